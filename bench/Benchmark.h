@@ -79,6 +79,10 @@ public:
 
     virtual void getGpuStats(SkCanvas*, SkTArray<SkString>* keys, SkTArray<double>* values) {}
 
+    // The most sk_malloc() calls a loop of draw() may make on the backend once it is warmed up,
+    // or -1 for no limit. nanobench --countAllocations fails benches that make more.
+    virtual int allocationsPerLoopLimit(Backend) const { return -1; }
+
 protected:
     virtual void setupPaint(SkPaint* paint);
 
@@ -82,3 +82,38 @@ DEF_BENCH( return new BigPathBench(kRight_Align,    false); )
 DEF_BENCH( return new BigPathBench(kLeft_Align,     true); )
 DEF_BENCH( return new BigPathBench(kMiddle_Align,   true); )
 DEF_BENCH( return new BigPathBench(kRight_Align,    true); )
+
+// Fills a big path that has never been drawn before on every loop, so that it's tessellated each
+// time instead of coming from a cache. With --gpuThreads the tessellation happens on those
+// threads while recording continues.
+class BigPathFillBench : public Benchmark {
+    SkPath fPath;
+
+public:
+    BigPathFillBench() {}
+
+protected:
+    const char* onGetName() override { return "bigpath_fill_uncached"; }
+
+    SkIPoint onGetSize() override { return SkIPoint::Make(640, 100); }
+
+    void onDelayedSetup() override { ToolUtils::make_big_path(fPath); }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkPaint paint;
+        this->setupPaint(&paint);
+        paint.setAntiAlias(false);
+        canvas->translate(-fPath.getBounds().left(), 0);
+        for (int i = 0; i < loops; i++) {
+            // Offsetting makes a path with a new generation ID.
+            SkPath path;
+            fPath.offset(SkIntToScalar(i & 1), 0, &path);
+            canvas->drawPath(path, paint);
+        }
+    }
+
+private:
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH( return new BigPathFillBench(); )
@@ -7,25 +7,43 @@
 
 #include "bench/Benchmark.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkColorSpace.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkString.h"
+#include "include/core/SkSurface.h"
 #include "include/core/SkTextBlob.h"
 #include "include/utils/SkRandom.h"
 #include "src/core/SkBlendModePriv.h"
 
-// Benchmark that draws non-AA rects or AA text with an SkXfermode::Mode.
+// Benchmark that draws non-AA rects or AA text with an SkXfermode::Mode, optionally into a linear
+// F16 raster surface instead of the benchmark's canvas.
 class XfermodeBench : public Benchmark {
 public:
-    XfermodeBench(SkBlendMode mode, bool aa) : fBlendMode(mode) {
+    XfermodeBench(SkBlendMode mode, bool aa, bool f16 = false) : fBlendMode(mode) {
         fAA = aa;
-        fName.printf("blendmode_%s_%s", aa ? "mask" : "rect", SkBlendMode_Name(mode));
+        fF16 = f16;
+        fName.printf("blendmode_%s_%s%s", aa ? "mask" : "rect", f16 ? "f16_" : "",
+                     SkBlendMode_Name(mode));
     }
 
 protected:
     const char* onGetName() override { return fName.c_str(); }
 
+    bool isSuitableFor(Backend backend) override {
+        return !fF16 || backend == kNonRendering_Backend;
+    }
+
     void onDraw(int loops, SkCanvas* canvas) override {
+        if (fF16) {
+            if (!fSurface) {
+                fSurface = SkSurface::MakeRaster(SkImageInfo::Make(640, 480,
+                                                                   kRGBA_F16_SkColorType,
+                                                                   kPremul_SkAlphaType,
+                                                                   SkColorSpace::MakeSRGBLinear()));
+            }
+            canvas = fSurface->getCanvas();
+        }
         const char* text = "Hamburgefons";
         size_t len = strlen(text);
         SkISize size = canvas->getBaseLayerSize();
@@ -62,9 +80,11 @@ protected:
     }
 
 private:
-    SkBlendMode fBlendMode;
-    SkString    fName;
-    bool        fAA;
+    SkBlendMode      fBlendMode;
+    SkString         fName;
+    bool             fAA;
+    bool             fF16;
+    sk_sp<SkSurface> fSurface;
 
     typedef Benchmark INHERITED;
 };
@@ -107,3 +127,12 @@ BENCH(SkBlendMode::kHue)
 BENCH(SkBlendMode::kSaturation)
 BENCH(SkBlendMode::kColor)
 BENCH(SkBlendMode::kLuminosity)
+
+#define F16_BENCH(...)                                               \
+    DEF_BENCH( return new XfermodeBench(__VA_ARGS__, true, true); )  \
+    DEF_BENCH( return new XfermodeBench(__VA_ARGS__, false, true); )
+
+F16_BENCH(SkBlendMode::kSrc)
+F16_BENCH(SkBlendMode::kSrcOver)
+F16_BENCH(SkBlendMode::kPlus)
+F16_BENCH(SkBlendMode::kMultiply)
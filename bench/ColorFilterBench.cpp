@@ -75,3 +75,105 @@ private:
 DEF_BENCH( return new FilteredRectBench(FilteredRectBench::kNoFilter_Type); )
 DEF_BENCH( return new FilteredRectBench(FilteredRectBench::kColorFilter_Type); )
 DEF_BENCH( return new FilteredRectBench(FilteredRectBench::kImageFilter_Type); )
+
+#if SK_SUPPORT_GPU
+#include "include/core/SkData.h"
+#include "src/core/SkColorFilterPriv.h"
+
+/**
+ *  Draws small rects through a runtime color filter that the SkSL interpreter runs, so most of the
+ *  time goes to appending the filter to each draw's pipeline rather than to shading pixels.
+ */
+class RuntimeColorFilterBench : public Benchmark {
+public:
+    RuntimeColorFilterBench()
+        : fFactory(SkString(R"(
+            layout(ctype=float) in uniform half b;
+
+            void main(inout half4 color) {
+                color.a = color.r*0.3 + color.g*0.6 + color.b*b;
+                color.r = 0;
+                color.g = 0;
+                color.b = 0;
+            }
+        )")) {}
+
+protected:
+    const char* onGetName() override {
+        return "runtimecolorfilter_interpreted";
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kRaster_Backend;
+    }
+
+    void onDelayedSetup() override {
+        float b = 0.1f;
+        fPaint.setColor(SK_ColorRED);
+        fPaint.setColorFilter(fFactory.make(SkData::MakeWithCopy(&b, sizeof(b))));
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        const SkRect r = { 0, 0, 8, 8 };
+        for (int i = 0; i < loops; ++i) {
+            canvas->drawRect(r, fPaint);
+        }
+    }
+
+private:
+    SkRuntimeColorFilterFactory fFactory;
+    SkPaint                     fPaint;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH( return new RuntimeColorFilterBench; )
+#endif
+
+#include "include/effects/SkColorCubeFilter.h"
+#include "include/effects/SkGradientShader.h"
+
+/**
+ *  Grades a gradient through a 33^3 color cube, the usual size for color grading lookup tables.
+ */
+class ColorCubeFilterBench : public Benchmark {
+protected:
+    const char* onGetName() override {
+        return "colorcubefilter_33";
+    }
+
+    void onDelayedSetup() override {
+        const int dim = 33;
+        sk_sp<SkData> cube = SkData::MakeUninitialized(dim * dim * dim * sizeof(SkColor));
+        SkColor* colors = static_cast<SkColor*>(cube->writable_data());
+        for (int b = 0; b < dim; ++b) {
+            for (int g = 0; g < dim; ++g) {
+                for (int r = 0; r < dim; ++r) {
+                    // Something like a warming grade.
+                    *colors++ = SkColorSetRGB(SkTMin(255, r * 9), g * 255 / (dim - 1),
+                                              b * 200 / (dim - 1));
+                }
+            }
+        }
+        const SkPoint pts[] = {{0, 0}, {256, 256}};
+        const SkColor gradient[] = {SK_ColorRED, SK_ColorCYAN, SK_ColorYELLOW, SK_ColorBLUE};
+        fPaint.setShader(SkGradientShader::MakeLinear(pts, gradient, nullptr,
+                                                      SK_ARRAY_COUNT(gradient),
+                                                      SkTileMode::kClamp));
+        fPaint.setColorFilter(SkColorCubeFilter::Make(std::move(cube), dim));
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        const SkRect r = { 0, 0, 256, 256 };
+        for (int i = 0; i < loops; ++i) {
+            canvas->drawRect(r, fPaint);
+        }
+    }
+
+private:
+    SkPaint fPaint;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH( return new ColorCubeFilterBench; )
@@ -37,6 +37,38 @@ private:
     typedef Benchmark INHERITED;
 };
 
+class CubicMapBatchBench : public Benchmark {
+public:
+    CubicMapBatchBench(SkPoint p1, SkPoint p2) : fCMap(p1, p2) {
+        fName.printf("cubicmap_batch_%g_%g_%g_%g", p1.fX, p1.fY, p2.fX, p2.fY);
+        for (int i = 0; i <= 512; ++i) {
+            fX[i] = i * (1.0f / 512);
+        }
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops * 100; ++i) {
+            fCMap.computeYFromX(fX, fY, SK_ARRAY_COUNT(fX));
+        }
+    }
+
+private:
+    SkCubicMap  fCMap;
+    SkString    fName;
+    float       fX[513],
+                fY[513];
+
+    typedef Benchmark INHERITED;
+};
+
 DEF_BENCH( return new CubicMapBench({1, 0}, {0,0}); )
 DEF_BENCH( return new CubicMapBench({1, 0}, {0,1}); )
 DEF_BENCH( return new CubicMapBench({1, 0}, {1,0}); )
@@ -49,3 +81,8 @@ DEF_BENCH( return new CubicMapBench({0, 1}, {1,1}); )
 
 DEF_BENCH( return new CubicMapBench({0, 0}, {1,1}); )
 DEF_BENCH( return new CubicMapBench({1, 1}, {0,0}); )
+
+DEF_BENCH( return new CubicMapBatchBench({1, 0}, {0,1}); )
+DEF_BENCH( return new CubicMapBatchBench({0, 1}, {1,0}); )
+DEF_BENCH( return new CubicMapBatchBench({0, 0}, {1,1}); )
+DEF_BENCH( return new CubicMapBatchBench({0.42f, 0}, {0.58f, 1}); )
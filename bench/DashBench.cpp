@@ -205,6 +205,40 @@ private:
     typedef Benchmark INHERITED;
 };
 
+// Draws a thin dashed curve, which the GPU backend can dash without flattening it into dashes on
+// the CPU first.
+class DashCurveBench : public Benchmark {
+    SkString fName;
+    SkPath   fPath;
+    SkPaint  fPaint;
+
+public:
+    DashCurveBench(void (*proc)(SkPath*), const char name[], SkScalar width) {
+        fName.printf("dashcurve_%s_%g", name, SkScalarToFloat(width));
+        proc(&fPath);
+
+        SkScalar vals[] = { SkIntToScalar(4), SkIntToScalar(4) };
+        fPaint.setAntiAlias(true);
+        fPaint.setStyle(SkPaint::kStroke_Style);
+        fPaint.setStrokeWidth(width);
+        fPaint.setPathEffect(SkDashPathEffect::Make(vals, 2, 0));
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        for (int i = 0; i < loops; ++i) {
+            canvas->drawPath(fPath, fPaint);
+        }
+    }
+
+private:
+    typedef Benchmark INHERITED;
+};
+
 /*
  *  We try to special case square dashes (intervals are equal to strokewidth).
  */
@@ -449,6 +483,10 @@ DEF_BENCH( return new DashBench(PARAM(gDots), 4); )
 DEF_BENCH( return new MakeDashBench(make_poly, "poly"); )
 DEF_BENCH( return new MakeDashBench(make_quad, "quad"); )
 DEF_BENCH( return new MakeDashBench(make_cubic, "cubic"); )
+DEF_BENCH( return new DashCurveBench(make_poly, "poly", 0); )
+DEF_BENCH( return new DashCurveBench(make_quad, "quad", 0); )
+DEF_BENCH( return new DashCurveBench(make_cubic, "cubic", 0); )
+DEF_BENCH( return new DashCurveBench(make_cubic, "cubic", 2); )
 DEF_BENCH( return new DashLineBench(0, false); )
 DEF_BENCH( return new DashLineBench(SK_Scalar1, false); )
 DEF_BENCH( return new DashLineBench(2 * SK_Scalar1, false); )
@@ -11,6 +11,7 @@
 #include "include/core/SkSurface.h"
 #include "include/effects/SkDisplacementMapEffect.h"
 #include "include/effects/SkImageSource.h"
+#include "include/effects/SkPerlinNoiseShader.h"
 
 #define FILTER_WIDTH_SMALL  32
 #define FILTER_HEIGHT_SMALL 32
@@ -26,6 +27,7 @@ protected:
         if (!fInitialized) {
             this->makeBitmap();
             this->makeCheckerboard();
+            this->makeTurbulence();
             fInitialized = true;
         }
     }
@@ -69,6 +71,19 @@ protected:
         fCheckerboard = surface->makeImageSnapshot();
     }
 
+    // The usual SVG pairing: a displacement map made by feTurbulence, so that the displacement
+    // varies smoothly and every pixel is read from somewhere else.
+    void makeTurbulence() {
+        const int w = this->isSmall() ? FILTER_WIDTH_SMALL : FILTER_WIDTH_LARGE;
+        const int h = this->isSmall() ? FILTER_HEIGHT_SMALL : FILTER_HEIGHT_LARGE;
+        auto surface(SkSurface::MakeRasterN32Premul(w, h));
+        SkPaint paint;
+        paint.setShader(SkPerlinNoiseShader::MakeTurbulence(0.05f, 0.05f, 2, 0));
+        surface->getCanvas()->drawPaint(paint);
+
+        fTurbulence = surface->makeImageSnapshot();
+    }
+
     void drawClippedBitmap(SkCanvas* canvas, int x, int y, const SkPaint& paint) {
         canvas->save();
         canvas->clipRect(SkRect::MakeXYWH(SkIntToScalar(x), SkIntToScalar(y),
@@ -82,6 +97,7 @@ protected:
 
     SkBitmap fBitmap;
     sk_sp<SkImage> fCheckerboard;
+    sk_sp<SkImage> fTurbulence;
 
 private:
     bool fInitialized;
@@ -168,11 +184,39 @@ private:
     typedef DisplacementBaseBench INHERITED;
 };
 
+class DisplacementTurbulenceBench : public DisplacementBaseBench {
+public:
+    DisplacementTurbulenceBench(bool small) : INHERITED(small) { }
+
+protected:
+    const char* onGetName() override {
+        return isSmall() ? "displacement_turbulence_small" : "displacement_turbulence_large";
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkPaint paint;
+        sk_sp<SkImageFilter> displ(SkImageSource::Make(fTurbulence));
+        // Displacement, with 2 non-alpha components of a translucent map
+        paint.setImageFilter(SkDisplacementMapEffect::Make(
+                                                SkDisplacementMapEffect::kR_ChannelSelectorType,
+                                                SkDisplacementMapEffect::kG_ChannelSelectorType,
+                                                24.0f, std::move(displ), nullptr));
+        for (int i = 0; i < loops; ++i) {
+            this->drawClippedBitmap(canvas, 300, 0, paint);
+        }
+    }
+
+private:
+    typedef DisplacementBaseBench INHERITED;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 
 DEF_BENCH( return new DisplacementZeroBench(true); )
 DEF_BENCH( return new DisplacementAlphaBench(true); )
 DEF_BENCH( return new DisplacementFullBench(true); )
+DEF_BENCH( return new DisplacementTurbulenceBench(true); )
 DEF_BENCH( return new DisplacementZeroBench(false); )
 DEF_BENCH( return new DisplacementAlphaBench(false); )
 DEF_BENCH( return new DisplacementFullBench(false); )
+DEF_BENCH( return new DisplacementTurbulenceBench(false); )
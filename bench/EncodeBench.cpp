@@ -7,6 +7,7 @@
 
 #include "bench/Benchmark.h"
 #include "include/core/SkBitmap.h"
+#include "include/core/SkEncodedImageFormat.h"
 #include "include/core/SkStream.h"
 #include "include/encode/SkJpegEncoder.h"
 #include "include/encode/SkPngEncoder.h"
@@ -123,3 +124,67 @@ DEF_BENCH(return new EncodeBench(srcs[1], PNG(kNone, 3), "PNG_3n"));
 DEF_BENCH(return new EncodeBench(srcs[1], PNG(kNone, 1), "PNG_1n"));
 
 #undef PNG
+
+// Encodes a source image as many small tiles, which is dominated by the fixed cost of each
+// encode, either with a new encoder every time or with a Batch.
+class EncodeTilesBench : public Benchmark {
+public:
+    EncodeTilesBench(SkEncodedImageFormat format, bool batch)
+        : fFormat(format)
+        , fBatch(batch)
+        , fName(SkStringPrintf("Encode_tiles_%s%s",
+                               format == SkEncodedImageFormat::kPNG ? "PNG" : "JPEG",
+                               batch ? "_batch" : "")) {}
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        SkAssertResult(GetResourceAsBitmap(srcs[0], &fBitmap));
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        static constexpr int kTileSize = 32;
+        SkJpegEncoder::Options jpegOptions;
+        jpegOptions.fQuality = 90;
+        SkPngEncoder::Options pngOptions;
+        std::unique_ptr<SkJpegEncoder::Batch> jpegBatch;
+        std::unique_ptr<SkPngEncoder::Batch> pngBatch;
+        if (fBatch) {
+            jpegBatch = SkJpegEncoder::MakeBatch(jpegOptions);
+            pngBatch = SkPngEncoder::MakeBatch(pngOptions);
+        }
+
+        while (loops-- > 0) {
+            for (int y = 0; y + kTileSize <= fBitmap.height(); y += kTileSize) {
+                for (int x = 0; x + kTileSize <= fBitmap.width(); x += kTileSize) {
+                    SkPixmap tile;
+                    SkAssertResult(fBitmap.pixmap().extractSubset(
+                            &tile, SkIRect::MakeXYWH(x, y, kTileSize, kTileSize)));
+                    SkNullWStream dst;
+                    bool success;
+                    if (fFormat == SkEncodedImageFormat::kPNG) {
+                        success = fBatch ? pngBatch->encode(&dst, tile)
+                                         : SkPngEncoder::Encode(&dst, tile, pngOptions);
+                    } else {
+                        success = fBatch ? jpegBatch->encode(&dst, tile)
+                                         : SkJpegEncoder::Encode(&dst, tile, jpegOptions);
+                    }
+                    SkAssertResult(success);
+                }
+            }
+        }
+    }
+
+private:
+    SkEncodedImageFormat fFormat;
+    bool                 fBatch;
+    SkString             fName;
+    SkBitmap             fBitmap;
+};
+
+DEF_BENCH(return new EncodeTilesBench(SkEncodedImageFormat::kJPEG, false));
+DEF_BENCH(return new EncodeTilesBench(SkEncodedImageFormat::kJPEG, true));
+DEF_BENCH(return new EncodeTilesBench(SkEncodedImageFormat::kPNG, false));
+DEF_BENCH(return new EncodeTilesBench(SkEncodedImageFormat::kPNG, true));
@@ -0,0 +1,105 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkString.h"
+#include "src/core/SkTaskGroup.h"
+
+#include <atomic>
+#include <memory>
+
+// Simulates PDF or codec work sharing a pool with GPU prepare work: the pool is kept busy with a
+// backlog of bulk tasks, and each loop adds a few latency sensitive tasks and waits for them.
+// The time per loop is how long the urgent work takes to get through the backlog.
+enum class PoolType {
+    kFIFO,
+    kLIFO,
+    kWorkStealing,
+};
+
+class ExecutorMixedWorkloadBench : public Benchmark {
+public:
+    explicit ExecutorMixedWorkloadBench(PoolType type) : fType(type) {
+        static const char* kNames[] = { "fifo", "lifo", "workstealing" };
+        fName.printf("executor_mixed_%s", kNames[(int)type]);
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        switch (fType) {
+            case PoolType::kFIFO:
+                fExecutor = SkExecutor::MakeFIFOThreadPool(kThreads);
+                break;
+            case PoolType::kLIFO:
+                fExecutor = SkExecutor::MakeLIFOThreadPool(kThreads);
+                break;
+            case PoolType::kWorkStealing:
+                fExecutor = SkExecutor::MakeWorkStealingThreadPool(kThreads);
+                break;
+        }
+        fBulk.reset(new SkTaskGroup(*fExecutor));
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; i++) {
+            // Top the backlog back up.
+            while (fBulkPending.load(std::memory_order_relaxed) < kBulkTasks) {
+                fBulkPending.fetch_add(1, std::memory_order_relaxed);
+                fBulk->add([this] {
+                    this->spin(kBulkSpins);
+                    fBulkPending.fetch_add(-1, std::memory_order_relaxed);
+                });
+            }
+            SkTaskGroup urgent(*fExecutor);
+            for (int j = 0; j < kUrgentTasks; j++) {
+                urgent.add([this] { this->spin(kUrgentSpins); }, SkExecutor::Priority::kHigh);
+            }
+            urgent.wait();
+        }
+    }
+
+    void onPerCanvasPostDraw(SkCanvas*) override {
+        fBulk->wait();
+    }
+
+private:
+    static constexpr int kThreads = 4;
+    static constexpr int kBulkTasks = 64;
+    static constexpr int kBulkSpins = 20000;
+    static constexpr int kUrgentTasks = 4;
+    static constexpr int kUrgentSpins = 2000;
+
+    void spin(int n) {
+        uint32_t x = 0;
+        for (int i = 0; i < n; i++) {
+            x = x * 1664525 + 1013904223;
+        }
+        fSink.fetch_add(x, std::memory_order_relaxed);
+    }
+
+    PoolType                     fType;
+    SkString                     fName;
+    std::unique_ptr<SkExecutor>  fExecutor;
+    std::unique_ptr<SkTaskGroup> fBulk;
+    std::atomic<int>             fBulkPending{0};
+    std::atomic<uint32_t>        fSink{0};
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH( return new ExecutorMixedWorkloadBench(PoolType::kFIFO); )
+DEF_BENCH( return new ExecutorMixedWorkloadBench(PoolType::kLIFO); )
+DEF_BENCH( return new ExecutorMixedWorkloadBench(PoolType::kWorkStealing); )
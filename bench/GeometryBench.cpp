@@ -244,6 +244,38 @@ protected:
 };
 DEF_BENCH( return new ChopCubicAt; )
 
+// Evaluates a cubic at 64 values of t, one call per t or all in one batched call.
+class EvalCubicAtN : public QuadBenchBase {
+public:
+    EvalCubicAtN(bool batched)
+        : QuadBenchBase(batched ? "evalcubicat_batch" : "evalcubicat_each")
+        , fBatched(batched) {
+        for (int i = 0; i < kCount; ++i) {
+            fT[i] = i / (kCount - 1.0f);
+        }
+    }
+protected:
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkPoint result[kCount];
+        for (int outer = 0; outer < loops; ++outer) {
+            if (fBatched) {
+                SkEvalCubicAt(fPts, fT, kCount, result);
+            } else {
+                for (int i = 0; i < kCount; ++i) {
+                    SkEvalCubicAt(fPts, fT[i], &result[i], nullptr, nullptr);
+                }
+            }
+            this->virtualCallToFoilOptimizers(SkScalarTruncToInt(result[outer % kCount].fX));
+        }
+    }
+private:
+    static constexpr int kCount = 64;
+    SkScalar fT[kCount];
+    bool     fBatched;
+};
+DEF_BENCH( return new EvalCubicAtN(false); )
+DEF_BENCH( return new EvalCubicAtN(true); )
+
 #include "include/core/SkPath.h"
 
 class ConvexityBench : public Benchmark {
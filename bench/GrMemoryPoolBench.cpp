@@ -12,6 +12,7 @@
 #include "include/private/SkTemplates.h"
 #include "include/utils/SkRandom.h"
 #include "src/gpu/GrMemoryPool.h"
+#include "src/gpu/ops/GrOp.h"
 
 #include <new>
 
@@ -170,8 +171,75 @@ private:
     typedef Benchmark INHERITED;
 };
 
+class BenchOp : public GrOp {
+public:
+    DEFINE_OP_CLASS_ID
+
+    const char* name() const override { return "BenchOp"; }
+
+private:
+    friend class ::GrOpMemoryPool;  // for ctor
+
+    BenchOp() : INHERITED(ClassID()) {}
+
+    void onPrepare(GrOpFlushState*) override {}
+    void onExecute(GrOpFlushState*, const SkRect&) override {}
+
+    int fStuff[10];
+
+    typedef GrOp INHERITED;
+};
+
+/**
+ * This benchmark records frames of ops in a GrOpMemoryPool, and releases them in recording order
+ * the way a flush does, with or without the frame arena.
+ */
+class GrOpMemoryPoolBenchFrames : public Benchmark {
+    enum {
+        kMaxOpsPerFrame = 4 * (1 << 10),
+    };
+public:
+    GrOpMemoryPoolBenchFrames(bool useFrameArena)
+            : fUseFrameArena(useFrameArena)
+            , fName(useFrameArena ? "gropmemorypool_frames_arena" : "gropmemorypool_frames") {}
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName;
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        // Same sizes as GrRecordingContext's pool.
+        GrOpMemoryPool pool(16384, 16384, fUseFrameArena);
+        SkRandom r;
+        std::unique_ptr<GrOp> ops[kMaxOpsPerFrame];
+        for (int i = 0; i < loops; i++) {
+            uint32_t count = r.nextRangeU(0, kMaxOpsPerFrame - 1);
+            for (uint32_t j = 0; j < count; j++) {
+                ops[j] = pool.allocate<BenchOp>();
+            }
+            for (uint32_t j = 0; j < count; j++) {
+                pool.release(std::move(ops[j]));
+            }
+            pool.resetFrameArena();
+        }
+    }
+
+private:
+    bool        fUseFrameArena;
+    const char* fName;
+
+    typedef Benchmark INHERITED;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 
 DEF_BENCH( return new GrMemoryPoolBenchStack(); )
 DEF_BENCH( return new GrMemoryPoolBenchRandom(); )
 DEF_BENCH( return new GrMemoryPoolBenchQueue(); )
+DEF_BENCH( return new GrOpMemoryPoolBenchFrames(false); )
+DEF_BENCH( return new GrOpMemoryPoolBenchFrames(true); )
@@ -12,13 +12,19 @@
 #include "include/core/SkSurface.h"
 
 class GrMipMapBench: public Benchmark {
-    sk_sp<SkSurface> fSurface;
+    SkTArray<sk_sp<SkSurface>> fSurfaces;
     SkString fName;
     const int fW, fH;
+    const int fCount;
 
 public:
-    GrMipMapBench(int w, int h) : fW(w), fH(h) {
+    // With a count, that many surfaces are dirtied and drawn each loop, so their mips are all
+    // regenerated within one flush.
+    GrMipMapBench(int w, int h, int count = 1) : fW(w), fH(h), fCount(count) {
         fName.printf("gr_mipmap_build_%dx%d", w, h);
+        if (count > 1) {
+            fName.appendf("_x%d", count);
+        }
     }
 
 protected:
@@ -29,7 +35,7 @@ protected:
     const char* onGetName() override { return fName.c_str(); }
 
     void onDraw(int loops, SkCanvas* canvas) override {
-        if (!fSurface) {
+        if (fSurfaces.empty()) {
             GrContext* context = canvas->getGrContext();
             if (nullptr == context) {
                 return;
@@ -39,31 +45,37 @@ protected:
                     SkImageInfo::Make(fW, fH, kRGBA_8888_SkColorType, kPremul_SkAlphaType, srgb);
             // We're benching the regeneration of the mip levels not the need to allocate them every
             // frame. Thus we create the surface with mips to begin with.
-            fSurface = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, info, 0,
-                                                   kBottomLeft_GrSurfaceOrigin, nullptr, true);
-
+            for (int i = 0; i < fCount; ++i) {
+                fSurfaces.push_back(SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, info, 0,
+                                                                kBottomLeft_GrSurfaceOrigin,
+                                                                nullptr, true));
+            }
         }
 
-        // Clear surface once:
-        fSurface->getCanvas()->clear(SK_ColorBLACK);
+        // Clear surfaces once:
+        for (const auto& surface : fSurfaces) {
+            surface->getCanvas()->clear(SK_ColorBLACK);
+        }
 
         SkPaint paint;
         paint.setFilterQuality(kMedium_SkFilterQuality);
         paint.setColor(SK_ColorWHITE);
         for (int i = 0; i < loops; i++) {
-            // Touch surface so mips are dirtied
-            fSurface->getCanvas()->drawPoint(0, 0, paint);
+            for (const auto& surface : fSurfaces) {
+                // Touch surface so mips are dirtied
+                surface->getCanvas()->drawPoint(0, 0, paint);
 
-            // Draw reduced version of surface to original canvas, to trigger mip generation
-            canvas->save();
-            canvas->scale(0.1f, 0.1f);
-            canvas->drawImage(fSurface->makeImageSnapshot(), 0, 0, &paint);
-            canvas->restore();
+                // Draw reduced version of surface to original canvas, to trigger mip generation
+                canvas->save();
+                canvas->scale(0.1f, 0.1f);
+                canvas->drawImage(surface->makeImageSnapshot(), 0, 0, &paint);
+                canvas->restore();
+            }
         }
     }
 
     void onPerCanvasPostDraw(SkCanvas*) override {
-        fSurface.reset(nullptr);
+        fSurfaces.reset();
     }
 
 private:
@@ -77,3 +89,7 @@ DEF_BENCH( return new GrMipMapBench(511, 511); )
 DEF_BENCH( return new GrMipMapBench(512, 511); )
 DEF_BENCH( return new GrMipMapBench(511, 512); )
 DEF_BENCH( return new GrMipMapBench(512, 512); )
+
+// Many small textures sampled in the same frame, where the cost is in the per-level barriers more
+// than in the blits.
+DEF_BENCH( return new GrMipMapBench(32, 32, 64); )
@@ -156,6 +156,96 @@ private:
     typedef Benchmark INHERITED;
 };
 
+/**
+ * Compares the purge policies on a workload that mixes a hot set of resources, looked up every
+ * iteration and expensive to rebuild on a miss, with a scan of one-off resources that overflows the
+ * budget.
+ */
+class GrResourceCacheBenchPolicy : public Benchmark {
+public:
+    using PurgePolicy = GrResourceCache::PurgePolicy;
+
+    GrResourceCacheBenchPolicy(PurgePolicy policy) : fPolicy(policy) {
+        switch (policy) {
+            case PurgePolicy::kLRU:
+                fFullName = "grresourcecache_policy_lru";
+                break;
+            case PurgePolicy::kCostAware:
+                fFullName = "grresourcecache_policy_cost_aware";
+                break;
+            case PurgePolicy::kScanResistant:
+                fFullName = "grresourcecache_policy_scan_resistant";
+                break;
+        }
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+protected:
+    const char* onGetName() override {
+        return fFullName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        fContext = GrContext::MakeMock(nullptr);
+        if (!fContext) {
+            return;
+        }
+        fContext->setResourceCacheLimits(kBudgetCount, 1 << 30);
+        GrResourceCache* cache = fContext->priv().getResourceCache();
+        cache->purgeAllUnlocked();
+        cache->setPurgePolicy(fPolicy);
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        if (!fContext) {
+            return;
+        }
+        GrResourceCache* cache = fContext->priv().getResourceCache();
+        GrGpu* gpu = fContext->priv().getGpu();
+        for (int i = 0; i < loops; ++i) {
+            for (int k = 0; k < kHotCount; ++k) {
+                GrUniqueKey key;
+                BenchResource::ComputeKey(k, 1, &key);
+                sk_sp<GrGpuResource> resource(cache->findAndRefUniqueResource(key));
+                if (!resource) {
+                    resource.reset(new BenchResource(gpu));
+                    resource->resourcePriv().setUniqueKey(key);
+                    resource->resourcePriv().setRebuildCostHint(this->rebuild());
+                }
+            }
+            for (int k = 0; k < kScanCount; ++k) {
+                GrUniqueKey key;
+                BenchResource::ComputeKey(kHotCount + fNextScanKey++, 1, &key);
+                sk_sp<GrGpuResource> resource(new BenchResource(gpu));
+                resource->resourcePriv().setUniqueKey(key);
+            }
+        }
+    }
+
+private:
+    static constexpr int kBudgetCount = 1024;
+    static constexpr int kHotCount = kBudgetCount / 2;
+    static constexpr int kScanCount = kBudgetCount * 3 / 4;
+    static constexpr int kRebuildWork = 1000;
+
+    // Stands in for the work of recreating a hot resource, and returns its cost.
+    float rebuild() {
+        for (int j = 0; j < kRebuildWork; ++j) {
+            fRebuildSink = fRebuildSink * 31 + j;
+        }
+        return kRebuildWork;
+    }
+
+    sk_sp<GrContext> fContext;
+    PurgePolicy fPolicy;
+    SkString fFullName;
+    int fNextScanKey = 0;
+    volatile uint32_t fRebuildSink = 0;
+    typedef Benchmark INHERITED;
+};
+
 DEF_BENCH( return new GrResourceCacheBenchAdd(1); )
 #ifdef SK_RELEASE
 // Only on release because on debug the SkTDynamicHash validation is too slow.
@@ -182,3 +272,7 @@ DEF_BENCH( return new GrResourceCacheBenchFind(54); )
 DEF_BENCH( return new GrResourceCacheBenchFind(55); )
 DEF_BENCH( return new GrResourceCacheBenchFind(56); )
 #endif
+
+DEF_BENCH( return new GrResourceCacheBenchPolicy(GrResourceCache::PurgePolicy::kLRU); )
+DEF_BENCH( return new GrResourceCacheBenchPolicy(GrResourceCache::PurgePolicy::kCostAware); )
+DEF_BENCH( return new GrResourceCacheBenchPolicy(GrResourceCache::PurgePolicy::kScanResistant); )
@@ -36,6 +36,15 @@ static const SkColor gColors[] = {
 static const SkColor gShallowColors[] = { 0xFF555555, 0xFF444444 };
 static const SkScalar gPos[] = {0.25f, 0.75f};
 
+// Unevenly spaced, like a heatmap's scale, so these are searched rather than looked up directly.
+static const SkScalar gHiColorPos[] = {
+    0.000f, 0.003f, 0.008f, 0.015f, 0.023f, 0.033f, 0.043f, 0.054f, 0.066f, 0.079f,
+    0.092f, 0.106f, 0.121f, 0.137f, 0.153f, 0.169f, 0.187f, 0.204f, 0.223f, 0.241f,
+    0.261f, 0.281f, 0.301f, 0.322f, 0.343f, 0.364f, 0.387f, 0.409f, 0.432f, 0.455f,
+    0.479f, 0.503f, 0.528f, 0.553f, 0.578f, 0.604f, 0.630f, 0.656f, 0.683f, 0.710f,
+    0.738f, 0.765f, 0.794f, 0.822f, 0.851f, 0.880f, 0.910f, 0.939f, 0.970f, 1.000f,
+};
+
 // We have several special-cases depending on the number (and spacing) of colors, so
 // try to exercise those here.
 static const GradData gGradData[] = {
@@ -44,6 +53,7 @@ static const GradData gGradData[] = {
     { 3, gColors, nullptr, "_3color" },
     { 2, gShallowColors, nullptr, "_shallow" },
     { 2, gColors, gPos, "_pos" },
+    { 50, gColors, gHiColorPos, "_hicolor_pos" },
 };
 
 /// Ignores scale
@@ -272,6 +282,7 @@ DEF_BENCH( return new GradientBench(kLinear_GradType, gGradData[0]); )
 DEF_BENCH( return new GradientBench(kLinear_GradType, gGradData[1]); )
 DEF_BENCH( return new GradientBench(kLinear_GradType, gGradData[2]); )
 DEF_BENCH( return new GradientBench(kLinear_GradType, gGradData[4]); )
+DEF_BENCH( return new GradientBench(kLinear_GradType, gGradData[5]); )
 DEF_BENCH( return new GradientBench(kLinear_GradType, gGradData[0], SkTileMode::kRepeat); )
 DEF_BENCH( return new GradientBench(kLinear_GradType, gGradData[1], SkTileMode::kRepeat); )
 DEF_BENCH( return new GradientBench(kLinear_GradType, gGradData[2], SkTileMode::kRepeat); )
@@ -282,6 +293,7 @@ DEF_BENCH( return new GradientBench(kLinear_GradType, gGradData[2], SkTileMode::
 DEF_BENCH( return new GradientBench(kRadial_GradType, gGradData[0]); )
 DEF_BENCH( return new GradientBench(kRadial_GradType, gGradData[1]); )
 DEF_BENCH( return new GradientBench(kRadial_GradType, gGradData[2]); )
+DEF_BENCH( return new GradientBench(kRadial_GradType, gGradData[5]); )
 // Draw a radial gradient of radius 1/2 on a rectangle; half the lines should
 // be completely pinned, the other half should pe partially pinned
 DEF_BENCH( return new GradientBench(kRadial_GradType, gGradData[0], SkTileMode::kClamp, kRect_GeomType, 0.5f); )
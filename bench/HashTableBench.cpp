@@ -0,0 +1,98 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkString.h"
+#include "include/private/SkTHash.h"
+#include "include/utils/SkRandom.h"
+#include "src/core/SkGlyph.h"
+#include "src/core/SkTSwissTable.h"
+
+#include <vector>
+
+// Looks up glyph IDs the way SkStrike::fGlyphMap does: a table of pointers keyed by
+// SkPackedGlyphID, probed with a mix of glyphs in the strike and a few that aren't yet.
+namespace {
+
+struct GlyphEntry {
+    SkPackedGlyphID fID;
+};
+
+struct GlyphEntryTraits {
+    static SkPackedGlyphID GetKey(const GlyphEntry* entry) { return entry->fID; }
+    static uint32_t Hash(SkPackedGlyphID id) { return id.hash(); }
+};
+
+template <typename Table>
+class GlyphIDLookupBench : public Benchmark {
+public:
+    GlyphIDLookupBench(const char* tableName, int glyphCount) : fGlyphCount(glyphCount) {
+        fName.printf("hashtable_glyph_lookup_%s_%d", tableName, glyphCount);
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        // Each glyph is cached at a couple of subpixel positions, like horizontal text.
+        fEntries.resize(fGlyphCount);
+        for (int i = 0; i < fGlyphCount; i++) {
+            fEntries[i].fID = SkPackedGlyphID(i / 2, (i & 1) ? SK_FixedHalf : 0, 0);
+            fTable.set(&fEntries[i]);
+        }
+
+        // About one lookup in sixteen misses, for glyphs that aren't in the strike yet.
+        SkRandom rand;
+        fLookups.resize(kLookupCount);
+        for (auto& id : fLookups) {
+            int i = rand.nextULessThan(fGlyphCount + fGlyphCount / 16 + 1);
+            id = SkPackedGlyphID(i / 2, (i & 1) ? SK_FixedHalf : 0, 0);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        int found = 0;
+        for (int i = 0; i < loops; i++) {
+            for (SkPackedGlyphID id : fLookups) {
+                found += fTable.findOrNull(id) != nullptr;
+            }
+        }
+        volatile int result = found;
+        sk_ignore_unused_variable(result);
+    }
+
+private:
+    static constexpr int kLookupCount = 1024;
+
+    SkString                     fName;
+    int                          fGlyphCount;
+    std::vector<GlyphEntry>      fEntries;
+    std::vector<SkPackedGlyphID> fLookups;
+    Table                        fTable;
+
+    typedef Benchmark INHERITED;
+};
+
+using THashGlyphTable = SkTHashTable<GlyphEntry*, SkPackedGlyphID, GlyphEntryTraits>;
+using SwissGlyphTable = SkTSwissTable<GlyphEntry*, SkPackedGlyphID, GlyphEntryTraits>;
+
+}  // namespace
+
+///////////////////////////////////////////////////////////////////////////////
+
+DEF_BENCH( return new GlyphIDLookupBench<THashGlyphTable>("thash", 64); )
+DEF_BENCH( return new GlyphIDLookupBench<SwissGlyphTable>("swiss", 64); )
+DEF_BENCH( return new GlyphIDLookupBench<THashGlyphTable>("thash", 1024); )
+DEF_BENCH( return new GlyphIDLookupBench<SwissGlyphTable>("swiss", 1024); )
+DEF_BENCH( return new GlyphIDLookupBench<THashGlyphTable>("thash", 16384); )
+DEF_BENCH( return new GlyphIDLookupBench<SwissGlyphTable>("swiss", 16384); )
@@ -13,6 +13,7 @@
 
 #include "include/gpu/GrContext.h"
 #include "src/gpu/GrContextPriv.h"
+#include "src/gpu/GrResourceCache.h"
 
 #include <utility>
 
@@ -69,16 +70,32 @@ void set_cache_budget(SkCanvas* canvas, int approxImagesInBudget) {
  */
 class ImageCacheBudgetBench : public Benchmark {
 public:
-    /** budgetSize is the number of images that can fit in the cache. 100 images will be drawn. */
-    ImageCacheBudgetBench(int budgetSize, bool shuffle)
+    using PurgePolicy = GrResourceCache::PurgePolicy;
+
+    /**
+     * budgetSize is the number of images that can fit in the cache. 100 images will be drawn.
+     * The cache purges with policy while the bench runs.
+     */
+    ImageCacheBudgetBench(int budgetSize, bool shuffle, PurgePolicy policy = PurgePolicy::kLRU)
             : fBudgetSize(budgetSize)
             , fShuffle(shuffle)
+            , fPolicy(policy)
             , fIndices(nullptr) {
         float imagesOverBudget = float(kImagesToDraw) / budgetSize;
         // Make the benchmark name contain the percentage of the budget that is used in each
         // simulated frame.
         fName.printf("image_cache_budget_%.0f%s", imagesOverBudget * 100,
                      (shuffle ? "_shuffle" : ""));
+        switch (policy) {
+            case PurgePolicy::kLRU:
+                break;
+            case PurgePolicy::kCostAware:
+                fName.append("_cost_aware");
+                break;
+            case PurgePolicy::kScanResistant:
+                fName.append("_scan_resistant");
+                break;
+        }
     }
 
     bool isSuitableFor(Backend backend) override { return kGPU_Backend == backend; }
@@ -92,6 +109,8 @@ protected:
         GrContext* context = canvas->getGrContext();
         SkASSERT(context);
         context->getResourceCacheLimits(&fOldCount, &fOldBytes);
+        fOldPolicy = context->priv().getResourceCache()->purgePolicy();
+        context->priv().getResourceCache()->setPurgePolicy(fPolicy);
         set_cache_budget(canvas, fBudgetSize);
         make_images(fImages, kImagesToDraw);
         if (fShuffle) {
@@ -115,6 +134,7 @@ protected:
         GrContext* context =  canvas->getGrContext();
         SkASSERT(context);
         context->setResourceCacheLimits(fOldCount, fOldBytes);
+        context->priv().getResourceCache()->setPurgePolicy(fOldPolicy);
         for (int i = 0; i < kImagesToDraw; ++i) {
             fImages[i].reset();
         }
@@ -145,6 +165,8 @@ private:
 
     int                         fBudgetSize;
     bool                        fShuffle;
+    PurgePolicy                 fPolicy;
+    PurgePolicy                 fOldPolicy;
     SkString                    fName;
     sk_sp<SkImage>              fImages[kImagesToDraw];
     std::unique_ptr<int[]>      fIndices;
@@ -170,6 +192,18 @@ DEF_BENCH( return new ImageCacheBudgetBench(80, true); )
 
 DEF_BENCH( return new ImageCacheBudgetBench(50, true); )
 
+DEF_BENCH( return new ImageCacheBudgetBench(80, true,
+                                            ImageCacheBudgetBench::PurgePolicy::kCostAware); )
+
+DEF_BENCH( return new ImageCacheBudgetBench(50, true,
+                                            ImageCacheBudgetBench::PurgePolicy::kCostAware); )
+
+DEF_BENCH( return new ImageCacheBudgetBench(80, true,
+                                            ImageCacheBudgetBench::PurgePolicy::kScanResistant); )
+
+DEF_BENCH( return new ImageCacheBudgetBench(50, true,
+                                            ImageCacheBudgetBench::PurgePolicy::kScanResistant); )
+
 //////////////////////////////////////////////////////////////////////////////
 
 /**
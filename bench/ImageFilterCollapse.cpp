@@ -12,6 +12,7 @@
 #include "include/effects/SkColorFilterImageFilter.h"
 #include "include/effects/SkColorMatrixFilter.h"
 #include "include/effects/SkGradientShader.h"
+#include "include/effects/SkOffsetImageFilter.h"
 #include "include/effects/SkTableColorFilter.h"
 
 // Chains several matrix color filters image filter or several
@@ -25,11 +26,16 @@ public:
     BaseImageFilterCollapseBench() {}
 
 protected:
-    void doPreDraw(sk_sp<SkColorFilter> colorFilters[], int nFilters) {
+    // If offset is not zero, each color filter is separated from the next by an offset filter,
+    // so they can't be collapsed when the chain is made, only when it is drawn.
+    void doPreDraw(sk_sp<SkColorFilter> colorFilters[], int nFilters, SkScalar offset = 0) {
         SkASSERT(!fImageFilter);
 
         // Create a chain of ImageFilters from colorFilters
         for(int i = nFilters; i --> 0;) {
+            if (offset != 0 && fImageFilter) {
+                fImageFilter = SkOffsetImageFilter::Make(offset, offset, fImageFilter);
+            }
             fImageFilter = SkColorFilterImageFilter::Make(colorFilters[i], fImageFilter);
         }
     }
@@ -132,5 +138,23 @@ protected:
     }
 };
 
+class OffsetCollapseBench: public BaseImageFilterCollapseBench {
+protected:
+    const char* onGetName() override {
+        return "image_filter_collapse_offset";
+    }
+
+    void onDelayedSetup() override {
+        sk_sp<SkColorFilter> colorFilters[] = {
+            make_brightness(0.1f),
+            make_grayscale(),
+            make_brightness(-0.1f),
+        };
+
+        this->doPreDraw(colorFilters, SK_ARRAY_COUNT(colorFilters), 2);
+    }
+};
+
 DEF_BENCH(return new TableCollapseBench;)
 DEF_BENCH(return new MatrixCollapseBench;)
+DEF_BENCH(return new OffsetCollapseBench;)
@@ -7,8 +7,11 @@
 
 #include "bench/Benchmark.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkGraphics.h"
 #include "include/core/SkImage.h"
+#include "include/core/SkString.h"
 #include "include/effects/SkBlurImageFilter.h"
+#include "include/effects/SkColorFilterImageFilter.h"
 #include "include/effects/SkDisplacementMapEffect.h"
 #include "include/effects/SkMergeImageFilter.h"
 #include "include/effects/SkOffsetImageFilter.h"
@@ -18,17 +21,25 @@
 // Exercise a blur filter connected to 5 inputs of the same merge filter.
 // This bench shows an improvement in performance once cacheing of re-used
 // nodes is implemented, since the DAG is no longer flattened to a tree.
+// With a tile size, raster canvases evaluate the DAG in tiles (see
+// SkGraphics::SetImageFilterTileSize()).
 class ImageFilterDAGBench : public Benchmark {
 public:
-    ImageFilterDAGBench() {}
+    explicit ImageFilterDAGBench(int tileSize = 0) : fTileSize(tileSize) {
+        fName = "image_filter_dag";
+        if (tileSize) {
+            fName.appendf("_tiled_%d", tileSize);
+        }
+    }
 
 protected:
     const char* onGetName() override {
-        return "image_filter_dag";
+        return fName.c_str();
     }
 
     void onDraw(int loops, SkCanvas* canvas) override {
         const SkRect rect = SkRect::Make(SkIRect::MakeWH(400, 400));
+        const int prevTileSize = SkGraphics::SetImageFilterTileSize(fTileSize);
 
         for (int j = 0; j < loops; j++) {
             sk_sp<SkImageFilter> blur(SkBlurImageFilter::Make(20.0f, 20.0f, nullptr));
@@ -40,11 +51,15 @@ protected:
             paint.setImageFilter(SkMergeImageFilter::Make(inputs, kNumInputs));
             canvas->drawRect(rect, paint);
         }
+        SkGraphics::SetImageFilterTileSize(prevTileSize);
     }
 
 private:
     static const int kNumInputs = 5;
 
+    int      fTileSize;
+    SkString fName;
+
     typedef Benchmark INHERITED;
 };
 
@@ -144,7 +159,39 @@ private:
     typedef Benchmark INHERITED;
 };
 
+// Exercise an Xfermode filter compositing two color filtered, offset copies of a blur. The color
+// filters are applied while compositing, rather than each in a pass of its own.
+class ImageFilterXfermodeColorFiltered : public Benchmark {
+public:
+    ImageFilterXfermodeColorFiltered() {}
+
+protected:
+    const char* onGetName() override { return "image_filter_xfermode_color_filtered"; }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        for (int j = 0; j < loops; j++) {
+            auto blur = SkBlurImageFilter::Make(4.0f, 4.0f, nullptr);
+            auto red = SkColorFilterImageFilter::Make(
+                    SkColorFilters::Blend(SK_ColorRED, SkBlendMode::kSrcIn), blur);
+            auto blue = SkColorFilterImageFilter::Make(
+                    SkColorFilters::Blend(SK_ColorBLUE, SkBlendMode::kSrcIn),
+                    SkOffsetImageFilter::Make(10.0f, 10.0f, blur));
+            auto xfermode =
+                    SkXfermodeImageFilter::Make(SkBlendMode::kSrcOver, red, blue, nullptr);
+
+            SkPaint paint;
+            paint.setImageFilter(xfermode);
+            canvas->drawRect(SkRect::MakeWH(400.0f, 400.0f), paint);
+        }
+    }
+
+private:
+    typedef Benchmark INHERITED;
+};
+
 DEF_BENCH(return new ImageFilterDAGBench;)
+DEF_BENCH(return new ImageFilterDAGBench(128);)
 DEF_BENCH(return new ImageMakeWithFilterDAGBench;)
 DEF_BENCH(return new ImageFilterDisplacedBlur;)
 DEF_BENCH(return new ImageFilterXfermodeIn;)
+DEF_BENCH(return new ImageFilterXfermodeColorFiltered;)
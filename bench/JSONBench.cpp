@@ -8,7 +8,12 @@
 #include "bench/Benchmark.h"
 #include "include/core/SkData.h"
 #include "include/core/SkStream.h"
+#include "src/core/SkOSFile.h"
 #include "src/utils/SkJSON.h"
+#include "src/utils/SkOSPath.h"
+#include "tools/Resources.h"
+
+#include <vector>
 
 #if defined(SK_BUILD_FOR_ANDROID)
 static constexpr const char* kBenchFile = "/data/local/tmp/bench.json";
@@ -55,6 +60,51 @@ private:
 
 DEF_BENCH( return new JsonBench; )
 
+// Parses all the Lottie files in resources/skottie.
+class JsonLottieBench : public Benchmark {
+protected:
+    const char* onGetName() override { return "json_skjson_lottie"; }
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+    void onPerCanvasPreDraw(SkCanvas*) override {
+        const auto dir = GetResourcePath("skottie");
+        SkOSFile::Iter it(dir.c_str(), ".json");
+        for (SkString name; it.next(&name);) {
+            if (auto data = SkData::MakeFromFileName(SkOSPath::Join(dir.c_str(),
+                                                                    name.c_str()).c_str())) {
+                fData.push_back(std::move(data));
+            }
+        }
+        if (fData.empty()) {
+            SkDebugf("!! Could not find Lottie files in: %s\n", dir.c_str());
+        }
+    }
+
+    void onPerCanvasPostDraw(SkCanvas*) override {
+        fData.clear();
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; i++) {
+            for (const auto& data : fData) {
+                skjson::DOM dom(static_cast<const char*>(data->data()), data->size());
+                if (dom.root().is<skjson::NullValue>()) {
+                    SkDebugf("!! Parsing failed.\n");
+                    return;
+                }
+            }
+        }
+    }
+
+private:
+    std::vector<sk_sp<SkData>> fData;
+
+    using INHERITED = Benchmark;
+};
+
+DEF_BENCH( return new JsonLottieBench; )
+
 #if (0)
 
 #include "rapidjson/document.h"
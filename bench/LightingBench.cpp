@@ -7,6 +7,7 @@
 #include "bench/Benchmark.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkPoint3.h"
+#include "include/effects/SkGradientShader.h"
 #include "include/effects/SkLightingImageFilter.h"
 
 #define FILTER_WIDTH_SMALL  SkIntToScalar(32)
@@ -230,6 +231,54 @@ private:
     typedef LightingBaseBench INHERITED;
 };
 
+// An emboss: a distant light over a surface whose height varies across the whole image, drawn
+// by a radial gradient, so no two neighbouring pixels have the same normal.
+class LightingEmbossBench : public LightingBaseBench {
+public:
+    LightingEmbossBench(bool specular) : INHERITED(false), fSpecular(specular) { }
+
+protected:
+    const char* onGetName() override {
+        return fSpecular ? "lightingemboss_specular" : "lightingemboss_diffuse";
+    }
+
+    void onDelayedSetup() override {
+        const SkPoint center = SkPoint::Make(FILTER_WIDTH_LARGE / 2, FILTER_HEIGHT_LARGE / 2);
+        const SkColor colors[] = { SK_ColorBLACK, SK_ColorTRANSPARENT, SK_ColorBLACK };
+        fShader = SkGradientShader::MakeRadial(center, FILTER_WIDTH_LARGE / 8, colors, nullptr,
+                                               SK_ARRAY_COUNT(colors), SkTileMode::kMirror);
+        fFilter = fSpecular
+                ? SkLightingImageFilter::MakeDistantLitSpecular(GetDistantDirection(),
+                                                                GetWhite(),
+                                                                GetSurfaceScale(),
+                                                                GetKs(),
+                                                                GetShininess(),
+                                                                nullptr)
+                : SkLightingImageFilter::MakeDistantLitDiffuse(GetDistantDirection(),
+                                                               GetWhite(),
+                                                               GetSurfaceScale(),
+                                                               GetKd(),
+                                                               nullptr);
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkPaint paint;
+        paint.setShader(fShader);
+        paint.setImageFilter(fFilter);
+        SkRect r = SkRect::MakeWH(FILTER_WIDTH_LARGE, FILTER_HEIGHT_LARGE);
+        for (int i = 0; i < loops; i++) {
+            canvas->drawRect(r, paint);
+        }
+    }
+
+private:
+    bool                 fSpecular;
+    sk_sp<SkShader>      fShader;
+    sk_sp<SkImageFilter> fFilter;
+
+    typedef LightingBaseBench INHERITED;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 
 DEF_BENCH( return new LightingPointLitDiffuseBench(true); )
@@ -244,3 +293,5 @@ DEF_BENCH( return new LightingDistantLitSpecularBench(true); )
 DEF_BENCH( return new LightingDistantLitSpecularBench(false); )
 DEF_BENCH( return new LightingSpotLitSpecularBench(true); )
 DEF_BENCH( return new LightingSpotLitSpecularBench(false); )
+DEF_BENCH( return new LightingEmbossBench(false); )
+DEF_BENCH( return new LightingEmbossBench(true); )
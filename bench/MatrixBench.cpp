@@ -6,6 +6,7 @@
  */
 #include "bench/Benchmark.h"
 #include "include/core/SkMatrix.h"
+#include "include/core/SkPoint3.h"
 #include "include/core/SkString.h"
 #include "include/utils/SkRandom.h"
 #include "src/core/SkMatrixUtils.h"
@@ -269,6 +270,7 @@ DEF_BENCH( return new InvertMapRectMatrixBench(
 static SkMatrix make_trans() { return SkMatrix::MakeTrans(2, 3); }
 static SkMatrix make_scale() { SkMatrix m(make_trans()); m.postScale(1.5f, 0.5f); return m; }
 static SkMatrix make_afine() { SkMatrix m(make_trans()); m.postRotate(15); return m; }
+static SkMatrix make_persp() { SkMatrix m(make_afine()); m.setPerspX(0.001f); return m; }
 
 class MapPointsMatrixBench : public MatrixBench {
 protected:
@@ -297,6 +299,34 @@ DEF_BENCH( return new MapPointsMatrixBench("mappoints_identity", SkMatrix::I());
 DEF_BENCH( return new MapPointsMatrixBench("mappoints_trans", make_trans()); )
 DEF_BENCH( return new MapPointsMatrixBench("mappoints_scale", make_scale()); )
 DEF_BENCH( return new MapPointsMatrixBench("mappoints_affine", make_afine()); )
+DEF_BENCH( return new MapPointsMatrixBench("mappoints_persp", make_persp()); )
+
+class MapHomogeneousPointsMatrixBench : public MatrixBench {
+    SkMatrix fM;
+    enum {
+        N = 32
+    };
+    SkPoint3 fSrc[N], fDst[N];
+public:
+    MapHomogeneousPointsMatrixBench(const char name[], const SkMatrix& m)
+        : MatrixBench(name), fM(m)
+    {
+        SkRandom rand;
+        for (int i = 0; i < N; ++i) {
+            fSrc[i].set(rand.nextSScalar1(), rand.nextSScalar1(), rand.nextSScalar1());
+        }
+    }
+
+    void performTest() override {
+        for (int i = 0; i < 1000000; ++i) {
+            fM.mapHomogeneousPoints(fDst, fSrc, N);
+        }
+    }
+};
+DEF_BENCH( return new MapHomogeneousPointsMatrixBench("maphomogeneouspoints_affine",
+                                                      make_afine()); )
+DEF_BENCH( return new MapHomogeneousPointsMatrixBench("maphomogeneouspoints_persp",
+                                                      make_persp()); )
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -9,6 +9,7 @@
 #include "include/core/SkPaint.h"
 #include "include/core/SkString.h"
 #include "include/effects/SkMatrixConvolutionImageFilter.h"
+#include "include/private/SkTemplates.h"
 #include "include/utils/SkRandom.h"
 
 static const char* name(SkMatrixConvolutionImageFilter::TileMode mode) {
@@ -68,3 +69,52 @@ DEF_BENCH( return new MatrixConvolutionBench(SkMatrixConvolutionImageFilter::kCl
 DEF_BENCH( return new MatrixConvolutionBench(SkMatrixConvolutionImageFilter::kRepeat_TileMode, true); )
 DEF_BENCH( return new MatrixConvolutionBench(SkMatrixConvolutionImageFilter::kClampToBlack_TileMode, true); )
 DEF_BENCH( return new MatrixConvolutionBench(SkMatrixConvolutionImageFilter::kClampToBlack_TileMode, false); )
+
+// Kernels too big for the GPU effect, drawn to a raster layer: a separable one, which is
+// applied as a row then a column, and one that isn't, which is applied with FFTs.
+class MatrixConvolutionLargeKernelBench : public Benchmark {
+public:
+    MatrixConvolutionLargeKernelBench(int kernelSize, bool separable)
+        : fName(SkStringPrintf("matrixconvolution_%s_%dx%d",
+                               separable ? "separable" : "general", kernelSize, kernelSize)) {
+        SkRandom rand;
+        SkAutoTMalloc<SkScalar> row(kernelSize), kernel(kernelSize * kernelSize);
+        for (int i = 0; i < kernelSize; ++i) {
+            row[i] = rand.nextUScalar1();
+        }
+        for (int y = 0; y < kernelSize; ++y) {
+            for (int x = 0; x < kernelSize; ++x) {
+                kernel[y * kernelSize + x] = separable ? row[x] * row[y] : rand.nextUScalar1();
+            }
+        }
+        SkScalar gain = 1.0f / (kernelSize * kernelSize), bias = 0;
+        SkIPoint kernelOffset = SkIPoint::Make(kernelSize / 2, kernelSize / 2);
+        fFilter = SkMatrixConvolutionImageFilter::Make(
+                SkISize::Make(kernelSize, kernelSize), kernel.get(), gain, bias, kernelOffset,
+                SkMatrixConvolutionImageFilter::kClamp_TileMode, true, nullptr);
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkPaint paint;
+        paint.setImageFilter(fFilter);
+        SkRect r = SkRect::MakeWH(256, 256);
+        for (int i = 0; i < loops; i++) {
+            canvas->drawOval(r, paint);
+        }
+    }
+
+private:
+    sk_sp<SkImageFilter> fFilter;
+    SkString fName;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH( return new MatrixConvolutionLargeKernelBench(15, true); )
+DEF_BENCH( return new MatrixConvolutionLargeKernelBench(15, false); )
+DEF_BENCH( return new MatrixConvolutionLargeKernelBench(31, false); )
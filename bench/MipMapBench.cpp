@@ -7,21 +7,30 @@
 
 #include "bench/Benchmark.h"
 #include "include/core/SkBitmap.h"
+#include "include/core/SkExecutor.h"
 #include "src/core/SkMipMap.h"
 
 class MipMapBench: public Benchmark {
     SkBitmap fBitmap;
     SkString fName;
     const int fW, fH;
-    bool fHalfFoat;
+    const SkColorType fColorType;
+    std::unique_ptr<SkExecutor> fExecutor;
 
 public:
-    MipMapBench(int w, int h, bool halfFloat = false)
-        : fW(w), fH(h), fHalfFoat(halfFloat)
+    MipMapBench(int w, int h, SkColorType ct = kN32_SkColorType, int threads = 0)
+        : fW(w), fH(h), fColorType(ct)
     {
         fName.printf("mipmap_build_%dx%d", w, h);
-        if (halfFloat) {
+        if (ct == kRGBA_F16_SkColorType) {
             fName.append("_f16");
+        } else if (ct == kAlpha_8_SkColorType) {
+            fName.append("_a8");
+        }
+        // Large levels are filtered in bands on the default SkExecutor.
+        if (threads > 0) {
+            fName.appendf("_%dthreads", threads);
+            fExecutor = SkExecutor::MakeFIFOThreadPool(threads);
         }
     }
 
@@ -33,17 +42,21 @@ protected:
     const char* onGetName() override { return fName.c_str(); }
 
     void onDelayedSetup() override {
-        SkColorType ct = fHalfFoat ? kRGBA_F16_SkColorType : kN32_SkColorType;
-        SkImageInfo info = SkImageInfo::Make(fW, fH, ct, kPremul_SkAlphaType,
+        SkImageInfo info = SkImageInfo::Make(fW, fH, fColorType, kPremul_SkAlphaType,
                                              SkColorSpace::MakeSRGB());
         fBitmap.allocPixels(info);
         fBitmap.eraseColor(SK_ColorWHITE);  // so we don't read uninitialized memory
     }
 
     void onDraw(int loops, SkCanvas*) override {
+        SkExecutor* defaultExecutor = &SkExecutor::GetDefault();
+        if (fExecutor) {
+            SkExecutor::SetDefault(fExecutor.get());
+        }
         for (int i = 0; i < loops * 4; i++) {
             SkMipMap::Build(fBitmap, nullptr)->unref();
         }
+        SkExecutor::SetDefault(defaultExecutor);
     }
 
 private:
@@ -58,10 +71,19 @@ DEF_BENCH( return new MipMapBench(512, 511); )
 DEF_BENCH( return new MipMapBench(511, 512); )
 DEF_BENCH( return new MipMapBench(512, 512); )
 
-DEF_BENCH( return new MipMapBench(512, 512, true); )
-DEF_BENCH( return new MipMapBench(511, 511, true); )
+DEF_BENCH( return new MipMapBench(512, 512, kRGBA_F16_SkColorType); )
+DEF_BENCH( return new MipMapBench(511, 511, kRGBA_F16_SkColorType); )
+
+DEF_BENCH( return new MipMapBench(512, 512, kAlpha_8_SkColorType); )
+DEF_BENCH( return new MipMapBench(511, 511, kAlpha_8_SkColorType); )
 
 DEF_BENCH( return new MipMapBench(2048, 2048); )
 DEF_BENCH( return new MipMapBench(2047, 2047); )
 DEF_BENCH( return new MipMapBench(2048, 2047); )
 DEF_BENCH( return new MipMapBench(2047, 2048); )
+
+DEF_BENCH( return new MipMapBench(4096, 4096); )
+DEF_BENCH( return new MipMapBench(4096, 4096, kRGBA_F16_SkColorType); )
+DEF_BENCH( return new MipMapBench(4096, 4096, kAlpha_8_SkColorType); )
+DEF_BENCH( return new MipMapBench(4096, 4096, kN32_SkColorType, 4); )
+DEF_BENCH( return new MipMapBench(4096, 4096, kRGBA_F16_SkColorType, 4); )
@@ -157,11 +157,14 @@ private:
     alternate zlib settings, usage, and library versions. */
 class PDFCompressionBench : public Benchmark {
 public:
-    PDFCompressionBench() {}
+    PDFCompressionBench(SkPDF::Metadata::CompressionLevel level, const char* levelName)
+        : fLevel(level) {
+        fName.printf("PDFCompression%s", levelName);
+    }
     ~PDFCompressionBench() override {}
 
 protected:
-    const char* onGetName() override { return "PDFCompression"; }
+    const char* onGetName() override { return fName.c_str(); }
     bool isSuitableFor(Backend backend) override {
         return backend == kNonRendering_Backend;
     }
@@ -171,15 +174,19 @@ protected:
     void onDraw(int loops, SkCanvas*) override {
         SkASSERT(fAsset);
         if (!fAsset) { return; }
+        SkPDF::Metadata metadata;
+        metadata.fCompressionLevel = fLevel;
         while (loops-- > 0) {
             SkNullWStream wStream;
-            SkPDFDocument doc(&wStream, SkPDF::Metadata());
+            SkPDFDocument doc(&wStream, metadata);
             doc.beginPage(256, 256);
             (void)SkPDFStreamOut(nullptr, fAsset->duplicate(), &doc, true);
        }
     }
 
 private:
+    SkPDF::Metadata::CompressionLevel fLevel;
+    SkString fName;
     std::unique_ptr<SkStreamAsset> fAsset;
 };
 
@@ -304,7 +311,11 @@ struct PDFClipPathBenchmark : public Benchmark {
 }  // namespace
 DEF_BENCH(return new PDFImageBench;)
 DEF_BENCH(return new PDFJpegImageBench;)
-DEF_BENCH(return new PDFCompressionBench;)
+DEF_BENCH(return new PDFCompressionBench(SkPDF::Metadata::kDefault_CompressionLevel, "");)
+DEF_BENCH(return new PDFCompressionBench(SkPDF::Metadata::kLowButFast_CompressionLevel,
+                                         "_fast");)
+DEF_BENCH(return new PDFCompressionBench(SkPDF::Metadata::kHighButSlow_CompressionLevel,
+                                         "_small");)
 DEF_BENCH(return new PDFColorComponentBench;)
 DEF_BENCH(return new PDFShaderBench;)
 DEF_BENCH(return new WritePDFTextBenchmark;)
@@ -411,18 +422,19 @@ SkBitmap make_background() {
 
 struct PDFBigDocBench : public Benchmark {
     bool fFast;
+    SkPDF::Metadata::CompressionLevel fLevel;
+    SkString fName;
     SkBitmap fBackground;
     std::unique_ptr<SkExecutor> fExecutor;
-    PDFBigDocBench(bool fast) : fFast(fast) {}
+    PDFBigDocBench(bool fast, SkPDF::Metadata::CompressionLevel level, const char* levelName)
+        : fFast(fast), fLevel(level) {
+        fName.printf("PDFBigDocBench_%s%s", fast ? "fast" : "slow", levelName);
+    }
     void onDelayedSetup() override {
         fBackground = make_background();
         fExecutor = fFast ? SkExecutor::MakeFIFOThreadPool() : nullptr;
     }
-    const char* onGetName() override {
-        static const char kNameFast[] = "PDFBigDocBench_fast";
-        static const char kNameSlow[] = "PDFBigDocBench_slow";
-        return fFast ? kNameFast : kNameSlow;
-    }
+    const char* onGetName() override { return fName.c_str(); }
     bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
     void onDraw(int loops, SkCanvas*) override {
         while (loops-- > 0) {
@@ -433,14 +445,19 @@ struct PDFBigDocBench : public Benchmark {
             #endif
             SkPDF::Metadata metadata;
             metadata.fExecutor = fExecutor.get();
+            metadata.fCompressionLevel = fLevel;
             auto doc = SkPDF::MakeDocument(&wStream, metadata);
             big_pdf_test(doc.get(), fBackground);
         }
     }
 };
 }  // namespace
-DEF_BENCH(return new PDFBigDocBench(false);)
-DEF_BENCH(return new PDFBigDocBench(true);)
+DEF_BENCH(return new PDFBigDocBench(false, SkPDF::Metadata::kDefault_CompressionLevel, "");)
+DEF_BENCH(return new PDFBigDocBench(true, SkPDF::Metadata::kDefault_CompressionLevel, "");)
+DEF_BENCH(return new PDFBigDocBench(true, SkPDF::Metadata::kLowButFast_CompressionLevel,
+                                    "_fastcompression");)
+DEF_BENCH(return new PDFBigDocBench(true, SkPDF::Metadata::kNone_CompressionLevel,
+                                    "_nocompression");)
 #endif
 
 #endif // SK_SUPPORT_PDF
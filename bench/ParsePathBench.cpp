@@ -0,0 +1,137 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkString.h"
+#include "include/utils/SkParse.h"
+#include "include/utils/SkParsePath.h"
+#include "include/utils/SkRandom.h"
+
+// Parses SVG path data the way an app loading its icons at startup would.
+class ParsePathBench : public Benchmark {
+public:
+    enum class Data {
+        kIcon,       // A short path with mixed, relative commands.
+        kPolyline,   // A long run of absolute line segments.
+        kCurves,     // A long run of relative cubics.
+    };
+
+    ParsePathBench(Data data) : fData(data) {
+        switch (fData) {
+            case Data::kIcon:
+                fName = "parsepath_icon";
+                break;
+            case Data::kPolyline:
+                fName = "parsepath_polyline";
+                break;
+            case Data::kCurves:
+                fName = "parsepath_curves";
+                break;
+        }
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        SkRandom rand;
+        switch (fData) {
+            case Data::kIcon:
+                // Material Design "settings".
+                fPathData = "M19.43 12.98c.04-.32.07-.64.07-.98s-.03-.66-.07-.98l2.11-1.65c.19-.15"
+                            ".24-.42.12-.64l-2-3.46c-.12-.22-.39-.3-.61-.22l-2.49 1c-.52-.4-1.08-."
+                            "73-1.69-.98l-.38-2.65C14.46 2.18 14.25 2 14 2h-4c-.25 0-.46.18-.49.42l"
+                            "-.38 2.65c-.61.25-1.17.59-1.69.98l-2.49-1c-.23-.09-.49 0-.61.22l-2 3."
+                            "46c-.13.22-.07.49.12.64l2.11 1.65c-.04.32-.07.65-.07.98s.03.66.07.98l"
+                            "-2.11 1.65c-.19.15-.24.42-.12.64l2 3.46c.12.22.39.3.61.22l2.49-1c.52."
+                            "4 1.08.73 1.69.98l.38 2.65c.03.24.24.42.49.42h4c.25 0 .46-.18.49-.42l"
+                            ".38-2.65c.61-.25 1.17-.59 1.69-.98l2.49 1c.23.09.49 0 .61-.22l2-3.46c"
+                            ".12-.22.07-.49-.12-.64l-2.11-1.65zM12 15.5c-1.93 0-3.5-1.57-3.5-3.5s1"
+                            ".57-3.5 3.5-3.5 3.5 1.57 3.5 3.5-1.57 3.5-3.5 3.5z";
+                break;
+            case Data::kPolyline:
+                fPathData.printf("M%.2f %.2f", rand.nextRangeF(0, 1000), rand.nextRangeF(0, 1000));
+                for (int i = 0; i < 1000; ++i) {
+                    fPathData.appendf("L%.2f %.2f",
+                                      rand.nextRangeF(0, 1000), rand.nextRangeF(0, 1000));
+                }
+                fPathData.append("Z");
+                break;
+            case Data::kCurves:
+                fPathData = "m500 500";
+                for (int i = 0; i < 1000; ++i) {
+                    fPathData.append("c");
+                    for (int j = 0; j < 6; ++j) {
+                        fPathData.appendf("%s%.3f", j ? "," : "", rand.nextRangeF(-10, 10));
+                    }
+                }
+                break;
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkPath path;
+        for (int i = 0; i < loops; ++i) {
+            SkParsePath::FromSVGString(fPathData.c_str(), &path);
+        }
+    }
+
+private:
+    const Data fData;
+    SkString   fName;
+    SkString   fPathData;
+
+    typedef Benchmark INHERITED;
+};
+
+// Parses lists of scalars, as SVG attributes and path data are made of.
+class ParseScalarsBench : public Benchmark {
+public:
+    ParseScalarsBench() {}
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override {
+        return "parse_scalars";
+    }
+
+    void onDelayedSetup() override {
+        SkRandom rand;
+        for (int i = 0; i < kNumScalars; ++i) {
+            fData.appendf("%s%g", i ? " " : "", rand.nextRangeF(-1000, 1000));
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkScalar values[kNumScalars];
+        for (int i = 0; i < loops; ++i) {
+            SkParse::FindScalars(fData.c_str(), values, kNumScalars);
+        }
+    }
+
+private:
+    static constexpr int kNumScalars = 1000;
+
+    SkString fData;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH( return new ParsePathBench(ParsePathBench::Data::kIcon); )
+DEF_BENCH( return new ParsePathBench(ParsePathBench::Data::kPolyline); )
+DEF_BENCH( return new ParsePathBench(ParsePathBench::Data::kCurves); )
+DEF_BENCH( return new ParseScalarsBench(); )
@@ -1175,6 +1175,74 @@ DEF_BENCH( return new ConservativelyContainsBench(ConservativelyContainsBench::k
 DEF_BENCH( return new ConservativelyContainsBench(ConservativelyContainsBench::kRoundRect_Type); )
 DEF_BENCH( return new ConservativelyContainsBench(ConservativelyContainsBench::kOval_Type); )
 
+// Times computing the convexity of a path from scratch, as for a path that was just built.
+class PathConvexityBench : public Benchmark {
+public:
+    enum Type {
+        kPolygon_Type,  // convex, all lines
+        kStar_Type,     // turns the same way at every point, but isn't convex
+        kRRect_Type,    // convex, lines and conics
+    };
+
+    PathConvexityBench(Type type, int pointCount = 0) {
+        static const char* kNames[] = { "polygon", "star", "rrect" };
+        fName.printf("path_convexity_%s", kNames[type]);
+        if (pointCount) {
+            fName.appendf("_%d", pointCount);
+        }
+        switch (type) {
+            case kPolygon_Type:
+            case kStar_Type: {
+                // A star visits every other point of a polygon with an odd number of them.
+                int count = pointCount | 1;
+                int step = kStar_Type == type ? 2 : 1;
+                for (int i = 0; i < count; ++i) {
+                    SkScalar angle = 2 * SK_ScalarPI * (i * step % count) / count;
+                    SkPoint pt = { 100 + 90 * SkScalarCos(angle), 100 + 90 * SkScalarSin(angle) };
+                    if (0 == i) {
+                        fPath.moveTo(pt);
+                    } else {
+                        fPath.lineTo(pt);
+                    }
+                }
+                fPath.close();
+                break;
+            }
+            case kRRect_Type:
+                fPath.addRoundRect(SkRect::MakeWH(200, 100), 20, 20);
+                break;
+        }
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+private:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            fPath.setConvexity(SkPath::kUnknown_Convexity);
+            fParity = fParity != (SkPath::kConvex_Convexity == fPath.getConvexity());
+        }
+    }
+
+    SkString fName;
+    SkPath   fPath;
+    bool     fParity = false;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH( return new PathConvexityBench(PathConvexityBench::kPolygon_Type, 16); )
+DEF_BENCH( return new PathConvexityBench(PathConvexityBench::kPolygon_Type, 512); )
+DEF_BENCH( return new PathConvexityBench(PathConvexityBench::kStar_Type, 16); )
+DEF_BENCH( return new PathConvexityBench(PathConvexityBench::kStar_Type, 512); )
+DEF_BENCH( return new PathConvexityBench(PathConvexityBench::kRRect_Type); )
+
 #include "include/pathops/SkPathOps.h"
 #include "src/core/SkPathPriv.h"
 
@@ -1242,3 +1310,86 @@ DEF_BENCH( return new CommonConvexBench(200, 16, false, false); )
 DEF_BENCH( return new CommonConvexBench(200, 16, true,  false); )
 DEF_BENCH( return new CommonConvexBench(200, 16, false, true); )
 DEF_BENCH( return new CommonConvexBench(200, 16, true,  true); )
+
+#include "src/core/SkScan.h"
+
+// Fills the same dense paths with each of the raster anti-aliasing scan converters.
+class AAModePathBench : public Benchmark {
+public:
+    enum Mode { kSupersample_Mode, kAnalytic_Mode, kAccumulation_Mode };
+    enum Shape { kChart_Shape, kMap_Shape };
+
+    AAModePathBench(Shape shape, Mode mode) : fMode(mode) {
+        static const char* kModeNames[] = { "saa", "aaa", "accumulation" };
+        fName.printf("path_fill_aa_mode_%s_%s", shape == kChart_Shape ? "chart" : "map",
+                     kModeNames[mode]);
+
+        SkRandom rand;
+        if (shape == kChart_Shape) {
+            // One long area chart across the whole canvas.
+            fPath.moveTo(0, 512);
+            for (int x = 0; x <= 512; x += 2) {
+                fPath.lineTo(SkIntToScalar(x), 128 + rand.nextF() * 256);
+            }
+            fPath.lineTo(512, 512);
+            fPath.close();
+        } else {
+            // Lots of small, overlapping polygons.
+            for (int i = 0; i < 300; ++i) {
+                SkScalar cx = rand.nextF() * 480 + 16,
+                         cy = rand.nextF() * 480 + 16;
+                fPath.moveTo(cx + rand.nextSScalar1() * 16, cy + rand.nextSScalar1() * 16);
+                for (int j = 0; j < 5; ++j) {
+                    fPath.lineTo(cx + rand.nextSScalar1() * 16, cy + rand.nextSScalar1() * 16);
+                }
+                fPath.close();
+            }
+        }
+    }
+
+protected:
+    bool isSuitableFor(Backend backend) override {
+        return backend == kRaster_Backend;
+    }
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        const bool useAnalytic     = gSkUseAnalyticAA,
+                   forceAnalytic   = gSkForceAnalyticAA,
+                   useAccumulation = gSkUseAccumulationAA;
+        gSkUseAnalyticAA     = fMode == kAnalytic_Mode;
+        gSkForceAnalyticAA   = fMode == kAnalytic_Mode;
+        gSkUseAccumulationAA = fMode == kAccumulation_Mode;
+
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        for (int i = 0; i < loops; ++i) {
+            canvas->drawPath(fPath, paint);
+        }
+
+        gSkUseAnalyticAA     = useAnalytic;
+        gSkForceAnalyticAA   = forceAnalytic;
+        gSkUseAccumulationAA = useAccumulation;
+    }
+
+private:
+    SkString fName;
+    SkPath   fPath;
+    Mode     fMode;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH( return new AAModePathBench(AAModePathBench::kChart_Shape,
+                                      AAModePathBench::kSupersample_Mode); )
+DEF_BENCH( return new AAModePathBench(AAModePathBench::kChart_Shape,
+                                      AAModePathBench::kAnalytic_Mode); )
+DEF_BENCH( return new AAModePathBench(AAModePathBench::kChart_Shape,
+                                      AAModePathBench::kAccumulation_Mode); )
+DEF_BENCH( return new AAModePathBench(AAModePathBench::kMap_Shape,
+                                      AAModePathBench::kSupersample_Mode); )
+DEF_BENCH( return new AAModePathBench(AAModePathBench::kMap_Shape,
+                                      AAModePathBench::kAnalytic_Mode); )
+DEF_BENCH( return new AAModePathBench(AAModePathBench::kMap_Shape,
+                                      AAModePathBench::kAccumulation_Mode); )
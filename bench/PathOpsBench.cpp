@@ -96,3 +96,57 @@ static SkPath makerects() {
 }
 
 DEF_BENCH( return new PathOpsSimplifyBench("rects", makerects()); )
+
+// Unions many small building-like footprints, most of which overlap only a neighbor or two, as
+// in a map tile.
+class PathOpsBuilderBench : public Benchmark {
+    SkString         fName;
+    SkTArray<SkPath> fPaths;
+
+public:
+    PathOpsBuilderBench(const char suffix[], int count) {
+        fName.printf("pathops_builder_%s", suffix);
+
+        SkRandom rand;
+        for (int i = 0; i < count; ++i) {
+            SkScalar x = rand.nextRangeScalar(0, 1000);
+            SkScalar y = rand.nextRangeScalar(0, 1000);
+            SkScalar w = rand.nextRangeScalar(4, 12);
+            SkScalar h = rand.nextRangeScalar(4, 12);
+            SkPath& path = fPaths.push_back();
+            path.moveTo(x, y);
+            path.lineTo(x + w, y);
+            path.lineTo(x + w, y + h / 2);
+            path.lineTo(x + w / 2, y + h / 2);
+            path.lineTo(x + w / 2, y + h);
+            path.lineTo(x, y + h);
+            path.close();
+        }
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        for (int i = 0; i < loops; i++) {
+            SkOpBuilder builder;
+            for (const SkPath& path : fPaths) {
+                builder.add(path, kUnion_SkPathOp);
+            }
+            SkPath result;
+            builder.resolve(&result);
+        }
+    }
+
+private:
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH( return new PathOpsBuilderBench("footprints_100", 100); )
+DEF_BENCH( return new PathOpsBuilderBench("footprints_2000", 2000); )
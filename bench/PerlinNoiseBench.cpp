@@ -7,23 +7,35 @@
 #include "bench/Benchmark.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkShader.h"
+#include "include/core/SkString.h"
 #include "include/effects/SkPerlinNoiseShader.h"
 
 class PerlinNoiseBench : public Benchmark {
-    SkISize fSize;
+    SkISize  fSize;
+    bool     fTurbulence;
+    bool     fStitchTiles;
+    SkString fName;
 
 public:
-    PerlinNoiseBench()  {
+    PerlinNoiseBench(bool turbulence = false, bool stitchTiles = false)
+            : fTurbulence(turbulence), fStitchTiles(stitchTiles) {
         fSize = SkISize::Make(80, 80);
+        fName.set("perlinnoise");
+        if (turbulence) {
+            fName.append("_turbulence");
+        }
+        if (stitchTiles) {
+            fName.append("_stitched");
+        }
     }
 
 protected:
     const char* onGetName() override {
-        return "perlinnoise";
+        return fName.c_str();
     }
 
     void onDraw(int loops, SkCanvas* canvas) override {
-        this->test(loops, canvas, 0, 0, 0.1f, 0.1f, 3, 0, false);
+        this->test(loops, canvas, 0, 0, 0.1f, 0.1f, 3, 0, fStitchTiles);
     }
 
 private:
@@ -41,10 +53,15 @@ private:
     void test(int loops, SkCanvas* canvas, int x, int y,
               float baseFrequencyX, float baseFrequencyY, int numOctaves, float seed,
               bool stitchTiles) {
+        // On the GPU, every draw makes a new fragment processor, but they all share one set of
+        // noise textures.
         SkPaint paint;
-        paint.setShader(SkPerlinNoiseShader::MakeFractalNoise(baseFrequencyX, baseFrequencyY,
-                                                              numOctaves, seed,
-                                                              stitchTiles ? &fSize : nullptr));
+        const SkISize* tileSize = stitchTiles ? &fSize : nullptr;
+        paint.setShader(fTurbulence
+                ? SkPerlinNoiseShader::MakeTurbulence(baseFrequencyX, baseFrequencyY,
+                                                      numOctaves, seed, tileSize)
+                : SkPerlinNoiseShader::MakeFractalNoise(baseFrequencyX, baseFrequencyY,
+                                                        numOctaves, seed, tileSize));
         for (int i = 0; i < loops; i++) {
             this->drawClippedRect(canvas, x, y, paint);
         }
@@ -56,3 +73,5 @@ private:
 ///////////////////////////////////////////////////////////////////////////////
 
 DEF_BENCH( return new PerlinNoiseBench(); )
+DEF_BENCH( return new PerlinNoiseBench(true, false); )
+DEF_BENCH( return new PerlinNoiseBench(false, true); )
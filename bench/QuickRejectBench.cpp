@@ -7,7 +7,9 @@
 
 #include "bench/Benchmark.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkString.h"
 #include "include/utils/SkRandom.h"
+#include "src/core/SkCanvasPriv.h"
 
 class QuickRejectBench : public Benchmark {
     enum { N = 1000000 };
@@ -38,6 +40,58 @@ class QuickRejectBench : public Benchmark {
 };
 DEF_BENCH( return new QuickRejectBench; )
 
+// Tests an array of rects, one at a time with quickReject() or all at once with
+// SkCanvasPriv::QuickReject(), under an identity or a scale+translate matrix.
+class QuickRejectRectsBench : public Benchmark {
+    enum { N = 250000 };
+    SkRect fRects[N];
+    bool   fRejected[N];
+    bool   fBatch;
+    bool   fScaled;
+    SkString fName;
+
+    const char* onGetName() override { return fName.c_str(); }
+    bool isSuitableFor(Backend backend) override { return backend != kNonRendering_Backend; }
+
+public:
+    QuickRejectRectsBench(bool batch, bool scaled) : fBatch(batch), fScaled(scaled) {
+        fName.printf("quick_reject_rects%s%s", batch ? "_batch" : "", scaled ? "_scaled" : "");
+    }
+
+private:
+    void onDelayedSetup() override  {
+        SkRandom rand;
+        for (int i = 0; i < N; ++i) {
+            float l = 300.0f * (rand.nextSScalar1() + 0.5f),
+                  t = 300.0f * (rand.nextSScalar1() + 0.5f);
+            fRects[i] = SkRect::MakeXYWH(l, t, 300.0f * rand.nextUScalar1(),
+                                         300.0f * rand.nextUScalar1());
+        }
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        canvas->save();
+        if (fScaled) {
+            canvas->translate(-20.0f, 10.0f);
+            canvas->scale(1.5f, 0.75f);
+        }
+        while (loops --> 0) {
+            if (fBatch) {
+                SkCanvasPriv::QuickReject(*canvas, fRects, N, fRejected);
+            } else {
+                for (int i = 0; i < N; i++) {
+                    fRejected[i] = canvas->quickReject(fRects[i]);
+                }
+            }
+        }
+        canvas->restore();
+    }
+};
+DEF_BENCH( return new QuickRejectRectsBench(false, false); )
+DEF_BENCH( return new QuickRejectRectsBench(false, true); )
+DEF_BENCH( return new QuickRejectRectsBench(true, false); )
+DEF_BENCH( return new QuickRejectRectsBench(true, true); )
+
 class ConcatBench : public Benchmark {
     SkMatrix fMatrix;
 
@@ -61,6 +61,60 @@ DEF_BENCH( return new ReadPixBench(kBGRA_8888_SkColorType, kUnpremul_SkAlphaType
 DEF_BENCH( return new ReadPixBench(kBGRA_8888_SkColorType, kPremul_SkAlphaType, SkColorSpace::MakeSRGB()); )
 DEF_BENCH( return new ReadPixBench(kBGRA_8888_SkColorType, kUnpremul_SkAlphaType, SkColorSpace::MakeSRGB()); )
 
+// Converts an opaque sRGB image, as if just decoded, to another color space.
+class ConvertPixelsBench : public Benchmark {
+public:
+    ConvertPixelsBench(sk_sp<SkColorSpace> dstCS, SkColorType dstCT, const char* label)
+        : fDstCS(std::move(dstCS)), fDstCT(dstCT) {
+        fName.printf("convertpix_srgb_to_%s", label);
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        fSrc.allocPixels(SkImageInfo::Make(1024, 1024, kRGBA_8888_SkColorType,
+                                           kOpaque_SkAlphaType, SkColorSpace::MakeSRGB()));
+        for (int y = 0; y < fSrc.height(); ++y) {
+            for (int x = 0; x < fSrc.width(); ++x) {
+                *fSrc.getAddr32(x, y) = 0xff000000 | (x * 0x010203 + y * 0x030201);
+            }
+        }
+        fDst.allocPixels(fSrc.info().makeColorType(fDstCT).makeColorSpace(fDstCS));
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; ++i) {
+            fSrc.readPixels(fDst.pixmap());
+        }
+    }
+
+private:
+    sk_sp<SkColorSpace> fDstCS;
+    SkColorType         fDstCT;
+    SkString            fName;
+    SkBitmap            fSrc, fDst;
+
+    typedef Benchmark INHERITED;
+};
+DEF_BENCH( return new ConvertPixelsBench(SkColorSpace::MakeSRGBLinear(),
+                                         kRGBA_8888_SkColorType, "linear"); )
+DEF_BENCH( return new ConvertPixelsBench(SkColorSpace::MakeRGB(SkNamedTransferFn::kSRGB,
+                                                               SkNamedGamut::kDCIP3),
+                                         kRGBA_8888_SkColorType, "p3"); )
+DEF_BENCH( return new ConvertPixelsBench(SkColorSpace::MakeRGB(SkNamedTransferFn::kSRGB,
+                                                               SkNamedGamut::kDCIP3),
+                                         kBGRA_8888_SkColorType, "p3_bgra"); )
+DEF_BENCH( return new ConvertPixelsBench(SkColorSpace::MakeRGB(SkNamedTransferFn::kRec2020,
+                                                               SkNamedGamut::kRec2020),
+                                         kRGBA_8888_SkColorType, "rec2020"); )
+
 ////////////////////////////////////////////////////////////////////////////////
 #include "include/core/SkBitmap.h"
 #include "src/core/SkPixmapPriv.h"
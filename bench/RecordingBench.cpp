@@ -32,16 +32,21 @@ SkIPoint PictureCentricBench::onGetSize() {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
-RecordingBench::RecordingBench(const char* name, const SkPicture* pic, bool useBBH)
+RecordingBench::RecordingBench(const char* name, const SkPicture* pic, bool useBBH,
+                               bool cullOccludedDraws)
     : INHERITED(name, pic)
     , fUseBBH(useBBH)
+    , fCullOccludedDraws(cullOccludedDraws)
 {}
 
 void RecordingBench::onDraw(int loops, SkCanvas*) {
     SkRTreeFactory factory;
     SkPictureRecorder recorder;
+    const uint32_t flags = fCullOccludedDraws ? SkPictureRecorder::kCullOccludedDraws_RecordFlag
+                                              : 0;
     while (loops --> 0) {
-        fSrc->playback(recorder.beginRecording(fSrc->cullRect(), fUseBBH ? &factory : nullptr));
+        fSrc->playback(recorder.beginRecording(fSrc->cullRect(), fUseBBH ? &factory : nullptr,
+                                               flags));
         (void)recorder.finishRecordingAsPicture();
     }
 }
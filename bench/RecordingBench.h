@@ -29,13 +29,15 @@ protected:
 
 class RecordingBench : public PictureCentricBench {
 public:
-    RecordingBench(const char* name, const SkPicture*, bool useBBH);
+    RecordingBench(const char* name, const SkPicture*, bool useBBH,
+                   bool cullOccludedDraws = false);
 
 protected:
     void onDraw(int loops, SkCanvas*) override;
 
 private:
     bool fUseBBH;
+    bool fCullOccludedDraws;
 
     typedef PictureCentricBench INHERITED;
 };
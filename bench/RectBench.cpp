@@ -125,6 +125,11 @@ protected:
         paint->setBlendMode(fMode);
     }
 
+    // Filling rects on the CPU should only need the stack and the blitter's arena.
+    int allocationsPerLoopLimit(Backend backend) const override {
+        return kRaster_Backend == backend ? 0 : -1;
+    }
+
     const char* onGetName() override {
         fName.set(this->INHERITED::onGetName());
         fName.prepend("srcmode_");
@@ -149,6 +154,10 @@ protected:
         paint->setAlpha(0x80);
     }
 
+    int allocationsPerLoopLimit(Backend backend) const override {
+        return kRaster_Backend == backend ? 0 : -1;
+    }
+
     const char* onGetName() override {
         fName.set(this->INHERITED::onGetName());
         fName.prepend("transparent_");
@@ -160,6 +169,32 @@ private:
     typedef RectBench INHERITED;
 };
 
+// Draws every rect with the same color, like the bars of a chart.
+class SameColorRectBench : public RectBench {
+public:
+    SameColorRectBench(int shift, bool aa) : INHERITED(shift, 0, aa) {}
+
+protected:
+    void setupPaint(SkPaint* paint) override {
+        this->INHERITED::setupPaint(paint);
+        paint->setColor(0xFF3366CC);
+    }
+
+    int allocationsPerLoopLimit(Backend backend) const override {
+        return kRaster_Backend == backend ? 0 : -1;
+    }
+
+    const char* onGetName() override {
+        fName.set(this->INHERITED::onGetName());
+        fName.prepend("samecolor_");
+        return fName.c_str();
+    }
+
+private:
+    SkString fName;
+    typedef RectBench INHERITED;
+};
+
 // Adds a shader to the paint that requires local coordinates to be used
 class LocalCoordsRectBench : public RectBench {
 public:
@@ -358,6 +393,9 @@ DEF_BENCH(return new SrcModeRectBench();)
 
 DEF_BENCH(return new TransparentRectBench();)
 
+DEF_BENCH(return new SameColorRectBench(5, false);)
+DEF_BENCH(return new SameColorRectBench(5, true);)
+
 DEF_BENCH(return new LocalCoordsRectBench(true);)
 DEF_BENCH(return new LocalCoordsRectBench(false);)
 
@@ -7,6 +7,7 @@
 #include "bench/Benchmark.h"
 #include "include/core/SkRegion.h"
 #include "include/core/SkString.h"
+#include "include/private/SkTArray.h"
 #include "include/utils/SkRandom.h"
 
 static bool union_proc(SkRegion& a, SkRegion& b) {
@@ -129,3 +130,40 @@ DEF_BENCH(return new RegionBench(SMALL, containsrect_proc, "containsrect");)
 DEF_BENCH(return new RegionBench(SMALL, sectsrgn_proc, "intersectsrgn");)
 DEF_BENCH(return new RegionBench(SMALL, sectsrect_proc, "intersectsrect");)
 DEF_BENCH(return new RegionBench(SMALL, containsxy_proc, "containsxy");)
+
+// Builds a region from many small rects at once, like a frame's worth of damage.
+class RegionSetRectsBench : public Benchmark {
+public:
+    RegionSetRectsBench(int count) {
+        fName.printf("region_setrects_%d", count);
+        SkRandom rand;
+        for (int i = 0; i < count; i++) {
+            fRects.push_back(SkIRect::MakeXYWH(rand.nextULessThan(1900), rand.nextULessThan(1060),
+                                               8 + rand.nextULessThan(60),
+                                               8 + rand.nextULessThan(30)));
+        }
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        for (int i = 0; i < loops; ++i) {
+            SkRegion rgn;
+            rgn.setRects(fRects.begin(), fRects.count());
+        }
+    }
+
+private:
+    SkTArray<SkIRect> fRects;
+    SkString          fName;
+
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH(return new RegionSetRectsBench(SMALL);)
+DEF_BENCH(return new RegionSetRectsBench(1000);)
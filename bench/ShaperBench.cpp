@@ -12,14 +12,22 @@
 
 namespace {
 struct ShaperBench : public Benchmark {
-    ShaperBench(const char* r, const char* n) : fResource(r), fName(n) {}
+    ShaperBench(const char* r, const char* n, bool cached = false)
+        : fResource(r), fName(n), fCached(cached) {}
     std::unique_ptr<SkShaper> fShaper;
     sk_sp<SkData> fData;
     const char* fResource;
     const char* fName;
+    bool fCached;
     const char* onGetName() override { return fName; }
     bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
     void onDelayedSetup() override {
+        #ifdef SK_SHAPER_HARFBUZZ_AVAILABLE
+        if (fCached) {
+            fShaper = SkShaper::MakeCachingShaperDrivenWrapper();
+            return;
+        }
+        #endif
         fShaper = SkShaper::Make();
         fData = GetResourceAsData(fResource);
     }
@@ -74,4 +82,16 @@ SHAPER_BENCH(tifnagh)
 SHAPER_BENCH(vai)
 #undef SHAPER_BENCH
 
+// The same text shaped again each loop, as when a UI lays out the same strings every frame.
+#ifdef SK_SHAPER_HARFBUZZ_AVAILABLE
+#define CACHED_SHAPER_BENCH(X) \
+    DEF_BENCH(return new ShaperBench("text/" #X ".txt", "shaper_cached_" #X, true);)
+CACHED_SHAPER_BENCH(arabic)
+CACHED_SHAPER_BENCH(devanagari)
+CACHED_SHAPER_BENCH(english)
+CACHED_SHAPER_BENCH(han_simplified)
+CACHED_SHAPER_BENCH(thai)
+#undef CACHED_SHAPER_BENCH
+#endif
+
 #endif  // !defined(SK_BUILD_FOR_ANDROID_FRAMEWORK) && !defined(SK_BUILD_FOR_GOOGLE3)
@@ -10,7 +10,9 @@
 
 #include "bench/Benchmark.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkGraphics.h"
+#include "include/core/SkSurface.h"
 #include "include/core/SkTypeface.h"
 #include "src/core/SkStrikeCache.h"
 #include "src/core/SkTaskGroup.h"
@@ -110,7 +112,166 @@ private:
     SkString fName;
 };
 
+// First-paint cost of a strike: rasterize every glyph image into an empty strike, either one at
+// a time through findImage() or in a batch through prepareImages().
+class SkGlyphCachePrepareImages : public Benchmark {
+public:
+    explicit SkGlyphCachePrepareImages(int threads) : fThreads(threads) { }
+
+protected:
+    const char* onGetName() override {
+        fName.printf("SkGlyphCachePrepareImages_%d", fThreads);
+        return fName.c_str();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        if (fThreads > 0) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        }
+        fFont.setEdging(SkFont::Edging::kAntiAlias);
+        fFont.setSubpixel(true);
+        fFont.setSize(48);
+        fFont.setTypeface(ToolUtils::create_portable_typeface("serif", SkFontStyle::Italic()));
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int work = 0; work < loops; work++) {
+            SkStrikeCache::PurgeAll();
+            auto cache = SkStrikeCache::FindOrCreateStrikeWithNoDeviceExclusive(fFont);
+            std::vector<SkPackedGlyphID> glyphIDs;
+            for (SkFixed x = 0; x < SK_Fixed1; x += SK_FixedQuarter) {
+                for (int c = ' '; c < 'z'; c++) {
+                    glyphIDs.push_back(SkPackedGlyphID(fFont.unicharToGlyph(c), x, 0));
+                }
+            }
+            if (fExecutor) {
+                cache->prepareImages(
+                        SkSpan<const SkPackedGlyphID>(glyphIDs.data(), glyphIDs.size()),
+                        fExecutor.get());
+            } else {
+                for (SkPackedGlyphID glyphID : glyphIDs) {
+                    cache->findImage(cache->getGlyphIDMetrics(glyphID));
+                }
+            }
+        }
+    }
+
+private:
+    typedef Benchmark INHERITED;
+    const int fThreads;
+    std::unique_ptr<SkExecutor> fExecutor;
+    SkFont fFont;
+    SkString fName;
+};
+
+// Many raster threads drawing the same, already cached, text. With exclusive strikes every lookup
+// takes the cache's lock and detaches the strike; with shared strikes hits take no lock at all.
+class SkGlyphCacheDrawFromThreads : public Benchmark {
+public:
+    explicit SkGlyphCacheDrawFromThreads(bool shared) : fShared(shared) { }
+
+protected:
+    const char* onGetName() override {
+        return fShared ? "SkGlyphCacheDrawFromThreads_shared"
+                       : "SkGlyphCacheDrawFromThreads_exclusive";
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        fFont.setEdging(SkFont::Edging::kAntiAlias);
+        fFont.setSubpixel(true);
+        fFont.setSize(16);
+        fFont.setTypeface(ToolUtils::create_portable_typeface("serif", SkFontStyle()));
+        for (int i = 0; i < kThreads; i++) {
+            fSurfaces[i] = SkSurface::MakeRasterN32Premul(256, 32);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        bool oldShared = SkGraphics::SetFontCacheSharedStrikes(fShared);
+        static const char kText[] = "The quick brown fox jumps over the lazy dog.";
+        SkTaskGroup().batch(kThreads, [&](int threadIndex) {
+            SkCanvas* canvas = fSurfaces[threadIndex]->getCanvas();
+            SkPaint paint;
+            for (int work = 0; work < loops; work++) {
+                canvas->drawSimpleText(kText, sizeof(kText) - 1, SkTextEncoding::kUTF8,
+                                       4, 20, fFont, paint);
+            }
+        });
+        SkGraphics::SetFontCacheSharedStrikes(oldShared);
+    }
+
+private:
+    typedef Benchmark INHERITED;
+    static constexpr int kThreads = 16;
+    const bool fShared;
+    sk_sp<SkSurface> fSurfaces[kThreads];
+    SkFont fFont;
+};
+
+// Layout asking for the advances, bounds, and outlines of the same glyphs, either in separate
+// passes or all at once through getWidthsBoundsPaths().
+class SkGlyphCacheWidthsBoundsPaths : public Benchmark {
+public:
+    explicit SkGlyphCacheWidthsBoundsPaths(bool batched) : fBatched(batched) { }
+
+protected:
+    const char* onGetName() override {
+        return fBatched ? "SkGlyphCacheWidthsBoundsPaths_batched"
+                        : "SkGlyphCacheWidthsBoundsPaths_separate";
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        fFont.setSize(24);
+        fFont.setTypeface(ToolUtils::create_portable_typeface("serif", SkFontStyle()));
+        for (int c = ' '; c < 'z'; c++) {
+            fGlyphs[c - ' '] = fFont.unicharToGlyph(c);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkScalar widths[kCount];
+        SkRect bounds[kCount];
+        SkPath paths[kCount];
+        for (int work = 0; work < loops; work++) {
+            if (fBatched) {
+                fFont.getWidthsBoundsPaths(fGlyphs, kCount, widths, bounds, paths);
+            } else {
+                fFont.getWidths(fGlyphs, kCount, widths);
+                fFont.getBounds(fGlyphs, kCount, bounds, nullptr);
+                for (int i = 0; i < kCount; i++) {
+                    fFont.getPath(fGlyphs[i], &paths[i]);
+                }
+            }
+        }
+    }
+
+private:
+    typedef Benchmark INHERITED;
+    static constexpr int kCount = 'z' - ' ';
+    const bool fBatched;
+    SkGlyphID fGlyphs[kCount];
+    SkFont fFont;
+};
+
 DEF_BENCH( return new SkGlyphCacheBasic(256 * 1024); )
 DEF_BENCH( return new SkGlyphCacheBasic(32 * 1024 * 1024); )
 DEF_BENCH( return new SkGlyphCacheStressTest(256 * 1024); )
 DEF_BENCH( return new SkGlyphCacheStressTest(32 * 1024 * 1024); )
+DEF_BENCH( return new SkGlyphCachePrepareImages(0); )
+DEF_BENCH( return new SkGlyphCachePrepareImages(4); )
+DEF_BENCH( return new SkGlyphCacheDrawFromThreads(false); )
+DEF_BENCH( return new SkGlyphCacheDrawFromThreads(true); )
+DEF_BENCH( return new SkGlyphCacheWidthsBoundsPaths(false); )
+DEF_BENCH( return new SkGlyphCacheWidthsBoundsPaths(true); )
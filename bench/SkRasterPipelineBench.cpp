@@ -0,0 +1,127 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "src/core/SkOpts.h"
+#include "src/core/SkRasterPipeline.h"
+
+// These exercise whichever SkOpts tier SkOpts::Init() picked for this CPU (up to SKX),
+// so comparing runs across machines or with SK_CPU_LIMIT_* shows what each tier buys us.
+
+static const int kWidth = 1021;  // Not a multiple of any SIMD width, to include a tail.
+
+// Draws src over dst, both in 8888, a pipeline simple enough to run in lowp.
+class SkRasterPipelineSrcOver8888Bench : public Benchmark {
+public:
+    explicit SkRasterPipelineSrcOver8888Bench(bool compiled) : fCompiled(compiled) {}
+
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+    const char* onGetName() override {
+        return fCompiled ? "SkRasterPipeline_srcover_8888_compiled"
+                         : "SkRasterPipeline_srcover_8888";
+    }
+
+    void onDelayedSetup() override {
+        for (int i = 0; i < kWidth; i++) {
+            fSrc[i] = 0x7f003f7f + i;
+            fDst[i] = 0xff7f3f00 - i;
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkRasterPipeline_MemoryCtx src_ctx = { fSrc, 0 },
+                                   dst_ctx = { fDst, 0 };
+
+        SkRasterPipeline_<256> p;
+        p.append(SkRasterPipeline::load_8888,     &src_ctx);
+        p.append(SkRasterPipeline::load_8888_dst, &dst_ctx);
+        p.append(SkRasterPipeline::srcover);
+        p.append(SkRasterPipeline::store_8888,    &dst_ctx);
+
+        if (fCompiled) {
+            auto fn = p.compile();
+            while (loops --> 0) {
+                fn(0,0,kWidth,1);
+            }
+        } else {
+            while (loops --> 0) {
+                p.run(0,0,kWidth,1);
+            }
+        }
+    }
+
+private:
+    bool     fCompiled;
+    uint32_t fSrc[kWidth];
+    uint32_t fDst[kWidth];
+};
+
+// Draws src over dst in F16 with a gamma transfer function, which forces highp.
+class SkRasterPipelineSrcOverF16Bench : public Benchmark {
+public:
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+    const char* onGetName() override { return "SkRasterPipeline_srcover_f16_gamma"; }
+
+    void onDelayedSetup() override {
+        for (int i = 0; i < kWidth; i++) {
+            fSrc[i] = 0x3800380000000000ull;  // 50% transparent blue
+            fDst[i] = 0x3c00000000003c00ull;  // opaque red
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkRasterPipeline_MemoryCtx src_ctx = { fSrc, 0 },
+                                   dst_ctx = { fDst, 0 };
+
+        skcms_TransferFunction tf = {2.2f, 1, 0, 0, 0, 0, 0};
+
+        SkRasterPipeline_<256> p;
+        p.append(SkRasterPipeline::load_f16,     &src_ctx);
+        p.append(SkRasterPipeline::load_f16_dst, &dst_ctx);
+        p.append(SkRasterPipeline::srcover);
+        p.append(SkRasterPipeline::parametric, &tf);
+        p.append(SkRasterPipeline::store_f16,    &dst_ctx);
+
+        while (loops --> 0) {
+            p.run(0,0,kWidth,1);
+        }
+    }
+
+private:
+    uint64_t fSrc[kWidth];
+    uint64_t fDst[kWidth];
+};
+
+// The SkOpts entry points that shadow the raster pipeline in the simplest raster blits.
+class SkOptsBlitRowBench : public Benchmark {
+public:
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+    const char* onGetName() override { return "SkOpts_blit_row_s32a_opaque"; }
+
+    void onDelayedSetup() override {
+        for (int i = 0; i < kWidth; i++) {
+            uint32_t a = (i % 3) ? 0x7f000000 : 0xff000000;
+            fSrc[i] = a | (0x003f7f3f & (a >> 8));
+            fDst[i] = 0xff7f3f00;
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        while (loops --> 0) {
+            SkOpts::blit_row_s32a_opaque(fDst, fSrc, kWidth, 0xff);
+        }
+    }
+
+private:
+    uint32_t fSrc[kWidth];
+    uint32_t fDst[kWidth];
+};
+
+DEF_BENCH( return new SkRasterPipelineSrcOver8888Bench(false); )
+DEF_BENCH( return new SkRasterPipelineSrcOver8888Bench(true); )
+DEF_BENCH( return new SkRasterPipelineSrcOverF16Bench; )
+DEF_BENCH( return new SkOptsBlitRowBench; )
@@ -6,10 +6,12 @@
  */
 
 #include "bench/Benchmark.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkString.h"
 #include "include/utils/SkRandom.h"
+#include "src/core/SkStroke.h"
 
 class StrokeBench : public Benchmark {
 public:
@@ -117,3 +119,57 @@ DEF_BENCH(return new StrokeBench(line_path_maker(), paint_maker(), "line_.25", .
 DEF_BENCH(return new StrokeBench(quad_path_maker(), paint_maker(), "quad_.25", .25f);)
 DEF_BENCH(return new StrokeBench(conic_path_maker(), paint_maker(), "conic_.25", .25f);)
 DEF_BENCH(return new StrokeBench(cubic_path_maker(), paint_maker(), "cubic_.25", .25f);)
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Strokes one long polyline like a GPS track, either serially or split into pieces on a thread
+// pool.
+class LongStrokeBench : public Benchmark {
+public:
+    LongStrokeBench(int pointCount, bool parallel) : fPointCount(pointCount), fParallel(parallel) {
+        fName.printf("build_stroke_track_%d%s", pointCount, parallel ? "_parallel" : "");
+    }
+
+protected:
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        SkRandom rand;
+        SkPoint pt = SkPoint::Make(X, Y);
+        fPath.moveTo(pt);
+        for (int i = 1; i < fPointCount; ++i) {
+            pt.offset(rand.nextSScalar1() * 5, rand.nextSScalar1() * 5);
+            fPath.lineTo(pt);
+        }
+        if (fParallel) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool();
+        }
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkStroke stroke;
+        stroke.setWidth(8);
+        stroke.setJoin(SkPaint::kRound_Join);
+        stroke.setCap(SkPaint::kRound_Cap);
+        stroke.setExecutor(fExecutor.get());
+        for (int i = 0; i < loops; ++i) {
+            SkPath result;
+            stroke.strokePath(fPath, &result);
+        }
+    }
+
+private:
+    int                         fPointCount;
+    bool                        fParallel;
+    SkPath                      fPath;
+    std::unique_ptr<SkExecutor> fExecutor;
+    SkString                    fName;
+    typedef Benchmark INHERITED;
+};
+
+DEF_BENCH(return new LongStrokeBench(500000, false);)
+DEF_BENCH(return new LongStrokeBench(500000, true);)
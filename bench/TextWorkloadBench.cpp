@@ -0,0 +1,224 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+
+#if !defined(SK_BUILD_FOR_ANDROID_FRAMEWORK) && !defined(SK_BUILD_FOR_GOOGLE3)
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkFont.h"
+#include "include/core/SkGraphics.h"
+#include "include/core/SkSurfaceProps.h"
+#include "include/core/SkTextBlob.h"
+#include "include/gpu/GrContext.h"
+#include "include/gpu/GrContextOptions.h"
+#include "modules/skshaper/include/SkShaper.h"
+#include "src/core/SkRemoteGlyphCache.h"
+#include "tools/Resources.h"
+#include "tools/ToolUtils.h"
+
+#include <vector>
+
+/*
+ * Pages of shaped text, drawn the way an app draws them: SkShaper lays out paragraphs of real
+ * text into SkTextBlobs once, and each loop draws the page with SkCanvas::drawTextBlob(). Unlike
+ * TextBlobBench and FontCacheBench, the glyphs come from several sizes, scripts and fonts
+ * (including color emoji), so a page touches many strikes and atlas pages.
+ *
+ * The strike caches are either left warm between loops, or purged before each one (with the GPU
+ * glyph atlases) to time first paint. Scrolling redraws the page a pixel further up each loop.
+ * Remote configs also send the page's glyphs through an SkStrikeServer / SkStrikeClient pair
+ * each loop, as a renderer process would before drawing, either to a client that already has
+ * them or to a new one.
+ */
+
+namespace {
+
+enum class Script { kLatin, kCJK, kArabic, kEmoji, kMixed };
+enum class Mode { kWarm, kCold, kScroll, kRemoteWarm, kRemoteCold };
+
+static const char* script_name(Script script) {
+    switch (script) {
+        case Script::kLatin:  return "latin";
+        case Script::kCJK:    return "cjk";
+        case Script::kArabic: return "arabic";
+        case Script::kEmoji:  return "emoji";
+        case Script::kMixed:  return "mixed";
+    }
+    return "";
+}
+
+static const char* mode_name(Mode mode) {
+    switch (mode) {
+        case Mode::kWarm:       return "warm";
+        case Mode::kCold:       return "cold";
+        case Mode::kScroll:     return "scroll";
+        case Mode::kRemoteWarm: return "remote_warm";
+        case Mode::kRemoteCold: return "remote_cold";
+    }
+    return "";
+}
+
+// Handles are never deleted: the client keeps every strike it's sent for the bench's lifetime.
+class BenchDiscardableManager : public SkStrikeServer::DiscardableHandleManager,
+                                public SkStrikeClient::DiscardableHandleManager {
+public:
+    SkDiscardableHandleId createHandle() override { return ++fNextHandleId; }
+    bool lockHandle(SkDiscardableHandleId) override { return true; }
+    bool deleteHandle(SkDiscardableHandleId) override { return false; }
+
+private:
+    SkDiscardableHandleId fNextHandleId = 0;
+};
+
+class TextWorkloadBench : public Benchmark {
+public:
+    TextWorkloadBench(Script script, Mode mode) : fScript(script), fMode(mode) {
+        fName.printf("text_workload_%s_%s", script_name(script), mode_name(mode));
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+    SkIPoint onGetSize() override { return {kWidth, kHeight}; }
+
+    // Once its strikes are warm, redrawing a page on the CPU shouldn't need sk_malloc().
+    int allocationsPerLoopLimit(Backend backend) const override {
+        bool warm = Mode::kWarm == fMode || Mode::kScroll == fMode;
+        return warm && kRaster_Backend == backend ? 0 : -1;
+    }
+
+    void onDelayedSetup() override {
+        std::unique_ptr<SkShaper> shaper = SkShaper::Make();
+        static const float kSizes[] = {12, 16, 24, 40};
+        struct Paragraph {
+            Script      fScript;
+            const char* fResource;
+        };
+        static const Paragraph kParagraphs[] = {
+            {Script::kLatin,  "text/english.txt"},
+            {Script::kCJK,    "text/han_simplified.txt"},
+            {Script::kArabic, "text/arabic.txt"},
+            {Script::kEmoji,  "text/emoji.txt"},
+        };
+
+        // Each size gets a quarter of the page.
+        for (int quarter = 0; quarter < 4; ++quarter) {
+            float size = kSizes[quarter];
+            SkPoint offset = {SkIntToScalar(quarter % 2 * kWidth / 2),
+                              SkIntToScalar(quarter / 2 * kHeight / 2)};
+            for (const Paragraph& paragraph : kParagraphs) {
+                if (fScript != Script::kMixed && fScript != paragraph.fScript) {
+                    continue;
+                }
+                sk_sp<SkData> text = GetResourceAsData(paragraph.fResource);
+                if (!text) {
+                    continue;
+                }
+                // The shaper falls back to other fonts for characters this one lacks.
+                SkFont font(Script::kEmoji == paragraph.fScript ? ToolUtils::emoji_typeface()
+                                                                : nullptr,
+                            size);
+                font.setSubpixel(true);
+                font.setEdging(SkFont::Edging::kAntiAlias);
+                const char* utf8 = static_cast<const char*>(text->data());
+                SkTextBlobBuilderRunHandler handler(utf8, offset);
+                shaper->shape(utf8, text->size(), font, Script::kArabic != paragraph.fScript,
+                              kWidth / 2, &handler);
+                if (sk_sp<SkTextBlob> blob = handler.makeBlob()) {
+                    fBlobs.push_back(std::move(blob));
+                }
+                offset = handler.endPoint();
+            }
+        }
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkPaint paint;
+        for (int i = 0; i < loops; ++i) {
+            if (Mode::kCold == fMode) {
+                SkGraphics::PurgeFontCache();
+                if (GrContext* context = canvas->getGrContext()) {
+                    context->freeGpuResources();
+                }
+            }
+            if (Mode::kRemoteWarm == fMode || Mode::kRemoteCold == fMode) {
+                this->sendGlyphs(canvas);
+            }
+
+            canvas->save();
+            if (Mode::kScroll == fMode) {
+                canvas->translate(0, -SkIntToScalar(i % 64));
+            }
+            for (const sk_sp<SkTextBlob>& blob : fBlobs) {
+                canvas->drawTextBlob(blob, 0, 0, paint);
+            }
+            canvas->restore();
+        }
+    }
+
+private:
+    // Analyzes the page on the server side, and hands the glyphs it needs to the client.
+    void sendGlyphs(SkCanvas* canvas) {
+        if (!fManager || Mode::kRemoteCold == fMode) {
+            fManager = sk_make_sp<BenchDiscardableManager>();
+            fServer.reset(new SkStrikeServer(fManager.get()));
+            fClient.reset(new SkStrikeClient(fManager, false));
+        }
+        SkSurfaceProps props(0, kUnknown_SkPixelGeometry);
+        canvas->getProps(&props);
+        SkTextBlobCacheDiffCanvas::Settings settings;
+        if (GrContext* context = canvas->getGrContext()) {
+            settings.fContextSupportsDistanceFieldText =
+                    context->supportsDistanceFieldText();
+            settings.fMaxTextureSize = context->maxTextureSize();
+            settings.fMaxTextureBytes = GrContextOptions().fGlyphCacheTextureMaximumBytes;
+        }
+        SkTextBlobCacheDiffCanvas analyzer(kWidth, kHeight, props, fServer.get(), settings);
+        SkPaint paint;
+        for (const sk_sp<SkTextBlob>& blob : fBlobs) {
+            analyzer.drawTextBlob(blob, 0, 0, paint);
+        }
+        fStrikeData.clear();
+        fServer->writeStrikeData(&fStrikeData);
+        fClient->readStrikeData(fStrikeData.data(), fStrikeData.size());
+    }
+
+    static constexpr int kWidth = 1024;
+    static constexpr int kHeight = 768;
+
+    const Script                    fScript;
+    const Mode                      fMode;
+    SkString                        fName;
+    std::vector<sk_sp<SkTextBlob>>  fBlobs;
+    sk_sp<BenchDiscardableManager>  fManager;
+    std::unique_ptr<SkStrikeServer> fServer;
+    std::unique_ptr<SkStrikeClient> fClient;
+    std::vector<uint8_t>            fStrikeData;
+
+    typedef Benchmark INHERITED;
+};
+
+}  // namespace
+
+#define TEXT_WORKLOAD_BENCH(script, mode) \
+    DEF_BENCH(return new TextWorkloadBench(Script::script, Mode::mode);)
+TEXT_WORKLOAD_BENCH(kLatin, kWarm)
+TEXT_WORKLOAD_BENCH(kLatin, kCold)
+TEXT_WORKLOAD_BENCH(kCJK, kWarm)
+TEXT_WORKLOAD_BENCH(kCJK, kCold)
+TEXT_WORKLOAD_BENCH(kArabic, kWarm)
+TEXT_WORKLOAD_BENCH(kArabic, kCold)
+TEXT_WORKLOAD_BENCH(kEmoji, kWarm)
+TEXT_WORKLOAD_BENCH(kEmoji, kCold)
+TEXT_WORKLOAD_BENCH(kMixed, kWarm)
+TEXT_WORKLOAD_BENCH(kMixed, kCold)
+TEXT_WORKLOAD_BENCH(kMixed, kScroll)
+TEXT_WORKLOAD_BENCH(kMixed, kRemoteWarm)
+TEXT_WORKLOAD_BENCH(kMixed, kRemoteCold)
+#undef TEXT_WORKLOAD_BENCH
+
+#endif  // !defined(SK_BUILD_FOR_ANDROID_FRAMEWORK) && !defined(SK_BUILD_FOR_GOOGLE3)
@@ -100,8 +100,9 @@ DEF_BENCH(return new VertBench();)
 #include "tools/Resources.h"
 
 enum AtlasFlags {
-    kColors_Flag = 1 << 0,
-    kVerts_Flag  = 1 << 1,
+    kColors_Flag       = 1 << 0,
+    kVerts_Flag        = 1 << 1,
+    kPixelAligned_Flag = 1 << 2,  // whole-pixel sprites, with colors blended by kModulate
 };
 
 class AtlasBench : public Benchmark {
@@ -141,6 +142,11 @@ protected:
                                          rand.nextF() * (imageH - 8), 8, 8);
             fColors[i] = rand.nextU();
             fXforms[i] = SkRSXform::Make(1, 0, rand.nextF() * W, rand.nextF() * H);
+            if (fFlags & kPixelAligned_Flag) {
+                fRects[i] = SkRect::Make(fRects[i].round());
+                fXforms[i].fTx = SkScalarRoundToScalar(fXforms[i].fTx);
+                fXforms[i].fTy = SkScalarRoundToScalar(fXforms[i].fTy);
+            }
         }
     }
     void onDraw(int loops, SkCanvas* canvas) override {
@@ -154,9 +160,10 @@ protected:
         if (fFlags & kVerts_Flag) {
             atlas = fAtlas.get();
         }
+        const SkBlendMode mode = (fFlags & kPixelAligned_Flag) ? SkBlendMode::kModulate
+                                                               : SkBlendMode::kSrcOver;
         for (int i = 0; i < loops; i++) {
-            canvas->drawAtlas(atlas, fXforms, fRects, colors, N, SkBlendMode::kSrcOver,
-                              cullRect, paintPtr);
+            canvas->drawAtlas(atlas, fXforms, fRects, colors, N, mode, cullRect, paintPtr);
         }
     }
 private:
@@ -166,4 +173,6 @@ private:
 //DEF_BENCH(return new AtlasBench(kColors_Flag);)
 DEF_BENCH(return new AtlasBench(kVerts_Flag);)
 DEF_BENCH(return new AtlasBench(kVerts_Flag | kColors_Flag);)
+DEF_BENCH(return new AtlasBench(kVerts_Flag | kPixelAligned_Flag);)
+DEF_BENCH(return new AtlasBench(kVerts_Flag | kColors_Flag | kPixelAligned_Flag);)
 
@@ -7,6 +7,14 @@
 
 #include "bench/Benchmark.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkData.h"
+#include "include/core/SkFont.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPictureRecorder.h"
+#include "include/core/SkTextBlob.h"
+#include "include/core/SkVertices.h"
+#include "include/utils/SkRandom.h"
 #include "src/core/SkWriter32.h"
 
 class WriterBench : public Benchmark {
@@ -35,6 +43,98 @@ private:
     typedef Benchmark INHERITED;
 };
 
+/*
+ * Serializes (or deserializes) a picture whose data is mostly one kind of object: large paths,
+ * text blobs or vertices, whose arrays are written and read in bulk.
+ */
+class PictureSerializeBench : public Benchmark {
+public:
+    enum class Kind { kPath, kTextBlob, kVertices };
+
+    PictureSerializeBench(Kind kind, bool read) : fKind(kind), fRead(read) {
+        static const char* kKindNames[] = { "path", "textblob", "vertices" };
+        fName.printf("picture_%s_%s", fRead ? "deserialize" : "serialize",
+                     kKindNames[static_cast<int>(kind)]);
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        SkRandom rand;
+        SkPictureRecorder recorder;
+        SkCanvas* canvas = recorder.beginRecording(SkRect::MakeWH(1024, 1024));
+        SkPaint paint;
+        for (int i = 0; i < 100; i++) {
+            switch (fKind) {
+                case Kind::kPath: {
+                    SkPath path;
+                    path.moveTo(rand.nextUScalar1() * 1024, rand.nextUScalar1() * 1024);
+                    for (int j = 0; j < 1000; j++) {
+                        path.quadTo(rand.nextUScalar1() * 1024, rand.nextUScalar1() * 1024,
+                                    rand.nextUScalar1() * 1024, rand.nextUScalar1() * 1024);
+                    }
+                    canvas->drawPath(path, paint);
+                    break;
+                }
+                case Kind::kTextBlob: {
+                    SkString text;
+                    for (int j = 0; j < 1000; j++) {
+                        text.appendUnichar('a' + rand.nextULessThan(26));
+                    }
+                    SkFont font(nullptr, 12);
+                    canvas->drawTextBlob(SkTextBlob::MakeFromString(text.c_str(), font),
+                                         0, SkIntToScalar(i * 10), paint);
+                    break;
+                }
+                case Kind::kVertices: {
+                    SkPoint positions[999];
+                    SkColor colors[999];
+                    for (int j = 0; j < 999; j++) {
+                        positions[j] = {rand.nextUScalar1() * 1024, rand.nextUScalar1() * 1024};
+                        colors[j] = rand.nextU() | 0xFF000000;
+                    }
+                    auto vertices = SkVertices::MakeCopy(SkVertices::kTriangles_VertexMode, 999,
+                                                         positions, nullptr, colors);
+                    canvas->drawVertices(vertices, SkBlendMode::kModulate, paint);
+                    break;
+                }
+            }
+        }
+        fPicture = recorder.finishRecordingAsPicture();
+        fData = fPicture->serialize();
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; i++) {
+            if (fRead) {
+                SkPicture::MakeFromData(fData.get());
+            } else {
+                fPicture->serialize();
+            }
+        }
+    }
+
+private:
+    const Kind       fKind;
+    const bool       fRead;
+    SkString         fName;
+    sk_sp<SkPicture> fPicture;
+    sk_sp<SkData>    fData;
+
+    typedef Benchmark INHERITED;
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 
 DEF_BENCH( return new WriterBench(); )
+DEF_BENCH( return new PictureSerializeBench(PictureSerializeBench::Kind::kPath, false); )
+DEF_BENCH( return new PictureSerializeBench(PictureSerializeBench::Kind::kPath, true); )
+DEF_BENCH( return new PictureSerializeBench(PictureSerializeBench::Kind::kTextBlob, false); )
+DEF_BENCH( return new PictureSerializeBench(PictureSerializeBench::Kind::kTextBlob, true); )
+DEF_BENCH( return new PictureSerializeBench(PictureSerializeBench::Kind::kVertices, false); )
+DEF_BENCH( return new PictureSerializeBench(PictureSerializeBench::Kind::kVertices, true); )
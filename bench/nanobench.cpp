@@ -31,6 +31,7 @@
 #include "src/core/SkAutoMalloc.h"
 #include "src/core/SkBBoxHierarchy.h"
 #include "src/core/SkColorSpacePriv.h"
+#include "src/core/SkContention.h"
 #include "src/core/SkLeanWindows.h"
 #include "src/core/SkOSFile.h"
 #include "src/core/SkTaskGroup.h"
@@ -122,6 +123,7 @@ static DEFINE_string(zoom, "1.0,0",
                      "Comma-separated zoomMax,zoomPeriodMs factors for a periodic SKP zoom "
                      "function that ping-pongs between 1.0 and zoomMax.");
 static DEFINE_bool(bbh, true, "Build a BBH for SKPs?");
+static DEFINE_bool(cullOccludedDraws, false, "Cull occluded draws when recording SKPs?");
 static DEFINE_bool(mpd, true, "Use MultiPictureDraw for the SKPs?");
 static DEFINE_bool(loopSKP, true, "Loop SKPs like we do for micro benches?");
 static DEFINE_int(flushEvery, 10, "Flush --outResultsFile every Nth run.");
@@ -178,9 +180,18 @@ static DEFINE_string(key, "",
 static DEFINE_string(properties, "",
                      "Space-separated key/value pairs to add to JSON identifying this run.");
 
+static DEFINE_string(scalingThreads, "",
+                     "If set to thread counts, e.g. \"1 2 4 8\", also run each micro bench on "
+                     "raster configs with one copy per thread on that many threads at once, "
+                     "reporting throughput and lock contention for each count.");
+
 static DEFINE_bool(purgeBetweenBenches, false,
                    "Call SkGraphics::PurgeAllCaches() between each benchmark?");
 
+static DEFINE_bool(countAllocations, false,
+                   "Count the sk_malloc() calls and bytes of each bench's loops, failing benches "
+                   "that exceed their allocationsPerLoopLimit(). Needs SK_TRACK_MEMORY_TAGS.");
+
 static double now_ms() { return SkTime::GetNSecs() * 1e-6; }
 
 static SkString humanize(double ms) {
@@ -300,6 +311,47 @@ static double time(int loops, Benchmark* bench, Target* target) {
     return elapsed;
 }
 
+struct AllocationCounts {
+    uint64_t fCount = 0;
+    uint64_t fBytes = 0;
+};
+
+// Every sk_malloc() so far, on any thread.
+static AllocationCounts allocation_counts() {
+    AllocationCounts counts;
+    for (int i = 0; i < kSkMemoryTagCount; ++i) {
+        SkMemoryTagStats stats;
+        SkGraphics::GetMemoryTagStats(static_cast<SkMemoryTag>(i), &stats);
+        counts.fCount += stats.fAllocationCount;
+        counts.fBytes += stats.fAllocatedBytes;
+    }
+    return counts;
+}
+
+// Like time(), but counts what the draw allocates instead. Allocations made by other threads
+// while the bench draws (e.g. --keepAlive's) are counted too.
+static AllocationCounts count_allocations(int loops, Benchmark* bench, Target* target) {
+    SkCanvas* canvas = target->getCanvas();
+    if (canvas) {
+        canvas->clear(SK_ColorWHITE);
+    }
+    bench->preDraw(canvas);
+    canvas = target->beginTiming(canvas);
+    const AllocationCounts before = allocation_counts();
+    bench->draw(loops, canvas);
+    if (canvas) {
+        canvas->flush();
+    }
+    const AllocationCounts after = allocation_counts();
+    target->endTiming();
+    bench->postDraw(canvas);
+
+    AllocationCounts counts;
+    counts.fCount = after.fCount - before.fCount;
+    counts.fBytes = after.fBytes - before.fBytes;
+    return counts;
+}
+
 static double estimate_timer_overhead() {
     double overhead = 0;
     for (int i = 0; i < FLAGS_overheadLoops; i++) {
@@ -363,6 +415,109 @@ static bool write_canvas_png(Target* target, const SkString& filename) {
     return true;
 }
 
+using BenchFactory = Benchmark* (*)(void*);
+
+// Runs one copy of the bench per thread, each made by 'factory' and drawing 'loops' times into its
+// own raster surface, all at once. Returns the best wall time of FLAGS_samples runs, with the
+// lock contention of that run in 'contention'.
+static double time_on_threads(BenchFactory factory, int threads, int loops,
+                              const SkImageInfo& info, SkContentionCounts* contention) {
+    std::vector<std::unique_ptr<Benchmark>> benches;
+    std::vector<sk_sp<SkSurface>> surfaces;
+    for (int t = 0; t < threads; ++t) {
+        benches.emplace_back(factory(nullptr));
+        benches.back()->delayedSetup();
+        surfaces.push_back(SkSurface::MakeRaster(info));
+        if (!surfaces.back()) {
+            return -1;
+        }
+        benches.back()->perCanvasPreDraw(surfaces.back()->getCanvas());
+    }
+
+    double best = -1;
+    for (int s = 0; s < SkTMax(1, FLAGS_samples); ++s) {
+        for (int t = 0; t < threads; ++t) {
+            SkCanvas* canvas = surfaces[t]->getCanvas();
+            canvas->clear(SK_ColorWHITE);
+            benches[t]->preDraw(canvas);
+        }
+
+        // Every thread waits for the rest to be running before it draws.
+        std::atomic<int> ready{0};
+        std::vector<std::thread> pool;
+        for (int t = 0; t < threads; ++t) {
+            pool.emplace_back([&, t] {
+                ready.fetch_add(1);
+                while (ready.load() <= threads) {}
+                SkCanvas* canvas = surfaces[t]->getCanvas();
+                benches[t]->draw(loops, canvas);
+                canvas->flush();
+            });
+        }
+        while (ready.load() < threads) {}
+        const SkContentionCounts before = SkGetContentionCounts();
+        const double start = now_ms();
+        ready.fetch_add(1);
+        for (std::thread& thread : pool) {
+            thread.join();
+        }
+        const double elapsed = now_ms() - start;
+        const SkContentionCounts after = SkGetContentionCounts();
+        if (best < 0 || elapsed < best) {
+            best = elapsed;
+            *contention = {after.fSpinlockAcquires - before.fSpinlockAcquires,
+                           after.fSemaphoreWaits - before.fSemaphoreWaits};
+        }
+
+        for (int t = 0; t < threads; ++t) {
+            benches[t]->postDraw(surfaces[t]->getCanvas());
+        }
+    }
+
+    for (int t = 0; t < threads; ++t) {
+        benches[t]->perCanvasPostDraw(surfaces[t]->getCanvas());
+    }
+    return best;
+}
+
+// Reports how the bench's throughput changes with each of FLAGS_scalingThreads threads, relative
+// to the first count.
+static void run_scaling(BenchFactory factory, int loops, const SkImageInfo& info,
+                        const char* config, const char* name, NanoJSONResultsWriter& log) {
+    log.beginObject(SkStringPrintf("%s_scaling", config).c_str());
+    double baseThroughput = 0;
+    for (int i = 0; i < FLAGS_scalingThreads.count(); ++i) {
+        int threads = atoi(FLAGS_scalingThreads[i]);
+        if (threads < 1) {
+            SkDebugf("Can't parse %s from --scalingThreads as a thread count.\n",
+                     FLAGS_scalingThreads[i]);
+            continue;
+        }
+        SkContentionCounts contention = {0, 0};
+        double ms = time_on_threads(factory, threads, loops, info, &contention);
+        if (ms <= 0) {
+            continue;
+        }
+        // Loops completed per ms across all the threads.
+        const double throughput = threads * loops / ms;
+        if (!baseThroughput) {
+            baseThroughput = throughput;
+        }
+
+        log.appendMetric(SkStringPrintf("threads_%d_ms_per_loop", threads).c_str(), 1 / throughput);
+        log.appendMetric(SkStringPrintf("threads_%d_spinlock_contentions", threads).c_str(),
+                         contention.fSpinlockAcquires);
+        log.appendMetric(SkStringPrintf("threads_%d_semaphore_waits", threads).c_str(),
+                         contention.fSemaphoreWaits);
+        SkDebugf("scaling\t%d threads\t%s/loop\t%.2fx\t%llu spinlock, %llu semaphore waits"
+                 "\t%s\t%s\n",
+                 threads, HUMANIZE(1 / throughput), throughput / baseThroughput,
+                 (unsigned long long)contention.fSpinlockAcquires,
+                 (unsigned long long)contention.fSemaphoreWaits, config, name);
+    }
+    log.endObject();
+}
+
 static int kFailedLoops = -2;
 static int setup_cpu_bench(const double overhead, Target* target, Benchmark* bench) {
     // First figure out approximately how many loops of bench it takes to make overhead negligible.
@@ -748,9 +903,14 @@ public:
         return bench.release();
     }
 
+    // The factory for the current bench, if it's a micro bench that can be made again.
+    BenchFactory currentFactory() const { return fCurrentFactory; }
+
     Benchmark* rawNext() {
+        fCurrentFactory = nullptr;
         if (fBenches) {
-            Benchmark* bench = fBenches->get()(nullptr);
+            fCurrentFactory = fBenches->get();
+            Benchmark* bench = fCurrentFactory(nullptr);
             fBenches = fBenches->next();
             fSourceType = "bench";
             fBenchType  = "micro";
@@ -779,7 +939,8 @@ public:
             fBenchType  = "recording";
             fSKPBytes = static_cast<double>(pic->approximateBytesUsed());
             fSKPOps   = pic->approximateOpCount();
-            return new RecordingBench(name.c_str(), pic.get(), FLAGS_bbh);
+            return new RecordingBench(name.c_str(), pic.get(), FLAGS_bbh,
+                                      FLAGS_cullOccludedDraws);
         }
 
         // Add all .skps as DeserializePictureBenchs.
@@ -1095,6 +1256,7 @@ private:
     };
 
     const BenchRegistry* fBenches;
+    BenchFactory fCurrentFactory = nullptr;
     const skiagm::GMRegistry* fGMs;
     SkIRect            fClip;
     SkTArray<SkScalar> fScales;
@@ -1232,6 +1394,14 @@ int main(int argc, char** argv) {
         gSkForceRasterPipelineBlitter = true;
     }
 
+    SkMemoryTagStats untracked;
+    if (FLAGS_countAllocations &&
+        !SkGraphics::GetMemoryTagStats(SkMemoryTag::kUntagged, &untracked)) {
+        SkDebugf("ERROR: --countAllocations needs Skia built with SK_TRACK_MEMORY_TAGS.\n");
+        return 1;
+    }
+    int allocationFailures = 0;
+
     int runs = 0;
     BenchmarkStream benchStream;
     log.beginObject("results");
@@ -1307,6 +1477,15 @@ int main(int argc, char** argv) {
                 }
             }
 
+            // Counted after the timed samples, so caches and scratch buffers are warm.
+            double allocationsPerLoop = 0,
+                   allocatedBytesPerLoop = 0;
+            if (FLAGS_countAllocations) {
+                AllocationCounts counts = count_allocations(loops, bench.get(), target);
+                allocationsPerLoop = (double)counts.fCount / loops;
+                allocatedBytesPerLoop = (double)counts.fBytes / loops;
+            }
+
             SkTArray<SkString> keys;
             SkTArray<double> values;
             bool gpuStatsDump = FLAGS_gpuStatsDump && Benchmark::kGPU_Backend == configs[i].backend;
@@ -1346,6 +1525,10 @@ int main(int argc, char** argv) {
             }
             log.endArray(); // samples
             benchStream.fillCurrentMetrics(log);
+            if (FLAGS_countAllocations) {
+                log.appendMetric("allocations_per_loop", allocationsPerLoop);
+                log.appendMetric("allocated_bytes_per_loop", allocatedBytesPerLoop);
+            }
             if (gpuStatsDump) {
                 // dump to json, only SKPBench currently returns valid keys / values
                 SkASSERT(keys.count() == values.count());
@@ -1409,10 +1592,28 @@ int main(int argc, char** argv) {
                         );
             }
 
+            if (FLAGS_countAllocations) {
+                const int limit = bench->allocationsPerLoopLimit(configs[i].backend);
+                SkDebugf("allocations\t%.2f/loop\t%.0f bytes/loop\t%s\t%s\n",
+                         allocationsPerLoop, allocatedBytesPerLoop, config,
+                         bench->getUniqueName());
+                if (limit >= 0 && allocationsPerLoop > limit) {
+                    SkDebugf("ERROR: %s is limited to %d allocations per loop on %s.\n",
+                             bench->getUniqueName(), limit, config);
+                    ++allocationFailures;
+                }
+            }
+
             if (FLAGS_gpuStats && Benchmark::kGPU_Backend == configs[i].backend) {
                 target->dumpStats();
             }
 
+            if (!FLAGS_scalingThreads.isEmpty() && benchStream.currentFactory() &&
+                Benchmark::kRaster_Backend == configs[i].backend && canvas) {
+                run_scaling(benchStream.currentFactory(), loops, canvas->imageInfo(), config,
+                            bench->getUniqueName(), log);
+            }
+
             if (FLAGS_verbose) {
                 SkDebugf("Samples:  ");
                 for (int i = 0; i < samples.count(); i++) {
@@ -1435,9 +1636,27 @@ int main(int argc, char** argv) {
     log.endObject(); // config
     log.endBench();
 
+    // What Skia's one-time setup cost this process, e.g. to compare cold start between bots.
+    log.beginBench("init_phases", 0, 0);
+    log.beginObject("meta"); // config
+    for (int i = 0; i < SkGraphics::kInitPhaseCount; ++i) {
+        auto phase = static_cast<SkGraphics::InitPhase>(i);
+        double ms = SkGraphics::GetInitPhaseNanos(phase) * 1e-6;
+        log.appendMetric(SkStringPrintf("%s_ms", SkGraphics::InitPhaseName(phase)).c_str(), ms);
+        if (FLAGS_verbose) {
+            SkDebugf("init phase %s: %s\n", SkGraphics::InitPhaseName(phase), HUMANIZE(ms));
+        }
+    }
+    log.endObject(); // config
+    log.endBench();
+
     log.endObject(); // results
     log.endObject(); // root
     log.flush();
 
+    if (allocationFailures) {
+        SkDebugf("%d benches made more allocations than their limit.\n", allocationFailures);
+        return 1;
+    }
     return 0;
 }
@@ -281,6 +281,23 @@ bool SkVideoEncoder::sendFrame(AVFrame* frame) {
 }
 
 bool SkVideoEncoder::endFrame() {
+    if (!fSurface) {
+        return false;
+    }
+    SkPixmap pm;
+    SkAssertResult(fSurface->peekPixels(&pm));
+    return this->addFrame(pm);
+}
+
+SkImageInfo SkVideoEncoder::frameInfo() const {
+    return fSurface ? fSurface->imageInfo() : SkImageInfo::MakeUnknown();
+}
+
+bool SkVideoEncoder::addFrame(const SkPixmap& pm) {
+    if (!fSurface || pm.info() != fSurface->imageInfo()) {
+        return false;
+    }
+
     /* make sure the frame data is writable */
     if (check_err(av_frame_make_writable(fFrame))) {
         return false;
@@ -289,11 +306,9 @@ bool SkVideoEncoder::endFrame() {
     fFrame->pts = fCurrentPTS;
     fCurrentPTS += fDeltaPTS;
 
-    SkPixmap pm;
-    SkAssertResult(fSurface->peekPixels(&pm));
     const uint8_t* src[] = { (const uint8_t*)pm.addr() };
     const int strides[] = { SkToInt(pm.rowBytes()) };
-    sws_scale(fSWScaleCtx, src, strides, 0, fSurface->height(), fFrame->data, fFrame->linesize);
+    sws_scale(fSWScaleCtx, src, strides, 0, pm.height(), fFrame->data, fFrame->linesize);
 
     return this->sendFrame(fFrame);
 }
@@ -32,6 +32,17 @@ public:
     SkCanvas* beginFrame();
     bool endFrame();
 
+    /**
+     *  Encodes an already rendered frame, instead of beginFrame()/endFrame(). The pixmap must match
+     *  frameInfo(). The pixels are converted before this returns, so they can be reused at once.
+     */
+    bool addFrame(const SkPixmap&);
+
+    /**
+     *  The layout addFrame() expects, once beginRecording() has succeeded.
+     */
+    SkImageInfo frameInfo() const;
+
     sk_sp<SkData> endRecording();
 
 private:
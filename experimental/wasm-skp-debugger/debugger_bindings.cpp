@@ -111,6 +111,17 @@ class SkpDebugPlayer {
       return std::string(data_view);
     }
 
+    // Return the CPU time each command takes to draw into the surface, in JSON
+    std::string jsonTimings(sk_sp<SkSurface> surface, int repeat) {
+      SkDynamicMemoryWStream stream;
+      SkJSONWriter writer(&stream, SkJSONWriter::Mode::kFast);
+      fDebugCanvas->toJSONTimings(writer, getSize(), surface->getCanvas(), repeat, nullptr);
+      writer.flush();
+      auto skdata = stream.detachAsData();
+      std::string_view data_view(reinterpret_cast<const char*>(skdata->data()), skdata->size());
+      return std::string(data_view);
+    }
+
     // Gets the clip and matrix of the last command drawn
     std::string lastCommandInfo() {
       SkMatrix vm = fDebugCanvas->getCurrentMatrix();
@@ -218,6 +229,7 @@ EMSCRIPTEN_BINDINGS(my_module) {
     .function("setCommandVisibility", &SkpDebugPlayer::setCommandVisibility)
     .function("setGpuOpBounds",       &SkpDebugPlayer::setGpuOpBounds)
     .function("jsonCommandList",      &SkpDebugPlayer::jsonCommandList, allow_raw_pointers())
+    .function("jsonTimings",          &SkpDebugPlayer::jsonTimings, allow_raw_pointers())
     .function("lastCommandInfo",      &SkpDebugPlayer::lastCommandInfo);
 
   // Structs used as arguments or returns to the functions above
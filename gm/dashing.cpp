@@ -620,6 +620,69 @@ DEF_SIMPLE_GM(dash_line_zero_off_interval, canvas, 160, 330) {
     }
 }
 
+// Thin dashed polylines and curves, which the GPU backend dashes in the fragment shader.
+DEF_SIMPLE_GM(dashing_curves, canvas, 1060, 480) {
+    SkPath zigzag;
+    zigzag.moveTo(0, 40);
+    for (int i = 1; i <= 8; ++i) {
+        zigzag.lineTo(i * 12.5f, (i & 1) ? 0 : 40);
+    }
+
+    SkPath wavy;
+    wavy.moveTo(0, 20);
+    for (int i = 0; i < 5; ++i) {
+        wavy.quadTo(i * 20 + 5, 0, i * 20 + 10, 20);
+        wavy.quadTo(i * 20 + 15, 40, i * 20 + 20, 20);
+    }
+
+    SkPath loop;
+    loop.moveTo(0, 40);
+    loop.cubicTo(100, -20, 0, -20, 100, 40);
+
+    SkPath oval;
+    oval.addOval(SkRect::MakeWH(100, 40));
+
+    SkPath rect;
+    rect.addRect(SkRect::MakeWH(100, 40));
+
+    const SkPath* paths[] = { &zigzag, &wavy, &loop, &oval, &rect };
+    const SkScalar intervals[] = { 6, 4 };
+
+    SkPaint paint;
+    paint.setStyle(SkPaint::kStroke_Style);
+    paint.setPathEffect(SkDashPathEffect::Make(intervals, SK_ARRAY_COUNT(intervals), 3));
+
+    canvas->translate(10, 10);
+    for (SkScalar width : { 0.f, 1.f, 2.f }) {
+        for (SkPaint::Cap cap : { SkPaint::kButt_Cap, SkPaint::kSquare_Cap }) {
+            paint.setStrokeWidth(width);
+            paint.setStrokeCap(cap);
+            canvas->save();
+            for (const SkPath* path : paths) {
+                for (bool aa : { false, true }) {
+                    paint.setAntiAlias(aa);
+                    canvas->drawPath(*path, paint);
+                    canvas->translate(104, 0);
+                }
+            }
+            canvas->restore();
+            canvas->translate(0, 50);
+        }
+    }
+
+    // Rotated and scaled, the intervals have to follow the device space length of the path.
+    paint.setStrokeWidth(1);
+    paint.setStrokeCap(SkPaint::kButt_Cap);
+    paint.setAntiAlias(true);
+    canvas->translate(40, 130);
+    canvas->rotate(-10);
+    canvas->scale(0.75f, 0.75f);
+    for (const SkPath* path : paths) {
+        canvas->drawPath(*path, paint);
+        canvas->translate(120, 0);
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////////
 
 DEF_GM(return new DashingGM;)
@@ -29,6 +29,12 @@ public:
 
     SkInternalAtlasTextContext& internal() { return *fInternalContext; }
 
+    /**
+     * Issues the text draws that SkAtlasTextTargets have submitted to the SkAtlasTextRenderer,
+     * for all the targets together.
+     */
+    void flush();
+
 private:
     SkAtlasTextContext() = delete;
     SkAtlasTextContext(const SkAtlasTextContext&) = delete;
@@ -34,6 +34,14 @@ public:
         int16_t fTextureCoordY;
     };
 
+    /** A run of quads, in the vertices passed to drawSDFGlyphBatch(), drawn to one target. */
+    struct SDFGlyphRange {
+        void* fTargetHandle;
+        /** The run's first quad. Its first vertex is at 4 * 'fFirstQuad'. */
+        int fFirstQuad;
+        int fQuadCnt;
+    };
+
     virtual ~SkAtlasTextRenderer() = default;
 
     /**
@@ -65,6 +73,23 @@ public:
     virtual void drawSDFGlyphs(void* targetHandle, void* textureHandle, const SDFVertex vertices[],
                                int quadCnt) = 0;
 
+    /**
+     * Draws glyphs using SDFs, for any number of targets at once. 'ranges' are the runs of quads
+     * in 'vertices' drawn to each target, in the order they must be drawn. During one flush of
+     * the SkAtlasTextContext every call gets the same 'vertices', which holds all 'quadCnt' quads
+     * of the flush, so it only needs to be uploaded once. A flush makes more than one call only
+     * when texture data must be set between draws.
+     *
+     * The default calls drawSDFGlyphs() for each range.
+     */
+    virtual void drawSDFGlyphBatch(void* textureHandle, const SDFVertex vertices[], int quadCnt,
+                                   const SDFGlyphRange ranges[], int rangeCnt) {
+        for (int i = 0; i < rangeCnt; ++i) {
+            this->drawSDFGlyphs(ranges[i].fTargetHandle, textureHandle,
+                                vertices + 4 * ranges[i].fFirstQuad, ranges[i].fQuadCnt);
+        }
+    }
+
     /** Called when a SkAtlasTextureTarget is destroyed. */
     virtual void targetDeleted(void* targetHandle) = 0;
 };
@@ -41,7 +41,14 @@ public:
     virtual void drawText(const SkGlyphID[], const SkPoint[], int glyphCnt, uint32_t color,
                           const SkAtlasTextFont&) = 0;
 
-    /** Issues all queued text draws to SkAtlasTextRenderer. */
+    /**
+     * Hands the queued text draws to the SkAtlasTextContext without issuing them. Draws submitted
+     * by many targets reach the SkAtlasTextRenderer together, in the order they were submitted,
+     * at the next SkAtlasTextContext::flush().
+     */
+    virtual void submit() = 0;
+
+    /** Issues all queued text draws to SkAtlasTextRenderer, along with any submitted ones. */
     virtual void flush() = 0;
 
     int width() const { return fWidth; }
@@ -193,6 +193,7 @@ public:
             : fZeroInitialized(SkCodec::kNo_ZeroInitialized)
             , fSubset(nullptr)
             , fSampleSize(1)
+            , fBoxFilter(false)
         {}
 
         /**
@@ -222,6 +223,16 @@ public:
          *  The default is 1, representing no downscaling.
          */
         int fSampleSize;
+
+        /**
+         *  If true, a codec that downscales by sampling averages each fSampleSize square of
+         *  pixels instead, as it decodes, for smoother thumbnails. Only PNG and codecs that
+         *  decode scanlines top down do this, and only into kRGBA_8888 or kBGRA_8888 with
+         *  premultiplied or opaque alpha; otherwise this is ignored.
+         *
+         *  The default is false.
+         */
+        bool fBoxFilter;
     };
 
     /**
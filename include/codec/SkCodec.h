@@ -26,6 +26,7 @@
 
 class SkColorSpace;
 class SkData;
+class SkExecutor;
 class SkFrameHolder;
 class SkPngChunkReader;
 class SkSampler;
@@ -257,6 +258,7 @@ public:
             , fSubset(nullptr)
             , fFrameIndex(0)
             , fPriorFrame(kNoFrame)
+            , fExecutor(nullptr)
         {}
 
         ZeroInitialized            fZeroInitialized;
@@ -300,6 +302,17 @@ public:
          *  If set to kNoFrame, the codec will decode any necessary required frame(s) first.
          */
         int                        fPriorFrame;
+
+        /**
+         *  If not NULL, getPixels() may use this to split up the work of decoding across
+         *  threads. The output is the same either way.
+         *
+         *  Currently used by PNG, which still decompresses on the calling thread, but
+         *  swizzles and color transforms rows on the executor, and by JPEG, which decodes
+         *  bands between restart markers in parallel when the encoded data is in memory.
+         *  Ignored by incremental and scanline decodes.
+         */
+        SkExecutor*                fExecutor;
     };
 
     /**
@@ -384,8 +397,11 @@ public:
      *                    query, except the WidthBytes may be larger than the
      *                    recommendation (but not smaller).
      *  @param planes     Memory for each of the Y, U, and V planes.
+     *  @param executor   If not NULL, may be used to decode in parallel, as with
+     *                    Options::fExecutor.
      */
-    Result getYUV8Planes(const SkYUVASizeInfo& sizeInfo, void* planes[SkYUVASizeInfo::kMaxCount]) {
+    Result getYUV8Planes(const SkYUVASizeInfo& sizeInfo, void* planes[SkYUVASizeInfo::kMaxCount],
+                         SkExecutor* executor = nullptr) {
         if (!planes || !planes[0] || !planes[1] || !planes[2]) {
             return kInvalidInput;
         }
@@ -395,7 +411,7 @@ public:
             return kCouldNotRewind;
         }
 
-        return this->onGetYUV8Planes(sizeInfo, planes);
+        return this->onGetYUV8Planes(sizeInfo, planes, executor);
     }
 
     /**
@@ -738,7 +754,8 @@ protected:
     }
 
     virtual Result onGetYUV8Planes(const SkYUVASizeInfo&,
-                                   void*[SkYUVASizeInfo::kMaxCount] /*planes*/) {
+                                   void*[SkYUVASizeInfo::kMaxCount] /*planes*/,
+                                   SkExecutor*) {
         return kUnimplemented;
     }
 
@@ -926,6 +943,13 @@ private:
      */
     virtual SkSampler* getSampler(bool /*createIfNecessary*/) { return nullptr; }
 
+    /**
+     *  Whether an incremental decode passes every row to the SkBoxFilter set on getSampler(),
+     *  so that SkAndroidCodec can average rather than sample. Only valid after
+     *  startIncrementalDecode().
+     */
+    virtual bool supportsBoxFilter() const { return false; }
+
     friend class DM::CodecSrc;  // for fillIncompleteImage
     friend class SkSampledCodec;
     friend class SkIcoCodec;
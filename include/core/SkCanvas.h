@@ -2635,6 +2635,12 @@ private:
      */
     void drawClippedToSaveBehind(const SkPaint&);
 
+    /**
+     *  Sets rejected[i] to quickReject(rects[i]) for each of the count rects, and returns how many
+     *  were rejected. With a scale+translate matrix, four rects are mapped and tested at a time.
+     */
+    int quickRejectRects(const SkRect rects[], int count, bool rejected[]) const;
+
     void resetForNextPicture(const SkIRect& bounds);
 
     // needs gettotalclip()
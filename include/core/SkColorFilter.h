@@ -120,6 +120,13 @@ protected:
     virtual bool onAsAColorMatrix(float[20]) const;
     virtual bool onAsAColorMode(SkColor* color, SkBlendMode* bmode) const;
 
+    /**
+     *  Returns a single filter that does what this(inner(...)) does, or nullptr if there isn't
+     *  one cheaper than composing the two. This lets makeComposed() fold e.g. two color matrices
+     *  into one before they're applied to every pixel.
+     */
+    virtual sk_sp<SkColorFilter> onMakeComposed(const SkColorFilter& inner) const;
+
 private:
     /*
      *  Returns 1 if this is a single filter (not a composition of other filters), otherwise it
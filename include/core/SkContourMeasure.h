@@ -86,7 +86,10 @@ private:
 
     const Segment* distanceToSegment(SkScalar distance, SkScalar* t) const;
 
+    size_t bytesUsed() const { return fSegments.bytes() + fPts.bytes(); }
+
     friend class SkContourMeasureIter;
+    friend class SkContourMeasureCache;
 };
 
 class SK_API SkContourMeasureIter : SkNoncopyable {
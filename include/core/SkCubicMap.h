@@ -24,6 +24,12 @@ public:
 
     float computeYFromX(float x) const;
 
+    /**
+     *  Same as calling computeYFromX() on each of the |count| values of |x|, writing the results
+     *  to |y|, but solves several values at a time. |x| and |y| may be the same array.
+     */
+    void computeYFromX(const float x[], float y[], int count) const;
+
     SkPoint computeFromT(float t) const;
 
 private:
@@ -20,13 +20,27 @@ public:
     static std::unique_ptr<SkExecutor> MakeFIFOThreadPool(int threads = 0);
     static std::unique_ptr<SkExecutor> MakeLIFOThreadPool(int threads = 0);
 
+    // Create a thread pool SkExecutor where each thread has its own queues of work, runs the work
+    // it added itself most recently first, and steals the oldest work of the other threads when
+    // it runs out.  It honors priorities: high priority work runs ahead of all normal work.
+    static std::unique_ptr<SkExecutor> MakeWorkStealingThreadPool(int threads = 0);
+
     // There is always a default SkExecutor available by calling SkExecutor::GetDefault().
     static SkExecutor& GetDefault();
     static void SetDefault(SkExecutor*);  // Does not take ownership.  Not thread safe.
 
+    enum class Priority {
+        kNormal,
+        kHigh,  // Latency sensitive work, to run ahead of bulk work.
+    };
+    static constexpr int kPriorityCount = (int)Priority::kHigh + 1;
+
     // Add work to execute.
     virtual void add(std::function<void(void)>) = 0;
 
+    // Add work to execute with a priority.  Executors that don't have priorities just add() it.
+    virtual void add(std::function<void(void)> work, Priority) { this->add(std::move(work)); }
+
     // If it makes sense for this executor, use this thread to execute work for a little while.
     virtual void borrow() {}
 };
@@ -416,6 +416,24 @@ public:
         this->getWidthsBounds(glyphs, count, nullptr, bounds, paint);
     }
 
+    /** Retrieves any of the advance, bounds, and path of each glyph in glyphs in one pass,
+        which is faster than asking for each separately with getWidthsBounds() and getPaths().
+        Any of widths, bounds, and paths may be nullptr; each that is not must be an array of
+        count entries. paths are scaled to the text size as by getPath(), and are empty for
+        glyphs without an outline.
+
+        @param glyphs      array of glyph indices to be measured
+        @param count       number of glyphs
+        @param widths      returns text advances for each glyph; may be nullptr
+        @param bounds      returns bounds for each glyph relative to (0, 0); may be nullptr
+        @param paths       returns outline for each glyph; may be nullptr
+        @param paint       optional, specifies stroking, SkPathEffect and SkMaskFilter for widths
+                           and bounds; paths ignore it
+     */
+    void getWidthsBoundsPaths(const SkGlyphID glyphs[], int count, SkScalar widths[],
+                              SkRect bounds[], SkPath paths[],
+                              const SkPaint* paint = nullptr) const;
+
     /** Retrieves the positions for each glyph, beginning at the specified origin. The caller
         must allocated at least count number of elements in the pos[] array.
 
@@ -9,6 +9,7 @@
 #define SkGraphics_DEFINED
 
 #include "include/core/SkRefCnt.h"
+#include "include/private/SkMalloc.h"
 
 class SkData;
 class SkImageGenerator;
@@ -90,6 +91,33 @@ public:
      */
     static int SetFontCachePointSizeLimit(int maxPointSize);
 
+    /**
+     *  Allow many threads to draw text from the same font cache entry at once, returning the
+     *  previous setting. Glyphs that are already cached are then found without locking, which
+     *  helps when several threads draw the same text, at the cost of each thread keeping a few
+     *  entries alive until it next draws text or exits. Off by default.
+     */
+    static bool SetFontCacheSharedStrikes(bool shared);
+
+    /**
+     *  Keep the glyph images of font cache entries made from now on in discardable memory (see
+     *  SkDiscardableMemory), returning the previous setting. The system may then reclaim the
+     *  images of entries not in use under memory pressure, and they are generated again when they
+     *  are next drawn. Does not apply to entries shared by SetFontCacheSharedStrikes(). Off by
+     *  default.
+     */
+    static bool SetFontCacheDiscardableImages(bool discardable);
+
+    /**
+     *  Evaluate image filters drawn to raster canvases in tiles of at most tileSize x tileSize
+     *  pixels, returning the previous size. Each filter in the graph then only makes images about
+     *  the size of a tile, plus the margin it needs around it, instead of the size of the whole
+     *  layer. Tiles are filtered on SkExecutor::GetDefault(), so they run in parallel if that is
+     *  a thread pool; filters (e.g. SkPictureImageFilter) must then be safe to run on its
+     *  threads. Zero, the default, turns tiling off.
+     */
+    static int SetImageFilterTileSize(int tileSize);
+
     /**
      *  For debugging purposes, this will attempt to purge the font cache. It
      *  does not change the limit, but will cause subsequent font measures and
@@ -137,6 +165,13 @@ public:
      */
     static void DumpMemoryStatistics(SkTraceMemoryDump* dump);
 
+    /**
+     *  Reports the memory allocated by Skia on behalf of the subsystem tag (see SkMemoryTag).
+     *  Returns false, leaving stats zeroed, unless Skia is built with SK_TRACK_MEMORY_TAGS, in
+     *  which case DumpMemoryStatistics() also dumps these as "skia/sk_malloc/<tag>".
+     */
+    static bool GetMemoryTagStats(SkMemoryTag tag, SkMemoryTagStats* stats);
+
     /**
      *  Free as much globally cached memory as possible. This will purge all private caches in Skia,
      *  including font and image caches.
@@ -145,6 +180,110 @@ public:
      */
     static void PurgeAllCaches();
 
+    /**
+     *  How much cached memory should be given up, e.g. in response to an Android onTrimMemory()
+     *  level.
+     */
+    enum class MemoryPressure {
+        kLow,       //!< trims a quarter of each cache
+        kModerate,  //!< trims half of each cache
+        kCritical,  //!< frees everything that isn't in use, including unused typefaces
+    };
+
+    /**
+     *  Returns the fraction of each cache's contents that is trimmed under the given pressure.
+     */
+    static float MemoryPressureTrimFraction(MemoryPressure);
+
+    /**
+     *  What OnMemoryPressure() and GrContext::onMemoryPressure() freed from each cache.
+     */
+    struct MemoryPressureResult {
+        size_t fFontCacheBytes = 0;
+        size_t fResourceCacheBytes = 0;
+        // The typeface cache doesn't track the memory of its typefaces, so this is a count.
+        int    fTypefaces = 0;
+        size_t fTextBlobCacheBytes = 0;
+        // Also a count; the path atlases they release are included in fGpuResourceBytes.
+        int    fCoverageCountingPathCacheEntries = 0;
+        size_t fGpuResourceBytes = 0;
+
+        size_t totalBytes() const {
+            return fFontCacheBytes + fResourceCacheBytes + fTextBlobCacheBytes + fGpuResourceBytes;
+        }
+    };
+
+    /**
+     *  Trims the global caches under memory pressure, least valuable first: the font cache, then
+     *  the resource cache, then (under critical pressure) the typeface and image filter caches.
+     *  What was freed is added to 'result', if not null.
+     *
+     *  GPU caches belong to their GrContext: call GrContext::onMemoryPressure() on each context
+     *  as well.
+     */
+    static void OnMemoryPressure(MemoryPressure, MemoryPressureResult* result = nullptr);
+
+    /**
+     *  Events Skia counts as it goes, cheaply enough to stay on in release builds: each is one
+     *  relaxed atomic increment. The counts only ever go up, so to see what a frame did, read them
+     *  before and after it.
+     */
+    enum class PerfCounter {
+        kRasterPipelineBuilds,      //!< raster pipelines turned into programs to run
+        kRasterPipelineBlitters,    //!< blitters chosen for a draw that run a raster pipeline
+        kLegacyBlitters,            //!< blitters chosen for a draw with a hand-written loop
+        kStrikeCacheHits,           //!< font strikes found in the strike cache
+        kStrikeCacheMisses,         //!< font strikes the strike cache had to create
+        kGpuResourceBudgetPurges,   //!< GPU resources freed to bring a cache back under budget
+        kGpuOpMerges,               //!< GPU ops merged into another op in flushed op lists
+        kGpuProgramCacheMisses,     //!< GPU programs or pipelines that had to be built
+        kGpuSoftwarePathMasks,      //!< GPU path draws that fell back to a mask drawn on the CPU
+
+        kLast = kGpuSoftwarePathMasks,
+    };
+    static constexpr int kPerfCounterCount = static_cast<int>(PerfCounter::kLast) + 1;
+
+    /**
+     *  Returns how many times the event has happened, in any thread, since the process started.
+     */
+    static uint64_t GetPerfCounter(PerfCounter);
+
+    /**
+     *  Returns a short name for the counter, e.g. "strike_cache_hits".
+     */
+    static const char* PerfCounterName(PerfCounter);
+
+    /**
+     *  Dumps each counter as "skia/perf_counters/<name>", with a "count" value in "events".
+     *  These aren't memory, so DumpMemoryStatistics() leaves them out.
+     */
+    static void DumpPerfCounters(SkTraceMemoryDump* dump);
+
+    /**
+     *  The setup Skia does once, at Init() or on first use, that shows up in cold start times.
+     *  Each is timed as it runs, to attribute startup costs.
+     */
+    enum class InitPhase {
+        kCpuFeatures,       //!< detecting the CPU's features, in Init()
+        kOpts,              //!< picking the SkOpts routines for the CPU, in Init()
+        kFlattenables,      //!< registering SkFlattenable factories, on first (de)serialization
+        kDefaultFontMgr,    //!< making SkFontMgr::RefDefault(), e.g. loading the fontconfig config
+        kGLCaps,            //!< querying the capabilities of each GL context (once per context)
+
+        kLast = kGLCaps,
+    };
+    static constexpr int kInitPhaseCount = static_cast<int>(InitPhase::kLast) + 1;
+
+    /**
+     *  Returns the time spent in the phase so far, summed over threads and GL contexts.
+     */
+    static uint64_t GetInitPhaseNanos(InitPhase);
+
+    /**
+     *  Returns a short name for the phase, e.g. "default_font_mgr".
+     */
+    static const char* InitPhaseName(InitPhase);
+
     /**
      *  Applications with command line options may pass optional state, such
      *  as cache sizes, here, for instance:
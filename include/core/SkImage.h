@@ -432,7 +432,11 @@ public:
         format of data is recognized and supported. Otherwise, nullptr is returned.
         Recognized GPU formats vary by platform and GPU back-end.
 
-        @param context                GPU context
+        If context is nullptr, the planes are instead converted to a raster SkImage, reading
+        each channel from the nearest pixel of its (possibly subsampled) plane. Planes must then
+        be kAlpha_8, kGray_8, or 8888, and buildMips and limitToMaxTextureSize are ignored.
+
+        @param context                GPU context, or nullptr for a raster image
         @param yuvColorSpace          How the YUV values are converted to RGB. One of:
                                             kJPEG_SkYUVColorSpace, kRec601_SkYUVColorSpace,
                                             kRec709_SkYUVColorSpace, kIdentity_SkYUVColorSpace
@@ -379,6 +379,22 @@ protected:
                                       const Context&,
                                       SkIPoint* offset) const;
 
+    // Like filterInput(), but doesn't materialize the color filter and offset nodes at the top of
+    // the input. It returns the result of the first other node below them (or "src"), with
+    // "offset" including their offsets, and sets "colorFilter" to the color filter they would
+    // have applied (null if none). The caller must apply it when drawing the result, e.g. as the
+    // paint's color filter, or with ApplyColorFilter().
+    sk_sp<SkSpecialImage> filterInputPointwise(int index,
+                                               SkSpecialImage* src,
+                                               const Context&,
+                                               SkIPoint* offset,
+                                               sk_sp<SkColorFilter>* colorFilter) const;
+
+    // Returns image drawn through colorFilter, or image itself if colorFilter is null.
+    static sk_sp<SkSpecialImage> ApplyColorFilter(sk_sp<SkSpecialImage> image,
+                                                  sk_sp<SkColorFilter> colorFilter,
+                                                  const OutputProperties&);
+
     /**
      *  Return true (and return a ref'd colorfilter) if this node in the DAG is just a
      *  colorfilter w/o CropRect constraints.
@@ -387,6 +403,14 @@ protected:
         return false;
     }
 
+    /**
+     *  Return true (and the device space offset for ctm) if this node in the DAG just translates
+     *  its input w/o CropRect constraints.
+     */
+    virtual bool onIsOffsetNode(const SkMatrix& /*ctm*/, SkIPoint* /*offset*/) const {
+        return false;
+    }
+
     /**
      *  Override this to describe the behavior of your subclass - as a leaf node. The caller will
      *  take care of calling your inputs (and return false if any of them could not handle it).
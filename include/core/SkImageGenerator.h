@@ -82,6 +82,18 @@ public:
      */
     bool getPixels(const SkImageInfo& info, void* pixels, size_t rowBytes);
 
+    /**
+     *  Return the smallest size, no smaller than getInfo()'s dimensions times desiredScale,
+     *  that getPixels() can decode to more cheaply than the full size. Generators that
+     *  can't scale return getInfo()'s dimensions.
+     *
+     *  @param desiredScale The scale the caller will draw at, in (0, 1].
+     */
+    SkISize getScaledDimensions(float desiredScale) const {
+        return desiredScale > 0 && desiredScale < 1 ? this->onGetScaledDimensions(desiredScale)
+                                                    : fInfo.dimensions();
+    }
+
     /**
      *  If decoding to YUV is supported, this returns true.  Otherwise, this
      *  returns false and does not modify any of the parameters.
@@ -170,6 +182,7 @@ protected:
     struct Options {};
     virtual bool onGetPixels(const SkImageInfo&, void*, size_t, const Options&) { return false; }
     virtual bool onIsValid(GrContext*) const { return true; }
+    virtual SkISize onGetScaledDimensions(float) const { return fInfo.dimensions(); }
     virtual bool onQueryYUVA8(SkYUVASizeInfo*, SkYUVAIndex[SkYUVAIndex::kIndexCount],
                               SkYUVColorSpace*) const { return false; }
     virtual bool onGetYUVA8Planes(const SkYUVASizeInfo&, const SkYUVAIndex[SkYUVAIndex::kIndexCount],
@@ -1389,6 +1389,30 @@ public:
         kDone_Verb,  //!< terminates SkPath
     };
 
+    /** Returns SkPath built from copies of the given arrays, in a single allocation of exactly
+        the needed size. This is cheaper than building the same SkPath with moveTo(), lineTo()
+        and the like, which grow the storage as they go.
+
+        verbs are in the order they are drawn, pointCount must equal the number of points they
+        use, and conicWeightCount the number of kConic_Verb among them. Returns an empty SkPath
+        if the arrays don't describe a valid SkPath.
+
+        @param pts               SkPoint array
+        @param pointCount        number of entries in pts
+        @param verbs             SkPath::Verb array
+        @param verbCount         number of entries in verbs
+        @param conicWeights      conic weight array
+        @param conicWeightCount  number of entries in conicWeights
+        @param fillType          SkPath::FillType of the result
+        @param isVolatile        whether the result is volatile
+        @return                  SkPath made from the arrays, or empty SkPath
+    */
+    static SkPath Make(const SkPoint pts[], int pointCount,
+                       const uint8_t verbs[], int verbCount,
+                       const SkScalar conicWeights[], int conicWeightCount,
+                       FillType fillType = kWinding_FillType,
+                       bool isVolatile = false);
+
     /** \class SkPath::Iter
         Iterates through verb array, and associated SkPoint array and conic weight.
         Provides options to treat open contours as closed, and to ignore
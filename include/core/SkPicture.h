@@ -13,8 +13,11 @@
 #include "include/core/SkTileMode.h"
 #include "include/core/SkTypes.h"
 
+#include <functional>
+
 class SkCanvas;
 class SkData;
+class SkExecutor;
 struct SkDeserialProcs;
 class SkImage;
 class SkMatrix;
@@ -80,6 +83,25 @@ public:
     static sk_sp<SkPicture> MakeFromData(const void* data, size_t size,
                                          const SkDeserialProcs* procs = nullptr);
 
+    /** Recreates SkPicture that was serialized into data, like MakeFromData(), but the returned
+        SkPicture plays its drawing commands back straight from data instead of copying them into
+        a recording of its own. data is referenced rather than copied, so it may come from
+        SkData::MakeFromFileName() to play a picture back from a memory mapped file.
+
+        If the picture was recorded with an SkBBHFactory, playback only reads the drawing
+        commands that touch the canvas clip, so each tile of a large picture touches only its
+        own part of data. Paints, paths, text blobs, images and nested pictures are still
+        decoded up front.
+        Returns nullptr if data does not permit constructing valid SkPicture. If data holds a
+        picture encoded by procs->fPictureProc, returns what MakeFromData() would.
+
+        @param data   container for serial data
+        @param procs  custom serial data decoders; may be nullptr
+        @return       SkPicture that plays back from data
+    */
+    static sk_sp<SkPicture> MakeFromDataForPlayback(sk_sp<SkData> data,
+                                                    const SkDeserialProcs* procs = nullptr);
+
     /** \class SkPicture::AbortCallback
         AbortCallback is an abstract class. An implementation of AbortCallback may
         passed as a parameter to SkPicture::playback, to stop it before all drawing
@@ -126,6 +148,23 @@ public:
     */
     virtual void playback(SkCanvas* canvas, AbortCallback* callback = nullptr) const = 0;
 
+    /** Replays the drawing commands on tileCount canvases concurrently, one task per canvas
+        on executor. Each canvas should have its own matrix and clip set up to select its tile;
+        when SkPicture was recorded with a bounding box hierarchy, each tile only visits the
+        commands that intersect its clip.
+
+        tileCanvas is called on the calling thread, once per tile index in [0, tileCount),
+        before any playback starts. Returned canvases must be distinct and stay valid until
+        playbackParallel() returns; tiles with a nullptr canvas are skipped. The recorded
+        commands are shared by all tiles; only canvas state is per tile.
+
+        @param tileCount   number of tiles to draw
+        @param tileCanvas  returns receiver of drawing commands for each tile index
+        @param executor    runs tile playback; if nullptr, SkExecutor::GetDefault() is used
+    */
+    void playbackParallel(int tileCount, const std::function<SkCanvas*(int tile)>& tileCanvas,
+                          SkExecutor* executor = nullptr) const;
+
     /** Returns cull SkRect for this picture, passed in when SkPicture was created.
         Returned SkRect does not specify clipping SkRect for SkPicture; cull is hint
         of SkPicture bounds.
@@ -219,11 +258,14 @@ private:
     friend class SkBigPicture;
     friend class SkEmptyPicture;
     friend class SkPicturePriv;
+    friend class SkPlaybackPicture;
     template <typename> friend class SkMiniPicture;
 
-    void serialize(SkWStream*, const SkSerialProcs*, class SkRefCntSet* typefaces) const;
+    void serialize(SkWStream*, const SkSerialProcs*, class SkRefCntSet* typefaces,
+                   class SkPictureObjectSet* objects = nullptr) const;
     static sk_sp<SkPicture> MakeFromStream(SkStream*, const SkDeserialProcs*,
-                                           class SkTypefacePlayback*);
+                                           class SkTypefacePlayback*,
+                                           struct SkPictureObjectPlayback* objects = nullptr);
     friend class SkPictureData;
 
     /** Return true if the SkStream/Buffer represents a serialized picture, and
@@ -277,10 +319,12 @@ private:
     // V66: Add saveBehind
     // V67: Blobs serialize fonts instead of paints
     // V68: Paint doesn't serialize font-related stuff
+    // V69: Pictures with a bbh serialize the bounds of their ops
+    // V70: Sub-pictures and images repeated within a picture are written once
 
     // Only SKPs within the min/current picture version range (inclusive) can be read.
     static const uint32_t     MIN_PICTURE_VERSION = 56;     // august 2017
-    static const uint32_t CURRENT_PICTURE_VERSION = 68;
+    static const uint32_t CURRENT_PICTURE_VERSION = 70;
 
     static_assert(MIN_PICTURE_VERSION <= 62, "Remove kFontAxes_bad from SkFontDescriptor.cpp");
 
@@ -36,6 +36,10 @@ public:
         // If you call drawPicture() or drawDrawable() on the recording canvas, this flag forces
         // that object to playback its contents immediately rather than reffing the object.
         kPlaybackDrawPicture_RecordFlag     = 1 << 0,
+        // Drops draws that a later opaque, aliased rect or paint under the same clip overwrites
+        // completely. Pixels on the edge of an anti-aliased clip the picture is played back under
+        // may come out slightly differently.
+        kCullOccludedDraws_RecordFlag       = 1 << 1,
     };
 
     enum FinishFlags {
@@ -20,6 +20,7 @@
 
 class SkCanvas;
 class SkDeferredDisplayList;
+class SkExecutor;
 class SkPaint;
 class SkSurfaceCharacterization;
 class GrBackendRenderTarget;
@@ -160,6 +161,31 @@ public:
     static sk_sp<SkSurface> MakeRasterN32Premul(int width, int height,
                                                 const SkSurfaceProps* surfaceProps = nullptr);
 
+    /** Allocates raster SkSurface whose SkCanvas records draws instead of executing them.
+        Recorded draws are binned by their bounds into tiles of tileSize by tileSize pixels,
+        and each tile is played back concurrently on executor when the contents are needed:
+        by makeImageSnapshot(), readPixels(), peekPixels(), draw(), writePixels() or flush().
+
+        Clip and matrix state, and saveLayer() calls still open when the contents are needed,
+        are carried over so that later draws land where they would on a MakeRaster() surface.
+        Draws inside a saveLayer() that has not yet been restored are deferred until it is.
+
+        Image filters that sample outside their destination bounds, such as blurs, may
+        see tile edges, as they would when drawing each tile into its own raster surface.
+
+        @param imageInfo  width, height, SkColorType, SkAlphaType, SkColorSpace,
+                          of raster surface; width and height must be greater than zero
+        @param executor   runs tile playback; if nullptr, SkExecutor::GetDefault() is used
+        @param tileSize   width and height of each tile in pixels; must be greater than zero
+        @param props      LCD striping orientation and setting for device independent fonts;
+                          may be nullptr
+        @return           SkSurface if all parameters are valid; otherwise, nullptr
+    */
+    static sk_sp<SkSurface> MakeRasterThreaded(const SkImageInfo& imageInfo,
+                                               SkExecutor* executor,
+                                               int tileSize = 512,
+                                               const SkSurfaceProps* props = nullptr);
+
     /** Caller data passed to RenderTarget/TextureReleaseProc; may be nullptr. */
     typedef void* ReleaseContext;
 
@@ -711,6 +737,37 @@ public:
                                    RescaleGamma rescaleGamma, SkFilterQuality rescaleQuality,
                                    ReadPixelsCallback callback, ReadPixelsContext context);
 
+    /** Like asyncRescaleAndReadPixels, but the rescaled pixels are converted to YUV and returned
+        as three planes, ordered Y, U, V, of one byte per pixel, e.g. to feed a video encoder.
+
+        srcRect is rescaled to dstW x dstH and converted to dstColorSpace, as it would be by
+        asyncRescaleAndReadPixels. It is then converted to Y, U and V with yuvColorSpace. The Y
+        plane is dstW x dstH, and the U and V planes are half that in each direction, each of their
+        values averaging a 2x2 block of the rescaled pixels. On the GPU backend the conversion is
+        done on the GPU, so that only the planes are read back.
+
+        Fails, calling callback with nullptr for 'data', if srcRect is not contained by the bounds
+        of the surface, or if dstW or dstH is not even and positive.
+
+        @param yuvColorSpace    the conversion from RGB to YUV
+        @param dstColorSpace    color space the rescaled pixels are converted to before YUV
+        @param srcRect          subrectangle of surface to read
+        @param dstW             width srcRect is rescaled to
+        @param dstH             height srcRect is rescaled to
+        @param rescaleGamma     as in asyncRescaleAndReadPixels
+        @param rescaleQuality   as in asyncRescaleAndReadPixels
+        @param callback         function to call with the three planes
+        @param context          passed to callback
+     */
+    using ReadPixelsCallbackYUV420 = void(ReadPixelsContext, const void* data[3],
+                                          const size_t rowBytes[3]);
+    void asyncRescaleAndReadPixelsYUV420(SkYUVColorSpace yuvColorSpace,
+                                         sk_sp<SkColorSpace> dstColorSpace,
+                                         const SkIRect& srcRect, int dstW, int dstH,
+                                         RescaleGamma rescaleGamma, SkFilterQuality rescaleQuality,
+                                         ReadPixelsCallbackYUV420 callback,
+                                         ReadPixelsContext context);
+
     /** Copies SkRect of pixels from the src SkPixmap to the SkSurface.
 
         Source SkRect corners are (0, 0) and (src.width(), src.height()).
@@ -172,6 +172,12 @@ public:
         kHasColors_BuilderFlag      = 1 << 1,
         kHasBones_BuilderFlag       = 1 << 2,
         kIsNonVolatile_BuilderFlag  = 1 << 3,
+        // Reorders the triangles of an indexed kTriangles (or kTriangleFan) mesh in detach() so
+        // that each one reuses the vertices the GPU most recently transformed, and renumbers the
+        // vertices in the order the triangles first use them. The same triangles are drawn, but in
+        // a different order, so only use this when overlapping triangles don't care which is drawn
+        // first.
+        kOptimizeForVertexCache_BuilderFlag = 1 << 4,
     };
     class Builder {
     public:
@@ -203,6 +209,7 @@ public:
         // Extra storage for intermediate vertices in the case where the client specifies indexed
         // triangle fans. These get converted to indexed triangles when the Builder is finalized.
         std::unique_ptr<uint8_t[]> fIntermediateFanIndices;
+        bool fOptimizeForVertexCache = false;
 
         friend class SkVertices;
     };
@@ -9,7 +9,10 @@
 #include "include/core/SkString.h"
 #include "include/core/SkTime.h"
 
+#include <memory>
+
 class SkExecutor;
+class SkPicture;
 
 namespace SkPDF {
 
@@ -79,6 +82,28 @@ struct StructureElementNode {
     DocumentStructureType fType;
 };
 
+/** Font subsets that documents made with the same cache share: the subset font program, its
+    glyph widths and its ToUnicode CMap, for a typeface and the glyphs a document uses from it.
+    Documents that use the same fonts for the same glyphs (like ones made from one template)
+    then only subset each font once.  A cache keeps up to its byte limit of subsets, dropping
+    the least recently used ones, and may be used by many documents on many threads at once.
+
+    Experimental.
+*/
+class SK_API FontSubsetCache {
+public:
+    /** Returns null if PDF support isn't compiled in. */
+    static std::unique_ptr<FontSubsetCache> Make(size_t byteLimit);
+
+    virtual ~FontSubsetCache() = default;
+
+    /** The size of the subsets the cache holds. */
+    virtual size_t bytesUsed() const = 0;
+
+protected:
+    FontSubsetCache() = default;
+};
+
 /** Optional metadata to be passed into the PDF factory function.
 */
 struct Metadata {
@@ -160,6 +185,17 @@ struct Metadata {
     */
     SkExecutor* fExecutor = nullptr;
 
+    /** If true, each page is written out as soon as it ends, and the
+        document only keeps what is shared between pages (fonts, graphic
+        states, images) until it is closed.  This bounds memory use for
+        documents with many pages, at the cost of a page tree that is laid
+        out a little differently.  If fExecutor is set, ending a page also
+        waits for enough of the pending work to bound the memory it holds.
+
+        Experimental.
+    */
+    bool fStreamPages = false;
+
     /** Preferred Subsetter. Only respected if both are compiled in.
         Experimental.
     */
@@ -167,6 +203,25 @@ struct Metadata {
         kHarfbuzz_Subsetter,
         kSfntly_Subsetter,
     } fSubsetter = kHarfbuzz_Subsetter;
+
+    /** How hard to deflate content streams and images: the zlib levels they're compressed at.
+        Lower levels make larger files faster. kNone_CompressionLevel leaves content streams
+        uncompressed, and stores images without compressing them. At any level a stream
+        compresses to the same bytes with or without fExecutor.
+    */
+    enum CompressionLevel : int {
+        kDefault_CompressionLevel = -1,
+        kNone_CompressionLevel = 0,
+        kLowButFast_CompressionLevel = 1,
+        kAverage_CompressionLevel = 6,
+        kHighButSlow_CompressionLevel = 9,
+    } fCompressionLevel = kDefault_CompressionLevel;
+
+    /** If set, fonts are subset through this cache, and the subsets are kept in it for other
+        documents. The caller should retain ownership, and keep it alive until the document is
+        closed.
+    */
+    FontSubsetCache* fFontSubsetCache = nullptr;
 };
 
 /** Associate a node ID with subsequent drawing commands in an
@@ -198,5 +253,20 @@ static inline sk_sp<SkDocument> MakeDocument(SkWStream* stream) {
     return MakeDocument(stream, Metadata());
 }
 
+/** Add a page to the end of a document for each picture, as if each were drawn
+    between beginPage() and endPage().  Each page covers its picture's cull rect,
+    from the origin.  If Metadata::fExecutor is set, the pages are drawn and
+    converted to PDF in parallel, sharing fonts, images and other resources
+    between them as usual.
+
+    Experimental.
+
+    @param document A document returned by MakeDocument(), that is not closed.
+                    If it has a page in progress, that page is ended first.
+    @param pages    The contents of each page, in order.
+    @param count    The number of pages.
+*/
+SK_API void AppendPages(SkDocument* document, const sk_sp<SkPicture> pages[], int count);
+
 }  // namespace SkPDF
 #endif  // SkPDFDocument_DEFINED
@@ -0,0 +1,37 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkColorCubeFilter_DEFINED
+#define SkColorCubeFilter_DEFINED
+
+#include "include/core/SkColorFilter.h"
+#include "include/core/SkData.h"
+
+class SK_API SkColorCubeFilter {
+public:
+    static constexpr int kMinDimension = 2;
+    static constexpr int kMaxDimension = 64;
+
+    /**
+     *  Create a colorfilter that maps colors through a 3D lookup table, e.g. for color grading.
+     *  cubeData holds cubeDimension^3 SkColors, with red varying fastest: the color for the
+     *  lattice point (r, g, b) is at index r + g*cubeDimension + b*cubeDimension*cubeDimension,
+     *  where each of r, g and b runs over [0, cubeDimension) to cover [0, 1]. Colors between the
+     *  lattice points are interpolated trilinearly.
+     *
+     *  Colors are looked up unpremultiplied, and the alpha of the table's colors is ignored: the
+     *  filter leaves alpha unchanged.
+     *
+     *  Returns nullptr if cubeDimension is outside [kMinDimension, kMaxDimension] or cubeData is
+     *  not the right size.
+     */
+    static sk_sp<SkColorFilter> Make(sk_sp<SkData> cubeData, int cubeDimension);
+
+    static void RegisterFlattenables();
+};
+
+#endif
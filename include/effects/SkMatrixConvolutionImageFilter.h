@@ -14,6 +14,8 @@
 #include "include/core/SkScalar.h"
 #include "include/core/SkSize.h"
 
+#include <memory>
+
 class SkBitmap;
 
 /*! \class SkMatrixConvolutionImageFilter
@@ -96,6 +98,9 @@ private:
     SkIPoint  fKernelOffset;
     TileMode  fTileMode;
     bool      fConvolveAlpha;
+    // If the kernel is the outer product of a column and a row, this holds the row's
+    // fKernelSize.fWidth values followed by the column's fKernelSize.fHeight values.
+    std::unique_ptr<SkScalar[]> fSeparableKernel;
 
     template <class PixelFetcher, bool convolveAlpha>
     void filterPixels(const SkBitmap& src,
@@ -103,6 +108,24 @@ private:
                       SkIVector& offset,
                       const SkIRect& rect,
                       const SkIRect& bounds) const;
+    template <class PixelFetcher, bool convolveAlpha>
+    void filterPixelsSeparable(const SkBitmap& src,
+                               SkBitmap* result,
+                               SkIVector& offset,
+                               const SkIRect& rect,
+                               const SkIRect& bounds) const;
+    template <class PixelFetcher, bool convolveAlpha>
+    void filterPixelsFFT(const SkBitmap& src,
+                         SkBitmap* result,
+                         SkIVector& offset,
+                         const SkIRect& rect,
+                         const SkIRect& bounds) const;
+    template <class PixelFetcher, bool convolveAlpha>
+    void filterPixelsDirect(const SkBitmap& src,
+                            SkBitmap* result,
+                            SkIVector& offset,
+                            const SkIRect& rect,
+                            const SkIRect& bounds) const;
     template <class PixelFetcher>
     void filterPixels(const SkBitmap& src,
                       SkBitmap* result,
@@ -26,6 +26,7 @@ protected:
                                         SkIPoint* offset) const override;
     SkIRect onFilterNodeBounds(const SkIRect&, const SkMatrix& ctm,
                                MapDirection, const SkIRect* inputRect) const override;
+    bool onIsOffsetNode(const SkMatrix& ctm, SkIPoint* offset) const override;
 
 private:
     SK_FLATTENABLE_HOOKS(SkOffsetImageFilter)
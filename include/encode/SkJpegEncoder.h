@@ -82,6 +82,31 @@ public:
     static std::unique_ptr<SkEncoder> Make(SkWStream* dst, const SkPixmap& src,
                                            const Options& options);
 
+    /**
+     *  Encodes a series of images with the same options, one after another.
+     *
+     *  This keeps libjpeg's compressor and our row buffer from one image to the next, and
+     *  while the SkImageInfo stays the same, the encoding parameters, quantization tables and
+     *  ICC marker too. This saves most of the fixed cost of Encode() when there are many
+     *  small images.
+     *
+     *  A Batch is not thread safe.
+     */
+    class SK_API Batch {
+    public:
+        virtual ~Batch() {}
+
+        /**
+         *  Encode the |src| pixels to the |dst| stream, as Encode() would.
+         */
+        virtual bool encode(SkWStream* dst, const SkPixmap& src) = 0;
+    };
+
+    /**
+     *  Returns nullptr if jpeg encoding is not supported.
+     */
+    static std::unique_ptr<Batch> MakeBatch(const Options& options);
+
     ~SkJpegEncoder() override;
 
 protected:
@@ -80,6 +80,30 @@ public:
     static std::unique_ptr<SkEncoder> Make(SkWStream* dst, const SkPixmap& src,
                                            const Options& options);
 
+    /**
+     *  Encodes a series of images with the same options, one after another.
+     *
+     *  This recycles libpng's memory (including zlib's deflate buffers) and our row buffer
+     *  from one image to the next, which saves most of the fixed cost of Encode() when there
+     *  are many small images, especially images of the same SkImageInfo.
+     *
+     *  A Batch is not thread safe.
+     */
+    class SK_API Batch {
+    public:
+        virtual ~Batch() {}
+
+        /**
+         *  Encode the |src| pixels to the |dst| stream, as Encode() would.
+         */
+        virtual bool encode(SkWStream* dst, const SkPixmap& src) = 0;
+    };
+
+    /**
+     *  Returns nullptr if png encoding is not supported.
+     */
+    static std::unique_ptr<Batch> MakeBatch(const Options& options);
+
     ~SkPngEncoder() override;
 
 protected:
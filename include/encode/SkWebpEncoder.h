@@ -8,8 +8,10 @@
 #ifndef SkWebpEncoder_DEFINED
 #define SkWebpEncoder_DEFINED
 
+#include "include/core/SkPixmap.h"
 #include "include/encode/SkEncoder.h"
 
+class SkExecutor;
 class SkWStream;
 
 namespace SkWebpEncoder {
@@ -34,8 +36,33 @@ namespace SkWebpEncoder {
          */
         Compression fCompression = Compression::kLossy;
         float fQuality = 100.0f;
+
+        /**
+         *  |fMethod| is libwebp's trade-off between encoding speed and size, from 0 (fastest) to
+         *  6 (slowest, and smallest). If it is negative, we use 3 for lossy and 0 for lossless,
+         *  which match Chrome's defaults.
+         */
+        int fMethod = -1;
+
+        /**
+         *  If |fMultithreaded| is true, libwebp may use a thread of its own to encode faster
+         *  (libwebp's thread_level). This helps lossy compression the most.
+         */
+        bool fMultithreaded = false;
     };
 
+    /**
+     *  Options for the fastest lossless encoding libwebp offers (its lossless preset 0), for
+     *  when encoding time matters more than size.
+     */
+    inline Options FastLosslessOptions() {
+        Options options;
+        options.fCompression = Compression::kLossless;
+        options.fQuality = 0.0f;
+        options.fMethod = 0;
+        return options;
+    }
+
     /**
      *  Encode the |src| pixels to the |dst| stream.
      *  |options| may be used to control the encoding behavior.
@@ -43,6 +70,21 @@ namespace SkWebpEncoder {
      *  Returns true on success.  Returns false on an invalid or unsupported |src|.
      */
     SK_API bool Encode(SkWStream* dst, const SkPixmap& src, const Options& options);
+
+    struct Frame {
+        SkPixmap fPixmap;
+        int      fDuration;  // In milliseconds.
+    };
+
+    /**
+     *  Encode |frameCount| frames, which must all be the same size, to the |dst| stream as an
+     *  animated WebP that loops forever. Each frame is encoded whole, independently of the
+     *  others, so if |executor| is non-null they are encoded on it in parallel.
+     *
+     *  Returns true on success.  Returns false on an invalid or unsupported frame.
+     */
+    SK_API bool EncodeAnimated(SkWStream* dst, const Frame frames[], int frameCount,
+                               const Options& options, SkExecutor* executor = nullptr);
 }
 
 #endif
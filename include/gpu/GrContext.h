@@ -8,6 +8,7 @@
 #ifndef GrContext_DEFINED
 #define GrContext_DEFINED
 
+#include "include/core/SkGraphics.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPathEffect.h"
 #include "include/core/SkTypes.h"
@@ -39,7 +40,9 @@ class GrTextContext;
 class GrTextureProxy;
 struct GrVkBackendContext;
 
+class SkData;
 class SkImage;
+class SkImageFilterCache;
 class SkSurfaceProps;
 class SkTaskGroup;
 class SkTraceMemoryDump;
@@ -209,6 +212,17 @@ public:
      */
     void purgeUnlockedResources(bool scratchResourcesOnly);
 
+    /**
+     * Trims the context's caches under memory pressure, least valuable first: the text blob
+     * cache, then the coverage counting path cache, then unlocked GPU resources (scratch resources
+     * before ones with persistent data). Under critical pressure this frees as much as
+     * freeGpuResources() does. What was freed is added to 'result', if not null.
+     *
+     * This complements SkGraphics::OnMemoryPressure(), which trims the global caches.
+     */
+    void onMemoryPressure(SkGraphics::MemoryPressure,
+                          SkGraphics::MemoryPressureResult* result = nullptr);
+
     /**
      * Gets the maximum supported texture size.
      */
@@ -327,7 +341,10 @@ public:
     GrContextPriv priv();
     const GrContextPriv priv() const;
 
-    /** Enumerates all cached GPU resources and dumps their memory to traceMemoryDump. */
+    /**
+     * Enumerates all cached GPU resources and dumps their memory to traceMemoryDump, along with
+     * how full each page of the glyph atlases is.
+     */
     // Chrome is using this!
     void dumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump) const;
 
@@ -335,6 +352,16 @@ public:
 
     void storeVkPipelineCacheData();
 
+    /**
+     * Compiles the program described by a key/data pair that a context like this one previously
+     * handed to GrContextOptions::PersistentCache::store(), so that the first draw that needs it
+     * doesn't have to. Returns false if the pair can't be used, e.g. because it came from a
+     * different driver or isn't a program. The compiled program lives in the same bounded cache
+     * as programs compiled during draws, so precompiling more programs than that cache holds
+     * evicts the oldest ones. Currently only supported by the GL backend.
+     */
+    bool precompileShader(const SkData& key, const SkData& data);
+
     static size_t ComputeTextureSize(SkColorType type, int width, int height, GrMipMapped,
                                      bool useNextPow2 = false);
 
@@ -396,6 +423,9 @@ private:
     GrContextOptions::PersistentCache*      fPersistentCache;
     GrContextOptions::ShaderErrorHandler*   fShaderErrorHandler;
 
+    // Only made if fCacheImageFilterResults is set.
+    sk_sp<SkImageFilterCache>               fImageFilterCache;
+
     // TODO: have the GrClipStackClip use renderTargetContexts and rm this friending
     friend class GrContextPriv;
 
@@ -31,6 +31,26 @@ struct SK_API GrContextOptions {
         kDefault
     };
 
+    /**
+     * The order in which the resource cache purges unused resources when it is over budget.
+     */
+    enum class ResourceCachePolicy {
+        /** Least recently used first. */
+        kLRU,
+        /**
+         * Resources that are cheap to recreate for their size first, aging expensive ones so they
+         * are eventually purged too (GreedyDual-Size). Producers hint at rebuild costs; resources
+         * without a hint, e.g. scratch render targets, are purged in LRU order before the others.
+         */
+        kCostAware,
+        /**
+         * Least recently used first, but resources that have been reused are kept for about one
+         * more turnover of the cache than resources used once. A burst of one-off resources then
+         * doesn't flush the reused ones out (like 2Q).
+         */
+        kScanResistant,
+    };
+
     /**
      * Abstract class which stores Skia data in a cache that persists between sessions. Currently,
      * Skia stores compiled shader binaries (only when glProgramBinary / glGetProgramBinary are
@@ -102,18 +122,72 @@ struct SK_API GrContextOptions {
      */
     bool fDisableDistanceFieldPaths = false;
 
+    /**
+     * If true, opaque images that are uploaded once and then reused, like decoded or raster
+     * SkImages drawn without mipmaps, are compressed to ETC1 on the CPU before upload when the
+     * GPU supports it, cutting their texture memory to 1/8th at some loss of quality. Only images
+     * whose dimensions are multiples of 4 are compressed. If fExecutor is set, the compression
+     * is spread across its threads.
+     */
+    bool fCompressStaticImages = false;
+
     /**
      * If true this allows path mask textures to be cached. This is only really useful if paths
      * are commonly rendered at the same scale and fractional translation.
      */
     bool fAllowPathMaskCaching = true;
 
+    /**
+     * If true, and path mask caching is allowed, a cached path mask may also be reused when the
+     * path is drawn rotated, or scaled down by up to 2x, from the transform it was rendered with.
+     * The mask is resampled when drawn, which is slightly softer than rendering a new mask but
+     * avoids re-rendering animated paths every frame. Only used by coverage counting paths.
+     */
+    bool fAllowPathMaskResampling = false;
+
     /**
      * If true, the GPU will not be used to perform YUV -> RGB conversion when generating
      * textures from codec-backed images.
      */
     bool fDisableGpuYUVConversion = false;
 
+    /**
+     * If true, textures made from lazily generated images (e.g. encoded ones) are uploaded at half
+     * resolution while the resource cache has too little budget left to fit the full resolution
+     * ones besides the resources in use. The full resolution is used again once the budget allows.
+     */
+    bool fDownscaleImageTexturesOverBudget = false;
+
+    /**
+     * The purge policy of the resource cache.
+     */
+    ResourceCachePolicy fResourceCachePolicy = ResourceCachePolicy::kLRU;
+
+    /**
+     * If true, the ops recorded between flushes are allocated from an arena that is reset as a
+     * whole once they have all been flushed, instead of being returned to the op memory pool one
+     * at a time.
+     */
+    bool fUseFrameArenaForOps = false;
+
+    /**
+     * If true, image filter results are kept from one draw to the next, so that e.g. a static
+     * background blurred under animating content is not blurred again every frame. The results
+     * stay in the resource cache as purgeable textures under its budget. Otherwise each draw with
+     * an image filter only reuses results within its own filter graph.
+     */
+    bool fCacheImageFilterResults = false;
+
+    /**
+     * Each analytic gradient colorizer needs a program of its own for each number of intervals it
+     * handles, where the textured colorizer has one program shared by every gradient. Once
+     * gradients drawn with this context have used this many distinct analytic colorizers, a
+     * gradient that would need yet another one uses the textured colorizer instead. This bounds
+     * the programs compiled for apps that draw many different gradients, at the cost of the
+     * texture's sampling resolution. A negative value means no limit.
+     */
+    int fMaxGradientColorizerShapes = -1;
+
     /**
      * The maximum size of cache textures used for Skia's Glyph cache.
      */
@@ -162,6 +236,30 @@ struct SK_API GrContextOptions {
      */
     Enable fReduceOpListSplitting = Enable::kDefault;
 
+    /**
+     * When recording a draw, Ganesh looks back through this many earlier op chains for one it can
+     * merge the draw into or chain it onto, and when an op list is closed, each chain looks ahead
+     * as far for a later chain to join. Either search stops sooner at anything the draw overlaps,
+     * which preserves painter's order. Larger values help content with many interleaved,
+     * non-overlapping draws of different kinds, at the cost of more comparisons per draw. A value
+     * of zero or less means use the default, which is 10.
+     */
+    int fMaxOpChainDistance = -1;
+
+    /**
+     * When two op chains are concatenated, each op looks back through up to this many ops of the
+     * other chain for one to merge with. A value of zero or less means use the default, which is 10.
+     */
+    int fMaxOpMergeDistance = -1;
+
+    /**
+     * Controls whether dynamic vertex and index data is written to a persistently mapped buffer
+     * that is reused as a ring across flushes, with fences tracking what the GPU may still read,
+     * rather than to freshly mapped buffers each flush. This is only available on GL with
+     * GL_ARB_buffer_storage (or GL 4.4) or GL_EXT_buffer_storage. The default currently is not to.
+     */
+    Enable fUsePersistentlyMappedBuffers = Enable::kDefault;
+
     /**
      * Some ES3 contexts report the ES2 external image extension, but not the ES3 version.
      * If support for external images is critical, enabling this option will cause Ganesh to limit
@@ -189,6 +287,24 @@ struct SK_API GrContextOptions {
      */
      bool fDisallowGLSLBinaryCaching = false;
 
+    /**
+     * Cache in which to store distance field glyph images between runs. Before generating the
+     * distance field for a glyph the context looks it up here, keyed on the typeface's descriptor,
+     * the glyph ID and the distance field parameters, and stores any image it had to generate.
+     * This may be a different object than fPersistentCache, but need not be; the keys don't
+     * collide.
+     */
+    PersistentCache* fDistanceFieldGlyphCache = nullptr;
+
+    /**
+     * If true, and both fExecutor and fPersistentCache are set, backends may start loading data
+     * from the PersistentCache on fExecutor as soon as the context is created, rather than on the
+     * thread that first needs it. PersistentCache::load() may then be called from a worker thread.
+     * Currently this only affects Vulkan, which seeds its VkPipelineCache this way so the first
+     * pipeline compile does not also pay for reading and ingesting the cached blob.
+     */
+    bool fLoadPersistentCacheOnExecutor = false;
+
      /**
       * If present, use this object to report shader compilation failures. If not, report failures
       * via SkDebugf and assert.
@@ -358,6 +358,13 @@ private:
     // by the cache.
     uint32_t fTimestamp;
     GrStdSteadyClock::time_point fTimeWhenBecamePurgeable;
+    // The purge order of this resource while it is purgeable, under the cache's purge policy:
+    // lower goes first. This is maintained by the cache.
+    double fPurgeKey = 0;
+    // The producer's estimate of what recreating this resource would cost (see ResourcePriv).
+    float fRebuildCostHint = 0;
+    // Whether a cache lookup has returned this resource since it was created.
+    bool fWasReused = false;
 
     static const size_t kInvalidGpuMemorySize = ~static_cast<size_t>(0);
     GrScratchKey fScratchKey;
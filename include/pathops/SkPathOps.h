@@ -107,6 +107,7 @@ private:
 
     static bool FixWinding(SkPath* path);
     static void ReversePath(SkPath* path);
+    static bool ResolveUnion(SkPath* paths[], int count, SkPath* result);
     void reset();
 };
 
@@ -103,6 +103,9 @@ protected:
 
     GrAuditTrail* auditTrail() { return &fAuditTrail; }
 
+    // One bit for each analytic gradient colorizer shape used so far (see GrGradientShader.cpp).
+    uint32_t* gradientColorizerShapes() { return &fGradientColorizerShapes; }
+
     GrRecordingContext* asRecordingContext() override { return this; }
 
 private:
@@ -115,6 +118,8 @@ private:
 
     GrAuditTrail                      fAuditTrail;
 
+    uint32_t                          fGradientColorizerShapes = 0;
+
     typedef GrImageContext INHERITED;
 };
 
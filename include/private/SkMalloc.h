@@ -9,6 +9,7 @@
 #define SkMalloc_DEFINED
 
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
 
 #include "include/core/SkTypes.h"
@@ -94,6 +95,58 @@ static inline void* sk_malloc_canfail(size_t size) {
 }
 SK_API extern void* sk_malloc_canfail(size_t count, size_t elemSize);
 
+/**
+ *  The subsystems that memory from sk_malloc() and friends can be charged to. When Skia is built
+ *  with SK_TRACK_MEMORY_TAGS, each allocation is charged to the tag its thread had set when it was
+ *  made (see SkAutoMemoryTag), or reallocated. Only the malloc porting layer keeps track.
+ */
+enum class SkMemoryTag : uint8_t {
+    kUntagged,
+    kGlyphs,
+    kCodec,
+    kPathOps,
+    kPDF,
+    kGpuCPUData,
+
+    kLast = kGpuCPUData,
+};
+static constexpr int kSkMemoryTagCount = static_cast<int>(SkMemoryTag::kLast) + 1;
+
+struct SkMemoryTagStats {
+    size_t   fLiveBytes       = 0;  // allocated and not yet freed
+    uint64_t fAllocationCount = 0;  // ever allocated, to measure allocation rates
+    uint64_t fAllocatedBytes  = 0;  // ever allocated
+};
+
+#if defined(SK_TRACK_MEMORY_TAGS)
+/** Sets the tag the calling thread's allocations are charged to, returning the previous one. */
+SK_API extern SkMemoryTag sk_set_memory_tag(SkMemoryTag);
+#else
+static inline SkMemoryTag sk_set_memory_tag(SkMemoryTag) { return SkMemoryTag::kUntagged; }
+#endif
+
+/**
+ *  Fills out the statistics of the allocations charged to tag. Returns false, leaving stats
+ *  zeroed, if Skia is not built with SK_TRACK_MEMORY_TAGS.
+ */
+SK_API extern bool sk_get_memory_tag_stats(SkMemoryTag tag, SkMemoryTagStats* stats);
+
+/** Returns a short name for tag, e.g. "glyphs". */
+SK_API extern const char* sk_memory_tag_name(SkMemoryTag tag);
+
+/** Charges the calling thread's allocations to a tag while in scope. */
+class SkAutoMemoryTag {
+public:
+    explicit SkAutoMemoryTag(SkMemoryTag tag) : fPrevious(sk_set_memory_tag(tag)) {}
+    ~SkAutoMemoryTag() { sk_set_memory_tag(fPrevious); }
+
+    SkAutoMemoryTag(const SkAutoMemoryTag&) = delete;
+    SkAutoMemoryTag& operator=(const SkAutoMemoryTag&) = delete;
+
+private:
+    SkMemoryTag fPrevious;
+};
+
 // bzero is safer than memset, but we can't rely on it, so... sk_bzero()
 static inline void sk_bzero(void* buffer, size_t size) {
     // Please c.f. sk_careful_memcpy.  It's undefined behavior to call memset(null, 0, 0).
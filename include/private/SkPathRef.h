@@ -240,6 +240,15 @@ public:
 
     static SkPathRef* CreateFromBuffer(SkRBuffer* buffer);
 
+    /**
+     * Makes a path ref holding copies of the given arrays in a single allocation of exactly the
+     * needed size. The verbs are in the order they are drawn. Returns nullptr if the verbs don't
+     * form a valid sequence, or don't use exactly pointCount points and conicWeightCount weights.
+     */
+    static SkPathRef* CreateFromArrays(const SkPoint pts[], int pointCount,
+                                       const uint8_t verbs[], int verbCount,
+                                       const SkScalar conicWeights[], int conicWeightCount);
+
     /**
      * Rollsback a path ref to zero verbs and points with the assumption that the path ref will be
      * repopulated with approximately the same number of verbs and points. A new path ref is created
@@ -14,18 +14,29 @@ class SkWStream;
 
 class SK_API SkSVGCanvas {
 public:
+    enum {
+        kNoPrettyXML_Flag          = 0x01,  //!< Don't indent elements or put them on own lines.
+        kRelativePathEncoding_Flag = 0x02,  //!< Write compact, relative path data.
+    };
+
     /**
      *  Returns a new canvas that will generate SVG commands from its draw calls, and send
      *  them to the provided stream. Ownership of the stream is not transfered, and it must
      *  remain valid for the lifetime of the returned canvas.
      *
-     *  The canvas may buffer some drawing calls, so the output is not guaranteed to be valid
-     *  or complete until the canvas instance is deleted.
+     *  Each draw is written to the stream as it is made; only the enclosing elements are left
+     *  open, so the output is not guaranteed to be valid or complete until the canvas instance is
+     *  deleted. Gradients, image shaders, images and clips used by more than one draw are written
+     *  once, and referred to by the later draws.
      *
      *  The 'bounds' parameter defines an initial SVG viewport (viewBox attribute on the root
      *  SVG element).
+     *
+     *  If 'pathDecimalPlaces' is not negative, path coordinates are rounded to that many digits
+     *  after the decimal point.
      */
-    static std::unique_ptr<SkCanvas> Make(const SkRect& bounds, SkWStream*);
+    static std::unique_ptr<SkCanvas> Make(const SkRect& bounds, SkWStream*, uint32_t flags = 0,
+                                          int pathDecimalPlaces = -1);
 };
 
 #endif
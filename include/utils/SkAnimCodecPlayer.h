@@ -10,11 +10,32 @@
 
 #include "include/codec/SkCodec.h"
 
+class SkData;
+class SkExecutor;
 class SkImage;
 
+/**
+ *  Plays back the frames of an animated image.
+ *
+ *  Decoded frames are kept in the SkResourceCache (and count against its budget), so recent
+ *  frames are not decoded again when the animation loops or seeks back, and a frame that depends
+ *  on an earlier one is decoded from it if that is still in the cache.
+ */
 class SkAnimCodecPlayer {
 public:
-    SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec);
+    /**
+     *  If executor is not null, it is used to decode the frame after the one getFrame() returns
+     *  while that one is displayed.
+     */
+    SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec, SkExecutor* executor = nullptr);
+
+    /**
+     *  Plays the animated image encoded in data. Players made from the same SkData share one
+     *  decoder and its cached frames, so a frame shown by several of them is only decoded once.
+     *  If data can't be decoded, getFrame() returns null.
+     */
+    SkAnimCodecPlayer(sk_sp<SkData> data, SkExecutor* executor = nullptr);
+
     ~SkAnimCodecPlayer();
 
     /**
@@ -46,14 +67,20 @@ public:
 
 
 private:
-    std::unique_ptr<SkCodec>        fCodec;
+    class Decoder;
+
+    sk_sp<Decoder>                  fDecoder;
+    SkExecutor*                     fExecutor;
     SkImageInfo                     fImageInfo;
     std::vector<SkCodec::FrameInfo> fFrameInfos;
-    std::vector<sk_sp<SkImage> >    fImages;
+    // The frame at fImageIndex, or the whole image if it isn't animated.
+    sk_sp<SkImage>                  fImage;
+    int                             fImageIndex = -1;
     int                             fCurrIndex = 0;
-    uint32_t                        fTotalDuration;
+    uint32_t                        fTotalDuration = 0;
 
-    sk_sp<SkImage> getFrameAt(int index);
+    void init(std::unique_ptr<SkCodec>, sk_sp<SkData>);
+    void initFrames();
 };
 
 #endif
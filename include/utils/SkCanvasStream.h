@@ -0,0 +1,173 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkCanvasStream_DEFINED
+#define SkCanvasStream_DEFINED
+
+#include "include/core/SkCanvasVirtualEnforcer.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkTypeface.h"
+#include "include/private/SkTHash.h"
+#include "include/utils/SkNoDrawCanvas.h"
+
+#include <memory>
+
+class SkBinaryWriteBuffer;
+class SkReadBuffer;
+class SkStream;
+class SkStrikeClient;
+class SkStrikeServer;
+class SkWStream;
+
+/**
+ *  An SkCanvas that serializes each command as it is made, and sends them to a stream in chunks
+ *  for an SkCanvasStreamPlayer (in another process, say) to draw as they arrive. Unlike recording
+ *  an SkPicture, nothing waits for the recording to finish, so recording and drawing overlap.
+ *
+ *  Each chunk is a 32-bit byte count followed by that many bytes of commands. Typefaces and images
+ *  are sent the first time a chunk uses them, and are referred to by unique ID after that.
+ *  Pictures and drawables are sent as the commands they draw.
+ */
+class SK_API SkCanvasStreamRecorder final : public SkCanvasVirtualEnforcer<SkNoDrawCanvas> {
+public:
+    struct Options {
+        // A chunk is sent once it holds at least this many bytes, and whenever flush() is called.
+        size_t fChunkSize = 64 * 1024;
+
+        // If not null, typefaces are sent as this server's typeface handles, and the player needs
+        // the matching SkStrikeClient; glyphs then reach the player in the server's strike data.
+        // Otherwise typefaces are sent with SkTypeface::serialize().
+        SkStrikeServer* fStrikeServer = nullptr;
+    };
+
+    // stream must outlive the recorder.
+    SkCanvasStreamRecorder(int width, int height, SkWStream* stream);
+    SkCanvasStreamRecorder(int width, int height, SkWStream* stream, const Options& options);
+    // Sends any commands still waiting.
+    ~SkCanvasStreamRecorder() override;
+
+    // Sends the commands recorded since the last chunk, if there are any.
+    void sendChunk();
+
+    enum class Op : uint32_t;
+
+protected:
+    void onFlush() override;
+
+    void willSave() override;
+    SaveLayerStrategy getSaveLayerStrategy(const SaveLayerRec&) override;
+    bool onDoSaveBehind(const SkRect*) override;
+    void willRestore() override;
+
+    void didConcat(const SkMatrix&) override;
+    void didSetMatrix(const SkMatrix&) override;
+    void didTranslate(SkScalar, SkScalar) override;
+
+    void onClipRect(const SkRect&, SkClipOp, ClipEdgeStyle) override;
+    void onClipRRect(const SkRRect&, SkClipOp, ClipEdgeStyle) override;
+    void onClipPath(const SkPath&, SkClipOp, ClipEdgeStyle) override;
+    void onClipRegion(const SkRegion&, SkClipOp) override;
+
+    void onDrawPaint(const SkPaint&) override;
+    void onDrawBehind(const SkPaint&) override;
+    void onDrawPoints(PointMode, size_t count, const SkPoint pts[], const SkPaint&) override;
+    void onDrawRect(const SkRect&, const SkPaint&) override;
+    void onDrawRegion(const SkRegion&, const SkPaint&) override;
+    void onDrawOval(const SkRect&, const SkPaint&) override;
+    void onDrawArc(const SkRect&, SkScalar, SkScalar, bool, const SkPaint&) override;
+    void onDrawRRect(const SkRRect&, const SkPaint&) override;
+    void onDrawDRRect(const SkRRect&, const SkRRect&, const SkPaint&) override;
+    void onDrawPath(const SkPath&, const SkPaint&) override;
+    void onDrawTextBlob(const SkTextBlob*, SkScalar x, SkScalar y, const SkPaint&) override;
+    void onDrawPatch(const SkPoint cubics[12], const SkColor colors[4],
+                     const SkPoint texCoords[4], SkBlendMode, const SkPaint&) override;
+    void onDrawVerticesObject(const SkVertices*, const SkVertices::Bone bones[], int boneCount,
+                              SkBlendMode, const SkPaint&) override;
+
+    void onDrawImage(const SkImage*, SkScalar left, SkScalar top, const SkPaint*) override;
+    void onDrawImageRect(const SkImage*, const SkRect* src, const SkRect& dst,
+                         const SkPaint*, SrcRectConstraint) override;
+    void onDrawImageNine(const SkImage*, const SkIRect& center, const SkRect& dst,
+                         const SkPaint*) override;
+    void onDrawImageLattice(const SkImage*, const Lattice&, const SkRect& dst,
+                            const SkPaint*) override;
+    void onDrawBitmap(const SkBitmap&, SkScalar left, SkScalar top, const SkPaint*) override;
+    void onDrawBitmapRect(const SkBitmap&, const SkRect* src, const SkRect& dst, const SkPaint*,
+                          SrcRectConstraint) override;
+    void onDrawBitmapNine(const SkBitmap&, const SkIRect& center, const SkRect& dst,
+                          const SkPaint*) override;
+    void onDrawBitmapLattice(const SkBitmap&, const Lattice&, const SkRect& dst,
+                             const SkPaint*) override;
+    void onDrawAtlas(const SkImage*, const SkRSXform[], const SkRect[], const SkColor[],
+                     int count, SkBlendMode, const SkRect* cull, const SkPaint*) override;
+    void onDrawEdgeAAQuad(const SkRect&, const SkPoint clip[4], QuadAAFlags, SkColor,
+                          SkBlendMode) override;
+    void onDrawEdgeAAImageSet(const ImageSetEntry[], int count, const SkPoint dstClips[],
+                              const SkMatrix preViewMatrices[], const SkPaint*,
+                              SrcRectConstraint) override;
+
+    void onDrawAnnotation(const SkRect&, const char key[], SkData* value) override;
+    void onDrawShadowRec(const SkPath&, const SkDrawShadowRec&) override;
+
+    void onDrawDrawable(SkDrawable*, const SkMatrix*) override;
+    void onDrawPicture(const SkPicture*, const SkMatrix*, const SkPaint*) override;
+
+private:
+    static sk_sp<SkData> SerializeTypeface(SkTypeface*, void* ctx);
+    static sk_sp<SkData> SerializeImage(SkImage*, void* ctx);
+
+    // Starts a new chunk. Each gets its own buffer, so that it can be read on its own.
+    void resetBuffer();
+
+    SkBinaryWriteBuffer& beginOp(Op);
+    // Sends the chunk if it is full.
+    void endOp();
+
+    SkWStream*                           fStream;
+    const Options                        fOptions;
+    std::unique_ptr<SkBinaryWriteBuffer> fBuffer;
+    // Unique IDs of the typefaces and images the player has been sent.
+    SkTHashSet<uint32_t>                 fSentTypefaces;
+    SkTHashSet<uint32_t>                 fSentImages;
+
+    typedef SkCanvasVirtualEnforcer<SkNoDrawCanvas> INHERITED;
+};
+
+/**
+ *  Draws the chunks made by an SkCanvasStreamRecorder into a canvas, as they arrive. The canvas
+ *  keeps its matrix, clip and layers from one chunk to the next, just as if the recorder's
+ *  commands were made on it directly.
+ *
+ *  The player keeps every typeface and image it is sent until it is destroyed.
+ */
+class SK_API SkCanvasStreamPlayer {
+public:
+    // strikeClient must be given if the recorder had an SkStrikeServer.
+    explicit SkCanvasStreamPlayer(SkCanvas* canvas, SkStrikeClient* strikeClient = nullptr);
+    ~SkCanvasStreamPlayer();
+
+    // Draws the commands of one chunk, without its byte count; data must be 4-byte aligned.
+    // Returns false, having drawn the commands before it, if the chunk is malformed.
+    bool playChunk(const void* data, size_t size);
+
+    // Reads and draws chunks until the stream ends. Returns false if it ends mid chunk, or a chunk
+    // is malformed.
+    bool play(SkStream* stream);
+
+private:
+    static sk_sp<SkTypeface> DeserializeTypeface(const void* data, size_t length, void* ctx);
+    static sk_sp<SkImage> DeserializeImage(const void* data, size_t length, void* ctx);
+
+    void playOp(SkCanvasStreamRecorder::Op, SkReadBuffer&);
+
+    SkCanvas*                                 fCanvas;
+    SkStrikeClient*                           fStrikeClient;
+    SkTHashMap<uint32_t, sk_sp<SkTypeface>>   fTypefaces;
+    SkTHashMap<uint32_t, sk_sp<SkImage>>      fImages;
+};
+
+#endif
@@ -17,7 +17,19 @@ class SkString;
 class SkParsePath {
 public:
     static bool FromSVGString(const char str[], SkPath*);
-    static void ToSVGString(const SkPath&, SkString*);
+
+    enum class PathEncoding { Absolute, Relative };
+
+    /**
+     *  Writes the path as SVG path data. Relative encoding measures each command from the end of
+     *  the previous one, and leaves out any separators and repeated commands SVG doesn't need.
+     *
+     *  If decimalPlaces is not negative, coordinates are rounded to that many digits after the
+     *  decimal point and written in the same compact form. Relative coordinates are measured
+     *  between rounded points, so the rounding errors don't add up along the path.
+     */
+    static void ToSVGString(const SkPath&, SkString*, PathEncoding = PathEncoding::Absolute,
+                            int decimalPlaces = -1);
 };
 
 #endif
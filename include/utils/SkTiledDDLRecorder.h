@@ -0,0 +1,68 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkTiledDDLRecorder_DEFINED
+#define SkTiledDDLRecorder_DEFINED
+
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkTypes.h"
+
+#include <memory>
+
+class SkExecutor;
+class SkPicture;
+class SkSurface;
+
+/**
+ *  Records an SkPicture as a grid of SkDeferredDisplayLists, one per tile, in parallel, and then
+ *  replays them into a GPU-backed surface.
+ *
+ *  Each image the picture draws is uploaded once and shared by every tile as a promise image, so
+ *  the tiles don't each upload their own copy.
+ *
+ *      SkTiledDDLRecorder tiles(surface, 4);
+ *      if (tiles.record(picture.get(), executor)) {
+ *          tiles.draw();
+ *      }
+ *
+ *  Both calls must be made on the thread that uses the surface's GrContext; only the recording of
+ *  the tiles happens on the executor.
+ */
+class SK_API SkTiledDDLRecorder {
+public:
+    /**
+     *  Splits 'dst' into numDivisions x numDivisions tiles. 'dst' must outlive this object.
+     */
+    SkTiledDDLRecorder(SkSurface* dst, int numDivisions);
+    ~SkTiledDDLRecorder();
+
+    /**
+     *  Uploads the images drawn by 'picture', then records a display list for each tile as a task
+     *  on 'executor' (or SkExecutor::GetDefault() if it is null), and waits for them to finish.
+     *
+     *  Returns false, leaving nothing to draw, if 'dst' isn't GPU-backed or the tiles' surfaces
+     *  can't be made.
+     */
+    bool record(const SkPicture* picture, SkExecutor* executor = nullptr);
+
+    /**
+     *  Replays each tile's display list into its own surface, draws the tiles into 'dst', and
+     *  flushes once. The display lists are released afterwards, so call record() again before
+     *  drawing again.
+     */
+    void draw();
+
+private:
+    struct Tile;
+    class PromiseImage;
+
+    SkSurface*              fDst;
+    int                     fNumDivisions;
+    std::unique_ptr<Tile[]> fTiles;
+};
+
+#endif
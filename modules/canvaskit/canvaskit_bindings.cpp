@@ -11,6 +11,7 @@
 #include "include/core/SkColor.h"
 #include "include/core/SkData.h"
 #include "include/core/SkEncodedImageFormat.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFilterQuality.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkFontMgr.h"
@@ -160,6 +161,24 @@ sk_sp<SkSurface> MakeRenderTarget(sk_sp<GrContext> grContext, SimpleImageInfo si
 }
 #endif
 
+#ifdef __EMSCRIPTEN_PTHREADS__
+// Threaded builds draw CPU surfaces in tiles on a pool of Web Workers. The workers have to be
+// started before the main thread needs them (it can't wait for a new one to start), so the pool
+// is sized by compile.sh to match PTHREAD_POOL_SIZE.
+#ifndef SK_CANVASKIT_THREADS
+#define SK_CANVASKIT_THREADS 4
+#endif
+
+SkExecutor* GetThreadPool() {
+    static std::unique_ptr<SkExecutor> gThreadPool = [] {
+        std::unique_ptr<SkExecutor> pool = SkExecutor::MakeFIFOThreadPool(SK_CANVASKIT_THREADS);
+        SkExecutor::SetDefault(pool.get());
+        return pool;
+    }();
+    return gThreadPool.get();
+}
+#endif
+
 
 //========================================================================================
 // Path things
@@ -605,6 +624,13 @@ EMSCRIPTEN_BINDINGS(Skia) {
     function("_getRasterN32PremulSurface", optional_override([](int width, int height)->sk_sp<SkSurface> {
         return SkSurface::MakeRasterN32Premul(width, height, nullptr);
     }), allow_raw_pointers());
+#ifdef __EMSCRIPTEN_PTHREADS__
+    function("_getRasterThreadedSurface", optional_override([](const SimpleImageInfo ii)->sk_sp<SkSurface> {
+        return SkSurface::MakeRasterThreaded(toSkImageInfo(ii), GetThreadPool());
+    }), allow_raw_pointers());
+
+    constant("threads", true);
+#endif
 
     function("getSkDataBytes", &getSkDataBytes, allow_raw_pointers());
     function("MakeSkCornerPathEffect", &SkCornerPathEffect::Make, allow_raw_pointers());
@@ -784,6 +810,13 @@ EMSCRIPTEN_BINDINGS(Skia) {
         .function("drawOval", &SkCanvas::drawOval)
         .function("drawPaint", &SkCanvas::drawPaint)
         .function("drawPath", &SkCanvas::drawPath)
+        .function("_drawPoints", optional_override([](SkCanvas& self, SkCanvas::PointMode mode,
+                                                      uintptr_t /* SkPoint* */ pptr,
+                                                      int count, SkPaint& paint)->void {
+            // See comment above for uintptr_t explanation
+            const SkPoint* pts = reinterpret_cast<const SkPoint*>(pptr);
+            self.drawPoints(mode, count, pts, paint);
+        }))
         // Of note, picture is *not* what is colloquially thought of as a "picture", what we call
         // a bitmap. An SkPicture is a series of draw commands.
         .function("drawPicture",  select_overload<void (const sk_sp<SkPicture>&)>(&SkCanvas::drawPicture))
@@ -1078,6 +1111,13 @@ EMSCRIPTEN_BINDINGS(Skia) {
     class_<SkSurface>("SkSurface")
         .smart_ptr<sk_sp<SkSurface>>("sk_sp<SkSurface>")
         .function("_flush", select_overload<void()>(&SkSurface::flush))
+        .function("_readPixels", optional_override([](SkSurface& self, SimpleImageInfo di,
+                                                      uintptr_t /* uint8_t* */ pPtr,
+                                                      size_t dstRowBytes)->bool {
+            uint8_t* pixels = reinterpret_cast<uint8_t*>(pPtr);
+            SkImageInfo dstInfo = toSkImageInfo(di);
+            return self.readPixels(dstInfo, pixels, dstRowBytes, 0, 0);
+        }), allow_raw_pointers())
         .function("getCanvas", &SkSurface::getCanvas, allow_raw_pointers())
         .function("height", &SkSurface::height)
         .function("makeImageSnapshot", select_overload<sk_sp<SkImage>()>(&SkSurface::makeImageSnapshot))
@@ -1219,6 +1259,11 @@ EMSCRIPTEN_BINDINGS(Skia) {
         .value("XOR",                SkPathOp::kXOR_SkPathOp)
         .value("ReverseDifference",  SkPathOp::kReverseDifference_SkPathOp);
 
+    enum_<SkCanvas::PointMode>("PointMode")
+        .value("Points",   SkCanvas::PointMode::kPoints_PointMode)
+        .value("Lines",    SkCanvas::PointMode::kLines_PointMode)
+        .value("Polygon",  SkCanvas::PointMode::kPolygon_PointMode);
+
     enum_<SkPaint::Cap>("StrokeCap")
         .value("Butt",   SkPaint::Cap::kButt_Cap)
         .value("Round",  SkPaint::Cap::kRound_Cap)
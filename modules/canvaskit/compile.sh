@@ -20,6 +20,17 @@ source $EMSDK/emsdk_env.sh
 EMCC=`which emcc`
 EMCXX=`which em++`
 
+# SIMD and threaded builds are variants of any of the builds below, with their own build
+# directory and output name (e.g. canvaskit_simd_threads.js), so they can sit side by side.
+# loader.js picks the one the browser supports.
+VARIANT=""
+if [[ $@ == *simd* ]]; then
+  VARIANT="${VARIANT}_simd"
+fi
+if [[ $@ == *threads* ]]; then
+  VARIANT="${VARIANT}_threads"
+fi
+
 RELEASE_CONF="-Oz --closure 1 --llvm-lto 3 -DSK_RELEASE --pre-js $BASE_DIR/release.js \
               -DGR_GL_CHECK_ALLOC_WITH_GET_ERROR=0"
 EXTRA_CFLAGS="\"-DSK_RELEASE\", \"-DGR_GL_CHECK_ALLOC_WITH_GET_ERROR=0\","
@@ -28,18 +39,43 @@ if [[ $@ == *debug* ]]; then
   EXTRA_CFLAGS="\"-DSK_DEBUG\""
   RELEASE_CONF="-O0 --js-opts 0 -s DEMANGLE_SUPPORT=1 -s ASSERTIONS=1 -s GL_ASSERTIONS=1 -g4 \
                 --source-map-base /node_modules/canvaskit/bin/ -DSK_DEBUG --pre-js $BASE_DIR/debug.js"
-  BUILD_DIR=${BUILD_DIR:="out/canvaskit_wasm_debug"}
+  BUILD_DIR=${BUILD_DIR:="out/canvaskit_wasm_debug${VARIANT}"}
 elif [[ $@ == *profiling* ]]; then
   echo "Building a build for profiling"
   RELEASE_CONF="-O3 --source-map-base /node_modules/canvaskit/bin/ --profiling -g4 -DSK_RELEASE \
                 --pre-js $BASE_DIR/release.js -DGR_GL_CHECK_ALLOC_WITH_GET_ERROR=0"
-  BUILD_DIR=${BUILD_DIR:="out/canvaskit_wasm_profile"}
+  BUILD_DIR=${BUILD_DIR:="out/canvaskit_wasm_profile${VARIANT}"}
 else
-  BUILD_DIR=${BUILD_DIR:="out/canvaskit_wasm"}
+  BUILD_DIR=${BUILD_DIR:="out/canvaskit_wasm${VARIANT}"}
 fi
 
 mkdir -p $BUILD_DIR
 
+GN_SIMD_FLAGS="\"-DSKNX_NO_SIMD\","
+WASM_SIMD=""
+if [[ $@ == *simd* ]]; then
+  echo "Building with WebAssembly SIMD"
+  # Emscripten's SSE headers implement the SSE2 intrinsics with SIMD128, so SkNx and
+  # SkRasterPipeline use their SSE2 code. SkVx's vector extensions lower to SIMD128 directly.
+  GN_SIMD_FLAGS="\"-msimd128\", \"-msse\", \"-msse2\","
+  WASM_SIMD="-msimd128 -msse -msse2"
+fi
+
+# The main thread can't wait for a worker to start, so the pool that backs SkExecutor is
+# started up front, with SK_CANVASKIT_THREADS workers.
+THREADS=4
+GN_THREADS_FLAGS=""
+WASM_THREADS=""
+WASM_MEMORY="-s ALLOW_MEMORY_GROWTH=1 -s TOTAL_MEMORY=128MB"
+if [[ $@ == *threads* ]]; then
+  echo "Building with threads"
+  GN_THREADS_FLAGS="\"-pthread\", \"-s\", \"USE_PTHREADS=1\","
+  WASM_THREADS="-pthread -s USE_PTHREADS=1 -s PTHREAD_POOL_SIZE=$THREADS \
+                -DSK_CANVASKIT_THREADS=$THREADS"
+  # Growing a shared heap is slow (every view of it has to be recreated), so it's fixed.
+  WASM_MEMORY="-s ALLOW_MEMORY_GROWTH=0 -s TOTAL_MEMORY=512MB"
+fi
+
 GN_GPU="skia_enable_gpu=true skia_gl_standard = \"webgl\""
 GN_GPU_FLAGS="\"-DSK_DISABLE_LEGACY_SHADERCONTEXT\","
 WASM_GPU="-lEGL -lGLESv2 -DSK_SUPPORT_GPU=1 \
@@ -144,8 +180,10 @@ echo "Compiling bitcode"
   cxx=\"${EMCXX}\" \
   extra_cflags_cc=[\"-frtti\"] \
   extra_cflags=[\"-s\",\"USE_FREETYPE=1\",\"-s\",\"USE_LIBPNG=1\", \"-s\", \"WARN_UNALIGNED=1\",
-    \"-DSKNX_NO_SIMD\", \"-DSK_DISABLE_AAA\", \"-DSK_DISABLE_READBUFFER\",
+    \"-DSK_DISABLE_AAA\", \"-DSK_DISABLE_READBUFFER\",
     \"-DSK_DISABLE_EFFECT_DESERIALIZATION\",
+    ${GN_SIMD_FLAGS}
+    ${GN_THREADS_FLAGS}
     ${GN_GPU_FLAGS}
     ${EXTRA_CFLAGS}
   ] \
@@ -202,6 +240,8 @@ ${EMCXX} \
     -DSK_DISABLE_READBUFFER \
     -DSK_DISABLE_AAA \
     $WASM_GPU \
+    $WASM_SIMD \
+    $WASM_THREADS \
     -std=c++14 \
     --bind \
     --pre-js $BASE_DIR/preamble.js \
@@ -221,16 +261,15 @@ ${EMCXX} \
     $BUILD_DIR/libskshaper.a \
     $SHAPER_LIB \
     $BUILD_DIR/libskia.a \
-    -s ALLOW_MEMORY_GROWTH=1 \
+    $WASM_MEMORY \
     -s EXPORT_NAME="CanvasKitInit" \
     -s FORCE_FILESYSTEM=0 \
     -s MODULARIZE=1 \
     -s NO_EXIT_RUNTIME=1 \
     -s STRICT=1 \
-    -s TOTAL_MEMORY=128MB \
     -s USE_FREETYPE=1 \
     -s USE_LIBPNG=1 \
     -s WARN_UNALIGNED=1 \
     -s USE_WEBGL2=0 \
     -s WASM=1 \
-    -o $BUILD_DIR/canvaskit.js
+    -o $BUILD_DIR/canvaskit${VARIANT}.js
@@ -40,9 +40,14 @@
       // Allocate the buffer of pixels to be drawn into.
       var pixelPtr = CanvasKit._malloc(pixelLen);
 
-      var surface = this._getRasterDirectSurface(imageInfo, pixelPtr, width*4);
+      // Threaded builds draw in tiles on worker threads, into pixels the surface owns.
+      // flush() reads them back into pixelPtr.
+      var surface = CanvasKit.threads ?
+          this._getRasterThreadedSurface(imageInfo) :
+          this._getRasterDirectSurface(imageInfo, pixelPtr, width*4);
       if (surface) {
         surface._canvas = null;
+        surface._imageInfo = imageInfo;
         surface._width = width;
         surface._height = height;
         surface._pixelLen = pixelLen;
@@ -57,6 +62,9 @@
 
     CanvasKit.SkSurface.prototype.flush = function() {
       this._flush();
+      if (CanvasKit.threads && this._pixelPtr) {
+        this._readPixels(this._imageInfo, this._pixelPtr, this._width*4);
+      }
       // Do we have an HTML canvas to write the pixels to?
       // We will not if this a GPU build or a raster surface, for example.
       if (this._canvas) {
@@ -32,6 +32,7 @@ var CanvasKit = {
 	/** @return {ImageData} */
 	ImageData: function() {},
 
+	Free: function() {},
 	GetWebGLContext: function() {},
 	MakeBlurMaskFilter: function() {},
 	MakeCanvas: function() {},
@@ -55,6 +56,7 @@ var CanvasKit = {
 	/** @return {RadialCanvasGradient} */
 	MakeTwoPointConicalGradientShader: function() {},
 	MakeWebGLCanvasSurface: function() {},
+	Malloc: function() {},
 	currentContext: function() {},
 	getColorComponents: function() {},
 	getSkDataBytes: function() {},
@@ -75,6 +77,7 @@ var CanvasKit = {
 	_drawShapedText: function() {},
 	_getRasterDirectSurface: function() {},
 	_getRasterN32PremulSurface: function() {},
+	_getRasterThreadedSurface: function() {},
 
 	// The testing object is meant to expose internal functions
 	// for more fine-grained testing, e.g. parseColor
@@ -132,6 +135,7 @@ var CanvasKit = {
 
 		// private API
 		_drawAtlas: function() {},
+		_drawPoints: function() {},
 		_drawSimpleText: function() {},
 		_readPixels: function() {},
 		_writePixels: function() {},
@@ -290,6 +294,7 @@ var CanvasKit = {
 		// private API
 		_flush: function() {},
 		_getRasterN32PremulSurface: function() {},
+		_readPixels: function() {},
 		delete: function() {},
 	},
 
@@ -318,6 +323,7 @@ var CanvasKit = {
 	// Constants and Enums
 	gpu: {},
 	skottie: {},
+	threads: {},
 
 	TRANSPARENT: {},
 	RED: {},
@@ -423,6 +429,12 @@ var CanvasKit = {
 		StrokeAndFill: {},
 	},
 
+	PointMode: {
+		Points: {},
+		Lines: {},
+		Polygon: {},
+	},
+
 	PathOp: {
 		Difference: {},
 		Intersect: {},
@@ -531,6 +543,7 @@ CanvasKit.SkImage.prototype.encodeToData = function() {};
 CanvasKit.SkImage.prototype.makeShader = function() {};
 
 CanvasKit.SkCanvas.prototype.drawAtlas = function() {};
+CanvasKit.SkCanvas.prototype.drawPoints = function() {};
 CanvasKit.SkCanvas.prototype.drawText = function() {};
 /** @return {Uint8Array} */
 CanvasKit.SkCanvas.prototype.readPixels = function() {};
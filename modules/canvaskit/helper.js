@@ -63,12 +63,67 @@ function almostEqual(floata, floatb) {
 
 var nullptr = 0; // emscripten doesn't like to take null as uintptr_t
 
-// arr can be a normal JS array or a TypedArray
+/**
+ * Allocates len elements of the given TypedArray type (e.g. Float32Array) in
+ * the WASM heap. Data that is drawn over and over (e.g. the points of a chart)
+ * can be written into toTypedArray() and the returned object (or the typed
+ * array itself) passed to MakePathFromCmds, drawPoints, MakeSkVertices, etc.
+ * They will read it where it is, instead of copying it into the heap on every
+ * call. CanvasKit.Free must be called when it is no longer needed.
+ */
+CanvasKit.Malloc = function(typedArray, len) {
+  var byteLen = len * typedArray.BYTES_PER_ELEMENT;
+  var ptr = CanvasKit._malloc(byteLen);
+  var ta = null;
+  return {
+    '_ck': true,
+    'length': len,
+    'byteOffset': ptr,
+    'toTypedArray': function() {
+      // Growing the heap detaches the old views of it, so this makes a new one
+      // if that happened.
+      if (!ta || !ta.length) {
+        ta = new typedArray(CanvasKit.HEAPU8.buffer, ptr, len);
+      }
+      return ta;
+    },
+  };
+}
+
+/**
+ * Frees the memory allocated with CanvasKit.Malloc.
+ */
+CanvasKit.Free = function(mObj) {
+  CanvasKit._free(mObj['byteOffset']);
+  mObj['byteOffset'] = nullptr;
+  mObj['toTypedArray'] = null;
+}
+
+// Returns true if arr is an object from CanvasKit.Malloc or a TypedArray that
+// views the WASM heap, and thus can be read by the C++ code where it is.
+function isInWasmHeap(arr) {
+  return !!arr && (arr['_ck'] || arr.buffer === CanvasKit.HEAPU8.buffer);
+}
+
+// Frees ptr, as returned by copy1dArray(arr, ...), unless it points at the
+// caller's memory.
+function freeIfCopied(ptr, arr) {
+  if (ptr && !isInWasmHeap(arr)) {
+    CanvasKit._free(ptr);
+  }
+}
+
+// arr can be a normal JS array or a TypedArray, or an object from
+// CanvasKit.Malloc. If it is already in the WASM heap, it is not copied.
+// Either way, the result must be released with freeIfCopied(ptr, arr).
 // dest is something like CanvasKit.HEAPF32
 function copy1dArray(arr, dest) {
   if (!arr || !arr.length) {
     return nullptr;
   }
+  if (isInWasmHeap(arr)) {
+    return arr.byteOffset;
+  }
   var ptr = CanvasKit._malloc(arr.length * dest.BYTES_PER_ELEMENT);
   // In c++ terms, the WASM heap is a uint8_t*, a long buffer/array of single
   // byte elements. When we run _malloc, we always get an offset/pointer into
@@ -139,7 +194,13 @@ var Float32ArrayCache = {};
 //   [CanvasKit.LINE_VERB, 30, 40],
 //   [CanvasKit.QUAD_VERB, 20, 50, 45, 60],
 // ];
+// The commands can also be given already flattened, as a Float32Array or an
+// object from CanvasKit.Malloc. The pointer must be freed with freeIfCopied.
 function loadCmdsTypedArray(arr) {
+  // Already flat, so it can be used (or copied) as is.
+  if (isInWasmHeap(arr) || arr instanceof Float32Array) {
+    return [copy1dArray(arr, CanvasKit.HEAPF32), arr.length];
+  }
   var len = 0;
   for (var r = 0; r < arr.length; r++) {
     len += arr[r].length;
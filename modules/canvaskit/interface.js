@@ -476,18 +476,26 @@ CanvasKit.onRuntimeInitialized = function() {
     this._drawAtlas(atlas, dstXformPtr, srcRectPtr, colorPtr, dstXforms.length,
                     blendMode, paint);
 
-    if (srcRectPtr && !srcRects.build) {
-      CanvasKit._free(srcRectPtr);
+    if (!srcRects.build) {
+      freeIfCopied(srcRectPtr, srcRects);
     }
-    if (dstXformPtr && !dstXforms.build) {
-      CanvasKit._free(dstXformPtr);
+    if (!dstXforms.build) {
+      freeIfCopied(dstXformPtr, dstXforms);
     }
-    if (colorPtr && !colors.build) {
-      CanvasKit._free(colorPtr);
+    if (colors && !colors.build) {
+      freeIfCopied(colorPtr, colors);
     }
 
   }
 
+  // points is a flat array of x, y pairs: a JS array, a Float32Array, or an
+  // object from CanvasKit.Malloc (which is drawn from without being copied).
+  CanvasKit.SkCanvas.prototype.drawPoints = function(mode, points, paint) {
+    var ptr = copy1dArray(points, CanvasKit.HEAPF32);
+    this._drawPoints(mode, ptr, points.length / 2, paint);
+    freeIfCopied(ptr, points);
+  }
+
   // str can be either a text string or a ShapedText object
   CanvasKit.SkCanvas.prototype.drawText = function(str, x, y, paint, font) {
     if (typeof str === 'string') {
@@ -782,7 +790,7 @@ CanvasKit.XYWHRect = function(x, y, w, h) {
 CanvasKit.MakePathFromCmds = function(cmds) {
   var ptrLen = loadCmdsTypedArray(cmds);
   var path = CanvasKit._MakePathFromCmds(ptrLen[0], ptrLen[1]);
-  CanvasKit._free(ptrLen[0]);
+  freeIfCopied(ptrLen[0], cmds);
   return path;
 }
 
@@ -795,7 +803,7 @@ CanvasKit.MakeSkDashPathEffect = function(intervals, phase) {
   }
   var ptr = copy1dArray(intervals, CanvasKit.HEAPF32);
   var dpe = CanvasKit._MakeSkDashPathEffect(ptr, intervals.length, phase);
-  CanvasKit._free(ptr);
+  freeIfCopied(ptr, intervals);
   return dpe;
 }
 
@@ -846,8 +854,8 @@ CanvasKit.MakeLinearGradientShader = function(start, end, colors, pos, mode, loc
                                                   colors.length, mode, flags);
   }
 
-  CanvasKit._free(colorPtr);
-  CanvasKit._free(posPtr);
+  freeIfCopied(colorPtr, colors);
+  freeIfCopied(posPtr, pos);
   return lgs;
 }
 
@@ -868,8 +876,8 @@ CanvasKit.MakeRadialGradientShader = function(center, radius, colors, pos, mode,
                                                   colors.length, mode, flags);
   }
 
-  CanvasKit._free(colorPtr);
-  CanvasKit._free(posPtr);
+  freeIfCopied(colorPtr, colors);
+  freeIfCopied(posPtr, pos);
   return rgs;
 }
 
@@ -893,15 +901,26 @@ CanvasKit.MakeTwoPointConicalGradientShader = function(start, startRadius, end,
                         colorPtr, posPtr, colors.length, mode, flags);
   }
 
-  CanvasKit._free(colorPtr);
-  CanvasKit._free(posPtr);
+  freeIfCopied(colorPtr, colors);
+  freeIfCopied(posPtr, pos);
   return rgs;
 }
 
+// positions and textureCoordinates are arrays of [x, y] arrays, or flat arrays of
+// x, y pairs (a Float32Array or an object from CanvasKit.Malloc, which isn't copied).
+function copyPointArray(pts) {
+  if (pts && pts.length && (isInWasmHeap(pts) || typeof pts[0] === 'number')) {
+    return copy1dArray(pts, CanvasKit.HEAPF32);
+  }
+  return copy2dArray(pts, CanvasKit.HEAPF32);
+}
+
 CanvasKit.MakeSkVertices = function(mode, positions, textureCoordinates, colors,
                                     boneIndices, boneWeights, indices, isVolatile) {
-  var positionPtr = copy2dArray(positions,          CanvasKit.HEAPF32);
-  var texPtr =      copy2dArray(textureCoordinates, CanvasKit.HEAPF32);
+  var flatPositions = isInWasmHeap(positions) || typeof positions[0] === 'number';
+  var vertexCount = flatPositions ? positions.length / 2 : positions.length;
+  var positionPtr = copyPointArray(positions);
+  var texPtr =      copyPointArray(textureCoordinates);
   var colorPtr =    copy1dArray(colors,             CanvasKit.HEAPU32);
 
   var boneIdxPtr =  copy2dArray(boneIndices,        CanvasKit.HEAP32);
@@ -914,13 +933,13 @@ CanvasKit.MakeSkVertices = function(mode, positions, textureCoordinates, colors,
   var idxCount = (indices && indices.length) || 0;
   // _MakeVertices will copy all the values in, so we are free to release
   // the memory after.
-  var vertices = CanvasKit._MakeSkVertices(mode, positions.length, positionPtr,
+  var vertices = CanvasKit._MakeSkVertices(mode, vertexCount, positionPtr,
                                            texPtr, colorPtr, boneIdxPtr, boneWtPtr,
                                            idxCount, idxPtr, isVolatile);
-  positionPtr && CanvasKit._free(positionPtr);
-  texPtr && CanvasKit._free(texPtr);
-  colorPtr && CanvasKit._free(colorPtr);
-  idxPtr && CanvasKit._free(idxPtr);
+  freeIfCopied(positionPtr, positions);
+  freeIfCopied(texPtr, textureCoordinates);
+  freeIfCopied(colorPtr, colors);
+  freeIfCopied(idxPtr, indices);
   boneIdxPtr && CanvasKit._free(boneIdxPtr);
   boneWtPtr && CanvasKit._free(boneWtPtr);
   return vertices;
@@ -0,0 +1,105 @@
+// Loads the fastest build of CanvasKit this browser can run, and initializes it.
+// compile.sh makes canvaskit.js, and the canvaskit_simd.js, canvaskit_threads.js and
+// canvaskit_simd_threads.js variants; any of them may be missing, in which case the next
+// best one is used.
+//
+//   CanvasKitLoad({locateFile: (file) => '/node_modules/canvaskit/bin/' + file})
+//     .then((CanvasKit) => { ... });
+//
+// The options are passed on to CanvasKitInit, so locateFile also finds the .wasm (and the
+// threaded builds' workers). Threaded builds need SharedArrayBuffer, which browsers only
+// offer to cross-origin isolated pages.
+(function(root) {
+  // A module with one function that returns i8x16.splat(0)
+  var simdModule = new Uint8Array([
+    0, 97, 115, 109, 1, 0, 0, 0,  // magic, version
+    1, 5, 1, 96, 0, 1, 123,       // type section: () -> v128
+    3, 2, 1, 0,                   // function section
+    10, 8, 1, 6, 0, 65, 0, 253, 15, 11,  // code section: i32.const 0, i8x16.splat, end
+  ]);
+
+  function supportsSIMD() {
+    try {
+      return WebAssembly.validate(simdModule);
+    } catch (e) {
+      return false;
+    }
+  }
+
+  function supportsThreads() {
+    if (typeof SharedArrayBuffer === 'undefined' ||
+        (typeof crossOriginIsolated !== 'undefined' && !crossOriginIsolated)) {
+      return false;
+    }
+    try {
+      var mem = new WebAssembly.Memory({'initial': 1, 'maximum': 1, 'shared': true});
+      return mem.buffer instanceof SharedArrayBuffer;
+    } catch (e) {
+      return false;
+    }
+  }
+
+  // The builds to try, best first.
+  function candidates() {
+    var simd = supportsSIMD();
+    var threads = supportsThreads();
+    var names = [];
+    if (simd && threads) {
+      names.push('canvaskit_simd_threads.js');
+    }
+    if (threads) {
+      names.push('canvaskit_threads.js');
+    }
+    if (simd) {
+      names.push('canvaskit_simd.js');
+    }
+    names.push('canvaskit.js');
+    return names;
+  }
+
+  function loadScript(url) {
+    if (typeof document === 'undefined') {
+      // Node: the builds are CommonJS modules.
+      return Promise.resolve(require(url));
+    }
+    return new Promise(function(resolve, reject) {
+      var script = document.createElement('script');
+      script.src = url;
+      script.onload = function() {
+        resolve(root.CanvasKitInit);
+      };
+      script.onerror = function() {
+        script.remove();
+        reject(url);
+      };
+      document.head.appendChild(script);
+    });
+  }
+
+  root.CanvasKitLoad = function(opts) {
+    opts = opts || {};
+    var locate = opts['locateFile'] || function(file) { return file; };
+    var names = candidates();
+    var tryNext = function(i) {
+      return loadScript(locate(names[i])).then(function(init) {
+        init = init || root.CanvasKitInit;
+        var ready = init(opts).ready();
+        // Remember which build was loaded; handy when comparing performance.
+        return ready.then(function(CanvasKit) {
+          CanvasKit.build = names[i];
+          return CanvasKit;
+        });
+      }, function(err) {
+        if (i + 1 < names.length) {
+          return tryNext(i + 1);
+        }
+        throw 'Could not load CanvasKit: ' + err;
+      });
+    };
+    return tryNext(0);
+  };
+
+  if (typeof module !== 'undefined' && module.exports) {
+    module.exports = root.CanvasKitLoad;
+  }
+}(typeof window !== 'undefined' ? window : global));
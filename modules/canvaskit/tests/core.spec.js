@@ -47,4 +47,42 @@ describe('Core canvas behavior', function() {
         }));
     });
 
+    it('can draw points from memory allocated with CanvasKit.Malloc', function(done) {
+        LoadCanvasKit.then(catchException(done, () => {
+            const surface = CanvasKit.MakeCanvasSurface('test');
+            expect(surface).toBeTruthy('Could not make surface')
+            if (!surface) {
+                done();
+                return;
+            }
+            const canvas = surface.getCanvas();
+            const paint = new CanvasKit.SkPaint();
+            paint.setStrokeWidth(10);
+            paint.setColor(CanvasKit.Color(153, 34, 153, 0.8));
+            paint.setStrokeCap(CanvasKit.StrokeCap.Round);
+
+            // The same buffer is rewritten and drawn from several times.
+            const mPoints = CanvasKit.Malloc(Float32Array, 2 * 40);
+            for (let row = 0; row < 3; row++) {
+                const pts = mPoints.toTypedArray();
+                for (let i = 0; i < 40; i++) {
+                    pts[2*i]   = 20 + 14 * i;
+                    pts[2*i+1] = 100 + 150 * row + 40 * Math.sin(i / 4);
+                }
+                const mode = [CanvasKit.PointMode.Points, CanvasKit.PointMode.Lines,
+                              CanvasKit.PointMode.Polygon][row];
+                canvas.drawPoints(mode, mPoints, paint);
+            }
+            // A typed array of the same memory isn't copied either.
+            canvas.drawPoints(CanvasKit.PointMode.Polygon, mPoints.toTypedArray(), paint);
+            CanvasKit.Free(mPoints);
+
+            // Nor are plain JS arrays required to be in the WASM heap.
+            canvas.drawPoints(CanvasKit.PointMode.Points, [30, 550, 60, 560, 90, 570], paint);
+
+            paint.delete();
+            reportSurface(surface, 'drawpoints_malloc', done);
+        }));
+    });
+
 });
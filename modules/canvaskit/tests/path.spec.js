@@ -185,6 +185,31 @@ describe('CanvasKit\'s Path Behavior', function() {
         }));
     });
 
+    it('can create a path from commands in memory allocated with CanvasKit.Malloc',
+       function(done) {
+        LoadCanvasKit.then(catchException(done, () => {
+            let cmds = [CanvasKit.MOVE_VERB, 205, 5,
+                        CanvasKit.LINE_VERB, 795, 5,
+                        CanvasKit.LINE_VERB, 595, 295,
+                        CanvasKit.LINE_VERB, 5, 295,
+                        CanvasKit.LINE_VERB, 205, 5,
+                        CanvasKit.CLOSE_VERB];
+            let mCmds = CanvasKit.Malloc(Float32Array, cmds.length);
+            mCmds.toTypedArray().set(cmds);
+            let path = CanvasKit.MakePathFromCmds(mCmds);
+            expect(path.toSVGString()).toEqual('M205 5L795 5L595 295L5 295L205 5Z');
+            path.delete();
+
+            // The commands are still there to be used again.
+            expect(mCmds.toTypedArray()[4]).toEqual(795);
+            path = CanvasKit.MakePathFromCmds(new Float32Array(cmds));
+            expect(path.toSVGString()).toEqual('M205 5L795 5L595 295L5 295L205 5Z');
+            path.delete();
+            CanvasKit.Free(mCmds);
+            done();
+        }));
+    });
+
      it('can create an SVG string from a path', function(done) {
         LoadCanvasKit.then(catchException(done, () => {
             let cmds = [[CanvasKit.MOVE_VERB, 205, 5],
@@ -141,6 +141,10 @@ void SkParticleEffect::update(double now) {
     for (int i = 0; i < fCount; ++i) {
         fParticles[i].fPose.fPosition += fParticles[i].fVelocity.fLinear * deltaTime;
 
+        // Many effects never spin their particles: skip the sin/cos when they'd be a no-op.
+        if (fParticles[i].fVelocity.fAngular == 0) {
+            continue;
+        }
         SkScalar s = SkScalarSin(fParticles[i].fVelocity.fAngular * deltaTime),
                  c = SkScalarCos(fParticles[i].fVelocity.fAngular * deltaTime);
         SkVector oldHeading = fParticles[i].fPose.fHeading;
@@ -37,6 +37,7 @@ if [[ $@ == *help* ]]; then
   echo "  test = Make a build suitable for running tests or profiling"
   echo "  debug = Make a build suitable for debugging (defines SK_DEBUG)"
   echo "  asm.js = Build for asm.js instead of WASM (very experimental)"
+  echo "  simd = Use WebAssembly SIMD (with Skia's SSE2 code)"
   echo "  serve = starts a webserver allowing a user to navigate to"
   echo "          localhost:8000/pathkit.html to view the demo page."
   exit 0
@@ -68,6 +69,17 @@ if [[ $@ == *asm.js* ]]; then
   WASM_CONF="-s WASM=0 -s ALLOW_MEMORY_GROWTH=1"
 fi
 
+GN_SIMD_FLAGS=""
+WASM_SIMD=""
+if [[ $@ == *simd* ]]; then
+  echo "Building with WebAssembly SIMD"
+  # Emscripten's SSE headers implement the SSE2 intrinsics with SIMD128.
+  GN_SIMD_FLAGS="\"-msimd128\", \"-msse\", \"-msse2\","
+  WASM_SIMD="-msimd128 -msse -msse2"
+  BUILD_DIR=${BUILD_DIR}_simd
+  mkdir -p $BUILD_DIR
+fi
+
 OUTPUT="-o $BUILD_DIR/pathkit.js"
 
 source $EMSDK/emsdk_env.sh
@@ -92,6 +104,7 @@ echo "Compiling bitcode"
   --args="cc=\"${EMCC}\" \
   cxx=\"${EMCXX}\" \
   extra_cflags=[\"-DSK_DISABLE_READBUFFER=1\",\"-s\", \"WARN_UNALIGNED=1\",
+    ${GN_SIMD_FLAGS}
     ${EXTRA_CFLAGS}
   ] \
   is_debug=false \
@@ -115,6 +128,7 @@ ${EMCXX} $RELEASE_CONF -std=c++14 \
 -DSK_DISABLE_READBUFFER=1 \
 -fno-rtti -fno-exceptions -DEMSCRIPTEN_HAS_UNBOUND_TYPE_NAMES=0 \
 $WASM_CONF \
+$WASM_SIMD \
 -s ERROR_ON_MISSING_LIBRARIES=1 \
 -s ERROR_ON_UNDEFINED_SYMBOLS=1 \
 -s EXPORT_NAME="PathKitInit" \
@@ -15,16 +15,23 @@
 #include "include/core/SkTypes.h"
 
 #include <memory>
+#include <vector>
 
 class SkCanvas;
 class SkData;
 class SkImage;
+class SkJSONWriter;
 struct SkRect;
 class SkStream;
 
 namespace skjson { class ObjectValue; }
 
-namespace sksg { class Scene;  }
+namespace sksg {
+
+class InvalidationController;
+class Scene;
+
+} // namespace sksg
 
 namespace skottie {
 
@@ -163,8 +170,29 @@ public:
          */
         Builder& setMarkerObserver(sk_sp<MarkerObserver>);
 
+        /**
+         * Cache the rendering of precomp layers in images while their content doesn't change, with
+         * up to |bytes| of images per animation. Defaults to 0 (no caching).
+         *
+         * Cached precomps are composited as a whole, so layer blend modes inside them only blend
+         * with other layers of the same precomp.
+         */
+        Builder& setPrecompCacheBudget(size_t bytes);
+
+        /**
+         * Collect per-layer timings and draw counts for every frame (see Animation::frameStats()).
+         * Defaults to false.
+         *
+         * This adds some overhead to seeking and rendering, so it should only be enabled for
+         * profiling.
+         */
+        Builder& setFrameStatsEnabled(bool);
+
         /**
          * Animation factories.
+         *
+         * The input is either Lottie JSON, or its binary skjson DOM form (see tools/skottie2bin),
+         * which loads without being parsed.
          */
         sk_sp<Animation> make(SkStream*);
         sk_sp<Animation> make(const char* data, size_t length);
@@ -176,6 +204,8 @@ public:
         sk_sp<PropertyObserver> fPropertyObserver;
         sk_sp<Logger>           fLogger;
         sk_sp<MarkerObserver>   fMarkerObserver;
+        size_t                  fPrecompCacheBudget = 0;
+        bool                    fFrameStatsEnabled  = false;
         Stats                   fStats;
     };
 
@@ -208,13 +238,29 @@ public:
     void render(SkCanvas* canvas, const SkRect* dst = nullptr) const;
     void render(SkCanvas* canvas, const SkRect* dst, RenderFlags) const;
 
+    /**
+     * Redraws only the part of the current frame covered by |damage| (typically the bounds
+     * reported to seek()'s InvalidationController), leaving the rest of the canvas as it was.
+     *
+     * The damaged area is cleared to transparent and then drawn, so this is meant for redrawing a
+     * surface that holds the previous frame of this animation and nothing else.
+     *
+     * @param canvas   destination canvas
+     * @param dst      optional destination rect
+     * @param flags    RenderFlags
+     * @param damage   the area to redraw, in animation coordinates (see size())
+     */
+    void render(SkCanvas* canvas, const SkRect* dst, RenderFlags, const SkRect& damage) const;
+
     /**
      * Updates the animation state for |t|.
      *
      * @param t   normalized [0..1] frame selector (0 -> first frame, 1 -> final frame)
+     * @param ic  optional invalidation controller, which receives the areas (in animation
+     *            coordinates) that changed since the last seek
      *
      */
-    void seek(SkScalar t);
+    void seek(SkScalar t, sksg::InvalidationController* ic = nullptr);
 
     /**
      * Returns the animation duration in seconds.
@@ -224,6 +270,57 @@ public:
     const SkString& version() const { return fVersion;   }
     const SkSize&      size() const { return fSize;      }
 
+    struct SeekStats {
+        size_t fKeyframeEvals   = 0, // Keyframed properties evaluated by the last seek().
+               fKeyframeApplies = 0; // Evaluated properties whose value changed.
+    };
+
+    /**
+     * Returns stats for the last seek() call.
+     *
+     * Properties of layers outside their [in..out] points, and properties whose time didn't
+     * change, are not evaluated.
+     */
+    const SeekStats& seekStats() const { return *fSeekStats; }
+
+    struct LayerFrameStats {
+        SkString fName;                 // Layer name ("nm").
+        int      fParent           = -1; // Index of the enclosing precomp layer, or -1.
+        float    fSeekTimeMS       = 0, // Time spent updating the layer's animated properties.
+                 fRevalidateTimeMS = 0, // Time spent revalidating the layer's scene graph.
+                 fRenderTimeMS     = 0; // Time spent drawing the layer.
+        size_t   fDrawCount        = 0, // Draw calls issued by the layer.
+                 fSaveLayerCount   = 0; // saveLayer() calls issued by the layer.
+    };
+
+    struct SK_API FrameStats {
+        // Totals for the whole animation.
+        float  fSeekTimeMS       = 0,
+               fRevalidateTimeMS = 0,
+               fRenderTimeMS     = 0;
+        size_t fDrawCount        = 0,
+               fSaveLayerCount   = 0;
+
+        // In document order: a precomp layer is followed by its nested layers.
+        std::vector<LayerFrameStats> fLayers;
+
+        /**
+         * Writes the stats as a JSON object.
+         */
+        void writeJSON(SkJSONWriter*) const;
+    };
+
+    /**
+     * Returns the stats for the current frame: the last seek() call, and the render() calls
+     * following it. Only collected when enabled with Builder::setFrameStatsEnabled(), otherwise
+     * returns nullptr.
+     *
+     * Layer stats include those of their nested layers: a precomp layer accounts for its whole
+     * content. Content drawn from a precomp cache image (see Builder::setPrecompCacheBudget())
+     * doesn't issue draw calls.
+     */
+    const FrameStats* frameStats() const { return fFrameStats.get(); }
+
     void setShowInval(bool show);
 
 private:
@@ -231,9 +328,14 @@ private:
         kRequiresTopLevelIsolation = 1 << 0, // Needs to draw into a layer due to layer blending.
     };
 
-    Animation(std::unique_ptr<sksg::Scene>, SkString ver, const SkSize& size,
-              SkScalar inPoint, SkScalar outPoint, SkScalar duration, uint32_t flags = 0);
+    Animation(std::unique_ptr<sksg::Scene>, std::unique_ptr<SeekStats>,
+              std::unique_ptr<FrameStats>, SkString ver, const SkSize& size, SkScalar inPoint,
+              SkScalar outPoint, SkScalar duration, uint32_t flags = 0);
 
+    // The scene's animators and nodes update fSeekStats and fFrameStats, so they must outlive
+    // them.
+    const std::unique_ptr<SeekStats>  fSeekStats;
+    const std::unique_ptr<FrameStats> fFrameStats;
     std::unique_ptr<sksg::Scene> fScene;
     const SkString               fVersion;
     const SkSize                 fSize;
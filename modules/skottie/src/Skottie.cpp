@@ -16,6 +16,7 @@
 #include "include/core/SkStream.h"
 #include "include/private/SkTArray.h"
 #include "include/private/SkTo.h"
+#include "include/utils/SkPaintFilterCanvas.h"
 #include "modules/skottie/include/SkottieProperty.h"
 #include "modules/skottie/src/SkottieAdapter.h"
 #include "modules/skottie/src/SkottieJson.h"
@@ -29,7 +30,9 @@
 #include "modules/sksg/include/SkSGScene.h"
 #include "modules/sksg/include/SkSGTransform.h"
 #include "src/core/SkMakeUnique.h"
+#include "src/core/SkTLazy.h"
 #include "src/core/SkTraceEvent.h"
+#include "src/utils/SkJSONWriter.h"
 
 #include <chrono>
 #include <cmath>
@@ -274,14 +277,20 @@ sk_sp<sksg::Color> AnimationBuilder::attachColor(const skjson::ObjectValue& jcol
 AnimationBuilder::AnimationBuilder(sk_sp<ResourceProvider> rp, sk_sp<SkFontMgr> fontmgr,
                                    sk_sp<PropertyObserver> pobserver, sk_sp<Logger> logger,
                                    sk_sp<MarkerObserver> mobserver,
+                                   sk_sp<sksg::CacheEffect::Budget> precomp_cache_budget,
                                    Animation::Builder::Stats* stats,
+                                   Animation::SeekStats* seek_stats,
+                                   Animation::FrameStats* frame_stats,
                                    const SkSize& size, float duration, float framerate)
     : fResourceProvider(std::move(rp))
     , fLazyFontMgr(std::move(fontmgr))
     , fPropertyObserver(std::move(pobserver))
     , fLogger(std::move(logger))
     , fMarkerObserver(std::move(mobserver))
+    , fPrecompCacheBudget(std::move(precomp_cache_budget))
     , fStats(stats)
+    , fSeekStats(seek_stats)
+    , fFrameStats(frame_stats)
     , fSize(size)
     , fDuration(duration)
     , fFrameRate(framerate)
@@ -436,6 +445,16 @@ Animation::Builder& Animation::Builder::setMarkerObserver(sk_sp<MarkerObserver>
     return *this;
 }
 
+Animation::Builder& Animation::Builder::setPrecompCacheBudget(size_t bytes) {
+    fPrecompCacheBudget = bytes;
+    return *this;
+}
+
+Animation::Builder& Animation::Builder::setFrameStatsEnabled(bool enabled) {
+    fFrameStatsEnabled = enabled;
+    return *this;
+}
+
 sk_sp<Animation> Animation::Builder::make(SkStream* stream) {
     if (!stream->hasLength()) {
         // TODO: handle explicit buffering?
@@ -505,11 +524,17 @@ sk_sp<Animation> Animation::Builder::make(const char* data, size_t data_len) {
     }
 
     SkASSERT(resolvedProvider);
+    auto seek_stats  = skstd::make_unique<Animation::SeekStats>();
+    auto frame_stats = fFrameStatsEnabled ? skstd::make_unique<Animation::FrameStats>() : nullptr;
     internal::AnimationBuilder builder(std::move(resolvedProvider), fFontMgr,
                                        std::move(fPropertyObserver),
                                        std::move(fLogger),
                                        std::move(fMarkerObserver),
-                                       &fStats, size, duration, fps);
+                                       fPrecompCacheBudget
+                                           ? sksg::CacheEffect::Budget::Make(fPrecompCacheBudget)
+                                           : nullptr,
+                                       &fStats, seek_stats.get(), frame_stats.get(),
+                                       size, duration, fps);
     auto scene = builder.parse(json);
 
     const auto t2 = std::chrono::steady_clock::now();
@@ -526,6 +551,8 @@ sk_sp<Animation> Animation::Builder::make(const char* data, size_t data_len) {
     }
 
     return sk_sp<Animation>(new Animation(std::move(scene),
+                                          std::move(seek_stats),
+                                          std::move(frame_stats),
                                           std::move(version),
                                           size,
                                           inPoint,
@@ -541,9 +568,13 @@ sk_sp<Animation> Animation::Builder::makeFromFile(const char path[]) {
                 : nullptr;
 }
 
-Animation::Animation(std::unique_ptr<sksg::Scene> scene, SkString version, const SkSize& size,
-                     SkScalar inPoint, SkScalar outPoint, SkScalar duration, uint32_t flags)
-    : fScene(std::move(scene))
+Animation::Animation(std::unique_ptr<sksg::Scene> scene, std::unique_ptr<SeekStats> seek_stats,
+                     std::unique_ptr<FrameStats> frame_stats, SkString version,
+                     const SkSize& size, SkScalar inPoint, SkScalar outPoint,
+                     SkScalar duration, uint32_t flags)
+    : fSeekStats(std::move(seek_stats))
+    , fFrameStats(std::move(frame_stats))
+    , fScene(std::move(scene))
     , fVersion(std::move(version))
     , fSize(size)
     , fInPoint(inPoint)
@@ -567,12 +598,81 @@ void Animation::render(SkCanvas* canvas, const SkRect* dstR) const {
     this->render(canvas, dstR, 0);
 }
 
+namespace {
+
+// Forwards to the destination canvas, counting the draws in the frame stats, for the layers to
+// sample as they render.
+class StatsCanvas final : public SkPaintFilterCanvas {
+public:
+    StatsCanvas(SkCanvas* canvas, Animation::FrameStats* stats)
+        : INHERITED(canvas)
+        , fStats(stats) {}
+
+protected:
+    bool onFilter(SkPaint&) const override {
+        fStats->fDrawCount++;
+        return true;
+    }
+
+    SaveLayerStrategy getSaveLayerStrategy(const SaveLayerRec& rec) override {
+        fStats->fSaveLayerCount++;
+        return this->INHERITED::getSaveLayerStrategy(rec);
+    }
+
+private:
+    Animation::FrameStats* fStats;
+
+    using INHERITED = SkPaintFilterCanvas;
+};
+
+} // namespace
+
+void Animation::FrameStats::writeJSON(SkJSONWriter* writer) const {
+    writer->beginObject();
+    writer->appendFloat("seek_ms"      , fSeekTimeMS);
+    writer->appendFloat("revalidate_ms", fRevalidateTimeMS);
+    writer->appendFloat("render_ms"    , fRenderTimeMS);
+    writer->appendU64  ("draws"        , fDrawCount);
+    writer->appendU64  ("save_layers"  , fSaveLayerCount);
+
+    writer->beginArray("layers");
+    for (const auto& layer : fLayers) {
+        writer->beginObject(nullptr, false);
+        writer->appendString("name"         , layer.fName.c_str());
+        writer->appendS32   ("parent"       , layer.fParent);
+        writer->appendFloat ("seek_ms"      , layer.fSeekTimeMS);
+        writer->appendFloat ("revalidate_ms", layer.fRevalidateTimeMS);
+        writer->appendFloat ("render_ms"    , layer.fRenderTimeMS);
+        writer->appendU64   ("draws"        , layer.fDrawCount);
+        writer->appendU64   ("save_layers"  , layer.fSaveLayerCount);
+        writer->endObject();
+    }
+    writer->endArray();
+
+    writer->endObject();
+}
+
 void Animation::render(SkCanvas* canvas, const SkRect* dstR, RenderFlags renderFlags) const {
     TRACE_EVENT0("skottie", TRACE_FUNC);
 
     if (!fScene)
         return;
 
+    SkTLazy<StatsCanvas> stats_canvas;
+    std::chrono::steady_clock::time_point t0;
+    if (fFrameStats) {
+        // Revalidate upfront, to time it separately. (Showing the inval needs the scene to
+        // revalidate as it renders.)
+        if (!fScene->showInval()) {
+            t0 = std::chrono::steady_clock::now();
+            fScene->revalidate();
+            fFrameStats->fRevalidateTimeMS += internal::ElapsedMS(t0);
+        }
+
+        canvas = stats_canvas.init(canvas, fFrameStats.get());
+        t0 = std::chrono::steady_clock::now();
+    }
+
     SkAutoCanvasRestore restore(canvas, true);
 
     const SkRect srcR = SkRect::MakeSize(this->size());
@@ -590,9 +690,37 @@ void Animation::render(SkCanvas* canvas, const SkRect* dstR, RenderFlags renderF
     canvas->clipRect(srcR);
 
     fScene->render(canvas);
+
+    if (fFrameStats) {
+        fFrameStats->fRenderTimeMS += internal::ElapsedMS(t0);
+    }
+}
+
+void Animation::render(SkCanvas* canvas, const SkRect* dstR, RenderFlags renderFlags,
+                       const SkRect& damage) const {
+    if (!fScene || damage.isEmpty())
+        return;
+
+    SkAutoCanvasRestore restore(canvas, true);
+
+    // Snap the damage out to whole device pixels, so partially covered pixels at its edges are
+    // redrawn too.
+    const SkMatrix ctm = canvas->getTotalMatrix();
+    SkMatrix animationToDevice = ctm;
+    if (dstR) {
+        animationToDevice.preConcat(SkMatrix::MakeRectToRect(SkRect::MakeSize(this->size()),
+                                                             *dstR,
+                                                             SkMatrix::kCenter_ScaleToFit));
+    }
+    canvas->resetMatrix();
+    canvas->clipRect(SkRect::Make(animationToDevice.mapRect(damage).roundOut()));
+    canvas->setMatrix(ctm);
+
+    canvas->clear(SK_ColorTRANSPARENT);
+    this->render(canvas, dstR, renderFlags);
 }
 
-void Animation::seek(SkScalar t) {
+void Animation::seek(SkScalar t, sksg::InvalidationController* ic) {
     TRACE_EVENT0("skottie", TRACE_FUNC);
 
     if (!fScene)
@@ -601,7 +729,39 @@ void Animation::seek(SkScalar t) {
     // Per AE/Lottie semantics out_point is exclusive.
     const auto kLastValidFrame = std::nextafter(fOutPoint, fInPoint);
 
+    // A seek starts a new frame.
+    std::chrono::steady_clock::time_point t0;
+    if (fFrameStats) {
+        auto layers = std::move(fFrameStats->fLayers);
+        *fFrameStats = FrameStats();
+        for (auto& layer : layers) {
+            layer.fSeekTimeMS = layer.fRevalidateTimeMS = layer.fRenderTimeMS = 0;
+            layer.fDrawCount = layer.fSaveLayerCount = 0;
+        }
+        fFrameStats->fLayers = std::move(layers);
+        t0 = std::chrono::steady_clock::now();
+    }
+
+    *fSeekStats = SeekStats();
     fScene->animate(SkTPin(fInPoint + t * (fOutPoint - fInPoint), fInPoint, kLastValidFrame));
+    TRACE_COUNTER2("skottie", "seek keyframes",
+                   "evaluated", fSeekStats->fKeyframeEvals,
+                   "applied"  , fSeekStats->fKeyframeApplies);
+
+    if (fFrameStats) {
+        fFrameStats->fSeekTimeMS = internal::ElapsedMS(t0);
+    }
+
+    if (ic) {
+        // Revalidating here (rather than lazily, in render) is what gathers the damage.
+        if (fFrameStats) {
+            t0 = std::chrono::steady_clock::now();
+        }
+        fScene->revalidate(ic);
+        if (fFrameStats) {
+            fFrameStats->fRevalidateTimeMS = internal::ElapsedMS(t0);
+        }
+    }
 }
 
 sk_sp<Animation> Animation::Make(const char* data, size_t length) {
@@ -13,6 +13,8 @@
 #include "modules/skottie/src/text/TextValue.h"
 #include "modules/sksg/include/SkSGScene.h"
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <vector>
 
@@ -21,6 +23,57 @@ namespace internal {
 
 namespace {
 
+// A cubic map which switches to interpolating in a table of its values once it has been evaluated
+// often enough, if the table reproduces it closely enough.
+class CubicMapCache {
+public:
+    CubicMapCache(SkPoint p1, SkPoint p2) : fMap(p1, p2) {}
+
+    float computeYFromX(float x) const {
+        if (!fTable) {
+            if (fEvalCount < 0 || ++fEvalCount <= kTableThreshold || !this->buildTable()) {
+                return fMap.computeYFromX(x);
+            }
+        }
+
+        const auto fi = SkTPin(x, 0.0f, 1.0f) * kTableIntervals;
+        const auto i  = std::min(static_cast<int>(fi), kTableIntervals - 1);
+        return fTable[i] + (fTable[i + 1] - fTable[i]) * (fi - i);
+    }
+
+private:
+    static constexpr int   kTableIntervals = 64,
+                           kTableThreshold = 16;
+    static constexpr float kMaxTableError  = 1.0f / 1024;
+
+    bool buildTable() const {
+        // Solve for the interval ends and midpoints, and check the interpolated midpoints.
+        float vals[2 * kTableIntervals + 1];
+        for (int i = 0; i <= 2 * kTableIntervals; ++i) {
+            vals[i] = static_cast<float>(i) / (2 * kTableIntervals);
+        }
+        fMap.computeYFromX(vals, vals, SK_ARRAY_COUNT(vals));
+
+        for (int i = 1; i < 2 * kTableIntervals; i += 2) {
+            if (std::abs(vals[i] - (vals[i - 1] + vals[i + 1]) * 0.5f) > kMaxTableError) {
+                // Too curvy, keep solving.
+                fEvalCount = -1;
+                return false;
+            }
+        }
+
+        fTable.reset(new float[kTableIntervals + 1]);
+        for (int i = 0; i <= kTableIntervals; ++i) {
+            fTable[i] = vals[2 * i];
+        }
+        return true;
+    }
+
+    SkCubicMap                       fMap;
+    mutable std::unique_ptr<float[]> fTable;
+    mutable int                      fEvalCount = 0;  // -1 after failing to build the table
+};
+
 class KeyframeAnimatorBase : public sksg::Animator {
 public:
     size_t count() const { return fRecs.size(); }
@@ -211,9 +264,9 @@ private:
         return f0;
     }
 
-    std::vector<KeyframeRec> fRecs;
-    std::vector<SkCubicMap>  fCubicMaps;
-    const KeyframeRec*       fCachedRec = nullptr;
+    std::vector<KeyframeRec>   fRecs;
+    std::vector<CubicMapCache> fCubicMaps;
+    const KeyframeRec*         fCachedRec = nullptr;
 
     using INHERITED = sksg::Animator;
 };
@@ -236,14 +289,42 @@ public:
 
 protected:
     void onTick(float t) override {
-        fApplyFunc(*this->eval(this->frame(t), t, &fScratch));
+        // Repeated ticks at the same time would reapply the same value.
+        if (t == fLastT) {
+            return;
+        }
+        fLastT = t;
+
+        auto* stats = fSeekStats;
+        if (stats) {
+            stats->fKeyframeEvals++;
+        }
+
+        const T* value = this->eval(this->frame(t), t, &fScratch);
+
+        // Values held constant (by a hold keyframe, or before/after the first/last keyframe) are
+        // stored, so a repeated pointer means a repeated value.
+        if (value != &fScratch) {
+            if (value == fLastConstValue) {
+                return;
+            }
+            fLastConstValue = value;
+        } else {
+            fLastConstValue = nullptr;
+        }
+
+        if (stats) {
+            stats->fKeyframeApplies++;
+        }
+        fApplyFunc(*value);
     }
 
 private:
     KeyframeAnimator(const skjson::ArrayValue& jframes,
                      const AnimationBuilder* abuilder,
                      std::function<void(const T&)>&& apply)
-        : fApplyFunc(std::move(apply)) {
+        : fApplyFunc(std::move(apply))
+        , fSeekStats(abuilder->seekStats()) {
         // Generally, each keyframe holds two values (start, end) and a cubic mapper. Except
         // the last frame, which only holds a marker timestamp.  Then, the values series is
         // contiguous (keyframe[i].end == keyframe[i + 1].start), and we dedupe them.
@@ -287,8 +368,14 @@ private:
     }
 
     const std::function<void(const T&)> fApplyFunc;
+    Animation::SeekStats*               fSeekStats;
     std::vector<T>                      fVs;
 
+    // The time of the last tick (NaN before the first one), and the value it applied if that
+    // was one of fVs.
+    float                               fLastT = SK_FloatNaN;
+    const T*                            fLastConstValue = nullptr;
+
     // LERP storage: we use this to temporarily store interpolation results.
     // Alternatively, the temp result could live on the stack -- but for vector values that would
     // involve dynamic allocations on each tick.  This a trade-off to avoid allocator pressure
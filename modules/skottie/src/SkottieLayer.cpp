@@ -17,6 +17,7 @@
 #include "modules/skottie/src/SkottieValue.h"
 #include "modules/sksg/include/SkSGClipEffect.h"
 #include "modules/sksg/include/SkSGDraw.h"
+#include "modules/sksg/include/SkSGEffectNode.h"
 #include "modules/sksg/include/SkSGGroup.h"
 #include "modules/sksg/include/SkSGImage.h"
 #include "modules/sksg/include/SkSGMaskEffect.h"
@@ -199,6 +200,44 @@ sk_sp<sksg::RenderNode> AttachMask(const skjson::ArrayValue* jmask,
     return sksg::MaskEffect::Make(std::move(childNode), std::move(maskNode));
 }
 
+// Records the revalidation and render work of a layer in the frame stats.
+class LayerStatsNode final : public sksg::EffectNode {
+public:
+    LayerStatsNode(sk_sp<sksg::RenderNode> layer, Animation::FrameStats* stats, int stats_index)
+        : INHERITED(std::move(layer))
+        , fStats(stats)
+        , fStatsIndex(stats_index) {}
+
+protected:
+    SkRect onRevalidate(sksg::InvalidationController* ic, const SkMatrix& ctm) override {
+        const auto t0 = std::chrono::steady_clock::now();
+        const auto bounds = this->INHERITED::onRevalidate(ic, ctm);
+        fStats->fLayers[fStatsIndex].fRevalidateTimeMS += ElapsedMS(t0);
+
+        return bounds;
+    }
+
+    void onRender(SkCanvas* canvas, const RenderContext* ctx) const override {
+        // The animation's canvas counts the draws in the frame totals.
+        const auto draw_count       = fStats->fDrawCount,
+                   save_layer_count = fStats->fSaveLayerCount;
+        const auto t0 = std::chrono::steady_clock::now();
+
+        this->INHERITED::onRender(canvas, ctx);
+
+        auto& layer_stats = fStats->fLayers[fStatsIndex];
+        layer_stats.fRenderTimeMS   += ElapsedMS(t0);
+        layer_stats.fDrawCount      += fStats->fDrawCount - draw_count;
+        layer_stats.fSaveLayerCount += fStats->fSaveLayerCount - save_layer_count;
+    }
+
+private:
+    Animation::FrameStats* fStats;
+    const int              fStatsIndex;
+
+    using INHERITED = sksg::EffectNode;
+};
+
 static constexpr int kCameraLayerType = 13;
 
 } // namespace
@@ -595,10 +634,22 @@ sk_sp<sksg::RenderNode> AnimationBuilder::attachLayer(const skjson::ObjectValue*
 
     const auto& build_info = gLayerBuildInfo[type];
 
+    // Layer stats are listed in document order, ahead of the nested layers of precomps.
+    const auto stats_index = fFrameStats ? SkToInt(fFrameStats->fLayers.size()) : -1;
+    if (fFrameStats) {
+        Animation::LayerFrameStats layer_stats;
+        layer_stats.fName   = ParseDefault<SkString>((*jlayer)["nm"], SkString());
+        layer_stats.fParent = fFrameStatsLayer;
+        fFrameStats->fLayers.push_back(std::move(layer_stats));
+    }
+
     AnimatorScope layer_animators;
 
     // Build the layer content fragment.
+    const auto parent_stats_index = fFrameStatsLayer;
+    fFrameStatsLayer = stats_index;
     auto layer = (this->*(build_info.fBuilder))(*jlayer, layer_info, &layer_animators);
+    fFrameStatsLayer = parent_stats_index;
 
     // Clip layers with explicit dimensions.
     float w = 0, h = 0;
@@ -646,13 +697,28 @@ sk_sp<sksg::RenderNode> AnimationBuilder::attachLayer(const skjson::ObjectValue*
     public:
         LayerController(sksg::AnimatorList&& layer_animators,
                         sk_sp<sksg::OpacityEffect> controlNode,
-                        float in, float out)
+                        float in, float out,
+                        Animation::FrameStats* stats, int stats_index)
             : INHERITED(std::move(layer_animators))
             , fControlNode(std::move(controlNode))
             , fIn(in)
-            , fOut(out) {}
+            , fOut(out)
+            , fStats(stats)
+            , fStatsIndex(stats_index) {}
 
         void onTick(float t) override {
+            if (!fStats) {
+                this->update(t);
+                return;
+            }
+
+            const auto t0 = std::chrono::steady_clock::now();
+            this->update(t);
+            fStats->fLayers[fStatsIndex].fSeekTimeMS += ElapsedMS(t0);
+        }
+
+    private:
+        void update(float t) {
             const auto active = (t >= fIn && t < fOut);
 
             // Keep the layer fully transparent except for its [in..out] lifespan.
@@ -663,10 +729,11 @@ sk_sp<sksg::RenderNode> AnimationBuilder::attachLayer(const skjson::ObjectValue*
             if (active) this->INHERITED::onTick(t);
         }
 
-    private:
         const sk_sp<sksg::OpacityEffect> fControlNode;
         const float                      fIn,
                                          fOut;
+        Animation::FrameStats*           fStats;
+        const int                        fStatsIndex;
 
         using INHERITED = sksg::GroupAnimator;
     };
@@ -678,11 +745,17 @@ sk_sp<sksg::RenderNode> AnimationBuilder::attachLayer(const skjson::ObjectValue*
 
     layerCtx->fScope->push_back(
         skstd::make_unique<LayerController>(std::move(layer_animators), controller_node,
-                                            layer_info.fInPoint, layer_info.fOutPoint));
+                                            layer_info.fInPoint, layer_info.fOutPoint,
+                                            fFrameStats, stats_index));
+
+    sk_sp<sksg::RenderNode> layer_node = std::move(controller_node);
+    if (fFrameStats) {
+        layer_node = sk_make_sp<LayerStatsNode>(std::move(layer_node), fFrameStats, stats_index);
+    }
 
     if (ParseDefault<bool>((*jlayer)["td"], false)) {
         // This layer is a matte.  We apply it as a mask to the next layer.
-        layerCtx->fCurrentMatte = std::move(controller_node);
+        layerCtx->fCurrentMatte = std::move(layer_node);
         return nullptr;
     }
 
@@ -695,14 +768,14 @@ sk_sp<sksg::RenderNode> AnimationBuilder::attachLayer(const skjson::ObjectValue*
         const auto matteType = ParseDefault<size_t>((*jlayer)["tt"], 1) - 1;
 
         if (matteType < SK_ARRAY_COUNT(gMaskModes)) {
-            return sksg::MaskEffect::Make(std::move(controller_node),
+            return sksg::MaskEffect::Make(std::move(layer_node),
                                           std::move(layerCtx->fCurrentMatte),
                                           gMaskModes[matteType]);
         }
         layerCtx->fCurrentMatte.reset();
     }
 
-    return std::move(controller_node);
+    return layer_node;
 }
 
 sk_sp<sksg::RenderNode> AnimationBuilder::attachComposition(const skjson::ObjectValue& jcomp,
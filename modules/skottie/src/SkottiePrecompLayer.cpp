@@ -83,6 +83,10 @@ sk_sp<sksg::RenderNode> AnimationBuilder::attachPrecompLayer(const skjson::Objec
         ascope->push_back(std::move(time_mapper));
     }
 
+    if (fPrecompCacheBudget && precomp_layer) {
+        precomp_layer = sksg::CacheEffect::Make(std::move(precomp_layer), fPrecompCacheBudget);
+    }
+
     return precomp_layer;
 }
 
@@ -15,9 +15,11 @@
 #include "include/core/SkTypeface.h"
 #include "include/private/SkTHash.h"
 #include "modules/skottie/include/SkottieProperty.h"
+#include "modules/sksg/include/SkSGCacheEffect.h"
 #include "modules/sksg/include/SkSGScene.h"
 #include "src/utils/SkUTF.h"
 
+#include <chrono>
 #include <functional>
 
 class SkFontMgr;
@@ -44,12 +46,18 @@ namespace internal {
 
 using AnimatorScope = sksg::AnimatorList;
 
+// Milliseconds elapsed since |t0|, for the frame stats.
+inline float ElapsedMS(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<float, std::milli>{std::chrono::steady_clock::now() - t0}.count();
+}
+
 class AnimationBuilder final : public SkNoncopyable {
 public:
     AnimationBuilder(sk_sp<ResourceProvider>, sk_sp<SkFontMgr>, sk_sp<PropertyObserver>,
                      sk_sp<Logger>, sk_sp<MarkerObserver>,
-                     Animation::Builder::Stats*, const SkSize& size,
-                     float duration, float framerate);
+                     sk_sp<sksg::CacheEffect::Budget> precompCacheBudget,
+                     Animation::Builder::Stats*, Animation::SeekStats*,
+                     Animation::FrameStats*, const SkSize& size, float duration, float framerate);
 
     std::unique_ptr<sksg::Scene> parse(const skjson::ObjectValue&);
 
@@ -87,6 +95,12 @@ public:
 
     bool hasNontrivialBlending() const { return fHasNontrivialBlending; }
 
+    // Keyframe animators report their per-seek work here.
+    Animation::SeekStats* seekStats() const { return fSeekStats; }
+
+    // Null unless frame stats are enabled.
+    Animation::FrameStats* frameStats() const { return fFrameStats; }
+
 private:
     struct AttachLayerContext;
     struct AttachShapeContext;
@@ -179,11 +193,15 @@ private:
     sk_sp<PropertyObserver>    fPropertyObserver;
     sk_sp<Logger>              fLogger;
     sk_sp<MarkerObserver>      fMarkerObserver;
+    sk_sp<sksg::CacheEffect::Budget> fPrecompCacheBudget;
     Animation::Builder::Stats* fStats;
+    Animation::SeekStats*      fSeekStats;
+    Animation::FrameStats*     fFrameStats;
     const SkSize               fSize;
     const float                fDuration,
                                fFrameRate;
     mutable const char*        fPropertyObserverContext;
+    mutable int                fFrameStatsLayer = -1; // The layer being attached, for fFrameStats.
     mutable bool               fHasNontrivialBlending : 1;
 
 
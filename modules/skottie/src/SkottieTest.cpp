@@ -5,6 +5,8 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkTextBlob.h"
@@ -12,6 +14,9 @@
 #include "modules/skottie/include/Skottie.h"
 #include "modules/skottie/include/SkottieProperty.h"
 #include "modules/skottie/src/text/SkottieShaper.h"
+#include "modules/sksg/include/SkSGInvalidationController.h"
+#include "src/utils/SkJSON.h"
+#include "src/utils/SkJSONWriter.h"
 
 #include "tests/Test.h"
 
@@ -346,3 +351,278 @@ DEF_TEST(Skottie_Shaper_VAlign, reporter) {
         }
     }
 }
+
+DEF_TEST(Skottie_DamageRender, reporter) {
+    // A 20x20 square sliding from (10,10) to (50,10) on a 200x200 canvas.
+    static constexpr char json[] = R"({
+                                     "v": "5.2.1",
+                                     "w": 200,
+                                     "h": 200,
+                                     "fr": 10,
+                                     "ip": 0,
+                                     "op": 10,
+                                     "layers": [
+                                       {
+                                         "ty": 4,
+                                         "ip": 0,
+                                         "op": 10,
+                                         "shapes": [
+                                           {
+                                             "ty": "rc",
+                                             "p": { "a": 1, "k": [
+                                               { "t": 0, "s": [ 20, 20 ], "e": [ 60, 20 ] },
+                                               { "t": 10 }
+                                             ]},
+                                             "s": { "a": 0, "k": [ 20, 20 ] },
+                                             "r": { "a": 0, "k": 0 }
+                                           },
+                                           {
+                                             "ty": "fl",
+                                             "c": { "a": 0, "k": [ 1, 0, 0 ] },
+                                             "o": { "a": 0, "k": 100 }
+                                           }
+                                         ]
+                                       }
+                                     ]
+                                   })";
+
+    SkMemoryStream stream(json, strlen(json));
+    auto animation = Animation::Make(&stream);
+    REPORTER_ASSERT(reporter, animation);
+
+    // The dst rect scales the animation to a fractional size, so the damage doesn't land on pixel
+    // boundaries.
+    const SkRect dst = SkRect::MakeWH(150, 150);
+    SkBitmap partial, full;
+    partial.allocN32Pixels(150, 150);
+    full.allocN32Pixels(150, 150);
+    SkCanvas partialCanvas(partial),
+             fullCanvas(full);
+
+    partial.eraseColor(SK_ColorTRANSPARENT);
+    animation->render(&partialCanvas, &dst);
+
+    for (float t : { 0.25f, 0.5f, 0.55f, 1.0f }) {
+        sksg::InvalidationController ic;
+        animation->seek(t, &ic);
+
+        // Only the area swept by the square is damaged.
+        REPORTER_ASSERT(reporter, !ic.bounds().isEmpty());
+        REPORTER_ASSERT(reporter, SkRect::MakeLTRB(10, 10, 70, 30).contains(ic.bounds()));
+
+        animation->render(&partialCanvas, &dst, 0, ic.bounds());
+
+        full.eraseColor(SK_ColorTRANSPARENT);
+        animation->render(&fullCanvas, &dst);
+
+        bool matches = true;
+        for (int y = 0; y < full.height() && matches; ++y) {
+            matches = !memcmp(partial.getAddr32(0, y), full.getAddr32(0, y),
+                              full.width() * sizeof(uint32_t));
+        }
+        REPORTER_ASSERT(reporter, matches, "t = %g", t);
+    }
+
+    // Seeking to the same frame damages nothing.
+    sksg::InvalidationController ic;
+    animation->seek(1, &ic);
+    REPORTER_ASSERT(reporter, ic.bounds().isEmpty());
+}
+
+DEF_TEST(Skottie_SeekStats, reporter) {
+    // layer_0 is active for the whole animation, and fades in over [0..5].
+    // layer_1 is only active over [5..10], and fades in over it.
+    static constexpr char json[] = R"({
+                                     "v": "5.2.1",
+                                     "w": 100,
+                                     "h": 100,
+                                     "fr": 1,
+                                     "ip": 0,
+                                     "op": 10,
+                                     "layers": [
+                                       {
+                                         "ty": 4,
+                                         "nm": "layer_0",
+                                         "ip": 0,
+                                         "op": 10,
+                                         "ks": {
+                                           "o": { "a": 1, "k": [
+                                             { "t": 0, "s": [ 0 ], "e": [ 100 ] },
+                                             { "t": 5 }
+                                           ]}
+                                         },
+                                         "shapes": [
+                                           {
+                                             "ty": "rc",
+                                             "p": { "a": 0, "k": [ 50, 50 ] },
+                                             "s": { "a": 0, "k": [ 50, 50 ] },
+                                             "r": { "a": 0, "k": 0 }
+                                           },
+                                           {
+                                             "ty": "fl",
+                                             "c": { "a": 0, "k": [ 1, 0, 0 ] },
+                                             "o": { "a": 0, "k": 100 }
+                                           }
+                                         ]
+                                       },
+                                       {
+                                         "ty": 4,
+                                         "nm": "layer_1",
+                                         "ip": 5,
+                                         "op": 10,
+                                         "ks": {
+                                           "o": { "a": 1, "k": [
+                                             { "t": 5, "s": [ 0 ], "e": [ 100 ] },
+                                             { "t": 10 }
+                                           ]}
+                                         },
+                                         "shapes": [
+                                           {
+                                             "ty": "rc",
+                                             "p": { "a": 0, "k": [ 50, 50 ] },
+                                             "s": { "a": 0, "k": [ 20, 20 ] },
+                                             "r": { "a": 0, "k": 0 }
+                                           },
+                                           {
+                                             "ty": "fl",
+                                             "c": { "a": 0, "k": [ 0, 0, 1 ] },
+                                             "o": { "a": 0, "k": 100 }
+                                           }
+                                         ]
+                                       }
+                                     ]
+                                   })";
+
+    SkMemoryStream stream(json, strlen(json));
+    auto animation = Animation::Make(&stream);
+    REPORTER_ASSERT(reporter, animation);
+
+    auto check = [&](float t, size_t expected_evals, size_t expected_applies) {
+        animation->seek(t);
+        const auto& stats = animation->seekStats();
+        REPORTER_ASSERT(reporter, stats.fKeyframeEvals == expected_evals,
+                        "t: %g, evals: %zu", t, stats.fKeyframeEvals);
+        REPORTER_ASSERT(reporter, stats.fKeyframeApplies == expected_applies,
+                        "t: %g, applies: %zu", t, stats.fKeyframeApplies);
+    };
+
+    // Only layer_0 is active, and it is fading in.
+    check(0.2f, 1, 1);
+
+    // Nothing to do at the same time.
+    check(0.2f, 0, 0);
+
+    // Both layers are active. layer_0 is done fading in, and holds its final opacity.
+    check(0.6f, 2, 2);
+    check(0.8f, 2, 1);
+}
+
+DEF_TEST(Skottie_FrameStats, reporter) {
+    // A solid layer, and a precomp layer nesting a shape layer.
+    static constexpr char json[] = R"({
+                                     "v": "5.2.1",
+                                     "w": 100,
+                                     "h": 100,
+                                     "fr": 1,
+                                     "ip": 0,
+                                     "op": 10,
+                                     "assets": [
+                                       {
+                                         "id": "comp",
+                                         "layers": [
+                                           {
+                                             "ty": 4,
+                                             "nm": "shape",
+                                             "ip": 0,
+                                             "op": 10,
+                                             "shapes": [
+                                               {
+                                                 "ty": "rc",
+                                                 "p": { "a": 0, "k": [ 50, 50 ] },
+                                                 "s": { "a": 0, "k": [ 20, 20 ] },
+                                                 "r": { "a": 0, "k": 0 }
+                                               },
+                                               {
+                                                 "ty": "fl",
+                                                 "c": { "a": 0, "k": [ 0, 0, 1 ] },
+                                                 "o": { "a": 0, "k": 100 }
+                                               }
+                                             ]
+                                           }
+                                         ]
+                                       }
+                                     ],
+                                     "layers": [
+                                       {
+                                         "ty": 0,
+                                         "nm": "precomp",
+                                         "refId": "comp",
+                                         "ip": 0,
+                                         "op": 10
+                                       },
+                                       {
+                                         "ty": 1,
+                                         "nm": "solid",
+                                         "sw": 100,
+                                         "sh": 100,
+                                         "sc": "#ff0000",
+                                         "ip": 0,
+                                         "op": 10
+                                       }
+                                     ]
+                                   })";
+
+    REPORTER_ASSERT(reporter, !Animation::Make(json, strlen(json))->frameStats());
+
+    auto animation = Animation::Builder().setFrameStatsEnabled(true).make(json, strlen(json));
+    REPORTER_ASSERT(reporter, animation);
+
+    const auto* stats = animation->frameStats();
+    REPORTER_ASSERT(reporter, stats && stats->fLayers.size() == 3);
+
+    const struct {
+        const char* fName;
+        int         fParent;
+    } expected[] = {
+        { "precomp", -1 },
+        { "shape"  ,  0 },
+        { "solid"  , -1 },
+    };
+    for (size_t i = 0; i < SK_ARRAY_COUNT(expected); ++i) {
+        REPORTER_ASSERT(reporter, stats->fLayers[i].fName.equals(expected[i].fName));
+        REPORTER_ASSERT(reporter, stats->fLayers[i].fParent == expected[i].fParent);
+    }
+
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(100, 100);
+    SkCanvas canvas(bitmap);
+
+    animation->seek(0.5f);
+    animation->render(&canvas);
+    REPORTER_ASSERT(reporter, stats->fDrawCount == 2);
+    REPORTER_ASSERT(reporter, stats->fLayers[0].fDrawCount == 1);
+    REPORTER_ASSERT(reporter, stats->fLayers[1].fDrawCount == 1);
+    REPORTER_ASSERT(reporter, stats->fLayers[2].fDrawCount == 1);
+
+    // Rendering accumulates over the frame, seeking starts a new one.
+    animation->render(&canvas);
+    REPORTER_ASSERT(reporter, stats->fDrawCount == 4);
+    animation->seek(0.6f);
+    REPORTER_ASSERT(reporter, stats->fDrawCount == 0);
+    REPORTER_ASSERT(reporter, stats->fLayers.size() == 3);
+    REPORTER_ASSERT(reporter, stats->fLayers[2].fDrawCount == 0);
+
+    SkDynamicMemoryWStream stream;
+    {
+        SkJSONWriter writer(&stream);
+        stats->writeJSON(&writer);
+    }
+    const auto data = stream.detachAsData();
+    const skjson::DOM dom(static_cast<const char*>(data->data()), data->size());
+    const skjson::ObjectValue* jstats = dom.root();
+    REPORTER_ASSERT(reporter, jstats);
+    const skjson::ArrayValue* jlayers = (*jstats)["layers"];
+    REPORTER_ASSERT(reporter, jlayers && jlayers->size() == 3);
+    const skjson::StringValue* jname = (*jlayers)[1].as<skjson::ObjectValue>()["name"];
+    REPORTER_ASSERT(reporter, jname && !strcmp(jname->begin(), "shape"));
+}
@@ -11,6 +11,7 @@
 #include "include/core/SkPoint.h"
 #include "include/core/SkSize.h"
 #include "include/private/SkNx.h"
+#include "include/private/SkTArray.h"
 #include "modules/skottie/src/SkottieJson.h"
 #include "modules/skottie/src/SkottiePriv.h"
 
@@ -203,14 +204,19 @@ void ValueTraits<ShapeValue>::Lerp(const ShapeValue& v0, const ShapeValue& v1, f
 template <>
 template <>
 SkPath ValueTraits<ShapeValue>::As<SkPath>(const ShapeValue& shape) {
-    SkPath path;
+    if (shape.fVertices.empty()) {
+        SkPath path;
+        path.setIsVolatile(shape.fVolatile);
+        return path;
+    }
 
-    if (!shape.fVertices.empty()) {
-        // conservatively assume all cubics
-        path.incReserve(1 + SkToU32(shape.fVertices.size() * 3));
+    // Shapes are rebuilt on every frame they animate, so gather the path on the stack and make it
+    // in one exactly-sized allocation, instead of growing (and then shrinking) its storage.
+    SkSTArray<96, SkPoint, true> pts;
+    SkSTArray<32, uint8_t, true> verbs;
 
-        path.moveTo(shape.fVertices.front().fVertex);
-    }
+    pts.push_back(shape.fVertices.front().fVertex);
+    verbs.push_back(SkPath::kMove_Verb);
 
     const auto& addCubic = [&](size_t from, size_t to) {
         const auto c0 = shape.fVertices[from].fVertex + shape.fVertices[from].fOutPoint,
@@ -221,25 +227,26 @@ SkPath ValueTraits<ShapeValue>::As<SkPath>(const ShapeValue& shape) {
             // If the control points are coincident, we can power-reduce to a straight line.
             // TODO: we could also do that when the controls are on the same line as the
             //       vertices, but it's unclear how common that case is.
-            path.lineTo(shape.fVertices[to].fVertex);
+            verbs.push_back(SkPath::kLine_Verb);
         } else {
-            path.cubicTo(c0, c1, shape.fVertices[to].fVertex);
+            pts.push_back(c0);
+            pts.push_back(c1);
+            verbs.push_back(SkPath::kCubic_Verb);
         }
+        pts.push_back(shape.fVertices[to].fVertex);
     };
 
     for (size_t i = 1; i < shape.fVertices.size(); ++i) {
         addCubic(i - 1, i);
     }
 
-    if (!shape.fVertices.empty() && shape.fClosed) {
+    if (shape.fClosed) {
         addCubic(shape.fVertices.size() - 1, 0);
-        path.close();
+        verbs.push_back(SkPath::kClose_Verb);
     }
 
-    path.setIsVolatile(shape.fVolatile);
-    path.shrinkToFit();
-
-    return path;
+    return SkPath::Make(pts.begin(), pts.count(), verbs.begin(), verbs.count(), nullptr, 0,
+                        SkPath::kWinding_FillType, shape.fVolatile);
 }
 
 } // namespace skottie
@@ -97,6 +97,78 @@ sk_sp<skottie::ImageAsset> FileResourceProvider::loadImageAsset(const char resou
     return MultiFrameImageAsset::Make(this->load(resource_path, resource_name));
 }
 
+namespace {
+
+class StaticImageAsset final : public skottie::ImageAsset {
+public:
+    explicit StaticImageAsset(sk_sp<SkImage> image) : fImage(std::move(image)) {}
+
+    bool isMultiFrame() override { return false; }
+
+    sk_sp<SkImage> getFrame(float) override { return fImage; }
+
+private:
+    const sk_sp<SkImage> fImage;
+};
+
+std::string resource_key(const char a[], const char b[]) {
+    std::string key(a ? a : "");
+    key.push_back('\0');
+    key.append(b ? b : "");
+    return key;
+}
+
+} // namespace
+
+sk_sp<SharedResourceProvider> SharedResourceProvider::Make(sk_sp<ResourceProvider> proxy) {
+    return proxy ? sk_sp<SharedResourceProvider>(new SharedResourceProvider(std::move(proxy)))
+                 : nullptr;
+}
+
+SharedResourceProvider::SharedResourceProvider(sk_sp<ResourceProvider> proxy)
+    : fProxy(std::move(proxy)) {}
+
+sk_sp<SkData> SharedResourceProvider::load(const char resource_path[],
+                                           const char resource_name[]) const {
+    SkAutoMutexExclusive lock(fMutex);
+    auto& data = fData[resource_key(resource_path, resource_name)];
+    if (!data) {
+        data = fProxy->load(resource_path, resource_name);
+    }
+    return data;
+}
+
+sk_sp<SkData> SharedResourceProvider::loadFont(const char name[], const char url[]) const {
+    SkAutoMutexExclusive lock(fMutex);
+    auto& data = fFonts[resource_key(name, url)];
+    if (!data) {
+        data = fProxy->loadFont(name, url);
+    }
+    return data;
+}
+
+sk_sp<skottie::ImageAsset> SharedResourceProvider::loadImageAsset(
+        const char resource_path[], const char resource_name[]) const {
+    SkAutoMutexExclusive lock(fMutex);
+    const auto key = resource_key(resource_path, resource_name);
+    const auto it = fImages.find(key);
+    if (it != fImages.end() && !it->second.fMultiFrame) {
+        return it->second.fImage ? sk_make_sp<StaticImageAsset>(it->second.fImage) : nullptr;
+    }
+
+    auto asset = fProxy->loadImageAsset(resource_path, resource_name);
+    if (it == fImages.end()) {
+        // Skottie only calls getFrame() once for static assets, so this is the only decode.
+        const auto multi_frame = asset && asset->isMultiFrame();
+        fImages[key] = { multi_frame || !asset ? nullptr : asset->getFrame(0), multi_frame };
+        if (!multi_frame && asset) {
+            return sk_make_sp<StaticImageAsset>(fImages[key].fImage);
+        }
+    }
+
+    return asset;
+}
+
 class CustomPropertyManager::PropertyInterceptor final : public skottie::PropertyObserver {
 public:
     explicit PropertyInterceptor(CustomPropertyManager* mgr) : fMgr(mgr) {}
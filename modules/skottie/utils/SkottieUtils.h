@@ -10,6 +10,7 @@
 
 #include "include/core/SkColor.h"
 #include "include/core/SkString.h"
+#include "include/private/SkMutex.h"
 #include "include/private/SkTHash.h"
 #include "modules/skottie/include/Skottie.h"
 #include "modules/skottie/include/SkottieProperty.h"
@@ -65,6 +66,43 @@ private:
     using INHERITED = skottie::ResourceProvider;
 };
 
+/**
+ * A ResourceProvider wrapper letting several animations built from the same source share their
+ * resources: each resource is loaded from the wrapped provider once, and served to all of them.
+ *
+ * Static image assets are decoded once and share the same SkImage.  Animated image assets hold
+ * playback state, so each loadImageAsset() call gets its own from the wrapped provider.
+ *
+ * Safe to use from several threads, e.g. to build per-thread clones of an animation.
+ */
+class SharedResourceProvider final : public skottie::ResourceProvider {
+public:
+    static sk_sp<SharedResourceProvider> Make(sk_sp<skottie::ResourceProvider>);
+
+    sk_sp<SkData> load(const char resource_path[], const char resource_name[]) const override;
+
+    sk_sp<skottie::ImageAsset> loadImageAsset(const char[], const char []) const override;
+
+    sk_sp<SkData> loadFont(const char name[], const char url[]) const override;
+
+private:
+    explicit SharedResourceProvider(sk_sp<skottie::ResourceProvider>);
+
+    struct ImageEntry {
+        sk_sp<SkImage> fImage;       // Static assets only.
+        bool           fMultiFrame;
+    };
+
+    const sk_sp<skottie::ResourceProvider> fProxy;
+
+    mutable SkMutex                                        fMutex;
+    mutable std::unordered_map<std::string, sk_sp<SkData>> fData     SK_GUARDED_BY(fMutex),
+                                                           fFonts    SK_GUARDED_BY(fMutex);
+    mutable std::unordered_map<std::string, ImageEntry>    fImages   SK_GUARDED_BY(fMutex);
+
+    using INHERITED = skottie::ResourceProvider;
+};
+
 /**
  * CustomPropertyManager implements a property management scheme where color/opacity/transform
  * attributes are grouped and manipulated by name (one-to-many mapping).
@@ -0,0 +1,108 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkSGCacheEffect_DEFINED
+#define SkSGCacheEffect_DEFINED
+
+#include "modules/sksg/include/SkSGEffectNode.h"
+
+#include "include/core/SkImage.h"
+#include "include/core/SkMatrix.h"
+
+namespace sksg {
+
+/**
+ * Concrete Effect node, replaying its descendants from a cached image while they stay unchanged.
+ *
+ * When the descendants render twice in a row without being invalidated, under the same total
+ * matrix (up to an integer translation), they are rasterized into an image -- a texture, when the
+ * destination canvas is GPU-backed -- which is drawn instead of them until they are invalidated
+ * again.
+ *
+ * The descendants are rasterized into a transparent image and composited with src-over, so this
+ * should only wrap content that doesn't otherwise blend with what is beneath it.
+ */
+class CacheEffect final : public EffectNode {
+public:
+    /**
+     * A byte budget shared by the images of the CacheEffects made with it. When a new image would
+     * exceed it, the least recently drawn images are evicted.
+     *
+     * Budgets are not thread safe: the nodes sharing one must all be rendered on the same thread.
+     */
+    class Budget final : public SkRefCnt {
+    public:
+        static sk_sp<Budget> Make(size_t byteLimit) {
+            return sk_sp<Budget>(new Budget(byteLimit));
+        }
+        ~Budget() override;
+
+        size_t byteLimit() const { return fByteLimit; }
+        size_t bytesUsed() const { return fBytesUsed; }
+
+    private:
+        explicit Budget(size_t byteLimit);
+
+        bool reserve(const CacheEffect*, size_t bytes);
+        void release(const CacheEffect*);
+        void touch(const CacheEffect*);
+        void link(const CacheEffect*);
+        void unlink(const CacheEffect*);
+
+        const size_t fByteLimit;
+        size_t       fBytesUsed = 0;
+
+        // Nodes holding images, most recently drawn first.
+        const CacheEffect* fHead = nullptr;
+        const CacheEffect* fTail = nullptr;
+
+        friend class CacheEffect;
+    };
+
+    static sk_sp<CacheEffect> Make(sk_sp<RenderNode> child, sk_sp<Budget> budget) {
+        return child && budget
+            ? sk_sp<CacheEffect>(new CacheEffect(std::move(child), std::move(budget)))
+            : nullptr;
+    }
+
+    ~CacheEffect() override;
+
+    bool hasCachedImage() const { return SkToBool(fImage); }
+
+protected:
+    CacheEffect(sk_sp<RenderNode>, sk_sp<Budget>);
+
+    void onRender(SkCanvas*, const RenderContext*) const override;
+
+    SkRect onRevalidate(InvalidationController*, const SkMatrix&) override;
+
+private:
+    bool makeImage(SkCanvas*, const SkMatrix& ctm) const;
+    void dropImage() const;
+
+    const sk_sp<Budget> fBudget;
+
+    // The image and the device space position it was rendered at, under fCTM.
+    mutable sk_sp<SkImage> fImage;
+    mutable SkIPoint       fImageOrigin = { 0, 0 };
+    mutable size_t         fImageBytes  = 0;
+
+    // The total matrix of the last render, and whether there has been one since the last
+    // invalidation.
+    mutable SkMatrix       fCTM;
+    mutable bool           fRendered = false;
+
+    // Budget LRU links.
+    mutable const CacheEffect* fPrev = nullptr;
+    mutable const CacheEffect* fNext = nullptr;
+
+    typedef EffectNode INHERITED;
+};
+
+} // namespace sksg
+
+#endif // SkSGCacheEffect_DEFINED
@@ -60,6 +60,10 @@ private:
 
     const std::vector<Rec> fRecs;
     SkPath                 fMerged;
+    SkRect                 fMergedBounds = SkRect::MakeEmpty();
+
+    // The child paths fMerged was built from.
+    std::vector<SkPath>    fInputs;
 
     using INHERITED = GeometryNode;
 };
@@ -19,6 +19,7 @@ struct SkPoint;
 
 namespace sksg {
 
+class InvalidationController;
 class RenderNode;
 
 /**
@@ -68,9 +69,13 @@ public:
 
     void render(SkCanvas*) const;
     void animate(float t);
+    // Brings the scene up to date after animate(), reporting the areas that changed to the
+    // (optional) controller. render() does this itself when the scene hasn't been revalidated.
+    void revalidate(InvalidationController* = nullptr);
     const RenderNode* nodeAt(const SkPoint&) const;
 
     void setShowInval(bool show) { fShowInval = show; }
+    bool showInval() const { return fShowInval; }
 
 private:
     Scene(sk_sp<RenderNode> root, AnimatorList&& animators);
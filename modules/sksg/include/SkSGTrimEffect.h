@@ -51,6 +51,13 @@ private:
                               fStop  = 1;
     SkTrimPathEffect::Mode    fMode  = SkTrimPathEffect::Mode::kNormal;
 
+    // What fTrimmedPath was last computed from.
+    SkRect                    fTrimmedBounds = SkRect::MakeEmpty();
+    SkPath                    fInput;
+    SkScalar                  fInputStart = 0,
+                              fInputStop  = 0;
+    SkTrimPathEffect::Mode    fInputMode  = SkTrimPathEffect::Mode::kNormal;
+
     using INHERITED = GeometryNode;
 };
 
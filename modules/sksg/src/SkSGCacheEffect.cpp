@@ -0,0 +1,194 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "modules/sksg/include/SkSGCacheEffect.h"
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkSurface.h"
+
+#include <cmath>
+
+namespace sksg {
+
+namespace {
+
+// True if content rendered under |a| lands on the same pixel grid, with the same coverage, as
+// content rendered under |b|: the matrices may only differ by an integer translation.
+bool same_up_to_integer_translate(const SkMatrix& a, const SkMatrix& b) {
+    for (int i = 0; i < 9; ++i) {
+        if (i != SkMatrix::kMTransX && i != SkMatrix::kMTransY && a[i] != b[i]) {
+            return false;
+        }
+    }
+    const auto dx = a.getTranslateX() - b.getTranslateX(),
+               dy = a.getTranslateY() - b.getTranslateY();
+    return dx == std::floor(dx) && dy == std::floor(dy);
+}
+
+} // namespace
+
+CacheEffect::Budget::Budget(size_t byteLimit) : fByteLimit(byteLimit) {}
+
+CacheEffect::Budget::~Budget() {
+    // Each node holds a ref on its budget.
+    SkASSERT(!fHead && !fTail && !fBytesUsed);
+}
+
+bool CacheEffect::Budget::reserve(const CacheEffect* node, size_t bytes) {
+    SkASSERT(!node->fImage);
+    if (bytes > fByteLimit) {
+        return false;
+    }
+    while (fBytesUsed + bytes > fByteLimit) {
+        SkASSERT(fTail);
+        const CacheEffect* victim = fTail;
+        this->release(victim);
+        victim->fImage.reset();
+        victim->fImageBytes = 0;
+    }
+    fBytesUsed += bytes;
+    this->link(node);
+    return true;
+}
+
+void CacheEffect::Budget::release(const CacheEffect* node) {
+    SkASSERT(fBytesUsed >= node->fImageBytes);
+    fBytesUsed -= node->fImageBytes;
+    this->unlink(node);
+}
+
+void CacheEffect::Budget::touch(const CacheEffect* node) {
+    if (fHead != node) {
+        this->unlink(node);
+        this->link(node);
+    }
+}
+
+void CacheEffect::Budget::link(const CacheEffect* node) {
+    SkASSERT(!node->fPrev && !node->fNext);
+    node->fNext = fHead;
+    if (fHead) {
+        fHead->fPrev = node;
+    } else {
+        fTail = node;
+    }
+    fHead = node;
+}
+
+void CacheEffect::Budget::unlink(const CacheEffect* node) {
+    (node->fPrev ? node->fPrev->fNext : fHead) = node->fNext;
+    (node->fNext ? node->fNext->fPrev : fTail) = node->fPrev;
+    node->fPrev = node->fNext = nullptr;
+}
+
+CacheEffect::CacheEffect(sk_sp<RenderNode> child, sk_sp<Budget> budget)
+    : INHERITED(std::move(child))
+    , fBudget(std::move(budget)) {}
+
+CacheEffect::~CacheEffect() {
+    this->dropImage();
+}
+
+void CacheEffect::dropImage() const {
+    if (fImage) {
+        fBudget->release(this);
+        fImage.reset();
+        fImageBytes = 0;
+    }
+}
+
+bool CacheEffect::makeImage(SkCanvas* canvas, const SkMatrix& ctm) const {
+    SkASSERT(!fImage);
+
+    if (ctm.hasPerspective()) {
+        return false;
+    }
+    const auto dev_bounds = ctm.mapRect(this->bounds()).roundOut();
+    if (dev_bounds.isEmpty()) {
+        return false;
+    }
+
+    const auto info = SkImageInfo::MakeN32Premul(dev_bounds.width(), dev_bounds.height(),
+                                                 canvas->imageInfo().refColorSpace());
+    const auto bytes = info.computeMinByteSize();
+    if (!fBudget->reserve(this, bytes)) {
+        return false;
+    }
+    fImageBytes = bytes;
+
+    // Match the destination's backend, so GPU canvases get a texture.
+    auto surface = canvas->makeSurface(info);
+    if (!surface) {
+        surface = SkSurface::MakeRaster(info);
+    }
+    if (!surface) {
+        this->dropImage();
+        return false;
+    }
+
+    auto* image_canvas = surface->getCanvas();
+    image_canvas->clear(SK_ColorTRANSPARENT);
+    image_canvas->translate(-dev_bounds.x(), -dev_bounds.y());
+    image_canvas->concat(ctm);
+    this->INHERITED::onRender(image_canvas, nullptr);
+
+    fImage       = surface->makeImageSnapshot();
+    fImageOrigin = { dev_bounds.x(), dev_bounds.y() };
+    fCTM         = ctm;
+
+    return true;
+}
+
+void CacheEffect::onRender(SkCanvas* canvas, const RenderContext* ctx) const {
+    // Shader overrides are applied to each individual draw, which the image can't reproduce.
+    if (ctx && ctx->fShader) {
+        this->dropImage();
+        fRendered = false;
+        this->INHERITED::onRender(canvas, ctx);
+        return;
+    }
+
+    const auto ctm = canvas->getTotalMatrix();
+    const auto same_ctm = fRendered && same_up_to_integer_translate(ctm, fCTM);
+    if (!same_ctm) {
+        this->dropImage();
+    }
+
+    // Only rasterize content that rendered the same way last time, so animating content doesn't
+    // get rasterized on every frame.
+    if (!fImage && !(same_ctm && this->makeImage(canvas, ctm))) {
+        fRendered = true;
+        fCTM = ctm;
+        this->INHERITED::onRender(canvas, ctx);
+        return;
+    }
+
+    fBudget->touch(this);
+
+    // (Image: fImageOrigin in the fCTM device space) => (ctm device space).
+    const auto x = fImageOrigin.x() + (ctm.getTranslateX() - fCTM.getTranslateX()),
+               y = fImageOrigin.y() + (ctm.getTranslateY() - fCTM.getTranslateY());
+
+    const auto local_ctx = ScopedRenderContext(canvas, ctx).setIsolation(this->bounds(), ctm, true);
+
+    canvas->save();
+    canvas->resetMatrix();
+    canvas->drawImage(fImage, x, y);
+    canvas->restore();
+}
+
+SkRect CacheEffect::onRevalidate(InvalidationController* ic, const SkMatrix& ctm) {
+    SkASSERT(this->hasInval());
+
+    // Something below changed.
+    this->dropImage();
+    fRendered = false;
+
+    return this->INHERITED::onRevalidate(ic, ctm);
+}
+
+} // namespace sksg
@@ -63,13 +63,33 @@ static SkPathOp mode_to_op(Merge::Mode mode) {
 SkRect Merge::onRevalidate(InvalidationController* ic, const SkMatrix& ctm) {
     SkASSERT(this->hasInval());
 
+    // An invalidated child doesn't necessarily produce a different path (e.g. an animated value
+    // going back and forth), and path ops are expensive: only rebuild when the inputs changed.
+    bool inputs_changed = fInputs.size() != fRecs.size();
+    fInputs.resize(fRecs.size());
+
+    for (size_t i = 0; i < fRecs.size(); ++i) {
+        fRecs[i].fGeo->revalidate(ic, ctm);
+
+        auto path = fRecs[i].fGeo->asPath();
+        if (inputs_changed || path != fInputs[i]) {
+            fInputs[i] = std::move(path);
+            inputs_changed = true;
+        }
+    }
+
+    if (!inputs_changed) {
+        return fMergedBounds;
+    }
+
     SkOpBuilder builder;
 
     fMerged.reset();
     bool in_builder = false;
 
-    for (const auto& rec : fRecs) {
-        rec.fGeo->revalidate(ic, ctm);
+    for (size_t i = 0; i < fRecs.size(); ++i) {
+        const auto& rec  = fRecs[i];
+        const auto& path = fInputs[i];
 
         // Merge is not currently supported by SkOpBuidler.
         if (rec.fMode == Mode::kMerge) {
@@ -78,7 +98,7 @@ SkRect Merge::onRevalidate(InvalidationController* ic, const SkMatrix& ctm) {
                 in_builder = false;
             }
 
-            fMerged.addPath(rec.fGeo->asPath());
+            fMerged.addPath(path);
             continue;
         }
 
@@ -87,7 +107,7 @@ SkRect Merge::onRevalidate(InvalidationController* ic, const SkMatrix& ctm) {
             in_builder = true;
         }
 
-        builder.add(rec.fGeo->asPath(), mode_to_op(rec.fMode));
+        builder.add(path, mode_to_op(rec.fMode));
     }
 
     if (in_builder) {
@@ -95,8 +115,9 @@ SkRect Merge::onRevalidate(InvalidationController* ic, const SkMatrix& ctm) {
     }
 
     fMerged.shrinkToFit();
+    fMergedBounds = fMerged.computeTightBounds();
 
-    return fMerged.computeTightBounds();
+    return fMergedBounds;
 }
 
 } // namespace sksg
@@ -44,7 +44,16 @@ SkRect TrimEffect::onRevalidate(InvalidationController* ic, const SkMatrix& ctm)
     SkASSERT(this->hasInval());
 
     const auto childbounds = fChild->revalidate(ic, ctm);
-    const auto path        = fChild->asPath();
+    auto       path        = fChild->asPath();
+
+    // The child may have been invalidated without its path actually changing.
+    if (path == fInput && fStart == fInputStart && fStop == fInputStop && fMode == fInputMode) {
+        return fTrimmedBounds;
+    }
+    fInput      = path;
+    fInputStart = fStart;
+    fInputStop  = fStop;
+    fInputMode  = fMode;
 
     if (auto trim = SkTrimPathEffect::Make(fStart, fStop, fMode)) {
         fTrimmedPath.reset();
@@ -55,8 +64,9 @@ SkRect TrimEffect::onRevalidate(InvalidationController* ic, const SkMatrix& ctm)
     }
 
     fTrimmedPath.shrinkToFit();
+    fTrimmedBounds = fTrimmedPath.computeTightBounds();
 
-    return fTrimmedPath.computeTightBounds();
+    return fTrimmedBounds;
 }
 
 } // namespace sksg
@@ -9,15 +9,20 @@
 
 #if !defined(SK_BUILD_FOR_GOOGLE3)
 
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
 #include "include/core/SkRect.h"
 #include "include/private/SkTo.h"
+#include "modules/sksg/include/SkSGCacheEffect.h"
 #include "modules/sksg/include/SkSGDraw.h"
 #include "modules/sksg/include/SkSGGroup.h"
 #include "modules/sksg/include/SkSGInvalidationController.h"
+#include "modules/sksg/include/SkSGMerge.h"
 #include "modules/sksg/include/SkSGPaint.h"
 #include "modules/sksg/include/SkSGRect.h"
 #include "modules/sksg/include/SkSGRenderEffect.h"
 #include "modules/sksg/include/SkSGTransform.h"
+#include "modules/sksg/include/SkSGTrimEffect.h"
 #include "src/core/SkRectPriv.h"
 
 #include "tests/Test.h"
@@ -346,4 +351,176 @@ DEF_TEST(SGInvalidation, reporter) {
     inval_group_remove(reporter);
 }
 
+namespace {
+
+// Draws a rect, and counts how many times it has been drawn.
+class CountingRect final : public sksg::RenderNode {
+public:
+    static sk_sp<CountingRect> Make(const SkRect& rect) {
+        return sk_sp<CountingRect>(new CountingRect(rect));
+    }
+
+    int renderCount() const { return fRenderCount; }
+
+    void setColor(SkColor color) {
+        fColor = color;
+        this->invalidate();
+    }
+
+protected:
+    void onRender(SkCanvas* canvas, const RenderContext*) const override {
+        ++fRenderCount;
+        SkPaint paint;
+        paint.setColor(fColor);
+        canvas->drawRect(fRect, paint);
+    }
+
+    const RenderNode* onNodeAt(const SkPoint&) const override { return this; }
+
+    SkRect onRevalidate(sksg::InvalidationController*, const SkMatrix&) override { return fRect; }
+
+private:
+    explicit CountingRect(const SkRect& rect) : fRect(rect) {}
+
+    const SkRect fRect;
+    SkColor      fColor = SK_ColorRED;
+    mutable int  fRenderCount = 0;
+};
+
+} // namespace
+
+static void cache_test_replay(skiatest::Reporter* reporter) {
+    auto rect = CountingRect::Make(SkRect::MakeWH(20, 20));
+    auto budget = sksg::CacheEffect::Budget::Make(1 << 20);
+    auto cache = sksg::CacheEffect::Make(rect, budget);
+
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(64, 64);
+    SkCanvas canvas(bitmap);
+
+    auto render = [&](SkScalar tx, SkScalar ty) {
+        bitmap.eraseColor(SK_ColorTRANSPARENT);
+        cache->revalidate(nullptr, SkMatrix::I());
+        canvas.save();
+        canvas.translate(tx, ty);
+        cache->render(&canvas);
+        canvas.restore();
+    };
+
+    // The first render draws the content directly, the second rasterizes it into the cache.
+    render(0, 0);
+    REPORTER_ASSERT(reporter, rect->renderCount() == 1);
+    REPORTER_ASSERT(reporter, !cache->hasCachedImage());
+    render(0, 0);
+    REPORTER_ASSERT(reporter, rect->renderCount() == 2);
+    REPORTER_ASSERT(reporter, cache->hasCachedImage());
+    REPORTER_ASSERT(reporter, budget->bytesUsed() == 20 * 20 * 4);
+    REPORTER_ASSERT(reporter, *bitmap.getAddr32(10, 10) == SkPreMultiplyColor(SK_ColorRED));
+
+    // Later renders replay the image, even under a different integer translation.
+    render(0, 0);
+    REPORTER_ASSERT(reporter, rect->renderCount() == 2);
+    render(30, 40);
+    REPORTER_ASSERT(reporter, rect->renderCount() == 2);
+    REPORTER_ASSERT(reporter, *bitmap.getAddr32(10, 10) == 0);
+    REPORTER_ASSERT(reporter, *bitmap.getAddr32(30, 40) == SkPreMultiplyColor(SK_ColorRED));
+    REPORTER_ASSERT(reporter, *bitmap.getAddr32(49, 59) == SkPreMultiplyColor(SK_ColorRED));
+    REPORTER_ASSERT(reporter, *bitmap.getAddr32(50, 60) == 0);
+
+    // A fractional translation changes the rasterization, and drops the image.
+    render(0.5f, 0);
+    REPORTER_ASSERT(reporter, rect->renderCount() == 3);
+    REPORTER_ASSERT(reporter, !cache->hasCachedImage());
+    REPORTER_ASSERT(reporter, budget->bytesUsed() == 0);
+    render(0.5f, 0);
+    REPORTER_ASSERT(reporter, rect->renderCount() == 4);
+    REPORTER_ASSERT(reporter, cache->hasCachedImage());
+
+    // So does invalidating the content.
+    rect->setColor(SK_ColorBLUE);
+    render(0.5f, 0);
+    REPORTER_ASSERT(reporter, rect->renderCount() == 5);
+    REPORTER_ASSERT(reporter, !cache->hasCachedImage());
+    render(0.5f, 0);
+    render(0.5f, 0);
+    REPORTER_ASSERT(reporter, rect->renderCount() == 6);
+    REPORTER_ASSERT(reporter, *bitmap.getAddr32(10, 10) == SkPreMultiplyColor(SK_ColorBLUE));
+}
+
+static void cache_test_budget(skiatest::Reporter* reporter) {
+    static constexpr size_t kImageBytes = 20 * 20 * 4;
+
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(64, 64);
+    SkCanvas canvas(bitmap);
+
+    // Room for one image only: caching the second evicts the first.
+    auto budget = sksg::CacheEffect::Budget::Make(kImageBytes * 3 / 2);
+    auto cache1 = sksg::CacheEffect::Make(CountingRect::Make(SkRect::MakeWH(20, 20)), budget),
+         cache2 = sksg::CacheEffect::Make(CountingRect::Make(SkRect::MakeWH(20, 20)), budget);
+    for (const auto& cache : { cache1, cache2 }) {
+        cache->revalidate(nullptr, SkMatrix::I());
+        cache->render(&canvas);
+        cache->render(&canvas);
+    }
+    REPORTER_ASSERT(reporter, !cache1->hasCachedImage());
+    REPORTER_ASSERT(reporter, cache2->hasCachedImage());
+    REPORTER_ASSERT(reporter, budget->bytesUsed() == kImageBytes);
+
+    // Deleting a node releases its image.
+    cache2.reset();
+    REPORTER_ASSERT(reporter, budget->bytesUsed() == 0);
+
+    // Content too big for the budget is never cached.
+    auto small_budget = sksg::CacheEffect::Budget::Make(kImageBytes / 2);
+    auto rect = CountingRect::Make(SkRect::MakeWH(20, 20));
+    auto cache3 = sksg::CacheEffect::Make(rect, small_budget);
+    cache3->revalidate(nullptr, SkMatrix::I());
+    for (int i = 0; i < 3; ++i) {
+        cache3->render(&canvas);
+    }
+    REPORTER_ASSERT(reporter, rect->renderCount() == 3);
+    REPORTER_ASSERT(reporter, !cache3->hasCachedImage());
+    REPORTER_ASSERT(reporter, small_budget->bytesUsed() == 0);
+}
+
+DEF_TEST(SGCacheEffect, reporter) {
+    cache_test_replay(reporter);
+    cache_test_budget(reporter);
+}
+
+DEF_TEST(SGGeometryCache, reporter) {
+    auto r1 = sksg::Rect::Make(SkRect::MakeWH(100, 100)),
+         r2 = sksg::Rect::Make(SkRect::MakeXYWH(50, 50, 100, 100));
+    auto merge = sksg::Merge::Make({
+        { r1, sksg::Merge::Mode::kMerge },
+        { r2, sksg::Merge::Mode::kUnion },
+    });
+    auto trim = sksg::TrimEffect::Make(merge);
+    trim->setStop(0.5f);
+
+    trim->revalidate(nullptr, SkMatrix::I());
+    const auto merged_id = merge->asPath().getGenerationID(),
+               trimmed_id = trim->asPath().getGenerationID();
+
+    // Invalidated, but back to the same geometry: the previous results are reused.
+    r1->setL(10);
+    r1->setL(0);
+    const auto bounds = trim->revalidate(nullptr, SkMatrix::I());
+    REPORTER_ASSERT(reporter, merge->asPath().getGenerationID() == merged_id);
+    REPORTER_ASSERT(reporter, trim->asPath().getGenerationID() == trimmed_id);
+    REPORTER_ASSERT(reporter, bounds == trim->asPath().computeTightBounds());
+
+    // Actual changes are picked up.
+    trim->setStop(0.75f);
+    trim->revalidate(nullptr, SkMatrix::I());
+    REPORTER_ASSERT(reporter, merge->asPath().getGenerationID() == merged_id);
+    REPORTER_ASSERT(reporter, trim->asPath().getGenerationID() != trimmed_id);
+
+    r2->setR(200);
+    trim->revalidate(nullptr, SkMatrix::I());
+    REPORTER_ASSERT(reporter, merge->asPath().getGenerationID() != merged_id);
+    REPORTER_ASSERT(reporter, merge->asPath().getBounds() == SkRect::MakeWH(200, 150));
+}
+
 #endif // !defined(SK_BUILD_FOR_GOOGLE3)
@@ -16,6 +16,7 @@
 
 #include <memory>
 
+class SkExecutor;
 class SkFont;
 class SkFontMgr;
 
@@ -30,6 +31,9 @@ public:
     static std::unique_ptr<SkShaper> MakePrimitive();
     #ifdef SK_SHAPER_HARFBUZZ_AVAILABLE
     static std::unique_ptr<SkShaper> MakeShaperDrivenWrapper();
+    /** Like MakeShaperDrivenWrapper(), but remembers the glyphs of up to maxCachedRuns runs, so
+        text that is laid out again (every frame, or at a new width) isn't reshaped. */
+    static std::unique_ptr<SkShaper> MakeCachingShaperDrivenWrapper(int maxCachedRuns = 1024);
     static std::unique_ptr<SkShaper> MakeShapeThenWrap();
     static std::unique_ptr<SkShaper> MakeShapeDontWrapOrReorder();
     #endif
@@ -149,6 +153,28 @@ public:
                        SkScalar width,
                        RunHandler*) const = 0;
 
+    /** A paragraph for ShapeParagraphs(), with the arguments of the simple shape() call. */
+    struct Paragraph {
+        const char* utf8;
+        size_t utf8Bytes;
+        SkFont font;
+        bool leftToRight;
+        SkScalar width;
+        RunHandler* handler;
+    };
+
+    /**
+     *  Shapes the paragraphs concurrently as tasks on 'executor' (or SkExecutor::GetDefault() if
+     *  it is null). Each task shapes with its own shaper, made by 'makeShaper', so nothing is
+     *  shared between threads but the fonts.
+     *
+     *  The results are recorded and then delivered to each paragraph's handler on the calling
+     *  thread, in input order, before this returns; the handlers need not be thread-safe.
+     */
+    static void ShapeParagraphs(const Paragraph paragraphs[], int count,
+                                SkExecutor* executor = nullptr,
+                                std::unique_ptr<SkShaper> (*makeShaper)() = &SkShaper::Make);
+
 private:
     SkShaper(const SkShaper&) = delete;
     SkShaper& operator=(const SkShaper&) = delete;
@@ -5,21 +5,26 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkFontMetrics.h"
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkString.h"
 #include "include/core/SkTypeface.h"
+#include "include/private/SkTArray.h"
 #include "include/private/SkTFitsIn.h"
 #include "modules/skshaper/include/SkShaper.h"
 #include "src/core/SkMakeUnique.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkTextBlobPriv.h"
 #include "src/utils/SkUTF.h"
 
 #include <limits.h>
 #include <string.h>
+#include <atomic>
 #include <locale>
 #include <string>
+#include <thread>
 #include <utility>
 
 std::unique_ptr<SkShaper> SkShaper::Make() {
@@ -35,6 +40,131 @@ std::unique_ptr<SkShaper> SkShaper::Make() {
 SkShaper::SkShaper() {}
 SkShaper::~SkShaper() {}
 
+namespace {
+// Records everything a shaper tells its handler, to be replayed into another handler later.
+class RecordingRunHandler final : public SkShaper::RunHandler {
+public:
+    void beginLine() override { fOps.push_back(Op::kBeginLine); }
+    void runInfo(const RunInfo& info) override {
+        fOps.push_back(Op::kRunInfo);
+        fRuns.emplace_back(info);
+    }
+    void commitRunInfo() override { fOps.push_back(Op::kCommitRunInfo); }
+    Buffer runBuffer(const RunInfo& info) override {
+        fOps.push_back(Op::kRunBuffer);
+        Run& run = fRuns.emplace_back(info);
+        // Offsets and clusters are zeroed in case the shaper doesn't write them.
+        run.fGlyphs.reset(new SkGlyphID[info.glyphCount]);
+        run.fPositions.reset(new SkPoint[info.glyphCount]);
+        run.fOffsets.reset(new SkPoint[info.glyphCount]());
+        run.fClusters.reset(new uint32_t[info.glyphCount]());
+        return { run.fGlyphs.get(), run.fPositions.get(), run.fOffsets.get(),
+                 run.fClusters.get(), {0, 0} };
+    }
+    void commitRunBuffer(const RunInfo&) override {}
+    void commitLine() override { fOps.push_back(Op::kCommitLine); }
+
+    void replay(SkShaper::RunHandler* handler) const {
+        int runIndex = 0;
+        for (Op op : fOps) {
+            switch (op) {
+                case Op::kBeginLine:
+                    handler->beginLine();
+                    break;
+                case Op::kRunInfo:
+                    handler->runInfo(fRuns[runIndex++].info());
+                    break;
+                case Op::kCommitRunInfo:
+                    handler->commitRunInfo();
+                    break;
+                case Op::kRunBuffer:
+                    ReplayRunBuffer(fRuns[runIndex++], handler);
+                    break;
+                case Op::kCommitLine:
+                    handler->commitLine();
+                    break;
+            }
+        }
+    }
+
+private:
+    enum class Op { kBeginLine, kRunInfo, kCommitRunInfo, kRunBuffer, kCommitLine };
+
+    struct Run {
+        explicit Run(const RunInfo& info)
+            : fFont(info.fFont)
+            , fBidiLevel(info.fBidiLevel)
+            , fAdvance(info.fAdvance)
+            , fGlyphCount(info.glyphCount)
+            , fUtf8Range(info.utf8Range) {}
+
+        RunInfo info() const { return { fFont, fBidiLevel, fAdvance, fGlyphCount, fUtf8Range }; }
+
+        SkFont fFont;
+        uint8_t fBidiLevel;
+        SkVector fAdvance;
+        size_t fGlyphCount;
+        Range fUtf8Range;
+        std::unique_ptr<SkGlyphID[]> fGlyphs;
+        std::unique_ptr<SkPoint[]> fPositions;
+        std::unique_ptr<SkPoint[]> fOffsets;
+        std::unique_ptr<uint32_t[]> fClusters;
+    };
+
+    static void ReplayRunBuffer(const Run& run, SkShaper::RunHandler* handler) {
+        const RunInfo info = run.info();
+        const Buffer buffer = handler->runBuffer(info);
+        SkASSERT(buffer.glyphs);
+        SkASSERT(buffer.positions);
+        memcpy(buffer.glyphs, run.fGlyphs.get(), run.fGlyphCount * sizeof(SkGlyphID));
+        for (size_t i = 0; i < run.fGlyphCount; ++i) {
+            if (buffer.offsets) {
+                buffer.positions[i] = run.fPositions[i] + buffer.point;
+                buffer.offsets[i] = run.fOffsets[i];
+            } else {
+                buffer.positions[i] = run.fPositions[i] + buffer.point + run.fOffsets[i];
+            }
+        }
+        if (buffer.clusters) {
+            memcpy(buffer.clusters, run.fClusters.get(), run.fGlyphCount * sizeof(uint32_t));
+        }
+        handler->commitRunBuffer(info);
+    }
+
+    SkTArray<Op> fOps;
+    SkTArray<Run> fRuns;
+};
+}  // namespace
+
+void SkShaper::ShapeParagraphs(const Paragraph paragraphs[], int count, SkExecutor* executor,
+                               std::unique_ptr<SkShaper> (*makeShaper)()) {
+    if (count <= 0) {
+        return;
+    }
+    std::unique_ptr<RecordingRunHandler[]> recordings(new RecordingRunHandler[count]);
+
+    // Each task makes one shaper and then takes paragraphs in order until they're all shaped.
+    const int taskCount = SkTMin(count, SkTMax(1, (int)std::thread::hardware_concurrency()));
+    std::atomic<int> next{0};
+    SkTaskGroup group(executor ? *executor : SkExecutor::GetDefault());
+    group.batch(taskCount, [&](int) {
+        std::unique_ptr<SkShaper> shaper = makeShaper();
+        if (!shaper) {
+            return;
+        }
+        for (int i = next++; i < count; i = next++) {
+            const Paragraph& paragraph = paragraphs[i];
+            shaper->shape(paragraph.utf8, paragraph.utf8Bytes, paragraph.font,
+                          paragraph.leftToRight, paragraph.width, &recordings[i]);
+        }
+    });
+    group.wait();
+
+    for (int i = 0; i < count; ++i) {
+        recordings[i].replay(paragraphs[i].handler);
+    }
+}
+
 /** Replaces invalid utf-8 sequences with REPLACEMENT CHARACTER U+FFFD. */
 static inline SkUnichar utf8_next(const char** ptr, const char* end) {
     SkUnichar val = SkUTF::NextUTF8(ptr, end);
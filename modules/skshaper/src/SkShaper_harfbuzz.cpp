@@ -16,6 +16,7 @@
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkScalar.h"
 #include "include/core/SkStream.h"
+#include "include/core/SkString.h"
 #include "include/core/SkTypeface.h"
 #include "include/core/SkTypes.h"
 #include "include/private/SkBitmaskEnum.h"
@@ -25,7 +26,9 @@
 #include "include/private/SkTemplates.h"
 #include "include/private/SkTo.h"
 #include "modules/skshaper/include/SkShaper.h"
+#include "src/core/SkLRUCache.h"
 #include "src/core/SkMakeUnique.h"
+#include "src/core/SkOpts.h"
 #include "src/core/SkTDPQueue.h"
 #include "src/utils/SkUTF.h"
 
@@ -271,14 +274,14 @@ hb_blob_t* skhb_get_table(hb_face_t* face, hb_tag_t tag, void* user_data) {
                           HB_MEMORY_MODE_WRITABLE, buffer, sk_free);
 }
 
-HBFont create_hb_font(const SkFont& font) {
+HBFace create_hb_face(SkTypeface* typeface) {
     int index;
-    std::unique_ptr<SkStreamAsset> typefaceAsset = font.getTypeface()->openStream(&index);
+    std::unique_ptr<SkStreamAsset> typefaceAsset = typeface->openStream(&index);
     HBFace face;
     if (!typefaceAsset) {
         face.reset(hb_face_create_for_tables(
             skhb_get_table,
-            reinterpret_cast<void *>(font.refTypeface().release()),
+            reinterpret_cast<void *>(SkRef(typeface)),
             [](void* user_data){ SkSafeUnref(reinterpret_cast<SkTypeface*>(user_data)); }));
     } else {
         HBBlob blob(stream_to_blob(std::move(typefaceAsset)));
@@ -289,18 +292,22 @@ HBFont create_hb_font(const SkFont& font) {
         return nullptr;
     }
     hb_face_set_index(face.get(), (unsigned)index);
-    hb_face_set_upem(face.get(), font.getTypeface()->getUnitsPerEm());
+    hb_face_set_upem(face.get(), typeface->getUnitsPerEm());
+    return face;
+}
 
-    HBFont otFont(hb_font_create(face.get()));
+HBFont create_hb_font(const SkFont& font, hb_face_t* face) {
+    HBFont otFont(hb_font_create(face));
     SkASSERT(otFont);
     if (!otFont) {
         return nullptr;
     }
     hb_ot_font_set_funcs(otFont.get());
-    int axis_count = font.getTypeface()->getVariationDesignPosition(nullptr, 0);
+    SkTypeface* typeface = font.getTypefaceOrDefault();
+    int axis_count = typeface->getVariationDesignPosition(nullptr, 0);
     if (axis_count > 0) {
         SkAutoSTMalloc<4, SkFontArguments::VariationPosition::Coordinate> axis_values(axis_count);
-        if (font.getTypeface()->getVariationDesignPosition(axis_values, axis_count) == axis_count) {
+        if (typeface->getVariationDesignPosition(axis_values, axis_count) == axis_count) {
             hb_font_set_variations(otFont.get(),
                                    reinterpret_cast<hb_variation_t*>(axis_values.get()),
                                    axis_count);
@@ -319,6 +326,33 @@ HBFont create_hb_font(const SkFont& font) {
     return skFont;
 }
 
+// Everything about an SkFont that goes into the hb_font_t made for it.
+struct HBFontKey {
+    explicit HBFontKey(const SkFont& font)
+        : fTypefaceID(font.getTypefaceOrDefault()->uniqueID())
+        , fSize(font.getSize())
+        , fScaleX(font.getScaleX())
+        , fSkewX(font.getSkewX())
+        , fFlags((uint32_t)font.getEdging()                  |
+                 (uint32_t)font.getHinting()          <<  2 |
+                 (uint32_t)font.isForceAutoHinting()  <<  4 |
+                 (uint32_t)font.isEmbeddedBitmaps()   <<  5 |
+                 (uint32_t)font.isSubpixel()          <<  6 |
+                 (uint32_t)font.isLinearMetrics()     <<  7 |
+                 (uint32_t)font.isEmbolden()          <<  8) {}
+
+    bool operator==(const HBFontKey& that) const {
+        return 0 == memcmp(this, &that, sizeof(*this));
+    }
+
+    SkFontID fTypefaceID;
+    SkScalar fSize;
+    SkScalar fScaleX;
+    SkScalar fSkewX;
+    uint32_t fFlags;
+};
+static_assert(sizeof(HBFontKey) == 20, "HBFontKey must not have padding");
+
 /** Replaces invalid utf-8 sequences with REPLACEMENT CHARACTER U+FFFD. */
 static inline SkUnichar utf8_next(const char** ptr, const char* end) {
     SkUnichar val = SkUTF::NextUTF8(ptr, end);
@@ -501,10 +535,178 @@ struct ShapedLine {
     SkVector fAdvance = { 0, 0 };
 };
 
+// HarfBuzz only looks at this many code points of context on either side of the text it shapes
+// (HB_BUFFER_CONTEXT_LENGTH), so a run shapes the same in any paragraph with the same context.
+constexpr int kShapingContextLength = 5;
+
+// Everything that goes into shaping a run: the font, direction, script, language, and the utf8 of
+// the run along with the context around it.
+struct ShapedRunKey {
+    ShapedRunKey(const SkFont& font, bool leftToRight, SkFourByteTag script, const char* language,
+                 const char* utf8, size_t utf8Bytes, const char* utf8Start, const char* utf8End)
+        : fFont(font)
+        , fLeftToRight(leftToRight)
+        , fScript(script)
+        , fLanguage(language)
+    {
+        const char* contextStart = utf8Start;
+        for (int i = 0; i < kShapingContextLength && contextStart > utf8; ++i) {
+            do {
+                --contextStart;
+            } while (contextStart > utf8 && (*contextStart & 0xC0) == 0x80);
+        }
+        const char* contextEnd = utf8End;
+        for (int i = 0; i < kShapingContextLength && contextEnd < utf8 + utf8Bytes; ++i) {
+            utf8_next(&contextEnd, utf8 + utf8Bytes);
+        }
+        fText.set(contextStart, contextEnd - contextStart);
+        fRunBegin = SkToU32(utf8Start - contextStart);
+        fRunSize = SkToU32(utf8End - utf8Start);
+
+        fHash = SkOpts::hash_fn(fText.c_str(), fText.size(), 0);
+        fHash = SkOpts::hash_fn(fLanguage.c_str(), fLanguage.size(), fHash);
+        fHash = SkOpts::hash_fn(&fFont, sizeof(fFont), fHash);
+        uint32_t rest[] = { fRunBegin, fRunSize, fLeftToRight, fScript };
+        fHash = SkOpts::hash_fn(rest, sizeof(rest), fHash);
+    }
+
+    bool operator==(const ShapedRunKey& that) const {
+        return fHash == that.fHash &&
+               fRunBegin == that.fRunBegin &&
+               fRunSize == that.fRunSize &&
+               fLeftToRight == that.fLeftToRight &&
+               fScript == that.fScript &&
+               fFont == that.fFont &&
+               fText.equals(that.fText) &&
+               fLanguage.equals(that.fLanguage);
+    }
+
+    struct Hash {
+        uint32_t operator()(const ShapedRunKey& key) const { return key.fHash; }
+    };
+
+    HBFontKey fFont;
+    bool fLeftToRight;
+    SkFourByteTag fScript;
+    SkString fLanguage;
+    SkString fText;
+    uint32_t fRunBegin;
+    uint32_t fRunSize;
+    uint32_t fHash;
+};
+
+// The glyphs of a shaped run, with clusters relative to the start of the run.
+struct ShapedRunGlyphs {
+    std::unique_ptr<ShapedGlyph[]> fGlyphs;
+    size_t fNumGlyphs;
+    SkVector fAdvance;
+};
+
 constexpr bool is_LTR(UBiDiLevel level) {
     return (level & 1) == 0;
 }
 
+// Characters HarfBuzz maps straight to one glyph each when the font has no layout tables: Latin and
+// Cyrillic letters, digits, punctuation, and symbols, but no controls, marks, default ignorables,
+// or anything else it might normalize, hide, or position specially.
+bool is_simple_unichar(SkUnichar u) {
+    return (0x0020 <= u && u <= 0x007E) ||
+           (0x00A0 <= u && u <= 0x024F && u != 0x00AD) ||
+           (0x0400 <= u && u <= 0x0482) ||
+           (0x048A <= u && u <= 0x052F) ||
+           (0x2010 <= u && u <= 0x2027) ||
+           (0x2030 <= u && u <= 0x205E) ||
+           (0x20A0 <= u && u <= 0x20BF);
+}
+
+// Shapes a left-to-right run the way HarfBuzz would with a font that has no GSUB, GPOS, or AAT
+// tables: one glyph per character, advanced by its width plus any 'kern' table adjustment.
+// Returns false, leaving 'run' alone, for runs that may need more than that.
+bool shape_simple(const char* utf8, const char* utf8Start, const char* utf8End,
+                  const SkFont& font, bool hasKern, ShapedRun* run) {
+    const size_t maxCount = utf8End - utf8Start;
+    SkAutoSTMalloc<64, SkUnichar> unichars(maxCount);
+    SkAutoSTMalloc<64, uint32_t> clusters(maxCount);
+    int count = 0;
+    for (const char* ptr = utf8Start; ptr < utf8End;) {
+        clusters[count] = SkToU32(ptr - utf8);
+        SkUnichar u = SkUTF::NextUTF8(&ptr, utf8End);
+        if (!is_simple_unichar(u)) {
+            return false;
+        }
+        unichars[count++] = u;
+    }
+    if (count == 0) {
+        return false;
+    }
+
+    SkAutoSTMalloc<64, SkGlyphID> glyphs(count);
+    font.textToGlyphs(unichars.get(), count * sizeof(SkUnichar), SkTextEncoding::kUTF32,
+                      glyphs.get(), count);
+    for (int i = 0; i < count; ++i) {
+        if (glyphs[i] == 0) {
+            return false;
+        }
+    }
+
+    // Positions in HarfBuzz units, so rounding matches what hb_shape() would produce.
+    const int scale = skhb_position(font.getSize());
+    SkAutoSTMalloc<64, hb_position_t> advances(count);
+    SkAutoSTMalloc<64, hb_position_t> offsets(count);
+    SkAutoSTMalloc<64, bool> unsafeToBreak(count);
+    SkAutoSTMalloc<64, SkScalar> widths(count);
+    SkAutoSTMalloc<64, SkRect> bounds(count);
+    SkPaint p;
+    font.getWidthsBounds(glyphs.get(), count, widths.get(), bounds.get(), &p);
+    for (int i = 0; i < count; ++i) {
+        SkScalar advance = font.isSubpixel() ? widths[i] : SkScalarRoundToInt(widths[i]);
+        advances[i] = skhb_position(advance);
+        offsets[i] = 0;
+        unsafeToBreak[i] = false;
+    }
+
+    if (hasKern && count > 1) {
+        SkTypeface* typeface = font.getTypefaceOrDefault();
+        SkAutoSTMalloc<64, int32_t> kerning(count - 1);
+        if (!typeface->getKerningPairAdjustments(glyphs.get(), count, kerning.get())) {
+            // The font has kerning we can't get at, so let HarfBuzz read the table itself.
+            return false;
+        }
+        const int upem = typeface->getUnitsPerEm();
+        if (upem <= 0) {
+            return false;
+        }
+        for (int i = 0; i + 1 < count; ++i) {
+            // Like HarfBuzz, split each adjustment between the pair so it falls between them.
+            hb_position_t kern = SkToS32((int64_t)kerning[i] * scale / upem);
+            hb_position_t kern1 = kern >> 1;
+            hb_position_t kern2 = kern - kern1;
+            advances[i] += kern1;
+            advances[i + 1] += kern2;
+            offsets[i + 1] += kern2;
+            unsafeToBreak[i + 1] = kern != 0;
+        }
+    }
+
+    *run = ShapedRun(run->fUtf8Range, run->fFont, run->fLevel,
+                     std::unique_ptr<ShapedGlyph[]>(new ShapedGlyph[count]), count);
+    double textSizeX = run->fFont.getSize() / scale * run->fFont.getScaleX();
+    SkVector runAdvance = { 0, 0 };
+    for (int i = 0; i < count; ++i) {
+        ShapedGlyph& glyph = run->fGlyphs[i];
+        glyph.fID = glyphs[i];
+        glyph.fCluster = clusters[i];
+        glyph.fOffset = { SkDoubleToScalar(offsets[i] * textSizeX), 0 };
+        glyph.fAdvance = { SkDoubleToScalar(advances[i] * textSizeX), 0 };
+        glyph.fHasVisual = !bounds[i].isEmpty();
+        glyph.fUnsafeToBreak = unsafeToBreak[i];
+        glyph.fMustLineBreakBefore = false;
+        runAdvance += glyph.fAdvance;
+    }
+    run->fAdvance = runAdvance;
+    return true;
+}
+
 void append(SkShaper::RunHandler* handler, const SkShaper::RunHandler::RunInfo& runInfo,
                    const ShapedRun& run, size_t startGlyphIndex, size_t endGlyphIndex) {
     SkASSERT(startGlyphIndex <= endGlyphIndex);
@@ -624,9 +826,13 @@ struct ShapedRunGlyphIterator {
     size_t fGlyphIndex;
 };
 
+// Each hb_face_t holds its typeface's tables, each hb_font_t just a size and some flags for one.
+constexpr int kMaxCachedHBFaces = 8;
+constexpr int kMaxCachedHBFonts = 32;
+
 class ShaperHarfBuzz : public SkShaper {
 public:
-    ShaperHarfBuzz(HBBuffer, ICUBrk line, ICUBrk grapheme);
+    ShaperHarfBuzz(HBBuffer, ICUBrk line, ICUBrk grapheme, int maxCachedRuns = 0);
 protected:
     ICUBrk fLineBreakIterator;
     ICUBrk fGraphemeBreakIterator;
@@ -639,7 +845,20 @@ protected:
                     const ScriptRunIterator&,
                     const FontRunIterator&) const;
 private:
+    // Returns the hb_font_t for 'font', making it (and its hb_face_t) only if it isn't cached.
+    hb_font_t* hbFont(const SkFont& font) const;
+
+    // Which typefaces have no GSUB, GPOS, or AAT tables, and so can be shaped by shape_simple().
+    enum SimpleTypeface : uint8_t { kNotSimple, kSimple, kSimpleWithKern };
+    SimpleTypeface simpleTypeface(SkTypeface* typeface) const;
+
     HBBuffer fBuffer;
+    mutable SkLRUCache<SkFontID, HBFace> fHBFaces;
+    mutable SkLRUCache<HBFontKey, HBFont> fHBFonts;
+    mutable SkLRUCache<SkFontID, SimpleTypeface> fSimpleTypefaces;
+    // Only made if asked for, since the same text is rarely shaped twice by most clients.
+    using ShapedRunCache = SkLRUCache<ShapedRunKey, ShapedRunGlyphs, ShapedRunKey::Hash>;
+    std::unique_ptr<ShapedRunCache> fShapedRuns;
 
     void shape(const char* utf8, size_t utf8Bytes,
                const SkFont&,
@@ -707,7 +926,7 @@ private:
               RunHandler*) const override;
 };
 
-static std::unique_ptr<SkShaper> MakeHarfBuzz(bool correct) {
+static std::unique_ptr<SkShaper> MakeHarfBuzz(bool correct, int maxCachedRuns = 0) {
     #if defined(SK_USING_THIRD_PARTY_ICU)
     if (!SkLoadICU()) {
         SkDEBUGF("SkLoadICU() failed!\n");
@@ -735,19 +954,69 @@ static std::unique_ptr<SkShaper> MakeHarfBuzz(bool correct) {
 
     if (correct) {
         return skstd::make_unique<ShaperDrivenWrapper>(
-            std::move(buffer), std::move(lineBreakIterator), std::move(graphemeBreakIterator));
+            std::move(buffer), std::move(lineBreakIterator), std::move(graphemeBreakIterator),
+            maxCachedRuns);
     } else {
         return skstd::make_unique<ShapeThenWrap>(
-            std::move(buffer), std::move(lineBreakIterator), std::move(graphemeBreakIterator));
+            std::move(buffer), std::move(lineBreakIterator), std::move(graphemeBreakIterator),
+            maxCachedRuns);
     }
 }
 
-ShaperHarfBuzz::ShaperHarfBuzz(HBBuffer buffer, ICUBrk line, ICUBrk grapheme)
+ShaperHarfBuzz::ShaperHarfBuzz(HBBuffer buffer, ICUBrk line, ICUBrk grapheme, int maxCachedRuns)
     : fLineBreakIterator(std::move(line))
     , fGraphemeBreakIterator(std::move(grapheme))
     , fBuffer(std::move(buffer))
+    , fHBFaces(kMaxCachedHBFaces)
+    , fHBFonts(kMaxCachedHBFonts)
+    , fSimpleTypefaces(kMaxCachedHBFaces)
+    , fShapedRuns(maxCachedRuns > 0 ? skstd::make_unique<ShapedRunCache>(maxCachedRuns) : nullptr)
 {}
 
+ShaperHarfBuzz::SimpleTypeface ShaperHarfBuzz::simpleTypeface(SkTypeface* typeface) const {
+    if (const SimpleTypeface* simple = fSimpleTypefaces.find(typeface->uniqueID())) {
+        return *simple;
+    }
+    SimpleTypeface simple = kSimple;
+    for (SkFontTableTag tag : { SkSetFourByteTag('G', 'S', 'U', 'B'),
+                                SkSetFourByteTag('G', 'P', 'O', 'S'),
+                                SkSetFourByteTag('m', 'o', 'r', 't'),
+                                SkSetFourByteTag('m', 'o', 'r', 'x'),
+                                SkSetFourByteTag('k', 'e', 'r', 'x'),
+                                SkSetFourByteTag('t', 'r', 'a', 'k') }) {
+        if (typeface->getTableSize(tag)) {
+            simple = kNotSimple;
+            break;
+        }
+    }
+    if (simple == kSimple && typeface->getTableSize(SkSetFourByteTag('k', 'e', 'r', 'n'))) {
+        simple = kSimpleWithKern;
+    }
+    return *fSimpleTypefaces.insert(typeface->uniqueID(), simple);
+}
+
+hb_font_t* ShaperHarfBuzz::hbFont(const SkFont& font) const {
+    HBFontKey key(font);
+    if (HBFont* hbFont = fHBFonts.find(key)) {
+        return hbFont->get();
+    }
+
+    HBFace* face = fHBFaces.find(key.fTypefaceID);
+    if (!face) {
+        HBFace newFace = create_hb_face(font.getTypefaceOrDefault());
+        if (!newFace) {
+            return nullptr;
+        }
+        face = fHBFaces.insert(key.fTypefaceID, std::move(newFace));
+    }
+
+    HBFont hbFont = create_hb_font(font, face->get());
+    if (!hbFont) {
+        return nullptr;
+    }
+    return fHBFonts.insert(key, std::move(hbFont))->get();
+}
+
 void ShaperHarfBuzz::shape(const char* utf8, size_t utf8Bytes,
                            const SkFont& srcFont,
                            bool leftToRight,
@@ -1230,6 +1499,33 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
     size_t utf8runLength = utf8End - utf8Start;
     ShapedRun run(RunHandler::Range(utf8Start - utf8, utf8runLength),
                   font.currentFont(), bidi.currentLevel(), nullptr, 0);
+    const uint32_t utf8runOffset = SkToU32(utf8Start - utf8);
+
+    if (is_LTR(bidi.currentLevel())) {
+        SimpleTypeface simple = this->simpleTypeface(font.currentFont().getTypefaceOrDefault());
+        if (simple != kNotSimple &&
+            shape_simple(utf8, utf8Start, utf8End, font.currentFont(), simple == kSimpleWithKern,
+                         &run)) {
+            return run;
+        }
+    }
+
+    std::unique_ptr<ShapedRunKey> key;
+    if (fShapedRuns) {
+        key = skstd::make_unique<ShapedRunKey>(font.currentFont(), is_LTR(bidi.currentLevel()),
+                                               script.currentScript(), language.currentLanguage(),
+                                               utf8, utf8Bytes, utf8Start, utf8End);
+        if (const ShapedRunGlyphs* cached = fShapedRuns->find(*key)) {
+            std::unique_ptr<ShapedGlyph[]> glyphs(new ShapedGlyph[cached->fNumGlyphs]);
+            for (size_t i = 0; i < cached->fNumGlyphs; ++i) {
+                glyphs[i] = cached->fGlyphs[i];
+                glyphs[i].fCluster += utf8runOffset;
+            }
+            return ShapedRun(RunHandler::Range(utf8runOffset, utf8runLength),
+                             font.currentFont(), bidi.currentLevel(),
+                             std::move(glyphs), cached->fNumGlyphs, cached->fAdvance);
+        }
+    }
 
     hb_buffer_t* buffer = fBuffer.get();
     SkAutoTCallVProc<hb_buffer_t, hb_buffer_clear_contents> autoClearBuffer(buffer);
@@ -1260,12 +1556,11 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
     hb_buffer_guess_segment_properties(buffer);
     // TODO: features
 
-    // TODO: how to cache hbface (typeface) / hbfont (font)
-    HBFont hbFont(create_hb_font(font.currentFont()));
+    hb_font_t* hbFont = this->hbFont(font.currentFont());
     if (!hbFont) {
         return run;
     }
-    hb_shape(hbFont.get(), buffer, nullptr, 0);
+    hb_shape(hbFont, buffer, nullptr, 0);
     unsigned len = hb_buffer_get_length(buffer);
     if (len == 0) {
         return run;
@@ -1283,7 +1578,7 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
                     font.currentFont(), bidi.currentLevel(),
                     std::unique_ptr<ShapedGlyph[]>(new ShapedGlyph[len]), len);
     int scaleX, scaleY;
-    hb_font_get_scale(hbFont.get(), &scaleX, &scaleY);
+    hb_font_get_scale(hbFont, &scaleX, &scaleY);
     double textSizeY = run.fFont.getSize() / scaleY;
     double textSizeX = run.fFont.getSize() / scaleX * run.fFont.getScaleX();
     SkVector runAdvance = { 0, 0 };
@@ -1312,6 +1607,15 @@ ShapedRun ShaperHarfBuzz::shape(char const * const utf8,
     }
     run.fAdvance = runAdvance;
 
+    if (key) {
+        std::unique_ptr<ShapedGlyph[]> glyphs(new ShapedGlyph[len]);
+        for (unsigned i = 0; i < len; ++i) {
+            glyphs[i] = run.fGlyphs[i];
+            glyphs[i].fCluster -= utf8runOffset;
+        }
+        fShapedRuns->insert(*key, {std::move(glyphs), len, runAdvance});
+    }
+
     return run;
 }
 
@@ -1365,6 +1669,9 @@ SkShaper::MakeHbIcuScriptRunIterator(const char* utf8, size_t utf8Bytes) {
 std::unique_ptr<SkShaper> SkShaper::MakeShaperDrivenWrapper() {
     return MakeHarfBuzz(true);
 }
+std::unique_ptr<SkShaper> SkShaper::MakeCachingShaperDrivenWrapper(int maxCachedRuns) {
+    return MakeHarfBuzz(true, maxCachedRuns);
+}
 std::unique_ptr<SkShaper> SkShaper::MakeShapeThenWrap() {
     return MakeHarfBuzz(false);
 }
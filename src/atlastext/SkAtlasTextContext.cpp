@@ -15,3 +15,5 @@ sk_sp<SkAtlasTextContext> SkAtlasTextContext::Make(sk_sp<SkAtlasTextRenderer> re
 
 SkAtlasTextContext::SkAtlasTextContext(sk_sp<SkAtlasTextRenderer> renderer)
         : fInternalContext(SkInternalAtlasTextContext::Make(std::move(renderer))) {}
+
+void SkAtlasTextContext::flush() { fInternalContext->flush(); }
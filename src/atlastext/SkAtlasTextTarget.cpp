@@ -120,6 +120,7 @@ public:
 
     void drawText(const SkGlyphID[], const SkPoint[], int glyphCnt, uint32_t color,
                   const SkAtlasTextFont&) override;
+    void submit() override;
     void flush() override;
 
 private:
@@ -198,14 +199,18 @@ void SkInternalAtlasTextTarget::deleteOps() {
     fOps.reset();
 }
 
-void SkInternalAtlasTextTarget::flush() {
+void SkInternalAtlasTextTarget::submit() {
     for (int i = 0; i < fOps.count(); ++i) {
         fOps[i]->executeForTextTarget(this);
     }
-    this->context()->internal().flush();
     this->deleteOps();
 }
 
+void SkInternalAtlasTextTarget::flush() {
+    this->submit();
+    this->context()->internal().flush();
+}
+
 void GrAtlasTextOp::finalizeForTextTarget(uint32_t color, const GrCaps& caps) {
     // TODO4F: Odd handling of client colors among AtlasTextTarget and AtlasTextRenderer
     SkPMColor4f color4f = SkPMColor4f::FromBytes_RGBA(color);
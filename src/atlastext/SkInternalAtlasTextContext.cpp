@@ -72,11 +72,11 @@ GrDeferredUploadToken SkInternalAtlasTextContext::addASAPUpload(
 
 void SkInternalAtlasTextContext::recordDraw(const void* srcVertexData, int glyphCnt,
                                             const SkMatrix& matrix, void* targetHandle) {
-    auto vertexDataSize = sizeof(SkAtlasTextRenderer::SDFVertex) * 4 * glyphCnt;
-    auto vertexData = fArena.makeArrayDefault<char>(vertexDataSize);
-    memcpy(vertexData, srcVertexData, vertexDataSize);
+    int firstQuad = fVertices.count() / 4;
+    auto* vertexData = fVertices.append(4 * glyphCnt,
+            static_cast<const SkAtlasTextRenderer::SDFVertex*>(srcVertexData));
     for (int i = 0; i < 4 * glyphCnt; ++i) {
-        auto* vertex = reinterpret_cast<SkAtlasTextRenderer::SDFVertex*>(vertexData) + i;
+        auto* vertex = vertexData + i;
         // GrTextContext encodes a texture index into the lower bit of each texture coord.
         // This isn't expected by SkAtlasTextRenderer subclasses.
         vertex->fTextureCoordX /= 2;
@@ -84,7 +84,7 @@ void SkInternalAtlasTextContext::recordDraw(const void* srcVertexData, int glyph
         matrix.mapHomogeneousPoints(&vertex->fPosition, &vertex->fPosition, 1);
     }
     fDraws.append(&fArena,
-                  Draw{glyphCnt, fTokenTracker.issueDrawToken(), targetHandle, vertexData});
+                  Draw{glyphCnt, fTokenTracker.issueDrawToken(), targetHandle, firstQuad});
 }
 
 void SkInternalAtlasTextContext::flush() {
@@ -110,19 +110,36 @@ void SkInternalAtlasTextContext::flush() {
     for (const auto& upload : fASAPUploads) {
         upload(writePixelsFn);
     }
+    // Draws are batched, whatever their target, until an inline upload must come between them.
+    auto drawBatch = [this]() {
+        if (!fRanges.isEmpty()) {
+            fRenderer->drawSDFGlyphBatch(fDistanceFieldAtlas.fTextureHandle, fVertices.begin(),
+                                         fVertices.count() / 4, fRanges.begin(), fRanges.count());
+            fRanges.rewind();
+        }
+    };
     auto inlineUpload = fInlineUploads.begin();
     for (const auto& draw : fDraws) {
+        if (inlineUpload != fInlineUploads.end() && inlineUpload->fToken == draw.fToken) {
+            drawBatch();
+        }
         while (inlineUpload != fInlineUploads.end() && inlineUpload->fToken == draw.fToken) {
             inlineUpload->fUpload(writePixelsFn);
             ++inlineUpload;
         }
-        auto vertices = reinterpret_cast<const SkAtlasTextRenderer::SDFVertex*>(draw.fVertexData);
-        fRenderer->drawSDFGlyphs(draw.fTargetHandle, fDistanceFieldAtlas.fTextureHandle, vertices,
-                                 draw.fGlyphCnt);
+        // Draws are recorded in order, so a target's consecutive draws are adjacent quads.
+        if (!fRanges.isEmpty() && fRanges.top().fTargetHandle == draw.fTargetHandle) {
+            SkASSERT(fRanges.top().fFirstQuad + fRanges.top().fQuadCnt == draw.fFirstQuad);
+            fRanges.top().fQuadCnt += draw.fGlyphCnt;
+        } else {
+            fRanges.push_back({draw.fTargetHandle, draw.fFirstQuad, draw.fGlyphCnt});
+        }
         fTokenTracker.flushToken();
     }
+    drawBatch();
     fASAPUploads.reset();
     fInlineUploads.reset();
     fDraws.reset();
+    fVertices.rewind();
     fArena.reset();
 }
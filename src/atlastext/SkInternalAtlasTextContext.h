@@ -8,7 +8,9 @@
 #ifndef SkInternalAtlasTextContext_DEFINED
 #define SkInternalAtlasTextContext_DEFINED
 
+#include "include/atlastext/SkAtlasTextRenderer.h"
 #include "include/core/SkRefCnt.h"
+#include "include/private/SkTDArray.h"
 #include "src/core/SkArenaAlloc.h"
 #include "src/core/SkArenaAllocList.h"
 #include "src/gpu/GrDeferredUpload.h"
@@ -17,7 +19,6 @@ class GrContext;
 class GrStrikeCache;
 class GrTextBlobCache;
 
-class SkAtlasTextRenderer;
 class SkMatrix;
 
 /**
@@ -63,7 +64,7 @@ private:
         int fGlyphCnt;
         GrDeferredUploadToken fToken;
         void* fTargetHandle;
-        const void* fVertexData;
+        int fFirstQuad;
     };
 
     struct InlineUpload {
@@ -75,6 +76,9 @@ private:
     SkArenaAllocList<InlineUpload> fInlineUploads;
     SkArenaAllocList<Draw> fDraws;
     SkArenaAllocList<GrDeferredTextureUploadFn> fASAPUploads;
+    // The vertices of every draw recorded since the last flush, four per glyph.
+    SkTDArray<SkAtlasTextRenderer::SDFVertex> fVertices;
+    SkTDArray<SkAtlasTextRenderer::SDFGlyphRange> fRanges;
     SkArenaAlloc fArena{1024 * 40};
     sk_sp<GrContext> fGrContext;
     AtlasTexture fDistanceFieldAtlas;
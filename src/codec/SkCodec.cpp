@@ -9,9 +9,11 @@
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkData.h"
 #include "include/private/SkHalf.h"
+#include "include/private/SkMalloc.h"
 #include "src/codec/SkBmpCodec.h"
 #include "src/codec/SkCodecPriv.h"
 #include "src/codec/SkFrameHolder.h"
+#include "src/core/SkOSFile.h"
 #ifdef SK_HAS_HEIF_LIBRARY
 #include "src/codec/SkHeifCodec.h"
 #endif
@@ -69,6 +71,7 @@ void SkCodec::Register(
 
 std::unique_ptr<SkCodec> SkCodec::MakeFromStream(std::unique_ptr<SkStream> stream,
                                                  Result* outResult, SkPngChunkReader* chunkReader) {
+    SkAutoMemoryTag memoryTag(SkMemoryTag::kCodec);
     Result resultStorage;
     if (!outResult) {
         outResult = &resultStorage;
@@ -79,6 +82,14 @@ std::unique_ptr<SkCodec> SkCodec::MakeFromStream(std::unique_ptr<SkStream> strea
         return nullptr;
     }
 
+    // Encoded data in memory, e.g. a mapped file, is usually decoded straight through, so let
+    // the OS read ahead of the decoder and reclaim the pages it has finished with.
+    if (const void* base = stream->getMemoryBase()) {
+        if (stream->hasLength()) {
+            sk_madvise_sequential(base, stream->getLength());
+        }
+    }
+
     constexpr size_t bytesToRead = MinBufferedBytesNeeded();
 
     char buffer[bytesToRead];
@@ -317,6 +328,7 @@ SkCodec::Result SkCodec::handleFrameIndex(const SkImageInfo& info, void* pixels,
 
 SkCodec::Result SkCodec::getPixels(const SkImageInfo& dstInfo, void* pixels, size_t rowBytes,
                                    const Options* options) {
+    SkAutoMemoryTag memoryTag(SkMemoryTag::kCodec);
     SkImageInfo info = dstInfo;
     if (!info.colorSpace()) {
         info = info.makeColorSpace(SkColorSpace::MakeSRGB());
@@ -392,6 +404,7 @@ SkCodec::Result SkCodec::getPixels(const SkImageInfo& dstInfo, void* pixels, siz
 
 SkCodec::Result SkCodec::startIncrementalDecode(const SkImageInfo& dstInfo, void* pixels,
         size_t rowBytes, const SkCodec::Options* options) {
+    SkAutoMemoryTag memoryTag(SkMemoryTag::kCodec);
     fStartedIncrementalDecode = false;
 
     SkImageInfo info = dstInfo;
@@ -465,6 +478,7 @@ SkCodec::Result SkCodec::startIncrementalDecode(const SkImageInfo& dstInfo, void
 
 SkCodec::Result SkCodec::startScanlineDecode(const SkImageInfo& dstInfo,
         const SkCodec::Options* options) {
+    SkAutoMemoryTag memoryTag(SkMemoryTag::kCodec);
     // Reset fCurrScanline in case of failure.
     fCurrScanline = -1;
 
@@ -523,6 +537,7 @@ SkCodec::Result SkCodec::startScanlineDecode(const SkImageInfo& dstInfo,
 }
 
 int SkCodec::getScanlines(void* dst, int countLines, size_t rowBytes) {
+    SkAutoMemoryTag memoryTag(SkMemoryTag::kCodec);
     if (fCurrScanline < 0) {
         return 0;
     }
@@ -47,12 +47,58 @@ sk_sp<SkData> SkCodecImageGenerator::onRefEncodedData() {
     return fData;
 }
 
+// Sample sizes are powers of two, so that draws at nearby scales share a decode.
+static constexpr int kMaxSampleSize = 64;
+
+SkAndroidCodec* SkCodecImageGenerator::sampledCodec() const {
+    if (!fTriedSampledCodec) {
+        fTriedSampledCodec = true;
+        if (fData) {
+            fSampledCodec = SkAndroidCodec::MakeFromData(fData);
+        }
+    }
+    return fSampledCodec.get();
+}
+
+int SkCodecImageGenerator::sampleSizeFor(const SkISize& size) const {
+    SkAndroidCodec* codec = this->sampledCodec();
+    if (!codec) {
+        return 0;
+    }
+    for (int sampleSize = 2; sampleSize <= kMaxSampleSize; sampleSize *= 2) {
+        if (codec->getSampledDimensions(sampleSize) == size) {
+            return sampleSize;
+        }
+    }
+    return 0;
+}
+
+SkISize SkCodecImageGenerator::onGetScaledDimensions(float desiredScale) const {
+    SkAndroidCodec* codec = this->sampledCodec();
+    if (!codec) {
+        return this->getInfo().dimensions();
+    }
+
+    int sampleSize = 1;
+    while (sampleSize * 2 <= kMaxSampleSize && desiredScale * (sampleSize * 2) <= 1) {
+        sampleSize *= 2;
+    }
+    if (sampleSize == 1) {
+        return this->getInfo().dimensions();
+    }
+
+    SkISize size = codec->getSampledDimensions(sampleSize);
+    if (SkPixmapPriv::ShouldSwapWidthHeight(fCodec->getOrigin())) {
+        size = SkISize::Make(size.height(), size.width());
+    }
+    return size;
+}
+
 bool SkCodecImageGenerator::onGetPixels(const SkImageInfo& requestInfo, void* requestPixels,
                                         size_t requestRowBytes, const Options&) {
     SkPixmap dst(requestInfo, requestPixels, requestRowBytes);
 
-    auto decode = [this](const SkPixmap& pm) {
-        SkCodec::Result result = fCodec->getPixels(pm);
+    auto succeeded = [](SkCodec::Result result) {
         switch (result) {
             case SkCodec::kSuccess:
             case SkCodec::kIncompleteInput:
@@ -63,6 +109,27 @@ bool SkCodecImageGenerator::onGetPixels(const SkImageInfo& requestInfo, void* re
         }
     };
 
+    if (requestInfo.dimensions() != this->getInfo().dimensions()) {
+        const SkISize size = SkPixmapPriv::ShouldSwapWidthHeight(fCodec->getOrigin())
+                ? SkISize::Make(requestInfo.height(), requestInfo.width())
+                : requestInfo.dimensions();
+        const int sampleSize = this->sampleSizeFor(size);
+        if (!sampleSize) {
+            return false;
+        }
+        auto decode = [this, sampleSize, &succeeded](const SkPixmap& pm) {
+            SkAndroidCodec::AndroidOptions options;
+            options.fSampleSize = sampleSize;
+            return succeeded(fSampledCodec->getAndroidPixels(pm.info(), pm.writable_addr(),
+                                                             pm.rowBytes(), &options));
+        };
+        return SkPixmapPriv::Orient(dst, fCodec->getOrigin(), decode);
+    }
+
+    auto decode = [this, &succeeded](const SkPixmap& pm) {
+        return succeeded(fCodec->getPixels(pm));
+    };
+
     return SkPixmapPriv::Orient(dst, fCodec->getOrigin(), decode);
 }
 
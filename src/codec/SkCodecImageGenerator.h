@@ -7,6 +7,7 @@
 #ifndef SkCodecImageGenerator_DEFINED
 #define SkCodecImageGenerator_DEFINED
 
+#include "include/codec/SkAndroidCodec.h"
 #include "include/codec/SkCodec.h"
 #include "include/core/SkData.h"
 #include "include/core/SkImageGenerator.h"
@@ -27,6 +28,8 @@ protected:
     bool onGetPixels(
         const SkImageInfo& info, void* pixels, size_t rowBytes, const Options& opts) override;
 
+    SkISize onGetScaledDimensions(float desiredScale) const override;
+
     bool onQueryYUVA8(
         SkYUVASizeInfo*, SkYUVAIndex[SkYUVAIndex::kIndexCount], SkYUVColorSpace*) const override;
 
@@ -39,9 +42,24 @@ private:
      */
     SkCodecImageGenerator(std::unique_ptr<SkCodec>, sk_sp<SkData>);
 
+    /*
+     * Returns a second codec for fData, made on first use, that decodes at reduced sizes by
+     * sampling. Returns nullptr if there is no fData.
+     */
+    SkAndroidCodec* sampledCodec() const;
+
+    /*
+     * Returns the sample size that decodes to size, which is in fCodec's (unoriented)
+     * coordinates, or 0 if there isn't one.
+     */
+    int sampleSizeFor(const SkISize& size) const;
+
     std::unique_ptr<SkCodec> fCodec;
     sk_sp<SkData> fData;
 
+    mutable std::unique_ptr<SkAndroidCodec> fSampledCodec;
+    mutable bool                            fTriedSampledCodec = false;
+
     typedef SkImageGenerator INHERITED;
 };
 #endif  // SkCodecImageGenerator_DEFINED
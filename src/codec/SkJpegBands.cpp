@@ -0,0 +1,229 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/codec/SkJpegBands.h"
+
+#include "include/private/SkTo.h"
+
+#include <algorithm>
+#include <cstring>
+
+// Marker codes, from ITU T.81 table B.1.
+static constexpr uint8_t kSOF0  = 0xC0;
+static constexpr uint8_t kSOF1  = 0xC1;
+static constexpr uint8_t kDHT   = 0xC4;
+static constexpr uint8_t kJPG   = 0xC8;
+static constexpr uint8_t kDAC   = 0xCC;
+static constexpr uint8_t kSOF15 = 0xCF;
+static constexpr uint8_t kRST0  = 0xD0;
+static constexpr uint8_t kRST7  = 0xD7;
+static constexpr uint8_t kSOI   = 0xD8;
+static constexpr uint8_t kEOI   = 0xD9;
+static constexpr uint8_t kSOS   = 0xDA;
+static constexpr uint8_t kDRI   = 0xDD;
+static constexpr uint8_t kTEM   = 0x01;
+
+static int read_u16(const uint8_t* data) {
+    return (data[0] << 8) | data[1];
+}
+
+static bool is_standalone_marker(uint8_t marker) {
+    return marker == kTEM || (marker >= kRST0 && marker <= kEOI);
+}
+
+static bool is_sof_marker(uint8_t marker) {
+    return marker >= kSOF0 && marker <= kSOF15 &&
+           marker != kDHT && marker != kJPG && marker != kDAC;
+}
+
+std::vector<SkJpegBand> SkJpegSplitIntoBands(const void* data, size_t size, int maxBands,
+                                             bool includeContext) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    std::vector<SkJpegBand> bands;
+    if (maxBands < 2 || size < 4 || bytes[0] != 0xFF || bytes[1] != kSOI) {
+        return bands;
+    }
+
+    // Walk the marker segments up to the start of the entropy coded data.
+    size_t sofHeightOffset = 0;
+    int width = 0, height = 0, components = 0, maxH = 0, maxV = 0;
+    int restartInterval = 0;
+    size_t scanStart = 0;
+    size_t pos = 2;
+    while (!scanStart) {
+        // Markers may be preceded by any number of 0xFF fill bytes.
+        if (pos >= size || bytes[pos] != 0xFF) {
+            return bands;
+        }
+        while (pos < size && bytes[pos] == 0xFF) {
+            pos++;
+        }
+        if (pos + 3 > size || is_standalone_marker(bytes[pos])) {
+            return bands;
+        }
+        const uint8_t marker = bytes[pos];
+        const uint8_t* segment = bytes + pos + 1;  // Starts with the segment's length.
+        const size_t length = read_u16(segment);
+        if (length < 2 || pos + 1 + length > size) {
+            return bands;
+        }
+
+        if (is_sof_marker(marker)) {
+            // Only sequential, Huffman coded frames can be split.
+            if ((marker != kSOF0 && marker != kSOF1) || sofHeightOffset || length < 8) {
+                return bands;
+            }
+            height = read_u16(segment + 3);
+            width = read_u16(segment + 5);
+            components = segment[7];
+            if (components < 1 || length != 8 + 3 * (size_t)components) {
+                return bands;
+            }
+            for (int i = 0; i < components; i++) {
+                const uint8_t sampling = segment[8 + 3 * i + 1];
+                maxH = std::max(maxH, sampling >> 4);
+                maxV = std::max(maxV, sampling & 0xF);
+            }
+            sofHeightOffset = pos + 1 + 3;
+        } else if (marker == kDRI) {
+            if (length != 4) {
+                return bands;
+            }
+            restartInterval = read_u16(segment + 2);
+        } else if (marker == kSOS) {
+            // The scan must include every component, or there will be more scans to decode.
+            if (!sofHeightOffset || length < 3 || segment[2] != components) {
+                return bands;
+            }
+            scanStart = pos + 1 + length;
+        }
+        pos += 1 + length;
+    }
+
+    // A frame height of zero means the height comes later, in a DNL marker.
+    if (width <= 0 || height <= 0 || restartInterval <= 0 ||
+            maxH < 1 || maxH > 4 || maxV < 1 || maxV > 4) {
+        return bands;
+    }
+
+    // A scan of a single component is not interleaved, so each MCU is a lone block.
+    const int mcuWidth  = components == 1 ? 8 : 8 * maxH;
+    const int mcuHeight = components == 1 ? 8 : 8 * maxV;
+    const int mcusPerRow = (width + mcuWidth - 1) / mcuWidth;
+    const int mcuRows = (height + mcuHeight - 1) / mcuHeight;
+
+    // Find every restart marker. In entropy coded data, 0xFF is always followed by a stuffed
+    // zero, another 0xFF fill byte, or a marker.
+    std::vector<size_t> restarts;
+    size_t scanEnd = 0;
+    for (size_t i = scanStart; i + 1 < size; i++) {
+        if (bytes[i] != 0xFF) {
+            continue;
+        }
+        const uint8_t next = bytes[i + 1];
+        if (next == 0xFF) {
+            continue;
+        }
+        if (next == 0x00) {
+            i++;
+            continue;
+        }
+        if (next >= kRST0 && next <= kRST7) {
+            if (next - kRST0 != (int)(restarts.size() % 8)) {
+                return bands;
+            }
+            restarts.push_back(i);
+            i++;
+            continue;
+        }
+        if (next == kEOI) {
+            scanEnd = i;
+            break;
+        }
+        // Another scan, a DNL marker, or something else we can't split around.
+        return bands;
+    }
+    const int64_t mcuCount = (int64_t)mcusPerRow * mcuRows;
+    if (!scanEnd || (int64_t)restarts.size() != (mcuCount - 1) / restartInterval) {
+        return bands;
+    }
+
+    // The places a band can start: the start of the scan, and any restart marker that falls at
+    // the start of an MCU row.
+    struct Boundary {
+        int    fMCURow;
+        size_t fOffset;   // Where the entropy coded data for fMCURow starts.
+        int    fRestart;  // Index of the marker just before fOffset, or -1 at the start.
+    };
+    std::vector<Boundary> boundaries = {{0, scanStart, -1}};
+    for (int r = 0; r < SkToInt(restarts.size()); r++) {
+        const int64_t mcu = (int64_t)(r + 1) * restartInterval;
+        if (mcu % mcusPerRow == 0) {
+            boundaries.push_back({SkToInt(mcu / mcusPerRow), restarts[r] + 2, r});
+        }
+    }
+    // The end of the scan, as if it were the start of one more row.
+    boundaries.push_back({mcuRows, scanEnd + 2, SkToInt(restarts.size())});
+    auto dataEnd = [&](const Boundary& boundary) {
+        return boundary.fOffset - 2;  // Just before the marker.
+    };
+
+    // Pick the boundaries that start each band, as evenly spaced as they allow.
+    const int rowsPerBand = std::max(1, (mcuRows + maxBands - 1) / maxBands);
+    std::vector<size_t> starts = {0};
+    for (size_t i = 1; i + 1 < boundaries.size(); i++) {
+        if (boundaries[i].fMCURow - boundaries[starts.back()].fMCURow >= rowsPerBand) {
+            starts.push_back(i);
+        }
+    }
+    if (starts.size() < 2) {
+        return bands;
+    }
+    starts.push_back(boundaries.size() - 1);
+
+    const size_t headerSize = scanStart;
+    for (size_t b = 0; b + 1 < starts.size(); b++) {
+        // Output rows come from [first, end), but we may decode from [decodeFirst, decodeEnd).
+        size_t first = starts[b], end = starts[b + 1];
+        size_t decodeFirst = first, decodeEnd = end;
+        if (includeContext) {
+            while (decodeFirst > 0 &&
+                   boundaries[decodeFirst].fMCURow > boundaries[first].fMCURow - 1) {
+                decodeFirst--;
+            }
+            while (decodeEnd + 1 < boundaries.size() &&
+                   boundaries[decodeEnd].fMCURow < boundaries[end].fMCURow + 1) {
+                decodeEnd++;
+            }
+        }
+
+        const int firstRow = boundaries[first].fMCURow * mcuHeight;
+        const int endRow = std::min(boundaries[end].fMCURow * mcuHeight, height);
+        const int decodeFirstRow = boundaries[decodeFirst].fMCURow * mcuHeight;
+        const int decodeHeight =
+                std::min(boundaries[decodeEnd].fMCURow * mcuHeight, height) - decodeFirstRow;
+        const size_t entropyStart = boundaries[decodeFirst].fOffset;
+        const size_t entropyEnd = dataEnd(boundaries[decodeEnd]);
+
+        sk_sp<SkData> band = SkData::MakeUninitialized(headerSize + entropyEnd - entropyStart + 2);
+        uint8_t* dst = static_cast<uint8_t*>(band->writable_data());
+        memcpy(dst, bytes, headerSize);
+        dst[sofHeightOffset]     = SkToU8(decodeHeight >> 8);
+        dst[sofHeightOffset + 1] = SkToU8(decodeHeight & 0xFF);
+        memcpy(dst + headerSize, bytes + entropyStart, entropyEnd - entropyStart);
+        // The decoder expects the restart markers in each band to count up from RST0.
+        const int firstRestart = boundaries[decodeFirst].fRestart;
+        for (int r = firstRestart + 1; r < boundaries[decodeEnd].fRestart; r++) {
+            dst[headerSize + restarts[r] - entropyStart + 1] =
+                    SkToU8(kRST0 + (r - firstRestart - 1) % 8);
+        }
+        dst[band->size() - 2] = 0xFF;
+        dst[band->size() - 1] = kEOI;
+        bands.push_back({firstRow, endRow - firstRow, firstRow - decodeFirstRow, std::move(band)});
+    }
+    return bands;
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkJpegBands_DEFINED
+#define SkJpegBands_DEFINED
+
+#include "include/core/SkData.h"
+#include "include/core/SkRefCnt.h"
+
+#include <vector>
+
+/*
+ * A horizontal band of a JPEG, rewritten as a complete JPEG of its own.
+ */
+struct SkJpegBand {
+    // The rows of the image this band is responsible for.
+    int           fFirstRow;
+    int           fHeight;
+
+    // The number of rows fData decodes before fFirstRow, which belong to the band above.
+    int           fSkipRows;
+
+    // The original headers, with the frame height changed to match, followed by the entropy
+    // coded data for this band's MCU rows and an EOI marker. This may decode to more than
+    // fSkipRows + fHeight rows; the rest belong to the band below.
+    sk_sp<SkData> fData;
+};
+
+/*
+ * Splits a sequential JPEG into at most maxBands bands that can be decoded independently.
+ *
+ * Bands start at restart markers, which reset the entropy decoder, so this only succeeds for
+ * a baseline or extended sequential JPEG with a single scan, restart markers that fall at the
+ * start of MCU rows, and complete data. Otherwise (or if it would make fewer than two bands)
+ * this returns an empty vector.
+ *
+ * libjpeg's fancy upsampling blends subsampled chroma with the neighbouring rows, so to match
+ * a decode of the whole image, set includeContext to have each band also decode at least one
+ * MCU row above and below its own rows. Raw (YUV) output doesn't need it.
+ */
+std::vector<SkJpegBand> SkJpegSplitIntoBands(const void* data, size_t size, int maxBands,
+                                             bool includeContext);
+
+#endif
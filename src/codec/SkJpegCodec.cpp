@@ -15,8 +15,13 @@
 #include "include/private/SkTo.h"
 #include "src/codec/SkCodecPriv.h"
 #include "src/codec/SkJpegDecoderMgr.h"
+#include "src/core/SkAutoMalloc.h"
+#include "src/core/SkMakeUnique.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/pdf/SkJpegInfo.h"
 
+#include <atomic>
+
 // stdio is needed for libjpeg-turbo
 #include <stdio.h>
 #include "src/codec/SkJpegUtility.h"
@@ -306,6 +311,9 @@ SkJpegCodec::SkJpegCodec(SkEncodedInfo&& info, std::unique_ptr<SkStream> stream,
     , fSwizzleSrcRow(nullptr)
     , fColorXformSrcRow(nullptr)
     , fSwizzlerSubset(SkIRect::MakeEmpty())
+    , fIncrementalDst(nullptr)
+    , fIncrementalRowBytes(0)
+    , fOutputScan(0)
 {}
 
 /*
@@ -381,6 +389,8 @@ bool SkJpegCodec::onRewind() {
     fSwizzleSrcRow = nullptr;
     fColorXformSrcRow = nullptr;
     fStorage.reset();
+    fIncrementalDst = nullptr;
+    fOutputScan = 0;
 
     return true;
 }
@@ -572,6 +582,44 @@ static inline bool needs_swizzler_to_convert_from_cmyk(J_COLOR_SPACE jpegColorTy
 /*
  * Performs the jpeg decode
  */
+// The most bands to split an image into when decoding with an executor.
+static constexpr int kMaxBands = 16;
+
+std::vector<SkJpegBand> SkJpegCodec::splitIntoBands(bool includeContext) {
+    SkStream* stream = this->stream();
+    const void* data = stream->getMemoryBase();
+    if (!data || !stream->hasLength()) {
+        return std::vector<SkJpegBand>();
+    }
+    return SkJpegSplitIntoBands(data, stream->getLength(), kMaxBands, includeContext);
+}
+
+std::unique_ptr<SkCodec> SkJpegCodec::makeBandCodec(const SkJpegBand& band) const {
+    // Bands carry the original headers, so they will find the same embedded profile, if any.
+    // Pass along ours in case it came from somewhere else.
+    const skcms_ICCProfile* profile = this->getEncodedInfo().profile();
+    Result result;
+    return SkJpegCodec::MakeFromStream(skstd::make_unique<SkMemoryStream>(band.fData), &result,
+            profile ? SkEncodedInfo::ICCProfile::Make(*profile) : nullptr);
+}
+
+static bool decode_band(SkCodec* codec, const SkImageInfo& dstInfo, const SkJpegBand& band,
+                        void* dst, size_t rowBytes) {
+    const SkImageInfo bandInfo = dstInfo.makeWH(dstInfo.width(), codec->dimensions().height());
+    if (SkCodec::kSuccess != codec->startScanlineDecode(bandInfo)) {
+        return false;
+    }
+    if (band.fSkipRows > 0) {
+        // Decode, rather than skip, the rows above, so that upsampling sees them.
+        const size_t skipRowBytes = bandInfo.minRowBytes();
+        SkAutoMalloc skipped(band.fSkipRows * skipRowBytes);
+        if (band.fSkipRows != codec->getScanlines(skipped.get(), band.fSkipRows, skipRowBytes)) {
+            return false;
+        }
+    }
+    return band.fHeight == codec->getScanlines(dst, band.fHeight, rowBytes);
+}
+
 SkCodec::Result SkJpegCodec::onGetPixels(const SkImageInfo& dstInfo,
                                          void* dst, size_t dstRowBytes,
                                          const Options& options,
@@ -581,6 +629,24 @@ SkCodec::Result SkJpegCodec::onGetPixels(const SkImageInfo& dstInfo,
         return kUnimplemented;
     }
 
+    if (options.fExecutor && dstInfo.dimensions() == this->dimensions()) {
+        std::vector<SkJpegBand> bands = this->splitIntoBands(true);
+        if (!bands.empty()) {
+            std::atomic<bool> failed{false};
+            SkTaskGroup(*options.fExecutor).batch(SkToInt(bands.size()), [&](int i) {
+                std::unique_ptr<SkCodec> codec = this->makeBandCodec(bands[i]);
+                void* bandDst = SkTAddOffset<void>(dst, bands[i].fFirstRow * dstRowBytes);
+                if (!codec || !decode_band(codec.get(), dstInfo, bands[i], bandDst, dstRowBytes)) {
+                    failed = true;
+                }
+            });
+            if (!failed) {
+                return kSuccess;
+            }
+            // Otherwise decode serially, overwriting whatever the bands wrote.
+        }
+    }
+
     // Get a pointer to the decompress info since we will use it quite frequently
     jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
 
@@ -784,6 +850,122 @@ bool SkJpegCodec::onSkipScanlines(int count) {
     return (uint32_t) count == jpeg_skip_scanlines(fDecoderMgr->dinfo(), count);
 }
 
+SkCodec::Result SkJpegCodec::onStartIncrementalDecode(const SkImageInfo& dstInfo, void* dst,
+        size_t rowBytes, const Options& options) {
+    jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
+
+    // Sequential JPEGs (and subsets, which need jpeg_crop_scanline) use the scanline decoder.
+    if (options.fSubset || !jpeg_has_multiple_scans(dinfo)) {
+        return kUnimplemented;
+    }
+
+    // Set the jump location for libjpeg errors
+    skjpeg_error_mgr::AutoPushJmpBuf jmp(fDecoderMgr->errorMgr());
+    if (setjmp(jmp)) {
+        return fDecoderMgr->returnFailure("setjmp", kInvalidInput);
+    }
+
+    // In buffered-image mode, libjpeg keeps the coefficients of every scan that has arrived, and
+    // we choose when to decode them into pixels. jpeg_start_decompress() does not read any
+    // further, so it can't run out of data.
+    dinfo->buffered_image = TRUE;
+    fDecoderMgr->sourceMgr()->setSuspendable();
+    if (!jpeg_start_decompress(dinfo)) {
+        return fDecoderMgr->returnFailure("startDecompress", kInvalidInput);
+    }
+
+    if (needs_swizzler_to_convert_from_cmyk(dinfo->out_color_space,
+                                            this->getEncodedInfo().profile(), this->colorXform())) {
+        this->initializeSwizzler(dstInfo, options, true);
+    }
+    this->allocateStorage(dstInfo);
+
+    fIncrementalDst = dst;
+    fIncrementalRowBytes = rowBytes;
+    fOutputScan = 0;
+    return kSuccess;
+}
+
+/*
+ * Reads every row of the current output pass into fIncrementalDst, keeping only the rows the
+ * sampler wants, if SkSampledCodec set one up. Returns the number of rows read.
+ */
+int SkJpegCodec::readIncrementalRows() {
+    const int height = this->dstInfo().height();
+    const int sampleY = fSwizzler ? fSwizzler->sampleY() : 1;
+    if (1 == sampleY) {
+        return this->readRows(this->dstInfo(), fIncrementalDst, fIncrementalRowBytes, height,
+                              this->options());
+    }
+
+    // Every row has to be read to get to the next, so read the ones we don't want into scratch.
+    const int dstHeight = get_scaled_dimension(height, sampleY);
+    for (int y = 0; y < height; y++) {
+        void* dst;
+        if (is_coord_necessary(y, sampleY, dstHeight)) {
+            dst = SkTAddOffset<void>(fIncrementalDst,
+                                     get_dst_coord(y, sampleY) * fIncrementalRowBytes);
+        } else {
+            if (!fIncrementalSkippedRow.get()) {
+                fIncrementalSkippedRow.reset(fIncrementalRowBytes);
+            }
+            dst = fIncrementalSkippedRow.get();
+        }
+        if (1 != this->readRows(this->dstInfo(), dst, fIncrementalRowBytes, 1, this->options())) {
+            return y;
+        }
+    }
+    return height;
+}
+
+SkCodec::Result SkJpegCodec::onIncrementalDecode(int* rowsDecoded) {
+    jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
+    skjpeg_source_mgr* src = fDecoderMgr->sourceMgr();
+
+    // Once a scan has been decoded, every row has been written.
+    auto incomplete = [this, rowsDecoded](Result result) {
+        if (rowsDecoded) {
+            const int sampleY = fSwizzler ? fSwizzler->sampleY() : 1;
+            *rowsDecoded = fOutputScan > 0
+                    ? get_scaled_dimension(this->dstInfo().height(), sampleY) : 0;
+        }
+        return result;
+    };
+
+    // Set the jump location for libjpeg errors
+    skjpeg_error_mgr::AutoPushJmpBuf jmp(fDecoderMgr->errorMgr());
+    if (setjmp(jmp)) {
+        SkCodecPrintf("setjmp: Error from libjpeg\n");
+        return incomplete(kErrorInInput);
+    }
+
+    // Take in whatever has arrived, without decoding any of it yet.
+    while (!jpeg_input_complete(dinfo)) {
+        if (JPEG_SUSPENDED == jpeg_consume_input(dinfo) && !src->shouldRetry()) {
+            break;
+        }
+    }
+
+    // Decoding the scan that is still arriving would have to wait for the rest of it (and block
+    // smoothing looks ahead, so would the end of one that has just arrived), so stick to the ones
+    // before it. Do nothing until there is a scan newer than the last one we decoded.
+    const bool inputComplete = jpeg_input_complete(dinfo);
+    const int scan = inputComplete ? dinfo->input_scan_number : dinfo->input_scan_number - 1;
+    if (scan > fOutputScan) {
+        jpeg_start_output(dinfo, scan);
+        if (this->readIncrementalRows() < this->dstInfo().height() ||
+                !jpeg_finish_output(dinfo)) {
+            return incomplete(kErrorInInput);
+        }
+        fOutputScan = scan;
+    }
+
+    if (inputComplete && fOutputScan == dinfo->input_scan_number) {
+        return kSuccess;
+    }
+    return incomplete(kIncompleteInput);
+}
+
 static bool is_yuv_supported(jpeg_decompress_struct* dinfo) {
     // Scaling is not supported in raw data mode.
     SkASSERT(dinfo->scale_num == dinfo->scale_denom);
@@ -864,7 +1046,8 @@ bool SkJpegCodec::onQueryYUV8(SkYUVASizeInfo* sizeInfo, SkYUVColorSpace* colorSp
 }
 
 SkCodec::Result SkJpegCodec::onGetYUV8Planes(const SkYUVASizeInfo& sizeInfo,
-                                             void* planes[SkYUVASizeInfo::kMaxCount]) {
+                                             void* planes[SkYUVASizeInfo::kMaxCount],
+                                             SkExecutor* executor) {
     SkYUVASizeInfo defaultInfo;
 
     // This will check is_yuv_supported(), so we don't need to here.
@@ -879,6 +1062,39 @@ SkCodec::Result SkJpegCodec::onGetYUV8Planes(const SkYUVASizeInfo& sizeInfo,
         return fDecoderMgr->returnFailure("onGetYUV8Planes", kInvalidInput);
     }
 
+    // Raw data isn't upsampled, so bands don't need any context rows.
+    std::vector<SkJpegBand> bands;
+    if (executor) {
+        bands = this->splitIntoBands(false);
+    }
+    if (!bands.empty()) {
+        const jpeg_component_info* compInfo = fDecoderMgr->dinfo()->comp_info;
+        const int maxV = fDecoderMgr->dinfo()->max_v_samp_factor;
+        std::atomic<bool> failed{false};
+        SkTaskGroup(*executor).batch(SkToInt(bands.size()), [&](int i) {
+            std::unique_ptr<SkCodec> codec = this->makeBandCodec(bands[i]);
+            SkYUVASizeInfo bandSizeInfo;
+            if (!codec || !codec->queryYUV8(&bandSizeInfo, nullptr)) {
+                failed = true;
+                return;
+            }
+            // Bands start on MCU rows, so every plane starts on a whole row.
+            void* bandPlanes[SkYUVASizeInfo::kMaxCount] = { nullptr, nullptr, nullptr, nullptr };
+            for (int p = 0; p < 3; ++p) {
+                bandSizeInfo.fWidthBytes[p] = sizeInfo.fWidthBytes[p];
+                const int firstRow = bands[i].fFirstRow * compInfo[p].v_samp_factor / maxV;
+                bandPlanes[p] = SkTAddOffset<void>(planes[p], firstRow * sizeInfo.fWidthBytes[p]);
+            }
+            if (kSuccess != codec->getYUV8Planes(bandSizeInfo, bandPlanes)) {
+                failed = true;
+            }
+        });
+        if (!failed) {
+            return kSuccess;
+        }
+        // Otherwise decode serially, overwriting whatever the bands wrote.
+    }
+
     // Set the jump location for libjpeg errors
     skjpeg_error_mgr::AutoPushJmpBuf jmp(fDecoderMgr->errorMgr());
     if (setjmp(jmp)) {
@@ -12,8 +12,11 @@
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkStream.h"
 #include "include/private/SkTemplates.h"
+#include "src/codec/SkJpegBands.h"
 #include "src/codec/SkSwizzler.h"
 
+#include <vector>
+
 class JpegDecoderMgr;
 
 /*
@@ -47,7 +50,8 @@ protected:
     bool onQueryYUV8(SkYUVASizeInfo* sizeInfo, SkYUVColorSpace* colorSpace) const override;
 
     Result onGetYUV8Planes(const SkYUVASizeInfo& sizeInfo,
-                           void* planes[SkYUVASizeInfo::kMaxCount]) override;
+                           void* planes[SkYUVASizeInfo::kMaxCount],
+                           SkExecutor* executor) override;
 
     SkEncodedImageFormat onGetEncodedFormat() const override {
         return SkEncodedImageFormat::kJPEG;
@@ -106,6 +110,17 @@ private:
 
     void initializeSwizzler(const SkImageInfo& dstInfo, const Options& options,
                             bool needsCMYKToRGB);
+
+    /*
+     * If the encoded data is in memory, splits it at restart markers into bands that can be
+     * decoded in parallel (see SkJpegSplitIntoBands). Returns an empty vector if it can't.
+     */
+    std::vector<SkJpegBand> splitIntoBands(bool includeContext);
+
+    /*
+     * Makes a codec for a band that decodes the same way this one does.
+     */
+    std::unique_ptr<SkCodec> makeBandCodec(const SkJpegBand&) const;
     void allocateStorage(const SkImageInfo& dstInfo);
     int readRows(const SkImageInfo& dstInfo, void* dst, size_t rowBytes, int count, const Options&);
 
@@ -118,6 +133,16 @@ private:
     int onGetScanlines(void* dst, int count, size_t rowBytes) override;
     bool onSkipScanlines(int count) override;
 
+    /*
+     * Incremental decoding of progressive JPEGs. Each call takes in whatever data has arrived and,
+     * if another scan is complete, decodes the coefficients so far into the whole image, refining
+     * the previous output. Sequential JPEGs decode incrementally with the scanline decoder.
+     */
+    Result onStartIncrementalDecode(const SkImageInfo& dstInfo, void* dst, size_t rowBytes,
+            const Options&) override;
+    Result onIncrementalDecode(int* rowsDecoded) override;
+    int readIncrementalRows();
+
     std::unique_ptr<JpegDecoderMgr>    fDecoderMgr;
 
     // We will save the state of the decompress struct after reading the header.
@@ -136,6 +161,12 @@ private:
 
     std::unique_ptr<SkSwizzler>        fSwizzler;
 
+    // State for incremental decoding. fOutputScan is the last scan decoded into fIncrementalDst.
+    void*                              fIncrementalDst;
+    size_t                             fIncrementalRowBytes;
+    SkAutoTMalloc<uint8_t>             fIncrementalSkippedRow;
+    int                                fOutputScan;
+
     friend class SkRawCodec;
 
     typedef SkCodec INHERITED;
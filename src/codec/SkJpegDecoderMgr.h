@@ -63,6 +63,11 @@ public:
      */
     jpeg_decompress_struct* dinfo() { return &fDInfo; }
 
+    /*
+     * Get the skjpeg_source_mgr, to control how it handles running out of data
+     */
+    skjpeg_source_mgr* sourceMgr() { return &fSrcMgr; }
+
 private:
 
     jpeg_decompress_struct fDInfo;
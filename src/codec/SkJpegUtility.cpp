@@ -30,8 +30,51 @@ void skjpeg_err_exit(j_common_ptr dinfo) {
  */
 static void sk_init_buffered_source(j_decompress_ptr dinfo) {
     skjpeg_source_mgr* src = (skjpeg_source_mgr*) dinfo->src;
-    src->next_input_byte = (const JOCTET*) src->fBuffer;
+    src->next_input_byte = (const JOCTET*) src->fBuffer.get();
     src->bytes_in_buffer = 0;
+    src->fBufferEnd = 0;
+}
+
+/*
+ * Fill the input buffer of a suspendable source.
+ *
+ * When libjpeg suspends, it backs up to next_input_byte (typically the start of the current MCU)
+ * and rescans from there once it resumes. It only updates next_input_byte between MCUs, so it may
+ * already have read past it, and after returning true there would be no telling where to back up
+ * to. So this always suspends, after reading in whatever has arrived behind the data libjpeg still
+ * needs, and leaves it to the caller to resume.
+ */
+static boolean sk_fill_suspendable_input_buffer(skjpeg_source_mgr* src) {
+    src->fRetry = false;
+    if (src->fBytesToSkip > 0) {
+        src->fBytesToSkip -= src->fStream->skip(src->fBytesToSkip);
+        if (src->fBytesToSkip > 0) {
+            return false;
+        }
+    }
+
+    uint8_t* buffer = src->fBuffer.get();
+    const size_t kept = src->next_input_byte ? buffer + src->fBufferEnd - src->next_input_byte : 0;
+    if (0 == kept || src->fBufferEnd == src->fBufferSize) {
+        // Make room by moving the data libjpeg still needs to the front, or growing the buffer if
+        // it is all needed.
+        if (kept == src->fBufferSize) {
+            src->fBufferSize *= 2;
+            src->fBuffer.realloc(src->fBufferSize);
+            buffer = src->fBuffer.get();
+        } else if (kept > 0) {
+            memmove(buffer, src->next_input_byte, kept);
+        }
+        src->next_input_byte = (const JOCTET*) buffer;
+        src->fBufferEnd = kept;
+    }
+
+    size_t bytes = src->fStream->read(buffer + src->fBufferEnd,
+                                      src->fBufferSize - src->fBufferEnd);
+    src->fBufferEnd += bytes;
+    src->bytes_in_buffer = buffer + src->fBufferEnd - src->next_input_byte;
+    src->fRetry = bytes > 0;
+    return false;
 }
 
 /*
@@ -39,18 +82,24 @@ static void sk_init_buffered_source(j_decompress_ptr dinfo) {
  */
 static boolean sk_fill_buffered_input_buffer(j_decompress_ptr dinfo) {
     skjpeg_source_mgr* src = (skjpeg_source_mgr*) dinfo->src;
-    size_t bytes = src->fStream->read(src->fBuffer, skjpeg_source_mgr::kBufferSize);
+    if (src->fSuspendable) {
+        return sk_fill_suspendable_input_buffer(src);
+    }
+
+    size_t bytes = src->fStream->read(src->fBuffer.get(), src->fBufferSize);
 
     // libjpeg is still happy with a less than full read, as long as the result is non-zero
     if (bytes == 0) {
         // Let libjpeg know that the buffer needs to be refilled
         src->next_input_byte = nullptr;
         src->bytes_in_buffer = 0;
+        src->fBufferEnd = 0;
         return false;
     }
 
-    src->next_input_byte = (const JOCTET*) src->fBuffer;
+    src->next_input_byte = (const JOCTET*) src->fBuffer.get();
     src->bytes_in_buffer = bytes;
+    src->fBufferEnd = bytes;
     return true;
 }
 
@@ -63,14 +112,20 @@ static void sk_skip_buffered_input_data(j_decompress_ptr dinfo, long numBytes) {
 
     if (bytes > src->bytes_in_buffer) {
         size_t bytesToSkip = bytes - src->bytes_in_buffer;
-        if (bytesToSkip != src->fStream->skip(bytesToSkip)) {
-            SkCodecPrintf("Failure to skip.\n");
-            dinfo->err->error_exit((j_common_ptr) dinfo);
-            return;
+        size_t bytesSkipped = src->fStream->skip(bytesToSkip);
+        if (bytesToSkip != bytesSkipped) {
+            if (!src->fSuspendable) {
+                SkCodecPrintf("Failure to skip.\n");
+                dinfo->err->error_exit((j_common_ptr) dinfo);
+                return;
+            }
+            // libjpeg can't suspend here, so finish skipping on the next fill.
+            src->fBytesToSkip = bytesToSkip - bytesSkipped;
         }
 
-        src->next_input_byte = (const JOCTET*) src->fBuffer;
+        src->next_input_byte = (const JOCTET*) src->fBuffer.get();
         src->bytes_in_buffer = 0;
+        src->fBufferEnd = 0;
     } else {
         src->next_input_byte += numBytes;
         src->bytes_in_buffer -= numBytes;
@@ -123,6 +178,11 @@ static boolean sk_fill_mem_input_buffer (j_decompress_ptr cinfo) {
  */
 skjpeg_source_mgr::skjpeg_source_mgr(SkStream* stream)
     : fStream(stream)
+    , fBufferSize(0)
+    , fBufferEnd(0)
+    , fSuspendable(false)
+    , fRetry(false)
+    , fBytesToSkip(0)
 {
     if (stream->hasLength() && stream->getMemoryBase()) {
         init_source = sk_init_mem_source;
@@ -133,6 +193,8 @@ skjpeg_source_mgr::skjpeg_source_mgr(SkStream* stream)
         bytes_in_buffer = static_cast<size_t>(stream->getLength());
         next_input_byte = static_cast<const JOCTET*>(stream->getMemoryBase());
     } else {
+        fBuffer.reset(kBufferSize);
+        fBufferSize = kBufferSize;
         init_source = sk_init_buffered_source;
         fill_input_buffer = sk_fill_buffered_input_buffer;
         skip_input_data = sk_skip_buffered_input_data;
@@ -10,6 +10,7 @@
 #define SkJpegUtility_codec_DEFINED
 
 #include "include/core/SkStream.h"
+#include "include/private/SkTemplates.h"
 #include "src/codec/SkJpegPriv.h"
 
 #include <setjmp.h>
@@ -32,13 +33,37 @@ void skjpeg_err_exit(j_common_ptr cinfo);
 struct skjpeg_source_mgr : jpeg_source_mgr {
     skjpeg_source_mgr(SkStream* stream);
 
+    /*
+     * Lets libjpeg suspend when the stream runs out of data, and pick up where it left off once
+     * more has arrived, rather than treating the end of the data as the end of the image. This
+     * only affects sources that are not in memory.
+     */
+    void setSuspendable() { fSuspendable = true; }
+
+    /*
+     * A suspendable source suspends every time libjpeg reaches the end of its buffer. This is true
+     * if it read more data when it last did, so libjpeg should be called again straight away,
+     * rather than waiting for more to arrive.
+     */
+    bool shouldRetry() const { return fRetry; }
+
     SkStream* fStream; // unowned
     enum {
         // TODO (msarett): Experiment with different buffer sizes.
         // This size was chosen because it matches SkImageDecoder.
         kBufferSize = 1024
     };
-    uint8_t fBuffer[kBufferSize];
+    SkAutoTMalloc<uint8_t> fBuffer;
+    size_t                 fBufferSize;
+
+    // The end of the data read into fBuffer.
+    size_t                 fBufferEnd;
+
+    bool                   fSuspendable;
+    bool                   fRetry;
+
+    // Bytes that libjpeg asked to skip that had not arrived yet.
+    size_t                 fBytesToSkip;
 };
 
 #endif
@@ -20,6 +20,7 @@
 #include "src/codec/SkPngPriv.h"
 #include "src/codec/SkSwizzler.h"
 #include "src/core/SkOpts.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkUtils.h"
 
 #include "png.h"
@@ -135,6 +136,19 @@ static inline bool is_chunk(const png_byte* chunk, const char* tag) {
 
 static inline bool process_data(png_structp png_ptr, png_infop info_ptr,
         SkStream* stream, void* buffer, size_t bufferSize, size_t length) {
+    // If the stream is backed by memory, hand libpng the data in place instead of copying it
+    // through buffer. libpng does not write to its input.
+    const uint8_t* base = static_cast<const uint8_t*>(stream->getMemoryBase());
+    if (base && stream->hasPosition() && stream->hasLength()) {
+        const size_t position = stream->getPosition();
+        const size_t available = stream->getLength() - std::min(position, stream->getLength());
+        const size_t bytesToProcess = std::min(available, length);
+        stream->skip(bytesToProcess);
+        png_process_data(png_ptr, info_ptr, const_cast<png_bytep>(base + position),
+                         bytesToProcess);
+        return bytesToProcess == length;
+    }
+
     while (length > 0) {
         const size_t bytesToProcess = std::min(bufferSize, length);
         const size_t bytesRead = stream->read(buffer, bytesToProcess);
@@ -431,6 +445,7 @@ std::unique_ptr<SkEncodedInfo::ICCProfile> read_color_profile(png_structp png_pt
 }
 
 void SkPngCodec::allocateStorage(const SkImageInfo& dstInfo) {
+    fColorXformSrcRowBytes = 0;
     switch (fXformMode) {
         case kSwizzleOnly_XformMode:
             break;
@@ -447,6 +462,7 @@ void SkPngCodec::allocateStorage(const SkImageInfo& dstInfo) {
             const size_t colorXformBytes = dstInfo.width() * bytesPerPixel;
             fStorage.reset(colorXformBytes);
             fColorXformSrcRow = fStorage.get();
+            fColorXformSrcRowBytes = colorXformBytes;
             break;
         }
     }
@@ -468,20 +484,47 @@ static skcms_PixelFormat png_select_xform_format(const SkEncodedInfo& info) {
 }
 
 void SkPngCodec::applyXformRow(void* dst, const void* src) {
-    switch (fXformMode) {
-        case kSwizzleOnly_XformMode:
-            fSwizzler->swizzle(dst, (const uint8_t*) src);
-            break;
-        case kColorOnly_XformMode:
-            this->applyColorXform(dst, src, fXformWidth);
-            break;
-        case kSwizzleColor_XformMode:
-            fSwizzler->swizzle(fColorXformSrcRow, (const uint8_t*) src);
-            this->applyColorXform(dst, fColorXformSrcRow, fXformWidth);
-            break;
+    this->applyXformRows(dst, 0, src, 0, 1, fColorXformSrcRow);
+}
+
+void SkPngCodec::applyXformRows(void* dst, size_t dstRowBytes, const void* src,
+                                size_t srcRowBytes, int count, void* colorXformSrcRow) {
+    for (int i = 0; i < count; i++) {
+        switch (fXformMode) {
+            case kSwizzleOnly_XformMode:
+                fSwizzler->swizzle(dst, (const uint8_t*) src);
+                break;
+            case kColorOnly_XformMode:
+                this->applyColorXform(dst, src, fXformWidth);
+                break;
+            case kSwizzleColor_XformMode:
+                fSwizzler->swizzle(colorXformSrcRow, (const uint8_t*) src);
+                this->applyColorXform(dst, colorXformSrcRow, fXformWidth);
+                break;
+        }
+        dst = SkTAddOffset<void>(dst, dstRowBytes);
+        src = SkTAddOffset<const void>(src, srcRowBytes);
     }
 }
 
+void SkPngCodec::applyXformRows(void* dst, size_t dstRowBytes, const void* src,
+                                size_t srcRowBytes, int count) {
+    const int bandCount = (count + kRowsPerBand - 1) / kRowsPerBand;
+    if (!fExecutor || bandCount < 2) {
+        this->applyXformRows(dst, dstRowBytes, src, srcRowBytes, count, fColorXformSrcRow);
+        return;
+    }
+
+    SkAutoTMalloc<uint8_t> colorXformSrcRows(bandCount * fColorXformSrcRowBytes);
+    SkTaskGroup(*fExecutor).batch(bandCount, [&](int band) {
+        const int firstRow = band * kRowsPerBand;
+        this->applyXformRows(SkTAddOffset<void>(dst, firstRow * dstRowBytes), dstRowBytes,
+                             SkTAddOffset<const void>(src, firstRow * srcRowBytes), srcRowBytes,
+                             SkTMin(kRowsPerBand, count - firstRow),
+                             colorXformSrcRows.get() + band * fColorXformSrcRowBytes);
+    });
+}
+
 static SkCodec::Result log_and_return_error(bool success) {
     if (success) return SkCodec::kIncompleteInput;
 #ifdef SK_BUILD_FOR_ANDROID_FRAMEWORK
@@ -500,6 +543,9 @@ public:
         , fRowBytes(0)
         , fFirstRow(0)
         , fLastRow(0)
+        , fBandSrcRowBytes(0)
+        , fBandIndex(0)
+        , fBandRowCount(0)
     {}
 
     static void AllRowsCallback(png_structp png_ptr, png_bytep row, png_uint_32 rowNum, int /*pass*/) {
@@ -510,6 +556,11 @@ public:
         GetDecoder(png_ptr)->rowCallback(row, rowNum);
     }
 
+    static void BandedRowsCallback(png_structp png_ptr, png_bytep row, png_uint_32 rowNum,
+                                   int /*pass*/) {
+        GetDecoder(png_ptr)->bandedRowsCallback(row, rowNum);
+    }
+
 private:
     int                         fRowsWrittenToOutput;
     void*                       fDst;
@@ -520,6 +571,15 @@ private:
     int                         fLastRow;
     int                         fRowsNeeded;
 
+    // Variables for decoding all rows with an executor. libpng decompresses rows on this
+    // thread into a ring of kBandCount bands, and each full band is xformed on the executor.
+    static constexpr int        kBandCount = 8;
+    std::unique_ptr<SkTaskGroup> fBandTasks;
+    SkAutoTMalloc<uint8_t>      fBandStorage;
+    size_t                      fBandSrcRowBytes;
+    int                         fBandIndex;
+    int                         fBandRowCount;
+
     typedef SkPngCodec INHERITED;
 
     static SkPngNormalDecoder* GetDecoder(png_structp png_ptr) {
@@ -528,7 +588,9 @@ private:
 
     Result decodeAllRows(void* dst, size_t rowBytes, int* rowsDecoded) override {
         const int height = this->dimensions().height();
-        png_set_progressive_read_fn(this->png_ptr(), this, nullptr, AllRowsCallback, nullptr);
+        const bool banded = this->executor() && height >= 2 * kRowsPerBand;
+        png_set_progressive_read_fn(this->png_ptr(), this, nullptr,
+                                    banded ? BandedRowsCallback : AllRowsCallback, nullptr);
         fDst = dst;
         fRowBytes = rowBytes;
 
@@ -536,7 +598,13 @@ private:
         fFirstRow = 0;
         fLastRow = height - 1;
 
+        if (banded) {
+            this->setUpBands();
+        }
         const bool success = this->processData();
+        if (banded) {
+            this->finishBands();
+        }
         if (success && fRowsWrittenToOutput == height) {
             return kSuccess;
         }
@@ -555,6 +623,60 @@ private:
         fDst = SkTAddOffset<void>(fDst, fRowBytes);
     }
 
+    uint8_t* bandRows(int band) {
+        return fBandStorage.get() + band * (kRowsPerBand * fBandSrcRowBytes +
+                                            fColorXformSrcRowBytes);
+    }
+
+    void setUpBands() {
+        fBandTasks.reset(new SkTaskGroup(*this->executor()));
+        fBandSrcRowBytes = png_get_rowbytes(this->png_ptr(), this->info_ptr());
+        // Each band holds its rows from libpng, followed by its own scratch row for the xform.
+        fBandStorage.reset(kBandCount * (kRowsPerBand * fBandSrcRowBytes +
+                                         fColorXformSrcRowBytes));
+        fBandIndex = 0;
+        fBandRowCount = 0;
+    }
+
+    void bandedRowsCallback(png_bytep row, int rowNum) {
+        SkASSERT(rowNum == fRowsWrittenToOutput);
+        fRowsWrittenToOutput++;
+        memcpy(this->bandRows(fBandIndex) + fBandRowCount * fBandSrcRowBytes, row,
+               fBandSrcRowBytes);
+        if (++fBandRowCount == kRowsPerBand) {
+            this->flushBand();
+        }
+    }
+
+    void flushBand() {
+        if (0 == fBandRowCount) {
+            return;
+        }
+        void* dst = fDst;
+        size_t dstRowBytes = fRowBytes;
+        const uint8_t* src = this->bandRows(fBandIndex);
+        size_t srcRowBytes = fBandSrcRowBytes;
+        int count = fBandRowCount;
+        uint8_t* colorXformSrcRow = this->bandRows(fBandIndex) + kRowsPerBand * srcRowBytes;
+        fBandTasks->add([=] {
+            this->applyXformRows(dst, dstRowBytes, src, srcRowBytes, count, colorXformSrcRow);
+        });
+
+        fDst = SkTAddOffset<void>(fDst, count * fRowBytes);
+        fBandRowCount = 0;
+        if (++fBandIndex == kBandCount) {
+            // Every band is in flight; wait for them before libpng overwrites the first.
+            fBandTasks->wait();
+            fBandIndex = 0;
+        }
+    }
+
+    void finishBands() {
+        // Rows from an incomplete image still need to reach the output.
+        this->flushBand();
+        fBandTasks.reset();
+    }
+
     void setRange(int firstRow, int lastRow, void* dst, size_t rowBytes) override {
         png_set_progressive_read_fn(this->png_ptr(), this, nullptr, RowCallback, nullptr);
         fFirstRow = firstRow;
@@ -565,10 +687,16 @@ private:
         fRowsNeeded = fLastRow - fFirstRow + 1;
     }
 
+    bool supportsBoxFilter() const override { return true; }
+
     Result decode(int* rowsDecoded) override {
         if (this->swizzler()) {
-            const int sampleY = this->swizzler()->sampleY();
-            fRowsNeeded = get_scaled_dimension(fLastRow - fFirstRow + 1, sampleY);
+            if (SkBoxFilter* boxFilter = this->swizzler()->boxFilter()) {
+                fRowsNeeded = (fLastRow - fFirstRow + 1) / boxFilter->sampleY();
+            } else {
+                const int sampleY = this->swizzler()->sampleY();
+                fRowsNeeded = get_scaled_dimension(fLastRow - fFirstRow + 1, sampleY);
+            }
         }
 
         const bool success = this->processData();
@@ -592,8 +720,16 @@ private:
         SkASSERT(rowNum <= fLastRow);
         SkASSERT(fRowsWrittenToOutput < fRowsNeeded);
 
-        // If there is no swizzler, all rows are needed.
-        if (!this->swizzler() || this->swizzler()->rowNeeded(rowNum - fFirstRow)) {
+        SkBoxFilter* boxFilter = this->swizzler() ? this->swizzler()->boxFilter() : nullptr;
+        if (boxFilter) {
+            // Every row goes into the average, and each block of them makes an output row.
+            this->applyXformRow(boxFilter->scratchRow(), row);
+            if (boxFilter->addRow(boxFilter->scratchRow(), fDst)) {
+                fDst = SkTAddOffset<void>(fDst, fRowBytes);
+                fRowsWrittenToOutput++;
+            }
+        } else if (!this->swizzler() || this->swizzler()->rowNeeded(rowNum - fFirstRow)) {
+            // If there is no swizzler, all rows are needed.
             this->applyXformRow(fDst, row);
             fDst = SkTAddOffset<void>(fDst, fRowBytes);
             fRowsWrittenToOutput++;
@@ -683,13 +819,8 @@ private:
         fLinesDecoded = 0;
 
         const bool success = this->processData();
-        png_bytep srcRow = fInterlaceBuffer.get();
         // FIXME: When resuming, this may rewrite rows that did not change.
-        for (int rowNum = 0; rowNum < fLinesDecoded; rowNum++) {
-            this->applyXformRow(dst, srcRow);
-            dst = SkTAddOffset<void>(dst, rowBytes);
-            srcRow = SkTAddOffset<png_byte>(srcRow, fPng_rowbytes);
-        }
+        this->applyXformRows(dst, rowBytes, fInterlaceBuffer.get(), fPng_rowbytes, fLinesDecoded);
         if (success && fInterlacedComplete) {
             return kSuccess;
         }
@@ -976,9 +1107,11 @@ SkPngCodec::SkPngCodec(SkEncodedInfo&& encodedInfo, std::unique_ptr<SkStream> st
     , fPng_ptr(png_ptr)
     , fInfo_ptr(info_ptr)
     , fColorXformSrcRow(nullptr)
+    , fColorXformSrcRowBytes(0)
     , fBitDepth(bitDepth)
     , fIdatLength(0)
     , fDecodedIdat(false)
+    , fExecutor(nullptr)
 {}
 
 SkPngCodec::~SkPngCodec() {
@@ -1150,7 +1283,10 @@ SkCodec::Result SkPngCodec::onGetPixels(const SkImageInfo& dstInfo, void* dst,
 
     this->allocateStorage(dstInfo);
     this->initializeXformParams();
-    return this->decodeAllRows(dst, rowBytes, rowsDecoded);
+    fExecutor = options.fExecutor;
+    Result decodeResult = this->decodeAllRows(dst, rowBytes, rowsDecoded);
+    fExecutor = nullptr;
+    return decodeResult;
 }
 
 SkCodec::Result SkPngCodec::onStartIncrementalDecode(const SkImageInfo& dstInfo,
@@ -15,6 +15,7 @@
 #include "src/codec/SkColorTable.h"
 #include "src/codec/SkSwizzler.h"
 
+class SkExecutor;
 class SkStream;
 
 class SkPngCodec : public SkCodec {
@@ -55,6 +56,22 @@ protected:
     SkSampler* getSampler(bool createIfNecessary) override;
     void applyXformRow(void* dst, const void* src);
 
+    // Apply the xform to count rows, using colorXformSrcRow (which must hold
+    // fColorXformSrcRowBytes) as scratch space. Safe to call from several threads at once,
+    // as long as each has its own colorXformSrcRow.
+    void applyXformRows(void* dst, size_t dstRowBytes, const void* src, size_t srcRowBytes,
+                        int count, void* colorXformSrcRow);
+
+    // Like the above, but splits the rows into bands on fExecutor if it is set.
+    void applyXformRows(void* dst, size_t dstRowBytes, const void* src, size_t srcRowBytes,
+                        int count);
+
+    // Rows per unit of work when transforming on fExecutor.
+    static constexpr int kRowsPerBand = 32;
+
+    // Set by onGetPixels() from Options::fExecutor.
+    SkExecutor* executor() const { return fExecutor; }
+
     voidp png_ptr() { return fPng_ptr; }
     voidp info_ptr() { return fInfo_ptr; }
 
@@ -84,6 +101,7 @@ protected:
     std::unique_ptr<SkSwizzler> fSwizzler;
     SkAutoTMalloc<uint8_t>      fStorage;
     void*                       fColorXformSrcRow;
+    size_t                      fColorXformSrcRowBytes;
     const int                   fBitDepth;
 
 private:
@@ -115,6 +133,7 @@ private:
 
     size_t                         fIdatLength;
     bool                           fDecodedIdat;
+    SkExecutor*                    fExecutor;
 
     typedef SkCodec INHERITED;
 };
@@ -213,6 +213,29 @@ SkCodec::Result SkSampledCodec::sampledDecode(const SkImageInfo& info, void* pix
 
     const SkImageInfo nativeInfo = info.makeWH(nativeSize.width(), nativeSize.height());
 
+    // Asks sampler to sample, or, if the codec can give boxFilter every pixel of every row, to
+    // skip nothing. Returns false if that doesn't produce info's dimensions.
+    std::unique_ptr<SkBoxFilter> boxFilter;
+    auto setUpSampler = [&](SkSampler* sampler, bool codecSupportsBoxFilter) {
+        if (get_scaled_dimension(subsetHeight, sampleY) != info.height()) {
+            return false;
+        }
+        if (options.fBoxFilter && codecSupportsBoxFilter && SkBoxFilter::Supports(info)) {
+            if (sampler->setSampleX(1) != subsetWidth ||
+                    get_scaled_dimension(subsetWidth, sampleX) != info.width()) {
+                return false;
+            }
+            boxFilter.reset(new SkBoxFilter(subsetWidth, sampleX, sampleY));
+            sampler->setSampleY(1);
+            return true;
+        }
+        if (sampler->setSampleX(sampleX) != info.width()) {
+            return false;
+        }
+        sampler->setSampleY(sampleY);
+        return true;
+    };
+
     {
         // Although startScanlineDecode expects the bottom and top to match the
         // SkImageInfo, startIncrementalDecode uses them to determine which rows to
@@ -234,17 +257,18 @@ SkCodec::Result SkSampledCodec::sampledDecode(const SkImageInfo& info, void* pix
                 return SkCodec::kUnimplemented;
             }
 
-            if (sampler->setSampleX(sampleX) != info.width()) {
-                return SkCodec::kInvalidScale;
-            }
-            if (get_scaled_dimension(subsetHeight, sampleY) != info.height()) {
+            if (!setUpSampler(sampler, this->codec()->supportsBoxFilter())) {
                 return SkCodec::kInvalidScale;
             }
 
-            sampler->setSampleY(sampleY);
-
+            sampler->setBoxFilter(boxFilter.get());
             int rowsDecoded = 0;
             const SkCodec::Result incResult = this->codec()->incrementalDecode(&rowsDecoded);
+            if (boxFilter) {
+                // Sample again, so that filling in an incomplete image covers info's width.
+                sampler->setBoxFilter(nullptr);
+                sampler->setSampleX(sampleX);
+            }
             if (incResult == SkCodec::kSuccess) {
                 return SkCodec::kSuccess;
             }
@@ -276,15 +300,18 @@ SkCodec::Result SkSampledCodec::sampledDecode(const SkImageInfo& info, void* pix
         return SkCodec::kUnimplemented;
     }
 
-    if (sampler->setSampleX(sampleX) != info.width()) {
-        return SkCodec::kInvalidScale;
-    }
-    if (get_scaled_dimension(subsetHeight, sampleY) != info.height()) {
+    // Here the scanlines are averaged as they come, so any codec that decodes top down will do.
+    const bool topDown = SkCodec::kTopDown_SkScanlineOrder == this->codec()->getScanlineOrder();
+    if (!setUpSampler(sampler, topDown)) {
         return SkCodec::kInvalidScale;
     }
 
     switch(this->codec()->getScanlineOrder()) {
         case SkCodec::kTopDown_SkScanlineOrder: {
+            if (boxFilter) {
+                return this->boxFilterScanlines(info, pixels, rowBytes, options, sampler,
+                                                boxFilter.get(), subsetY, sampleX);
+            }
             if (!this->codec()->skipScanlines(startY)) {
                 this->codec()->fillIncompleteImage(info, pixels, rowBytes, options.fZeroInitialized,
                         dstHeight, 0);
@@ -350,3 +377,35 @@ SkCodec::Result SkSampledCodec::sampledDecode(const SkImageInfo& info, void* pix
             return SkCodec::kUnimplemented;
     }
 }
+
+SkCodec::Result SkSampledCodec::boxFilterScanlines(const SkImageInfo& info, void* pixels,
+        size_t rowBytes, const AndroidOptions& options, SkSampler* sampler,
+        SkBoxFilter* boxFilter, int subsetY, int sampleX) {
+    const int dstHeight = info.height();
+    int y = 0;
+    if (this->codec()->skipScanlines(subsetY)) {
+        void* pixelPtr = pixels;
+        for (; y < dstHeight; y++) {
+            bool rowDone = false;
+            for (int i = 0; i < boxFilter->sampleY(); i++) {
+                if (1 != this->codec()->getScanlines(boxFilter->scratchRow(), 1, 0)) {
+                    break;
+                }
+                rowDone = boxFilter->addRow(boxFilter->scratchRow(), pixelPtr);
+            }
+            if (!rowDone) {
+                break;
+            }
+            pixelPtr = SkTAddOffset<void>(pixelPtr, rowBytes);
+        }
+    }
+    if (y == dstHeight) {
+        return SkCodec::kSuccess;
+    }
+
+    // Sample again, so that filling in the rest covers info's width.
+    sampler->setSampleX(sampleX);
+    this->codec()->fillIncompleteImage(info, pixels, rowBytes, options.fZeroInitialized,
+                                       dstHeight, y);
+    return SkCodec::kIncompleteInput;
+}
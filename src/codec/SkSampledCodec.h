@@ -10,6 +10,9 @@
 #include "include/codec/SkAndroidCodec.h"
 #include "include/codec/SkCodec.h"
 
+class SkBoxFilter;
+class SkSampler;
+
 /**
  *  This class implements the functionality of SkAndroidCodec.  Scaling will
  *  be provided by sampling if it cannot be provided by fCodec.
@@ -54,6 +57,15 @@ private:
     SkCodec::Result sampledDecode(const SkImageInfo& info, void* pixels, size_t rowBytes,
             const AndroidOptions& options);
 
+    /**
+     *  Finishes sampledDecode() with fCodec's scanlines, averaging every boxFilter->sampleY()
+     *  of them (starting at subsetY) into a row of pixels. sampler is set up to sample by
+     *  sampleX again if the image is incomplete.
+     */
+    SkCodec::Result boxFilterScanlines(const SkImageInfo& info, void* pixels, size_t rowBytes,
+            const AndroidOptions& options, SkSampler* sampler, SkBoxFilter* boxFilter,
+            int subsetY, int sampleX);
+
     typedef SkAndroidCodec INHERITED;
 };
 #endif // SkSampledCodec_DEFINED
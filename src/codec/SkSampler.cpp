@@ -6,6 +6,7 @@
  */
 
 #include "include/codec/SkCodec.h"
+#include "include/private/SkTo.h"
 #include "src/codec/SkCodecPriv.h"
 #include "src/codec/SkSampler.h"
 #include "src/core/SkUtils.h"
@@ -62,3 +63,49 @@ void SkSampler::Fill(const SkImageInfo& info, void* dst, size_t rowBytes,
             break;
     }
 }
+
+SkBoxFilter::SkBoxFilter(int srcWidth, int sampleX, int sampleY)
+    : fDstWidth(get_scaled_dimension(srcWidth, sampleX))
+    , fSampleX(sampleX)
+    , fSampleY(sampleY)
+    , fRowsAdded(0)
+    , fScratchRow(srcWidth)
+    , fSums(4 * fDstWidth) {
+    SkASSERT(sampleX >= 1 && sampleY >= 1 && fDstWidth * sampleX <= srcWidth);
+    sk_bzero(fSums.get(), 4 * fDstWidth * sizeof(uint32_t));
+}
+
+bool SkBoxFilter::Supports(const SkImageInfo& dstInfo) {
+    return (kRGBA_8888_SkColorType == dstInfo.colorType() ||
+            kBGRA_8888_SkColorType == dstInfo.colorType()) &&
+           kUnpremul_SkAlphaType != dstInfo.alphaType();
+}
+
+bool SkBoxFilter::addRow(const void* src, void* dst) {
+    const uint8_t* srcPixel = static_cast<const uint8_t*>(src);
+    uint32_t* sums = fSums.get();
+    for (int x = 0; x < fDstWidth; x++) {
+        for (int i = 0; i < fSampleX; i++) {
+            sums[0] += srcPixel[0];
+            sums[1] += srcPixel[1];
+            sums[2] += srcPixel[2];
+            sums[3] += srcPixel[3];
+            srcPixel += 4;
+        }
+        sums += 4;
+    }
+
+    if (++fRowsAdded < fSampleY) {
+        return false;
+    }
+
+    // Averaging premultiplied pixels keeps every color channel at or below alpha.
+    const uint32_t count = fSampleX * fSampleY;
+    uint8_t* dstPixel = static_cast<uint8_t*>(dst);
+    for (int i = 0; i < 4 * fDstWidth; i++) {
+        dstPixel[i] = SkToU8((fSums[i] + count / 2) / count);
+    }
+    sk_bzero(fSums.get(), 4 * fDstWidth * sizeof(uint32_t));
+    fRowsAdded = 0;
+    return true;
+}
@@ -9,8 +9,48 @@
 
 #include "include/codec/SkCodec.h"
 #include "include/core/SkTypes.h"
+#include "include/private/SkTemplates.h"
 #include "src/codec/SkCodecPriv.h"
 
+/**
+ *  Downscales by averaging each sampleX by sampleY block of decoded pixels into one, rather
+ *  than keeping a single pixel of it. Works on 8888 rows with premultiplied (or no) alpha.
+ *
+ *  The codec decodes every row, at full width, into scratchRow(), and adds it. Columns and
+ *  rows left over past the last whole block are dropped, just as sampling drops them.
+ */
+class SkBoxFilter : public SkNoncopyable {
+public:
+    SkBoxFilter(int srcWidth, int sampleX, int sampleY);
+
+    /**
+     *  Whether rows of dstInfo can be averaged.
+     */
+    static bool Supports(const SkImageInfo& dstInfo);
+
+    int sampleY() const { return fSampleY; }
+
+    /**
+     *  Room for one full width row, for the codec to decode into before calling addRow().
+     */
+    void* scratchRow() { return fScratchRow.get(); }
+
+    /**
+     *  Adds the next decoded row. Returns true if that completed a block, in which case the
+     *  averaged row has been written to dst.
+     */
+    bool addRow(const void* src, void* dst);
+
+private:
+    const int                fDstWidth;
+    const int                fSampleX;
+    const int                fSampleY;
+    int                      fRowsAdded;
+    SkAutoTMalloc<uint32_t>  fScratchRow;
+    // Per channel sums for the block being added up.
+    SkAutoTMalloc<uint32_t>  fSums;
+};
+
 class SkSampler : public SkNoncopyable {
 public:
     /**
@@ -35,6 +75,20 @@ public:
         return fSampleY;
     }
 
+    /**
+     *  Set (or clear, with nullptr) a box filter to average the decoded rows, for codecs
+     *  whose SkCodec::supportsBoxFilter() is true. The sampler should be set to sample every
+     *  pixel and row; the codec then hands each row to the filter rather than writing it
+     *  out. Not owned, and only used for the decode it was set for.
+     */
+    void setBoxFilter(SkBoxFilter* boxFilter) {
+        fBoxFilter = boxFilter;
+    }
+
+    SkBoxFilter* boxFilter() const {
+        return fBoxFilter;
+    }
+
     /**
      *  Based on fSampleY, return whether this row belongs in the output.
      *
@@ -72,11 +126,13 @@ public:
 
     SkSampler()
         : fSampleY(1)
+        , fBoxFilter(nullptr)
     {}
 
     virtual ~SkSampler() {}
 private:
-    int fSampleY;
+    int          fSampleY;
+    SkBoxFilter* fBoxFilter;
 
     virtual int onSetSampleX(int) = 0;
 };
@@ -13,6 +13,8 @@ SkStreamBuffer::SkStreamBuffer(std::unique_ptr<SkStream> stream)
     , fBytesBuffered(0)
     , fHasLengthAndPosition(fStream->hasLength() && fStream->hasPosition())
     , fTrulyBuffered(0)
+    , fMemoryBase(fHasLengthAndPosition
+                  ? static_cast<const char*>(fStream->getMemoryBase()) : nullptr)
 {}
 
 SkStreamBuffer::~SkStreamBuffer() {
@@ -21,6 +23,11 @@ SkStreamBuffer::~SkStreamBuffer() {
 
 const char* SkStreamBuffer::get() const {
     SkASSERT(fBytesBuffered >= 1);
+    if (fMemoryBase) {
+        // The stream does not move until flush(), so its position is still the
+        // start of the buffer.
+        return fMemoryBase + fStream->getPosition();
+    }
     if (fHasLengthAndPosition && fTrulyBuffered < fBytesBuffered) {
         const size_t bytesToBuffer = fBytesBuffered - fTrulyBuffered;
         char* dst = SkTAddOffset<char>(const_cast<char*>(fBuffer), fTrulyBuffered);
@@ -75,6 +82,10 @@ sk_sp<SkData> SkStreamBuffer::getDataAtPosition(size_t position, size_t length)
     SkASSERT(length <= fStream->getLength() &&
              position <= fStream->getLength() - length);
 
+    if (fMemoryBase) {
+        return SkData::MakeWithoutCopy(fMemoryBase + position, length);
+    }
+
     const size_t oldPosition = fStream->getPosition();
     if (!fStream->seek(position)) {
         return nullptr;
@@ -32,6 +32,9 @@ public:
      *
      *  The number of bytes buffered is the number passed to buffer()
      *  after the last call to flush().
+     *
+     *  If the stream is backed by memory, this points into the stream's
+     *  memory, and nothing is copied.
      */
     const char* get() const;
 
@@ -80,6 +83,10 @@ public:
     /**
      *  Retrieve data at position, as previously marked by markPosition().
      *
+     *  If the stream is backed by memory (e.g. a memory mapped file), the
+     *  returned SkData points into that memory rather than holding a copy,
+     *  so it must not outlive this SkStreamBuffer.
+     *
      *  @param position Position to retrieve data, as marked by markPosition().
      *  @param length   Amount of data required at position.
      *  @return SkData The data at position.
@@ -108,6 +115,9 @@ private:
     // The second call to get() needs to only truly buffer the part that was
     // not already buffered.
     mutable size_t              fTrulyBuffered;
+    // Non-null if fHasLengthAndPosition and the stream is backed by memory. In
+    // that case get() and getDataAtPosition() read from it directly.
+    const char*                 fMemoryBase;
     // Only used if !fHasLengthAndPosition. In that case, markPosition will
     // copy into an SkData, stored here.
     SkTHashMap<size_t, SkData*> fMarkedData;
@@ -643,6 +643,13 @@ bool SkAAClip::setRect(const SkIRect& bounds) {
 #endif
 }
 
+size_t SkAAClip::bytesUsed() const {
+    if (!fRunHead) {
+        return 0;
+    }
+    return sizeof(RunHead) + fRunHead->fRowCount * sizeof(YOffset) + fRunHead->fDataSize;
+}
+
 bool SkAAClip::isRect() const {
     if (this->isEmpty()) {
         return false;
@@ -33,6 +33,9 @@ public:
     // If true, getBounds() can be used in place of this clip.
     bool isRect() const;
 
+    // Returns the memory owned by the clip's rows, e.g. for cache accounting.
+    size_t bytesUsed() const;
+
     bool setEmpty();
     bool setRect(const SkIRect&);
     bool setRect(const SkRect&, bool doAA = true);
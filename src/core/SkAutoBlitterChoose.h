@@ -17,6 +17,69 @@ class SkMatrix;
 class SkPaint;
 class SkPixmap;
 
+/**
+ *  Holds on to the blitter built for the last solid-color paint drawn into a device, so that a run
+ *  of draws with the same paint (a chart's bars, a grid of cells) builds it only once.
+ *
+ *  Only paints whose blitter can't depend on the matrix or the geometry are reused: no shader,
+ *  color filter, or mask filter. Everything else that goes into SkBlitter::Choose() for such a
+ *  paint is part of the key, so a stale blitter is never returned.
+ */
+class SkSolidBlitterCache : SkNoncopyable {
+public:
+    /**
+     *  Returns the blitter for drawing 'paint' into 'dst', building it if the cached one doesn't
+     *  match, or nullptr if the paint can't be cached or the cached blitter is already in use.
+     *  Each non-null return must be paired with a call to release().
+     */
+    SkBlitter* acquire(const SkPixmap& dst, const SkMatrix& matrix, const SkPaint& paint) {
+        if (fInUse || paint.getShader() || paint.getColorFilter() || paint.getMaskFilter() ||
+            matrix.hasPerspective() || paint.getFilterQuality() == kHigh_SkFilterQuality) {
+            return nullptr;
+        }
+        if (!fBlitter || !this->matches(dst, paint)) {
+            this->reset();
+            fDst = dst;
+            fColor = paint.getColor4f();
+            fBlendMode = paint.getBlendMode();
+            fDither = paint.isDither();
+            fBlitter = SkBlitter::Choose(dst, matrix, paint, &fAlloc);
+        }
+        fInUse = true;
+        return fBlitter;
+    }
+
+    void release() {
+        SkASSERT(fInUse);
+        fInUse = false;
+    }
+
+    // Drops the cached blitter, e.g. when the device's pixels are replaced.
+    void reset() {
+        SkASSERT(!fInUse);
+        fBlitter = nullptr;
+        fAlloc.reset();
+        fDst.reset();
+    }
+
+private:
+    bool matches(const SkPixmap& dst, const SkPaint& paint) const {
+        return fDst.addr() == dst.addr() && fDst.rowBytes() == dst.rowBytes() &&
+               fDst.info() == dst.info() && fColor == paint.getColor4f() &&
+               fBlendMode == paint.getBlendMode() && fDither == paint.isDither();
+    }
+
+    // Owned by fAlloc.
+    SkBlitter*  fBlitter = nullptr;
+    SkPixmap    fDst;
+    SkColor4f   fColor = SkColors::kTransparent;
+    SkBlendMode fBlendMode = SkBlendMode::kSrcOver;
+    bool        fDither = false;
+    bool        fInUse = false;
+
+    SkSTArenaAlloc<kSkBlitterContextSize> fAlloc;
+};
+
 class SkAutoBlitterChoose : SkNoncopyable {
 public:
     SkAutoBlitterChoose() {}
@@ -24,6 +87,11 @@ public:
                         bool drawCoverage = false) {
         this->choose(draw, matrix, paint, drawCoverage);
     }
+    ~SkAutoBlitterChoose() {
+        if (fCache) {
+            fCache->release();
+        }
+    }
 
     SkBlitter*  operator->() { return fBlitter; }
     SkBlitter*  get() const { return fBlitter; }
@@ -34,6 +102,13 @@ public:
         if (!matrix) {
             matrix = draw.fMatrix;
         }
+        if (draw.fBlitterCache && !draw.fCoverage && !drawCoverage) {
+            fBlitter = draw.fBlitterCache->acquire(draw.fDst, *matrix, paint);
+            if (fBlitter) {
+                fCache = draw.fBlitterCache;
+                return fBlitter;
+            }
+        }
         fBlitter = SkBlitter::Choose(draw.fDst, *matrix, paint, &fAlloc, drawCoverage);
 
         if (draw.fCoverage) {
@@ -48,6 +123,8 @@ public:
 private:
     // Owned by fAlloc, which will handle the delete.
     SkBlitter* fBlitter = nullptr;
+    // Set if fBlitter came from the draw's cache, which we release when we're done with it.
+    SkSolidBlitterCache* fCache = nullptr;
 
     SkSTArenaAlloc<kSkBlitterContextSize> fAlloc;
 };
@@ -8,6 +8,7 @@
 #include "src/core/SkBBoxHierarchy.h"
 #include "src/core/SkBigPicture.h"
 #include "src/core/SkPictureCommon.h"
+#include "src/core/SkPictureRecord.h"
 #include "src/core/SkRecord.h"
 #include "src/core/SkRecordDraw.h"
 #include "src/core/SkTraceEvent.h"
@@ -53,6 +54,20 @@ void SkBigPicture::partialPlayback(SkCanvas* canvas,
                         initialCTM);
 }
 
+void SkBigPicture::playbackWithOpBounds(SkPictureRecord* rec) const {
+    SkASSERT(rec);
+    SkAutoTMalloc<SkRect> bounds(fRecord->count());
+    SkRecordFillBounds(fCullRect, *fRecord, bounds);
+
+    SkAutoCanvasRestore saveRestore(rec, true /*save now, restore at exit*/);
+    SkRecords::Draw draw(rec, this->drawablePicts(), nullptr, this->drawableCount());
+    for (int i = 0; i < fRecord->count(); i++) {
+        size_t offset = rec->writeStream().bytesWritten();
+        fRecord->visit(i, draw);
+        rec->recordOpBounds(offset, bounds[i]);
+    }
+}
+
 SkRect SkBigPicture::cullRect()            const { return fCullRect; }
 int    SkBigPicture::approximateOpCount()   const { return fRecord->count(); }
 size_t SkBigPicture::approximateBytesUsed() const {
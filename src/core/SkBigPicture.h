@@ -16,6 +16,7 @@
 
 class SkBBoxHierarchy;
 class SkMatrix;
+class SkPictureRecord;
 class SkRecord;
 
 // An implementation of SkPicture supporting an arbitrary number of drawing commands.
@@ -56,6 +57,9 @@ public:
 // Used by GrRecordReplaceDraw
     const SkBBoxHierarchy* bbh() const { return fBBH.get(); }
     const SkRecord*     record() const { return fRecord.get(); }
+// Used by SkPicture::backport()
+    // Plays back into 'rec' like playback(), noting the bounds of the ops each record makes.
+    void playbackWithOpBounds(SkPictureRecord* rec) const;
 
 private:
     int drawableCount() const;
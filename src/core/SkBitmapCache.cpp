@@ -30,7 +30,15 @@ void SkNotifyBitmapGenIDIsStale(uint32_t bitmapGenID) {
 SkBitmapCacheDesc SkBitmapCacheDesc::Make(uint32_t imageID, const SkIRect& subset) {
     SkASSERT(imageID);
     SkASSERT(subset.width() > 0 && subset.height() > 0);
-    return { imageID, subset };
+    return { imageID, subset, {0, 0} };
+}
+
+SkBitmapCacheDesc SkBitmapCacheDesc::MakeScaled(uint32_t imageID, const SkIRect& subset,
+                                                const SkISize& scaledSize) {
+    SkASSERT(imageID);
+    SkASSERT(subset.width() > 0 && subset.height() > 0);
+    SkASSERT(!scaledSize.isEmpty());
+    return { imageID, subset, scaledSize };
 }
 
 SkBitmapCacheDesc SkBitmapCacheDesc::Make(const SkImage* image) {
@@ -175,9 +183,9 @@ void SkBitmapCache::PrivateDeleteRec(Rec* rec) { delete rec; }
 
 SkBitmapCache::RecPtr SkBitmapCache::Alloc(const SkBitmapCacheDesc& desc, const SkImageInfo& info,
                                            SkPixmap* pmap) {
-    // Ensure that the info matches the subset (i.e. the subset is the entire image)
-    SkASSERT(info.width() == desc.fSubset.width());
-    SkASSERT(info.height() == desc.fSubset.height());
+    // Ensure that the info matches the subset (i.e. the subset is the entire image), at the
+    // scale it was decoded at
+    SkASSERT(info.dimensions() == desc.dimensions());
 
     const size_t rb = info.minRowBytes();
     size_t size = info.computeByteSize(rb);
@@ -26,6 +26,7 @@ void SkNotifyBitmapGenIDIsStale(uint32_t bitmapGenID);
 struct SkBitmapCacheDesc {
     uint32_t    fImageID;       // != 0
     SkIRect     fSubset;        // always set to a valid rect (entire or subset)
+    SkISize     fScaledSize;    // the size fSubset was decoded at, or empty for full size
 
     void validate() const {
         SkASSERT(fImageID);
@@ -33,8 +34,15 @@ struct SkBitmapCacheDesc {
         SkASSERT(fSubset.width() > 0 && fSubset.height() > 0);
     }
 
+    // The size of the cached pixels.
+    SkISize dimensions() const {
+        return fScaledSize.isEmpty() ? fSubset.size() : fScaledSize;
+    }
+
     static SkBitmapCacheDesc Make(const SkImage*);
     static SkBitmapCacheDesc Make(uint32_t genID, const SkIRect& subset);
+    static SkBitmapCacheDesc MakeScaled(uint32_t genID, const SkIRect& subset,
+                                        const SkISize& scaledSize);
 };
 
 class SkBitmapCache {
@@ -56,6 +56,25 @@ bool SkBitmapController::State::processHighRequest(const SkBitmapProvider& provi
     return true;
 }
 
+/*
+ *  For images that can decode at a reduced size, this is cheaper than building mips from the
+ *  full size: we decode (and cache) just big enough for the draw, and filter the rest of the
+ *  way with kLow, as extracting a mip level would.
+ */
+bool SkBitmapController::State::processScaledRequest(const SkBitmapProvider& provider,
+                                                     const SkSize& invScaleSize) {
+    const SkSize scale = SkSize::Make(SkScalarInvert(invScaleSize.width()),
+                                      SkScalarInvert(invScaleSize.height()));
+    if (!provider.asScaledBitmap(scale, &fResultBitmap)) {
+        return false;
+    }
+
+    const SkISize dimensions = provider.dimensions();
+    fInvMatrix.postScale(SkIntToScalar(fResultBitmap.width()) / dimensions.width(),
+                         SkIntToScalar(fResultBitmap.height()) / dimensions.height());
+    return true;
+}
+
 /*
  *  Modulo internal errors, this should always succeed *if* the matrix is downscaling
  *  (in this case, we have the inverse, so it succeeds if fInvMatrix is upscaling)
@@ -77,6 +96,9 @@ bool SkBitmapController::State::processMediumRequest(const SkBitmapProvider& pro
 
     if (invScaleSize.width() > SK_Scalar1 || invScaleSize.height() > SK_Scalar1) {
         fCurrMip.reset(SkMipMapCache::FindAndRef(provider.makeCacheDesc()));
+        if (nullptr == fCurrMip.get() && this->processScaledRequest(provider, invScaleSize)) {
+            return true;
+        }
         if (nullptr == fCurrMip.get()) {
             fCurrMip.reset(SkMipMapCache::AddAndRef(provider));
             if (nullptr == fCurrMip.get()) {
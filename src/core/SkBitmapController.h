@@ -32,6 +32,7 @@ public:
     private:
         bool processHighRequest(const SkBitmapProvider&);
         bool processMediumRequest(const SkBitmapProvider&);
+        bool processScaledRequest(const SkBitmapProvider&, const SkSize& invScaleSize);
 
         SkPixmap              fPixmap;
         SkMatrix              fInvMatrix;
@@ -10,11 +10,14 @@
 #include "include/core/SkPaint.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkPixmap.h"
+#include "include/core/SkRSXform.h"
 #include "include/core/SkRasterHandleAllocator.h"
 #include "include/core/SkShader.h"
 #include "include/core/SkSurface.h"
 #include "include/core/SkVertices.h"
+#include "src/core/Sk4px.h"
 #include "src/core/SkBitmapDevice.h"
+#include "src/core/SkBlitRow.h"
 #include "src/core/SkDraw.h"
 #include "src/core/SkGlyphRun.h"
 #include "src/core/SkImageFilterCache.h"
@@ -23,6 +26,9 @@
 #include "src/core/SkSpecialImage.h"
 #include "src/core/SkStrikeCache.h"
 #include "src/core/SkTLazy.h"
+#include "src/core/SkTaskGroup.h"
+
+#include <atomic>
 
 struct Bounder {
     SkRect  fBounds;
@@ -117,6 +123,7 @@ public:
             fOrigin.set(0, 0);
 
             fDraw.fCoverage = dev->accessCoverage();
+            fDraw.fBlitterCache = &dev->fBlitterCache;
         }
     }
 
@@ -194,6 +201,7 @@ public:
         fMatrix = &dev->ctm();
         fRC = &dev->fRCStack.rc();
         fCoverage = dev->accessCoverage();
+        fBlitterCache = &dev->fBlitterCache;
     }
 };
 
@@ -211,6 +219,12 @@ static bool valid_for_bitmap_device(const SkImageInfo& info,
     return true;
 }
 
+static std::atomic<int> gImageFilterTileSize{0};
+
+int SkBitmapDevice::SetImageFilterTileSize(int tileSize) {
+    return gImageFilterTileSize.exchange(SkTMax(tileSize, 0));
+}
+
 SkBitmapDevice::SkBitmapDevice(const SkBitmap& bitmap)
         : INHERITED(bitmap.info(), SkSurfaceProps(SkSurfaceProps::kLegacyFontHost_InitType))
         , fBitmap(bitmap)
@@ -297,6 +311,7 @@ void SkBitmapDevice::replaceBitmapBackendForRasterSurface(const SkBitmap& bm) {
     SkASSERT(bm.width() == fBitmap.width());
     SkASSERT(bm.height() == fBitmap.height());
     fBitmap = bm;   // intent is to use bm's pixelRef (and rowbytes/config)
+    fBlitterCache.reset();
     this->privateResize(fBitmap.info().width(), fBitmap.info().height());
 }
 
@@ -549,6 +564,86 @@ void SkBitmapDevice::drawVertices(const SkVertices* vertices, const SkVertices::
                               vertices->indexCount(), paint, bones, boneCount);
 }
 
+// The common case of drawAtlas() -- sprites copied 1:1 from a raster atlas to whole-pixel positions
+// under a rect clip -- doesn't need drawVertices() and an image shader. Rows of each sprite can be
+// blended straight from the atlas pixels into the device. Returns false, having drawn nothing, if
+// any sprite needs the general path.
+static bool blit_atlas_sprites(const SkPixmap& dst, const SkRasterClip& rc, const SkMatrix& ctm,
+                               const SkImage* atlas, const SkRSXform xform[], const SkRect tex[],
+                               const SkColor colors[], int count, SkBlendMode mode,
+                               const SkPaint& paint) {
+    SkPixmap src;
+    if (!rc.isBW() || !rc.isRect() || !ctm.isTranslate() ||
+        !atlas || !atlas->peekPixels(&src) ||
+        src.colorType() != kN32_SkColorType || src.alphaType() == kUnpremul_SkAlphaType ||
+        dst.colorType() != kN32_SkColorType || dst.alphaType() == kUnpremul_SkAlphaType ||
+        !SkColorSpace::Equals(src.colorSpace(), dst.colorSpace()) ||
+        paint.getShader() || paint.getColorFilter() || paint.getMaskFilter() ||
+        paint.isDither() || paint.getBlendMode() != SkBlendMode::kSrcOver ||
+        (colors && (mode != SkBlendMode::kModulate || dst.colorSpace()))) {
+        return false;
+    }
+
+    auto isInt = [](SkScalar x) { return x == SkScalarFloorToScalar(x); };
+    const SkRect atlasBounds = SkRect::Make(src.bounds());
+    int maxWidth = 0;
+    for (int i = 0; i < count; ++i) {
+        SkScalar x = xform[i].fTx + ctm.getTranslateX(),
+                 y = xform[i].fTy + ctm.getTranslateY();
+        if (xform[i].fSCos != 1 || xform[i].fSSin != 0 || !isInt(x) || !isInt(y) ||
+            !isInt(tex[i].fLeft) || !isInt(tex[i].fTop) ||
+            !isInt(tex[i].fRight) || !isInt(tex[i].fBottom) ||
+            !atlasBounds.contains(tex[i]) ||
+            // Keep the device coordinates comfortably inside int range.
+            SkScalarAbs(x) > (1 << 29) || SkScalarAbs(y) > (1 << 29)) {
+            return false;
+        }
+        maxWidth = SkTMax(maxWidth, (int)tex[i].width());
+    }
+
+    const U8CPU alpha = paint.getAlpha();
+    const SkBlitRow::Proc32 proc = SkBlitRow::Factory32(
+            SkBlitRow::kSrcPixelAlpha_Flag32 | (alpha < 0xFF ? SkBlitRow::kGlobalAlpha_Flag32 : 0));
+    SkAutoSTMalloc<256, SkPMColor> modulated(colors ? maxWidth : 0);
+
+    const SkIRect& clip = rc.getBounds();
+    for (int i = 0; i < count; ++i) {
+        const SkIRect texRect = tex[i].round();
+        const int dx = SkScalarRoundToInt(xform[i].fTx + ctm.getTranslateX()),
+                  dy = SkScalarRoundToInt(xform[i].fTy + ctm.getTranslateY());
+        SkIRect dstRect = SkIRect::MakeXYWH(dx, dy, texRect.width(), texRect.height());
+        if (!dstRect.intersect(clip)) {
+            continue;
+        }
+        const int sx = texRect.fLeft + dstRect.fLeft - dx,
+                  sy = texRect.fTop  + dstRect.fTop  - dy,
+                  width = dstRect.width();
+
+        // Modulating by a single premultiplied color is kModulate's src * dst.
+        const Sk4px color = Sk4px::DupPMColor(colors ? SkPreMultiplyColor(colors[i]) : 0);
+        for (int y = dstRect.fTop; y < dstRect.fBottom; ++y) {
+            const SkPMColor* row = src.addr32(sx, sy + y - dstRect.fTop);
+            if (colors) {
+                Sk4px::MapSrc(width, modulated.get(), row, [&](const Sk4px& px) {
+                    return px.approxMulDiv255(color);
+                });
+                row = modulated.get();
+            }
+            proc(dst.writable_addr32(dstRect.fLeft, y), row, width, alpha);
+        }
+    }
+    return true;
+}
+
+void SkBitmapDevice::drawAtlas(const SkImage* atlas, const SkRSXform xform[], const SkRect tex[],
+                               const SkColor colors[], int count, SkBlendMode mode,
+                               const SkPaint& paint) {
+    if (!blit_atlas_sprites(fBitmap.pixmap(), fRCStack.rc(), this->ctm(), atlas, xform, tex,
+                            colors, count, mode, paint)) {
+        this->INHERITED::drawAtlas(atlas, xform, tex, colors, count, mode, paint);
+    }
+}
+
 void SkBitmapDevice::drawDevice(SkBaseDevice* device, int x, int y, const SkPaint& origPaint) {
     SkASSERT(!origPaint.getImageFilter());
 
@@ -616,6 +711,14 @@ void SkBitmapDevice::drawSpecial(SkSpecialImage* src, int x, int y, const SkPain
         SkImageFilter::OutputProperties outputProperties(fBitmap.colorType(), fBitmap.colorSpace());
         SkImageFilter::Context ctx(matrix, clipBounds, cache.get(), outputProperties);
 
+        const int tileSize = gImageFilterTileSize.load(std::memory_order_relaxed);
+        if (!clipImage && tileSize > 0 &&
+            (clipBounds.width() > tileSize || clipBounds.height() > tileSize)) {
+            paint.writable()->setImageFilter(nullptr);
+            this->drawFilteredTiles(filter, src, x, y, ctx, tileSize, *paint);
+            return;
+        }
+
         filteredImage = filter->filterImage(src, ctx, &offset);
         if (!filteredImage) {
             return;
@@ -695,6 +798,64 @@ void SkBitmapDevice::drawSpecial(SkSpecialImage* src, int x, int y, const SkPain
                         *paint, SkCanvas::kFast_SrcRectConstraint);
 }
 
+// Evaluates the filter for one tile of the clip at a time. Each context only asks for its tile,
+// so the filters in the DAG map it back to the (slightly larger) region they need of their
+// inputs, and no intermediate surface is much bigger than a tile. A batch of tiles is filtered
+// at once on the default SkExecutor, then drawn in order, clipped to their tiles.
+void SkBitmapDevice::drawFilteredTiles(const SkImageFilter* filter, SkSpecialImage* src,
+                                       int x, int y, const SkImageFilter::Context& ctx,
+                                       int tileSize, const SkPaint& origPaint) {
+    static constexpr int kTileBatch = 8;
+
+    SkTCopyOnFirstWrite<SkPaint> paint(origPaint);
+    if (paint->getMaskFilter()) {
+        paint.writable()->setMaskFilter(paint->getMaskFilter()->makeWithMatrix(this->ctm()));
+    }
+
+    const SkIRect& clipBounds = ctx.clipBounds();
+    const int tilesX = (clipBounds.width()  - 1) / tileSize + 1,
+              tilesY = (clipBounds.height() - 1) / tileSize + 1;
+    const int tileCount = tilesX * tilesY;
+    auto tileBounds = [&](int i) {
+        SkIRect tile = SkIRect::MakeXYWH(clipBounds.fLeft + (i % tilesX) * tileSize,
+                                         clipBounds.fTop  + (i / tilesX) * tileSize,
+                                         tileSize, tileSize);
+        SkAssertResult(tile.intersect(clipBounds));
+        return tile;
+    };
+
+    struct FilteredTile {
+        sk_sp<SkSpecialImage> fImage;
+        SkIPoint              fOffset;
+    };
+    FilteredTile tiles[kTileBatch];
+
+    SkTaskGroup tasks;
+    for (int start = 0; start < tileCount; start += kTileBatch) {
+        const int count = SkTMin(kTileBatch, tileCount - start);
+        tasks.parallelFor(count, [&](int begin, int end) {
+            for (int i = begin; i < end; ++i) {
+                SkImageFilter::Context tileCtx(ctx.ctm(), tileBounds(start + i), ctx.cache(),
+                                               ctx.outputProperties());
+                tiles[i].fOffset = SkIPoint::Make(0, 0);
+                tiles[i].fImage = filter->filterImage(src, tileCtx, &tiles[i].fOffset);
+            }
+        }, 1);
+        tasks.wait();
+
+        for (int i = 0; i < count; ++i) {
+            sk_sp<SkSpecialImage> image = std::move(tiles[i].fImage);
+            SkBitmap resultBM;
+            if (image && image->getROPixels(&resultBM)) {
+                SkAutoDeviceClipRestore autoClipRestore(this,
+                                                        tileBounds(start + i).makeOffset(x, y));
+                this->drawSprite(resultBM, x + tiles[i].fOffset.x(), y + tiles[i].fOffset.y(),
+                                 *paint);
+            }
+        }
+    }
+}
+
 sk_sp<SkSpecialImage> SkBitmapDevice::makeSpecial(const SkBitmap& bitmap) {
     return SkSpecialImage::MakeFromRaster(bitmap.bounds(), bitmap);
 }
@@ -11,11 +11,13 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
+#include "include/core/SkImageFilter.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkScalar.h"
 #include "include/core/SkSize.h"
 #include "include/core/SkSurfaceProps.h"
+#include "src/core/SkAutoBlitterChoose.h"
 #include "src/core/SkDevice.h"
 #include "src/core/SkGlyphRunPainter.h"
 #include "src/core/SkRasterClip.h"
@@ -56,6 +58,12 @@ public:
     SkBitmapDevice(const SkBitmap& bitmap, const SkSurfaceProps& surfaceProps,
                    void* externalHandle, const SkBitmap* coverage);
 
+    /**
+     *  Sets the size of the tiles image filters are evaluated in, returning the previous size.
+     *  See SkGraphics::SetImageFilterTileSize(). Zero, the default, turns tiling off.
+     */
+    static int SetImageFilterTileSize(int tileSize);
+
     static SkBitmapDevice* Create(const SkImageInfo&, const SkSurfaceProps&,
                                   bool trackCoverage,
                                   SkRasterHandleAllocator*);
@@ -101,6 +109,8 @@ protected:
     void drawGlyphRunList(const SkGlyphRunList& glyphRunList) override;
     void drawVertices(const SkVertices*, const SkVertices::Bone bones[], int boneCount, SkBlendMode,
                       const SkPaint& paint) override;
+    void drawAtlas(const SkImage* atlas, const SkRSXform[], const SkRect[], const SkColor[],
+                   int count, SkBlendMode, const SkPaint&) override;
     void drawDevice(SkBaseDevice*, int x, int y, const SkPaint&) override;
 
     ///////////////////////////////////////////////////////////////////////////
@@ -157,11 +167,15 @@ private:
 
     SkImageFilterCache* getImageFilterCache() override;
 
+    void drawFilteredTiles(const SkImageFilter*, SkSpecialImage* src, int x, int y,
+                           const SkImageFilter::Context&, int tileSize, const SkPaint&);
+
     SkBitmap    fBitmap;
     void*       fRasterHandle = nullptr;
     SkRasterClipStack  fRCStack;
     std::unique_ptr<SkBitmap> fCoverage;    // if non-null, will have the same dimensions as fBitmap
     SkGlyphRunListPainter fGlyphPainter;
+    SkSolidBlitterCache fBlitterCache;
 
 
     typedef SkBaseDevice INHERITED;
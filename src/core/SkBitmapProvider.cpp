@@ -19,3 +19,7 @@ void SkBitmapProvider::notifyAddedToCache() const {
 bool SkBitmapProvider::asBitmap(SkBitmap* bm) const {
     return as_IB(fImage)->getROPixels(bm);
 }
+
+bool SkBitmapProvider::asScaledBitmap(const SkSize& scale, SkBitmap* bm) const {
+    return as_IB(fImage)->getROPixelsForScale(scale, bm);
+}
@@ -28,6 +28,12 @@ public:
     // ... cause a decode and cache, or gpu-readback
     bool asBitmap(SkBitmap*) const;
 
+    // Like asBitmap, but the bitmap may be smaller than the image, if the image can produce a
+    // version no smaller than what a draw at scale needs. Returns false if it can't.
+    bool asScaledBitmap(const SkSize& scale, SkBitmap*) const;
+
+    SkISize dimensions() const { return fImage->dimensions(); }
+
 private:
     // Stack-allocated only.
     void* operator new(size_t) = delete;
@@ -17,6 +17,7 @@
 #include "src/core/SkMask.h"
 #include "src/core/SkMaskFilterBase.h"
 #include "src/core/SkPaintPriv.h"
+#include "src/core/SkPerfCounters.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkRegionPriv.h"
 #include "src/core/SkTLazy.h"
@@ -762,6 +763,7 @@ SkBlitter* SkBlitter::Choose(const SkPixmap& device,
 
     switch (device.colorType()) {
         case kN32_SkColorType:
+            SkPerfCounters::Add(SkGraphics::PerfCounter::kLegacyBlitters);
             if (shaderContext) {
                 return alloc->make<SkARGB32_Shader_Blitter>(device, *paint, shaderContext);
             } else if (paint->getColor() == SK_ColorBLACK) {
@@ -774,6 +776,7 @@ SkBlitter* SkBlitter::Choose(const SkPixmap& device,
 
         case kRGB_565_SkColorType:
             if (shaderContext && SkRGB565_Shader_Blitter::Supports(device, *paint)) {
+                SkPerfCounters::Add(SkGraphics::PerfCounter::kLegacyBlitters);
                 return alloc->make<SkRGB565_Shader_Blitter>(device, *paint, shaderContext);
             } else {
                 return SkCreateRasterPipelineBlitter(device, *paint, matrix, alloc);
@@ -497,22 +497,29 @@ SkBlurMaskFilterImpl::filterRRectToNine(const SkRRect& rrect, const SkMatrix& ma
     // any fractional space on either side plus 1 for the part to stretch.
     const SkScalar stretchSize = SkIntToScalar(3);
 
-    const SkScalar totalSmallWidth = leftUnstretched + rightUnstretched + stretchSize;
-    if (totalSmallWidth >= rrect.rect().width()) {
-        // There is no valid piece to stretch.
-        return kUnimplemented_FilterReturn;
-    }
-
     const SkScalar topUnstretched = SkTMax(UL.fY, UR.fY) + SkIntToScalar(2 * margin.fY);
     const SkScalar bottomUnstretched = SkTMax(LL.fY, LR.fY) + SkIntToScalar(2 * margin.fY);
 
+    const SkScalar totalSmallWidth = leftUnstretched + rightUnstretched + stretchSize;
     const SkScalar totalSmallHeight = topUnstretched + bottomUnstretched + stretchSize;
-    if (totalSmallHeight >= rrect.rect().height()) {
+
+    // A narrow or short rrect, e.g. a small card with a large shadow, may have no piece to
+    // stretch along one axis. It can still be stretched along the other, so its mask only
+    // depends on its size in one direction.
+    const bool stretchX = totalSmallWidth < rrect.rect().width();
+    const bool stretchY = totalSmallHeight < rrect.rect().height();
+    if (!stretchX && !stretchY) {
         // There is no valid piece to stretch.
         return kUnimplemented_FilterReturn;
     }
 
-    SkRect smallR = SkRect::MakeWH(totalSmallWidth, totalSmallHeight);
+    // Along an axis we don't stretch, the mask is drawn as is, so keep the rrect's subpixel
+    // position on that axis.
+    const SkRect& rect = rrect.rect();
+    SkRect smallR = SkRect::MakeXYWH(stretchX ? 0 : rect.fLeft - SkScalarFloorToScalar(rect.fLeft),
+                                     stretchY ? 0 : rect.fTop - SkScalarFloorToScalar(rect.fTop),
+                                     stretchX ? totalSmallWidth : rect.width(),
+                                     stretchY ? totalSmallHeight : rect.height());
 
     SkRRect smallRR;
     SkVector radii[4];
@@ -548,8 +555,11 @@ SkBlurMaskFilterImpl::filterRRectToNine(const SkRRect& rrect, const SkMatrix& ma
 
     patch->fMask.fBounds.offsetTo(0, 0);
     patch->fOuterRect = dstM.fBounds;
-    patch->fCenter.fX = SkScalarCeilToInt(leftUnstretched) + 1;
-    patch->fCenter.fY = SkScalarCeilToInt(topUnstretched) + 1;
+    patch->fCenter.fX = stretchX ? SkScalarCeilToInt(leftUnstretched) + 1
+                                 : patch->fMask.fBounds.width() / 2;
+    patch->fCenter.fY = stretchY ? SkScalarCeilToInt(topUnstretched) + 1
+                                 : patch->fMask.fBounds.height() / 2;
+    patch->fOpaqueCenter = stretchX && stretchY;
     SkASSERT(nullptr == patch->fCache);
     patch->fCache = cache;  // transfer ownership to patch
     return kTrue_FilterReturn;
@@ -1653,6 +1653,53 @@ bool SkCanvas::quickReject(const SkRect& src) const {
     return is_nan_or_clipped(devRect, Sk4f::Load(&fDeviceClipBounds.fLeft));
 }
 
+int SkCanvas::quickRejectRects(const SkRect rects[], int count, bool rejected[]) const {
+    int i = 0;
+    int rejectedCount = 0;
+#if !defined(SKNX_NO_SIMD) && \
+    (SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2 || defined(SK_ARM_HAS_NEON))
+    if (fIsScaleTranslate) {
+        Sk4f sx(fMCRec->fMatrix.getScaleX()),
+             sy(fMCRec->fMatrix.getScaleY()),
+             tx(fMCRec->fMatrix.getTranslateX()),
+             ty(fMCRec->fMatrix.getTranslateY());
+        Sk4f clipL(fDeviceClipBounds.fLeft),
+             clipT(fDeviceClipBounds.fTop),
+             clipR(fDeviceClipBounds.fRight),
+             clipB(fDeviceClipBounds.fBottom);
+        for (; i + 4 <= count; i += 4) {
+            // Transpose four rects into their lefts, tops, rights and bottoms.
+            Sk4f l, t, r, b;
+            Sk4f::Load4(&rects[i], &l, &t, &r, &b);
+            l = l * sx + tx;
+            r = r * sx + tx;
+            t = t * sy + ty;
+            b = b * sy + ty;
+
+            // The same min/max (operand order matters for NaNs) and tests as quickReject(rect)
+            // with the SIMD is_nan_or_clipped(), so NaNs are rejected.
+            Sk4f devL = Sk4f::Min(r, l), devR = Sk4f::Max(l, r),
+                 devT = Sk4f::Min(b, t), devB = Sk4f::Max(t, b);
+            Sk4f inside = (devL < clipR).thenElse(1.0f, 0.0f) *
+                          (clipL < devR).thenElse(1.0f, 0.0f) *
+                          (devT < clipB).thenElse(1.0f, 0.0f) *
+                          (clipT < devB).thenElse(1.0f, 0.0f);
+            float in[4];
+            inside.store(in);
+            for (int j = 0; j < 4; ++j) {
+                rejected[i + j] = 0 == in[j];
+                rejectedCount += rejected[i + j];
+            }
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        rejected[i] = this->quickReject(rects[i]);
+        rejectedCount += rejected[i];
+    }
+    return rejectedCount;
+}
+
 bool SkCanvas::quickReject(const SkPath& path) const {
     return path.isEmpty() || this->quickReject(path.getBounds());
 }
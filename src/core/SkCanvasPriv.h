@@ -47,6 +47,12 @@ public:
         canvas->drawClippedToSaveBehind(paint);
     }
 
+    // Sets rejected[i] to canvas.quickReject(rects[i]), and returns the number rejected.
+    static int QuickReject(const SkCanvas& canvas, const SkRect rects[], int count,
+                           bool rejected[]) {
+        return canvas.quickRejectRects(rects, count, rejected);
+    }
+
     // The experimental_DrawEdgeAAImageSet API accepts separate dstClips and preViewMatrices arrays,
     // where entries refer into them, but no explicit size is provided. Given a set of entries,
     // computes the minimum length for these arrays that would provide index access errors.
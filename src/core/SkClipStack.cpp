@@ -33,6 +33,9 @@ SkClipStack::Element::Element(const Element& that) {
             break;
     }
 
+    fSourcePathGenID = that.fSourcePathGenID;
+    fSourceMatrix = that.fSourceMatrix;
+
     fSaveCount = that.fSaveCount;
     fOp = that.fOp;
     fDeviceSpaceType = that.fDeviceSpaceType;
@@ -157,6 +160,7 @@ void SkClipStack::Element::initCommon(int saveCount, SkClipOp op, bool doAA) {
     fFiniteBound.setEmpty();
     fIsIntersectionOfRects = false;
     fGenID = kInvalidGenID;
+    fSourcePathGenID = SK_InvalidGenID;
 }
 
 void SkClipStack::Element::initRect(int saveCount, const SkRect& rect, const SkMatrix& m,
@@ -218,6 +222,10 @@ void SkClipStack::Element::initAsPath(int saveCount, const SkPath& path, const S
     fDeviceSpacePath.get()->setIsVolatile(true);
     fDeviceSpaceType = DeviceSpaceType::kPath;
     this->initCommon(saveCount, op, doAA);
+    if (!path.isVolatile()) {
+        fSourcePathGenID = path.getGenerationID();
+        fSourceMatrix = m;
+    }
 }
 
 void SkClipStack::Element::asDeviceSpacePath(SkPath* path) const {
@@ -247,6 +255,7 @@ void SkClipStack::Element::setEmpty() {
     fIsIntersectionOfRects = false;
     fDeviceSpaceRRect.setEmpty();
     fDeviceSpacePath.reset();
+    fSourcePathGenID = SK_InvalidGenID;
     fGenID = kEmptyGenID;
     SkDEBUGCODE(this->checkEmpty();)
 }
@@ -126,6 +126,18 @@ public:
             return fDeviceSpaceRRect;
         }
 
+        /** If getDeviceSpaceType() is kPath, and the element was made from a path that isn't
+            volatile, this is that path's generation ID. Together with getSourceMatrix() it
+            identifies the device space path. Otherwise it is SK_InvalidGenID. */
+        uint32_t getSourcePathGenID() const { return fSourcePathGenID; }
+
+        //!< Call if getSourcePathGenID() is valid to get the matrix that took the path to device
+        //!< space.
+        const SkMatrix& getSourceMatrix() const {
+            SkASSERT(SK_InvalidGenID != fSourcePathGenID);
+            return fSourceMatrix;
+        }
+
         /** If getType() is not kEmpty this indicates whether the clip shape should be anti-aliased
             when it is rasterized. */
         bool isAA() const { return fDoAA; }
@@ -195,6 +207,8 @@ public:
 
         SkTLazy<SkPath> fDeviceSpacePath;
         SkRRect fDeviceSpaceRRect;
+        uint32_t fSourcePathGenID;
+        SkMatrix fSourceMatrix;
         int fSaveCount;  // save count of stack when this element was added.
         SkClipOp fOp;
         DeviceSpaceType fDeviceSpaceType;
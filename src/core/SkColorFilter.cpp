@@ -32,6 +32,10 @@ bool SkColorFilter::onAsAColorMatrix(float matrix[20]) const {
     return false;
 }
 
+sk_sp<SkColorFilter> SkColorFilter::onMakeComposed(const SkColorFilter&) const {
+    return nullptr;
+}
+
 #if SK_SUPPORT_GPU
 std::unique_ptr<GrFragmentProcessor> SkColorFilter::asFragmentProcessor(
         GrRecordingContext*, const GrColorSpaceInfo&) const {
@@ -155,6 +159,9 @@ sk_sp<SkColorFilter> SkColorFilter::makeComposed(sk_sp<SkColorFilter> inner) con
     if (!inner) {
         return sk_ref_sp(this);
     }
+    if (sk_sp<SkColorFilter> folded = this->onMakeComposed(*inner)) {
+        return folded;
+    }
 
     int count = inner->privateComposedFilterCount() + this->privateComposedFilterCount();
     if (count > SK_MAX_COMPOSE_COLORFILTER_COUNT) {
@@ -364,10 +371,60 @@ sk_sp<SkColorFilter> SkColorFilters::Lerp(float weight, sk_sp<SkColorFilter> cf0
 
 #if SK_SUPPORT_GPU
 #include "include/private/GrRecordingContext.h"
+#include "include/private/SkMutex.h"
+#include "src/core/SkLRUCache.h"
 #include "src/gpu/effects/GrSkSLFP.h"
 #include "src/sksl/SkSLByteCode.h"
 #include "src/sksl/SkSLInterpreter.h"
 
+namespace {
+
+// A runtime color filter's SkSL, compiled for the interpreter. Nothing in it changes after it is
+// compiled, so every filter (on any thread) with the same source shares one copy.
+struct CompiledSkSL : public SkNVRefCnt<CompiledSkSL> {
+    std::unique_ptr<SkSL::Program>  fProgram;
+    std::unique_ptr<SkSL::ByteCode> fByteCode;
+};
+
+}  // anonymous namespace
+
+// Returns the compiled form of 'sksl', compiling it only if it isn't in the cache already. Every
+// runtime color filter is compiled as a pipeline stage with the default settings, so the source
+// alone is the key.
+static sk_sp<CompiledSkSL> find_or_compile_sksl(const SkString& sksl) {
+    static constexpr int kMaxCachedPrograms = 64;
+    static SkMutex gCacheMutex;
+    static auto* gCache = new SkLRUCache<SkString, sk_sp<CompiledSkSL>>(kMaxCachedPrograms);
+
+    {
+        SkAutoMutexExclusive lock(gCacheMutex);
+        if (sk_sp<CompiledSkSL>* compiled = gCache->find(sksl)) {
+            return *compiled;
+        }
+    }
+
+    // Compile without holding the lock. If another thread compiles the same source meanwhile,
+    // we keep whichever copy reaches the cache first.
+    SkSL::Compiler c;
+    auto compiled = sk_make_sp<CompiledSkSL>();
+    compiled->fProgram = c.convertProgram(SkSL::Program::kPipelineStage_Kind,
+                                          SkSL::String(sksl.c_str()), SkSL::Program::Settings());
+    if (compiled->fProgram) {
+        compiled->fByteCode = c.toByteCode(*compiled->fProgram);
+    }
+    if (c.errorCount() || !compiled->fByteCode) {
+        SkDebugf("%s\n", c.errorText().c_str());
+        SkASSERT(false);
+        return nullptr;
+    }
+
+    SkAutoMutexExclusive lock(gCacheMutex);
+    if (sk_sp<CompiledSkSL>* existing = gCache->find(sksl)) {
+        return *existing;
+    }
+    return *gCache->insert(sksl, std::move(compiled));
+}
+
 class SkRuntimeColorFilter : public SkColorFilter {
 public:
     SkRuntimeColorFilter(int index, SkString sksl, sk_sp<SkData> inputs,
@@ -404,31 +461,37 @@ public:
             rec.fPipeline->append(SkRasterPipeline::callback, ctx);
         } else {
             struct InterpreterCtx : public SkRasterPipeline_CallbackCtx {
+                sk_sp<CompiledSkSL> compiled;
                 SkSL::ByteCodeFunction* main;
                 std::unique_ptr<SkSL::Interpreter> interpreter;
                 const void* inputs;
             };
+            sk_sp<CompiledSkSL> compiled = find_or_compile_sksl(fSkSL);
+            if (!compiled) {
+                return false;
+            }
             auto ctx = rec.fAlloc->make<InterpreterCtx>();
             ctx->inputs = fInputs->data();
-            SkSL::Compiler c;
-            std::unique_ptr<SkSL::Program> prog =
-                                                c.convertProgram(SkSL::Program::kPipelineStage_Kind,
-                                                                 SkSL::String(fSkSL.c_str()),
-                                                                 SkSL::Program::Settings());
-            if (c.errorCount()) {
-                SkDebugf("%s\n", c.errorText().c_str());
-                SkASSERT(false);
-            }
-            std::unique_ptr<SkSL::ByteCode> byteCode = c.toByteCode(*prog);
-            ctx->main = byteCode->fFunctions[0].get();
-            ctx->interpreter.reset(new SkSL::Interpreter(std::move(prog), std::move(byteCode),
+            ctx->compiled = std::move(compiled);
+            ctx->main = ctx->compiled->fByteCode->fFunctions[0].get();
+            ctx->interpreter.reset(new SkSL::Interpreter(ctx->compiled->fByteCode.get(),
                                                          (SkSL::Interpreter::Value*) ctx->inputs));
             ctx->fn = [](SkRasterPipeline_CallbackCtx* arg, int active_pixels) {
                 auto ctx = (InterpreterCtx*)arg;
+                // The interpreter wants one array per channel, so it can run every pixel at once.
+                SkSL::Interpreter::Value channels[4][SkRasterPipeline_kMaxStride];
+                for (int i = 0; i < active_pixels; i++) {
+                    for (int c = 0; c < 4; c++) {
+                        channels[c][i] = ctx->rgba[i * 4 + c];
+                    }
+                }
+                SkSL::Interpreter::Value* args[] = { channels[0], channels[1], channels[2],
+                                                     channels[3] };
+                ctx->interpreter->runStriped(*ctx->main, active_pixels, args, nullptr);
                 for (int i = 0; i < active_pixels; i++) {
-                    ctx->interpreter->run(*ctx->main,
-                                          (SkSL::Interpreter::Value*) (ctx->rgba + i * 4),
-                                          nullptr);
+                    for (int c = 0; c < 4; c++) {
+                        ctx->rgba[i * 4 + c] = channels[c][i].fFloat;
+                    }
                 }
             };
             rec.fPipeline->append(SkRasterPipeline::callback, ctx);
@@ -51,6 +51,39 @@ bool SkColorFilter_Matrix::onAsAColorMatrix(float matrix[20]) const {
     return true;
 }
 
+sk_sp<SkColorFilter> SkColorFilter_Matrix::onMakeComposed(const SkColorFilter& inner) const {
+    float innerMatrix[20];
+    if (!inner.asAColorMatrix(innerMatrix)) {
+        return nullptr;
+    }
+    // Applying the product skips the inner filter's premul and our unpremul, and its clamp.
+    // With alpha left alone by both, the premul/unpremul only matters where alpha is 0, and
+    // there the final premul zeroes the color either way. The clamp can be skipped if the inner
+    // matrix keeps colors in [0,1] anyway (e.g. grayscale, sepia or darkening), allowing for
+    // float error in rows meant to sum to 1.
+    if (!(fFlags & kAlphaUnchanged_Flag) ||
+        !(inner.getFlags() & kAlphaUnchanged_Flag)) {
+        return nullptr;
+    }
+    for (int row = 0; row < 3; ++row) {
+        const float* m = innerMatrix + 5 * row;
+        float lo = m[4],
+              hi = m[4];
+        for (int i = 0; i < 4; ++i) {
+            (m[i] < 0 ? lo : hi) += m[i];
+        }
+        if (lo < -SK_ScalarNearlyZero || hi > 1 + SK_ScalarNearlyZero) {
+            return nullptr;
+        }
+    }
+
+    SkColorMatrix outerCM, innerCM, product;
+    outerCM.setRowMajor(fMatrix);
+    innerCM.setRowMajor(innerMatrix);
+    product.setConcat(outerCM, innerCM);
+    return SkColorFilters::Matrix(product);
+}
+
 bool SkColorFilter_Matrix::onAppendStages(const SkStageRec& rec,
                                                     bool shaderIsOpaque) const {
     const bool willStayOpaque = shaderIsOpaque && (fFlags & kAlphaUnchanged_Flag);
@@ -28,6 +28,7 @@ public:
 protected:
     void flatten(SkWriteBuffer&) const override;
     bool onAsAColorMatrix(float matrix[20]) const override;
+    sk_sp<SkColorFilter> onMakeComposed(const SkColorFilter& inner) const override;
 
 private:
     SK_FLATTENABLE_HOOKS(SkColorFilter_Matrix)
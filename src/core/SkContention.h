@@ -0,0 +1,33 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkContention_DEFINED
+#define SkContention_DEFINED
+
+#include <atomic>
+#include <cstdint>
+
+// How often threads have had to wait for Skia's locks, e.g. for nanobench to show why a bench
+// stops scaling as threads are added. The counts are only bumped on the slow paths, once a
+// lock was found to be held, so they cost nothing when there's no contention.
+//
+// SkMutex and SkSharedMutex wait on SkSemaphores, so their waits are counted as semaphore waits,
+// along with any other semaphore that had to block (e.g. an idle SkExecutor thread).
+extern std::atomic<uint64_t> gSkSpinlockContendedAcquires;
+extern std::atomic<uint64_t> gSkSemaphoreContendedWaits;
+
+struct SkContentionCounts {
+    uint64_t fSpinlockAcquires;
+    uint64_t fSemaphoreWaits;
+};
+
+static inline SkContentionCounts SkGetContentionCounts() {
+    return {gSkSpinlockContendedAcquires.load(std::memory_order_relaxed),
+            gSkSemaphoreContendedWaits.load(std::memory_order_relaxed)};
+}
+
+#endif
@@ -0,0 +1,116 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkContourMeasureCache.h"
+
+#include "include/private/SkPathRef.h"
+#include "src/core/SkPathPriv.h"
+#include "src/core/SkResourceCache.h"
+
+#include <cstring>
+
+#define CHECK_LOCAL(localCache, localName, globalName, ...) \
+    ((localCache) ? localCache->localName(__VA_ARGS__) : SkResourceCache::globalName(__VA_ARGS__))
+
+namespace {
+static unsigned gContourMeasureKeyNamespaceLabel;
+
+static uint64_t shared_id(uint32_t pathGenID) {
+    uint64_t sharedID = SkSetFourByteTag('c', 'm', 's', 'r');
+    return (sharedID << 32) | pathGenID;
+}
+
+struct ContourMeasureKey : public SkResourceCache::Key {
+    ContourMeasureKey(uint32_t genID, bool forceClosed, SkScalar resScale)
+        : fGenID(genID)
+        , fForceClosed(forceClosed) {
+        memcpy(&fResScale, &resScale, sizeof(fResScale));
+        this->init(&gContourMeasureKeyNamespaceLabel, shared_id(genID),
+                   sizeof(fGenID) + sizeof(fForceClosed) + sizeof(fResScale));
+    }
+
+    uint32_t fGenID;
+    int32_t  fForceClosed;
+    uint32_t fResScale;
+};
+
+struct ContourMeasureValue {
+    SkTArray<sk_sp<SkContourMeasure>>* fContours;
+    SkScalar                           fLength;
+};
+
+struct ContourMeasureRec : public SkResourceCache::Rec {
+    ContourMeasureRec(const ContourMeasureKey& key,
+                      const SkTArray<sk_sp<SkContourMeasure>>& contours, SkScalar length,
+                      size_t bytes)
+        : fKey(key), fContours(contours), fLength(length), fBytes(bytes) {}
+
+    ContourMeasureKey                 fKey;
+    SkTArray<sk_sp<SkContourMeasure>> fContours;
+    SkScalar                          fLength;
+    size_t                            fBytes;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override { return sizeof(*this) + fBytes; }
+    const char* getCategory() const override { return "contour-measure"; }
+    SkDiscardableMemory* diagnostic_only_getDiscardable() const override { return nullptr; }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* context) {
+        const ContourMeasureRec& rec = static_cast<const ContourMeasureRec&>(baseRec);
+        ContourMeasureValue* value = static_cast<ContourMeasureValue*>(context);
+        *value->fContours = rec.fContours;
+        value->fLength = rec.fLength;
+        return true;
+    }
+};
+
+// Purges a path's entries once the path changes or goes away. Otherwise they would sit in the
+// cache, unreachable, until they aged out.
+class PurgeOnChange : public SkPathRef::GenIDChangeListener {
+public:
+    explicit PurgeOnChange(uint32_t genID) : fSharedID(shared_id(genID)) {}
+
+    void onChange() override { SkResourceCache::PostPurgeSharedID(fSharedID); }
+
+private:
+    uint64_t fSharedID;
+};
+} // namespace
+
+SkScalar SkContourMeasureCache::Find(const SkPath& path, bool forceClosed, SkScalar resScale,
+                                     SkTArray<sk_sp<SkContourMeasure>>* contours,
+                                     SkResourceCache* localCache) {
+    contours->reset();
+    // Empty paths all share one generation ID, and have nothing to measure anyway.
+    if (path.isEmpty()) {
+        return 0;
+    }
+
+    const bool cacheable = !path.isVolatile();
+    ContourMeasureKey key(path.getGenerationID(), forceClosed, resScale);
+    ContourMeasureValue value = { contours, 0 };
+    if (cacheable && CHECK_LOCAL(localCache, find, Find, key, ContourMeasureRec::Visitor,
+                                 &value)) {
+        return value.fLength;
+    }
+
+    SkScalar length = 0;
+    size_t bytes = 0;
+    SkContourMeasureIter iter(path, forceClosed, resScale);
+    while (sk_sp<SkContourMeasure> contour = iter.next()) {
+        length += contour->length();
+        bytes += sizeof(SkContourMeasure) + contour->bytesUsed();
+        contours->push_back(std::move(contour));
+    }
+
+    if (cacheable) {
+        SkPathPriv::AddGenIDChangeListener(path,
+                                           sk_make_sp<PurgeOnChange>(path.getGenerationID()));
+        CHECK_LOCAL(localCache, add, Add, new ContourMeasureRec(key, *contours, length, bytes));
+    }
+    return length;
+}
@@ -0,0 +1,36 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkContourMeasureCache_DEFINED
+#define SkContourMeasureCache_DEFINED
+
+#include "include/core/SkContourMeasure.h"
+#include "include/private/SkTArray.h"
+
+class SkResourceCache;
+
+/**
+ *  Shares the contours of a path, as measured by SkContourMeasureIter, between everything that
+ *  measures the same path. Trim and text-on-path animations measure the same path every frame;
+ *  this measures it once per generation of the path.
+ */
+class SkContourMeasureCache {
+public:
+    /**
+     *  Fills 'contours' with what SkContourMeasureIter(path, forceClosed, resScale) returns, in
+     *  order, and returns their total length. The contours are immutable and may be shared with
+     *  other threads.
+     *
+     *  Results are kept in SkResourceCache keyed on the path's generation ID, and are purged when
+     *  the path is edited or deleted. Volatile paths are measured every time.
+     */
+    static SkScalar Find(const SkPath& path, bool forceClosed, SkScalar resScale,
+                         SkTArray<sk_sp<SkContourMeasure>>* contours,
+                         SkResourceCache* localCache = nullptr);
+};
+
+#endif
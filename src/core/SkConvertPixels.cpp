@@ -160,6 +160,114 @@ static bool convert_to_alpha8(const SkImageInfo& dstInfo,       void* vdst, size
     return false;
 }
 
+// Converts 8888 pixels between color spaces where neither has to unpremul or premul, e.g. opaque
+// decoded images going to another gamut. Each source channel has only 256 values, so linearizing
+// is a table lookup. Encoding finds the byte a linear value rounds to among the linear values
+// halfway between each pair of encoded bytes, starting from a table over even slices of [0,1]
+// that leaves only a step or two of search. Without a gamut transform each channel's whole trip
+// fits into one 256 entry table.
+static bool xform_8888_with_tables(const SkImageInfo& dstInfo,       void* dstPixels, size_t dstRB,
+                                   const SkImageInfo& srcInfo, const void* srcPixels, size_t srcRB,
+                                     const SkColorSpaceXformSteps& steps) {
+    auto is_8888 = [](SkColorType ct) {
+        return ct == kRGBA_8888_SkColorType || ct == kBGRA_8888_SkColorType;
+    };
+    if (!is_8888(dstInfo.colorType()) ||
+        !is_8888(srcInfo.colorType()) ||
+        steps.flags.unpremul          ||
+        steps.flags.premul            ||
+        !(steps.flags.linearize || steps.flags.gamut_transform || steps.flags.encode)) {
+        return false;
+    }
+    // Building the tables costs about as much as converting this many pixels in the pipeline.
+    static constexpr int64_t kMinPixelsForTables = 4096;
+    if ((int64_t)dstInfo.width() * dstInfo.height() < kMinPixelsForTables) {
+        return false;
+    }
+
+    // thresholds[k] is the linear value that encodes to k + 0.5, past which x encodes to k + 1.
+    float thresholds[256];
+    skcms_TransferFunction dstTF;
+    if (steps.flags.encode && !skcms_TransferFunction_invert(&steps.dstTFInv, &dstTF)) {
+        return false;
+    }
+    for (int k = 0; k < 255; k++) {
+        thresholds[k] = (k + 0.5f) * (1 / 255.0f);
+        if (steps.flags.encode) {
+            thresholds[k] = skcms_TransferFunction_eval(&dstTF, thresholds[k]);
+        }
+    }
+    thresholds[255] = SK_FloatInfinity;
+
+    // Slices this thin mostly hold at most one threshold (e.g. all of them for sRGB encoding).
+    static constexpr int kEncodeSlices = 4096;
+    uint8_t sliceStart[kEncodeSlices];
+    for (int i = 0, k = 0; i < kEncodeSlices; i++) {
+        while (i * (1.0f / kEncodeSlices) >= thresholds[k]) {
+            k++;
+        }
+        sliceStart[i] = k;
+    }
+
+    auto encode = [&](float x) -> uint32_t {
+        x = SkTPin(x, 0.0f, 1.0f);
+        int k = sliceStart[std::min((int)(x * kEncodeSlices), kEncodeSlices - 1)];
+        k += x >= thresholds[k];
+        while (x >= thresholds[k]) {
+            k++;
+        }
+        while (k > 0 && x < thresholds[k - 1]) {
+            k--;
+        }
+        return k;
+    };
+
+    float linear[256];
+    for (int i = 0; i < 256; i++) {
+        linear[i] = i * (1 / 255.0f);
+        if (steps.flags.linearize) {
+            linear[i] = skcms_TransferFunction_eval(&steps.srcTF, linear[i]);
+        }
+    }
+
+    uint8_t table[256];
+    if (!steps.flags.gamut_transform) {
+        for (int i = 0; i < 256; i++) {
+            table[i] = encode(linear[i]);
+        }
+    }
+
+    const int srcR = srcInfo.colorType() == kRGBA_8888_SkColorType ? 0 : 16,
+              srcB = 16 - srcR,
+              dstR = dstInfo.colorType() == kRGBA_8888_SkColorType ? 0 : 16,
+              dstB = 16 - dstR;
+    const float* m = steps.src_to_dst_matrix;
+    for (int y = 0; y < dstInfo.height(); y++) {
+        auto src = (const uint32_t*)srcPixels;
+        auto dst = (uint32_t*)dstPixels;
+        for (int x = 0; x < dstInfo.width(); x++) {
+            const uint32_t s = src[x];
+            uint32_t r = (s >> srcR) & 0xff,
+                     g = (s >>    8) & 0xff,
+                     b = (s >> srcB) & 0xff;
+            if (steps.flags.gamut_transform) {
+                const float lr = linear[r], lg = linear[g], lb = linear[b];
+                r = encode(m[0] * lr + m[3] * lg + m[6] * lb);
+                g = encode(m[1] * lr + m[4] * lg + m[7] * lb);
+                b = encode(m[2] * lr + m[5] * lg + m[8] * lb);
+            } else {
+                r = table[r];
+                g = table[g];
+                b = table[b];
+            }
+            dst[x] = (s & 0xff000000) | (r << dstR) | (g << 8) | (b << dstB);
+        }
+        dstPixels = SkTAddOffset<void>(dstPixels, dstRB);
+        srcPixels = SkTAddOffset<const void>(srcPixels, srcRB);
+    }
+    return true;
+}
+
 // Default: Use the pipeline.
 static void convert_with_pipeline(const SkImageInfo& dstInfo, void* dstRow, size_t dstRB,
                                   const SkImageInfo& srcInfo, const void* srcRow, size_t srcRB,
@@ -186,7 +294,7 @@ void SkConvertPixels(const SkImageInfo& dstInfo,       void* dstPixels, size_t d
     SkColorSpaceXformSteps steps{srcInfo.colorSpace(), srcInfo.alphaType(),
                                  dstInfo.colorSpace(), dstInfo.alphaType()};
 
-    for (auto fn : {rect_memcpy, swizzle_or_premul, convert_to_alpha8}) {
+    for (auto fn : {rect_memcpy, swizzle_or_premul, convert_to_alpha8, xform_8888_with_tables}) {
         if (fn(dstInfo, dstPixels, dstRB, srcInfo, srcPixels, srcRB, steps)) {
             return;
         }
@@ -9,6 +9,7 @@
 #include "include/core/SkString.h"
 #include "include/private/SkOnce.h"
 #include "src/core/SkCpu.h"
+#include "src/core/SkPerfCounters.h"
 
 #if defined(SK_CPU_X86)
     #if defined(SK_BUILD_FOR_WIN)
@@ -156,5 +157,8 @@ uint32_t SkCpu::gCachedFeatures = 0;
 
 void SkCpu::CacheRuntimeFeatures() {
     static SkOnce once;
-    once([] { gCachedFeatures = read_cpu_features(); });
+    once([] {
+        SkPerfCounters::AutoInitPhase phase(SkGraphics::InitPhase::kCpuFeatures);
+        gCachedFeatures = read_cpu_features();
+    });
 }
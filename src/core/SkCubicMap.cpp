@@ -185,6 +185,58 @@ float SkCubicMap::computeYFromX(float x) const {
     return y;
 }
 
+// Four lanes of solve_nice_cubic_halley(A, B, C, -x), each lane stopping where the scalar
+// version would.
+static Sk4f solve_nice_cubic_halley4(float A, float B, float C, const Sk4f& x) {
+    const int MAX_ITERS = 8;
+    const float A3 = 3 * A;
+    const float B2 = B + B;
+    const Sk4f D = -x;
+
+    Sk4f t = x;     // guess_nice_cubic_root()
+    Sk4f done = 0;  // lane mask
+    for (int iters = 0; iters < MAX_ITERS; ++iters) {
+        Sk4f f   = ((A * t + B) * t + C) * t + D;
+        Sk4f fp  = (A3 * t + B2) * t + C;
+        Sk4f fpp = (A3 + A3) * t + B2;
+
+        Sk4f numer = 2.0f * fp * f;
+        Sk4f denom = 2.0f * fp * fp - f * fpp;
+        Sk4f delta = numer / denom;
+
+        const Sk4f numer_zero  = numer == 0,
+                   delta_small = delta.abs() <= 0.0001f;
+        done = numer_zero .thenElse(numer_zero , done);
+        done = delta_small.thenElse(delta_small, done);
+        if (done.allTrue()) {
+            break;
+        }
+        t = done.thenElse(t, t - delta);
+    }
+    return t;
+}
+
+void SkCubicMap::computeYFromX(const float xs[], float ys[], int count) const {
+    int i = 0;
+    if (fType == kSolver_Type) {
+        const float a = fCoeff[0].fY,
+                    b = fCoeff[1].fY,
+                    c = fCoeff[2].fY;
+        for (; i + 4 <= count; i += 4) {
+            const Sk4f x = Sk4f::Min(Sk4f::Max(Sk4f::Load(xs + i), 0), 1);
+            const Sk4f t = solve_nice_cubic_halley4(fCoeff[0].fX, fCoeff[1].fX, fCoeff[2].fX, x);
+            const Sk4f y = ((a * t + b) * t + c) * t;
+
+            // Like computeYFromX(), ends map to themselves.
+            const Sk4f ends = Sk4f::Min(x, 1.0f - x) <= 0.0000000001f;
+            ends.thenElse(x, y).store(ys + i);
+        }
+    }
+    for (; i < count; ++i) {
+        ys[i] = this->computeYFromX(xs[i]);
+    }
+}
+
 static inline bool coeff_nearly_zero(float delta) {
     return sk_float_abs(delta) <= 0.0000001f;
 }
@@ -28,6 +28,7 @@ class SkRegion;
 class SkRasterClip;
 struct SkRect;
 class SkRRect;
+class SkSolidBlitterCache;
 
 class SkDraw : public SkGlyphRunListPainter::BitmapDevicePainter {
 public:
@@ -161,6 +162,9 @@ public:
     // optional, will be same dimensions as fDst if present
     const SkPixmap* fCoverage{nullptr};
 
+    // optional, lets consecutive draws with the same solid paint share one blitter
+    SkSolidBlitterCache* fBlitterCache{nullptr};
+
 #ifdef SK_DEBUG
     void validate() const;
 #else
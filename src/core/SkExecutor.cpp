@@ -10,7 +10,9 @@
 #include "include/private/SkSemaphore.h"
 #include "include/private/SkSpinlock.h"
 #include "include/private/SkTArray.h"
+#include "include/private/SkTemplates.h"
 #include "src/core/SkMakeUnique.h"
+#include <atomic>
 #include <deque>
 #include <thread>
 
@@ -30,8 +32,11 @@
 
 SkExecutor::~SkExecutor() {}
 
+constexpr int SkExecutor::kPriorityCount;
+
 // The default default SkExecutor is an SkTrivialExecutor, which just runs the work right away.
 class SkTrivialExecutor final : public SkExecutor {
+    using SkExecutor::add;
     void add(std::function<void(void)> work) override {
         work();
     }
@@ -90,6 +95,7 @@ public:
         }
     }
 
+    using SkExecutor::add;
     virtual void add(std::function<void(void)> work) override {
         // Add some work to our pile of work to do.
         {
@@ -141,6 +147,136 @@ private:
     SkSemaphore           fWorkAvailable;
 };
 
+// An SkWorkStealingThreadPool keeps a deque of work per thread and priority, so threads adding
+// and taking work mostly contend for their own locks.  Each thread takes the newest work from its
+// own deques, and steals the oldest work from the others' when they're empty, trying high
+// priority work everywhere before normal priority work.  Work is added to the deques of the
+// thread adding it, or spread over the threads when added from outside the pool.
+class SkWorkStealingThreadPool final : public SkExecutor {
+public:
+    explicit SkWorkStealingThreadPool(int threads) : fWorkers(threads), fWorkerCount(threads) {
+        for (int i = 0; i < threads; i++) {
+            fThreads.emplace_back(&Loop, this, i);
+        }
+        // The threads can't look themselves up until all their IDs are known.
+        for (int i = 0; i < threads; i++) {
+            fWorkers[i].fThreadID = fThreads[i].get_id();
+        }
+        fIDsKnown.signal(threads);
+    }
+
+    ~SkWorkStealingThreadPool() override {
+        // Wake each thread, to find that there's no more work and shut down.
+        fShuttingDown.store(true, std::memory_order_release);
+        fWorkAvailable.signal(fWorkerCount);
+        for (int i = 0; i < fThreads.count(); i++) {
+            fThreads[i].join();
+        }
+    }
+
+    void add(std::function<void(void)> work) override {
+        this->add(std::move(work), Priority::kNormal);
+    }
+
+    void add(std::function<void(void)> work, Priority priority) override {
+        int worker = this->currentWorker();
+        if (worker < 0) {
+            worker = fNextWorker.fetch_add(1, std::memory_order_relaxed) % fWorkerCount;
+        }
+        {
+            SkAutoSpinlock lock(fWorkers[worker].fLock);
+            fWorkers[worker].fWork[(int)priority].emplace_back(std::move(work));
+        }
+        fWorkAvailable.signal(1);
+    }
+
+    void borrow() override {
+        if (fWorkAvailable.try_wait()) {
+            SkAssertResult(this->doWork(this->currentWorker()));
+        }
+    }
+
+private:
+    using WorkList = std::deque<std::function<void(void)>>;
+
+    struct Worker {
+        std::thread::id fThreadID;
+        SkSpinlock      fLock;
+        WorkList        fWork[kPriorityCount];
+    };
+
+    // Returns the index of the calling thread's worker, or -1 if it's not one of ours.
+    int currentWorker() const {
+        std::thread::id id = std::this_thread::get_id();
+        for (int i = 0; i < fWorkerCount; i++) {
+            if (fWorkers[i].fThreadID == id) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    std::function<void(void)> findWork(int self) {
+        for (int priority = kPriorityCount - 1; priority >= 0; priority--) {
+            if (self >= 0) {
+                SkAutoSpinlock lock(fWorkers[self].fLock);
+                WorkList& own = fWorkers[self].fWork[priority];
+                if (!own.empty()) {
+                    std::function<void(void)> work = std::move(own.back());
+                    own.pop_back();
+                    return work;
+                }
+            }
+            for (int i = 1; i <= fWorkerCount; i++) {
+                int victim = (SkTMax(self, 0) + i) % fWorkerCount;
+                if (victim == self) {
+                    continue;
+                }
+                SkAutoSpinlock lock(fWorkers[victim].fLock);
+                WorkList& theirs = fWorkers[victim].fWork[priority];
+                if (!theirs.empty()) {
+                    std::function<void(void)> work = std::move(theirs.front());
+                    theirs.pop_front();
+                    return work;
+                }
+            }
+        }
+        return nullptr;
+    }
+
+    // This method should be called only when fWorkAvailable indicates there's work to do.
+    // Returns false if there's no work because the pool is shutting down.
+    bool doWork(int self) {
+        // Every signal of fWorkAvailable is matched by work in some deque, but another thread may
+        // take it from under our scan and leave us the work it was signaled for, elsewhere.
+        std::function<void(void)> work = this->findWork(self);
+        while (!work) {
+            if (fShuttingDown.load(std::memory_order_acquire)) {
+                return false;
+            }
+            std::this_thread::yield();
+            work = this->findWork(self);
+        }
+        work();
+        return true;
+    }
+
+    static void Loop(SkWorkStealingThreadPool* pool, int self) {
+        pool->fIDsKnown.wait();
+        do {
+            pool->fWorkAvailable.wait();
+        } while (pool->doWork(self));
+    }
+
+    SkAutoTArray<Worker>  fWorkers;
+    const int             fWorkerCount;
+    SkTArray<std::thread> fThreads;
+    std::atomic<int>      fNextWorker{0};
+    std::atomic<bool>     fShuttingDown{false};
+    SkSemaphore           fIDsKnown;
+    SkSemaphore           fWorkAvailable;
+};
+
 std::unique_ptr<SkExecutor> SkExecutor::MakeFIFOThreadPool(int threads) {
     using WorkList = std::deque<std::function<void(void)>>;
     return skstd::make_unique<SkThreadPool<WorkList>>(threads > 0 ? threads : num_cores());
@@ -149,3 +285,6 @@ std::unique_ptr<SkExecutor> SkExecutor::MakeLIFOThreadPool(int threads) {
     using WorkList = SkTArray<std::function<void(void)>>;
     return skstd::make_unique<SkThreadPool<WorkList>>(threads > 0 ? threads : num_cores());
 }
+std::unique_ptr<SkExecutor> SkExecutor::MakeWorkStealingThreadPool(int threads) {
+    return skstd::make_unique<SkWorkStealingThreadPool>(threads > 0 ? threads : num_cores());
+}
@@ -324,6 +324,58 @@ void SkFont::getWidthsBounds(const SkGlyphID glyphs[], int count, SkScalar width
     }
 }
 
+void SkFont::getWidthsBoundsPaths(const SkGlyphID glyphs[], int count, SkScalar widths[],
+                                  SkRect bounds[], SkPath paths[], const SkPaint* paint) const {
+    if (!paths) {
+        this->getWidthsBounds(glyphs, count, widths, bounds, paint);
+        return;
+    }
+    if (count <= 0) {
+        return;
+    }
+
+    SkFont pathFont(*this);
+    const SkScalar pathScale = pathFont.setupForAsPaths(nullptr);
+    const SkMatrix pathMatrix = SkMatrix::MakeScale(pathScale, pathScale);
+    SkStrikeSpecStorage pathSpec = SkStrikeSpecStorage::MakeCanonicalized(pathFont);
+    auto pathStrike = pathSpec.findOrCreateExclusiveStrike();
+
+    // Text drawn as paths (large text, say) is measured with the path strike too, in which case
+    // one lookup per glyph serves everything.
+    SkStrike* metricsStrike = nullptr;
+    SkExclusiveStrikePtr metricsStrikeStorage;
+    SkScalar metricsScale = 1;
+    if (widths || bounds) {
+        SkStrikeSpecStorage metricsSpec = SkStrikeSpecStorage::MakeCanonicalized(*this, paint);
+        metricsScale = metricsSpec.strikeToSourceRatio();
+        if (metricsSpec.descriptor() == pathSpec.descriptor()) {
+            metricsStrike = pathStrike.get();
+        } else {
+            metricsStrikeStorage = metricsSpec.findOrCreateExclusiveStrike();
+            metricsStrike = metricsStrikeStorage.get();
+        }
+    }
+
+    for (int i = 0; i < count; ++i) {
+        const SkGlyph& pathGlyph = pathStrike->getGlyphIDMetrics(glyphs[i]);
+        if (const SkPath* path = pathStrike->findPath(pathGlyph)) {
+            path->transform(pathMatrix, &paths[i]);
+        } else {
+            paths[i].reset();
+        }
+        if (metricsStrike) {
+            const SkGlyph& g = metricsStrike == pathStrike.get()
+                             ? pathGlyph : metricsStrike->getGlyphIDMetrics(glyphs[i]);
+            if (bounds) {
+                bounds[i] = make_bounds(g, metricsScale);
+            }
+            if (widths) {
+                widths[i] = g.fAdvanceX * metricsScale;
+            }
+        }
+    }
+}
+
 void SkFont::getPos(const SkGlyphID glyphs[], int count, SkPoint pos[], SkPoint origin) const {
 
     SkStrikeSpecStorage strikeSpec = SkStrikeSpecStorage::MakeCanonicalized(*this);
@@ -10,6 +10,7 @@
 #include "include/core/SkTypes.h"
 #include "include/private/SkOnce.h"
 #include "src/core/SkFontDescriptor.h"
+#include "src/core/SkPerfCounters.h"
 
 class SkFontStyle;
 class SkTypeface;
@@ -180,6 +181,7 @@ sk_sp<SkFontMgr> SkFontMgr::RefDefault() {
     static sk_sp<SkFontMgr> singleton;
 
     once([]{
+        SkPerfCounters::AutoInitPhase phase(SkGraphics::InitPhase::kDefaultFontMgr);
         sk_sp<SkFontMgr> fm = gSkFontMgr_DefaultFactory ? gSkFontMgr_DefaultFactory()
                                                         : SkFontMgr::Factory();
         singleton = fm ? std::move(fm) : sk_make_sp<SkEmptyFontMgr>();
@@ -8,6 +8,7 @@
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPoint3.h"
 #include "include/private/SkNx.h"
+#include "include/private/SkVx.h"
 #include "src/core/SkGeometry.h"
 #include "src/core/SkPointPriv.h"
 
@@ -19,6 +20,24 @@ static SkVector to_vector(const Sk2s& x) {
     return vector;
 }
 
+using float8 = skvx::Vec<8, float>;
+
+// Calls fn with up to eight t values at a time, the unused lanes set to zero, and stores the first
+// n of the points it returns as their x and y lanes.
+template <typename Fn>
+static void eval_batch(const SkScalar t[], int count, SkPoint pos[], Fn&& fn) {
+    for (int i = 0; i < count; i += 8) {
+        int n = SkTMin(8, count - i);
+        float8 tt(0);
+        memcpy(&tt, t + i, n * sizeof(SkScalar));
+        float8 x, y;
+        fn(tt, &x, &y);
+        for (int j = 0; j < n; ++j) {
+            pos[i + j].set(x[j], y[j]);
+        }
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////
 
 static int is_not_monotonic(SkScalar a, SkScalar b, SkScalar c) {
@@ -124,6 +143,15 @@ SkPoint SkEvalQuadAt(const SkPoint src[3], SkScalar t) {
     return to_point(SkQuadCoeff(src).eval(t));
 }
 
+void SkEvalQuadAt(const SkPoint src[3], const SkScalar t[], int count, SkPoint pos[]) {
+    SkQuadCoeff coeff(src);
+    SkPoint A = to_point(coeff.fA), B = to_point(coeff.fB), C = to_point(coeff.fC);
+    eval_batch(t, count, pos, [&](const float8& tt, float8* x, float8* y) {
+        *x = (A.fX * tt + B.fX) * tt + C.fX;
+        *y = (A.fY * tt + B.fY) * tt + C.fY;
+    });
+}
+
 SkVector SkEvalQuadTangentAt(const SkPoint src[3], SkScalar t) {
     // The derivative equation is 2(b - a +(a - 2b +c)t). This returns a
     // zero tangent vector when t is 0 or 1, and the control point is equal
@@ -359,6 +387,16 @@ void SkEvalCubicAt(const SkPoint src[4], SkScalar t, SkPoint* loc,
     }
 }
 
+void SkEvalCubicAt(const SkPoint src[4], const SkScalar t[], int count, SkPoint pos[]) {
+    SkCubicCoeff coeff(src);
+    SkPoint A = to_point(coeff.fA), B = to_point(coeff.fB),
+            C = to_point(coeff.fC), D = to_point(coeff.fD);
+    eval_batch(t, count, pos, [&](const float8& tt, float8* x, float8* y) {
+        *x = ((A.fX * tt + B.fX) * tt + C.fX) * tt + D.fX;
+        *y = ((A.fY * tt + B.fY) * tt + C.fY) * tt + D.fY;
+    });
+}
+
 /** Cubic'(t) = At^2 + Bt + C, where
     A = 3(-a + 3(b - c) + d)
     B = 6(a - 2b + c)
@@ -1107,6 +1145,19 @@ SkPoint SkConic::evalAt(SkScalar t) const {
     return to_point(SkConicCoeff(*this).eval(t));
 }
 
+void SkConic::evalAt(const SkScalar t[], int count, SkPoint pos[]) const {
+    SkConicCoeff coeff(*this);
+    SkPoint nA = to_point(coeff.fNumer.fA), nB = to_point(coeff.fNumer.fB),
+            nC = to_point(coeff.fNumer.fC);
+    // The denominator's coefficients are the same in both lanes.
+    SkScalar dA = coeff.fDenom.fA[0], dB = coeff.fDenom.fB[0], dC = coeff.fDenom.fC[0];
+    eval_batch(t, count, pos, [&](const float8& tt, float8* x, float8* y) {
+        float8 denom = (dA * tt + dB) * tt + dC;
+        *x = ((nA.fX * tt + nB.fX) * tt + nC.fX) / denom;
+        *y = ((nA.fY * tt + nB.fY) * tt + nC.fY) / denom;
+    });
+}
+
 SkVector SkConic::evalTangentAt(SkScalar t) const {
     // The derivative equation returns a zero tangent vector when t is 0 or 1,
     // and the control point is equal to the end point.
@@ -40,6 +40,11 @@ SkPoint SkEvalQuadTangentAt(const SkPoint src[3], SkScalar t);
 */
 void SkEvalQuadAt(const SkPoint src[3], SkScalar t, SkPoint* pt, SkVector* tangent = nullptr);
 
+/** Set pos[i] to the point on the src quadratic at each of the count values in t[], which must
+    be 0 <= t[i] <= 1.0. Evaluates eight values at a time, giving the same points as SkEvalQuadAt.
+*/
+void SkEvalQuadAt(const SkPoint src[3], const SkScalar t[], int count, SkPoint pos[]);
+
 /** Given a src quadratic bezier, chop it at the specified t value,
     where 0 < t < 1, and return the two new quadratics in dst:
     dst[0..2] and dst[2..4]
@@ -99,6 +104,11 @@ SK_API void SkConvertQuadToCubic(const SkPoint src[3], SkPoint dst[4]);
 void SkEvalCubicAt(const SkPoint src[4], SkScalar t, SkPoint* locOrNull,
                    SkVector* tangentOrNull, SkVector* curvatureOrNull);
 
+/** Set pos[i] to the point on the src cubic at each of the count values in t[], which must be
+    0 <= t[i] <= 1.0. Evaluates eight values at a time, giving the same points as SkEvalCubicAt.
+*/
+void SkEvalCubicAt(const SkPoint src[4], const SkScalar t[], int count, SkPoint pos[]);
+
 /** Given a src cubic bezier, chop it at the specified t value,
     where 0 < t < 1, and return the two new cubics in dst:
     dst[0..3] and dst[3..6]
@@ -266,6 +276,8 @@ struct SkConic {
     void chop(SkConic dst[2]) const;
 
     SkPoint evalAt(SkScalar t) const;
+    // Evaluates the conic at each of the count values in t[], eight at a time.
+    void evalAt(const SkScalar t[], int count, SkPoint pos[]) const;
     SkVector evalTangentAt(SkScalar t) const;
 
     void computeAsQuadError(SkVector* err) const;
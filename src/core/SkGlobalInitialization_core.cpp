@@ -7,10 +7,12 @@
 
 #include "include/core/SkFlattenable.h"
 #include "include/private/SkOnce.h"
+#include "src/core/SkPerfCounters.h"
 
 void SkFlattenable::RegisterFlattenablesIfNeeded() {
     static SkOnce once;
     once([]{
+        SkPerfCounters::AutoInitPhase phase(SkGraphics::InitPhase::kFlattenables);
         SkFlattenable::PrivateInitializer::InitEffects();
         SkFlattenable::PrivateInitializer::InitImageFilters();
         SkFlattenable::Finalize();
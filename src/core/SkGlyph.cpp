@@ -7,8 +7,10 @@
 
 #include "src/core/SkGlyph.h"
 
+#include "include/private/SkPathRef.h"
 #include "src/core/SkArenaAlloc.h"
 #include "src/core/SkMakeUnique.h"
+#include "src/core/SkPathPriv.h"
 #include "src/core/SkScalerContext.h"
 
 SkMask SkGlyph::mask() const {
@@ -128,3 +130,156 @@ SkPath* SkGlyph::addPath(SkScalerContext* scalerContext, SkArenaAlloc* alloc) {
     }
     return this->path();
 }
+
+static constexpr SkScalar kMaxQuantizedCoord = 65535;
+
+const SkGlyph::CompactPath* SkGlyph::CompactPath::Make(const SkPath& path, SkArenaAlloc* alloc) {
+    const SkRect& bounds = path.getBounds();
+    if (path.countVerbs() == 0 || !bounds.isFinite()) {
+        return nullptr;
+    }
+
+    int pointCount = path.countPoints();
+    int weightCount = SkPathPriv::ConicWeightCnt(path);
+    uint8_t*  verbs = alloc->makeArrayDefault<uint8_t>(path.countVerbs());
+    uint16_t* coords = alloc->makeArrayDefault<uint16_t>(2 * pointCount);
+    SkScalar* weights = weightCount ? alloc->makeArrayDefault<SkScalar>(weightCount) : nullptr;
+
+    SkScalar xScale = bounds.width()  > 0 ? kMaxQuantizedCoord / bounds.width()  : 0;
+    SkScalar yScale = bounds.height() > 0 ? kMaxQuantizedCoord / bounds.height() : 0;
+    auto quantize = [](SkScalar v, SkScalar min, SkScalar scale) {
+        return (uint16_t)SkTPin(SkScalarRoundToInt((v - min) * scale), 0, 65535);
+    };
+
+    int verbCount = 0, coordCount = 0, conicCount = 0;
+    SkPath::RawIter iter(path);
+    SkPoint pts[4];
+    for (SkPath::Verb verb; (verb = iter.next(pts)) != SkPath::kDone_Verb;) {
+        // Every verb but move starts at the previous verb's last point.
+        int first = 1, count = 0;
+        switch (verb) {
+            case SkPath::kMove_Verb:  first = 0; count = 1; break;
+            case SkPath::kLine_Verb:  count = 1; break;
+            case SkPath::kQuad_Verb:  count = 2; break;
+            case SkPath::kConic_Verb: count = 2; weights[conicCount++] = iter.conicWeight(); break;
+            case SkPath::kCubic_Verb: count = 3; break;
+            case SkPath::kClose_Verb: break;
+            default: return nullptr;
+        }
+        if (coordCount + 2 * count > 2 * pointCount) {
+            return nullptr;
+        }
+        for (int i = first; i < first + count; ++i) {
+            coords[coordCount++] = quantize(pts[i].fX, bounds.fLeft, xScale);
+            coords[coordCount++] = quantize(pts[i].fY, bounds.fTop,  yScale);
+        }
+        verbs[verbCount++] = SkToU8(verb);
+    }
+
+    CompactPath* compact = alloc->make<CompactPath>();
+    compact->fBounds = bounds;
+    compact->fVerbs = verbs;
+    compact->fCoords = coords;
+    compact->fWeights = weights;
+    compact->fVerbCount = verbCount;
+    compact->fPointCount = coordCount / 2;
+    compact->fWeightCount = conicCount;
+    compact->fFillType = path.getFillType();
+    return compact;
+}
+
+void SkGlyph::CompactPath::expand(SkPath* path) const {
+    SkScalar xStep = fBounds.width()  / kMaxQuantizedCoord;
+    SkScalar yStep = fBounds.height() / kMaxQuantizedCoord;
+    const uint16_t* coords = fCoords;
+    auto next = [&]() {
+        SkPoint pt = {fBounds.fLeft + coords[0] * xStep, fBounds.fTop + coords[1] * yStep};
+        coords += 2;
+        return pt;
+    };
+
+    path->reset();
+    path->setFillType(fFillType);
+    path->incReserve(fPointCount);
+    const SkScalar* weights = fWeights;
+    for (int i = 0; i < fVerbCount; ++i) {
+        switch ((SkPath::Verb)fVerbs[i]) {
+            case SkPath::kMove_Verb: path->moveTo(next()); break;
+            case SkPath::kLine_Verb: path->lineTo(next()); break;
+            case SkPath::kQuad_Verb: {
+                SkPoint p1 = next();
+                path->quadTo(p1, next());
+                break;
+            }
+            case SkPath::kConic_Verb: {
+                SkPoint p1 = next();
+                path->conicTo(p1, next(), *weights++);
+                break;
+            }
+            case SkPath::kCubic_Verb: {
+                SkPoint p1 = next();
+                SkPoint p2 = next();
+                path->cubicTo(p1, p2, next());
+                break;
+            }
+            case SkPath::kClose_Verb: path->close(); break;
+            default: SkDEBUGFAIL("unexpected verb"); break;
+        }
+    }
+    path->updateBoundsCache();
+    path->getGenerationID();
+}
+
+// The heap storage behind an SkPath. Empty paths all share one SkPathRef.
+static size_t path_storage_size(const SkPath& path) {
+    if (path.countVerbs() == 0 && path.countPoints() == 0) {
+        return 0;
+    }
+    return sizeof(SkPathRef) + path.countPoints() * sizeof(SkPoint) + path.countVerbs()
+           + SkPathPriv::ConicWeightCnt(path) * sizeof(SkScalar);
+}
+
+void SkGlyph::PathData::compact(SkArenaAlloc* alloc) {
+    SkASSERT(fHasPath && !fCompactPath);
+    fCompactPath = CompactPath::Make(fPath, alloc);
+    if (fCompactPath) {
+        fCompactPath->expand(&fPath);
+    }
+}
+
+size_t SkGlyph::PathData::expand() {
+    if (!fIsReleased) {
+        return 0;
+    }
+    fCompactPath->expand(&fPath);
+    fIsReleased = false;
+    return path_storage_size(fPath);
+}
+
+size_t SkGlyph::PathData::release() {
+    if (fCompactPath == nullptr || fIsReleased) {
+        return 0;
+    }
+    size_t freed = path_storage_size(fPath);
+    fPath.reset();
+    fIsReleased = true;
+    return freed;
+}
+
+void SkGlyph::PathData::copyPath(SkPath* dst) const {
+    if (fIsReleased) {
+        fCompactPath->expand(dst);
+    } else {
+        *dst = fPath;
+    }
+}
+
+size_t SkGlyph::PathData::memoryUsed() const {
+    size_t size = sizeof(PathData) + path_storage_size(fPath);
+    if (fCompactPath) {
+        size += sizeof(CompactPath) + fCompactPath->fVerbCount
+                + 2 * fCompactPath->fPointCount * sizeof(uint16_t)
+                + fCompactPath->fWeightCount * sizeof(SkScalar);
+    }
+    return size;
+}
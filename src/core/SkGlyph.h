@@ -151,7 +151,9 @@ public:
 
     SkPath* addPath(SkScalerContext*, SkArenaAlloc*);
 
+    // The path must not have been released by its strike; SkStrike::findPath() rebuilds it.
     SkPath* path() const {
+        SkASSERT(fPathData == nullptr || !fPathData->fIsReleased);
         return fPathData != nullptr && fPathData->fHasPath ? &fPathData->fPath : nullptr;
     }
 
@@ -215,10 +217,48 @@ private:
         SkScalar   fInterval[2];  // the outside intersections of the axis and the glyph
     };
 
+    // A glyph outline with each coordinate quantized to 16 bits within the outline's bounds. It is
+    // a fraction of the size of an SkPath, lives in the strike's arena instead of the heap, and is
+    // expanded back into an SkPath when the path is needed.
+    struct CompactPath {
+        // Returns nullptr if the path can't be stored this way.
+        static const CompactPath* Make(const SkPath&, SkArenaAlloc*);
+
+        void expand(SkPath*) const;
+
+        SkRect           fBounds;
+        const uint8_t*   fVerbs;
+        const uint16_t*  fCoords;   // x, y for each point
+        const SkScalar*  fWeights;  // one for each conic
+        int              fVerbCount;
+        int              fPointCount;
+        int              fWeightCount;
+        SkPath::FillType fFillType;
+    };
+
     struct PathData {
-        Intercept* fIntercept{nullptr};
-        SkPath     fPath;
-        bool       fHasPath{false};
+        // Stores fPath as a CompactPath, and replaces fPath with its expansion so that the path
+        // is the same whether or not it has been released and rebuilt since. Leaves fPath alone
+        // if it can't be stored compactly.
+        void compact(SkArenaAlloc*);
+
+        // Rebuilds fPath if it was released. Returns the bytes this added to the heap.
+        size_t expand();
+
+        // Frees fPath's storage if it can be rebuilt. Returns the bytes this freed.
+        size_t release();
+
+        // Sets 'dst' to the path, whether or not it has been released.
+        void copyPath(SkPath* dst) const;
+
+        // The bytes used by this and by the path storage it owns.
+        size_t memoryUsed() const;
+
+        Intercept*         fIntercept{nullptr};
+        SkPath             fPath;
+        const CompactPath* fCompactPath{nullptr};
+        bool               fHasPath{false};
+        bool               fIsReleased{false};
     };
 
     // TODO(herb) remove friend statement after SkStrike cleanup.
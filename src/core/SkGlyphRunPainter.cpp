@@ -190,8 +190,7 @@ void SkGlyphRunListPainter::drawForBitmapDevice(
                     SkStrikeInterface::kBoundsOnly,
                     fGlyphPos);
 
-            SkTDArray<SkPathPos> pathsAndPositions;
-            pathsAndPositions.setReserve(glyphPosSpan.size());
+            size_t pathCount = 0;
             for (const SkGlyphPos& glyphPos : glyphPosSpan) {
                 const SkGlyph& glyph = *glyphPos.glyph;
                 SkPoint position = glyphPos.position;
@@ -201,13 +200,13 @@ void SkGlyphRunListPainter::drawForBitmapDevice(
                     && glyph.hasPath())
                 {
                     // Only draw a path if it exists, and this is not a color glyph.
-                    pathsAndPositions.push_back(SkPathPos{glyph.path(), position});
+                    fPathsAndPositions[pathCount++] = SkPathPos{glyph.path(), position};
                 } else {
                     // TODO: this is here to have chrome layout tests pass. Remove this when
                     //  fallback for CPU works.
                     strike->generatePath(glyph);
                     if (check_glyph_position(position) && !glyph.isEmpty() && glyph.hasPath()) {
-                        pathsAndPositions.push_back(SkPathPos{glyph.path(), position});
+                        fPathsAndPositions[pathCount++] = SkPathPos{glyph.path(), position};
                     }
                 }
             }
@@ -217,9 +216,8 @@ void SkGlyphRunListPainter::drawForBitmapDevice(
             pathPaint = runPaint;
             pathPaint.setAntiAlias(runFont.hasSomeAntiAliasing());
 
-            bitmapDevice->paintPaths(
-                    SkSpan<const SkPathPos>{pathsAndPositions.begin(), pathsAndPositions.size()},
-                    textScale, pathPaint);
+            bitmapDevice->paintPaths(SkSpan<const SkPathPos>{fPathsAndPositions, pathCount},
+                                     textScale, pathPaint);
         } else {
             SkAutoDescriptor ad;
             SkScalerContextEffects effects;
@@ -247,20 +245,18 @@ void SkGlyphRunListPainter::drawForBitmapDevice(
                     SkStrikeInterface::kImageIfNeeded,
                     fGlyphPos);
 
-            SkTDArray<SkMask> masks;
-            masks.setReserve(glyphPosSpan.size());
-
+            size_t maskCount = 0;
             for (const SkGlyphPos& glyphPos : glyphPosSpan) {
                 const SkGlyph& glyph = *glyphPos.glyph;
                 SkPoint position = glyphPos.position;
                 // The glyph could have dimensions (!isEmpty()), but still may have no bits if
                 // the width is too wide. So check that there really is an image.
                 if (check_glyph_position(position) && !glyph.isEmpty() && glyph.hasImage()) {
-                    masks.push_back(glyph.mask(position));
+                    fMasks[maskCount++] = glyph.mask(position);
                 }
             }
 
-            bitmapDevice->paintMasks(SkSpan<const SkMask>{masks.begin(), masks.size()}, runPaint);
+            bitmapDevice->paintMasks(SkSpan<const SkMask>{fMasks, maskCount}, runPaint);
         }
     }
 }
@@ -968,6 +964,8 @@ SkGlyphRunListPainter::ScopedBuffers::ScopedBuffers(SkGlyphRunListPainter* paint
 
         fPainter->fPositions.reset(size);
         fPainter->fGlyphPos.reset(size);
+        fPainter->fPathsAndPositions.reset(size);
+        fPainter->fMasks.reset(size);
     }
 }
 
@@ -976,10 +974,12 @@ SkGlyphRunListPainter::ScopedBuffers::~ScopedBuffers() {
     fPainter->fARGBGlyphsIDs.clear();
     fPainter->fARGBPositions.clear();
 
-    if (fPainter->fMaxRunSize > 200) {
+    if (fPainter->fMaxRunSize > kMaxRetainedRunSize) {
         fPainter->fMaxRunSize = 0;
         fPainter->fPositions.reset();
         fPainter->fGlyphPos.reset();
+        fPainter->fPathsAndPositions.reset();
+        fPainter->fMasks.reset();
         fPainter->fPaths.shrink_to_fit();
         fPainter->fARGBGlyphsIDs.shrink_to_fit();
         fPainter->fARGBPositions.shrink_to_fit();
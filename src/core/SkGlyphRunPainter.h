@@ -116,10 +116,17 @@ private:
 
     SkStrikeCacheInterface* const fStrikeCache;
 
+    // The buffers below are sized for the longest run seen, and kept between draws unless it is
+    // longer than kMaxRetainedRunSize, so drawing the same text again doesn't allocate.
+    static constexpr int kMaxRetainedRunSize = 1024;
     int fMaxRunSize{0};
     SkAutoTMalloc<SkPoint> fPositions;
     SkAutoTMalloc<SkGlyphPos> fGlyphPos;
 
+    // What drawForBitmapDevice() hands to the BitmapDevicePainter.
+    SkAutoTMalloc<SkPathPos> fPathsAndPositions;
+    SkAutoTMalloc<SkMask> fMasks;
+
     std::vector<SkGlyphPos> fPaths;
 
     // Vectors for tracking ARGB fallback information.
@@ -11,7 +11,9 @@
 
 #if SK_SUPPORT_GPU
 #include "include/private/GrRecordingContext.h"
+#include "src/gpu/GrBlurDownsampleCache.h"
 #include "src/gpu/GrCaps.h"
+#include "src/gpu/GrDrawingManager.h"
 #include "src/gpu/GrFixedClip.h"
 #include "src/gpu/GrRecordingContextPriv.h"
 #include "src/gpu/GrRenderTargetContext.h"
@@ -295,9 +297,35 @@ static sk_sp<GrTextureProxy> decimate(GrRecordingContext* context,
         return nullptr;
     }
 
+    // Other blurs of this source may already have made some of the levels we need.
+    GrBlurDownsampleCache* cache = context->priv().drawingManager()->blurDownsampleCache();
+    GrBlurDownsampleCache::Key key;
+    key.fSrcProxyID = src->uniqueID().asUInt();
+    key.fSrcRect = srcRect;
+    if (GrTextureDomain::kIgnore_Mode == mode) {
+        key.fSrcOffset.set(0, 0);
+        key.fDomain.setEmpty();
+    } else {
+        key.fSrcOffset = *srcOffset;
+        key.fDomain = *contentRect;
+    }
+    key.fMode = static_cast<int32_t>(mode);
+
     for (int i = 1; i < scaleFactorX || i < scaleFactorY; i *= 2) {
         shrink_irect_by_2(&dstRect, i < scaleFactorX, i < scaleFactorY);
 
+        key.fScaleX = SkTMin(2 * i, scaleFactorX);
+        key.fScaleY = SkTMin(2 * i, scaleFactorY);
+        if (sk_sp<GrTextureProxy> level = cache->find(key)) {
+            if (GrTextureDomain::kIgnore_Mode != mode && i == 1) {
+                srcOffset->set(0, 0);
+            }
+            dstRenderTargetContext = nullptr;
+            src = std::move(level);
+            srcRect = dstRect;
+            continue;
+        }
+
         // We know this will not be the final draw so we are free to make it an approx match.
         dstRenderTargetContext = context->priv().makeDeferredRenderTargetContext(
                                                     format,
@@ -353,12 +381,21 @@ static sk_sp<GrTextureProxy> decimate(GrRecordingContext* context,
         if (!src) {
             return nullptr;
         }
+        cache->add(key, src);
         srcRect = dstRect;
     }
 
     *contentRect = dstRect;
 
-    SkASSERT(dstRenderTargetContext);
+    if (!dstRenderTargetContext) {
+        // The last level came from the cache. The clears below only touch texels outside its
+        // content, which no blur that shares it reads for anything but transparent black.
+        dstRenderTargetContext = context->priv().drawingManager()->makeRenderTargetContext(
+                src, dstII.refColorSpace(), nullptr);
+        if (!dstRenderTargetContext) {
+            return nullptr;
+        }
+    }
 
     if (willBeXFiltering) {
         if (scaleFactorX > 1) {
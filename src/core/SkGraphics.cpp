@@ -17,9 +17,11 @@
 #include "include/core/SkShader.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkTime.h"
+#include "src/core/SkBitmapDevice.h"
 #include "src/core/SkBlitter.h"
 #include "src/core/SkCpu.h"
 #include "src/core/SkGeometry.h"
+#include "src/core/SkMemoryTags.h"
 #include "src/core/SkOpts.h"
 #include "src/core/SkResourceCache.h"
 #include "src/core/SkScalerContext.h"
@@ -28,6 +30,7 @@
 #include "src/core/SkTypefaceCache.h"
 #include "src/utils/SkUTF.h"
 
+#include <cmath>
 #include <stdlib.h>
 
 void SkGraphics::Init() {
@@ -41,6 +44,11 @@ void SkGraphics::Init() {
 void SkGraphics::DumpMemoryStatistics(SkTraceMemoryDump* dump) {
   SkResourceCache::DumpMemoryStatistics(dump);
   SkStrikeCache::DumpMemoryStatistics(dump);
+  SkMemoryTags::DumpMemoryStatistics(dump);
+}
+
+bool SkGraphics::GetMemoryTagStats(SkMemoryTag tag, SkMemoryTagStats* stats) {
+    return sk_get_memory_tag_stats(tag, stats);
 }
 
 void SkGraphics::PurgeAllCaches() {
@@ -49,6 +57,39 @@ void SkGraphics::PurgeAllCaches() {
     SkImageFilter::PurgeCache();
 }
 
+float SkGraphics::MemoryPressureTrimFraction(MemoryPressure pressure) {
+    switch (pressure) {
+        case MemoryPressure::kLow:      return 0.25f;
+        case MemoryPressure::kModerate: return 0.5f;
+        case MemoryPressure::kCritical: return 1;
+    }
+    SK_ABORT("Unknown memory pressure");
+    return 1;
+}
+
+void SkGraphics::OnMemoryPressure(MemoryPressure pressure, MemoryPressureResult* result) {
+    float fraction = MemoryPressureTrimFraction(pressure);
+    MemoryPressureResult freed;
+
+    SkStrikeCache* strikeCache = SkStrikeCache::GlobalStrikeCache();
+    freed.fFontCacheBytes = strikeCache->purgeBytes(
+            size_t(std::ceil(strikeCache->getTotalMemoryUsed() * fraction)));
+    freed.fResourceCacheBytes = SkResourceCache::PurgeBytes(
+            size_t(std::ceil(SkResourceCache::GetTotalBytesUsed() * fraction)));
+
+    if (MemoryPressure::kCritical == pressure) {
+        // Typefaces are released once nothing else, like the strikes above, refers to them.
+        freed.fTypefaces = SkTypefaceCache::PurgeAll();
+        SkImageFilter::PurgeCache();
+    }
+
+    if (result) {
+        result->fFontCacheBytes += freed.fFontCacheBytes;
+        result->fResourceCacheBytes += freed.fResourceCacheBytes;
+        result->fTypefaces += freed.fTypefaces;
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 static const char kFontCacheLimitStr[] = "font-cache-limit";
@@ -129,6 +170,18 @@ int SkGraphics::SetFontCachePointSizeLimit(int limit) {
     return SkStrikeCache::GlobalStrikeCache()->setCachePointSizeLimit(limit);
 }
 
+bool SkGraphics::SetFontCacheSharedStrikes(bool shared) {
+    return SkStrikeCache::GlobalStrikeCache()->setSharedStrikes(shared);
+}
+
+bool SkGraphics::SetFontCacheDiscardableImages(bool discardable) {
+    return SkStrikeCache::GlobalStrikeCache()->setDiscardableImages(discardable);
+}
+
+int SkGraphics::SetImageFilterTileSize(int tileSize) {
+    return SkBitmapDevice::SetImageFilterTileSize(tileSize);
+}
+
 void SkGraphics::PurgeFontCache() {
     SkStrikeCache::GlobalStrikeCache()->purgeAll();
     SkTypefaceCache::PurgeAll();
@@ -8,6 +8,7 @@
 #include "include/core/SkImageFilter.h"
 
 #include "include/core/SkCanvas.h"
+#include "include/core/SkColorFilter.h"
 #include "include/core/SkRect.h"
 #include "include/effects/SkComposeImageFilter.h"
 #include "include/private/SkSafe32.h"
@@ -467,6 +468,77 @@ sk_sp<SkSpecialImage> SkImageFilter::filterInput(int index,
     return result;
 }
 
+sk_sp<SkSpecialImage> SkImageFilter::filterInputPointwise(int index,
+                                                          SkSpecialImage* src,
+                                                          const Context& ctx,
+                                                          SkIPoint* offset,
+                                                          sk_sp<SkColorFilter>* colorFilter) const {
+    colorFilter->reset();
+    SkIPoint skipped = SkIPoint::Make(0, 0);
+
+    // Walk past the nodes that can be applied while drawing their input. A color filter that
+    // affects transparent black has to fill the clip, so it must be materialized.
+    const SkImageFilter* input = this->getInput(index);
+    Context inputCtx = this->mapContext(ctx);
+    while (input && input->countInputs() == 1) {
+        SkColorFilter* cf;
+        SkIPoint nodeOffset;
+        if (input->onIsColorFilterNode(&cf)) {
+            sk_sp<SkColorFilter> nodeCF(cf);
+            if (input->affectsTransparentBlack()) {
+                break;
+            }
+            if (*colorFilter) {
+                nodeCF = (*colorFilter)->makeComposed(std::move(nodeCF));
+                if (!nodeCF) {
+                    break;
+                }
+            }
+            *colorFilter = std::move(nodeCF);
+        } else if (input->onIsOffsetNode(inputCtx.ctm(), &nodeOffset)) {
+            skipped.fX = Sk32_sat_add(skipped.fX, nodeOffset.fX);
+            skipped.fY = Sk32_sat_add(skipped.fY, nodeOffset.fY);
+        } else {
+            break;
+        }
+        inputCtx = input->mapContext(inputCtx);
+        input = input->getInput(0);
+    }
+
+    sk_sp<SkSpecialImage> result;
+    if (!input) {
+        result = sk_ref_sp(src);
+    } else {
+        result = input->filterImage(src, inputCtx, offset);
+    }
+    SkASSERT(!result || src->isTextureBacked() == result->isTextureBacked());
+
+    offset->fX = Sk32_sat_add(offset->fX, skipped.fX);
+    offset->fY = Sk32_sat_add(offset->fY, skipped.fY);
+    return result;
+}
+
+sk_sp<SkSpecialImage> SkImageFilter::ApplyColorFilter(sk_sp<SkSpecialImage> image,
+                                                      sk_sp<SkColorFilter> colorFilter,
+                                                      const OutputProperties& outputProperties) {
+    if (!image || !colorFilter) {
+        return image;
+    }
+    SkISize size = SkISize::Make(image->width(), image->height());
+    sk_sp<SkSpecialSurface> surf(image->makeSurface(outputProperties, size));
+    if (!surf) {
+        return nullptr;
+    }
+    SkCanvas* canvas = surf->getCanvas();
+    canvas->clear(0x0);
+
+    SkPaint paint;
+    paint.setBlendMode(SkBlendMode::kSrc);
+    paint.setColorFilter(std::move(colorFilter));
+    image->draw(canvas, 0, 0, &paint);
+    return surf->makeImageSnapshot();
+}
+
 void SkImageFilter::PurgeCache() {
     SkImageFilterCache::Get()->purge();
 }
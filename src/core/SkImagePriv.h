@@ -54,6 +54,18 @@ sk_sp<SkShader> SkMakeBitmapShaderForPaint(const SkPaint& paint, const SkBitmap&
  */
 extern SK_API sk_sp<SkImage> SkMakeImageFromRasterBitmap(const SkBitmap&, SkCopyPixelsMode);
 
+/**
+ *  Converts the YUVA planes into a new raster image in a single pass, with Y, U, V, and A each
+ *  read from the nearest pixel of its plane, so planes may be subsampled. Planes must be A8,
+ *  Gray8, or 8888, with yuvaIndices choosing the channel of 8888 planes to read, which allows
+ *  interleaved planes like NV12's UV.
+ *
+ *  Returns nullptr if the indices aren't valid or a plane can't be read.
+ */
+sk_sp<SkImage> SkMakeRasterImageFromYUVAPixmaps(SkYUVColorSpace, const SkPixmap yuvaPixmaps[],
+                                                const SkYUVAIndex yuvaIndices[4], SkISize,
+                                                bool flipY, sk_sp<SkColorSpace>);
+
 // Given an image created from SkNewImageFromBitmap, return its pixelref. This
 // may be called to see if the surface and the image share the same pixelref,
 // in which case the surface may need to perform a copy-on-write.
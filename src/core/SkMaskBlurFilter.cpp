@@ -14,6 +14,7 @@
 #include "include/private/SkTo.h"
 #include "src/core/SkArenaAlloc.h"
 #include "src/core/SkGaussFilter.h"
+#include "src/core/SkTaskGroup.h"
 
 #include <cmath>
 #include <climits>
@@ -949,6 +950,21 @@ static SkIPoint small_blur(double sigmaX, double sigmaY, const SkMask& src, SkMa
     return {radiusX, radiusY};
 }
 
+// Rows are blurred in strips this tall, each of which may run on its own thread.
+static constexpr int kStripSize = 64;
+
+// Calls fn(first, end, buffer) for strips [first, end) of [0, count) on the default executor,
+// giving each strip its own buffer of bufferSize for its Scan.
+template <typename Fn>
+static void for_each_strip(int count, size_t bufferSize, Fn&& fn) {
+    const int strips = (count + kStripSize - 1) / kStripSize;
+    SkAutoTMalloc<uint32_t> buffers(strips * bufferSize);
+    SkTaskGroup().batch(strips, [&](int strip) {
+        const int first = strip * kStripSize;
+        fn(first, std::min(first + kStripSize, count), buffers.get() + strip * bufferSize);
+    });
+}
+
 // TODO: assuming sigmaW = sigmaH. Allow different sigmas. Right now the
 // API forces the sigmas to be the same.
 SkIPoint SkMaskBlurFilter::blur(const SkMask& src, SkMask* dst) const {
@@ -983,7 +999,6 @@ SkIPoint SkMaskBlurFilter::blur(const SkMask& src, SkMask* dst) const {
     SkASSERT(srcW >= 0 && srcH >= 0 && dstW >= 0 && dstH >= 0);
 
     auto bufferSize = std::max(planW.bufferSize(), planH.bufferSize());
-    auto buffer = alloc.makeArrayDefault<uint32_t>(bufferSize);
 
     // Blur both directions.
     int tmpW = srcH,
@@ -991,59 +1006,79 @@ SkIPoint SkMaskBlurFilter::blur(const SkMask& src, SkMask* dst) const {
 
     auto tmp = alloc.makeArrayDefault<uint8_t>(tmpW * tmpH);
 
-    // Blur horizontally, and transpose.
-    const PlanGauss::Scan& scanW = planW.makeBlurScan(srcW, buffer);
+    // Blur horizontally, and transpose. Each row is independent, so strips of rows can be
+    // blurred in parallel.
     switch (src.fFormat) {
-        case SkMask::kBW_Format: {
-            const uint8_t* bwStart = src.fImage;
-            auto start = SkMask::AlphaIter<SkMask::kBW_Format>(bwStart, 0);
-            auto end = SkMask::AlphaIter<SkMask::kBW_Format>(bwStart + (srcW / 8), srcW % 8);
-            for (int y = 0; y < srcH; ++y, start >>= src.fRowBytes, end >>= src.fRowBytes) {
-                auto tmpStart = &tmp[y];
-                scanW.blur(start, end, tmpStart, tmpW, tmpStart + tmpW * tmpH);
-            }
-        } break;
-        case SkMask::kA8_Format: {
-            const uint8_t* a8Start = src.fImage;
-            auto start = SkMask::AlphaIter<SkMask::kA8_Format>(a8Start);
-            auto end = SkMask::AlphaIter<SkMask::kA8_Format>(a8Start + srcW);
-            for (int y = 0; y < srcH; ++y, start >>= src.fRowBytes, end >>= src.fRowBytes) {
-                auto tmpStart = &tmp[y];
-                scanW.blur(start, end, tmpStart, tmpW, tmpStart + tmpW * tmpH);
-            }
-        } break;
-        case SkMask::kARGB32_Format: {
-            const uint32_t* argbStart = reinterpret_cast<const uint32_t*>(src.fImage);
-            auto start = SkMask::AlphaIter<SkMask::kARGB32_Format>(argbStart);
-            auto end = SkMask::AlphaIter<SkMask::kARGB32_Format>(argbStart + srcW);
-            for (int y = 0; y < srcH; ++y, start >>= src.fRowBytes, end >>= src.fRowBytes) {
-                auto tmpStart = &tmp[y];
-                scanW.blur(start, end, tmpStart, tmpW, tmpStart + tmpW * tmpH);
-            }
-        } break;
-        case SkMask::kLCD16_Format: {
-            const uint16_t* lcdStart = reinterpret_cast<const uint16_t*>(src.fImage);
-            auto start = SkMask::AlphaIter<SkMask::kLCD16_Format>(lcdStart);
-            auto end = SkMask::AlphaIter<SkMask::kLCD16_Format>(lcdStart + srcW);
-            for (int y = 0; y < srcH; ++y, start >>= src.fRowBytes, end >>= src.fRowBytes) {
-                auto tmpStart = &tmp[y];
-                scanW.blur(start, end, tmpStart, tmpW, tmpStart + tmpW * tmpH);
-            }
-        } break;
+        case SkMask::kBW_Format:
+            for_each_strip(srcH, bufferSize, [&](int firstRow, int endRow, uint32_t* buffer) {
+                const PlanGauss::Scan& scanW = planW.makeBlurScan(srcW, buffer);
+                const uint8_t* bwStart = src.fImage + firstRow * src.fRowBytes;
+                auto start = SkMask::AlphaIter<SkMask::kBW_Format>(bwStart, 0);
+                auto end   = SkMask::AlphaIter<SkMask::kBW_Format>(bwStart + (srcW / 8), srcW % 8);
+                for (int y = firstRow; y < endRow; ++y, start >>= src.fRowBytes,
+                                                        end   >>= src.fRowBytes) {
+                    auto tmpStart = &tmp[y];
+                    scanW.blur(start, end, tmpStart, tmpW, tmpStart + tmpW * tmpH);
+                }
+            });
+            break;
+        case SkMask::kA8_Format:
+            for_each_strip(srcH, bufferSize, [&](int firstRow, int endRow, uint32_t* buffer) {
+                const PlanGauss::Scan& scanW = planW.makeBlurScan(srcW, buffer);
+                const uint8_t* a8Start = src.fImage + firstRow * src.fRowBytes;
+                auto start = SkMask::AlphaIter<SkMask::kA8_Format>(a8Start);
+                auto end   = SkMask::AlphaIter<SkMask::kA8_Format>(a8Start + srcW);
+                for (int y = firstRow; y < endRow; ++y, start >>= src.fRowBytes,
+                                                        end   >>= src.fRowBytes) {
+                    auto tmpStart = &tmp[y];
+                    scanW.blur(start, end, tmpStart, tmpW, tmpStart + tmpW * tmpH);
+                }
+            });
+            break;
+        case SkMask::kARGB32_Format:
+            for_each_strip(srcH, bufferSize, [&](int firstRow, int endRow, uint32_t* buffer) {
+                const PlanGauss::Scan& scanW = planW.makeBlurScan(srcW, buffer);
+                const uint32_t* argbStart =
+                        reinterpret_cast<const uint32_t*>(src.fImage + firstRow * src.fRowBytes);
+                auto start = SkMask::AlphaIter<SkMask::kARGB32_Format>(argbStart);
+                auto end   = SkMask::AlphaIter<SkMask::kARGB32_Format>(argbStart + srcW);
+                for (int y = firstRow; y < endRow; ++y, start >>= src.fRowBytes,
+                                                        end   >>= src.fRowBytes) {
+                    auto tmpStart = &tmp[y];
+                    scanW.blur(start, end, tmpStart, tmpW, tmpStart + tmpW * tmpH);
+                }
+            });
+            break;
+        case SkMask::kLCD16_Format:
+            for_each_strip(srcH, bufferSize, [&](int firstRow, int endRow, uint32_t* buffer) {
+                const PlanGauss::Scan& scanW = planW.makeBlurScan(srcW, buffer);
+                const uint16_t* lcdStart =
+                        reinterpret_cast<const uint16_t*>(src.fImage + firstRow * src.fRowBytes);
+                auto start = SkMask::AlphaIter<SkMask::kLCD16_Format>(lcdStart);
+                auto end   = SkMask::AlphaIter<SkMask::kLCD16_Format>(lcdStart + srcW);
+                for (int y = firstRow; y < endRow; ++y, start >>= src.fRowBytes,
+                                                        end   >>= src.fRowBytes) {
+                    auto tmpStart = &tmp[y];
+                    scanW.blur(start, end, tmpStart, tmpW, tmpStart + tmpW * tmpH);
+                }
+            });
+            break;
         default:
             SK_ABORT("Unhandled format.");
     }
 
     // Blur vertically (scan in memory order because of the transposition),
     // and transpose back to the original orientation.
-    const PlanGauss::Scan& scanH = planH.makeBlurScan(tmpW, buffer);
-    for (int y = 0; y < tmpH; y++) {
-        auto tmpStart = &tmp[y * tmpW];
-        auto dstStart = &dst->fImage[y];
-
-        scanH.blur(tmpStart, tmpStart + tmpW,
-                   dstStart, dst->fRowBytes, dstStart + dst->fRowBytes * dstH);
-    }
+    for_each_strip(tmpH, bufferSize, [&](int firstRow, int endRow, uint32_t* buffer) {
+        const PlanGauss::Scan& scanH = planH.makeBlurScan(tmpW, buffer);
+        for (int y = firstRow; y < endRow; y++) {
+            auto tmpStart = &tmp[y * tmpW];
+            auto dstStart = &dst->fImage[y];
+
+            scanH.blur(tmpStart, tmpStart + tmpW,
+                       dstStart, dst->fRowBytes, dstStart + dst->fRowBytes * dstH);
+        }
+    });
 
     return {SkTo<int32_t>(borderW), SkTo<int32_t>(borderH)};
 }
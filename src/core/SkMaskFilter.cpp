@@ -77,7 +77,7 @@ static void dump(const SkMask& mask) {
 #endif
 
 static void draw_nine_clipped(const SkMask& mask, const SkIRect& outerR,
-                              const SkIPoint& center, bool fillCenter,
+                              const SkIPoint& center, U8CPU centerAlpha,
                               const SkIRect& clipR, SkBlitter* blitter) {
     int cx = center.x();
     int cy = center.y();
@@ -129,7 +129,7 @@ static void draw_nine_clipped(const SkMask& mask, const SkIRect& outerR,
                outerR.top() + cy - mask.fBounds.top(),
                outerR.right() + (cx + 1 - mask.fBounds.right()),
                outerR.bottom() + (cy + 1 - mask.fBounds.bottom()));
-    if (fillCenter) {
+    if (0xFF == centerAlpha) {
         blitClippedRect(blitter, innerR, clipR);
     }
 
@@ -140,6 +140,17 @@ static void draw_nine_clipped(const SkMask& mask, const SkIRect& outerR,
     uint8_t* alpha = (uint8_t*)(runs + innerW + 1);
 
     SkIRect r;
+    // center, when it is partially covered
+    r = innerR;
+    if (0 < centerAlpha && centerAlpha < 0xFF && r.intersect(clipR)) {
+        int width = r.width();
+        for (int y = r.top(); y < r.bottom(); ++y) {
+            runs[0] = width;
+            runs[width] = 0;
+            alpha[0] = centerAlpha;
+            blitter->blitAntiH(r.left(), y, alpha, runs);
+        }
+    }
     // top
     r.set(innerR.left(), outerR.top(), innerR.right(), innerR.top());
     if (r.intersect(clipR)) {
@@ -190,8 +201,9 @@ static void draw_nine_clipped(const SkMask& mask, const SkIRect& outerR,
     }
 }
 
+// A centerAlpha of 0 leaves the middle of the nine-patch undrawn, e.g. the hole of nested rects.
 static void draw_nine(const SkMask& mask, const SkIRect& outerR, const SkIPoint& center,
-                      bool fillCenter, const SkRasterClip& clip, SkBlitter* blitter) {
+                      U8CPU centerAlpha, const SkRasterClip& clip, SkBlitter* blitter) {
     // if we get here, we need to (possibly) resolve the clip and blitter
     SkAAClipBlitterWrapper wrapper(clip, blitter);
     blitter = wrapper.getBlitter();
@@ -201,7 +213,7 @@ static void draw_nine(const SkMask& mask, const SkIRect& outerR, const SkIPoint&
     if (!clipper.done()) {
         const SkIRect& cr = clipper.rect();
         do {
-            draw_nine_clipped(mask, outerR, center, fillCenter, cr, blitter);
+            draw_nine_clipped(mask, outerR, center, centerAlpha, cr, blitter);
             clipper.next();
         } while (!clipper.done());
     }
@@ -227,7 +239,10 @@ bool SkMaskFilterBase::filterRRect(const SkRRect& devRRect, const SkMatrix& matr
         SkASSERT(nullptr == patch.fMask.fImage);
         return false;
     }
-    draw_nine(patch.fMask, patch.fOuterRect, patch.fCenter, true, clip, blitter);
+    U8CPU centerAlpha = patch.fOpaqueCenter
+                                ? 0xFF
+                                : *patch.fMask.getAddr8(patch.fCenter.fX, patch.fCenter.fY);
+    draw_nine(patch.fMask, patch.fOuterRect, patch.fCenter, centerAlpha, clip, blitter);
     return true;
 }
 
@@ -248,8 +263,8 @@ bool SkMaskFilterBase::filterPath(const SkPath& devPath, const SkMatrix& matrix,
                 return false;
 
             case kTrue_FilterReturn:
-                draw_nine(patch.fMask, patch.fOuterRect, patch.fCenter, 1 == rectCount, clip,
-                          blitter);
+                draw_nine(patch.fMask, patch.fOuterRect, patch.fCenter,
+                          1 == rectCount ? 0xFF : 0, clip, blitter);
                 return true;
 
             case kUnimplemented_FilterReturn:
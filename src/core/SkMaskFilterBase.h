@@ -168,12 +168,15 @@ protected:
 
     class NinePatch : ::SkNoncopyable {
     public:
-        NinePatch() : fCache(nullptr) { }
+        NinePatch() : fOpaqueCenter(true), fCache(nullptr) { }
         ~NinePatch();
 
         SkMask      fMask;      // fBounds must have [0,0] in its top-left
         SkIRect     fOuterRect; // width/height must be >= fMask.fBounds'
         SkIPoint    fCenter;    // identifies center row/col for stretching
+        // False if the mask is only stretched along one axis, so the middle takes the center
+        // pixel's coverage instead of being filled.
+        bool        fOpaqueCenter;
         SkCachedData* fCache;
     };
 
@@ -16,6 +16,7 @@
 #include "include/private/SkTo.h"
 #include "src/core/SkMathPriv.h"
 #include "src/core/SkMatrixPriv.h"
+#include "src/core/SkOpts.h"
 
 #include <cstddef>
 #include <utility>
@@ -890,120 +891,26 @@ void SkMatrix::Identity_pts(const SkMatrix& m, SkPoint dst[], const SkPoint src[
     }
 }
 
+// The rest map their points with the fastest SkOpts this CPU has.
 void SkMatrix::Trans_pts(const SkMatrix& m, SkPoint dst[], const SkPoint src[], int count) {
     SkASSERT(m.getType() <= SkMatrix::kTranslate_Mask);
-    if (count > 0) {
-        SkScalar tx = m.getTranslateX();
-        SkScalar ty = m.getTranslateY();
-        if (count & 1) {
-            dst->fX = src->fX + tx;
-            dst->fY = src->fY + ty;
-            src += 1;
-            dst += 1;
-        }
-        Sk4s trans4(tx, ty, tx, ty);
-        count >>= 1;
-        if (count & 1) {
-            (Sk4s::Load(src) + trans4).store(dst);
-            src += 2;
-            dst += 2;
-        }
-        count >>= 1;
-        for (int i = 0; i < count; ++i) {
-            (Sk4s::Load(src+0) + trans4).store(dst+0);
-            (Sk4s::Load(src+2) + trans4).store(dst+2);
-            src += 4;
-            dst += 4;
-        }
-    }
+    SkOpts::map_points_translate(m, dst, src, count);
 }
 
 void SkMatrix::Scale_pts(const SkMatrix& m, SkPoint dst[], const SkPoint src[], int count) {
     SkASSERT(m.getType() <= (SkMatrix::kScale_Mask | SkMatrix::kTranslate_Mask));
-    if (count > 0) {
-        SkScalar tx = m.getTranslateX();
-        SkScalar ty = m.getTranslateY();
-        SkScalar sx = m.getScaleX();
-        SkScalar sy = m.getScaleY();
-        if (count & 1) {
-            dst->fX = src->fX * sx + tx;
-            dst->fY = src->fY * sy + ty;
-            src += 1;
-            dst += 1;
-        }
-        Sk4s trans4(tx, ty, tx, ty);
-        Sk4s scale4(sx, sy, sx, sy);
-        count >>= 1;
-        if (count & 1) {
-            (Sk4s::Load(src) * scale4 + trans4).store(dst);
-            src += 2;
-            dst += 2;
-        }
-        count >>= 1;
-        for (int i = 0; i < count; ++i) {
-            (Sk4s::Load(src+0) * scale4 + trans4).store(dst+0);
-            (Sk4s::Load(src+2) * scale4 + trans4).store(dst+2);
-            src += 4;
-            dst += 4;
-        }
-    }
+    SkOpts::map_points_scale_translate(m, dst, src, count);
 }
 
 void SkMatrix::Persp_pts(const SkMatrix& m, SkPoint dst[],
                          const SkPoint src[], int count) {
     SkASSERT(m.hasPerspective());
-
-    if (count > 0) {
-        do {
-            SkScalar sy = src->fY;
-            SkScalar sx = src->fX;
-            src += 1;
-
-            SkScalar x = sdot(sx, m.fMat[kMScaleX], sy, m.fMat[kMSkewX])  + m.fMat[kMTransX];
-            SkScalar y = sdot(sx, m.fMat[kMSkewY],  sy, m.fMat[kMScaleY]) + m.fMat[kMTransY];
-#ifdef SK_LEGACY_MATRIX_MATH_ORDER
-            SkScalar z = sx * m.fMat[kMPersp0] + (sy * m.fMat[kMPersp1] + m.fMat[kMPersp2]);
-#else
-            SkScalar z = sdot(sx, m.fMat[kMPersp0], sy, m.fMat[kMPersp1]) + m.fMat[kMPersp2];
-#endif
-            if (z) {
-                z = 1 / z;
-            }
-
-            dst->fY = y * z;
-            dst->fX = x * z;
-            dst += 1;
-        } while (--count);
-    }
+    SkOpts::map_points_perspective(m, dst, src, count);
 }
 
 void SkMatrix::Affine_vpts(const SkMatrix& m, SkPoint dst[], const SkPoint src[], int count) {
     SkASSERT(m.getType() != SkMatrix::kPerspective_Mask);
-    if (count > 0) {
-        SkScalar tx = m.getTranslateX();
-        SkScalar ty = m.getTranslateY();
-        SkScalar sx = m.getScaleX();
-        SkScalar sy = m.getScaleY();
-        SkScalar kx = m.getSkewX();
-        SkScalar ky = m.getSkewY();
-        if (count & 1) {
-            dst->set(src->fX * sx + src->fY * kx + tx,
-                     src->fX * ky + src->fY * sy + ty);
-            src += 1;
-            dst += 1;
-        }
-        Sk4s trans4(tx, ty, tx, ty);
-        Sk4s scale4(sx, sy, sx, sy);
-        Sk4s  skew4(kx, ky, kx, ky);    // applied to swizzle of src4
-        count >>= 1;
-        for (int i = 0; i < count; ++i) {
-            Sk4s src4 = Sk4s::Load(src);
-            Sk4s swz4 = SkNx_shuffle<1,0,3,2>(src4);  // y0 x0, y1 x1
-            (src4 * scale4 + swz4 * skew4 + trans4).store(dst);
-            src += 2;
-            dst += 2;
-        }
-    }
+    SkOpts::map_points_affine(m, dst, src, count);
 }
 
 const SkMatrix::MapPtsProc SkMatrix::gMapPtsProcs[] = {
@@ -1061,8 +968,17 @@ void SkMatrixPriv::MapHomogeneousPointsWithStride(const SkMatrix& mx, SkPoint3 d
 }
 
 void SkMatrix::mapHomogeneousPoints(SkPoint3 dst[], const SkPoint3 src[], int count) const {
-    SkMatrixPriv::MapHomogeneousPointsWithStride(*this, dst, sizeof(SkPoint3), src,
-                                                 sizeof(SkPoint3), count);
+    SkASSERT((dst && src && count > 0) || 0 == count);
+    // no partial overlap
+    SkASSERT(src == dst || &dst[count] <= &src[0] || &src[count] <= &dst[0]);
+
+    if (this->isIdentity()) {
+        if (src != dst && count > 0) {
+            memcpy(dst, src, count * sizeof(SkPoint3));
+        }
+        return;
+    }
+    SkOpts::map_homogeneous_points(*this, dst, src, count);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
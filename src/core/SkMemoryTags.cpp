@@ -0,0 +1,96 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkMemoryTags.h"
+
+#include "include/core/SkString.h"
+#include "include/core/SkTraceMemoryDump.h"
+
+#include <atomic>
+
+const char* sk_memory_tag_name(SkMemoryTag tag) {
+    switch (tag) {
+        case SkMemoryTag::kUntagged:   return "untagged";
+        case SkMemoryTag::kGlyphs:     return "glyphs";
+        case SkMemoryTag::kCodec:      return "codec";
+        case SkMemoryTag::kPathOps:    return "pathops";
+        case SkMemoryTag::kPDF:        return "pdf";
+        case SkMemoryTag::kGpuCPUData: return "gpu_cpu_data";
+    }
+    SK_ABORT("Unknown memory tag");
+    return "";
+}
+
+#if defined(SK_TRACK_MEMORY_TAGS)
+
+namespace {
+
+struct TagCounters {
+    std::atomic<size_t>   fLiveBytes{0};
+    std::atomic<uint64_t> fAllocationCount{0};
+    std::atomic<uint64_t> fAllocatedBytes{0};
+};
+
+// Builds that keep track can afford thread_local; the untracked ones don't need it.
+thread_local SkMemoryTag gCurrentTag = SkMemoryTag::kUntagged;
+TagCounters gCounters[kSkMemoryTagCount];
+
+}  // namespace
+
+SkMemoryTag sk_set_memory_tag(SkMemoryTag tag) {
+    SkMemoryTag previous = gCurrentTag;
+    gCurrentTag = tag;
+    return previous;
+}
+
+bool sk_get_memory_tag_stats(SkMemoryTag tag, SkMemoryTagStats* stats) {
+    const TagCounters& counters = gCounters[static_cast<int>(tag)];
+    stats->fLiveBytes       = counters.fLiveBytes.load(std::memory_order_relaxed);
+    stats->fAllocationCount = counters.fAllocationCount.load(std::memory_order_relaxed);
+    stats->fAllocatedBytes  = counters.fAllocatedBytes.load(std::memory_order_relaxed);
+    return true;
+}
+
+SkMemoryTag SkMemoryTags::CurrentTag() {
+    return gCurrentTag;
+}
+
+void SkMemoryTags::DidAllocate(SkMemoryTag tag, size_t size) {
+    TagCounters& counters = gCounters[static_cast<int>(tag)];
+    counters.fLiveBytes.fetch_add(size, std::memory_order_relaxed);
+    counters.fAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    counters.fAllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+void SkMemoryTags::DidFree(SkMemoryTag tag, size_t size) {
+    gCounters[static_cast<int>(tag)].fLiveBytes.fetch_sub(size, std::memory_order_relaxed);
+}
+
+#else
+
+bool sk_get_memory_tag_stats(SkMemoryTag, SkMemoryTagStats* stats) {
+    *stats = SkMemoryTagStats();
+    return false;
+}
+
+#endif
+
+void SkMemoryTags::DumpMemoryStatistics(SkTraceMemoryDump* dump) {
+    for (int i = 0; i < kSkMemoryTagCount; ++i) {
+        SkMemoryTag tag = static_cast<SkMemoryTag>(i);
+        SkMemoryTagStats stats;
+        if (!sk_get_memory_tag_stats(tag, &stats)) {
+            return;
+        }
+        SkString dumpName = SkStringPrintf("skia/sk_malloc/%s", sk_memory_tag_name(tag));
+        dump->dumpNumericValue(dumpName.c_str(), "size", "bytes", stats.fLiveBytes);
+        dump->dumpNumericValue(dumpName.c_str(), "allocations", "objects",
+                               stats.fAllocationCount);
+        dump->dumpNumericValue(dumpName.c_str(), "allocated_size", "bytes",
+                               stats.fAllocatedBytes);
+    }
+}
@@ -0,0 +1,28 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkMemoryTags_DEFINED
+#define SkMemoryTags_DEFINED
+
+#include "include/private/SkMalloc.h"
+
+class SkTraceMemoryDump;
+
+// The bookkeeping behind SkMemoryTag. Porting layers that keep track call these as blocks come
+// and go; they are only defined when building with SK_TRACK_MEMORY_TAGS.
+namespace SkMemoryTags {
+    // The tag the calling thread's allocations are charged to.
+    SkMemoryTag CurrentTag();
+
+    void DidAllocate(SkMemoryTag tag, size_t size);
+    void DidFree(SkMemoryTag tag, size_t size);
+
+    // Dumps the statistics of each tag as "skia/sk_malloc/<tag name>".
+    void DumpMemoryStatistics(SkTraceMemoryDump* dump);
+}
+
+#endif  // SkMemoryTags_DEFINED
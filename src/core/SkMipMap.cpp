@@ -15,6 +15,8 @@
 #include "include/private/SkNx.h"
 #include "include/private/SkTo.h"
 #include "src/core/SkMathPriv.h"
+#include "src/core/SkOpts.h"
+#include "src/core/SkTaskGroup.h"
 #include <new>
 
 //
@@ -311,6 +313,9 @@ size_t SkMipMap::AllocLevelsSize(int levelCount, size_t pixelSize) {
     return SkTo<int32_t>(size);
 }
 
+// The fewest dst pixels worth handing to another thread when building a level.
+static constexpr int kMinPixelsPerBand = 128 * 1024;
+
 SkMipMap* SkMipMap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact) {
     typedef void FilterProc(void*, const void* srcPtr, size_t srcRB, int count);
 
@@ -332,7 +337,7 @@ SkMipMap* SkMipMap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact) {
             proc_1_2 = downsample_1_2<ColorTypeFilter_8888>;
             proc_1_3 = downsample_1_3<ColorTypeFilter_8888>;
             proc_2_1 = downsample_2_1<ColorTypeFilter_8888>;
-            proc_2_2 = downsample_2_2<ColorTypeFilter_8888>;
+            proc_2_2 = SkOpts::downsample_2_2_8888;
             proc_2_3 = downsample_2_3<ColorTypeFilter_8888>;
             proc_3_1 = downsample_3_1<ColorTypeFilter_8888>;
             proc_3_2 = downsample_3_2<ColorTypeFilter_8888>;
@@ -363,7 +368,7 @@ SkMipMap* SkMipMap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact) {
             proc_1_2 = downsample_1_2<ColorTypeFilter_8>;
             proc_1_3 = downsample_1_3<ColorTypeFilter_8>;
             proc_2_1 = downsample_2_1<ColorTypeFilter_8>;
-            proc_2_2 = downsample_2_2<ColorTypeFilter_8>;
+            proc_2_2 = SkOpts::downsample_2_2_A8;
             proc_2_3 = downsample_2_3<ColorTypeFilter_8>;
             proc_3_1 = downsample_3_1<ColorTypeFilter_8>;
             proc_3_2 = downsample_3_2<ColorTypeFilter_8>;
@@ -374,7 +379,7 @@ SkMipMap* SkMipMap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact) {
             proc_1_2 = downsample_1_2<ColorTypeFilter_F16>;
             proc_1_3 = downsample_1_3<ColorTypeFilter_F16>;
             proc_2_1 = downsample_2_1<ColorTypeFilter_F16>;
-            proc_2_2 = downsample_2_2<ColorTypeFilter_F16>;
+            proc_2_2 = SkOpts::downsample_2_2_F16;
             proc_2_3 = downsample_2_3<ColorTypeFilter_F16>;
             proc_3_1 = downsample_3_1<ColorTypeFilter_F16>;
             proc_3_2 = downsample_3_2<ColorTypeFilter_F16>;
@@ -476,10 +481,21 @@ SkMipMap* SkMipMap::Build(const SkPixmap& src, SkDiscardableFactoryProc fact) {
         void* dstBasePtr = dstPM.writable_addr();
 
         const size_t srcRB = srcPM.rowBytes();
-        for (int y = 0; y < height; y++) {
-            proc(dstBasePtr, srcBasePtr, srcRB, width);
-            srcBasePtr = (char*)srcBasePtr + srcRB * 2; // jump two rows
-            dstBasePtr = (char*)dstBasePtr + dstPM.rowBytes();
+        const size_t dstRB = dstPM.rowBytes();
+        auto filterRows = [=](int y, int end) {
+            for (; y < end; y++) {
+                proc((char*)dstBasePtr + dstRB * y,
+                     (const char*)srcBasePtr + srcRB * 2 * y, // jump two rows
+                     srcRB, width);
+            }
+        };
+
+        // Large levels are split into bands of rows, which may be filtered in parallel.
+        const int rowsPerBand = SkTMax(1, kMinPixelsPerBand / width);
+        if (height > rowsPerBand) {
+            SkTaskGroup().parallelFor(height, filterRows, rowsPerBand);
+        } else {
+            filterRows(0, height);
         }
         srcPM = dstPM;
         addr += height * rowBytes;
@@ -38,6 +38,15 @@ bool SkModeColorFilter::onAsAColorMode(SkColor* color, SkBlendMode* mode) const
     return true;
 }
 
+sk_sp<SkColorFilter> SkModeColorFilter::onMakeComposed(const SkColorFilter&) const {
+    // kSrc (which kClear is turned into) replaces every color with ours, whatever the inner
+    // filter did to it.
+    if (SkBlendMode::kSrc == fMode) {
+        return sk_ref_sp(this);
+    }
+    return nullptr;
+}
+
 uint32_t SkModeColorFilter::getFlags() const {
     uint32_t flags = 0;
     switch (fMode) {
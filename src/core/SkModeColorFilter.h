@@ -29,6 +29,7 @@ protected:
 
     void flatten(SkWriteBuffer&) const override;
     bool onAsAColorMode(SkColor*, SkBlendMode*) const override;
+    sk_sp<SkColorFilter> onMakeComposed(const SkColorFilter& inner) const override;
 
     bool onAppendStages(const SkStageRec& rec, bool shaderIsOpaque) const override;
 
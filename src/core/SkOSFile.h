@@ -49,6 +49,12 @@ void*   sk_fdmmap(int fd, size_t* length);
  */
 void    sk_fmunmap(const void* addr, size_t length);
 
+/** Hints that the memory at [addr, addr + length) will soon be read once, from front to back,
+ *  so that if it is a file mapping the OS can read ahead and reclaim pages behind the reader.
+ *  Any memory may be passed; this never changes its contents. Does nothing where unsupported.
+ */
+void    sk_madvise_sequential(const void* addr, size_t length);
+
 /** Returns true if the two point at the exact same filesystem object. */
 bool    sk_fidentical(FILE* a, FILE* b);
 
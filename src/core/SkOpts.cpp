@@ -9,6 +9,7 @@
 #include "include/private/SkOnce.h"
 #include "src/core/SkCpu.h"
 #include "src/core/SkOpts.h"
+#include "src/core/SkPerfCounters.h"
 
 #if defined(SK_ARM_HAS_NEON)
     #if defined(SK_ARM_HAS_CRC32)
@@ -40,6 +41,8 @@
 #include "src/opts/SkBlitMask_opts.h"
 #include "src/opts/SkBlitRow_opts.h"
 #include "src/opts/SkChecksum_opts.h"
+#include "src/opts/SkMatrix_opts.h"
+#include "src/opts/SkMipMap_opts.h"
 #include "src/opts/SkRasterPipeline_opts.h"
 #include "src/opts/SkSwizzler_opts.h"
 #include "src/opts/SkUtils_opts.h"
@@ -79,6 +82,16 @@ namespace SkOpts {
 
     DEFINE_DEFAULT(hash_fn);
 
+    DEFINE_DEFAULT(downsample_2_2_8888);
+    DEFINE_DEFAULT(downsample_2_2_F16);
+    DEFINE_DEFAULT(downsample_2_2_A8);
+
+    DEFINE_DEFAULT(map_points_translate);
+    DEFINE_DEFAULT(map_points_scale_translate);
+    DEFINE_DEFAULT(map_points_affine);
+    DEFINE_DEFAULT(map_points_perspective);
+    DEFINE_DEFAULT(map_homogeneous_points);
+
     DEFINE_DEFAULT(S32_alpha_D32_filter_DX);
 #undef DEFINE_DEFAULT
 
@@ -102,6 +115,7 @@ namespace SkOpts {
     void Init_sse42();
     void Init_avx();
     void Init_hsw();
+    void Init_skx();
     void Init_crc32();
 
     static void init() {
@@ -124,6 +138,10 @@ namespace SkOpts {
             if (SkCpu::Supports(SkCpu::HSW)) { Init_hsw();   }
         #endif
 
+        #if SK_CPU_SSE_LEVEL < SK_CPU_SSE_LEVEL_AVX512
+            if (SkCpu::Supports(SkCpu::SKX)) { Init_skx();   }
+        #endif
+
     #elif defined(SK_CPU_ARM64)
         if (SkCpu::Supports(SkCpu::CRC32)) { Init_crc32(); }
 
@@ -133,6 +151,9 @@ namespace SkOpts {
 
     void Init() {
         static SkOnce once;
-        once(init);
+        once([] {
+            SkPerfCounters::AutoInitPhase phase(SkGraphics::InitPhase::kOpts);
+            init();
+        });
     }
 }  // namespace SkOpts
@@ -13,6 +13,9 @@
 #include "src/core/SkXfermodePriv.h"
 
 struct SkBitmapProcState;
+class SkMatrix;
+struct SkPoint;
+struct SkPoint3;
 
 namespace SkOpts {
     // Call to replace pointers to portable functions with pointers to CPU-specific functions.
@@ -58,6 +61,21 @@ namespace SkOpts {
         return hash_fn(data, bytes, seed);
     }
 
+    // SkMipMap's 2x2 box filters, writing count pixels from 2*count in each of the two rows.
+    typedef void (*Downsample_2_2)(void* dst, const void* src, size_t srcRB, int count);
+    extern Downsample_2_2 downsample_2_2_8888,
+                          downsample_2_2_F16,
+                          downsample_2_2_A8;
+
+    // SkMatrix's mapPoints() for each type of matrix, and mapHomogeneousPoints().
+    typedef void (*Map_points)(const SkMatrix&, SkPoint dst[], const SkPoint src[], int count);
+    extern Map_points map_points_translate,
+                      map_points_scale_translate,
+                      map_points_affine,
+                      map_points_perspective;
+    extern void (*map_homogeneous_points)(const SkMatrix&, SkPoint3 dst[], const SkPoint3 src[],
+                                          int count);
+
     // SkBitmapProcState optimized Shader, Sample, or Matrix procs.
     // This is the only one that can use anything past SSE2/NEON.
     extern void (*S32_alpha_D32_filter_DX)(const SkBitmapProcState&,
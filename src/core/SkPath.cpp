@@ -179,6 +179,48 @@ SkPath::~SkPath() {
     SkDEBUGCODE(this->validate();)
 }
 
+SkPath SkPath::Make(const SkPoint pts[], int pointCount,
+                    const uint8_t verbs[], int verbCount,
+                    const SkScalar conicWeights[], int conicWeightCount,
+                    FillType fillType, bool isVolatile) {
+    SkPath path;
+    SkPathRef* ref = SkPathRef::CreateFromArrays(pts, pointCount, verbs, verbCount,
+                                                 conicWeights, conicWeightCount);
+    if (!ref) {
+        return path;
+    }
+    path.fPathRef.reset(ref);
+    path.fFillType = fillType;
+    path.fIsVolatile = isVolatile;
+
+    // Leave fLastMoveToIndex as moveTo() and close() would have.
+    int ptIndex = 0;
+    for (int i = 0; i < verbCount; ++i) {
+        switch (verbs[i]) {
+            case kMove_Verb:
+                path.fLastMoveToIndex = ptIndex;
+                // fall-through
+            case kLine_Verb:
+                ptIndex += 1;
+                break;
+            case kQuad_Verb:
+            case kConic_Verb:
+                ptIndex += 2;
+                break;
+            case kCubic_Verb:
+                ptIndex += 3;
+                break;
+            case kClose_Verb:
+                if (path.fLastMoveToIndex >= 0) {
+                    path.fLastMoveToIndex = ~path.fLastMoveToIndex;
+                }
+                break;
+        }
+    }
+    SkDEBUGCODE(path.validate();)
+    return path;
+}
+
 SkPath& SkPath::operator=(const SkPath& that) {
     SkDEBUGCODE(that.validate();)
 
@@ -2625,16 +2667,8 @@ struct Convexicator {
         if (fCurrPt == pt) {
             return true;
         }
-        fCurrPt = pt;
-        if (fPriorPt == fLastPt) {  // should only be true for first non-zero vector
-            fLastVec = fCurrPt - fLastPt;
-            fFirstPt = pt;
-        } else if (!this->addVec(fCurrPt - fLastPt)) {
-            return false;
-        }
-        fPriorPt = fLastPt;
-        fLastPt = fCurrPt;
-        return true;
+        this->countSigns(pt - fCurrPt);
+        return fDxes <= 3 && fDyes <= 3 && this->addNewPt(pt);
     }
 
     static SkPath::Convexity BySign(const SkPoint points[], int count) {
@@ -2674,7 +2708,8 @@ struct Convexicator {
     }
 
     bool close() {
-        return this->addPt(fFirstPt);
+        // This only checks the turn back into the first edge, which BySign() doesn't count again.
+        return fCurrPt == fFirstPt || this->addNewPt(fFirstPt);
     }
 
     bool isFinite() const {
@@ -2686,6 +2721,30 @@ struct Convexicator {
     }
 
 private:
+    // Counts sign changes the same way BySign() does, so that a walk over a single contour gives
+    // up where BySign() would, and never needs BySign() when it doesn't give up.
+    void countSigns(const SkVector& vec) {
+        int sx = sign(vec.fX);
+        int sy = sign(vec.fY);
+        fDxes += (sx != fLastSx);
+        fDyes += (sy != fLastSy);
+        fLastSx = sx;
+        fLastSy = sy;
+    }
+
+    bool addNewPt(const SkPoint& pt) {
+        fCurrPt = pt;
+        if (fPriorPt == fLastPt) {  // should only be true for first non-zero vector
+            fLastVec = fCurrPt - fLastPt;
+            fFirstPt = pt;
+        } else if (!this->addVec(fCurrPt - fLastPt)) {
+            return false;
+        }
+        fPriorPt = fLastPt;
+        fLastPt = fCurrPt;
+        return true;
+    }
+
     DirChange directionChange(const SkVector& curVec) {
         SkScalar cross = SkPoint::CrossProduct(fLastVec, curVec);
         if (!SkScalarIsFinite(cross)) {
@@ -2742,6 +2801,10 @@ private:
     DirChange           fExpectedDir { kInvalid_DirChange };
     SkPathPriv::FirstDirection   fFirstDirection { SkPathPriv::kUnknown_FirstDirection };
     int                 fReversals { 0 };
+    int                 fDxes { 0 };
+    int                 fDyes { 0 };
+    int                 fLastSx { kValueNeverReturnedBySign };
+    int                 fLastSy { kValueNeverReturnedBySign };
     bool                fIsFinite { true };
 };
 
@@ -2761,29 +2824,44 @@ SkPath::Convexity SkPath::internalGetConvexity() const {
     if (0 < fLastMoveToIndex && fLastMoveToIndex < pointCount) {
         pointCount = fLastMoveToIndex;
     }
-    if (pointCount > 3) {
+    const bool checkSigns = pointCount > 3;
+    if (!checkSigns && !this->isFinite()) {
+        return kUnknown_Convexity;
+    }
+    // The walk below counts the same sign changes as it goes, so the separate pass over the
+    // points is only needed to decide why the walk gave up.
+    auto bySign = [=]() {
+        if (!checkSigns) {
+            return kConvex_Convexity;
+        }
         const SkPoint* points = fPathRef->points();
         const SkPoint* last = &points[pointCount];
         // only consider the last of the initial move tos
-        while (SkPath::kMove_Verb == iter.next(pts, false, false)) {
+        SkPoint         movePts[4];
+        SkPath::Iter    moveIter(*this, true);
+        while (SkPath::kMove_Verb == moveIter.next(movePts, false, false)) {
             ++points;
         }
         --points;
-        SkPath::Convexity convexity = Convexicator::BySign(points, (int) (last - points));
-        if (SkPath::kConcave_Convexity == convexity) {
-            return setComputedConvexity(SkPath::kConcave_Convexity);
-        } else if (SkPath::kUnknown_Convexity == convexity) {
-            return SkPath::kUnknown_Convexity;
-        }
-        iter.setPath(*this, true);
-    } else if (!this->isFinite()) {
-        return kUnknown_Convexity;
-    }
+        return Convexicator::BySign(points, (int) (last - points));
+    };
 
     int             contourCount = 0;
     int             count;
     Convexicator    state;
+    auto setConcave = [=]() {
+        SkPath::Convexity convexity = bySign();
+        if (SkPath::kUnknown_Convexity == convexity) {
+            return SkPath::kUnknown_Convexity;
+        }
+        return setComputedConvexity(kConcave_Convexity);
+    };
     auto setFail = [=](){
+        SkPath::Convexity convexity = bySign();
+        if (SkPath::kConvex_Convexity != convexity) {
+            return SkPath::kConcave_Convexity == convexity ? setComputedConvexity(convexity)
+                                                           : convexity;
+        }
         if (!state.isFinite()) {
             return SkPath::kUnknown_Convexity;
         }
@@ -2794,7 +2872,7 @@ SkPath::Convexity SkPath::internalGetConvexity() const {
         switch (verb) {
             case kMove_Verb:
                 if (++contourCount > 1) {
-                    return setComputedConvexity(kConcave_Convexity);
+                    return setConcave();
                 }
                 state.setMovePt(pts[0]);
                 count = 0;
@@ -2818,7 +2896,7 @@ SkPath::Convexity SkPath::internalGetConvexity() const {
                 break;
             default:
                 SkDEBUGFAIL("bad verb");
-                return setComputedConvexity(kConcave_Convexity);
+                return setConcave();
         }
         for (int i = 1; i <= count; i++) {
             if (!state.addPt(pts[i])) {
@@ -3791,9 +3869,7 @@ static int compute_quad_extremas(const SkPoint src[3], SkPoint extremas[3]) {
     int n  = SkFindQuadExtrema(src[0].fX, src[1].fX, src[2].fX, ts);
         n += SkFindQuadExtrema(src[0].fY, src[1].fY, src[2].fY, &ts[n]);
     SkASSERT(n >= 0 && n <= 2);
-    for (int i = 0; i < n; ++i) {
-        extremas[i] = SkEvalQuadAt(src, ts[i]);
-    }
+    SkEvalQuadAt(src, ts, n, extremas);
     extremas[n] = src[2];
     return n + 1;
 }
@@ -3804,9 +3880,7 @@ static int compute_conic_extremas(const SkPoint src[3], SkScalar w, SkPoint extr
     int n  = conic.findXExtrema(ts);
         n += conic.findYExtrema(&ts[n]);
     SkASSERT(n >= 0 && n <= 2);
-    for (int i = 0; i < n; ++i) {
-        extremas[i] = conic.evalAt(ts[i]);
-    }
+    conic.evalAt(ts, n, extremas);
     extremas[n] = src[2];
     return n + 1;
 }
@@ -3816,9 +3890,7 @@ static int compute_cubic_extremas(const SkPoint src[4], SkPoint extremas[5]) {
     int n  = SkFindCubicExtrema(src[0].fX, src[1].fX, src[2].fX, src[3].fX, ts);
         n += SkFindCubicExtrema(src[0].fY, src[1].fY, src[2].fY, src[3].fY, &ts[n]);
     SkASSERT(n >= 0 && n <= 4);
-    for (int i = 0; i < n; ++i) {
-        SkEvalCubicAt(src, ts[i], &extremas[i], nullptr, nullptr);
-    }
+    SkEvalCubicAt(src, ts, n, extremas);
     extremas[n] = src[3];
     return n + 1;
 }
@@ -399,6 +399,36 @@ SkPathRef* SkPathRef::CreateFromBuffer(SkRBuffer* buffer) {
     return ref.release();
 }
 
+SkPathRef* SkPathRef::CreateFromArrays(const SkPoint pts[], int pointCount,
+                                       const uint8_t verbs[], int verbCount,
+                                       const SkScalar conicWeights[], int conicWeightCount) {
+    if (verbCount < 0 || pointCount < 0 || conicWeightCount < 0) {
+        return nullptr;
+    }
+    std::unique_ptr<SkPathRef> ref(new SkPathRef);
+    ref->resetToSize(verbCount, pointCount, conicWeightCount);
+
+    // verbs are stored backwards
+    uint8_t* vb = ref->verbsMemWritable();
+    for (int i = 0; i < verbCount; ++i) {
+        vb[verbCount - 1 - i] = verbs[i];
+    }
+    int pCount, cCount;
+    if (!validate_verb_sequence(vb, verbCount) ||
+        !deduce_pts_conics(vb, verbCount, &pCount, &cCount) ||
+        pCount != pointCount || cCount != conicWeightCount ||
+        !validate_conic_weights(conicWeights, conicWeightCount)) {
+        return nullptr;
+    }
+    sk_careful_memcpy(ref->fPoints, pts, pointCount * sizeof(SkPoint));
+    sk_careful_memcpy(ref->fConicWeights.begin(), conicWeights,
+                      conicWeightCount * sizeof(SkScalar));
+
+    // call this after validate_verb_sequence, since it relies on valid verbs
+    ref->fSegmentMask = ref->computeSegmentMask();
+    return ref.release();
+}
+
 void SkPathRef::Rewind(sk_sp<SkPathRef>* pathRef) {
     if ((*pathRef)->unique()) {
         SkDEBUGCODE((*pathRef)->validate();)
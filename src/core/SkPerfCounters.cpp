@@ -0,0 +1,58 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkPerfCounters.h"
+
+#include "include/core/SkString.h"
+#include "include/core/SkTraceMemoryDump.h"
+
+std::atomic<uint64_t> SkPerfCounters::gCounts[SkGraphics::kPerfCounterCount];
+std::atomic<uint64_t> SkPerfCounters::gInitPhaseNanos[SkGraphics::kInitPhaseCount];
+
+uint64_t SkGraphics::GetPerfCounter(PerfCounter counter) {
+    return SkPerfCounters::gCounts[static_cast<int>(counter)].load(std::memory_order_relaxed);
+}
+
+const char* SkGraphics::PerfCounterName(PerfCounter counter) {
+    switch (counter) {
+        case PerfCounter::kRasterPipelineBuilds:    return "raster_pipeline_builds";
+        case PerfCounter::kRasterPipelineBlitters:  return "raster_pipeline_blitters";
+        case PerfCounter::kLegacyBlitters:          return "legacy_blitters";
+        case PerfCounter::kStrikeCacheHits:         return "strike_cache_hits";
+        case PerfCounter::kStrikeCacheMisses:       return "strike_cache_misses";
+        case PerfCounter::kGpuResourceBudgetPurges: return "gpu_resource_budget_purges";
+        case PerfCounter::kGpuOpMerges:             return "gpu_op_merges";
+        case PerfCounter::kGpuProgramCacheMisses:   return "gpu_program_cache_misses";
+        case PerfCounter::kGpuSoftwarePathMasks:    return "gpu_software_path_masks";
+    }
+    SK_ABORT("Unknown perf counter");
+    return "";
+}
+
+uint64_t SkGraphics::GetInitPhaseNanos(InitPhase phase) {
+    return SkPerfCounters::gInitPhaseNanos[static_cast<int>(phase)].load(std::memory_order_relaxed);
+}
+
+const char* SkGraphics::InitPhaseName(InitPhase phase) {
+    switch (phase) {
+        case InitPhase::kCpuFeatures:    return "cpu_features";
+        case InitPhase::kOpts:           return "opts";
+        case InitPhase::kFlattenables:   return "flattenables";
+        case InitPhase::kDefaultFontMgr: return "default_font_mgr";
+        case InitPhase::kGLCaps:         return "gl_caps";
+    }
+    SK_ABORT("Unknown init phase");
+    return "";
+}
+
+void SkGraphics::DumpPerfCounters(SkTraceMemoryDump* dump) {
+    for (int i = 0; i < kPerfCounterCount; ++i) {
+        PerfCounter counter = static_cast<PerfCounter>(i);
+        SkString dumpName = SkStringPrintf("skia/perf_counters/%s", PerfCounterName(counter));
+        dump->dumpNumericValue(dumpName.c_str(), "count", "events", GetPerfCounter(counter));
+    }
+}
@@ -0,0 +1,45 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkPerfCounters_DEFINED
+#define SkPerfCounters_DEFINED
+
+#include "include/core/SkGraphics.h"
+#include "include/core/SkTime.h"
+
+#include <atomic>
+#include <cstdint>
+
+// The counts behind SkGraphics::GetPerfCounter(). Nothing orders the increments with respect to
+// anything else, so a relaxed fetch_add is all an event costs.
+namespace SkPerfCounters {
+    extern std::atomic<uint64_t> gCounts[SkGraphics::kPerfCounterCount];
+
+    static inline void Add(SkGraphics::PerfCounter counter, uint64_t count = 1) {
+        gCounts[static_cast<int>(counter)].fetch_add(count, std::memory_order_relaxed);
+    }
+
+    extern std::atomic<uint64_t> gInitPhaseNanos[SkGraphics::kInitPhaseCount];
+
+    // Charges the time until it goes out of scope to an init phase. Make one inside the SkOnce
+    // (or constructor) doing the work, so only the work is timed.
+    class AutoInitPhase {
+    public:
+        explicit AutoInitPhase(SkGraphics::InitPhase phase)
+            : fPhase(phase), fStartNanos(SkTime::GetNSecs()) {}
+        ~AutoInitPhase() {
+            uint64_t nanos = static_cast<uint64_t>(SkTime::GetNSecs() - fStartNanos);
+            gInitPhaseNanos[static_cast<int>(fPhase)].fetch_add(nanos, std::memory_order_relaxed);
+        }
+
+    private:
+        SkGraphics::InitPhase fPhase;
+        double                fStartNanos;
+    };
+}
+
+#endif  // SkPerfCounters_DEFINED
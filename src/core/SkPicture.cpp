@@ -11,13 +11,17 @@
 #include "include/core/SkPictureRecorder.h"
 #include "include/core/SkSerialProcs.h"
 #include "include/private/SkTo.h"
+#include "src/core/SkBigPicture.h"
 #include "src/core/SkMathPriv.h"
 #include "src/core/SkPictureCommon.h"
 #include "src/core/SkPictureData.h"
 #include "src/core/SkPicturePlayback.h"
 #include "src/core/SkPicturePriv.h"
 #include "src/core/SkPictureRecord.h"
+#include "src/core/SkPlaybackPicture.h"
+#include "src/core/SkTaskGroup.h"
 #include <atomic>
+#include <vector>
 
 // When we read/write the SkPictInfo via a stream, we have a sentinel byte right after the info.
 // Note: in the read/write buffer versions, we have a slightly different convention:
@@ -29,6 +33,7 @@ enum {
     kFailure_TrailingStreamByteAfterPictInfo     = 0,   // nothing follows
     kPictureData_TrailingStreamByteAfterPictInfo = 1,   // SkPictureData follows
     kCustom_TrailingStreamByteAfterPictInfo      = 2,   // -size32 follows
+    kShared_TrailingStreamByteAfterPictInfo      = 3,   // index32 of an earlier sub-picture
 };
 
 /* SkPicture impl.  This handles generic responsibilities like unique IDs and serialization. */
@@ -40,6 +45,30 @@ SkPicture::SkPicture() {
     } while (fUniqueID == 0);
 }
 
+void SkPicture::playbackParallel(int tileCount,
+                                 const std::function<SkCanvas*(int tile)>& tileCanvas,
+                                 SkExecutor* executor) const {
+    if (tileCount <= 0) {
+        return;
+    }
+
+    // Gather the canvases up front so tileCanvas need not be thread safe.
+    std::vector<SkCanvas*> canvases(tileCount);
+    for (int i = 0; i < tileCount; i++) {
+        canvases[i] = tileCanvas(i);
+    }
+
+    // Our recorded commands are immutable, so every tile can read them at once.
+    // SkBigPicture::playback() uses the canvas clip to query its BBH, if any.
+    SkTaskGroup tasks(executor ? *executor : SkExecutor::GetDefault());
+    tasks.batch(tileCount, [&](int i) {
+        if (canvases[i]) {
+            this->playback(canvases[i]);
+        }
+    });
+    tasks.wait();
+}
+
 static const char kMagic[] = { 's', 'k', 'i', 'a', 'p', 'i', 'c', 't' };
 
 SkPictInfo SkPicture::createHeader() const {
@@ -152,8 +181,42 @@ sk_sp<SkPicture> SkPicture::MakeFromData(const SkData* data, const SkDeserialPro
     return MakeFromStream(&stream, procs, nullptr);
 }
 
+sk_sp<SkPicture> SkPicture::MakeFromDataForPlayback(sk_sp<SkData> data,
+                                                    const SkDeserialProcs* procsPtr) {
+    if (!data) {
+        return nullptr;
+    }
+    SkMemoryStream stream(data->data(), data->size());
+    SkPictInfo info;
+    if (!StreamIsSKP(&stream, &info)) {
+        return nullptr;
+    }
+
+    uint8_t trailingStreamByteAfterPictInfo;
+    if (!stream.readU8(&trailingStreamByteAfterPictInfo)) { return nullptr; }
+    if (trailingStreamByteAfterPictInfo != kPictureData_TrailingStreamByteAfterPictInfo) {
+        return MakeFromData(data.get(), procsPtr);
+    }
+
+    SkDeserialProcs procs;
+    if (procsPtr) {
+        procs = *procsPtr;
+    }
+    std::unique_ptr<const SkPictureData> pictureData(
+            SkPictureData::CreateFromStream(&stream, info, procs, nullptr, data.get()));
+    if (!pictureData) {
+        return nullptr;
+    }
+    // Old files don't record the size of each op, so they can't be walked without playing them.
+    if (auto picture = SkPlaybackPicture::Make(info.fCullRect, std::move(pictureData))) {
+        return picture;
+    }
+    return MakeFromData(data.get(), procsPtr);
+}
+
 sk_sp<SkPicture> SkPicture::MakeFromStream(SkStream* stream, const SkDeserialProcs* procsPtr,
-                                           SkTypefacePlayback* typefaces) {
+                                           SkTypefacePlayback* typefaces,
+                                           SkPictureObjectPlayback* objects) {
     SkPictInfo info;
     if (!StreamIsSKP(stream, &info)) {
         return nullptr;
@@ -166,12 +229,14 @@ sk_sp<SkPicture> SkPicture::MakeFromStream(SkStream* stream, const SkDeserialPro
 
     uint8_t trailingStreamByteAfterPictInfo;
     if (!stream->readU8(&trailingStreamByteAfterPictInfo)) { return nullptr; }
+    sk_sp<SkPicture> picture;
     switch (trailingStreamByteAfterPictInfo) {
         case kPictureData_TrailingStreamByteAfterPictInfo: {
             std::unique_ptr<SkPictureData> data(
-                    SkPictureData::CreateFromStream(stream, info, procs, typefaces));
-            return Forwardport(info, data.get(), nullptr);
-        }
+                    SkPictureData::CreateFromStream(stream, info, procs, typefaces, nullptr,
+                                                    objects));
+            picture = Forwardport(info, data.get(), nullptr);
+        } break;
         case kCustom_TrailingStreamByteAfterPictInfo: {
             int32_t ssize;
             if (!stream->readS32(&ssize) || ssize >= 0 || !procs.fPictureProc) {
@@ -182,12 +247,23 @@ sk_sp<SkPicture> SkPicture::MakeFromStream(SkStream* stream, const SkDeserialPro
             if (stream->read(data->writable_data(), size) != size) {
                 return nullptr;
             }
-            return procs.fPictureProc(data->data(), size, procs.fPictureCtx);
+            picture = procs.fPictureProc(data->data(), size, procs.fPictureCtx);
+        } break;
+        case kShared_TrailingStreamByteAfterPictInfo: {
+            uint32_t index;
+            if (!objects || !stream->readU32(&index) ||
+                index >= SkToU32(objects->fPictures.count())) {
+                return nullptr;
+            }
+            return objects->fPictures[index];
         }
         default:    // fall through to error return
             break;
     }
-    return nullptr;
+    if (picture && objects) {
+        objects->fPictures.push_back(picture);
+    }
+    return picture;
 }
 
 sk_sp<SkPicture> SkPicturePriv::MakeFromBuffer(SkReadBuffer& buffer) {
@@ -217,7 +293,14 @@ SkPictureData* SkPicture::backport() const {
     SkPictInfo info = this->createHeader();
     SkPictureRecord rec(SkISize::Make(info.fCullRect.width(), info.fCullRect.height()), 0/*flags*/);
     rec.beginRecording();
-        this->playback(&rec);
+        // Pictures with a bbh also serialize the bounds of their ops, so readers can play back
+        // just the ops that touch their clip. See SkPlaybackPicture.
+        const SkBigPicture* bigPicture = this->asSkBigPicture();
+        if (bigPicture && bigPicture->bbh()) {
+            bigPicture->playbackWithOpBounds(&rec);
+        } else {
+            this->playback(&rec);
+        }
     rec.endRecording();
     return new SkPictureData(rec, info);
 }
@@ -258,7 +341,7 @@ static bool write_pad32(SkWStream* stream, const void* data, size_t size) {
 }
 
 void SkPicture::serialize(SkWStream* stream, const SkSerialProcs* procsPtr,
-                          SkRefCntSet* typefaceSet) const {
+                          SkRefCntSet* typefaceSet, SkPictureObjectSet* objects) const {
     SkSerialProcs procs;
     if (procsPtr) {
         procs = *procsPtr;
@@ -267,6 +350,13 @@ void SkPicture::serialize(SkWStream* stream, const SkSerialProcs* procsPtr,
     SkPictInfo info = this->createHeader();
     stream->write(&info, sizeof(info));
 
+    int sharedIndex = objects ? objects->findPicture(this) : -1;
+    if (sharedIndex >= 0) {
+        stream->write8(kShared_TrailingStreamByteAfterPictInfo);
+        stream->write32(sharedIndex);
+        return;
+    }
+
     if (auto custom = custom_serialize(this, procs)) {
         int32_t size = SkToS32(custom->size());
         if (size == 0) {
@@ -276,13 +366,19 @@ void SkPicture::serialize(SkWStream* stream, const SkSerialProcs* procsPtr,
         stream->write8(kCustom_TrailingStreamByteAfterPictInfo);
         stream->write32(-size);    // negative for custom format
         write_pad32(stream, custom->data(), size);
+        if (objects) {
+            objects->addPicture(this);
+        }
         return;
     }
 
     std::unique_ptr<SkPictureData> data(this->backport());
     if (data) {
         stream->write8(kPictureData_TrailingStreamByteAfterPictInfo);
-        data->serialize(stream, procs, typefaceSet);
+        data->serialize(stream, procs, typefaceSet, objects);
+        if (objects) {
+            objects->addPicture(this);
+        }
     } else {
         stream->write8(kFailure_TrailingStreamByteAfterPictInfo);
     }
@@ -45,6 +45,7 @@ SkPictureData::SkPictureData(const SkPictureRecord& record,
     , fTextBlobs(record.getTextBlobs())
     , fVertices(record.getVertices())
     , fImages(record.getImages())
+    , fOpBounds(record.getOpBounds())
     , fInfo(info) {
 
     fOpData = record.opData();
@@ -144,7 +145,7 @@ void SkPictureData::WriteTypefaces(SkWStream* stream, const SkRefCntSet& rec,
     }
 }
 
-void SkPictureData::flattenToBuffer(SkWriteBuffer& buffer) const {
+void SkPictureData::flattenToBuffer(SkWriteBuffer& buffer, SkPictureObjectSet* objects) const {
     int i, n;
 
     if ((n = fPaints.count()) > 0) {
@@ -176,7 +177,28 @@ void SkPictureData::flattenToBuffer(SkWriteBuffer& buffer) const {
         }
     }
 
-    if (!fImages.empty()) {
+    if (!fImages.empty() && objects) {
+        // Images already written elsewhere in the picture are written as the index of that copy.
+        write_tag_size(buffer, SK_PICT_SHARED_IMAGE_BUFFER_TAG, fImages.count());
+        for (const auto& img : fImages) {
+            int index = objects->findImage(img.get());
+            if (index < 0) {
+                SkBinaryWriteBuffer imageBuffer;
+                imageBuffer.setSerialProcs(buffer.getSerialProcs());
+                imageBuffer.writeImage(img.get());
+                sk_sp<SkData> bytes = SkData::MakeUninitialized(imageBuffer.bytesWritten());
+                imageBuffer.writeToMemory(bytes->writable_data());
+
+                index = objects->findOrAddImage(img.get(), bytes);
+                if (index < 0) {
+                    buffer.writeInt(-1);
+                    buffer.writePad32(bytes->data(), bytes->size());
+                    continue;
+                }
+            }
+            buffer.writeInt(index);
+        }
+    } else if (!fImages.empty()) {
         write_tag_size(buffer, SK_PICT_IMAGE_BUFFER_TAG, fImages.count());
         for (const auto& img : fImages) {
             buffer.writeImage(img.get());
@@ -197,15 +219,26 @@ static SkSerialProcs skip_typeface_proc(const SkSerialProcs& procs) {
 }
 
 void SkPictureData::serialize(SkWStream* stream, const SkSerialProcs& procs,
-                              SkRefCntSet* topLevelTypeFaceSet) const {
+                              SkRefCntSet* topLevelTypeFaceSet,
+                              SkPictureObjectSet* topLevelObjects) const {
     // This can happen at pretty much any time, so might as well do it first.
     write_tag_size(stream, SK_PICT_READER_TAG, fOpData->size());
     stream->write(fOpData->bytes(), fOpData->size());
 
+    if (!fOpBounds.isEmpty()) {
+        write_tag_size(stream, SK_PICT_OP_BOUNDS_TAG, fOpBounds.count());
+        stream->write(fOpBounds.begin(), fOpBounds.bytes());
+    }
+
     // We serialize all typefaces into the typeface section of the top-level picture.
     SkRefCntSet localTypefaceSet;
     SkRefCntSet* typefaceSet = topLevelTypeFaceSet ? topLevelTypeFaceSet : &localTypefaceSet;
 
+    // Likewise, sub-pictures and images repeated anywhere in the top-level picture are only
+    // written once.
+    SkPictureObjectSet localObjects;
+    SkPictureObjectSet* objects = topLevelObjects ? topLevelObjects : &localObjects;
+
     // We delay serializing the bulk of our data until after we've serialized
     // factories and typefaces by first serializing to an in-memory write buffer.
     SkFactorySet factSet;  // buffer refs factSet, so factSet must come first.
@@ -213,7 +246,7 @@ void SkPictureData::serialize(SkWStream* stream, const SkSerialProcs& procs,
     buffer.setFactoryRecorder(sk_ref_sp(&factSet));
     buffer.setSerialProcs(skip_typeface_proc(procs));
     buffer.setTypefaceRecorder(sk_ref_sp(typefaceSet));
-    this->flattenToBuffer(buffer);
+    this->flattenToBuffer(buffer, objects);
 
     // Dummy serialize our sub-pictures for the side effect of filling
     // typefaceSet with typefaces from sub-pictures.
@@ -245,7 +278,7 @@ void SkPictureData::serialize(SkWStream* stream, const SkSerialProcs& procs,
     if (!fPictures.empty()) {
         write_tag_size(stream, SK_PICT_PICTURE_TAG, fPictures.count());
         for (const auto& pic : fPictures) {
-            pic->serialize(stream, &procs, typefaceSet);
+            pic->serialize(stream, &procs, typefaceSet, objects);
         }
     }
 
@@ -281,15 +314,43 @@ bool SkPictureData::parseStreamTag(SkStream* stream,
                                    uint32_t tag,
                                    uint32_t size,
                                    const SkDeserialProcs& procs,
-                                   SkTypefacePlayback* topLevelTFPlayback) {
+                                   SkTypefacePlayback* topLevelTFPlayback,
+                                   const SkData* backingData,
+                                   SkPictureObjectPlayback* objects) {
     switch (tag) {
-        case SK_PICT_READER_TAG:
+        case SK_PICT_READER_TAG: {
             SkASSERT(nullptr == fOpData);
-            fOpData = SkData::MakeFromStream(stream, size);
+            const void* base = stream->getMemoryBase();
+            if (backingData && base == backingData->data() && stream->hasPosition()) {
+                size_t offset = stream->getPosition();
+                if (size > backingData->size() - offset || stream->skip(size) != size) {
+                    return false;
+                }
+                fOpData = SkData::MakeSubset(backingData, offset, size);
+            } else {
+                fOpData = SkData::MakeFromStream(stream, size);
+            }
             if (!fOpData) {
                 return false;
             }
             break;
+        }
+        case SK_PICT_OP_BOUNDS_TAG: {
+            if (!fOpBounds.isEmpty() || !SkTFitsIn<int>(size) ||
+                size > SIZE_MAX / sizeof(SkPictureOpBounds)) {
+                return false;
+            }
+            size_t bytes = size * sizeof(SkPictureOpBounds);
+            if (stream->hasLength() && stream->hasPosition() &&
+                bytes > stream->getLength() - stream->getPosition()) {
+                return false;
+            }
+            fOpBounds.setCount(size);
+            if (stream->read(fOpBounds.begin(), bytes) != bytes) {
+                return false;
+            }
+            break;
+        }
         case SK_PICT_FACTORY_TAG: {
             if (!stream->readU32(&size)) { return false; }
             fFactoryPlayback = skstd::make_unique<SkFactoryPlayback>(size);
@@ -321,7 +382,7 @@ bool SkPictureData::parseStreamTag(SkStream* stream,
             fPictures.reserve(SkToInt(size));
 
             for (uint32_t i = 0; i < size; i++) {
-                auto pic = SkPicture::MakeFromStream(stream, &procs, topLevelTFPlayback);
+                auto pic = SkPicture::MakeFromStream(stream, &procs, topLevelTFPlayback, objects);
                 if (!pic) {
                     return false;
                 }
@@ -354,7 +415,7 @@ bool SkPictureData::parseStreamTag(SkStream* stream,
             while (!buffer.eof() && buffer.isValid()) {
                 tag = buffer.readUInt();
                 size = buffer.readUInt();
-                this->parseBufferTag(buffer, tag, size);
+                this->parseBufferTag(buffer, tag, size, objects);
             }
             if (!buffer.isValid()) {
                 return false;
@@ -368,8 +429,10 @@ static sk_sp<SkImage> create_image_from_buffer(SkReadBuffer& buffer) {
     return buffer.readImage();
 }
 static sk_sp<SkVertices> create_vertices_from_buffer(SkReadBuffer& buffer) {
-    auto data = buffer.readByteArrayAsData();
-    return data ? SkVertices::Decode(data->data(), data->size()) : nullptr;
+    // Decode straight from the buffer; SkVertices copies the arrays out itself.
+    size_t size;
+    const void* data = buffer.skipByteArray(&size);
+    return data ? SkVertices::Decode(data, size) : nullptr;
 }
 
 static sk_sp<SkDrawable> create_drawable_from_buffer(SkReadBuffer& buffer) {
@@ -401,7 +464,8 @@ bool new_array_from_buffer(SkReadBuffer& buffer, uint32_t inCount,
     return true;
 }
 
-void SkPictureData::parseBufferTag(SkReadBuffer& buffer, uint32_t tag, uint32_t size) {
+void SkPictureData::parseBufferTag(SkReadBuffer& buffer, uint32_t tag, uint32_t size,
+                                   SkPictureObjectPlayback* objects) {
     switch (tag) {
         case SK_PICT_PAINT_BUFFER_TAG: {
             if (!buffer.validate(SkTFitsIn<int>(size))) {
@@ -438,6 +502,28 @@ void SkPictureData::parseBufferTag(SkReadBuffer& buffer, uint32_t tag, uint32_t
         case SK_PICT_IMAGE_BUFFER_TAG:
             new_array_from_buffer(buffer, size, fImages, create_image_from_buffer);
             break;
+        case SK_PICT_SHARED_IMAGE_BUFFER_TAG: {
+            if (!buffer.validate(objects && fImages.empty() && SkTFitsIn<int>(size))) {
+                return;
+            }
+            for (uint32_t i = 0; i < size; ++i) {
+                int index = buffer.readInt();
+                sk_sp<const SkImage> image;
+                if (index == -1) {
+                    image = buffer.readImage();
+                    if (image) {
+                        objects->fImages.push_back(image);
+                    }
+                } else if (buffer.validate(index >= 0 && index < objects->fImages.count())) {
+                    image = objects->fImages[index];
+                }
+                if (!buffer.validate(image != nullptr)) {
+                    fImages.reset();
+                    return;
+                }
+                fImages.push_back(std::move(image));
+            }
+        } break;
         case SK_PICT_READER_TAG: {
             // Preflight check that we can initialize all data from the buffer
             // before allocating it.
@@ -467,13 +553,19 @@ void SkPictureData::parseBufferTag(SkReadBuffer& buffer, uint32_t tag, uint32_t
 SkPictureData* SkPictureData::CreateFromStream(SkStream* stream,
                                                const SkPictInfo& info,
                                                const SkDeserialProcs& procs,
-                                               SkTypefacePlayback* topLevelTFPlayback) {
+                                               SkTypefacePlayback* topLevelTFPlayback,
+                                               const SkData* backingData,
+                                               SkPictureObjectPlayback* objects) {
     std::unique_ptr<SkPictureData> data(new SkPictureData(info));
     if (!topLevelTFPlayback) {
         topLevelTFPlayback = &data->fTFPlayback;
     }
+    SkPictureObjectPlayback localObjects;
+    if (!objects) {
+        objects = &localObjects;
+    }
 
-    if (!data->parseStream(stream, procs, topLevelTFPlayback)) {
+    if (!data->parseStream(stream, procs, topLevelTFPlayback, backingData, objects)) {
         return nullptr;
     }
     return data.release();
@@ -492,7 +584,9 @@ SkPictureData* SkPictureData::CreateFromBuffer(SkReadBuffer& buffer,
 
 bool SkPictureData::parseStream(SkStream* stream,
                                 const SkDeserialProcs& procs,
-                                SkTypefacePlayback* topLevelTFPlayback) {
+                                SkTypefacePlayback* topLevelTFPlayback,
+                                const SkData* backingData,
+                                SkPictureObjectPlayback* objects) {
     for (;;) {
         uint32_t tag;
         if (!stream->readU32(&tag)) { return false; }
@@ -502,7 +596,8 @@ bool SkPictureData::parseStream(SkStream* stream,
 
         uint32_t size;
         if (!stream->readU32(&size)) { return false; }
-        if (!this->parseStreamTag(stream, tag, size, procs, topLevelTFPlayback)) {
+        if (!this->parseStreamTag(stream, tag, size, procs, topLevelTFPlayback, backingData,
+                                  objects)) {
             return false; // we're invalid
         }
     }
@@ -55,6 +55,7 @@ public:
 #define SK_PICT_TYPEFACE_TAG   SkSetFourByteTag('t', 'p', 'f', 'c')
 #define SK_PICT_PICTURE_TAG    SkSetFourByteTag('p', 'c', 't', 'r')
 #define SK_PICT_DRAWABLE_TAG   SkSetFourByteTag('d', 'r', 'a', 'w')
+#define SK_PICT_OP_BOUNDS_TAG  SkSetFourByteTag('o', 'b', 'n', 'd')
 
 // This tag specifies the size of the ReadBuffer, needed for the following tags
 #define SK_PICT_BUFFER_SIZE_TAG     SkSetFourByteTag('a', 'r', 'a', 'y')
@@ -64,6 +65,9 @@ public:
 #define SK_PICT_TEXTBLOB_BUFFER_TAG SkSetFourByteTag('b', 'l', 'o', 'b')
 #define SK_PICT_VERTICES_BUFFER_TAG SkSetFourByteTag('v', 'e', 'r', 't')
 #define SK_PICT_IMAGE_BUFFER_TAG    SkSetFourByteTag('i', 'm', 'a', 'g')
+// Each image is an int32 index of an image already read by SkPictureObjectPlayback, or -1 and
+// the image itself.
+#define SK_PICT_SHARED_IMAGE_BUFFER_TAG SkSetFourByteTag('s', 'i', 'm', 'g')
 
 // Always write this guy last (with no length field afterwards)
 #define SK_PICT_EOF_TAG     SkSetFourByteTag('e', 'o', 'f', ' ')
@@ -77,23 +81,30 @@ T* read_index_base_1_or_null(SkReadBuffer* reader, const SkTArray<sk_sp<T>>& arr
 class SkPictureData {
 public:
     SkPictureData(const SkPictureRecord& record, const SkPictInfo&);
-    // Does not affect ownership of SkStream.
+    // Does not affect ownership of SkStream. If the stream reads from 'backingData', the op data
+    // references it instead of being copied. 'objects' are the sub-pictures and images read so
+    // far by the top-level picture; pass nullptr for the top-level picture itself.
     static SkPictureData* CreateFromStream(SkStream*,
                                            const SkPictInfo&,
                                            const SkDeserialProcs&,
-                                           SkTypefacePlayback*);
+                                           SkTypefacePlayback*,
+                                           const SkData* backingData = nullptr,
+                                           SkPictureObjectPlayback* objects = nullptr);
     static SkPictureData* CreateFromBuffer(SkReadBuffer&, const SkPictInfo&);
 
-    void serialize(SkWStream*, const SkSerialProcs&, SkRefCntSet*) const;
+    void serialize(SkWStream*, const SkSerialProcs&, SkRefCntSet*,
+                   SkPictureObjectSet* objects = nullptr) const;
     void flatten(SkWriteBuffer&) const;
 
     const sk_sp<SkData>& opData() const { return fOpData; }
+    const SkTDArray<SkPictureOpBounds>& opBounds() const { return fOpBounds; }
 
 protected:
     explicit SkPictureData(const SkPictInfo& info);
 
     // Does not affect ownership of SkStream.
-    bool parseStream(SkStream*, const SkDeserialProcs&, SkTypefacePlayback*);
+    bool parseStream(SkStream*, const SkDeserialProcs&, SkTypefacePlayback*,
+                     const SkData* backingData, SkPictureObjectPlayback*);
     bool parseBuffer(SkReadBuffer& buffer);
 
 public:
@@ -138,15 +149,19 @@ private:
     // these help us with reading/writing
     // Does not affect ownership of SkStream.
     bool parseStreamTag(SkStream*, uint32_t tag, uint32_t size,
-                        const SkDeserialProcs&, SkTypefacePlayback*);
-    void parseBufferTag(SkReadBuffer&, uint32_t tag, uint32_t size);
-    void flattenToBuffer(SkWriteBuffer&) const;
+                        const SkDeserialProcs&, SkTypefacePlayback*, const SkData* backingData,
+                        SkPictureObjectPlayback*);
+    void parseBufferTag(SkReadBuffer&, uint32_t tag, uint32_t size,
+                        SkPictureObjectPlayback* objects = nullptr);
+    void flattenToBuffer(SkWriteBuffer&, SkPictureObjectSet* objects = nullptr) const;
 
     SkTArray<SkPaint>  fPaints;
     SkTArray<SkPath>   fPaths;
 
     sk_sp<SkData>   fOpData;    // opcodes and parameters
 
+    SkTDArray<SkPictureOpBounds> fOpBounds;    // empty unless recorded with a bbh
+
     const SkPath    fEmptyPath;
     const SkBitmap  fEmptyBitmap;
 
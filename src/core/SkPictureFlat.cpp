@@ -6,11 +6,14 @@
  */
 
 #include "include/core/SkColorFilter.h"
+#include "include/core/SkData.h"
 #include "include/core/SkDrawLooper.h"
+#include "include/core/SkImage.h"
 #include "include/core/SkMaskFilter.h"
 #include "include/core/SkShader.h"
 #include "include/core/SkTypeface.h"
 #include "include/private/SkChecksum.h"
+#include "src/core/SkOpts.h"
 #include "src/core/SkPictureFlat.h"
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -19,3 +22,35 @@ void SkTypefacePlayback::setCount(size_t count) {
     fCount = count;
     fArray.reset(new sk_sp<SkTypeface>[count]);
 }
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+int SkPictureObjectSet::findPicture(const SkPicture* picture) const {
+    const int* index = fPictureIDs.find(picture->uniqueID());
+    return index ? *index : -1;
+}
+
+void SkPictureObjectSet::addPicture(const SkPicture* picture) {
+    fPictureIDs.set(picture->uniqueID(), fPictureCount++);
+}
+
+int SkPictureObjectSet::findImage(const SkImage* image) const {
+    const int* index = fImageIDs.find(image->uniqueID());
+    return index ? *index : -1;
+}
+
+int SkPictureObjectSet::findOrAddImage(const SkImage* image, sk_sp<SkData> bytes) {
+    uint32_t hash = SkOpts::hash(bytes->data(), bytes->size());
+    if (const int* index = fImageHashes.find(hash)) {
+        if (fImageBytes[*index]->equals(bytes.get())) {
+            fImageIDs.set(image->uniqueID(), *index);
+            return *index;
+        }
+    } else {
+        fImageHashes.set(hash, fImageBytes.count());
+    }
+    fImageIDs.set(image->uniqueID(), fImageBytes.count());
+    fImageBytes.push_back(std::move(bytes));
+    return -1;
+}
@@ -11,6 +11,7 @@
 #include "include/core/SkPaint.h"
 #include "include/core/SkPicture.h"
 #include "include/private/SkChecksum.h"
+#include "include/private/SkTHash.h"
 #include "src/core/SkPtrRecorder.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkTDynamicHash.h"
@@ -165,6 +166,17 @@ static inline bool ClipParams_unpackDoAA(uint32_t packed) {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// A run of ops in the op data that together draw within fBounds, in picture space. Pictures
+// recorded with a bounding box hierarchy serialize one of these for each recorded op, so readers
+// can play back just the ops that touch their query rect.
+struct SkPictureOpBounds {
+    uint32_t fOffset;    // of the first op, in bytes from the start of the op data
+    uint32_t fSize;      // in bytes
+    SkRect   fBounds;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
 class SkTypefacePlayback {
 public:
     SkTypefacePlayback() : fCount(0), fArray(nullptr) {}
@@ -188,6 +200,38 @@ protected:
     std::unique_ptr<sk_sp<SkTypeface>[]> fArray;
 };
 
+// The sub-pictures and images already written while serializing a picture and its sub-pictures,
+// so that repeats can be written as the index of the first copy. Pictures are matched by
+// uniqueID; images by uniqueID, or failing that by their serialized bytes.
+class SkPictureObjectSet {
+public:
+    // Returns the index of an earlier copy of 'picture', or -1.
+    int findPicture(const SkPicture* picture) const;
+    // Call after 'picture' has been written in full.
+    void addPicture(const SkPicture* picture);
+
+    // Returns the index of an earlier copy of 'image', or -1.
+    int findImage(const SkImage* image) const;
+    // Returns the index of an earlier image that serialized to 'bytes', or else notes that
+    // 'image' is about to be written as 'bytes' and returns -1.
+    int findOrAddImage(const SkImage* image, sk_sp<SkData> bytes);
+
+private:
+    SkTHashMap<uint32_t, int>  fPictureIDs;
+    int                        fPictureCount = 0;
+
+    SkTHashMap<uint32_t, int>  fImageIDs;
+    SkTHashMap<uint32_t, int>  fImageHashes;    // of the first image with each hash
+    SkTArray<sk_sp<SkData>>    fImageBytes;
+};
+
+// The sub-pictures and images read so far while deserializing a picture and its sub-pictures,
+// matching the indices written by SkPictureObjectSet.
+struct SkPictureObjectPlayback {
+    SkTArray<sk_sp<SkPicture>>       fPictures;
+    SkTArray<sk_sp<const SkImage>>   fImages;
+};
+
 class SkFactoryPlayback {
 public:
     SkFactoryPlayback(int count) : fCount(count) { fArray = new SkFlattenable::Factory[count]; }
@@ -103,6 +103,50 @@ void SkPicturePlayback::draw(SkCanvas* canvas,
     }
 }
 
+void SkPicturePlayback::drawOps(SkCanvas* canvas,
+                                SkPicture::AbortCallback* callback,
+                                const int indices[],
+                                int count) {
+    AutoResetOpID aroi(this);
+    SkASSERT(0 == fCurOffset);
+
+    const SkTDArray<SkPictureOpBounds>& opBounds = fPictureData->opBounds();
+    SkReadBuffer reader(fPictureData->opData()->bytes(),
+                        fPictureData->opData()->size());
+
+    // Record this, so we can concat w/ it if we encounter a setMatrix()
+    SkMatrix initialMatrix = canvas->getTotalMatrix();
+
+    SkAutoCanvasRestore acr(canvas, false);
+
+    for (int i = 0; i < count; i++) {
+        const SkPictureOpBounds& ops = opBounds[indices[i]];
+        size_t stop = ops.fOffset + ops.fSize;
+        // A clip that empties the canvas skips ahead to its restore, maybe past these ops.
+        if (reader.offset() < ops.fOffset) {
+            reader.skip(ops.fOffset - reader.offset());
+        }
+
+        while (reader.offset() < stop && !reader.eof()) {
+            if (callback && callback->abort()) {
+                return;
+            }
+
+            fCurOffset = reader.offset();
+            uint32_t size;
+            DrawType op = ReadOpAndSize(&reader, &size);
+            if (!reader.validate(op > UNUSED && op <= LAST_DRAWTYPE_ENUM)) {
+                return;
+            }
+
+            this->handleOp(&reader, op, size, canvas, initialMatrix);
+        }
+        if (!reader.isValid()) {
+            return;
+        }
+    }
+}
+
 static void validate_offsetToRestore(SkReadBuffer* reader, size_t offsetToRestore) {
     if (offsetToRestore) {
         reader->validate(SkIsAlign4(offsetToRestore) && offsetToRestore >= reader->offset());
@@ -25,12 +25,18 @@ public:
 
     void draw(SkCanvas* canvas, SkPicture::AbortCallback*, SkReadBuffer* buffer);
 
+    // Plays back only the runs of ops opBounds()[indices[0..count)], which must be ascending.
+    void drawOps(SkCanvas* canvas, SkPicture::AbortCallback*, const int indices[], int count);
+
     // TODO: remove the curOp calls after cleaning up GrGatherDevice
     // Return the ID of the operation currently being executed when playing
     // back. 0 indicates no call is active.
     size_t curOpID() const { return fCurOffset; }
     void resetOpID() { fCurOffset = 0; }
 
+    // Reads the op code at the start of an op and the size of the whole op, in bytes.
+    static DrawType ReadOpAndSize(SkReadBuffer* reader, uint32_t* size);
+
 protected:
     const SkPictureData* fPictureData;
 
@@ -43,8 +49,6 @@ protected:
                   SkCanvas* canvas,
                   const SkMatrix& initialMatrix);
 
-    static DrawType ReadOpAndSize(SkReadBuffer* reader, uint32_t* size);
-
     class AutoResetOpID {
     public:
         AutoResetOpID(SkPicturePlayback* playback) : fPlayback(playback) { }
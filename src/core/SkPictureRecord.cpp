@@ -297,6 +297,13 @@ void SkPictureRecord::endRecording() {
     this->restoreToCount(fInitialSaveCount);
 }
 
+void SkPictureRecord::recordOpBounds(size_t offset, const SkRect& bounds) {
+    size_t size = fWriter.bytesWritten() - offset;
+    if (size > 0) {
+        fOpBounds.push_back({ SkToU32(offset), SkToU32(size), bounds });
+    }
+}
+
 size_t SkPictureRecord::recordRestoreOffsetPlaceholder(SkClipOp op) {
     if (fRestoreOffsetStack.isEmpty()) {
         return -1;
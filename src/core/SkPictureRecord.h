@@ -70,6 +70,13 @@ public:
         return fWriter;
     }
 
+    // Notes that the ops written since 'offset' draw within 'bounds'.
+    void recordOpBounds(size_t offset, const SkRect& bounds);
+
+    const SkTDArray<SkPictureOpBounds>& getOpBounds() const {
+        return fOpBounds;
+    }
+
     void beginRecording();
     void endRecording();
 
@@ -85,6 +92,8 @@ private:
 
     SkTDArray<uint32_t> fCullOffsetStack;
 
+    SkTDArray<SkPictureOpBounds> fOpBounds;
+
     /*
      * Write the 'drawType' operation and chunk size to the skp. 'size'
      * can potentially be increased if the chunk size needs its own storage
@@ -64,6 +64,9 @@ sk_sp<SkPicture> SkPictureRecorder::finishRecordingAsPicture(uint32_t finishFlag
     }
 
     // TODO: delay as much of this work until just before first playback?
+    if (fFlags & kCullOccludedDraws_RecordFlag) {
+        SkRecordCullOccludedDraws(fRecord.get());
+    }
     SkRecordOptimize(fRecord.get());
 
     SkDrawableList* drawableList = fRecorder->getDrawableList();
@@ -118,6 +121,9 @@ sk_sp<SkDrawable> SkPictureRecorder::finishRecordingAsDrawable(uint32_t finishFl
     fRecorder->flushMiniRecorder();
     fRecorder->restoreToCount(1);  // If we were missing any restores, add them now.
 
+    if (fFlags & kCullOccludedDraws_RecordFlag) {
+        SkRecordCullOccludedDraws(fRecord.get());
+    }
     SkRecordOptimize(fRecord.get());
 
     if (fBBH.get()) {
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkPlaybackPicture.h"
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkTextBlob.h"
+#include "include/private/SkTemplates.h"
+#include "src/core/SkPictureData.h"
+#include "src/core/SkPicturePlayback.h"
+#include "src/core/SkRTree.h"
+#include "src/core/SkReadBuffer.h"
+
+#include <algorithm>
+#include <vector>
+
+sk_sp<SkPicture> SkPlaybackPicture::Make(const SkRect& cull,
+                                         std::unique_ptr<const SkPictureData> data) {
+    if (!data || !data->opData()) {
+        return nullptr;
+    }
+
+    // Walk the ops once to count them, which also makes sure each one fits in the op data.
+    const SkData* ops = data->opData().get();
+    SkReadBuffer reader(ops->data(), ops->size());
+    std::vector<size_t> opOffsets;
+    while (!reader.eof()) {
+        size_t start = reader.offset();
+        uint32_t size;
+        SkPicturePlayback::ReadOpAndSize(&reader, &size);
+        size_t headerSize = reader.offset() - start;
+        if (!reader.isValid() || size < headerSize || size > ops->size() - start) {
+            return nullptr;
+        }
+        reader.skip(size - headerSize);
+        opOffsets.push_back(start);
+    }
+    int opCount = SkToInt(opOffsets.size());
+    opOffsets.push_back(ops->size());
+
+    // Each run of ops with bounds must start and stop between ops, in order.
+    const SkTDArray<SkPictureOpBounds>& opBounds = data->opBounds();
+    size_t prevStop = 0;
+    for (const SkPictureOpBounds& run : opBounds) {
+        size_t stop = (size_t)run.fOffset + run.fSize;
+        if (run.fOffset < prevStop || run.fSize == 0 ||
+            !std::binary_search(opOffsets.begin(), opOffsets.end(), run.fOffset) ||
+            !std::binary_search(opOffsets.begin(), opOffsets.end(), stop)) {
+            return nullptr;
+        }
+        prevStop = stop;
+    }
+
+    sk_sp<SkBBoxHierarchy> bbh;
+    if (!opBounds.isEmpty()) {
+        SkAutoTMalloc<SkRect> bounds(opBounds.count());
+        for (int i = 0; i < opBounds.count(); i++) {
+            bounds[i] = opBounds[i].fBounds;
+        }
+        bbh = sk_make_sp<SkRTree>();
+        bbh->insert(bounds, opBounds.count());
+    }
+    return sk_sp<SkPicture>(new SkPlaybackPicture(cull, std::move(data), std::move(bbh),
+                                                  opCount));
+}
+
+SkPlaybackPicture::SkPlaybackPicture(const SkRect& cull,
+                                     std::unique_ptr<const SkPictureData> data,
+                                     sk_sp<SkBBoxHierarchy> bbh,
+                                     int opCount)
+    : fCullRect(cull)
+    , fData(std::move(data))
+    , fBBH(std::move(bbh))
+    , fOpCount(opCount)
+{}
+
+SkPlaybackPicture::~SkPlaybackPicture() {}
+
+void SkPlaybackPicture::playback(SkCanvas* canvas, AbortCallback* callback) const {
+    SkASSERT(canvas);
+
+    SkPicturePlayback playback(fData.get());
+    // If the query contains the whole picture, don't bother with the BBH.
+    SkRect query = canvas->getLocalClipBounds();
+    if (fBBH && !query.contains(fCullRect)) {
+        SkTDArray<int> ops;
+        fBBH->search(query, &ops);
+        playback.drawOps(canvas, callback, ops.begin(), ops.count());
+        return;
+    }
+    playback.draw(canvas, callback, nullptr);
+}
+
+size_t SkPlaybackPicture::approximateBytesUsed() const {
+    // The op data may be memory mapped, but count it anyway: it's what this picture keeps alive.
+    size_t bytes = sizeof(*this) + sizeof(SkPictureData) + fData->opData()->size();
+    if (fBBH) { bytes += fBBH->bytesUsed(); }
+    return bytes;
+}
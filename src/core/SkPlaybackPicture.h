@@ -0,0 +1,47 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkPlaybackPicture_DEFINED
+#define SkPlaybackPicture_DEFINED
+
+#include "include/core/SkPicture.h"
+#include "include/core/SkRect.h"
+
+#include <memory>
+
+class SkBBoxHierarchy;
+class SkPictureData;
+
+// An SkPicture that plays back straight from deserialized SkPictureData with SkPicturePlayback,
+// without building an SkRecord. See SkPicture::MakeFromDataForPlayback().
+//
+// If the picture was serialized with the bounds of its ops, playback() only reads the ops that
+// touch the canvas's clip, so a tile can be drawn without paging in the rest of the op data.
+class SkPlaybackPicture final : public SkPicture {
+public:
+    // Returns nullptr if 'data' has no ops, or its ops or their bounds don't line up.
+    static sk_sp<SkPicture> Make(const SkRect& cull, std::unique_ptr<const SkPictureData> data);
+
+    ~SkPlaybackPicture() override;
+
+// SkPicture overrides
+    void playback(SkCanvas*, AbortCallback*) const override;
+    SkRect cullRect() const override { return fCullRect; }
+    int approximateOpCount() const override { return fOpCount; }
+    size_t approximateBytesUsed() const override;
+
+private:
+    SkPlaybackPicture(const SkRect& cull, std::unique_ptr<const SkPictureData>,
+                      sk_sp<SkBBoxHierarchy>, int opCount);
+
+    const SkRect                         fCullRect;
+    std::unique_ptr<const SkPictureData> fData;
+    sk_sp<const SkBBoxHierarchy>         fBBH;
+    const int                            fOpCount;
+};
+
+#endif
@@ -7,6 +7,8 @@
 
 #include "src/core/SkRTree.h"
 
+#include "include/private/SkNx.h"
+
 SkRTree::SkRTree() : fCount(0) {}
 
 SkRect SkRTree::getRootBound() const {
@@ -39,8 +41,7 @@ void SkRTree::insert(const SkRect boundsArray[], int N) {
         if (1 == fCount) {
             fNodes.setReserve(1);
             Node* n = this->allocateNodeAtLevel(0);
-            n->fNumChildren = 1;
-            n->fChildren[0] = branches[0];
+            n->addChild(branches[0]);
             fRoot.fSubtree = n;
             fRoot.fBounds  = branches[0].fBounds;
         } else {
@@ -56,9 +57,27 @@ SkRTree::Node* SkRTree::allocateNodeAtLevel(uint16_t level) {
     SkASSERT(fNodes.begin() == p);  // If this fails, we didn't setReserve() enough.
     out->fNumChildren = 0;
     out->fLevel = level;
+    for (int i = 0; i < kMaxChildren; ++i) {
+        out->fLeft[i] = out->fTop[i] = SK_ScalarInfinity;
+        out->fRight[i] = out->fBottom[i] = SK_ScalarNegativeInfinity;
+    }
     return out;
 }
 
+void SkRTree::Node::addChild(const Branch& branch) {
+    SkASSERT(fNumChildren < kMaxChildren);
+    int i = fNumChildren++;
+    fLeft[i]   = branch.fBounds.fLeft;
+    fTop[i]    = branch.fBounds.fTop;
+    fRight[i]  = branch.fBounds.fRight;
+    fBottom[i] = branch.fBounds.fBottom;
+    if (0 == fLevel) {
+        fChildren[i].fOpIndex = branch.fOpIndex;
+    } else {
+        fChildren[i].fSubtree = branch.fSubtree;
+    }
+}
+
 // This function parallels bulkLoad, but just counts how many nodes bulkLoad would allocate.
 int SkRTree::CountNodes(int branches) {
     if (branches == 1) {
@@ -132,16 +151,14 @@ SkRTree::Branch SkRTree::bulkLoad(SkTDArray<Branch>* branches, int level) {
             }
         }
         Node* n = allocateNodeAtLevel(level);
-        n->fNumChildren = 1;
-        n->fChildren[0] = (*branches)[currentBranch];
+        n->addChild((*branches)[currentBranch]);
         Branch b;
         b.fBounds = (*branches)[currentBranch].fBounds;
         b.fSubtree = n;
         ++currentBranch;
         for (int k = 1; k < incrementBy && currentBranch < branches->count(); ++k) {
             b.fBounds.join((*branches)[currentBranch].fBounds);
-            n->fChildren[k] = (*branches)[currentBranch];
-            ++n->fNumChildren;
+            n->addChild((*branches)[currentBranch]);
             ++currentBranch;
         }
         (*branches)[newBranches] = b;
@@ -158,8 +175,20 @@ void SkRTree::search(const SkRect& query, SkTDArray<int>* results) const {
 }
 
 void SkRTree::search(Node* node, const SkRect& query, SkTDArray<int>* results) const {
+    static_assert(kMaxChildren == 8, "");
+    // SkRect::Intersects() for all the children at once: does the intersection have area?
+    Sk8f L = Sk8f::Max(Sk8f::Load(node->fLeft),   query.fLeft),
+         T = Sk8f::Max(Sk8f::Load(node->fTop),    query.fTop),
+         R = Sk8f::Min(Sk8f::Load(node->fRight),  query.fRight),
+         B = Sk8f::Min(Sk8f::Load(node->fBottom), query.fBottom);
+    Sk8f hits = Sk8f::Min(R - L, B - T) > 0;
+    if (!hits.anyTrue()) {
+        return;
+    }
+    uint32_t hitBits[kMaxChildren];
+    hits.store(hitBits);
     for (int i = 0; i < node->fNumChildren; ++i) {
-        if (SkRect::Intersects(node->fChildren[i].fBounds, query)) {
+        if (hitBits[i]) {
             if (0 == node->fLevel) {
                 results->push_back(node->fChildren[i].fOpIndex);
             } else {
@@ -19,9 +19,13 @@
  * It only supports bulk-loading, i.e. creation from a batch of bounding rectangles.
  * This performs a bottom-up bulk load using the STR (sort-tile-recursive) algorithm.
  *
+ * Each node keeps the edges of its children's bounds in separate arrays, so a search tests all
+ * of a node's children against the query at once, with SIMD.
+ *
  * TODO: Experiment with other bulk-load algorithms (in particular the Hilbert pack variant,
  * which groups rects by position on the Hilbert curve, is probably worth a look). There also
- * exist top-down bulk load variants (VAMSplit, TopDownGreedy, etc).
+ * exist top-down bulk load variants (VAMSplit, TopDownGreedy, etc). Note that playback needs
+ * search results in insertion order, so any packing that reorders the rects has to sort them.
  *
  * For more details see:
  *
@@ -47,9 +51,9 @@ public:
     // Get the root bound.
     SkRect getRootBound() const override;
 
-    // These values were empirically determined to produce reasonable performance in most cases.
-    static const int kMinChildren = 6,
-                     kMaxChildren = 11;
+    // kMaxChildren is the width of one Sk8f, so a node's children are tested in one pass.
+    static const int kMinChildren = 4,
+                     kMaxChildren = 8;
 
 private:
     struct Node;
@@ -65,7 +69,17 @@ private:
     struct Node {
         uint16_t fNumChildren;
         uint16_t fLevel;
-        Branch fChildren[kMaxChildren];
+        // The bounds of children past fNumChildren never intersect anything.
+        float fLeft[kMaxChildren];
+        float fTop[kMaxChildren];
+        float fRight[kMaxChildren];
+        float fBottom[kMaxChildren];
+        union {
+            Node* fSubtree;
+            int fOpIndex;
+        } fChildren[kMaxChildren];
+
+        void addChild(const Branch&);
     };
 
     void search(Node* root, const SkRect& query, SkTDArray<int>* results) const;
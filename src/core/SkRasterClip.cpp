@@ -6,8 +6,10 @@
  */
 
 #include "include/core/SkPath.h"
+#include "include/core/SkRRect.h"
 #include "src/core/SkRasterClip.h"
 #include "src/core/SkRegionPriv.h"
+#include "src/core/SkResourceCache.h"
 
 enum MutateResult {
     kDoNothing_MutateResult,
@@ -241,34 +243,138 @@ bool SkRasterClip::setPath(const SkPath& path, const SkRegion& clip, bool doAA)
     return this->updateCacheAndReturnNonEmpty();
 }
 
+namespace {
+static unsigned gClipPathKeyNamespaceLabel;
+
+// Raster clips of rrects are keyed on their geometry, since the path an rrect clip is drawn with is
+// rebuilt every time. Other paths are keyed on their generation ID.
+struct ClipPathKey : public SkResourceCache::Key {
+    ClipPathKey(const SkPath& path, const SkRRect* rrect, const SkMatrix& matrix,
+                const SkIRect& clip, bool doAA)
+        : fRRect(rrect ? *rrect : SkRRect())
+        , fClip(clip)
+        , fPathGenID(rrect ? 0 : path.getGenerationID())
+        , fFlags(((int32_t)path.getFillType() << 1) | (int32_t)doAA)
+    {
+        matrix.get9(fMatrix);
+        this->init(&gClipPathKeyNamespaceLabel, 0,
+                   sizeof(fRRect) + sizeof(fMatrix) + sizeof(fClip) + sizeof(fPathGenID) +
+                   sizeof(fFlags));
+    }
+
+    SkRRect  fRRect;
+    SkScalar fMatrix[9];
+    SkIRect  fClip;
+    uint32_t fPathGenID;
+    int32_t  fFlags;
+};
+
+struct ClipPathValue {
+    SkRegion fBW;
+    SkAAClip fAA;
+    bool     fIsBW;
+};
+
+struct ClipPathRec : public SkResourceCache::Rec {
+    ClipPathRec(const ClipPathKey& key, const ClipPathValue& value) : fKey(key), fValue(value) {}
+
+    ClipPathKey   fKey;
+    ClipPathValue fValue;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override {
+        return sizeof(*this) + (fValue.fIsBW ? fValue.fBW.writeToMemory(nullptr)
+                                             : fValue.fAA.bytesUsed());
+    }
+    const char* getCategory() const override { return "clip-path"; }
+    SkDiscardableMemory* diagnostic_only_getDiscardable() const override { return nullptr; }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* context) {
+        const ClipPathRec& rec = static_cast<const ClipPathRec&>(baseRec);
+        *static_cast<ClipPathValue*>(context) = rec.fValue;
+        return true;
+    }
+};
+} // namespace
+
+// Clips smaller than this are quicker to scan convert again than to look up.
+static constexpr int64_t kMinCachedClipArea = 64 * 64;
+
+// Sets this to 'path', drawn with 'matrix' and clipped to 'clip'. Apps tend to clip to the same
+// rrects and paths every frame, so when the scan conversion is big enough to be worth saving the
+// result is shared through SkResourceCache. Pass 'rrect' when 'path' was just built from it.
+bool SkRasterClip::setCachedPath(const SkPath& path, const SkRRect* rrect, const SkMatrix& matrix,
+                                 const SkIRect& clipRef, bool doAA) {
+    const SkIRect clip = clipRef;  // clipRef may be our own bounds.
+
+    SkPath devPath;
+    auto makeDevPath = [&] {
+        if (matrix.isIdentity()) {
+            devPath = path;
+        } else {
+            path.transform(matrix, &devPath);
+            devPath.setIsVolatile(true);
+        }
+    };
+
+    bool cacheable = (rrect || !path.isVolatile()) && !matrix.hasPerspective();
+    if (cacheable && !path.isInverseFillType()) {
+        SkIRect devBounds = matrix.mapRect(path.getBounds()).roundOut();
+        cacheable = devBounds.intersect(clip) &&
+                    (int64_t)devBounds.width() * devBounds.height() >= kMinCachedClipArea;
+    }
+    if (!cacheable) {
+        makeDevPath();
+        return this->setPath(devPath, clip, doAA);
+    }
+
+    ClipPathKey key(path, rrect, matrix, clip, doAA);
+    ClipPathValue value;
+    if (SkResourceCache::Find(key, ClipPathRec::Visitor, &value)) {
+        fIsBW = value.fIsBW;
+        fBW.swap(value.fBW);
+        fAA.swap(value.fAA);
+        if (fIsBW) {
+            fAA.setEmpty();
+        } else {
+            fBW.setEmpty();
+        }
+        return this->updateCacheAndReturnNonEmpty();
+    }
+
+    makeDevPath();
+    bool nonEmpty = this->setPath(devPath, clip, doAA);
+    value.fIsBW = fIsBW;
+    if (fIsBW) {
+        value.fBW = fBW;
+    } else {
+        value.fAA = fAA;
+    }
+    SkResourceCache::Add(new ClipPathRec(key, value));
+    return nonEmpty;
+}
+
 bool SkRasterClip::op(const SkRRect& rrect, const SkMatrix& matrix, const SkIRect& devBounds,
                       SkRegion::Op op, bool doAA) {
-    SkIRect bounds(devBounds);
-    this->applyClipRestriction(op, &bounds);
-
     SkPath path;
     path.addRRect(rrect);
 
-    return this->op(path, matrix, bounds, op, doAA);
+    return this->opPath(path, &rrect, matrix, devBounds, op, doAA);
 }
 
 bool SkRasterClip::op(const SkPath& path, const SkMatrix& matrix, const SkIRect& devBounds,
                       SkRegion::Op op, bool doAA) {
+    return this->opPath(path, nullptr, matrix, devBounds, op, doAA);
+}
+
+bool SkRasterClip::opPath(const SkPath& path, const SkRRect* rrect, const SkMatrix& matrix,
+                          const SkIRect& devBounds, SkRegion::Op op, bool doAA) {
     AUTO_RASTERCLIP_VALIDATE(*this);
+    // bounds is used to limit the size (and therefore memory allocation) of the
+    // region that results from scan converting the path.
     SkIRect bounds(devBounds);
     this->applyClipRestriction(op, &bounds);
 
-    // base is used to limit the size (and therefore memory allocation) of the
-    // region that results from scan converting devPath.
-    SkRegion base;
-
-    SkPath devPath;
-    if (matrix.isIdentity()) {
-        devPath = path;
-    } else {
-        path.transform(matrix, &devPath);
-        devPath.setIsVolatile(true);
-    }
     if (SkRegion::kIntersect_Op == op) {
         // since we are intersect, we can do better (tighter) with currRgn's
         // bounds, than just using the device. However, if currRgn is complex,
@@ -277,21 +383,18 @@ bool SkRasterClip::op(const SkPath& path, const SkMatrix& matrix, const SkIRect&
             // FIXME: we should also be able to do this when this->isBW(),
             // but relaxing the test above triggers GM asserts in
             // SkRgnBuilder::blitH(). We need to investigate what's going on.
-            return this->setPath(devPath, this->bwRgn(), doAA);
+            return this->setCachedPath(path, rrect, matrix, this->getBounds(), doAA);
         } else {
-            base.setRect(this->getBounds());
             SkRasterClip clip;
-            clip.setPath(devPath, base, doAA);
+            clip.setCachedPath(path, rrect, matrix, this->getBounds(), doAA);
             return this->op(clip, op);
         }
     } else {
-        base.setRect(bounds);
-
         if (SkRegion::kReplace_Op == op) {
-            return this->setPath(devPath, base, doAA);
+            return this->setCachedPath(path, rrect, matrix, bounds, doAA);
         } else {
             SkRasterClip clip;
-            clip.setPath(devPath, base, doAA);
+            clip.setCachedPath(path, rrect, matrix, bounds, doAA);
             return this->op(clip, op);
         }
     }
@@ -165,6 +165,10 @@ private:
 
     bool setPath(const SkPath& path, const SkRegion& clip, bool doAA);
     bool setPath(const SkPath& path, const SkIRect& clip, bool doAA);
+    bool setCachedPath(const SkPath& path, const SkRRect* rrect, const SkMatrix& matrix,
+                       const SkIRect& clip, bool doAA);
+    bool opPath(const SkPath& path, const SkRRect* rrect, const SkMatrix& matrix,
+                const SkIRect& devBounds, SkRegion::Op op, bool doAA);
     bool op(const SkRasterClip&, SkRegion::Op);
     bool setConservativeRect(const SkRect& r, const SkIRect& clipR, bool isInverse);
 
@@ -6,6 +6,7 @@
  */
 
 #include "src/core/SkOpts.h"
+#include "src/core/SkPerfCounters.h"
 #include "src/core/SkRasterPipeline.h"
 #include <algorithm>
 
@@ -58,6 +59,13 @@ void SkRasterPipeline::extend(const SkRasterPipeline& src) {
     fSlotsNeeded += src.fSlotsNeeded - 1;  // Don't double count just_returns().
 }
 
+void SkRasterPipeline::extend_shared(const SkRasterPipeline& src) {
+    SkASSERT(this->empty());
+    fStages      = src.fStages;
+    fNumStages   = src.fNumStages;
+    fSlotsNeeded = src.fSlotsNeeded;
+}
+
 void SkRasterPipeline::dump() const {
     SkDebugf("SkRasterPipeline, %d stages\n", fNumStages);
     std::vector<const char*> stages;
@@ -259,39 +267,71 @@ void SkRasterPipeline::append_gamut_clamp_if_normalized(const SkImageInfo& dstIn
     }
 }
 
-SkRasterPipeline::StartPipelineFn SkRasterPipeline::build_pipeline(void** ip) const {
-    // We'll try to build a lowp pipeline, but if that fails fallback to a highp float pipeline.
-    void** reset_point = ip;
+SkRasterPipeline::StartPipelineFn SkRasterPipeline::build_pipeline(void** end,
+                                                                   void*** program) const {
+    SkPerfCounters::Add(SkGraphics::PerfCounter::kRasterPipelineBuilds);
+    // A srcover blit that can't use srcover_rgba_8888 or srcover_rgba_f16 directly, e.g. because
+    // it scales by coverage first, ends in load_dst, srcover and a store to the same pixels.
+    // We run the fused stage in place of those three, returning the first stage it covers. The
+    // fused stages leave r,g,b,a different than a store does, so the store must come last.
+    auto next = [this](const StageList* st, uint64_t* stage) {
+        *stage = st->stage;
+        const StageList* blend = st->prev;
+        const StageList* load  = blend ? blend->prev : nullptr;
+        if (st != fStages || !load || load->rawFunction || blend->rawFunction || st->rawFunction ||
+                blend->stage != srcover || load->ctx != st->ctx) {
+            return st;
+        }
+        if (load->stage == load_8888_dst && st->stage == store_8888) {
+            *stage = srcover_rgba_8888;
+            return load;
+        }
+        if (load->stage == load_f16_dst && st->stage == store_f16) {
+            *stage = srcover_rgba_f16;
+            return load;
+        }
+        return st;
+    };
 
-    // Stages are stored backwards in fStages, so we reverse here, back to front.
+    // We'll try to build a lowp pipeline, but if that fails fallback to a highp float pipeline.
+    void** ip = end;
     *--ip = (void*)SkOpts::just_return_lowp;
     for (const StageList* st = fStages; st; st = st->prev) {
+        uint64_t stage;
+        st = next(st, &stage);
+
         SkOpts::StageFn fn;
-        if (!st->rawFunction && (fn = SkOpts::stages_lowp[st->stage])) {
+        if (!st->rawFunction && (fn = SkOpts::stages_lowp[stage])) {
             if (st->ctx) {
                 *--ip = st->ctx;
             }
             *--ip = (void*)fn;
         } else {
-            ip = reset_point;
+            ip = nullptr;
             break;
         }
     }
-    if (ip != reset_point) {
+    if (ip) {
+        *program = ip;
         return SkOpts::start_pipeline_lowp;
     }
 
+    ip = end;
     *--ip = (void*)SkOpts::just_return_highp;
     for (const StageList* st = fStages; st; st = st->prev) {
+        uint64_t stage;
+        st = next(st, &stage);
+
         if (st->ctx) {
             *--ip = st->ctx;
         }
         if (st->rawFunction) {
-            *--ip = (void*)st->stage;
+            *--ip = (void*)stage;
         } else {
-            *--ip = (void*)SkOpts::stages_highp[st->stage];
+            *--ip = (void*)SkOpts::stages_highp[stage];
         }
     }
+    *program = ip;
     return SkOpts::start_pipeline_highp;
 }
 
@@ -301,10 +341,12 @@ void SkRasterPipeline::run(size_t x, size_t y, size_t w, size_t h) const {
     }
 
     // Best to not use fAlloc here... we can't bound how often run() will be called.
-    SkAutoSTMalloc<64, void*> program(fSlotsNeeded);
+    SkAutoSTMalloc<64, void*> storage(fSlotsNeeded);
 
-    auto start_pipeline = this->build_pipeline(program.get() + fSlotsNeeded);
-    start_pipeline(x,y,x+w,y+h, program.get());
+    // Fused stages take fewer slots than fSlotsNeeded, so the program may start past storage.
+    void** program;
+    auto start_pipeline = this->build_pipeline(storage.get() + fSlotsNeeded, &program);
+    start_pipeline(x,y,x+w,y+h, program);
 }
 
 std::function<void(size_t, size_t, size_t, size_t)> SkRasterPipeline::compile() const {
@@ -312,9 +354,10 @@ std::function<void(size_t, size_t, size_t, size_t)> SkRasterPipeline::compile()
         return [](size_t, size_t, size_t, size_t) {};
     }
 
-    void** program = fAlloc->makeArray<void*>(fSlotsNeeded);
+    void** storage = fAlloc->makeArray<void*>(fSlotsNeeded);
 
-    auto start_pipeline = this->build_pipeline(program + fSlotsNeeded);
+    void** program;
+    auto start_pipeline = this->build_pipeline(storage + fSlotsNeeded, &program);
     return [=](size_t x, size_t y, size_t w, size_t h) {
         start_pipeline(x,y,x+w,y+h, program);
     };
@@ -10,6 +10,7 @@
 
 #include "include/core/SkColor.h"
 #include "include/core/SkImageInfo.h"
+#include "include/core/SkTileMode.h"
 #include "include/core/SkTypes.h"
 #include "include/private/SkNx.h"
 #include "include/private/SkTArray.h"
@@ -49,8 +50,9 @@
     M(load_f32)  M(load_f32_dst)  M(store_f32)  M(gather_f32)      \
     M(load_8888) M(load_8888_dst) M(store_8888) M(gather_8888)     \
     M(load_1010102) M(load_1010102_dst) M(store_1010102) M(gather_1010102) \
+    M(gather_yuva)                                                 \
     M(alpha_to_gray) M(alpha_to_gray_dst) M(luminance_to_alpha)    \
-    M(bilerp_clamp_8888)                                           \
+    M(bilerp_clamp_8888) M(bilerp_tiled_8888) M(bicubic_clamp_8888) \
     M(store_u16_be)                                                \
     M(load_src) M(store_src) M(load_dst) M(store_dst)              \
     M(scale_u8) M(scale_565) M(scale_1_float)                      \
@@ -61,7 +63,7 @@
     M(colorburn) M(colordodge) M(darken) M(difference)             \
     M(exclusion) M(hardlight) M(lighten) M(overlay) M(softlight)   \
     M(hue) M(saturation) M(color) M(luminosity)                    \
-    M(srcover_rgba_8888)                                           \
+    M(srcover_rgba_8888) M(srcover_rgba_f16)                       \
     M(matrix_translate) M(matrix_scale_translate)                  \
     M(matrix_2x3) M(matrix_3x3) M(matrix_3x4) M(matrix_4x5) M(matrix_4x3) \
     M(matrix_perspective)                                          \
@@ -90,7 +92,7 @@
     M(alter_2pt_conical_unswap)                                    \
     M(mask_2pt_conical_nan)                                        \
     M(mask_2pt_conical_degenerates) M(apply_vector_mask)           \
-    M(byte_tables)                                                 \
+    M(byte_tables) M(color_cube)                                   \
     M(rgb_to_hsl) M(hsl_to_rgb)                                    \
     M(gauss_a_to_rgba)                                             \
     M(emboss)
@@ -127,6 +129,26 @@ struct SkRasterPipeline_TileCtx {
     float invScale; // cache of 1/scale
 };
 
+// For gather_yuva, which reads each of Y, U, V, and A from an 8-bit channel of some plane.
+struct SkRasterPipeline_YUVACtx {
+    const uint8_t* pixels[4];  // The channel of the plane's first pixel, or null for no A.
+    int            rowBytes[4];
+    int            bytesPerPixel[4];
+    float          width[4];
+    float          height[4];
+    // Maps image coordinates to the plane's, which may be subsampled or flipped.
+    float          scaleX[4];
+    float          scaleY[4];
+    float          transY[4];
+};
+
+// For bilerp_tiled_8888, which tiles each of its samples like repeat_x/mirror_x and friends.
+struct SkRasterPipeline_TiledGatherCtx {
+    SkRasterPipeline_GatherCtx gather;
+    SkRasterPipeline_TileCtx   limitX, limitY;
+    SkTileMode                 modeX, modeY;  // kClamp, kRepeat, or kMirror.
+};
+
 struct SkRasterPipeline_DecalTileCtx {
     uint32_t mask[SkRasterPipeline_kMaxStride];
     float    limit_x;
@@ -147,6 +169,13 @@ struct SkRasterPipeline_GradientCtx {
     float* fs[4];
     float* bs[4];
     float* ts;
+    // Optional, to save the gradient stage searching every stop when there are many. t in
+    // [0,1] is split into bucketCount buckets (plus one more for t == 1), and stopBuckets[k]
+    // holds the index of the interval where bucket k starts. No bucket has more than
+    // maxStopsPerBucket stops in it, and ts[stopCount] must be +inf.
+    uint32_t* stopBuckets;
+    int bucketCount;
+    int maxStopsPerBucket;
     bool interpolatedInPremul;
 };
 
@@ -167,6 +196,15 @@ struct SkRasterPipeline_UniformColorCtx {
     uint16_t rgba[4];  // [0,255] in a 16-bit lane.
 };
 
+// A dim x dim x dim lookup table of colors, one plane per channel. The entry for lattice point
+// (r,g,b) is at index r + g*dim + b*dim*dim in each plane.
+struct SkRasterPipeline_ColorCubeCtx {
+    const float* r;
+    const float* g;
+    const float* b;
+    int          dim;
+};
+
 struct SkRasterPipeline_EmbossCtx {
     SkRasterPipeline_MemoryCtx mul,
                                add;
@@ -200,6 +238,11 @@ public:
     // Append all stages to this pipeline.
     void extend(const SkRasterPipeline&);
 
+    // Like extend(), but for an empty pipeline, which links to src's stages instead of copying
+    // them. Stages never change once appended, so this is safe as long as the memory holding
+    // src's stages (src's SkArenaAlloc) outlives this pipeline.
+    void extend_shared(const SkRasterPipeline& src);
+
     // Runs the pipeline in 2d from (x,y) inclusive to (x+w,y+h) exclusive.
     void run(size_t x, size_t y, size_t w, size_t h) const;
 
@@ -245,7 +288,8 @@ private:
     };
 
     using StartPipelineFn = void(*)(size_t,size_t,size_t,size_t, void** program);
-    StartPipelineFn build_pipeline(void**) const;
+    // Writes the program backwards from end, pointing *program at its first slot.
+    StartPipelineFn build_pipeline(void** end, void*** program) const;
 
     void unchecked_append(StockStage, void*);
 
@@ -16,6 +16,7 @@
 #include "src/core/SkColorSpacePriv.h"
 #include "src/core/SkColorSpaceXformSteps.h"
 #include "src/core/SkOpts.h"
+#include "src/core/SkPerfCounters.h"
 #include "src/core/SkRasterPipeline.h"
 #include "src/core/SkUtils.h"
 #include "src/shaders/SkShaderBase.h"
@@ -62,7 +63,7 @@ private:
     void   (*fMemset2D)(SkPixmap*, int x,int y, int w,int h, uint64_t color) = nullptr;
     uint64_t fMemsetColor = 0;   // Big enough for largest memsettable dst format, F16.
 
-    // Built lazily on first use.
+    // Built lazily on first use. They're all built on top of fColorPipeline, sharing its stages.
     std::function<void(size_t, size_t, size_t, size_t)> fBlitRect,
                                                         fBlitAntiH,
                                                         fBlitMaskA8,
@@ -137,6 +138,7 @@ SkBlitter* SkRasterPipelineBlitter::Create(const SkPixmap& dst,
                                            const SkRasterPipeline& shaderPipeline,
                                            bool is_opaque,
                                            bool is_constant) {
+    SkPerfCounters::Add(SkGraphics::PerfCounter::kRasterPipelineBlitters);
     auto blitter = alloc->make<SkRasterPipelineBlitter>(dst,
                                                         paint.getBlendMode(),
                                                         alloc);
@@ -204,7 +206,7 @@ SkBlitter* SkRasterPipelineBlitter::Create(const SkPixmap& dst,
         // Run our color pipeline all the way through to produce what we'd memset when we can.
         // Not all blits can memset, so we need to keep colorPipeline too.
         SkRasterPipeline_<256> p;
-        p.extend(*colorPipeline);
+        p.extend_shared(*colorPipeline);
         p.append_gamut_clamp_if_normalized(dst.info());
         blitter->fDstPtr = SkRasterPipeline_MemoryCtx{&blitter->fMemsetColor, 0};
         blitter->append_store(&p);
@@ -273,7 +275,7 @@ void SkRasterPipelineBlitter::blitRect(int x, int y, int w, int h) {
 
     if (!fBlitRect) {
         SkRasterPipeline p(fAlloc);
-        p.extend(fColorPipeline);
+        p.extend_shared(fColorPipeline);
         p.append_gamut_clamp_if_normalized(fDst.info());
         if (fBlend == SkBlendMode::kSrcOver
                 && (fDst.info().colorType() == kRGBA_8888_SkColorType ||
@@ -285,6 +287,11 @@ void SkRasterPipelineBlitter::blitRect(int x, int y, int w, int h) {
                 p.append(SkRasterPipeline::swap_rb);
             }
             p.append(SkRasterPipeline::srcover_rgba_8888, &fDstPtr);
+        } else if (fBlend == SkBlendMode::kSrcOver
+                && fDst.info().colorType() == kRGBA_F16_SkColorType
+                && fDst.info().alphaType() != kUnpremul_SkAlphaType
+                && fDitherRate == 0.0f) {
+            p.append(SkRasterPipeline::srcover_rgba_f16, &fDstPtr);
         } else {
             if (fBlend != SkBlendMode::kSrc) {
                 this->append_load_dst(&p);
@@ -301,7 +308,7 @@ void SkRasterPipelineBlitter::blitRect(int x, int y, int w, int h) {
 void SkRasterPipelineBlitter::blitAntiH(int x, int y, const SkAlpha aa[], const int16_t runs[]) {
     if (!fBlitAntiH) {
         SkRasterPipeline p(fAlloc);
-        p.extend(fColorPipeline);
+        p.extend_shared(fColorPipeline);
         p.append_gamut_clamp_if_normalized(fDst.info());
         if (SkBlendMode_ShouldPreScaleCoverage(fBlend, /*rgb_coverage=*/false)) {
             p.append(SkRasterPipeline::scale_1_float, &fCurrentCoverage);
@@ -406,7 +413,7 @@ void SkRasterPipelineBlitter::blitMask(const SkMask& mask, const SkIRect& clip)
     // Lazily build whichever pipeline we need, specialized for each mask format.
     if (mask.fFormat == SkMask::kA8_Format && !fBlitMaskA8) {
         SkRasterPipeline p(fAlloc);
-        p.extend(fColorPipeline);
+        p.extend_shared(fColorPipeline);
         p.append_gamut_clamp_if_normalized(fDst.info());
         if (SkBlendMode_ShouldPreScaleCoverage(fBlend, /*rgb_coverage=*/false)) {
             p.append(SkRasterPipeline::scale_u8, &fMaskPtr);
@@ -422,7 +429,7 @@ void SkRasterPipelineBlitter::blitMask(const SkMask& mask, const SkIRect& clip)
     }
     if (mask.fFormat == SkMask::kLCD16_Format && !fBlitMaskLCD16) {
         SkRasterPipeline p(fAlloc);
-        p.extend(fColorPipeline);
+        p.extend_shared(fColorPipeline);
         p.append_gamut_clamp_if_normalized(fDst.info());
         if (SkBlendMode_ShouldPreScaleCoverage(fBlend, /*rgb_coverage=*/true)) {
             // Somewhat unusually, scale_565 needs dst loaded first.
@@ -439,7 +446,7 @@ void SkRasterPipelineBlitter::blitMask(const SkMask& mask, const SkIRect& clip)
     }
     if (mask.fFormat == SkMask::k3D_Format && !fBlitMask3D) {
         SkRasterPipeline p(fAlloc);
-        p.extend(fColorPipeline);
+        p.extend_shared(fColorPipeline);
         // This bit is where we differ from kA8_Format:
         p.append(SkRasterPipeline::emboss, &fEmbossCtx);
         // Now onward just as kA8.
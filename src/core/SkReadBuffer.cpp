@@ -91,6 +91,13 @@ const void* SkReadBuffer::skip(size_t count, size_t size) {
     return this->skip(SkSafeMath::Mul(count, size));
 }
 
+const void* SkReadBuffer::skipByteArray(size_t* size) {
+    const uint32_t count = this->readUInt();
+    const void* buf = this->skip(count);
+    *size = buf ? count : 0;
+    return buf;
+}
+
 void SkReadBuffer::setDeserialProcs(const SkDeserialProcs& procs) {
     fProcs = procs;
 }
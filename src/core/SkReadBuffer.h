@@ -47,6 +47,8 @@ public:
         kSaveBehind_Version                = 66,
         kSerializeFonts_Version            = 67,
         kPaintDoesntSerializeFonts_Version = 68,
+        kSerializeOpBounds_Version         = 69,
+        kSharedPictureObjects_Version      = 70,
     };
 
     /**
@@ -79,6 +81,10 @@ public:
         return static_cast<const T*>(this->skip(count, sizeof(T)));
     }
 
+    // Like readByteArray(), but returns the bytes in place (and their count in size), rather
+    // than copying them out. Returns null if they aren't all there.
+    const void* skipByteArray(size_t* size);
+
     // primitives
     bool readBool();
     SkColor readColor();
@@ -256,6 +262,7 @@ public:
         kSaveBehind_Version                = 66,
         kSerializeFonts_Version            = 67,
         kPaintDoesntSerializeFonts_Version = 68,
+        kSerializeOpBounds_Version         = 69,
     };
 
     bool isVersionLT(Version) const { return false; }
@@ -271,6 +278,7 @@ public:
     const void* skip(size_t, size_t) { return nullptr; }
     template <typename T> const T* skipT()       { return nullptr; }
     template <typename T> const T* skipT(size_t) { return nullptr; }
+    const void* skipByteArray(size_t*)           { return nullptr; }
 
     bool     readBool()   { return 0; }
     SkColor  readColor()  { return 0; }
@@ -9,6 +9,7 @@
 
 #include "include/private/SkTDArray.h"
 #include "src/core/SkCanvasPriv.h"
+#include "src/core/SkPaintPriv.h"
 #include "src/core/SkRecordPattern.h"
 #include "src/core/SkRecords.h"
 
@@ -289,6 +290,233 @@ void SkRecordMergeSvgOpacityAndFilterLayers(SkRecord* record) {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Turns draws into NoOps when a later draw overwrites every pixel they could touch.
+//
+// Only opaque, aliased rects and opaque paints cover anything, and only the draws under the same
+// clip (or one inside it) and layer.  Anti-aliased edges, whether from the draw or a clip, leave
+// pixels partially covered, so a covered draw must be aliased and fit inside the rect that
+// covers it, or be under a paint that covers the whole clip.  Anything under an anti-aliased clip
+// is left alone.
+//
+// Bounds are compared in the picture's coordinate space, so this holds under any matrix the
+// picture is played back with.
+class OccludedDrawCuller {
+public:
+    explicit OccludedDrawCuller(SkRecord* record) : fRecord(record) {
+        fClips.push_back({-1, false});
+        fCTM.reset();
+    }
+
+    void cull() {
+        for (fCurrentOp = 0; fCurrentOp < fRecord->count(); fCurrentOp++) {
+            fRecord->visit(fCurrentOp, *this);
+        }
+    }
+
+    template <typename T> void operator()(const T& op) { this->update(op); }
+
+private:
+    // Remember at most this many draws that might still be covered, so this stays linear.
+    static constexpr int kMaxCandidates = 256;
+
+    struct Candidate {
+        int    fOp;
+        int    fClip;
+        bool   fBounded;  // If false, only a paint covering the whole clip covers this draw.
+        SkRect fBounds;   // Contains the center of every pixel this draw can touch.
+    };
+    struct Clip {
+        int  fParent;
+        bool fAA;         // This clip or one it's inside is anti-aliased.
+    };
+    struct SaveState {
+        int  fClip;
+        bool fIsLayer;
+    };
+
+    void update(const Save&)       { fSaves.push_back({fCurrentClip, false}); }
+    void update(const SaveLayer&)  { this->pushLayer(); }
+    void update(const SaveBehind&) { this->pushLayer(); }
+    void update(const Restore& op) {
+        if (fSaves.count() > 0) {
+            if (fSaves.top().fIsLayer) {
+                fCandidates.reset();
+            }
+            fCurrentClip = fSaves.top().fClip;
+            fSaves.pop();
+        }
+        fCTM = op.matrix;
+    }
+
+    void update(const SetMatrix& op) { fCTM = op.matrix; }
+    void update(const Concat& op)    { fCTM.preConcat(op.matrix); }
+    void update(const Translate& op) { fCTM.preTranslate(op.dx, op.dy); }
+
+    void update(const ClipPath& op)   { this->pushClip(op.opAA.aa()); }
+    void update(const ClipRRect& op)  { this->pushClip(op.opAA.aa()); }
+    void update(const ClipRect& op)   { this->pushClip(op.opAA.aa()); }
+    void update(const ClipRegion&)    { this->pushClip(false); }
+
+    // Pictures and drawables may hold annotations or do work of their own, so we keep them.
+    void update(const DrawPicture&)  {}
+    void update(const DrawDrawable&) {}
+    void update(const DrawBehind&)   { fCandidates.reset(); }
+
+    void update(const DrawPaint& op) {
+        if (Covers(op.paint)) {
+            this->cullCandidates(nullptr);
+        }
+        this->addCandidate(op);
+    }
+
+    void update(const DrawRect& op) {
+        if (fCTM.rectStaysRect() && !op.paint.isAntiAlias() &&
+                op.paint.getStyle() == SkPaint::kFill_Style && !op.paint.getPathEffect() &&
+                Covers(op.paint)) {
+            SkRect cover;
+            fCTM.mapRect(&cover, op.rect);
+            this->cullCandidates(&cover);
+        }
+        this->addCandidate(op);
+    }
+
+    template <typename T>
+    SK_WHEN(T::kTags & kDraw_Tag, void) update(const T& op) { this->addCandidate(op); }
+
+    template <typename T>
+    SK_WHEN(!(T::kTags & kDraw_Tag), void) update(const T&) {}
+
+    // Would a draw with this paint replace every pixel it fully covers?
+    static bool Covers(const SkPaint& paint) {
+        return !paint.getMaskFilter() && !paint.getImageFilter() &&
+               SkPaintPriv::Overwrites(&paint, SkPaintPriv::kNone_ShaderOverrideOpacity);
+    }
+
+    // If the draw is aliased, sets 'bounds' to local bounds containing the center of every pixel
+    // it can touch and returns true.
+    template <typename T> static bool LocalBounds(const T&, SkRect*) { return false; }
+    static bool LocalBounds(const DrawRect& op, SkRect* bounds) {
+        return AdjustForPaint(&op.paint, op.rect, bounds);
+    }
+    static bool LocalBounds(const DrawOval& op, SkRect* bounds) {
+        return AdjustForPaint(&op.paint, op.oval, bounds);
+    }
+    static bool LocalBounds(const DrawArc& op, SkRect* bounds) {
+        return AdjustForPaint(&op.paint, op.oval, bounds);
+    }
+    static bool LocalBounds(const DrawRRect& op, SkRect* bounds) {
+        return AdjustForPaint(&op.paint, op.rrect.getBounds(), bounds);
+    }
+    static bool LocalBounds(const DrawDRRect& op, SkRect* bounds) {
+        return AdjustForPaint(&op.paint, op.outer.getBounds(), bounds);
+    }
+    static bool LocalBounds(const DrawPath& op, SkRect* bounds) {
+        return !op.path.isInverseFillType() &&
+               AdjustForPaint(&op.paint, op.path.getBounds(), bounds);
+    }
+    static bool LocalBounds(const DrawRegion& op, SkRect* bounds) {
+        return AdjustForPaint(&op.paint, SkRect::Make(op.region.getBounds()), bounds);
+    }
+    static bool LocalBounds(const DrawImage& op, SkRect* bounds) {
+        SkRect rect = SkRect::MakeXYWH(op.left, op.top, op.image->width(), op.image->height());
+        return AdjustForPaint(op.paint, rect, bounds);
+    }
+    static bool LocalBounds(const DrawImageRect& op, SkRect* bounds) {
+        return AdjustForPaint(op.paint, op.dst, bounds);
+    }
+    static bool LocalBounds(const DrawImageNine& op, SkRect* bounds) {
+        return AdjustForPaint(op.paint, op.dst, bounds);
+    }
+    static bool LocalBounds(const DrawImageLattice& op, SkRect* bounds) {
+        return AdjustForPaint(op.paint, op.dst, bounds);
+    }
+
+    static bool AdjustForPaint(const SkPaint* paint, const SkRect& rect, SkRect* bounds) {
+        if (!paint) {
+            *bounds = rect;
+            return true;
+        }
+        // Hairlines touch every pixel they cross, not just those whose centers they contain.
+        const bool hairline = paint->getStyle() != SkPaint::kFill_Style &&
+                              paint->getStrokeWidth() == 0;
+        if (paint->isAntiAlias() || hairline || paint->getMaskFilter() ||
+                paint->getImageFilter() || !paint->canComputeFastBounds()) {
+            return false;
+        }
+        SkRect storage;
+        *bounds = paint->computeFastBounds(rect, &storage);
+        return true;
+    }
+
+    template <typename T>
+    void addCandidate(const T& op) {
+        if (fClips[fCurrentClip].fAA) {
+            return;
+        }
+        Candidate candidate = {fCurrentOp, fCurrentClip, false, SkRect::MakeEmpty()};
+        SkRect local;
+        if (LocalBounds(op, &local) && !fCTM.hasPerspective()) {
+            candidate.fBounded = true;
+            fCTM.mapRect(&candidate.fBounds, local);
+        }
+        if (fCandidates.count() == kMaxCandidates) {
+            fCandidates.remove(0, kMaxCandidates / 2);
+        }
+        fCandidates.push_back(candidate);
+    }
+
+    // NoOps the candidates under the current clip that 'cover' contains, or all of them if
+    // 'cover' is null.
+    void cullCandidates(const SkRect* cover) {
+        int kept = 0;
+        for (int i = 0; i < fCandidates.count(); i++) {
+            const Candidate& candidate = fCandidates[i];
+            if (this->isInsideCurrentClip(candidate.fClip) &&
+                    (!cover || (candidate.fBounded && cover->contains(candidate.fBounds)))) {
+                fRecord->replace<NoOp>(candidate.fOp);
+            } else {
+                fCandidates[kept++] = candidate;
+            }
+        }
+        fCandidates.setCount(kept);
+    }
+
+    bool isInsideCurrentClip(int clip) const {
+        for (; clip >= 0; clip = fClips[clip].fParent) {
+            if (clip == fCurrentClip) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void pushClip(bool aa) {
+        fClips.push_back({fCurrentClip, aa || fClips[fCurrentClip].fAA});
+        fCurrentClip = fClips.count() - 1;
+    }
+
+    // Draws inside a layer land on the layer, not on whatever the layer is drawn over.
+    void pushLayer() {
+        fSaves.push_back({fCurrentClip, true});
+        fCandidates.reset();
+    }
+
+    SkRecord*             fRecord;
+    int                   fCurrentOp = 0;
+    SkMatrix              fCTM;
+    int                   fCurrentClip = 0;
+    SkTDArray<Clip>       fClips;
+    SkTDArray<SaveState>  fSaves;
+    SkTDArray<Candidate>  fCandidates;
+};
+
+void SkRecordCullOccludedDraws(SkRecord* record) {
+    OccludedDrawCuller culler(record);
+    culler.cull();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
 void SkRecordOptimize(SkRecord* record) {
     // This might be useful  as a first pass in the future if we want to weed
     // out junk for other optimization passes.  Right now, nothing needs it,
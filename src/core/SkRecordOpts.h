@@ -26,6 +26,11 @@ void SkRecordNoopSaveLayerDrawRestores(SkRecord*);
 // the alpha of the first SaveLayer to the second SaveLayer.
 void SkRecordMergeSvgOpacityAndFilterLayers(SkRecord*);
 
+// Turns draws into NoOps where a later opaque rect or paint under the same clip overwrites every
+// pixel they could touch.  Not part of SkRecordOptimize(); SkPictureRecorder runs it when asked to
+// with kCullOccludedDraws_RecordFlag.
+void SkRecordCullOccludedDraws(SkRecord*);
+
 // Experimental optimizers
 void SkRecordOptimize2(SkRecord*);
 
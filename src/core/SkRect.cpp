@@ -47,28 +47,42 @@ bool SkRect::setBoundsCheck(const SkPoint pts[], int count) {
         return true;
     }
 
-    Sk4s min, max;
-    if (count & 1) {
-        min = max = Sk4s(pts->fX, pts->fY,
-                         pts->fX, pts->fY);
-        pts   += 1;
-        count -= 1;
-    } else {
-        min = max = Sk4s::Load(pts);
-        pts   += 2;
-        count -= 2;
+    // Four points (eight scalars) at a time, in two independent sets of (x, y, x, y) lanes so that
+    // neither min/max chain waits on the other. The first point seeds every lane, and any points
+    // left over from a multiple of four are folded in one at a time first.
+    Sk4s min0 = Sk4s(pts->fX, pts->fY, pts->fX, pts->fY),
+         max0 = min0,
+         min1 = min0,
+         max1 = min0;
+    Sk4s accum0 = min0 * 0,
+         accum1 = accum0;
+
+    int leftover = count & 3;
+    for (int i = 1; i < leftover; ++i) {
+        Sk4s xy = Sk4s(pts[i].fX, pts[i].fY, pts[i].fX, pts[i].fY);
+        accum0 = accum0 * xy;
+        min0 = Sk4s::Min(min0, xy);
+        max0 = Sk4s::Max(max0, xy);
     }
+    pts   += leftover;
+    count -= leftover;
 
-    Sk4s accum = min * 0;
     while (count) {
-        Sk4s xy = Sk4s::Load(pts);
-        accum = accum * xy;
-        min = Sk4s::Min(min, xy);
-        max = Sk4s::Max(max, xy);
-        pts   += 2;
-        count -= 2;
+        Sk4s xy0 = Sk4s::Load(pts),
+             xy1 = Sk4s::Load(pts + 2);
+        accum0 = accum0 * xy0;
+        accum1 = accum1 * xy1;
+        min0 = Sk4s::Min(min0, xy0);
+        min1 = Sk4s::Min(min1, xy1);
+        max0 = Sk4s::Max(max0, xy0);
+        max1 = Sk4s::Max(max1, xy1);
+        pts   += 4;
+        count -= 4;
     }
 
+    Sk4s min   = Sk4s::Min(min0, min1),
+         max   = Sk4s::Max(max0, max1),
+         accum = accum0 * accum1;
     bool all_finite = (accum * 0 == 0).allTrue();
     if (all_finite) {
         this->set(SkTMin(min[0], min[2]), SkTMin(min[1], min[3]),
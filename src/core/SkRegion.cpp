@@ -8,10 +8,12 @@
 #include "include/core/SkRegion.h"
 
 #include "include/private/SkMacros.h"
+#include "include/private/SkTDArray.h"
 #include "include/private/SkTemplates.h"
 #include "include/private/SkTo.h"
 #include "src/core/SkRegionPriv.h"
 #include "src/core/SkSafeMath.h"
+#include "src/core/SkTSort.h"
 #include "src/utils/SkUTF.h"
 
 #include <utility>
@@ -647,16 +649,94 @@ void SkRegion::translate(int dx, int dy, SkRegion* dst) const {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// Rather than union the rects one at a time, which is quadratic in their count, sweep down through
+// their top and bottom edges. Each band between two edges gets the merged x-extents of the rects
+// that cover it, and is coalesced with the band above when they match.
 bool SkRegion::setRects(const SkIRect rects[], int count) {
-    if (0 == count) {
-        this->setEmpty();
-    } else {
-        this->setRect(rects[0]);
-        for (int i = 1; i < count; i++) {
-            this->op(rects[i], kUnion_Op);
+    SkTDArray<SkIRect> sorted;
+    sorted.setReserve(count);
+    for (int i = 0; i < count; i++) {
+        const SkIRect& r = rects[i];
+        if (!r.isEmpty() &&
+            r.fRight != SkRegion_kRunTypeSentinel && r.fBottom != SkRegion_kRunTypeSentinel) {
+            *sorted.append() = r;
+        }
+    }
+    if (sorted.count() <= 1) {
+        return sorted.isEmpty() ? this->setEmpty() : this->setRect(sorted[0]);
+    }
+    SkTQSort(sorted.begin(), sorted.end() - 1, [](const SkIRect& a, const SkIRect& b) {
+        return a.fTop < b.fTop;
+    });
+
+    SkTDArray<RunType> ys;
+    ys.setReserve(2 * sorted.count());
+    for (const SkIRect& r : sorted) {
+        *ys.append() = r.fTop;
+        *ys.append() = r.fBottom;
+    }
+    SkTQSort(ys.begin(), ys.end() - 1);
+
+    SkTDArray<SkIRect> active;
+    SkTDArray<RunType> runs;
+    *runs.append() = ys[0];
+    int prevStart = 0, prevLen = 0;  // the previous band's x-intervals and x-sentinel
+    int next = 0;
+    for (int i = 0; i + 1 < ys.count(); i++) {
+        const RunType top = ys[i], bottom = ys[i + 1];
+        if (top == bottom) {
+            continue;
+        }
+
+        int kept = 0;
+        for (const SkIRect& r : active) {
+            if (r.fBottom > top) {
+                active[kept++] = r;
+            }
+        }
+        active.setCount(kept);
+        while (next < sorted.count() && sorted[next].fTop <= top) {
+            *active.append() = sorted[next++];
+        }
+        if (active.count() > 1) {
+            SkTQSort(active.begin(), active.end() - 1, [](const SkIRect& a, const SkIRect& b) {
+                return a.fLeft < b.fLeft;
+            });
+        }
+
+        *runs.append() = bottom;
+        *runs.append() = 0;  // interval count, filled in below
+        const int start = runs.count();
+        if (!active.isEmpty()) {
+            RunType left = active[0].fLeft, right = active[0].fRight;
+            for (int j = 1; j < active.count(); j++) {
+                if (active[j].fLeft <= right) {
+                    right = SkTMax(right, active[j].fRight);
+                } else {
+                    *runs.append() = left;
+                    *runs.append() = right;
+                    left  = active[j].fLeft;
+                    right = active[j].fRight;
+                }
+            }
+            *runs.append() = left;
+            *runs.append() = right;
+        }
+        *runs.append() = SkRegion_kRunTypeSentinel;
+
+        const int len = runs.count() - start;
+        runs[start - 1] = len >> 1;
+        if (len == prevLen && !memcmp(&runs[prevStart], &runs[start], len * sizeof(RunType))) {
+            runs[prevStart - 2] = bottom;
+            runs.setCount(start - 2);
+        } else {
+            prevStart = start;
+            prevLen   = len;
         }
     }
-    return !this->isEmpty();
+    *runs.append() = SkRegion_kRunTypeSentinel;
+
+    return this->setRuns(runs.begin(), runs.count());
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -721,6 +721,16 @@ static bool readGlyph(SkTLazy<SkGlyph>& glyph, Deserializer* deserializer) {
 }
 
 bool SkStrikeClient::readStrikeData(const volatile void* memory, size_t memorySize) {
+    return this->readStrikeData(memory, memorySize, nullptr);
+}
+
+bool SkStrikeClient::readStrikeData(sk_sp<SkData> data) {
+    if (!data || data->isEmpty()) READ_FAILURE
+    return this->readStrikeData(data->data(), data->size(), data);
+}
+
+bool SkStrikeClient::readStrikeData(const volatile void* memory, size_t memorySize,
+                                    const sk_sp<SkData>& imageOwner) {
     SkASSERT(memorySize != 0u);
     Deserializer deserializer(static_cast<const volatile char*>(memory), memorySize);
 
@@ -807,7 +817,14 @@ bool SkStrikeClient::readStrikeData(const volatile void* memory, size_t memorySi
             // Don't overwrite the image if we already have one. We could have used a fallback if
             // the glyph was missing earlier.
             if (allocatedGlyph->fImage == nullptr) {
-                strike->initializeImage(image, imageSize, allocatedGlyph);
+                // The image is aligned within the data, which is only enough if the data is too.
+                bool aligned = reinterpret_cast<uintptr_t>(image) % glyph->formatAlignment() == 0;
+                if (imageOwner && aligned) {
+                    strike->adoptImage(const_cast<const void*>(image), imageSize, imageOwner,
+                                       allocatedGlyph);
+                } else {
+                    strike->initializeImage(image, imageSize, allocatedGlyph);
+                }
             }
         }
 
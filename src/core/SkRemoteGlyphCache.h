@@ -210,9 +210,18 @@ public:
     // Returns false if the data is invalid.
     bool readStrikeData(const volatile void* memory, size_t memorySize);
 
+    // Like readStrikeData() above, but glyph images are used where they are in |data| instead of
+    // being copied into the strikes, which keep |data| alive while they use them. If |data| maps
+    // memory shared with other clients, they all draw from one copy of each image. Its contents
+    // must not change once it has been passed here.
+    bool readStrikeData(sk_sp<SkData> data);
+
 private:
     class DiscardableStrikePinner;
 
+    bool readStrikeData(const volatile void* memory, size_t memorySize,
+                        const sk_sp<SkData>& imageOwner);
+
     sk_sp<SkTypeface> addTypeface(const WireTypeface& wire);
 
     SkTHashMap<SkFontID, sk_sp<SkTypeface>> fRemoteFontIdToTypeface;
@@ -8,13 +8,16 @@
 #include "src/core/SkResourceCache.h"
 
 #include "include/core/SkTraceMemoryDump.h"
+#include "include/private/SkChecksum.h"
 #include "include/private/SkMutex.h"
+#include "include/private/SkThreadID.h"
 #include "include/private/SkTo.h"
 #include "src/core/SkDiscardableMemory.h"
 #include "src/core/SkMessageBus.h"
 #include "src/core/SkMipMap.h"
 #include "src/core/SkOpts.h"
 
+#include <cmath>
 #include <stddef.h>
 #include <stdlib.h>
 
@@ -38,6 +41,10 @@ static inline bool SkShouldPostMessageToBus(
     #define SK_DEFAULT_IMAGE_CACHE_LIMIT     (32 * 1024 * 1024)
 #endif
 
+#ifndef SK_RESOURCE_CACHE_SHARD_COUNT
+    #define SK_RESOURCE_CACHE_SHARD_COUNT    1
+#endif
+
 void SkResourceCache::Key::init(void* nameSpace, uint64_t sharedID, size_t dataSize) {
     SkASSERT(SkAlign4(dataSize) == dataSize);
 
@@ -84,6 +91,7 @@ void SkResourceCache::init() {
     fTotalBytesUsed = 0;
     fCount = 0;
     fSingleAllocationByteLimit = 0;
+    fDiscardableCountLimit = SK_DISCARDABLEMEMORY_SCALEDIMAGECACHE_COUNT_LIMIT;
 
     // One of these should be explicit set by the caller after we return.
     fTotalByteLimit = 0;
@@ -203,7 +211,7 @@ void SkResourceCache::purgeAsNeeded(bool forcePurge) {
     int    countLimit;
 
     if (fDiscardableFactory) {
-        countLimit = SK_DISCARDABLEMEMORY_SCALEDIMAGECACHE_COUNT_LIMIT;
+        countLimit = fDiscardableCountLimit;
         byteLimit = UINT32_MAX;  // no limit based on bytes
     } else {
         countLimit = SK_MaxS32; // no limit based on count
@@ -224,6 +232,20 @@ void SkResourceCache::purgeAsNeeded(bool forcePurge) {
     }
 }
 
+size_t SkResourceCache::purgeBytes(size_t bytes) {
+    size_t freed = 0;
+    Rec* rec = fTail;
+    while (rec && freed < bytes) {
+        Rec* prev = rec->fPrev;
+        if (rec->canBePurged()) {
+            freed += rec->bytesUsed();
+            this->remove(rec);
+        }
+        rec = prev;
+    }
+    return freed;
+}
+
 //#define SK_TRACK_PURGE_SHAREDID_HITRATE
 
 #ifdef SK_TRACK_PURGE_SHAREDID_HITRATE
@@ -289,6 +311,15 @@ size_t SkResourceCache::setTotalByteLimit(size_t newLimit) {
     return prevLimit;
 }
 
+int SkResourceCache::setDiscardableCountLimit(int newLimit) {
+    int prevLimit = fDiscardableCountLimit;
+    fDiscardableCountLimit = newLimit;
+    if (newLimit < prevLimit) {
+        this->purgeAsNeeded();
+    }
+    return prevLimit;
+}
+
 SkCachedData* SkResourceCache::newCachedData(size_t bytes) {
     this->checkMessages();
 
@@ -449,86 +480,149 @@ void SkResourceCache::checkMessages() {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-SK_DECLARE_STATIC_MUTEX(gMutex);
-static SkResourceCache* gResourceCache = nullptr;
+static constexpr int kShardCount = SK_RESOURCE_CACHE_SHARD_COUNT;
+static_assert(kShardCount > 0, "SK_RESOURCE_CACHE_SHARD_COUNT must be positive");
+
+namespace {
+
+struct Shard {
+    SkBaseMutex      fMutex;
+    SkResourceCache* fCache = nullptr;
+};
 
-/** Must hold gMutex when calling. */
-static SkResourceCache* get_cache() {
-    // gMutex is always held when this is called, so we don't need to be fancy in here.
-    gMutex.assertHeld();
-    if (nullptr == gResourceCache) {
+} // namespace
+
+static Shard gShards[kShardCount];
+
+// Shard i's part of a total budget. The first shard takes the remainder.
+static size_t shard_share(size_t total, int i) {
+    return total / kShardCount + (i == 0 ? total % kShardCount : 0);
+}
+
+static Shard* shard_for_key(const SkResourceCache::Key& key) {
+    // Use the high bits of the hash: each shard's hash table indexes with the low ones.
+    return &gShards[(uint64_t(key.hash()) * kShardCount) >> 32];
+}
+
+// For calls without a key, spread the threads across the shards.
+static Shard* shard_for_thread() {
+    const uint64_t id = SkGetThreadID();
+    return &gShards[SkChecksum::Mix(uint32_t(id ^ (id >> 32))) % kShardCount];
+}
+
+/** Must hold the shard's mutex when calling. */
+static SkResourceCache* get_cache(Shard* shard) {
+    shard->fMutex.assertHeld();
+    if (nullptr == shard->fCache) {
 #ifdef SK_USE_DISCARDABLE_SCALEDIMAGECACHE
-        gResourceCache = new SkResourceCache(SkDiscardableMemory::Create);
+        shard->fCache = new SkResourceCache(SkDiscardableMemory::Create);
+        shard->fCache->setDiscardableCountLimit(
+                SkTMax(1, SK_DISCARDABLEMEMORY_SCALEDIMAGECACHE_COUNT_LIMIT / kShardCount));
 #else
-        gResourceCache = new SkResourceCache(SK_DEFAULT_IMAGE_CACHE_LIMIT);
+        shard->fCache = new SkResourceCache(
+                shard_share(SK_DEFAULT_IMAGE_CACHE_LIMIT, SkToInt(shard - gShards)));
 #endif
     }
-    return gResourceCache;
+    return shard->fCache;
+}
+
+// Calls fn(cache, shard index) on every shard, holding its mutex.
+template <typename Fn>
+static void for_each_shard(Fn&& fn) {
+    for (int i = 0; i < kShardCount; ++i) {
+        SkAutoMutexAcquire am(gShards[i].fMutex);
+        fn(get_cache(&gShards[i]), i);
+    }
 }
 
 size_t SkResourceCache::GetTotalBytesUsed() {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->getTotalBytesUsed();
+    size_t used = 0;
+    for_each_shard([&](SkResourceCache* cache, int) { used += cache->getTotalBytesUsed(); });
+    return used;
 }
 
 size_t SkResourceCache::GetTotalByteLimit() {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->getTotalByteLimit();
+    size_t limit = 0;
+    for_each_shard([&](SkResourceCache* cache, int) { limit += cache->getTotalByteLimit(); });
+    return limit;
 }
 
 size_t SkResourceCache::SetTotalByteLimit(size_t newLimit) {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->setTotalByteLimit(newLimit);
+    size_t prevLimit = 0;
+    for_each_shard([&](SkResourceCache* cache, int i) {
+        prevLimit += cache->setTotalByteLimit(shard_share(newLimit, i));
+    });
+    return prevLimit;
 }
 
 SkResourceCache::DiscardableFactory SkResourceCache::GetDiscardableFactory() {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->discardableFactory();
+    SkAutoMutexAcquire am(gShards[0].fMutex);
+    return get_cache(&gShards[0])->discardableFactory();
 }
 
 SkCachedData* SkResourceCache::NewCachedData(size_t bytes) {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->newCachedData(bytes);
+    Shard* shard = shard_for_thread();
+    SkAutoMutexAcquire am(shard->fMutex);
+    return get_cache(shard)->newCachedData(bytes);
 }
 
 void SkResourceCache::Dump() {
-    SkAutoMutexAcquire am(gMutex);
-    get_cache()->dump();
+    for_each_shard([](SkResourceCache* cache, int) { cache->dump(); });
 }
 
 size_t SkResourceCache::SetSingleAllocationByteLimit(size_t size) {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->setSingleAllocationByteLimit(size);
+    size_t prevLimit = 0;
+    for_each_shard([&](SkResourceCache* cache, int) {
+        prevLimit = cache->setSingleAllocationByteLimit(size);
+    });
+    return prevLimit;
 }
 
 size_t SkResourceCache::GetSingleAllocationByteLimit() {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->getSingleAllocationByteLimit();
+    SkAutoMutexAcquire am(gShards[0].fMutex);
+    return get_cache(&gShards[0])->getSingleAllocationByteLimit();
 }
 
 size_t SkResourceCache::GetEffectiveSingleAllocationByteLimit() {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->getEffectiveSingleAllocationByteLimit();
+    // Pinned against the smallest shard budget: anything bigger would be purged right away.
+    size_t limit = SIZE_MAX;
+    for_each_shard([&](SkResourceCache* cache, int) {
+        limit = SkTMin(limit, cache->getEffectiveSingleAllocationByteLimit());
+    });
+    return limit;
 }
 
 void SkResourceCache::PurgeAll() {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->purgeAll();
+    for_each_shard([](SkResourceCache* cache, int) { cache->purgeAll(); });
+}
+
+size_t SkResourceCache::PurgeBytes(size_t bytes) {
+    size_t used = GetTotalBytesUsed();
+    if (0 == bytes || 0 == used) {
+        return 0;
+    }
+    double fraction = SkTMin(1.0, double(bytes) / used);
+    size_t freed = 0;
+    for_each_shard([&](SkResourceCache* cache, int) {
+        freed += cache->purgeBytes(size_t(std::ceil(cache->getTotalBytesUsed() * fraction)));
+    });
+    return freed;
 }
 
 bool SkResourceCache::Find(const Key& key, FindVisitor visitor, void* context) {
-    SkAutoMutexAcquire am(gMutex);
-    return get_cache()->find(key, visitor, context);
+    Shard* shard = shard_for_key(key);
+    SkAutoMutexAcquire am(shard->fMutex);
+    return get_cache(shard)->find(key, visitor, context);
 }
 
 void SkResourceCache::Add(Rec* rec, void* payload) {
-    SkAutoMutexAcquire am(gMutex);
-    get_cache()->add(rec, payload);
+    Shard* shard = shard_for_key(rec->getKey());
+    SkAutoMutexAcquire am(shard->fMutex);
+    get_cache(shard)->add(rec, payload);
 }
 
 void SkResourceCache::VisitAll(Visitor visitor, void* context) {
-    SkAutoMutexAcquire am(gMutex);
-    get_cache()->visitAll(visitor, context);
+    for_each_shard([&](SkResourceCache* cache, int) { cache->visitAll(visitor, context); });
 }
 
 void SkResourceCache::PostPurgeSharedID(uint64_t sharedID) {
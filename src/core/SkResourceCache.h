@@ -25,6 +25,11 @@ class SkTraceMemoryDump;
  *
  *  As a convenience, a global instance is also defined, which can be safely
  *  access across threads via the static methods (e.g. FindAndLock, etc.).
+ *
+ *  The global instance can be split into SK_RESOURCE_CACHE_SHARD_COUNT shards (defined by the
+ *  build, 1 by default), which reduces lock contention between threads. Keys are assigned to a
+ *  shard by hash, and each shard has its own lock, LRU list and an equal share of the budget.
+ *  The static methods report totals across all shards.
  */
 class SkResourceCache {
 public:
@@ -165,6 +170,11 @@ public:
     static size_t GetEffectiveSingleAllocationByteLimit();
 
     static void PurgeAll();
+    /**
+     *  Purges the least recently used entries of each shard, in proportion to what they hold,
+     *  until about 'bytes' have been freed. Returns the number of bytes freed.
+     */
+    static size_t PurgeBytes(size_t bytes);
 
     static void TestDumpMemoryStatistics();
 
@@ -241,12 +251,24 @@ public:
      */
     size_t setTotalByteLimit(size_t newLimit);
 
+    /**
+     *  When backed by discardable memory, the cache purges its least recently used entries to
+     *  stay under this many entries. Returns the previous value.
+     */
+    int setDiscardableCountLimit(int newLimit);
+
     void purgeSharedID(uint64_t sharedID);
 
     void purgeAll() {
         this->purgeAsNeeded(true);
     }
 
+    /**
+     *  Purges the least recently used entries until at least 'bytes' have been freed, or nothing
+     *  else can be purged. Returns the number of bytes freed. Does not change the limits.
+     */
+    size_t purgeBytes(size_t bytes);
+
     DiscardableFactory discardableFactory() const { return fDiscardableFactory; }
 
     SkCachedData* newCachedData(size_t bytes);
@@ -268,6 +290,7 @@ private:
     size_t  fTotalBytesUsed;
     size_t  fTotalByteLimit;
     size_t  fSingleAllocationByteLimit;
+    int     fDiscardableCountLimit;
     int     fCount;
 
     SkMessageBus<PurgeSharedIDMessage>::Inbox fPurgeSharedIDInbox;
@@ -489,6 +489,11 @@ static void generateMask(const SkMask& mask, const SkPath& path,
     }
 }
 
+std::unique_ptr<SkScalerContext> SkScalerContext::makeSibling(const SkDescriptor& desc) const {
+    SkScalerContextEffects effects{fPathEffect.get(), fMaskFilter.get()};
+    return fTypeface->createScalerContext(effects, &desc, true);
+}
+
 void SkScalerContext::getImage(const SkGlyph& origGlyph) {
     const SkGlyph*  glyph = &origGlyph;
     SkGlyph  tmpGlyph{origGlyph.getPackedID()};
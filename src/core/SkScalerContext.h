@@ -276,6 +276,12 @@ public:
     bool SK_WARN_UNUSED_RESULT getPath(SkPackedGlyphID, SkPath*);
     void        getFontMetrics(SkFontMetrics*);
 
+    /** Returns a new scaler context for the same typeface and effects, built from desc (which
+        should be the descriptor this one was made from). It shares no mutable state with this
+        one, so the two can generate glyphs on different threads. May return nullptr.
+     */
+    std::unique_ptr<SkScalerContext> makeSibling(const SkDescriptor& desc) const;
+
     /** Return the size in bytes of the associated gamma lookup table
      */
     static size_t GetGammaLUTSize(SkScalar contrast, SkScalar paintGamma, SkScalar deviceGamma,
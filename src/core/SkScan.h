@@ -25,6 +25,7 @@ typedef SkIRect SkXRect;
 
 extern std::atomic<bool> gSkUseAnalyticAA;
 extern std::atomic<bool> gSkForceAnalyticAA;
+extern std::atomic<bool> gSkUseAccumulationAA;
 
 class AdditiveBlitter;
 
@@ -90,6 +91,8 @@ private:
                             const SkIRect& clipBounds, bool forceRLE);
     static void SAAFillPath(const SkPath& path, SkBlitter* blitter, const SkIRect& pathIR,
                             const SkIRect& clipBounds, bool forceRLE);
+    static void AccumulateFillPath(const SkPath& path, SkBlitter* blitter, const SkIRect& pathIR,
+                                   const SkIRect& clipBounds);
 };
 
 /** Assign an SkXRect from a SkIRect, by promoting the src rect's coordinates
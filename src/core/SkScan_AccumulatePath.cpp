@@ -0,0 +1,385 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkPath.h"
+#include "include/private/SkTDArray.h"
+#include "include/private/SkTemplates.h"
+#include "include/private/SkVx.h"
+#include "src/core/SkBlitter.h"
+#include "src/core/SkGeometry.h"
+#include "src/core/SkMask.h"
+#include "src/core/SkScan.h"
+#include "src/core/SkTSort.h"
+
+#include <climits>
+#include <cmath>
+
+/*
+
+Accumulation AA computes the exact area of each pixel covered by a path, without supersampling
+and without sorting edges along each scanline.
+
+The path is flattened into lines. Each line adds, for every pixel row it crosses, the signed
+area it sweeps to its left into that row of an accumulation buffer: a pixel in the middle of
+the line's span gets (in total) the height of the line within the row, split between its
+cells by how much of each cell lies to the right of the line. The coverage of a pixel is then
+the sum of its row of the buffer up to and including it, so lines never need to know about
+each other and winding comes out of the sign of each line's direction.
+
+Rows are rasterized a band at a time, so the buffers stay small and hot in the cache, and bands
+(or rows within a band) that no line touches are never resolved. The prefix sum over each row
+is done four pixels at a time, and each band is handed to the blitter as one A8 mask.
+
+Lines left of the bounds are moved onto its left edge, where they still add their winding to
+every pixel of the row, and the parts of lines right of the bounds are dropped, since they only
+affect pixels outside.
+
+Like any coverage accumulation this is only approximate where edges cross inside a pixel: the
+signed areas of the regions on either side of the crossing are summed before the winding rule
+is applied, so a self-intersecting contour may come out lighter in those pixels.
+
+*/
+
+namespace {
+
+constexpr int   kBandHeight       = 16;   // Rows accumulated and resolved at a time.
+constexpr float kFlattenTolerance = 0.1f; // Max distance (in pixels) from a curve to its lines.
+constexpr int   kMaxCurveLines    = 100;
+
+using F4 = skvx::Vec<4,float>;
+
+// A line with fY0 < fY1, with fDir = +1 if the original went down and -1 if it went up.
+struct Line {
+    float fX0, fY0, fX1, fY1;
+    float fDir;
+
+    bool operator<(const Line& that) const { return fY0 < that.fY0; }
+};
+
+// Flattens a path into Lines relative to the top left of its bounds, clipped to those bounds.
+class LineBuilder {
+public:
+    LineBuilder(const SkIRect& bounds)
+        : fOffset(SkPoint::Make(-bounds.fLeft, -bounds.fTop))
+        , fWidth(bounds.width())
+        , fHeight(bounds.height()) {}
+
+    void addPath(const SkPath& path) {
+        SkPath::Iter iter(path, true);
+        SkPoint pts[4];
+        SkPath::Verb verb;
+        while ((verb = iter.next(pts)) != SkPath::kDone_Verb) {
+            switch (verb) {
+                case SkPath::kLine_Verb:
+                    this->addLine(pts[0] + fOffset, pts[1] + fOffset);
+                    break;
+                case SkPath::kQuad_Verb:
+                    this->addQuad(pts);
+                    break;
+                case SkPath::kConic_Verb: {
+                    SkAutoConicToQuads quadder;
+                    const SkPoint* quadPts = quadder.computeQuads(pts, iter.conicWeight(), 0.25f);
+                    for (int i = 0; i < quadder.countQuads(); ++i) {
+                        this->addQuad(quadPts + 2 * i);
+                    }
+                    break;
+                }
+                case SkPath::kCubic_Verb:
+                    this->addCubic(pts);
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    SkTDArray<Line>& lines() { return fLines; }
+
+private:
+    static int CountLines(float deviation) {
+        float n = std::ceil(std::sqrt(deviation / kFlattenTolerance));
+        return n < 1 ? 1 : n > kMaxCurveLines ? kMaxCurveLines : (int)n;
+    }
+
+    void addQuad(const SkPoint pts[3]) {
+        SkPoint p0 = pts[0] + fOffset, p1 = pts[1] + fOffset, p2 = pts[2] + fOffset;
+        // Lines n segments long are at most |p0 - 2p1 + p2| / 4n^2 from the curve.
+        SkVector dd = p0 - p1 - p1 + p2;
+        int n = CountLines(dd.length() * 0.25f);
+        SkPoint prev = p0;
+        for (int i = 1; i < n; ++i) {
+            float t = (float)i / n, s = 1 - t;
+            SkPoint p = {s*s*p0.fX + 2*s*t*p1.fX + t*t*p2.fX,
+                         s*s*p0.fY + 2*s*t*p1.fY + t*t*p2.fY};
+            this->addLine(prev, p);
+            prev = p;
+        }
+        this->addLine(prev, p2);
+    }
+
+    void addCubic(const SkPoint pts[4]) {
+        SkPoint p0 = pts[0] + fOffset, p1 = pts[1] + fOffset,
+                p2 = pts[2] + fOffset, p3 = pts[3] + fOffset;
+        // Lines n segments long are at most 3 max(|p0 - 2p1 + p2|, |p1 - 2p2 + p3|) / 4n^2 from
+        // the curve.
+        SkVector dd0 = p0 - p1 - p1 + p2,
+                 dd1 = p1 - p2 - p2 + p3;
+        int n = CountLines(SkTMax(dd0.length(), dd1.length()) * 0.75f);
+        SkPoint prev = p0;
+        for (int i = 1; i < n; ++i) {
+            float t = (float)i / n, s = 1 - t;
+            float a = s*s*s, b = 3*s*s*t, c = 3*s*t*t, d = t*t*t;
+            SkPoint p = {a*p0.fX + b*p1.fX + c*p2.fX + d*p3.fX,
+                         a*p0.fY + b*p1.fY + c*p2.fY + d*p3.fY};
+            this->addLine(prev, p);
+            prev = p;
+        }
+        this->addLine(prev, p3);
+    }
+
+    void addLine(SkPoint p0, SkPoint p1) {
+        float dir = 1;
+        if (p0.fY > p1.fY) {
+            std::swap(p0, p1);
+            dir = -1;
+        }
+        if (!(p0.fY < p1.fY) || p1.fY <= 0 || p0.fY >= fHeight) {
+            return;  // Horizontal (or NaN), or entirely above or below.
+        }
+
+        float dxdy = (p1.fX - p0.fX) / (p1.fY - p0.fY);
+        if (p0.fY < 0) {
+            p0 = {p0.fX - p0.fY * dxdy, 0};
+        }
+        if (p1.fY > fHeight) {
+            p1 = {p1.fX - (p1.fY - fHeight) * dxdy, fHeight};
+        }
+
+        float xMin = SkTMin(p0.fX, p1.fX),
+              xMax = SkTMax(p0.fX, p1.fX);
+        if (xMin >= fWidth) {
+            return;
+        }
+        if (xMax <= 0) {
+            this->push(0, p0.fY, 0, p1.fY, dir);
+            return;
+        }
+        if (xMin < 0) {
+            float y = SkTPin(p0.fY - p0.fX / dxdy, p0.fY, p1.fY);
+            if (p0.fX < 0) {
+                this->push(0, p0.fY, 0, y, dir);
+                p0 = {0, y};
+            } else {
+                this->push(0, y, 0, p1.fY, dir);
+                p1 = {0, y};
+            }
+        }
+        if (xMax > fWidth) {
+            float y = SkTPin(p0.fY + (fWidth - p0.fX) / dxdy, p0.fY, p1.fY);
+            if (p0.fX > fWidth) {
+                p0 = {fWidth, y};
+            } else {
+                p1 = {fWidth, y};
+            }
+        }
+        this->push(p0.fX, p0.fY, p1.fX, p1.fY, dir);
+    }
+
+    void push(float x0, float y0, float x1, float y1, float dir) {
+        if (y0 < y1) {
+            *fLines.append() = {SkTPin(x0, 0.0f, fWidth), y0, SkTPin(x1, 0.0f, fWidth), y1, dir};
+        }
+    }
+
+    const SkVector  fOffset;
+    const float     fWidth, fHeight;
+    SkTDArray<Line> fLines;
+};
+
+// The range of cells of a row of the accumulation buffer that have been written.
+struct RowSpan {
+    int fLeft, fRight;  // inclusive; fLeft > fRight if nothing has been written
+};
+
+// Adds the area to the left of 'line' to the rows of 'acc' (which starts at row 'bandTop')
+// between bandTop and bandBottom.
+void accumulate_line(const Line& line, int bandTop, int bandBottom,
+                     float* acc, size_t stride, RowSpan spans[]) {
+    float yStart = SkTMax(line.fY0, (float)bandTop),
+          yEnd   = SkTMin(line.fY1, (float)bandBottom);
+    if (!(yStart < yEnd)) {
+        return;
+    }
+    const float dxdy = (line.fX1 - line.fX0) / (line.fY1 - line.fY0);
+    float x = line.fX0 + (yStart - line.fY0) * dxdy;
+
+    for (int y = (int)yStart; y < bandBottom && y < yEnd; ++y) {
+        float dy = SkTMin((float)(y + 1), yEnd) - SkTMax((float)y, yStart);
+        float xNext = x + dxdy * dy;
+        float d = dy * line.fDir;
+        float* row = acc + (y - bandTop) * stride;
+
+        float xa = SkTMin(x, xNext),
+              xb = SkTMax(x, xNext);
+        int xai = (int)xa,
+            xbi = (int)std::ceil(xb);
+        int right;
+        if (xbi <= xai + 1) {
+            // Within one cell: split by the middle of the line.
+            float mid = 0.5f * (x + xNext) - xai;
+            row[xai    ] += d - d * mid;
+            row[xai + 1] += d * mid;
+            right = xai + 1;
+        } else {
+            // Across several cells: the area is trapezoidal, with triangles at each end.
+            float s     = 1 / (xb - xa),
+                  xaf   = xa - xai,
+                  xbf   = xb - xbi + 1,
+                  aHead = 0.5f * s * (1 - xaf) * (1 - xaf),
+                  aTail = 0.5f * s * xbf * xbf;
+            row[xai] += d * aHead;
+            if (xbi == xai + 2) {
+                row[xai + 1] += d * (1 - aHead - aTail);
+            } else {
+                float a1 = s * (1.5f - xaf);
+                row[xai + 1] += d * (a1 - aHead);
+                for (int xi = xai + 2; xi < xbi - 1; ++xi) {
+                    row[xi] += d * s;
+                }
+                float a2 = a1 + (xbi - xai - 3) * s;
+                row[xbi - 1] += d * (1 - a2 - aTail);
+            }
+            row[xbi] += d * aTail;
+            right = xbi;
+        }
+
+        RowSpan& span = spans[y - bandTop];
+        span.fLeft  = SkTMin(span.fLeft,  xai);
+        span.fRight = SkTMax(span.fRight, right);
+        x = xNext;
+    }
+}
+
+SK_ALWAYS_INLINE F4 coverage(F4 winding, bool evenOdd) {
+    F4 c = abs(winding);
+    if (evenOdd) {
+        c = c - 2 * floor(c * 0.5f);
+        c = min(c, 2 - c);
+    }
+    return min(c, 1.0f);
+}
+
+// Sums the cells of one row of 'acc' into 'dst', clearing them for the next band.
+void resolve_row(float* acc, const RowSpan& span, int width, bool evenOdd, uint8_t* dst) {
+    if (span.fLeft > span.fRight) {
+        sk_bzero(dst, width);
+        return;
+    }
+    int x = span.fLeft & ~3;
+    sk_bzero(dst, x);
+
+    // The stride is a multiple of four and past width, so whole vectors fit in both rows.
+    const int end = SkTMin(width, span.fRight + 1);
+    F4 sum = 0;
+    for (; x < end; x += 4) {
+        F4 v = F4::Load(acc + x);
+        v += skvx::shuffle<0,0,1,2>(v) * F4{0,1,1,1};
+        v += skvx::shuffle<0,0,0,1>(v) * F4{0,0,1,1};
+        v += sum;
+        sum = skvx::shuffle<3,3,3,3>(v);
+        skvx::cast<uint8_t>(coverage(v, evenOdd) * 255 + 0.5f).store(dst + x);
+        F4(0).store(acc + x);
+    }
+    if (x <= span.fRight) {
+        sk_bzero(acc + x, (span.fRight + 1 - x) * sizeof(float));
+    }
+    if (x < width) {
+        // Nothing was added past here, so the rest of the row has the same coverage.
+        memset(dst + x, (uint8_t)(coverage(sum, evenOdd)[0] * 255 + 0.5f), width - x);
+    }
+}
+
+}  // namespace
+
+void SkScan::AccumulateFillPath(const SkPath& path, SkBlitter* blitter, const SkIRect& pathIR,
+                                const SkIRect& clipBounds) {
+    SkASSERT(!path.isInverseFillType());
+    SkIRect bounds;
+    if (!bounds.intersect(pathIR, clipBounds)) {
+        return;
+    }
+
+    LineBuilder builder(bounds);
+    builder.addPath(path);
+    SkTDArray<Line>& lines = builder.lines();
+    if (lines.isEmpty()) {
+        return;
+    }
+    SkTQSort(lines.begin(), lines.end() - 1);
+
+    const int    width     = bounds.width(),
+                 height    = bounds.height(),
+                 bandRows  = SkTMin(kBandHeight, height);
+    const size_t stride    = SkAlign4(width + 2);
+    const bool   evenOdd   = path.getFillType() == SkPath::kEvenOdd_FillType;
+
+    SkAutoTMalloc<float>   acc(stride * bandRows);
+    SkAutoTMalloc<uint8_t> mask(stride * bandRows);
+    RowSpan                spans[kBandHeight];
+    sk_bzero(acc.get(), stride * bandRows * sizeof(float));
+
+    SkTDArray<const Line*> active;
+    int next = 0;
+    for (int bandTop = 0; bandTop < height; bandTop += bandRows) {
+        const int bandBottom = SkTMin(bandTop + bandRows, height);
+
+        // Drop the lines that ended above this band, and pick up those that start in it.
+        int kept = 0;
+        for (const Line* line : active) {
+            if (line->fY1 > bandTop) {
+                active[kept++] = line;
+            }
+        }
+        active.setCount(kept);
+        while (next < lines.count() && lines[next].fY0 < bandBottom) {
+            *active.append() = &lines[next++];
+        }
+        if (active.isEmpty()) {
+            continue;
+        }
+
+        for (int i = 0; i < bandBottom - bandTop; ++i) {
+            spans[i] = {INT_MAX, -1};
+        }
+        for (const Line* line : active) {
+            accumulate_line(*line, bandTop, bandBottom, acc.get(), stride, spans);
+        }
+
+        int first = 0, last = bandBottom - bandTop - 1;
+        while (first <= last && spans[first].fLeft > spans[first].fRight) {
+            ++first;
+        }
+        while (last >= first && spans[last].fLeft > spans[last].fRight) {
+            --last;
+        }
+        if (first > last) {
+            continue;
+        }
+        for (int i = first; i <= last; ++i) {
+            resolve_row(acc.get() + i * stride, spans[i], width, evenOdd,
+                        mask.get() + i * stride);
+        }
+
+        SkMask m;
+        m.fImage    = mask.get() + first * stride;
+        m.fBounds   = {bounds.fLeft, bounds.fTop + bandTop + first,
+                       bounds.fRight, bounds.fTop + bandTop + last + 1};
+        m.fRowBytes = SkToU32(stride);
+        m.fFormat   = SkMask::kA8_Format;
+        blitter->blitMask(m, m.fBounds);
+    }
+}
@@ -786,7 +786,10 @@ void SkScan::AntiFillPath(const SkPath& path, const SkRegion& origClip,
     SkScalar avgLength, complexity;
     compute_complexity(path, avgLength, complexity);
 
-    if (ShouldUseAAA(path, avgLength, complexity)) {
+    if (gSkUseAccumulationAA && !isInverse && !forceRLE) {
+        // Accumulation AA only ever draws masks inside ir, so it can't do inverse or RLE fills.
+        SkScan::AccumulateFillPath(path, blitter, ir, clipRgn->getBounds());
+    } else if (ShouldUseAAA(path, avgLength, complexity)) {
         // Do not use AAA if path is too complicated:
         // there won't be any speedup or significant visual improvement.
         SkScan::AAAFillPath(path, blitter, ir, clipRgn->getBounds(), forceRLE);
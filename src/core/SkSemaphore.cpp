@@ -6,6 +6,7 @@
  */
 
 #include "include/private/SkSemaphore.h"
+#include "src/core/SkContention.h"
 #include "src/core/SkLeanWindows.h"
 
 #if defined(SK_BUILD_FOR_MAC) || defined(SK_BUILD_FOR_IOS)
@@ -82,7 +83,10 @@ void SkBaseSemaphore::osSignal(int n) {
     fOSSemaphore->signal(n);
 }
 
+std::atomic<uint64_t> gSkSemaphoreContendedWaits{0};
+
 void SkBaseSemaphore::osWait() {
+    gSkSemaphoreContendedWaits.fetch_add(1, std::memory_order_relaxed);
     fOSSemaphoreOnce([this] { fOSSemaphore = new OSSemaphore; });
     fOSSemaphore->wait();
 }
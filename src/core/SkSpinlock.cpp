@@ -6,6 +6,7 @@
  */
 
 #include "include/private/SkSpinlock.h"
+#include "src/core/SkContention.h"
 
 #if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
     #include <emmintrin.h>
@@ -14,7 +15,10 @@
     static void pause() { /*spin*/ }
 #endif
 
+std::atomic<uint64_t> gSkSpinlockContendedAcquires{0};
+
 void SkSpinlock::contendedAcquire() {
+    gSkSpinlockContendedAcquires.fetch_add(1, std::memory_order_relaxed);
     // To act as a mutex, we need an acquire barrier when we acquire the lock.
     while (fLocked.exchange(true, std::memory_order_acquire)) {
         pause();
@@ -14,14 +14,9 @@
 #include "include/private/SkOnce.h"
 #include "include/private/SkTemplates.h"
 #include "src/core/SkMakeUnique.h"
+#include "src/core/SkTaskGroup.h"
 #include <cctype>
 
-namespace {
-size_t compute_path_size(const SkPath& path) {
-    return sizeof(SkPath) + path.countPoints() * sizeof(SkPoint);
-}
-}  // namespace
-
 SkStrike::SkStrike(
     const SkDescriptor& desc,
     std::unique_ptr<SkScalerContext> scaler,
@@ -36,6 +31,11 @@ SkStrike::SkStrike(
     fMemoryUsed = sizeof(*this);
 }
 
+SkStrike::~SkStrike() {
+    // Discardable memory must be unlocked before it is deleted.
+    this->unlockImages();
+}
+
 const SkDescriptor& SkStrike::getDescriptor() const {
     return *fDesc.getDesc();
 }
@@ -126,10 +126,11 @@ SkGlyph* SkStrike::lookupByPackedGlyphID(SkPackedGlyphID packedGlyphID, MetricsT
 }
 
 const void* SkStrike::findImage(const SkGlyph& glyph) {
+    SkAutoMemoryTag memoryTag(SkMemoryTag::kGlyphs);
     if (glyph.fWidth > 0 && glyph.fWidth < kMaxGlyphWidth) {
         if (nullptr == glyph.fImage) {
             SkDEBUGCODE(SkMask::Format oldFormat = (SkMask::Format)glyph.fMaskFormat);
-            size_t  size = const_cast<SkGlyph&>(glyph).allocImage(&fAlloc);
+            size_t  size = this->allocImage(const_cast<SkGlyph*>(&glyph));
             // check that alloc() actually succeeded
             if (glyph.fImage) {
                 fScalerContext->getImage(glyph);
@@ -145,11 +146,144 @@ const void* SkStrike::findImage(const SkGlyph& glyph) {
     return glyph.fImage;
 }
 
+void SkStrike::useDiscardableImages(sk_sp<SkDiscardableMemory::Factory> factory) {
+    SkASSERT(fImagesLocked);
+    fDiscardableImages = true;
+    fImageFactory = std::move(factory);
+}
+
+void SkStrike::unlockImages() {
+    if (fDiscardableImages && fImagesLocked) {
+        for (ImagePage& page : fImagePages) {
+            page.fMemory->unlock();
+        }
+        fImagesLocked = false;
+    }
+}
+
+void SkStrike::lockImages() {
+    if (!fDiscardableImages || fImagesLocked) {
+        return;
+    }
+    fImagesLocked = true;
+
+    size_t kept = 0;
+    for (size_t i = 0; i < fImagePages.size(); ++i) {
+        ImagePage& page = fImagePages[i];
+        if (page.fMemory->lock()) {
+            if (kept != i) {
+                fImagePages[kept] = std::move(page);
+            }
+            kept++;
+            continue;
+        }
+        // The system reclaimed this page; findImage() makes its images again.
+        for (SkGlyph* glyph : page.fGlyphs) {
+            fMemoryUsed -= glyph->computeImageSize();
+            glyph->fImage = nullptr;
+        }
+    }
+    fImagePages.erase(fImagePages.begin() + kept, fImagePages.end());
+}
+
+size_t SkStrike::allocImage(SkGlyph* glyph) {
+    if (!fDiscardableImages) {
+        return glyph->allocImage(&fAlloc);
+    }
+    SkASSERT(fImagesLocked);
+
+    size_t size = glyph->computeImageSize();
+    size_t alignment = glyph->formatAlignment();
+    size_t offset = 0;
+    if (!fImagePages.empty()) {
+        const ImagePage& page = fImagePages.back();
+        offset = (page.fUsed + alignment - 1) & ~(alignment - 1);
+    }
+    if (fImagePages.empty() || offset + size > fImagePages.back().fSize) {
+        size_t pageSize = SkTMax(kImagePageSize, size);
+        std::unique_ptr<SkDiscardableMemory> memory(fImageFactory
+                                                    ? fImageFactory->create(pageSize)
+                                                    : SkDiscardableMemory::Create(pageSize));
+        if (!memory) {
+            // Keep it in the strike's own memory then.
+            return glyph->allocImage(&fAlloc);
+        }
+        fImagePages.push_back({std::move(memory), pageSize, 0, {}});
+        offset = 0;
+    }
+
+    ImagePage& page = fImagePages.back();
+    glyph->fImage = static_cast<char*>(page.fMemory->data()) + offset;
+    page.fUsed = offset + size;
+    page.fGlyphs.push_back(glyph);
+    return size;
+}
+
+void SkStrike::prepareImages(SkSpan<const SkPackedGlyphID> glyphIDs, SkExecutor* executor) {
+    SkAutoMemoryTag memoryTag(SkMemoryTag::kGlyphs);
+    // Metrics and image storage come from the strike's own allocators, so get those up front.
+    SkTDArray<const SkGlyph*> needImages;
+    for (SkPackedGlyphID glyphID : glyphIDs) {
+        SkGlyph* glyph = this->lookupByPackedGlyphID(glyphID, kFull_MetricsType);
+        if (glyph->fWidth > 0 && glyph->fWidth < kMaxGlyphWidth && nullptr == glyph->fImage) {
+            size_t size = this->allocImage(glyph);
+            if (glyph->fImage) {
+                fMemoryUsed += size;
+                *needImages.append() = glyph;
+            }
+        }
+    }
+
+    // Making a scaler context is not free, so only split off tasks that have enough glyphs to
+    // pay for one.
+    static constexpr int kMinGlyphsPerTask = 32;
+    static constexpr int kMaxTasks = 8;
+    const int taskCount = SkTMin(kMaxTasks, needImages.count() / kMinGlyphsPerTask);
+    if (taskCount <= 1) {
+        for (const SkGlyph* glyph : needImages) {
+            fScalerContext->getImage(*glyph);
+        }
+        return;
+    }
+
+    // Each glyph's image is disjoint memory, so tasks only share the (read only) glyph list. The
+    // first task can use our scaler context: we hold the strike exclusively and wait below.
+    const int glyphsPerTask = (needImages.count() + taskCount - 1) / taskCount;
+    SkAutoTArray<bool> failed(taskCount);
+    SkTaskGroup tasks(executor ? *executor : SkExecutor::GetDefault());
+    tasks.batch(taskCount, [&](int task) {
+        SkAutoMemoryTag memoryTag(SkMemoryTag::kGlyphs);
+        std::unique_ptr<SkScalerContext> sibling;
+        SkScalerContext* scaler = fScalerContext.get();
+        if (task > 0) {
+            sibling = fScalerContext->makeSibling(this->getDescriptor());
+            scaler = sibling.get();
+        }
+        failed[task] = scaler == nullptr;
+        if (scaler) {
+            int end = SkTMin(needImages.count(), (task + 1) * glyphsPerTask);
+            for (int i = task * glyphsPerTask; i < end; ++i) {
+                scaler->getImage(*needImages[i]);
+            }
+        }
+    });
+    tasks.wait();
+
+    for (int task = 0; task < taskCount; ++task) {
+        if (failed[task]) {
+            int end = SkTMin(needImages.count(), (task + 1) * glyphsPerTask);
+            for (int i = task * glyphsPerTask; i < end; ++i) {
+                fScalerContext->getImage(*needImages[i]);
+            }
+        }
+    }
+}
+
 void SkStrike::initializeImage(const volatile void* data, size_t size, SkGlyph* glyph) {
     SkASSERT(!glyph->fImage);
 
     if (glyph->fWidth > 0 && glyph->fWidth < kMaxGlyphWidth) {
-        size_t allocSize = glyph->allocImage(&fAlloc);
+        size_t allocSize = this->allocImage(glyph);
         // check that alloc() actually succeeded
         if (glyph->fImage) {
             SkASSERT(size == allocSize);
@@ -159,12 +293,30 @@ void SkStrike::initializeImage(const volatile void* data, size_t size, SkGlyph*
     }
 }
 
+void SkStrike::adoptImage(const void* data, size_t size, const sk_sp<SkData>& owner,
+                          SkGlyph* glyph) {
+    SkASSERT(!glyph->fImage);
+    SkASSERT(size == glyph->computeImageSize());
+
+    if (glyph->fWidth > 0 && glyph->fWidth < kMaxGlyphWidth) {
+        glyph->fImage = const_cast<void*>(data);
+        if (fAdoptedImageOwners.empty() || fAdoptedImageOwners.back() != owner) {
+            fAdoptedImageOwners.push_back(owner);
+        }
+        // Counted like any other image, since purging this strike is what lets owner go.
+        fMemoryUsed += size;
+    }
+}
+
 const SkPath* SkStrike::findPath(const SkGlyph& glyph) {
+    SkAutoMemoryTag memoryTag(SkMemoryTag::kGlyphs);
 
     if (!glyph.isEmpty()) {
         // If the path already exists, return it.
         if (glyph.fPathData != nullptr) {
             if (glyph.fPathData->fHasPath) {
+                // Rebuild the path if releasePaths() freed it.
+                fMemoryUsed += glyph.fPathData->expand();
                 return &glyph.fPathData->fPath;
             }
             return nullptr;
@@ -172,7 +324,10 @@ const SkPath* SkStrike::findPath(const SkGlyph& glyph) {
 
         const_cast<SkGlyph&>(glyph).addPath(fScalerContext.get(), &fAlloc);
         if (glyph.fPathData != nullptr) {
-            fMemoryUsed += compute_path_size(glyph.fPathData->fPath);
+            if (glyph.fPathData->fHasPath) {
+                glyph.fPathData->compact(&fAlloc);
+            }
+            fMemoryUsed += glyph.fPathData->memoryUsed();
         }
 
         return glyph.path();
@@ -187,14 +342,18 @@ bool SkStrike::initializePath(SkGlyph* glyph, const volatile void* data, size_t
     if (glyph->fWidth) {
         SkGlyph::PathData* pathData = fAlloc.make<SkGlyph::PathData>();
         glyph->fPathData = pathData;
-        if (size == 0u) return true;
+        if (size == 0u) {
+            fMemoryUsed += pathData->memoryUsed();
+            return true;
+        }
 
-        auto path = skstd::make_unique<SkPath>();
         if (!pathData->fPath.readFromMemory(const_cast<const void*>(data), size)) {
+            fMemoryUsed += pathData->memoryUsed();
             return false;
         }
-        fMemoryUsed += compute_path_size(glyph->fPathData->fPath);
         pathData->fHasPath = true;
+        pathData->compact(&fAlloc);
+        fMemoryUsed += pathData->memoryUsed();
     }
 
     return true;
@@ -228,12 +387,16 @@ SkVector SkStrike::rounding() const {
 }
 
 const SkGlyph& SkStrike::getGlyphMetrics(SkGlyphID glyphID, SkPoint position) {
+    return this->getGlyphIDMetrics(this->packedGlyphID(glyphID, position));
+}
+
+SkPackedGlyphID SkStrike::packedGlyphID(SkGlyphID glyphID, SkPoint position) const {
     if (!fIsSubpixel) {
-        return this->getGlyphIDMetrics(glyphID);
+        return SkPackedGlyphID(glyphID);
     } else {
         SkIPoint lookupPosition = SkStrikeCommon::SubpixelLookup(fAxisAlignment, position);
 
-        return this->getGlyphIDMetrics(glyphID, lookupPosition.x(), lookupPosition.y());
+        return SkPackedGlyphID(glyphID, lookupPosition.x(), lookupPosition.y());
     }
 }
 
@@ -458,6 +621,17 @@ void SkStrike::dump() const {
     SkDebugf("%s\n", msg.c_str());
 }
 
+size_t SkStrike::releasePaths() {
+    size_t freed = 0;
+    fGlyphMap.foreach([&freed](SkGlyph** glyph) {
+        if ((*glyph)->fPathData) {
+            freed += (*glyph)->fPathData->release();
+        }
+    });
+    fMemoryUsed -= freed;
+    return freed;
+}
+
 void SkStrike::generatePath(const SkGlyph& glyph) {
     if (!glyph.isEmpty()) { this->findPath(glyph); }
 }
@@ -473,7 +647,7 @@ void SkStrike::forceValidate() const {
             memoryUsed += glyphPtr->computeImageSize();
         }
         if (glyphPtr->fPathData) {
-            memoryUsed += compute_path_size(glyphPtr->fPathData->fPath);
+            memoryUsed += glyphPtr->fPathData->memoryUsed();
         }
     });
     SkASSERT(fMemoryUsed == memoryUsed);
@@ -7,6 +7,7 @@
 #ifndef SkStrike_DEFINED
 #define SkStrike_DEFINED
 
+#include "include/core/SkData.h"
 #include "include/core/SkFontMetrics.h"
 #include "include/core/SkFontTypes.h"
 #include "include/core/SkPaint.h"
@@ -14,11 +15,15 @@
 #include "include/private/SkTemplates.h"
 #include "src/core/SkArenaAlloc.h"
 #include "src/core/SkDescriptor.h"
+#include "src/core/SkDiscardableMemory.h"
 #include "src/core/SkGlyph.h"
 #include "src/core/SkGlyphRunPainter.h"
 #include "src/core/SkScalerContext.h"
 #include "src/core/SkStrikeInterface.h"
 #include <memory>
+#include <vector>
+
+class SkExecutor;
 
 /** \class SkGlyphCache
 
@@ -38,6 +43,7 @@ public:
     SkStrike(const SkDescriptor& desc,
              std::unique_ptr<SkScalerContext> scaler,
              const SkFontMetrics&);
+    ~SkStrike() override;
 
     /** Return true if glyph is cached. */
     bool isGlyphCached(SkGlyphID glyphID, SkFixed x, SkFixed y) const;
@@ -61,6 +67,11 @@ public:
 
     const SkGlyph& getGlyphIDMetrics(SkPackedGlyphID id);
 
+    /** Returns the id getGlyphMetrics(glyphID, position) would look up. Only reads state that is
+        fixed when the strike is created, so it is safe to call from any thread.
+    */
+    SkPackedGlyphID packedGlyphID(SkGlyphID glyphID, SkPoint position) const;
+
     void getAdvances(SkSpan<const SkGlyphID>, SkPoint[]);
 
     /** Returns the number of glyphs for this strike.
@@ -75,10 +86,39 @@ public:
     */
     const void* findImage(const SkGlyph&);
 
+    /** Generates the images of any of the glyphs that don't have one yet. The work is split
+        across tasks on executor (the default executor if null), each rasterizing with its own
+        scaler context, and this returns once every image is in the strike. Worth it when a lot of
+        glyphs are new, e.g. the first paint of CJK text.
+    */
+    void prepareImages(SkSpan<const SkPackedGlyphID> glyphIDs, SkExecutor* executor = nullptr);
+
     /** Initializes the image associated with the glyph with |data|.
      */
     void initializeImage(const volatile void* data, size_t size, SkGlyph*);
 
+    /** Like initializeImage(), but uses |data| in place instead of copying it. The strike keeps
+        |owner|, which holds |data|, alive as long as it might use the image.
+    */
+    void adoptImage(const void* data, size_t size, const sk_sp<SkData>& owner, SkGlyph*);
+
+    /** Keeps the images generated from now on in discardable memory from factory (from
+        SkDiscardableMemory::Create if null), which the system may reclaim while the images are
+        unlocked. Images start out locked. Only for strikes used by one thread at a time.
+    */
+    void useDiscardableImages(sk_sp<SkDiscardableMemory::Factory> factory = nullptr);
+
+    bool hasDiscardableImages() const { return fDiscardableImages; }
+
+    /** Unlocks the discardable images; until lockImages() no image of this strike may be read.
+    */
+    void unlockImages();
+
+    /** Locks the discardable images again. The glyphs of any images the system reclaimed lose
+        them, and findImage() generates them again when they are next needed.
+    */
+    void lockImages();
+
     /** If the advance axis intersects the glyph's path, append the positions scaled and offset
         to the array (if non-null), and set the count to the updated array length.
     */
@@ -90,6 +130,12 @@ public:
     */
     const SkPath* findPath(const SkGlyph&);
 
+    /** Frees the SkPaths of glyphs whose outlines are also kept in compact form; findPath()
+        rebuilds them when they are next needed. Returns the number of bytes freed.
+        Nothing may be holding a path from this strike.
+    */
+    size_t releasePaths();
+
     /** Initializes the path associated with the glyph with |data|. Returns false if
      *  data is invalid.
      */
@@ -206,6 +252,10 @@ private:
     static const SkGlyph::Intercept* MatchBounds(const SkGlyph* glyph,
                                                  const SkScalar bounds[2]);
 
+    // Allocates glyph's image from the discardable pages if there are any, otherwise from fAlloc.
+    // Returns the size of the image.
+    size_t allocImage(SkGlyph* glyph);
+
     const SkAutoDescriptor fDesc;
     const std::unique_ptr<SkScalerContext> fScalerContext;
     SkFontMetrics          fFontMetrics;
@@ -232,6 +282,24 @@ private:
 
     SkArenaAlloc            fAlloc {kMinAllocAmount};
 
+    // The discardable memory images are allocated from, filled in order, and the glyphs whose
+    // images are in it.
+    struct ImagePage {
+        std::unique_ptr<SkDiscardableMemory> fMemory;
+        size_t                               fSize;
+        size_t                               fUsed;
+        std::vector<SkGlyph*>                fGlyphs;
+    };
+    static constexpr size_t kImagePageSize = 16 * 1024;
+
+    bool                                 fDiscardableImages{false};
+    bool                                 fImagesLocked{true};
+    sk_sp<SkDiscardableMemory::Factory>  fImageFactory;
+    std::vector<ImagePage>               fImagePages;
+
+    // Keeps alive the memory holding images passed to adoptImage().
+    std::vector<sk_sp<SkData>> fAdoptedImageOwners;
+
     // used to track (approx) how much ram is tied-up in this cache
     size_t                  fMemoryUsed;
 
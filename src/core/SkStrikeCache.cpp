@@ -14,8 +14,123 @@
 #include "include/core/SkTypeface.h"
 #include "include/private/SkMutex.h"
 #include "include/private/SkTemplates.h"
+#include "src/core/SkArenaAlloc.h"
 #include "src/core/SkGlyphRunPainter.h"
+#include "src/core/SkMakeUnique.h"
+#include "src/core/SkPerfCounters.h"
 #include "src/core/SkStrike.h"
+#include "src/core/SkTLS.h"
+
+#include <vector>
+
+// The glyphs of a shared strike that are ready to draw, readable without a lock. Entries are only
+// ever added, while holding the strike's mutex, and each entry is published with a release store
+// after the glyph data it advertises is complete. Growing the table publishes a new table; the old
+// ones are kept until the strike is deleted, because a reader may still be probing them. They add
+// up to less than the current table, so no other reclamation scheme is needed.
+class SkStrikeCache::SharedGlyphs {
+public:
+    enum Ready : uint8_t {
+        kImage = 1 << 0,
+        kPath  = 1 << 1,
+    };
+
+    struct Entry {
+        Entry(const SkGlyph* glyph, uint8_t ready) : fGlyph{glyph}, fReady{ready} {}
+        bool isReady(uint8_t need) const {
+            return (fReady.load(std::memory_order_acquire) & need) == need;
+        }
+
+        const SkGlyph* const fGlyph;
+        std::atomic<uint8_t> fReady;
+    };
+
+    SharedGlyphs() { this->publish(kInitialCapacity); }
+
+    // What prepareForDrawing() must produce for glyph beyond its metrics.
+    static uint8_t Need(const SkGlyph& glyph, int maxDimension,
+                        SkStrikeInterface::PreparationDetail detail) {
+        if (glyph.isEmpty()) {
+            return 0;
+        }
+        if (glyph.maxDimension() <= maxDimension) {
+            return detail == SkStrikeInterface::kImageIfNeeded ? kImage : 0;
+        }
+        return glyph.fMaskFormat != SkMask::kARGB32_Format ? kPath : 0;
+    }
+
+    // Safe to call from any thread.
+    const Entry* find(SkPackedGlyphID packedID) const {
+        const Table* table = fTable.load(std::memory_order_acquire);
+        int mask = table->fCapacity - 1;
+        for (int i = packedID.hash() & mask; ; i = (i + 1) & mask) {
+            const Entry* entry = table->fSlots[i].load(std::memory_order_acquire);
+            if (entry == nullptr || entry->fGlyph->getPackedID() == packedID) {
+                return entry;
+            }
+        }
+    }
+
+    // Only call while holding the strike's mutex.
+    void add(const SkGlyph* glyph, uint8_t ready) {
+        if (const Entry* entry = this->find(glyph->getPackedID())) {
+            Entry* mutableEntry = const_cast<Entry*>(entry);
+            mutableEntry->fReady.store(entry->fReady.load(std::memory_order_relaxed) | ready,
+                                       std::memory_order_release);
+            return;
+        }
+
+        if (2 * (fCount + 1) > fTables.back()->fCapacity) {
+            this->publish(2 * fTables.back()->fCapacity);
+        }
+        Insert(fTables.back().get(), fEntries.make<Entry>(glyph, ready));
+        fCount += 1;
+    }
+
+private:
+    static constexpr int kInitialCapacity = 32;
+
+    struct Table {
+        explicit Table(int capacity)
+                : fCapacity{capacity}
+                , fSlots{new std::atomic<const Entry*>[capacity]} {
+            for (int i = 0; i < capacity; ++i) {
+                fSlots[i].store(nullptr, std::memory_order_relaxed);
+            }
+        }
+
+        const int fCapacity;
+        std::unique_ptr<std::atomic<const Entry*>[]> fSlots;
+    };
+
+    static void Insert(Table* table, const Entry* entry) {
+        int mask = table->fCapacity - 1;
+        int i = entry->fGlyph->getPackedID().hash() & mask;
+        while (table->fSlots[i].load(std::memory_order_relaxed) != nullptr) {
+            i = (i + 1) & mask;
+        }
+        table->fSlots[i].store(entry, std::memory_order_release);
+    }
+
+    void publish(int capacity) {
+        auto table = skstd::make_unique<Table>(capacity);
+        if (!fTables.empty()) {
+            const Table* old = fTables.back().get();
+            for (int i = 0; i < old->fCapacity; ++i) {
+                if (const Entry* entry = old->fSlots[i].load(std::memory_order_relaxed)) {
+                    Insert(table.get(), entry);
+                }
+            }
+        }
+        fTable.store(table.get(), std::memory_order_release);
+        fTables.push_back(std::move(table));
+    }
+
+    std::atomic<const Table*>           fTable{nullptr};
+    std::vector<std::unique_ptr<Table>> fTables;
+    SkArenaAlloc                        fEntries{sizeof(Entry) * kInitialCapacity};
+    int                                 fCount{0};
+};
 
 class SkStrikeCache::Node final : public SkStrikeInterface {
 public:
@@ -23,17 +138,38 @@ public:
          const SkDescriptor& desc,
          std::unique_ptr<SkScalerContext> scaler,
          const SkFontMetrics& metrics,
-         std::unique_ptr<SkStrikePinner> pinner)
+         std::unique_ptr<SkStrikePinner> pinner,
+         bool shared = false)
             : fStrikeCache{strikeCache}
             , fStrike{desc, std::move(scaler), metrics}
-            , fPinner{std::move(pinner)} {}
+            , fPinner{std::move(pinner)}
+            , fSharedGlyphs{shared ? new SharedGlyphs : nullptr}
+            , fSharedMemoryUsed{fStrike.getMemoryUsed()} {}
 
     SkVector rounding() const override {
         return fStrike.rounding();
     }
 
     const SkGlyph& getGlyphMetrics(SkGlyphID glyphID, SkPoint position) override {
-        return fStrike.getGlyphMetrics(glyphID, position);
+        if (!this->isShared()) {
+            return fStrike.getGlyphMetrics(glyphID, position);
+        }
+
+        SkPackedGlyphID packedID = fStrike.packedGlyphID(glyphID, position);
+        if (const SharedGlyphs::Entry* entry = fSharedGlyphs->find(packedID)) {
+            return *entry->fGlyph;
+        }
+
+        const SkGlyph* glyph;
+        size_t memoryUsed;
+        {
+            SkAutoMutexExclusive lock{fSharedMutex};
+            glyph = &fStrike.getGlyphIDMetrics(packedID);
+            fSharedGlyphs->add(glyph, 0);
+            memoryUsed = fStrike.getMemoryUsed();
+        }
+        fStrikeCache->sharedStrikeGrew(this, memoryUsed);
+        return *glyph;
     }
 
     SkSpan<const SkGlyphPos> prepareForDrawing(const SkGlyphID glyphIDs[],
@@ -42,29 +178,234 @@ public:
                                                int maxDimension,
                                                PreparationDetail detail,
                                                SkGlyphPos results[]) override {
-        return fStrike.prepareForDrawing(
-                glyphIDs, positions, n, maxDimension, detail, results);
+        if (!this->isShared()) {
+            return fStrike.prepareForDrawing(
+                    glyphIDs, positions, n, maxDimension, detail, results);
+        }
+
+        // Try to find every glyph ready to go without locking.
+        size_t drawableGlyphCount = 0;
+        bool allReady = true;
+        for (size_t i = 0; i < n && allReady; i++) {
+            SkPoint position = positions[i];
+            if (SkScalarsAreFinite(position.x(), position.y())) {
+                const SharedGlyphs::Entry* entry =
+                        fSharedGlyphs->find(fStrike.packedGlyphID(glyphIDs[i], position));
+                allReady = entry != nullptr
+                        && entry->isReady(SharedGlyphs::Need(*entry->fGlyph, maxDimension, detail));
+                if (allReady && !entry->fGlyph->isEmpty()) {
+                    results[drawableGlyphCount++] = {i, entry->fGlyph, position};
+                }
+            }
+        }
+        if (allReady) {
+            return SkSpan<const SkGlyphPos>{results, drawableGlyphCount};
+        }
+
+        // Something is missing, so prepare the whole run as SkStrike would, under the lock.
+        drawableGlyphCount = 0;
+        size_t memoryUsed;
+        {
+            SkAutoMutexExclusive lock{fSharedMutex};
+            for (size_t i = 0; i < n; i++) {
+                SkPoint position = positions[i];
+                if (SkScalarsAreFinite(position.x(), position.y())) {
+                    const SkGlyph& glyph = fStrike.getGlyphMetrics(glyphIDs[i], position);
+                    uint8_t need = SharedGlyphs::Need(glyph, maxDimension, detail);
+                    if (need & SharedGlyphs::kImage) {
+                        fStrike.findImage(glyph);
+                    }
+                    if (need & SharedGlyphs::kPath) {
+                        fStrike.findPath(glyph);
+                    }
+                    fSharedGlyphs->add(&glyph, need);
+                    if (!glyph.isEmpty()) {
+                        results[drawableGlyphCount++] = {i, &glyph, position};
+                    }
+                }
+            }
+            memoryUsed = fStrike.getMemoryUsed();
+        }
+        fStrikeCache->sharedStrikeGrew(this, memoryUsed);
+
+        return SkSpan<const SkGlyphPos>{results, drawableGlyphCount};
     }
 
     void generatePath(const SkGlyph& glyph) override {
-        fStrike.generatePath(glyph);
+        if (!this->isShared()) {
+            fStrike.generatePath(glyph);
+            return;
+        }
+
+        const SharedGlyphs::Entry* entry = fSharedGlyphs->find(glyph.getPackedID());
+        if (entry != nullptr && entry->isReady(SharedGlyphs::kPath)) {
+            return;
+        }
+        size_t memoryUsed;
+        {
+            SkAutoMutexExclusive lock{fSharedMutex};
+            fStrike.generatePath(glyph);
+            fSharedGlyphs->add(&glyph, SharedGlyphs::kPath);
+            memoryUsed = fStrike.getMemoryUsed();
+        }
+        fStrikeCache->sharedStrikeGrew(this, memoryUsed);
     }
 
     const SkDescriptor& getDescriptor() const override {
         return fStrike.getDescriptor();
     }
 
-    void onAboutToExitScope() override {
-        fStrikeCache->attachNode(this);
+    void onAboutToExitScope() override;
+
+    bool isShared() const { return fSharedGlyphs != nullptr; }
+
+    // The bytes this node contributes to fTotalMemoryUsed. Only call while holding fLock.
+    size_t memoryUsed() const {
+        return this->isShared() ? fSharedMemoryUsed : fStrike.getMemoryUsed();
+    }
+
+    void refShared() {
+        SkASSERT(this->isShared());
+        fSharedRefs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void unrefShared() {
+        SkASSERT(this->isShared());
+        if (1 == fSharedRefs.fetch_sub(1, std::memory_order_acq_rel)) {
+            delete this;
+        }
     }
 
+    // Called after the node leaves the list for good. Threads may still be drawing from a shared
+    // node, so it only goes away when they let go of it.
+    void purge() {
+        if (this->isShared()) {
+            fPurged.store(true, std::memory_order_relaxed);
+            this->unrefShared();
+        } else {
+            delete this;
+        }
+    }
+
+    bool isPurged() const { return fPurged.load(std::memory_order_relaxed); }
+
     SkStrikeCache* const            fStrikeCache;
     Node*                           fNext{nullptr};
     Node*                           fPrev{nullptr};
     SkStrike                        fStrike;
     std::unique_ptr<SkStrikePinner> fPinner;
+
+    // Only used by shared nodes. fSharedMutex guards fStrike, and fSharedMemoryUsed is guarded
+    // by fStrikeCache->fLock. The cache's list holds one ref until the node is purged.
+    const std::unique_ptr<SharedGlyphs> fSharedGlyphs;
+    SkMutex                             fSharedMutex;
+    size_t                              fSharedMemoryUsed;
+    std::atomic<int32_t>                fSharedRefs{1};
+    std::atomic<bool>                   fPurged{false};
 };
 
+// The shared strikes a thread drew with most recently. Each slot holds a ref on its node, and
+// counts how many SkScopedStrikes on this thread are using it, so that in-use nodes are never
+// evicted.
+class SkStrikeCache::SharedStrikeSlots {
+public:
+    static SharedStrikeSlots* Get() {
+        return static_cast<SharedStrikeSlots*>(SkTLS::Get(Create, Delete));
+    }
+
+    static SharedStrikeSlots* Find() {
+        return static_cast<SharedStrikeSlots*>(SkTLS::Find(Create));
+    }
+
+    Node* find(const SkStrikeCache* strikeCache, const SkDescriptor& desc) {
+        for (Slot& slot : fSlots) {
+            if (slot.fNode == nullptr) {
+                continue;
+            }
+            if (slot.fNode->isPurged()) {
+                if (slot.fInUse == 0) {
+                    slot.fNode->unrefShared();
+                    slot.fNode = nullptr;
+                }
+                continue;
+            }
+            if (slot.fNode->fStrikeCache == strikeCache && slot.fNode->getDescriptor() == desc) {
+                slot.fInUse += 1;
+                return slot.fNode;
+            }
+        }
+        return nullptr;
+    }
+
+    bool hasFreeSlot() const {
+        for (const Slot& slot : fSlots) {
+            if (slot.fInUse == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Takes over a ref on node, and marks it in use. There must be a free slot.
+    void add(Node* node) {
+        for (int i = 0; i < kSlotCount; ++i) {
+            Slot& slot = fSlots[(fNextVictim + i) % kSlotCount];
+            if (slot.fInUse == 0) {
+                if (slot.fNode != nullptr) {
+                    slot.fNode->unrefShared();
+                }
+                slot.fNode = node;
+                slot.fInUse = 1;
+                fNextVictim = (fNextVictim + i + 1) % kSlotCount;
+                return;
+            }
+        }
+        SK_ABORT("No free shared strike slot.");
+    }
+
+    void release(Node* node) {
+        for (Slot& slot : fSlots) {
+            if (slot.fNode == node && slot.fInUse > 0) {
+                slot.fInUse -= 1;
+                return;
+            }
+        }
+        SkDEBUGFAIL("Releasing a shared strike this thread is not using.");
+    }
+
+private:
+    static constexpr int kSlotCount = 8;
+
+    struct Slot {
+        Node* fNode{nullptr};
+        int   fInUse{0};
+    };
+
+    static void* Create() { return new SharedStrikeSlots; }
+
+    static void Delete(void* ptr) {
+        auto slots = static_cast<SharedStrikeSlots*>(ptr);
+        for (Slot& slot : slots->fSlots) {
+            SkASSERT(slot.fInUse == 0);
+            if (slot.fNode != nullptr) {
+                slot.fNode->unrefShared();
+            }
+        }
+        delete slots;
+    }
+
+    Slot fSlots[kSlotCount];
+    int  fNextVictim{0};
+};
+
+void SkStrikeCache::Node::onAboutToExitScope() {
+    if (this->isShared()) {
+        SharedStrikeSlots::Find()->release(this);
+    } else {
+        fStrikeCache->attachNode(this);
+    }
+}
+
 SkStrikeCache* SkStrikeCache::GlobalStrikeCache() {
     static auto* cache = new SkStrikeCache;
     return cache;
@@ -130,7 +471,7 @@ SkStrikeCache::~SkStrikeCache() {
     Node* node = fHead;
     while (node) {
         Node* next = node->fNext;
-        delete node;
+        node->purge();
         node = next;
     }
 }
@@ -182,6 +523,12 @@ auto SkStrikeCache::findOrCreateStrike(const SkDescriptor& desc,
 SkScopedStrike SkStrikeCache::findOrCreateScopedStrike(const SkDescriptor& desc,
                                                        const SkScalerContextEffects& effects,
                                                        const SkTypeface& typeface) {
+    if (fSharedStrikes.load(std::memory_order_relaxed)) {
+        if (Node* node = this->findOrCreateSharedStrike(desc, effects, typeface)) {
+            return SkScopedStrike{node};
+        }
+    }
+
     Node* node = this->findAndDetachStrike(desc);
     if (node == nullptr) {
         auto scaler = CreateScalerContext(desc, effects, typeface);
@@ -190,6 +537,96 @@ SkScopedStrike SkStrikeCache::findOrCreateScopedStrike(const SkDescriptor& desc,
     return SkScopedStrike{node};
 }
 
+bool SkStrikeCache::setSharedStrikes(bool shared) {
+    return fSharedStrikes.exchange(shared);
+}
+
+bool SkStrikeCache::setDiscardableImages(bool discardable) {
+    return fDiscardableImages.exchange(discardable);
+}
+
+auto SkStrikeCache::findOrCreateSharedStrike(const SkDescriptor& desc,
+                                             const SkScalerContextEffects& effects,
+                                             const SkTypeface& typeface) -> Node* {
+    SharedStrikeSlots* slots = SharedStrikeSlots::Get();
+    if (Node* node = slots->find(this, desc)) {
+        SkPerfCounters::Add(SkGraphics::PerfCounter::kStrikeCacheHits);
+        return node;
+    }
+
+    // Every slot is in use by nested draws on this thread; fall back to an exclusive strike.
+    if (!slots->hasFreeSlot()) {
+        return nullptr;
+    }
+
+    Node* node = this->findSharedStrike(desc);
+    SkPerfCounters::Add(node ? SkGraphics::PerfCounter::kStrikeCacheHits
+                             : SkGraphics::PerfCounter::kStrikeCacheMisses);
+    if (node == nullptr) {
+        auto scaler = CreateScalerContext(desc, effects, typeface);
+        SkFontMetrics fontMetrics;
+        scaler->getFontMetrics(&fontMetrics);
+        node = this->attachSharedStrike(
+                new Node{this, desc, std::move(scaler), fontMetrics, nullptr, true});
+    }
+    slots->add(node);
+    return node;
+}
+
+auto SkStrikeCache::findSharedStrike(const SkDescriptor& desc) -> Node* {
+    SkAutoSpinlock ac(fLock);
+
+    for (Node* node = internalGetHead(); node != nullptr; node = node->fNext) {
+        if (node->isShared() && node->fStrike.getDescriptor() == desc) {
+            // Move to the head to keep the list in LRU order.
+            this->internalDetachCache(node);
+            this->internalAttachToHead(node);
+            node->refShared();
+            return node;
+        }
+    }
+
+    return nullptr;
+}
+
+auto SkStrikeCache::attachSharedStrike(Node* created) -> Node* {
+    Node* found = nullptr;
+    {
+        SkAutoSpinlock ac(fLock);
+
+        // Another thread may have created the same strike while we were making the scaler.
+        for (Node* node = internalGetHead(); node != nullptr; node = node->fNext) {
+            if (node->isShared() && node->fStrike.getDescriptor() == created->getDescriptor()) {
+                found = node;
+                found->refShared();
+                break;
+            }
+        }
+
+        if (found == nullptr) {
+            created->refShared();
+            this->internalAttachToHead(created);
+            this->internalPurge();
+            return created;
+        }
+    }
+
+    created->unrefShared();
+    return found;
+}
+
+void SkStrikeCache::sharedStrikeGrew(Node* node, size_t memoryUsed) {
+    SkAutoSpinlock ac(fLock);
+
+    if (node->isPurged() || memoryUsed <= node->fSharedMemoryUsed) {
+        return;
+    }
+
+    fTotalMemoryUsed += memoryUsed - node->fSharedMemoryUsed;
+    node->fSharedMemoryUsed = memoryUsed;
+    this->internalPurge();
+}
+
 SkExclusiveStrikePtr SkStrikeCache::FindOrCreateStrikeExclusive(
         const SkFont& font,
         const SkPaint& paint,
@@ -308,6 +745,9 @@ void SkStrikeCache::attachNode(Node* node) {
     if (node == nullptr) {
         return;
     }
+    // Outside of fLock, since this may take the discardable memory's own lock.
+    node->fStrike.unlockImages();
+
     SkAutoSpinlock ac(fLock);
 
     this->validate();
@@ -322,16 +762,25 @@ SkExclusiveStrikePtr SkStrikeCache::findStrikeExclusive(const SkDescriptor& desc
 }
 
 auto SkStrikeCache::findAndDetachStrike(const SkDescriptor& desc) -> Node* {
-    SkAutoSpinlock ac(fLock);
-
-    for (Node* node = internalGetHead(); node != nullptr; node = node->fNext) {
-        if (node->fStrike.getDescriptor() == desc) {
-            this->internalDetachCache(node);
-            return node;
+    Node* found = nullptr;
+    {
+        SkAutoSpinlock ac(fLock);
+        for (Node* node = internalGetHead(); node != nullptr; node = node->fNext) {
+            if (!node->isShared() && node->fStrike.getDescriptor() == desc) {
+                this->internalDetachCache(node);
+                found = node;
+                break;
+            }
         }
     }
 
-    return nullptr;
+    // The node is detached, so its memory use is accounted for again when it is attached.
+    if (found != nullptr) {
+        found->fStrike.lockImages();
+    }
+    SkPerfCounters::Add(found ? SkGraphics::PerfCounter::kStrikeCacheHits
+                              : SkGraphics::PerfCounter::kStrikeCacheMisses);
+    return found;
 }
 
 
@@ -370,7 +819,9 @@ bool SkStrikeCache::desperationSearchForImage(const SkDescriptor& desc, SkGlyph*
             targetSubY = glyph->getSubYFixed();
 
     for (Node* node = internalGetHead(); node != nullptr; node = node->fNext) {
-        if (loose_compare(node->fStrike.getDescriptor(), desc)) {
+        // The images of discardable strikes can't be read while they are in the list.
+        if (!node->isShared() && !node->fStrike.hasDiscardableImages()
+                && loose_compare(node->fStrike.getDescriptor(), desc)) {
             auto targetGlyphID = SkPackedGlyphID(glyphID, targetSubX, targetSubY);
             if (node->fStrike.isGlyphCached(glyphID, targetSubX, targetSubY)) {
                 SkGlyph* fallback = node->fStrike.getRawGlyphByID(targetGlyphID);
@@ -403,13 +854,13 @@ bool SkStrikeCache::desperationSearchForPath(
     // This will have to search the sub-pixel positions too.
     // There is also a problem with accounting for cache size with shared path data.
     for (Node* node = internalGetHead(); node != nullptr; node = node->fNext) {
-        if (loose_compare(node->fStrike.getDescriptor(), desc)) {
+        if (!node->isShared() && loose_compare(node->fStrike.getDescriptor(), desc)) {
             if (node->fStrike.isGlyphCached(glyphID, 0, 0)) {
                 SkGlyph* from = node->fStrike.getRawGlyphByID(SkPackedGlyphID(glyphID));
                 if (from->fPathData != nullptr) {
                     // We can just copy the path out by value here, so no need to worry
                     // about the lifetime of this desperate-match node.
-                    *path = from->fPathData->fPath;
+                    from->fPathData->copyPath(path);
                     return true;
                 }
             }
@@ -450,7 +901,12 @@ auto SkStrikeCache::createStrike(
         scaler->getFontMetrics(&fontMetrics);
     }
 
-    return new Node{this, desc, std::move(scaler), fontMetrics, std::move(pinner)};
+    Node* node = new Node{this, desc, std::move(scaler), fontMetrics, std::move(pinner)};
+    // Pinned strikes hold images sent from elsewhere, which could not be generated again.
+    if (node->fPinner == nullptr && fDiscardableImages.load(std::memory_order_relaxed)) {
+        node->fStrike.useDiscardableImages();
+    }
+    return node;
 }
 
 void SkStrikeCache::purgeAll() {
@@ -458,6 +914,11 @@ void SkStrikeCache::purgeAll() {
     this->internalPurge(fTotalMemoryUsed);
 }
 
+size_t SkStrikeCache::purgeBytes(size_t bytes) {
+    SkAutoSpinlock ac(fLock);
+    return bytes ? this->internalPurge(bytes) : 0;
+}
+
 size_t SkStrikeCache::getTotalMemoryUsed() const {
     SkAutoSpinlock ac(fLock);
     return fTotalMemoryUsed;
@@ -528,7 +989,12 @@ void SkStrikeCache::forEachStrike(std::function<void(const SkStrike&)> visitor)
     this->validate();
 
     for (Node* node = this->internalGetHead(); node != nullptr; node = node->fNext) {
-        visitor(node->fStrike);
+        if (node->isShared()) {
+            SkAutoMutexExclusive lock{node->fSharedMutex};
+            visitor(node->fStrike);
+        } else {
+            visitor(node->fStrike);
+        }
     }
 }
 
@@ -560,6 +1026,18 @@ size_t SkStrikeCache::internalPurge(size_t minBytesNeeded) {
     size_t  bytesFreed = 0;
     int     countFreed = 0;
 
+    // Glyph paths kept in compact form can be rebuilt from it, so free their SkPaths before
+    // giving up whole strikes. Shared strikes may be in use, so they keep theirs.
+    for (Node* node = this->internalGetTail();
+         node != nullptr && bytesFreed < bytesNeeded;
+         node = node->fPrev) {
+        if (!node->isShared()) {
+            size_t freed = node->fStrike.releasePaths();
+            fTotalMemoryUsed -= freed;
+            bytesFreed += freed;
+        }
+    }
+
     // Start at the tail and proceed backwards deleting; the list is in LRU
     // order, with unimportant entries at the tail.
     Node* node = this->internalGetTail();
@@ -568,10 +1046,10 @@ size_t SkStrikeCache::internalPurge(size_t minBytesNeeded) {
 
         // Only delete if the strike is not pinned.
         if (node->fPinner == nullptr || node->fPinner->canDelete()) {
-            bytesFreed += node->fStrike.getMemoryUsed();
+            bytesFreed += node->memoryUsed();
             countFreed += 1;
             this->internalDetachCache(node);
-            delete node;
+            node->purge();
         }
         node = prev;
     }
@@ -601,13 +1079,13 @@ void SkStrikeCache::internalAttachToHead(Node* node) {
     }
 
     fCacheCount += 1;
-    fTotalMemoryUsed += node->fStrike.getMemoryUsed();
+    fTotalMemoryUsed += node->memoryUsed();
 }
 
 void SkStrikeCache::internalDetachCache(Node* node) {
     SkASSERT(fCacheCount > 0);
     fCacheCount -= 1;
-    fTotalMemoryUsed -= node->fStrike.getMemoryUsed();
+    fTotalMemoryUsed -= node->memoryUsed();
 
     if (node->fPrev) {
         node->fPrev->fNext = node->fNext;
@@ -643,7 +1121,7 @@ void SkStrikeCache::validate() const {
 
     const Node* node = fHead;
     while (node != nullptr) {
-        computedBytes += node->fStrike.getMemoryUsed();
+        computedBytes += node->memoryUsed();
         computedCount += 1;
         node = node->fNext;
     }
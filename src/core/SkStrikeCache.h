@@ -8,6 +8,7 @@
 #ifndef SkStrikeCache_DEFINED
 #define SkStrikeCache_DEFINED
 
+#include <atomic>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -41,6 +42,8 @@ public:
 
 class SkStrikeCache final : public SkStrikeCacheInterface {
     class Node;
+    class SharedGlyphs;
+    class SharedStrikeSlots;
 
 public:
     SkStrikeCache() = default;
@@ -118,6 +121,20 @@ public:
                                             const SkScalerContextEffects& effects,
                                             const SkTypeface& typeface) override;
 
+    // When strikes are shared, findOrCreateScopedStrike() leaves the strike in the cache while it
+    // is in use, so any number of threads can draw from it at once. Glyphs that are already
+    // prepared are looked up without taking a lock; only misses lock the strike. Each thread
+    // keeps references to the few shared strikes it used last, so finding one of those again does
+    // not take fLock either. The exclusive entry points are not affected. Returns the previous
+    // setting.
+    bool setSharedStrikes(bool shared);
+
+    // If true, strikes made from now on keep their glyph images in discardable memory, unlocked
+    // while the strike is in the cache's list, so the system can reclaim them under memory
+    // pressure. Reclaimed images are generated again when next used. Returns the previous
+    // setting.
+    bool setDiscardableImages(bool discardable);
+
     static ExclusiveStrikePtr FindOrCreateStrikeExclusive(
             const SkFont& font,
             const SkPaint& paint,
@@ -153,6 +170,9 @@ public:
     void attachNode(Node* node);
 
     void purgeAll(); // does not change budget
+    // Purges at least 'bytes' from the least recently used strikes, as far as they can be purged,
+    // and returns the number of bytes freed. Does not change budget.
+    size_t purgeBytes(size_t bytes);
 
     int getCacheCountLimit() const;
     int setCacheCountLimit(int limit);
@@ -188,6 +208,14 @@ private:
     // Returns number of bytes freed.
     size_t internalPurge(size_t minBytesNeeded = 0) SK_REQUIRES(fLock);
 
+    Node* findOrCreateSharedStrike(const SkDescriptor& desc,
+                                   const SkScalerContextEffects& effects,
+                                   const SkTypeface& typeface);
+    Node* findSharedStrike(const SkDescriptor& desc);
+    Node* attachSharedStrike(Node* node);
+    // Account for the glyphs a shared strike has added since it was last accounted for.
+    void sharedStrikeGrew(Node* node, size_t memoryUsed);
+
     void forEachStrike(std::function<void(const SkStrike&)> visitor) const;
 
     mutable SkSpinlock fLock;
@@ -198,6 +226,8 @@ private:
     int32_t            fCacheCountLimit{SK_DEFAULT_FONT_CACHE_COUNT_LIMIT};
     int32_t            fCacheCount{0};
     int32_t            fPointSizeLimit{SK_DEFAULT_FONT_CACHE_POINT_SIZE_LIMIT};
+    std::atomic<bool>  fSharedStrikes{false};
+    std::atomic<bool>  fDiscardableImages{false};
 };
 
 using SkExclusiveStrikePtr = SkStrikeCache::ExclusiveStrikePtr;
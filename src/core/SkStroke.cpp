@@ -8,10 +8,12 @@
 #include "src/core/SkStrokerPriv.h"
 
 #include "include/private/SkMacros.h"
+#include "include/private/SkTArray.h"
 #include "include/private/SkTo.h"
 #include "src/core/SkGeometry.h"
 #include "src/core/SkPathPriv.h"
 #include "src/core/SkPointPriv.h"
+#include "src/core/SkTaskGroup.h"
 
 #include <utility>
 
@@ -147,6 +149,13 @@ public:
 
     SkScalar getResScale() const { return fResScale; }
 
+    // Draws butt caps instead at the start or end of each open contour, for ends that lie inside
+    // another stroke and should not show.
+    void hideCaps(bool start, bool end) {
+        fHideStartCap = start;
+        fHideEndCap = end;
+    }
+
     bool isCurrentContourEmpty() const {
         return fInner.isZeroLengthSincePoint(0) &&
                fOuter.isZeroLengthSincePoint(fFirstOuterPtIndexInContour);
@@ -166,6 +175,8 @@ private:
     int         fSegmentCount;
     bool        fPrevIsLine;
     bool        fCanIgnoreCenter;
+    bool        fHideStartCap = false;
+    bool        fHideEndCap = false;
 
     SkStrokerPriv::CapProc  fCapper;
     SkStrokerPriv::JoinProc fJoiner;
@@ -317,14 +328,15 @@ void SkPathStroker::finishContour(bool close, bool currIsLine) {
                 fOuter.close();
             }
         } else {    // add caps to start and end
+            SkStrokerPriv::CapProc buttCapper = SkStrokerPriv::CapFactory(SkPaint::kButt_Cap);
             // cap the end
             fInner.getLastPt(&pt);
-            fCapper(&fOuter, fPrevPt, fPrevNormal, pt,
-                    currIsLine ? &fInner : nullptr);
+            (fHideEndCap ? buttCapper : fCapper)(&fOuter, fPrevPt, fPrevNormal, pt,
+                                                 currIsLine ? &fInner : nullptr);
             fOuter.reversePathTo(fInner);
             // cap the start
-            fCapper(&fOuter, fFirstPt, -fFirstNormal, fFirstOuterPt,
-                    fPrevIsLine ? &fInner : nullptr);
+            (fHideStartCap ? buttCapper : fCapper)(&fOuter, fFirstPt, -fFirstNormal, fFirstOuterPt,
+                                                   fPrevIsLine ? &fInner : nullptr);
             fOuter.close();
         }
         if (!fCusper.isEmpty()) {
@@ -618,16 +630,20 @@ SkPathStroker::ReductionType SkPathStroker::CheckCubicLinear(const SkPoint cubic
     }
     SkScalar tValues[3];
     int count = SkFindCubicMaxCurvature(cubic, tValues);
-    int rCount = 0;
-    // Now loop over the t-values, and reject any that evaluate to either end-point
+    int tCount = 0;
     for (int index = 0; index < count; ++index) {
         SkScalar t = tValues[index];
-        if (0 >= t || t >= 1) {
-            continue;
+        if (0 < t && t < 1) {
+            tValues[tCount++] = t;
         }
-        SkEvalCubicAt(cubic, t, &reduction[rCount], nullptr, nullptr);
-        if (reduction[rCount] != cubic[0] && reduction[rCount] != cubic[3]) {
-            ++rCount;
+    }
+    SkPoint points[3];
+    SkEvalCubicAt(cubic, tValues, tCount, points);
+    int rCount = 0;
+    // Now loop over the points, and reject any that are either end-point
+    for (int index = 0; index < tCount; ++index) {
+        if (points[index] != cubic[0] && points[index] != cubic[3]) {
+            reduction[rCount++] = points[index];
         }
     }
     if (rCount == 0) {
@@ -1376,40 +1392,8 @@ private:
     bool            fSwapWithSrc;
 };
 
-void SkStroke::strokePath(const SkPath& src, SkPath* dst) const {
-    SkASSERT(dst);
-
-    SkScalar radius = SkScalarHalf(fWidth);
-
-    AutoTmpPath tmp(src, &dst);
-
-    if (radius <= 0) {
-        return;
-    }
-
-    // If src is really a rect, call our specialty strokeRect() method
-    {
-        SkRect rect;
-        bool isClosed;
-        SkPath::Direction dir;
-        if (src.isRect(&rect, &isClosed, &dir) && isClosed) {
-            this->strokeRect(rect, dst, dir);
-            // our answer should preserve the inverseness of the src
-            if (src.isInverseFillType()) {
-                SkASSERT(!dst->isInverseFillType());
-                dst->toggleInverseFillType();
-            }
-            return;
-        }
-    }
-
-    // We can always ignore centers for stroke and fill convex line-only paths
-    // TODO: remove the line-only restriction
-    bool ignoreCenter = fDoFill && (src.getSegmentMasks() == SkPath::kLine_SegmentMask) &&
-                        src.isLastContourClosed() && src.isConvex();
-
-    SkPathStroker   stroker(src, radius, fMiterLimit, this->getCap(), this->getJoin(),
-                            fResScale, ignoreCenter);
+static void stroke_contours(const SkPath& src, SkPaint::Cap cap, SkPathStroker* stroker,
+                            SkPath* dst) {
     SkPath::Iter    iter(src, false);
     SkPath::Verb    lastSegment = SkPath::kMove_Verb;
 
@@ -1417,51 +1401,240 @@ void SkStroke::strokePath(const SkPath& src, SkPath* dst) const {
         SkPoint  pts[4];
         switch (iter.next(pts, false)) {
             case SkPath::kMove_Verb:
-                stroker.moveTo(pts[0]);
+                stroker->moveTo(pts[0]);
                 break;
             case SkPath::kLine_Verb:
-                stroker.lineTo(pts[1], &iter);
+                stroker->lineTo(pts[1], &iter);
                 lastSegment = SkPath::kLine_Verb;
                 break;
             case SkPath::kQuad_Verb:
-                stroker.quadTo(pts[1], pts[2]);
+                stroker->quadTo(pts[1], pts[2]);
                 lastSegment = SkPath::kQuad_Verb;
                 break;
             case SkPath::kConic_Verb: {
-                stroker.conicTo(pts[1], pts[2], iter.conicWeight());
+                stroker->conicTo(pts[1], pts[2], iter.conicWeight());
                 lastSegment = SkPath::kConic_Verb;
                 break;
             } break;
             case SkPath::kCubic_Verb:
-                stroker.cubicTo(pts[1], pts[2], pts[3]);
+                stroker->cubicTo(pts[1], pts[2], pts[3]);
                 lastSegment = SkPath::kCubic_Verb;
                 break;
             case SkPath::kClose_Verb:
-                if (SkPaint::kButt_Cap != this->getCap()) {
+                if (SkPaint::kButt_Cap != cap) {
                     /* If the stroke consists of a moveTo followed by a close, treat it
                        as if it were followed by a zero-length line. Lines without length
                        can have square and round end caps. */
-                    if (stroker.hasOnlyMoveTo()) {
-                        stroker.lineTo(stroker.moveToPt());
+                    if (stroker->hasOnlyMoveTo()) {
+                        stroker->lineTo(stroker->moveToPt());
                         goto ZERO_LENGTH;
                     }
                     /* If the stroke consists of a moveTo followed by one or more zero-length
                        verbs, then followed by a close, treat is as if it were followed by a
                        zero-length line. Lines without length can have square & round end caps. */
-                    if (stroker.isCurrentContourEmpty()) {
+                    if (stroker->isCurrentContourEmpty()) {
                 ZERO_LENGTH:
                         lastSegment = SkPath::kLine_Verb;
                         break;
                     }
                 }
-                stroker.close(lastSegment == SkPath::kLine_Verb);
+                stroker->close(lastSegment == SkPath::kLine_Verb);
                 break;
             case SkPath::kDone_Verb:
                 goto DONE;
         }
     }
 DONE:
-    stroker.done(dst, lastSegment == SkPath::kLine_Verb);
+    stroker->done(dst, lastSegment == SkPath::kLine_Verb);
+}
+
+// When stroking on an executor, contours with more segments than this are split into pieces of
+// about this many segments.
+static constexpr int kStrokeChunkSegments = 4096;
+
+namespace {
+
+// The verbs stroked by one task: either whole contours, or a piece of a split contour. Each piece
+// after the first starts with the last segment of the piece before it, so that it draws the join
+// between them; the ends that lie inside a neighbouring piece's stroke get butt caps.
+struct StrokeChunk {
+    SkPath fPath;
+    int    fSegmentCount = 0;
+    bool   fHideStart = false;
+    bool   fHideEnd = false;
+    SkPath fStroke;
+};
+
+struct StrokeSegment {
+    SkPath::Verb fVerb;
+    SkPoint      fPts[4];
+    SkScalar     fWeight;
+};
+
+}  // namespace
+
+static void add_segment(StrokeChunk* chunk, const StrokeSegment& segment) {
+    const SkPoint* pts = segment.fPts;
+    switch (segment.fVerb) {
+        case SkPath::kLine_Verb:
+            chunk->fPath.lineTo(pts[1]);
+            break;
+        case SkPath::kQuad_Verb:
+            chunk->fPath.quadTo(pts[1], pts[2]);
+            break;
+        case SkPath::kConic_Verb:
+            chunk->fPath.conicTo(pts[1], pts[2], segment.fWeight);
+            break;
+        case SkPath::kCubic_Verb:
+            chunk->fPath.cubicTo(pts[1], pts[2], pts[3]);
+            break;
+        default:
+            SkASSERT(false);
+    }
+    chunk->fSegmentCount += 1;
+}
+
+// A segment that the stroker may skip, and so can't carry a join across a split.
+static bool is_degenerate(const StrokeSegment& segment) {
+    int count = SkPathPriv::PtsInIter(segment.fVerb);
+    for (int index = 1; index < count; ++index) {
+        if (!SkPointPriv::EqualsWithinTolerance(segment.fPts[0], segment.fPts[index])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SkStroke::strokeChunks(const SkPath& src, SkScalar radius, SkPath* dst) const {
+    SkTDArray<int> segmentCounts;
+    bool needsSplit = false;
+    SkPath::Iter iter(src, false);
+    SkPoint pts[4];
+    SkPath::Verb verb;
+    while ((verb = iter.next(pts, false)) != SkPath::kDone_Verb) {
+        if (SkPath::kMove_Verb == verb) {
+            *segmentCounts.append() = 0;
+        } else if (SkPath::kClose_Verb != verb) {
+            SkASSERT(!segmentCounts.isEmpty());
+            needsSplit |= ++segmentCounts.top() > kStrokeChunkSegments;
+        }
+    }
+    if (!needsSplit) {
+        return false;
+    }
+
+    SkTArray<StrokeChunk> chunks;
+    int contour = -1;
+    bool splitting = false;
+    int firstChunk = 0;
+    // The current contour's first and latest segments that the stroker won't skip.
+    StrokeSegment first, last;
+    bool hasSegment = false;
+    iter.setPath(src, false);
+    while ((verb = iter.next(pts, false)) != SkPath::kDone_Verb) {
+        switch (verb) {
+            case SkPath::kMove_Verb: {
+                splitting = segmentCounts[++contour] > kStrokeChunkSegments;
+                const StrokeChunk* prev = chunks.empty() ? nullptr : &chunks.back();
+                if (splitting || !prev || prev->fHideStart || prev->fHideEnd ||
+                        prev->fSegmentCount >= kStrokeChunkSegments) {
+                    chunks.push_back();
+                }
+                firstChunk = chunks.count() - 1;
+                hasSegment = false;
+                chunks.back().fPath.moveTo(pts[0]);
+                break;
+            }
+            case SkPath::kClose_Verb:
+                if (!splitting) {
+                    chunks.back().fPath.close();
+                } else if (hasSegment) {
+                    // The last piece goes on around the first segment, to draw the join that
+                    // closing would have.
+                    add_segment(&chunks.back(), first);
+                    chunks.back().fHideEnd = true;
+                    chunks[firstChunk].fHideStart = true;
+                }
+                break;
+            default: {
+                StrokeSegment segment = { verb, { pts[0], pts[1], pts[2], pts[3] },
+                                          SkPath::kConic_Verb == verb ? iter.conicWeight() : 1 };
+                if (splitting && hasSegment &&
+                        chunks.back().fSegmentCount >= kStrokeChunkSegments) {
+                    chunks.back().fHideEnd = true;
+                    StrokeChunk& piece = chunks.push_back();
+                    piece.fHideStart = true;
+                    piece.fPath.moveTo(last.fPts[0]);
+                    add_segment(&piece, last);
+                }
+                add_segment(&chunks.back(), segment);
+                if (!is_degenerate(segment)) {
+                    if (!hasSegment) {
+                        first = segment;
+                    }
+                    last = segment;
+                    hasSegment = true;
+                }
+                break;
+            }
+        }
+    }
+
+    SkTaskGroup(*fExecutor).batch(chunks.count(), [&](int index) {
+        StrokeChunk& chunk = chunks[index];
+        SkPathStroker stroker(chunk.fPath, radius, fMiterLimit, this->getCap(), this->getJoin(),
+                              fResScale, false);
+        stroker.hideCaps(chunk.fHideStart, chunk.fHideEnd);
+        stroke_contours(chunk.fPath, this->getCap(), &stroker, &chunk.fStroke);
+    });
+    int pointCount = 0;
+    for (const StrokeChunk& chunk : chunks) {
+        pointCount += chunk.fStroke.countPoints();
+    }
+    dst->incReserve(pointCount);
+    for (const StrokeChunk& chunk : chunks) {
+        dst->addPath(chunk.fStroke);
+    }
+    return true;
+}
+
+void SkStroke::strokePath(const SkPath& src, SkPath* dst) const {
+    SkASSERT(dst);
+
+    SkScalar radius = SkScalarHalf(fWidth);
+
+    AutoTmpPath tmp(src, &dst);
+
+    if (radius <= 0) {
+        return;
+    }
+
+    // If src is really a rect, call our specialty strokeRect() method
+    {
+        SkRect rect;
+        bool isClosed;
+        SkPath::Direction dir;
+        if (src.isRect(&rect, &isClosed, &dir) && isClosed) {
+            this->strokeRect(rect, dst, dir);
+            // our answer should preserve the inverseness of the src
+            if (src.isInverseFillType()) {
+                SkASSERT(!dst->isInverseFillType());
+                dst->toggleInverseFillType();
+            }
+            return;
+        }
+    }
+
+    // We can always ignore centers for stroke and fill convex line-only paths
+    // TODO: remove the line-only restriction
+    bool ignoreCenter = fDoFill && (src.getSegmentMasks() == SkPath::kLine_SegmentMask) &&
+                        src.isLastContourClosed() && src.isConvex();
+
+    if (!fExecutor || ignoreCenter || !this->strokeChunks(src, radius, dst)) {
+        SkPathStroker stroker(src, radius, fMiterLimit, this->getCap(), this->getJoin(),
+                              fResScale, ignoreCenter);
+        stroke_contours(src, this->getCap(), &stroker, dst);
+    }
 
     if (fDoFill && !ignoreCenter) {
         if (SkPathPriv::CheapIsFirstDirection(src, SkPathPriv::kCCW_FirstDirection)) {
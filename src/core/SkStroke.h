@@ -14,6 +14,8 @@
 #include "include/private/SkTo.h"
 #include "src/core/SkStrokerPriv.h"
 
+class SkExecutor;
+
 #ifdef SK_DEBUG
 extern bool gDebugStrokerErrorSet;
 extern SkScalar gDebugStrokerError;
@@ -65,6 +67,13 @@ public:
                        SkPath::Direction = SkPath::kCW_Direction) const;
     void    strokePath(const SkPath& path, SkPath*) const;
 
+    /**
+     *  If an executor is set, strokePath() splits contours of many segments into overlapping
+     *  pieces and strokes them as tasks on it. The result matches stroking them whole except where
+     *  the pieces meet. The executor must outlive any calls to strokePath().
+     */
+    void setExecutor(SkExecutor* executor) { fExecutor = executor; }
+
     ////////////////////////////////////////////////////////////////
 
 private:
@@ -72,6 +81,9 @@ private:
     SkScalar    fResScale;
     uint8_t     fCap, fJoin;
     bool        fDoFill;
+    SkExecutor* fExecutor = nullptr;
+
+    bool strokeChunks(const SkPath& src, SkScalar radius, SkPath* dst) const;
 
     friend class SkPaint;
 };
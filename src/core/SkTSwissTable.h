@@ -0,0 +1,376 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkTSwissTable_DEFINED
+#define SkTSwissTable_DEFINED
+
+#include "include/core/SkTypes.h"
+#include "include/private/SkChecksum.h"
+#include "include/private/SkTemplates.h"
+
+#include <cstring>
+#include <new>
+
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+    #include <emmintrin.h>
+#elif defined(SK_ARM_HAS_NEON)
+    #include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+// SkTSwissTable and SkTSwissMap are drop-in replacements for SkTHashTable and SkTHashMap, with the
+// same API and the same rules about entries and the pointers to them.
+//
+// Instead of storing each entry's hash next to it, they keep one control byte per slot, either
+// empty, deleted, or the 7 low bits of the hash of the slot's entry. Lookups compare a whole group
+// of control bytes at once (with SSE2 or NEON when available), so keys are only compared for the
+// slots that are likely matches, and the slots themselves only hold the entries.
+
+// One group of control bytes, loaded from anywhere in the control bytes of a table.
+class SkSwissGroup {
+public:
+    static constexpr int8_t kEmpty   = -128;  // 0b10000000
+    static constexpr int8_t kDeleted = -2;    // 0b11111110
+    // Full slots hold the 7 low bits of their hash, so they're the non-negative control bytes.
+
+    // Masks have one bit (SSE2) or byte (otherwise) per control byte, set for the matching ones.
+    using Mask = uint64_t;
+
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+    static constexpr int kWidth = 16;
+    static constexpr int kShift = 0;
+
+    explicit SkSwissGroup(const int8_t* ctrl)
+        : fCtrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) {}
+
+    Mask match(int8_t h2) const {
+        return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), fCtrl));
+    }
+    Mask matchEmpty() const { return this->match(kEmpty); }
+    Mask matchEmptyOrDeleted() const { return (uint32_t)_mm_movemask_epi8(fCtrl); }
+
+private:
+    __m128i fCtrl;
+#elif defined(SK_ARM_HAS_NEON)
+    static constexpr int kWidth = 8;
+    static constexpr int kShift = 3;
+
+    explicit SkSwissGroup(const int8_t* ctrl) : fCtrl(vld1_s8(ctrl)) {}
+
+    Mask match(int8_t h2) const {
+        return vget_lane_u64(vreinterpret_u64_u8(vceq_s8(vdup_n_s8(h2), fCtrl)), 0) & kMsbs;
+    }
+    Mask matchEmpty() const { return this->match(kEmpty); }
+    Mask matchEmptyOrDeleted() const {
+        return vget_lane_u64(vreinterpret_u64_u8(vclt_s8(fCtrl, vdup_n_s8(0))), 0) & kMsbs;
+    }
+
+private:
+    static constexpr uint64_t kMsbs = 0x8080808080808080ULL;
+
+    int8x8_t fCtrl;
+#else
+    static constexpr int kWidth = 8;
+    static constexpr int kShift = 3;
+
+    explicit SkSwissGroup(const int8_t* ctrl) { memcpy(&fCtrl, ctrl, sizeof(fCtrl)); }
+
+    // This may also match a full byte next to a matching one, which only costs a key comparison.
+    Mask match(int8_t h2) const {
+        uint64_t x = fCtrl ^ (kLsbs * (uint8_t)h2);
+        return (x - kLsbs) & ~x & kMsbs;
+    }
+    // Empty is the only control byte with its high bit set and its second lowest bit clear.
+    Mask matchEmpty() const { return fCtrl & (~fCtrl << 6) & kMsbs; }
+    Mask matchEmptyOrDeleted() const { return fCtrl & kMsbs; }
+
+private:
+    static constexpr uint64_t kLsbs = 0x0101010101010101ULL;
+    static constexpr uint64_t kMsbs = 0x8080808080808080ULL;
+
+    uint64_t fCtrl;  // Little endian, like the CPUs we build for.
+#endif
+
+public:
+    // Returns the index in the group of the lowest match in a non-empty mask.
+    static int LowestMatch(Mask mask) {
+        SkASSERT(mask);
+#if defined(_MSC_VER)
+        unsigned long index;
+        if (!_BitScanForward(&index, (uint32_t)mask)) {
+            _BitScanForward(&index, (uint32_t)(mask >> 32));
+            index += 32;
+        }
+        return (int)index >> kShift;
+#else
+        return __builtin_ctzll(mask) >> kShift;
+#endif
+    }
+};
+
+// T and K are treated as ordinary copyable C++ types, with the same Traits as SkTHashTable:
+//   - static K GetKey(T)
+//   - static uint32_t Hash(K)
+template <typename T, typename K, typename Traits = T>
+class SkTSwissTable {
+public:
+    SkTSwissTable() : fCount(0), fDeleted(0), fCapacity(0) {}
+    SkTSwissTable(SkTSwissTable&& other)
+        : fCount(other.fCount)
+        , fDeleted(other.fDeleted)
+        , fCapacity(other.fCapacity)
+        , fCtrl(std::move(other.fCtrl))
+        , fSlots(std::move(other.fSlots)) { other.fCount = other.fDeleted = other.fCapacity = 0; }
+
+    SkTSwissTable& operator=(SkTSwissTable&& other) {
+        if (this != &other) {
+            this->~SkTSwissTable();
+            new (this) SkTSwissTable(std::move(other));
+        }
+        return *this;
+    }
+
+    // Clear the table.
+    void reset() { *this = SkTSwissTable(); }
+
+    // How many entries are in the table?
+    int count() const { return fCount; }
+
+    // Approximately how many bytes of memory do we use beyond sizeof(*this)?
+    size_t approxBytesUsed() const {
+        return fCapacity ? fCapacity * sizeof(T) + fCapacity + SkSwissGroup::kWidth : 0;
+    }
+
+    // The pointers returned by set() and find() are valid only until the next call to set().
+    // The pointers you receive in foreach() are only valid for its duration.
+    // As with SkTHashTable, do not change an entry so that it no longer has the same key.
+
+    // Copy val into the hash table, returning a pointer to the copy now in the table.
+    // If there already is an entry in the table with the same key, we overwrite it.
+    T* set(T val) {
+        uint32_t hash = Traits::Hash(Traits::GetKey(val));
+        if (T* existing = this->find(Traits::GetKey(val), hash)) {
+            *existing = std::move(val);
+            return existing;
+        }
+        // Keep at least one in eight slots empty, so every probe sequence ends.
+        if (8 * (fCount + fDeleted + 1) > 7 * fCapacity) {
+            // Rehashing in place is enough if most of the used slots are deleted ones.
+            this->resize(16 * (fCount + 1) > 7 * fCapacity ? SkTMax(2 * fCapacity,
+                                                                     (int)SkSwissGroup::kWidth)
+                                                           : fCapacity);
+        }
+        return this->uncheckedSet(std::move(val), hash);
+    }
+
+    // If there is an entry in the table with this key, return a pointer to it.  If not, null.
+    T* find(const K& key) const { return this->find(key, Traits::Hash(key)); }
+
+    // If there is an entry in the table with this key, return it.  If not, null.
+    // This only works for pointer type T, and cannot be used to find an nullptr entry.
+    T findOrNull(const K& key) const {
+        if (T* p = this->find(key)) {
+            return *p;
+        }
+        return nullptr;
+    }
+
+    // Remove the value with this key from the hash table.
+    void remove(const K& key) {
+        T* p = this->find(key);
+        SkASSERT(p);
+        int index = (int)(p - fSlots.get());
+        // Later entries may have probed past this slot, so it can't be marked empty. Deleted
+        // slots are reused by set() and dropped when the table is rehashed.
+        this->setCtrl(index, SkSwissGroup::kDeleted);
+        *p = T();
+        fCount--;
+        fDeleted++;
+    }
+
+    // Call fn on every entry in the table.  You may mutate the entries, but be very careful.
+    template <typename Fn>  // f(T*)
+    void foreach(Fn&& fn) {
+        for (int i = 0; i < fCapacity; i++) {
+            if (fCtrl[i] >= 0) {
+                fn(&fSlots[i]);
+            }
+        }
+    }
+
+    // Call fn on every entry in the table.  You may not mutate anything.
+    template <typename Fn>  // f(T) or f(const T&)
+    void foreach(Fn&& fn) const {
+        for (int i = 0; i < fCapacity; i++) {
+            if (fCtrl[i] >= 0) {
+                fn(fSlots[i]);
+            }
+        }
+    }
+
+private:
+    // The hash picks the first group probed with its high bits, and is matched against the
+    // control bytes with its 7 low bits.
+    static int H1(uint32_t hash) { return (int)(hash >> 7); }
+    static int8_t H2(uint32_t hash) { return (int8_t)(hash & 0x7f); }
+
+    // Groups are probed quadratically, at triangular number multiples of the group width past the
+    // first one. With a power of two capacity that visits every slot.
+    T* find(const K& key, uint32_t hash) const {
+        if (!fCapacity) {
+            return nullptr;
+        }
+        const int mask = fCapacity - 1;
+        const int8_t h2 = H2(hash);
+        int groupIndex = H1(hash) & mask;
+        for (int step = SkSwissGroup::kWidth; ; step += SkSwissGroup::kWidth) {
+            SkSwissGroup group(fCtrl.get() + groupIndex);
+            for (SkSwissGroup::Mask m = group.match(h2); m; m &= m - 1) {
+                int index = (groupIndex + SkSwissGroup::LowestMatch(m)) & mask;
+                if (key == Traits::GetKey(fSlots[index])) {
+                    return &fSlots[index];
+                }
+            }
+            if (group.matchEmpty()) {
+                return nullptr;
+            }
+            SkASSERT(step < fCapacity);
+            groupIndex = (groupIndex + step) & mask;
+        }
+    }
+
+    // Adds val, which must not be in the table yet, to an empty or deleted slot.
+    T* uncheckedSet(T&& val, uint32_t hash) {
+        const int mask = fCapacity - 1;
+        int groupIndex = H1(hash) & mask;
+        SkSwissGroup::Mask m = SkSwissGroup(fCtrl.get() + groupIndex).matchEmptyOrDeleted();
+        for (int step = SkSwissGroup::kWidth; !m; step += SkSwissGroup::kWidth) {
+            SkASSERT(step < fCapacity);
+            groupIndex = (groupIndex + step) & mask;
+            m = SkSwissGroup(fCtrl.get() + groupIndex).matchEmptyOrDeleted();
+        }
+        int index = (groupIndex + SkSwissGroup::LowestMatch(m)) & mask;
+        if (fCtrl[index] == SkSwissGroup::kDeleted) {
+            fDeleted--;
+        }
+        this->setCtrl(index, H2(hash));
+        fSlots[index] = std::move(val);
+        fCount++;
+        return &fSlots[index];
+    }
+
+    // The control bytes of the first group are repeated past the end, so a group can be loaded
+    // from any slot.
+    void setCtrl(int index, int8_t ctrl) {
+        fCtrl[index] = ctrl;
+        if (index < SkSwissGroup::kWidth) {
+            fCtrl[fCapacity + index] = ctrl;
+        }
+    }
+
+    void resize(int capacity) {
+        SkASSERT(SkIsPow2(capacity) && capacity >= SkSwissGroup::kWidth);
+        int oldCapacity = fCapacity;
+        SkDEBUGCODE(int oldCount = fCount);
+
+        SkAutoTMalloc<int8_t> oldCtrl = std::move(fCtrl);
+        SkAutoTArray<T> oldSlots = std::move(fSlots);
+        fCount = fDeleted = 0;
+        fCapacity = capacity;
+        fCtrl.reset(capacity + SkSwissGroup::kWidth);
+        memset(fCtrl.get(), SkSwissGroup::kEmpty, capacity + SkSwissGroup::kWidth);
+        fSlots = SkAutoTArray<T>(capacity);
+
+        for (int i = 0; i < oldCapacity; i++) {
+            if (oldCtrl[i] >= 0) {
+                T& val = oldSlots[i];
+                uint32_t hash = Traits::Hash(Traits::GetKey(val));
+                this->uncheckedSet(std::move(val), hash);
+            }
+        }
+        SkASSERT(fCount == oldCount);
+    }
+
+    int fCount, fDeleted, fCapacity;
+    SkAutoTMalloc<int8_t> fCtrl;
+    SkAutoTArray<T> fSlots;
+
+    SkTSwissTable(const SkTSwissTable&) = delete;
+    SkTSwissTable& operator=(const SkTSwissTable&) = delete;
+};
+
+// Maps K->V, with the same API as SkTHashMap.
+template <typename K, typename V, typename HashK = SkGoodHash>
+class SkTSwissMap {
+public:
+    SkTSwissMap() {}
+    SkTSwissMap(SkTSwissMap&&) = default;
+    SkTSwissMap& operator=(SkTSwissMap&&) = default;
+
+    // Clear the map.
+    void reset() { fTable.reset(); }
+
+    // How many key/value pairs are in the table?
+    int count() const { return fTable.count(); }
+
+    // Approximately how many bytes of memory do we use beyond sizeof(*this)?
+    size_t approxBytesUsed() const { return fTable.approxBytesUsed(); }
+
+    // N.B. The pointers returned by set() and find() are valid only until the next call to set().
+
+    // Set key to val in the table, replacing any previous value with the same key.
+    // We copy both key and val, and return a pointer to the value copy now in the table.
+    V* set(K key, V val) {
+        Pair* out = fTable.set({std::move(key), std::move(val)});
+        return &out->val;
+    }
+
+    // If there is key/value entry in the table with this key, return a pointer to the value.
+    // If not, return null.
+    V* find(const K& key) const {
+        if (Pair* p = fTable.find(key)) {
+            return &p->val;
+        }
+        return nullptr;
+    }
+
+    // Remove the key/value entry in the table with this key.
+    void remove(const K& key) {
+        SkASSERT(this->find(key));
+        fTable.remove(key);
+    }
+
+    // Call fn on every key/value pair in the table.  You may mutate the value but not the key.
+    template <typename Fn>  // f(K, V*) or f(const K&, V*)
+    void foreach(Fn&& fn) {
+        fTable.foreach([&fn](Pair* p){ fn(p->key, &p->val); });
+    }
+
+    // Call fn on every key/value pair in the table.  You may not mutate anything.
+    template <typename Fn>  // f(K, V), f(const K&, V), f(K, const V&) or f(const K&, const V&).
+    void foreach(Fn&& fn) const {
+        fTable.foreach([&fn](const Pair& p){ fn(p.key, p.val); });
+    }
+
+private:
+    struct Pair {
+        K key;
+        V val;
+        static const K& GetKey(const Pair& p) { return p.key; }
+        static uint32_t Hash(const K& key) { return HashK()(key); }
+    };
+
+    SkTSwissTable<Pair, K> fTable;
+
+    SkTSwissMap(const SkTSwissMap&) = delete;
+    SkTSwissMap& operator=(const SkTSwissMap&) = delete;
+};
+
+#endif//SkTSwissTable_DEFINED
@@ -8,23 +8,72 @@
 #include "include/core/SkExecutor.h"
 #include "src/core/SkTaskGroup.h"
 
+#include <memory>
+#include <thread>
+
 SkTaskGroup::SkTaskGroup(SkExecutor& executor) : fPending(0), fExecutor(executor) {}
 
-void SkTaskGroup::add(std::function<void(void)> fn) {
+void SkTaskGroup::add(std::function<void(void)> fn, SkExecutor::Priority priority) {
     fPending.fetch_add(+1, std::memory_order_relaxed);
     fExecutor.add([=] {
         fn();
         fPending.fetch_add(-1, std::memory_order_release);
-    });
+    }, priority);
 }
 
 void SkTaskGroup::batch(int N, std::function<void(int)> fn) {
-    // TODO: I really thought we had some sort of more clever chunking logic.
-    fPending.fetch_add(+N, std::memory_order_relaxed);
-    for (int i = 0; i < N; i++) {
-        fExecutor.add([=] {
+    if (N <= 0) {
+        return;
+    }
+    // A few chunks per task, so the ones that run slowly don't hold the rest back for long.
+    int grain = SkTMax(1, N / (4 * MaxConcurrency(N, 1)));
+    this->addChunks(N, grain, [fn](int start, int end) {
+        for (int i = start; i < end; i++) {
             fn(i);
-            fPending.fetch_add(-1, std::memory_order_release);
+        }
+    });
+}
+
+void SkTaskGroup::parallelFor(int N, std::function<void(int, int)> fn, int grain) {
+    if (N <= 0) {
+        return;
+    }
+    this->addChunks(N, GrainSize(N, grain), std::move(fn));
+}
+
+int SkTaskGroup::MaxConcurrency(int N, int grain) {
+    int chunks = (N + grain - 1) / grain;
+    return SkTMin(chunks, (int)SkTMax(std::thread::hardware_concurrency(), 1u));
+}
+
+void SkTaskGroup::addChunks(int N, int grain, std::function<void(int, int)> fn) {
+    SkASSERT(N > 0 && grain > 0);
+    // Rather than adding a task per chunk, add a task per thread that might run them, each
+    // claiming chunks until there are none left.  Threads that get to the work late or finish
+    // their chunks early steal the rest from the others.
+    struct Chunks {
+        std::atomic<int>              fNext{0};
+        int                           fN;
+        int                           fGrain;
+        std::function<void(int, int)> fFn;
+    };
+    auto chunks = std::make_shared<Chunks>();
+    chunks->fN = N;
+    chunks->fGrain = grain;
+    chunks->fFn = std::move(fn);
+
+    fPending.fetch_add(+N, std::memory_order_relaxed);
+    for (int t = MaxConcurrency(N, grain); t > 0; t--) {
+        // Once all the chunks are claimed a task touches nothing but the chunks, so the tasks
+        // that run after this group is done are harmless.
+        fExecutor.add([this, chunks] {
+            int start;
+            while ((start = chunks->fNext.fetch_add(chunks->fGrain, std::memory_order_relaxed))
+                    < chunks->fN) {
+                int end = SkTMin(start + chunks->fGrain, chunks->fN);
+                chunks->fFn(start, end);
+                fPending.fetch_add(start - end, std::memory_order_release);
+            }
         });
     }
 }
@@ -13,6 +13,7 @@
 #include "include/private/SkNoncopyable.h"
 #include <atomic>
 #include <functional>
+#include <vector>
 
 class SkTaskGroup : SkNoncopyable {
 public:
@@ -21,11 +22,41 @@ public:
     ~SkTaskGroup() { this->wait(); }
 
     // Add a task to this SkTaskGroup.
-    void add(std::function<void(void)> fn);
+    void add(std::function<void(void)> fn,
+             SkExecutor::Priority priority = SkExecutor::Priority::kNormal);
 
     // Add a batch of N tasks, all calling fn with different arguments.
+    // They're run in chunks of consecutive arguments, claimed by a few executor tasks.
     void batch(int N, std::function<void(int)> fn);
 
+    // Call fn(start, end) for consecutive subranges [start, end) that together cover [0, N),
+    // each at most grain long.  A grain of 0 picks one that makes a few dozen subranges.
+    // Like batch(), this returns right away: wait() for the subranges to be done.
+    void parallelFor(int N, std::function<void(int start, int end)> fn, int grain = 0);
+
+    // Map each subrange of [0, N), as in parallelFor(), to a T with map(start, end), and return
+    // the results folded into identity in range order with reduce(T, T).  The subranges only
+    // depend on N and grain, so results are reproducible even if reduce isn't associative.
+    // This waits for the group, so it's safe to call from the group's executor's own tasks.
+    template <typename T, typename MapFn, typename ReduceFn>
+    T parallelReduce(int N, T identity, MapFn&& map, ReduceFn&& reduce, int grain = 0) {
+        if (N <= 0) {
+            return identity;
+        }
+        grain = GrainSize(N, grain);
+        std::vector<T> results((N + grain - 1) / grain, identity);
+        this->parallelFor(N, [&](int start, int end) {
+            results[start / grain] = map(start, end);
+        }, grain);
+        this->wait();
+
+        T result = std::move(identity);
+        for (T& r : results) {
+            result = reduce(std::move(result), std::move(r));
+        }
+        return result;
+    }
+
     // Returns true if all Tasks previously add()ed to this SkTaskGroup have run.
     // It is safe to reuse this SkTaskGroup once done().
     bool done() const;
@@ -41,6 +72,17 @@ public:
     };
 
 private:
+    static constexpr int kAutoChunks = 64;
+
+    static int GrainSize(int N, int grain) {
+        return grain > 0 ? grain : SkTMax(1, (N + kAutoChunks - 1) / kAutoChunks);
+    }
+
+    // How many executor tasks to split N arguments in chunks of grain over.
+    static int MaxConcurrency(int N, int grain);
+
+    void addChunks(int N, int grain, std::function<void(int, int)> fn);
+
     std::atomic<int32_t> fPending;
     SkExecutor&          fExecutor;
 };
@@ -30,24 +30,26 @@ sk_sp<SkTypeface> SkTypefaceCache::findByProcAndRef(FindProc proc, void* ctx) co
     return nullptr;
 }
 
-void SkTypefaceCache::purge(int numToPurge) {
+int SkTypefaceCache::purge(int numToPurge) {
     int count = fTypefaces.count();
+    int purged = 0;
     int i = 0;
     while (i < count) {
         if (fTypefaces[i]->unique()) {
             fTypefaces.removeShuffle(i);
             --count;
-            if (--numToPurge == 0) {
-                return;
+            if (++purged == numToPurge) {
+                break;
             }
         } else {
             ++i;
         }
     }
+    return purged;
 }
 
-void SkTypefaceCache::purgeAll() {
-    this->purge(fTypefaces.count());
+int SkTypefaceCache::purgeAll() {
+    return this->purge(fTypefaces.count());
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -74,9 +76,9 @@ sk_sp<SkTypeface> SkTypefaceCache::FindByProcAndRef(FindProc proc, void* ctx) {
     return Get().findByProcAndRef(proc, ctx);
 }
 
-void SkTypefaceCache::PurgeAll() {
+int SkTypefaceCache::PurgeAll() {
     SkAutoMutexAcquire ama(gMutex);
-    Get().purgeAll();
+    return Get().purgeAll();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -44,7 +44,7 @@ public:
      *  This function is exposed for clients that explicitly want to purge the
      *  cache (e.g. to look for leaks).
      */
-    void purgeAll();
+    int purgeAll();
 
     /**
      *  Helper: returns a unique fontID to pass to the constructor of
@@ -56,7 +56,8 @@ public:
 
     static void Add(sk_sp<SkTypeface>);
     static sk_sp<SkTypeface> FindByProcAndRef(FindProc proc, void* ctx);
-    static void PurgeAll();
+    // Returns the number of typefaces released.
+    static int PurgeAll();
 
     /**
      *  Debugging only: dumps the status of the typefaces in the cache
@@ -66,7 +67,7 @@ public:
 private:
     static SkTypefaceCache& Get();
 
-    void purge(int count);
+    int purge(int count);
 
     SkTArray<sk_sp<SkTypeface>> fTypefaces;
 };
@@ -8,12 +8,15 @@
 #include "include/core/SkVertices.h"
 
 #include "include/core/SkData.h"
+#include "include/private/SkTemplates.h"
 #include "include/private/SkTo.h"
 #include "src/core/SkReader32.h"
 #include "src/core/SkSafeMath.h"
 #include "src/core/SkSafeRange.h"
 #include "src/core/SkWriter32.h"
+#include <algorithm>
 #include <atomic>
+#include <cmath>
 #include <new>
 
 static int32_t next_id() {
@@ -91,6 +94,180 @@ struct SkVertices::Sizes {
     size_t fBuilderTriFanISize;
 };
 
+// The size of the post-transform cache the triangle order is tuned for. Tuning for a bigger cache
+// than the GPU has costs little, since the most recently used vertices still score highest.
+static constexpr int kVertexCacheSize = 32;
+
+// How much a vertex adds to the score of the triangles that use it, following Tom Forsyth's
+// "Linear-Speed Vertex Cache Optimisation": vertices that are still in the cache score by how
+// recently they were used, and vertices with few triangles left score higher, so they get finished
+// off rather than refetched later.
+static float vertex_cache_score(int cachePosition, int remainingTriangles) {
+    if (!remainingTriangles) {
+        return -1;
+    }
+    float score = 0;
+    if (cachePosition >= 0) {
+        if (cachePosition < 3) {
+            // These were used by the last triangle. They are scored a little lower than the next
+            // few so that we don't end up stripping long thin runs of triangles.
+            score = 0.75f;
+        } else {
+            const float scale = 1.0f / (kVertexCacheSize - 3);
+            score = std::pow(1.0f - (cachePosition - 3) * scale, 1.5f);
+        }
+    }
+    return score + 2.0f / std::sqrt((float)remainingTriangles);
+}
+
+template <typename T>
+static void permute_vertices(const T* array, const int newToOld[], int vertexCount) {
+    if (array) {
+        SkAutoTMalloc<T> original(vertexCount);
+        memcpy(original.get(), array, vertexCount * sizeof(T));
+        T* dst = const_cast<T*>(array);
+        for (int v = 0; v < vertexCount; ++v) {
+            dst[v] = original[newToOld[v]];
+        }
+    }
+}
+
+// Greedily reorders the triangles of 'vertices' so that each one reuses the vertices of the
+// triangles before it, and then renumbers the vertices in the order the triangles first use them.
+static void optimize_for_vertex_cache(SkVertices* vertices) {
+    const int vertexCount = vertices->vertexCount();
+    const int triCount = vertices->indexCount() / 3;
+    uint16_t* indices = const_cast<uint16_t*>(vertices->indices());
+    const int indexCount = 3 * triCount;
+    for (int i = 0; i < indexCount; ++i) {
+        if (indices[i] >= vertexCount) {
+            return;
+        }
+    }
+
+    // For each vertex, the triangles that use it and haven't been emitted yet are the first
+    // remaining[v] entries of vertexTris[firstTri[v]...].
+    SkAutoTMalloc<int> remaining(vertexCount);
+    SkAutoTMalloc<int> firstTri(vertexCount);
+    SkAutoTMalloc<int> vertexTris(indexCount);
+    sk_bzero(remaining.get(), vertexCount * sizeof(int));
+    for (int i = 0; i < indexCount; ++i) {
+        remaining[indices[i]]++;
+    }
+    for (int v = 0, start = 0; v < vertexCount; ++v) {
+        firstTri[v] = start;
+        start += remaining[v];
+        remaining[v] = 0;
+    }
+    for (int i = 0; i < indexCount; ++i) {
+        int v = indices[i];
+        vertexTris[firstTri[v] + remaining[v]++] = i / 3;
+    }
+
+    SkAutoTMalloc<int> cachePosition(vertexCount);
+    SkAutoTMalloc<float> score(vertexCount);
+    for (int v = 0; v < vertexCount; ++v) {
+        cachePosition[v] = -1;
+        score[v] = vertex_cache_score(-1, remaining[v]);
+    }
+    SkAutoTMalloc<bool> emitted(triCount);
+    sk_bzero(emitted.get(), triCount * sizeof(bool));
+    SkAutoTMalloc<uint16_t> sorted(indexCount);
+
+    // The simulated LRU cache, most recent first. It briefly holds three extra vertices while the
+    // ones pushed out by the latest triangle are evicted.
+    int cache[kVertexCacheSize + 3];
+    int cacheCount = 0;
+    int nextUnemitted = 0;
+    int best = -1;
+    for (int t = 0; t < triCount; ++t) {
+        if (best < 0) {
+            // Nothing in the cache is used by a remaining triangle, so start on a new one. Taking
+            // them in their original order keeps this linear.
+            while (emitted[nextUnemitted]) {
+                ++nextUnemitted;
+            }
+            best = nextUnemitted;
+        }
+        emitted[best] = true;
+        const uint16_t* tri = indices + 3 * best;
+        memcpy(sorted.get() + 3 * t, tri, 3 * sizeof(uint16_t));
+
+        int newCache[kVertexCacheSize + 3];
+        int newCount = 0;
+        for (int i = 0; i < 3; ++i) {
+            int v = tri[i];
+            int* tris = vertexTris.get() + firstTri[v];
+            for (int j = 0; j < remaining[v]; ++j) {
+                if (tris[j] == best) {
+                    tris[j] = tris[--remaining[v]];
+                    break;
+                }
+            }
+            if (std::find(newCache, newCache + newCount, v) == newCache + newCount) {
+                newCache[newCount++] = v;
+            }
+        }
+        const int triVertexCount = newCount;
+        for (int i = 0; i < cacheCount; ++i) {
+            int v = cache[i];
+            if (std::find(newCache, newCache + triVertexCount, v) == newCache + triVertexCount) {
+                newCache[newCount++] = v;
+            }
+        }
+        for (int i = 0; i < newCount; ++i) {
+            int v = newCache[i];
+            cachePosition[v] = i < kVertexCacheSize ? i : -1;
+            score[v] = vertex_cache_score(cachePosition[v], remaining[v]);
+        }
+        cacheCount = SkTMin(newCount, kVertexCacheSize);
+        memcpy(cache, newCache, cacheCount * sizeof(int));
+
+        // The next triangle is the best scoring one that uses a cached vertex.
+        best = -1;
+        float bestScore = -1;
+        for (int i = 0; i < cacheCount; ++i) {
+            int v = cache[i];
+            const int* tris = vertexTris.get() + firstTri[v];
+            for (int j = 0; j < remaining[v]; ++j) {
+                const uint16_t* candidate = indices + 3 * tris[j];
+                float triScore = score[candidate[0]] + score[candidate[1]] + score[candidate[2]];
+                if (triScore > bestScore) {
+                    bestScore = triScore;
+                    best = tris[j];
+                }
+            }
+        }
+    }
+
+    // Renumber the vertices in the order they are first used. Any that no triangle uses go last.
+    SkAutoTMalloc<int> newToOld(vertexCount);
+    SkAutoTMalloc<int> oldToNew(vertexCount);
+    for (int v = 0; v < vertexCount; ++v) {
+        oldToNew[v] = -1;
+    }
+    int used = 0;
+    for (int i = 0; i < indexCount; ++i) {
+        int v = sorted[i];
+        if (oldToNew[v] < 0) {
+            oldToNew[v] = used;
+            newToOld[used++] = v;
+        }
+        indices[i] = SkToU16(oldToNew[v]);
+    }
+    for (int v = 0; v < vertexCount; ++v) {
+        if (oldToNew[v] < 0) {
+            newToOld[used++] = v;
+        }
+    }
+
+    permute_vertices(vertices->positions(), newToOld.get(), vertexCount);
+    permute_vertices(vertices->texCoords(), newToOld.get(), vertexCount);
+    permute_vertices(vertices->colors(), newToOld.get(), vertexCount);
+    permute_vertices(vertices->boneIndices(), newToOld.get(), vertexCount);
+    permute_vertices(vertices->boneWeights(), newToOld.get(), vertexCount);
+}
+
 SkVertices::Builder::Builder(VertexMode mode, int vertexCount, int indexCount,
                              uint32_t builderFlags) {
     bool hasTexs = SkToBool(builderFlags & SkVertices::kHasTexCoords_BuilderFlag);
@@ -99,6 +276,8 @@ SkVertices::Builder::Builder(VertexMode mode, int vertexCount, int indexCount,
     bool isVolatile = !SkToBool(builderFlags & SkVertices::kIsNonVolatile_BuilderFlag);
     this->init(mode, vertexCount, indexCount, isVolatile,
                SkVertices::Sizes(mode, vertexCount, indexCount, hasTexs, hasColors, hasBones));
+    fOptimizeForVertexCache =
+            SkToBool(builderFlags & SkVertices::kOptimizeForVertexCache_BuilderFlag);
 }
 
 SkVertices::Builder::Builder(VertexMode mode, int vertexCount, int indexCount, bool isVolatile,
@@ -160,6 +339,10 @@ sk_sp<SkVertices> SkVertices::Builder::detach() {
             }
             fVertices->fMode = kTriangles_VertexMode;
         }
+        if (fOptimizeForVertexCache && fVertices->fMode == kTriangles_VertexMode &&
+            fVertices->fIndexCnt) {
+            optimize_for_vertex_cache(fVertices.get());
+        }
         fVertices->fUniqueID = next_id();
         return std::move(fVertices);        // this will null fVertices after the return
     }
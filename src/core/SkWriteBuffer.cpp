@@ -36,8 +36,7 @@ bool SkBinaryWriteBuffer::usingInitialStorage() const {
 }
 
 void SkBinaryWriteBuffer::writeByteArray(const void* data, size_t size) {
-    fWriter.write32(SkToU32(size));
-    fWriter.writePad(data, size);
+    fWriter.writeCountAndPad(SkToU32(size), data, size);
 }
 
 void SkBinaryWriteBuffer::writeBool(bool value) {
@@ -49,8 +48,7 @@ void SkBinaryWriteBuffer::writeScalar(SkScalar value) {
 }
 
 void SkBinaryWriteBuffer::writeScalarArray(const SkScalar* value, uint32_t count) {
-    fWriter.write32(count);
-    fWriter.write(value, count * sizeof(SkScalar));
+    fWriter.writeCountAndPad(count, value, count * sizeof(SkScalar));
 }
 
 void SkBinaryWriteBuffer::writeInt(int32_t value) {
@@ -58,8 +56,7 @@ void SkBinaryWriteBuffer::writeInt(int32_t value) {
 }
 
 void SkBinaryWriteBuffer::writeIntArray(const int32_t* value, uint32_t count) {
-    fWriter.write32(count);
-    fWriter.write(value, count * sizeof(int32_t));
+    fWriter.writeCountAndPad(count, value, count * sizeof(int32_t));
 }
 
 void SkBinaryWriteBuffer::writeUInt(uint32_t value) {
@@ -75,8 +72,7 @@ void SkBinaryWriteBuffer::writeColor(SkColor color) {
 }
 
 void SkBinaryWriteBuffer::writeColorArray(const SkColor* color, uint32_t count) {
-    fWriter.write32(count);
-    fWriter.write(color, count * sizeof(SkColor));
+    fWriter.writeCountAndPad(count, color, count * sizeof(SkColor));
 }
 
 void SkBinaryWriteBuffer::writeColor4f(const SkColor4f& color) {
@@ -84,13 +80,11 @@ void SkBinaryWriteBuffer::writeColor4f(const SkColor4f& color) {
 }
 
 void SkBinaryWriteBuffer::writeColor4fArray(const SkColor4f* color, uint32_t count) {
-    fWriter.write32(count);
-    fWriter.write(color, count * sizeof(SkColor4f));
+    fWriter.writeCountAndPad(count, color, count * sizeof(SkColor4f));
 }
 
 void SkBinaryWriteBuffer::writePoint(const SkPoint& point) {
-    fWriter.writeScalar(point.fX);
-    fWriter.writeScalar(point.fY);
+    fWriter.writePoint(point);
 }
 
 void SkBinaryWriteBuffer::writePoint3(const SkPoint3& point) {
@@ -98,8 +92,7 @@ void SkBinaryWriteBuffer::writePoint3(const SkPoint3& point) {
 }
 
 void SkBinaryWriteBuffer::writePointArray(const SkPoint* point, uint32_t count) {
-    fWriter.write32(count);
-    fWriter.write(point, count * sizeof(SkPoint));
+    fWriter.writeCountAndPad(count, point, count * sizeof(SkPoint));
 }
 
 void SkBinaryWriteBuffer::writeMatrix(const SkMatrix& matrix) {
@@ -60,6 +60,7 @@ public:
     virtual void writePaint(const SkPaint& paint) = 0;
 
     void setSerialProcs(const SkSerialProcs& procs) { fProcs = procs; }
+    const SkSerialProcs& getSerialProcs() const { return fProcs; }
 
 protected:
     SkSerialProcs   fProcs;
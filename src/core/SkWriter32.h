@@ -189,6 +189,16 @@ public:
         sk_careful_memcpy(this->reservePad(size), src, size);
     }
 
+    /**
+     *  Write count, then size bytes from src padded to 4 byte alignment with zeroes, reserving
+     *  room for both at once.
+     */
+    void writeCountAndPad(uint32_t count, const void* src, size_t size) {
+        uint32_t* p = this->reservePad(sizeof(uint32_t) + size);
+        p[0] = count;
+        sk_careful_memcpy(p + 1, src, size);
+    }
+
     /**
      *  Writes a string to the writer, which can be retrieved with
      *  SkReader32::readString().
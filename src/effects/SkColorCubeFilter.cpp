@@ -0,0 +1,272 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/effects/SkColorCubeFilter.h"
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkColorPriv.h"
+#include "include/private/SkOnce.h"
+#include "src/core/SkArenaAlloc.h"
+#include "src/core/SkEffectPriv.h"
+#include "src/core/SkRasterPipeline.h"
+#include "src/core/SkReadBuffer.h"
+#include "src/core/SkWriteBuffer.h"
+
+#include <memory>
+
+static bool valid_cube(const SkData* cubeData, int cubeDimension) {
+    if (cubeDimension < SkColorCubeFilter::kMinDimension ||
+        cubeDimension > SkColorCubeFilter::kMaxDimension) {
+        return false;
+    }
+    const size_t entries = cubeDimension * cubeDimension * cubeDimension;
+    return cubeData && cubeData->size() == entries * sizeof(SkColor);
+}
+
+class SkColorCube_Filter : public SkColorFilter {
+public:
+    SkColorCube_Filter(sk_sp<SkData> cubeData, int cubeDimension)
+            : fCubeData(std::move(cubeData))
+            , fDimension(cubeDimension) {
+        SkASSERT(valid_cube(fCubeData.get(), fDimension));
+    }
+
+    uint32_t getFlags() const override { return kAlphaUnchanged_Flag; }
+
+#if SK_SUPPORT_GPU
+    std::unique_ptr<GrFragmentProcessor> asFragmentProcessor(
+            GrRecordingContext*, const GrColorSpaceInfo&) const override;
+#endif
+
+    bool onAppendStages(const SkStageRec& rec, bool shaderIsOpaque) const override {
+        SkRasterPipeline* p = rec.fPipeline;
+        if (!shaderIsOpaque) {
+            p->append(SkRasterPipeline::unpremul);
+        }
+
+        const float* planes = this->getPlanes();
+        const int entries = fDimension * fDimension * fDimension;
+        p->append(SkRasterPipeline::color_cube,
+                  rec.fAlloc->make<SkRasterPipeline_ColorCubeCtx>(SkRasterPipeline_ColorCubeCtx{
+                          planes, planes + entries, planes + 2 * entries, fDimension}));
+
+        if (!shaderIsOpaque) {
+            p->append(SkRasterPipeline::premul);
+        }
+        return true;
+    }
+
+protected:
+    void flatten(SkWriteBuffer&) const override;
+
+private:
+    SK_FLATTENABLE_HOOKS(SkColorCube_Filter)
+
+    // The cube split into red, green and blue planes of floats for the raster pipeline.
+    const float* getPlanes() const;
+#if SK_SUPPORT_GPU
+    // The cube unrolled into a (dim*dim) x dim bitmap: each blue lattice value is a dim x dim
+    // slice, with red along x and green along y.
+    const SkBitmap& getSlices() const;
+#endif
+
+    sk_sp<SkData> fCubeData;
+    int           fDimension;
+
+    // Both made lazily, since a filter is usually only drawn with one backend.
+    mutable SkOnce                   fPlanesOnce;
+    mutable std::unique_ptr<float[]> fPlanes;
+#if SK_SUPPORT_GPU
+    mutable SkOnce                   fSlicesOnce;
+    mutable SkBitmap                 fSlices;
+#endif
+
+    friend class SkColorCubeFilter;
+
+    typedef SkColorFilter INHERITED;
+};
+
+const float* SkColorCube_Filter::getPlanes() const {
+    fPlanesOnce([this] {
+        const int entries = fDimension * fDimension * fDimension;
+        const SkColor* colors = static_cast<const SkColor*>(fCubeData->data());
+        fPlanes.reset(new float[3 * entries]);
+        for (int i = 0; i < entries; ++i) {
+            fPlanes[i              ] = SkColorGetR(colors[i]) * (1 / 255.0f);
+            fPlanes[i +     entries] = SkColorGetG(colors[i]) * (1 / 255.0f);
+            fPlanes[i + 2 * entries] = SkColorGetB(colors[i]) * (1 / 255.0f);
+        }
+    });
+    return fPlanes.get();
+}
+
+void SkColorCube_Filter::flatten(SkWriteBuffer& buffer) const {
+    buffer.writeInt(fDimension);
+    buffer.writeDataAsByteArray(fCubeData.get());
+}
+
+sk_sp<SkFlattenable> SkColorCube_Filter::CreateProc(SkReadBuffer& buffer) {
+    int cubeDimension = buffer.readInt();
+    sk_sp<SkData> cubeData = buffer.readByteArrayAsData();
+    if (!buffer.validate(valid_cube(cubeData.get(), cubeDimension))) {
+        return nullptr;
+    }
+    return SkColorCubeFilter::Make(std::move(cubeData), cubeDimension);
+}
+
+#if SK_SUPPORT_GPU
+
+#include "include/private/GrRecordingContext.h"
+#include "src/gpu/GrCaps.h"
+#include "src/gpu/GrColorSpaceInfo.h"
+#include "src/gpu/GrFragmentProcessor.h"
+#include "src/gpu/GrRecordingContextPriv.h"
+#include "src/gpu/SkGr.h"
+#include "src/gpu/glsl/GrGLSLFragmentProcessor.h"
+#include "src/gpu/glsl/GrGLSLFragmentShaderBuilder.h"
+#include "src/gpu/glsl/GrGLSLProgramDataManager.h"
+#include "src/gpu/glsl/GrGLSLUniformHandler.h"
+
+const SkBitmap& SkColorCube_Filter::getSlices() const {
+    fSlicesOnce([this] {
+        const SkColor* colors = static_cast<const SkColor*>(fCubeData->data());
+        fSlices.allocN32Pixels(fDimension * fDimension, fDimension, /*isOpaque=*/true);
+        for (int b = 0; b < fDimension; ++b) {
+            for (int g = 0; g < fDimension; ++g) {
+                for (int r = 0; r < fDimension; ++r) {
+                    SkColor c = *colors++;
+                    *fSlices.getAddr32(b * fDimension + r, g) =
+                            SkPackARGB32(0xFF, SkColorGetR(c), SkColorGetG(c), SkColorGetB(c));
+                }
+            }
+        }
+        fSlices.setImmutable();
+    });
+    return fSlices;
+}
+
+// Reads the cube from its slices texture: red and green are filtered by the sampler within a
+// slice, and blue by mixing the two slices either side.
+class ColorCubeEffect : public GrFragmentProcessor {
+public:
+    static std::unique_ptr<GrFragmentProcessor> Make(GrRecordingContext*, const SkBitmap& slices,
+                                                     int dimension);
+
+    const char* name() const override { return "ColorCubeEffect"; }
+
+    std::unique_ptr<GrFragmentProcessor> clone() const override {
+        return std::unique_ptr<GrFragmentProcessor>(
+                new ColorCubeEffect(sk_ref_sp(fTextureSampler.proxy()), fDimension));
+    }
+
+    int dimension() const { return fDimension; }
+
+private:
+    ColorCubeEffect(sk_sp<GrTextureProxy> proxy, int dimension)
+            : INHERITED(kColorCubeEffect_ClassID, kPreservesOpaqueInput_OptimizationFlag)
+            , fTextureSampler(std::move(proxy), GrSamplerState::ClampBilerp())
+            , fDimension(dimension) {
+        this->setTextureSamplerCnt(1);
+    }
+
+    GrGLSLFragmentProcessor* onCreateGLSLInstance() const override;
+
+    // The dimension is a uniform, so every cube shares one program.
+    void onGetGLSLProcessorKey(const GrShaderCaps&, GrProcessorKeyBuilder*) const override {}
+
+    bool onIsEqual(const GrFragmentProcessor& that) const override {
+        return fDimension == that.cast<ColorCubeEffect>().fDimension;
+    }
+
+    const TextureSampler& onTextureSampler(int) const override { return fTextureSampler; }
+
+    TextureSampler fTextureSampler;
+    int            fDimension;
+
+    typedef GrFragmentProcessor INHERITED;
+};
+
+class GLColorCubeEffect : public GrGLSLFragmentProcessor {
+public:
+    void emitCode(EmitArgs& args) override {
+        GrGLSLUniformHandler* uniformHandler = args.fUniformHandler;
+        fCubeUni = uniformHandler->addUniform(kFragment_GrShaderFlag, kFloat4_GrSLType, "Cube");
+        const char* cube = uniformHandler->getUniformCStr(fCubeUni);
+
+        GrGLSLFPFragmentBuilder* fragBuilder = args.fFragBuilder;
+        if (args.fInputColor) {
+            fragBuilder->codeAppendf("half alpha = %s.a;", args.fInputColor);
+            fragBuilder->codeAppendf("half3 color = saturate(%s.rgb / max(alpha, 0.0001));",
+                                     args.fInputColor);
+        } else {
+            fragBuilder->codeAppend("half alpha = 1;");
+            fragBuilder->codeAppend("half3 color = half3(1);");
+        }
+        // cube is (dim - 1, dim, 1 / texture width, 1 / texture height).
+        fragBuilder->codeAppendf("float3 pos = float3(color) * %s.x;", cube);
+        fragBuilder->codeAppendf("float b = min(floor(pos.b), %s.x - 1);", cube);
+        fragBuilder->codeAppendf("float2 coord = float2(pos.r + 0.5 + b * %s.y, pos.g + 0.5) * "
+                                 "%s.zw;", cube, cube);
+        fragBuilder->codeAppend("half4 lo = ");
+        fragBuilder->appendTextureLookup(args.fTexSamplers[0], "coord");
+        fragBuilder->codeAppend(";");
+        fragBuilder->codeAppendf("coord.x += %s.y * %s.z;", cube, cube);
+        fragBuilder->codeAppend("half4 hi = ");
+        fragBuilder->appendTextureLookup(args.fTexSamplers[0], "coord");
+        fragBuilder->codeAppend(";");
+        fragBuilder->codeAppendf("%s = half4(mix(lo.rgb, hi.rgb, half(pos.b - b)) * alpha, alpha);",
+                                 args.fOutputColor);
+    }
+
+private:
+    void onSetData(const GrGLSLProgramDataManager& pdman,
+                   const GrFragmentProcessor& processor) override {
+        const int dim = processor.cast<ColorCubeEffect>().dimension();
+        pdman.set4f(fCubeUni, dim - 1, dim, 1.0f / (dim * dim), 1.0f / dim);
+    }
+
+    UniformHandle fCubeUni;
+
+    typedef GrGLSLFragmentProcessor INHERITED;
+};
+
+GrGLSLFragmentProcessor* ColorCubeEffect::onCreateGLSLInstance() const {
+    return new GLColorCubeEffect;
+}
+
+std::unique_ptr<GrFragmentProcessor> ColorCubeEffect::Make(GrRecordingContext* context,
+                                                           const SkBitmap& slices,
+                                                           int dimension) {
+    if (slices.width() > context->priv().caps()->maxTextureSize()) {
+        return nullptr;
+    }
+    // Keyed on the bitmap, so every draw with the filter shares one texture.
+    sk_sp<GrTextureProxy> proxy = GrMakeCachedBitmapProxy(context->priv().proxyProvider(),
+                                                          slices);
+    if (!proxy) {
+        return nullptr;
+    }
+    return std::unique_ptr<GrFragmentProcessor>(new ColorCubeEffect(std::move(proxy), dimension));
+}
+
+std::unique_ptr<GrFragmentProcessor> SkColorCube_Filter::asFragmentProcessor(
+        GrRecordingContext* context, const GrColorSpaceInfo&) const {
+    return ColorCubeEffect::Make(context, this->getSlices(), fDimension);
+}
+
+#endif // SK_SUPPORT_GPU
+
+///////////////////////////////////////////////////////////////////////////////
+
+sk_sp<SkColorFilter> SkColorCubeFilter::Make(sk_sp<SkData> cubeData, int cubeDimension) {
+    if (!valid_cube(cubeData.get(), cubeDimension)) {
+        return nullptr;
+    }
+    return sk_make_sp<SkColorCube_Filter>(std::move(cubeData), cubeDimension);
+}
+
+void SkColorCubeFilter::RegisterFlattenables() { SK_REGISTER_FLATTENABLE(SkColorCube_Filter); }
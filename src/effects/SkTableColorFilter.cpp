@@ -97,15 +97,12 @@ public:
     };
 
     bool onAppendStages(const SkStageRec& rec, bool shaderIsOpaque) const override {
-        const uint8_t *r = gIdentityTable,
-                      *g = gIdentityTable,
-                      *b = gIdentityTable,
-                      *a = gIdentityTable;
-        const uint8_t* ptr = fStorage;
-        if (fFlags & kA_Flag) { a = ptr; ptr += 256; }
-        if (fFlags & kR_Flag) { r = ptr; ptr += 256; }
-        if (fFlags & kG_Flag) { g = ptr; ptr += 256; }
-        if (fFlags & kB_Flag) { b = ptr;             }
+        const uint8_t* tables[4];
+        this->getTables(tables);
+        const uint8_t *r = tables[0],
+                      *g = tables[1],
+                      *b = tables[2],
+                      *a = tables[3];
 
         SkRasterPipeline* p = rec.fPipeline;
         if (!shaderIsOpaque) {
@@ -124,10 +121,14 @@ public:
 
 protected:
     void flatten(SkWriteBuffer&) const override;
+    sk_sp<SkColorFilter> onMakeComposed(const SkColorFilter& inner) const override;
 
 private:
     SK_FLATTENABLE_HOOKS(SkTable_ColorFilter)
 
+    // Points r, g, b and a at the channels' tables, identity for the ones we don't have.
+    void getTables(const uint8_t* tables[4]) const;
+
     void getTableAsBitmap(SkBitmap* table) const;
 
     mutable const SkBitmap* fBitmap; // lazily allocated
@@ -140,6 +141,46 @@ private:
     typedef SkColorFilter INHERITED;
 };
 
+void SkTable_ColorFilter::getTables(const uint8_t* tables[4]) const {
+    const uint8_t *r = gIdentityTable,
+                  *g = gIdentityTable,
+                  *b = gIdentityTable,
+                  *a = gIdentityTable;
+    const uint8_t* ptr = fStorage;
+    if (fFlags & kA_Flag) { a = ptr; ptr += 256; }
+    if (fFlags & kR_Flag) { r = ptr; ptr += 256; }
+    if (fFlags & kG_Flag) { g = ptr; ptr += 256; }
+    if (fFlags & kB_Flag) { b = ptr;             }
+    tables[0] = r;
+    tables[1] = g;
+    tables[2] = b;
+    tables[3] = a;
+}
+
+sk_sp<SkColorFilter> SkTable_ColorFilter::onMakeComposed(const SkColorFilter& inner) const {
+    if (inner.getFactory() != this->getFactory()) {
+        return nullptr;
+    }
+    const uint8_t* outerTables[4];
+    const uint8_t* innerTables[4];
+    this->getTables(outerTables);
+    static_cast<const SkTable_ColorFilter&>(inner).getTables(innerTables);
+
+    // Where the inner alpha table gives 0, premul loses the inner color before our tables see
+    // it, which only matters if our alpha table then brings alpha back.
+    if (outerTables[3][0] != 0 && memchr(innerTables[3], 0, 256)) {
+        return nullptr;
+    }
+
+    uint8_t composed[4][256];
+    for (int c = 0; c < 4; ++c) {
+        for (int i = 0; i < 256; ++i) {
+            composed[c][i] = outerTables[c][innerTables[c][i]];
+        }
+    }
+    return SkTableColorFilter::MakeARGB(composed[3], composed[0], composed[1], composed[2]);
+}
+
 static const uint8_t gCountNibBits[] = {
     0, 1, 1, 2,
     1, 2, 2, 3,
@@ -5,8 +5,8 @@
  * found in the LICENSE file.
  */
 
-#include "include/core/SkPathMeasure.h"
 #include "include/effects/SkTrimPathEffect.h"
+#include "src/core/SkContourMeasureCache.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkWriteBuffer.h"
 #include "src/effects/SkTrimPE.h"
@@ -15,34 +15,36 @@ namespace {
 
 class Segmentator : public SkNoncopyable {
 public:
-    Segmentator(const SkPath& src, SkPath* dst)
-        : fMeasure(src, false)
+    Segmentator(const SkTArray<sk_sp<SkContourMeasure>>& contours, SkPath* dst)
+        : fContours(contours)
         , fDst(dst) {}
 
     void add(SkScalar start, SkScalar stop) {
         SkASSERT(start < stop);
 
         // TODO: we appear to skip zero-length contours.
-        do {
-            const auto nextOffset = fCurrentSegmentOffset + fMeasure.getLength();
+        for (; fCurrentContour < fContours.count(); ++fCurrentContour) {
+            const SkContourMeasure& contour = *fContours[fCurrentContour];
+            const auto nextOffset = fCurrentSegmentOffset + contour.length();
 
             if (start < nextOffset) {
-                fMeasure.getSegment(start - fCurrentSegmentOffset,
-                                    stop  - fCurrentSegmentOffset,
-                                    fDst, true);
+                contour.getSegment(start - fCurrentSegmentOffset,
+                                   stop  - fCurrentSegmentOffset,
+                                   fDst, true);
 
                 if (stop < nextOffset)
                     break;
             }
 
             fCurrentSegmentOffset = nextOffset;
-        } while (fMeasure.nextContour());
+        }
     }
 
 private:
-    SkPathMeasure fMeasure;
-    SkPath*       fDst;
+    const SkTArray<sk_sp<SkContourMeasure>>& fContours;
+    SkPath*                                  fDst;
 
+    int      fCurrentContour       = 0;
     SkScalar fCurrentSegmentOffset = 0;
 
     using INHERITED = SkNoncopyable;
@@ -60,18 +62,14 @@ bool SkTrimPE::onFilterPath(SkPath* dst, const SkPath& src, SkStrokeRec* rec,
         return true;
     }
 
-    // First pass: compute the total len.
-    SkScalar len = 0;
-    SkPathMeasure meas(src, false);
-    do {
-        len += meas.getLength();
-    } while (meas.nextContour());
+    // Animated trims filter the same path every frame, so share its measurements.
+    SkTArray<sk_sp<SkContourMeasure>> contours;
+    const auto len = SkContourMeasureCache::Find(src, false, 1, &contours);
 
     const auto arcStart = len * fStartT,
                arcStop  = len * fStopT;
 
-    // Second pass: actually add segments.
-    Segmentator segmentator(src, dst);
+    Segmentator segmentator(contours, dst);
     if (fMode == SkTrimPathEffect::Mode::kNormal) {
         if (arcStart < arcStop) segmentator.add(arcStart, arcStop);
     } else {
@@ -6,6 +6,7 @@
  */
 
 #include "include/core/SkCanvas.h"
+#include "include/core/SkColorFilter.h"
 #include "include/effects/SkArithmeticImageFilter.h"
 #include "include/effects/SkXfermodeImageFilter.h"
 #include "include/private/SkNx.h"
@@ -18,6 +19,7 @@
 #include "include/private/GrRecordingContext.h"
 #include "include/private/GrTextureProxy.h"
 #include "src/gpu/GrClip.h"
+#include "src/gpu/GrColorSpaceInfo.h"
 #include "src/gpu/GrColorSpaceXform.h"
 #include "src/gpu/GrRecordingContextPriv.h"
 #include "src/gpu/GrRenderTargetContext.h"
@@ -62,8 +64,10 @@ protected:
     sk_sp<SkSpecialImage> filterImageGPU(SkSpecialImage* source,
                                          sk_sp<SkSpecialImage> background,
                                          const SkIPoint& backgroundOffset,
+                                         sk_sp<SkColorFilter> backgroundCF,
                                          sk_sp<SkSpecialImage> foreground,
                                          const SkIPoint& foregroundOffset,
+                                         sk_sp<SkColorFilter> foregroundCF,
                                          const SkIRect& bounds,
                                          const OutputProperties& outputProperties) const;
 #endif
@@ -163,11 +167,17 @@ static bool intersect(SkPixmap* dst, SkPixmap* src, int srcDx, int srcDy) {
 sk_sp<SkSpecialImage> ArithmeticImageFilterImpl::onFilterImage(SkSpecialImage* source,
                                                                const Context& ctx,
                                                                SkIPoint* offset) const {
+    // Color filters and offsets on the inputs are applied while compositing them, except for the
+    // raster foreground, which is read directly.
     SkIPoint backgroundOffset = SkIPoint::Make(0, 0);
-    sk_sp<SkSpecialImage> background(this->filterInput(0, source, ctx, &backgroundOffset));
+    sk_sp<SkColorFilter> backgroundCF;
+    sk_sp<SkSpecialImage> background(this->filterInputPointwise(0, source, ctx, &backgroundOffset,
+                                                                &backgroundCF));
 
     SkIPoint foregroundOffset = SkIPoint::Make(0, 0);
-    sk_sp<SkSpecialImage> foreground(this->filterInput(1, source, ctx, &foregroundOffset));
+    sk_sp<SkColorFilter> foregroundCF;
+    sk_sp<SkSpecialImage> foreground(this->filterInputPointwise(1, source, ctx, &foregroundOffset,
+                                                                &foregroundCF));
 
     SkIRect foregroundBounds = SkIRect::EmptyIRect();
     if (foreground) {
@@ -196,10 +206,13 @@ sk_sp<SkSpecialImage> ArithmeticImageFilterImpl::onFilterImage(SkSpecialImage* s
 
 #if SK_SUPPORT_GPU
     if (source->isTextureBacked()) {
-        return this->filterImageGPU(source, background, backgroundOffset, foreground,
-                                    foregroundOffset, bounds, ctx.outputProperties());
+        return this->filterImageGPU(source, background, backgroundOffset, std::move(backgroundCF),
+                                    foreground, foregroundOffset, std::move(foregroundCF),
+                                    bounds, ctx.outputProperties());
     }
 #endif
+    foreground = ApplyColorFilter(std::move(foreground), std::move(foregroundCF),
+                                  ctx.outputProperties());
 
     sk_sp<SkSpecialSurface> surf(source->makeSurface(ctx.outputProperties(), bounds.size()));
     if (!surf) {
@@ -215,6 +228,7 @@ sk_sp<SkSpecialImage> ArithmeticImageFilterImpl::onFilterImage(SkSpecialImage* s
     if (background) {
         SkPaint paint;
         paint.setBlendMode(SkBlendMode::kSrc);
+        paint.setColorFilter(std::move(backgroundCF));
         background->draw(canvas, SkIntToScalar(backgroundOffset.fX),
                          SkIntToScalar(backgroundOffset.fY), &paint);
     }
@@ -284,14 +298,33 @@ sk_sp<SkSpecialImage> ArithmeticImageFilterImpl::filterImageGPU(
         SkSpecialImage* source,
         sk_sp<SkSpecialImage> background,
         const SkIPoint& backgroundOffset,
+        sk_sp<SkColorFilter> backgroundCF,
         sk_sp<SkSpecialImage> foreground,
         const SkIPoint& foregroundOffset,
+        sk_sp<SkColorFilter> foregroundCF,
         const SkIRect& bounds,
         const OutputProperties& outputProperties) const {
     SkASSERT(source->isTextureBacked());
 
     auto context = source->getContext();
 
+    // Run the inputs' color filters in the same draw, unless they have no fragment processor.
+    GrColorSpaceInfo dstColorSpaceInfo(sk_ref_sp(outputProperties.colorSpace()),
+                                       SkColorType2GrPixelConfig(outputProperties.colorType()));
+    auto colorFilterFP = [&](sk_sp<SkSpecialImage>* image, sk_sp<SkColorFilter> colorFilter) {
+        std::unique_ptr<GrFragmentProcessor> fp;
+        if (*image && colorFilter) {
+            fp = colorFilter->asFragmentProcessor(context, dstColorSpaceInfo);
+            if (!fp) {
+                *image = ApplyColorFilter(std::move(*image), std::move(colorFilter),
+                                          outputProperties);
+            }
+        }
+        return fp;
+    };
+    auto backgroundCFFP = colorFilterFP(&background, std::move(backgroundCF));
+    auto foregroundCFFP = colorFilterFP(&foreground, std::move(foregroundCF));
+
     sk_sp<GrTextureProxy> backgroundProxy, foregroundProxy;
 
     if (background) {
@@ -317,6 +350,11 @@ sk_sp<SkSpecialImage> ArithmeticImageFilterImpl::filterImageGPU(
         bgFP = GrColorSpaceXformEffect::Make(std::move(bgFP), background->getColorSpace(),
                                              background->alphaType(),
                                              outputProperties.colorSpace());
+        if (backgroundCFFP) {
+            std::unique_ptr<GrFragmentProcessor> series[] = { std::move(bgFP),
+                                                              std::move(backgroundCFFP) };
+            bgFP = GrFragmentProcessor::RunInSeries(series, 2);
+        }
     } else {
         bgFP = GrConstColorProcessor::Make(SK_PMColor4fTRANSPARENT,
                                            GrConstColorProcessor::InputMode::kIgnore);
@@ -336,6 +374,9 @@ sk_sp<SkSpecialImage> ArithmeticImageFilterImpl::filterImageGPU(
                                                      foreground->alphaType(),
                                                      outputProperties.colorSpace());
         paint.addColorFragmentProcessor(std::move(foregroundFP));
+        if (foregroundCFFP) {
+            paint.addColorFragmentProcessor(std::move(foregroundCFFP));
+        }
 
         static int arithmeticIndex = GrSkSLFP::NewIndex();
         ArithmeticFPInputs inputs;
@@ -20,6 +20,7 @@
 #include "src/core/SkOpts.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkSpecialImage.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkWriteBuffer.h"
 
 #if SK_SUPPORT_GPU
@@ -450,60 +451,53 @@ static sk_sp<SkSpecialImage> copy_image_with_bounds(
                                           dst, &source->props());
 }
 
-// TODO: Implement CPU backend for different fTileMode.
-static sk_sp<SkSpecialImage> cpu_blur(
-        SkVector sigma,
-        SkSpecialImage *source, const sk_sp<SkSpecialImage> &input,
-        SkIRect srcBounds, SkIRect dstBounds) {
-    auto windowW = calculate_window(sigma.x()),
-         windowH = calculate_window(sigma.y());
-
-    if (windowW <= 1 && windowH <= 1) {
-        return copy_image_with_bounds(source, input, srcBounds, dstBounds);
-    }
-
-    SkBitmap inputBM;
-
-    if (!input->getROPixels(&inputBM)) {
-        return nullptr;
-    }
-
-    if (inputBM.colorType() != kN32_SkColorType) {
-        return nullptr;
-    }
-
-    SkBitmap src;
-    inputBM.extractSubset(&src, srcBounds);
-
-    // Make everything relative to the destination bounds.
-    srcBounds.offset(-dstBounds.x(), -dstBounds.y());
-    dstBounds.offset(-dstBounds.x(), -dstBounds.y());
+// Rows (or columns) are blurred in strips this many wide, each of which may run on its own thread.
+static constexpr int kStripSize = 64;
+
+// Calls blur_one_direction for strips of the count rows (or columns) of src on the default
+// executor, giving each strip its own circular buffer.
+static void blur_strips(int window, int bufferSize,
+                        int srcLeft, int srcRight, int dstRight,
+                        const uint32_t* src, int srcXStride, int srcYStride, int count,
+                              uint32_t* dst, int dstXStride, int dstYStride) {
+    const int strips = (count + kStripSize - 1) / kStripSize;
+    SkTaskGroup().batch(strips, [&](int strip) {
+        // The amount 1024 is enough for buffers up to 10 sigma.
+        SkSTArenaAlloc<1024> alloc;
+        Sk4u* buffer = alloc.makeArrayDefault<Sk4u>(bufferSize);
+
+        const int first = strip * kStripSize;
+        blur_one_direction(buffer, window, srcLeft, srcRight, dstRight,
+                           src + first * srcYStride, srcXStride, srcYStride,
+                           std::min(kStripSize, count - first),
+                           dst + first * dstYStride, dstXStride, dstYStride);
+    });
+}
 
+// Blurs src into a newly allocated dst. Both srcBounds and dstBounds are relative to the
+// destination, so dstBounds is at the origin.
+static bool blur_bitmap(int windowW, int windowH, const SkBitmap& src,
+                        const SkIRect& srcBounds, const SkIRect& dstBounds, SkBitmap* dst) {
     auto srcW = srcBounds.width(),
          srcH = srcBounds.height(),
          dstW = dstBounds.width(),
          dstH = dstBounds.height();
 
-    SkImageInfo dstInfo = inputBM.info().makeWH(dstW, dstH);
-
-    SkBitmap dst;
-    if (!dst.tryAllocPixels(dstInfo)) {
-        return nullptr;
+    SkImageInfo dstInfo = src.info().makeWH(dstW, dstH);
+    if (!dst->tryAllocPixels(dstInfo)) {
+        return false;
     }
 
-    auto bufferSizeW = calculate_buffer(windowW),
-         bufferSizeH = calculate_buffer(windowH);
-
-    // The amount 1024 is enough for buffers up to 10 sigma. The tmp bitmap will be
-    // allocated on the heap.
-    SkSTArenaAlloc<1024> alloc;
-    Sk4u* buffer = alloc.makeArrayDefault<Sk4u>(std::max(bufferSizeW, bufferSizeH));
+    auto bufferSize = std::max(calculate_buffer(windowW), calculate_buffer(windowH));
 
     // Basic Plan: The three cases to handle
     // * Horizontal and Vertical - blur horizontally while copying values from the source to
     //     the destination. Then, do an in-place vertical blur.
     // * Horizontal only - blur horizontally copying values from the source to the destination.
     // * Vertical only - blur vertically copying values from the source to the destination.
+    //
+    // Each row of the horizontal blur and each column of the vertical blur is independent, so
+    // both are split into strips that can run in parallel.
 
     // Default to vertical only blur case. If a horizontal blur is needed, then these values
     // will be adjusted while doing the horizontal blur.
@@ -516,14 +510,14 @@ static sk_sp<SkSpecialImage> cpu_blur(
     // src and dst left values are the same. If sigma is small resulting in a window size of
     // 1, then border calculations add some pixels which will always be zero. Inset the
     // destination by those zero pixels. This case is very rare.
-    auto intermediateDst = dst.getAddr32(srcBounds.left(), 0);
+    auto intermediateDst = dst->getAddr32(srcBounds.left(), 0);
 
     // The following code is executed very rarely, I have never seen it in a real web
     // page. If sigma is small but not zero then shared GPU/CPU border calculation
     // code adds extra pixels for the border. Just clear everything to clear those pixels.
     // This solution is overkill, but very simple.
     if (windowW == 1 || windowH == 1) {
-        dst.eraseColor(0);
+        dst->eraseColor(0);
     }
 
     if (windowW > 1) {
@@ -533,25 +527,181 @@ static sk_sp<SkSpecialImage> cpu_blur(
         // For the horizontal blur, starts part way down in anticipation of the vertical blur.
         // For a vertical sigma of zero shift should be zero. But, for small sigma,
         // shift may be > 0 but the vertical window could be 1.
-        intermediateSrc = static_cast<uint32_t *>(dst.getPixels())
-                          + (shift > 0 ? shift * dst.rowBytesAsPixels() : 0);
-        intermediateRowBytesAsPixels = dst.rowBytesAsPixels();
+        intermediateSrc = static_cast<uint32_t *>(dst->getPixels())
+                          + (shift > 0 ? shift * dst->rowBytesAsPixels() : 0);
+        intermediateRowBytesAsPixels = dst->rowBytesAsPixels();
         intermediateWidth = dstW;
-        intermediateDst = static_cast<uint32_t *>(dst.getPixels());
+        intermediateDst = static_cast<uint32_t *>(dst->getPixels());
 
-        blur_one_direction(
-                buffer, windowW,
+        blur_strips(
+                windowW, bufferSize,
                 srcBounds.left(), srcBounds.right(), dstBounds.right(),
                 static_cast<uint32_t *>(src.getPixels()), 1, src.rowBytesAsPixels(), srcH,
                 intermediateSrc, 1, intermediateRowBytesAsPixels);
     }
 
     if (windowH > 1) {
-        blur_one_direction(
-                buffer, windowH,
+        blur_strips(
+                windowH, bufferSize,
                 srcBounds.top(), srcBounds.bottom(), dstBounds.bottom(),
                 intermediateSrc, intermediateRowBytesAsPixels, 1, intermediateWidth,
-                intermediateDst, dst.rowBytesAsPixels(), 1);
+                intermediateDst, dst->rowBytesAsPixels(), 1);
+    }
+
+    return true;
+}
+
+// Like SkGpuBlurUtils, wide blurs are done at a reduced resolution. The box blurs cost the same
+// per pixel at any sigma, but halving the resolution quarters the pixels to blur, and a blur
+// this wide hides the detail lost.
+static constexpr double kMaxFullResolutionSigma = 16;
+
+static int downsample_factor(double sigma) {
+    int scale = 1;
+    while (sigma / scale > kMaxFullResolutionSigma) {
+        scale *= 2;
+    }
+    return scale;
+}
+
+// Averages each scaleX x scaleY block of src into one pixel of a new smallSrc, on a grid aligned
+// with the destination. Returns the bounds of smallSrc relative to the reduced destination.
+static bool downsample(const SkBitmap& src, const SkIRect& srcBounds, int scaleX, int scaleY,
+                       SkBitmap* smallSrc, SkIRect* smallSrcBounds) {
+    SkASSERT(srcBounds.left() >= 0 && srcBounds.top() >= 0);
+    *smallSrcBounds = SkIRect::MakeLTRB(srcBounds.left() / scaleX,
+                                        srcBounds.top()  / scaleY,
+                                        (srcBounds.right()  + scaleX - 1) / scaleX,
+                                        (srcBounds.bottom() + scaleY - 1) / scaleY);
+    const int smallW = smallSrcBounds->width(),
+              smallH = smallSrcBounds->height();
+    if (!smallSrc->tryAllocPixels(src.info().makeWH(smallW, smallH))) {
+        return false;
+    }
+
+    // Pixels outside of src are transparent, so every block sums to scaleX * scaleY pixels.
+    const float invArea = 1.0f / (scaleX * scaleY);
+    const int strips = (smallH + kStripSize - 1) / kStripSize;
+    SkTaskGroup().batch(strips, [&](int strip) {
+        const int firstRow = strip * kStripSize,
+                  endRow   = std::min(firstRow + kStripSize, smallH);
+        for (int y = firstRow; y < endRow; ++y) {
+            const int blockTop = (smallSrcBounds->top() + y) * scaleY,
+                      top      = std::max(blockTop, srcBounds.top()),
+                      bottom   = std::min(blockTop + scaleY, srcBounds.bottom());
+            uint32_t* dstRow = smallSrc->getAddr32(0, y);
+            for (int x = 0; x < smallW; ++x) {
+                const int blockLeft = (smallSrcBounds->left() + x) * scaleX,
+                          left      = std::max(blockLeft, srcBounds.left()),
+                          right     = std::min(blockLeft + scaleX, srcBounds.right());
+                Sk4u sum{0u};
+                for (int sy = top; sy < bottom; ++sy) {
+                    const uint32_t* srcRow = src.getAddr32(0, sy - srcBounds.top());
+                    for (int sx = left; sx < right; ++sx) {
+                        sum += SkNx_cast<uint32_t>(Sk4b::Load(srcRow + sx - srcBounds.left()));
+                    }
+                }
+                SkNx_cast<uint8_t>(SkNx_cast<float>(sum) * invArea + 0.5f).store(dstRow + x);
+            }
+        }
+    });
+    return true;
+}
+
+// Bilinearly scales smallDst up by scaleX x scaleY into dst.
+static void upsample(const SkBitmap& smallDst, int scaleX, int scaleY, SkBitmap* dst) {
+    const int dstW = dst->width();
+
+    // The columns of smallDst to interpolate between for each column of dst.
+    SkAutoTMalloc<int>   x0s(dstW);
+    SkAutoTMalloc<float> txs(dstW);
+    for (int x = 0; x < dstW; ++x) {
+        float fx = (x + 0.5f) / scaleX - 0.5f;
+        int ix = (int)floorf(fx);
+        txs[x] = fx - ix;
+        x0s[x] = ix;
+    }
+
+    auto load = [](const SkBitmap& bm, int x, int y) {
+        x = SkTPin(x, 0, bm.width()  - 1);
+        y = SkTPin(y, 0, bm.height() - 1);
+        return SkNx_cast<float>(Sk4b::Load(bm.getAddr32(x, y)));
+    };
+
+    const int strips = (dst->height() + kStripSize - 1) / kStripSize;
+    SkTaskGroup().batch(strips, [&](int strip) {
+        const int firstRow = strip * kStripSize,
+                  endRow   = std::min(firstRow + kStripSize, dst->height());
+        for (int y = firstRow; y < endRow; ++y) {
+            float fy = (y + 0.5f) / scaleY - 0.5f;
+            int iy = (int)floorf(fy);
+            float ty = fy - iy;
+            uint32_t* dstRow = dst->getAddr32(0, y);
+            for (int x = 0; x < dstW; ++x) {
+                int ix = x0s[x];
+                Sk4f top    = load(smallDst, ix, iy    ) * (1 - txs[x]) +
+                              load(smallDst, ix + 1, iy    ) * txs[x],
+                     bottom = load(smallDst, ix, iy + 1) * (1 - txs[x]) +
+                              load(smallDst, ix + 1, iy + 1) * txs[x];
+                SkNx_cast<uint8_t>(top * (1 - ty) + bottom * ty + 0.5f).store(dstRow + x);
+            }
+        }
+    });
+}
+
+// TODO: Implement CPU backend for different fTileMode.
+static sk_sp<SkSpecialImage> cpu_blur(
+        SkVector sigma,
+        SkSpecialImage *source, const sk_sp<SkSpecialImage> &input,
+        SkIRect srcBounds, SkIRect dstBounds) {
+    auto windowW = calculate_window(sigma.x()),
+         windowH = calculate_window(sigma.y());
+
+    if (windowW <= 1 && windowH <= 1) {
+        return copy_image_with_bounds(source, input, srcBounds, dstBounds);
+    }
+
+    SkBitmap inputBM;
+
+    if (!input->getROPixels(&inputBM)) {
+        return nullptr;
+    }
+
+    if (inputBM.colorType() != kN32_SkColorType) {
+        return nullptr;
+    }
+
+    SkBitmap src;
+    inputBM.extractSubset(&src, srcBounds);
+
+    // Make everything relative to the destination bounds.
+    srcBounds.offset(-dstBounds.x(), -dstBounds.y());
+    dstBounds.offset(-dstBounds.x(), -dstBounds.y());
+
+    SkBitmap dst;
+    const int scaleX = downsample_factor(sigma.x()),
+              scaleY = downsample_factor(sigma.y());
+    if (scaleX == 1 && scaleY == 1) {
+        if (!blur_bitmap(windowW, windowH, src, srcBounds, dstBounds, &dst)) {
+            return nullptr;
+        }
+    } else {
+        SkBitmap smallSrc, smallDst;
+        SkIRect smallSrcBounds;
+        if (!downsample(src, srcBounds, scaleX, scaleY, &smallSrc, &smallSrcBounds)) {
+            return nullptr;
+        }
+        SkIRect smallDstBounds = SkIRect::MakeWH((dstBounds.width()  + scaleX - 1) / scaleX,
+                                                 (dstBounds.height() + scaleY - 1) / scaleY);
+        if (!blur_bitmap(calculate_window(sigma.x() / scaleX),
+                         calculate_window(sigma.y() / scaleY),
+                         smallSrc, smallSrcBounds, smallDstBounds, &smallDst)) {
+            return nullptr;
+        }
+        if (!dst.tryAllocPixels(inputBM.info().makeWH(dstBounds.width(), dstBounds.height()))) {
+            return nullptr;
+        }
+        upsample(smallDst, scaleX, scaleY, &dst);
     }
 
     return SkSpecialImage::MakeFromRaster(SkIRect::MakeWH(dstBounds.width(),
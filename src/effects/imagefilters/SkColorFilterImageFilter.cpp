@@ -60,8 +60,18 @@ void SkColorFilterImageFilter::flatten(SkWriteBuffer& buffer) const {
 sk_sp<SkSpecialImage> SkColorFilterImageFilter::onFilterImage(SkSpecialImage* source,
                                                               const Context& ctx,
                                                               SkIPoint* offset) const {
+    // Color filters and offsets below this one are applied in the same pass.
     SkIPoint inputOffset = SkIPoint::Make(0, 0);
-    sk_sp<SkSpecialImage> input(this->filterInput(0, source, ctx, &inputOffset));
+    sk_sp<SkColorFilter> inputCF;
+    sk_sp<SkSpecialImage> input(this->filterInputPointwise(0, source, ctx, &inputOffset, &inputCF));
+    sk_sp<SkColorFilter> colorFilter = fColorFilter;
+    if (inputCF) {
+        colorFilter = fColorFilter->makeComposed(inputCF);
+        if (!colorFilter) {
+            input = ApplyColorFilter(std::move(input), std::move(inputCF), ctx.outputProperties());
+            colorFilter = fColorFilter;
+        }
+    }
 
     SkIRect inputBounds;
     if (fColorFilter->affectsTransparentBlack()) {
@@ -90,7 +100,7 @@ sk_sp<SkSpecialImage> SkColorFilterImageFilter::onFilterImage(SkSpecialImage* so
     SkPaint paint;
 
     paint.setBlendMode(SkBlendMode::kSrc);
-    paint.setColorFilter(fColorFilter);
+    paint.setColorFilter(std::move(colorFilter));
 
     // TODO: it may not be necessary to clear or drawPaint inside the input bounds
     // (see skbug.com/5075)
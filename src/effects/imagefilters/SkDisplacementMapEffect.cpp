@@ -10,6 +10,7 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkUnPreMultiply.h"
 #include "include/private/SkColorData.h"
+#include "include/private/SkNx.h"
 #include "src/core/SkImageFilterPriv.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkSpecialImage.h"
@@ -57,6 +58,34 @@ struct Extractor {
     unsigned getY(SkColor c) const { return (c >> fShiftY) & 0xFF; }
 };
 
+using Sk8u = SkNx<8, uint32_t>;
+
+// Where the channel that Extractor reads from an SkColor comes from in an SkPMColor.
+int pmcolor_shift(unsigned colorShift) {
+    switch (colorShift) {
+        case 24: return SK_A32_SHIFT;
+        case 16: return SK_R32_SHIFT;
+        case  8: return SK_G32_SHIFT;
+        default: return SK_B32_SHIFT;
+    }
+}
+
+// Extractor's channel of SkUnPreMultiply::PMColorToColor() for eight pixels, given the scales
+// for their alphas.
+inline Sk8f unpremul_channel8(const Sk8u& pm, const Sk8u& scale, unsigned colorShift) {
+    const Sk8u c = (pm >> pmcolor_shift(colorShift)) & 0xFF;
+    return SkNx_cast<float>(SkNx_cast<int32_t>(24 == colorShift ? c
+                                                                : (scale * c + (1 << 23)) >> 24));
+}
+
+// SkScalarTruncToInt(), but saturating at +-2^30 rather than at the int range, so that adding a
+// pixel coordinate can't overflow. Anything that far off lands outside the source either way.
+inline Sk8i trunc_to_int8(const Sk8f& x) {
+    constexpr float kMax = 1 << 30;
+    const Sk8f min = (x < kMax).thenElse(x, kMax);
+    return SkNx_cast<int32_t>((min > -kMax).thenElse(min, -kMax));
+}
+
 void computeDisplacement(Extractor ex, const SkVector& scale, SkBitmap* dst,
                          const SkBitmap& displ, const SkIPoint& offset,
                          const SkBitmap& src,
@@ -67,10 +96,37 @@ void computeDisplacement(Extractor ex, const SkVector& scale, SkBitmap* dst,
     const SkVector scaleForColor = SkVector::Make(scale.fX * Inv8bit, scale.fY * Inv8bit);
     const SkVector scaleAdj = SkVector::Make(SK_ScalarHalf - scale.fX * SK_ScalarHalf,
                                              SK_ScalarHalf - scale.fY * SK_ScalarHalf);
+    const SkUnPreMultiply::Scale* scaleTable = SkUnPreMultiply::GetScaleTable();
+    const Sk8i laneX = { 0, 1, 2, 3, 4, 5, 6, 7 };
+    const SkPMColor* srcPixels = src.getAddr32(0, 0);
+    const int srcRowPixels = src.rowBytesAsPixels();
     SkPMColor* dstPtr = dst->getAddr32(0, 0);
     for (int y = bounds.top(); y < bounds.bottom(); ++y) {
         const SkPMColor* displPtr = displ.getAddr32(bounds.left() + offset.fX, y + offset.fY);
-        for (int x = bounds.left(); x < bounds.right(); ++x, ++displPtr) {
+        int x = bounds.left();
+        // Eight pixels at a time, with the same math as below. Only the source reads are done a
+        // pixel at a time.
+        for (; x + 8 <= bounds.right(); x += 8, displPtr += 8, dstPtr += 8) {
+            const Sk8u pm = Sk8u::Load(displPtr);
+            uint32_t alphaScale[8];
+            for (int k = 0; k < 8; ++k) {
+                alphaScale[k] = scaleTable[SkGetPackedA32(displPtr[k])];
+            }
+
+            const Sk8f displX = scaleForColor.fX *
+                    unpremul_channel8(pm, Sk8u::Load(alphaScale), ex.fShiftX) + scaleAdj.fX;
+            const Sk8f displY = scaleForColor.fY *
+                    unpremul_channel8(pm, Sk8u::Load(alphaScale), ex.fShiftY) + scaleAdj.fY;
+            const Sk8i srcX = laneX + x + trunc_to_int8(displX);
+            const Sk8i srcY = y + trunc_to_int8(displY);
+            const Sk8i inside = (srcX > -1) & (srcX < srcW) & (srcY > -1) & (srcY < srcH);
+            int32_t index[8];
+            inside.thenElse(srcY * srcRowPixels + srcX, -1).store(index);
+            for (int k = 0; k < 8; ++k) {
+                dstPtr[k] = index[k] < 0 ? 0 : srcPixels[index[k]];
+            }
+        }
+        for (; x < bounds.right(); ++x, ++displPtr) {
             SkColor c = SkUnPreMultiply::PMColorToColor(*displPtr);
 
             SkScalar displX = scaleForColor.fX * ex.getX(c) + scaleAdj.fX;
@@ -10,6 +10,7 @@
 #include "include/core/SkTypes.h"
 #include "include/effects/SkLightingImageFilter.h"
 #include "include/private/SkColorData.h"
+#include "include/private/SkVx.h"
 #include "src/core/SkImageFilterPriv.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkSpecialImage.h"
@@ -77,6 +78,79 @@ static inline void fast_normalize(SkPoint3* vector) {
     vector->fZ *= scale;
 }
 
+// The raster path lights the interior of the bitmap eight pixels at a time, with the same math
+// as the one pixel functions, so the two paths give the same results.
+using float8 = skvx::Vec<8, float>;
+
+// Lane by lane, the same estimate as sk_float_rsqrt().
+static inline float8 fast_rsqrt(const float8& x) {
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE1
+    auto rsqrt4 = [](const skvx::Vec<4, float>& v) {
+        return skvx::bit_pun<skvx::Vec<4, float>>(_mm_rsqrt_ps(skvx::bit_pun<__m128>(v)));
+    };
+    return skvx::join(rsqrt4(x.lo), rsqrt4(x.hi));
+#elif defined(SK_ARM_HAS_NEON)
+    auto rsqrt4 = [](const skvx::Vec<4, float>& v) {
+        const float32x4_t xx = skvx::bit_pun<float32x4_t>(v);
+        float32x4_t estimate = vrsqrteq_f32(xx);
+        const float32x4_t estimate_sq = vmulq_f32(estimate, estimate);
+        estimate = vmulq_f32(estimate, vrsqrtsq_f32(xx, estimate_sq));
+        return skvx::bit_pun<skvx::Vec<4, float>>(estimate);
+    };
+    return skvx::join(rsqrt4(x.lo), rsqrt4(x.hi));
+#else
+    const float8 estimate = skvx::bit_pun<float8>(
+            0x5F1FFFF9 - (skvx::bit_pun<skvx::Vec<8, int32_t>>(x) >> 1));
+    return estimate * (0.703952253f * (2.38924456f - x * (estimate * estimate)));
+#endif
+}
+
+// Lane by lane, SkScalarClampMax(x, 1), including what it does with NaN.
+static inline float8 clamp_to_unit(const float8& x) {
+    const float8 min = skvx::if_then_else(x < 1, x, float8(1));
+    return skvx::if_then_else(0 < min, min, float8(0));
+}
+
+static inline float8 pow8(const float8& base, SkScalar exponent) {
+    if (1 == exponent) {
+        return base;  // What pow() gives exactly, e.g. a spot light's default exponent.
+    }
+    float8 result;
+    for (int i = 0; i < 8; ++i) {
+        result[i] = SkScalarPow(base[i], exponent);
+    }
+    return result;
+}
+
+// Lane by lane, SkClampMax(SkScalarRoundToInt(x), 255). Clamping first lets the conversion
+// truncate, rather than take the floor.
+static inline skvx::Vec<8, uint32_t> round_to_byte(const float8& x) {
+    const float8 clamped = skvx::min(skvx::max(x + 0.5f, 0.0f), 255.0f);
+    return skvx::cast<uint32_t>(skvx::cast<int32_t>(clamped));
+}
+
+// Eight SkPoint3s, one per lane.
+struct Point3x8 {
+    float8 fX, fY, fZ;
+
+    static Point3x8 Make(const SkPoint3& p) { return { p.fX, p.fY, p.fZ }; }
+
+    float8 dot(const Point3x8& p) const { return fX * p.fX + fY * p.fY + fZ * p.fZ; }
+
+    void scale(const float8& s) {
+        fX *= s;
+        fY *= s;
+        fZ *= s;
+    }
+
+    void fastNormalize() { this->scale(fast_rsqrt(this->dot(*this) + SK_ScalarNearlyZero)); }
+};
+
+// The x coordinates of the eight pixels starting at x.
+static inline float8 lane_x(int x) {
+    return float8{ 0, 1, 2, 3, 4, 5, 6, 7 } + SkIntToScalar(x);
+}
+
 static SkPoint3 read_point3(SkReadBuffer& buffer) {
     SkPoint3 point;
     point.fX = buffer.readScalar();
@@ -119,6 +193,13 @@ public:
     virtual SkPoint3 surfaceToLight(int x, int y, int z, SkScalar surfaceScale) const = 0;
     virtual SkPoint3 lightColor(const SkPoint3& surfaceToLight) const = 0;
 
+    // Eight pixels at once, from x to x + 7 in row y, with heights z.
+    virtual Point3x8 surfaceToLight8(int x, int y, const float8& z,
+                                     SkScalar surfaceScale) const = 0;
+    virtual Point3x8 lightColor8(const Point3x8& surfaceToLight) const {
+        return Point3x8::Make(fColor);
+    }
+
 protected:
     SkImageFilterLight(SkColor color) {
         fColor = SkPoint3::Make(SkIntToScalar(SkColorGetR(color)),
@@ -146,8 +227,17 @@ public:
 
     virtual SkPMColor light(const SkPoint3& normal, const SkPoint3& surfaceTolight,
                             const SkPoint3& lightColor) const= 0;
+    virtual void light8(const Point3x8& normal, const Point3x8& surfaceToLight,
+                        const Point3x8& lightColor, SkPMColor dst[8]) const = 0;
 };
 
+static inline void pack_argb8(const skvx::Vec<8, uint32_t>& a, const skvx::Vec<8, uint32_t>& r,
+                              const skvx::Vec<8, uint32_t>& g, const skvx::Vec<8, uint32_t>& b,
+                              SkPMColor dst[8]) {
+    ((a << SK_A32_SHIFT) | (r << SK_R32_SHIFT) | (g << SK_G32_SHIFT) | (b << SK_B32_SHIFT))
+            .store(dst);
+}
+
 class DiffuseLightingType : public BaseLightingType {
 public:
     DiffuseLightingType(SkScalar kd)
@@ -162,6 +252,14 @@ public:
                             SkClampMax(SkScalarRoundToInt(color.fY), 255),
                             SkClampMax(SkScalarRoundToInt(color.fZ), 255));
     }
+    void light8(const Point3x8& normal, const Point3x8& surfaceTolight,
+                const Point3x8& lightColor, SkPMColor dst[8]) const override {
+        const float8 colorScale = clamp_to_unit(fKD * normal.dot(surfaceTolight));
+        Point3x8 color = lightColor;
+        color.scale(colorScale);
+        pack_argb8(255, round_to_byte(color.fX), round_to_byte(color.fY),
+                   round_to_byte(color.fZ), dst);
+    }
 private:
     SkScalar fKD;
 };
@@ -187,6 +285,21 @@ public:
                             SkClampMax(SkScalarRoundToInt(color.fY), 255),
                             SkClampMax(SkScalarRoundToInt(color.fZ), 255));
     }
+    void light8(const Point3x8& normal, const Point3x8& surfaceTolight,
+                const Point3x8& lightColor, SkPMColor dst[8]) const override {
+        Point3x8 halfDir = surfaceTolight;
+        halfDir.fZ += SK_Scalar1;        // eye position is always (0, 0, 1)
+        halfDir.fastNormalize();
+        const float8 colorScale = clamp_to_unit(fKS * pow8(normal.dot(halfDir), fShininess));
+        Point3x8 color = lightColor;
+        color.scale(colorScale);
+        const float8 maxComponent = skvx::if_then_else(
+                color.fX > color.fY,
+                skvx::if_then_else(color.fX > color.fZ, color.fX, color.fZ),
+                skvx::if_then_else(color.fY > color.fZ, color.fY, color.fZ));
+        pack_argb8(round_to_byte(maxComponent), round_to_byte(color.fX),
+                   round_to_byte(color.fY), round_to_byte(color.fZ), dst);
+    }
 private:
     SkScalar fKS;
     SkScalar fShininess;
@@ -263,6 +376,10 @@ public:
     static inline uint32_t Fetch(const SkBitmap& src, int x, int y, const SkIRect& bounds) {
         return SkGetPackedA32(*src.getAddr32(x, y));
     }
+    static inline float8 Fetch8(const SkBitmap& src, int x, int y, const SkIRect& bounds) {
+        const auto pixels = skvx::Vec<8, uint32_t>::Load(src.getAddr32(x, y));
+        return skvx::cast<float>(skvx::cast<int32_t>((pixels >> SK_A32_SHIFT) & 0xFF));
+    }
 };
 
 // The DecalPixelFetcher is used when the destination crop rect exceeds the input bitmap bounds.
@@ -275,8 +392,43 @@ public:
             return SkGetPackedA32(*src.getAddr32(x, y));
         }
     }
+    static inline float8 Fetch8(const SkBitmap& src, int x, int y, const SkIRect& bounds) {
+        float8 alphas;
+        for (int i = 0; i < 8; ++i) {
+            alphas[i] = SkIntToScalar(Fetch(src, x + i, y, bounds));
+        }
+        return alphas;
+    }
 };
 
+// Lights the interior pixels x to x + 7 of row y, like interiorNormal() does one at a time.
+template <class PixelFetcher>
+static inline void light_interior8(const BaseLightingType& lightingType,
+                                   const SkImageFilterLight* l,
+                                   const SkBitmap& src,
+                                   int x, int y,
+                                   SkScalar surfaceScale,
+                                   const SkIRect& srcBounds,
+                                   SkPMColor dst[8]) {
+    const float8 m0 = PixelFetcher::Fetch8(src, x - 1, y - 1, srcBounds),
+                 m1 = PixelFetcher::Fetch8(src, x,     y - 1, srcBounds),
+                 m2 = PixelFetcher::Fetch8(src, x + 1, y - 1, srcBounds),
+                 m3 = PixelFetcher::Fetch8(src, x - 1, y,     srcBounds),
+                 m4 = PixelFetcher::Fetch8(src, x,     y,     srcBounds),
+                 m5 = PixelFetcher::Fetch8(src, x + 1, y,     srcBounds),
+                 m6 = PixelFetcher::Fetch8(src, x - 1, y + 1, srcBounds),
+                 m7 = PixelFetcher::Fetch8(src, x,     y + 1, srcBounds),
+                 m8 = PixelFetcher::Fetch8(src, x + 1, y + 1, srcBounds);
+    // The sums are of small integers, so they're exact in any order.
+    const float8 sobelX = (m2 - m0 + 2 * (m5 - m3) + m8 - m6) * gOneQuarter,
+                 sobelY = (m6 - m0 + 2 * (m7 - m1) + m8 - m2) * gOneQuarter;
+    Point3x8 normal = { -sobelX * surfaceScale, -sobelY * surfaceScale, 1 };
+    normal.fastNormalize();
+
+    const Point3x8 surfaceToLight = l->surfaceToLight8(x, y, m4, surfaceScale);
+    lightingType.light8(normal, surfaceToLight, l->lightColor8(surfaceToLight), dst);
+}
+
 template <class PixelFetcher>
 static void lightBitmap(const BaseLightingType& lightingType,
                  const SkImageFilterLight* l,
@@ -327,7 +479,21 @@ static void lightBitmap(const BaseLightingType& lightingType,
         SkPoint3 surfaceToLight = l->surfaceToLight(x, y, m[4], surfaceScale);
         *dptr++ = lightingType.light(leftNormal(m, surfaceScale), surfaceToLight,
                                      l->lightColor(surfaceToLight));
-        for (++x; x < right - 1; ++x) {
+        ++x;
+        if (x + 8 <= right - 1) {
+            for (; x + 8 <= right - 1; x += 8, dptr += 8) {
+                light_interior8<PixelFetcher>(lightingType, l, src, x, y, surfaceScale,
+                                              srcBounds, dptr);
+            }
+            // Pick the matrix back up as the one pixel loop expects it.
+            m[1] = PixelFetcher::Fetch(src, x - 1, y - 1, srcBounds);
+            m[2] = PixelFetcher::Fetch(src, x,     y - 1, srcBounds);
+            m[4] = PixelFetcher::Fetch(src, x - 1, y,     srcBounds);
+            m[5] = PixelFetcher::Fetch(src, x,     y,     srcBounds);
+            m[7] = PixelFetcher::Fetch(src, x - 1, y + 1, srcBounds);
+            m[8] = PixelFetcher::Fetch(src, x,     y + 1, srcBounds);
+        }
+        for (; x < right - 1; ++x) {
             shiftMatrixLeft(m);
             m[2] = PixelFetcher::Fetch(src, x + 1, y - 1, srcBounds);
             m[5] = PixelFetcher::Fetch(src, x + 1, y,     srcBounds);
@@ -831,6 +997,10 @@ public:
         return fDirection;
     }
     SkPoint3 lightColor(const SkPoint3&) const override { return this->color(); }
+    Point3x8 surfaceToLight8(int x, int y, const float8& z,
+                             SkScalar surfaceScale) const override {
+        return Point3x8::Make(fDirection);
+    }
     LightType type() const override { return kDistant_LightType; }
     const SkPoint3& direction() const { return fDirection; }
     GrGLLight* createGLLight() const override {
@@ -887,6 +1057,14 @@ public:
         fast_normalize(&direction);
         return direction;
     }
+    Point3x8 surfaceToLight8(int x, int y, const float8& z,
+                             SkScalar surfaceScale) const override {
+        Point3x8 direction = { fLocation.fX - lane_x(x),
+                               fLocation.fY - SkIntToScalar(y),
+                               fLocation.fZ - z * surfaceScale };
+        direction.fastNormalize();
+        return direction;
+    }
     SkPoint3 lightColor(const SkPoint3&) const override { return this->color(); }
     LightType type() const override { return kPoint_LightType; }
     const SkPoint3& location() const { return fLocation; }
@@ -991,6 +1169,14 @@ public:
         fast_normalize(&direction);
         return direction;
     }
+    Point3x8 surfaceToLight8(int x, int y, const float8& z,
+                             SkScalar surfaceScale) const override {
+        Point3x8 direction = { fLocation.fX - lane_x(x),
+                               fLocation.fY - SkIntToScalar(y),
+                               fLocation.fZ - z * surfaceScale };
+        direction.fastNormalize();
+        return direction;
+    }
     SkPoint3 lightColor(const SkPoint3& surfaceToLight) const override {
         SkScalar cosAngle = -surfaceToLight.dot(fS);
         SkScalar scale = 0;
@@ -1002,6 +1188,22 @@ public:
         }
         return this->color().makeScale(scale);
     }
+    Point3x8 lightColor8(const Point3x8& surfaceToLight) const override {
+        const float8 cosAngle = -surfaceToLight.dot(Point3x8::Make(fS));
+        const auto inCone = cosAngle >= fCosOuterConeAngle;
+        if (!skvx::any(inCone)) {
+            return Point3x8::Make(SkPoint3::Make(0, 0, 0));
+        }
+        const float8 edgeScale = skvx::if_then_else(cosAngle < fCosInnerConeAngle,
+                                                    (cosAngle - fCosOuterConeAngle) * fConeScale,
+                                                    float8(1));
+        const float8 scale = skvx::if_then_else(inCone,
+                                                pow8(cosAngle, fSpecularExponent) * edgeScale,
+                                                float8(0));
+        Point3x8 color = Point3x8::Make(this->color());
+        color.scale(scale);
+        return color;
+    }
     GrGLLight* createGLLight() const override {
 #if SK_SUPPORT_GPU
         return new GrGLSpotLight;
@@ -10,11 +10,18 @@
 #include "include/core/SkUnPreMultiply.h"
 #include "include/effects/SkMatrixConvolutionImageFilter.h"
 #include "include/private/SkColorData.h"
+#include "include/private/SkNx.h"
+#include "include/private/SkTemplates.h"
 #include "src/core/SkImageFilterPriv.h"
+#include "src/core/SkMathPriv.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkSpecialImage.h"
 #include "src/core/SkWriteBuffer.h"
 
+#include <cmath>
+#include <complex>
+#include <vector>
+
 #if SK_SUPPORT_GPU
 #include "include/gpu/GrContext.h"
 #include "include/private/GrTextureProxy.h"
@@ -25,6 +32,56 @@
 // by the size of a scalar to know how many scalars we can read.
 static const int32_t gMaxKernelSize = SK_MaxS32 / sizeof(SkScalar);
 
+// Kernels with more taps than this, that aren't separable, are evaluated with FFTs on the CPU...
+static const int kMaxDirectKernelArea = 81;
+// ... unless either dimension is larger than this, where the transforms take too much memory.
+static const int kMaxFFTKernelSize = 256;
+
+static bool use_fft(const SkISize& kernelSize, bool separable) {
+    return !separable &&
+           kernelSize.width() * kernelSize.height() > kMaxDirectKernelArea &&
+           kernelSize.width() <= kMaxFFTKernelSize && kernelSize.height() <= kMaxFFTKernelSize;
+}
+
+// If 'kernel' is the outer product of a column and a row, to within float precision, returns
+// the row followed by the column. Convolving with each in turn takes width + height taps per
+// pixel, rather than width * height.
+static std::unique_ptr<SkScalar[]> factor_separable_kernel(const SkScalar* kernel,
+                                                           const SkISize& kernelSize) {
+    const int width = kernelSize.width(), height = kernelSize.height();
+    int pivot = 0;
+    for (int i = 1; i < width * height; ++i) {
+        if (SkScalarAbs(kernel[i]) > SkScalarAbs(kernel[pivot])) {
+            pivot = i;
+        }
+    }
+    const SkScalar maxAbs = SkScalarAbs(kernel[pivot]);
+    if (0 == maxAbs) {
+        return nullptr;
+    }
+
+    std::unique_ptr<SkScalar[]> factors(new SkScalar[width + height]);
+    SkScalar* row = factors.get();
+    SkScalar* column = row + width;
+    const int pivotX = pivot % width, pivotY = pivot / width;
+    for (int x = 0; x < width; ++x) {
+        row[x] = kernel[pivotY * width + x] / kernel[pivot];
+    }
+    for (int y = 0; y < height; ++y) {
+        column[y] = kernel[y * width + pivotX];
+    }
+
+    const SkScalar tolerance = maxAbs * (1.0f / (1 << 16));
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            if (!SkScalarNearlyEqual(kernel[y * width + x], column[y] * row[x], tolerance)) {
+                return nullptr;
+            }
+        }
+    }
+    return factors;
+}
+
 SkMatrixConvolutionImageFilter::SkMatrixConvolutionImageFilter(const SkISize& kernelSize,
                                                                const SkScalar* kernel,
                                                                SkScalar gain,
@@ -45,6 +102,9 @@ SkMatrixConvolutionImageFilter::SkMatrixConvolutionImageFilter(const SkISize& ke
     fKernel = new SkScalar[size];
     memcpy(fKernel, kernel, size * sizeof(SkScalar));
     SkASSERT(kernelSize.fWidth >= 1 && kernelSize.fHeight >= 1);
+    if (kernelSize.fWidth > 1 && kernelSize.fHeight > 1) {
+        fSeparableKernel = factor_separable_kernel(fKernel, fKernelSize);
+    }
     SkASSERT(kernelOffset.fX >= 0 && kernelOffset.fX < kernelSize.fWidth);
     SkASSERT(kernelOffset.fY >= 0 && kernelOffset.fY < kernelSize.fHeight);
 }
@@ -171,6 +231,36 @@ public:
     }
 };
 
+template<class PixelFetcher, bool convolveAlpha>
+static inline SkPMColor pack_result(SkScalar sumA, SkScalar sumR, SkScalar sumG, SkScalar sumB,
+                                    SkScalar gain, SkScalar bias,
+                                    const SkBitmap& src, int x, int y, const SkIRect& bounds) {
+    int a = convolveAlpha
+          ? SkClampMax(SkScalarFloorToInt(sumA * gain + bias), 255)
+          : 255;
+    int r = SkClampMax(SkScalarFloorToInt(sumR * gain + bias), a);
+    int g = SkClampMax(SkScalarFloorToInt(sumG * gain + bias), a);
+    int b = SkClampMax(SkScalarFloorToInt(sumB * gain + bias), a);
+    if (!convolveAlpha) {
+        a = SkGetPackedA32(PixelFetcher::fetch(src, x, y, bounds));
+        return SkPreMultiplyARGB(a, r, g, b);
+    } else {
+        return SkPackARGB32(a, r, g, b);
+    }
+}
+
+static inline Sk4f unpack(SkPMColor c) {
+    return SkNx_cast<float>(Sk4b::Load(&c));
+}
+
+template<class PixelFetcher, bool convolveAlpha>
+static inline SkPMColor pack_result(const Sk4f& sum, SkScalar gain, SkScalar bias,
+                                    const SkBitmap& src, int x, int y, const SkIRect& bounds) {
+    return pack_result<PixelFetcher, convolveAlpha>(sum[SK_A32_SHIFT / 8], sum[SK_R32_SHIFT / 8],
+                                                    sum[SK_G32_SHIFT / 8], sum[SK_B32_SHIFT / 8],
+                                                    gain, bias, src, x, y, bounds);
+}
+
 template<class PixelFetcher, bool convolveAlpha>
 void SkMatrixConvolutionImageFilter::filterPixels(const SkBitmap& src,
                                                   SkBitmap* result,
@@ -181,6 +271,22 @@ void SkMatrixConvolutionImageFilter::filterPixels(const SkBitmap& src,
     if (!rect.intersect(bounds)) {
         return;
     }
+    if (fSeparableKernel) {
+        this->filterPixelsSeparable<PixelFetcher, convolveAlpha>(src, result, offset, rect,
+                                                                 bounds);
+    } else if (use_fft(fKernelSize, false)) {
+        this->filterPixelsFFT<PixelFetcher, convolveAlpha>(src, result, offset, rect, bounds);
+    } else {
+        this->filterPixelsDirect<PixelFetcher, convolveAlpha>(src, result, offset, rect, bounds);
+    }
+}
+
+template<class PixelFetcher, bool convolveAlpha>
+void SkMatrixConvolutionImageFilter::filterPixelsDirect(const SkBitmap& src,
+                                                        SkBitmap* result,
+                                                        SkIVector& offset,
+                                                        const SkIRect& rect,
+                                                        const SkIRect& bounds) const {
     for (int y = rect.fTop; y < rect.fBottom; ++y) {
         SkPMColor* dptr = result->getAddr32(rect.fLeft - offset.fX, y - offset.fY);
         for (int x = rect.fLeft; x < rect.fRight; ++x) {
@@ -200,17 +306,189 @@ void SkMatrixConvolutionImageFilter::filterPixels(const SkBitmap& src,
                     sumB += SkGetPackedB32(s) * k;
                 }
             }
-            int a = convolveAlpha
-                  ? SkClampMax(SkScalarFloorToInt(sumA * fGain + fBias), 255)
-                  : 255;
-            int r = SkClampMax(SkScalarFloorToInt(sumR * fGain + fBias), a);
-            int g = SkClampMax(SkScalarFloorToInt(sumG * fGain + fBias), a);
-            int b = SkClampMax(SkScalarFloorToInt(sumB * fGain + fBias), a);
-            if (!convolveAlpha) {
-                a = SkGetPackedA32(PixelFetcher::fetch(src, x, y, bounds));
-                *dptr++ = SkPreMultiplyARGB(a, r, g, b);
-            } else {
-                *dptr++ = SkPackARGB32(a, r, g, b);
+            *dptr++ = pack_result<PixelFetcher, convolveAlpha>(sumA, sumR, sumG, sumB,
+                                                               fGain, fBias, src, x, y, bounds);
+        }
+    }
+}
+
+// The tile modes all treat x and y independently, so a separable kernel can be applied as a
+// horizontal pass over every source row that's needed, followed by a vertical pass.
+template<class PixelFetcher, bool convolveAlpha>
+void SkMatrixConvolutionImageFilter::filterPixelsSeparable(const SkBitmap& src,
+                                                           SkBitmap* result,
+                                                           SkIVector& offset,
+                                                           const SkIRect& rect,
+                                                           const SkIRect& bounds) const {
+    const SkScalar* kernelX = fSeparableKernel.get();
+    const SkScalar* kernelY = kernelX + fKernelSize.fWidth;
+    const int width = rect.width();
+    const int rows = rect.height() + fKernelSize.fHeight - 1;
+
+    SkAutoTMalloc<float> horizontal(SkToSizeT(sk_64_mul(width, rows)) * 4);
+    for (int j = 0; j < rows; ++j) {
+        const int y = rect.fTop - fKernelOffset.fY + j;
+        float* h = horizontal.get() + j * width * 4;
+        for (int x = rect.fLeft; x < rect.fRight; ++x, h += 4) {
+            Sk4f sum(0);
+            for (int cx = 0; cx < fKernelSize.fWidth; cx++) {
+                sum += unpack(PixelFetcher::fetch(src, x + cx - fKernelOffset.fX, y, bounds)) *
+                       kernelX[cx];
+            }
+            sum.store(h);
+        }
+    }
+
+    for (int y = rect.fTop; y < rect.fBottom; ++y) {
+        SkPMColor* dptr = result->getAddr32(rect.fLeft - offset.fX, y - offset.fY);
+        const float* h = horizontal.get() + (y - rect.fTop) * width * 4;
+        for (int i = 0; i < width; ++i) {
+            Sk4f sum(0);
+            for (int cy = 0; cy < fKernelSize.fHeight; cy++) {
+                sum += Sk4f::Load(h + (cy * width + i) * 4) * kernelY[cy];
+            }
+            *dptr++ = pack_result<PixelFetcher, convolveAlpha>(sum, fGain, fBias,
+                                                               src, rect.fLeft + i, y, bounds);
+        }
+    }
+}
+
+namespace {
+
+using Complex = std::complex<float>;
+
+// Written out, to skip the checks for infinities in std::complex's operator*.
+inline Complex multiply(const Complex& a, const Complex& b) {
+    return Complex(a.real() * b.real() - a.imag() * b.imag(),
+                   a.real() * b.imag() + a.imag() * b.real());
+}
+
+// An in-place radix-2 FFT of a fixed power of two length, along a strided line of values.
+class FFT {
+public:
+    explicit FFT(int n) : fN(n), fTwiddles(n / 2) {
+        SkASSERT(SkIsPow2(n));
+        for (int i = 0; i < n / 2; ++i) {
+            const double theta = -2 * 3.14159265358979323846 * i / n;
+            fTwiddles[i] = Complex((float)std::cos(theta), (float)std::sin(theta));
+        }
+    }
+
+    int size() const { return fN; }
+
+    // The inverse is unnormalized; the caller scales by 1/n.
+    void transform(Complex* data, int stride, bool inverse) const {
+        for (int i = 1, j = 0; i < fN; ++i) {
+            int bit = fN >> 1;
+            for (; j & bit; bit >>= 1) {
+                j ^= bit;
+            }
+            j ^= bit;
+            if (i < j) {
+                std::swap(data[i * stride], data[j * stride]);
+            }
+        }
+        for (int len = 2; len <= fN; len <<= 1) {
+            const int half = len / 2, step = fN / len;
+            for (int i = 0; i < fN; i += len) {
+                for (int j = 0; j < half; ++j) {
+                    const Complex w = inverse ? std::conj(fTwiddles[j * step])
+                                              : fTwiddles[j * step];
+                    Complex& a = data[(i + j) * stride];
+                    Complex& b = data[(i + j + half) * stride];
+                    const Complex t = multiply(b, w);
+                    b = a - t;
+                    a += t;
+                }
+            }
+        }
+    }
+
+private:
+    int                  fN;
+    std::vector<Complex> fTwiddles;
+};
+
+void transform_2d(const FFT& fftX, const FFT& fftY, Complex* data, bool inverse) {
+    const int width = fftX.size(), height = fftY.size();
+    for (int y = 0; y < height; ++y) {
+        fftX.transform(data + y * width, 1, inverse);
+    }
+    for (int x = 0; x < width; ++x) {
+        fftY.transform(data + x, width, inverse);
+    }
+}
+
+}  // namespace
+
+// Large kernels are applied by overlap-save: the output is cut into tiles, and each tile's source
+// block (with the tile mode applied) is multiplied by the kernel in the frequency domain. The
+// cyclic convolution only wraps around into the last kernel width - 1 columns and height - 1 rows
+// of the block, which aren't part of the tile. Each complex transform carries two channels, one
+// in the real part and one in the imaginary part, which works because the kernel is real.
+template<class PixelFetcher, bool convolveAlpha>
+void SkMatrixConvolutionImageFilter::filterPixelsFFT(const SkBitmap& src,
+                                                     SkBitmap* result,
+                                                     SkIVector& offset,
+                                                     const SkIRect& rect,
+                                                     const SkIRect& bounds) const {
+    const int kernelW = fKernelSize.fWidth, kernelH = fKernelSize.fHeight;
+    // Tiles are at least as big as the kernel, so the block isn't mostly overlap.
+    const int blockW = SkNextPow2(SkTMin(rect.width(), SkTMax(kernelW, 32)) + kernelW - 1);
+    const int blockH = SkNextPow2(SkTMin(rect.height(), SkTMax(kernelH, 32)) + kernelH - 1);
+    const int tileW = blockW - kernelW + 1, tileH = blockH - kernelH + 1;
+    const FFT fftX(blockW), fftY(blockH);
+
+    // The filter correlates the source with the kernel, so transform it flipped, with its first
+    // tap at the origin. The inverse transform's 1/n is folded in here.
+    std::vector<Complex> kernel(blockW * blockH);
+    const float scale = 1.0f / (blockW * blockH);
+    for (int cy = 0; cy < kernelH; ++cy) {
+        for (int cx = 0; cx < kernelW; ++cx) {
+            kernel[((blockH - cy) % blockH) * blockW + (blockW - cx) % blockW] =
+                    fKernel[cy * kernelW + cx] * scale;
+        }
+    }
+    transform_2d(fftX, fftY, kernel.data(), false);
+
+    std::vector<Complex> rg(blockW * blockH), ba(blockW * blockH);
+    for (int tileY = rect.fTop; tileY < rect.fBottom; tileY += tileH) {
+        const int h = SkTMin(tileH, rect.fBottom - tileY);
+        for (int tileX = rect.fLeft; tileX < rect.fRight; tileX += tileW) {
+            const int w = SkTMin(tileW, rect.fRight - tileX);
+
+            // Only fetch the pixels this tile reads; the rest of the block is left zero.
+            std::fill(rg.begin(), rg.end(), Complex(0));
+            std::fill(ba.begin(), ba.end(), Complex(0));
+            for (int v = 0; v < h + kernelH - 1; ++v) {
+                const int y = tileY - fKernelOffset.fY + v;
+                for (int u = 0; u < w + kernelW - 1; ++u) {
+                    SkPMColor s = PixelFetcher::fetch(src, tileX - fKernelOffset.fX + u, y,
+                                                      bounds);
+                    rg[v * blockW + u] = Complex(SkGetPackedR32(s), SkGetPackedG32(s));
+                    ba[v * blockW + u] = Complex(SkGetPackedB32(s), SkGetPackedA32(s));
+                }
+            }
+
+            transform_2d(fftX, fftY, rg.data(), false);
+            transform_2d(fftX, fftY, ba.data(), false);
+            for (int i = 0; i < blockW * blockH; ++i) {
+                rg[i] = multiply(rg[i], kernel[i]);
+                ba[i] = multiply(ba[i], kernel[i]);
+            }
+            transform_2d(fftX, fftY, rg.data(), true);
+            transform_2d(fftX, fftY, ba.data(), true);
+
+            for (int j = 0; j < h; ++j) {
+                const int y = tileY + j;
+                SkPMColor* dptr = result->getAddr32(tileX - offset.fX, y - offset.fY);
+                for (int i = 0; i < w; ++i) {
+                    const Complex& c0 = rg[j * blockW + i];
+                    const Complex& c1 = ba[j * blockW + i];
+                    *dptr++ = pack_result<PixelFetcher, convolveAlpha>(
+                            c1.imag(), c0.real(), c0.imag(), c1.real(), fGain, fBias,
+                            src, tileX + i, y, bounds);
+                }
             }
         }
     }
@@ -425,11 +703,17 @@ sk_sp<SkSpecialImage> SkMatrixConvolutionImageFilter::onFilterImage(SkSpecialIma
 
     SkIVector dstContentOffset = { offset->fX - inputOffset.fX, offset->fY - inputOffset.fY };
 
-    this->filterBorderPixels(inputBM, &dst, dstContentOffset, top, srcBounds);
-    this->filterBorderPixels(inputBM, &dst, dstContentOffset, left, srcBounds);
-    this->filterInteriorPixels(inputBM, &dst, dstContentOffset, interior, srcBounds);
-    this->filterBorderPixels(inputBM, &dst, dstContentOffset, right, srcBounds);
-    this->filterBorderPixels(inputBM, &dst, dstContentOffset, bottom, srcBounds);
+    if (use_fft(fKernelSize, SkToBool(fSeparableKernel))) {
+        // The transforms dominate the cost of fetching, so this is done in one piece rather
+        // than as thin border strips.
+        this->filterBorderPixels(inputBM, &dst, dstContentOffset, dstBounds, srcBounds);
+    } else {
+        this->filterBorderPixels(inputBM, &dst, dstContentOffset, top, srcBounds);
+        this->filterBorderPixels(inputBM, &dst, dstContentOffset, left, srcBounds);
+        this->filterInteriorPixels(inputBM, &dst, dstContentOffset, interior, srcBounds);
+        this->filterBorderPixels(inputBM, &dst, dstContentOffset, right, srcBounds);
+        this->filterBorderPixels(inputBM, &dst, dstContentOffset, bottom, srcBounds);
+    }
 
     return SkSpecialImage::MakeFromRaster(SkIRect::MakeWH(dstBounds.width(), dstBounds.height()),
                                           dst);
@@ -10,6 +10,8 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkRect.h"
 #include "include/private/SkColorData.h"
+#include "include/private/SkNx.h"
+#include "include/private/SkTemplates.h"
 #include "src/core/SkImageFilterPriv.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkSpecialImage.h"
@@ -641,6 +643,84 @@ namespace {
         }
     }
 #endif
+
+    // From this radius on, morph_van_herk() beats taking the extreme of each pixel's window.
+    static constexpr int kVanHerkMinRadius = 2;
+
+    // Loads one pixel of each of four lines, |stride| apart, into a vector. If there are fewer
+    // than four lines left, the last one is repeated.
+    static inline Sk16b load_lines(const SkPMColor* src, int stride, int lines) {
+        if (stride == 1 && lines == 4) {
+            return Sk16b::Load(src);
+        }
+        SkPMColor pixels[4];
+        for (int i = 0; i < 4; ++i) {
+            pixels[i] = src[SkTMin(i, lines - 1) * stride];
+        }
+        return Sk16b::Load(pixels);
+    }
+
+    static inline void store_lines(const Sk16b& v, SkPMColor* dst, int stride, int lines) {
+        if (stride == 1 && lines == 4) {
+            v.store(dst);
+            return;
+        }
+        SkPMColor pixels[4];
+        v.store(pixels);
+        for (int i = 0; i < lines; ++i) {
+            dst[i * stride] = pixels[i];
+        }
+    }
+
+    // The van Herk/Gil-Werman algorithm, which takes three min/max per pixel whatever the radius.
+    // Each line is padded with |radius| pixels that don't change the result on either side, and
+    // split into blocks as long as the window, 2 * radius + 1. A window then covers the end of
+    // one block and the start of the next, so its extreme is the extreme of the block suffix that
+    // starts at its first pixel and the block prefix that ends at its last one. Four lines are
+    // done at once, with one pixel of each in a vector.
+    template<MorphType type, MorphDirection direction>
+    static void morph_van_herk(const SkPMColor* src, SkPMColor* dst,
+                               int radius, int width, int height, int srcStride, int dstStride) {
+        const int srcStrideX = direction == MorphDirection::kX ? 1 : srcStride;
+        const int dstStrideX = direction == MorphDirection::kX ? 1 : dstStride;
+        const int srcStrideY = direction == MorphDirection::kX ? srcStride : 1;
+        const int dstStrideY = direction == MorphDirection::kX ? dstStride : 1;
+        radius = SkMin32(radius, width - 1);
+        const int window = 2 * radius + 1;
+        const int padded = width + 2 * radius;
+
+        auto extreme = [](const Sk16b& a, const Sk16b& b) {
+            return type == kDilate ? Sk16b::Max(a, b) : Sk16b::Min(a, b);
+        };
+        const Sk16b padding(type == kDilate ? 0 : 255);
+
+        SkAutoTMalloc<Sk16b> prefix(padded), suffix(padded);
+        for (int y = 0; y < height; y += 4) {
+            const int lines = SkTMin(4, height - y);
+            const SkPMColor* lineSrc = src + y * srcStrideY;
+            SkPMColor* lineDst = dst + y * dstStrideY;
+            auto load = [&](int i) {
+                const int x = i - radius;
+                return (x < 0 || x >= width) ? padding
+                                             : load_lines(lineSrc + x * srcStrideX, srcStrideY,
+                                                          lines);
+            };
+
+            for (int i = 0; i < padded; ++i) {
+                const Sk16b p = load(i);
+                prefix[i] = (i % window == 0) ? p : extreme(prefix[i - 1], p);
+            }
+            for (int i = padded - 1; i >= 0; --i) {
+                const Sk16b p = load(i);
+                suffix[i] = (i % window == window - 1 || i == padded - 1)
+                          ? p : extreme(suffix[i + 1], p);
+            }
+            for (int x = 0; x < width; ++x) {
+                store_lines(extreme(suffix[x], prefix[x + 2 * radius]), lineDst + x * dstStrideX,
+                            dstStrideY, lines);
+            }
+        }
+    }
 }  // namespace
 
 sk_sp<SkSpecialImage> SkMorphologyImageFilter::onFilterImage(SkSpecialImage* source,
@@ -721,11 +801,15 @@ sk_sp<SkSpecialImage> SkMorphologyImageFilter::onFilterImage(SkSpecialImage* sou
     SkMorphologyImageFilter::Proc procX, procY;
 
     if (kDilate_Op == this->op()) {
-        procX = &morph<kDilate, MorphDirection::kX>;
-        procY = &morph<kDilate, MorphDirection::kY>;
+        procX = width  >= kVanHerkMinRadius ? &morph_van_herk<kDilate, MorphDirection::kX>
+                                            : &morph<kDilate, MorphDirection::kX>;
+        procY = height >= kVanHerkMinRadius ? &morph_van_herk<kDilate, MorphDirection::kY>
+                                            : &morph<kDilate, MorphDirection::kY>;
     } else {
-        procX = &morph<kErode,  MorphDirection::kX>;
-        procY = &morph<kErode,  MorphDirection::kY>;
+        procX = width  >= kVanHerkMinRadius ? &morph_van_herk<kErode,  MorphDirection::kX>
+                                            : &morph<kErode,  MorphDirection::kX>;
+        procY = height >= kVanHerkMinRadius ? &morph_van_herk<kErode,  MorphDirection::kY>
+                                            : &morph<kErode,  MorphDirection::kY>;
     }
 
     if (width > 0 && height > 0) {
@@ -94,6 +94,14 @@ SkIRect SkOffsetImageFilter::onFilterNodeBounds(const SkIRect& src, const SkMatr
     return src.makeOffset(vec.fX, vec.fY);
 }
 
+bool SkOffsetImageFilter::onIsOffsetNode(const SkMatrix& ctm, SkIPoint* offset) const {
+    if (this->cropRectIsSet()) {
+        return false;
+    }
+    *offset = map_offset_vector(ctm, fOffset);
+    return true;
+}
+
 sk_sp<SkFlattenable> SkOffsetImageFilter::CreateProc(SkReadBuffer& buffer) {
     SK_IMAGEFILTER_UNFLATTEN_COMMON(common, 1);
     SkPoint offset;
@@ -6,6 +6,7 @@
  */
 
 #include "include/core/SkCanvas.h"
+#include "include/core/SkColorFilter.h"
 #include "include/effects/SkArithmeticImageFilter.h"
 #include "include/effects/SkXfermodeImageFilter.h"
 #include "include/private/SkColorData.h"
@@ -19,6 +20,7 @@
 #include "include/private/GrTextureProxy.h"
 #include "src/gpu/GrCaps.h"
 #include "src/gpu/GrClip.h"
+#include "src/gpu/GrColorSpaceInfo.h"
 #include "src/gpu/GrColorSpaceXform.h"
 #include "src/gpu/GrRecordingContextPriv.h"
 #include "src/gpu/GrRenderTargetContext.h"
@@ -46,15 +48,18 @@ protected:
     sk_sp<SkSpecialImage> filterImageGPU(SkSpecialImage* source,
                                          sk_sp<SkSpecialImage> background,
                                          const SkIPoint& backgroundOffset,
+                                         sk_sp<SkColorFilter> backgroundCF,
                                          sk_sp<SkSpecialImage> foreground,
                                          const SkIPoint& foregroundOffset,
+                                         sk_sp<SkColorFilter> foregroundCF,
                                          const SkIRect& bounds,
                                          const OutputProperties& outputProperties) const;
 #endif
 
     void flatten(SkWriteBuffer&) const override;
 
-    void drawForeground(SkCanvas* canvas, SkSpecialImage*, const SkIRect&) const;
+    void drawForeground(SkCanvas* canvas, SkSpecialImage*, const SkIRect&,
+                        sk_sp<SkColorFilter>) const;
 #if SK_SUPPORT_GPU
     std::unique_ptr<GrFragmentProcessor> makeFGFrag(
             std::unique_ptr<GrFragmentProcessor> bgFP) const;
@@ -111,11 +116,16 @@ void SkXfermodeImageFilter_Base::flatten(SkWriteBuffer& buffer) const {
 sk_sp<SkSpecialImage> SkXfermodeImageFilter_Base::onFilterImage(SkSpecialImage* source,
                                                                 const Context& ctx,
                                                                 SkIPoint* offset) const {
+    // Color filters and offsets on the inputs are applied while compositing them.
     SkIPoint backgroundOffset = SkIPoint::Make(0, 0);
-    sk_sp<SkSpecialImage> background(this->filterInput(0, source, ctx, &backgroundOffset));
+    sk_sp<SkColorFilter> backgroundCF;
+    sk_sp<SkSpecialImage> background(this->filterInputPointwise(0, source, ctx, &backgroundOffset,
+                                                                &backgroundCF));
 
     SkIPoint foregroundOffset = SkIPoint::Make(0, 0);
-    sk_sp<SkSpecialImage> foreground(this->filterInput(1, source, ctx, &foregroundOffset));
+    sk_sp<SkColorFilter> foregroundCF;
+    sk_sp<SkSpecialImage> foreground(this->filterInputPointwise(1, source, ctx, &foregroundOffset,
+                                                                &foregroundCF));
 
     SkIRect foregroundBounds = SkIRect::EmptyIRect();
     if (foreground) {
@@ -145,8 +155,8 @@ sk_sp<SkSpecialImage> SkXfermodeImageFilter_Base::onFilterImage(SkSpecialImage*
 #if SK_SUPPORT_GPU
     if (source->isTextureBacked()) {
         return this->filterImageGPU(source,
-                                    background, backgroundOffset,
-                                    foreground, foregroundOffset,
+                                    background, backgroundOffset, std::move(backgroundCF),
+                                    foreground, foregroundOffset, std::move(foregroundCF),
                                     bounds, ctx.outputProperties());
     }
 #endif
@@ -165,12 +175,13 @@ sk_sp<SkSpecialImage> SkXfermodeImageFilter_Base::onFilterImage(SkSpecialImage*
     if (background) {
         SkPaint paint;
         paint.setBlendMode(SkBlendMode::kSrc);
+        paint.setColorFilter(std::move(backgroundCF));
         background->draw(canvas,
                          SkIntToScalar(backgroundOffset.fX), SkIntToScalar(backgroundOffset.fY),
                          &paint);
     }
 
-    this->drawForeground(canvas, foreground.get(), foregroundBounds);
+    this->drawForeground(canvas, foreground.get(), foregroundBounds, std::move(foregroundCF));
 
     return surf->makeImageSnapshot();
 }
@@ -221,11 +232,16 @@ SkIRect SkXfermodeImageFilter_Base::onFilterBounds(const SkIRect& src,
 }
 
 void SkXfermodeImageFilter_Base::drawForeground(SkCanvas* canvas, SkSpecialImage* img,
-                                                const SkIRect& fgBounds) const {
+                                                const SkIRect& fgBounds,
+                                                sk_sp<SkColorFilter> colorFilter) const {
     SkPaint paint;
     paint.setBlendMode(fMode);
     if (img) {
-        img->draw(canvas, SkIntToScalar(fgBounds.fLeft), SkIntToScalar(fgBounds.fTop), &paint);
+        // The color filter leaves transparent black alone, so it isn't needed outside fgBounds.
+        SkPaint imagePaint(paint);
+        imagePaint.setColorFilter(std::move(colorFilter));
+        img->draw(canvas, SkIntToScalar(fgBounds.fLeft), SkIntToScalar(fgBounds.fTop),
+                  &imagePaint);
     }
 
     SkAutoCanvasRestore acr(canvas, true);
@@ -242,14 +258,33 @@ sk_sp<SkSpecialImage> SkXfermodeImageFilter_Base::filterImageGPU(
                                                    SkSpecialImage* source,
                                                    sk_sp<SkSpecialImage> background,
                                                    const SkIPoint& backgroundOffset,
+                                                   sk_sp<SkColorFilter> backgroundCF,
                                                    sk_sp<SkSpecialImage> foreground,
                                                    const SkIPoint& foregroundOffset,
+                                                   sk_sp<SkColorFilter> foregroundCF,
                                                    const SkIRect& bounds,
                                                    const OutputProperties& outputProperties) const {
     SkASSERT(source->isTextureBacked());
 
     auto context = source->getContext();
 
+    // Run the inputs' color filters in the same draw, unless they have no fragment processor.
+    GrColorSpaceInfo dstColorSpaceInfo(sk_ref_sp(outputProperties.colorSpace()),
+                                       SkColorType2GrPixelConfig(outputProperties.colorType()));
+    auto colorFilterFP = [&](sk_sp<SkSpecialImage>* image, sk_sp<SkColorFilter> colorFilter) {
+        std::unique_ptr<GrFragmentProcessor> fp;
+        if (*image && colorFilter) {
+            fp = colorFilter->asFragmentProcessor(context, dstColorSpaceInfo);
+            if (!fp) {
+                *image = ApplyColorFilter(std::move(*image), std::move(colorFilter),
+                                          outputProperties);
+            }
+        }
+        return fp;
+    };
+    auto backgroundCFFP = colorFilterFP(&background, std::move(backgroundCF));
+    auto foregroundCFFP = colorFilterFP(&foreground, std::move(foregroundCF));
+
     sk_sp<GrTextureProxy> backgroundProxy, foregroundProxy;
 
     if (background) {
@@ -275,6 +310,11 @@ sk_sp<SkSpecialImage> SkXfermodeImageFilter_Base::filterImageGPU(
         bgFP = GrColorSpaceXformEffect::Make(std::move(bgFP), background->getColorSpace(),
                                              background->alphaType(),
                                              outputProperties.colorSpace());
+        if (backgroundCFFP) {
+            std::unique_ptr<GrFragmentProcessor> series[] = { std::move(bgFP),
+                                                              std::move(backgroundCFFP) };
+            bgFP = GrFragmentProcessor::RunInSeries(series, 2);
+        }
     } else {
         bgFP = GrConstColorProcessor::Make(SK_PMColor4fTRANSPARENT,
                                            GrConstColorProcessor::InputMode::kIgnore);
@@ -294,6 +334,9 @@ sk_sp<SkSpecialImage> SkXfermodeImageFilter_Base::filterImageGPU(
                                                      foreground->alphaType(),
                                                      outputProperties.colorSpace());
         paint.addColorFragmentProcessor(std::move(foregroundFP));
+        if (foregroundCFFP) {
+            paint.addColorFragmentProcessor(std::move(foregroundCFFP));
+        }
 
         std::unique_ptr<GrFragmentProcessor> xferFP = this->makeFGFrag(std::move(bgFP));
 
@@ -0,0 +1,31 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/gpu/GrBlurDownsampleCache.h"
+
+#include "src/core/SkOpts.h"
+
+#include <cstring>
+
+static_assert(sizeof(GrBlurDownsampleCache::Key) == 14 * sizeof(uint32_t), "key_has_no_padding");
+
+bool GrBlurDownsampleCache::Key::operator==(const Key& that) const {
+    return 0 == memcmp(this, &that, sizeof(Key));
+}
+
+uint32_t GrBlurDownsampleCache::Hash::operator()(const Key& key) const {
+    return SkOpts::hash(&key, sizeof(Key));
+}
+
+sk_sp<GrTextureProxy> GrBlurDownsampleCache::find(const Key& key) const {
+    const sk_sp<GrTextureProxy>* level = fLevels.find(key);
+    return level ? *level : nullptr;
+}
+
+void GrBlurDownsampleCache::add(const Key& key, sk_sp<GrTextureProxy> level) {
+    fLevels.set(key, std::move(level));
+}
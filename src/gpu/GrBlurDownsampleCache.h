@@ -0,0 +1,57 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrBlurDownsampleCache_DEFINED
+#define GrBlurDownsampleCache_DEFINED
+
+#include "include/core/SkRect.h"
+#include "include/private/GrTextureProxy.h"
+#include "include/private/SkTHash.h"
+
+/**
+ * Holds the downsampled levels SkGpuBlurUtils::GaussianBlur makes of its sources, so that other
+ * blurs of the same source recorded before the next flush (e.g. drop shadows with different
+ * sigmas) can start from them instead of redoing the 2x draws. A level is only reused by blurs
+ * that would have drawn exactly the same pixels into it.
+ *
+ * Owned by the GrDrawingManager, which empties it whenever the recorded ops go off to be flushed
+ * or into a DDL: past that point a source proxy's contents may change under the same ID.
+ */
+class GrBlurDownsampleCache {
+public:
+    struct Key {
+        // The source being blurred and the part of it (in its own texture space) that the first
+        // level is drawn from, rounded out to a multiple of the blur's scale factors.
+        uint32_t fSrcProxyID;
+        SkIRect  fSrcRect;
+        // With a texture domain, the offset and domain used to read the source. Zero otherwise.
+        SkIPoint fSrcOffset;
+        SkIRect  fDomain;
+        int32_t  fMode;
+        // How far this level is scaled down from the source in each direction.
+        int32_t  fScaleX;
+        int32_t  fScaleY;
+
+        bool operator==(const Key& that) const;
+    };
+
+    sk_sp<GrTextureProxy> find(const Key&) const;
+    void add(const Key&, sk_sp<GrTextureProxy>);
+
+    void reset() { fLevels.reset(); }
+    int count() const { return fLevels.count(); }
+
+private:
+    struct Hash {
+        uint32_t operator()(const Key&) const;
+    };
+
+    // There are only a few blurs per flush, so this isn't bounded beyond the flush itself.
+    SkTHashMap<Key, sk_sp<GrTextureProxy>, Hash> fLevels;
+};
+
+#endif
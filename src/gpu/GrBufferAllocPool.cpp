@@ -68,6 +68,111 @@ void GrBufferAllocPool::CpuBufferCache::releaseAll() {
 
 //////////////////////////////////////////////////////////////////////////////
 
+constexpr size_t GrBufferAllocPool::RingBuffer::kDefaultSize;
+
+sk_sp<GrBufferAllocPool::RingBuffer> GrBufferAllocPool::RingBuffer::Make(GrGpu* gpu,
+                                                                         GrGpuBufferType type,
+                                                                         size_t size) {
+    void* data = nullptr;
+    sk_sp<GrGpuBuffer> buffer = gpu->createPersistentlyMappedBuffer(size, type, &data);
+    if (!buffer || !data) {
+        return nullptr;
+    }
+    return sk_sp<RingBuffer>(new RingBuffer(gpu, std::move(buffer), data));
+}
+
+GrBufferAllocPool::RingBuffer::RingBuffer(GrGpu* gpu, sk_sp<GrGpuBuffer> buffer, void* data)
+        : fGpu(gpu)
+        , fBuffer(std::move(buffer))
+        , fData(static_cast<char*>(data)) {}
+
+GrBufferAllocPool::RingBuffer::~RingBuffer() {
+    for (const Submission& submission : fSubmissions) {
+        fGpu->deleteFence(submission.fFence);
+    }
+}
+
+void GrBufferAllocPool::RingBuffer::retireSignaledFences() {
+    // Fences signal in the order they were inserted, so stop at the first that hasn't.
+    while (!fSubmissions.empty() && fGpu->waitFence(fSubmissions.front().fFence, 0)) {
+        const Submission& submission = fSubmissions.front();
+        fTail = submission.fEnd;
+        SkASSERT(fBytesInUse >= submission.fBytes);
+        fBytesInUse -= submission.fBytes;
+        fGpu->deleteFence(submission.fFence);
+        fSubmissions.pop_front();
+    }
+    if (!fBytesInUse) {
+        // Nothing is in use, so start again at the front where there's the most contiguous room.
+        fHead = fTail = fLastAllocation = 0;
+    }
+}
+
+void* GrBufferAllocPool::RingBuffer::allocate(size_t size, size_t alignment,
+                                              sk_sp<const GrBuffer>* buffer, size_t* offset) {
+    SkASSERT(buffer);
+    SkASSERT(offset);
+    if (fBuffer->wasDestroyed() || !size || size > fBuffer->size()) {
+        return nullptr;
+    }
+    this->retireSignaledFences();
+    if (fBytesInUse && fHead == fTail) {
+        return nullptr;  // Full.
+    }
+
+    // The free space is [fHead, end) then [0, fTail) when fHead is ahead of fTail, or else just
+    // [fHead, fTail).
+    size_t start = fHead + GrSizeAlignUpPad(fHead, alignment);
+    if (fHead >= fTail) {
+        SkSafeMath safeMath;
+        size_t end = safeMath.add(start, size);
+        if (!safeMath.ok() || end > fBuffer->size()) {
+            // Skip the rest of the buffer and wrap around to the front.
+            if (size > fTail) {
+                return nullptr;
+            }
+            start = 0;
+        }
+    } else if (start > fTail || size > fTail - start) {
+        return nullptr;
+    }
+
+    // When wrapping around, the skipped space at the end is counted as used along with this.
+    size_t consumed = (start >= fHead ? start - fHead : fBuffer->size() - fHead) + size;
+    fHead = start + size;
+    fBytesInUse += consumed;
+    fUnfencedBytes += consumed;
+    fLastAllocation = start;
+
+    *buffer = fBuffer;
+    *offset = start;
+    return fData + start;
+}
+
+void GrBufferAllocPool::RingBuffer::putBack(size_t bytes) {
+    bytes = SkTMin(bytes, SkTMin(fHead - fLastAllocation, fUnfencedBytes));
+    fHead -= bytes;
+    fBytesInUse -= bytes;
+    fUnfencedBytes -= bytes;
+}
+
+void GrBufferAllocPool::RingBuffer::fence() {
+    if (!fUnfencedBytes || fBuffer->wasDestroyed()) {
+        return;
+    }
+    fSubmissions.push_back({fGpu->insertFence(), fHead, fUnfencedBytes});
+    fUnfencedBytes = 0;
+    // A putBack() must not reach back into what was just fenced.
+    fLastAllocation = fHead;
+}
+
+void GrBufferAllocPool::RingBuffer::abandon() {
+    fSubmissions.clear();
+    fHead = fTail = fBytesInUse = fUnfencedBytes = fLastAllocation = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 #ifdef SK_DEBUG
     #define VALIDATE validate
 #else
@@ -86,9 +191,11 @@ void GrBufferAllocPool::CpuBufferCache::releaseAll() {
 constexpr size_t GrBufferAllocPool::kDefaultBufferSize;
 
 GrBufferAllocPool::GrBufferAllocPool(GrGpu* gpu, GrGpuBufferType bufferType,
-                                     sk_sp<CpuBufferCache> cpuBufferCache)
+                                     sk_sp<CpuBufferCache> cpuBufferCache,
+                                     sk_sp<RingBuffer> ringBuffer)
         : fBlocks(8)
         , fCpuBufferCache(std::move(cpuBufferCache))
+        , fRingBuffer(std::move(ringBuffer))
         , fGpu(gpu)
         , fBufferType(bufferType) {}
 
@@ -108,10 +215,18 @@ void GrBufferAllocPool::deleteBlocks() {
 GrBufferAllocPool::~GrBufferAllocPool() {
     VALIDATE();
     this->deleteBlocks();
+    if (fRingBuffer) {
+        fRingBuffer->fence();
+    }
 }
 
 void GrBufferAllocPool::reset() {
     VALIDATE();
+    if (fRingBuffer) {
+        // The draws reading this flush's part of the ring have all been issued by now.
+        fRingBuffer->fence();
+        fRingBytesInUse = 0;
+    }
     fBytesInUse = 0;
     this->deleteBlocks();
     this->resetCpuData(0);
@@ -187,6 +302,13 @@ void* GrBufferAllocPool::makeSpace(size_t size,
     SkASSERT(buffer);
     SkASSERT(offset);
 
+    if (fRingBuffer && fBlocks.empty()) {
+        if (void* ptr = fRingBuffer->allocate(size, alignment, buffer, offset)) {
+            fRingBytesInUse += size;
+            return ptr;
+        }
+    }
+
     if (fBufferPtr) {
         BufferBlock& back = fBlocks.back();
         size_t usedBytes = back.fBuffer->size() - back.fBytesFree;
@@ -242,6 +364,16 @@ void* GrBufferAllocPool::makeSpaceAtLeast(size_t minSize,
     SkASSERT(offset);
     SkASSERT(actualSize);
 
+    if (fRingBuffer && fBlocks.empty()) {
+        for (size_t size : {fallbackSize, minSize}) {
+            if (void* ptr = fRingBuffer->allocate(size, alignment, buffer, offset)) {
+                fRingBytesInUse += size;
+                *actualSize = size;
+                return ptr;
+            }
+        }
+    }
+
     if (fBufferPtr) {
         BufferBlock& back = fBlocks.back();
         size_t usedBytes = back.fBuffer->size() - back.fBytesFree;
@@ -298,9 +430,7 @@ void* GrBufferAllocPool::makeSpaceAtLeast(size_t minSize,
 void GrBufferAllocPool::putBack(size_t bytes) {
     VALIDATE();
 
-    while (bytes) {
-        // caller shouldn't try to put back more than they've taken
-        SkASSERT(!fBlocks.empty());
+    while (bytes && !fBlocks.empty()) {
         BufferBlock& block = fBlocks.back();
         size_t bytesUsed = block.fBuffer->size() - block.fBytesFree;
         if (bytes >= bytesUsed) {
@@ -320,6 +450,13 @@ void GrBufferAllocPool::putBack(size_t bytes) {
             break;
         }
     }
+    if (bytes) {
+        // The rest came from the ring, before there were any blocks.
+        // caller shouldn't try to put back more than they've taken
+        SkASSERT(bytes <= fRingBytesInUse);
+        fRingBuffer->putBack(bytes);
+        fRingBytesInUse -= bytes;
+    }
 
     VALIDATE();
 }
@@ -433,8 +570,10 @@ sk_sp<GrBuffer> GrBufferAllocPool::getBuffer(size_t size) {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-GrVertexBufferAllocPool::GrVertexBufferAllocPool(GrGpu* gpu, sk_sp<CpuBufferCache> cpuBufferCache)
-        : GrBufferAllocPool(gpu, GrGpuBufferType::kVertex, std::move(cpuBufferCache)) {}
+GrVertexBufferAllocPool::GrVertexBufferAllocPool(GrGpu* gpu, sk_sp<CpuBufferCache> cpuBufferCache,
+                                                 sk_sp<RingBuffer> ringBuffer)
+        : GrBufferAllocPool(gpu, GrGpuBufferType::kVertex, std::move(cpuBufferCache),
+                            std::move(ringBuffer)) {}
 
 void* GrVertexBufferAllocPool::makeSpace(size_t vertexSize,
                                          int vertexCount,
@@ -486,8 +625,10 @@ void* GrVertexBufferAllocPool::makeSpaceAtLeast(size_t vertexSize, int minVertex
 
 ////////////////////////////////////////////////////////////////////////////////
 
-GrIndexBufferAllocPool::GrIndexBufferAllocPool(GrGpu* gpu, sk_sp<CpuBufferCache> cpuBufferCache)
-        : GrBufferAllocPool(gpu, GrGpuBufferType::kIndex, std::move(cpuBufferCache)) {}
+GrIndexBufferAllocPool::GrIndexBufferAllocPool(GrGpu* gpu, sk_sp<CpuBufferCache> cpuBufferCache,
+                                               sk_sp<RingBuffer> ringBuffer)
+        : GrBufferAllocPool(gpu, GrGpuBufferType::kIndex, std::move(cpuBufferCache),
+                            std::move(ringBuffer)) {}
 
 void* GrIndexBufferAllocPool::makeSpace(int indexCount, sk_sp<const GrBuffer>* buffer,
                                         int* startIndex) {
@@ -16,7 +16,10 @@
 #include "src/gpu/GrCpuBuffer.h"
 #include "src/gpu/GrNonAtomicRef.h"
 
+#include <deque>
+
 class GrGpu;
+class GrGpuBuffer;
 
 /**
  * A pool of geometry buffers tied to a GrGpu.
@@ -56,6 +59,63 @@ public:
         int fMaxBuffersToCache = 0;
     };
 
+    /**
+     * A persistently mapped GPU buffer that pools suballocate from as a ring, across flushes. A
+     * pool fences what it allocated when it is reset, after the flush's draws have been issued,
+     * and space is only reused once the GPU has signaled that fence. Nothing ever waits on a
+     * fence: when the GPU is still reading all the space that's left, pools fall back to making
+     * buffers of their own.
+     */
+    class RingBuffer : public GrNonAtomicRef<RingBuffer> {
+    public:
+        static constexpr size_t kDefaultSize = 1 << 22;
+
+        /** Returns null if the GrGpu can't make persistently mapped buffers. */
+        static sk_sp<RingBuffer> Make(GrGpu*, GrGpuBufferType, size_t size = kDefaultSize);
+
+        ~RingBuffer();
+
+        /**
+         * Returns size bytes of the buffer at a multiple of alignment, or null if they aren't
+         * free. The pointer stays valid until the bytes are fenced and the fence is signaled.
+         */
+        void* allocate(size_t size, size_t alignment, sk_sp<const GrBuffer>* buffer,
+                       size_t* offset);
+
+        /**
+         * Frees bytes from the end of the most recent allocation. Any more than that are simply
+         * held until the next fence is signaled.
+         */
+        void putBack(size_t bytes);
+
+        /** Fences everything allocated since the last fence. */
+        void fence();
+
+        /** Drops the fences without deleting them, for when the context has been abandoned. */
+        void abandon();
+
+    private:
+        RingBuffer(GrGpu*, sk_sp<GrGpuBuffer>, void* data);
+
+        void retireSignaledFences();
+
+        struct Submission {
+            GrFence fFence;
+            size_t fEnd;    // fHead when the fence was inserted.
+            size_t fBytes;  // Includes alignment padding and any space skipped to wrap around.
+        };
+
+        GrGpu* fGpu;
+        sk_sp<GrGpuBuffer> fBuffer;
+        char* fData;
+        size_t fHead = 0;  // Where the next allocation starts.
+        size_t fTail = 0;  // Where the oldest bytes the GPU may still read start.
+        size_t fBytesInUse = 0;
+        size_t fUnfencedBytes = 0;
+        size_t fLastAllocation = 0;
+        std::deque<Submission> fSubmissions;
+    };
+
     /**
      * Ensures all buffers are unmapped and have all data written to them.
      * Call before drawing using buffers from the pool.
@@ -81,8 +141,11 @@ protected:
      * @param cpuBufferCache        If non-null a cache for client side array buffers
      *                              or staging buffers used before data is uploaded to
      *                              GPU buffer objects.
+     * @param ringBuffer            If non-null, space is taken from this first. It must be
+     *                              for bufferType.
      */
-    GrBufferAllocPool(GrGpu* gpu, GrGpuBufferType bufferType, sk_sp<CpuBufferCache> cpuBufferCache);
+    GrBufferAllocPool(GrGpu* gpu, GrGpuBufferType bufferType, sk_sp<CpuBufferCache> cpuBufferCache,
+                      sk_sp<RingBuffer> ringBuffer = nullptr);
 
     virtual ~GrBufferAllocPool();
 
@@ -159,6 +222,10 @@ private:
 
     SkTArray<BufferBlock> fBlocks;
     sk_sp<CpuBufferCache> fCpuBufferCache;
+    // Space is only taken from the ring while there are no blocks, so that putBack() can free the
+    // most recent space first.
+    sk_sp<RingBuffer> fRingBuffer;
+    size_t fRingBytesInUse = 0;
     sk_sp<GrCpuBuffer> fCpuStagingBuffer;
     GrGpu* fGpu;
     GrGpuBufferType fBufferType;
@@ -177,8 +244,10 @@ public:
      * @param cpuBufferCache        If non-null a cache for client side array buffers
      *                              or staging buffers used before data is uploaded to
      *                              GPU buffer objects.
+     * @param ringBuffer            If non-null, a ring of vertex buffer space to use first.
      */
-    GrVertexBufferAllocPool(GrGpu* gpu, sk_sp<CpuBufferCache> cpuBufferCache);
+    GrVertexBufferAllocPool(GrGpu* gpu, sk_sp<CpuBufferCache> cpuBufferCache,
+                            sk_sp<RingBuffer> ringBuffer = nullptr);
 
     /**
      * Returns a block of memory to hold vertices. A buffer designated to hold
@@ -256,8 +325,10 @@ public:
      * @param cpuBufferCache        If non-null a cache for client side array buffers
      *                              or staging buffers used before data is uploaded to
      *                              GPU buffer objects.
+     * @param ringBuffer            If non-null, a ring of index buffer space to use first.
      */
-    GrIndexBufferAllocPool(GrGpu* gpu, sk_sp<CpuBufferCache> cpuBufferCache);
+    GrIndexBufferAllocPool(GrGpu* gpu, sk_sp<CpuBufferCache> cpuBufferCache,
+                           sk_sp<RingBuffer> ringBuffer = nullptr);
 
     /**
      * Returns a block of memory to hold indices. A buffer designated to hold
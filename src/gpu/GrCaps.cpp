@@ -37,6 +37,7 @@ GrCaps::GrCaps(const GrContextOptions& options) {
     fSupportsAHardwareBufferImages = false;
     fFenceSyncSupport = false;
     fSemaphoreSupport = false;
+    fPersistentlyMappedBufferSupport = false;
     fCrossContextTextureSupport = false;
     fHalfFloatVertexAttributeSupport = false;
     fDynamicStateArrayGeometryProcessorTextureSupport = false;
@@ -66,6 +67,13 @@ GrCaps::GrCaps(const GrContextOptions& options) {
     // when drawing rounded div borders.
     fMaxClipAnalyticFPs = 4;
 
+    // Experimentally we have found that most combining occurs within the first 10 comparisons.
+    static constexpr int kDefaultMaxOpDistance = 10;
+    fMaxOpChainDistance = options.fMaxOpChainDistance > 0 ? options.fMaxOpChainDistance
+                                                          : kDefaultMaxOpDistance;
+    fMaxOpMergeDistance = options.fMaxOpMergeDistance > 0 ? options.fMaxOpMergeDistance
+                                                          : kDefaultMaxOpDistance;
+
     fSuppressPrints = options.fSuppressPrints;
 #if GR_TEST_UTILS
     fWireframeMode = options.fWireframeMode;
@@ -212,6 +220,7 @@ void GrCaps::dumpJSON(SkJSONWriter* writer) const {
     writer->appendBool("Supports importing AHardwareBuffers", fSupportsAHardwareBufferImages);
     writer->appendBool("Fence sync support", fFenceSyncSupport);
     writer->appendBool("Semaphore support", fSemaphoreSupport);
+    writer->appendBool("Persistently mapped buffer support", fPersistentlyMappedBufferSupport);
     writer->appendBool("Cross context texture support", fCrossContextTextureSupport);
     writer->appendBool("Half float vertex attribute support", fHalfFloatVertexAttributeSupport);
     writer->appendBool("Specify GeometryProcessor textures as a dynamic state array",
@@ -239,6 +248,8 @@ void GrCaps::dumpJSON(SkJSONWriter* writer) const {
     writer->appendS32("Max Preferred Render Target Size", fMaxPreferredRenderTargetSize);
     writer->appendS32("Max Window Rectangles", fMaxWindowRectangles);
     writer->appendS32("Max Clip Analytic Fragment Processors", fMaxClipAnalyticFPs);
+    writer->appendS32("Max Op Chain Distance", fMaxOpChainDistance);
+    writer->appendS32("Max Op Merge Distance", fMaxOpMergeDistance);
 
     static const char* kBlendEquationSupportNames[] = {
         "Basic",
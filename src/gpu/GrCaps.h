@@ -161,6 +161,11 @@ public:
     // should use to implement a clip, before falling back on a mask.
     int maxClipAnalyticFPs() const { return fMaxClipAnalyticFPs; }
 
+    // How far GrRenderTargetOpList searches for op chains to join, and for ops to merge with
+    // within a chain. See GrContextOptions::fMaxOpChainDistance and fMaxOpMergeDistance.
+    int maxOpChainDistance() const { return fMaxOpChainDistance; }
+    int maxOpMergeDistance() const { return fMaxOpMergeDistance; }
+
     virtual bool isConfigTexturable(GrPixelConfig) const = 0;
 
     // Returns whether a texture of the given config can be copied to a texture of the same config.
@@ -269,6 +274,12 @@ public:
     /** Supports using GrSemaphore. */
     bool semaphoreSupport() const { return fSemaphoreSupport; }
 
+    /**
+     * Supports GrGpu::createPersistentlyMappedBuffer(), and dynamic vertex and index data should be
+     * suballocated from such buffers, fenced, rather than mapping fresh buffers every flush.
+     */
+    bool persistentlyMappedBufferSupport() const { return fPersistentlyMappedBufferSupport; }
+
     bool crossContextTextureSupport() const { return fCrossContextTextureSupport; }
     /**
      * Returns whether or not we will be able to do a copy given the passed in params
@@ -411,6 +422,9 @@ protected:
     bool fFenceSyncSupport                           : 1;
     bool fSemaphoreSupport                           : 1;
 
+    // Requires fence sync support.
+    bool fPersistentlyMappedBufferSupport            : 1;
+
     // Requires fence sync support in GL.
     bool fCrossContextTextureSupport                 : 1;
 
@@ -431,6 +445,8 @@ protected:
     int fMaxTileSize;
     int fMaxWindowRectangles;
     int fMaxClipAnalyticFPs;
+    int fMaxOpChainDistance;
+    int fMaxOpMergeDistance;
 
     GrDriverBugWorkarounds fDriverBugWorkarounds;
 
@@ -327,6 +327,85 @@ static void create_clip_mask_key(uint32_t clipGenID, const SkIRect& bounds, int
     builder[3] = numAnalyticFPs;
 }
 
+// Writes a key for what's drawn into the mask, relative to the scissor's top left, so the mask
+// can be reused by a later clip stack with the same elements (e.g. the next frame's, or one
+// scrolled by whole pixels). Paths are only keyed by the generation ID and matrix of the path
+// they were made from, so this fails for elements made from volatile paths.
+static bool create_clip_mask_content_key(const GrReducedClip& reducedClip, GrUniqueKey* key) {
+    static constexpr int kRRectKeySize = SkRRect::kSizeInMemory / sizeof(uint32_t);
+    // The alpha mask isn't drawn inside the window rectangles.
+    const GrWindowRectangles& windows = reducedClip.windowRectangles();
+    int keySize = 4 + 4 * windows.count();
+    for (ElementList::Iter iter(reducedClip.maskElements()); iter.get(); iter.next()) {
+        const Element* element = iter.get();
+        switch (element->getDeviceSpaceType()) {
+            case Element::DeviceSpaceType::kEmpty:
+                keySize += 1;
+                break;
+            case Element::DeviceSpaceType::kRect:
+                keySize += 1 + 4;
+                break;
+            case Element::DeviceSpaceType::kRRect:
+                keySize += 1 + kRRectKeySize;
+                break;
+            case Element::DeviceSpaceType::kPath:
+                if (SK_InvalidGenID == element->getSourcePathGenID()) {
+                    return false;
+                }
+                keySize += 1 + 1 + 9;
+                break;
+        }
+    }
+
+    static const GrUniqueKey::Domain kDomain = GrUniqueKey::GenerateDomain();
+    GrUniqueKey::Builder builder(key, kDomain, keySize, GrClipStackClip::kMaskTestTag);
+    const SkIRect& scissor = reducedClip.scissor();
+    SkScalar dx = SkIntToScalar(-scissor.fLeft), dy = SkIntToScalar(-scissor.fTop);
+    int i = 0;
+    builder[i++] = scissor.width();
+    builder[i++] = scissor.height();
+    builder[i++] = static_cast<uint32_t>(reducedClip.initialState());
+    builder[i++] = windows.count();
+    for (int w = 0; w < windows.count(); ++w) {
+        SkIRect window = windows.data()[w].makeOffset(-scissor.fLeft, -scissor.fTop);
+        memcpy(&builder[i], &window, sizeof(window));
+        i += 4;
+    }
+    for (ElementList::Iter iter(reducedClip.maskElements()); iter.get(); iter.next()) {
+        const Element* element = iter.get();
+        Element::DeviceSpaceType type = element->getDeviceSpaceType();
+        builder[i++] = static_cast<uint32_t>(type) |
+                       (static_cast<uint32_t>(element->getOp()) << 2) | (element->isAA() << 5);
+        switch (type) {
+            case Element::DeviceSpaceType::kEmpty:
+                break;
+            case Element::DeviceSpaceType::kRect: {
+                SkRect rect = element->getDeviceSpaceRect().makeOffset(dx, dy);
+                memcpy(&builder[i], &rect, sizeof(rect));
+                i += 4;
+                break;
+            }
+            case Element::DeviceSpaceType::kRRect: {
+                SkRRect rrect = element->getDeviceSpaceRRect().makeOffset(dx, dy);
+                rrect.writeToMemory(&builder[i]);
+                i += kRRectKeySize;
+                break;
+            }
+            case Element::DeviceSpaceType::kPath: {
+                SkMatrix matrix = element->getSourceMatrix();
+                matrix.postTranslate(dx, dy);
+                builder[i++] = element->getSourcePathGenID();
+                builder[i++] = element->getDeviceSpacePath().getFillType();
+                matrix.get9(reinterpret_cast<SkScalar*>(&builder[i]));
+                i += 9;
+                break;
+            }
+        }
+    }
+    SkASSERT(i == keySize);
+    return true;
+}
+
 static void add_invalidate_on_pop_message(GrRecordingContext* context,
                                           const SkClipStack& stack, uint32_t clipGenID,
                                           const GrUniqueKey& clipMaskKey) {
@@ -346,8 +425,11 @@ sk_sp<GrTextureProxy> GrClipStackClip::createAlphaClipMask(GrRecordingContext* c
                                                            const GrReducedClip& reducedClip) const {
     GrProxyProvider* proxyProvider = context->priv().proxyProvider();
     GrUniqueKey key;
-    create_clip_mask_key(reducedClip.maskGenID(), reducedClip.scissor(),
-                         reducedClip.numAnalyticFPs(), &key);
+    bool contentKey = create_clip_mask_content_key(reducedClip, &key);
+    if (!contentKey) {
+        create_clip_mask_key(reducedClip.maskGenID(), reducedClip.scissor(),
+                             reducedClip.numAnalyticFPs(), &key);
+    }
 
     sk_sp<GrTextureProxy> proxy(proxyProvider->findOrCreateProxyByUniqueKey(
                                                                 key, kTopLeft_GrSurfaceOrigin));
@@ -382,7 +464,9 @@ sk_sp<GrTextureProxy> GrClipStackClip::createAlphaClipMask(GrRecordingContext* c
 
     SkASSERT(result->origin() == kTopLeft_GrSurfaceOrigin);
     proxyProvider->assignUniqueKeyToProxy(key, result.get());
-    add_invalidate_on_pop_message(context, *fStack, reducedClip.maskGenID(), key);
+    if (!contentKey) {
+        add_invalidate_on_pop_message(context, *fStack, reducedClip.maskGenID(), key);
+    }
 
     return result;
 }
@@ -465,8 +549,11 @@ sk_sp<GrTextureProxy> GrClipStackClip::createSoftwareClipMask(
         GrRecordingContext* context, const GrReducedClip& reducedClip,
         GrRenderTargetContext* renderTargetContext) const {
     GrUniqueKey key;
-    create_clip_mask_key(reducedClip.maskGenID(), reducedClip.scissor(),
-                         reducedClip.numAnalyticFPs(), &key);
+    bool contentKey = create_clip_mask_content_key(reducedClip, &key);
+    if (!contentKey) {
+        create_clip_mask_key(reducedClip.maskGenID(), reducedClip.scissor(),
+                             reducedClip.numAnalyticFPs(), &key);
+    }
 
     GrProxyProvider* proxyProvider = context->priv().proxyProvider();
 
@@ -531,6 +618,8 @@ sk_sp<GrTextureProxy> GrClipStackClip::createSoftwareClipMask(
 
     SkASSERT(proxy->origin() == kTopLeft_GrSurfaceOrigin);
     proxyProvider->assignUniqueKeyToProxy(key, proxy.get());
-    add_invalidate_on_pop_message(context, *fStack, reducedClip.maskGenID(), key);
+    if (!contentKey) {
+        add_invalidate_on_pop_message(context, *fStack, reducedClip.maskGenID(), key);
+    }
     return proxy;
 }
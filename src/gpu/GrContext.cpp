@@ -15,6 +15,7 @@
 #include "src/core/SkTaskGroup.h"
 #include "src/gpu/GrDrawingManager.h"
 #include "src/gpu/GrGpu.h"
+#include "src/gpu/GrImageFilterCache.h"
 #include "src/gpu/GrMemoryPool.h"
 #include "src/gpu/GrPathRendererChain.h"
 #include "src/gpu/GrProxyProvider.h"
@@ -28,10 +29,12 @@
 #include "src/gpu/ccpr/GrCoverageCountingPathRenderer.h"
 #include "src/gpu/effects/GrSkSLFP.h"
 #include "src/gpu/effects/generated/GrConfigConversionEffect.h"
+#include "src/gpu/text/GrAtlasManager.h"
 #include "src/gpu/text/GrTextBlobCache.h"
 #include "src/gpu/text/GrTextContext.h"
 #include "src/image/SkSurface_Gpu.h"
 #include <atomic>
+#include <cmath>
 #include <unordered_map>
 
 #define ASSERT_OWNED_PROXY(P) \
@@ -82,6 +85,7 @@ bool GrContext::init(sk_sp<const GrCaps> caps, sk_sp<GrSkSLFPFactoryCache> FPFac
 
     if (fResourceCache) {
         fResourceCache->setProxyProvider(this->proxyProvider());
+        fResourceCache->setPurgePolicy(this->options().fResourceCachePolicy);
     }
 
     fDidTestPMConversions = false;
@@ -92,12 +96,20 @@ bool GrContext::init(sk_sp<const GrCaps> caps, sk_sp<GrSkSLFPFactoryCache> FPFac
         fTaskGroup = skstd::make_unique<SkTaskGroup>(*this->options().fExecutor);
     }
 
+    if (fResourceCache && this->options().fCacheImageFilterResults) {
+        fImageFilterCache = sk_make_sp<GrImageFilterCache>(this);
+    }
+
     fPersistentCache = this->options().fPersistentCache;
     fShaderErrorHandler = this->options().fShaderErrorHandler;
     if (!fShaderErrorHandler) {
         fShaderErrorHandler = GrShaderUtils::DefaultShaderErrorHandler();
     }
 
+    if (fGpu && fTaskGroup && fPersistentCache && this->options().fLoadPersistentCacheOnExecutor) {
+        fGpu->prewarmPersistentCache(fTaskGroup.get());
+    }
+
     return true;
 }
 
@@ -202,6 +214,41 @@ void GrContext::purgeUnlockedResources(size_t bytesToPurge, bool preferScratchRe
     fResourceCache->purgeUnlockedResources(bytesToPurge, preferScratchResources);
 }
 
+void GrContext::onMemoryPressure(SkGraphics::MemoryPressure pressure,
+                                 SkGraphics::MemoryPressureResult* result) {
+    ASSERT_SINGLE_OWNER
+    RETURN_IF_ABANDONED
+
+    float fraction = SkGraphics::MemoryPressureTrimFraction(pressure);
+    size_t startResourceBytes = fResourceCache->getResourceBytes();
+
+    GrTextBlobCache* textBlobCache = this->getTextBlobCache();
+    textBlobCache->purgeStaleBlobs();
+    size_t textBlobBytes =
+            textBlobCache->purgeBytes(size_t(std::ceil(textBlobCache->usedBytes() * fraction)));
+
+    int pathCacheEntries = 0;
+    if (auto ccpr = this->drawingManager()->getCoverageCountingPathRenderer()) {
+        pathCacheEntries = ccpr->purgeCacheEntries(this->proxyProvider(), fraction);
+    }
+
+    if (SkGraphics::MemoryPressure::kCritical == pressure) {
+        this->freeGpuResources();
+    } else {
+        fResourceCache->purgeUnlockedResources(
+                size_t(std::ceil(fResourceCache->getPurgeableBytes() * fraction)), true);
+    }
+    size_t endResourceBytes = fResourceCache->getResourceBytes();
+
+    if (result) {
+        result->fTextBlobCacheBytes += textBlobBytes;
+        result->fCoverageCountingPathCacheEntries += pathCacheEntries;
+        if (startResourceBytes > endResourceBytes) {
+            result->fGpuResourceBytes += startResourceBytes - endResourceBytes;
+        }
+    }
+}
+
 void GrContext::getResourceCacheUsage(int* resourceCount, size_t* resourceBytes) const {
     ASSERT_SINGLE_OWNER
 
@@ -285,6 +332,13 @@ void GrContext::storeVkPipelineCacheData() {
     }
 }
 
+bool GrContext::precompileShader(const SkData& key, const SkData& data) {
+    if (this->abandoned() || !fGpu) {
+        return false;
+    }
+    return fGpu->precompileShader(key, data);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 std::unique_ptr<GrFragmentProcessor> GrContext::createPMToUPMEffect(
@@ -348,6 +402,9 @@ void GrContext::dumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump) const {
     fResourceCache->dumpMemoryStatistics(traceMemoryDump);
     traceMemoryDump->dumpNumericValue("skia/gr_text_blob_cache", "size", "bytes",
                                       this->getTextBlobCache()->usedBytes());
+    if (GrAtlasManager* atlasManager = const_cast<GrContext*>(this)->onGetAtlasManager()) {
+        atlasManager->dumpMemoryStatistics(traceMemoryDump);
+    }
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -20,6 +20,7 @@
 #include "src/gpu/GrSurfacePriv.h"
 #include "src/gpu/GrTextureContext.h"
 #include "src/gpu/SkGr.h"
+#include "src/gpu/ccpr/GrCoverageCountingPathRenderer.h"
 #include "src/gpu/text/GrTextBlobCache.h"
 #include "src/image/SkImage_Base.h"
 #include "src/image/SkImage_Gpu.h"
@@ -688,12 +689,16 @@ SkString GrContextPriv::dump() const {
 void GrContextPriv::resetGpuStats() const {
 #if GR_GPU_STATS
     fContext->fGpu->stats()->reset();
+    fContext->drawingManager()->pathRendererStats()->reset();
 #endif
 }
 
 void GrContextPriv::dumpCacheStats(SkString* out) const {
 #if GR_CACHE_STATS
     fContext->fResourceCache->dumpStats(out);
+    if (auto ccpr = fContext->drawingManager()->getCoverageCountingPathRenderer()) {
+        ccpr->dumpPathCacheStats(out);
+    }
 #endif
 }
 
@@ -712,14 +717,16 @@ void GrContextPriv::printCacheStats() const {
 
 void GrContextPriv::dumpGpuStats(SkString* out) const {
 #if GR_GPU_STATS
-    return fContext->fGpu->stats()->dump(out);
+    fContext->fGpu->stats()->dump(out);
+    fContext->drawingManager()->pathRendererStats()->dump(out);
 #endif
 }
 
 void GrContextPriv::dumpGpuStatsKeyValuePairs(SkTArray<SkString>* keys,
                                               SkTArray<double>* values) const {
 #if GR_GPU_STATS
-    return fContext->fGpu->stats()->dumpKeyValuePairs(keys, values);
+    fContext->fGpu->stats()->dumpKeyValuePairs(keys, values);
+    fContext->drawingManager()->pathRendererStats()->dumpKeyValuePairs(keys, values);
 #endif
 }
 
@@ -23,6 +23,7 @@ class GrSurfaceProxy;
 class GrTextureContext;
 
 class SkDeferredDisplayList;
+class SkImageFilterCache;
 class SkTaskGroup;
 
 /** Class that adds methods to GrContext that are only intended for use internal to Skia.
@@ -238,6 +239,9 @@ public:
 
     GrResourceCache* getResourceCache() { return fContext->fResourceCache; }
 
+    // Null unless GrContextOptions::fCacheImageFilterResults is set.
+    SkImageFilterCache* getImageFilterCache() { return fContext->fImageFilterCache.get(); }
+
     GrGpu* getGpu() { return fContext->fGpu.get(); }
     const GrGpu* getGpu() const { return fContext->fGpu.get(); }
 
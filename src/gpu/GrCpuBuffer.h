@@ -8,6 +8,7 @@
 #ifndef GrCpuBuffer_DEFINED
 #define GrCpuBuffer_DEFINED
 
+#include "include/private/SkMalloc.h"
 #include "src/gpu/GrBuffer.h"
 #include "src/gpu/GrNonAtomicRef.h"
 
@@ -15,10 +16,14 @@ class GrCpuBuffer final : public GrNonAtomicRef<GrCpuBuffer>, public GrBuffer {
 public:
     static sk_sp<GrCpuBuffer> Make(size_t size) {
         SkASSERT(size > 0);
-        auto mem = ::operator new(sizeof(GrCpuBuffer) + size);
+        SkAutoMemoryTag memoryTag(SkMemoryTag::kGpuCPUData);
+        auto mem = sk_malloc_throw(sizeof(GrCpuBuffer) + size);
         return sk_sp<GrCpuBuffer>(new (mem) GrCpuBuffer((char*)mem + sizeof(GrCpuBuffer), size));
     }
 
+    // Make() allocates with sk_malloc, so the memory is charged to its tag.
+    static void operator delete(void* p) { sk_free(p); }
+
     void ref() const override { GrNonAtomicRef<GrCpuBuffer>::ref(); }
     void unref() const override { GrNonAtomicRef<GrCpuBuffer>::unref(); }
     size_t size() const override { return fSize; }
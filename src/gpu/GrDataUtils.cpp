@@ -7,7 +7,9 @@
 
 #include "GrDataUtils.h"
 
+#include "include/core/SkPixmap.h"
 #include "include/private/GrColor.h"
+#include "src/core/SkEndian.h"
 #include "src/core/SkUtils.h"
 
 static const int kNumModifierTables = 8;
@@ -117,6 +119,128 @@ void GrFillInETC1WithColor(const SkColor4f& colorf, void* dest, int numBlocks) {
     }
 }
 
+// The error of the best modifier from 'table' for each of the 8 pixels of a sub-block, given the
+// sub-block's base color. Each pixel's chosen modifier index is stored in 'indices'.
+static int encode_etc1_subblock(const uint8_t* pixels[8], int r8, int g8, int b8, int table,
+                                int indices[8]) {
+    int error = 0;
+    for (int p = 0; p < 8; ++p) {
+        int bestError = SK_MaxS32;
+        for (int i = 0; i < kNumPixelIndices; ++i) {
+            int m = kModifierTables[table][i];
+            int dr = pixels[p][0] - SkTPin(r8 + m, 0, 255);
+            int dg = pixels[p][1] - SkTPin(g8 + m, 0, 255);
+            int db = pixels[p][2] - SkTPin(b8 + m, 0, 255);
+            int e = dr * dr + dg * dg + db * db;
+            if (e < bestError) {
+                bestError = e;
+                indices[p] = i;
+            }
+        }
+        error += bestError;
+    }
+    return error;
+}
+
+// Encodes one 4x4 block of 'pixels' (RGBA bytes, rows 'rowBytes' apart). Both sub-block
+// orientations are tried, each in differential mode when the two sub-block colors are close
+// enough and in individual mode otherwise, and the one with the least squared error is kept.
+static void encode_etc1_block(const uint8_t* pixels, size_t rowBytes, ETC1Block* block) {
+    uint32_t bestHigh = 0, bestLow = 0;
+    int bestError = SK_MaxS32;
+    for (int flip = 0; flip < 2; ++flip) {
+        // The pixels of each sub-block, with their x*4 + y positions in the pixel index bits.
+        const uint8_t* subPixels[2][8];
+        int positions[2][8];
+        int sums[2][3] = {};
+        for (int y = 0; y < 4; ++y) {
+            for (int x = 0; x < 4; ++x) {
+                int sub = flip ? y >> 1 : x >> 1;
+                int p = flip ? (y & 1) * 4 + x : y * 2 + (x & 1);
+                subPixels[sub][p] = pixels + y * rowBytes + 4 * x;
+                positions[sub][p] = x * 4 + y;
+                for (int c = 0; c < 3; ++c) {
+                    sums[sub][c] += subPixels[sub][p][c];
+                }
+            }
+        }
+
+        // Quantize the averages to 555 for differential mode, or to 444 if the second color
+        // can't be reached from the first with a 3 bit delta.
+        int base5[2][3], base8[2][3];
+        bool differential = true;
+        for (int c = 0; c < 3; ++c) {
+            for (int sub = 0; sub < 2; ++sub) {
+                base5[sub][c] = (sums[sub][c] * 31 + 8 * 255 / 2) / (8 * 255);
+            }
+            int delta = base5[1][c] - base5[0][c];
+            differential &= -4 <= delta && delta <= 3;
+        }
+        uint32_t high = (differential ? 0x2 : 0x0) | flip;
+        for (int c = 0; c < 3; ++c) {
+            int shift = 24 - 8 * c;
+            if (differential) {
+                base8[0][c] = convert_5To8(base5[0][c]);
+                base8[1][c] = convert_5To8(base5[1][c]);
+                high |= (base5[0][c] << (shift + 3)) |
+                        (((base5[1][c] - base5[0][c]) & 0x7) << shift);
+            } else {
+                for (int sub = 0; sub < 2; ++sub) {
+                    int base4 = (sums[sub][c] * 15 + 8 * 255 / 2) / (8 * 255);
+                    base8[sub][c] = (base4 << 4) | base4;
+                    high |= base4 << (shift + 4 - 4 * sub);
+                }
+            }
+        }
+
+        uint32_t low = 0;
+        int error = 0;
+        for (int sub = 0; sub < 2; ++sub) {
+            int bestTableError = SK_MaxS32, bestTable = 0;
+            int indices[8], bestIndices[8];
+            for (int table = 0; table < kNumModifierTables; ++table) {
+                int tableError = encode_etc1_subblock(subPixels[sub], base8[sub][0],
+                                                      base8[sub][1], base8[sub][2], table,
+                                                      indices);
+                if (tableError < bestTableError) {
+                    bestTableError = tableError;
+                    bestTable = table;
+                    memcpy(bestIndices, indices, sizeof(indices));
+                }
+            }
+            error += bestTableError;
+            high |= bestTable << (5 - 3 * sub);
+            for (int p = 0; p < 8; ++p) {
+                // The index's high bit goes in the top half of the low word.
+                low |= ((bestIndices[p] >> 1) << (16 + positions[sub][p])) |
+                       ((bestIndices[p] & 1) << positions[sub][p]);
+            }
+        }
+        if (error < bestError) {
+            bestError = error;
+            bestHigh = high;
+            bestLow = low;
+        }
+    }
+
+    // ETC1 blocks are stored as big endian 64 bit values.
+    block->fHigh = SkEndian_SwapBE32(bestHigh);
+    block->fLow = SkEndian_SwapBE32(bestLow);
+}
+
+void GrCompressRGBA8888ToETC1(const SkPixmap& pixmap, void* blocks) {
+    SkASSERT(kRGBA_8888_SkColorType == pixmap.colorType());
+    SkASSERT(!(pixmap.width() & 3) && !(pixmap.height() & 3));
+
+    ETC1Block* block = static_cast<ETC1Block*>(blocks);
+    for (int y = 0; y < pixmap.height(); y += 4) {
+        for (int x = 0; x < pixmap.width(); x += 4) {
+            encode_etc1_block(static_cast<const uint8_t*>(pixmap.addr(x, y)), pixmap.rowBytes(),
+                              block++);
+        }
+    }
+}
+
 bool GrFillBufferWithColor(GrPixelConfig config, int width, int height,
                            const SkColor4f& colorf, void* dest) {
     SkASSERT(kRGB_ETC1_GrPixelConfig != config);
@@ -11,6 +11,8 @@
 #include "include/core/SkColor.h"
 #include "include/private/GrTypesPriv.h"
 
+class SkPixmap;
+
 // Fill in the width x height 'dest' with the munged version of 'color' that matches 'config'
 bool GrFillBufferWithColor(GrPixelConfig config, int width, int height,
                            const SkColor4f& color, void* dest);
@@ -25,4 +27,8 @@ int GrNumETC1Blocks(int w, int h);
 // Fill in 'blocks' with ETC1 blocks derived from 'color'
 void GrFillInETC1WithColor(const SkColor4f& color, void* blocks, int numBlocks);
 
+// Compress the opaque 'pixmap', which must be kRGBA_8888 with dimensions that are multiples of 4,
+// into the GrNumETC1Blocks(width, height) ETC1 'blocks'. Alpha is ignored.
+void GrCompressRGBA8888ToETC1(const SkPixmap& pixmap, void* blocks);
+
 #endif
@@ -7,6 +7,7 @@
 
 #include "src/gpu/GrDrawOpAtlas.h"
 
+#include "include/core/SkTraceMemoryDump.h"
 #include "include/gpu/GrContext.h"
 #include "include/gpu/GrTexture.h"
 #include "src/gpu/GrContextPriv.h"
@@ -60,6 +61,7 @@ GrDrawOpAtlas::Plot::Plot(int pageIndex, int plotIndex, uint64_t genID, int offX
         : fLastUpload(GrDeferredUploadToken::AlreadyFlushedToken())
         , fLastUse(GrDeferredUploadToken::AlreadyFlushedToken())
         , fFlushesSinceLastUse(0)
+        , fOccupiedPixels(0)
         , fPageIndex(pageIndex)
         , fPlotIndex(plotIndex)
         , fGenID(genID)
@@ -126,6 +128,7 @@ bool GrDrawOpAtlas::Plot::addSubImage(int width, int height, const void* image,
     }
 
     fDirtyRect.join(loc->fX, loc->fY, loc->fX + width, loc->fY + height);
+    fOccupiedPixels += width * height;
 
     loc->fX += fOffset.fX;
     loc->fY += fOffset.fY;
@@ -162,6 +165,7 @@ void GrDrawOpAtlas::Plot::resetRects() {
         fRects->reset();
     }
 
+    fOccupiedPixels = 0;
     fGenID++;
     fID = CreateId(fPageIndex, fPlotIndex, fGenID);
     fLastUpload = GrDeferredUploadToken::AlreadyFlushedToken();
@@ -189,6 +193,7 @@ GrDrawOpAtlas::GrDrawOpAtlas(GrProxyProvider* proxyProvider, const GrBackendForm
         , fPlotHeight(plotHeight)
         , fAtlasGeneration(kInvalidAtlasGeneration + 1)
         , fPrevFlushToken(GrDeferredUploadToken::AlreadyFlushedToken())
+        , fIdleFlushes(0)
         , fMaxPages(AllowMultitexturing::kYes == allowMultitexturing ? kMaxMultitexturePages : 1)
         , fNumActivePages(0) {
     int numPlotsX = width/plotWidth;
@@ -369,6 +374,7 @@ GrDrawOpAtlas::ErrorCode GrDrawOpAtlas::addToAtlas(GrResourceProvider* resourceP
 void GrDrawOpAtlas::compact(GrDeferredUploadToken startTokenForNextFlush) {
     if (fNumActivePages <= 1) {
         fPrevFlushToken = startTokenForNextFlush;
+        fIdleFlushes = 0;
         return;
     }
 
@@ -390,9 +396,22 @@ void GrDrawOpAtlas::compact(GrDeferredUploadToken startTokenForNextFlush) {
 
     // We only try to compact if the atlas was used in the recently completed flush.
     // This is to handle the case where a lot of text or path rendering has occurred but then just
-    // a blinking cursor is drawn.
-    // TODO: consider if we should also do this if it's been a long time since the last atlas use
-    if (atlasUsedThisFlush) {
+    // a blinking cursor is drawn. If the atlas stays unused for long enough though, we give back
+    // everything but the first page. Nothing in those pages can still be read by the GPU.
+    fIdleFlushes = atlasUsedThisFlush ? 0 : fIdleFlushes + 1;
+    if (fIdleFlushes > kIdleFlushCount) {
+        while (fNumActivePages > 1) {
+            plotIter.init(fPages[fNumActivePages - 1].fPlotList, PlotList::Iter::kHead_IterStart);
+            while (Plot* plot = plotIter.get()) {
+                if (plot->lastUseToken() != GrDeferredUploadToken::AlreadyFlushedToken()) {
+                    this->processEviction(plot->id());
+                }
+                plotIter.next();
+            }
+            this->deactivateLastPage();
+        }
+        fIdleFlushes = 0;
+    } else if (atlasUsedThisFlush) {
         SkTArray<Plot*> availablePlots;
         uint32_t lastPageIndex = fNumActivePages - 1;
 
@@ -510,6 +529,37 @@ void GrDrawOpAtlas::compact(GrDeferredUploadToken startTokenForNextFlush) {
     fPrevFlushToken = startTokenForNextFlush;
 }
 
+void GrDrawOpAtlas::dumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump,
+                                         const char* dumpName) const {
+    size_t bpp = GrColorTypeBytesPerPixel(fColorType);
+    for (uint32_t pageIndex = 0; pageIndex < fNumActivePages; ++pageIndex) {
+        uint64_t occupiedPixels = 0;
+        uint64_t plotsInUse = 0;
+        uint64_t plotsRecentlyUsed = 0;
+        for (uint32_t plotIndex = 0; plotIndex < fNumPlots; ++plotIndex) {
+            const Plot* plot = fPages[pageIndex].fPlotArray[plotIndex].get();
+            occupiedPixels += plot->occupiedPixels();
+            if (plot->occupiedPixels()) {
+                ++plotsInUse;
+                if (plot->flushesSinceLastUsed() <= kRecentlyUsedCount) {
+                    ++plotsRecentlyUsed;
+                }
+            }
+        }
+
+        SkString pageDumpName = SkStringPrintf("%s/page_%u", dumpName, pageIndex);
+        traceMemoryDump->dumpNumericValue(pageDumpName.c_str(), "page_size", "bytes",
+                                          (uint64_t)fTextureWidth * fTextureHeight * bpp);
+        traceMemoryDump->dumpNumericValue(pageDumpName.c_str(), "occupied_size", "bytes",
+                                          occupiedPixels * bpp);
+        traceMemoryDump->dumpNumericValue(pageDumpName.c_str(), "plots", "objects", fNumPlots);
+        traceMemoryDump->dumpNumericValue(pageDumpName.c_str(), "plots_in_use", "objects",
+                                          plotsInUse);
+        traceMemoryDump->dumpNumericValue(pageDumpName.c_str(), "plots_recently_used", "objects",
+                                          plotsRecentlyUsed);
+    }
+}
+
 bool GrDrawOpAtlas::createPages(GrProxyProvider* proxyProvider) {
     SkASSERT(SkIsPow2(fTextureWidth) && SkIsPow2(fTextureHeight));
 
@@ -20,6 +20,7 @@
 
 class GrOnFlushResourceProvider;
 class GrRectanizer;
+class SkTraceMemoryDump;
 
 
 /**
@@ -230,8 +231,23 @@ public:
         }
     }
 
+    /**
+     * Called after each flush. Pages beyond the first are emptied and released once no plot in
+     * them is in recent use. If the atlas goes unused for kIdleFlushCount flushes in a row, all
+     * pages but the first are released, so memory taken by a burst of text or paths is returned
+     * during idle frames. Their entries are evicted and reuploaded if they're drawn again.
+     */
     void compact(GrDeferredUploadToken startTokenForNextFlush);
 
+    static constexpr int kIdleFlushCount = 1024;
+
+    /**
+     * Dumps the size of each active page, how much of it holds entries, and how many of its plots
+     * hold entries or were recently used, under "<dumpName>/page_<index>". The textures are
+     * already dumped by the resource cache, so none of these are reported as "size".
+     */
+    void dumpMemoryStatistics(SkTraceMemoryDump*, const char* dumpName) const;
+
     static uint32_t GetPageIndexFromID(AtlasID id) {
         return id & 0xff;
     }
@@ -291,7 +307,10 @@ private:
         void uploadToTexture(GrDeferredTextureUploadWritePixelsFn&, GrTextureProxy*);
         void resetRects();
 
-        int flushesSinceLastUsed() { return fFlushesSinceLastUse; }
+        // The number of pixels covered by subimages since the plot was last reset.
+        int occupiedPixels() const { return fOccupiedPixels; }
+
+        int flushesSinceLastUsed() const { return fFlushesSinceLastUse; }
         void resetFlushesSinceLastUsed() { fFlushesSinceLastUse = 0; }
         void incFlushesSinceLastUsed() { fFlushesSinceLastUse++; }
 
@@ -323,6 +342,7 @@ private:
         GrDeferredUploadToken fLastUse;
         // the number of flushes since this plot has been last used
         int                   fFlushesSinceLastUse;
+        int                   fOccupiedPixels;
 
         struct {
             const uint32_t fPageIndex : 16;
@@ -396,6 +416,8 @@ private:
     uint64_t              fAtlasGeneration;
     // nextTokenToFlush() value at the end of the previous flush
     GrDeferredUploadToken fPrevFlushToken;
+    // the number of flushes in a row that didn't use the atlas
+    int                   fIdleFlushes;
 
     struct EvictionData {
         EvictionFunc fFunc;
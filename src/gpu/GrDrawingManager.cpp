@@ -166,10 +166,25 @@ GrDrawingManager::GrDrawingManager(GrRecordingContext* context,
 void GrDrawingManager::cleanup() {
     fDAG.cleanup(fContext->priv().caps());
 
+    fBlurDownsampleCache.reset();
+
     fPathRendererChain = nullptr;
     fSoftwarePathRenderer = nullptr;
 
     fOnFlushCBObjects.reset();
+
+    this->releaseRingBuffers();
+}
+
+void GrDrawingManager::releaseRingBuffers() {
+    // The rings' fences have to be deleted while the GrGpu is still around, unless the context
+    // was abandoned, in which case they no longer exist.
+    for (sk_sp<GrBufferAllocPool::RingBuffer>* ring : {&fVertexRing, &fIndexRing}) {
+        if (*ring && this->wasAbandoned()) {
+            (*ring)->abandon();
+        }
+        ring->reset();
+    }
 }
 
 GrDrawingManager::~GrDrawingManager() {
@@ -191,6 +206,12 @@ void GrDrawingManager::freeGpuResources() {
     // a path renderer may be holding onto resources
     fPathRendererChain = nullptr;
     fSoftwarePathRenderer = nullptr;
+
+    // as are the downsampled blur sources
+    fBlurDownsampleCache.reset();
+
+    // so are the ring buffers; they'll be remade by the next flush
+    this->releaseRingBuffers();
 }
 
 // MDB TODO: make use of the 'proxy' parameter.
@@ -239,6 +260,10 @@ GrSemaphoresSubmitted GrDrawingManager::flush(GrSurfaceProxy* proxies[], int num
 
     fFlushing = true;
 
+    // Every op that reads the downsampled blur sources has been recorded. Dropping our refs lets
+    // their textures be recycled once those ops are done with them.
+    fBlurDownsampleCache.reset();
+
     auto resourceProvider = direct->priv().resourceProvider();
     auto resourceCache = direct->priv().getResourceCache();
 
@@ -257,9 +282,16 @@ GrSemaphoresSubmitted GrDrawingManager::flush(GrSurfaceProxy* proxies[], int num
         int maxCachedBuffers = fContext->priv().caps()->preferClientSideDynamicBuffers() ? 2 : 6;
         fCpuBufferCache = GrBufferAllocPool::CpuBufferCache::Make(maxCachedBuffers);
     }
+    if (!fVertexRing && fContext->priv().caps()->persistentlyMappedBufferSupport()) {
+        // These persist across flushes, so that each flush's vertices and indices can be written
+        // with no mapping or orphaning at all.
+        fVertexRing = GrBufferAllocPool::RingBuffer::Make(gpu, GrGpuBufferType::kVertex);
+        fIndexRing = GrBufferAllocPool::RingBuffer::Make(
+                gpu, GrGpuBufferType::kIndex, GrBufferAllocPool::RingBuffer::kDefaultSize / 4);
+    }
 
     GrOpFlushState flushState(gpu, resourceProvider, resourceCache, &fTokenTracker,
-                              fCpuBufferCache);
+                              fCpuBufferCache, fVertexRing, fIndexRing);
 
     GrOnFlushResourceProvider onFlushProvider(this);
     // TODO: AFAICT the only reason fFlushState is on GrDrawingManager rather than on the
@@ -357,6 +389,9 @@ GrSemaphoresSubmitted GrDrawingManager::flush(GrSurfaceProxy* proxies[], int num
     opMemoryPool->isEmpty();
 #endif
 
+    // If the ops recorded since the last flush are all gone their memory is reclaimed at once.
+    fContext->priv().opMemoryPool()->resetFrameArena();
+
     GrSemaphoresSubmitted result = gpu->finishFlush(proxies, numProxies, access, info,
                                                     externalRequests);
 
@@ -548,6 +583,9 @@ void GrDrawingManager::moveOpListsToDDL(SkDeferredDisplayList* ddl) {
 
     fDAG.swap(&ddl->fOpLists);
 
+    // The DDL's ops might not run before the ones recorded next.
+    fBlurDownsampleCache.reset();
+
     if (fPathRendererChain) {
         if (auto ccpr = fPathRendererChain->getCoverageCountingPathRenderer()) {
             ddl->fPendingPaths = ccpr->detachPendingPaths();
@@ -712,7 +750,11 @@ GrPathRenderer* GrDrawingManager::getPathRenderer(const GrPathRenderer::CanDrawP
         fPathRendererChain.reset(new GrPathRendererChain(fContext, fOptionsForPathRendererChain));
     }
 
-    GrPathRenderer* pr = fPathRendererChain->getPathRenderer(args, drawType, stencilSupport);
+    GrAuditTrail* auditTrail = fContext->priv().auditTrail();
+    GrPathRendererChain::Rejections rejections;
+    const bool collectRejections = GR_GPU_STATS || auditTrail->isEnabled();
+    GrPathRenderer* pr = fPathRendererChain->getPathRenderer(
+            args, drawType, stencilSupport, collectRejections ? &rejections : nullptr);
     if (!pr && allowSW) {
         auto swPR = this->getSoftwarePathRenderer();
         if (GrPathRenderer::CanDrawPath::kNo != swPR->canDrawPath(args)) {
@@ -720,6 +762,17 @@ GrPathRenderer* GrDrawingManager::getPathRenderer(const GrPathRenderer::CanDrawP
         }
     }
 
+    if (!rejections.empty()) {
+        fPathRendererStats.recordRejections(rejections);
+        if (auditTrail->isEnabled()) {
+            for (const GrPathRendererChain::Rejection& rejection : rejections) {
+                SkString frame = SkStringPrintf("Path renderer %s passed: %s", rejection.fRenderer,
+                                                rejection.fReason);
+                auditTrail->pushFrame(frame.c_str());
+            }
+        }
+    }
+
     return pr;
 }
 
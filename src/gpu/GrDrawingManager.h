@@ -11,6 +11,7 @@
 #include <set>
 #include "include/core/SkSurface.h"
 #include "include/private/SkTArray.h"
+#include "src/gpu/GrBlurDownsampleCache.h"
 #include "src/gpu/GrBufferAllocPool.h"
 #include "src/gpu/GrDeferredUpload.h"
 #include "src/gpu/GrPathRenderer.h"
@@ -56,6 +57,9 @@ public:
 
     GrTextContext* getTextContext();
 
+    // Downsampled blur sources, shared by the blurs recorded until the next flush.
+    GrBlurDownsampleCache* blurDownsampleCache() { return &fBlurDownsampleCache; }
+
     GrPathRenderer* getPathRenderer(const GrPathRenderer::CanDrawPathArgs& args,
                                     bool allowSW,
                                     GrPathRendererChain::DrawType drawType,
@@ -63,6 +67,9 @@ public:
 
     GrPathRenderer* getSoftwarePathRenderer();
 
+    // What the path renderers have drawn and passed on, including the software renderer.
+    GrPathRendererChain::Stats* pathRendererStats() { return &fPathRendererStats; }
+
     // Returns a direct pointer to the coverage counting path renderer, or null if it is not
     // supported and turned on.
     GrCoverageCountingPathRenderer* getCoverageCountingPathRenderer();
@@ -149,6 +156,7 @@ private:
     bool wasAbandoned() const;
 
     void cleanup();
+    void releaseRingBuffers();
 
     // return true if any opLists were actually executed; false otherwise
     bool executeOpLists(int startIndex, int stopIndex, GrOpFlushState*, int* numOpListsExecuted);
@@ -176,6 +184,9 @@ private:
     // This cache is used by both the vertex and index pools. It reuses memory across multiple
     // flushes.
     sk_sp<GrBufferAllocPool::CpuBufferCache> fCpuBufferCache;
+    // Only made when the caps support persistently mapped buffers.
+    sk_sp<GrBufferAllocPool::RingBuffer> fVertexRing;
+    sk_sp<GrBufferAllocPool::RingBuffer> fIndexRing;
 
     OpListDAG                         fDAG;
     GrOpList*                         fActiveOpList = nullptr;
@@ -186,8 +197,11 @@ private:
 
     std::unique_ptr<GrTextContext>    fTextContext;
 
+    GrBlurDownsampleCache             fBlurDownsampleCache;
+
     std::unique_ptr<GrPathRendererChain> fPathRendererChain;
     sk_sp<GrSoftwarePathRenderer>     fSoftwarePathRenderer;
+    GrPathRendererChain::Stats        fPathRendererStats;
 
     GrTokenTracker                    fTokenTracker;
     bool                              fFlushing;
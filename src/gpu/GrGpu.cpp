@@ -14,6 +14,7 @@
 #include "src/core/SkMathPriv.h"
 #include "src/gpu/GrCaps.h"
 #include "src/gpu/GrContextPriv.h"
+#include "src/gpu/GrGpuCapture.h"
 #include "src/gpu/GrGpuResourcePriv.h"
 #include "src/gpu/GrMesh.h"
 #include "src/gpu/GrPathRendering.h"
@@ -127,16 +128,21 @@ sk_sp<GrTexture> GrGpu::createTexture(const GrSurfaceDesc& origDesc, SkBudgeted
     SkASSERT(!GrPixelConfigIsCompressed(desc.fConfig) || 1 == desc.fSampleCnt);
 
     this->handleDirtyContext();
+    GrGpuCapture::AutoCommand capture(fCapture, GrGpuCapture::Op::kCreateTexture);
     sk_sp<GrTexture> tex = this->onCreateTexture(desc, budgeted, texels, mipLevelCount);
     if (tex) {
         if (!this->caps()->reuseScratchTextures() && !isRT) {
             tex->resourcePriv().removeScratchKey();
         }
         fStats.incTextureCreates();
-        if (mipLevelCount) {
-            if (texels[0].fPixels) {
-                fStats.incTextureUploads();
-            }
+        bool uploaded = mipLevelCount && texels[0].fPixels;
+        if (uploaded) {
+            fStats.incTextureUploads();
+        }
+        if (GrGpuCapture::Command* command = capture.command()) {
+            command->fRect = SkIRect::MakeWH(desc.fWidth, desc.fHeight);
+            command->fCount = uploaded ? mipLevelCount : 0;
+            capture.succeeded(tex.get());
         }
     }
     return tex;
@@ -226,6 +232,17 @@ sk_sp<GrGpuBuffer> GrGpu::createBuffer(size_t size, GrGpuBufferType intendedType
     return buffer;
 }
 
+sk_sp<GrGpuBuffer> GrGpu::createPersistentlyMappedBuffer(size_t size,
+                                                         GrGpuBufferType intendedType,
+                                                         void** mappedPtr) {
+    SkASSERT(mappedPtr);
+    if (!this->caps()->persistentlyMappedBufferSupport()) {
+        return nullptr;
+    }
+    this->handleDirtyContext();
+    return this->onCreatePersistentlyMappedBuffer(size, intendedType, mappedPtr);
+}
+
 bool GrGpu::copySurface(GrSurface* dst, GrSurfaceOrigin dstOrigin,
                         GrSurface* src, GrSurfaceOrigin srcOrigin,
                         const SkIRect& srcRect, const SkIPoint& dstPoint,
@@ -239,8 +256,18 @@ bool GrGpu::copySurface(GrSurface* dst, GrSurfaceOrigin dstOrigin,
 
     this->handleDirtyContext();
 
-    return this->onCopySurface(dst, dstOrigin, src, srcOrigin, srcRect, dstPoint,
-                               canDiscardOutsideDstRect);
+    GrGpuCapture::AutoCommand capture(fCapture, GrGpuCapture::Op::kCopySurface);
+    if (!this->onCopySurface(dst, dstOrigin, src, srcOrigin, srcRect, dstPoint,
+                             canDiscardOutsideDstRect)) {
+        return false;
+    }
+    if (GrGpuCapture::Command* command = capture.command()) {
+        command->fSrc = GrGpuCapture::DescribeSurface(src);
+        command->fRect = srcRect;
+        command->fDstPoint = dstPoint;
+        capture.succeeded(dst);
+    }
+    return true;
 }
 
 bool GrGpu::readPixels(GrSurface* surface, int left, int top, int width, int height,
@@ -291,11 +318,17 @@ bool GrGpu::writePixels(GrSurface* surface, int left, int top, int width, int he
     }
 
     this->handleDirtyContext();
+    GrGpuCapture::AutoCommand capture(fCapture, GrGpuCapture::Op::kWritePixels);
     if (this->onWritePixels(surface, left, top, width, height, srcColorType, texels,
                             mipLevelCount)) {
         SkIRect rect = SkIRect::MakeXYWH(left, top, width, height);
         this->didWriteToSurface(surface, kTopLeft_GrSurfaceOrigin, &rect, mipLevelCount);
         fStats.incTextureUploads();
+        if (GrGpuCapture::Command* command = capture.command()) {
+            command->fRect = rect;
+            command->fCount = mipLevelCount;
+            capture.succeeded(surface);
+        }
         return true;
     }
     return false;
@@ -319,11 +352,17 @@ bool GrGpu::transferPixelsTo(GrTexture* texture, int left, int top, int width, i
     }
 
     this->handleDirtyContext();
+    GrGpuCapture::AutoCommand capture(fCapture, GrGpuCapture::Op::kTransferPixelsTo);
     if (this->onTransferPixelsTo(texture, left, top, width, height, bufferColorType, transferBuffer,
                                  offset, rowBytes)) {
         SkIRect rect = SkIRect::MakeXYWH(left, top, width, height);
         this->didWriteToSurface(texture, kTopLeft_GrSurfaceOrigin, &rect);
         fStats.incTransfersToTexture();
+        if (GrGpuCapture::Command* command = capture.command()) {
+            command->fRect = rect;
+            command->fCount = 1;
+            capture.succeeded(texture);
+        }
 
         return true;
     }
@@ -346,9 +385,15 @@ bool GrGpu::transferPixelsFrom(GrSurface* surface, int left, int top, int width,
     }
 
     this->handleDirtyContext();
+    GrGpuCapture::AutoCommand capture(fCapture, GrGpuCapture::Op::kTransferPixelsFrom);
     if (this->onTransferPixelsFrom(surface, left, top, width, height, bufferColorType,
                                    transferBuffer, offset)) {
         fStats.incTransfersFromSurface();
+        if (GrGpuCapture::Command* command = capture.command()) {
+            command->fRect = SkIRect::MakeXYWH(left, top, width, height);
+            command->fCount = 1;
+            capture.succeeded(surface);
+        }
         return true;
     }
     return false;
@@ -363,8 +408,15 @@ bool GrGpu::regenerateMipMapLevels(GrTexture* texture) {
     if (texture->readOnly()) {
         return false;
     }
+    GrGpuCapture::AutoCommand capture(fCapture, GrGpuCapture::Op::kRegenerateMipMaps);
     if (this->onRegenerateMipMapLevels(texture)) {
         texture->texturePriv().markMipMapsClean();
+        fStats.incNumMipMapRegenerations(1);
+        if (GrGpuCapture::Command* command = capture.command()) {
+            command->fRect = SkIRect::MakeWH(texture->width(), texture->height());
+            command->fCount = texture->texturePriv().maxMipMapLevel() + 1;
+            capture.succeeded(texture);
+        }
         return true;
     }
     return false;
@@ -482,11 +534,38 @@ void GrGpu::Stats::dump(SkString* out) {
     out->appendf("Transfers from Surface: %d\n", fTransfersFromSurface);
     out->appendf("Stencil Buffer Creates: %d\n", fStencilAttachmentCreates);
     out->appendf("Number of draws: %d\n", fNumDraws);
+    out->appendf("Pipelines Created Warm: %d\n", fNumWarmPipelineCreates);
+    out->appendf("Pipelines Created Cold: %d\n", fNumColdPipelineCreates);
+    out->appendf("Ops Merged: %d\n", fNumMergedOps);
+    out->appendf("Ops Chained: %d\n", fNumChainedOps);
+    out->appendf("Tessellation Cache Hits: %d\n", fNumTessellationCacheHits);
+    out->appendf("Tessellation Cache Misses: %d\n", fNumTessellationCacheMisses);
+    out->appendf("Uniform Uploads: %d\n", fNumUniformUploads);
+    out->appendf("Uniform Uploads Skipped: %d\n", fNumSkippedUniformUploads);
+    out->appendf("Mip Map Regenerations: %d\n", fNumMipMapRegenerations);
+    out->appendf("Mip Map Regeneration Batches: %d\n", fNumMipMapRegenerationBatches);
 }
 
 void GrGpu::Stats::dumpKeyValuePairs(SkTArray<SkString>* keys, SkTArray<double>* values) {
     keys->push_back(SkString("render_target_binds")); values->push_back(fRenderTargetBinds);
     keys->push_back(SkString("shader_compilations")); values->push_back(fShaderCompilations);
+    keys->push_back(SkString("warm_pipeline_creates"));
+    values->push_back(fNumWarmPipelineCreates);
+    keys->push_back(SkString("cold_pipeline_creates"));
+    values->push_back(fNumColdPipelineCreates);
+    keys->push_back(SkString("merged_ops")); values->push_back(fNumMergedOps);
+    keys->push_back(SkString("chained_ops")); values->push_back(fNumChainedOps);
+    keys->push_back(SkString("tessellation_cache_hits"));
+    values->push_back(fNumTessellationCacheHits);
+    keys->push_back(SkString("tessellation_cache_misses"));
+    values->push_back(fNumTessellationCacheMisses);
+    keys->push_back(SkString("uniform_uploads")); values->push_back(fNumUniformUploads);
+    keys->push_back(SkString("skipped_uniform_uploads"));
+    values->push_back(fNumSkippedUniformUploads);
+    keys->push_back(SkString("mipmap_regenerations"));
+    values->push_back(fNumMipMapRegenerations);
+    keys->push_back(SkString("mipmap_regeneration_batches"));
+    values->push_back(fNumMipMapRegenerationBatches);
 }
 
 #endif
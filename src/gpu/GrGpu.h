@@ -25,6 +25,7 @@
 class GrBackendRenderTarget;
 class GrBackendSemaphore;
 class GrGpuBuffer;
+class GrGpuCapture;
 class GrContext;
 struct GrContextOptions;
 class GrGLContext;
@@ -41,7 +42,9 @@ class GrStencilAttachment;
 class GrStencilSettings;
 class GrSurface;
 class GrTexture;
+class SkData;
 class SkJSONWriter;
+class SkTaskGroup;
 
 class GrGpu : public SkRefCnt {
 public:
@@ -145,6 +148,21 @@ public:
     sk_sp<GrGpuBuffer> createBuffer(size_t size, GrGpuBufferType intendedType,
                                     GrAccessPattern accessPattern, const void* data = nullptr);
 
+    /**
+     * Creates a buffer in GPU memory that stays mapped, coherently, for its whole life, so the CPU
+     * can write it at any time without map() or unmap(). The caller must use fences to avoid
+     * writing any part that the GPU may still be reading. Only supported when
+     * GrCaps::persistentlyMappedBufferSupport() is true.
+     *
+     * @param size            size of buffer to create.
+     * @param intendedType    hint to the graphics subsystem about what the buffer will be used for.
+     * @param mappedPtr       returns the address where the CPU writes the buffer's contents.
+     *
+     * @return the buffer if successful, otherwise nullptr.
+     */
+    sk_sp<GrGpuBuffer> createPersistentlyMappedBuffer(size_t size, GrGpuBufferType intendedType,
+                                                      void** mappedPtr);
+
     /**
      * Resolves MSAA.
      */
@@ -355,6 +373,38 @@ public:
         void incNumDraws() { fNumDraws++; }
         void incNumFailedDraws() { ++fNumFailedDraws; }
         void incNumFinishFlushes() { ++fNumFinishFlushes; }
+        // A pipeline is warm if the backend could seed its creation from persistent cache data.
+        int numWarmPipelineCreates() const { return fNumWarmPipelineCreates; }
+        int numColdPipelineCreates() const { return fNumColdPipelineCreates; }
+        void incNumPipelineCreates(bool warm) {
+            ++(warm ? fNumWarmPipelineCreates : fNumColdPipelineCreates);
+        }
+        // Ops combined into another op at record time, and ops drawn as part of another op's
+        // chain, in executed op lists.
+        int numMergedOps() const { return fNumMergedOps; }
+        int numChainedOps() const { return fNumChainedOps; }
+        void incNumMergedOps(int count) { fNumMergedOps += count; }
+        void incNumChainedOps(int count) { fNumChainedOps += count; }
+        // Lookups of cached path tessellations by GrTessellatingPathRenderer.
+        int numTessellationCacheHits() const { return fNumTessellationCacheHits; }
+        int numTessellationCacheMisses() const { return fNumTessellationCacheMisses; }
+        void incNumTessellationCacheHits() { ++fNumTessellationCacheHits; }
+        void incNumTessellationCacheMisses() { ++fNumTessellationCacheMisses; }
+        // Uniform values the backend sent to the driver, and ones it skipped because the program
+        // already held them.
+        int numUniformUploads() const { return fNumUniformUploads; }
+        int numSkippedUniformUploads() const { return fNumSkippedUniformUploads; }
+        void incNumUniformUploads(bool uploaded) {
+            ++(uploaded ? fNumUniformUploads : fNumSkippedUniformUploads);
+        }
+        // Textures whose mip levels were regenerated, and the batches they were regenerated in. A
+        // backend that regenerates several textures' levels together counts them as one batch.
+        int numMipMapRegenerations() const { return fNumMipMapRegenerations; }
+        int numMipMapRegenerationBatches() const { return fNumMipMapRegenerationBatches; }
+        void incNumMipMapRegenerations(int textureCount) {
+            fNumMipMapRegenerations += textureCount;
+            ++fNumMipMapRegenerationBatches;
+        }
 #if GR_TEST_UTILS
         void dump(SkString*);
         void dumpKeyValuePairs(SkTArray<SkString>* keys, SkTArray<double>* values);
@@ -373,6 +423,16 @@ public:
         int fNumDraws = 0;
         int fNumFailedDraws = 0;
         int fNumFinishFlushes = 0;
+        int fNumWarmPipelineCreates = 0;
+        int fNumColdPipelineCreates = 0;
+        int fNumMergedOps = 0;
+        int fNumChainedOps = 0;
+        int fNumTessellationCacheHits = 0;
+        int fNumTessellationCacheMisses = 0;
+        int fNumUniformUploads = 0;
+        int fNumSkippedUniformUploads = 0;
+        int fNumMipMapRegenerations = 0;
+        int fNumMipMapRegenerationBatches = 0;
 #else
 
 #if GR_TEST_UTILS
@@ -388,12 +448,24 @@ public:
         void incNumDraws() {}
         void incNumFailedDraws() {}
         void incNumFinishFlushes() {}
+        void incNumPipelineCreates(bool) {}
+        void incNumMergedOps(int) {}
+        void incNumChainedOps(int) {}
+        void incNumTessellationCacheHits() {}
+        void incNumTessellationCacheMisses() {}
+        void incNumUniformUploads(bool) {}
+        void incNumMipMapRegenerations(int) {}
 #endif
     };
 
     Stats* stats() { return &fStats; }
     void dumpJSON(SkJSONWriter*) const;
 
+    // While a capture is set, the commands given to this GrGpu and its command buffers are added
+    // to it. The caller keeps ownership, and must clear it before deleting it.
+    void setCapture(GrGpuCapture* capture) { fCapture = capture; }
+    GrGpuCapture* capture() const { return fCapture; }
+
     // TODO: remove this method
     GrBackendTexture createTestingOnlyBackendTexture(int w, int h, SkColorType,
                                                      GrMipMapped, GrRenderable,
@@ -483,6 +555,13 @@ public:
 
     virtual void storeVkPipelineCacheData() {}
 
+    // See GrContext::precompileShader().
+    virtual bool precompileShader(const SkData& key, const SkData& data) { return false; }
+
+    // Called once the owning GrContext has set up its task group and persistent cache, so that
+    // backends can start loading cached data in the background.
+    virtual void prewarmPersistentCache(SkTaskGroup*) {}
+
 protected:
     // Handles cases where a surface will be updated without a call to flushRenderTarget.
     void didWriteToSurface(GrSurface* surface, GrSurfaceOrigin origin, const SkIRect* bounds,
@@ -526,6 +605,10 @@ private:
 
     virtual sk_sp<GrGpuBuffer> onCreateBuffer(size_t size, GrGpuBufferType intendedType,
                                               GrAccessPattern, const void* data) = 0;
+    virtual sk_sp<GrGpuBuffer> onCreatePersistentlyMappedBuffer(size_t size, GrGpuBufferType,
+                                                                void** mappedPtr) {
+        return nullptr;
+    }
 
     // overridden by backend-specific derived class to perform the surface read
     virtual bool onReadPixels(GrSurface*, int left, int top, int width, int height, GrColorType,
@@ -574,6 +657,7 @@ private:
     // The context owns us, not vice-versa, so this ptr is not ref'ed by Gpu.
     GrContext* fContext;
     GrSamplePatternDictionary fSamplePatternDictionary;
+    GrGpuCapture* fCapture = nullptr;
 
     friend class GrPathRendering;
     typedef SkRefCnt INHERITED;
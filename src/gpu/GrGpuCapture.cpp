@@ -0,0 +1,577 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/gpu/GrGpuCapture.h"
+
+#include "include/core/SkData.h"
+#include "include/core/SkStream.h"
+#include "include/core/SkTime.h"
+#include "include/gpu/GrContext.h"
+#include "include/gpu/GrRenderTarget.h"
+#include "include/gpu/GrTexture.h"
+#include "include/private/SkTemplates.h"
+#include "src/core/SkMipMap.h"
+#include "src/core/SkOpts.h"
+#include "src/gpu/GrCaps.h"
+#include "src/gpu/GrContextPriv.h"
+#include "src/gpu/GrFixedClip.h"
+#include "src/gpu/GrGpu.h"
+#include "src/gpu/GrGpuCommandBuffer.h"
+#include "src/gpu/GrMesh.h"
+#include "src/gpu/GrPrimitiveProcessor.h"
+#include "src/gpu/GrProgramDesc.h"
+#include "src/gpu/GrRenderTargetPriv.h"
+#include "src/gpu/GrTexturePriv.h"
+#include "src/utils/SkJSON.h"
+#include "src/utils/SkJSONWriter.h"
+
+#include <limits>
+
+static constexpr int kCaptureVersion = 1;
+
+static const char* const kOpNames[] = {
+    "createTexture",
+    "writePixels",
+    "transferPixelsTo",
+    "transferPixelsFrom",
+    "copySurface",
+    "regenerateMipMaps",
+    "clear",
+    "draw",
+};
+static_assert(SK_ARRAY_COUNT(kOpNames) == GrGpuCapture::kOpCount, "op_names_match_ops");
+
+const char* GrGpuCapture::OpName(Op op) { return kOpNames[static_cast<int>(op)]; }
+
+GrGpuCapture::Surface GrGpuCapture::DescribeSurface(const GrSurface* surface) {
+    Surface desc;
+    if (surface) {
+        desc.fID = surface->uniqueID().asUInt();
+        desc.fWidth = surface->width();
+        desc.fHeight = surface->height();
+        desc.fConfig = surface->config();
+        desc.fRenderTarget = SkToBool(surface->asRenderTarget());
+        const GrTexture* texture = surface->asTexture();
+        desc.fMipMapped = texture && GrMipMapped::kYes == texture->texturePriv().mipMapped();
+    }
+    return desc;
+}
+
+GrGpuCapture::AutoCommand::AutoCommand(GrGpuCapture* capture, Op op)
+        : fCapture(capture), fStartNs(0) {
+    if (fCapture) {
+        fCommand.fOp = op;
+        fStartNs = SkTime::GetNSecs();
+    }
+}
+
+void GrGpuCapture::AutoCommand::succeeded(const GrSurface* dst) {
+    if (fCapture) {
+        fCommand.fMs = (SkTime::GetNSecs() - fStartNs) * 1e-6;
+        fCommand.fDst = DescribeSurface(dst);
+        fCapture->fCommands.push_back(fCommand);
+    }
+}
+
+namespace {
+
+// Counts the vertices a mesh draws, or its indices if it's indexed, over all of its instances.
+class VertexCounter : public GrMesh::SendToGpuImpl {
+public:
+    int count() const { return fCount; }
+
+    void sendMeshToGpu(GrPrimitiveType, const GrBuffer*, int vertexCount, int) override {
+        fCount += vertexCount;
+    }
+    void sendIndexedMeshToGpu(GrPrimitiveType, const GrBuffer*, int indexCount, int, uint16_t,
+                              uint16_t, const GrBuffer*, int, GrPrimitiveRestart) override {
+        fCount += indexCount;
+    }
+    void sendInstancedMeshToGpu(GrPrimitiveType, const GrBuffer*, int vertexCount, int,
+                                const GrBuffer*, int instanceCount, int) override {
+        fCount += vertexCount * instanceCount;
+    }
+    void sendIndexedInstancedMeshToGpu(GrPrimitiveType, const GrBuffer*, int indexCount, int,
+                                       const GrBuffer*, int, const GrBuffer*, int instanceCount,
+                                       int, GrPrimitiveRestart) override {
+        fCount += indexCount * instanceCount;
+    }
+
+private:
+    int fCount = 0;
+};
+
+}  // anonymous namespace
+
+void GrGpuCapture::recordDraw(GrGpu* gpu, const GrRenderTarget* rt,
+                              const GrPrimitiveProcessor& primProc, const GrPipeline& pipeline,
+                              const GrMesh meshes[], int meshCount, double ms) {
+    Command command;
+    command.fOp = Op::kDraw;
+    command.fDst = DescribeSurface(rt);
+    command.fCount = meshCount;
+    command.fMs = ms;
+
+    VertexCounter counter;
+    for (int i = 0; i < meshCount; ++i) {
+        meshes[i].sendToGpu(&counter);
+    }
+    command.fVertexCount = counter.count();
+
+    GrProgramDesc desc;
+    bool hasPoints = meshCount && GrPrimitiveType::kPoints == meshes[0].primitiveType();
+    if (GrProgramDesc::Build(&desc, rt, primProc, hasPoints, pipeline, gpu)) {
+        uint32_t hash = SkOpts::hash(desc.asKey(), desc.keyLength());
+        int* index = fProgramIndices.find(hash);
+        if (!index) {
+            index = fProgramIndices.set(hash, fPrograms.count());
+            fPrograms.push_back({hash, SkToInt(desc.keyLength()), SkString(primProc.name()), 0});
+        }
+        ++fPrograms[*index].fDrawCount;
+        command.fProgram = *index;
+    }
+    fCommands.push_back(command);
+}
+
+void GrGpuCapture::reset() {
+    fCommands.reset();
+    fPrograms.reset();
+    fProgramIndices.reset();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void write_surface(SkJSONWriter* writer, const char* name,
+                          const GrGpuCapture::Surface& surface) {
+    writer->beginObject(name, false);
+    writer->appendS32("id", SkToS32(surface.fID));
+    writer->appendS32("width", surface.fWidth);
+    writer->appendS32("height", surface.fHeight);
+    writer->appendS32("config", surface.fConfig);
+    writer->appendBool("renderTarget", surface.fRenderTarget);
+    writer->appendBool("mipMapped", surface.fMipMapped);
+    writer->endObject();
+}
+
+sk_sp<SkData> GrGpuCapture::serialize() const {
+    SkDynamicMemoryWStream stream;
+    SkJSONWriter writer(&stream, SkJSONWriter::Mode::kPretty);
+    writer.beginObject();
+    writer.appendS32("version", kCaptureVersion);
+
+    writer.beginArray("programs");
+    for (const Program& program : fPrograms) {
+        writer.beginObject(nullptr, false);
+        // The reader's numbers are int32s or floats, so the hash goes out as a hex string.
+        writer.appendHexU32("keyHash", program.fKeyHash);
+        writer.appendS32("keyLength", program.fKeyLength);
+        writer.appendString("primitiveProcessor", program.fPrimitiveProcessor.c_str());
+        writer.appendS32("draws", program.fDrawCount);
+        writer.endObject();
+    }
+    writer.endArray();
+
+    writer.beginArray("commands");
+    for (const Command& command : fCommands) {
+        writer.beginObject(nullptr, false);
+        writer.appendString("op", OpName(command.fOp));
+        writer.appendDoubleDigits("ms", command.fMs, 6);
+        write_surface(&writer, "dst", command.fDst);
+        if (Op::kCopySurface == command.fOp) {
+            write_surface(&writer, "src", command.fSrc);
+            writer.beginArray("dstPoint", false);
+            writer.appendS32(command.fDstPoint.fX);
+            writer.appendS32(command.fDstPoint.fY);
+            writer.endArray();
+        }
+        if (Op::kDraw == command.fOp) {
+            writer.appendS32("meshes", command.fCount);
+            writer.appendS32("vertices", command.fVertexCount);
+            writer.appendS32("program", command.fProgram);
+        } else {
+            writer.beginArray("rect", false);
+            writer.appendS32(command.fRect.fLeft);
+            writer.appendS32(command.fRect.fTop);
+            writer.appendS32(command.fRect.fRight);
+            writer.appendS32(command.fRect.fBottom);
+            writer.endArray();
+            writer.appendS32("levels", command.fCount);
+        }
+        writer.endObject();
+    }
+    writer.endArray();
+
+    writer.endObject();
+    writer.flush();
+    return stream.detachAsData();
+}
+
+static bool read_number(const skjson::ObjectValue& object, const char* name, double* value) {
+    const skjson::NumberValue* number = object[name];
+    if (!number) {
+        return false;
+    }
+    *value = **number;
+    return true;
+}
+
+static bool fits_in_int(double number) {
+    return number >= std::numeric_limits<int>::min() && number <= std::numeric_limits<int>::max();
+}
+
+static bool read_int(const skjson::ObjectValue& object, const char* name, int* value) {
+    double number;
+    if (!read_number(object, name, &number) || !fits_in_int(number)) {
+        return false;
+    }
+    *value = static_cast<int>(number);
+    return true;
+}
+
+static bool read_ints(const skjson::ObjectValue& object, const char* name, int* values,
+                      size_t count) {
+    const skjson::ArrayValue* array = object[name];
+    if (!array || array->size() != count) {
+        return false;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        const skjson::NumberValue* number = (*array)[i];
+        if (!number || !fits_in_int(**number)) {
+            return false;
+        }
+        values[i] = static_cast<int>(**number);
+    }
+    return true;
+}
+
+static bool read_surface(const skjson::ObjectValue& object, const char* name,
+                         GrGpuCapture::Surface* surface) {
+    const skjson::ObjectValue* desc = object[name];
+    if (!desc) {
+        return false;
+    }
+    int id;
+    int config;
+    const skjson::BoolValue* renderTarget = (*desc)["renderTarget"];
+    const skjson::BoolValue* mipMapped = (*desc)["mipMapped"];
+    if (!read_int(*desc, "id", &id) || id < 0 ||
+        !read_int(*desc, "width", &surface->fWidth) ||
+        !read_int(*desc, "height", &surface->fHeight) ||
+        !read_int(*desc, "config", &config) || config < 0 || config >= kGrPixelConfigCnt ||
+        !renderTarget || !mipMapped) {
+        return false;
+    }
+    surface->fID = static_cast<uint32_t>(id);
+    surface->fConfig = static_cast<GrPixelConfig>(config);
+    surface->fRenderTarget = **renderTarget;
+    surface->fMipMapped = **mipMapped;
+    return true;
+}
+
+bool GrGpuCapture::deserialize(const void* json, size_t length) {
+    this->reset();
+
+    skjson::DOM dom(static_cast<const char*>(json), length);
+    const skjson::ObjectValue* root = dom.root();
+    int version;
+    if (!root || !read_int(*root, "version", &version) || kCaptureVersion != version) {
+        return false;
+    }
+    const skjson::ArrayValue* programs = (*root)["programs"];
+    const skjson::ArrayValue* commands = (*root)["commands"];
+    if (!programs || !commands) {
+        return false;
+    }
+
+    bool ok = true;
+    for (const skjson::ObjectValue* value : *programs) {
+        if (!value) {
+            ok = false;
+            break;
+        }
+        Program program;
+        const skjson::StringValue* hash = (*value)["keyHash"];
+        const skjson::StringValue* primProc = (*value)["primitiveProcessor"];
+        if (!hash || !primProc || !read_int(*value, "keyLength", &program.fKeyLength) ||
+            !read_int(*value, "draws", &program.fDrawCount)) {
+            ok = false;
+            break;
+        }
+        program.fKeyHash = static_cast<uint32_t>(strtoul(hash->begin(), nullptr, 16));
+        program.fPrimitiveProcessor.set(primProc->begin(), primProc->size());
+        fProgramIndices.set(program.fKeyHash, fPrograms.count());
+        fPrograms.push_back(std::move(program));
+    }
+
+    for (const skjson::ObjectValue* value : *commands) {
+        if (!ok || !value) {
+            ok = false;
+            break;
+        }
+        const skjson::StringValue* opName = (*value)["op"];
+        Command command;
+        ok = opName && read_number(*value, "ms", &command.fMs) &&
+             read_surface(*value, "dst", &command.fDst);
+        int op = 0;
+        while (ok && op < kOpCount && strcmp(opName->begin(), kOpNames[op])) {
+            ++op;
+        }
+        if (!ok || op == kOpCount) {
+            ok = false;
+            break;
+        }
+        command.fOp = static_cast<Op>(op);
+        if (Op::kCopySurface == command.fOp) {
+            ok = read_surface(*value, "src", &command.fSrc) &&
+                 read_ints(*value, "dstPoint", &command.fDstPoint.fX, 2);
+        }
+        if (Op::kDraw == command.fOp) {
+            ok = ok && read_int(*value, "meshes", &command.fCount) &&
+                 read_int(*value, "vertices", &command.fVertexCount) &&
+                 read_int(*value, "program", &command.fProgram) &&
+                 command.fProgram >= -1 && command.fProgram < fPrograms.count();
+        } else {
+            ok = ok && read_ints(*value, "rect", &command.fRect.fLeft, 4) &&
+                 read_int(*value, "levels", &command.fCount);
+        }
+        if (ok) {
+            fCommands.push_back(command);
+        }
+    }
+
+    if (!ok) {
+        this->reset();
+    }
+    return ok;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#if GR_TEST_UTILS
+
+namespace {
+
+// Stands in for the captured context's surfaces, by their IDs in that context.
+class ReplaySurfaces {
+public:
+    explicit ReplaySurfaces(GrGpu* gpu) : fGpu(gpu) {}
+
+    GrTexture* find(const GrGpuCapture::Surface& surface) const {
+        const sk_sp<GrTexture>* texture = fTextures.find(surface.fID);
+        return texture ? texture->get() : nullptr;
+    }
+
+    // Surfaces the capture saw but didn't create (e.g. wrapped ones) are made on first use.
+    GrTexture* findOrMake(const GrGpuCapture::Surface& surface) {
+        if (GrTexture* texture = this->find(surface)) {
+            return texture;
+        }
+        GrSurfaceDesc desc;
+        desc.fFlags = surface.fRenderTarget ? kRenderTarget_GrSurfaceFlag : kNone_GrSurfaceFlags;
+        desc.fWidth = surface.fWidth;
+        desc.fHeight = surface.fHeight;
+        desc.fConfig = surface.fConfig;
+        desc.fSampleCnt = 1;
+
+        sk_sp<GrTexture> texture;
+        if (surface.fMipMapped && fGpu->caps()->mipMapSupport()) {
+            int levelCount = SkMipMap::ComputeLevelCount(desc.fWidth, desc.fHeight) + 1;
+            if (levelCount > 1) {
+                std::unique_ptr<GrMipLevel[]> texels(new GrMipLevel[levelCount]);
+                for (int i = 0; i < levelCount; ++i) {
+                    texels[i] = {nullptr, 0};
+                }
+                texture = fGpu->createTexture(desc, SkBudgeted::kNo, texels.get(), levelCount);
+            }
+        }
+        if (!texture) {
+            texture = fGpu->createTexture(desc, SkBudgeted::kNo);
+        }
+        if (texture) {
+            fTextures.set(surface.fID, texture);
+        }
+        return texture.get();
+    }
+
+private:
+    GrGpu* fGpu;
+    SkTHashMap<uint32_t, sk_sp<GrTexture>> fTextures;
+};
+
+}  // anonymous namespace
+
+// Writes zeros: the capture only knows how much was uploaded, not what.
+static bool replay_write_pixels(GrGpu* gpu, GrTexture* texture, const SkIRect& rect,
+                                int levelCount) {
+    GrColorType colorType = GrPixelConfigToColorType(texture->config());
+    if (rect.isEmpty() || GrColorType::kUnknown == colorType ||
+        GrPixelConfigIsCompressed(texture->config())) {
+        return false;
+    }
+    size_t bpp = GrColorTypeBytesPerPixel(colorType);
+    levelCount = GrMipMapped::kYes == texture->texturePriv().mipMapped()
+            ? SkTPin(levelCount, 1, texture->texturePriv().maxMipMapLevel() + 1)
+            : 1;
+    SkAutoTMalloc<char> pixels(bpp * rect.width() * rect.height());
+    memset(pixels.get(), 0, bpp * rect.width() * rect.height());
+    SkAutoTArray<GrMipLevel> levels(levelCount);
+    for (int i = 0; i < levelCount; ++i) {
+        levels[i] = {pixels.get(), bpp * SkTMax(rect.width() >> i, 1)};
+    }
+    return gpu->writePixels(texture, rect.fLeft, rect.fTop, rect.width(), rect.height(), colorType,
+                            levels.get(), levelCount);
+}
+
+static bool replay_transfer(GrGpu* gpu, GrGpuCapture::Op op, GrTexture* texture,
+                            const SkIRect& rect) {
+    GrColorType colorType = GrPixelConfigToColorType(texture->config());
+    if (rect.isEmpty() || GrColorType::kUnknown == colorType ||
+        !gpu->caps()->transferBufferSupport()) {
+        return false;
+    }
+    size_t size = GrColorTypeBytesPerPixel(colorType) * rect.width() * rect.height();
+    if (GrGpuCapture::Op::kTransferPixelsTo == op) {
+        sk_sp<GrGpuBuffer> buffer = gpu->createBuffer(size, GrGpuBufferType::kXferCpuToGpu,
+                                                      kStream_GrAccessPattern);
+        return buffer && gpu->transferPixelsTo(texture, rect.fLeft, rect.fTop, rect.width(),
+                                               rect.height(), colorType, buffer.get(), 0, 0);
+    }
+    if (!gpu->caps()->transferFromOffsetAlignment(colorType)) {
+        return false;
+    }
+    sk_sp<GrGpuBuffer> buffer = gpu->createBuffer(size, GrGpuBufferType::kXferGpuToCpu,
+                                                  kStream_GrAccessPattern);
+    return buffer && gpu->transferPixelsFrom(texture, rect.fLeft, rect.fTop, rect.width(),
+                                             rect.height(), colorType, buffer.get(), 0);
+}
+
+static bool replay_clear(GrGpu* gpu, GrRenderTarget* rt, const SkIRect& rect) {
+    const GrCaps& caps = *gpu->caps();
+    SkIRect bounds = SkIRect::MakeWH(rt->width(), rt->height());
+    SkIRect clearRect = rect;
+    if (!clearRect.intersect(bounds)) {
+        return false;
+    }
+    bool partial = clearRect != bounds;
+    if (caps.performColorClearsAsDraws() || (partial && caps.performPartialClearsAsDraws())) {
+        return false;
+    }
+    GrGpuRTCommandBuffer* commandBuffer = gpu->getCommandBuffer(
+            rt, kTopLeft_GrSurfaceOrigin, SkRect::Make(bounds),
+            {GrLoadOp::kLoad, GrStoreOp::kStore, SK_PMColor4fTRANSPARENT},
+            {GrLoadOp::kLoad, GrStoreOp::kStore});
+    if (!commandBuffer) {
+        return false;
+    }
+    commandBuffer->begin();
+    commandBuffer->clear(partial ? GrFixedClip(clearRect) : GrFixedClip::Disabled(),
+                         SK_PMColor4fTRANSPARENT);
+    commandBuffer->end();
+    gpu->submit(commandBuffer);
+    return true;
+}
+
+void GrGpuCapture::replay(GrContext* context, ReplayResult* result) const {
+    GrGpu* gpu = context->priv().getGpu();
+    ReplaySurfaces surfaces(gpu);
+
+    for (const Command& command : fCommands) {
+        int op = static_cast<int>(command.fOp);
+        ++result->fCount[op];
+        result->fLiveMs[op] += command.fMs;
+        if (Op::kDraw == command.fOp) {
+            continue;
+        }
+
+        // Make the surfaces before starting the clock, unless making one is the command.
+        GrTexture* dst = nullptr;
+        GrTexture* src = nullptr;
+        if (Op::kCreateTexture == command.fOp) {
+            if (surfaces.find(command.fDst)) {
+                continue;
+            }
+        } else {
+            dst = surfaces.findOrMake(command.fDst);
+            if (Op::kCopySurface == command.fOp) {
+                src = surfaces.findOrMake(command.fSrc);
+            }
+            if (!dst || (Op::kCopySurface == command.fOp && !src)) {
+                continue;
+            }
+        }
+        if (Op::kRegenerateMipMaps == command.fOp) {
+            if (!gpu->caps()->mipMapSupport() ||
+                GrMipMapped::kNo == dst->texturePriv().mipMapped()) {
+                continue;
+            }
+            if (dst->asRenderTarget() && dst->asRenderTarget()->needsResolve()) {
+                gpu->resolveRenderTarget(dst->asRenderTarget());
+            }
+            dst->texturePriv().markMipMapsDirty();
+        }
+
+        double startNs = SkTime::GetNSecs();
+        bool replayed = false;
+        switch (command.fOp) {
+            case Op::kCreateTexture:
+                dst = surfaces.findOrMake(command.fDst);
+                replayed = dst && (!command.fCount ||
+                                   replay_write_pixels(gpu, dst, command.fRect, command.fCount));
+                break;
+            case Op::kWritePixels:
+                replayed = replay_write_pixels(gpu, dst, command.fRect, command.fCount);
+                break;
+            case Op::kTransferPixelsTo:
+            case Op::kTransferPixelsFrom:
+                replayed = replay_transfer(gpu, command.fOp, dst, command.fRect);
+                break;
+            case Op::kCopySurface: {
+                // GrGpu expects copies to have been clipped to both surfaces already.
+                SkIRect dstRect = SkIRect::MakeXYWH(command.fDstPoint.fX, command.fDstPoint.fY,
+                                                    command.fRect.width(), command.fRect.height());
+                replayed = !command.fRect.isEmpty() &&
+                           SkIRect::MakeWH(src->width(), src->height()).contains(command.fRect) &&
+                           SkIRect::MakeWH(dst->width(), dst->height()).contains(dstRect) &&
+                           gpu->copySurface(dst, kTopLeft_GrSurfaceOrigin, src,
+                                            kTopLeft_GrSurfaceOrigin, command.fRect,
+                                            command.fDstPoint);
+                break;
+            }
+            case Op::kRegenerateMipMaps:
+                replayed = gpu->regenerateMipMapLevels(dst);
+                break;
+            case Op::kClear:
+                replayed = dst->asRenderTarget() &&
+                           replay_clear(gpu, dst->asRenderTarget(), command.fRect);
+                break;
+            case Op::kDraw:
+                SkASSERT(false);
+                break;
+        }
+        if (replayed) {
+            ++result->fReplayed[op];
+            result->fReplayMs[op] += (SkTime::GetNSecs() - startNs) * 1e-6;
+        }
+    }
+
+    double startNs = SkTime::GetNSecs();
+    gpu->testingOnly_flushGpuAndSync();
+    result->fFinishMs += (SkTime::GetNSecs() - startNs) * 1e-6;
+}
+
+void GrGpuCapture::ReplayResult::dump(SkString* out) const {
+    out->appendf("%-20s %8s %8s %10s %10s\n", "op", "count", "replayed", "live_ms", "replay_ms");
+    for (int i = 0; i < kOpCount; ++i) {
+        if (fCount[i]) {
+            out->appendf("%-20s %8d %8d %10.3f %10.3f\n", kOpNames[i], fCount[i], fReplayed[i],
+                         fLiveMs[i], fReplayMs[i]);
+        }
+    }
+    out->appendf("%-20s %8s %8s %10s %10.3f\n", "finish", "", "", "", fFinishMs);
+}
+
+#endif
@@ -0,0 +1,150 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrGpuCapture_DEFINED
+#define GrGpuCapture_DEFINED
+
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkString.h"
+#include "include/private/GrTypesPriv.h"
+#include "include/private/SkTArray.h"
+#include "include/private/SkTHash.h"
+
+class GrContext;
+class GrGpu;
+class GrMesh;
+class GrPipeline;
+class GrPrimitiveProcessor;
+class GrRenderTarget;
+class GrSurface;
+class SkData;
+
+/**
+ * A record of the commands a GrGpu was given while it was attached with GrGpu::setCapture():
+ * surface creation, uploads, transfers, copies, mip regeneration, clears and draws, each with the
+ * CPU time the GrGpu call took. Draws keep the program key of the draw (as a hash, with the
+ * primitive processor that made it) rather than the processors themselves.
+ *
+ * A capture can be written to and read back from JSON, and replayed against another GrContext's
+ * GrGpu. Replay recreates the surfaces and repeats everything but the draws, which can't be
+ * rebuilt without their ops; it reports how many there were and what they cost live. This makes
+ * it possible to compare the backend's cost of the same command stream on different contexts
+ * (including the mock context) without recording the ops that produced it.
+ *
+ * The CPU time of a command buffer clear or draw is only the time to record it on backends that
+ * execute command buffers at submit, such as Vulkan.
+ */
+class GrGpuCapture {
+public:
+    enum class Op {
+        kCreateTexture,
+        kWritePixels,
+        kTransferPixelsTo,
+        kTransferPixelsFrom,
+        kCopySurface,
+        kRegenerateMipMaps,
+        kClear,
+        kDraw,
+
+        kLast = kDraw
+    };
+    static constexpr int kOpCount = static_cast<int>(Op::kLast) + 1;
+
+    static const char* OpName(Op);
+
+    // Enough about a surface to make one like it on replay. fID is the surface's unique ID in the
+    // captured context.
+    struct Surface {
+        uint32_t      fID = 0;
+        int           fWidth = 0;
+        int           fHeight = 0;
+        GrPixelConfig fConfig = kUnknown_GrPixelConfig;
+        bool          fRenderTarget = false;
+        bool          fMipMapped = false;
+    };
+
+    struct Command {
+        Op       fOp = Op::kDraw;
+        Surface  fDst;
+        // Copies only.
+        Surface  fSrc;
+        SkIPoint fDstPoint = {0, 0};
+        // The pixels written, read, copied (in fSrc) or cleared. Draws leave this empty.
+        SkIRect  fRect = SkIRect::MakeEmpty();
+        // Mip levels uploaded, or meshes drawn.
+        int      fCount = 0;
+        // Draws only: the vertices drawn, and the program that drew them.
+        int      fVertexCount = 0;
+        int      fProgram = -1;
+        double   fMs = 0;
+    };
+
+    struct Program {
+        uint32_t fKeyHash;
+        int      fKeyLength;
+        SkString fPrimitiveProcessor;
+        int      fDrawCount;
+    };
+
+    // Times a GrGpu call, and adds a command for it if the call succeeds. Everything is a no-op
+    // without a capture, so the GrGpu can make one of these for every call.
+    class AutoCommand {
+    public:
+        AutoCommand(GrGpuCapture*, Op);
+
+        // The command to fill in, or null without a capture.
+        Command* command() { return fCapture ? &fCommand : nullptr; }
+        // Adds the command, timed up to now.
+        void succeeded(const GrSurface* dst);
+
+    private:
+        GrGpuCapture* fCapture;
+        Command       fCommand;
+        double        fStartNs;
+    };
+
+    static Surface DescribeSurface(const GrSurface*);
+
+    // Called by GrGpuRTCommandBuffer::draw() to record the program a successful draw used.
+    void recordDraw(GrGpu*, const GrRenderTarget*, const GrPrimitiveProcessor&, const GrPipeline&,
+                    const GrMesh[], int meshCount, double ms);
+
+    const SkTArray<Command>& commands() const { return fCommands; }
+    const SkTArray<Program>& programs() const { return fPrograms; }
+    void reset();
+
+    sk_sp<SkData> serialize() const;
+    // Returns false, leaving this empty, if the data isn't a capture.
+    bool deserialize(const void* json, size_t length);
+
+#if GR_TEST_UTILS
+    struct ReplayResult {
+        // Per Op: the commands seen, those actually replayed on the GrGpu, and the CPU time they
+        // took live and on replay.
+        int    fCount[kOpCount] = {};
+        int    fReplayed[kOpCount] = {};
+        double fLiveMs[kOpCount] = {};
+        double fReplayMs[kOpCount] = {};
+        // The time to flush and wait for the GPU once all the commands were issued.
+        double fFinishMs = 0;
+
+        void dump(SkString*) const;
+    };
+
+    // Replays the commands against the context's GrGpu, and waits for the GPU to finish them.
+    void replay(GrContext*, ReplayResult*) const;
+#endif
+
+private:
+    SkTArray<Command>         fCommands;
+    SkTArray<Program>         fPrograms;
+    // Indices into fPrograms by key hash.
+    SkTHashMap<uint32_t, int> fProgramIndices;
+};
+
+#endif
@@ -8,12 +8,14 @@
 #include "src/gpu/GrGpuCommandBuffer.h"
 
 #include "include/core/SkRect.h"
+#include "include/core/SkTime.h"
 #include "include/gpu/GrContext.h"
 #include "include/gpu/GrRenderTarget.h"
 #include "src/gpu/GrCaps.h"
 #include "src/gpu/GrContextPriv.h"
 #include "src/gpu/GrFixedClip.h"
 #include "src/gpu/GrGpu.h"
+#include "src/gpu/GrGpuCapture.h"
 #include "src/gpu/GrMesh.h"
 #include "src/gpu/GrPrimitiveProcessor.h"
 #include "src/gpu/GrRenderTargetPriv.h"
@@ -24,7 +26,14 @@ void GrGpuRTCommandBuffer::clear(const GrFixedClip& clip, const SkPMColor4f& col
     // be redirected to draws instead
     SkASSERT(!this->gpu()->caps()->performColorClearsAsDraws());
     SkASSERT(!clip.scissorEnabled() || !this->gpu()->caps()->performPartialClearsAsDraws());
+    GrGpuCapture::AutoCommand capture(this->gpu()->capture(), GrGpuCapture::Op::kClear);
     this->onClear(clip, color);
+    if (GrGpuCapture::Command* command = capture.command()) {
+        command->fRect = clip.scissorEnabled()
+                ? clip.scissorRect()
+                : SkIRect::MakeWH(fRenderTarget->width(), fRenderTarget->height());
+        capture.succeeded(fRenderTarget);
+    }
 }
 
 void GrGpuRTCommandBuffer::clearStencilClip(const GrFixedClip& clip, bool insideStencilMask) {
@@ -87,8 +96,14 @@ bool GrGpuRTCommandBuffer::draw(const GrPrimitiveProcessor& primProc, const GrPi
         this->gpu()->stats()->incNumFailedDraws();
         return false;
     }
+    GrGpuCapture* capture = this->gpu()->capture();
+    double startNs = capture ? SkTime::GetNSecs() : 0;
     this->onDraw(primProc, pipeline, fixedDynamicState, dynamicStateArrays, meshes, meshCount,
                  bounds);
+    if (capture) {
+        capture->recordDraw(this->gpu(), fRenderTarget, primProc, pipeline, meshes, meshCount,
+                            (SkTime::GetNSecs() - startNs) * 1e-6);
+    }
 #ifdef SK_DEBUG
     GrProcessor::CustomFeatures processorFeatures = primProc.requestedFeatures();
     for (int i = 0; i < pipeline.numFragmentProcessors(); ++i) {
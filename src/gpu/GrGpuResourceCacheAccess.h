@@ -64,6 +64,12 @@ private:
     uint32_t timestamp() const { return fResource->fTimestamp; }
     void setTimestamp(uint32_t ts) { fResource->fTimestamp = ts; }
 
+    double purgeKey() const { return fResource->fPurgeKey; }
+    void setPurgeKey(double key) { fResource->fPurgeKey = key; }
+
+    bool wasReused() const { return fResource->fWasReused; }
+    void setWasReused() { fResource->fWasReused = true; }
+
     void setTimeWhenResourceBecomePurgeable() {
         SkASSERT(fResource->isPurgeable());
         fResource->fTimeWhenBecamePurgeable = GrStdSteadyClock::now();
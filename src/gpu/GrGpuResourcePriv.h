@@ -70,6 +70,14 @@ public:
      */
     void removeScratchKey() const { fResource->removeScratchKey();  }
 
+    /**
+     * Hints at what recreating the resource would cost, e.g. the time in microseconds its
+     * contents took to compute. The cost-aware purge policy (see GrContextOptions) keeps
+     * resources that are expensive for their size longer. Defaults to 0: cheap to recreate.
+     */
+    void setRebuildCostHint(float cost) { fResource->fRebuildCostHint = SkTMax(cost, 0.0f); }
+    float rebuildCostHint() const { return fResource->fRebuildCostHint; }
+
     bool isPurgeable() const { return fResource->isPurgeable(); }
 
     bool hasRefOrPendingIO() const { return fResource->hasRefOrPendingIO(); }
@@ -0,0 +1,150 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/gpu/GrImageFilterCache.h"
+
+#include "include/gpu/GrContext.h"
+#include "include/private/GrTextureProxy.h"
+#include "src/core/SkOpts.h"
+#include "src/core/SkSpecialImage.h"
+#include "src/gpu/GrContextPriv.h"
+#include "src/gpu/GrProxyProvider.h"
+
+static constexpr int kKeyData32Count = sizeof(SkImageFilterCacheKey) / sizeof(uint32_t);
+static_assert(sizeof(SkImageFilterCacheKey) % sizeof(uint32_t) == 0, "key_is_whole_words");
+
+GrImageFilterCache::Record::Record(const SkImageFilterCacheKey& key,
+                                   const GrUniqueKey& textureKey, bool ownsTextureKey,
+                                   GrSurfaceOrigin origin, const SkSpecialImage* image,
+                                   const SkIPoint& offset, const SkImageFilter* filter)
+        : fKey(key)
+        , fTextureKey(textureKey)
+        , fOwnsTextureKey(ownsTextureKey)
+        , fOrigin(origin)
+        , fSubset(image->subset())
+        , fImageID(image->uniqueID())
+        , fAlphaType(image->alphaType())
+        , fColorSpace(sk_ref_sp(image->getColorSpace()))
+        , fProps(image->props())
+        , fOffset(offset)
+        , fFilter(filter) {}
+
+uint32_t GrImageFilterCache::Record::Hash(const SkImageFilterCacheKey& key) {
+    return SkOpts::hash(reinterpret_cast<const uint32_t*>(&key), sizeof(SkImageFilterCacheKey));
+}
+
+GrImageFilterCache::GrImageFilterCache(GrContext* context) : fContext(context) {}
+
+GrImageFilterCache::~GrImageFilterCache() {
+    // The context is going away with its resources, so there are no texture keys to remove.
+    while (Record* record = fLRU.head()) {
+        fLRU.remove(record);
+        fLookup.remove(record->fKey);
+        delete record;
+    }
+}
+
+sk_sp<SkSpecialImage> GrImageFilterCache::get(const SkImageFilterCacheKey& key,
+                                              SkIPoint* offset) const {
+    Record* record = fLookup.find(key);
+    if (!record) {
+        return nullptr;
+    }
+
+    sk_sp<GrTextureProxy> proxy = fContext->priv().proxyProvider()->findOrCreateProxyByUniqueKey(
+            record->fTextureKey, record->fOrigin);
+    if (!proxy) {
+        // The resource cache purged the texture.
+        fLRU.remove(record);
+        fLookup.remove(record->fKey);
+        delete record;
+        return nullptr;
+    }
+
+    if (record != fLRU.head()) {
+        fLRU.remove(record);
+        fLRU.addToHead(record);
+    }
+    *offset = record->fOffset;
+    return SkSpecialImage::MakeDeferredFromGpu(fContext, record->fSubset, record->fImageID,
+                                               std::move(proxy), record->fColorSpace,
+                                               &record->fProps, record->fAlphaType);
+}
+
+void GrImageFilterCache::set(const SkImageFilterCacheKey& key, SkSpecialImage* image,
+                             const SkIPoint& offset, const SkImageFilter* filter) {
+    if (Record* record = fLookup.find(key)) {
+        this->remove(record);
+    }
+
+    // A result with the source's ID is the source itself, e.g. from an offset. Its texture is
+    // the layer being filtered, which should go back to being a scratch texture when it's done.
+    if (!image->isTextureBacked() || image->uniqueID() == key.fSrcGenID) {
+        return;
+    }
+    sk_sp<GrTextureProxy> proxy = image->asTextureProxyRef(fContext);
+    if (!proxy) {
+        return;
+    }
+
+    GrUniqueKey textureKey = proxy->getUniqueKey();
+    const bool ownsTextureKey = !textureKey.isValid();
+    if (ownsTextureKey) {
+        static const GrUniqueKey::Domain kDomain = GrUniqueKey::GenerateDomain();
+        {
+            GrUniqueKey::Builder builder(&textureKey, kDomain, kKeyData32Count, "Image Filter");
+            const uint32_t* data = reinterpret_cast<const uint32_t*>(&key);
+            for (int i = 0; i < kKeyData32Count; ++i) {
+                builder[i] = data[i];
+            }
+        }
+        if (!fContext->priv().proxyProvider()->assignUniqueKeyToProxy(textureKey, proxy.get())) {
+            return;
+        }
+    }
+
+    Record* record = new Record(key, textureKey, ownsTextureKey, proxy->origin(), image, offset,
+                                filter);
+    fLookup.add(record);
+    fLRU.addToHead(record);
+
+    while (fLookup.count() > kMaxRecords) {
+        this->remove(fLRU.tail());
+    }
+}
+
+void GrImageFilterCache::purge() {
+    while (Record* record = fLRU.tail()) {
+        this->remove(record);
+    }
+}
+
+void GrImageFilterCache::purgeByImageFilter(const SkImageFilter* filter) {
+    SkTInternalLList<Record>::Iter iter;
+    Record* record = iter.init(fLRU, SkTInternalLList<Record>::Iter::kHead_IterStart);
+    while (record) {
+        Record* next = iter.next();
+        if (record->fFilter == filter) {
+            this->remove(record);
+        }
+        record = next;
+    }
+}
+
+void GrImageFilterCache::remove(Record* record) const {
+    if (record->fOwnsTextureKey) {
+        // Drop our key from the texture, so it can be reused as a scratch texture or freed.
+        GrProxyProvider* proxyProvider = fContext->priv().proxyProvider();
+        if (sk_sp<GrTextureProxy> proxy = proxyProvider->findOrCreateProxyByUniqueKey(
+                record->fTextureKey, record->fOrigin)) {
+            proxyProvider->removeUniqueKeyFromProxy(proxy.get());
+        }
+    }
+    fLRU.remove(record);
+    fLookup.remove(record->fKey);
+    delete record;
+}
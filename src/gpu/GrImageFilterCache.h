@@ -0,0 +1,76 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrImageFilterCache_DEFINED
+#define GrImageFilterCache_DEFINED
+
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkSurfaceProps.h"
+#include "include/private/GrResourceKey.h"
+#include "src/core/SkImageFilterCache.h"
+#include "src/core/SkTDynamicHash.h"
+#include "src/core/SkTInternalLList.h"
+
+class GrContext;
+
+/**
+ * An SkImageFilterCache that keeps a GrContext's image filter results from one draw to the next,
+ * e.g. a blurred background that is drawn again every frame. Rather than holding refs on the
+ * results, it gives their textures unique keys. They stay in the GrResourceCache as purgeable
+ * resources, and are purged under the same budget as everything else. This only keeps a small
+ * record per result; a record whose texture has been purged is a miss.
+ */
+class GrImageFilterCache : public SkImageFilterCache {
+public:
+    explicit GrImageFilterCache(GrContext*);
+    ~GrImageFilterCache() override;
+
+    sk_sp<SkSpecialImage> get(const SkImageFilterCacheKey&, SkIPoint* offset) const override;
+    void set(const SkImageFilterCacheKey&, SkSpecialImage*, const SkIPoint& offset,
+             const SkImageFilter*) override;
+    void purge() override;
+    void purgeByImageFilter(const SkImageFilter*) override;
+    SkDEBUGCODE(int count() const override { return fLookup.count(); })
+
+private:
+    // Records beyond this many are dropped, least recently used first.
+    static constexpr int kMaxRecords = 1024;
+
+    struct Record {
+        Record(const SkImageFilterCacheKey& key, const GrUniqueKey& textureKey,
+               bool ownsTextureKey, GrSurfaceOrigin origin, const SkSpecialImage* image,
+               const SkIPoint& offset, const SkImageFilter* filter);
+
+        SkImageFilterCacheKey fKey;
+        GrUniqueKey           fTextureKey;
+        // False if the texture already had a unique key of its own, which we must not remove.
+        bool                  fOwnsTextureKey;
+        GrSurfaceOrigin       fOrigin;
+        SkIRect               fSubset;
+        uint32_t              fImageID;
+        SkAlphaType           fAlphaType;
+        sk_sp<SkColorSpace>   fColorSpace;
+        SkSurfaceProps        fProps;
+        SkIPoint              fOffset;
+        const SkImageFilter*  fFilter;
+
+        static const SkImageFilterCacheKey& GetKey(const Record& r) { return r.fKey; }
+        static uint32_t Hash(const SkImageFilterCacheKey&);
+        SK_DECLARE_INTERNAL_LLIST_INTERFACE(Record);
+    };
+
+    void remove(Record*) const;
+
+    GrContext*                                             fContext;
+    mutable SkTDynamicHash<Record, SkImageFilterCacheKey>  fLookup;
+    mutable SkTInternalLList<Record>                       fLRU;
+
+    typedef SkImageFilterCache INHERITED;
+};
+
+#endif
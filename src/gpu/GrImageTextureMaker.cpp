@@ -6,7 +6,11 @@
  */
 
 #include "src/gpu/GrColorSpaceXform.h"
+#include "src/gpu/GrContextPriv.h"
 #include "src/gpu/GrImageTextureMaker.h"
+#include "src/gpu/GrProxyProvider.h"
+#include "src/gpu/GrRecordingContextPriv.h"
+#include "src/gpu/GrResourceCache.h"
 #include "src/gpu/SkGr.h"
 #include "src/gpu/effects/GrYUVtoRGBEffect.h"
 #include "src/image/SkImage_GpuYUVA.h"
@@ -28,6 +32,33 @@ sk_sp<GrTextureProxy> GrImageTextureMaker::refOriginalTextureProxy(bool willBeMi
                                     willBeMipped, onlyIfFast);
 }
 
+sk_sp<GrTextureProxy> GrImageTextureMaker::refDownscaledTextureProxy() {
+    // Only a direct context can tell how much of its budget is in use.
+    GrContext* direct = this->context()->priv().asDirectContext();
+    if (!direct || !direct->priv().options().fDownscaleImageTexturesOverBudget) {
+        return nullptr;
+    }
+
+    // Keep using a full resolution texture that is cached already.
+    GrUniqueKey key;
+    fImage->makeCacheKeyFromOrigKey(fOriginalKey, &key);
+    if (key.isValid() && direct->priv().proxyProvider()->findOrCreateProxyByUniqueKey(
+                                 key, kTopLeft_GrSurfaceOrigin)) {
+        return nullptr;
+    }
+
+    // Resources that can be purged make room, so only the ones in use count against the budget.
+    const GrResourceCache* cache = direct->priv().getResourceCache();
+    size_t budgetedBytes = cache->getBudgetedResourceBytes();
+    size_t lockedBytes = budgetedBytes - SkTMin(budgetedBytes, cache->getPurgeableBytes());
+    size_t textureBytes = GrContext::ComputeTextureSize(fImage->colorType(), this->width(),
+                                                        this->height(), GrMipMapped::kNo);
+    if (lockedBytes + textureBytes <= cache->getMaxResourceBytes()) {
+        return nullptr;
+    }
+    return fImage->lockDownscaledTextureProxy(this->context(), fOriginalKey, fCachingHint);
+}
+
 void GrImageTextureMaker::makeCopyKey(const CopyParams& stretch, GrUniqueKey* paramsCopyKey) {
     if (fOriginalKey.isValid() && SkImage::kAllow_CachingHint == fCachingHint) {
         GrUniqueKey cacheKey;
@@ -27,6 +27,8 @@ protected:
     //          GrTexture* generateTextureForParams(const CopyParams&) override;
     sk_sp<GrTextureProxy> refOriginalTextureProxy(bool willBeMipped,
                                                   AllowedTexGenType onlyIfFast) override;
+    // See GrContextOptions::fDownscaleImageTexturesOverBudget.
+    sk_sp<GrTextureProxy> refDownscaledTextureProxy() override;
 
     void makeCopyKey(const CopyParams& stretch, GrUniqueKey* paramsCopyKey) override;
     void didCacheCopy(const GrUniqueKey& copyKey, uint32_t contextUniqueID) override {}
@@ -18,13 +18,35 @@
     #define VALIDATE
 #endif
 
+constexpr size_t GrOpMemoryPool::kFrameArenaAlignment;
+
+GrOpMemoryPool::GrOpMemoryPool(size_t preallocSize, size_t minAllocSize, bool useFrameArena)
+        // The frame arena makes the allocations, so the block pool only keeps its minimum around.
+        : fMemoryPool(useFrameArena ? 0 : preallocSize, minAllocSize) {
+    if (useFrameArena) {
+        fFrameArenaStorage.reset(new char[preallocSize]);
+        fFrameArena.reset(new SkArenaAlloc(fFrameArenaStorage.get(), preallocSize, minAllocSize));
+    }
+}
+
 void GrOpMemoryPool::release(std::unique_ptr<GrOp> op) {
     GrOp* tmp = op.release();
     SkASSERT(tmp);
     tmp->~GrOp();
+    if (fFrameArena) {
+        SkASSERT(fFrameArenaLiveCount > 0);
+        --fFrameArenaLiveCount;
+        return;
+    }
     fMemoryPool.release(tmp);
 }
 
+void GrOpMemoryPool::resetFrameArena() {
+    if (fFrameArena && !fFrameArenaLiveCount) {
+        fFrameArena->reset();
+    }
+}
+
 constexpr size_t GrMemoryPool::kSmallestMinAllocSize;
 
 GrMemoryPool::GrMemoryPool(size_t preallocSize, size_t minAllocSize) {
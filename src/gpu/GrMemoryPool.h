@@ -11,6 +11,9 @@
 #include "include/gpu/GrTypes.h"
 
 #include "include/core/SkRefCnt.h"
+#include "src/core/SkArenaAlloc.h"
+
+#include <memory>
 
 #ifdef SK_DEBUG
 #include "include/private/SkTHash.h"
@@ -130,26 +133,49 @@ class GrOp;
 // ref counting
 class GrOpMemoryPool : public SkRefCnt {
 public:
-    GrOpMemoryPool(size_t preallocSize, size_t minAllocSize)
-            : fMemoryPool(preallocSize, minAllocSize) {
-    }
+    /**
+     * In frame arena mode the ops are allocated from an SkArenaAlloc, whose first preallocSize
+     * bytes are kept across resets. Releasing an op then only runs its destructor, and the memory
+     * of all the ops is reclaimed at once by resetFrameArena() after they have all been released.
+     */
+    GrOpMemoryPool(size_t preallocSize, size_t minAllocSize, bool useFrameArena = false);
 
     template <typename Op, typename... OpArgs>
     std::unique_ptr<Op> allocate(OpArgs&&... opArgs) {
-        char* mem = (char*) fMemoryPool.allocate(sizeof(Op));
+        char* mem = (char*) this->allocate(sizeof(Op));
         return std::unique_ptr<Op>(new (mem) Op(std::forward<OpArgs>(opArgs)...));
     }
 
     void* allocate(size_t size) {
+        if (fFrameArena) {
+            ++fFrameArenaLiveCount;
+            return fFrameArena->makeBytesAlignedTo(size, kFrameArenaAlignment);
+        }
         return fMemoryPool.allocate(size);
     }
 
     void release(std::unique_ptr<GrOp> op);
 
-    bool isEmpty() const { return fMemoryPool.isEmpty(); }
+    bool isEmpty() const {
+        return fFrameArena ? !fFrameArenaLiveCount : fMemoryPool.isEmpty();
+    }
+
+    bool usesFrameArena() const { return SkToBool(fFrameArena); }
+
+    /**
+     * Reclaims the frame arena's memory if every op allocated from it has been released. Ops that
+     * outlive a flush (e.g. the ones held by a DDL) keep the arena alive until a later reset.
+     */
+    void resetFrameArena();
 
 private:
-    GrMemoryPool fMemoryPool;
+    // Matches the alignment GrMemoryPool guarantees.
+    static constexpr size_t kFrameArenaAlignment = 8;
+
+    GrMemoryPool                  fMemoryPool;
+    std::unique_ptr<char[]>       fFrameArenaStorage;
+    std::unique_ptr<SkArenaAlloc> fFrameArena;
+    int                           fFrameArenaLiveCount = 0;
 };
 
 #endif
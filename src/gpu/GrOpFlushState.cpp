@@ -17,9 +17,11 @@
 
 GrOpFlushState::GrOpFlushState(GrGpu* gpu, GrResourceProvider* resourceProvider,
                                GrResourceCache* cache, GrTokenTracker* tokenTracker,
-                               sk_sp<GrBufferAllocPool::CpuBufferCache> cpuBufferCache)
-        : fVertexPool(gpu, cpuBufferCache)
-        , fIndexPool(gpu, std::move(cpuBufferCache))
+                               sk_sp<GrBufferAllocPool::CpuBufferCache> cpuBufferCache,
+                               sk_sp<GrBufferAllocPool::RingBuffer> vertexRing,
+                               sk_sp<GrBufferAllocPool::RingBuffer> indexRing)
+        : fVertexPool(gpu, cpuBufferCache, std::move(vertexRing))
+        , fIndexPool(gpu, std::move(cpuBufferCache), std::move(indexRing))
         , fGpu(gpu)
         , fResourceProvider(resourceProvider)
         , fTokenTracker(tokenTracker)
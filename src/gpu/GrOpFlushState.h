@@ -28,9 +28,12 @@ class GrOpFlushState final : public GrDeferredUploadTarget, public GrMeshDrawOp:
 public:
     // vertexSpace and indexSpace may either be null or an alloation of size
     // GrBufferAllocPool::kDefaultBufferSize. If the latter, then CPU memory is only allocated for
-    // vertices/indices when a buffer larger than kDefaultBufferSize is required.
+    // vertices/indices when a buffer larger than kDefaultBufferSize is required. If there are
+    // ring buffers, vertices and indices are written there first.
     GrOpFlushState(GrGpu*, GrResourceProvider*, GrResourceCache*, GrTokenTracker*,
-                   sk_sp<GrBufferAllocPool::CpuBufferCache> = nullptr);
+                   sk_sp<GrBufferAllocPool::CpuBufferCache> = nullptr,
+                   sk_sp<GrBufferAllocPool::RingBuffer> vertexRing = nullptr,
+                   sk_sp<GrBufferAllocPool::RingBuffer> indexRing = nullptr);
 
     ~GrOpFlushState() final { this->reset(); }
 
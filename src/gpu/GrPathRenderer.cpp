@@ -5,8 +5,10 @@
  * found in the LICENSE file.
  */
 
+#include "include/private/GrAuditTrail.h"
 #include "src/core/SkDrawProcs.h"
 #include "src/gpu/GrCaps.h"
+#include "src/gpu/GrDrawingManager.h"
 #include "src/gpu/GrPaint.h"
 #include "src/gpu/GrPathRenderer.h"
 #include "src/gpu/GrRecordingContextPriv.h"
@@ -64,9 +66,19 @@ bool GrPathRenderer::drawPath(const DrawPathArgs& args) {
         SkASSERT(kNoRestriction_StencilSupport == this->getStencilSupport(*args.fShape));
     }
 #endif
+    this->recordUse(args.fContext, *args.fShape);
     return this->onDrawPath(args);
 }
 
+void GrPathRenderer::recordUse(GrRecordingContext* context, const GrShape& shape) {
+    context->priv().drawingManager()->pathRendererStats()->recordUse(this, shape);
+    GrAuditTrail* auditTrail = context->priv().auditTrail();
+    if (auditTrail->isEnabled()) {
+        SkString frame = SkStringPrintf("Path renderer %s", this->name());
+        auditTrail->pushFrame(frame.c_str());
+    }
+}
+
 bool GrPathRenderer::IsStrokeHairlineOrEquivalent(const GrStyle& style, const SkMatrix& matrix,
                                                   SkScalar* outCoverage) {
     if (style.pathEffect()) {
@@ -33,6 +33,9 @@ class SK_API GrPathRenderer : public SkRefCnt {
 public:
     GrPathRenderer();
 
+    /** A short name for the renderer in stats and audit trails, e.g. "ccpr". */
+    virtual const char* name() const = 0;
+
     /**
      * A caller may wish to use a path renderer to draw a path into the stencil buffer. However,
      * the path renderer itself may require use of the stencil buffer. Also a path renderer may
@@ -96,6 +99,11 @@ public:
         // This is only used by GrStencilAndCoverPathRenderer
         bool                        fHasUserStencilSettings;
 
+        // onCanDrawPath() may point this at a short explanation when it returns kNo or kAsBackup,
+        // e.g. "too large". GrPathRendererChain clears it before asking each renderer and collects
+        // the explanations for its stats; nothing else reads it.
+        mutable const char*         fRejectReason;
+
 #ifdef SK_DEBUG
         void validate() const {
             SkASSERT(fCaps);
@@ -169,6 +177,7 @@ public:
     void stencilPath(const StencilPathArgs& args) {
         SkDEBUGCODE(args.validate();)
         SkASSERT(kNoSupport_StencilSupport != this->getStencilSupport(*args.fShape));
+        this->recordUse(args.fContext, *args.fShape);
         this->onStencilPath(args);
     }
 
@@ -187,6 +196,10 @@ protected:
                                  SkRect* bounds);
 
 private:
+    // Counts a draw or stencil in the drawing manager's path renderer stats, and names the renderer
+    // in the audit trail of the op it makes.
+    void recordUse(GrRecordingContext*, const GrShape&);
+
     /**
      * Subclass overrides if it has any limitations of stenciling support.
      */
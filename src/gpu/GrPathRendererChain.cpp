@@ -15,6 +15,7 @@
 #include "src/gpu/GrGpu.h"
 #include "src/gpu/GrRecordingContextPriv.h"
 #include "src/gpu/GrShaderCaps.h"
+#include "src/gpu/GrShape.h"
 #include "src/gpu/ccpr/GrCoverageCountingPathRenderer.h"
 #include "src/gpu/ops/GrAAConvexPathRenderer.h"
 #include "src/gpu/ops/GrAAHairLinePathRenderer.h"
@@ -47,8 +48,10 @@ GrPathRendererChain::GrPathRendererChain(GrRecordingContext* context, const Opti
     }
     if (options.fGpuPathRenderers & GpuPathRenderers::kCoverageCounting) {
         using AllowCaching = GrCoverageCountingPathRenderer::AllowCaching;
+        using AllowResampling = GrCoverageCountingPathRenderer::AllowResampling;
         if (auto ccpr = GrCoverageCountingPathRenderer::CreateIfSupported(
                                 caps, AllowCaching(options.fAllowPathMaskCaching),
+                                AllowResampling(options.fAllowPathMaskResampling),
                                 context->priv().contextID())) {
             fCoverageCountingPathRenderer = ccpr.get();
             context->priv().addOnFlushCallbackObject(fCoverageCountingPathRenderer);
@@ -77,7 +80,8 @@ GrPathRendererChain::GrPathRendererChain(GrRecordingContext* context, const Opti
 GrPathRenderer* GrPathRendererChain::getPathRenderer(
         const GrPathRenderer::CanDrawPathArgs& args,
         DrawType drawType,
-        GrPathRenderer::StencilSupport* stencilSupport) {
+        GrPathRenderer::StencilSupport* stencilSupport,
+        Rejections* rejections) {
     GR_STATIC_ASSERT(GrPathRenderer::kNoSupport_StencilSupport <
                      GrPathRenderer::kStencilOnly_StencilSupport);
     GR_STATIC_ASSERT(GrPathRenderer::kStencilOnly_StencilSupport <
@@ -106,7 +110,11 @@ GrPathRenderer* GrPathRendererChain::getPathRenderer(
                 continue;
             }
         }
+        args.fRejectReason = nullptr;
         GrPathRenderer::CanDrawPath canDrawPath = pr->canDrawPath(args);
+        if (rejections && args.fRejectReason) {
+            rejections->push_back({pr->name(), args.fRejectReason});
+        }
         if (GrPathRenderer::CanDrawPath::kNo == canDrawPath) {
             continue;
         }
@@ -123,3 +131,92 @@ GrPathRenderer* GrPathRendererChain::getPathRenderer(
     }
     return bestPathRenderer;
 }
+
+#if GR_GPU_STATS
+
+void GrPathRendererChain::Stats::recordUse(const GrPathRenderer* pr, const GrShape& shape) {
+    Increment(&fUses, pr->name(), nullptr);
+
+    SkPath path;
+    shape.asPath(&path);
+    int bucket = 0;
+    for (int limit = 4; bucket < kNumVerbCountBuckets - 1 && path.countVerbs() > limit;
+         limit *= 4) {
+        ++bucket;
+    }
+    ++fVerbCounts[bucket];
+}
+
+void GrPathRendererChain::Stats::recordRejections(const Rejections& rejections) {
+    for (const Rejection& rejection : rejections) {
+        Increment(&fRejections, rejection.fRenderer, rejection.fReason);
+    }
+}
+
+int GrPathRendererChain::Stats::numUses(const char* renderer) const {
+    int i = Find(fUses, renderer, nullptr);
+    return i >= 0 ? fUses[i].fCount : 0;
+}
+
+int GrPathRendererChain::Stats::numRejections(const char* renderer, const char* reason) const {
+    int i = Find(fRejections, renderer, reason);
+    return i >= 0 ? fRejections[i].fCount : 0;
+}
+
+void GrPathRendererChain::Stats::Increment(SkTArray<Count>* counts, const char* renderer,
+                                           const char* reason) {
+    int i = Find(*counts, renderer, reason);
+    if (i >= 0) {
+        ++(*counts)[i].fCount;
+    } else {
+        counts->push_back({renderer, reason, 1});
+    }
+}
+
+int GrPathRendererChain::Stats::Find(const SkTArray<Count>& counts, const char* renderer,
+                                     const char* reason) {
+    for (int i = 0; i < counts.count(); ++i) {
+        if (!strcmp(counts[i].fRenderer, renderer) &&
+            (counts[i].fReason == reason ||
+             (counts[i].fReason && reason && !strcmp(counts[i].fReason, reason)))) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+#if GR_TEST_UTILS
+
+static const char* kVerbCountBucketNames[] = {"0-4", "5-16", "17-64", "65-256", "257-1024",
+                                              "1025+"};
+static_assert(SK_ARRAY_COUNT(kVerbCountBucketNames) ==
+              GrPathRendererChain::Stats::kNumVerbCountBuckets, "");
+
+void GrPathRendererChain::Stats::dump(SkString* out) const {
+    for (const Count& use : fUses) {
+        out->appendf("Path Renderer %s: %d\n", use.fRenderer, use.fCount);
+    }
+    for (int i = 0; i < kNumVerbCountBuckets; ++i) {
+        out->appendf("Paths With %s Verbs: %d\n", kVerbCountBucketNames[i], fVerbCounts[i]);
+    }
+    for (const Count& rejection : fRejections) {
+        out->appendf("Path Renderer %s Rejected (%s): %d\n", rejection.fRenderer,
+                     rejection.fReason, rejection.fCount);
+    }
+}
+
+void GrPathRendererChain::Stats::dumpKeyValuePairs(SkTArray<SkString>* keys,
+                                                   SkTArray<double>* values) const {
+    for (const Count& use : fUses) {
+        keys->push_back(SkStringPrintf("path_renderer_%s", use.fRenderer));
+        values->push_back(use.fCount);
+    }
+    for (int i = 0; i < kNumVerbCountBuckets; ++i) {
+        keys->push_back(SkStringPrintf("paths_with_%s_verbs", kVerbCountBucketNames[i]));
+        values->push_back(fVerbCounts[i]);
+    }
+}
+
+#endif
+
+#endif
@@ -17,6 +17,8 @@
 
 class GrContext;
 class GrCoverageCountingPathRenderer;
+class GrShape;
+class SkString;
 
 /**
  * Keeps track of an ordered list of path renderers. When a path needs to be
@@ -28,6 +30,7 @@ class GrPathRendererChain : public SkNoncopyable {
 public:
     struct Options {
         bool fAllowPathMaskCaching = false;
+        bool fAllowPathMaskResampling = false;
         GpuPathRenderers fGpuPathRenderers = GpuPathRenderers::kAll;
     };
     GrPathRendererChain(GrRecordingContext* context, const Options&);
@@ -40,13 +43,22 @@ public:
         kStencilAndColor,  // draw the stencil and color buffer, no AA
     };
 
+    /** A renderer that passed on a path, and the reason it gave (see CanDrawPathArgs). */
+    struct Rejection {
+        const char* fRenderer;
+        const char* fReason;
+    };
+    using Rejections = SkSTArray<4, Rejection>;
+
     /** Returns a GrPathRenderer compatible with the request if one is available. If the caller
         is drawing the path to the stencil buffer then stencilSupport can be used to determine
         whether the path can be rendered with arbitrary stencil rules or not. See comments on
-        StencilSupport in GrPathRenderer.h. */
+        StencilSupport in GrPathRenderer.h. If rejections is not null, the renderers ahead of the
+        returned one that explained why they passed on the path are appended to it. */
     GrPathRenderer* getPathRenderer(const GrPathRenderer::CanDrawPathArgs& args,
                                     DrawType drawType,
-                                    GrPathRenderer::StencilSupport* stencilSupport);
+                                    GrPathRenderer::StencilSupport* stencilSupport,
+                                    Rejections* rejections = nullptr);
 
     /** Returns a direct pointer to the coverage counting path renderer, or null if it is not in the
         chain. */
@@ -54,6 +66,50 @@ public:
         return fCoverageCountingPathRenderer;
     }
 
+    /**
+     * How often each renderer drew (or stenciled) a path, how many verbs those paths had, and why
+     * renderers passed on paths. Kept by the GrDrawingManager, since it also picks the software
+     * renderer, and reported with the GrContext's GPU stats.
+     */
+    class Stats {
+    public:
+#if GR_GPU_STATS
+        // Paths are counted by verb count in buckets of up to 4, 16, 64, 256, 1024 and more.
+        static constexpr int kNumVerbCountBuckets = 6;
+
+        void reset() { *this = Stats(); }
+
+        void recordUse(const GrPathRenderer*, const GrShape&);
+        void recordRejections(const Rejections&);
+
+        int numUses(const char* renderer) const;
+        int numRejections(const char* renderer, const char* reason) const;
+        int numPathsInVerbCountBucket(int bucket) const { return fVerbCounts[bucket]; }
+
+#if GR_TEST_UTILS
+        void dump(SkString*) const;
+        void dumpKeyValuePairs(SkTArray<SkString>* keys, SkTArray<double>* values) const;
+#endif
+
+    private:
+        // There are only a handful of renderers and reasons, so these are searched linearly.
+        struct Count {
+            const char* fRenderer;
+            const char* fReason;  // null for uses
+            int         fCount;
+        };
+        static void Increment(SkTArray<Count>*, const char* renderer, const char* reason);
+        static int Find(const SkTArray<Count>&, const char* renderer, const char* reason);
+
+        SkTArray<Count> fUses;
+        SkTArray<Count> fRejections;
+        int             fVerbCounts[kNumVerbCountBuckets] = {};
+#else
+        void recordUse(const GrPathRenderer*, const GrShape&) {}
+        void recordRejections(const Rejections&) {}
+#endif
+    };
+
 private:
     enum {
         kPreAllocCount = 8,
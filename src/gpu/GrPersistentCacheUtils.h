@@ -9,7 +9,9 @@
 #define GrPersistentCacheEntry_DEFINED
 
 #include "include/core/SkData.h"
+#include "include/core/SkString.h"
 #include "include/private/GrTypesPriv.h"
+#include "include/private/SkTArray.h"
 #include "src/core/SkReader32.h"
 #include "src/core/SkWriter32.h"
 #include "src/sksl/SkSLString.h"
@@ -20,10 +22,20 @@
 // put the serialization logic here, to be shared by the backend code and the tool code.
 namespace GrPersistentCacheUtils {
 
+// Extra state a backend needs to link cached shaders without the processors that generated them
+// (see GrContext::precompileShader()). It is written after the shaders, so tools that only look
+// at the shaders can ignore it.
+struct ShaderMetadata {
+    SkTArray<SkString> fAttributeNames;
+    bool fHasCustomColorOutput = false;
+    bool fHasSecondaryColorOutput = false;
+};
+
 static inline sk_sp<SkData> PackCachedShaders(SkFourByteTag shaderType,
                                               const SkSL::String shaders[],
                                               const SkSL::Program::Inputs inputs[],
-                                              int numInputs) {
+                                              int numInputs,
+                                              const ShaderMetadata* meta = nullptr) {
     // For consistency (so tools can blindly pack and unpack cached shaders), we always write
     // kGrShaderTypeCount inputs. If the backend gives us fewer, we just replicate the last one.
     SkASSERT(numInputs >= 1 && numInputs <= kGrShaderTypeCount);
@@ -34,13 +46,25 @@ static inline sk_sp<SkData> PackCachedShaders(SkFourByteTag shaderType,
         writer.writeString(shaders[i].c_str(), shaders[i].size());
         writer.writePad(&inputs[SkTMin(i, numInputs - 1)], sizeof(SkSL::Program::Inputs));
     }
+    if (meta) {
+        writer.writeInt(meta->fAttributeNames.count());
+        for (const auto& name : meta->fAttributeNames) {
+            writer.writeString(name.c_str(), name.size());
+        }
+        writer.writeBool(meta->fHasCustomColorOutput);
+        writer.writeBool(meta->fHasSecondaryColorOutput);
+    }
     return writer.snapshotAsData();
 }
 
+// If meta is non-null, it is filled in from the data and *hasMeta (if non-null) reports whether
+// the data contained any. Data packed without metadata leaves meta untouched.
 static inline SkFourByteTag UnpackCachedShaders(const SkData* data,
                                                 SkSL::String shaders[],
                                                 SkSL::Program::Inputs inputs[],
-                                                int numInputs) {
+                                                int numInputs,
+                                                ShaderMetadata* meta = nullptr,
+                                                bool* hasMeta = nullptr) {
     SkReader32 reader(data->data(), data->size());
     SkFourByteTag shaderType = reader.readU32();
     for (int i = 0; i < kGrShaderTypeCount; ++i) {
@@ -55,6 +79,21 @@ static inline SkFourByteTag UnpackCachedShaders(const SkData* data,
             reader.skip(sizeof(SkSL::Program::Inputs));
         }
     }
+    bool readMeta = meta && !reader.eof();
+    if (readMeta) {
+        int attributeCount = reader.readInt();
+        meta->fAttributeNames.reset();
+        for (int i = 0; i < attributeCount; ++i) {
+            size_t nameLen = 0;
+            const char* name = reader.readString(&nameLen);
+            meta->fAttributeNames.emplace_back(name, nameLen);
+        }
+        meta->fHasCustomColorOutput = reader.readBool();
+        meta->fHasSecondaryColorOutput = reader.readBool();
+    }
+    if (hasMeta) {
+        *hasMeta = readMeta;
+    }
     return shaderType;
 }
 
@@ -58,7 +58,7 @@ SkTArray<GrXPFactoryTestFactory*, true>* GrXPFactoryTestFactory::GetFactories()
  */
 #if SK_ALLOW_STATIC_GLOBAL_INITIALIZERS
 static const int kFPFactoryCount = 36;
-static const int kGPFactoryCount = 14;
+static const int kGPFactoryCount = 15;
 static const int kXPFactoryCount = 4;
 #else
 static const int kFPFactoryCount = 0;
@@ -20,11 +20,16 @@
 #include "src/core/SkAutoPixmapStorage.h"
 #include "src/core/SkImagePriv.h"
 #include "src/core/SkMipMap.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkTraceEvent.h"
 #include "src/gpu/GrCaps.h"
 #include "src/gpu/GrContextPriv.h"
+#include "src/gpu/GrDataUtils.h"
+#include "src/gpu/GrGpu.h"
+#include "src/gpu/GrGpuBuffer.h"
 #include "src/gpu/GrImageContextPriv.h"
 #include "src/gpu/GrResourceProvider.h"
+#include "src/gpu/GrResourceProviderPriv.h"
 #include "src/gpu/GrSurfaceProxyPriv.h"
 #include "src/gpu/GrTextureProxyCacheAccess.h"
 #include "src/gpu/GrTextureRenderTargetProxy.h"
@@ -300,6 +305,62 @@ sk_sp<GrTextureProxy> GrProxyProvider::createMipMapProxy(const GrBackendFormat&
                              budgeted, GrInternalSurfaceFlags::kNone);
 }
 
+sk_sp<GrTextureProxy> GrProxyProvider::createProxyFromTransferBuffer(
+        const SkImageInfo& info, const WritePixelsFn& writePixels) {
+    ASSERT_SINGLE_OWNER
+
+    if (this->isAbandoned()) {
+        return nullptr;
+    }
+
+    // In ddl there is no gpu to transfer to yet, and we'd have to hold on to the pixels anyway.
+    GrContext* direct = fImageContext->priv().asDirectContext();
+    if (!direct || !this->caps()->transferBufferSupport() ||
+            GrCaps::kNone_MapFlags == this->caps()->mapBufferFlags()) {
+        return nullptr;
+    }
+
+    if (!SkImageInfoIsValid(info)) {
+        return nullptr;
+    }
+
+    const GrSurfaceDesc desc = GrImageInfoToSurfaceDesc(info);
+    const GrColorType colorType = SkColorTypeToGrColorType(info.colorType());
+    if (GrColorType::kUnknown == colorType || !this->caps()->isConfigTexturable(desc.fConfig)) {
+        return nullptr;
+    }
+
+    ATRACE_ANDROID_FRAMEWORK("Upload Texture From Transfer Buffer [%ux%u]",
+                             info.width(), info.height());
+
+    GrResourceProvider* resourceProvider = direct->priv().resourceProvider();
+    const size_t rowBytes = info.minRowBytes();
+    sk_sp<GrGpuBuffer> buffer = resourceProvider->createBuffer(
+            info.computeByteSize(rowBytes), GrGpuBufferType::kXferCpuToGpu,
+            kStream_GrAccessPattern);
+    if (!buffer) {
+        return nullptr;
+    }
+    void* pixels = buffer->map();
+    if (!pixels) {
+        return nullptr;
+    }
+    const bool wrote = writePixels(SkPixmap(info, pixels, rowBytes));
+    buffer->unmap();
+    if (!wrote) {
+        return nullptr;
+    }
+
+    sk_sp<GrTexture> texture = resourceProvider->createTexture(
+            desc, SkBudgeted::kYes, GrResourceProvider::Flags::kNoPendingIO);
+    if (!texture || !resourceProvider->priv().gpu()->transferPixelsTo(
+                texture.get(), 0, 0, info.width(), info.height(), colorType, buffer.get(), 0,
+                rowBytes)) {
+        return nullptr;
+    }
+    return this->createWrapped(std::move(texture), kTopLeft_GrSurfaceOrigin);
+}
+
 sk_sp<GrTextureProxy> GrProxyProvider::createProxyFromBitmap(const SkBitmap& bitmap,
                                                              GrMipMapped mipMapped) {
     ASSERT_SINGLE_OWNER
@@ -330,6 +391,9 @@ sk_sp<GrTextureProxy> GrProxyProvider::createProxyFromBitmap(const SkBitmap& bit
     // If mips weren't requested (or this was too small to have any), then take the fast path
     if (GrMipMapped::kNo == mipMapped ||
         0 == SkMipMap::ComputeLevelCount(baseLevel->width(), baseLevel->height())) {
+        if (auto proxy = this->createCompressedProxyFromBitmap(bitmap)) {
+            return proxy;
+        }
         return this->createTextureProxy(std::move(baseLevel), kNone_GrSurfaceFlags, 1,
                                         SkBudgeted::kYes, SkBackingFit::kExact);
     }
@@ -438,6 +502,64 @@ sk_sp<GrTextureProxy> GrProxyProvider::createProxy(const GrBackendFormat& format
                                                     fit, budgeted, surfaceFlags));
 }
 
+sk_sp<GrTextureProxy> GrProxyProvider::createCompressedProxyFromBitmap(const SkBitmap& bitmap) {
+    const GrContextOptions& options = fImageContext->priv().options();
+    if (!options.fCompressStaticImages || !bitmap.isImmutable() || !bitmap.info().isOpaque() ||
+        (bitmap.width() & 3) || (bitmap.height() & 3) ||
+        !this->caps()->isConfigTexturable(kRGB_ETC1_GrPixelConfig)) {
+        return nullptr;
+    }
+    switch (bitmap.colorType()) {
+        case kRGBA_8888_SkColorType:
+        case kBGRA_8888_SkColorType:
+        case kRGB_888x_SkColorType:
+            break;
+        default:
+            return nullptr;
+    }
+
+    SkPixmap pixmap;
+    SkAutoPixmapStorage rgba;
+    if (!bitmap.peekPixels(&pixmap)) {
+        return nullptr;
+    }
+    if (kRGBA_8888_SkColorType != pixmap.colorType()) {
+        if (!rgba.tryAlloc(pixmap.info().makeColorType(kRGBA_8888_SkColorType)) ||
+            !pixmap.readPixels(rgba)) {
+            return nullptr;
+        }
+        pixmap = rgba;
+    }
+
+    ATRACE_ANDROID_FRAMEWORK("Compress Texture [%ux%u]", bitmap.width(), bitmap.height());
+    const int blocksPerRow = GrNumETC1Blocks(pixmap.width(), 4);
+    const int blockRows = pixmap.height() / 4;
+    sk_sp<SkData> data = SkData::MakeUninitialized(
+            GrNumETC1Blocks(pixmap.width(), pixmap.height()) * sizeof(ETC1Block));
+    auto compressRow = [&](int row) {
+        SkPixmap rowPixmap;
+        SkAssertResult(pixmap.extractSubset(&rowPixmap,
+                                            SkIRect::MakeXYWH(0, 4 * row, pixmap.width(), 4)));
+        GrCompressRGBA8888ToETC1(
+                rowPixmap, static_cast<ETC1Block*>(data->writable_data()) + row * blocksPerRow);
+    };
+    if (options.fExecutor) {
+        SkTaskGroup taskGroup(*options.fExecutor);
+        taskGroup.batch(blockRows, compressRow);
+        taskGroup.wait();
+    } else {
+        for (int row = 0; row < blockRows; ++row) {
+            compressRow(row);
+        }
+    }
+
+    GrSurfaceDesc desc;
+    desc.fWidth = bitmap.width();
+    desc.fHeight = bitmap.height();
+    desc.fConfig = kRGB_ETC1_GrPixelConfig;
+    return this->createProxy(std::move(data), desc);
+}
+
 sk_sp<GrTextureProxy> GrProxyProvider::createProxy(sk_sp<SkData> data, const GrSurfaceDesc& desc) {
     if (!this->caps()->isConfigTexturable(desc.fConfig)) {
         return nullptr;
@@ -13,6 +13,8 @@
 #include "include/private/GrTextureProxy.h"
 #include "src/core/SkTDynamicHash.h"
 
+#include <functional>
+
 class GrImageContext;
 class GrBackendRenderTarget;
 class SkBitmap;
@@ -80,6 +82,17 @@ public:
      */
     sk_sp<GrTextureProxy> createProxyFromBitmap(const SkBitmap& bitmap, GrMipMapped);
 
+    /*
+     * Creates an un-mipmapped texture proxy, and fills it by having writePixels write straight
+     * into a mapped transfer buffer, which is then transferred to the texture. This saves the
+     * allocation and copy of an intermediate bitmap. Returns nullptr (and the caller should
+     * upload another way) if we're not rendering directly, the backend can't map transfer
+     * buffers, or writePixels fails.
+     */
+    using WritePixelsFn = std::function<bool(const SkPixmap&)>;
+    sk_sp<GrTextureProxy> createProxyFromTransferBuffer(const SkImageInfo&,
+                                                        const WritePixelsFn& writePixels);
+
     /*
      * Create a GrSurfaceProxy without any data.
      */
@@ -251,6 +264,10 @@ private:
 
     sk_sp<GrTextureProxy> createWrapped(sk_sp<GrTexture> tex, GrSurfaceOrigin origin);
 
+    // Returns an ETC1 proxy for the bitmap if GrContextOptions::fCompressStaticImages is set and
+    // the bitmap is eligible, and nullptr otherwise.
+    sk_sp<GrTextureProxy> createCompressedProxyFromBitmap(const SkBitmap&);
+
     struct UniquelyKeyedProxyHashTraits {
         static const GrUniqueKey& GetKey(const GrTextureProxy& p) { return p.getUniqueKey(); }
 
@@ -56,7 +56,8 @@ bool GrRecordingContext::init(sk_sp<const GrCaps> caps, sk_sp<GrSkSLFPFactoryCac
     }
 
     fStrikeCache.reset(new GrStrikeCache(this->caps(),
-                                        this->options().fGlyphCacheTextureMaximumBytes));
+                                        this->options().fGlyphCacheTextureMaximumBytes,
+                                        this->options().fDistanceFieldGlyphCache));
 
     fTextBlobCache.reset(new GrTextBlobCache(textblobcache_overbudget_CB, this,
                                              this->contextID()));
@@ -67,6 +68,7 @@ bool GrRecordingContext::init(sk_sp<const GrCaps> caps, sk_sp<GrSkSLFPFactoryCac
 void GrRecordingContext::setupDrawingManager(bool sortOpLists, bool reduceOpListSplitting) {
     GrPathRendererChain::Options prcOptions;
     prcOptions.fAllowPathMaskCaching = this->options().fAllowPathMaskCaching;
+    prcOptions.fAllowPathMaskResampling = this->options().fAllowPathMaskResampling;
 #if GR_TEST_UTILS
     prcOptions.fGpuPathRenderers = this->options().fGpuPathRenderers;
 #endif
@@ -118,7 +120,8 @@ sk_sp<GrOpMemoryPool> GrRecordingContext::refOpMemoryPool() {
         // DDL TODO: should the size of the memory pool be decreased in DDL mode? CPU-side memory
         // consumed in DDL mode vs. normal mode for a single skp might be a good metric of wasted
         // memory.
-        fOpMemoryPool = sk_sp<GrOpMemoryPool>(new GrOpMemoryPool(16384, 16384));
+        fOpMemoryPool = sk_sp<GrOpMemoryPool>(
+                new GrOpMemoryPool(16384, 16384, this->options().fUseFrameArenaForOps));
     }
 
     SkASSERT(fOpMemoryPool);
@@ -107,6 +107,8 @@ public:
 
     GrAuditTrail* auditTrail() { return fContext->auditTrail(); }
 
+    uint32_t* gradientColorizerShapes() { return fContext->gradientColorizerShapes(); }
+
     // CONTEXT TODO: remove this backdoor
     // In order to make progress we temporarily need a way to break CL impasses.
     GrContext* backdoor();
@@ -6,6 +6,7 @@
  */
 
 #include "src/gpu/GrRenderTargetContext.h"
+#include "include/core/SkColorFilter.h"
 #include "include/core/SkDrawable.h"
 #include "include/gpu/GrBackendSemaphore.h"
 #include "include/gpu/GrRenderTarget.h"
@@ -23,9 +24,11 @@
 #include "src/core/SkMatrixPriv.h"
 #include "src/core/SkRRectPriv.h"
 #include "src/core/SkSurfacePriv.h"
+#include "src/core/SkYUVMath.h"
 #include "src/gpu/GrAppliedClip.h"
 #include "src/gpu/GrBlurUtils.h"
 #include "src/gpu/GrCaps.h"
+#include "src/gpu/GrColorSpaceXform.h"
 #include "src/gpu/GrContextPriv.h"
 #include "src/gpu/GrDrawingManager.h"
 #include "src/gpu/GrFixedClip.h"
@@ -44,6 +47,7 @@
 #include "src/gpu/effects/GrBicubicEffect.h"
 #include "src/gpu/effects/GrRRectEffect.h"
 #include "src/gpu/effects/GrTextureDomain.h"
+#include "src/gpu/effects/generated/GrSimpleTextureEffect.h"
 #include "src/gpu/ops/GrAtlasTextOp.h"
 #include "src/gpu/ops/GrClearOp.h"
 #include "src/gpu/ops/GrClearStencilClipOp.h"
@@ -2028,6 +2032,190 @@ void GrRenderTargetContext::asyncRescaleAndReadPixels(
     return rtc->asyncReadPixels(info, x, y, callback, context);
 }
 
+void GrRenderTargetContext::asyncRescaleAndReadPixelsYUV420(
+        SkYUVColorSpace yuvColorSpace, sk_sp<SkColorSpace> dstColorSpace, const SkIRect& srcRect,
+        int dstW, int dstH, SkSurface::RescaleGamma rescaleGamma, SkFilterQuality rescaleQuality,
+        ReadPixelsCallbackYUV420 callback, ReadPixelsContext context) {
+    SkASSERT(srcRect.fLeft >= 0 && srcRect.fRight <= this->width());
+    SkASSERT(srcRect.fTop >= 0 && srcRect.fBottom <= this->height());
+    SkASSERT(dstW > 0 && dstH > 0 && !(dstW & 1) && !(dstH & 1));
+    auto direct = fContext->priv().asDirectContext();
+    if (!direct || fRenderTargetProxy->wrapsVkSecondaryCB()) {
+        callback(context, nullptr, nullptr);
+        return;
+    }
+
+    // The source of the conversion draws: srcRect rescaled to dstW x dstH in dstColorSpace, or,
+    // without a rescale, srcRect of this context with a color space xform to dstColorSpace.
+    sk_sp<GrTextureProxy> srcProxy;
+    int x = srcRect.fLeft;
+    int y = srcRect.fTop;
+    SkColorSpace* srcColorSpace = dstColorSpace.get();
+    if (srcRect.width() != dstW || srcRect.height() != dstH) {
+        auto info = SkImageInfo::Make(dstW, dstH, kRGBA_8888_SkColorType, kPremul_SkAlphaType,
+                                      dstColorSpace);
+        auto rtc = this->rescale(info, srcRect, rescaleGamma, rescaleQuality);
+        if (!rtc) {
+            callback(context, nullptr, nullptr);
+            return;
+        }
+        srcProxy = rtc->asTextureProxyRef();
+        x = y = 0;
+    } else {
+        srcProxy = this->asTextureProxyRef();
+        if (!srcProxy) {
+            srcProxy = GrSurfaceProxy::Copy(fContext, fRenderTargetProxy.get(), GrMipMapped::kNo,
+                                            srcRect, SkBackingFit::kApprox, SkBudgeted::kNo);
+            if (!srcProxy) {
+                callback(context, nullptr, nullptr);
+                return;
+            }
+            x = y = 0;
+        }
+        srcColorSpace = this->colorSpaceInfo().colorSpace();
+    }
+
+    float rgb2yuv[20];
+    SkColorMatrix_RGB2YUV(yuvColorSpace, rgb2yuv);
+
+    // Each plane is drawn into its own alpha-only context, with a color matrix whose alpha row is
+    // one of Y, U or V. The U and V planes sample the center of each 2x2 block with bilerp to
+    // average it.
+    sk_sp<GrRenderTargetContext> planeRTCs[3];
+    const GrBackendFormat a8Format = this->caps()->getBackendFormatFromColorType(
+            kAlpha_8_SkColorType);
+    for (int i = 0; i < 3; ++i) {
+        const int planeW = i ? dstW / 2 : dstW;
+        const int planeH = i ? dstH / 2 : dstH;
+        planeRTCs[i] = direct->priv().makeDeferredRenderTargetContextWithFallback(
+                a8Format, SkBackingFit::kApprox, planeW, planeH, kAlpha_8_GrPixelConfig, nullptr,
+                1, GrMipMapped::kNo, kTopLeft_GrSurfaceOrigin);
+        if (!planeRTCs[i]) {
+            callback(context, nullptr, nullptr);
+            return;
+        }
+
+        float matrix[20] = {};
+        memcpy(matrix + 15, rgb2yuv + 5 * i, 5 * sizeof(float));
+        auto matrixFP = SkColorFilters::Matrix(matrix)->asFragmentProcessor(
+                fContext, planeRTCs[i]->colorSpaceInfo());
+        const float scale = i ? 2.f : 1.f;
+        auto textureFP = GrSimpleTextureEffect::Make(
+                srcProxy, SkMatrix::MakeAll(scale, 0, x, 0, scale, y, 0, 0, 1),
+                i ? GrSamplerState::Filter::kBilerp : GrSamplerState::Filter::kNearest);
+        textureFP = GrColorSpaceXformEffect::Make(std::move(textureFP), srcColorSpace,
+                                                  kPremul_SkAlphaType, dstColorSpace.get());
+        if (!matrixFP || !textureFP) {
+            callback(context, nullptr, nullptr);
+            return;
+        }
+        GrPaint paint;
+        paint.addColorFragmentProcessor(std::move(textureFP));
+        paint.addColorFragmentProcessor(std::move(matrixFP));
+        paint.setPorterDuffXPFactory(SkBlendMode::kSrc);
+        planeRTCs[i]->drawFilledRect(GrNoClip(), std::move(paint), GrAA::kNo, SkMatrix::I(),
+                                     SkRect::MakeIWH(planeW, planeH));
+    }
+
+    struct Plane {
+        SkImageInfo        fReadInfo;
+        SkImageInfo        fDstInfo;
+        sk_sp<GrGpuBuffer> fBuffer;
+        size_t             fRowBytes;
+    };
+    struct FinishContext {
+        ReadPixelsCallbackYUV420* fClientCallback;
+        ReadPixelsContext         fClientContext;
+        Plane                     fPlanes[3];
+    };
+    auto* finishContext = new FinishContext{callback, context, {}};
+    auto finish = [](GrGpuFinishedContext c) {
+        auto context = reinterpret_cast<const FinishContext*>(c);
+        SkAutoPixmapStorage converted[3];
+        const void* data[3] = {};
+        size_t rowBytes[3] = {};
+        int mapped = 0;
+        for (; mapped < 3; ++mapped) {
+            const Plane& plane = context->fPlanes[mapped];
+            data[mapped] = plane.fBuffer->map();
+            if (!data[mapped]) {
+                break;
+            }
+            rowBytes[mapped] = plane.fRowBytes;
+            if (plane.fReadInfo != plane.fDstInfo) {
+                converted[mapped].alloc(plane.fDstInfo);
+                SkConvertPixels(plane.fDstInfo, converted[mapped].writable_addr(),
+                                converted[mapped].rowBytes(), plane.fReadInfo, data[mapped],
+                                plane.fRowBytes);
+                data[mapped] = converted[mapped].addr();
+                rowBytes[mapped] = converted[mapped].rowBytes();
+            }
+        }
+        if (3 == mapped) {
+            (*context->fClientCallback)(context->fClientContext, data, rowBytes);
+        } else {
+            (*context->fClientCallback)(context->fClientContext, nullptr, nullptr);
+        }
+        for (int i = 0; i < mapped; ++i) {
+            context->fPlanes[i].fBuffer->unmap();
+        }
+        delete context;
+    };
+
+    const bool canTransfer = this->caps()->transferBufferSupport();
+    SkAutoPixmapStorage syncPlanes[3];
+    for (int i = 0; i < 3; ++i) {
+        GrRenderTargetContext* rtc = planeRTCs[i].get();
+        const auto dstInfo = SkImageInfo::MakeA8(i ? dstW / 2 : dstW, i ? dstH / 2 : dstH);
+        auto readCT = this->caps()->supportedReadPixelsColorType(rtc->asSurfaceProxy()->config(),
+                                                                 GrColorType::kAlpha_8);
+        if (!canTransfer || GrColorTypeToSkColorType(readCT) == kUnknown_SkColorType ||
+            !this->caps()->transferFromOffsetAlignment(readCT)) {
+            // Without a transfer, read all the planes back synchronously.
+            delete finishContext;
+            const void* data[3];
+            size_t rowBytes[3];
+            for (int j = 0; j < 3; ++j) {
+                syncPlanes[j].alloc(SkImageInfo::MakeA8(j ? dstW / 2 : dstW,
+                                                        j ? dstH / 2 : dstH));
+                if (!planeRTCs[j]->readPixels(syncPlanes[j].info(), syncPlanes[j].writable_addr(),
+                                              syncPlanes[j].rowBytes(), 0, 0)) {
+                    callback(context, nullptr, nullptr);
+                    return;
+                }
+                data[j] = syncPlanes[j].addr();
+                rowBytes[j] = syncPlanes[j].rowBytes();
+            }
+            callback(context, data, rowBytes);
+            return;
+        }
+        Plane& plane = finishContext->fPlanes[i];
+        plane.fDstInfo = dstInfo;
+        plane.fReadInfo = dstInfo.makeColorType(GrColorTypeToSkColorType(readCT));
+        plane.fRowBytes = GrColorTypeBytesPerPixel(readCT) * dstInfo.width();
+        plane.fBuffer = direct->priv().resourceProvider()->createBuffer(
+                plane.fRowBytes * dstInfo.height(), GrGpuBufferType::kXferGpuToCpu,
+                GrAccessPattern::kStream_GrAccessPattern);
+        if (!plane.fBuffer) {
+            delete finishContext;
+            callback(context, nullptr, nullptr);
+            return;
+        }
+        rtc->getRTOpList()->addOp(
+                GrTransferFromOp::Make(fContext, SkIRect::MakeWH(dstInfo.width(),
+                                                                 dstInfo.height()),
+                                       readCT, plane.fBuffer, 0),
+                *this->caps());
+    }
+
+    // As in asyncReadPixels, assume the caller wants the flush. The drawing manager flushes every
+    // op list, so the three transfers all finish before the callback.
+    GrFlushInfo flushInfo;
+    flushInfo.fFinishedContext = finishContext;
+    flushInfo.fFinishedProc = finish;
+    this->flush(SkSurface::BackendSurfaceAccess::kNoAccess, flushInfo);
+}
+
 void GrRenderTargetContext::asyncReadPixels(const SkImageInfo& info, int x, int y,
                                             ReadPixelsCallback callback,
                                             ReadPixelsContext context) {
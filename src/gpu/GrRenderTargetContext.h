@@ -419,6 +419,18 @@ public:
                                    SkSurface::RescaleGamma rescaleGamma,
                                    SkFilterQuality rescaleQuality, ReadPixelsCallback callback,
                                    ReadPixelsContext context);
+    /**
+     * Like asyncRescaleAndReadPixels but the rescaled pixels are converted to Y, U and V planes on
+     * the GPU, and only those are read back. dstW and dstH must be even.
+     */
+    using ReadPixelsCallbackYUV420 = SkSurface::ReadPixelsCallbackYUV420;
+    void asyncRescaleAndReadPixelsYUV420(SkYUVColorSpace yuvColorSpace,
+                                         sk_sp<SkColorSpace> dstColorSpace,
+                                         const SkIRect& srcRect, int dstW, int dstH,
+                                         SkSurface::RescaleGamma rescaleGamma,
+                                         SkFilterQuality rescaleQuality,
+                                         ReadPixelsCallbackYUV420 callback,
+                                         ReadPixelsContext context);
 
     /**
      * After this returns any pending surface IO will be issued to the backend 3D API and
@@ -8,6 +8,7 @@
 #include "include/private/GrAuditTrail.h"
 #include "include/private/GrRecordingContext.h"
 #include "src/core/SkExchange.h"
+#include "src/core/SkPerfCounters.h"
 #include "src/core/SkRectPriv.h"
 #include "src/core/SkTraceEvent.h"
 #include "src/gpu/GrCaps.h"
@@ -24,12 +25,6 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
-// Experimentally we have found that most combining occurs within the first 10 comparisons.
-static const int kMaxOpMergeDistance = 10;
-static const int kMaxOpChainDistance = 10;
-
-////////////////////////////////////////////////////////////////////////////////
-
 using DstProxy = GrXferProcessor::DstProxy;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -208,7 +203,7 @@ GrRenderTargetOpList::OpChain::List GrRenderTargetOpList::OpChain::DoConcat(
                 }
                 break;
             } else {
-                if (++numMergeChecks == kMaxOpMergeDistance) {
+                if (++numMergeChecks == caps.maxOpMergeDistance()) {
                     break;
                 }
                 forwardMergeBounds.joinNonEmptyArg(a->bounds());
@@ -360,6 +355,9 @@ void GrRenderTargetOpList::deleteOps() {
         chain.deleteOps(fOpMemoryPool.get());
     }
     fOpChains.reset();
+    fNumRecordedOps = 0;
+    fNumMergedOps = 0;
+    fNumChainedOps = 0;
 }
 
 GrRenderTargetOpList::~GrRenderTargetOpList() {
@@ -515,6 +513,10 @@ bool GrRenderTargetOpList::onExecute(GrOpFlushState* flushState) {
     flushState->gpu()->submit(commandBuffer);
     flushState->setCommandBuffer(nullptr);
 
+    flushState->gpu()->stats()->incNumMergedOps(fNumMergedOps);
+    SkPerfCounters::Add(SkGraphics::PerfCounter::kGpuOpMerges, fNumMergedOps);
+    flushState->gpu()->stats()->incNumChainedOps(fNumChainedOps);
+
     return true;
 }
 
@@ -677,6 +679,7 @@ void GrRenderTargetOpList::recordOp(
         fOpMemoryPool->release(std::move(op));
         return;
     }
+    ++fNumRecordedOps;
 
     // Check if there is an op we can combine with by linearly searching back until we either
     // 1) check every op
@@ -692,7 +695,7 @@ void GrRenderTargetOpList::recordOp(
                op->bounds().fRight, op->bounds().fBottom);
     GrOP_INFO(SkTabString(op->dumpInfo(), 1).c_str());
     GrOP_INFO("\tOutcome:\n");
-    int maxCandidates = SkTMin(kMaxOpChainDistance, fOpChains.count());
+    int maxCandidates = SkTMin(caps.maxOpChainDistance(), fOpChains.count());
     if (maxCandidates) {
         int i = 0;
         while (true) {
@@ -729,7 +732,7 @@ void GrRenderTargetOpList::forwardCombine(const GrCaps& caps) {
 
     for (int i = 0; i < fOpChains.count() - 1; ++i) {
         OpChain& chain = fOpChains[i];
-        int maxCandidateIdx = SkTMin(i + kMaxOpChainDistance, fOpChains.count() - 1);
+        int maxCandidateIdx = SkTMin(i + caps.maxOpChainDistance(), fOpChains.count() - 1);
         int j = i + 1;
         while (true) {
             OpChain& candidate = fOpChains[j];
@@ -752,5 +755,20 @@ void GrRenderTargetOpList::forwardCombine(const GrCaps& caps) {
             }
         }
     }
+
+    // Every recorded op is now either the head of a chain, chained after another op, or merged
+    // into another op.
+    int numChains = 0, numOps = 0;
+    for (const auto& chain : fOpChains) {
+        if (chain.head()) {
+            ++numChains;
+            for (const auto& op : GrOp::ChainRange<>(chain.head())) {
+                (void)op;
+                ++numOps;
+            }
+        }
+    }
+    fNumMergedOps = fNumRecordedOps - numOps;
+    fNumChainedOps = numOps - numChains;
 }
 
@@ -234,6 +234,12 @@ private:
     // For ops/opList we have mean: 5 stdDev: 28
     SkSTArray<25, OpChain, true> fOpChains;
 
+    // Counted for GrGpu::Stats. Merged ops were combined into another op, and chained ops are
+    // drawn as part of another op's chain. The latter two are computed in forwardCombine().
+    int fNumRecordedOps = 0;
+    int fNumMergedOps = 0;
+    int fNumChainedOps = 0;
+
     // MDB TODO: 4096 for the first allocation of the clip space will be huge overkill.
     // Gather statistics to determine the correct size.
     SkArenaAlloc                   fClipAllocator{4096};
@@ -15,6 +15,7 @@
 #include "src/core/SkExchange.h"
 #include "src/core/SkMessageBus.h"
 #include "src/core/SkOpts.h"
+#include "src/core/SkPerfCounters.h"
 #include "src/core/SkScopeExit.h"
 #include "src/core/SkTSort.h"
 #include "src/gpu/GrCaps.h"
@@ -129,6 +130,47 @@ void GrResourceCache::setLimits(int count, size_t bytes) {
     this->purgeAsNeeded();
 }
 
+void GrResourceCache::setPurgePolicy(PurgePolicy policy) {
+    if (policy == fPurgePolicy) {
+        return;
+    }
+    fPurgePolicy = policy;
+    fPurgeInflation = 0;
+
+    // Reorder the purgeable resources as if they had become purgeable under the new policy.
+    SkTDArray<GrGpuResource*> purgeableResources;
+    purgeableResources.setReserve(fPurgeableQueue.count());
+    while (fPurgeableQueue.count()) {
+        *purgeableResources.append() = fPurgeableQueue.peek();
+        fPurgeableQueue.pop();
+    }
+    for (int i = 0; i < purgeableResources.count(); ++i) {
+        GrGpuResource* resource = purgeableResources[i];
+        resource->cacheAccess().setPurgeKey(this->computePurgeKey(resource));
+        fPurgeableQueue.insert(resource);
+    }
+    this->validate();
+}
+
+double GrResourceCache::computePurgeKey(const GrGpuResource* resource) const {
+    switch (fPurgePolicy) {
+        case PurgePolicy::kLRU:
+            return 0;
+        case PurgePolicy::kCostAware:
+            // GreedyDual-Size: the rebuild cost per byte, on top of the inflation, which rises as
+            // resources are purged so that resources left unused age out.
+            return fPurgeInflation + resource->resourcePriv().rebuildCostHint() /
+                                     SkTMax<size_t>(resource->gpuMemorySize(), 1);
+        case PurgePolicy::kScanResistant:
+            // A reused resource is purged as if it had been used again one cache's worth of
+            // resources later.
+            return double(resource->cacheAccess().timestamp()) +
+                   (resource->cacheAccess().wasReused() ? this->getResourceCount() : 0);
+    }
+    SK_ABORT("Unknown purge policy");
+    return 0;
+}
+
 void GrResourceCache::insertResource(GrGpuResource* resource) {
     ASSERT_SINGLE_OWNER
     SkASSERT(resource);
@@ -412,6 +454,7 @@ void GrResourceCache::refAndMakeResourceMRU(GrGpuResource* resource) {
         fNumBudgetedResourcesFlushWillMakePurgeable--;
     }
     resource->cacheAccess().ref();
+    resource->cacheAccess().setWasReused();
 
     resource->cacheAccess().setTimestamp(this->getNextTimestamp());
     this->validate();
@@ -464,6 +507,7 @@ void GrResourceCache::notifyCntReachedZero(GrGpuResource* resource, uint32_t fla
     }
 
     this->removeFromNonpurgeableArray(resource);
+    resource->cacheAccess().setPurgeKey(this->computePurgeKey(resource));
     fPurgeableQueue.insert(resource);
     resource->cacheAccess().setTimeWhenResourceBecomePurgeable();
     fPurgeableBytes += resource->gpuMemorySize();
@@ -560,7 +604,11 @@ void GrResourceCache::purgeAsNeeded() {
     while (stillOverbudget && fPurgeableQueue.count()) {
         GrGpuResource* resource = fPurgeableQueue.peek();
         SkASSERT(resource->resourcePriv().isPurgeable());
+        if (PurgePolicy::kCostAware == fPurgePolicy) {
+            fPurgeInflation = SkTMax(fPurgeInflation, resource->cacheAccess().purgeKey());
+        }
         resource->cacheAccess().release();
+        SkPerfCounters::Add(SkGraphics::PerfCounter::kGpuResourceBudgetPurges);
         stillOverbudget = this->overBudget();
     }
 
@@ -601,6 +649,22 @@ void GrResourceCache::purgeUnlockedResources(bool scratchResourcesOnly) {
 }
 
 void GrResourceCache::purgeResourcesNotUsedSince(GrStdSteadyClock::time_point purgeTime) {
+    if (PurgePolicy::kLRU != fPurgePolicy) {
+        // The queue isn't in the order the resources became purgeable, so check all of them.
+        SkTDArray<GrGpuResource*> oldResources;
+        for (int i = 0; i < fPurgeableQueue.count(); ++i) {
+            GrGpuResource* resource = fPurgeableQueue.at(i);
+            if (resource->cacheAccess().timeWhenResourceBecamePurgeable() < purgeTime) {
+                *oldResources.append() = resource;
+            }
+        }
+        for (int i = 0; i < oldResources.count(); ++i) {
+            SkASSERT(oldResources[i]->resourcePriv().isPurgeable());
+            oldResources[i]->cacheAccess().release();
+        }
+        return;
+    }
+
     while (fPurgeableQueue.count()) {
         const GrStdSteadyClock::time_point resourceTime =
                 fPurgeableQueue.peek()->cacheAccess().timeWhenResourceBecamePurgeable();
@@ -728,6 +792,10 @@ uint32_t GrResourceCache::getNextTimestamp() {
                 *sortedPurgeableResources.append() = fPurgeableQueue.peek();
                 fPurgeableQueue.pop();
             }
+            if (PurgePolicy::kLRU != fPurgePolicy) {
+                SkTQSort(sortedPurgeableResources.begin(), sortedPurgeableResources.end() - 1,
+                         CompareTimestamp);
+            }
 
             SkTQSort(fNonpurgeableResources.begin(), fNonpurgeableResources.end() - 1,
                      CompareTimestamp);
@@ -759,8 +827,13 @@ uint32_t GrResourceCache::getNextTimestamp() {
                 fNonpurgeableResources[currNP++]->cacheAccess().setTimestamp(fTimestamp++);
             }
 
-            // Rebuild the queue.
+            // Rebuild the queue. Scan resistant purge keys are based on timestamps, so renumber
+            // them too.
             for (int i = 0; i < sortedPurgeableResources.count(); ++i) {
+                if (PurgePolicy::kScanResistant == fPurgePolicy) {
+                    GrGpuResource* resource = sortedPurgeableResources[i];
+                    resource->cacheAccess().setPurgeKey(this->computePurgeKey(resource));
+                }
                 fPurgeableQueue.insert(sortedPurgeableResources[i]);
             }
 
@@ -9,6 +9,7 @@
 #define GrResourceCache_DEFINED
 
 #include "include/core/SkRefCnt.h"
+#include "include/gpu/GrContextOptions.h"
 #include "include/gpu/GrGpuResource.h"
 #include "include/private/GrResourceKey.h"
 #include "include/private/SkTArray.h"
@@ -74,6 +75,12 @@ public:
     /** Sets the cache limits in terms of number of resources and max gpu memory byte size. */
     void setLimits(int count, size_t bytes);
 
+    using PurgePolicy = GrContextOptions::ResourceCachePolicy;
+
+    /** Sets the order in which unused resources are purged when the cache is over budget. */
+    void setPurgePolicy(PurgePolicy);
+    PurgePolicy purgePolicy() const { return fPurgePolicy; }
+
     /**
      * Returns the number of resources.
      */
@@ -279,6 +286,9 @@ private:
 
     uint32_t getNextTimestamp();
 
+    // The value fPurgeableQueue orders a resource that just became purgeable by.
+    double computePurgeKey(const GrGpuResource*) const;
+
 #ifdef SK_DEBUG
     bool isInCache(const GrGpuResource* r) const;
     void validate() const;
@@ -330,20 +340,31 @@ private:
         return a->cacheAccess().timestamp() < b->cacheAccess().timestamp();
     }
 
+    // Under the LRU policy every purge key is 0, so this is purely timestamp order.
+    static bool ComparePurgeOrder(GrGpuResource* const& a, GrGpuResource* const& b) {
+        double keyA = a->cacheAccess().purgeKey(),
+               keyB = b->cacheAccess().purgeKey();
+        return keyA != keyB ? keyA < keyB : CompareTimestamp(a, b);
+    }
+
     static int* AccessResourceIndex(GrGpuResource* const& res) {
         return res->cacheAccess().accessCacheIndex();
     }
 
     typedef SkMessageBus<GrUniqueKeyInvalidatedMessage>::Inbox InvalidUniqueKeyInbox;
     typedef SkMessageBus<GrGpuResourceFreedMessage>::Inbox FreedGpuResourceInbox;
-    typedef SkTDPQueue<GrGpuResource*, CompareTimestamp, AccessResourceIndex> PurgeableQueue;
+    typedef SkTDPQueue<GrGpuResource*, ComparePurgeOrder, AccessResourceIndex> PurgeableQueue;
     typedef SkTDArray<GrGpuResource*> ResourceArray;
 
     GrProxyProvider*                    fProxyProvider = nullptr;
     // Whenever a resource is added to the cache or the result of a cache lookup, fTimestamp is
     // assigned as the resource's timestamp and then incremented. fPurgeableQueue orders the
-    // purgeable resources by this value, and thus is used to purge resources in LRU order.
+    // purgeable resources by this value, and thus is used to purge resources in LRU order, unless
+    // fPurgePolicy orders them by their purge keys first.
     uint32_t                            fTimestamp = 0;
+    PurgePolicy                         fPurgePolicy = PurgePolicy::kLRU;
+    // The cost-aware policy's aging value: the highest purge key purged for being over budget.
+    double                              fPurgeInflation = 0;
     PurgeableQueue                      fPurgeableQueue;
     ResourceArray                       fNonpurgeableResources;
 
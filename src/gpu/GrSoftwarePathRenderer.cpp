@@ -9,6 +9,7 @@
 #include "include/private/GrOpList.h"
 #include "include/private/SkSemaphore.h"
 #include "src/core/SkMakeUnique.h"
+#include "src/core/SkPerfCounters.h"
 #include "src/core/SkTaskGroup.h"
 #include "src/core/SkTraceEvent.h"
 #include "src/gpu/GrCaps.h"
@@ -266,6 +267,7 @@ bool GrSoftwarePathRenderer::onDrawPath(const DrawPathArgs& args) {
         }
         return true;
     }
+    SkPerfCounters::Add(SkGraphics::PerfCounter::kGpuSoftwarePathMasks);
 
     const SkIRect* boundsForMask = &clippedDevShapeBounds;
     if (useCache) {
@@ -24,6 +24,8 @@ public:
             , fAllowCaching(allowCaching) {
     }
 
+    const char* name() const override { return "sw"; }
+
     static bool GetShapeAndClipBounds(GrRenderTargetContext*,
                                       const GrClip& clip,
                                       const GrShape& shape,
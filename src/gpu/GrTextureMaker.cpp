@@ -21,6 +21,14 @@ sk_sp<GrTextureProxy> GrTextureMaker::onRefTextureProxyForParams(const GrSampler
         return nullptr;
     }
 
+    if (scaleAdjust && !params.isRepeated() && !willBeMipped) {
+        if (sk_sp<GrTextureProxy> downscaled = this->refDownscaledTextureProxy()) {
+            scaleAdjust[0] = downscaled->width() / SkIntToScalar(this->width());
+            scaleAdjust[1] = downscaled->height() / SkIntToScalar(this->height());
+            return downscaled;
+        }
+    }
+
     CopyParams copyParams;
 
     sk_sp<GrTextureProxy> original(this->refOriginalTextureProxy(willBeMipped,
@@ -130,10 +138,19 @@ std::unique_ptr<GrFragmentProcessor> GrTextureMaker::createFragmentProcessor(
     SkMatrix adjustedMatrix = textureMatrix;
     adjustedMatrix.postScale(scaleAdjust[0], scaleAdjust[1]);
 
+    // A downscaled texture holds all of the contents, so the constraint scales with it. (Copies
+    // for repeat modes keep the contents at their original scale.)
+    SkRect adjustedConstraintRect = constraintRect;
+    if (proxy->width() < this->width() || proxy->height() < this->height()) {
+        adjustedConstraintRect = SkMatrix::MakeScale(scaleAdjust[0], scaleAdjust[1])
+                                         .mapRect(constraintRect);
+    }
+
     SkRect domain;
     DomainMode domainMode =
-        DetermineDomainMode(constraintRect, filterConstraint, coordsLimitedToConstraintRect,
-                            proxy.get(), fmForDetermineDomain, &domain);
+        DetermineDomainMode(adjustedConstraintRect, filterConstraint,
+                            coordsLimitedToConstraintRect, proxy.get(), fmForDetermineDomain,
+                            &domain);
     SkASSERT(kTightCopy_DomainMode != domainMode);
     return this->createFragmentProcessorForDomainAndFilter(
             std::move(proxy), adjustedMatrix, domainMode, domain, filterOrNullForBicubic);
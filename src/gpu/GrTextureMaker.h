@@ -40,6 +40,14 @@ protected:
     virtual sk_sp<GrTextureProxy> refOriginalTextureProxy(bool willBeMipped,
                                                           AllowedTexGenType genType) = 0;
 
+    /**
+     *  Return a texture holding the maker's contents at a lower resolution, to use instead of the
+     *  original when full resolution textures shouldn't be made now (e.g. when the resource cache
+     *  is over budget), or nullptr to use the original. It is only asked for when the texture is
+     *  sampled with clamping and without mip maps.
+     */
+    virtual sk_sp<GrTextureProxy> refDownscaledTextureProxy() { return nullptr; }
+
 private:
     sk_sp<GrTextureProxy> onRefTextureProxyForParams(const GrSamplerState&,
                                                      bool willBeMipped,
@@ -1248,10 +1248,21 @@ sk_sp<SkSpecialImage> SkGpuDevice::makeSpecial(const SkImage* image) {
                                                    image->refColorSpace(),
                                                    &this->surfaceProps());
     } else if (image->peekPixels(&pm)) {
-        SkBitmap bm;
+        // Upload through the image rather than a new bitmap of its pixels, so the texture and
+        // the special image are keyed on the image's ID. Filter results computed from it are then
+        // found again when the same image is drawn with the same filter again.
+        sk_sp<GrTextureProxy> proxy = GrMakeCachedImageProxy(fContext->priv().proxyProvider(),
+                                                             sk_ref_sp(image));
+        if (!proxy) {
+            return nullptr;
+        }
 
-        bm.installPixels(pm);
-        return this->makeSpecial(bm);
+        return SkSpecialImage::MakeDeferredFromGpu(fContext.get(),
+                                                   SkIRect::MakeWH(image->width(), image->height()),
+                                                   image->uniqueID(),
+                                                   std::move(proxy),
+                                                   image->refColorSpace(),
+                                                   &this->surfaceProps());
     } else {
         return nullptr;
     }
@@ -1711,7 +1722,11 @@ sk_sp<SkSurface> SkGpuDevice::makeSurface(const SkImageInfo& info, const SkSurfa
 
 SkImageFilterCache* SkGpuDevice::getImageFilterCache() {
     ASSERT_SINGLE_OWNER
-    // We always return a transient cache, so it is freed after each
+    if (SkImageFilterCache* cache = fContext->priv().getImageFilterCache()) {
+        cache->ref();
+        return cache;
+    }
+    // Otherwise we return a transient cache, so it is freed after each
     // filter traversal.
     return SkImageFilterCache::Create(SkImageFilterCache::kDefaultTransientSize);
 }
@@ -235,15 +235,25 @@ void GrCCDrawPathsOp::SingleDraw::accountForOwnPath(
     SkASSERT(!fCacheEntry);
 
     if (pathCache) {
-        fCacheEntry =
-                pathCache->find(onFlushRP, fShape, fMaskDevIBounds, fMatrix, &fCachedMaskShift);
+        fCacheEntry = pathCache->find(onFlushRP, fShape, fMaskDevIBounds, fMatrix,
+                                      &fCachedMaskShift, &fResampleMatrix);
     }
 
     if (fCacheEntry) {
         if (const GrCCCachedAtlas* cachedAtlas = fCacheEntry->cachedAtlas()) {
             SkASSERT(cachedAtlas->getOnFlushProxy());
+            if (fResampleMatrix.isValid()) {
+                // Resampled draws get their own instances, but their masks still get copied out of
+                // a coverage count atlas like any other.
+                ++specs->fNumResampledPaths;
+                if (CoverageType::kA8_LiteralCoverage != cachedAtlas->coverageType()) {
+                    ++specs->fNumCopiedResampledPaths;
+                }
+            }
             if (CoverageType::kA8_LiteralCoverage == cachedAtlas->coverageType()) {
-                ++specs->fNumCachedPaths;
+                if (!fResampleMatrix.isValid()) {
+                    ++specs->fNumCachedPaths;
+                }
             } else {
                 // Suggest that this path be copied to a literal coverage atlas, to save memory.
                 // (The client may decline this copy via DoCopiesToA8Coverage::kNo.)
@@ -315,6 +325,8 @@ void GrCCDrawPathsOp::setupResources(
     SkASSERT(fNumDraws > 0);
     SkASSERT(-1 == fBaseInstance);
     fBaseInstance = resources->nextPathInstanceIdx();
+    SkASSERT(-1 == fBaseResampledInstance);
+    fBaseResampledInstance = resources->nextResampledPathInstanceIdx();
 
     for (SingleDraw& draw : fDraws) {
         draw.setupResources(pathCache, onFlushRP, resources, doCopies, this);
@@ -323,6 +335,10 @@ void GrCCDrawPathsOp::setupResources(
     if (!fInstanceRanges.empty()) {
         fInstanceRanges.back().fEndInstanceIdx = resources->nextPathInstanceIdx();
     }
+    if (!fResampledInstanceRanges.empty()) {
+        fResampledInstanceRanges.back().fEndInstanceIdx =
+                resources->nextResampledPathInstanceIdx();
+    }
 }
 
 void GrCCDrawPathsOp::SingleDraw::setupResources(
@@ -356,6 +372,16 @@ void GrCCDrawPathsOp::SingleDraw::setupResources(
                               == fCacheEntry->cachedAtlas()->coverageType())
                     ? SkPMColor4f{0,0,.25,.25} : SkPMColor4f{0,.25,0,.25};
 #endif
+            if (fResampleMatrix.isValid()) {
+                int idx = resources->nextResampledPathInstanceIdx();
+                if (resources->appendResampledDrawPathInstance(
+                            *fCacheEntry, *fResampleMatrix.get(), fMaskDevIBounds,
+                            SkPMColor4f_toFP16(fColor), doEvenOddFill)) {
+                    op->recordResampledInstance(fCacheEntry->cachedAtlas()->getOnFlushProxy(),
+                                                idx);
+                }
+                return;
+            }
             op->recordInstance(fCacheEntry->cachedAtlas()->getOnFlushProxy(),
                                resources->nextPathInstanceIdx());
             resources->appendDrawPathInstance().set(*fCacheEntry, fCachedMaskShift,
@@ -389,13 +415,23 @@ void GrCCDrawPathsOp::SingleDraw::setupResources(
 }
 
 inline void GrCCDrawPathsOp::recordInstance(GrTextureProxy* atlasProxy, int instanceIdx) {
-    if (fInstanceRanges.empty()) {
-        fInstanceRanges.push_back({atlasProxy, instanceIdx});
+    RecordInstance(&fInstanceRanges, atlasProxy, instanceIdx);
+}
+
+inline void GrCCDrawPathsOp::recordResampledInstance(GrTextureProxy* atlasProxy,
+                                                     int resampledInstanceIdx) {
+    RecordInstance(&fResampledInstanceRanges, atlasProxy, resampledInstanceIdx);
+}
+
+void GrCCDrawPathsOp::RecordInstance(SkTArray<InstanceRange, true>* ranges,
+                                     GrTextureProxy* atlasProxy, int instanceIdx) {
+    if (ranges->empty()) {
+        ranges->push_back({atlasProxy, instanceIdx});
         return;
     }
-    if (fInstanceRanges.back().fAtlasProxy != atlasProxy) {
-        fInstanceRanges.back().fEndInstanceIdx = instanceIdx;
-        fInstanceRanges.push_back({atlasProxy, instanceIdx});
+    if (ranges->back().fAtlasProxy != atlasProxy) {
+        ranges->back().fEndInstanceIdx = instanceIdx;
+        ranges->push_back({atlasProxy, instanceIdx});
         return;
     }
 }
@@ -434,4 +470,24 @@ void GrCCDrawPathsOp::onExecute(GrOpFlushState* flushState, const SkRect& chainB
 
         baseInstance = range.fEndInstanceIdx;
     }
+
+    int baseResampledInstance = fBaseResampledInstance;
+    SkASSERT(baseResampledInstance >= 0);
+
+    for (const InstanceRange& range : fResampledInstanceRanges) {
+        SkASSERT(range.fEndInstanceIdx > baseResampledInstance);
+
+        const GrTextureProxy* atlas = range.fAtlasProxy;
+        SkASSERT(atlas->isInstantiated());
+
+        GrCCPathProcessor pathProc(atlas->peekTexture(), atlas->origin(),
+                                   fViewMatrixIfUsingLocalCoords,
+                                   GrCCPathProcessor::DoResample::kYes);
+        GrTextureProxy* atlasProxy = range.fAtlasProxy;
+        fixedDynamicState.fPrimitiveProcessorTextures = &atlasProxy;
+        pathProc.drawPaths(flushState, pipeline, &fixedDynamicState, *resources,
+                           baseResampledInstance, range.fEndInstanceIdx, this->bounds());
+
+        baseResampledInstance = range.fEndInstanceIdx;
+    }
 }
@@ -42,6 +42,9 @@ public:
         for (const auto& range : fInstanceRanges) {
             fn(range.fAtlasProxy, GrMipMapped::kNo);
         }
+        for (const auto& range : fResampledInstanceRanges) {
+            fn(range.fAtlasProxy, GrMipMapped::kNo);
+        }
         fProcessors.visitProxies(fn);
     }
     void onPrepare(GrOpFlushState*) override {}
@@ -85,6 +88,7 @@ private:
                     const SkRect& conservativeDevBounds, GrPaint&&);
 
     void recordInstance(GrTextureProxy* atlasProxy, int instanceIdx);
+    void recordResampledInstance(GrTextureProxy* atlasProxy, int resampledInstanceIdx);
 
     const SkMatrix fViewMatrixIfUsingLocalCoords;
 
@@ -114,6 +118,7 @@ private:
 
         GrCCPathCache::OnFlushEntryRef fCacheEntry;
         SkIVector fCachedMaskShift;
+        SkTLazy<SkMatrix> fResampleMatrix;  // Valid if the cached mask gets drawn resampled.
         bool fDoCopyToA8Coverage = false;
         bool fDoCachePathMask = false;
 
@@ -136,8 +141,14 @@ private:
         int fEndInstanceIdx;
     };
 
+    static void RecordInstance(SkTArray<InstanceRange, true>*, GrTextureProxy*, int instanceIdx);
+
     SkSTArray<2, InstanceRange, true> fInstanceRanges;
     int fBaseInstance SkDEBUGCODE(= -1);
+
+    // Resampled draws come from their own instance buffer, so they get their own ranges.
+    SkSTArray<1, InstanceRange, true> fResampledInstanceRanges;
+    int fBaseResampledInstance SkDEBUGCODE(= -1);
 };
 
 #endif
@@ -11,6 +11,8 @@
 #include "src/gpu/GrOnFlushResourceProvider.h"
 #include "src/gpu/GrProxyProvider.h"
 
+#include <cmath>
+
 static constexpr int kMaxKeyDataCountU32 = 256;  // 1kB of uint32_t's.
 
 DECLARE_SKMESSAGEBUS_MESSAGE(sk_sp<GrCCPathCache::Key>);
@@ -65,6 +67,43 @@ inline static bool fuzzy_equals(const GrCCPathCache::MaskTransform& a,
     return true;
 }
 
+// Finds the transform from device space into the mask space of an entry that was rendered with
+// 'maskTransform', and decides whether its mask has enough resolution to be resampled for
+// 'viewMatrix'. Masks may be rotated and scaled down by up to 2x, but are never magnified.
+static bool get_resample_matrix(const GrCCPathCache::MaskTransform& maskTransform,
+                                const SkMatrix& viewMatrix, const SkStrokeRec& stroke,
+                                SkMatrix* devToMask) {
+    SkMatrix inverse;
+    if (!viewMatrix.invert(&inverse)) {
+        return false;
+    }
+    const float* m = maskTransform.fMatrix2x2;
+#ifndef SK_BUILD_FOR_ANDROID_FRAMEWORK
+    const float* t = maskTransform.fSubpixelTranslate;
+    devToMask->setAll(m[0], m[1], t[0], m[2], m[3], t[1], 0, 0, 1);
+#else
+    devToMask->setAll(m[0], m[1], 0, m[2], m[3], 0, 0, 0, 1);
+#endif
+    devToMask->preConcat(inverse);
+
+    // How many mask texels does a device pixel span?
+    constexpr static float kTolerance = 1.f/64;
+    SkScalar scales[2];
+    if (!devToMask->getMinMaxScales(scales) ||
+        scales[0] < 1 - kTolerance || scales[1] > 2 + kTolerance) {
+        return false;
+    }
+    if (stroke.isHairlineStyle()) {
+        // Hairlines are 1px wide in device space no matter the matrix. Only rotate them.
+        return scales[1] <= 1 + kTolerance;
+    }
+    if (!stroke.isFillStyle()) {
+        // The stroke must have been scaled uniformly with the path.
+        return devToMask->isSimilarity(kTolerance);
+    }
+    return true;
+}
+
 sk_sp<GrCCPathCache::Key> GrCCPathCache::Key::Make(uint32_t pathCacheUniqueID,
                                                    int dataCountU32, const void* data) {
     void* memory = ::operator new (sizeof(Key) + dataCountU32 * sizeof(uint32_t));
@@ -90,8 +129,9 @@ void GrCCPathCache::Key::onChange() {
     SkMessageBus<sk_sp<Key>>::Post(sk_ref_sp(this));
 }
 
-GrCCPathCache::GrCCPathCache(uint32_t contextUniqueID)
+GrCCPathCache::GrCCPathCache(uint32_t contextUniqueID, bool allowResampling)
         : fContextUniqueID(contextUniqueID)
+        , fAllowResampling(allowResampling)
         , fInvalidatedKeysInbox(next_path_cache_id())
         , fScratchKey(Key::Make(fInvalidatedKeysInbox.uniqueID(), kMaxKeyDataCountU32)) {
 }
@@ -160,7 +200,9 @@ private:
 
 GrCCPathCache::OnFlushEntryRef GrCCPathCache::find(
         GrOnFlushResourceProvider* onFlushRP, const GrShape& shape,
-        const SkIRect& clippedDrawBounds, const SkMatrix& viewMatrix, SkIVector* maskShift) {
+        const SkIRect& clippedDrawBounds, const SkMatrix& viewMatrix, SkIVector* maskShift,
+        SkTLazy<SkMatrix>* resampleMatrix) {
+    resampleMatrix->reset();
     if (!shape.hasUnstyledKey()) {
         return OnFlushEntryRef();
     }
@@ -181,17 +223,33 @@ GrCCPathCache::OnFlushEntryRef GrCCPathCache::find(
         SkASSERT(fLRU.isInList(entry));
 
         if (!fuzzy_equals(m, entry->fMaskTransform)) {
-            // The path was reused with an incompatible matrix.
-            if (entry->unique()) {
-                // This entry is unique: recycle it instead of deleting and malloc-ing a new one.
-                SkASSERT(0 == entry->fOnFlushRefCnt);  // Because we are unique.
-                entry->fMaskTransform = m;
-                entry->fHitCount = 0;
-                entry->fHitRect = SkIRect::MakeEmpty();
-                entry->releaseCachedAtlas(this);
-            } else {
-                this->evict(*fScratchKey);
-                entry = nullptr;
+            SkMatrix devToMask;
+            if (fAllowResampling && entry->fCachedAtlas &&
+                get_resample_matrix(entry->fMaskTransform, viewMatrix, shape.style().strokeRec(),
+                                    &devToMask)) {
+                // Only resample the mask if its atlas texture is still around.
+                this->findOnFlushProxy(onFlushRP, entry);
+                if (entry->fCachedAtlas) {
+                    resampleMatrix->set(devToMask);
+                }
+            }
+            if (!resampleMatrix->isValid()) {
+                // The path was reused with an incompatible matrix.
+#if GR_CACHE_STATS
+                ++fStats.fNumTransformMisses;
+#endif
+                if (entry->unique()) {
+                    // This entry is unique: recycle it instead of deleting and malloc-ing a new
+                    // one.
+                    SkASSERT(0 == entry->fOnFlushRefCnt);  // Because we are unique.
+                    entry->fMaskTransform = m;
+                    entry->fHitCount = 0;
+                    entry->fHitRect = SkIRect::MakeEmpty();
+                    entry->releaseCachedAtlas(this);
+                } else {
+                    this->evict(*fScratchKey);
+                    entry = nullptr;
+                }
             }
         }
     }
@@ -224,29 +282,50 @@ GrCCPathCache::OnFlushEntryRef GrCCPathCache::find(
         // current flush.
         entry->fTimestamp = this->quickPerFlushTimestamp();
         ++entry->fHitCount;
-
-        if (entry->fCachedAtlas) {
-            SkASSERT(SkToBool(entry->fCachedAtlas->peekOnFlushRefCnt()) ==
-                     SkToBool(entry->fCachedAtlas->getOnFlushProxy()));
-            if (!entry->fCachedAtlas->getOnFlushProxy()) {
-                if (sk_sp<GrTextureProxy> onFlushProxy = onFlushRP->findOrCreateProxyByUniqueKey(
-                        entry->fCachedAtlas->textureKey(), GrCCAtlas::kTextureOrigin)) {
-                    onFlushProxy->priv().setIgnoredByResourceAllocator();
-                    entry->fCachedAtlas->setOnFlushProxy(std::move(onFlushProxy));
-                }
-            }
-            if (!entry->fCachedAtlas->getOnFlushProxy()) {
-                // Our atlas's backing texture got purged from the GrResourceCache. Release the
-                // cached atlas.
-                entry->releaseCachedAtlas(this);
-            }
+        if (!resampleMatrix->isValid()) {  // Otherwise we already found the proxy above.
+            this->findOnFlushProxy(onFlushRP, entry);
         }
     }
-    entry->fHitRect.join(clippedDrawBounds.makeOffset(-maskShift->x(), -maskShift->y()));
+    if (!resampleMatrix->isValid()) {
+        // (A resampled draw has no meaningful location in the entry's mask space. The mask is
+        // already complete anyway.)
+        entry->fHitRect.join(clippedDrawBounds.makeOffset(-maskShift->x(), -maskShift->y()));
+    }
     SkASSERT(!entry->fCachedAtlas || entry->fCachedAtlas->getOnFlushProxy());
+    SkASSERT(!resampleMatrix->isValid() || entry->fCachedAtlas);
+
+#if GR_CACHE_STATS
+    ++fStats.fNumFinds;
+    if (resampleMatrix->isValid()) {
+        ++fStats.fNumResampledHits;
+    } else if (entry->fCachedAtlas) {
+        ++fStats.fNumHits;
+    }
+#endif
     return OnFlushEntryRef::OnFlushRef(entry);
 }
 
+void GrCCPathCache::findOnFlushProxy(GrOnFlushResourceProvider* onFlushRP,
+                                     GrCCPathCacheEntry* entry) {
+    if (!entry->fCachedAtlas) {
+        return;
+    }
+    SkASSERT(SkToBool(entry->fCachedAtlas->peekOnFlushRefCnt()) ==
+             SkToBool(entry->fCachedAtlas->getOnFlushProxy()));
+    if (!entry->fCachedAtlas->getOnFlushProxy()) {
+        if (sk_sp<GrTextureProxy> onFlushProxy = onFlushRP->findOrCreateProxyByUniqueKey(
+                entry->fCachedAtlas->textureKey(), GrCCAtlas::kTextureOrigin)) {
+            onFlushProxy->priv().setIgnoredByResourceAllocator();
+            entry->fCachedAtlas->setOnFlushProxy(std::move(onFlushProxy));
+        }
+    }
+    if (!entry->fCachedAtlas->getOnFlushProxy()) {
+        // Our atlas's backing texture got purged from the GrResourceCache. Release the cached
+        // atlas.
+        entry->releaseCachedAtlas(this);
+    }
+}
+
 void GrCCPathCache::evict(const GrCCPathCache::Key& key, GrCCPathCacheEntry* entry) {
     if (!entry) {
         HashNode* node = fHashTable.find(key);
@@ -293,6 +372,19 @@ void GrCCPathCache::purgeEntriesOlderThan(GrProxyProvider* proxyProvider,
     this->purgeInvalidatedAtlasTextures(proxyProvider);
 }
 
+int GrCCPathCache::purgeEntries(GrProxyProvider* proxyProvider, float fraction) {
+    this->evictInvalidatedCacheKeys();
+
+    int count = SkTMin(fHashTable.count(), (int)std::ceil(fHashTable.count() * fraction));
+    for (int i = 0; i < count; ++i) {
+        SkASSERT(!fLRU.isEmpty());
+        this->evict(*fLRU.tail()->fCacheKey);
+    }
+
+    this->purgeInvalidatedAtlasTextures(proxyProvider);
+    return count;
+}
+
 void GrCCPathCache::purgeInvalidatedAtlasTextures(GrOnFlushResourceProvider* onFlushRP) {
     for (sk_sp<GrTextureProxy>& proxy : fInvalidatedProxies) {
         onFlushRP->removeUniqueKeyFromProxy(proxy.get());
@@ -329,6 +421,16 @@ void GrCCPathCache::evictInvalidatedCacheKeys() {
     }
 }
 
+#if GR_CACHE_STATS && GR_TEST_UTILS
+void GrCCPathCache::dumpStats(SkString* out) const {
+    int numMaskHits = fStats.fNumHits + fStats.fNumResampledHits;
+    out->appendf("CCPR path cache: %d entries, %d finds\n", fHashTable.count(), fStats.fNumFinds);
+    out->appendf("\t\tMask hits: %d (%.2g%%), %d of them resampled. Transform misses: %d\n",
+                 numMaskHits, 100.f * numMaskHits / SkTMax(fStats.fNumFinds, 1),
+                 fStats.fNumResampledHits, fStats.fNumTransformMisses);
+}
+#endif
+
 GrCCPathCache::OnFlushEntryRef
 GrCCPathCache::OnFlushEntryRef::OnFlushRef(GrCCPathCacheEntry* entry) {
     entry->ref();
@@ -406,6 +508,54 @@ GrCCPathCacheEntry::ReleaseAtlasResult GrCCPathCacheEntry::releaseCachedAtlas(
     return result;
 }
 
+bool GrCCPathProcessor::ResampledInstance::set(const GrCCPathCacheEntry& entry,
+                                               const SkMatrix& devToMask,
+                                               const SkIRect& clipIBounds, uint64_t color,
+                                               DoEvenOddFill doEvenOddFill) {
+    SkMatrix maskToDev;
+    if (!devToMask.invert(&maskToDev)) {
+        return false;
+    }
+
+    // Map the vertices of the mask's octagon to device space, and circumscribe them with a new
+    // octagon. Each vertex is where an edge of the bounding box meets an edge of the 45-degree one.
+    const GrOctoBounds& o = entry.fOctoBounds;
+    SkPoint vertices[8] = {
+        {o.top45() - o.top(), o.top()}, {o.right45() + o.top(), o.top()},
+        {o.right(), o.right() - o.right45()}, {o.right(), o.bottom45() - o.right()},
+        {o.bottom45() - o.bottom(), o.bottom()}, {o.left45() + o.bottom(), o.bottom()},
+        {o.left(), o.left() - o.left45()}, {o.left(), o.top45() - o.left()}
+    };
+    maskToDev.mapPoints(vertices, SK_ARRAY_COUNT(vertices));
+    SkRect devBounds, devBounds45;
+    devBounds.setBounds(vertices, SK_ARRAY_COUNT(vertices));
+    for (SkPoint& pt : vertices) {
+        pt.set(GrOctoBounds::Get_x45(pt.x(), pt.y()), GrOctoBounds::Get_y45(pt.x(), pt.y()));
+    }
+    devBounds45.setBounds(vertices, SK_ARRAY_COUNT(vertices));
+
+    GrOctoBounds octoBounds(devBounds, devBounds45);
+    // Bilinear filtering can spread the mask's coverage out by up to one more device pixel.
+    octoBounds.outset(1);
+    if (!clipIBounds.contains(octoBounds.bounds()) && !octoBounds.clip(clipIBounds)) {
+        return false;
+    }
+    SetDevBounds(octoBounds, doEvenOddFill, &fDevBounds, &fDevBounds45);
+
+    SkMatrix devToAtlas = devToMask;
+    devToAtlas.postTranslate(entry.fAtlasOffset.x(), entry.fAtlasOffset.y());
+    fDevToAtlasMatrix[0] = devToAtlas.getScaleX();
+    fDevToAtlasMatrix[1] = devToAtlas.getSkewY();
+    fDevToAtlasMatrix[2] = devToAtlas.getSkewX();
+    fDevToAtlasMatrix[3] = devToAtlas.getScaleY();
+    fDevToAtlasTranslate[0] = devToAtlas.getTranslateX();
+    fDevToAtlasTranslate[1] = devToAtlas.getTranslateY();
+    fAtlasBounds = SkRect::Make(
+            entry.fDevIBounds.makeOffset(entry.fAtlasOffset.x(), entry.fAtlasOffset.y()));
+    fColor = color;
+    return true;
+}
+
 GrCCPathCacheEntry::ReleaseAtlasResult GrCCCachedAtlas::invalidatePathPixels(
         GrCCPathCache* pathCache, int numPixels) {
     // Mark the pixels invalid in the cached atlas texture.
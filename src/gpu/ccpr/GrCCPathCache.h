@@ -11,6 +11,7 @@
 #include "include/private/SkTHash.h"
 #include "src/core/SkExchange.h"
 #include "src/core/SkTInternalLList.h"
+#include "src/core/SkTLazy.h"
 #include "src/gpu/GrShape.h"
 #include "src/gpu/ccpr/GrCCAtlas.h"
 #include "src/gpu/ccpr/GrCCPathProcessor.h"
@@ -21,11 +22,11 @@ class GrShape;
 /**
  * This class implements an LRU cache that maps from GrShape to GrCCPathCacheEntry objects. Shapes
  * are only given one entry in the cache, so any time they are accessed with a different matrix, the
- * old entry gets evicted.
+ * old entry gets evicted (unless its mask can be resampled for the new matrix; see find()).
  */
 class GrCCPathCache {
 public:
-    GrCCPathCache(uint32_t contextUniqueID);
+    GrCCPathCache(uint32_t contextUniqueID, bool allowResampling = false);
     ~GrCCPathCache();
 
     class Key : public SkPathRef::GenIDChangeListener {
@@ -103,16 +104,27 @@ public:
     // 'maskShift' is filled with an integer post-translate that the caller must apply when drawing
     // the entry's mask to the device.
     //
+    // If resampling is allowed, and the shape already has a cached mask that was rendered with a
+    // different transformation, the entry is still returned as long as the mask has enough
+    // resolution for the new one: it may be rotated, or scaled down by up to 2x, but is never
+    // magnified. In that case 'resampleMatrix' is initialized with the transform from device space
+    // to the entry's mask space (see GrCCPathCacheEntry::devIBounds), and the caller must draw the
+    // mask with GrCCPathProcessor::ResampledInstance rather than 'maskShift'.
+    //
     // NOTE: Shapes are only given one entry, so any time they are accessed with a new
-    // transformation, the old entry gets evicted.
+    // transformation that can't be resampled, the old entry gets evicted.
     OnFlushEntryRef find(GrOnFlushResourceProvider*, const GrShape&,
                          const SkIRect& clippedDrawBounds, const SkMatrix& viewMatrix,
-                         SkIVector* maskShift);
+                         SkIVector* maskShift, SkTLazy<SkMatrix>* resampleMatrix);
 
     void doPreFlushProcessing();
 
     void purgeEntriesOlderThan(GrProxyProvider*, const GrStdSteadyClock::time_point& purgeTime);
 
+    // Evicts the given fraction of the cache's entries, least recently used first, and purges their
+    // atlas textures from the GrResourceCache. Returns the number of entries evicted.
+    int purgeEntries(GrProxyProvider*, float fraction);
+
     // As we evict entries from our local path cache, we accumulate a list of invalidated atlas
     // textures. This call purges the invalidated atlas textures from the mainline GrResourceCache.
     // This call is available with two different "provider" objects, to accomodate whatever might
@@ -120,6 +132,21 @@ public:
     void purgeInvalidatedAtlasTextures(GrOnFlushResourceProvider*);
     void purgeInvalidatedAtlasTextures(GrProxyProvider*);
 
+#if GR_CACHE_STATS
+    struct Stats {
+        int fNumFinds = 0;  // Calls to find() for shapes that have a cache key.
+        int fNumHits = 0;  // Finds that can draw from a cached mask with a matching transform.
+        int fNumResampledHits = 0;  // Finds that can draw from a resampled cached mask.
+        int fNumTransformMisses = 0;  // Finds whose entry had to start over for a new transform.
+    };
+
+    const Stats& stats() const { return fStats; }
+
+#if GR_TEST_UTILS
+    void dumpStats(SkString*) const;
+#endif
+#endif
+
 private:
     // This is a special ref ptr for GrCCPathCacheEntry, used by the hash table. It provides static
     // methods for SkTHash, and can only be moved. This guarantees the hash table holds exactly one
@@ -160,11 +187,16 @@ private:
 
     void evict(const GrCCPathCache::Key&, GrCCPathCacheEntry* = nullptr);
 
+    // Makes sure the entry's cached atlas has a proxy for the current flush. If the atlas texture
+    // has been purged from the GrResourceCache, the entry's cached atlas is released instead.
+    void findOnFlushProxy(GrOnFlushResourceProvider*, GrCCPathCacheEntry*);
+
     // Evicts all the cache entries whose keys have been queued up in fInvalidatedKeysInbox via
     // SkPath listeners.
     void evictInvalidatedCacheKeys();
 
     const uint32_t fContextUniqueID;
+    const bool fAllowResampling;
 
     SkTHashTable<HashNode, const Key&> fHashTable;
     SkTInternalLList<GrCCPathCacheEntry> fLRU;
@@ -183,6 +215,10 @@ private:
 
     friend class GrCCCachedAtlas;  // To append to fInvalidatedProxies, fInvalidatedProxyUniqueKeys.
 
+#if GR_CACHE_STATS
+    Stats fStats;
+#endif
+
 public:
     const SkTHashTable<HashNode, const Key&>& testingOnly_getHashTable() const;
     const SkTInternalLList<GrCCPathCacheEntry>& testingOnly_getLRU() const;
@@ -268,6 +304,9 @@ private:
     friend class GrCCPathCache;
     friend void GrCCPathProcessor::Instance::set(const GrCCPathCacheEntry&, const SkIVector&,
                                                  uint64_t color, DoEvenOddFill);  // To access data.
+    friend bool GrCCPathProcessor::ResampledInstance::set(const GrCCPathCacheEntry&,
+                                                          const SkMatrix&, const SkIRect&,
+                                                          uint64_t color, DoEvenOddFill);
 
 public:
     int testingOnly_peekOnFlushRefCnt() const;
@@ -64,6 +64,7 @@ static constexpr uint16_t kOctoIndicesAsTris[] = {
 GR_DECLARE_STATIC_UNIQUE_KEY(gIndexBufferKey);
 
 constexpr GrPrimitiveProcessor::Attribute GrCCPathProcessor::kInstanceAttribs[];
+constexpr GrPrimitiveProcessor::Attribute GrCCPathProcessor::kResampledInstanceAttribs[];
 constexpr GrPrimitiveProcessor::Attribute GrCCPathProcessor::kCornersAttrib;
 
 sk_sp<const GrGpuBuffer> GrCCPathProcessor::FindIndexBuffer(GrOnFlushResourceProvider* onFlushRP) {
@@ -80,15 +81,23 @@ sk_sp<const GrGpuBuffer> GrCCPathProcessor::FindIndexBuffer(GrOnFlushResourcePro
 }
 
 GrCCPathProcessor::GrCCPathProcessor(const GrTexture* atlasTexture, GrSurfaceOrigin atlasOrigin,
-                                     const SkMatrix& viewMatrixIfUsingLocalCoords)
+                                     const SkMatrix& viewMatrixIfUsingLocalCoords,
+                                     DoResample doResample)
         : INHERITED(kGrCCPathProcessor_ClassID)
         , fAtlasAccess(atlasTexture->texturePriv().textureType(), atlasTexture->config(),
                        GrSamplerState::Filter::kNearest, GrSamplerState::WrapMode::kClamp)
         , fAtlasSize(SkISize::Make(atlasTexture->width(), atlasTexture->height()))
-        , fAtlasOrigin(atlasOrigin) {
+        , fAtlasOrigin(atlasOrigin)
+        , fDoResample(doResample) {
     // TODO: Can we just assert that atlas has GrCCAtlas::kTextureOrigin and remove fAtlasOrigin?
-    this->setInstanceAttributes(kInstanceAttribs, SK_ARRAY_COUNT(kInstanceAttribs));
-    SkASSERT(this->instanceStride() == sizeof(Instance));
+    if (DoResample::kNo == fDoResample) {
+        this->setInstanceAttributes(kInstanceAttribs, SK_ARRAY_COUNT(kInstanceAttribs));
+        SkASSERT(this->instanceStride() == sizeof(Instance));
+    } else {
+        this->setInstanceAttributes(kResampledInstanceAttribs,
+                                    SK_ARRAY_COUNT(kResampledInstanceAttribs));
+        SkASSERT(this->instanceStride() == sizeof(ResampledInstance));
+    }
 
     this->setVertexAttributes(&kCornersAttrib, 1);
     this->setTextureSamplerCnt(1);
@@ -135,8 +144,10 @@ void GrCCPathProcessor::drawPaths(GrOpFlushState* flushState, const GrPipeline&
     auto enablePrimitiveRestart = GrPrimitiveRestart(flushState->caps().usePrimitiveRestart());
 
     mesh.setIndexedInstanced(resources.refIndexBuffer(), numIndicesPerInstance,
-                             resources.refInstanceBuffer(), endInstance - baseInstance,
-                             baseInstance, enablePrimitiveRestart);
+                             (DoResample::kYes == fDoResample)
+                                     ? resources.refResampledInstanceBuffer()
+                                     : resources.refInstanceBuffer(),
+                             endInstance - baseInstance, baseInstance, enablePrimitiveRestart);
     mesh.setVertexData(resources.refVertexBuffer());
 
     flushState->rtCommandBuffer()->draw(*this, pipeline, fixedDynamicState, nullptr, &mesh, 1,
@@ -149,18 +160,27 @@ void GrCCPathProcessor::Impl::onEmitCode(EmitArgs& args, GrGPArgs* gpArgs) {
     const GrCCPathProcessor& proc = args.fGP.cast<GrCCPathProcessor>();
     GrGLSLUniformHandler* uniHandler = args.fUniformHandler;
     GrGLSLVaryingHandler* varyingHandler = args.fVaryingHandler;
+    bool doResample = (DoResample::kYes == proc.fDoResample);
 
+    // When resampling, the fragment shader does its own texel lookups for bilinear filtering.
     const char* atlasAdjust;
     fAtlasAdjustUniform = uniHandler->addUniform(
-            kVertex_GrShaderFlag, kFloat2_GrSLType, "atlas_adjust", &atlasAdjust);
+            doResample ? kFragment_GrShaderFlag : kVertex_GrShaderFlag, kFloat2_GrSLType,
+            "atlas_adjust", &atlasAdjust);
 
     varyingHandler->emitAttributes(proc);
 
     GrGLSLVarying texcoord(kFloat3_GrSLType);
     GrGLSLVarying color(kHalf4_GrSLType);
+    GrGLSLVarying maskBounds(kFloat4_GrSLType);
     varyingHandler->addVarying("texcoord", &texcoord);
+    if (doResample) {
+        varyingHandler->addVarying("maskbounds", &maskBounds, Interpolation::kCanBeFlat);
+    }
     varyingHandler->addPassThroughAttribute(
-            kInstanceAttribs[kColorAttribIdx], args.fOutputColor, Interpolation::kCanBeFlat);
+            doResample ? kResampledInstanceAttribs[kResampledColorAttribIdx]
+                       : kInstanceAttribs[kColorAttribIdx],
+            args.fOutputColor, Interpolation::kCanBeFlat);
 
     // The vertex shader bloats and intersects the devBounds and devBounds45 rectangles, in order to
     // find an octagon that circumscribes the (bloated) path.
@@ -198,13 +218,20 @@ void GrCCPathProcessor::Impl::onEmitCode(EmitArgs& args, GrGPArgs* gpArgs) {
     v->codeAppendf("octocoord = (ceil(octocoord * bloatdir - 1e-4) + 0.25) * bloatdir;");
 
     // Convert to atlas coordinates in order to do our texture lookup.
-    v->codeAppendf("float2 atlascoord = octocoord + float2(dev_to_atlas_offset);");
-    if (kTopLeft_GrSurfaceOrigin == proc.fAtlasOrigin) {
-        v->codeAppendf("%s.xy = atlascoord * %s;", texcoord.vsOut(), atlasAdjust);
+    if (doResample) {
+        // Leave the coords in texels. The fragment shader normalizes them for each of its taps.
+        v->codeAppendf("%s.xy = float2x2(dev_to_atlas_matrix.xy, dev_to_atlas_matrix.zw) * "
+                               "octocoord + dev_to_atlas_translate;", texcoord.vsOut());
+        v->codeAppendf("%s = atlas_bounds;", maskBounds.vsOut());
     } else {
-        SkASSERT(kBottomLeft_GrSurfaceOrigin == proc.fAtlasOrigin);
-        v->codeAppendf("%s.xy = float2(atlascoord.x * %s.x, 1 - atlascoord.y * %s.y);",
-                       texcoord.vsOut(), atlasAdjust, atlasAdjust);
+        v->codeAppendf("float2 atlascoord = octocoord + float2(dev_to_atlas_offset);");
+        if (kTopLeft_GrSurfaceOrigin == proc.fAtlasOrigin) {
+            v->codeAppendf("%s.xy = atlascoord * %s;", texcoord.vsOut(), atlasAdjust);
+        } else {
+            SkASSERT(kBottomLeft_GrSurfaceOrigin == proc.fAtlasOrigin);
+            v->codeAppendf("%s.xy = float2(atlascoord.x * %s.x, 1 - atlascoord.y * %s.y);",
+                           texcoord.vsOut(), atlasAdjust, atlasAdjust);
+        }
     }
     v->codeAppendf("%s.z = wind * .5;", texcoord.vsOut());
 
@@ -215,6 +242,35 @@ void GrCCPathProcessor::Impl::onEmitCode(EmitArgs& args, GrGPArgs* gpArgs) {
     // Fragment shader.
     GrGLSLFPFragmentBuilder* f = args.fFragBuilder;
 
+    if (doResample) {
+        // Filter bilinearly between the four nearest texels. Each texel's coverage count has to be
+        // resolved to coverage (same as below) before they can be blended, and texels outside the
+        // mask's bounds belong to other paths in the atlas.
+        f->codeAppendf("float2 texel = %s.xy - .5;", texcoord.fsIn());
+        f->codeAppend ("float2 weight = fract(texel);");
+        f->codeAppend ("texel = floor(texel) + .5;");
+        f->codeAppend ("half coverage = 0;");
+        for (int i = 0; i < 4; ++i) {
+            int dx = i & 1, dy = i >> 1;
+            f->codeAppendf("{ float2 tap = texel + float2(%i, %i);", dx, dy);
+            SkString tapcoord = (kTopLeft_GrSurfaceOrigin == proc.fAtlasOrigin)
+                    ? SkStringPrintf("tap * %s", atlasAdjust)
+                    : SkStringPrintf("float2(tap.x * %s.x, 1 - tap.y * %s.y)",
+                                     atlasAdjust, atlasAdjust);
+            f->codeAppend ("half count = ");
+            f->appendTextureLookup(args.fTexSamplers[0], tapcoord.c_str(), kFloat2_GrSLType);
+            f->codeAppend (".a;");
+            f->codeAppendf("count = min(abs(count) * half(%s.z), .5);", texcoord.fsIn());
+            f->codeAppend ("count = 1 - abs(fract(count) * 2 - 1);");
+            f->codeAppendf("float2 inside = step(%s.xy, tap) * step(tap, %s.zw);",
+                           maskBounds.fsIn(), maskBounds.fsIn());
+            f->codeAppendf("float2 w = mix(1 - weight, weight, float2(%i, %i));", dx, dy);
+            f->codeAppend ("coverage += count * half(inside.x * inside.y * w.x * w.y); }");
+        }
+        f->codeAppendf("%s = half4(coverage);", args.fOutputCoverage);
+        return;
+    }
+
     // Look up coverage count in the atlas.
     f->codeAppend ("half coverage = ");
     f->appendTextureLookup(args.fTexSamplers[0], SkStringPrintf("%s.xy", texcoord.fsIn()).c_str(),
@@ -52,16 +52,47 @@ public:
 
     GR_STATIC_ASSERT(4 * 12 == sizeof(Instance));
 
+    enum class DoResample : bool {
+        kNo = false,
+        kYes = true
+    };
+
+    // Draws a cached path mask that was rendered with a different transform than the one it is now
+    // being drawn with (see GrCCPathCache::find). Rather than a fixed integer offset, each device
+    // position is mapped into the atlas by a matrix, and the atlas is filtered bilinearly. Atlas
+    // texels outside fAtlasBounds belong to other paths, and are treated as zero coverage.
+    struct ResampledInstance {
+        SkRect fDevBounds;  // "right < left" indicates even-odd fill type.
+        SkRect fDevBounds45;  // Bounding box in "| 1  -1 | * devCoords" space. See GrOctoBounds.
+                              //                  | 1   1 |
+        float fDevToAtlasMatrix[4];  // Column-major 2x2.
+        float fDevToAtlasTranslate[2];
+        SkRect fAtlasBounds;  // The mask's location in the atlas.
+        uint64_t fColor;  // Color always stored as 4 x fp16
+
+        // Returns false if the entry's mask, once transformed, does not intersect 'clipIBounds'.
+        bool SK_WARN_UNUSED_RESULT set(const GrCCPathCacheEntry&, const SkMatrix& devToMask,
+                                       const SkIRect& clipIBounds, uint64_t,
+                                       DoEvenOddFill = DoEvenOddFill::kNo);
+    };
+
+    GR_STATIC_ASSERT(4 * 20 == sizeof(ResampledInstance));
+
     static sk_sp<const GrGpuBuffer> FindVertexBuffer(GrOnFlushResourceProvider*);
     static sk_sp<const GrGpuBuffer> FindIndexBuffer(GrOnFlushResourceProvider*);
 
     GrCCPathProcessor(const GrTexture* atlasTexture, GrSurfaceOrigin atlasOrigin,
-                      const SkMatrix& viewMatrixIfUsingLocalCoords = SkMatrix::I());
+                      const SkMatrix& viewMatrixIfUsingLocalCoords = SkMatrix::I(),
+                      DoResample = DoResample::kNo);
 
     const char* name() const override { return "GrCCPathProcessor"; }
-    void getGLSLProcessorKey(const GrShaderCaps&, GrProcessorKeyBuilder*) const override {}
+    void getGLSLProcessorKey(const GrShaderCaps&, GrProcessorKeyBuilder* b) const override {
+        b->add32((uint32_t)fDoResample);
+    }
     GrGLSLPrimitiveProcessor* createGLSLInstance(const GrShaderCaps&) const override;
 
+    // Draws instances from the resources' resampled instance buffer if this processor was created
+    // with DoResample::kYes, and from its regular instance buffer otherwise.
     void drawPaths(GrOpFlushState*, const GrPipeline&, const GrPipeline::FixedDynamicState*,
                    const GrCCPerFlushResources&, int baseInstance, int endInstance,
                    const SkRect& bounds) const;
@@ -74,6 +105,7 @@ private:
     GrSurfaceOrigin fAtlasOrigin;
 
     SkMatrix fLocalMatrix;
+    const DoResample fDoResample;
     static constexpr Attribute kInstanceAttribs[] = {
             {"devbounds", kFloat4_GrVertexAttribType, kFloat4_GrSLType},
             {"devbounds45", kFloat4_GrVertexAttribType, kFloat4_GrSLType},
@@ -81,31 +113,49 @@ private:
             {"color", kHalf4_GrVertexAttribType, kHalf4_GrSLType}
     };
     static constexpr int kColorAttribIdx = 3;
+    static constexpr Attribute kResampledInstanceAttribs[] = {
+            {"devbounds", kFloat4_GrVertexAttribType, kFloat4_GrSLType},
+            {"devbounds45", kFloat4_GrVertexAttribType, kFloat4_GrSLType},
+            {"dev_to_atlas_matrix", kFloat4_GrVertexAttribType, kFloat4_GrSLType},
+            {"dev_to_atlas_translate", kFloat2_GrVertexAttribType, kFloat2_GrSLType},
+            {"atlas_bounds", kFloat4_GrVertexAttribType, kFloat4_GrSLType},
+            {"color", kHalf4_GrVertexAttribType, kHalf4_GrSLType}
+    };
+    static constexpr int kResampledColorAttribIdx = 5;
     static constexpr Attribute kCornersAttrib =
             {"corners", kFloat4_GrVertexAttribType, kFloat4_GrSLType};
 
+    static void SetDevBounds(const GrOctoBounds&, DoEvenOddFill, SkRect* devBounds,
+                             SkRect* devBounds45);
+
     class Impl;
 
     typedef GrGeometryProcessor INHERITED;
 };
 
-inline void GrCCPathProcessor::Instance::set(
-        const GrOctoBounds& octoBounds, const SkIVector& devToAtlasOffset, uint64_t color,
-        DoEvenOddFill doEvenOddFill) {
+inline void GrCCPathProcessor::SetDevBounds(const GrOctoBounds& octoBounds,
+                                            DoEvenOddFill doEvenOddFill, SkRect* devBounds,
+                                            SkRect* devBounds45) {
     if (DoEvenOddFill::kNo == doEvenOddFill) {
         // We cover "nonzero" paths with clockwise triangles, which is the default result from
         // normal octo bounds.
-        fDevBounds = octoBounds.bounds();
-        fDevBounds45 = octoBounds.bounds45();
+        *devBounds = octoBounds.bounds();
+        *devBounds45 = octoBounds.bounds45();
     } else {
         // We cover "even/odd" paths with counterclockwise triangles. Here we reorder the bounding
         // box vertices so the output is flipped horizontally.
-        fDevBounds.setLTRB(
+        devBounds->setLTRB(
                 octoBounds.right(), octoBounds.top(), octoBounds.left(), octoBounds.bottom());
-        fDevBounds45.setLTRB(
+        devBounds45->setLTRB(
                 octoBounds.bottom45(), octoBounds.right45(), octoBounds.top45(),
                 octoBounds.left45());
     }
+}
+
+inline void GrCCPathProcessor::Instance::set(
+        const GrOctoBounds& octoBounds, const SkIVector& devToAtlasOffset, uint64_t color,
+        DoEvenOddFill doEvenOddFill) {
+    SetDevBounds(octoBounds, doEvenOddFill, &fDevBounds, &fDevBounds45);
     fDevToAtlasOffset = devToAtlasOffset;
     fColor = color;
 }
@@ -23,6 +23,7 @@
 using FillBatchID = GrCCFiller::BatchID;
 using StrokeBatchID = GrCCStroker::BatchID;
 using PathInstance = GrCCPathProcessor::Instance;
+using ResampledPathInstance = GrCCPathProcessor::ResampledInstance;
 
 static constexpr int kFillIdx = GrCCPerFlushResourceSpecs::kFillIdx;
 static constexpr int kStrokeIdx = GrCCPerFlushResourceSpecs::kStrokeIdx;
@@ -152,11 +153,22 @@ private:
 static int inst_buffer_count(const GrCCPerFlushResourceSpecs& specs) {
     return specs.fNumCachedPaths +
            // Copies get two instances per draw: 1 copy + 1 draw.
-           (specs.fNumCopiedPaths[kFillIdx] + specs.fNumCopiedPaths[kStrokeIdx]) * 2 +
+           (specs.fNumCopiedPaths[kFillIdx] + specs.fNumCopiedPaths[kStrokeIdx]) * 2 -
+           // ... except resampled copies, whose draws go in the resampled instance buffer.
+           specs.fNumCopiedResampledPaths +
            specs.fNumRenderedPaths[kFillIdx] + specs.fNumRenderedPaths[kStrokeIdx];
            // No clips in instance buffers.
 }
 
+static sk_sp<GrGpuBuffer> make_resampled_inst_buffer(GrOnFlushResourceProvider* onFlushRP,
+                                                     const GrCCPerFlushResourceSpecs& specs) {
+    if (!specs.fNumResampledPaths) {
+        return nullptr;
+    }
+    return onFlushRP->makeBuffer(GrGpuBufferType::kVertex,
+                                 specs.fNumResampledPaths * sizeof(ResampledPathInstance));
+}
+
 GrCCPerFlushResources::GrCCPerFlushResources(GrOnFlushResourceProvider* onFlushRP,
                                              const GrCCPerFlushResourceSpecs& specs)
         // Overallocate by one point so we can call Sk4f::Store at the final SkPoint in the array.
@@ -179,6 +191,7 @@ GrCCPerFlushResources::GrCCPerFlushResources(GrOnFlushResourceProvider* onFlushR
         , fVertexBuffer(GrCCPathProcessor::FindVertexBuffer(onFlushRP))
         , fInstanceBuffer(onFlushRP->makeBuffer(GrGpuBufferType::kVertex,
                                                 inst_buffer_count(specs) * sizeof(PathInstance)))
+        , fResampledInstanceBuffer(make_resampled_inst_buffer(onFlushRP, specs))
         , fNextCopyInstanceIdx(0)
         , fNextPathInstanceIdx(specs.fNumCopiedPaths[kFillIdx] +
                                specs.fNumCopiedPaths[kStrokeIdx]) {
@@ -194,8 +207,19 @@ GrCCPerFlushResources::GrCCPerFlushResources(GrOnFlushResourceProvider* onFlushR
         SkDebugf("WARNING: failed to allocate CCPR instance buffer. No paths will be drawn.\n");
         return;
     }
+    if (specs.fNumResampledPaths && !fResampledInstanceBuffer) {
+        SkDebugf("WARNING: failed to allocate CCPR resampled instance buffer. No paths will be "
+                 "drawn.\n");
+        return;
+    }
     fPathInstanceData = static_cast<PathInstance*>(fInstanceBuffer->map());
     SkASSERT(fPathInstanceData);
+    if (fResampledInstanceBuffer) {
+        fResampledPathInstanceData =
+                static_cast<ResampledPathInstance*>(fResampledInstanceBuffer->map());
+        SkASSERT(fResampledPathInstanceData);
+    }
+    SkDEBUGCODE(fEndResampledPathInstance = specs.fNumResampledPaths);
     SkDEBUGCODE(fEndCopyInstance =
                         specs.fNumCopiedPaths[kFillIdx] + specs.fNumCopiedPaths[kStrokeIdx]);
     SkDEBUGCODE(fEndPathInstance = inst_buffer_count(specs));
@@ -243,6 +267,23 @@ void GrCCPerFlushResources::upgradeEntryToLiteralCoverageAtlas(
     }
 }
 
+bool GrCCPerFlushResources::appendResampledDrawPathInstance(
+        const GrCCPathCacheEntry& entry, const SkMatrix& devToMask, const SkIRect& clipIBounds,
+        uint64_t color, GrCCPathProcessor::DoEvenOddFill evenOdd) {
+    SkASSERT(this->isMapped());
+    SkASSERT(fNextResampledPathInstanceIdx < fEndResampledPathInstance);
+
+    if (!entry.cachedAtlas() ||
+        !fResampledPathInstanceData[fNextResampledPathInstanceIdx].set(
+                entry, devToMask, clipIBounds, color, evenOdd)) {
+        // The mask is gone or the transformed mask is clipped out. Draw nothing.
+        SkDEBUGCODE(--fEndResampledPathInstance);
+        return false;
+    }
+    ++fNextResampledPathInstanceIdx;
+    return true;
+}
+
 template<typename T, typename... Args>
 static void emplace_at_memcpy(SkTArray<T>* array, int idx, Args&&... args) {
     if (int moveCount = array->count() - idx) {
@@ -443,9 +484,14 @@ bool GrCCPerFlushResources::finalize(GrOnFlushResourceProvider* onFlushRP,
     SkASSERT(this->isMapped());
     SkASSERT(fNextPathInstanceIdx == fEndPathInstance);
     SkASSERT(fNextCopyInstanceIdx == fEndCopyInstance);
+    SkASSERT(fNextResampledPathInstanceIdx == fEndResampledPathInstance);
 
     fInstanceBuffer->unmap();
     fPathInstanceData = nullptr;
+    if (fResampledInstanceBuffer) {
+        fResampledInstanceBuffer->unmap();
+        fResampledPathInstanceData = nullptr;
+    }
 
     if (!fCopyAtlasStack.empty()) {
         fCopyAtlasStack.current().setFillBatchID(fCopyPathRanges.count());
@@ -523,9 +569,11 @@ bool GrCCPerFlushResources::finalize(GrOnFlushResourceProvider* onFlushRP,
 }
 
 void GrCCPerFlushResourceSpecs::cancelCopies() {
-    // Convert copies to cached draws.
-    fNumCachedPaths += fNumCopiedPaths[kFillIdx] + fNumCopiedPaths[kStrokeIdx];
+    // Convert copies to cached draws. (Resampled draws still get their own instances.)
+    fNumCachedPaths += fNumCopiedPaths[kFillIdx] + fNumCopiedPaths[kStrokeIdx] -
+                       fNumCopiedResampledPaths;
     fNumCopiedPaths[kFillIdx] = fNumCopiedPaths[kStrokeIdx] = 0;
+    fNumCopiedResampledPaths = 0;
     fCopyPathStats[kFillIdx] = fCopyPathStats[kStrokeIdx] = GrCCRenderedPathStats();
     fCopyAtlasSpecs = GrCCAtlas::Specs();
 }
@@ -42,6 +42,12 @@ struct GrCCPerFlushResourceSpecs {
 
     int fNumCachedPaths = 0;
 
+    // Cached paths whose masks get resampled for a new transform. These are drawn from their own
+    // instance buffer. The ones still in 16-bit atlases are also counted in fNumCopiedPaths (and
+    // fNumCopiedResampledPaths), since they get copied like any other cached mask.
+    int fNumResampledPaths = 0;
+    int fNumCopiedResampledPaths = 0;
+
     int fNumCopiedPaths[2] = {0, 0};
     GrCCRenderedPathStats fCopyPathStats[2];
     GrCCAtlas::Specs fCopyAtlasSpecs;
@@ -52,8 +58,9 @@ struct GrCCPerFlushResourceSpecs {
     GrCCAtlas::Specs fRenderedAtlasSpecs;
 
     bool isEmpty() const {
-        return 0 == fNumCachedPaths + fNumCopiedPaths[kFillIdx] + fNumCopiedPaths[kStrokeIdx] +
-                    fNumRenderedPaths[kFillIdx] + fNumRenderedPaths[kStrokeIdx] + fNumClipPaths;
+        return 0 == fNumCachedPaths + fNumResampledPaths + fNumCopiedPaths[kFillIdx] +
+                    fNumCopiedPaths[kStrokeIdx] + fNumRenderedPaths[kFillIdx] +
+                    fNumRenderedPaths[kStrokeIdx] + fNumClipPaths;
     }
     // Converts the copies to normal cached draws.
     void cancelCopies();
@@ -100,6 +107,18 @@ public:
         return fPathInstanceData[fNextPathInstanceIdx++];
     }
 
+    // Returns the index in resampledInstanceBuffer() of the next instance that will be added by
+    // appendResampledDrawPathInstance().
+    int nextResampledPathInstanceIdx() const { return fNextResampledPathInstanceIdx; }
+
+    // Appends an instance to resampledInstanceBuffer() that draws the entry's cached mask through
+    // 'devToMask' (see GrCCPathCache::find). Returns false, without appending anything, if the
+    // transformed mask falls outside clipIBounds. As with appendDrawPathInstance(), the caller is
+    // responsible to track the instance's atlas and index, and to issue the actual draw call.
+    bool appendResampledDrawPathInstance(const GrCCPathCacheEntry&, const SkMatrix& devToMask,
+                                         const SkIRect& clipIBounds, uint64_t color,
+                                         GrCCPathProcessor::DoEvenOddFill);
+
     // Finishes off the GPU buffers and renders the atlas(es).
     bool finalize(GrOnFlushResourceProvider*, SkTArray<sk_sp<GrRenderTargetContext>>* out);
 
@@ -118,6 +137,10 @@ public:
         SkASSERT(!this->isMapped());
         return fInstanceBuffer;
     }
+    sk_sp<const GrGpuBuffer> refResampledInstanceBuffer() const {
+        SkASSERT(!this->isMapped());
+        return fResampledInstanceBuffer;
+    }
 
 private:
     void recordCopyPathInstance(const GrCCPathCacheEntry&, const SkIVector& newAtlasOffset,
@@ -134,6 +157,7 @@ private:
     const sk_sp<const GrGpuBuffer> fIndexBuffer;
     const sk_sp<const GrGpuBuffer> fVertexBuffer;
     const sk_sp<GrGpuBuffer> fInstanceBuffer;
+    const sk_sp<GrGpuBuffer> fResampledInstanceBuffer;  // Null if no paths get resampled.
 
     GrCCPathProcessor::Instance* fPathInstanceData = nullptr;
     int fNextCopyInstanceIdx;
@@ -141,6 +165,10 @@ private:
     int fNextPathInstanceIdx;
     SkDEBUGCODE(int fEndPathInstance);
 
+    GrCCPathProcessor::ResampledInstance* fResampledPathInstanceData = nullptr;
+    int fNextResampledPathInstanceIdx = 0;
+    SkDEBUGCODE(int fEndResampledPathInstance);
+
     // Represents a range of copy-path instances that all share the same source proxy. (i.e. Draw
     // instances that copy a path mask from a 16-bit coverage count atlas into an 8-bit literal
     // coverage atlas.)
@@ -34,16 +34,19 @@ bool GrCoverageCountingPathRenderer::IsSupported(const GrCaps& caps) {
 }
 
 sk_sp<GrCoverageCountingPathRenderer> GrCoverageCountingPathRenderer::CreateIfSupported(
-        const GrCaps& caps, AllowCaching allowCaching, uint32_t contextUniqueID) {
+        const GrCaps& caps, AllowCaching allowCaching, AllowResampling allowResampling,
+        uint32_t contextUniqueID) {
     return sk_sp<GrCoverageCountingPathRenderer>((IsSupported(caps))
-            ? new GrCoverageCountingPathRenderer(allowCaching, contextUniqueID)
+            ? new GrCoverageCountingPathRenderer(allowCaching, allowResampling, contextUniqueID)
             : nullptr);
 }
 
 GrCoverageCountingPathRenderer::GrCoverageCountingPathRenderer(AllowCaching allowCaching,
+                                                               AllowResampling allowResampling,
                                                                uint32_t contextUniqueID) {
     if (AllowCaching::kYes == allowCaching) {
-        fPathCache = skstd::make_unique<GrCCPathCache>(contextUniqueID);
+        fPathCache = skstd::make_unique<GrCCPathCache>(
+                contextUniqueID, AllowResampling::kYes == allowResampling);
     }
 }
 
@@ -86,6 +89,7 @@ GrPathRenderer::CanDrawPath GrCoverageCountingPathRenderer::onCanDrawPath(
                 // This is a complicated path that has more vertices than pixels! Let's let the SW
                 // renderer have this one: It will probably be faster and a bitmap will require less
                 // total memory on the GPU than CCPR instance buffers would for the raw path data.
+                args.fRejectReason = "more points than pixels";
                 return CanDrawPath::kNo;
             }
 
@@ -93,11 +97,13 @@ GrPathRenderer::CanDrawPath GrCoverageCountingPathRenderer::onCanDrawPath(
                 // Large paths can blow up the atlas fast. And they are not ideal for a two-pass
                 // rendering algorithm. Give the simpler direct renderers a chance before we commit
                 // to drawing it.
+                args.fRejectReason = "too large";
                 return CanDrawPath::kAsBackup;
             }
 
             if (args.fShape->hasUnstyledKey() && path.countVerbs() > 50) {
                 // Complex paths do better cached in an SDF, if the renderer will accept them.
+                args.fRejectReason = "too complex to not cache";
                 return CanDrawPath::kAsBackup;
             }
 
@@ -109,6 +115,7 @@ GrPathRenderer::CanDrawPath GrCoverageCountingPathRenderer::onCanDrawPath(
                 // The stroker currently only supports rigid-body transfoms for the stroke lines
                 // themselves. This limitation doesn't affect hairlines since their stroke lines are
                 // defined relative to device space.
+                args.fRejectReason = "stroke matrix is not a similarity";
                 return CanDrawPath::kNo;
             }
             // fallthru
@@ -118,11 +125,13 @@ GrPathRenderer::CanDrawPath GrCoverageCountingPathRenderer::onCanDrawPath(
             if (!(inflationRadius <= kMaxBoundsInflationFromStroke)) {
                 // Let extremely wide strokes be converted to fill paths and drawn by the CCPR
                 // filler instead. (Cast the logic negatively in order to also catch r=NaN.)
+                args.fRejectReason = "stroke too wide";
                 return CanDrawPath::kNo;
             }
             SkASSERT(!SkScalarIsNaN(inflationRadius));
             if (SkPathPriv::ConicWeightCnt(path)) {
                 // The stroker does not support conics yet.
+                args.fRejectReason = "stroked conics";
                 return CanDrawPath::kNo;
             }
             return CanDrawPath::kYes;
@@ -305,6 +314,11 @@ void GrCoverageCountingPathRenderer::purgeCacheEntriesOlderThan(
     }
 }
 
+int GrCoverageCountingPathRenderer::purgeCacheEntries(GrProxyProvider* proxyProvider,
+                                                     float fraction) {
+    return fPathCache ? fPathCache->purgeEntries(proxyProvider, fraction) : 0;
+}
+
 void GrCoverageCountingPathRenderer::CropPath(const SkPath& path, const SkIRect& cropbox,
                                               SkPath* out) {
     SkPath cropboxPath;
@@ -336,3 +350,11 @@ float GrCoverageCountingPathRenderer::GetStrokeDevWidth(const SkMatrix& m,
     }
     return strokeDevWidth;
 }
+
+#if GR_CACHE_STATS && GR_TEST_UTILS
+void GrCoverageCountingPathRenderer::dumpPathCacheStats(SkString* out) const {
+    if (fPathCache) {
+        fPathCache->dumpStats(out);
+    }
+}
+#endif
@@ -29,12 +29,22 @@ class GrCoverageCountingPathRenderer : public GrPathRenderer, public GrOnFlushCa
 public:
     static bool IsSupported(const GrCaps&);
 
+    const char* name() const override { return "ccpr"; }
+
     enum class AllowCaching : bool {
         kNo = false,
         kYes = true
     };
 
+    // If caching is allowed, this also decides whether cached path masks may be resampled for
+    // transforms other than the one they were rendered with. (See GrCCPathCache::find.)
+    enum class AllowResampling : bool {
+        kNo = false,
+        kYes = true
+    };
+
     static sk_sp<GrCoverageCountingPathRenderer> CreateIfSupported(const GrCaps&, AllowCaching,
+                                                                   AllowResampling,
                                                                    uint32_t contextUniqueID);
 
     using PendingPathsMap = std::map<uint32_t, sk_sp<GrCCPerOpListPaths>>;
@@ -67,6 +77,8 @@ public:
     void postFlush(GrDeferredUploadToken, const uint32_t* opListIDs, int numOpListIDs) override;
 
     void purgeCacheEntriesOlderThan(GrProxyProvider*, const GrStdSteadyClock::time_point&);
+    // Returns the number of entries purged. See GrCCPathCache::purgeEntries().
+    int purgeCacheEntries(GrProxyProvider*, float fraction);
 
     // If a path spans more pixels than this, we need to crop it or else analytic AA can run out of
     // fp32 precision.
@@ -81,8 +93,13 @@ public:
     static float GetStrokeDevWidth(const SkMatrix&, const SkStrokeRec&,
                                    float* inflationRadius = nullptr);
 
+#if GR_CACHE_STATS && GR_TEST_UTILS
+    // Appends the path cache's hit rates to 'out', if caching is enabled.
+    void dumpPathCacheStats(SkString* out) const;
+#endif
+
 private:
-    GrCoverageCountingPathRenderer(AllowCaching, uint32_t contextUniqueID);
+    GrCoverageCountingPathRenderer(AllowCaching, AllowResampling, uint32_t contextUniqueID);
 
     // GrPathRenderer overrides.
     StencilSupport onGetStencilSupport(const GrShape&) const override {
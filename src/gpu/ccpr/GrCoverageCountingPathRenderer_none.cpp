@@ -12,7 +12,8 @@ bool GrCoverageCountingPathRenderer::IsSupported(const GrCaps& caps) {
 }
 
 sk_sp<GrCoverageCountingPathRenderer> GrCoverageCountingPathRenderer::CreateIfSupported(
-        const GrCaps& caps, AllowCaching allowCaching, uint32_t contextUniqueID) {
+        const GrCaps& caps, AllowCaching allowCaching, AllowResampling allowResampling,
+        uint32_t contextUniqueID) {
     return nullptr;
 }
 
@@ -21,3 +22,7 @@ std::unique_ptr<GrFragmentProcessor> GrCoverageCountingPathRenderer::makeClipPro
         int rtHeight, const GrCaps& caps) {
     return nullptr;
 }
+
+#if GR_CACHE_STATS && GR_TEST_UTILS
+void GrCoverageCountingPathRenderer::dumpPathCacheStats(SkString*) const {}
+#endif
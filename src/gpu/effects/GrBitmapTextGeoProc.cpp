@@ -20,7 +20,10 @@
 
 class GrGLBitmapTextGeoProc : public GrGLSLGeometryProcessor {
 public:
-    GrGLBitmapTextGeoProc() : fColor(SK_PMColor4fILLEGAL), fAtlasSize({0,0}) {}
+    GrGLBitmapTextGeoProc()
+            : fColor(SK_PMColor4fILLEGAL)
+            , fAtlasSize({0,0})
+            , fTranslate({SK_ScalarNaN, SK_ScalarNaN}) {}
 
     void onEmitCode(EmitArgs& args, GrGPArgs* gpArgs) override {
         const GrBitmapTextGeoProc& btgp = args.fGP.cast<GrBitmapTextGeoProc>();
@@ -54,9 +57,20 @@ public:
         }
 
         // Setup position
-        gpArgs->fPositionVar = btgp.inPosition().asShaderVar();
+        if (btgp.usesW()) {
+            gpArgs->fPositionVar = btgp.inPosition().asShaderVar();
+        } else {
+            const char* translateName;
+            fTranslateUniform = uniformHandler->addUniform(kVertex_GrShaderFlag,
+                                                           kFloat2_GrSLType,
+                                                           "Translate",
+                                                           &translateName);
+            vertBuilder->codeAppendf("float2 position = %s + %s;",
+                                     btgp.inPosition().name(), translateName);
+            gpArgs->fPositionVar.set(kFloat2_GrSLType, "position");
+        }
 
-        // emit transforms
+        // emit transforms. The local matrix already accounts for the translate.
         this->emitTransforms(vertBuilder,
                              varyingHandler,
                              uniformHandler,
@@ -92,6 +106,11 @@ public:
             pdman.set2f(fAtlasSizeInvUniform, 1.0f / atlasSize.fWidth, 1.0f / atlasSize.fHeight);
             fAtlasSize = atlasSize;
         }
+
+        if (!btgp.usesW() && fTranslate != btgp.translate()) {
+            pdman.set2f(fTranslateUniform, btgp.translate().fX, btgp.translate().fY);
+            fTranslate = btgp.translate();
+        }
         this->setTransformDataHelper(btgp.localMatrix(), pdman, &transformIter);
     }
 
@@ -113,6 +132,9 @@ private:
     SkISize       fAtlasSize;
     UniformHandle fAtlasSizeInvUniform;
 
+    SkVector      fTranslate;
+    UniformHandle fTranslateUniform;
+
     typedef GrGLSLGeometryProcessor INHERITED;
 };
 
@@ -124,13 +146,18 @@ GrBitmapTextGeoProc::GrBitmapTextGeoProc(const GrShaderCaps& caps,
                                          const sk_sp<GrTextureProxy>* proxies,
                                          int numActiveProxies,
                                          const GrSamplerState& params, GrMaskFormat format,
-                                         const SkMatrix& localMatrix, bool usesW)
+                                         const SkMatrix& localMatrix, bool usesW,
+                                         const SkVector& translate)
         : INHERITED(kGrBitmapTextGeoProc_ClassID)
         , fColor(color)
         , fLocalMatrix(localMatrix)
         , fUsesW(usesW)
+        , fTranslate(translate)
         , fMaskFormat(format) {
     SkASSERT(numActiveProxies <= kMaxTextures);
+    SkASSERT(!usesW || translate.isZero());
+    // Local coords are computed from the untranslated positions.
+    fLocalMatrix.preTranslate(translate.fX, translate.fY);
 
     if (usesW) {
         fInPosition = {"inPosition", kFloat3_GrVertexAttribType, kFloat3_GrSLType};
@@ -17,7 +17,8 @@ class GrInvariantOutput;
 /**
  * The output color of this effect is a modulation of the input color and a sample from a texture.
  * It allows explicit specification of the filtering and wrap modes (GrSamplerState). The input
- * coords are a custom attribute.
+ * coords are a custom attribute. Unless usesW is set, the positions are offset by a translate
+ * uniform, so moved text doesn't need new vertices.
  */
 class GrBitmapTextGeoProc : public GrGeometryProcessor {
 public:
@@ -28,10 +29,11 @@ public:
                                            const sk_sp<GrTextureProxy>* proxies,
                                            int numActiveProxies,
                                            const GrSamplerState& p, GrMaskFormat format,
-                                           const SkMatrix& localMatrix, bool usesW) {
+                                           const SkMatrix& localMatrix, bool usesW,
+                                           const SkVector& translate = {0, 0}) {
         return sk_sp<GrGeometryProcessor>(
             new GrBitmapTextGeoProc(caps, color, wideColor, proxies, numActiveProxies, p, format,
-                                    localMatrix, usesW));
+                                    localMatrix, usesW, translate));
     }
 
     ~GrBitmapTextGeoProc() override {}
@@ -46,6 +48,7 @@ public:
     bool hasVertexColor() const { return fInColor.isInitialized(); }
     const SkMatrix& localMatrix() const { return fLocalMatrix; }
     bool usesW() const { return fUsesW; }
+    const SkVector& translate() const { return fTranslate; }
     const SkISize& atlasSize() const { return fAtlasSize; }
 
     void addNewProxies(const sk_sp<GrTextureProxy>*, int numActiveProxies, const GrSamplerState&);
@@ -58,13 +61,14 @@ private:
     GrBitmapTextGeoProc(const GrShaderCaps&, const SkPMColor4f&, bool wideColor,
                         const sk_sp<GrTextureProxy>* proxies, int numProxies,
                         const GrSamplerState& params, GrMaskFormat format,
-                        const SkMatrix& localMatrix, bool usesW);
+                        const SkMatrix& localMatrix, bool usesW, const SkVector& translate);
 
     const TextureSampler& onTextureSampler(int i) const override { return fTextureSamplers[i]; }
 
     SkPMColor4f      fColor;
     SkMatrix         fLocalMatrix;
     bool             fUsesW;
+    SkVector         fTranslate;
     SkISize          fAtlasSize;  // size for all textures used with fTextureSamplers[].
     TextureSampler   fTextureSamplers[kMaxTextures];
     Attribute        fInPosition;
@@ -177,6 +177,10 @@ sk_sp<const GrGLInterface> GrGLMakeAssembledGLESInterface(void *ctx, GrGLGetProc
         GET_PROC_SUFFIX(ClearTexSubImage, EXT);
     }
 
+    if (extensions.has("GL_EXT_buffer_storage")) {
+        GET_PROC_SUFFIX(BufferStorage, EXT);
+    }
+
     if (glVer >= GR_GL_VER(3,0)) {
         GET_PROC(DrawArraysInstanced);
         GET_PROC(DrawElementsInstanced);
@@ -182,6 +182,12 @@ sk_sp<const GrGLInterface> GrGLMakeAssembledGLInterface(void *ctx, GrGLGetProc g
         GET_PROC(ClearTexSubImage);
     }
 
+    if (glVer >= GR_GL_VER(4,4)) {
+        GET_PROC(BufferStorage);
+    } else if (extensions.has("GL_ARB_buffer_storage")) {
+        GET_PROC(BufferStorage);
+    }
+
     if (glVer >= GR_GL_VER(3,1)) {
         GET_PROC(DrawArraysInstanced);
         GET_PROC(DrawElementsInstanced);
@@ -44,6 +44,18 @@ sk_sp<GrGLBuffer> GrGLBuffer::Make(GrGLGpu* gpu, size_t size, GrGpuBufferType in
     return buffer;
 }
 
+sk_sp<GrGLBuffer> GrGLBuffer::MakePersistentlyMapped(GrGLGpu* gpu, size_t size,
+                                                     GrGpuBufferType intendedType) {
+    SkASSERT(gpu->caps()->persistentlyMappedBufferSupport());
+    SkASSERT(GrGpuBufferType::kXferGpuToCpu != intendedType);
+    sk_sp<GrGLBuffer> buffer(new GrGLBuffer(gpu, size, intendedType, kDynamic_GrAccessPattern,
+                                            nullptr, /* persistentlyMapped */ true));
+    if (0 == buffer->bufferID()) {
+        return nullptr;
+    }
+    return buffer;
+}
+
 // GL_STREAM_DRAW triggers an optimization in Chromium's GPU process where a client's vertex buffer
 // objects are implemented as client-side-arrays on tile-deferred architectures.
 #define DYNAMIC_DRAW_PARAM GR_GL_STREAM_DRAW
@@ -94,32 +106,49 @@ inline static GrGLenum gr_to_gl_access_pattern(GrGpuBufferType bufferType,
 }
 
 GrGLBuffer::GrGLBuffer(GrGLGpu* gpu, size_t size, GrGpuBufferType intendedType,
-                       GrAccessPattern accessPattern, const void* data)
+                       GrAccessPattern accessPattern, const void* data, bool persistentlyMapped)
         : INHERITED(gpu, size, intendedType, accessPattern)
         , fIntendedType(intendedType)
         , fBufferID(0)
         , fUsage(gr_to_gl_access_pattern(intendedType, accessPattern))
         , fGLSizeInBytes(0)
-        , fHasAttachedToTexture(false) {
+        , fHasAttachedToTexture(false)
+        , fPersistentMapPtr(nullptr) {
     GL_CALL(GenBuffers(1, &fBufferID));
     if (fBufferID) {
         GrGLenum target = gpu->bindBuffer(fIntendedType, this);
         CLEAR_ERROR_BEFORE_ALLOC(gpu->glInterface());
         // make sure driver can allocate memory for this buffer
-        GL_ALLOC_CALL(gpu->glInterface(), BufferData(target,
-                                                     (GrGLsizeiptr) size,
-                                                     data,
-                                                     fUsage));
-        if (CHECK_ALLOC_ERROR(gpu->glInterface()) != GR_GL_NO_ERROR) {
+        if (persistentlyMapped) {
+            static constexpr GrGLbitfield kFlags =
+                    GR_GL_MAP_WRITE_BIT | GR_GL_MAP_PERSISTENT_BIT | GR_GL_MAP_COHERENT_BIT;
+            GL_ALLOC_CALL(gpu->glInterface(), BufferStorage(target,
+                                                            (GrGLsizeiptr) size,
+                                                            data,
+                                                            kFlags));
+            if (CHECK_ALLOC_ERROR(gpu->glInterface()) == GR_GL_NO_ERROR) {
+                GL_CALL_RET(fPersistentMapPtr, MapBufferRange(target, 0, size, kFlags));
+            }
+        } else {
+            GL_ALLOC_CALL(gpu->glInterface(), BufferData(target,
+                                                         (GrGLsizeiptr) size,
+                                                         data,
+                                                         fUsage));
+        }
+        if (CHECK_ALLOC_ERROR(gpu->glInterface()) != GR_GL_NO_ERROR ||
+            (persistentlyMapped && !fPersistentMapPtr)) {
             GL_CALL(DeleteBuffers(1, &fBufferID));
             fBufferID = 0;
+            fPersistentMapPtr = nullptr;
         } else {
             fGLSizeInBytes = size;
         }
     }
     VALIDATE();
     this->registerWithCache(SkBudgeted::kYes);
-    if (!fBufferID) {
+    // The immutable storage can't be respecified by map() or updateData(), so it mustn't be handed
+    // out again as an ordinary dynamic buffer.
+    if (!fBufferID || persistentlyMapped) {
         this->resourcePriv().removeScratchKey();
     }
 }
@@ -138,11 +167,13 @@ void GrGLBuffer::onRelease() {
         VALIDATE();
         // make sure we've not been abandoned or already released
         if (fBufferID) {
+            // Deleting a buffer implicitly unmaps it.
             GL_CALL(DeleteBuffers(1, &fBufferID));
             fBufferID = 0;
             fGLSizeInBytes = 0;
         }
         fMapPtr = nullptr;
+        fPersistentMapPtr = nullptr;
         VALIDATE();
     }
 
@@ -153,6 +184,7 @@ void GrGLBuffer::onAbandon() {
     fBufferID = 0;
     fGLSizeInBytes = 0;
     fMapPtr = nullptr;
+    fPersistentMapPtr = nullptr;
     VALIDATE();
     INHERITED::onAbandon();
 }
@@ -162,6 +194,11 @@ void GrGLBuffer::onMap() {
     SkASSERT(!this->wasDestroyed());
     VALIDATE();
     SkASSERT(!this->isMapped());
+    // Persistently mapped buffers are written through persistentMapPtr() instead.
+    if (fPersistentMapPtr) {
+        SkDEBUGFAIL("Can't map a persistently mapped buffer.");
+        return;
+    }
 
     // TODO: Make this a function parameter.
     bool readOnly = (GrGpuBufferType::kXferGpuToCpu == fIntendedType);
@@ -250,7 +287,7 @@ bool GrGLBuffer::onUpdateData(const void* src, size_t srcSizeInBytes) {
 
     SkASSERT(!this->isMapped());
     VALIDATE();
-    if (srcSizeInBytes > this->size()) {
+    if (fPersistentMapPtr || srcSizeInBytes > this->size()) {
         return false;
     }
     SkASSERT(srcSizeInBytes <= this->size());
@@ -19,6 +19,14 @@ public:
     static sk_sp<GrGLBuffer> Make(GrGLGpu*, size_t size, GrGpuBufferType intendedType,
                                   GrAccessPattern, const void* data = nullptr);
 
+    /**
+     * Makes a buffer with immutable storage that stays mapped for writing, coherently, until it is
+     * released. It can't be mapped or updated through the GrGpuBuffer API, and isn't reused as a
+     * scratch resource.
+     */
+    static sk_sp<GrGLBuffer> MakePersistentlyMapped(GrGLGpu*, size_t size,
+                                                    GrGpuBufferType intendedType);
+
     ~GrGLBuffer() override {
         // either release or abandon should have been called by the owner of this object.
         SkASSERT(0 == fBufferID);
@@ -35,9 +43,12 @@ public:
     void setHasAttachedToTexture() { fHasAttachedToTexture = true; }
     bool hasAttachedToTexture() const { return fHasAttachedToTexture; }
 
+    /** Where the CPU writes a persistently mapped buffer, or null for other buffers. */
+    void* persistentMapPtr() const { return fPersistentMapPtr; }
+
 protected:
     GrGLBuffer(GrGLGpu*, size_t size, GrGpuBufferType intendedType, GrAccessPattern,
-               const void* data);
+               const void* data, bool persistentlyMapped = false);
 
     void onAbandon() override;
     void onRelease() override;
@@ -61,6 +72,7 @@ private:
     GrGLenum        fUsage;
     size_t          fGLSizeInBytes;
     bool            fHasAttachedToTexture;
+    void*           fPersistentMapPtr;
 
     typedef GrGpuBuffer INHERITED;
 };
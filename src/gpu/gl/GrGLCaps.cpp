@@ -635,6 +635,19 @@ void GrGLCaps::init(const GrContextOptions& contextOptions,
     // Safely moving textures between contexts requires semaphores.
     fCrossContextTextureSupport = fSemaphoreSupport;
 
+    // Persistent mapping needs immutable buffer storage, and fences to know when the GPU is done
+    // with each part of the buffer. It's opt-in for now.
+    if (GrContextOptions::Enable::kYes == contextOptions.fUsePersistentlyMappedBuffers &&
+        kMapBufferRange_MapBufferType == fMapBufferType && fFenceSyncSupport &&
+        gli->fFunctions.fBufferStorage) {
+        if (GR_IS_GR_GL(standard)) {
+            fPersistentlyMappedBufferSupport = version >= GR_GL_VER(4, 4) ||
+                                               ctxInfo.hasExtension("GL_ARB_buffer_storage");
+        } else if (GR_IS_GR_GL_ES(standard)) {
+            fPersistentlyMappedBufferSupport = ctxInfo.hasExtension("GL_EXT_buffer_storage");
+        }
+    }
+
     // Half float vertex attributes requires GL3 or ES3
     // It can also work with OES_VERTEX_HALF_FLOAT, but that requires a different enum.
     if (GR_IS_GR_GL(standard)) {
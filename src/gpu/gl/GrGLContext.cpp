@@ -6,6 +6,7 @@
  */
 
 #include "src/gpu/gl/GrGLContext.h"
+#include "src/core/SkPerfCounters.h"
 #include "src/gpu/gl/GrGLGLSL.h"
 #include "src/sksl/SkSLCompiler.h"
 
@@ -100,5 +101,6 @@ GrGLContextInfo::GrGLContextInfo(ConstructorArgs&& args) {
     fANGLEVendor = args.fANGLEVendor;
     fANGLERenderer = args.fANGLERenderer;
 
+    SkPerfCounters::AutoInitPhase phase(SkGraphics::InitPhase::kGLCaps);
     fGLCaps = sk_make_sp<GrGLCaps>(*args.fContextOptions, *this, fInterface.get());
 }
@@ -27,6 +27,7 @@
 #include "src/gpu/GrMesh.h"
 #include "src/gpu/GrPipeline.h"
 #include "src/gpu/GrRenderTargetPriv.h"
+#include "src/gpu/GrResourceProvider.h"
 #include "src/gpu/GrShaderCaps.h"
 #include "src/gpu/GrSurfaceProxyPriv.h"
 #include "src/gpu/GrTexturePriv.h"
@@ -848,11 +849,48 @@ bool GrGLGpu::onWritePixels(GrSurface* surface, int left, int top, int width, in
     auto srcAsConfig = GrColorTypeToPixelConfig(srcColorType, srgbEncoded);
 
     SkASSERT(!GrPixelConfigIsCompressed(glTex->config()));
+
+    // Large uploads from client memory block in glTexSubImage2D on many drivers. Staged through a
+    // pixel unpack buffer instead, the CPU only waits for the copy into the buffer, and the driver
+    // can move the data into the texture while it gets on with other work.
+    static constexpr size_t kMinTransferBufferUploadSize = 1 << 18;
+    if (1 == mipLevelCount && texels[0].fPixels && GrSRGBEncoded::kNo == srgbEncoded &&
+        GrGLCaps::kPBO_TransferBufferType == this->glCaps().transferBufferType() &&
+        width * height * GrColorTypeBytesPerPixel(srcColorType) >= kMinTransferBufferUploadSize &&
+        this->writePixelsThroughTransferBuffer(glTex, left, top, width, height, srcColorType,
+                                               texels[0])) {
+        return true;
+    }
+
     return this->uploadTexData(glTex->config(), glTex->width(), glTex->height(), glTex->target(),
                                kWrite_UploadType, left, top, width, height, srcAsConfig, texels,
                                mipLevelCount);
 }
 
+bool GrGLGpu::writePixelsThroughTransferBuffer(GrGLTexture* glTex, int left, int top, int width,
+                                               int height, GrColorType srcColorType,
+                                               const GrMipLevel& texel) {
+    const size_t bpp = GrColorTypeBytesPerPixel(srcColorType);
+    const size_t trimRowBytes = width * bpp;
+    const size_t rowBytes = texel.fRowBytes ? texel.fRowBytes : trimRowBytes;
+    if (rowBytes != trimRowBytes &&
+        (!this->glCaps().unpackRowLengthSupport() || rowBytes % bpp)) {
+        return false;
+    }
+
+    // Dynamic buffers are recycled through the resource cache. updateData respecifies the
+    // buffer's storage, so reusing one doesn't wait on the GPU reading the last upload from it.
+    const size_t size = rowBytes * (height - 1) + trimRowBytes;
+    GrResourceProvider* resourceProvider = this->getContext()->priv().resourceProvider();
+    sk_sp<GrGpuBuffer> buffer = resourceProvider->createBuffer(
+            size, GrGpuBufferType::kXferCpuToGpu, kDynamic_GrAccessPattern, nullptr);
+    if (!buffer || !buffer->updateData(texel.fPixels, size)) {
+        return false;
+    }
+    return this->onTransferPixelsTo(glTex, left, top, width, height, srcColorType, buffer.get(),
+                                    0, rowBytes);
+}
+
 // For GL_[UN]PACK_ALIGNMENT. TODO: This really wants to be GrColorType.
 static inline GrGLint config_alignment(GrPixelConfig config) {
     SkASSERT(!GrPixelConfigIsCompressed(config));
@@ -1938,6 +1976,17 @@ sk_sp<GrGpuBuffer> GrGLGpu::onCreateBuffer(size_t size, GrGpuBufferType intended
     return GrGLBuffer::Make(this, size, intendedType, accessPattern, data);
 }
 
+sk_sp<GrGpuBuffer> GrGLGpu::onCreatePersistentlyMappedBuffer(size_t size,
+                                                             GrGpuBufferType intendedType,
+                                                             void** mappedPtr) {
+    sk_sp<GrGLBuffer> buffer = GrGLBuffer::MakePersistentlyMapped(this, size, intendedType);
+    if (!buffer) {
+        return nullptr;
+    }
+    *mappedPtr = buffer->persistentMapPtr();
+    return std::move(buffer);
+}
+
 void GrGLGpu::flushScissor(const GrScissorState& scissorState, int rtWidth, int rtHeight,
                            GrSurfaceOrigin rtOrigin) {
     if (scissorState.enabled()) {
@@ -157,6 +157,10 @@ public:
 
     void submit(GrGpuCommandBuffer* buffer) override;
 
+    bool precompileShader(const SkData& key, const SkData& data) override {
+        return fProgramCache->precompileShader(key, data);
+    }
+
     GrFence SK_WARN_UNUSED_RESULT insertFence() override;
     bool waitFence(GrFence, uint64_t timeout) override;
     void deleteFence(GrFence) const override;
@@ -196,6 +200,8 @@ private:
 
     sk_sp<GrGpuBuffer> onCreateBuffer(size_t size, GrGpuBufferType intendedType, GrAccessPattern,
                                       const void* data) override;
+    sk_sp<GrGpuBuffer> onCreatePersistentlyMappedBuffer(size_t size, GrGpuBufferType,
+                                                        void** mappedPtr) override;
 
     sk_sp<GrTexture> onWrapBackendTexture(const GrBackendTexture&, GrWrapOwnership, GrWrapCacheable,
                                           GrIOType) override;
@@ -323,6 +329,7 @@ private:
                                 const GrPrimitiveProcessor&,
                                 const GrTextureProxy* const primProcProxies[],
                                 const GrPipeline&, bool hasPointSize);
+        bool precompileShader(const SkData& key, const SkData& data);
 
     private:
         // We may actually have kMaxEntries+1 shaders in the GL context because we create a new
@@ -401,6 +408,11 @@ private:
                        GrPixelConfig dataConfig, const GrMipLevel texels[], int mipLevelCount,
                        GrMipMapsStatus* mipMapsStatus = nullptr);
 
+    // helper for onWritePixels. Stages a single level of pixels in a transfer buffer and uploads
+    // the texture from that, returning false if it couldn't.
+    bool writePixelsThroughTransferBuffer(GrGLTexture*, int left, int top, int width, int height,
+                                          GrColorType srcColorType, const GrMipLevel& texel);
+
     // helper for onCreateCompressedTexture. Compressed textures are read-only so we
     // only use this to populate a new texture.
     bool uploadCompressedTexData(GrPixelConfig texConfig, int texWidth, int texHeight,
@@ -7,6 +7,7 @@
 
 #include "src/gpu/gl/GrGLGpu.h"
 
+#include "src/core/SkPerfCounters.h"
 #include "src/core/SkTSearch.h"
 #include "src/gpu/GrProcessor.h"
 #include "src/gpu/GrProgramDesc.h"
@@ -25,7 +26,27 @@ typedef GrGLSLProgramDataManager::UniformHandle UniformHandle;
 struct GrGLGpu::ProgramCache::Entry {
     Entry(sk_sp<GrGLProgram> program) : fProgram(std::move(program)) {}
 
+    Entry(GrGLGpu* gpu, const GrGLPrecompiledProgram& precompiledProgram)
+        : fGpu(gpu)
+        , fPrecompiledProgram(precompiledProgram) {}
+
+    ~Entry() {
+        // A precompiled program that was never used still owns its GL program.
+        if (fPrecompiledProgram.fProgramID) {
+            GR_GL_CALL(fGpu->glInterface(), DeleteProgram(fPrecompiledProgram.fProgramID));
+        }
+    }
+
+    void abandon() {
+        if (fProgram) {
+            fProgram->abandon();
+        }
+        fPrecompiledProgram.fProgramID = 0;
+    }
+
     sk_sp<GrGLProgram> fProgram;
+    GrGLGpu* fGpu = nullptr;
+    GrGLPrecompiledProgram fPrecompiledProgram;
 };
 
 GrGLGpu::ProgramCache::ProgramCache(GrGLGpu* gpu)
@@ -57,7 +78,7 @@ GrGLGpu::ProgramCache::~ProgramCache() {
 
 void GrGLGpu::ProgramCache::abandon() {
     fMap.foreach([](std::unique_ptr<Entry>* e) {
-        (*e)->fProgram->abandon();
+        (*e)->abandon();
     });
 
     this->reset();
@@ -96,11 +117,26 @@ GrGLProgram* GrGLGpu::ProgramCache::refProgram(GrGLGpu* gpu,
         desc.setSurfaceOriginKey(GrGLSLFragmentShaderBuilder::KeyForSurfaceOrigin(origin));
         entry = fMap.find(desc);
     }
-    if (!entry) {
+    if (entry && !(*entry)->fProgram) {
+        // Finish a program that precompileShader() already linked
+        const GrGLPrecompiledProgram* precompiledProgram = &((*entry)->fPrecompiledProgram);
+        SkASSERT(precompiledProgram->fProgramID != 0);
+        GrGLProgram* program = GrGLProgramBuilder::CreateProgram(renderTarget, origin,
+                                                                 primProc, primProcProxies,
+                                                                 pipeline, &desc, fGpu,
+                                                                 precompiledProgram);
+        if (nullptr == program) {
+            return nullptr;
+        }
+        // The GrGLProgram now owns the GL program
+        (*entry)->fPrecompiledProgram.fProgramID = 0;
+        (*entry)->fProgram.reset(program);
+    } else if (!entry) {
         // We have a cache miss
 #ifdef PROGRAM_CACHE_STATS
         ++fCacheMisses;
 #endif
+        SkPerfCounters::Add(SkGraphics::PerfCounter::kGpuProgramCacheMisses);
         GrGLProgram* program = GrGLProgramBuilder::CreateProgram(renderTarget, origin,
                                                                  primProc, primProcProxies,
                                                                  pipeline, &desc, fGpu);
@@ -112,3 +148,24 @@ GrGLProgram* GrGLGpu::ProgramCache::refProgram(GrGLGpu* gpu,
 
     return SkRef((*entry)->fProgram.get());
 }
+
+bool GrGLGpu::ProgramCache::precompileShader(const SkData& key, const SkData& data) {
+    GrProgramDesc desc;
+    if (!GrProgramDesc::BuildFromData(&desc, key.data(), key.size())) {
+        return false;
+    }
+
+    std::unique_ptr<Entry>* entry = fMap.find(desc);
+    if (entry) {
+        // We've already seen/compiled this shader
+        return true;
+    }
+
+    GrGLPrecompiledProgram precompiledProgram;
+    if (!GrGLProgramBuilder::PrecompileProgram(&precompiledProgram, fGpu, data)) {
+        return false;
+    }
+
+    fMap.insert(desc, std::unique_ptr<Entry>(new Entry(fGpu, precompiledProgram)));
+    return true;
+}
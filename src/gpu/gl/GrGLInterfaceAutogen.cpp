@@ -203,6 +203,14 @@ bool GrGLInterface::validate() const {
         // all functions were marked optional or test_only
     }
 
+    if ((GR_IS_GR_GL(fStandard) && (
+          (glVer >= GR_GL_VER(4,4)) ||
+          fExtensions.has("GL_ARB_buffer_storage"))) ||
+       (GR_IS_GR_GL_ES(fStandard) && (
+          fExtensions.has("GL_EXT_buffer_storage")))) {
+        // all functions were marked optional or test_only
+    }
+
     if ((GR_IS_GR_GL(fStandard) && (
           (glVer >= GR_GL_VER(3,1)) ||
           fExtensions.has("GL_ARB_draw_instanced") ||
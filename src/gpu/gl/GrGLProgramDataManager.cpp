@@ -14,6 +14,24 @@
          SkASSERT((COUNT) <= (UNI).fArrayCount || \
                   (1 == (COUNT) && GrShaderVar::kNonArray == (UNI).fArrayCount))
 
+// Every uniform type is uploaded as 32 bit ints or floats.
+static int words_per_element(GrSLType type) {
+    switch (type) {
+        case kFloat2x2_GrSLType:
+        case kHalf2x2_GrSLType:
+            return 4;
+        case kFloat3x3_GrSLType:
+        case kHalf3x3_GrSLType:
+            return 9;
+        case kFloat4x4_GrSLType:
+        case kHalf4x4_GrSLType:
+            return 16;
+        default:
+            SkASSERT(GrSLTypeVecLength(type) > 0);
+            return GrSLTypeVecLength(type);
+    }
+}
+
 GrGLProgramDataManager::GrGLProgramDataManager(GrGLGpu* gpu, GrGLuint programID,
                                                const UniformInfoArray& uniforms,
                                                const VaryingInfoArray& pathProcVaryings)
@@ -21,6 +39,7 @@ GrGLProgramDataManager::GrGLProgramDataManager(GrGLGpu* gpu, GrGLuint programID,
     , fProgramID(programID) {
     int count = uniforms.count();
     fUniforms.push_back_n(count);
+    int totalWords = 0;
     for (int i = 0; i < count; i++) {
         Uniform& uniform = fUniforms[i];
         const UniformInfo& builderUniform = uniforms[i];
@@ -31,7 +50,15 @@ GrGLProgramDataManager::GrGLProgramDataManager(GrGLGpu* gpu, GrGLuint programID,
             uniform.fType = builderUniform.fVariable.getType();
         )
         uniform.fLocation = builderUniform.fLocation;
+        int words = words_per_element(builderUniform.fVariable.getType());
+        int arrayCount = builderUniform.fVariable.isArray()
+                                 ? builderUniform.fVariable.getArrayCount() : 1;
+        uniform.fUploadedOffset = totalWords;
+        uniform.fWordsPerElement = words;
+        uniform.fUploadedCount = 0;
+        totalWords += words * arrayCount;
     }
+    fUploadedValues.push_back_n(totalWords);
 
     // NVPR programs have separable varyings
     count = pathProcVaryings.count();
@@ -50,6 +77,22 @@ GrGLProgramDataManager::GrGLProgramDataManager(GrGLGpu* gpu, GrGLuint programID,
     }
 }
 
+bool GrGLProgramDataManager::needsUpload(const Uniform& uni, int arrayCount,
+                                         const void* values) const {
+    const int words = arrayCount * uni.fWordsPerElement;
+    SkASSERT(uni.fUploadedOffset + words <= fUploadedValues.count());
+    uint32_t* uploaded = fUploadedValues.begin() + uni.fUploadedOffset;
+    const size_t size = words * sizeof(uint32_t);
+    if (arrayCount <= uni.fUploadedCount && 0 == memcmp(uploaded, values, size)) {
+        fGpu->stats()->incNumUniformUploads(false);
+        return false;
+    }
+    memcpy(uploaded, values, size);
+    uni.fUploadedCount = SkTMax(uni.fUploadedCount, arrayCount);
+    fGpu->stats()->incNumUniformUploads(true);
+    return true;
+}
+
 void GrGLProgramDataManager::setSamplerUniforms(const UniformInfoArray& samplers,
                                                 int startUnit) const {
     for (int i = 0; i < samplers.count(); ++i) {
@@ -65,7 +108,8 @@ void GrGLProgramDataManager::set1i(UniformHandle u, int32_t i) const {
     const Uniform& uni = fUniforms[u.toIndex()];
     SkASSERT(uni.fType == kInt_GrSLType || uni.fType == kShort_GrSLType);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    const int32_t v[] = {i};
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(uni, 1, v)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform1i(uni.fLocation, i));
     }
 }
@@ -77,7 +121,7 @@ void GrGLProgramDataManager::set1iv(UniformHandle u,
     SkASSERT(uni.fType == kInt_GrSLType || uni.fType == kShort_GrSLType);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(uni, arrayCount, v)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform1iv(uni.fLocation, arrayCount, v));
     }
 }
@@ -86,7 +130,8 @@ void GrGLProgramDataManager::set1f(UniformHandle u, float v0) const {
     const Uniform& uni = fUniforms[u.toIndex()];
     SkASSERT(uni.fType == kFloat_GrSLType || uni.fType == kHalf_GrSLType);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    const float v[] = {v0};
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(uni, 1, v)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform1f(uni.fLocation, v0));
     }
 }
@@ -102,7 +147,7 @@ void GrGLProgramDataManager::set1fv(UniformHandle u,
     // Once the uniform manager is responsible for inserting the duplicate uniform
     // arrays in VS and FS driver bug workaround, this can be enabled.
     // this->printUni(uni);
-    if (kUnusedUniform != uni.fLocation) {
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(uni, arrayCount, v)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform1fv(uni.fLocation, arrayCount, v));
     }
 }
@@ -111,7 +156,8 @@ void GrGLProgramDataManager::set2i(UniformHandle u, int32_t i0, int32_t i1) cons
     const Uniform& uni = fUniforms[u.toIndex()];
     SkASSERT(uni.fType == kInt2_GrSLType || uni.fType == kShort2_GrSLType);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    const int32_t v[] = {i0, i1};
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(uni, 1, v)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform2i(uni.fLocation, i0, i1));
     }
 }
@@ -123,7 +169,7 @@ void GrGLProgramDataManager::set2iv(UniformHandle u,
     SkASSERT(uni.fType == kInt2_GrSLType || uni.fType == kShort2_GrSLType);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(uni, arrayCount, v)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform2iv(uni.fLocation, arrayCount, v));
     }
 }
@@ -132,7 +178,8 @@ void GrGLProgramDataManager::set2f(UniformHandle u, float v0, float v1) const {
     const Uniform& uni = fUniforms[u.toIndex()];
     SkASSERT(uni.fType == kFloat2_GrSLType || uni.fType == kHalf2_GrSLType);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    const float v[] = {v0, v1};
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(uni, 1, v)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform2f(uni.fLocation, v0, v1));
     }
 }
@@ -144,7 +191,7 @@ void GrGLProgramDataManager::set2fv(UniformHandle u,
     SkASSERT(uni.fType == kFloat2_GrSLType || uni.fType == kHalf2_GrSLType);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(uni, arrayCount, v)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform2fv(uni.fLocation, arrayCount, v));
     }
 }
@@ -153,7 +200,8 @@ void GrGLProgramDataManager::set3i(UniformHandle u, int32_t i0, int32_t i1, int3
     const Uniform& uni = fUniforms[u.toIndex()];
     SkASSERT(uni.fType == kInt3_GrSLType || uni.fType == kShort3_GrSLType);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    const int32_t v[] = {i0, i1, i2};
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(uni, 1, v)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform3i(uni.fLocation, i0, i1, i2));
     }
 }
@@ -165,7 +213,7 @@ void GrGLProgramDataManager::set3iv(UniformHandle u,
     SkASSERT(uni.fType == kInt3_GrSLType || uni.fType == kShort3_GrSLType);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(uni, arrayCount, v)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform3iv(uni.fLocation, arrayCount, v));
     }
 }
@@ -174,7 +222,8 @@ void GrGLProgramDataManager::set3f(UniformHandle u, float v0, float v1, float v2
     const Uniform& uni = fUniforms[u.toIndex()];
     SkASSERT(uni.fType == kFloat3_GrSLType || uni.fType == kHalf3_GrSLType);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    const float v[] = {v0, v1, v2};
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(uni, 1, v)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform3f(uni.fLocation, v0, v1, v2));
     }
 }
@@ -186,7 +235,7 @@ void GrGLProgramDataManager::set3fv(UniformHandle u,
     SkASSERT(uni.fType == kFloat3_GrSLType || uni.fType == kHalf3_GrSLType);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(uni, arrayCount, v)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform3fv(uni.fLocation, arrayCount, v));
     }
 }
@@ -199,7 +248,8 @@ void GrGLProgramDataManager::set4i(UniformHandle u,
     const Uniform& uni = fUniforms[u.toIndex()];
     SkASSERT(uni.fType == kInt4_GrSLType || uni.fType == kShort4_GrSLType);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    const int32_t v[] = {i0, i1, i2, i3};
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(uni, 1, v)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform4i(uni.fLocation, i0, i1, i2, i3));
     }
 }
@@ -211,7 +261,7 @@ void GrGLProgramDataManager::set4iv(UniformHandle u,
     SkASSERT(uni.fType == kInt4_GrSLType || uni.fType == kShort4_GrSLType);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(uni, arrayCount, v)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform4iv(uni.fLocation, arrayCount, v));
     }
 }
@@ -224,7 +274,8 @@ void GrGLProgramDataManager::set4f(UniformHandle u,
     const Uniform& uni = fUniforms[u.toIndex()];
     SkASSERT(uni.fType == kFloat4_GrSLType || uni.fType == kHalf4_GrSLType);
     SkASSERT(GrShaderVar::kNonArray == uni.fArrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    const float v[] = {v0, v1, v2, v3};
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(uni, 1, v)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform4f(uni.fLocation, v0, v1, v2, v3));
     }
 }
@@ -236,7 +287,7 @@ void GrGLProgramDataManager::set4fv(UniformHandle u,
     SkASSERT(uni.fType == kFloat4_GrSLType || uni.fType == kHalf4_GrSLType);
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(uni, arrayCount, v)) {
         GR_GL_CALL(fGpu->glInterface(), Uniform4fv(uni.fLocation, arrayCount, v));
     }
 }
@@ -275,7 +326,7 @@ template<int N> inline void GrGLProgramDataManager::setMatrices(UniformHandle u,
              uni.fType == kHalf2x2_GrSLType + (N - 2));
     SkASSERT(arrayCount > 0);
     ASSERT_ARRAY_UPLOAD_IN_BOUNDS(uni, arrayCount);
-    if (kUnusedUniform != uni.fLocation) {
+    if (kUnusedUniform != uni.fLocation && this->needsUpload(uni, arrayCount, matrices)) {
         set_uniform_matrix<N>::set(fGpu->glInterface(), uni.fLocation, arrayCount, matrices);
     }
 }
@@ -86,6 +86,11 @@ private:
 
     struct Uniform {
         GrGLint     fLocation;
+        // Where the values last uploaded to the uniform start in fUploadedValues, how many 32 bit
+        // words each of its array elements takes, and how many elements have been uploaded.
+        int         fUploadedOffset;
+        int         fWordsPerElement;
+        mutable int fUploadedCount;
 #ifdef SK_DEBUG
         GrSLType    fType;
         int         fArrayCount;
@@ -106,8 +111,14 @@ private:
     template<int N> inline void setMatrices(UniformHandle, int arrayCount,
                                             const float matrices[]) const;
 
+    // The program keeps its uniform values between draws, so this returns false when the first
+    // arrayCount elements of the uniform already hold these values. Otherwise it records them
+    // and returns true.
+    bool needsUpload(const Uniform&, int arrayCount, const void* values) const;
+
     SkTArray<Uniform, true> fUniforms;
     SkTArray<PathProcVarying, true> fPathProcVaryings;
+    mutable SkTArray<uint32_t, true> fUploadedValues;
     GrGLGpu* fGpu;
     GrGLuint fProgramID;
 
@@ -38,7 +38,8 @@ GrGLProgram* GrGLProgramBuilder::CreateProgram(GrRenderTarget* renderTarget, GrS
                                                const GrTextureProxy* const primProcProxies[],
                                                const GrPipeline& pipeline,
                                                GrProgramDesc* desc,
-                                               GrGLGpu* gpu) {
+                                               GrGLGpu* gpu,
+                                               const GrGLPrecompiledProgram* precompiledProgram) {
     SkASSERT(!pipeline.isBad());
 
     ATRACE_ANDROID_FRAMEWORK("Shader Compile");
@@ -50,7 +51,7 @@ GrGLProgram* GrGLProgramBuilder::CreateProgram(GrRenderTarget* renderTarget, GrS
                                pipeline, primProc, primProcProxies, desc);
 
     auto persistentCache = gpu->getContext()->priv().getPersistentCache();
-    if (persistentCache) {
+    if (persistentCache && !precompiledProgram) {
         sk_sp<SkData> key = SkData::MakeWithoutCopy(desc->asKey(), desc->keyLength());
         builder.fCached = persistentCache->load(*key);
         // the eventual end goal is to completely skip emitAndInstallProcs on a cache hit, but it's
@@ -60,7 +61,7 @@ GrGLProgram* GrGLProgramBuilder::CreateProgram(GrRenderTarget* renderTarget, GrS
     if (!builder.emitAndInstallProcs()) {
         return nullptr;
     }
-    return builder.finalize();
+    return builder.finalize(precompiledProgram);
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -177,30 +178,56 @@ void GrGLProgramBuilder::storeShaderInCache(const SkSL::Program::Inputs& inputs,
             this->gpu()->getContext()->priv().getPersistentCache()->store(*key, *data);
         }
     } else {
-        // source cache
+        // source cache, plus the metadata PrecompileProgram() needs to link it. NVPR programs
+        // also need their fragment inputs bound, so those are never precompiled.
+        GrPersistentCacheUtils::ShaderMetadata meta;
+        const GrPrimitiveProcessor& primProc = this->primitiveProcessor();
+        for (const auto& attr : primProc.vertexAttributes()) {
+            meta.fAttributeNames.emplace_back(attr.name());
+        }
+        for (const auto& attr : primProc.instanceAttributes()) {
+            meta.fAttributeNames.emplace_back(attr.name());
+        }
+        meta.fHasCustomColorOutput = fFS.hasCustomColorOutput();
+        meta.fHasSecondaryColorOutput = fFS.hasSecondaryOutput();
+        bool canPrecompile = !isSkSL && !primProc.isPathRendering();
         auto data = GrPersistentCacheUtils::PackCachedShaders(isSkSL ? kSKSL_Tag : kGLSL_Tag,
-                                                              shaders, &inputs, 1);
+                                                              shaders, &inputs, 1,
+                                                              canPrecompile ? &meta : nullptr);
         this->gpu()->getContext()->priv().getPersistentCache()->store(*key, *data);
     }
 }
 
-GrGLProgram* GrGLProgramBuilder::finalize() {
+GrGLProgram* GrGLProgramBuilder::finalize(const GrGLPrecompiledProgram* precompiledProgram) {
     TRACE_EVENT0("skia", TRACE_FUNC);
 
     // verify we can get a program id
     GrGLuint programID;
-    GL_CALL_RET(programID, CreateProgram());
+    if (precompiledProgram) {
+        programID = precompiledProgram->fProgramID;
+    } else {
+        GL_CALL_RET(programID, CreateProgram());
+    }
     if (0 == programID) {
         return nullptr;
     }
 
-    if (this->gpu()->glCaps().programBinarySupport() &&
+    if (!precompiledProgram && this->gpu()->glCaps().programBinarySupport() &&
         this->gpu()->getContext()->priv().getPersistentCache()) {
         GL_CALL(ProgramParameteri(programID, GR_GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GR_GL_TRUE));
     }
 
     this->finalizeShaders();
 
+    if (precompiledProgram) {
+        // The program is already linked, with attributes bound in the same order that
+        // computeCountsAndStrides() assigns them. Uniforms were not bound, so look them up.
+        this->addInputVars(precompiledProgram->fInputs);
+        this->computeCountsAndStrides(programID, this->primitiveProcessor(), false);
+        this->resolveProgramResourceLocations(programID, true);
+        return this->createProgram(programID);
+    }
+
     // compile shaders and bind attributes / uniforms
     auto errorHandler = this->gpu()->getContext()->priv().getShaderErrorHandler();
     const GrPrimitiveProcessor& primProc = this->primitiveProcessor();
@@ -363,7 +390,7 @@ GrGLProgram* GrGLProgramBuilder::finalize() {
             }
         }
     }
-    this->resolveProgramResourceLocations(programID);
+    this->resolveProgramResourceLocations(programID, false);
 
     this->cleanupShaders(shadersToDelete);
     if (!cached) {
@@ -442,8 +469,8 @@ bool GrGLProgramBuilder::checkLinkStatus(GrGLuint programID,
     return SkToBool(linked);
 }
 
-void GrGLProgramBuilder::resolveProgramResourceLocations(GrGLuint programID) {
-    fUniformHandler.getUniformLocations(programID, fGpu->glCaps());
+void GrGLProgramBuilder::resolveProgramResourceLocations(GrGLuint programID, bool force) {
+    fUniformHandler.getUniformLocations(programID, fGpu->glCaps(), force);
 
     // handle NVPR separable varyings
     if (!fGpu->glCaps().shaderCaps()->pathRenderingSupport() ||
@@ -488,3 +515,110 @@ GrGLProgram* GrGLProgramBuilder::createProgram(GrGLuint programID) {
                            fVertexStride,
                            fInstanceStride);
 }
+
+static bool check_link_status(GrGLGpu* gpu, GrGLuint programID) {
+    GrGLint linked = GR_GL_INIT_ZERO;
+    GR_GL_CALL(gpu->glInterface(), GetProgramiv(programID, GR_GL_LINK_STATUS, &linked));
+    return SkToBool(linked);
+}
+
+bool GrGLProgramBuilder::PrecompileProgram(GrGLPrecompiledProgram* precompiledProgram,
+                                           GrGLGpu* gpu,
+                                           const SkData& cachedData) {
+    const GrGLInterface* gl = gpu->glInterface();
+    const GrGLCaps& caps = gpu->glCaps();
+
+    if (caps.programBinarySupport()) {
+        // The data must match what storeShaderInCache() writes for the binary cache.
+        SkReader32 reader(cachedData.data(), cachedData.size());
+        SkSL::Program::Inputs inputs;
+        if (!reader.isAvailable(sizeof(inputs) + sizeof(int32_t))) {
+            return false;
+        }
+        reader.read(&inputs, sizeof(inputs));
+        GrGLsizei length = reader.readInt();
+        if (length <= 0 || !reader.isAvailable(SkAlign4(length) + sizeof(uint32_t))) {
+            return false;
+        }
+        const void* binary = reader.skip(length);
+        GrGLenum binaryFormat = reader.readU32();
+
+        GrGLuint programID;
+        GR_GL_CALL_RET(gl, programID, CreateProgram());
+        if (0 == programID) {
+            return false;
+        }
+        GrGLClearErr(gl);
+        GR_GL_CALL_NOERRCHECK(gl, ProgramBinary(programID, binaryFormat,
+                                                const_cast<void*>(binary), length));
+        if (GR_GL_GET_ERROR(gl) != GR_GL_NO_ERROR || !check_link_status(gpu, programID)) {
+            GR_GL_CALL(gl, DeleteProgram(programID));
+            return false;
+        }
+        *precompiledProgram = GrGLPrecompiledProgram(programID, inputs);
+        return true;
+    }
+
+    SkSL::String glsl[kGrShaderTypeCount];
+    SkSL::Program::Inputs inputs;
+    GrPersistentCacheUtils::ShaderMetadata meta;
+    bool hasMeta = false;
+    if (kGLSL_Tag != GrPersistentCacheUtils::UnpackCachedShaders(&cachedData, glsl, &inputs, 1,
+                                                                 &meta, &hasMeta) ||
+        !hasMeta || glsl[kVertex_GrShaderType].empty() || glsl[kFragment_GrShaderType].empty()) {
+        return false;
+    }
+
+    GrGLuint programID;
+    GR_GL_CALL_RET(gl, programID, CreateProgram());
+    if (0 == programID) {
+        return false;
+    }
+
+    auto errorHandler = gpu->getContext()->priv().getShaderErrorHandler();
+    SkTDArray<GrGLuint> shadersToDelete;
+    auto cleanup = [&]() {
+        for (int i = 0; i < shadersToDelete.count(); ++i) {
+            GR_GL_CALL(gl, DeleteShader(shadersToDelete[i]));
+        }
+    };
+    static constexpr GrGLenum kShaderTypes[kGrShaderTypeCount] = {
+        GR_GL_VERTEX_SHADER, GR_GL_GEOMETRY_SHADER, GR_GL_FRAGMENT_SHADER,
+    };
+    for (int i = 0; i < kGrShaderTypeCount; ++i) {
+        if (glsl[i].empty()) {
+            continue;
+        }
+        GrGLuint shaderID = GrGLCompileAndAttachShader(gpu->glContext(), programID,
+                                                       kShaderTypes[i], glsl[i], gpu->stats(),
+                                                       errorHandler);
+        if (!shaderID) {
+            cleanup();
+            GR_GL_CALL(gl, DeleteProgram(programID));
+            return false;
+        }
+        *shadersToDelete.append() = shaderID;
+    }
+
+    // Bind everything the way computeCountsAndStrides() and bindProgramResourceLocations() would.
+    for (int i = 0; i < meta.fAttributeNames.count(); ++i) {
+        GR_GL_CALL(gl, BindAttribLocation(programID, i, meta.fAttributeNames[i].c_str()));
+    }
+    if (meta.fHasCustomColorOutput && caps.bindFragDataLocationSupport()) {
+        GR_GL_CALL(gl, BindFragDataLocation(programID, 0,
+                                          GrGLSLFragmentShaderBuilder::DeclaredColorOutputName()));
+    }
+    if (meta.fHasSecondaryColorOutput && caps.shaderCaps()->mustDeclareFragmentShaderOutput()) {
+        GR_GL_CALL(gl, BindFragDataLocationIndexed(programID, 0, 1,
+                                  GrGLSLFragmentShaderBuilder::DeclaredSecondaryColorOutputName()));
+    }
+
+    GR_GL_CALL(gl, LinkProgram(programID));
+    cleanup();
+    if (!check_link_status(gpu, programID)) {
+        GR_GL_CALL(gl, DeleteProgram(programID));
+        return false;
+    }
+    *precompiledProgram = GrGLPrecompiledProgram(programID, inputs);
+    return true;
+}
@@ -23,6 +23,19 @@ class GrProgramDesc;
 class GrGLSLShaderBuilder;
 class GrShaderCaps;
 
+// A program that has been compiled and linked from PersistentCache data by
+// GrGLProgramBuilder::PrecompileProgram(), but that has no GrGLProgram yet. The remaining setup
+// needs the processors, so it happens when the program is first used.
+struct GrGLPrecompiledProgram {
+    GrGLPrecompiledProgram(GrGLuint programID = 0,
+                           SkSL::Program::Inputs inputs = SkSL::Program::Inputs())
+        : fProgramID(programID)
+        , fInputs(inputs) {}
+
+    GrGLuint fProgramID;
+    SkSL::Program::Inputs fInputs;
+};
+
 class GrGLProgramBuilder : public GrGLSLProgramBuilder {
 public:
     /** Generates a shader program.
@@ -33,6 +46,8 @@ public:
      * This function may modify the GrProgramDesc by setting the surface origin
      * key to 0 (unspecified) if it turns out the program does not care about
      * the surface origin.
+     * If precompiledProgram is non-null, its already linked program is used instead of compiling
+     * a new one.
      * @return true if generation was successful.
      */
     static GrGLProgram* CreateProgram(GrRenderTarget*, GrSurfaceOrigin,
@@ -40,7 +55,15 @@ public:
                                       const GrTextureProxy* const primProcProxies[],
                                       const GrPipeline&,
                                       GrProgramDesc*,
-                                      GrGLGpu*);
+                                      GrGLGpu*,
+                                      const GrGLPrecompiledProgram* = nullptr);
+
+    /**
+     * Compiles and links a program from data that was stored in the PersistentCache, without the
+     * processors that generated it. Returns false if the data isn't usable by this context, e.g.
+     * GLSL stored without the metadata needed to link it.
+     */
+    static bool PrecompileProgram(GrGLPrecompiledProgram*, GrGLGpu*, const SkData&);
 
     const GrCaps* caps() const override;
 
@@ -63,11 +86,11 @@ private:
                                  bool bindAttribLocations);
     void storeShaderInCache(const SkSL::Program::Inputs& inputs, GrGLuint programID,
                             const SkSL::String shaders[], bool isSkSL);
-    GrGLProgram* finalize();
+    GrGLProgram* finalize(const GrGLPrecompiledProgram*);
     void bindProgramResourceLocations(GrGLuint programID);
     bool checkLinkStatus(GrGLuint programID, GrContextOptions::ShaderErrorHandler* errorHandler,
                          SkSL::String* sksl[], const SkSL::String glsl[]);
-    void resolveProgramResourceLocations(GrGLuint programID);
+    void resolveProgramResourceLocations(GrGLuint programID, bool force);
     void cleanupProgram(GrGLuint programID, const SkTDArray<GrGLuint>& shaderIDs);
     void cleanupShaders(const SkTDArray<GrGLuint>& shaderIDs);
 
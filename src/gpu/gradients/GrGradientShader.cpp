@@ -66,6 +66,37 @@ static std::unique_ptr<GrFragmentProcessor> make_textured_colorizer(const SkPMCo
     return GrTextureGradientColorizer::Make(std::move(proxy));
 }
 
+// The analytic colorizers compile to a different program for each shape below, where the
+// textured one is a single program. Unrolled binary colorizers take shapes 2 through 9, one for
+// each interval count they support.
+enum ColorizerShape {
+    kSingleInterval_ColorizerShape = 0,
+    kDualInterval_ColorizerShape = 1,
+    kFirstUnrolled_ColorizerShape = 2,
+};
+
+// Records that a gradient uses the analytic colorizer shape, unless it's new and the context has
+// already used GrContextOptions::fMaxGradientColorizerShapes of them. In that case the gradient
+// should use the textured colorizer.
+static bool use_colorizer_shape(int shape, const GrFPArgs& args) {
+    uint32_t* usedShapes = args.fContext->priv().gradientColorizerShapes();
+    const uint32_t bit = 1u << shape;
+    if (!(*usedShapes & bit)) {
+        int maxShapes = args.fContext->priv().options().fMaxGradientColorizerShapes;
+        if (maxShapes >= 0) {
+            int usedCount = 0;
+            for (uint32_t bits = *usedShapes; bits; bits &= bits - 1) {
+                usedCount++;
+            }
+            if (usedCount >= maxShapes) {
+                return false;
+            }
+        }
+        *usedShapes |= bit;
+    }
+    return true;
+}
+
 // Analyze the shader's color stops and positions and chooses an appropriate colorizer to represent
 // the gradient.
 static std::unique_ptr<GrFragmentProcessor> make_colorizer(const SkPMColor4f* colors,
@@ -91,14 +122,15 @@ static std::unique_ptr<GrFragmentProcessor> make_colorizer(const SkPMColor4f* co
 
     // Two remaining colors means a single interval from 0 to 1
     // (but it may have originally been a 3 or 4 color gradient with 1-2 hard stops at the ends)
-    if (count == 2) {
+    if (count == 2 && use_colorizer_shape(kSingleInterval_ColorizerShape, args)) {
         return GrSingleIntervalGradientColorizer::Make(colors[offset], colors[offset + 1]);
     }
 
     // Do an early test for the texture fallback to skip all of the other tests for specific
     // analytic support of the gradient (and compatibility with the hardware), when it's definitely
     // impossible to use an analytic solution.
-    bool tryAnalyticColorizer = count <= GrUnrolledBinaryGradientColorizer::kMaxColorCount;
+    bool tryAnalyticColorizer = count > 2 &&
+                                count <= GrUnrolledBinaryGradientColorizer::kMaxColorCount;
 
     // The remaining analytic colorizers use scale*t+bias, and the scale/bias values can become
     // quite large when thresholds are close (but still outside the hardstop limit). If float isn't
@@ -119,7 +151,12 @@ static std::unique_ptr<GrFragmentProcessor> make_colorizer(const SkPMColor4f* co
     }
 
     if (tryAnalyticColorizer) {
-        if (count == 3) {
+        const bool dualInterval = count == 3 ||
+                                  (count == 4 && SkScalarNearlyEqual(positions[offset + 1],
+                                                                     positions[offset + 2]));
+        if (dualInterval && !use_colorizer_shape(kDualInterval_ColorizerShape, args)) {
+            tryAnalyticColorizer = false;
+        } else if (count == 3) {
             // Must be a dual interval gradient, where the middle point is at offset+1 and the two
             // intervals share the middle color stop.
             return GrDualIntervalGradientColorizer::Make(colors[offset], colors[offset + 1],
@@ -136,10 +173,17 @@ static std::unique_ptr<GrFragmentProcessor> make_colorizer(const SkPMColor4f* co
         // The single and dual intervals are a specialized case of the unrolled binary search
         // colorizer which can analytically render gradients of up to 8 intervals (up to 9 or 16
         // colors depending on how many hard stops are inserted).
-        std::unique_ptr<GrFragmentProcessor> unrolled = GrUnrolledBinaryGradientColorizer::Make(
-                colors + offset, positions + offset, count);
-        if (unrolled) {
-            return unrolled;
+        if (tryAnalyticColorizer) {
+            std::unique_ptr<GrFragmentProcessor> unrolled =
+                    GrUnrolledBinaryGradientColorizer::Make(colors + offset, positions + offset,
+                                                            count);
+            if (unrolled) {
+                int intervalCount = static_cast<const GrUnrolledBinaryGradientColorizer*>(
+                        unrolled.get())->intervalCount;
+                if (use_colorizer_shape(kFirstUnrolled_ColorizerShape + intervalCount - 1, args)) {
+                    return unrolled;
+                }
+            }
         }
     }
 
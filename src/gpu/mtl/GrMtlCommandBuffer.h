@@ -26,17 +26,29 @@ public:
     id<MTLRenderCommandEncoder> getRenderCommandEncoder(MTLRenderPassDescriptor*,
                                                         const GrMtlPipelineState*);
 
+    // These bind to the active render command encoder, skipping the call when the encoder already
+    // has the same texture or sampler at that index from an earlier draw.
+    void setFragmentTexture(id<MTLTexture>, NSUInteger index);
+    void setFragmentSamplerState(id<MTLSamplerState>, NSUInteger index);
+
 private:
+    // Matches the shader caps' fMaxFragmentSamplers.
+    static constexpr NSUInteger kMaxFragmentBindings = 16;
+
     GrMtlCommandBuffer(id<MTLCommandBuffer> cmdBuffer)
         : fCmdBuffer(cmdBuffer)
         , fPreviousRenderPassDescriptor(nil) {}
 
     void endAllEncoding();
+    void resetFragmentBindings();
 
     id<MTLCommandBuffer>        fCmdBuffer;
     id<MTLBlitCommandEncoder>   fActiveBlitCommandEncoder;
     id<MTLRenderCommandEncoder> fActiveRenderCommandEncoder;
     MTLRenderPassDescriptor*    fPreviousRenderPassDescriptor;
+
+    id<MTLTexture>              fBoundFragmentTextures[kMaxFragmentBindings];
+    id<MTLSamplerState>         fBoundFragmentSamplers[kMaxFragmentBindings];
 };
 
 #endif
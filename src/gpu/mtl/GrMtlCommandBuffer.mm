@@ -33,6 +33,7 @@ id<MTLBlitCommandEncoder> GrMtlCommandBuffer::getBlitCommandEncoder() {
     if (nil != fActiveRenderCommandEncoder) {
         [fActiveRenderCommandEncoder endEncoding];
         fActiveRenderCommandEncoder = nil;
+        this->resetFragmentBindings();
     }
 
     if (nil == fActiveBlitCommandEncoder) {
@@ -83,6 +84,33 @@ id<MTLRenderCommandEncoder> GrMtlCommandBuffer::getRenderCommandEncoder(
     return fActiveRenderCommandEncoder;
 }
 
+void GrMtlCommandBuffer::setFragmentTexture(id<MTLTexture> texture, NSUInteger index) {
+    SkASSERT(nil != fActiveRenderCommandEncoder);
+    SkASSERT(index < kMaxFragmentBindings);
+    if (fBoundFragmentTextures[index] != texture) {
+        [fActiveRenderCommandEncoder setFragmentTexture: texture
+                                                atIndex: index];
+        fBoundFragmentTextures[index] = texture;
+    }
+}
+
+void GrMtlCommandBuffer::setFragmentSamplerState(id<MTLSamplerState> sampler, NSUInteger index) {
+    SkASSERT(nil != fActiveRenderCommandEncoder);
+    SkASSERT(index < kMaxFragmentBindings);
+    if (fBoundFragmentSamplers[index] != sampler) {
+        [fActiveRenderCommandEncoder setFragmentSamplerState: sampler
+                                                     atIndex: index];
+        fBoundFragmentSamplers[index] = sampler;
+    }
+}
+
+void GrMtlCommandBuffer::resetFragmentBindings() {
+    for (NSUInteger i = 0; i < kMaxFragmentBindings; ++i) {
+        fBoundFragmentTextures[i] = nil;
+        fBoundFragmentSamplers[i] = nil;
+    }
+}
+
 void GrMtlCommandBuffer::commit(bool waitUntilCompleted) {
     this->endAllEncoding();
     [fCmdBuffer commit];
@@ -103,6 +131,7 @@ void GrMtlCommandBuffer::endAllEncoding() {
     if (nil != fActiveRenderCommandEncoder) {
         [fActiveRenderCommandEncoder endEncoding];
         fActiveRenderCommandEncoder = nil;
+        this->resetFragmentBindings();
     }
     if (nil != fActiveBlitCommandEncoder) {
         [fActiveBlitCommandEncoder endEncoding];
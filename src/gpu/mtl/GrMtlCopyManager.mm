@@ -216,10 +216,8 @@ bool GrMtlCopyManager::copySurfaceAsDraw(GrSurface* dst, GrSurfaceOrigin dstOrig
     [renderCmdEncoder setVertexBytes: vertexUniformBuffer
                               length: sizeof(vertexUniformBuffer)
                              atIndex: kUniform_BufferIndex];
-    [renderCmdEncoder setFragmentTexture: srcTex
-                                 atIndex: 0];
-    [renderCmdEncoder setFragmentSamplerState: fSamplerState
-                                      atIndex: 0];
+    fGpu->commandBuffer()->setFragmentTexture(srcTex, 0);
+    fGpu->commandBuffer()->setFragmentSamplerState(fSamplerState, 0);
     [renderCmdEncoder drawPrimitives: MTLPrimitiveTypeTriangleStrip
                          vertexStart: 0
                          vertexCount: 4];
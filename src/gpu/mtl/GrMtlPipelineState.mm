@@ -17,6 +17,7 @@
 #include "src/gpu/glsl/GrGLSLGeometryProcessor.h"
 #include "src/gpu/glsl/GrGLSLXferProcessor.h"
 #include "src/gpu/mtl/GrMtlBuffer.h"
+#include "src/gpu/mtl/GrMtlCommandBuffer.h"
 #include "src/gpu/mtl/GrMtlGpu.h"
 #include "src/gpu/mtl/GrMtlTexture.h"
 
@@ -124,11 +125,12 @@ void GrMtlPipelineState::bind(id<MTLRenderCommandEncoder> renderCmdEncoder) {
     fDataManager.uploadAndBindUniformBuffers(fGpu, renderCmdEncoder);
 
     SkASSERT(fNumSamplers == fSamplerBindings.count());
+    // Consecutive draws often sample the same textures (e.g. the atlas), so let the command
+    // buffer drop the bindings the encoder already has.
+    GrMtlCommandBuffer* cmdBuffer = fGpu->commandBuffer();
     for (int index = 0; index < fNumSamplers; ++index) {
-        [renderCmdEncoder setFragmentTexture: fSamplerBindings[index].fTexture
-                                     atIndex: index];
-        [renderCmdEncoder setFragmentSamplerState: fSamplerBindings[index].fSampler->mtlSampler()
-                                          atIndex: index];
+        cmdBuffer->setFragmentTexture(fSamplerBindings[index].fTexture, index);
+        cmdBuffer->setFragmentSamplerState(fSamplerBindings[index].fSampler->mtlSampler(), index);
     }
 }
 
@@ -7,6 +7,7 @@
 
 #include "src/gpu/mtl/GrMtlResourceProvider.h"
 
+#include "src/core/SkPerfCounters.h"
 #include "src/gpu/mtl/GrMtlCommandBuffer.h"
 #include "src/gpu/mtl/GrMtlCopyManager.h"
 #include "src/gpu/mtl/GrMtlGpu.h"
@@ -168,6 +169,7 @@ GrMtlPipelineState* GrMtlResourceProvider::PipelineStateCache::refPipelineState(
 #ifdef GR_PIPELINE_STATE_CACHE_STATS
         ++fCacheMisses;
 #endif
+        SkPerfCounters::Add(SkGraphics::PerfCounter::kGpuProgramCacheMisses);
         GrMtlPipelineState* pipelineState(GrMtlPipelineStateBuilder::CreatePipelineState(
                 fGpu, renderTarget, origin, primProc, primProcProxies, pipeline, &desc));
         if (nullptr == pipelineState) {
@@ -14,6 +14,8 @@ class GrAAConvexPathRenderer : public GrPathRenderer {
 public:
     GrAAConvexPathRenderer();
 
+    const char* name() const override { return "aaconvex"; }
+
 private:
     CanDrawPath onCanDrawPath(const CanDrawPathArgs&) const override;
 
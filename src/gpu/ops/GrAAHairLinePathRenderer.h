@@ -14,6 +14,8 @@ class GrAAHairLinePathRenderer : public GrPathRenderer {
 public:
     GrAAHairLinePathRenderer() {}
 
+    const char* name() const override { return "aahairline"; }
+
     typedef SkTArray<SkPoint, true> PtArray;
     typedef SkTArray<int, true> IntArray;
     typedef SkTArray<float, true> FloatArray;
@@ -14,6 +14,8 @@ class GrAALinearizingConvexPathRenderer : public GrPathRenderer {
 public:
     GrAALinearizingConvexPathRenderer();
 
+    const char* name() const override { return "aalinearizing"; }
+
 private:
     CanDrawPath onCanDrawPath(const CanDrawPathArgs&) const override;
 
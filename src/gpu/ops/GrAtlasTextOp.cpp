@@ -310,6 +310,25 @@ void GrAtlasTextOp::onPrepareDraws(Target* target) {
     flushInfo.fFixedDynamicState = fixedDynamicState;
 
     bool vmPerspective = fGeoData[0].fViewMatrix.hasPerspective();
+
+    // Bitmap text that has only moved since its vertices were generated can be drawn from them
+    // as is, with the offset applied in the vertex shader. Every geometry must share the offset,
+    // and clipping the quads against a clip rect has to happen at their final position.
+    bool translateOnGpu = !this->usesDistanceFields() && !fNeedsGlyphTransform && !vmPerspective;
+    SkVector translate = {0, 0};
+    for (int i = 0; i < fGeoCount && translateOnGpu; i++) {
+        const Geometry& args = fGeoData[i];
+        SkVector geoTranslate = args.fBlob->subRunTranslation(args.fRun, args.fSubRun,
+                                                              args.fViewMatrix, args.fX, args.fY);
+        if (!args.fClipRect.isEmpty() || (i > 0 && geoTranslate != translate)) {
+            translateOnGpu = false;
+        }
+        translate = geoTranslate;
+    }
+    if (!translateOnGpu) {
+        translate = {0, 0};
+    }
+
     if (this->usesDistanceFields()) {
         flushInfo.fGeometryProcessor = this->setupDfProcessor(*target->caps().shaderCaps(),
                                                               proxies, numActiveProxies);
@@ -318,7 +337,7 @@ void GrAtlasTextOp::onPrepareDraws(Target* target) {
                                                            : GrSamplerState::ClampNearest();
         flushInfo.fGeometryProcessor = GrBitmapTextGeoProc::Make(
             *target->caps().shaderCaps(), this->color(), false, proxies, numActiveProxies,
-            samplerState, maskFormat, localMatrix, vmPerspective);
+            samplerState, maskFormat, localMatrix, vmPerspective, translate);
     }
 
     flushInfo.fGlyphsToFlush = 0;
@@ -345,7 +364,7 @@ void GrAtlasTextOp::onPrepareDraws(Target* target) {
         GrTextBlob::VertexRegenerator regenerator(
                 resourceProvider, blob, args.fRun, args.fSubRun, args.fViewMatrix, args.fX, args.fY,
                 args.fColor.toBytes_RGBA(), target->deferredUploadTarget(), glyphCache,
-                atlasManager, &autoGlyphCache);
+                atlasManager, &autoGlyphCache, translateOnGpu);
         bool done = false;
         while (!done) {
             GrTextBlob::VertexRegenerator::Result result;
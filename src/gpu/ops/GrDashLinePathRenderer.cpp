@@ -15,17 +15,24 @@
 
 GrPathRenderer::CanDrawPath
 GrDashLinePathRenderer::onCanDrawPath(const CanDrawPathArgs& args) const {
+    if (!args.fShape->style().isDashed()) {
+        return CanDrawPath::kNo;
+    }
+    if (args.fAATypeFlags == AATypeFlags::kMixedSampledStencilThenCover) {
+        return CanDrawPath::kNo;
+    }
     SkPoint pts[2];
     bool inverted;
-    if (args.fShape->style().isDashed() && args.fShape->asLine(pts, &inverted)) {
-        if (args.fAATypeFlags == AATypeFlags::kMixedSampledStencilThenCover) {
-            return CanDrawPath::kNo;
-        }
+    if (args.fShape->asLine(pts, &inverted)) {
         // We should never have an inverse dashed case.
         SkASSERT(!inverted);
-        if (!GrDashOp::CanDrawDashLine(pts, args.fShape->style(), *args.fViewMatrix)) {
-            return CanDrawPath::kNo;
+        if (GrDashOp::CanDrawDashLine(pts, args.fShape->style(), *args.fViewMatrix)) {
+            return CanDrawPath::kYes;
         }
+    }
+    SkPath path;
+    args.fShape->asPath(&path);
+    if (GrDashOp::CanDrawDashPolyline(path, args.fShape->style(), *args.fViewMatrix)) {
         return CanDrawPath::kYes;
     }
     return CanDrawPath::kNo;
@@ -45,11 +52,20 @@ bool GrDashLinePathRenderer::onDrawPath(const DrawPathArgs& args) {
             aaMode = GrDashOp::AAMode::kCoverage;
         }
     }
+    std::unique_ptr<GrDrawOp> op;
     SkPoint pts[2];
-    SkAssertResult(args.fShape->asLine(pts, nullptr));
-    std::unique_ptr<GrDrawOp> op =
-            GrDashOp::MakeDashLineOp(args.fContext, std::move(args.fPaint), *args.fViewMatrix, pts,
-                                     aaMode, args.fShape->style(), args.fUserStencilSettings);
+    if (args.fShape->asLine(pts, nullptr) &&
+        GrDashOp::CanDrawDashLine(pts, args.fShape->style(), *args.fViewMatrix)) {
+        op = GrDashOp::MakeDashLineOp(args.fContext, std::move(args.fPaint), *args.fViewMatrix,
+                                      pts, aaMode, args.fShape->style(),
+                                      args.fUserStencilSettings);
+    } else {
+        SkPath path;
+        args.fShape->asPath(&path);
+        op = GrDashOp::MakeDashPolylineOp(args.fContext, std::move(args.fPaint),
+                                          *args.fViewMatrix, path, aaMode, args.fShape->style(),
+                                          args.fUserStencilSettings);
+    }
     if (!op) {
         return false;
     }
@@ -13,6 +13,9 @@
 class GrGpu;
 
 class GrDashLinePathRenderer : public GrPathRenderer {
+public:
+    const char* name() const override { return "dashline"; }
+
 private:
     CanDrawPath onCanDrawPath(const CanDrawPathArgs&) const override;
 
@@ -6,6 +6,8 @@
  */
 
 #include "include/private/GrRecordingContext.h"
+#include "include/private/SkTDArray.h"
+#include "src/core/SkGeometry.h"
 #include "src/core/SkMatrixPriv.h"
 #include "src/core/SkPointPriv.h"
 #include "src/gpu/GrAppliedClip.h"
@@ -16,6 +18,7 @@
 #include "src/gpu/GrGeometryProcessor.h"
 #include "src/gpu/GrMemoryPool.h"
 #include "src/gpu/GrOpFlushState.h"
+#include "src/gpu/GrPathUtils.h"
 #include "src/gpu/GrProcessor.h"
 #include "src/gpu/GrQuad.h"
 #include "src/gpu/GrRecordingContextPriv.h"
@@ -1196,6 +1199,651 @@ static sk_sp<GrGeometryProcessor> make_dash_gp(const SkPMColor4f& color,
     return nullptr;
 }
 
+//////////////////////////////////////////////////////////////////////////////
+
+class GLDashingPolylineEffect;
+
+/*
+ * This effect draws a dashed polyline, one quad per segment. Every vertex carries its distance
+ * along the contour ("dash position", in device space, shifted right by half the off interval like
+ * the other dash effects) and its signed distance from the segment's center line. The fragment
+ * shader wraps the dash position into one interval to find the dash it falls in, and clips the
+ * coverage to the ends of the contour so segment quads that overhang its ends draw nothing.
+ */
+class DashingPolylineEffect : public GrGeometryProcessor {
+public:
+    static sk_sp<GrGeometryProcessor> Make(const SkPMColor4f&,
+                                           AAMode aaMode,
+                                           const SkMatrix& localMatrix,
+                                           bool usesLocalCoords);
+
+    const char* name() const override { return "DashingPolylineEffect"; }
+
+    AAMode aaMode() const { return fAAMode; }
+
+    const SkPMColor4f& color() const { return fColor; }
+
+    const SkMatrix& localMatrix() const { return fLocalMatrix; }
+
+    bool usesLocalCoords() const { return fUsesLocalCoords; }
+
+    void getGLSLProcessorKey(const GrShaderCaps& caps, GrProcessorKeyBuilder* b) const override;
+
+    GrGLSLPrimitiveProcessor* createGLSLInstance(const GrShaderCaps&) const override;
+
+private:
+    DashingPolylineEffect(const SkPMColor4f&, AAMode aaMode, const SkMatrix& localMatrix,
+                          bool usesLocalCoords);
+
+    SkPMColor4f         fColor;
+    SkMatrix            fLocalMatrix;
+    bool                fUsesLocalCoords;
+    AAMode              fAAMode;
+
+    Attribute fInPosition;
+    Attribute fInDashParams;
+    Attribute fInDashInfo;
+
+    GR_DECLARE_GEOMETRY_PROCESSOR_TEST
+
+    friend class GLDashingPolylineEffect;
+
+    typedef GrGeometryProcessor INHERITED;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+class GLDashingPolylineEffect : public GrGLSLGeometryProcessor {
+public:
+    GLDashingPolylineEffect() : fColor(SK_PMColor4fILLEGAL) {}
+
+    void onEmitCode(EmitArgs&, GrGPArgs*) override;
+
+    static inline void GenKey(const GrGeometryProcessor&,
+                              const GrShaderCaps&,
+                              GrProcessorKeyBuilder*);
+
+    void setData(const GrGLSLProgramDataManager&, const GrPrimitiveProcessor&,
+                 FPCoordTransformIter&& iter) override;
+
+private:
+    SkPMColor4f   fColor;
+    UniformHandle fColorUniform;
+    typedef GrGLSLGeometryProcessor INHERITED;
+};
+
+void GLDashingPolylineEffect::onEmitCode(EmitArgs& args, GrGPArgs* gpArgs) {
+    const DashingPolylineEffect& de = args.fGP.cast<DashingPolylineEffect>();
+
+    GrGLSLVertexBuilder* vertBuilder = args.fVertBuilder;
+    GrGLSLVaryingHandler* varyingHandler = args.fVaryingHandler;
+    GrGLSLUniformHandler* uniformHandler = args.fUniformHandler;
+
+    // emit attributes
+    varyingHandler->emitAttributes(de);
+
+    // X is the dash position, Y the distance from the center line, and ZW the dash positions of
+    // the start and end of the contour.
+    GrGLSLVarying dashParams(kFloat4_GrSLType);
+    varyingHandler->addVarying("DashParams", &dashParams);
+    vertBuilder->codeAppendf("%s = %s;", dashParams.vsOut(), de.fInDashParams.name());
+
+    // X is the interval length, Y half the off interval, Z the on interval and W half the stroke
+    // width.
+    GrGLSLVarying dashInfo(kFloat4_GrSLType);
+    varyingHandler->addVarying("DashInfo", &dashInfo);
+    vertBuilder->codeAppendf("%s = %s;", dashInfo.vsOut(), de.fInDashInfo.name());
+
+    GrGLSLFPFragmentBuilder* fragBuilder = args.fFragBuilder;
+    // Setup pass through color
+    this->setupUniformColor(fragBuilder, uniformHandler, args.fOutputColor, &fColorUniform);
+
+    // Setup position
+    this->writeOutputPosition(vertBuilder, gpArgs, de.fInPosition.name());
+
+    // emit transforms
+    this->emitTransforms(vertBuilder,
+                         varyingHandler,
+                         uniformHandler,
+                         de.fInPosition.asShaderVar(),
+                         de.localMatrix(),
+                         args.fFPCoordTransformHandler);
+
+    const char* params = dashParams.fsIn();
+    const char* info = dashInfo.fsIn();
+    fragBuilder->codeAppendf("float xShifted = %s.x - floor(%s.x / %s.x) * %s.x;",
+                             params, params, info, info);
+    if (de.aaMode() == AAMode::kNone) {
+        // Assuming the bounding geometry is tight so no need to check y values
+        fragBuilder->codeAppendf("half alpha = 1.0;");
+        fragBuilder->codeAppendf("alpha *= (xShifted - %s.y) > 0.0 ? 1.0 : 0.0;", info);
+        fragBuilder->codeAppendf("alpha *= (%s.y + %s.z - xShifted) >= 0.0 ? 1.0 : 0.0;",
+                                 info, info);
+        fragBuilder->codeAppendf("alpha *= (%s.x - %s.z) > 0.0 ? 1.0 : 0.0;", params, params);
+        fragBuilder->codeAppendf("alpha *= (%s.w - %s.x) >= 0.0 ? 1.0 : 0.0;", params, params);
+    } else {
+        // The coverage removed along the line by the ends of the dash and of the contour, as a
+        // negative number.
+        fragBuilder->codeAppendf("half xSub = half(min(xShifted - (%s.y + 0.5), 0.0));", info);
+        fragBuilder->codeAppendf("xSub += half(min((%s.y + %s.z - 0.5) - xShifted, 0.0));",
+                                 info, info);
+        fragBuilder->codeAppendf("xSub += half(min(%s.x - (%s.z + 0.5), 0.0));", params, params);
+        fragBuilder->codeAppendf("xSub += half(min((%s.w - 0.5) - %s.x, 0.0));", params, params);
+        if (de.aaMode() == AAMode::kCoverage) {
+            fragBuilder->codeAppendf("half ySub = half(min((%s.w - 0.5) - abs(%s.y), 0.0));",
+                                     info, params);
+            fragBuilder->codeAppend(
+                    "half alpha = (1.0 + max(xSub, -1.0)) * (1.0 + max(ySub, -1.0));");
+        } else {
+            // MSAA handles the sides of the line, the shader only does the ends of the dashes.
+            fragBuilder->codeAppend("half alpha = 1.0 + max(xSub, -1.0);");
+        }
+    }
+    fragBuilder->codeAppendf("%s = half4(alpha);", args.fOutputCoverage);
+}
+
+void GLDashingPolylineEffect::setData(const GrGLSLProgramDataManager& pdman,
+                                      const GrPrimitiveProcessor& processor,
+                                      FPCoordTransformIter&& transformIter) {
+    const DashingPolylineEffect& de = processor.cast<DashingPolylineEffect>();
+    if (de.color() != fColor) {
+        pdman.set4fv(fColorUniform, 1, de.color().vec());
+        fColor = de.color();
+    }
+    this->setTransformDataHelper(de.localMatrix(), pdman, &transformIter);
+}
+
+void GLDashingPolylineEffect::GenKey(const GrGeometryProcessor& gp,
+                                     const GrShaderCaps&,
+                                     GrProcessorKeyBuilder* b) {
+    const DashingPolylineEffect& de = gp.cast<DashingPolylineEffect>();
+    uint32_t key = 0;
+    key |= de.usesLocalCoords() && de.localMatrix().hasPerspective() ? 0x1 : 0x0;
+    key |= static_cast<int>(de.aaMode()) << 8;
+    b->add32(key);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+sk_sp<GrGeometryProcessor> DashingPolylineEffect::Make(const SkPMColor4f& color,
+                                                       AAMode aaMode,
+                                                       const SkMatrix& localMatrix,
+                                                       bool usesLocalCoords) {
+    return sk_sp<GrGeometryProcessor>(
+        new DashingPolylineEffect(color, aaMode, localMatrix, usesLocalCoords));
+}
+
+void DashingPolylineEffect::getGLSLProcessorKey(const GrShaderCaps& caps,
+                                                GrProcessorKeyBuilder* b) const {
+    GLDashingPolylineEffect::GenKey(*this, caps, b);
+}
+
+GrGLSLPrimitiveProcessor* DashingPolylineEffect::createGLSLInstance(const GrShaderCaps&) const {
+    return new GLDashingPolylineEffect();
+}
+
+DashingPolylineEffect::DashingPolylineEffect(const SkPMColor4f& color,
+                                             AAMode aaMode,
+                                             const SkMatrix& localMatrix,
+                                             bool usesLocalCoords)
+    : INHERITED(kDashingPolylineEffect_ClassID)
+    , fColor(color)
+    , fLocalMatrix(localMatrix)
+    , fUsesLocalCoords(usesLocalCoords)
+    , fAAMode(aaMode) {
+    fInPosition = {"inPosition", kFloat2_GrVertexAttribType, kFloat2_GrSLType};
+    fInDashParams = {"inDashParams", kFloat4_GrVertexAttribType, kFloat4_GrSLType};
+    fInDashInfo = {"inDashInfo", kFloat4_GrVertexAttribType, kFloat4_GrSLType};
+    this->setVertexAttributes(&fInPosition, 3);
+}
+
+GR_DEFINE_GEOMETRY_PROCESSOR_TEST(DashingPolylineEffect);
+
+#if GR_TEST_UTILS
+sk_sp<GrGeometryProcessor> DashingPolylineEffect::TestCreate(GrProcessorTestData* d) {
+    AAMode aaMode = static_cast<AAMode>(d->fRandom->nextULessThan(GrDashOp::kAAModeCnt));
+    return DashingPolylineEffect::Make(SkPMColor4f::FromBytes_RGBA(GrRandomColor(d->fRandom)),
+                                       aaMode, GrTest::TestMatrix(d->fRandom),
+                                       d->fRandom->nextBool());
+}
+
+#endif
+//////////////////////////////////////////////////////////////////////////////
+
+// Thicker strokes need real joins, which overlapping segment quads can't draw without blending
+// twice where they overlap.
+static constexpr SkScalar kMaxPolylineDevStrokeWidth = 2;
+
+bool GrDashOp::CanDrawDashPolyline(const SkPath& path, const GrStyle& style,
+                                   const SkMatrix& viewMatrix) {
+    if (path.isInverseFillType() || !path.isFinite()) {
+        return false;
+    }
+
+    // The dash intervals are measured along the path in device space, so every direction has to
+    // scale the same.
+    if (!viewMatrix.isSimilarity()) {
+        return false;
+    }
+
+    if (!style.isDashed() || 2 != style.dashIntervalCnt()) {
+        return false;
+    }
+    const SkStrokeRec& rec = style.strokeRec();
+    if (SkStrokeRec::kStroke_Style != rec.getStyle() &&
+        SkStrokeRec::kHairline_Style != rec.getStyle()) {
+        return false;
+    }
+
+    const SkScalar* intervals = style.dashIntervals();
+    if (intervals[0] <= 0) {
+        return false;
+    }
+
+    SkScalar scale = viewMatrix.getMaxScale();
+    SkScalar devStrokeWidth = rec.getWidth() * scale;
+    if (devStrokeWidth > kMaxPolylineDevStrokeWidth) {
+        return false;
+    }
+
+    SkPaint::Cap cap = rec.getCap();
+    if (SkPaint::kRound_Cap == cap) {
+        return false;
+    }
+    // Square caps grow each dash into the off interval; once they swallow it we'd be drawing a
+    // plain stroke.
+    if (SkPaint::kSquare_Cap == cap && intervals[1] * scale <= SkTMax(devStrokeWidth, 1.f)) {
+        return false;
+    }
+    return true;
+}
+
+class DashPolylineOp final : public GrMeshDrawOp {
+public:
+    DEFINE_OP_CLASS_ID
+
+    struct PathData {
+        SkPath   fPath;
+        SkMatrix fViewMatrix;
+        // Everything below is in device space.
+        SkScalar fIntervals[2];
+        SkScalar fPhase;
+        SkScalar fStrokeWidth;
+        SkScalar fCapLength;
+    };
+
+    static std::unique_ptr<GrDrawOp> Make(GrRecordingContext* context,
+                                          GrPaint&& paint,
+                                          const PathData& pathData,
+                                          AAMode aaMode,
+                                          const GrUserStencilSettings* stencilSettings) {
+        GrOpMemoryPool* pool = context->priv().opMemoryPool();
+
+        return pool->allocate<DashPolylineOp>(std::move(paint), pathData, aaMode,
+                                              stencilSettings);
+    }
+
+    const char* name() const override { return "DashPolylineOp"; }
+
+    void visitProxies(const VisitProxyFunc& func) const override {
+        fProcessorSet.visitProxies(func);
+    }
+
+#ifdef SK_DEBUG
+    SkString dumpInfo() const override {
+        SkString string;
+        for (const auto& geo : fPaths) {
+            string.appendf("Verbs: %d, Width: %.2f, Ival0: %.2f, Ival1 : %.2f, Phase: %.2f\n",
+                           geo.fPath.countVerbs(), geo.fStrokeWidth, geo.fIntervals[0],
+                           geo.fIntervals[1], geo.fPhase);
+        }
+        string += fProcessorSet.dumpProcessors();
+        string += INHERITED::dumpInfo();
+        return string;
+    }
+#endif
+
+    FixedFunctionFlags fixedFunctionFlags() const override {
+        FixedFunctionFlags flags = FixedFunctionFlags::kNone;
+        if (AAMode::kCoverageWithMSAA == fAAMode) {
+            flags |= FixedFunctionFlags::kUsesHWAA;
+        }
+        if (fStencilSettings != &GrUserStencilSettings::kUnused) {
+            flags |= FixedFunctionFlags::kUsesStencil;
+        }
+        return flags;
+    }
+
+    GrProcessorSet::Analysis finalize(
+            const GrCaps& caps, const GrAppliedClip* clip, GrFSAAType fsaaType,
+            GrClampType clampType) override {
+        GrProcessorAnalysisCoverage coverage;
+        if (AAMode::kNone == fAAMode && !clip->numClipCoverageFragmentProcessors()) {
+            coverage = GrProcessorAnalysisCoverage::kNone;
+        } else {
+            coverage = GrProcessorAnalysisCoverage::kSingleChannel;
+        }
+        auto analysis = fProcessorSet.finalize(
+                fColor, coverage, clip, fStencilSettings, fsaaType, caps, clampType, &fColor);
+        fUsesLocalCoords = analysis.usesLocalCoords();
+        return analysis;
+    }
+
+private:
+    friend class GrOpMemoryPool; // for ctor
+
+    DashPolylineOp(GrPaint&& paint, const PathData& pathData, AAMode aaMode,
+                   const GrUserStencilSettings* stencilSettings)
+            : INHERITED(ClassID())
+            , fColor(paint.getColor4f())
+            , fAAMode(aaMode)
+            , fProcessorSet(std::move(paint))
+            , fStencilSettings(stencilSettings) {
+        fPaths.push_back(pathData);
+
+        // A segment's quad reaches at most its half width plus bloat past any point of the
+        // segment, in both directions at a corner.
+        SkRect bounds = pathData.fViewMatrix.mapRect(pathData.fPath.getBounds());
+        SkScalar outset = 0.5f * SkTMax(pathData.fStrokeWidth, 1.f) + pathData.fCapLength + 0.5f;
+        bounds.outset(outset * SK_ScalarSqrt2, outset * SK_ScalarSqrt2);
+        HasAABloat aaBloat = (aaMode == AAMode::kNone) ? HasAABloat::kNo : HasAABloat::kYes;
+        this->setBounds(bounds, aaBloat, IsZeroArea::kNo);
+    }
+
+    struct Contour {
+        int  fStart;
+        int  fCount;
+        bool fClosed;
+    };
+
+    // Flattens 'path' into device space polylines, appending their points to 'pts'.
+    static void Flatten(const SkPath& path, const SkMatrix& viewMatrix, SkTDArray<SkPoint>* pts,
+                        SkTDArray<Contour>* contours) {
+        static const SkScalar kTolerance = GrPathUtils::kDefaultTolerance;
+        static const SkScalar kToleranceSqd = kTolerance * kTolerance;
+
+        auto finishContour = [&](bool closed) {
+            if (contours->isEmpty() || contours->top().fCount >= 0) {
+                return;
+            }
+            Contour& contour = contours->top();
+            if (closed && pts->top() != (*pts)[contour.fStart]) {
+                pts->push_back((*pts)[contour.fStart]);
+            }
+            contour.fCount = pts->count() - contour.fStart;
+            contour.fClosed = closed;
+            if (contour.fCount < 2) {
+                pts->setCount(contour.fStart);
+                contours->pop();
+            }
+        };
+
+        SkPath::Iter iter(path, false);
+        SkPoint verbPts[4];
+        SkPath::Verb verb;
+        while ((verb = iter.next(verbPts, false)) != SkPath::kDone_Verb) {
+            switch (verb) {
+                case SkPath::kMove_Verb:
+                    finishContour(false);
+                    viewMatrix.mapPoints(verbPts, 1);
+                    contours->push_back({pts->count(), -1, false});
+                    pts->push_back(verbPts[0]);
+                    break;
+                case SkPath::kLine_Verb:
+                    viewMatrix.mapPoints(verbPts, 2);
+                    pts->push_back(verbPts[1]);
+                    break;
+                case SkPath::kQuad_Verb: {
+                    viewMatrix.mapPoints(verbPts, 3);
+                    uint32_t maxCount = GrPathUtils::quadraticPointCount(verbPts, kTolerance);
+                    SkPoint* target = pts->append(maxCount);
+                    uint32_t count = GrPathUtils::generateQuadraticPoints(
+                            verbPts[0], verbPts[1], verbPts[2], kToleranceSqd, &target, maxCount);
+                    pts->setCount(pts->count() - maxCount + count);
+                    break;
+                }
+                case SkPath::kConic_Verb: {
+                    viewMatrix.mapPoints(verbPts, 3);
+                    SkAutoConicToQuads quadder;
+                    const SkPoint* quads = quadder.computeQuads(verbPts, iter.conicWeight(),
+                                                                kTolerance);
+                    for (int i = 0; i < quadder.countQuads(); ++i, quads += 2) {
+                        uint32_t maxCount = GrPathUtils::quadraticPointCount(quads, kTolerance);
+                        SkPoint* target = pts->append(maxCount);
+                        uint32_t count = GrPathUtils::generateQuadraticPoints(
+                                quads[0], quads[1], quads[2], kToleranceSqd, &target, maxCount);
+                        pts->setCount(pts->count() - maxCount + count);
+                    }
+                    break;
+                }
+                case SkPath::kCubic_Verb: {
+                    viewMatrix.mapPoints(verbPts, 4);
+                    uint32_t maxCount = GrPathUtils::cubicPointCount(verbPts, kTolerance);
+                    SkPoint* target = pts->append(maxCount);
+                    uint32_t count = GrPathUtils::generateCubicPoints(
+                            verbPts[0], verbPts[1], verbPts[2], verbPts[3], kToleranceSqd,
+                            &target, maxCount);
+                    pts->setCount(pts->count() - maxCount + count);
+                    break;
+                }
+                case SkPath::kClose_Verb:
+                    finishContour(true);
+                    break;
+                case SkPath::kDone_Verb:
+                    break;
+            }
+        }
+        finishContour(false);
+    }
+
+    // How far a segment's quad has to reach past a corner, along the segment, to cover the
+    // outside of the turn from 'dir0' to 'dir1': halfWidth * tan(turn / 2), with square corners
+    // for turns of 90 degrees or more.
+    static SkScalar CornerExtension(const SkVector& dir0, const SkVector& dir1,
+                                    SkScalar halfWidth) {
+        SkScalar cosTurn = SkPoint::DotProduct(dir0, dir1);
+        if (cosTurn <= 0) {
+            return halfWidth;
+        }
+        return halfWidth * SkScalarSqrt((1 - cosTurn) / (1 + cosTurn));
+    }
+
+    void onPrepareDraws(Target* target) override {
+        SkMatrix invert;
+        if (fUsesLocalCoords && !this->viewMatrix().invert(&invert)) {
+            SkDebugf("Failed to invert\n");
+            return;
+        }
+        sk_sp<GrGeometryProcessor> gp = DashingPolylineEffect::Make(
+                this->color(), this->aaMode(), invert, fUsesLocalCoords);
+
+        SkTDArray<SkPoint> pts;
+        SkTDArray<Contour> contours;
+        SkTDArray<int> firstContour;
+        for (const PathData& geo : fPaths) {
+            firstContour.push_back(contours.count());
+            Flatten(geo.fPath, geo.fViewMatrix, &pts, &contours);
+        }
+        firstContour.push_back(contours.count());
+
+        // Drop zero length segments so every remaining one has a direction.
+        int segmentCount = 0;
+        for (Contour& contour : contours) {
+            int end = contour.fStart + contour.fCount;
+            int last = contour.fStart;
+            for (int i = contour.fStart + 1; i < end; ++i) {
+                if (pts[i] != pts[last]) {
+                    pts[++last] = pts[i];
+                }
+            }
+            contour.fCount = last - contour.fStart + 1;
+            segmentCount += contour.fCount - 1;
+        }
+        if (!segmentCount) {
+            return;
+        }
+
+        QuadHelper helper(target, gp->vertexStride(), segmentCount);
+        GrVertexWriter vertices{ helper.vertices() };
+        if (!vertices.fPtr) {
+            return;
+        }
+
+        // For EdgeAA, we bloat in X & Y. For MSAA, we don't bloat at all.
+        SkScalar devBloat = this->aaMode() == AAMode::kCoverage ? 0.5f : 0.0f;
+        for (int p = 0; p < fPaths.count(); ++p) {
+            const PathData& geo = fPaths[p];
+            SkScalar strokeWidth = SkTMax(geo.fStrokeWidth, 1.f);
+            SkScalar halfStroke = strokeWidth * 0.5f;
+            SkScalar halfWidth = halfStroke + devBloat;
+            SkScalar intervals[2] = { geo.fIntervals[0] + geo.fCapLength * 2,
+                                      geo.fIntervals[1] - geo.fCapLength * 2 };
+            SkScalar intervalLength = intervals[0] + intervals[1];
+            SkScalar halfOff = intervals[1] * 0.5f;
+            // Every contour starts the dash pattern over, at the phase.
+            SkScalar startOffset = halfOff + geo.fPhase + geo.fCapLength;
+
+            for (int c = firstContour[p]; c < firstContour[p + 1]; ++c) {
+                const Contour& contour = contours[c];
+                if (contour.fCount < 2) {
+                    continue;
+                }
+                const SkPoint* cpts = pts.begin() + contour.fStart;
+                int n = contour.fCount - 1;
+                bool closed = contour.fClosed && cpts[0] == cpts[n];
+                SkScalar length = 0;
+                for (int i = 0; i < n; ++i) {
+                    length += SkPoint::Distance(cpts[i], cpts[i + 1]);
+                }
+                // A closed contour has no ends to clip, so its range just has to contain all of
+                // its quads.
+                SkScalar endSlack = closed ? halfWidth + 1 : geo.fCapLength;
+                SkScalar contourStart = startOffset - endSlack;
+                SkScalar contourEnd = startOffset + length + endSlack;
+
+                SkVector prevDir = cpts[n] - cpts[n - 1];
+                prevDir.normalize();
+                SkScalar s = startOffset;
+                for (int i = 0; i < n; ++i) {
+                    SkVector dir = cpts[i + 1] - cpts[i];
+                    SkScalar segmentLength = dir.length();
+                    dir.scale(SkScalarInvert(segmentLength));
+                    SkVector nextDir;
+                    if (i + 1 < n) {
+                        nextDir = cpts[i + 2] - cpts[i + 1];
+                    } else {
+                        nextDir = cpts[1] - cpts[0];
+                    }
+                    nextDir.normalize();
+
+                    SkScalar startExt, endExt;
+                    if (i > 0 || closed) {
+                        startExt = CornerExtension(prevDir, dir, halfWidth);
+                    } else {
+                        startExt = geo.fCapLength + devBloat;
+                    }
+                    if (i + 1 < n || closed) {
+                        endExt = CornerExtension(dir, nextDir, halfWidth);
+                    } else {
+                        endExt = geo.fCapLength + devBloat;
+                    }
+
+                    SkVector normal = { -dir.fY * halfWidth, dir.fX * halfWidth };
+                    SkPoint p0 = cpts[i] - dir * startExt;
+                    SkPoint p1 = cpts[i + 1] + dir * endExt;
+                    SkScalar s0 = s - startExt;
+                    SkScalar s1 = s + segmentLength + endExt;
+                    SkScalar info[4] = { intervalLength, halfOff, intervals[0], halfStroke };
+                    vertices.write(p0 - normal, s0, -halfWidth, contourStart, contourEnd, info);
+                    vertices.write(p0 + normal, s0,  halfWidth, contourStart, contourEnd, info);
+                    vertices.write(p1 - normal, s1, -halfWidth, contourStart, contourEnd, info);
+                    vertices.write(p1 + normal, s1,  halfWidth, contourStart, contourEnd, info);
+
+                    s += segmentLength;
+                    prevDir = dir;
+                }
+            }
+        }
+        helper.recordDraw(target, std::move(gp));
+    }
+
+    void onExecute(GrOpFlushState* flushState, const SkRect& chainBounds) override {
+        auto pipelineFlags = GrPipeline::InputFlags::kNone;
+        if (AAMode::kCoverageWithMSAA == fAAMode) {
+            pipelineFlags |= GrPipeline::InputFlags::kHWAntialias;
+        }
+        flushState->executeDrawsAndUploadsForMeshDrawOp(
+                this, chainBounds, std::move(fProcessorSet), pipelineFlags, fStencilSettings);
+    }
+
+    CombineResult onCombineIfPossible(GrOp* t, const GrCaps& caps) override {
+        DashPolylineOp* that = t->cast<DashPolylineOp>();
+        if (fProcessorSet != that->fProcessorSet) {
+            return CombineResult::kCannotCombine;
+        }
+
+        if (this->aaMode() != that->aaMode()) {
+            return CombineResult::kCannotCombine;
+        }
+
+        // TODO vertex color
+        if (this->color() != that->color()) {
+            return CombineResult::kCannotCombine;
+        }
+
+        if (fUsesLocalCoords && !this->viewMatrix().cheapEqualTo(that->viewMatrix())) {
+            return CombineResult::kCannotCombine;
+        }
+
+        fPaths.push_back_n(that->fPaths.count(), that->fPaths.begin());
+        return CombineResult::kMerged;
+    }
+
+    const SkPMColor4f& color() const { return fColor; }
+    const SkMatrix& viewMatrix() const { return fPaths[0].fViewMatrix; }
+    AAMode aaMode() const { return fAAMode; }
+
+    SkSTArray<1, PathData, true> fPaths;
+    SkPMColor4f fColor;
+    bool fUsesLocalCoords;
+    AAMode fAAMode;
+    GrProcessorSet fProcessorSet;
+    const GrUserStencilSettings* fStencilSettings;
+
+    typedef GrMeshDrawOp INHERITED;
+};
+
+std::unique_ptr<GrDrawOp> GrDashOp::MakeDashPolylineOp(
+        GrRecordingContext* context,
+        GrPaint&& paint,
+        const SkMatrix& viewMatrix,
+        const SkPath& path,
+        AAMode aaMode,
+        const GrStyle& style,
+        const GrUserStencilSettings* stencilSettings) {
+    SkASSERT(GrDashOp::CanDrawDashPolyline(path, style, viewMatrix));
+    const SkScalar* intervals = style.dashIntervals();
+    SkScalar scale = viewMatrix.getMaxScale();
+    if (SkScalarNearlyZero(scale)) {
+        return nullptr;
+    }
+
+    DashPolylineOp::PathData pathData;
+    pathData.fPath = path;
+    pathData.fViewMatrix = viewMatrix;
+    pathData.fIntervals[0] = intervals[0] * scale;
+    pathData.fIntervals[1] = intervals[1] * scale;
+    pathData.fPhase = style.dashPhase() * scale;
+    pathData.fStrokeWidth = style.strokeRec().getWidth() * scale;
+    pathData.fCapLength = 0;
+    if (SkPaint::kSquare_Cap == style.strokeRec().getCap()) {
+        // Square caps reach half the (at least one pixel) stroke past each end of a dash.
+        pathData.fCapLength = SkTMax(pathData.fStrokeWidth, 1.f) * 0.5f;
+    }
+
+    return DashPolylineOp::Make(context, std::move(paint), pathData, aaMode, stencilSettings);
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #if GR_TEST_UTILS
@@ -1274,4 +1922,54 @@ GR_DRAW_OP_TEST_DEFINE(DashOp) {
                                     GrGetRandomStencil(random, context));
 }
 
+GR_DRAW_OP_TEST_DEFINE(DashPolylineOp) {
+    SkMatrix viewMatrix;
+    viewMatrix.setRotate(random->nextRangeScalar(0, 360));
+    SkScalar scale = random->nextRangeScalar(0.5f, 2);
+    viewMatrix.postScale(scale, scale);
+    viewMatrix.postTranslate(random->nextRangeScalar(-10, 10), random->nextRangeScalar(-10, 10));
+    AAMode aaMode;
+    do {
+        aaMode = static_cast<AAMode>(random->nextULessThan(GrDashOp::kAAModeCnt));
+    } while (AAMode::kCoverageWithMSAA == aaMode && GrFSAAType::kUnifiedMSAA != fsaaType);
+
+    SkPath path;
+    path.moveTo(random->nextF() * 10.f, random->nextF() * 10.f);
+    int verbCount = random->nextRangeU(1, 5);
+    for (int i = 0; i < verbCount; ++i) {
+        SkPoint p[3];
+        for (SkPoint& pt : p) {
+            pt.set(random->nextF() * 10.f, random->nextF() * 10.f);
+        }
+        switch (random->nextULessThan(4)) {
+            case 0: path.lineTo(p[0]); break;
+            case 1: path.quadTo(p[0], p[1]); break;
+            case 2: path.conicTo(p[0], p[1], random->nextRangeScalar(0.5f, 2)); break;
+            case 3: path.cubicTo(p[0], p[1], p[2]); break;
+        }
+    }
+    if (random->nextBool()) {
+        path.close();
+    }
+
+    SkScalar intervals[2];
+    intervals[0] = random->nextRangeScalar(0.5f, 10.f);
+    intervals[1] = random->nextRangeScalar(2.5f, 10.f);
+    SkScalar phase = random->nextRangeScalar(0, intervals[0] + intervals[1]);
+
+    SkPaint p;
+    p.setStyle(SkPaint::kStroke_Style);
+    p.setStrokeWidth(random->nextBool() ? 0 : SkIntToScalar(1));
+    p.setStrokeCap(random->nextBool() ? SkPaint::kButt_Cap : SkPaint::kSquare_Cap);
+    p.setPathEffect(GrTest::TestDashPathEffect::Make(intervals, 2, phase));
+
+    GrStyle style(p);
+    if (!GrDashOp::CanDrawDashPolyline(path, style, viewMatrix)) {
+        return nullptr;
+    }
+
+    return GrDashOp::MakeDashPolylineOp(context, std::move(paint), viewMatrix, path, aaMode, style,
+                                        GrGetRandomStencil(random, context));
+}
+
 #endif
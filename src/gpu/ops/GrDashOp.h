@@ -12,6 +12,7 @@
 #include "include/gpu/GrTypes.h"
 
 class GrDrawOp;
+class SkPath;
 class GrPaint;
 class GrRecordingContext;
 class GrStyle;
@@ -33,6 +34,21 @@ std::unique_ptr<GrDrawOp> MakeDashLineOp(GrRecordingContext*,
                                          const GrStyle& style,
                                          const GrUserStencilSettings*);
 bool CanDrawDashLine(const SkPoint pts[2], const GrStyle& style, const SkMatrix& viewMatrix);
+
+/**
+ * Dashes any path, curves included, on the GPU: the path is flattened into device space polylines
+ * and the fragment shader drops out the off intervals by each fragment's distance along its
+ * contour. Limited to thin (at most two device pixels wide) butt or square capped strokes with a
+ * single on/off interval pair under a similarity transform.
+ */
+std::unique_ptr<GrDrawOp> MakeDashPolylineOp(GrRecordingContext*,
+                                             GrPaint&&,
+                                             const SkMatrix& viewMatrix,
+                                             const SkPath& path,
+                                             AAMode,
+                                             const GrStyle& style,
+                                             const GrUserStencilSettings*);
+bool CanDrawDashPolyline(const SkPath& path, const GrStyle& style, const SkMatrix& viewMatrix);
 }
 
 #endif
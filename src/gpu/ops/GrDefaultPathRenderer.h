@@ -20,6 +20,8 @@ class SK_API GrDefaultPathRenderer : public GrPathRenderer {
 public:
     GrDefaultPathRenderer();
 
+    const char* name() const override { return "default"; }
+
 private:
     StencilSupport onGetStencilSupport(const GrShape&) const override;
 
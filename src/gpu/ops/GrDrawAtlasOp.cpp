@@ -16,11 +16,133 @@
 #include "src/gpu/GrDrawOpTest.h"
 #include "src/gpu/GrOpFlushState.h"
 #include "src/gpu/GrRecordingContextPriv.h"
+#include "src/gpu/GrResourceProvider.h"
 #include "src/gpu/SkGr.h"
+#include "src/gpu/glsl/GrGLSLFragmentShaderBuilder.h"
+#include "src/gpu/glsl/GrGLSLGeometryProcessor.h"
+#include "src/gpu/glsl/GrGLSLProgramDataManager.h"
+#include "src/gpu/glsl/GrGLSLUniformHandler.h"
+#include "src/gpu/glsl/GrGLSLUtil.h"
+#include "src/gpu/glsl/GrGLSLVarying.h"
+#include "src/gpu/glsl/GrGLSLVertexGeoBuilder.h"
 #include "src/gpu/ops/GrSimpleMeshDrawOpHelper.h"
 
 namespace {
 
+/**
+ * Draws each sprite as an instance of a unit quad, so only the sprite's RSXform, texture rect and
+ * (optional) color are uploaded, rather than four vertices. The vertex shader expands the quad
+ * the same way SkRSXform::toTriStrip() does.
+ */
+class AtlasInstanceProcessor : public GrGeometryProcessor {
+public:
+    static sk_sp<GrGeometryProcessor> Make(bool hasColors, const SkPMColor4f& color,
+                                           const SkMatrix& viewMatrix) {
+        return sk_sp<GrGeometryProcessor>(
+                new AtlasInstanceProcessor(hasColors, color, viewMatrix));
+    }
+
+    const char* name() const override { return "AtlasInstanceProcessor"; }
+
+    void getGLSLProcessorKey(const GrShaderCaps&, GrProcessorKeyBuilder*) const override;
+
+    GrGLSLPrimitiveProcessor* createGLSLInstance(const GrShaderCaps&) const override;
+
+private:
+    AtlasInstanceProcessor(bool hasColors, const SkPMColor4f& color, const SkMatrix& viewMatrix)
+            : INHERITED(kGrDrawAtlasOp_Processor_ClassID)
+            , fColor(color)
+            , fViewMatrix(viewMatrix)
+            , fHasColors(hasColors) {
+        this->setVertexAttributes(&kCornerAttrib, 1);
+        fInstanceAttribs[0] = {"xform", kFloat4_GrVertexAttribType, kFloat4_GrSLType};
+        fInstanceAttribs[1] = {"tex_rect", kFloat4_GrVertexAttribType, kFloat4_GrSLType};
+        fInstanceAttribs[2] = MakeColorAttribute("color", false);
+        this->setInstanceAttributes(fInstanceAttribs, hasColors ? 3 : 2);
+    }
+
+    // Each corner of the unit quad, as a triangle strip.
+    static constexpr Attribute kCornerAttrib =
+            {"corner", kFloat2_GrVertexAttribType, kFloat2_GrSLType};
+
+    const SkPMColor4f fColor;
+    const SkMatrix    fViewMatrix;
+    const bool        fHasColors;
+    Attribute         fInstanceAttribs[3];
+
+    class Impl;
+
+    typedef GrGeometryProcessor INHERITED;
+};
+
+constexpr GrPrimitiveProcessor::Attribute AtlasInstanceProcessor::kCornerAttrib;
+
+class AtlasInstanceProcessor::Impl : public GrGLSLGeometryProcessor {
+public:
+    static void GenKey(const AtlasInstanceProcessor& proc, GrProcessorKeyBuilder* b) {
+        b->add32((ComputePosKey(proc.fViewMatrix) << 1) | proc.fHasColors);
+    }
+
+private:
+    void onEmitCode(EmitArgs& args, GrGPArgs* gpArgs) override {
+        const auto& proc = args.fGP.cast<AtlasInstanceProcessor>();
+        GrGLSLVertexBuilder* v = args.fVertBuilder;
+        GrGLSLFPFragmentBuilder* f = args.fFragBuilder;
+        GrGLSLVaryingHandler* varyings = args.fVaryingHandler;
+        GrGLSLUniformHandler* uniforms = args.fUniformHandler;
+
+        varyings->emitAttributes(proc);
+        if (proc.fHasColors) {
+            varyings->addPassThroughAttribute(proc.fInstanceAttribs[2], args.fOutputColor,
+                                              GrGLSLVaryingHandler::Interpolation::kCanBeFlat);
+        } else {
+            this->setupUniformColor(f, uniforms, args.fOutputColor, &fColorUniform);
+        }
+
+        // xform is {scos, ssin, tx, ty}, and tex_rect is {l, t, r, b}.
+        v->codeAppend("float2 offset = corner * (tex_rect.zw - tex_rect.xy);");
+        v->codeAppend("float2 localcoord = tex_rect.xy + offset;");
+        v->codeAppend("float2 position = xform.xy * offset.x + float2(-xform.y, xform.x) * offset.y"
+                                        " + xform.zw;");
+        this->writeOutputPosition(v, uniforms, gpArgs, "position", proc.fViewMatrix,
+                                  &fViewMatrixUniform);
+        this->emitTransforms(v, varyings, uniforms, GrShaderVar("localcoord", kFloat2_GrSLType),
+                             args.fFPCoordTransformHandler);
+
+        f->codeAppendf("%s = half4(1);", args.fOutputCoverage);
+    }
+
+    void setData(const GrGLSLProgramDataManager& pdman, const GrPrimitiveProcessor& primProc,
+                 FPCoordTransformIter&& transformIter) override {
+        const auto& proc = primProc.cast<AtlasInstanceProcessor>();
+        if (!proc.fViewMatrix.isIdentity() && !fViewMatrix.cheapEqualTo(proc.fViewMatrix)) {
+            fViewMatrix = proc.fViewMatrix;
+            float viewMatrix[3 * 3];
+            GrGLSLGetMatrix<3>(viewMatrix, fViewMatrix);
+            pdman.setMatrix3f(fViewMatrixUniform, viewMatrix);
+        }
+        if (!proc.fHasColors && proc.fColor != fColor) {
+            pdman.set4fv(fColorUniform, 1, proc.fColor.vec());
+            fColor = proc.fColor;
+        }
+        this->setTransformDataHelper(SkMatrix::I(), pdman, &transformIter);
+    }
+
+    SkMatrix      fViewMatrix = SkMatrix::InvalidMatrix();
+    SkPMColor4f   fColor = SK_PMColor4fILLEGAL;
+    UniformHandle fViewMatrixUniform;
+    UniformHandle fColorUniform;
+};
+
+void AtlasInstanceProcessor::getGLSLProcessorKey(const GrShaderCaps&,
+                                                 GrProcessorKeyBuilder* b) const {
+    Impl::GenKey(*this, b);
+}
+
+GrGLSLPrimitiveProcessor* AtlasInstanceProcessor::createGLSLInstance(const GrShaderCaps&) const {
+    return new Impl();
+}
+
 class DrawAtlasOp final : public GrMeshDrawOp {
 private:
     using Helper = GrSimpleMeshDrawOpHelper;
@@ -29,8 +151,8 @@ public:
     DEFINE_OP_CLASS_ID
 
     DrawAtlasOp(const Helper::MakeArgs&, const SkPMColor4f& color,
-                const SkMatrix& viewMatrix, GrAAType, int spriteCount, const SkRSXform* xforms,
-                const SkRect* rects, const SkColor* colors);
+                const SkMatrix& viewMatrix, GrAAType, bool useInstancing, int spriteCount,
+                const SkRSXform* xforms, const SkRect* rects, const SkColor* colors);
 
     const char* name() const override { return "DrawAtlasOp"; }
 
@@ -58,9 +180,20 @@ private:
 
     CombineResult onCombineIfPossible(GrOp* t, const GrCaps&) override;
 
+    void prepareInstancedDraws(Target*);
+
+    // What's uploaded for each sprite when drawing with instancing.
+    struct Sprite {
+        SkRSXform fXform;
+        SkRect    fTexRect;
+        GrColor   fColor;
+    };
+
     struct Geometry {
         SkPMColor4f fColor;
+        // Either four vertices for each sprite, or with instancing, the sprites themselves.
         SkTArray<uint8_t, true> fVerts;
+        SkTArray<Sprite, true> fSprites;
     };
 
     SkSTArray<1, Geometry, true> fGeoData;
@@ -69,6 +202,7 @@ private:
     SkPMColor4f fColor;
     int fQuadCount;
     bool fHasColors;
+    bool fUseInstancing;
 
     typedef GrMeshDrawOp INHERITED;
 };
@@ -88,35 +222,64 @@ static sk_sp<GrGeometryProcessor> make_gp(const GrShaderCaps* shaderCaps,
 }
 
 DrawAtlasOp::DrawAtlasOp(const Helper::MakeArgs& helperArgs, const SkPMColor4f& color,
-                         const SkMatrix& viewMatrix, GrAAType aaType, int spriteCount,
-                         const SkRSXform* xforms, const SkRect* rects, const SkColor* colors)
-        : INHERITED(ClassID()), fHelper(helperArgs, aaType), fColor(color) {
+                         const SkMatrix& viewMatrix, GrAAType aaType, bool useInstancing,
+                         int spriteCount, const SkRSXform* xforms, const SkRect* rects,
+                         const SkColor* colors)
+        : INHERITED(ClassID())
+        , fHelper(helperArgs, aaType)
+        , fColor(color)
+        , fUseInstancing(useInstancing) {
     SkASSERT(xforms);
     SkASSERT(rects);
 
     fViewMatrix = viewMatrix;
     Geometry& installedGeo = fGeoData.push_back();
     installedGeo.fColor = color;
+    fHasColors = SkToBool(colors);
+    fQuadCount = spriteCount;
+
+    SkRect bounds = SkRectPriv::MakeLargestInverted();
+    // TODO4F: Preserve float colors
+    int paintAlpha = GrColorUnpackA(installedGeo.fColor.toBytes_RGBA());
+    if (useInstancing) {
+        installedGeo.fSprites.reset(spriteCount);
+        for (int spriteIndex = 0; spriteIndex < spriteCount; ++spriteIndex) {
+            Sprite& sprite = installedGeo.fSprites[spriteIndex];
+            sprite.fXform = xforms[spriteIndex];
+            sprite.fTexRect = rects[spriteIndex];
+            sprite.fColor = 0;
+            if (colors) {
+                SkColor color = colors[spriteIndex];
+                if (paintAlpha != 255) {
+                    color = SkColorSetA(color, SkMulDiv255Round(SkColorGetA(color), paintAlpha));
+                }
+                sprite.fColor = SkColorToPremulGrColor(color);
+            }
+
+            SkPoint quad[4];
+            sprite.fXform.toQuad(sprite.fTexRect.width(), sprite.fTexRect.height(), quad);
+            for (const SkPoint& pt : quad) {
+                SkRectPriv::GrowToInclude(&bounds, pt);
+            }
+        }
+        this->setTransformedBounds(bounds, viewMatrix, HasAABloat::kNo, IsZeroArea::kNo);
+        return;
+    }
 
     // Figure out stride and offsets
     // Order within the vertex is: position [color] texCoord
     size_t texOffset = sizeof(SkPoint);
     size_t vertexStride = 2 * sizeof(SkPoint);
-    fHasColors = SkToBool(colors);
     if (colors) {
         texOffset += sizeof(GrColor);
         vertexStride += sizeof(GrColor);
     }
 
     // Compute buffer size and alloc buffer
-    fQuadCount = spriteCount;
     int allocSize = static_cast<int>(4 * vertexStride * spriteCount);
     installedGeo.fVerts.reset(allocSize);
     uint8_t* currVertex = installedGeo.fVerts.begin();
 
-    SkRect bounds = SkRectPriv::MakeLargestInverted();
-    // TODO4F: Preserve float colors
-    int paintAlpha = GrColorUnpackA(installedGeo.fColor.toBytes_RGBA());
     for (int spriteIndex = 0; spriteIndex < spriteCount; ++spriteIndex) {
         // Transform rect
         SkPoint strip[4];
@@ -174,7 +337,7 @@ SkString DrawAtlasOp::dumpInfo() const {
     SkString string;
     for (const auto& geo : fGeoData) {
         string.appendf("Color: 0x%08x, Quads: %d\n", geo.fColor.toBytes_RGBA(),
-                       geo.fVerts.count() / 4);
+                       fUseInstancing ? geo.fSprites.count() : geo.fVerts.count() / 4);
     }
     string += fHelper.dumpInfo();
     string += INHERITED::dumpInfo();
@@ -183,6 +346,11 @@ SkString DrawAtlasOp::dumpInfo() const {
 #endif
 
 void DrawAtlasOp::onPrepareDraws(Target* target) {
+    if (fUseInstancing) {
+        this->prepareInstancedDraws(target);
+        return;
+    }
+
     // Setup geometry processor
     sk_sp<GrGeometryProcessor> gp(make_gp(target->caps().shaderCaps(),
                                           this->hasColors(),
@@ -211,6 +379,51 @@ void DrawAtlasOp::onPrepareDraws(Target* target) {
     helper.recordDraw(target, std::move(gp));
 }
 
+GR_DECLARE_STATIC_UNIQUE_KEY(gAtlasCornerBufferKey);
+
+static constexpr SkPoint kAtlasCorners[] = {{0, 0}, {0, 1}, {1, 0}, {1, 1}};
+
+void DrawAtlasOp::prepareInstancedDraws(Target* target) {
+    sk_sp<GrGeometryProcessor> gp = AtlasInstanceProcessor::Make(this->hasColors(), this->color(),
+                                                                 this->viewMatrix());
+
+    GR_DEFINE_STATIC_UNIQUE_KEY(gAtlasCornerBufferKey);
+    sk_sp<const GrBuffer> corners = target->resourceProvider()->findOrMakeStaticBuffer(
+            GrGpuBufferType::kVertex, sizeof(kAtlasCorners), kAtlasCorners,
+            gAtlasCornerBufferKey);
+
+    size_t instanceStride = gp->instanceStride();
+    sk_sp<const GrBuffer> instanceBuffer;
+    int firstInstance;
+    void* instances = target->makeVertexSpace(instanceStride, this->quadCount(),
+                                              &instanceBuffer, &firstInstance);
+    if (!corners || !instances) {
+        SkDebugf("Could not allocate vertices\n");
+        return;
+    }
+
+    // The sprites' colors are left out if finalize() found the color to be constant.
+    SkASSERT(instanceStride == sizeof(Sprite) - (this->hasColors() ? 0 : sizeof(GrColor)));
+    uint8_t* instancePtr = static_cast<uint8_t*>(instances);
+    for (const Geometry& geo : fGeoData) {
+        if (this->hasColors()) {
+            memcpy(instancePtr, geo.fSprites.begin(), geo.fSprites.count() * sizeof(Sprite));
+            instancePtr += geo.fSprites.count() * sizeof(Sprite);
+        } else {
+            for (const Sprite& sprite : geo.fSprites) {
+                memcpy(instancePtr, &sprite, instanceStride);
+                instancePtr += instanceStride;
+            }
+        }
+    }
+
+    GrMesh* mesh = target->allocMesh(GrPrimitiveType::kTriangleStrip);
+    mesh->setInstanced(std::move(instanceBuffer), this->quadCount(), firstInstance,
+                       SK_ARRAY_COUNT(kAtlasCorners));
+    mesh->setVertexData(std::move(corners));
+    target->recordDraw(std::move(gp), mesh);
+}
+
 void DrawAtlasOp::onExecute(GrOpFlushState* flushState, const SkRect& chainBounds) {
     fHelper.executeDrawsAndUploads(this, flushState, chainBounds);
 }
@@ -235,6 +448,10 @@ GrOp::CombineResult DrawAtlasOp::onCombineIfPossible(GrOp* t, const GrCaps& caps
         return CombineResult::kCannotCombine;
     }
 
+    if (fUseInstancing != that->fUseInstancing) {
+        return CombineResult::kCannotCombine;
+    }
+
     fGeoData.push_back_n(that->fGeoData.count(), that->fGeoData.begin());
     fQuadCount += that->quadCount();
 
@@ -271,10 +488,11 @@ std::unique_ptr<GrDrawOp> GrDrawAtlasOp::Make(GrRecordingContext* context,
                                               const SkRSXform* xforms,
                                               const SkRect* rects,
                                               const SkColor* colors) {
+    bool useInstancing = context->priv().caps()->instanceAttribSupport();
     return GrSimpleMeshDrawOpHelper::FactoryHelper<DrawAtlasOp>(context, std::move(paint),
                                                                 viewMatrix, aaType,
-                                                                spriteCount, xforms,
-                                                                rects, colors);
+                                                                useInstancing, spriteCount,
+                                                                xforms, rects, colors);
 }
 
 #if GR_TEST_UTILS
@@ -538,7 +538,8 @@ GrOp::CombineResult DrawVerticesOp::onCombineIfPossible(GrOp* t, const GrCaps& c
         return CombineResult::kCannotCombine;
     }
 
-    if (fVertexCount + that->fVertexCount > SkTo<int>(UINT16_MAX)) {
+    // Only indexed meshes are limited by the range of a 16 bit index.
+    if (fIndexCount && fVertexCount + that->fVertexCount > SkTo<int>(UINT16_MAX)) {
         return CombineResult::kCannotCombine;
     }
 
@@ -194,15 +194,17 @@ private:
         using Domain = GrQuadPerEdgeAA::Domain;
         static constexpr SkRect kEmptyDomain = SkRect::MakeEmpty();
 
+        bool instanced = GrQuadPerEdgeAA::CanDrawInstanced(
+                target->caps(), fDeviceQuads.quadType(), fLocalQuads.quadType(), fHelper.aaType());
         VertexSpec vertexSpec(fDeviceQuads.quadType(), fColorType, fLocalQuads.quadType(),
                               fHelper.usesLocalCoords(), Domain::kNo, fHelper.aaType(),
-                              fHelper.compatibleWithCoverageAsAlpha());
+                              fHelper.compatibleWithCoverageAsAlpha(), instanced);
         // Make sure that if the op thought it was a solid color, the vertex spec does not use
         // local coords.
         SkASSERT(!fHelper.isTrivial() || !fHelper.usesLocalCoords());
 
         sk_sp<GrGeometryProcessor> gp = GrQuadPerEdgeAA::MakeProcessor(vertexSpec);
-        size_t vertexSize = gp->vertexStride();
+        size_t vertexSize = instanced ? gp->instanceStride() : gp->vertexStride();
 
         sk_sp<const GrBuffer> vbuffer;
         int vertexOffsetInBuffer = 0;
@@ -238,11 +240,11 @@ private:
 
         // Configure the mesh for the vertex data
         GrMesh* mesh = target->allocMeshes(1);
-        if (!GrQuadPerEdgeAA::ConfigureMeshIndices(target, mesh, vertexSpec, this->quadCount())) {
+        if (!GrQuadPerEdgeAA::ConfigureMesh(target, mesh, vertexSpec, this->quadCount(),
+                                            std::move(vbuffer), vertexOffsetInBuffer)) {
             SkDebugf("Could not allocate indices\n");
             return;
         }
-        mesh->setVertexData(std::move(vbuffer), vertexOffsetInBuffer);
         target->recordDraw(std::move(gp), mesh);
     }
 
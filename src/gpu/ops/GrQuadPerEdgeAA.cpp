@@ -6,6 +6,7 @@
  */
 
 #include "include/private/SkNx.h"
+#include "src/gpu/GrCaps.h"
 #include "src/gpu/GrQuad.h"
 #include "src/gpu/GrVertexWriter.h"
 #include "src/gpu/SkGr.h"
@@ -699,6 +700,32 @@ static void write_quad(GrVertexWriter* vb, const GrQuadPerEdgeAA::VertexSpec& sp
     }
 }
 
+// Writes a single instance for the quad: its four device corners, which the vertex shader picks
+// between, followed by the color, the four local corners, and the texture domain as needed.
+static void write_instance(GrVertexWriter* vb, const GrQuadPerEdgeAA::VertexSpec& spec,
+                           const SkPMColor4f& color4f, const SkRect& texDomain,
+                           const Vertices& quad) {
+    float x[4], y[4];
+    quad.fX.store(x);
+    quad.fY.store(y);
+    vb->write(x, y);
+
+    if (spec.hasVertexColors()) {
+        vb->write(GrVertexColor(color4f, spec.colorType() == GrQuadPerEdgeAA::ColorType::kHalf));
+    }
+
+    if (spec.hasLocalCoords()) {
+        float u[4], v[4];
+        quad.fU.store(u);
+        quad.fV.store(v);
+        vb->write(u, v);
+    }
+
+    if (spec.hasDomain()) {
+        vb->write(texDomain);
+    }
+}
+
 GR_DECLARE_STATIC_UNIQUE_KEY(gAAFillRectIndexBufferKey);
 
 static const int kVertsPerAAFillRect = 8;
@@ -723,10 +750,37 @@ static sk_sp<const GrGpuBuffer> get_index_buffer(GrResourceProvider* resourcePro
             kVertsPerAAFillRect, gAAFillRectIndexBufferKey);
 }
 
+GR_DECLARE_STATIC_UNIQUE_KEY(gInstancedQuadCornersKey);
+
+// Each instanced quad is drawn as a strip over these, which select the corner's coordinates out
+// of the instance's four, in the same order as GrQuad.
+static sk_sp<const GrGpuBuffer> get_instanced_corners(GrResourceProvider* resourceProvider) {
+    GR_DEFINE_STATIC_UNIQUE_KEY(gInstancedQuadCornersKey);
+
+    // clang-format off
+    static const float gQuadCorners[] = {
+        1, 0, 0, 0,
+        0, 1, 0, 0,
+        0, 0, 1, 0,
+        0, 0, 0, 1,
+    };
+    // clang-format on
+
+    return resourceProvider->findOrMakeStaticBuffer(GrGpuBufferType::kVertex,
+                                                    sizeof(gQuadCorners), gQuadCorners,
+                                                    gInstancedQuadCornersKey);
+}
+
 } // anonymous namespace
 
 namespace GrQuadPerEdgeAA {
 
+bool CanDrawInstanced(const GrCaps& caps, GrQuadType deviceQuadType, GrQuadType localQuadType,
+                      GrAAType aa) {
+    return caps.instanceAttribSupport() && aa != GrAAType::kCoverage &&
+           deviceQuadType != GrQuadType::kPerspective && localQuadType != GrQuadType::kPerspective;
+}
+
 // This is a more elaborate version of SkPMColor4fNeedsWideColor that allows "no color" for white
 ColorType MinColorType(SkPMColor4f color, GrClampType clampType, const GrCaps& caps) {
     if (color == SK_PMColor4fWHITE) {
@@ -762,7 +816,10 @@ void* Tessellate(void* vertices, const VertexSpec& spec, const GrPerspQuad& devi
     }
 
     GrVertexWriter vb{vertices};
-    if (spec.usesCoverageAA()) {
+    if (spec.instanced()) {
+        SkASSERT(mode == CoverageMode::kNone);
+        write_instance(&vb, spec, color4f, domain, outer);
+    } else if (spec.usesCoverageAA()) {
         SkASSERT(mode == CoverageMode::kWithPosition || mode == CoverageMode::kWithColor);
         // Must calculate two new quads, an outset and inset by .5 in projected device space, so
         // duplicate the original quad for the inner space
@@ -804,8 +861,21 @@ void* Tessellate(void* vertices, const VertexSpec& spec, const GrPerspQuad& devi
     return vb.fPtr;
 }
 
-bool ConfigureMeshIndices(GrMeshDrawOp::Target* target, GrMesh* mesh, const VertexSpec& spec,
-                          int quadCount) {
+bool ConfigureMesh(GrMeshDrawOp::Target* target, GrMesh* mesh, const VertexSpec& spec,
+                   int quadCount, sk_sp<const GrBuffer> vertexBuffer, int vertexOffset) {
+    if (spec.instanced()) {
+        // One instance per quad, drawn as a strip over the four shared corners
+        sk_sp<const GrGpuBuffer> corners = get_instanced_corners(target->resourceProvider());
+        if (!corners) {
+            return false;
+        }
+
+        mesh->setPrimitiveType(GrPrimitiveType::kTriangleStrip);
+        mesh->setInstanced(std::move(vertexBuffer), quadCount, vertexOffset, 4);
+        mesh->setVertexData(std::move(corners));
+        return true;
+    }
+
     if (spec.usesCoverageAA()) {
         // AA quads use 8 vertices, basically nested rectangles
         sk_sp<const GrGpuBuffer> ibuffer = get_index_buffer(target->resourceProvider());
@@ -833,6 +903,7 @@ bool ConfigureMeshIndices(GrMeshDrawOp::Target* target, GrMesh* mesh, const Vert
         }
     }
 
+    mesh->setVertexData(std::move(vertexBuffer), vertexOffset);
     return true;
 }
 
@@ -887,6 +958,7 @@ public:
             x |= fGeomDomain.isInitialized() ?
                     384 : (CoverageMode::kWithPosition == fCoverageMode ? 128 : 256);
         }
+        x |= fInstanced ? 512 : 0;
 
         b->add32(GrColorSpaceXform::XformKey(fTextureColorSpaceXform.get()));
         b->add32(x);
@@ -914,7 +986,26 @@ public:
 
                 args.fVaryingHandler->emitAttributes(gp);
 
-                if (gp.fCoverageMode == CoverageMode::kWithPosition) {
+                // When instanced, the corner picks this vertex's coordinates out of the four
+                // that each instance has for the quad
+                GrShaderVar localCoord = gp.fLocalCoord.asShaderVar();
+                if (gp.fInstanced) {
+                    SkASSERT(gp.fCoverageMode == CoverageMode::kNone && !gp.fNeedsPerspective);
+                    args.fVertBuilder->codeAppendf(
+                            "float2 position = float2(dot(%s, %s), dot(%s, %s));",
+                            gp.fPosition.name(), gp.fCorner.name(),
+                            gp.fPositionY.name(), gp.fCorner.name());
+                    gpArgs->fPositionVar = {"position", kFloat2_GrSLType,
+                                            GrShaderVar::kNone_TypeModifier};
+                    if (gp.fLocalCoord.isInitialized()) {
+                        args.fVertBuilder->codeAppendf(
+                                "float2 localCoord = float2(dot(%s, %s), dot(%s, %s));",
+                                gp.fLocalCoord.name(), gp.fCorner.name(),
+                                gp.fLocalCoordY.name(), gp.fCorner.name());
+                        localCoord = {"localCoord", kFloat2_GrSLType,
+                                      GrShaderVar::kNone_TypeModifier};
+                    }
+                } else if (gp.fCoverageMode == CoverageMode::kWithPosition) {
                     // Strip last channel from the vertex attribute to remove coverage and get the
                     // actual position
                     if (gp.fNeedsPerspective) {
@@ -941,7 +1032,7 @@ public:
                     this->emitTransforms(args.fVertBuilder,
                                          args.fVaryingHandler,
                                          args.fUniformHandler,
-                                         gp.fLocalCoord.asShaderVar(),
+                                         localCoord,
                                          args.fFPCoordTransformHandler);
                 }
 
@@ -971,6 +1062,11 @@ public:
                                                        v.vsOut(), gp.fLocalCoord.name());
                         args.fFragBuilder->codeAppendf("texCoord = %s.xy / %s.z;",
                                                        v.fsIn(), v.fsIn());
+                    } else if (gp.fInstanced) {
+                        GrGLSLVarying v(kFloat2_GrSLType);
+                        args.fVaryingHandler->addVarying("texCoord", &v);
+                        args.fVertBuilder->codeAppendf("%s = %s;", v.vsOut(), localCoord.c_str());
+                        args.fFragBuilder->codeAppendf("texCoord = %s;", v.fsIn());
                     } else {
                         args.fVaryingHandler->addPassThroughAttribute(gp.fLocalCoord, "texCoord");
                     }
@@ -1066,6 +1162,12 @@ private:
     void initializeAttrs(const VertexSpec& spec) {
         fNeedsPerspective = spec.deviceDimensionality() == 3;
         fCoverageMode = get_mode_for_spec(spec);
+        fInstanced = spec.instanced();
+
+        if (fInstanced) {
+            this->initializeInstanceAttrs(spec);
+            return;
+        }
 
         if (fCoverageMode == CoverageMode::kWithPosition) {
             if (fNeedsPerspective) {
@@ -1105,21 +1207,55 @@ private:
             fTexDomain = {"texDomain", kFloat4_GrVertexAttribType, kFloat4_GrSLType};
         }
 
-        this->setVertexAttributes(&fPosition, 6);
+        this->setVertexAttributes(&fPosition, 8);
+    }
+
+    void initializeInstanceAttrs(const VertexSpec& spec) {
+        SkASSERT(fCoverageMode == CoverageMode::kNone && !fNeedsPerspective);
+        fCorner = {"corner", kFloat4_GrVertexAttribType, kFloat4_GrSLType};
+
+        fPosition = {"positionX", kFloat4_GrVertexAttribType, kFloat4_GrSLType};
+        fPositionY = {"positionY", kFloat4_GrVertexAttribType, kFloat4_GrSLType};
+
+        if (spec.hasLocalCoords()) {
+            SkASSERT(spec.localDimensionality() == 2);
+            fLocalCoord = {"localCoordX", kFloat4_GrVertexAttribType, kFloat4_GrSLType};
+            fLocalCoordY = {"localCoordY", kFloat4_GrVertexAttribType, kFloat4_GrSLType};
+        }
+
+        if (ColorType::kByte == spec.colorType()) {
+            fColor = {"color", kUByte4_norm_GrVertexAttribType, kHalf4_GrSLType};
+        } else if (ColorType::kHalf == spec.colorType()) {
+            fColor = {"color", kHalf4_GrVertexAttribType, kHalf4_GrSLType};
+        }
+
+        if (spec.hasDomain()) {
+            fTexDomain = {"texDomain", kFloat4_GrVertexAttribType, kFloat4_GrSLType};
+        }
+
+        this->setVertexAttributes(&fCorner, 1);
+        this->setInstanceAttributes(&fPosition, 8);
     }
 
     const TextureSampler& onTextureSampler(int) const override { return fSampler; }
 
+    // When instanced, fPosition and fLocalCoord hold the x coordinates of all four corners, and
+    // fPositionY and fLocalCoordY the y coordinates; otherwise the Y attributes are unused. The
+    // order here is the order that Tessellate() writes.
     Attribute fPosition; // May contain coverage as last channel
+    Attribute fPositionY;
     Attribute fCoverage; // Used for non-perspective position to avoid Intel Metal issues
     Attribute fColor; // May have coverage modulated in if the FPs support it
     Attribute fLocalCoord;
+    Attribute fLocalCoordY;
     Attribute fGeomDomain; // Screen-space bounding box on geometry+aa outset
     Attribute fTexDomain; // Texture-space bounding box on local coords
+    Attribute fCorner; // Per-vertex selector of one of the instance's corners
 
     // The positions attribute may have coverage built into it, so float3 is an ambiguous type
     // and may mean 2d with coverage, or 3d with no coverage
     bool fNeedsPerspective;
+    bool fInstanced;
     CoverageMode fCoverageMode;
 
     // Color space will be null and fSampler.isInitialized() returns false when the GP is configured
@@ -30,14 +30,23 @@ namespace GrQuadPerEdgeAA {
     // Gets the minimum ColorType that can represent a color.
     ColorType MinColorType(SkPMColor4f, GrClampType, const GrCaps&);
 
+    // Whether quads of these types can be drawn as one instance each, with the vertex shader
+    // picking out each corner, instead of writing every vertex. This needs instanced attributes,
+    // and only applies to 2D quads that aren't outset for coverage AA.
+    bool CanDrawInstanced(const GrCaps&, GrQuadType deviceQuadType, GrQuadType localQuadType,
+                          GrAAType);
+
     // Specifies the vertex configuration for an op that renders per-edge AA quads. The vertex
     // order (when enabled) is device position, color, local position, domain, aa edge equations.
     // This order matches the constructor argument order of VertexSpec and is the order that
     // GPAttributes maintains. If hasLocalCoords is false, then the local quad type can be ignored.
+    // When instanced, that data is written once per quad rather than per vertex, and the device
+    // and local positions hold all four of the quad's corners.
     struct VertexSpec {
     public:
         VertexSpec(GrQuadType deviceQuadType, ColorType colorType, GrQuadType localQuadType,
-                   bool hasLocalCoords, Domain domain, GrAAType aa, bool coverageAsAlpha)
+                   bool hasLocalCoords, Domain domain, GrAAType aa, bool coverageAsAlpha,
+                   bool instanced = false)
                 : fDeviceQuadType(static_cast<unsigned>(deviceQuadType))
                 , fLocalQuadType(static_cast<unsigned>(localQuadType))
                 , fHasLocalCoords(hasLocalCoords)
@@ -46,7 +55,13 @@ namespace GrQuadPerEdgeAA {
                 , fUsesCoverageAA(aa == GrAAType::kCoverage)
                 , fCompatibleWithCoverageAsAlpha(coverageAsAlpha)
                 , fRequiresGeometryDomain(aa == GrAAType::kCoverage &&
-                                          deviceQuadType > GrQuadType::kRectilinear) { }
+                                          deviceQuadType > GrQuadType::kRectilinear)
+                , fInstanced(instanced) {
+            SkASSERT(!instanced || (aa != GrAAType::kCoverage &&
+                                    deviceQuadType != GrQuadType::kPerspective &&
+                                    (!hasLocalCoords ||
+                                     localQuadType != GrQuadType::kPerspective)));
+        }
 
         GrQuadType deviceQuadType() const { return static_cast<GrQuadType>(fDeviceQuadType); }
         GrQuadType localQuadType() const { return static_cast<GrQuadType>(fLocalQuadType); }
@@ -57,12 +72,14 @@ namespace GrQuadPerEdgeAA {
         bool usesCoverageAA() const { return fUsesCoverageAA; }
         bool compatibleWithCoverageAsAlpha() const { return fCompatibleWithCoverageAsAlpha; }
         bool requiresGeometryDomain() const { return fRequiresGeometryDomain; }
+        bool instanced() const { return fInstanced; }
         // Will always be 2 or 3
         int deviceDimensionality() const;
         // Will always be 0 if hasLocalCoords is false, otherwise will be 2 or 3
         int localDimensionality() const;
 
-        int verticesPerQuad() const { return fUsesCoverageAA ? 8 : 4; }
+        // The number of vertices (or instances, when instanced) that Tessellate() writes per quad
+        int verticesPerQuad() const { return fInstanced ? 1 : (fUsesCoverageAA ? 8 : 4); }
     private:
         static_assert(kGrQuadTypeCount <= 4, "GrQuadType doesn't fit in 2 bits");
         static_assert(kColorTypeCount <= 4, "Color doesn't fit in 2 bits");
@@ -77,6 +94,7 @@ namespace GrQuadPerEdgeAA {
         // The geometry domain serves to clip off pixels touched by quads with sharp corners that
         // would otherwise exceed the miter limit for the AA-outset geometry.
         unsigned fRequiresGeometryDomain: 1;
+        unsigned fInstanced: 1;
     };
 
     sk_sp<GrGeometryProcessor> MakeProcessor(const VertexSpec& spec);
@@ -99,13 +117,15 @@ namespace GrQuadPerEdgeAA {
                      const SkPMColor4f& color, const GrPerspQuad& localQuad, const SkRect& domain,
                      GrQuadAAFlags aa);
 
-    // The mesh will have its index data configured to meet the expectations of the Tessellate()
-    // function, but it the calling code must handle filling a vertex buffer via Tessellate() and
-    // then assigning it to the returned mesh.
+    // The mesh will be configured to draw quadCount quads that Tessellate() wrote to the buffer,
+    // starting at vertexOffset. When the spec is instanced, that buffer supplies the instances and
+    // the mesh draws them over a shared buffer of corners; otherwise it supplies the vertices,
+    // with index data to meet the expectations of Tessellate(). Vertex sizes come from the GP's
+    // instanceStride() or vertexStride() respectively.
     //
-    // Returns false if the index data could not be allocated.
-    bool ConfigureMeshIndices(GrMeshDrawOp::Target* target, GrMesh* mesh, const VertexSpec& spec,
-                              int quadCount);
+    // Returns false if the index or corner data could not be allocated.
+    bool ConfigureMesh(GrMeshDrawOp::Target* target, GrMesh* mesh, const VertexSpec& spec,
+                       int quadCount, sk_sp<const GrBuffer> vertexBuffer, int vertexOffset);
 
     static constexpr int kNumAAQuadsInIndexBuffer = 512;
 
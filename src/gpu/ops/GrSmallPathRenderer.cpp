@@ -209,6 +209,7 @@ GrPathRenderer::CanDrawPath GrSmallPathRenderer::onCanDrawPath(const CanDrawPath
     SkScalar minSize = minDim * SkScalarAbs(scaleFactors[0]);
     SkScalar maxSize = maxDim * SkScalarAbs(scaleFactors[1]);
     if (maxDim > kMaxDim || kMinSize > minSize || maxSize > kMaxSize) {
+        args.fRejectReason = maxDim > kMaxDim || maxSize > kMaxSize ? "too large" : "too small";
         return CanDrawPath::kNo;
     }
 
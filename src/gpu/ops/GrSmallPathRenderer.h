@@ -27,6 +27,8 @@ public:
     GrSmallPathRenderer();
     ~GrSmallPathRenderer() override;
 
+    const char* name() const override { return "small"; }
+
     // GrOnFlushCallbackObject overrides
     //
     // Note: because this class is associated with a path renderer we want it to be removed from
@@ -22,6 +22,7 @@ public:
 
     static GrPathRenderer* Create(GrResourceProvider*, const GrCaps&);
 
+    const char* name() const override { return "nvpr"; }
 
 private:
     StencilSupport onGetStencilSupport(const GrShape&) const override {
@@ -6,18 +6,28 @@
  */
 
 #include "src/gpu/ops/GrTessellatingPathRenderer.h"
+#include <cmath>
 #include <stdio.h>
+#include "include/core/SkTime.h"
 #include "include/private/GrAuditTrail.h"
+#include "include/private/SkSemaphore.h"
+#include "src/core/SkAutoMalloc.h"
 #include "src/core/SkGeometry.h"
+#include "src/core/SkTaskGroup.h"
+#include "src/core/SkTraceEvent.h"
 #include "src/gpu/GrCaps.h"
 #include "src/gpu/GrClip.h"
+#include "src/gpu/GrContextPriv.h"
 #include "src/gpu/GrDefaultGeoProcFactory.h"
 #include "src/gpu/GrDrawOpTest.h"
+#include "src/gpu/GrGpu.h"
 #include "src/gpu/GrMesh.h"
 #include "src/gpu/GrOpFlushState.h"
 #include "src/gpu/GrPathUtils.h"
+#include "src/gpu/GrRecordingContextPriv.h"
 #include "src/gpu/GrResourceCache.h"
 #include "src/gpu/GrResourceProvider.h"
+#include "src/gpu/GrResourceProviderPriv.h"
 #include "src/gpu/GrShape.h"
 #include "src/gpu/GrStyle.h"
 #include "src/gpu/GrTessellator.h"
@@ -28,6 +38,12 @@
 #define GR_AA_TESSELLATOR_MAX_VERB_COUNT 10
 #endif
 
+// Paths with at least this many verbs are tessellated on GrContextOptions::fExecutor, if there is
+// one.
+#ifndef GR_TESSELLATOR_THREADED_MIN_VERB_COUNT
+#define GR_TESSELLATOR_THREADED_MIN_VERB_COUNT 1000
+#endif
+
 /*
  * This path renderer tessellates the path into triangles using GrTessellator, uploads the
  * triangles to a vertex buffer, and renders them with a single draw call. It can do screenspace
@@ -36,7 +52,6 @@
 namespace {
 
 struct TessInfo {
-    SkScalar  fTolerance;
     int       fCount;
 };
 
@@ -54,18 +69,34 @@ private:
     }
 };
 
-bool cache_match(GrGpuBuffer* vertexBuffer, SkScalar tol, int* actualCount) {
+bool cache_match(GrGpuBuffer* vertexBuffer, int* actualCount) {
     if (!vertexBuffer) {
         return false;
     }
     const SkData* data = vertexBuffer->getUniqueKey().getCustomData();
     SkASSERT(data);
     const TessInfo* info = static_cast<const TessInfo*>(data->data());
-    if (info->fTolerance == 0 || info->fTolerance < 3.0f * tol) {
-        *actualCount = info->fCount;
-        return true;
+    *actualCount = info->fCount;
+    return true;
+}
+
+// Cached tessellations are in source space, so they can be reused under any matrix that needs
+// about the same tolerance, e.g. as a path rotates or translates. The tolerance is rounded down
+// to a power of two, and the exponent goes in the key. Paths without curves tessellate the same
+// at any tolerance, so they all share one bucket.
+static constexpr int32_t kLinearToleranceBucket = SK_MinS32;
+
+int32_t tolerance_bucket(const SkPath& path, SkScalar* tol) {
+    if (SkPath::kLine_SegmentMask == path.getSegmentMasks()) {
+        return kLinearToleranceBucket;
+    }
+    if (!SkScalarIsFinite(*tol) || *tol <= 0) {
+        return SK_MaxS32;
     }
-    return false;
+    int exp;
+    frexpf(*tol, &exp);
+    *tol = ldexpf(1, exp - 1);
+    return exp - 1;
 }
 
 class StaticVertexAllocator : public GrTessellator::VertexAllocator {
@@ -135,6 +166,75 @@ private:
     void* fVertices;
 };
 
+// Tessellates a path on a worker thread into plain memory, for an op to copy into a vertex buffer
+// once it is prepared. The vertex layout only depends on whether the path is antialiased.
+class DeferredTessellation {
+public:
+    DeferredTessellation(const SkPath& path, SkScalar tol, const SkRect& clipBounds,
+                         bool antialias)
+            : fPath(path)
+            , fTolerance(tol)
+            , fClipBounds(clipBounds)
+            , fAntiAlias(antialias) {}
+
+    ~DeferredTessellation() { this->wait(); }
+
+    void run() {
+        TRACE_EVENT0("skia", "Threaded Tessellation");
+        size_t stride = sizeof(SkPoint) + (fAntiAlias ? sizeof(float) : 0);
+        MallocVertexAllocator allocator(stride, &fVertices);
+        bool isLinear;
+        fCount = GrTessellator::PathToTriangles(fPath, fTolerance, fClipBounds, &allocator,
+                                                fAntiAlias, &isLinear);
+        fPath.reset();
+        fDone.signal();
+    }
+
+    // Waits for run() to finish, then copies the vertices out.
+    int copyTo(GrTessellator::VertexAllocator* allocator) {
+        this->wait();
+        if (fCount == 0) {
+            return 0;
+        }
+        SkASSERT(allocator->stride() == sizeof(SkPoint) + (fAntiAlias ? sizeof(float) : 0));
+        void* vertices = allocator->lock(fCount);
+        if (!vertices) {
+            return 0;
+        }
+        memcpy(vertices, fVertices.get(), fCount * allocator->stride());
+        allocator->unlock(fCount);
+        return fCount;
+    }
+
+private:
+    class MallocVertexAllocator : public GrTessellator::VertexAllocator {
+    public:
+        MallocVertexAllocator(size_t stride, SkAutoMalloc* storage)
+                : VertexAllocator(stride), fStorage(storage) {}
+        void* lock(int vertexCount) override { return fStorage->reset(vertexCount * stride()); }
+        void unlock(int actualCount) override {}
+
+    private:
+        SkAutoMalloc* fStorage;
+    };
+
+    void wait() {
+        if (!fWaited) {
+            fDone.wait();
+            fWaited = true;
+        }
+    }
+
+    SkPath       fPath;
+    SkScalar     fTolerance;
+    SkRect       fClipBounds;
+    bool         fAntiAlias;
+    SkAutoMalloc fVertices;
+    int          fCount = 0;
+    SkSemaphore  fDone;
+    bool         fWaited = false;
+};
+
 }  // namespace
 
 GrTessellatingPathRenderer::GrTessellatingPathRenderer()
@@ -163,6 +263,7 @@ GrTessellatingPathRenderer::onCanDrawPath(const CanDrawPathArgs& args) const {
         SkPath path;
         args.fShape->asPath(&path);
         if (path.countVerbs() > fMaxVerbCount) {
+            args.fRejectReason = "too many verbs";
             return CanDrawPath::kNo;
         }
     }
@@ -242,6 +343,29 @@ public:
                 caps, clip, fsaaType, clampType, coverage, &fColor, nullptr);
     }
 
+    // Starts tessellating large paths on a worker thread, so that onPrepareDraws only has to wait
+    // for the result. Nothing is started if the tessellation is already in the cache.
+    void tessellateOnTaskGroup(SkTaskGroup* taskGroup, GrResourceProvider* resourceProvider) {
+        SkPath path;
+        SkScalar tol;
+        SkRect clipBounds;
+        int32_t toleranceBucket;
+        if (this->getPath().countVerbs() < GR_TESSELLATOR_THREADED_MIN_VERB_COUNT ||
+            !this->getTessellationArgs(&path, &tol, &clipBounds, &toleranceBucket)) {
+            return;
+        }
+        if (!fAntiAlias) {
+            GrUniqueKey key;
+            this->makeKey(toleranceBucket, &key);
+            if (resourceProvider->findByUniqueKey<GrGpuBuffer>(key)) {
+                return;
+            }
+        }
+        fDeferredTessellation.reset(new DeferredTessellation(path, tol, clipBounds, fAntiAlias));
+        DeferredTessellation* deferredTessellation = fDeferredTessellation.get();
+        taskGroup->add([deferredTessellation] { deferredTessellation->run(); });
+    }
+
 private:
     SkPath getPath() const {
         SkASSERT(!fShape.style().applies());
@@ -250,53 +374,93 @@ private:
         return path;
     }
 
-    void draw(Target* target, sk_sp<const GrGeometryProcessor> gp, size_t vertexStride) {
-        SkASSERT(!fAntiAlias);
-        GrResourceProvider* rp = target->resourceProvider();
-        bool inverseFill = fShape.inverseFilled();
-        // construct a cache key from the path's genID and the view matrix
+    // Computes what to pass to GrTessellator::PathToTriangles. Without AA the tessellation is in
+    // source space so that it can be cached; with AA it's in device space.
+    bool getTessellationArgs(SkPath* path, SkScalar* tol, SkRect* clipBounds,
+                             int32_t* toleranceBucket) const {
+        *path = this->getPath();
+        *clipBounds = SkRect::Make(fDevClipBounds);
+        if (fAntiAlias) {
+            path->transform(fViewMatrix);
+            *tol = GrPathUtils::kDefaultTolerance;
+            *toleranceBucket = 0;
+            return true;
+        }
+        *tol = GrPathUtils::scaleToleranceToSrc(GrPathUtils::kDefaultTolerance, fViewMatrix,
+                                                fShape.bounds());
+        *toleranceBucket = tolerance_bucket(*path, tol);
+        SkMatrix vmi;
+        if (!fViewMatrix.invert(&vmi)) {
+            return false;
+        }
+        vmi.mapRect(clipBounds);
+        return true;
+    }
+
+    // Construct a cache key from the path's genID and the tolerance bucket.
+    void makeKey(int32_t toleranceBucket, GrUniqueKey* key) const {
         static const GrUniqueKey::Domain kDomain = GrUniqueKey::GenerateDomain();
-        GrUniqueKey key;
         static constexpr int kClipBoundsCnt = sizeof(fDevClipBounds) / sizeof(uint32_t);
         int shapeKeyDataCnt = fShape.unstyledKeySize();
         SkASSERT(shapeKeyDataCnt >= 0);
-        GrUniqueKey::Builder builder(&key, kDomain, shapeKeyDataCnt + kClipBoundsCnt, "Path");
+        GrUniqueKey::Builder builder(key, kDomain, shapeKeyDataCnt + kClipBoundsCnt + 1, "Path");
         fShape.writeUnstyledKey(&builder[0]);
         // For inverse fills, the tessellation is dependent on clip bounds.
-        if (inverseFill) {
+        if (fShape.inverseFilled()) {
             memcpy(&builder[shapeKeyDataCnt], &fDevClipBounds, sizeof(fDevClipBounds));
         } else {
             memset(&builder[shapeKeyDataCnt], 0, sizeof(fDevClipBounds));
         }
+        builder[shapeKeyDataCnt + kClipBoundsCnt] = toleranceBucket;
         builder.finish();
+    }
+
+    int tessellate(const SkPath& path, SkScalar tol, const SkRect& clipBounds,
+                   GrTessellator::VertexAllocator* allocator) {
+        if (fDeferredTessellation) {
+            return fDeferredTessellation->copyTo(allocator);
+        }
+        bool isLinear;
+        return GrTessellator::PathToTriangles(path, tol, clipBounds, allocator, fAntiAlias,
+                                              &isLinear);
+    }
+
+    void draw(Target* target, sk_sp<const GrGeometryProcessor> gp, size_t vertexStride) {
+        SkASSERT(!fAntiAlias);
+        GrResourceProvider* rp = target->resourceProvider();
+        SkPath path;
+        SkScalar tol;
+        SkRect clipBounds;
+        int32_t toleranceBucket;
+        bool canTessellate = this->getTessellationArgs(&path, &tol, &clipBounds, &toleranceBucket);
+        GrUniqueKey key;
+        this->makeKey(toleranceBucket, &key);
         sk_sp<GrGpuBuffer> cachedVertexBuffer(rp->findByUniqueKey<GrGpuBuffer>(key));
         int actualCount;
-        SkScalar tol = GrPathUtils::kDefaultTolerance;
-        tol = GrPathUtils::scaleToleranceToSrc(tol, fViewMatrix, fShape.bounds());
-        if (cache_match(cachedVertexBuffer.get(), tol, &actualCount)) {
+        GrGpu::Stats* stats = rp->priv().gpu()->stats();
+        if (cache_match(cachedVertexBuffer.get(), &actualCount)) {
+            stats->incNumTessellationCacheHits();
             this->drawVertices(target, std::move(gp), std::move(cachedVertexBuffer), 0,
                                actualCount);
             return;
         }
+        stats->incNumTessellationCacheMisses();
 
-        SkRect clipBounds = SkRect::Make(fDevClipBounds);
-
-        SkMatrix vmi;
-        if (!fViewMatrix.invert(&vmi)) {
+        if (!canTessellate) {
             return;
         }
-        vmi.mapRect(&clipBounds);
-        bool isLinear;
         bool canMapVB = GrCaps::kNone_MapFlags != target->caps().mapBufferFlags();
         StaticVertexAllocator allocator(vertexStride, rp, canMapVB);
-        int count = GrTessellator::PathToTriangles(getPath(), tol, clipBounds, &allocator, false,
-                                                   &isLinear);
+        double startNSecs = SkTime::GetNSecs();
+        int count = this->tessellate(path, tol, clipBounds, &allocator);
         if (count == 0) {
             return;
         }
         sk_sp<GrGpuBuffer> vb = allocator.detachVertexBuffer();
+        // Tessellations are costly to redo, so let a cost-aware cache hold on to them.
+        vb->resourcePriv().setRebuildCostHint(
+                static_cast<float>((SkTime::GetNSecs() - startNSecs) / 1000));
         TessInfo info;
-        info.fTolerance = isLinear ? 0 : tol;
         info.fCount = count;
         fShape.addGenIDChangeListener(sk_make_sp<PathInvalidator>(key, target->contextUniqueID()));
         key.setCustomData(SkData::MakeWithCopy(&info, sizeof(info)));
@@ -307,17 +471,16 @@ private:
 
     void drawAA(Target* target, sk_sp<const GrGeometryProcessor> gp, size_t vertexStride) {
         SkASSERT(fAntiAlias);
-        SkPath path = getPath();
+        SkPath path;
+        SkScalar tol;
+        SkRect clipBounds;
+        int32_t toleranceBucket;
+        this->getTessellationArgs(&path, &tol, &clipBounds, &toleranceBucket);
         if (path.isEmpty()) {
             return;
         }
-        SkRect clipBounds = SkRect::Make(fDevClipBounds);
-        path.transform(fViewMatrix);
-        SkScalar tol = GrPathUtils::kDefaultTolerance;
-        bool isLinear;
         DynamicVertexAllocator allocator(vertexStride, target);
-        int count = GrTessellator::PathToTriangles(path, tol, clipBounds, &allocator, true,
-                                                   &isLinear);
+        int count = this->tessellate(path, tol, clipBounds, &allocator);
         if (count == 0) {
             return;
         }
@@ -384,6 +547,7 @@ private:
     SkMatrix                fViewMatrix;
     SkIRect                 fDevClipBounds;
     bool                    fAntiAlias;
+    std::unique_ptr<DeferredTessellation> fDeferredTessellation;
 
     typedef GrMeshDrawOp INHERITED;
 };
@@ -406,6 +570,11 @@ bool GrTessellatingPathRenderer::onDrawPath(const DrawPathArgs& args) {
     std::unique_ptr<GrDrawOp> op = TessellatingPathOp::Make(
             args.fContext, std::move(args.fPaint), *args.fShape, *args.fViewMatrix, clipBoundsI,
             aaType, args.fUserStencilSettings);
+    auto direct = args.fContext->priv().asDirectContext();
+    if (op && direct && direct->priv().getTaskGroup()) {
+        op->cast<TessellatingPathOp>()->tessellateOnTaskGroup(direct->priv().getTaskGroup(),
+                                                              direct->priv().resourceProvider());
+    }
     args.fRenderTargetContext->addDrawOp(*args.fClip, std::move(op));
     return true;
 }
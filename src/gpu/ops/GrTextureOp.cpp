@@ -445,8 +445,10 @@ private:
             }
         }
 
+        bool instanced = GrQuadPerEdgeAA::CanDrawInstanced(target->caps(), quadType, srcQuadType,
+                                                           aaType);
         VertexSpec vertexSpec(quadType, colorType, srcQuadType, /* hasLocal */ true, domain, aaType,
-                              /* alpha as coverage */ true);
+                              /* alpha as coverage */ true, instanced);
 
         GrSamplerState samplerState = GrSamplerState(GrSamplerState::WrapMode::kClamp,
                                                      this->filter());
@@ -471,7 +473,8 @@ private:
             fixedDynamicState->fPrimitiveProcessorTextures[0] = fProxies[0].fProxy;
         }
 
-        size_t vertexSize = gp->vertexStride();
+        // When instanced, each "vertex" in the buffer is a whole quad.
+        size_t vertexSize = instanced ? gp->instanceStride() : gp->vertexStride();
 
         GrMesh* meshes = target->allocMeshes(numProxies);
         sk_sp<const GrBuffer> vbuffer;
@@ -501,12 +504,11 @@ private:
 
                 op.tess(vdata, vertexSpec, proxy, q, quadCnt);
 
-                if (!GrQuadPerEdgeAA::ConfigureMeshIndices(target, &(meshes[m]), vertexSpec,
-                                                           quadCnt)) {
+                if (!GrQuadPerEdgeAA::ConfigureMesh(target, &(meshes[m]), vertexSpec, quadCnt,
+                                                    vbuffer, vertexOffsetInBuffer)) {
                     SkDebugf("Could not allocate indices");
                     return;
                 }
-                meshes[m].setVertexData(vbuffer, vertexOffsetInBuffer);
                 if (dynamicStateArrays) {
                     dynamicStateArrays->fPrimitiveProcessorTextures[m] = proxy;
                 }
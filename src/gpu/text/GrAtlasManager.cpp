@@ -67,6 +67,18 @@ void GrAtlasManager::addGlyphToBulkAndSetUseToken(GrDrawOpAtlas::BulkUseTokenUpd
     }
 }
 
+void GrAtlasManager::dumpMemoryStatistics(SkTraceMemoryDump* traceMemoryDump) const {
+    static const char* kFormatNames[] = { "a8", "a565", "argb" };
+    static_assert(SK_ARRAY_COUNT(kFormatNames) == kMaskFormatCount, "array_size_mismatch");
+
+    for (int i = 0; i < kMaskFormatCount; ++i) {
+        if (fAtlases[i]) {
+            SkString dumpName = SkStringPrintf("skia/gr_glyph_atlas/%s", kFormatNames[i]);
+            fAtlases[i]->dumpMemoryStatistics(traceMemoryDump, dumpName.c_str());
+        }
+    }
+}
+
 #ifdef SK_DEBUG
 #include "include/private/GrSurfaceProxy.h"
 #include "include/private/GrTextureProxy.h"
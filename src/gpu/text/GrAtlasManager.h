@@ -15,6 +15,7 @@
 
 struct GrGlyph;
 class GrTextStrike;
+class SkTraceMemoryDump;
 
 //////////////////////////////////////////////////////////////////////////////////////////////////
 /** The GrAtlasManager manages the lifetime of and access to GrDrawOpAtlases.
@@ -105,6 +106,9 @@ public:
         }
     }
 
+    // Dumps the occupancy of each glyph atlas page under "skia/gr_glyph_atlas/<format>".
+    void dumpMemoryStatistics(SkTraceMemoryDump*) const;
+
     // The AtlasGlyph cache always survives freeGpuResources so we want it to remain in the active
     // OnFlushCallbackObject list
     bool retainOnFreeGpuResources() override { return true; }
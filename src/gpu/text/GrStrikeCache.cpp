@@ -5,6 +5,8 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkStream.h"
+#include "include/core/SkTypeface.h"
 #include "include/private/GrColor.h"
 #include "src/gpu/GrCaps.h"
 #include "src/gpu/GrDistanceFieldGenFromVector.h"
@@ -14,10 +16,12 @@
 #include "src/core/SkAutoMalloc.h"
 #include "src/core/SkDistanceFieldGen.h"
 
-GrStrikeCache::GrStrikeCache(const GrCaps* caps, size_t maxTextureBytes)
+GrStrikeCache::GrStrikeCache(const GrCaps* caps, size_t maxTextureBytes,
+                             GrContextOptions::PersistentCache* distanceFieldGlyphCache)
         : fPreserveStrike(nullptr)
         , f565Masks(SkMasks::CreateMasks({0xF800, 0x07E0, 0x001F, 0},
-                    GrMaskFormatBytesPerPixel(kA565_GrMaskFormat))) { }
+                    GrMaskFormatBytesPerPixel(kA565_GrMaskFormat)))
+        , fDistanceFieldGlyphCache(distanceFieldGlyphCache) { }
 
 GrStrikeCache::~GrStrikeCache() {
     StrikeHash::Iter iter(&fCache);
@@ -184,6 +188,35 @@ void GrTextStrike::removeID(GrDrawOpAtlas::AtlasID id) {
     }
 }
 
+// Bump this whenever the distance field generators change what they produce, so that images
+// stored by an older build are no longer found.
+static constexpr uint32_t kDistanceFieldGlyphKeyVersion = 1;
+
+sk_sp<SkData> GrTextStrike::distanceFieldGlyphKey(SkStrike* skStrike, SkPackedGlyphID id) {
+    if (!fDistanceFieldKeyPrefix) {
+        const SkScalerContext* context = skStrike->getScalerContext();
+        SkDynamicMemoryWStream stream;
+        stream.write32(SkSetFourByteTag('s', 'd', 'f', 'g'));
+        stream.write32(kDistanceFieldGlyphKeyVersion);
+        stream.write32(SK_DistanceFieldMagnitude);
+        stream.write32(SK_DistanceFieldPad);
+        // The font ID is only meaningful within this process; the typeface's descriptor names it.
+        SkScalerContextRec rec = context->getRec();
+        rec.fFontID = 0;
+        stream.write(&rec, sizeof(rec));
+        context->getTypeface()->serialize(&stream, SkTypeface::SerializeBehavior::kDontIncludeData);
+        fDistanceFieldKeyPrefix = stream.detachAsData();
+    }
+
+    size_t prefixSize = fDistanceFieldKeyPrefix->size();
+    uint32_t packedID = id.value();
+    sk_sp<SkData> key = SkData::MakeUninitialized(prefixSize + sizeof(packedID));
+    char* bytes = static_cast<char*>(key->writable_data());
+    memcpy(bytes, fDistanceFieldKeyPrefix->data(), prefixSize);
+    memcpy(bytes + prefixSize, &packedID, sizeof(packedID));
+    return key;
+}
+
 GrDrawOpAtlas::ErrorCode GrTextStrike::addGlyphToAtlas(
                                    GrResourceProvider* resourceProvider,
                                    GrDeferredUploadTarget* target,
@@ -221,10 +254,29 @@ GrDrawOpAtlas::ErrorCode GrTextStrike::addGlyphToAtlas(
         sk_bzero(dataPtr, size);
         dataPtr = (char*)(dataPtr) + rowBytes + bytesPerPixel;
     }
-    if (!get_packed_glyph_image(skStrikeCache, skGlyph, glyph->width(), glyph->height(),
-                                rowBytes, expectedMaskFormat,
-                                dataPtr, glyphCache->getMasks())) {
-        return GrDrawOpAtlas::ErrorCode::kError;
+
+    // Distance fields are costly to generate, so look for one made by an earlier run first.
+    GrContextOptions::PersistentCache* distanceFieldCache = glyphCache->distanceFieldGlyphCache();
+    sk_sp<SkData> cacheKey;
+    bool foundInCache = false;
+    if (isSDFGlyph && distanceFieldCache && SkMask::kSDF_Format == skGlyph.fMaskFormat) {
+        cacheKey = this->distanceFieldGlyphKey(skStrikeCache, glyph->fPackedID);
+        sk_sp<SkData> cached = distanceFieldCache->load(*cacheKey);
+        if (cached && cached->size() == size) {
+            memcpy(dataPtr, cached->data(), size);
+            foundInCache = true;
+        }
+    }
+
+    if (!foundInCache) {
+        if (!get_packed_glyph_image(skStrikeCache, skGlyph, glyph->width(), glyph->height(),
+                                    rowBytes, expectedMaskFormat,
+                                    dataPtr, glyphCache->getMasks())) {
+            return GrDrawOpAtlas::ErrorCode::kError;
+        }
+        if (cacheKey) {
+            distanceFieldCache->store(*cacheKey, *SkData::MakeWithoutCopy(dataPtr, size));
+        }
     }
 
     GrDrawOpAtlas::ErrorCode result = fullAtlasManager->addToAtlas(
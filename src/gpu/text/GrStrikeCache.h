@@ -8,6 +8,7 @@
 #ifndef GrStrikeCache_DEFINED
 #define GrStrikeCache_DEFINED
 
+#include "include/gpu/GrContextOptions.h"
 #include "src/codec/SkMasks.h"
 #include "src/core/SkArenaAlloc.h"
 #include "src/core/SkStrike.h"
@@ -82,9 +83,15 @@ public:
     static uint32_t Hash(const SkDescriptor& desc) { return desc.getChecksum(); }
 
 private:
+    // Returns the key under which the distance field image of 'id' is kept in the context's
+    // distance field glyph cache. Unlike the strike's descriptor it doesn't depend on the
+    // typeface's unique ID, so it stays the same from one run to the next.
+    sk_sp<SkData> distanceFieldGlyphKey(SkStrike*, SkPackedGlyphID id);
+
     SkTDynamicHash<GrGlyph, SkPackedGlyphID> fCache;
     SkAutoDescriptor fFontScalerKey;
     SkArenaAlloc fAlloc{512};
+    sk_sp<SkData> fDistanceFieldKeyPrefix;
 
     int fAtlasedGlyphs{0};
     bool fIsAbandoned{false};
@@ -98,7 +105,8 @@ private:
  */
 class GrStrikeCache {
 public:
-    GrStrikeCache(const GrCaps* caps, size_t maxTextureBytes);
+    GrStrikeCache(const GrCaps* caps, size_t maxTextureBytes,
+                  GrContextOptions::PersistentCache* distanceFieldGlyphCache = nullptr);
     ~GrStrikeCache();
 
     void setStrikeToPreserve(GrTextStrike* strike) { fPreserveStrike = strike; }
@@ -117,6 +125,10 @@ public:
 
     const SkMasks& getMasks() const { return *f565Masks; }
 
+    GrContextOptions::PersistentCache* distanceFieldGlyphCache() const {
+        return fDistanceFieldGlyphCache;
+    }
+
     void freeAll();
 
     static void HandleEviction(GrDrawOpAtlas::AtlasID, void*);
@@ -134,6 +146,7 @@ private:
     StrikeHash fCache;
     GrTextStrike* fPreserveStrike;
     std::unique_ptr<const SkMasks> f565Masks;
+    GrContextOptions::PersistentCache* fDistanceFieldGlyphCache;
 };
 
 #endif  // GrStrikeCache_DEFINED
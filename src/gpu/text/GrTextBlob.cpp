@@ -451,3 +451,9 @@ void GrTextBlob::SubRun::computeTranslation(const SkMatrix& viewMatrix,
     fX = x;
     fY = y;
 }
+
+void GrTextBlob::SubRun::translation(const SkMatrix& viewMatrix, SkScalar x, SkScalar y,
+                                     SkScalar* transX, SkScalar* transY) const {
+    calculate_translation(!this->drawAsDistanceFields() && !this->isFallback(), viewMatrix,
+            x, y, fCurrentViewMatrix, fX, fY, transX, transY);
+}
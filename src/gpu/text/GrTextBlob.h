@@ -210,6 +210,17 @@ public:
         }
     }
 
+    // Bitmap text vertices are only moved on the CPU when a sub run is drawn somewhere new. This
+    // returns how far a draw at (x, y) with viewMatrix is from where the vertices were last left,
+    // without moving them, so that the offset can be applied on the GPU instead.
+    SkVector subRunTranslation(int runIndex, int subRunIndex, const SkMatrix& viewMatrix,
+                               SkScalar x, SkScalar y) const {
+        SkVector translation;
+        fRuns[runIndex].fSubRunInfo[subRunIndex].translation(viewMatrix, x, y,
+                                                             &translation.fX, &translation.fY);
+        return translation;
+    }
+
     // position + local coord
     static const size_t kColorTextVASize = sizeof(SkPoint) + sizeof(SkIPoint16);
     static const size_t kColorTextPerspectiveVASize = sizeof(SkPoint3) + sizeof(SkIPoint16);
@@ -335,6 +346,10 @@ private:
         void computeTranslation(const SkMatrix& viewMatrix, SkScalar x, SkScalar y,
                                 SkScalar* transX, SkScalar* transY);
 
+        // Like computeTranslation, but for when the vertices will be left where they are.
+        void translation(const SkMatrix& viewMatrix, SkScalar x, SkScalar y,
+                         SkScalar* transX, SkScalar* transY) const;
+
         // df properties
         void setDrawAsDistanceFields() { fFlags.drawAsSdf = true; }
         bool drawAsDistanceFields() const { return fFlags.drawAsSdf; }
@@ -347,7 +362,7 @@ private:
         void setNeedsTransform(bool needsTransform) { fFlags.needsTransform = needsTransform; }
         bool needsTransform() const { return fFlags.needsTransform; }
         void setFallback() { fFlags.argbFallback = true; }
-        bool isFallback() { return fFlags.argbFallback; }
+        bool isFallback() const { return fFlags.argbFallback; }
 
         const SkStrikeSpecStorage& strikeSpec() const { return fStrikeSpec; }
 
@@ -594,10 +609,14 @@ public:
      * SkAutoGlyphCache is reused then it can save the cost of multiple detach/attach operations of
      * SkGlyphCache.
      */
+    /**
+     * If translateOnGpu is set the vertex positions are left untouched, and the caller is
+     * responsible for offsetting them by subRunTranslation() when drawing.
+     */
     VertexRegenerator(GrResourceProvider*, GrTextBlob*, int runIdx, int subRunIdx,
                       const SkMatrix& viewMatrix, SkScalar x, SkScalar y, GrColor color,
                       GrDeferredUploadTarget*, GrStrikeCache*, GrAtlasManager*,
-                      SkExclusiveStrikePtr*);
+                      SkExclusiveStrikePtr*, bool translateOnGpu = false);
 
     struct Result {
         /**
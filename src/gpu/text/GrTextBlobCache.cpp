@@ -60,6 +60,20 @@ void GrTextBlobCache::purgeStaleBlobs() {
     }
 }
 
+size_t GrTextBlobCache::purgeBytes(size_t bytes) {
+    size_t startSize = fCurrentSize;
+    BitmapBlobList::Iter iter;
+    iter.init(fBlobList, BitmapBlobList::Iter::kTail_IterStart);
+    GrTextBlob* lruBlob;
+    while (startSize - fCurrentSize < bytes && (lruBlob = iter.get())) {
+        // Backup the iterator before removing and unrefing the blob
+        iter.prev();
+
+        this->remove(lruBlob);
+    }
+    return startSize - fCurrentSize;
+}
+
 void GrTextBlobCache::checkPurge(GrTextBlob* blob) {
     // First, purge all stale blob IDs.
     this->purgeStaleBlobs();
@@ -107,6 +107,10 @@ public:
 
     void purgeStaleBlobs();
 
+    // Purges the least recently used blobs until at least 'bytes' have been freed, or the cache is
+    // empty. Returns the number of bytes freed.
+    size_t purgeBytes(size_t bytes);
+
     size_t usedBytes() const { return fCurrentSize; }
 
 private:
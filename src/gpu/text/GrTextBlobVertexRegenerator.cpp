@@ -123,7 +123,8 @@ GrTextBlob::VertexRegenerator::VertexRegenerator(GrResourceProvider* resourcePro
                                                  GrDeferredUploadTarget* uploadTarget,
                                                  GrStrikeCache* glyphCache,
                                                  GrAtlasManager* fullAtlasManager,
-                                                 SkExclusiveStrikePtr* lazyStrike)
+                                                 SkExclusiveStrikePtr* lazyStrike,
+                                                 bool translateOnGpu)
         : fResourceProvider(resourceProvider)
         , fViewMatrix(viewMatrix)
         , fBlob(blob)
@@ -134,7 +135,11 @@ GrTextBlob::VertexRegenerator::VertexRegenerator(GrResourceProvider* resourcePro
         , fSubRun(&blob->fRuns[runIdx].fSubRunInfo[subRunIdx])
         , fColor(color) {
     // Compute translation if any
-    fSubRun->computeTranslation(fViewMatrix, x, y, &fTransX, &fTransY);
+    if (translateOnGpu) {
+        fTransX = fTransY = 0;
+    } else {
+        fSubRun->computeTranslation(fViewMatrix, x, y, &fTransX, &fTransY);
+    }
 
     // Because the GrStrikeCache may evict the strike a blob depends on using for
     // generating its texture coords, we have to track whether or not the strike has
@@ -1345,8 +1345,7 @@ sk_sp<GrRenderTarget> GrVkGpu::onWrapVulkanSecondaryCBAsRenderTarget(
     return GrVkRenderTarget::MakeSecondaryCBRenderTarget(this, desc, vkInfo);
 }
 
-bool GrVkGpu::onRegenerateMipMapLevels(GrTexture* tex) {
-    auto* vkTex = static_cast<GrVkTexture*>(tex);
+bool GrVkGpu::canBlitMipMapLevels(const GrVkTexture* vkTex) const {
     // don't do anything for linearly tiled textures (can't have mipmaps)
     if (vkTex->isLinearTiled()) {
         SkDebugf("Trying to create mipmap for linear tiled texture");
@@ -1355,27 +1354,56 @@ bool GrVkGpu::onRegenerateMipMapLevels(GrTexture* tex) {
 
     // determine if we can blit to and from this format
     const GrVkCaps& caps = this->vkCaps();
-    if (!caps.formatCanBeDstofBlit(vkTex->imageFormat(), false) ||
-        !caps.formatCanBeSrcofBlit(vkTex->imageFormat(), false) ||
-        !caps.mipMapSupport()) {
+    return caps.formatCanBeDstofBlit(vkTex->imageFormat(), false) &&
+           caps.formatCanBeSrcofBlit(vkTex->imageFormat(), false) &&
+           caps.mipMapSupport();
+}
+
+bool GrVkGpu::onRegenerateMipMapLevels(GrTexture* tex) {
+    auto* vkTex = static_cast<GrVkTexture*>(tex);
+    if (!this->canBlitMipMapLevels(vkTex)) {
         return false;
     }
+    this->blitMipMapLevels(&vkTex, 1);
+    return true;
+}
 
-    int width = tex->width();
-    int height = tex->height();
-    VkImageBlit blitRegion;
-    memset(&blitRegion, 0, sizeof(VkImageBlit));
+void GrVkGpu::regenerateMipMapLevelsBatch(GrVkTexture* const textures[], int count) {
+    SkSTArray<8, GrVkTexture*> blitTextures;
+    for (int i = 0; i < count; ++i) {
+        GrVkTexture* vkTex = textures[i];
+        SkASSERT(vkTex->texturePriv().mipMapped() == GrMipMapped::kYes);
+        // A texture may be listed more than once, but only the first one finds it dirty.
+        if (!vkTex->texturePriv().mipMapsAreDirty() || vkTex->readOnly() ||
+            !this->canBlitMipMapLevels(vkTex)) {
+            continue;
+        }
+        SkASSERT(!vkTex->asRenderTarget() || !vkTex->asRenderTarget()->needsResolve());
+        vkTex->texturePriv().markMipMapsClean();
+        blitTextures.push_back(vkTex);
+    }
+    if (blitTextures.count()) {
+        this->blitMipMapLevels(blitTextures.begin(), blitTextures.count());
+        fStats.incNumMipMapRegenerations(blitTextures.count());
+    }
+}
 
-    // SkMipMap doesn't include the base level in the level count so we have to add 1
-    uint32_t levelCount = SkMipMap::ComputeLevelCount(tex->width(), tex->height()) + 1;
-    SkASSERT(levelCount == vkTex->mipLevels());
+void GrVkGpu::blitMipMapLevels(GrVkTexture* const textures[], int count) {
+    uint32_t maxLevelCount = 0;
+    for (int i = 0; i < count; ++i) {
+        GrVkTexture* vkTex = textures[i];
+        // SkMipMap doesn't include the base level in the level count so we have to add 1
+        SkASSERT(SkMipMap::ComputeLevelCount(vkTex->width(), vkTex->height()) + 1 ==
+                 (int)vkTex->mipLevels());
+        maxLevelCount = SkTMax(maxLevelCount, vkTex->mipLevels());
 
-    // change layout of the layers so we can write to them.
-    vkTex->setImageLayout(this, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_ACCESS_TRANSFER_WRITE_BIT,
-                          VK_PIPELINE_STAGE_TRANSFER_BIT, false);
+        // change layout of the layers so we can write to them.
+        vkTex->setImageLayout(this, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                              VK_ACCESS_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, false);
+        SkASSERT(GrVkFormatIsSupported(vkTex->imageFormat()));
+    }
 
     // setup memory barrier
-    SkASSERT(GrVkFormatIsSupported(vkTex->imageFormat()));
     VkImageAspectFlags aspectFlags = VK_IMAGE_ASPECT_COLOR_BIT;
     VkImageMemoryBarrier imageMemoryBarrier = {
             VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,  // sType
@@ -1386,51 +1414,63 @@ bool GrVkGpu::onRegenerateMipMapLevels(GrTexture* tex) {
             VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,    // newLayout
             VK_QUEUE_FAMILY_IGNORED,                 // srcQueueFamilyIndex
             VK_QUEUE_FAMILY_IGNORED,                 // dstQueueFamilyIndex
-            vkTex->image(),                          // image
+            VK_NULL_HANDLE,                          // image
             {aspectFlags, 0, 1, 0, 1}                // subresourceRange
     };
+    VkImageBlit blitRegion;
+    memset(&blitRegion, 0, sizeof(VkImageBlit));
 
-    // Blit the miplevels
-    uint32_t mipLevel = 1;
-    while (mipLevel < levelCount) {
-        int prevWidth = width;
-        int prevHeight = height;
-        width = SkTMax(1, width / 2);
-        height = SkTMax(1, height / 2);
-
+    // Blit the miplevels. The barriers for one level of all the textures are added back to back,
+    // so the command buffer submits them together as a single pipeline barrier.
+    for (uint32_t mipLevel = 1; mipLevel <= maxLevelCount; ++mipLevel) {
         imageMemoryBarrier.subresourceRange.baseMipLevel = mipLevel - 1;
-        this->addImageMemoryBarrier(vkTex->resource(), VK_PIPELINE_STAGE_TRANSFER_BIT,
-                                    VK_PIPELINE_STAGE_TRANSFER_BIT, false, &imageMemoryBarrier);
-
-        blitRegion.srcSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, mipLevel - 1, 0, 1 };
-        blitRegion.srcOffsets[0] = { 0, 0, 0 };
-        blitRegion.srcOffsets[1] = { prevWidth, prevHeight, 1 };
-        blitRegion.dstSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, mipLevel, 0, 1 };
-        blitRegion.dstOffsets[0] = { 0, 0, 0 };
-        blitRegion.dstOffsets[1] = { width, height, 1 };
-        fCurrentCmdBuffer->blitImage(this,
-                                     vkTex->resource(),
-                                     vkTex->image(),
-                                     VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                                     vkTex->resource(),
-                                     vkTex->image(),
-                                     VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                                     1,
-                                     &blitRegion,
-                                     VK_FILTER_LINEAR);
-        ++mipLevel;
-    }
-    if (levelCount > 1) {
-        // This barrier logically is not needed, but it changes the final level to the same layout
-        // as all the others, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL. This makes tracking of the
-        // layouts and future layout changes easier. The alternative here would be to track layout
-        // and memory accesses per layer which doesn't seem work it.
-        imageMemoryBarrier.subresourceRange.baseMipLevel = mipLevel - 1;
-        this->addImageMemoryBarrier(vkTex->resource(), VK_PIPELINE_STAGE_TRANSFER_BIT,
-                                    VK_PIPELINE_STAGE_TRANSFER_BIT, false, &imageMemoryBarrier);
-        vkTex->updateImageLayout(VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+        for (int i = 0; i < count; ++i) {
+            GrVkTexture* vkTex = textures[i];
+            // The last level of each texture also gets a barrier. This barrier logically is not
+            // needed, but it changes the final level to the same layout as all the others,
+            // VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL. This makes tracking of the layouts and future
+            // layout changes easier. The alternative here would be to track layout and memory
+            // accesses per layer which doesn't seem work it.
+            if (mipLevel <= vkTex->mipLevels() && vkTex->mipLevels() > 1) {
+                imageMemoryBarrier.image = vkTex->image();
+                this->addImageMemoryBarrier(vkTex->resource(), VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                            VK_PIPELINE_STAGE_TRANSFER_BIT, false,
+                                            &imageMemoryBarrier);
+            }
+        }
+        for (int i = 0; i < count; ++i) {
+            GrVkTexture* vkTex = textures[i];
+            if (mipLevel >= vkTex->mipLevels()) {
+                continue;
+            }
+            int prevWidth = SkTMax(1, vkTex->width() >> (mipLevel - 1));
+            int prevHeight = SkTMax(1, vkTex->height() >> (mipLevel - 1));
+            int width = SkTMax(1, vkTex->width() >> mipLevel);
+            int height = SkTMax(1, vkTex->height() >> mipLevel);
+
+            blitRegion.srcSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, mipLevel - 1, 0, 1 };
+            blitRegion.srcOffsets[0] = { 0, 0, 0 };
+            blitRegion.srcOffsets[1] = { prevWidth, prevHeight, 1 };
+            blitRegion.dstSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, mipLevel, 0, 1 };
+            blitRegion.dstOffsets[0] = { 0, 0, 0 };
+            blitRegion.dstOffsets[1] = { width, height, 1 };
+            fCurrentCmdBuffer->blitImage(this,
+                                         vkTex->resource(),
+                                         vkTex->image(),
+                                         VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                                         vkTex->resource(),
+                                         vkTex->image(),
+                                         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                         1,
+                                         &blitRegion,
+                                         VK_FILTER_LINEAR);
+        }
+    }
+    for (int i = 0; i < count; ++i) {
+        if (textures[i]->mipLevels() > 1) {
+            textures[i]->updateImageLayout(VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+        }
     }
-    return true;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1595,7 +1635,7 @@ bool GrVkGpu::createTestingOnlyVkImage(GrPixelConfig config, int w, int h, bool
     GR_VK_CALL_ERRCHECK(this->vkInterface(),
                         CreateImage(this->device(), &imageCreateInfo, nullptr, &image));
 
-    if (!GrVkMemory::AllocAndBindImageMemory(this, image, false, &alloc)) {
+    if (!GrVkMemory::AllocAndBindImageMemory(this, image, false, usageFlags, &alloc)) {
         VK_CALL(DestroyImage(this->device(), image, nullptr));
         return false;
     }
@@ -2728,3 +2768,7 @@ void GrVkGpu::storeVkPipelineCacheData() {
         this->resourceProvider().storePipelineCacheData();
     }
 }
+
+void GrVkGpu::prewarmPersistentCache(SkTaskGroup* taskGroup) {
+    this->resourceProvider().prewarmPipelineCache(taskGroup);
+}
@@ -127,6 +127,14 @@ public:
 
     bool onRegenerateMipMapLevels(GrTexture* tex) override;
 
+    /**
+     * Regenerates the mip levels of several textures together, e.g. all the ones sampled by a
+     * render pass. Each level of every texture is blitted after a single pipeline barrier, instead
+     * of one barrier per level of each texture. Textures that are clean, read only or can't be
+     * blitted are skipped, and the rest are marked clean.
+     */
+    void regenerateMipMapLevelsBatch(GrVkTexture* const textures[], int count);
+
     void resolveRenderTargetNoFlush(GrRenderTarget* target) {
         this->internalResolveRenderTarget(target, false);
     }
@@ -182,6 +190,7 @@ public:
     };
 
     void storeVkPipelineCacheData() override;
+    void prewarmPersistentCache(SkTaskGroup*) override;
 
 private:
     GrVkGpu(GrContext*, const GrContextOptions&, const GrVkBackendContext&,
@@ -240,6 +249,11 @@ private:
 
     void internalResolveRenderTarget(GrRenderTarget*, bool requiresSubmit);
 
+    // Whether the texture's mip levels can be regenerated by blitting each level to the next.
+    bool canBlitMipMapLevels(const GrVkTexture*) const;
+    // Blits every level of the textures from the one above, level by level across all of them.
+    void blitMipMapLevels(GrVkTexture* const textures[], int count);
+
     void copySurfaceAsCopyImage(GrSurface* dst, GrSurfaceOrigin dstOrigin,
                                 GrSurface* src, GrSurfaceOrigin srcOrigin,
                                 GrVkImage* dstImage, GrVkImage* srcImage,
@@ -239,6 +239,11 @@ void GrVkGpuRTCommandBuffer::submit() {
             currPreCmd->execute(taskArgs);
         }
 
+        if (cbInfo.fMipMapTextures.count()) {
+            fGpu->regenerateMipMapLevelsBatch(cbInfo.fMipMapTextures.begin(),
+                                              cbInfo.fMipMapTextures.count());
+        }
+
         // TODO: Many things create a scratch texture which adds the discard immediately, but then
         // don't draw to it right away. This causes the discard to be ignored and we get yelled at
         // for loading uninitialized data. However, once MDB lands with reordering, the discard will
@@ -783,12 +788,13 @@ void GrVkGpuRTCommandBuffer::onDraw(const GrPrimitiveProcessor& primProc,
             fGpu->resolveRenderTargetNoFlush(texRT);
         }
 
-        // Check if we need to regenerate any mip maps
+        // Check if we need to regenerate any mip maps. They are regenerated together when the
+        // render pass is submitted.
         if (GrSamplerState::Filter::kMipMap == filter &&
             (vkTexture->width() != 1 || vkTexture->height() != 1)) {
             SkASSERT(vkTexture->texturePriv().mipMapped() == GrMipMapped::kYes);
             if (vkTexture->texturePriv().mipMapsAreDirty()) {
-                fGpu->regenerateMipMapLevels(vkTexture);
+                cbInfo.fMipMapTextures.push_back(vkTexture);
             }
         }
         cbInfo.fSampledTextures.push_back(vkTexture);
@@ -179,6 +179,9 @@ private:
         // before submitting the secondary command buffers. This must happen after we do any predraw
         // uploads or copies.
         SkTArray<SampledTexture>               fSampledTextures;
+        // Sampled images whose mip maps were dirty when drawn. Their levels are all regenerated
+        // after the predraw uploads and copies. fSampledTextures keeps them alive.
+        SkTArray<GrVkTexture*>                 fMipMapTextures;
 
         GrVkSecondaryCommandBuffer* currentCmdBuf() {
             return fCommandBuffers.back();
@@ -194,7 +194,8 @@ bool GrVkImage::InitImageInfo(const GrVkGpu* gpu, const ImageDesc& imageDesc, Gr
     GR_VK_CALL_ERRCHECK(gpu->vkInterface(), CreateImage(gpu->device(), &imageCreateInfo, nullptr,
                                                         &image));
 
-    if (!GrVkMemory::AllocAndBindImageMemory(gpu, image, isLinear, &alloc)) {
+    if (!GrVkMemory::AllocAndBindImageMemory(gpu, image, isLinear, imageDesc.fUsageFlags,
+                                             &alloc)) {
         VK_CALL(gpu, DestroyImage(gpu->device(), image, nullptr));
         return false;
     }
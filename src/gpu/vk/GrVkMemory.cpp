@@ -89,6 +89,7 @@ const VkDeviceSize kMaxSmallImageSize = 256 * 1024;
 bool GrVkMemory::AllocAndBindImageMemory(const GrVkGpu* gpu,
                                          VkImage image,
                                          bool linearTiling,
+                                         VkImageUsageFlags usage,
                                          GrVkAlloc* alloc) {
     SkASSERT(!linearTiling);
     GrVkMemoryAllocator* allocator = gpu->memoryAllocator();
@@ -103,6 +104,11 @@ bool GrVkMemory::AllocAndBindImageMemory(const GrVkGpu* gpu,
     } else {
         propFlags = AllocationPropertyFlags::kNone;
     }
+    // Transient attachments may never need backing memory on a tiler, which keeps them in tile
+    // memory for the length of a render pass.
+    if (usage & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT) {
+        propFlags |= AllocationPropertyFlags::kLazyAllocation;
+    }
 
     if (!allocator->allocateMemoryForImage(image, propFlags, &memory)) {
         return false;
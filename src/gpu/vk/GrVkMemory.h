@@ -29,6 +29,7 @@ namespace GrVkMemory {
     bool AllocAndBindImageMemory(const GrVkGpu* gpu,
                                  VkImage image,
                                  bool linearTiling,
+                                 VkImageUsageFlags usage,
                                  GrVkAlloc* alloc);
     void FreeImageMemory(const GrVkGpu* gpu, bool linearTiling, const GrVkAlloc& alloc);
 
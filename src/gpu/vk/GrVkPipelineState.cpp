@@ -237,53 +237,71 @@ void GrVkPipelineState::setAndBindTextures(GrVkGpu* gpu,
                 static_cast<GrVkTexture*>(dstTextureProxy->peekTexture())};
     }
 
-    // Get new descriptor set
     SkASSERT(fNumSamplers == currTextureBinding);
     if (fNumSamplers) {
-        if (fSamplerDescriptorSet) {
-            fSamplerDescriptorSet->recycle(gpu);
-        }
-        fSamplerDescriptorSet = gpu->resourceProvider().getSamplerDescriptorSet(fSamplerDSHandle);
-        int samplerDSIdx = GrVkUniformHandler::kSamplerDescSet;
-        fDescriptorSets[samplerDSIdx] = fSamplerDescriptorSet->descriptorSet();
+        SkAutoSTMalloc<8, const GrVkSampler*> samplers(fNumSamplers);
+        // The descriptor set from the last draw can be bound again as long as it holds the same
+        // textures and samplers, which is common for draws that batch poorly but share an atlas
+        // or image. Texture and sampler IDs are never reused, so they stay valid as a key even
+        // after the objects they came from have been freed.
+        bool reuseDescriptorSet = SkToBool(fSamplerDescriptorSet);
+        fBoundSamplerKeys.resize_back(fNumSamplers);
         for (int i = 0; i < fNumSamplers; ++i) {
-            const GrSamplerState& state = samplerBindings[i].fState;
             GrVkTexture* texture = samplerBindings[i].fTexture;
-
-            const GrVkImageView* textureView = texture->textureView();
-            const GrVkSampler* sampler = nullptr;
             if (fImmutableSamplers[i]) {
-                sampler = fImmutableSamplers[i];
+                samplers[i] = fImmutableSamplers[i];
             } else {
-                sampler = gpu->resourceProvider().findOrCreateCompatibleSampler(
-                    state, texture->ycbcrConversionInfo());
+                samplers[i] = gpu->resourceProvider().findOrCreateCompatibleSampler(
+                    samplerBindings[i].fState, texture->ycbcrConversionInfo());
+            }
+            SkASSERT(samplers[i]);
+
+            SamplerBindingKey key = {texture->uniqueID(), samplers[i]->uniqueID()};
+            if (fBoundSamplerKeys[i] != key) {
+                fBoundSamplerKeys[i] = key;
+                reuseDescriptorSet = false;
+            }
+        }
+
+        int samplerDSIdx = GrVkUniformHandler::kSamplerDescSet;
+        if (!reuseDescriptorSet) {
+            if (fSamplerDescriptorSet) {
+                fSamplerDescriptorSet->recycle(gpu);
+            }
+            fSamplerDescriptorSet =
+                    gpu->resourceProvider().getSamplerDescriptorSet(fSamplerDSHandle);
+            fDescriptorSets[samplerDSIdx] = fSamplerDescriptorSet->descriptorSet();
+
+            SkAutoSTMalloc<8, VkDescriptorImageInfo> imageInfos(fNumSamplers);
+            SkAutoSTMalloc<8, VkWriteDescriptorSet> writeInfos(fNumSamplers);
+            for (int i = 0; i < fNumSamplers; ++i) {
+                VkDescriptorImageInfo& imageInfo = imageInfos[i];
+                memset(&imageInfo, 0, sizeof(VkDescriptorImageInfo));
+                imageInfo.sampler = samplers[i]->sampler();
+                imageInfo.imageView = samplerBindings[i].fTexture->textureView()->imageView();
+                imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+                VkWriteDescriptorSet& writeInfo = writeInfos[i];
+                memset(&writeInfo, 0, sizeof(VkWriteDescriptorSet));
+                writeInfo.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                writeInfo.pNext = nullptr;
+                writeInfo.dstSet = fDescriptorSets[samplerDSIdx];
+                writeInfo.dstBinding = i;
+                writeInfo.dstArrayElement = 0;
+                writeInfo.descriptorCount = 1;
+                writeInfo.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+                writeInfo.pImageInfo = &imageInfo;
+                writeInfo.pBufferInfo = nullptr;
+                writeInfo.pTexelBufferView = nullptr;
             }
-            SkASSERT(sampler);
-
-            VkDescriptorImageInfo imageInfo;
-            memset(&imageInfo, 0, sizeof(VkDescriptorImageInfo));
-            imageInfo.sampler = sampler->sampler();
-            imageInfo.imageView = textureView->imageView();
-            imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-            VkWriteDescriptorSet writeInfo;
-            memset(&writeInfo, 0, sizeof(VkWriteDescriptorSet));
-            writeInfo.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-            writeInfo.pNext = nullptr;
-            writeInfo.dstSet = fDescriptorSets[GrVkUniformHandler::kSamplerDescSet];
-            writeInfo.dstBinding = i;
-            writeInfo.dstArrayElement = 0;
-            writeInfo.descriptorCount = 1;
-            writeInfo.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-            writeInfo.pImageInfo = &imageInfo;
-            writeInfo.pBufferInfo = nullptr;
-            writeInfo.pTexelBufferView = nullptr;
-
-            GR_VK_CALL(gpu->vkInterface(),
-                       UpdateDescriptorSets(gpu->device(), 1, &writeInfo, 0, nullptr));
-            commandBuffer->addResource(sampler);
+            GR_VK_CALL(gpu->vkInterface(), UpdateDescriptorSets(gpu->device(), fNumSamplers,
+                                                                writeInfos.get(), 0, nullptr));
+        }
+
+        for (int i = 0; i < fNumSamplers; ++i) {
+            commandBuffer->addResource(samplers[i]);
             if (!fImmutableSamplers[i]) {
-                sampler->unref(gpu);
+                samplers[i]->unref(gpu);
             }
             commandBuffer->addResource(samplerBindings[i].fTexture->textureView());
             commandBuffer->addResource(samplerBindings[i].fTexture->resource());
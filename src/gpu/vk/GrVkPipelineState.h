@@ -135,6 +135,17 @@ private:
 
     const GrVkDescriptorSetManager::Handle fSamplerDSHandle;
 
+    // What fSamplerDescriptorSet was last written with, one entry per sampler binding.
+    struct SamplerBindingKey {
+        GrGpuResource::UniqueID fTextureID;
+        uint32_t                fSamplerID = SK_InvalidUniqueID;
+
+        bool operator!=(const SamplerBindingKey& that) const {
+            return fTextureID != that.fTextureID || fSamplerID != that.fSamplerID;
+        }
+    };
+    SkSTArray<4, SamplerBindingKey, true> fBoundSamplerKeys;
+
     SkSTArray<4, const GrVkSampler*>   fImmutableSamplers;
 
     std::unique_ptr<GrVkUniformBuffer> fGeometryUniformBuffer;
@@ -7,6 +7,7 @@
 
 
 #include "src/core/SkOpts.h"
+#include "src/core/SkPerfCounters.h"
 #include "src/gpu/GrProcessor.h"
 #include "src/gpu/GrRenderTargetPriv.h"
 #include "src/gpu/GrStencilSettings.h"
@@ -111,6 +112,7 @@ GrVkPipelineState* GrVkResourceProvider::PipelineStateCache::refPipelineState(
 #ifdef GR_PIPELINE_STATE_CACHE_STATS
         ++fCacheMisses;
 #endif
+        SkPerfCounters::Add(SkGraphics::PerfCounter::kGpuProgramCacheMisses);
         GrVkPipelineState* pipelineState(GrVkPipelineStateBuilder::CreatePipelineState(
                 fGpu, renderTarget, origin, primProc, primProcProxies, pipeline, stencil,
                 primitiveType, &desc, compatibleRenderPass));
@@ -36,52 +36,94 @@ GrVkResourceProvider::~GrVkResourceProvider() {
     delete fPipelineStateCache;
 }
 
+// Pipeline cache data is only usable by the device and driver that produced it. Drivers check
+// the data's header themselves, but keying on the driver version as well keeps data written by
+// an older driver from shadowing the data we'd write with the current one.
+static sk_sp<SkData> pipeline_cache_key(const VkPhysicalDeviceProperties& props) {
+    struct {
+        uint32_t fKeyType;
+        uint32_t fVendorID;
+        uint32_t fDeviceID;
+        uint32_t fDriverVersion;
+        uint8_t  fPipelineCacheUUID[VK_UUID_SIZE];
+    } key;
+    static_assert(sizeof(key) == 4 * sizeof(uint32_t) + VK_UUID_SIZE, "unexpected padding");
+    key.fKeyType = GrVkGpu::kPipelineCache_PersistentCacheKeyType;
+    key.fVendorID = props.vendorID;
+    key.fDeviceID = props.deviceID;
+    key.fDriverVersion = props.driverVersion;
+    memcpy(key.fPipelineCacheUUID, props.pipelineCacheUUID, VK_UUID_SIZE);
+    return SkData::MakeWithCopy(&key, sizeof(key));
+}
+
+void GrVkResourceProvider::prewarmPipelineCache(SkTaskGroup* taskGroup) {
+    SkASSERT(taskGroup);
+    if (fPipelineCache != VK_NULL_HANDLE || fPipelineCacheCreatePending) {
+        return;
+    }
+    // Both the persistent cache load and vkCreatePipelineCache may do a lot of work for a large
+    // blob. Neither touches state the render thread uses until pipelineCache() waits for us.
+    fPipelineCacheCreatePending = true;
+    taskGroup->add([this]() {
+        this->createPipelineCache();
+        fPipelineCacheCreated.signal();
+    });
+}
+
 VkPipelineCache GrVkResourceProvider::pipelineCache() {
+    if (fPipelineCacheCreatePending) {
+        fPipelineCacheCreated.wait();
+        fPipelineCacheCreatePending = false;
+    }
     if (fPipelineCache == VK_NULL_HANDLE) {
-        VkPipelineCacheCreateInfo createInfo;
-        memset(&createInfo, 0, sizeof(VkPipelineCacheCreateInfo));
-        createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
-        createInfo.pNext = nullptr;
-        createInfo.flags = 0;
-
-        auto persistentCache = fGpu->getContext()->priv().getPersistentCache();
-        sk_sp<SkData> cached;
-        if (persistentCache) {
-            uint32_t key = GrVkGpu::kPipelineCache_PersistentCacheKeyType;
-            sk_sp<SkData> keyData = SkData::MakeWithoutCopy(&key, sizeof(uint32_t));
-            cached = persistentCache->load(*keyData);
-        }
-        bool usedCached = false;
-        if (cached) {
-            uint32_t* cacheHeader = (uint32_t*)cached->data();
-            if (cacheHeader[1] == VK_PIPELINE_CACHE_HEADER_VERSION_ONE) {
-                // For version one of the header, the total header size is 16 bytes plus
-                // VK_UUID_SIZE bytes. See Section 9.6 (Pipeline Cache) in the vulkan spec to see
-                // the breakdown of these bytes.
-                SkASSERT(cacheHeader[0] == 16 + VK_UUID_SIZE);
-                const VkPhysicalDeviceProperties& devProps = fGpu->physicalDeviceProperties();
-                const uint8_t* supportedPipelineCacheUUID = devProps.pipelineCacheUUID;
-                if (cacheHeader[2] == devProps.vendorID && cacheHeader[3] == devProps.deviceID &&
-                    !memcmp(&cacheHeader[4], supportedPipelineCacheUUID, VK_UUID_SIZE)) {
-                    createInfo.initialDataSize = cached->size();
-                    createInfo.pInitialData = cached->data();
-                    usedCached = true;
-                }
+        this->createPipelineCache();
+    }
+    return fPipelineCache;
+}
+
+void GrVkResourceProvider::createPipelineCache() {
+    SkASSERT(fPipelineCache == VK_NULL_HANDLE);
+    VkPipelineCacheCreateInfo createInfo;
+    memset(&createInfo, 0, sizeof(VkPipelineCacheCreateInfo));
+    createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    createInfo.pNext = nullptr;
+    createInfo.flags = 0;
+
+    auto persistentCache = fGpu->getContext()->priv().getPersistentCache();
+    sk_sp<SkData> cached;
+    if (persistentCache) {
+        cached = persistentCache->load(*pipeline_cache_key(fGpu->physicalDeviceProperties()));
+    }
+    bool usedCached = false;
+    if (cached && cached->size() >= 16 + VK_UUID_SIZE) {
+        uint32_t* cacheHeader = (uint32_t*)cached->data();
+        if (cacheHeader[1] == VK_PIPELINE_CACHE_HEADER_VERSION_ONE) {
+            // For version one of the header, the total header size is 16 bytes plus
+            // VK_UUID_SIZE bytes. See Section 9.6 (Pipeline Cache) in the vulkan spec to see
+            // the breakdown of these bytes.
+            SkASSERT(cacheHeader[0] == 16 + VK_UUID_SIZE);
+            const VkPhysicalDeviceProperties& devProps = fGpu->physicalDeviceProperties();
+            const uint8_t* supportedPipelineCacheUUID = devProps.pipelineCacheUUID;
+            if (cacheHeader[2] == devProps.vendorID && cacheHeader[3] == devProps.deviceID &&
+                !memcmp(&cacheHeader[4], supportedPipelineCacheUUID, VK_UUID_SIZE)) {
+                createInfo.initialDataSize = cached->size();
+                createInfo.pInitialData = cached->data();
+                usedCached = true;
             }
         }
-        if (!usedCached) {
-            createInfo.initialDataSize = 0;
-            createInfo.pInitialData = nullptr;
-        }
-        VkResult result = GR_VK_CALL(fGpu->vkInterface(),
-                                     CreatePipelineCache(fGpu->device(), &createInfo, nullptr,
-                                                         &fPipelineCache));
-        SkASSERT(VK_SUCCESS == result);
-        if (VK_SUCCESS != result) {
-            fPipelineCache = VK_NULL_HANDLE;
-        }
     }
-    return fPipelineCache;
+    if (!usedCached) {
+        createInfo.initialDataSize = 0;
+        createInfo.pInitialData = nullptr;
+    }
+    VkResult result = GR_VK_CALL(fGpu->vkInterface(),
+                                 CreatePipelineCache(fGpu->device(), &createInfo, nullptr,
+                                                     &fPipelineCache));
+    SkASSERT(VK_SUCCESS == result);
+    if (VK_SUCCESS != result) {
+        fPipelineCache = VK_NULL_HANDLE;
+    }
+    fPipelineCacheIsWarm = usedCached && VK_SUCCESS == result;
 }
 
 void GrVkResourceProvider::init() {
@@ -102,9 +144,11 @@ GrVkPipeline* GrVkResourceProvider::createPipeline(int numColorSamples,
                                                    GrPrimitiveType primitiveType,
                                                    VkRenderPass compatibleRenderPass,
                                                    VkPipelineLayout layout) {
+    VkPipelineCache cache = this->pipelineCache();
+    fGpu->stats()->incNumPipelineCreates(fPipelineCacheIsWarm);
     return GrVkPipeline::Create(
             fGpu, numColorSamples, primProc, pipeline, stencil, origin, shaderStageInfo,
-            shaderStageCount, primitiveType, compatibleRenderPass, layout, this->pipelineCache());
+            shaderStageCount, primitiveType, compatibleRenderPass, layout, cache);
 }
 
 GrVkCopyPipeline* GrVkResourceProvider::findOrCreateCopyPipeline(
@@ -119,11 +163,13 @@ GrVkCopyPipeline* GrVkResourceProvider::findOrCreateCopyPipeline(
         }
     }
     if (!pipeline) {
+        VkPipelineCache cache = this->pipelineCache();
+        fGpu->stats()->incNumPipelineCreates(fPipelineCacheIsWarm);
         pipeline = GrVkCopyPipeline::Create(fGpu, shaderStageInfo,
                                             pipelineLayout,
                                             dst->numColorSamples(),
                                             *dst->simpleRenderPass(),
-                                            this->pipelineCache());
+                                            cache);
         if (!pipeline) {
             return nullptr;
         }
@@ -431,6 +477,8 @@ void GrVkResourceProvider::destroyResources(bool deviceLost) {
 
     GR_VK_CALL(fGpu->vkInterface(), DestroyPipelineCache(fGpu->device(), fPipelineCache, nullptr));
     fPipelineCache = VK_NULL_HANDLE;
+    fPipelineCacheIsWarm = false;
+    fPipelineCacheCreatePending = false;
 
     for (GrVkCommandPool* pool : fActiveCommandPools) {
         SkASSERT(pool->unique());
@@ -503,6 +551,8 @@ void GrVkResourceProvider::abandonResources() {
     fPipelineStateCache->abandon();
 
     fPipelineCache = VK_NULL_HANDLE;
+    fPipelineCacheIsWarm = false;
+    fPipelineCacheCreatePending = false;
 
     // We must abandon all command buffers and pipeline states before abandoning the
     // GrVkDescriptorSetManagers
@@ -554,11 +604,9 @@ void GrVkResourceProvider::storePipelineCacheData() {
                                                                   (void*)data.get()));
     SkASSERT(result == VK_SUCCESS);
 
-    uint32_t key = GrVkGpu::kPipelineCache_PersistentCacheKeyType;
-    sk_sp<SkData> keyData = SkData::MakeWithoutCopy(&key, sizeof(uint32_t));
-
     fGpu->getContext()->priv().getPersistentCache()->store(
-            *keyData, *SkData::MakeWithoutCopy(data.get(), dataSize));
+            *pipeline_cache_key(fGpu->physicalDeviceProperties()),
+            *SkData::MakeWithoutCopy(data.get(), dataSize));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
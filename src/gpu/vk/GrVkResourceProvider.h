@@ -9,6 +9,7 @@
 #define GrVkResourceProvider_DEFINED
 
 #include "include/gpu/vk/GrVkTypes.h"
+#include "include/private/SkSemaphore.h"
 #include "include/private/SkTArray.h"
 #include "src/core/SkLRUCache.h"
 #include "src/core/SkTDynamicHash.h"
@@ -35,6 +36,7 @@ class GrVkPrimaryCommandBuffer;
 class GrVkRenderTarget;
 class GrVkSecondaryCommandBuffer;
 class GrVkUniformHandler;
+class SkTaskGroup;
 
 class GrVkResourceProvider {
 public:
@@ -168,6 +170,10 @@ public:
 
     void storePipelineCacheData();
 
+    // Creates the VkPipelineCache, seeded from the persistent cache, on the task group rather than
+    // lazily when the first pipeline is created. pipelineCache() waits for the task if needed.
+    void prewarmPipelineCache(SkTaskGroup*);
+
     // Destroy any cached resources. To be called before destroying the VkDevice.
     // The assumption is that all queues are idle and all command buffers are finished.
     // For resource tracing to work properly, this should be called after unrefing all other
@@ -263,11 +269,18 @@ private:
     };
 
     VkPipelineCache pipelineCache();
+    void createPipelineCache();
 
     GrVkGpu* fGpu;
 
     // Central cache for creating pipelines
     VkPipelineCache fPipelineCache;
+    // True if fPipelineCache was seeded with data from the GrContext's PersistentCache.
+    bool fPipelineCacheIsWarm = false;
+    // Set while prewarmPipelineCache()'s task may still be creating fPipelineCache. The task
+    // signals fPipelineCacheCreated when it is done.
+    bool fPipelineCacheCreatePending = false;
+    SkSemaphore fPipelineCacheCreated;
 
     // Cache of previously created copy pipelines
     SkTArray<GrVkCopyPipeline*> fCopyPipelines;
@@ -433,6 +433,15 @@ sk_sp<SkImage> SkImage::MakeFromYUVATexturesCopyWithExternalBackend(
     return nullptr;
 }
 
+sk_sp<SkImage> SkImage::MakeFromYUVAPixmaps(
+        GrContext* context, SkYUVColorSpace yuvColorSpace, const SkPixmap yuvaPixmaps[],
+        const SkYUVAIndex yuvaIndices[4], SkISize imageSize, GrSurfaceOrigin imageOrigin,
+        bool buildMips, bool limitToMaxTextureSize, sk_sp<SkColorSpace> imageColorSpace) {
+    return SkMakeRasterImageFromYUVAPixmaps(yuvColorSpace, yuvaPixmaps, yuvaIndices, imageSize,
+                                            imageOrigin == kBottomLeft_GrSurfaceOrigin,
+                                            std::move(imageColorSpace));
+}
+
 sk_sp<SkImage> SkImage::MakeFromYUVTexturesCopy(GrContext* ctx, SkYUVColorSpace space,
                                                 const GrBackendTexture[3],
                                                 GrSurfaceOrigin origin,
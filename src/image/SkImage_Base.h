@@ -73,6 +73,12 @@ public:
     // but only inspect them (or encode them).
     virtual bool getROPixels(SkBitmap*, CachingHint = kAllow_CachingHint) const = 0;
 
+    // Like getROPixels, but for a draw that scales the image down by scale. Images that can
+    // produce their pixels at a reduced size (such as lazily decoded ones) may return a smaller
+    // bitmap, though never smaller than the drawn size. Returns false if there is nothing to
+    // gain over getROPixels.
+    virtual bool getROPixelsForScale(const SkSize& scale, SkBitmap*) const { return false; }
+
     virtual sk_sp<SkImage> onMakeSubset(GrRecordingContext*, const SkIRect&) const = 0;
 
     virtual sk_sp<SkCachedData> getPlanes(SkYUVASizeInfo*, SkYUVAIndex[4],
@@ -14,6 +14,7 @@
 #include "include/gpu/GrTexture.h"
 #include "include/private/GrRecordingContext.h"
 #include "src/core/SkAutoPixmapStorage.h"
+#include "src/core/SkImagePriv.h"
 #include "src/core/SkMipMap.h"
 #include "src/core/SkScopeExit.h"
 #include "src/gpu/GrClip.h"
@@ -241,7 +242,9 @@ sk_sp<SkImage> SkImage::MakeFromYUVAPixmaps(
         const SkYUVAIndex yuvaIndices[4], SkISize imageSize, GrSurfaceOrigin imageOrigin,
         bool buildMips, bool limitToMaxTextureSize, sk_sp<SkColorSpace> imageColorSpace) {
     if (!context) {
-        return nullptr; // until we impl this for raster backend
+        return SkMakeRasterImageFromYUVAPixmaps(yuvColorSpace, yuvaPixmaps, yuvaIndices, imageSize,
+                                                imageOrigin == kBottomLeft_GrSurfaceOrigin,
+                                                std::move(imageColorSpace));
     }
 
     int numPixmaps;
@@ -10,6 +10,7 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkData.h"
 #include "include/core/SkImageGenerator.h"
+#include "include/private/SkTo.h"
 #include "src/core/SkBitmapCache.h"
 #include "src/core/SkCachedData.h"
 #include "src/core/SkImagePriv.h"
@@ -141,9 +142,12 @@ SkImage_Lazy::~SkImage_Lazy() {
 
 //////////////////////////////////////////////////////////////////////////////////////////////////
 
-static bool generate_pixels(SkImageGenerator* gen, const SkPixmap& pmap, int originX, int originY) {
-    const int genW = gen->getInfo().width();
-    const int genH = gen->getInfo().height();
+// genSize may be smaller than the generator's info, to have it decode at a reduced size; the
+// origin and pmap are then in the reduced coordinates.
+static bool generate_pixels(SkImageGenerator* gen, const SkPixmap& pmap, int originX, int originY,
+                            const SkISize& genSize) {
+    const int genW = genSize.width();
+    const int genH = genSize.height();
     const SkIRect srcR = SkIRect::MakeWH(genW, genH);
     const SkIRect dstR = SkIRect::MakeXYWH(originX, originY, pmap.width(), pmap.height());
     if (!srcR.contains(dstR)) {
@@ -177,6 +181,10 @@ static bool generate_pixels(SkImageGenerator* gen, const SkPixmap& pmap, int ori
     return true;
 }
 
+static bool generate_pixels(SkImageGenerator* gen, const SkPixmap& pmap, int originX, int originY) {
+    return generate_pixels(gen, pmap, originX, originY, gen->getInfo().dimensions());
+}
+
 bool SkImage_Lazy::getROPixels(SkBitmap* bitmap, SkImage::CachingHint chint) const {
     auto check_output_bitmap = [bitmap]() {
         SkASSERT(bitmap->isImmutable());
@@ -213,6 +221,78 @@ bool SkImage_Lazy::getROPixels(SkBitmap* bitmap, SkImage::CachingHint chint) con
     return true;
 }
 
+bool SkImage_Lazy::getROPixelsForScale(const SkSize& scale, SkBitmap* bitmap) const {
+    ScopedGenerator generator(fSharedGenerator);
+    const SkISize genSize = generator->getInfo().dimensions();
+    const SkIRect subset = this->onGetSubset();
+
+    // Finds the size the generator would decode to for a draw at desiredScale, and where our
+    // subset lands in that. We need the subset's edges to fall on whole pixels of the reduced
+    // decode, which they always do when we are the entire image.
+    auto scaledSubset = [&](float desiredScale, SkISize* scaledGenSize, SkIRect* scaledSubset) {
+        *scaledGenSize = generator->getScaledDimensions(desiredScale);
+        if (*scaledGenSize == genSize) {
+            return false;
+        }
+        auto scaleEdge = [](int edge, int scaled, int full, int* result) {
+            const int64_t product = (int64_t)edge * scaled;
+            *result = SkToInt(product / full);
+            return product % full == 0;
+        };
+        return scaleEdge(subset.fLeft,   scaledGenSize->width(),  genSize.width(),
+                         &scaledSubset->fLeft) &&
+               scaleEdge(subset.fTop,    scaledGenSize->height(), genSize.height(),
+                         &scaledSubset->fTop) &&
+               scaleEdge(subset.fRight,  scaledGenSize->width(),  genSize.width(),
+                         &scaledSubset->fRight) &&
+               scaleEdge(subset.fBottom, scaledGenSize->height(), genSize.height(),
+                         &scaledSubset->fBottom) &&
+               !scaledSubset->isEmpty();
+    };
+    auto scaledDesc = [this](const SkIRect& scaledSubset) {
+        return SkBitmapCacheDesc::MakeScaled(fUniqueID, this->bounds(), scaledSubset.size());
+    };
+
+    // We need a decode at least as large as the draw in both directions.
+    const float desiredScale = SkTMax(scale.width(), scale.height());
+    SkISize decodeGenSize;
+    SkIRect decodeSubset;
+    if (!scaledSubset(desiredScale, &decodeGenSize, &decodeSubset)) {
+        return false;
+    }
+
+    // Anything already cached at this size or larger will do, which lets draws across a range
+    // of scales share one decode. If the full size is cached, our caller should use that.
+    SkISize cachedGenSize = decodeGenSize;
+    SkIRect cachedSubset = decodeSubset;
+    for (float s = desiredScale; s < 1; s *= 2) {
+        if (s != desiredScale && !scaledSubset(s, &cachedGenSize, &cachedSubset)) {
+            break;
+        }
+        if (SkBitmapCache::Find(scaledDesc(cachedSubset), bitmap)) {
+            return true;
+        }
+    }
+    SkBitmap full;
+    if (SkBitmapCache::Find(SkBitmapCacheDesc::Make(this), &full)) {
+        return false;
+    }
+
+    const SkBitmapCacheDesc desc = scaledDesc(decodeSubset);
+    SkPixmap pmap;
+    SkBitmapCache::RecPtr cacheRec =
+            SkBitmapCache::Alloc(desc, this->imageInfo().makeWH(decodeSubset.width(),
+                                                                decodeSubset.height()), &pmap);
+    if (!cacheRec || !generate_pixels(generator, pmap, decodeSubset.x(), decodeSubset.y(),
+                                      decodeGenSize)) {
+        return false;
+    }
+    SkBitmapCache::Add(std::move(cacheRec), bitmap);
+    this->notifyAddedToRasterCache();
+    SkASSERT(bitmap->isImmutable());
+    return true;
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////
 
 bool SkImage_Lazy::onReadPixels(const SkImageInfo& dstInfo, void* dstPixels, size_t dstRB,
@@ -457,8 +537,27 @@ sk_sp<GrTextureProxy> SkImage_Lazy::lockTextureProxy(
         }
     }
 
-    // 4. Ask the generator to return RGB(A) data, which the GPU can convert
+    // 4. Ask the generator to return RGB(A) data, which the GPU can convert. If we aren't keeping
+    //    a CPU copy, have it decode straight into a transfer buffer, rather than into a bitmap we
+    //    would then copy from.
     SkBitmap bitmap;
+    if (!proxy && !willBeMipped && SkImage::kDisallow_CachingHint == chint &&
+            !SkBitmapCache::Find(SkBitmapCacheDesc::Make(this), &bitmap)) {
+        ScopedGenerator generator(fSharedGenerator);
+        proxy = proxyProvider->createProxyFromTransferBuffer(
+                this->imageInfo(), [&](const SkPixmap& pixmap) {
+                    return generate_pixels(generator, pixmap, fOrigin.x(), fOrigin.y());
+                });
+        if (proxy) {
+            SK_HISTOGRAM_ENUMERATION("LockTexturePath", kRGBA_LockTexturePath,
+                                     kLockTexturePathCount);
+            set_key_on_proxy(proxyProvider, proxy.get(), nullptr, key);
+            *fUniqueKeyInvalidatedMessages.append() =
+                    new GrUniqueKeyInvalidatedMessage(key, ctx->priv().contextID());
+            return proxy;
+        }
+    }
+
     if (!proxy && this->getROPixels(&bitmap, chint)) {
         proxy = proxyProvider->createProxyFromBitmap(bitmap, willBeMipped ? GrMipMapped::kYes
                                                                           : GrMipMapped::kNo);
@@ -496,6 +595,44 @@ sk_sp<GrTextureProxy> SkImage_Lazy::lockTextureProxy(
     return nullptr;
 }
 
+sk_sp<GrTextureProxy> SkImage_Lazy::lockDownscaledTextureProxy(GrRecordingContext* ctx,
+                                                               const GrUniqueKey& origKey,
+                                                               SkImage::CachingHint chint) const {
+    GrUniqueKey key;
+    this->makeCacheKeyFromOrigKey(origKey, &key);
+    GrUniqueKey downscaledKey;
+    if (key.isValid()) {
+        static const GrUniqueKey::Domain kDomain = GrUniqueKey::GenerateDomain();
+        GrUniqueKey::Builder builder(&downscaledKey, key, kDomain, 0, "Image Downscaled");
+    }
+
+    GrProxyProvider* proxyProvider = ctx->priv().proxyProvider();
+    if (downscaledKey.isValid()) {
+        if (auto proxy = proxyProvider->findOrCreateProxyByUniqueKey(downscaledKey,
+                                                                     kTopLeft_GrSurfaceOrigin)) {
+            return proxy;
+        }
+    }
+
+    SkBitmap bitmap, downscaled;
+    if (!this->getROPixels(&bitmap, chint) ||
+        !downscaled.tryAllocPixels(bitmap.info().makeWH(SkTMax(1, bitmap.width() / 2),
+                                                        SkTMax(1, bitmap.height() / 2))) ||
+        !bitmap.pixmap().scalePixels(downscaled.pixmap(), kMedium_SkFilterQuality)) {
+        return nullptr;
+    }
+    downscaled.setImmutable();
+
+    sk_sp<GrTextureProxy> proxy = proxyProvider->createProxyFromBitmap(downscaled,
+                                                                       GrMipMapped::kNo);
+    if (proxy && downscaledKey.isValid()) {
+        set_key_on_proxy(proxyProvider, proxy.get(), nullptr, downscaledKey);
+        *fUniqueKeyInvalidatedMessages.append() =
+                new GrUniqueKeyInvalidatedMessage(downscaledKey, ctx->priv().contextID());
+    }
+    return proxy;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 #endif
@@ -51,6 +51,7 @@ public:
     sk_sp<SkData> onRefEncoded() const override;
     sk_sp<SkImage> onMakeSubset(GrRecordingContext*, const SkIRect&) const override;
     bool getROPixels(SkBitmap*, CachingHint) const override;
+    bool getROPixelsForScale(const SkSize& scale, SkBitmap*) const override;
     bool onIsLazyGenerated() const override { return true; }
     sk_sp<SkImage> onMakeColorTypeAndColorSpace(GrRecordingContext*,
                                                 SkColorType, sk_sp<SkColorSpace>) const override;
@@ -67,6 +68,13 @@ public:
                                            bool willBeMipped,
                                            GrTextureMaker::AllowedTexGenType genType) const;
 
+    // Returns a texture proxy of the image at half resolution, for GrImageTextureMaker to use while
+    // the full resolution one doesn't fit the resource cache budget. It is cached under a key
+    // derived from the passed in key (if the key is valid).
+    sk_sp<GrTextureProxy> lockDownscaledTextureProxy(GrRecordingContext*,
+                                                     const GrUniqueKey& key,
+                                                     SkImage::CachingHint) const;
+
     void makeCacheKeyFromOrigKey(const GrUniqueKey& origKey, GrUniqueKey* cacheKey) const;
 #endif
 
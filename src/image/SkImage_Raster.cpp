@@ -10,11 +10,14 @@
 #include "include/core/SkData.h"
 #include "include/core/SkPixelRef.h"
 #include "include/core/SkSurface.h"
+#include "include/core/SkYUVAIndex.h"
 #include "include/private/SkImageInfoPriv.h"
 #include "src/codec/SkColorTable.h"
 #include "src/core/SkConvertPixels.h"
 #include "src/core/SkImagePriv.h"
+#include "src/core/SkRasterPipeline.h"
 #include "src/core/SkTLazy.h"
+#include "src/core/SkYUVMath.h"
 #include "src/image/SkImage_Base.h"
 #include "src/shaders/SkBitmapProcShader.h"
 
@@ -291,6 +294,93 @@ sk_sp<SkImage> SkImage::MakeFromRaster(const SkPixmap& pmap, RasterReleaseProc p
     return sk_make_sp<SkImage_Raster>(pmap.info(), std::move(data), pmap.rowBytes());
 }
 
+// Finds the byte of a ct pixel that holds channel, for planes of YUVA images.
+static bool yuva_channel_offset(SkColorType ct, SkColorChannel channel, int* offset) {
+    switch (ct) {
+        case kAlpha_8_SkColorType:
+        case kGray_8_SkColorType:
+            *offset = 0;
+            return true;
+        case kRGBA_8888_SkColorType:
+        case kRGB_888x_SkColorType:
+            *offset = (int)channel;
+            return true;
+        case kBGRA_8888_SkColorType: {
+            static const int kBGRAOffsets[] = { 2, 1, 0, 3 };
+            *offset = kBGRAOffsets[(int)channel];
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+sk_sp<SkImage> SkMakeRasterImageFromYUVAPixmaps(SkYUVColorSpace yuvColorSpace,
+                                                const SkPixmap yuvaPixmaps[],
+                                                const SkYUVAIndex yuvaIndices[4],
+                                                SkISize imageSize, bool flipY,
+                                                sk_sp<SkColorSpace> imageColorSpace) {
+    int numPixmaps;
+    if (!SkYUVAIndex::AreValidIndices(yuvaIndices, &numPixmaps) || imageSize.isEmpty()) {
+        return nullptr;
+    }
+
+    SkRasterPipeline_YUVACtx ctx;
+    for (int i = 0; i < SkYUVAIndex::kIndexCount; ++i) {
+        if (yuvaIndices[i].fIndex < 0) {
+            ctx.pixels[i] = nullptr;
+            continue;
+        }
+        const SkPixmap& plane = yuvaPixmaps[yuvaIndices[i].fIndex];
+        int offset;
+        if (!plane.addr() || plane.width() <= 0 || plane.height() <= 0 ||
+            !yuva_channel_offset(plane.colorType(), yuvaIndices[i].fChannel, &offset)) {
+            return nullptr;
+        }
+        ctx.pixels[i]        = static_cast<const uint8_t*>(plane.addr()) + offset;
+        ctx.rowBytes[i]      = SkToInt(plane.rowBytes());
+        ctx.bytesPerPixel[i] = plane.info().bytesPerPixel();
+        ctx.width[i]         = plane.width();
+        ctx.height[i]        = plane.height();
+        ctx.scaleX[i]        = (float)plane.width() / imageSize.width();
+        ctx.scaleY[i]        = (float)plane.height() / imageSize.height();
+        ctx.transY[i]        = 0;
+        if (flipY) {
+            ctx.scaleY[i] = -ctx.scaleY[i];
+            ctx.transY[i] = plane.height();
+        }
+    }
+
+    const bool hasAlpha = ctx.pixels[SkYUVAIndex::kA_Index] != nullptr;
+    SkImageInfo info = SkImageInfo::MakeN32(imageSize.width(), imageSize.height(),
+                                            hasAlpha ? kPremul_SkAlphaType : kOpaque_SkAlphaType,
+                                            std::move(imageColorSpace));
+    size_t size = info.computeMinByteSize();
+    if (SkImageInfo::ByteSizeOverflowed(size)) {
+        return nullptr;
+    }
+    sk_sp<SkData> data = SkData::MakeUninitialized(size);
+
+    // Read the planes, convert to RGB, and store, all in one pass straight into the image.
+    float yuvToRGB[20];
+    SkColorMatrix_YUV2RGB(yuvColorSpace, yuvToRGB);
+    SkRasterPipeline_MemoryCtx dst = { data->writable_data(), info.width() };
+
+    SkRasterPipeline_<256> p;
+    p.append(SkRasterPipeline::seed_shader);
+    p.append(SkRasterPipeline::gather_yuva, &ctx);
+    p.append(SkRasterPipeline::matrix_4x5, yuvToRGB);
+    p.append(SkRasterPipeline::clamp_0);
+    p.append(SkRasterPipeline::clamp_1);
+    if (hasAlpha) {
+        p.append(SkRasterPipeline::premul);
+    }
+    p.append_store(info.colorType(), &dst);
+    p.run(0,0, info.width(), info.height());
+
+    return SkImage::MakeRasterData(info, std::move(data), info.minRowBytes());
+}
+
 sk_sp<SkImage> SkMakeImageFromRasterBitmapPriv(const SkBitmap& bm, SkCopyPixelsMode cpm,
                                                uint32_t idForCopy) {
     if (kAlways_SkCopyPixelsMode == cpm || (!bm.isImmutable() && kNever_SkCopyPixelsMode != cpm)) {
@@ -12,6 +12,7 @@
 #include "include/gpu/GrBackendSurface.h"
 #include "src/core/SkAutoPixmapStorage.h"
 #include "src/core/SkImagePriv.h"
+#include "src/core/SkYUVMath.h"
 #include "src/image/SkSurface_Base.h"
 
 static SkPixelGeometry compute_default_geometry() {
@@ -95,6 +96,14 @@ void SkSurface_Base::onDraw(SkCanvas* canvas, SkScalar x, SkScalar y, const SkPa
     }
 }
 
+bool SkSurface_Base::onPeekPixels(SkPixmap* pmap) {
+    return this->getCachedCanvas()->peekPixels(pmap);
+}
+
+bool SkSurface_Base::onReadPixels(const SkPixmap& dst, int srcX, int srcY) {
+    return this->getCachedCanvas()->readPixels(dst, srcX, srcY);
+}
+
 void SkSurface_Base::onAsyncRescaleAndReadPixels(const SkImageInfo& info, const SkIRect& srcRect,
                                                  SkSurface::RescaleGamma rescaleGamma,
                                                  SkFilterQuality rescaleQuality,
@@ -204,6 +213,76 @@ void SkSurface_Base::onAsyncRescaleAndReadPixels(const SkImageInfo& info, const
     }
 }
 
+void SkSurface_Base::onAsyncRescaleAndReadPixelsYUV420(
+        SkYUVColorSpace yuvColorSpace, sk_sp<SkColorSpace> dstColorSpace, const SkIRect& srcRect,
+        int dstW, int dstH, RescaleGamma rescaleGamma, SkFilterQuality rescaleQuality,
+        ReadPixelsCallbackYUV420 callback, ReadPixelsContext context) {
+    // The base implementation of the RGBA read is synchronous, so the planes can be made from
+    // its result before it returns.
+    struct Context {
+        SkYUVColorSpace           fYUVColorSpace;
+        ReadPixelsCallbackYUV420* fClientCallback;
+        ReadPixelsContext         fClientContext;
+        SkImageInfo               fInfo;
+    } yuvContext{yuvColorSpace, callback, context,
+                 SkImageInfo::Make(dstW, dstH, kRGBA_8888_SkColorType, kPremul_SkAlphaType,
+                                   std::move(dstColorSpace))};
+    auto toYUV = [](ReadPixelsContext c, const void* data, size_t rowBytes) {
+        auto yuvContext = static_cast<const Context*>(c);
+        if (!data) {
+            yuvContext->fClientCallback(yuvContext->fClientContext, nullptr, nullptr);
+            return;
+        }
+        // getColor() unpremultiplies, like the GPU conversion does.
+        SkPixmap rgba(yuvContext->fInfo, data, rowBytes);
+        float m[20];
+        SkColorMatrix_RGB2YUV(yuvContext->fYUVColorSpace, m);
+        auto convert = [&m](int row, const float rgb[3]) {
+            const float* r = m + 5 * row;
+            float v = r[0] * rgb[0] + r[1] * rgb[1] + r[2] * rgb[2] + r[4];
+            return SkToU8(sk_float_round2int(SkTPin(v, 0.f, 1.f) * 255));
+        };
+        auto getRGB = [&rgba](int x, int y, float rgb[3]) {
+            SkColor c = rgba.getColor(x, y);
+            rgb[0] = SkColorGetR(c) * (1 / 255.f);
+            rgb[1] = SkColorGetG(c) * (1 / 255.f);
+            rgb[2] = SkColorGetB(c) * (1 / 255.f);
+        };
+        const int w = rgba.width(), h = rgba.height();
+        SkAutoPixmapStorage planes[3];
+        planes[0].alloc(SkImageInfo::MakeA8(w, h));
+        planes[1].alloc(SkImageInfo::MakeA8(w / 2, h / 2));
+        planes[2].alloc(SkImageInfo::MakeA8(w / 2, h / 2));
+        for (int y = 0; y < h; ++y) {
+            for (int x = 0; x < w; ++x) {
+                float rgb[3];
+                getRGB(x, y, rgb);
+                *planes[0].writable_addr8(x, y) = convert(0, rgb);
+            }
+        }
+        for (int y = 0; y < h / 2; ++y) {
+            for (int x = 0; x < w / 2; ++x) {
+                float rgb[3] = {0, 0, 0};
+                for (int i = 0; i < 4; ++i) {
+                    float texel[3];
+                    getRGB(2 * x + (i & 1), 2 * y + (i >> 1), texel);
+                    rgb[0] += texel[0] * 0.25f;
+                    rgb[1] += texel[1] * 0.25f;
+                    rgb[2] += texel[2] * 0.25f;
+                }
+                *planes[1].writable_addr8(x, y) = convert(1, rgb);
+                *planes[2].writable_addr8(x, y) = convert(2, rgb);
+            }
+        }
+        const void* planeData[3] = {planes[0].addr(), planes[1].addr(), planes[2].addr()};
+        const size_t planeRowBytes[3] = {planes[0].rowBytes(), planes[1].rowBytes(),
+                                         planes[2].rowBytes()};
+        yuvContext->fClientCallback(yuvContext->fClientContext, planeData, planeRowBytes);
+    };
+    SkSurface_Base::onAsyncRescaleAndReadPixels(yuvContext.fInfo, srcRect, rescaleGamma,
+                                                rescaleQuality, toYUV, &yuvContext);
+}
+
 bool SkSurface_Base::outstandingImageSnapshot() const {
     return fCachedImage && !fCachedImage->unique();
 }
@@ -308,11 +387,11 @@ void SkSurface::draw(SkCanvas* canvas, SkScalar x, SkScalar y,
 }
 
 bool SkSurface::peekPixels(SkPixmap* pmap) {
-    return this->getCanvas()->peekPixels(pmap);
+    return asSB(this)->onPeekPixels(pmap);
 }
 
 bool SkSurface::readPixels(const SkPixmap& pm, int srcX, int srcY) {
-    return this->getCanvas()->readPixels(pm, srcX, srcY);
+    return asSB(this)->onReadPixels(pm, srcX, srcY);
 }
 
 bool SkSurface::readPixels(const SkImageInfo& dstInfo, void* dstPixels, size_t dstRowBytes,
@@ -337,6 +416,23 @@ void SkSurface::asyncRescaleAndReadPixels(const SkImageInfo& info, const SkIRect
                                             context);
 }
 
+void SkSurface::asyncRescaleAndReadPixelsYUV420(SkYUVColorSpace yuvColorSpace,
+                                                sk_sp<SkColorSpace> dstColorSpace,
+                                                const SkIRect& srcRect, int dstW, int dstH,
+                                                RescaleGamma rescaleGamma,
+                                                SkFilterQuality rescaleQuality,
+                                                ReadPixelsCallbackYUV420 callback,
+                                                ReadPixelsContext context) {
+    if (!SkIRect::MakeWH(this->width(), this->height()).contains(srcRect) || srcRect.isEmpty() ||
+        dstW <= 0 || dstH <= 0 || (dstW & 1) || (dstH & 1)) {
+        callback(context, nullptr, nullptr);
+        return;
+    }
+    asSB(this)->onAsyncRescaleAndReadPixelsYUV420(yuvColorSpace, std::move(dstColorSpace),
+                                                  srcRect, dstW, dstH, rescaleGamma,
+                                                  rescaleQuality, callback, context);
+}
+
 void SkSurface::writePixels(const SkPixmap& pmap, int x, int y) {
     if (pmap.addr() == nullptr || pmap.width() <= 0 || pmap.height() <= 0) {
         return;
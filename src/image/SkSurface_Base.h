@@ -48,6 +48,13 @@ public:
 
     virtual void onWritePixels(const SkPixmap&, int x, int y) = 0;
 
+    /**
+     *  Default implementations forward to the cached canvas. Surfaces whose canvas does not
+     *  draw directly into their pixels (e.g. deferred or recording surfaces) override these.
+     */
+    virtual bool onPeekPixels(SkPixmap*);
+    virtual bool onReadPixels(const SkPixmap& dst, int srcX, int srcY);
+
     /**
      * Default implementation does a rescale/read and then calls the callback.
      */
@@ -57,6 +64,18 @@ public:
                                              ReadPixelsCallback callback,
                                              ReadPixelsContext context);
 
+    /**
+     * Default implementation does a rescale/read as RGBA and then makes the YUV planes from that
+     * before calling the callback.
+     */
+    virtual void onAsyncRescaleAndReadPixelsYUV420(SkYUVColorSpace yuvColorSpace,
+                                                   sk_sp<SkColorSpace> dstColorSpace,
+                                                   const SkIRect& srcRect, int dstW, int dstH,
+                                                   RescaleGamma rescaleGamma,
+                                                   SkFilterQuality rescaleQuality,
+                                                   ReadPixelsCallbackYUV420 callback,
+                                                   ReadPixelsContext context);
+
     /**
      *  Default implementation:
      *
@@ -36,6 +36,13 @@ public:
                                      RescaleGamma rescaleGamma, SkFilterQuality rescaleQuality,
                                      ReadPixelsCallback callback,
                                      ReadPixelsContext context) override;
+    void onAsyncRescaleAndReadPixelsYUV420(SkYUVColorSpace yuvColorSpace,
+                                           sk_sp<SkColorSpace> dstColorSpace,
+                                           const SkIRect& srcRect, int dstW, int dstH,
+                                           RescaleGamma rescaleGamma,
+                                           SkFilterQuality rescaleQuality,
+                                           ReadPixelsCallbackYUV420 callback,
+                                           ReadPixelsContext context) override;
     void onCopyOnWrite(ContentChangeMode) override;
     void onDiscard() override;
     GrSemaphoresSubmitted onFlush(BackendSurfaceAccess access, const GrFlushInfo& info) override;
@@ -0,0 +1,304 @@
+/*
+ * Copyright 2019 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkMallocPixelRef.h"
+#include "include/private/SkTDArray.h"
+#include "src/core/SkImagePriv.h"
+#include "src/core/SkRTree.h"
+#include "src/core/SkRecord.h"
+#include "src/core/SkRecordDraw.h"
+#include "src/core/SkRecorder.h"
+#include "src/core/SkTaskGroup.h"
+#include "src/image/SkSurface_Base.h"
+
+namespace {
+
+// How a recorded op interacts with the canvas state that later ops inherit.
+enum class OpKind { kDraw, kState, kSave, kSaveLayer, kRestore };
+
+struct ClassifyOp {
+    OpKind operator()(const SkRecords::Save&)       { return OpKind::kSave; }
+    OpKind operator()(const SkRecords::SaveLayer&)  { return OpKind::kSaveLayer; }
+    OpKind operator()(const SkRecords::SaveBehind&) { return OpKind::kSaveLayer; }
+    OpKind operator()(const SkRecords::Restore&)    { return OpKind::kRestore; }
+    OpKind operator()(const SkRecords::SetMatrix&)  { return OpKind::kState; }
+    OpKind operator()(const SkRecords::Translate&)  { return OpKind::kState; }
+    OpKind operator()(const SkRecords::Concat&)     { return OpKind::kState; }
+    OpKind operator()(const SkRecords::ClipPath&)   { return OpKind::kState; }
+    OpKind operator()(const SkRecords::ClipRRect&)  { return OpKind::kState; }
+    OpKind operator()(const SkRecords::ClipRect&)   { return OpKind::kState; }
+    OpKind operator()(const SkRecords::ClipRegion&) { return OpKind::kState; }
+
+    template <typename T>
+    OpKind operator()(const T&) { return OpKind::kDraw; }
+};
+
+}  // namespace
+
+class SkSurface_RasterThreaded : public SkSurface_Base {
+public:
+    SkSurface_RasterThreaded(const SkImageInfo&, sk_sp<SkPixelRef>, SkExecutor*, int tileSize,
+                             const SkSurfaceProps*);
+    ~SkSurface_RasterThreaded() override;
+
+    SkCanvas* onNewCanvas() override;
+    sk_sp<SkSurface> onNewSurface(const SkImageInfo&) override;
+    sk_sp<SkImage> onNewImageSnapshot(const SkIRect* subset) override;
+    void onWritePixels(const SkPixmap&, int x, int y) override;
+    bool onPeekPixels(SkPixmap*) override;
+    bool onReadPixels(const SkPixmap& dst, int srcX, int srcY) override;
+    void onDraw(SkCanvas*, SkScalar x, SkScalar y, const SkPaint*) override;
+    void onCopyOnWrite(ContentChangeMode) override;
+    void onRestoreBackingMutability() override;
+    GrSemaphoresSubmitted onFlush(BackendSurfaceAccess, const GrFlushInfo&) override;
+
+private:
+    // Plays back every pending draw that can be resolved now, one task per tile.
+    void playbackPendingDraws();
+
+    SkBitmap         fBitmap;
+    SkExecutor*      fExecutor;
+    const int        fTileSize;
+    sk_sp<SkRecord>  fRecord;
+    SkRecorder*      fRecorder = nullptr;  // Owned by our cached canvas.
+
+    typedef SkSurface_Base INHERITED;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+SkSurface_RasterThreaded::SkSurface_RasterThreaded(const SkImageInfo& info, sk_sp<SkPixelRef> pr,
+                                                   SkExecutor* executor, int tileSize,
+                                                   const SkSurfaceProps* props)
+        : INHERITED(pr->width(), pr->height(), props)
+        , fExecutor(executor)
+        , fTileSize(tileSize)
+        , fRecord(sk_make_sp<SkRecord>()) {
+    fBitmap.setInfo(info, pr->rowBytes());
+    fBitmap.setPixelRef(std::move(pr), 0, 0);
+}
+
+SkSurface_RasterThreaded::~SkSurface_RasterThreaded() {
+    // Our cached canvas outlives fRecord; make sure it never touches it again.
+    if (fRecorder) {
+        fRecorder->forgetRecord();
+    }
+}
+
+SkCanvas* SkSurface_RasterThreaded::onNewCanvas() {
+    SkASSERT(!fRecorder);
+    SkRect bounds = SkRect::MakeIWH(this->width(), this->height());
+    fRecorder = new SkRecorder(fRecord.get(), bounds);
+    // Drawables and pictures are expanded into our record as they are drawn, to match the
+    // immediate-mode semantics of a raster canvas, and so playback never touches them.
+    fRecorder->reset(fRecord.get(), bounds, SkRecorder::Playback_DrawPictureMode);
+    return fRecorder;
+}
+
+sk_sp<SkSurface> SkSurface_RasterThreaded::onNewSurface(const SkImageInfo& info) {
+    return SkSurface::MakeRasterThreaded(info, fExecutor, fTileSize, &this->props());
+}
+
+void SkSurface_RasterThreaded::playbackPendingDraws() {
+    const int count = fRecord->count();
+    if (!fRecorder || 0 == count) {
+        return;
+    }
+
+    // Find which ops are still needed once the pending draws land in fBitmap.  Saves, matrix
+    // and clip ops stay live while the save blocks around them are still open.  Everything
+    // else, including whole save blocks that have been restored, can be dropped after playback.
+    // Draws inside a saveLayer() that is still open can't be resolved yet, so playback stops
+    // at the outermost open layer.
+    SkTDArray<bool> live;
+    live.setCount(count);
+    struct SaveBlock {
+        int  fStart;
+        bool fIsLayer;
+    };
+    SkTDArray<SaveBlock> saves;
+    for (int i = 0; i < count; ++i) {
+        live[i] = false;
+        OpKind kind = fRecord->visit(i, ClassifyOp());
+        switch (kind) {
+            case OpKind::kDraw:
+                break;
+            case OpKind::kState:
+                live[i] = true;
+                break;
+            case OpKind::kSave:
+            case OpKind::kSaveLayer:
+                live[i] = true;
+                saves.push_back({i, OpKind::kSaveLayer == kind});
+                break;
+            case OpKind::kRestore:
+                if (!saves.isEmpty()) {
+                    SaveBlock save;
+                    saves.pop(&save);
+                    for (int j = save.fStart; j < i; ++j) {
+                        live[j] = false;
+                    }
+                }
+                break;
+        }
+    }
+    int stop = count;
+    for (const SaveBlock& save : saves) {
+        if (save.fIsLayer) {
+            stop = save.fStart;
+            break;
+        }
+    }
+
+    bool pendingDraws = false;
+    for (int i = 0; i < stop && !pendingDraws; ++i) {
+        pendingDraws = !live[i];
+    }
+    if (pendingDraws) {
+        // We draw outside of SkCanvas, so give any outstanding snapshot a chance to fork.
+        this->notifyContentWillChange(kRetain_ContentChangeMode);
+
+        SkAutoTMalloc<SkRect> bounds(count);
+        SkRecordFillBounds(SkRect::MakeIWH(this->width(), this->height()), *fRecord,
+                           bounds.get());
+        SkRTree rtree;
+        rtree.insert(bounds.get(), count);
+
+        const int tilesX = (this->width()  + fTileSize - 1) / fTileSize,
+                  tilesY = (this->height() + fTileSize - 1) / fTileSize;
+        const SkRecord& record = *fRecord;
+        SkTaskGroup tasks(*fExecutor);
+        tasks.batch(tilesX * tilesY, [&](int tile) {
+            SkIRect r = SkIRect::MakeXYWH((tile % tilesX) * fTileSize,
+                                          (tile / tilesX) * fTileSize, fTileSize, fTileSize);
+            SkBitmap tileBitmap;
+            if (!fBitmap.extractSubset(&tileBitmap, r)) {
+                return;
+            }
+            SkCanvas canvas(tileBitmap, this->props());
+            canvas.translate(-SkIntToScalar(r.fLeft), -SkIntToScalar(r.fTop));
+
+            SkTDArray<int> ops;
+            rtree.search(canvas.getLocalClipBounds(), &ops);
+
+            SkRecords::Draw draw(&canvas, nullptr, nullptr, 0);
+            for (int op : ops) {
+                if (op < stop) {
+                    record.visit(op, draw);
+                }
+            }
+        });
+        tasks.wait();
+    }
+
+    bool anyLive = stop < count;
+    for (int i = 0; i < stop; ++i) {
+        if (live[i]) {
+            anyLive = true;
+        } else {
+            fRecord->replace<SkRecords::NoOp>(i);
+        }
+    }
+    if (anyLive) {
+        fRecord->defrag();
+    } else {
+        // Nothing recorded affects later draws, so the recorder is back in its default state
+        // and we can start over with a fresh record, releasing everything the old one held.
+        fRecord = sk_make_sp<SkRecord>();
+        fRecorder->reset(fRecord.get(), SkRect::MakeIWH(this->width(), this->height()),
+                         SkRecorder::Playback_DrawPictureMode);
+    }
+}
+
+void SkSurface_RasterThreaded::onDraw(SkCanvas* canvas, SkScalar x, SkScalar y,
+                                      const SkPaint* paint) {
+    this->playbackPendingDraws();
+    canvas->drawBitmap(fBitmap, x, y, paint);
+}
+
+sk_sp<SkImage> SkSurface_RasterThreaded::onNewImageSnapshot(const SkIRect* subset) {
+    this->playbackPendingDraws();
+
+    if (subset) {
+        SkASSERT(SkIRect::MakeWH(fBitmap.width(), fBitmap.height()).contains(*subset));
+        SkBitmap dst;
+        dst.allocPixels(fBitmap.info().makeWH(subset->width(), subset->height()));
+        SkAssertResult(fBitmap.readPixels(dst.pixmap(), subset->left(), subset->top()));
+        dst.setImmutable(); // key, so MakeFromBitmap doesn't make a copy of the buffer
+        return SkImage::MakeFromBitmap(dst);
+    }
+
+    // SkImage_raster requires these pixels are immutable for its full lifetime.
+    // We'll undo this via onRestoreBackingMutability() if we can avoid the COW.
+    if (SkPixelRef* pr = fBitmap.pixelRef()) {
+        pr->setTemporarilyImmutable();
+    }
+    return SkMakeImageFromRasterBitmap(fBitmap, kIfMutable_SkCopyPixelsMode);
+}
+
+void SkSurface_RasterThreaded::onWritePixels(const SkPixmap& src, int x, int y) {
+    this->playbackPendingDraws();
+    fBitmap.writePixels(src, x, y);
+}
+
+bool SkSurface_RasterThreaded::onPeekPixels(SkPixmap* pmap) {
+    this->playbackPendingDraws();
+    return fBitmap.peekPixels(pmap);
+}
+
+bool SkSurface_RasterThreaded::onReadPixels(const SkPixmap& dst, int srcX, int srcY) {
+    this->playbackPendingDraws();
+    return fBitmap.readPixels(dst, srcX, srcY);
+}
+
+void SkSurface_RasterThreaded::onRestoreBackingMutability() {
+    SkASSERT(!this->hasCachedImage());  // Shouldn't be any snapshots out there.
+    if (SkPixelRef* pr = fBitmap.pixelRef()) {
+        pr->restoreMutability();
+    }
+}
+
+void SkSurface_RasterThreaded::onCopyOnWrite(ContentChangeMode mode) {
+    // are we sharing pixelrefs with the image?
+    sk_sp<SkImage> cached(this->refCachedImage());
+    SkASSERT(cached);
+    if (SkBitmapImageGetPixelRef(cached.get()) == fBitmap.pixelRef()) {
+        size_t rowBytes = fBitmap.rowBytes();
+        SkBitmap prev(fBitmap);
+        fBitmap.allocPixels(fBitmap.info(), rowBytes);
+        if (kRetain_ContentChangeMode == mode) {
+            memcpy(fBitmap.getPixels(), prev.getPixels(), fBitmap.computeByteSize());
+        }
+        // Our canvas only records, so there's no device to point at the new pixels.
+    }
+}
+
+GrSemaphoresSubmitted SkSurface_RasterThreaded::onFlush(BackendSurfaceAccess,
+                                                        const GrFlushInfo&) {
+    this->playbackPendingDraws();
+    return GrSemaphoresSubmitted::kNo;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+sk_sp<SkSurface> SkSurface::MakeRasterThreaded(const SkImageInfo& info, SkExecutor* executor,
+                                               int tileSize, const SkSurfaceProps* props) {
+    if (!SkSurfaceValidateRasterInfo(info) || tileSize <= 0) {
+        return nullptr;
+    }
+
+    sk_sp<SkPixelRef> pr = SkMallocPixelRef::MakeAllocate(info, 0);
+    if (!pr) {
+        return nullptr;
+    }
+    if (!executor) {
+        executor = &SkExecutor::GetDefault();
+    }
+    return sk_make_sp<SkSurface_RasterThreaded>(info, std::move(pr), executor, tileSize, props);
+}
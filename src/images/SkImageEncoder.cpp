@@ -15,6 +15,7 @@ bool SkJpegEncoder::Encode(SkWStream*, const SkPixmap&, const Options&) { return
 std::unique_ptr<SkEncoder> SkJpegEncoder::Make(SkWStream*, const SkPixmap&, const Options&) {
     return nullptr;
 }
+std::unique_ptr<SkJpegEncoder::Batch> SkJpegEncoder::MakeBatch(const Options&) { return nullptr; }
 #endif
 
 #ifndef SK_HAS_PNG_LIBRARY
@@ -22,10 +23,14 @@ bool SkPngEncoder::Encode(SkWStream*, const SkPixmap&, const Options&) { return
 std::unique_ptr<SkEncoder> SkPngEncoder::Make(SkWStream*, const SkPixmap&, const Options&) {
     return nullptr;
 }
+std::unique_ptr<SkPngEncoder::Batch> SkPngEncoder::MakeBatch(const Options&) { return nullptr; }
 #endif
 
 #ifndef SK_HAS_WEBP_LIBRARY
 bool SkWebpEncoder::Encode(SkWStream*, const SkPixmap&, const Options&) { return false; }
+bool SkWebpEncoder::EncodeAnimated(SkWStream*, const Frame[], int, const Options&, SkExecutor*) {
+    return false;
+}
 #endif
 
 bool SkEncodeImage(SkWStream* dst, const SkPixmap& src,
@@ -43,6 +43,8 @@ public:
 
     transform_scanline_proc proc() const { return fProc; }
 
+    void setStream(SkWStream* stream) { fDstMgr.fStream = stream; }
+
     ~SkJpegEncoderMgr() {
         jpeg_destroy_compress(&fCInfo);
     }
@@ -163,6 +165,50 @@ bool SkJpegEncoderMgr::setParams(const SkImageInfo& srcInfo, const SkJpegEncoder
     return true;
 }
 
+// Returns the APP2 marker holding the ICC profile for info, if it needs one.
+static sk_sp<SkData> icc_marker(const SkImageInfo& info) {
+    sk_sp<SkData> icc = icc_from_color_space(info);
+    if (!icc) {
+        return nullptr;
+    }
+
+    // Create a contiguous block of memory with the icc signature followed by the profile.
+    sk_sp<SkData> markerData =
+            SkData::MakeUninitialized(kICCMarkerHeaderSize + icc->size());
+    uint8_t* ptr = (uint8_t*) markerData->writable_data();
+    memcpy(ptr, kICCSig, sizeof(kICCSig));
+    ptr += sizeof(kICCSig);
+    *ptr++ = 1; // This is the first marker.
+    *ptr++ = 1; // Out of one total markers.
+    memcpy(ptr, icc->data(), icc->size());
+    return markerData;
+}
+
+// Writes rows [startRow, startRow + numRows) of src, finishing the image after the last row.
+// storage must hold a row of input_components bytes per pixel if there is a proc.
+// The caller is responsible for the setjmp.
+static void write_rows(SkJpegEncoderMgr* encoderMgr, const SkPixmap& src, uint8_t* storage,
+                       int startRow, int numRows) {
+    const void* srcRow = src.addr(0, startRow);
+    for (int i = 0; i < numRows; i++) {
+        JSAMPLE* jpegSrcRow = (JSAMPLE*) srcRow;
+        if (encoderMgr->proc()) {
+            encoderMgr->proc()((char*)storage,
+                               (const char*)srcRow,
+                               src.width(),
+                               encoderMgr->cinfo()->input_components);
+            jpegSrcRow = storage;
+        }
+
+        jpeg_write_scanlines(encoderMgr->cinfo(), &jpegSrcRow, 1);
+        srcRow = SkTAddOffset<const void>(srcRow, src.rowBytes());
+    }
+
+    if (startRow + numRows == src.height()) {
+        jpeg_finish_compress(encoderMgr->cinfo());
+    }
+}
+
 std::unique_ptr<SkEncoder> SkJpegEncoder::Make(SkWStream* dst, const SkPixmap& src,
                                                const Options& options) {
     if (!SkPixmapIsValid(src)) {
@@ -183,18 +229,7 @@ std::unique_ptr<SkEncoder> SkJpegEncoder::Make(SkWStream* dst, const SkPixmap& s
     jpeg_set_quality(encoderMgr->cinfo(), options.fQuality, TRUE);
     jpeg_start_compress(encoderMgr->cinfo(), TRUE);
 
-    sk_sp<SkData> icc = icc_from_color_space(src.info());
-    if (icc) {
-        // Create a contiguous block of memory with the icc signature followed by the profile.
-        sk_sp<SkData> markerData =
-                SkData::MakeUninitialized(kICCMarkerHeaderSize + icc->size());
-        uint8_t* ptr = (uint8_t*) markerData->writable_data();
-        memcpy(ptr, kICCSig, sizeof(kICCSig));
-        ptr += sizeof(kICCSig);
-        *ptr++ = 1; // This is the first marker.
-        *ptr++ = 1; // Out of one total markers.
-        memcpy(ptr, icc->data(), icc->size());
-
+    if (sk_sp<SkData> markerData = icc_marker(src.info())) {
         jpeg_write_marker(encoderMgr->cinfo(), kICCMarker, markerData->bytes(), markerData->size());
     }
 
@@ -214,26 +249,8 @@ bool SkJpegEncoder::onEncodeRows(int numRows) {
         return false;
     }
 
-    const void* srcRow = fSrc.addr(0, fCurrRow);
-    for (int i = 0; i < numRows; i++) {
-        JSAMPLE* jpegSrcRow = (JSAMPLE*) srcRow;
-        if (fEncoderMgr->proc()) {
-            fEncoderMgr->proc()((char*)fStorage.get(),
-                                (const char*)srcRow,
-                                fSrc.width(),
-                                fEncoderMgr->cinfo()->input_components);
-            jpegSrcRow = fStorage.get();
-        }
-
-        jpeg_write_scanlines(fEncoderMgr->cinfo(), &jpegSrcRow, 1);
-        srcRow = SkTAddOffset<const void>(srcRow, fSrc.rowBytes());
-    }
-
+    write_rows(fEncoderMgr.get(), fSrc, fStorage.get(), fCurrRow, numRows);
     fCurrRow += numRows;
-    if (fCurrRow == fSrc.height()) {
-        jpeg_finish_compress(fEncoderMgr->cinfo());
-    }
-
     return true;
 }
 
@@ -242,4 +259,72 @@ bool SkJpegEncoder::Encode(SkWStream* dst, const SkPixmap& src, const Options& o
     return encoder.get() && encoder->encodeRows(src.height());
 }
 
+namespace {
+
+class JpegBatch final : public SkJpegEncoder::Batch {
+public:
+    JpegBatch(const SkJpegEncoder::Options& options) : fOptions(options), fStorageSize(0) {}
+
+    bool encode(SkWStream* dst, const SkPixmap& src) override {
+        if (!SkPixmapIsValid(src)) {
+            return false;
+        }
+
+        if (!fEncoderMgr) {
+            fEncoderMgr = SkJpegEncoderMgr::Make(dst);
+            fInfo = SkImageInfo::MakeUnknown();
+        }
+        fEncoderMgr->setStream(dst);
+
+        skjpeg_error_mgr::AutoPushJmpBuf jmp(fEncoderMgr->errorMgr());
+        if (setjmp(jmp)) {
+            // skjpeg_error_exit() has destroyed the compressor, so start over next time.
+            fEncoderMgr.reset();
+            return false;
+        }
+
+        // libjpeg keeps the parameters and tables from one image to the next, so only set
+        // them up again if the image is different.
+        if (src.info() != fInfo) {
+            fInfo = SkImageInfo::MakeUnknown();
+            if (!fEncoderMgr->setParams(src.info(), fOptions)) {
+                return false;
+            }
+            jpeg_set_quality(fEncoderMgr->cinfo(), fOptions.fQuality, TRUE);
+            fICCMarker = icc_marker(src.info());
+            fInfo = src.info();
+        }
+
+        const size_t rowBytes =
+                fEncoderMgr->proc() ? fEncoderMgr->cinfo()->input_components * src.width() : 0;
+        if (rowBytes > fStorageSize) {
+            fStorage.reset(rowBytes);
+            fStorageSize = rowBytes;
+        }
+
+        jpeg_start_compress(fEncoderMgr->cinfo(), TRUE);
+        if (fICCMarker) {
+            jpeg_write_marker(fEncoderMgr->cinfo(), kICCMarker, fICCMarker->bytes(),
+                              fICCMarker->size());
+        }
+        write_rows(fEncoderMgr.get(), src, fStorage.get(), 0, src.height());
+        return true;
+    }
+
+private:
+    const SkJpegEncoder::Options      fOptions;
+    std::unique_ptr<SkJpegEncoderMgr> fEncoderMgr;
+    // The image fEncoderMgr's parameters were last set for.
+    SkImageInfo                       fInfo;
+    sk_sp<SkData>                     fICCMarker;
+    SkAutoTMalloc<uint8_t>            fStorage;
+    size_t                            fStorageSize;
+};
+
+}  // namespace
+
+std::unique_ptr<SkJpegEncoder::Batch> SkJpegEncoder::MakeBatch(const Options& options) {
+    return std::unique_ptr<Batch>(new JpegBatch(options));
+}
+
 #endif
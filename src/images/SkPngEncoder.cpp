@@ -16,6 +16,7 @@
 #include "src/codec/SkColorTable.h"
 #include "src/codec/SkPngPriv.h"
 #include "src/images/SkImageEncoderFns.h"
+#include <cstddef>
 #include <vector>
 
 #include "png.h"
@@ -44,14 +45,84 @@ static void sk_write_fn(png_structp png_ptr, png_bytep data, png_size_t len) {
     }
 }
 
+/*
+ * Recycles libpng's (and through it, zlib's) allocations from one image to the next. Encoding
+ * another image of the same size asks for the same blocks again, so after the first image
+ * there is nothing left to allocate.
+ */
+class SkPngEncoderMemory final : SkNoncopyable {
+public:
+    SkPngEncoderMemory() {}
+
+    ~SkPngEncoderMemory() {
+        for (Header* header : fFreeBlocks) {
+            sk_free(header);
+        }
+    }
+
+    static png_voidp Malloc(png_structp png_ptr, png_alloc_size_t size) {
+        return static_cast<SkPngEncoderMemory*>(png_get_mem_ptr(png_ptr))->alloc(size);
+    }
+
+    static void Free(png_structp png_ptr, png_voidp ptr) {
+        static_cast<SkPngEncoderMemory*>(png_get_mem_ptr(png_ptr))->release(ptr);
+    }
+
+private:
+    // Each block starts with its size, padded to keep the memory after it aligned.
+    union Header {
+        size_t           fSize;
+        std::max_align_t fAlign;
+    };
+
+    // Enough for everything libpng and zlib allocate for one image.
+    static constexpr size_t kMaxFreeBlocks = 32;
+
+    void* alloc(size_t size) {
+        for (size_t i = 0; i < fFreeBlocks.size(); i++) {
+            if (fFreeBlocks[i]->fSize == size) {
+                Header* header = fFreeBlocks[i];
+                fFreeBlocks[i] = fFreeBlocks.back();
+                fFreeBlocks.pop_back();
+                return header + 1;
+            }
+        }
+        if (size > SIZE_MAX - sizeof(Header)) {
+            return nullptr;
+        }
+        Header* header = static_cast<Header*>(sk_malloc_canfail(sizeof(Header) + size));
+        if (!header) {
+            return nullptr;
+        }
+        header->fSize = size;
+        return header + 1;
+    }
+
+    void release(void* ptr) {
+        if (!ptr) {
+            return;
+        }
+        if (fFreeBlocks.size() == kMaxFreeBlocks) {
+            // Blocks left over from images of another size.
+            sk_free(fFreeBlocks.front());
+            fFreeBlocks.erase(fFreeBlocks.begin());
+        }
+        fFreeBlocks.push_back(static_cast<Header*>(ptr) - 1);
+    }
+
+    std::vector<Header*> fFreeBlocks;
+};
+
 class SkPngEncoderMgr final : SkNoncopyable {
 public:
 
     /*
      * Create the decode manager
      * Does not take ownership of stream
+     * If memory is not null, libpng allocates from it, and it must outlive the manager.
      */
-    static std::unique_ptr<SkPngEncoderMgr> Make(SkWStream* stream);
+    static std::unique_ptr<SkPngEncoderMgr> Make(SkWStream* stream,
+                                                 SkPngEncoderMemory* memory = nullptr);
 
     bool setHeader(const SkImageInfo& srcInfo, const SkPngEncoder::Options& options);
     bool setColorSpace(const SkImageInfo& info);
@@ -80,9 +151,19 @@ private:
     transform_scanline_proc fProc;
 };
 
-std::unique_ptr<SkPngEncoderMgr> SkPngEncoderMgr::Make(SkWStream* stream) {
+std::unique_ptr<SkPngEncoderMgr> SkPngEncoderMgr::Make(SkWStream* stream,
+                                                       SkPngEncoderMemory* memory) {
+#ifdef PNG_USER_MEM_SUPPORTED
+    png_structp pngPtr = memory
+            ? png_create_write_struct_2(PNG_LIBPNG_VER_STRING, nullptr, sk_error_fn, nullptr,
+                                        memory, SkPngEncoderMemory::Malloc,
+                                        SkPngEncoderMemory::Free)
+            : png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, sk_error_fn, nullptr);
+#else
+    (void)memory;
     png_structp pngPtr =
             png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, sk_error_fn, nullptr);
+#endif
     if (!pngPtr) {
         return nullptr;
     }
@@ -372,13 +453,14 @@ void SkPngEncoderMgr::chooseProc(const SkImageInfo& srcInfo) {
     fProc = choose_proc(srcInfo);
 }
 
-std::unique_ptr<SkEncoder> SkPngEncoder::Make(SkWStream* dst, const SkPixmap& src,
-                                              const Options& options) {
+static std::unique_ptr<SkPngEncoderMgr> make_encoder_mgr(SkWStream* dst, const SkPixmap& src,
+                                                         const SkPngEncoder::Options& options,
+                                                         SkPngEncoderMemory* memory) {
     if (!SkPixmapIsValid(src)) {
         return nullptr;
     }
 
-    std::unique_ptr<SkPngEncoderMgr> encoderMgr = SkPngEncoderMgr::Make(dst);
+    std::unique_ptr<SkPngEncoderMgr> encoderMgr = SkPngEncoderMgr::Make(dst, memory);
     if (!encoderMgr) {
         return nullptr;
     }
@@ -396,6 +478,42 @@ std::unique_ptr<SkEncoder> SkPngEncoder::Make(SkWStream* dst, const SkPixmap& sr
     }
 
     encoderMgr->chooseProc(src.info());
+    return encoderMgr;
+}
+
+// Writes rows [startRow, startRow + numRows) of src, finishing the image after the last row.
+// storage must hold a row of the encoded pixels.
+static bool write_rows(SkPngEncoderMgr* encoderMgr, const SkPixmap& src, uint8_t* storage,
+                       int startRow, int numRows) {
+    if (setjmp(png_jmpbuf(encoderMgr->pngPtr()))) {
+        return false;
+    }
+
+    const void* srcRow = src.addr(0, startRow);
+    for (int y = 0; y < numRows; y++) {
+        encoderMgr->proc()((char*)storage,
+                           (const char*)srcRow,
+                           src.width(),
+                           SkColorTypeBytesPerPixel(src.colorType()));
+
+        png_bytep rowPtr = (png_bytep) storage;
+        png_write_rows(encoderMgr->pngPtr(), &rowPtr, 1);
+        srcRow = SkTAddOffset<const void>(srcRow, src.rowBytes());
+    }
+
+    if (startRow + numRows == src.height()) {
+        png_write_end(encoderMgr->pngPtr(), encoderMgr->infoPtr());
+    }
+
+    return true;
+}
+
+std::unique_ptr<SkEncoder> SkPngEncoder::Make(SkWStream* dst, const SkPixmap& src,
+                                              const Options& options) {
+    std::unique_ptr<SkPngEncoderMgr> encoderMgr = make_encoder_mgr(dst, src, options, nullptr);
+    if (!encoderMgr) {
+        return nullptr;
+    }
 
     return std::unique_ptr<SkPngEncoder>(new SkPngEncoder(std::move(encoderMgr), src));
 }
@@ -408,27 +526,11 @@ SkPngEncoder::SkPngEncoder(std::unique_ptr<SkPngEncoderMgr> encoderMgr, const Sk
 SkPngEncoder::~SkPngEncoder() {}
 
 bool SkPngEncoder::onEncodeRows(int numRows) {
-    if (setjmp(png_jmpbuf(fEncoderMgr->pngPtr()))) {
+    if (!write_rows(fEncoderMgr.get(), fSrc, fStorage.get(), fCurrRow, numRows)) {
         return false;
     }
 
-    const void* srcRow = fSrc.addr(0, fCurrRow);
-    for (int y = 0; y < numRows; y++) {
-        fEncoderMgr->proc()((char*)fStorage.get(),
-                            (const char*)srcRow,
-                            fSrc.width(),
-                            SkColorTypeBytesPerPixel(fSrc.colorType()));
-
-        png_bytep rowPtr = (png_bytep) fStorage.get();
-        png_write_rows(fEncoderMgr->pngPtr(), &rowPtr, 1);
-        srcRow = SkTAddOffset<const void>(srcRow, fSrc.rowBytes());
-    }
-
     fCurrRow += numRows;
-    if (fCurrRow == fSrc.height()) {
-        png_write_end(fEncoderMgr->pngPtr(), fEncoderMgr->infoPtr());
-    }
-
     return true;
 }
 
@@ -437,4 +539,38 @@ bool SkPngEncoder::Encode(SkWStream* dst, const SkPixmap& src, const Options& op
     return encoder.get() && encoder->encodeRows(src.height());
 }
 
+namespace {
+
+class PngBatch final : public SkPngEncoder::Batch {
+public:
+    PngBatch(const SkPngEncoder::Options& options) : fOptions(options), fStorageSize(0) {}
+
+    bool encode(SkWStream* dst, const SkPixmap& src) override {
+        std::unique_ptr<SkPngEncoderMgr> encoderMgr =
+                make_encoder_mgr(dst, src, fOptions, &fMemory);
+        if (!encoderMgr) {
+            return false;
+        }
+
+        const size_t rowBytes = encoderMgr->pngBytesPerPixel() * src.width();
+        if (rowBytes > fStorageSize) {
+            fStorage.reset(rowBytes);
+            fStorageSize = rowBytes;
+        }
+        return write_rows(encoderMgr.get(), src, fStorage.get(), 0, src.height());
+    }
+
+private:
+    const SkPngEncoder::Options fOptions;
+    SkPngEncoderMemory          fMemory;
+    SkAutoTMalloc<uint8_t>      fStorage;
+    size_t                      fStorageSize;
+};
+
+}  // namespace
+
+std::unique_ptr<SkPngEncoder::Batch> SkPngEncoder::MakeBatch(const Options& options) {
+    return std::unique_ptr<Batch>(new PngBatch(options));
+}
+
 #endif
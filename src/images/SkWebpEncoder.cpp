@@ -24,9 +24,12 @@
 #include "include/encode/SkWebpEncoder.h"
 #include "include/private/SkColorData.h"
 #include "include/private/SkTemplates.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/images/SkImageEncoderFns.h"
 #include "src/utils/SkUTF.h"
 
+#include <vector>
+
 // A WebP encoder only, on top of (subset of) libwebp
 // For more information on WebP image format, and libwebp library, see:
 //   http://code.google.com/speed/webp/
@@ -103,7 +106,9 @@ static int stream_writer(const uint8_t* data, size_t data_size,
   return stream->write(data, data_size) ? 1 : 0;
 }
 
-bool SkWebpEncoder::Encode(SkWStream* stream, const SkPixmap& pixmap, const Options& opts) {
+// Encodes |pixmap| as a complete WebP image, without its color profile.
+static bool encode_pixels(SkWStream* stream, const SkPixmap& pixmap,
+                          const SkWebpEncoder::Options& opts) {
     if (!SkPixmapIsValid(pixmap)) {
         return false;
     }
@@ -135,12 +140,13 @@ bool SkWebpEncoder::Encode(SkWStream* stream, const SkPixmap& pixmap, const Opti
     pic.width = pixmap.width();
     pic.height = pixmap.height();
     pic.writer = stream_writer;
+    pic.custom_ptr = (void*)stream;
 
     // Set compression, method, and pixel format.
     // libwebp recommends using BGRA for lossless and YUV for lossy.
-    // The choices of |webp_config.method| currently just match Chrome's defaults.  We
-    // could potentially expose this decision to the client.
-    if (Compression::kLossy == opts.fCompression) {
+    // Unless the client chose a method, the choices of |webp_config.method| just match
+    // Chrome's defaults.
+    if (SkWebpEncoder::Compression::kLossy == opts.fCompression) {
         webp_config.lossless = 0;
 #ifndef SK_WEBP_ENCODER_USE_DEFAULT_METHOD
         webp_config.method = 3;
@@ -151,13 +157,10 @@ bool SkWebpEncoder::Encode(SkWStream* stream, const SkPixmap& pixmap, const Opti
         webp_config.method = 0;
         pic.use_argb = 1;
     }
-
-    // If there is no need to embed an ICC profile, we write directly to the input stream.
-    // Otherwise, we will first encode to |tmp| and use a mux to add the ICC chunk.  libwebp
-    // forces us to have an encoded image before we can add a profile.
-    sk_sp<SkData> icc = icc_from_color_space(pixmap.info());
-    SkDynamicMemoryWStream tmp;
-    pic.custom_ptr = icc ? (void*)&tmp : (void*)stream;
+    if (opts.fMethod >= 0) {
+        webp_config.method = SkTMin(opts.fMethod, 6);
+    }
+    webp_config.thread_level = opts.fMultithreaded ? 1 : 0;
 
     const uint8_t* src = (uint8_t*)pixmap.addr();
     const int rgbStride = pic.width * bpp;
@@ -186,34 +189,104 @@ bool SkWebpEncoder::Encode(SkWStream* stream, const SkPixmap& pixmap, const Opti
         return false;
     }
 
-    if (!WebPEncode(&webp_config, &pic)) {
-        return false;
-    }
+    return WebPEncode(&webp_config, &pic);
+}
 
+// Adds |icc|, if any, to |mux|, and writes the result to |stream|.
+static bool assemble(SkWStream* stream, WebPMux* mux, const sk_sp<SkData>& icc) {
     if (icc) {
-        sk_sp<SkData> encodedData = tmp.detachAsData();
-        WebPData encoded = { encodedData->bytes(), encodedData->size() };
         WebPData iccChunk = { icc->bytes(), icc->size() };
-
-        SkAutoTCallVProc<WebPMux, WebPMuxDelete> mux(WebPMuxNew());
-        if (WEBP_MUX_OK != WebPMuxSetImage(mux, &encoded, 0)) {
+        if (WEBP_MUX_OK != WebPMuxSetChunk(mux, "ICCP", &iccChunk, 0)) {
             return false;
         }
+    }
 
-        if (WEBP_MUX_OK != WebPMuxSetChunk(mux, "ICCP", &iccChunk, 0)) {
+    WebPData assembled;
+    if (WEBP_MUX_OK != WebPMuxAssemble(mux, &assembled)) {
+        return false;
+    }
+
+    bool success = stream->write(assembled.bytes, assembled.size);
+    WebPDataClear(&assembled);
+    return success;
+}
+
+bool SkWebpEncoder::Encode(SkWStream* stream, const SkPixmap& pixmap, const Options& opts) {
+    // If there is no need to embed an ICC profile, we write directly to the input stream.
+    // Otherwise, we will first encode to |tmp| and use a mux to add the ICC chunk.  libwebp
+    // forces us to have an encoded image before we can add a profile.
+    sk_sp<SkData> icc = icc_from_color_space(pixmap.info());
+    if (!icc) {
+        return encode_pixels(stream, pixmap, opts);
+    }
+
+    SkDynamicMemoryWStream tmp;
+    if (!encode_pixels(&tmp, pixmap, opts)) {
+        return false;
+    }
+
+    sk_sp<SkData> encodedData = tmp.detachAsData();
+    WebPData encoded = { encodedData->bytes(), encodedData->size() };
+
+    SkAutoTCallVProc<WebPMux, WebPMuxDelete> mux(WebPMuxNew());
+    if (WEBP_MUX_OK != WebPMuxSetImage(mux, &encoded, 0)) {
+        return false;
+    }
+    return assemble(stream, mux, icc);
+}
+
+bool SkWebpEncoder::EncodeAnimated(SkWStream* stream, const Frame frames[], int frameCount,
+                                   const Options& opts, SkExecutor* executor) {
+    if (frameCount < 1) {
+        return false;
+    }
+    const SkISize dimensions = frames[0].fPixmap.info().dimensions();
+    for (int i = 1; i < frameCount; ++i) {
+        if (frames[i].fPixmap.info().dimensions() != dimensions) {
             return false;
         }
+    }
+
+    // Nothing in one frame depends on another, so they can all be encoded at once.
+    std::vector<sk_sp<SkData>> encoded(frameCount);
+    auto encodeFrame = [&](int i) {
+        SkDynamicMemoryWStream tmp;
+        if (encode_pixels(&tmp, frames[i].fPixmap, opts)) {
+            encoded[i] = tmp.detachAsData();
+        }
+    };
+    if (executor) {
+        SkTaskGroup(*executor).batch(frameCount, encodeFrame);
+    } else {
+        for (int i = 0; i < frameCount; ++i) {
+            encodeFrame(i);
+        }
+    }
 
-        WebPData assembled;
-        if (WEBP_MUX_OK != WebPMuxAssemble(mux, &assembled)) {
+    SkAutoTCallVProc<WebPMux, WebPMuxDelete> mux(WebPMuxNew());
+    for (int i = 0; i < frameCount; ++i) {
+        if (!encoded[i]) {
             return false;
         }
 
-        stream->write(assembled.bytes, assembled.size);
-        WebPDataClear(&assembled);
+        WebPMuxFrameInfo frame;
+        memset(&frame, 0, sizeof(frame));
+        frame.bitstream = { encoded[i]->bytes(), encoded[i]->size() };
+        frame.duration = frames[i].fDuration;
+        frame.id = WEBP_CHUNK_ANMF;
+        frame.dispose_method = WEBP_MUX_DISPOSE_NONE;
+        frame.blend_method = WEBP_MUX_NO_BLEND;
+        if (WEBP_MUX_OK != WebPMuxPushFrame(mux, &frame, 0)) {
+            return false;
+        }
     }
 
-    return true;
+    WebPMuxAnimParams params = { 0, 0 };  // Transparent background, loop forever.
+    if (WEBP_MUX_OK != WebPMuxSetCanvasSize(mux, dimensions.width(), dimensions.height()) ||
+        WEBP_MUX_OK != WebPMuxSetAnimationParams(mux, &params)) {
+        return false;
+    }
+    return assemble(stream, mux, icc_from_color_space(frames[0].fPixmap.info()));
 }
 
 #endif
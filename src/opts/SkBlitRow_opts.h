@@ -37,6 +37,32 @@
                                                                  _mm256_srli_epi32(src, 24))));
     }
 
+    #if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX512
+    // Same math as SkPMSrcOver_AVX2 above, 16 pixels at a time.  Requires AVX-512BW.
+    static inline __m512i SkPMSrcOver_AVX512(const __m512i& src, const __m512i& dst) {
+        auto SkAlphaMulQ_AVX512 = [](const __m512i& c, const __m512i& scale) {
+            const __m512i mask = _mm512_set1_epi32(0xFF00FF);
+            __m512i s = _mm512_or_si512(_mm512_slli_epi32(scale, 16), scale);
+
+            // uint32_t rb = ((c & mask) * scale) >> 8
+            __m512i rb = _mm512_and_si512(mask, c);
+            rb = _mm512_mullo_epi16(rb, s);
+            rb = _mm512_srli_epi16(rb, 8);
+
+            // uint32_t ag = ((c >> 8) & mask) * scale
+            __m512i ag = _mm512_srli_epi16(c, 8);
+            ag = _mm512_mullo_epi16(ag, s);
+
+            // (rb & mask) | (ag & ~mask)
+            ag = _mm512_andnot_si512(mask, ag);
+            return _mm512_or_si512(rb, ag);
+        };
+        return _mm512_add_epi32(src,
+                             SkAlphaMulQ_AVX512(dst, _mm512_sub_epi32(_mm512_set1_epi32(256),
+                                                                   _mm512_srli_epi32(src, 24))));
+    }
+    #endif
+
 #elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
     #include <immintrin.h>
 
@@ -141,8 +167,35 @@ static inline uint8x8_t SkPMSrcOver_neon2(uint8x8_t dst, uint8x8_t src) {
 void blit_row_s32a_opaque(SkPMColor* dst, const SkPMColor* src, int len, U8CPU alpha) {
     SkASSERT(alpha == 0xFF);
     sk_msan_assert_initialized(src, src+len);
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX512
+    const auto alphaMask = _mm512_set1_epi32(0xFF000000);
+    while (len > 0) {
+        // Load up to 16 source pixels, masking off any we'd read past the end of src.
+        __mmask16 live = len >= 16 ? (__mmask16)0xffff : (__mmask16)((1 << len) - 1);
+        auto s = _mm512_maskz_loadu_epi32(live, src);
+
+        // Pixels we didn't load act transparent here, so we skip them along with real ones.
+        auto alpha = _mm512_and_si512(s, alphaMask);
+        __mmask16 visible = _mm512_test_epi32_mask(s, alphaMask),
+                  opaque  = _mm512_mask_cmpeq_epi32_mask(live, alpha, alphaMask);
+        if (visible) {
+            if (opaque == live) {
+                // All source pixels are opaque.  SrcOver becomes Src.
+                _mm512_mask_storeu_epi32(dst, live, s);
+            } else {
+                // TODO: This math is wrong, in the same way as the AVX2 and SSE paths below.
+                // Do SrcOver.
+                auto d = _mm512_maskz_loadu_epi32(live, dst);
+                _mm512_mask_storeu_epi32(dst, visible, SkPMSrcOver_AVX512(s, d));
+            }
+        }
+        src += 16;
+        dst += 16;
+        len -= 16;
+    }
+
 // Require AVX2 because of AVX2 integer calculation intrinsics in SrcOver
-#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+#elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
     while (len >= 32) {
         // Load 32 source pixels.
         auto s0 = _mm256_loadu_si256((const __m256i*)(src) + 0),
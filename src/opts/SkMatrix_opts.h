@@ -0,0 +1,136 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkMatrix_opts_DEFINED
+#define SkMatrix_opts_DEFINED
+
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPoint3.h"
+#include "include/private/SkVx.h"
+#include <string.h>
+
+// SkMatrix's batch mapping. Points are mapped 4 (or homogeneous points 8) at a time, still
+// interleaved as they are in memory, so each lane does the same math, in the same order, as
+// mapping its point alone: x' = x*sx + y*kx + tx, and so on. src may be dst.
+
+namespace SK_OPTS_NS {
+
+    using F8 = skvx::Vec<8,float>;
+
+    // The matrix's values for x' in the even lanes and y' in the odd lanes, for 4 points.
+    static inline F8 interleave(float forX, float forY) {
+        return {forX, forY, forX, forY, forX, forY, forX, forY};
+    }
+
+    // {x0,y0, x1,y1, ...} -> {x0,x0, x1,x1, ...} and {y0,y0, y1,y1, ...}
+    static inline F8 xs(const F8& p) { return skvx::shuffle<0,0,2,2,4,4,6,6>(p); }
+    static inline F8 ys(const F8& p) { return skvx::shuffle<1,1,3,3,5,5,7,7>(p); }
+
+    // Maps 4 points at a time with fn. The last few are padded out to 4 rather than mapped with
+    // scalar math, which the compiler could fuse into FMAs, and round differently.
+    template <typename Fn>
+    static inline void map_4_at_a_time(SkPoint dst[], const SkPoint src[], int count, Fn&& fn) {
+        for (; count >= 4; count -= 4, src += 4, dst += 4) {
+            fn(F8::Load(src)).store(dst);
+        }
+        if (count > 0) {
+            SkPoint tmp[4] = {};
+            memcpy(tmp, src, count * sizeof(SkPoint));
+            fn(F8::Load(tmp)).store(tmp);
+            memcpy(dst, tmp, count * sizeof(SkPoint));
+        }
+    }
+
+    static void map_points_translate(const SkMatrix& m, SkPoint dst[], const SkPoint src[],
+                                     int count) {
+        const F8 trans = interleave(m.getTranslateX(), m.getTranslateY());
+        map_4_at_a_time(dst, src, count, [&](const F8& p) { return p + trans; });
+    }
+
+    static void map_points_scale_translate(const SkMatrix& m, SkPoint dst[], const SkPoint src[],
+                                           int count) {
+        const F8 trans = interleave(m.getTranslateX(), m.getTranslateY()),
+                 scale = interleave(m.getScaleX(),     m.getScaleY());
+        map_4_at_a_time(dst, src, count, [&](const F8& p) { return p * scale + trans; });
+    }
+
+    static void map_points_affine(const SkMatrix& m, SkPoint dst[], const SkPoint src[],
+                                  int count) {
+        const F8 trans = interleave(m.getTranslateX(), m.getTranslateY()),
+                 scale = interleave(m.getScaleX(),     m.getScaleY()),
+                 skew  = interleave(m.getSkewX(),      m.getSkewY());  // applied to {y0,x0, ...}
+        map_4_at_a_time(dst, src, count, [&](const F8& p) {
+            F8 swapped = skvx::shuffle<1,0,3,2,5,4,7,6>(p);
+            return p * scale + swapped * skew + trans;
+        });
+    }
+
+    // This one also divides by w for 4 points at once, where SkMatrix used to go one at a time.
+    static void map_points_perspective(const SkMatrix& m, SkPoint dst[], const SkPoint src[],
+                                       int count) {
+        // x' and y' are sums of each point's x times one of these and y times the other.
+        const F8 forX  = interleave(m[SkMatrix::kMScaleX], m[SkMatrix::kMSkewY]),
+                 forY  = interleave(m[SkMatrix::kMSkewX],  m[SkMatrix::kMScaleY]),
+                 trans = interleave(m[SkMatrix::kMTransX], m[SkMatrix::kMTransY]);
+        const float p0 = m[SkMatrix::kMPersp0],
+                    p1 = m[SkMatrix::kMPersp1],
+                    p2 = m[SkMatrix::kMPersp2];
+        map_4_at_a_time(dst, src, count, [&](const F8& p) {
+            F8 x = xs(p),
+               y = ys(p);
+            F8 xy = x * forX + y * forY + trans;
+        #ifdef SK_LEGACY_MATRIX_MATH_ORDER
+            F8 w = x * p0 + (y * p1 + p2);
+        #else
+            F8 w = x * p0 + y * p1 + p2;
+        #endif
+            // Points at infinity map to (0,0), as they do one at a time.
+            return xy * skvx::if_then_else(w != 0, 1 / w, F8(0));
+        });
+    }
+
+    static void map_homogeneous_points(const SkMatrix& m, SkPoint3 dst[], const SkPoint3 src[],
+                                       int count) {
+        const float sx = m[SkMatrix::kMScaleX], kx = m[SkMatrix::kMSkewX],
+                    tx = m[SkMatrix::kMTransX], ky = m[SkMatrix::kMSkewY],
+                    sy = m[SkMatrix::kMScaleY], ty = m[SkMatrix::kMTransY],
+                    p0 = m[SkMatrix::kMPersp0], p1 = m[SkMatrix::kMPersp1],
+                    p2 = m[SkMatrix::kMPersp2];
+        using F32 = skvx::Vec<32,float>;
+        // 8 points are 24 floats: {x0,y0,w0, x1,y1,w1, ...}.
+        auto map8 = [&](const float* s, float* d) {
+            F8 a = F8::Load(s + 0),
+               b = F8::Load(s + 8),
+               c = F8::Load(s + 16);
+            F32 p = skvx::join(skvx::join(a, b), skvx::join(c, c));
+            F8 x = skvx::shuffle<0,3,6, 9,12,15,18,21>(p),
+               y = skvx::shuffle<1,4,7,10,13,16,19,22>(p),
+               w = skvx::shuffle<2,5,8,11,14,17,20,23>(p);
+
+            F8 X = x * sx + y * kx + w * tx,
+               Y = x * ky + y * sy + w * ty,
+               W = x * p0 + y * p1 + w * p2;
+
+            F32 q = skvx::join(skvx::join(X, Y), skvx::join(W, W));
+            skvx::shuffle< 0, 8,16,  1, 9,17,  2,10>(q).store(d +  0);
+            skvx::shuffle<18, 3,11, 19, 4,12, 20, 5>(q).store(d +  8);
+            skvx::shuffle<13,21, 6, 14,22, 7, 15,23>(q).store(d + 16);
+        };
+        for (; count >= 8; count -= 8, src += 8, dst += 8) {
+            map8(&src->fX, &dst->fX);
+        }
+        if (count > 0) {
+            SkPoint3 tmp[8] = {};
+            memcpy(tmp, src, count * sizeof(SkPoint3));
+            map8(&tmp->fX, &tmp->fX);
+            memcpy(dst, tmp, count * sizeof(SkPoint3));
+        }
+    }
+
+}  // namespace SK_OPTS_NS
+
+#endif  // SkMatrix_opts_DEFINED
@@ -0,0 +1,229 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkMipMap_opts_DEFINED
+#define SkMipMap_opts_DEFINED
+
+#include "include/private/SkVx.h"
+#include <string.h>
+
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+    #include <immintrin.h>
+#elif SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+    #include <emmintrin.h>
+#elif defined(SK_ARM_HAS_NEON)
+    #include <arm_neon.h>
+#endif
+
+// These are the 2x2 box filters SkMipMap uses for levels with even dimensions, the common case.
+// Each writes count dst pixels, reading 2*count pixels from each of the two rows at src, and
+// must match SkMipMap's portable downsample_2_2<> exactly: integer channels are summed and
+// then shifted right by 2, and F16 is summed in float as ((c00 + c10) + c01) + c11.
+
+namespace SK_OPTS_NS {
+
+    static inline void downsample_2_2_8888_serial(uint8_t* d, const uint8_t* p0,
+                                                  const uint8_t* p1, int count) {
+        for (int i = 0; i < 4*count; i++) {
+            int c = i + (i & ~3);  // The first of the two pixels' channel i%4, in each row.
+            d[i] = (uint8_t)((p0[c] + p1[c] + p0[c+4] + p1[c+4]) >> 2);
+        }
+    }
+
+    static inline void downsample_2_2_A8_serial(uint8_t* d, const uint8_t* p0,
+                                                const uint8_t* p1, int count) {
+        for (int i = 0; i < count; i++) {
+            d[i] = (uint8_t)((p0[2*i] + p1[2*i] + p0[2*i+1] + p1[2*i+1]) >> 2);
+        }
+    }
+
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+    // Sums 4 pixels from each of r0 and r1 down to 2, leaving them in 16-bit lanes.
+    static inline __m128i sum_2_2_8888(__m128i r0, __m128i r1) {
+        const __m128i zero = _mm_setzero_si128();
+        __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(r0, zero), _mm_unpacklo_epi8(r1, zero)),
+                hi = _mm_add_epi16(_mm_unpackhi_epi8(r0, zero), _mm_unpackhi_epi8(r1, zero));
+        return _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(lo, hi),
+                                            _mm_unpackhi_epi64(lo, hi)), 2);
+    }
+
+    // Sums 16 bytes from each of r0 and r1 down to 8, leaving them in 16-bit lanes.
+    static inline __m128i sum_2_2_A8(__m128i r0, __m128i r1) {
+        const __m128i mask = _mm_set1_epi16(0x00FF);
+        __m128i s = _mm_add_epi16(_mm_add_epi16(_mm_and_si128(r0, mask), _mm_srli_epi16(r0, 8)),
+                                  _mm_add_epi16(_mm_and_si128(r1, mask), _mm_srli_epi16(r1, 8)));
+        return _mm_srli_epi16(s, 2);
+    }
+#endif
+
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+    // The same, for each 128-bit half of r0 and r1.
+    static inline __m256i sum_2_2_8888(__m256i r0, __m256i r1) {
+        const __m256i zero = _mm256_setzero_si256();
+        __m256i lo = _mm256_add_epi16(_mm256_unpacklo_epi8(r0, zero),
+                                      _mm256_unpacklo_epi8(r1, zero)),
+                hi = _mm256_add_epi16(_mm256_unpackhi_epi8(r0, zero),
+                                      _mm256_unpackhi_epi8(r1, zero));
+        return _mm256_srli_epi16(_mm256_add_epi16(_mm256_unpacklo_epi64(lo, hi),
+                                                  _mm256_unpackhi_epi64(lo, hi)), 2);
+    }
+
+    static inline __m256i sum_2_2_A8(__m256i r0, __m256i r1) {
+        const __m256i mask = _mm256_set1_epi16(0x00FF);
+        __m256i s = _mm256_add_epi16(
+                _mm256_add_epi16(_mm256_and_si256(r0, mask), _mm256_srli_epi16(r0, 8)),
+                _mm256_add_epi16(_mm256_and_si256(r1, mask), _mm256_srli_epi16(r1, 8)));
+        return _mm256_srli_epi16(s, 2);
+    }
+
+    // Packing works within 128-bit halves, so puts the results of a and b in the order
+    // {a.lo, b.lo, a.hi, b.hi}; this packs and puts them back in order.
+    static inline __m256i pack_in_order(__m256i a, __m256i b) {
+        return _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xD8);
+    }
+#endif
+
+    static void downsample_2_2_8888(void* dst, const void* src, size_t srcRB, int count) {
+        auto d  = static_cast<uint8_t*>(dst);
+        auto p0 = static_cast<const uint8_t*>(src);
+        auto p1 = p0 + srcRB;
+
+    #if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+        while (count >= 8) {
+            auto load = [](const uint8_t* p) { return _mm256_loadu_si256((const __m256i*)p); };
+            __m256i a = sum_2_2_8888(load(p0 +  0), load(p1 +  0)),
+                    b = sum_2_2_8888(load(p0 + 32), load(p1 + 32));
+            _mm256_storeu_si256((__m256i*)d, pack_in_order(a, b));
+            d += 32; p0 += 64; p1 += 64; count -= 8;
+        }
+    #endif
+    #if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+        while (count >= 4) {
+            auto load = [](const uint8_t* p) { return _mm_loadu_si128((const __m128i*)p); };
+            __m128i a = sum_2_2_8888(load(p0 +  0), load(p1 +  0)),
+                    b = sum_2_2_8888(load(p0 + 16), load(p1 + 16));
+            _mm_storeu_si128((__m128i*)d, _mm_packus_epi16(a, b));
+            d += 16; p0 += 32; p1 += 32; count -= 4;
+        }
+    #elif defined(SK_ARM_HAS_NEON)
+        while (count >= 4) {
+            // vld2 splits each row into its even and odd pixels.
+            uint32x4x2_t r0 = vld2q_u32((const uint32_t*)p0),
+                         r1 = vld2q_u32((const uint32_t*)p1);
+            uint8x16_t e0 = vreinterpretq_u8_u32(r0.val[0]), o0 = vreinterpretq_u8_u32(r0.val[1]),
+                       e1 = vreinterpretq_u8_u32(r1.val[0]), o1 = vreinterpretq_u8_u32(r1.val[1]);
+            uint16x8_t lo = vaddq_u16(vaddl_u8(vget_low_u8(e0), vget_low_u8(o0)),
+                                      vaddl_u8(vget_low_u8(e1), vget_low_u8(o1))),
+                       hi = vaddq_u16(vaddl_u8(vget_high_u8(e0), vget_high_u8(o0)),
+                                      vaddl_u8(vget_high_u8(e1), vget_high_u8(o1)));
+            vst1q_u8(d, vcombine_u8(vshrn_n_u16(lo, 2), vshrn_n_u16(hi, 2)));
+            d += 16; p0 += 32; p1 += 32; count -= 4;
+        }
+    #endif
+        downsample_2_2_8888_serial(d, p0, p1, count);
+    }
+
+    static void downsample_2_2_A8(void* dst, const void* src, size_t srcRB, int count) {
+        auto d  = static_cast<uint8_t*>(dst);
+        auto p0 = static_cast<const uint8_t*>(src);
+        auto p1 = p0 + srcRB;
+
+    #if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX2
+        while (count >= 32) {
+            auto load = [](const uint8_t* p) { return _mm256_loadu_si256((const __m256i*)p); };
+            __m256i a = sum_2_2_A8(load(p0 +  0), load(p1 +  0)),
+                    b = sum_2_2_A8(load(p0 + 32), load(p1 + 32));
+            _mm256_storeu_si256((__m256i*)d, pack_in_order(a, b));
+            d += 32; p0 += 64; p1 += 64; count -= 32;
+        }
+    #endif
+    #if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+        while (count >= 16) {
+            auto load = [](const uint8_t* p) { return _mm_loadu_si128((const __m128i*)p); };
+            __m128i a = sum_2_2_A8(load(p0 +  0), load(p1 +  0)),
+                    b = sum_2_2_A8(load(p0 + 16), load(p1 + 16));
+            _mm_storeu_si128((__m128i*)d, _mm_packus_epi16(a, b));
+            d += 16; p0 += 32; p1 += 32; count -= 16;
+        }
+    #elif defined(SK_ARM_HAS_NEON)
+        while (count >= 8) {
+            // vpaddl adds neighbouring pairs of bytes, and vpadal adds those to what it's given.
+            uint16x8_t s = vpadalq_u8(vpaddlq_u8(vld1q_u8(p0)), vld1q_u8(p1));
+            vst1_u8(d, vshrn_n_u16(s, 2));
+            d += 8; p0 += 16; p1 += 16; count -= 8;
+        }
+    #endif
+        downsample_2_2_A8_serial(d, p0, p1, count);
+    }
+
+    // Like SkHalfToFloat_finite_ftz() and SkFloatToHalf_finite_ftz(), for more lanes at once.
+    template <int N>
+    static inline skvx::Vec<N,float> half_to_float_finite_ftz(const skvx::Vec<N,uint16_t>& hs) {
+        using I = skvx::Vec<N,int32_t>;
+        I bits     = skvx::cast<int32_t>(hs),
+          sign     = bits & 0x00008000,
+          positive = bits ^ sign,
+          is_norm  = I(0x03ff) < positive,
+          norm     = (positive << 13) + ((127 - 15) << 23),
+          merged   = (sign << 16) | (norm & is_norm);
+        return skvx::bit_pun<skvx::Vec<N,float>>(merged);
+    }
+
+    template <int N>
+    static inline skvx::Vec<N,uint16_t> float_to_half_finite_ftz(const skvx::Vec<N,float>& fs) {
+        using I = skvx::Vec<N,int32_t>;
+        I bits         = skvx::bit_pun<I>(fs),
+          sign         = bits & 0x80000000,
+          positive     = bits ^ sign,
+          will_be_norm = I(0x387fdfff) < positive,
+          norm         = (positive - ((127 - 15) << 23)) >> 13,
+          merged       = (sign >> 16) | (will_be_norm & norm);
+        return skvx::cast<uint16_t>(merged);
+    }
+
+    // Split a row of F16 pixels, as floats, into its even and odd pixels.
+    static inline skvx::Vec<4,float> even_pixels(const skvx::Vec<8,float>& x) {
+        return skvx::shuffle<0,1,2,3>(x);
+    }
+    static inline skvx::Vec<4,float> odd_pixels(const skvx::Vec<8,float>& x) {
+        return skvx::shuffle<4,5,6,7>(x);
+    }
+    static inline skvx::Vec<16,float> even_pixels(const skvx::Vec<32,float>& x) {
+        return skvx::shuffle<0,1,2,3, 8,9,10,11, 16,17,18,19, 24,25,26,27>(x);
+    }
+    static inline skvx::Vec<16,float> odd_pixels(const skvx::Vec<32,float>& x) {
+        return skvx::shuffle<4,5,6,7, 12,13,14,15, 20,21,22,23, 28,29,30,31>(x);
+    }
+
+    // Filters N dst pixels from 2N pixels in each row.
+    template <int N>
+    static inline void downsample_2_2_F16_N(uint8_t* d, const uint8_t* p0, const uint8_t* p1) {
+        using H = skvx::Vec<8*N,uint16_t>;
+        auto r0 = half_to_float_finite_ftz(H::Load(p0)),
+             r1 = half_to_float_finite_ftz(H::Load(p1));
+        auto c = even_pixels(r0) + even_pixels(r1) + odd_pixels(r0) + odd_pixels(r1);
+        float_to_half_finite_ftz(c * 0.25f).store(d);
+    }
+
+    static void downsample_2_2_F16(void* dst, const void* src, size_t srcRB, int count) {
+        auto d  = static_cast<uint8_t*>(dst);
+        auto p0 = static_cast<const uint8_t*>(src);
+        auto p1 = p0 + srcRB;
+
+        while (count >= 4) {
+            downsample_2_2_F16_N<4>(d, p0, p1);
+            d += 32; p0 += 64; p1 += 64; count -= 4;
+        }
+        while (count > 0) {
+            downsample_2_2_F16_N<1>(d, p0, p1);
+            d += 8; p0 += 16; p1 += 16; count -= 1;
+        }
+    }
+
+}  // namespace SK_OPTS_NS
+
+#endif//SkMipMap_opts_DEFINED
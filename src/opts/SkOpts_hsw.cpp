@@ -9,7 +9,10 @@
 
 #define SK_OPTS_NS hsw
 #include "src/opts/SkBlitRow_opts.h"
+#include "src/opts/SkMatrix_opts.h"
+#include "src/opts/SkMipMap_opts.h"
 #include "src/opts/SkRasterPipeline_opts.h"
+#include "src/opts/SkSwizzler_opts.h"
 #include "src/opts/SkUtils_opts.h"
 
 namespace SkOpts {
@@ -17,6 +20,27 @@ namespace SkOpts {
         blit_row_color32     = hsw::blit_row_color32;
         blit_row_s32a_opaque = hsw::blit_row_s32a_opaque;
 
+        downsample_2_2_8888 = hsw::downsample_2_2_8888;
+        downsample_2_2_F16  = hsw::downsample_2_2_F16;
+        downsample_2_2_A8   = hsw::downsample_2_2_A8;
+
+        map_points_translate       = hsw::map_points_translate;
+        map_points_scale_translate = hsw::map_points_scale_translate;
+        map_points_affine          = hsw::map_points_affine;
+        map_points_perspective     = hsw::map_points_perspective;
+        map_homogeneous_points     = hsw::map_homogeneous_points;
+
+        RGBA_to_BGRA          = hsw::RGBA_to_BGRA;
+        RGBA_to_rgbA          = hsw::RGBA_to_rgbA;
+        RGBA_to_bgrA          = hsw::RGBA_to_bgrA;
+        RGB_to_RGB1           = hsw::RGB_to_RGB1;
+        RGB_to_BGR1           = hsw::RGB_to_BGR1;
+        gray_to_RGB1          = hsw::gray_to_RGB1;
+        grayA_to_RGBA         = hsw::grayA_to_RGBA;
+        grayA_to_rgbA         = hsw::grayA_to_rgbA;
+        inverted_CMYK_to_RGB1 = hsw::inverted_CMYK_to_RGB1;
+        inverted_CMYK_to_BGR1 = hsw::inverted_CMYK_to_BGR1;
+
     #define M(st) stages_highp[SkRasterPipeline::st] = (StageFn)SK_OPTS_NS::st;
         SK_RASTER_PIPELINE_STAGES(M)
         just_return_highp = (StageFn)SK_OPTS_NS::just_return;
@@ -1712,6 +1712,23 @@ STAGE(store_8888, const SkRasterPipeline_MemoryCtx* ctx) {
     store(ptr, px, tail);
 }
 
+// Reads Y, U, V, and A into r, g, b, and a from the nearest pixel of each one's plane.
+STAGE(gather_yuva, const SkRasterPipeline_YUVACtx* ctx) {
+    const F x = r,
+            y = g;
+    F* channels[] = { &r, &g, &b, &a };
+    for (int i = 0; i < 4; i++) {
+        if (!ctx->pixels[i]) {
+            *channels[i] = 1.0f;
+            continue;
+        }
+        F px = clamp(x * ctx->scaleX[i], ctx->width[i]),
+          py = clamp(mad(y, ctx->scaleY[i], ctx->transY[i]), ctx->height[i]);
+        U32 ix = trunc_(py) * ctx->rowBytes[i] + trunc_(px) * ctx->bytesPerPixel[i];
+        *channels[i] = from_byte(gather(ctx->pixels[i], ix));
+    }
+}
+
 STAGE(load_1010102, const SkRasterPipeline_MemoryCtx* ctx) {
     auto ptr = ptr_at_xy<const uint32_t>(ctx, dx,dy);
     from_1010102(load<U32>(ptr, tail), &r,&g,&b,&a);
@@ -1775,6 +1792,27 @@ STAGE(store_f16, const SkRasterPipeline_MemoryCtx* ctx) {
                               , to_half(a));
 }
 
+// load_f16_dst, srcover, and store_f16 fused, the common case for drawing into F16 surfaces.
+STAGE(srcover_rgba_f16, const SkRasterPipeline_MemoryCtx* ctx) {
+    auto ptr = ptr_at_xy<uint64_t>(ctx, dx,dy);
+
+    U16 R,G,B,A;
+    load4((const uint16_t*)ptr,tail, &R,&G,&B,&A);
+    dr = from_half(R);
+    dg = from_half(G);
+    db = from_half(B);
+    da = from_half(A);
+
+    r = mad(dr, inv(a), r);
+    g = mad(dg, inv(a), g);
+    b = mad(db, inv(a), b);
+    a = mad(da, inv(a), a);
+    store4((uint16_t*)ptr,tail, to_half(r)
+                              , to_half(g)
+                              , to_half(b)
+                              , to_half(a));
+}
+
 STAGE(store_u16_be, const SkRasterPipeline_MemoryCtx* ctx) {
     auto ptr = ptr_at_xy<uint16_t>(ctx, 4*dx,dy);
 
@@ -1831,6 +1869,41 @@ STAGE( clamp_x_1, Ctx::None) { r = clamp_01(r); }
 STAGE(repeat_x_1, Ctx::None) { r = clamp_01(r - floor_(r)); }
 STAGE(mirror_x_1, Ctx::None) { r = clamp_01(abs_( (r-1.0f) - two(floor_((r-1.0f)*0.5f)) - 1.0f )); }
 
+// Trilinearly interpolates r,g,b through a 3D lookup table.
+STAGE(color_cube, const SkRasterPipeline_ColorCubeCtx* ctx) {
+    const float    last    = (float)(ctx->dim - 1);
+    const uint32_t gStride = ctx->dim,
+                   bStride = ctx->dim * ctx->dim;
+
+    // The lattice point below v, kept short of the last so there's always one above it too,
+    // and how far v is from it towards that next one.
+    auto lattice = [&](F v, F* frac) {
+        v = clamp_01(v) * last;
+        F lo = min(floor_(v), last - 1);
+        *frac = v - lo;
+        return trunc_(lo);
+    };
+
+    F fr, fg, fb;
+    U32 ix = lattice(r, &fr) + lattice(g, &fg) * gStride + lattice(b, &fb) * bStride;
+
+    auto sample = [&](const float* plane) {
+        U32 i00 = ix,
+            i10 = ix + gStride,
+            i01 = ix + bStride,
+            i11 = ix + gStride + bStride;
+        F c00 = lerp(gather(plane, i00), gather(plane, i00 + 1), fr),
+          c10 = lerp(gather(plane, i10), gather(plane, i10 + 1), fr),
+          c01 = lerp(gather(plane, i01), gather(plane, i01 + 1), fr),
+          c11 = lerp(gather(plane, i11), gather(plane, i11 + 1), fr);
+        return lerp(lerp(c00, c10, fg),
+                    lerp(c01, c11, fg), fb);
+    };
+    r = sample(ctx->r);
+    g = sample(ctx->g);
+    b = sample(ctx->b);
+}
+
 // Decal stores a 32bit mask after checking the coordinate (x and/or y) against its domain:
 //      mask == 0x00000000 if the coordinate(s) are out of bounds
 //      mask == 0xFFFFFFFF if the coordinate(s) are in bounds
@@ -1968,13 +2041,29 @@ STAGE(evenly_spaced_gradient, const SkRasterPipeline_GradientCtx* c) {
     gradient_lookup(c, idx, t, &r, &g, &b, &a);
 }
 
+// The same interval the gradient stage's search finds, but starting from the interval where t's
+// bucket starts, so that only the few stops inside that bucket are compared against.
+SI U32 bucketed_stop_index(const SkRasterPipeline_GradientCtx* c, F t) {
+    F clamped = if_then_else(t > 0, t, F(0));
+    clamped = if_then_else(clamped < 1, clamped, F(1));
+    U32 idx = gather(c->stopBuckets, trunc_(clamped * (float)c->bucketCount));
+    for (int i = 0; i < c->maxStopsPerBucket; i++) {
+        idx += if_then_else(t >= gather(c->ts, idx + 1), U32(1), U32(0));
+    }
+    return idx;
+}
+
 STAGE(gradient, const SkRasterPipeline_GradientCtx* c) {
     auto t = r;
     U32 idx = 0;
 
-    // N.B. The loop starts at 1 because idx 0 is the color to use before the first stop.
-    for (size_t i = 1; i < c->stopCount; i++) {
-        idx += if_then_else(t >= c->ts[i], U32(1), U32(0));
+    if (c->stopBuckets) {
+        idx = bucketed_stop_index(c, t);
+    } else {
+        // N.B. The loop starts at 1 because idx 0 is the color to use before the first stop.
+        for (size_t i = 1; i < c->stopCount; i++) {
+            idx += if_then_else(t >= c->ts[i], U32(1), U32(0));
+        }
     }
 
     gradient_lookup(c, idx, t, &r, &g, &b, &a);
@@ -2214,11 +2303,22 @@ STAGE(gauss_a_to_rgba, Ctx::None) {
     b = a;
 }
 
-// A specialized fused image shader for clamp-x, clamp-y, non-sRGB sampling.
-STAGE(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
+// Tiles v to [0,limit) as repeat_x/mirror_x do, or leaves it for ix_and_ptr() to clamp.
+SI F tile(F v, SkTileMode mode, const SkRasterPipeline_TileCtx* limit) {
+    switch (mode) {
+        case SkTileMode::kRepeat: return exclusive_repeat(v, limit);
+        case SkTileMode::kMirror: return exclusive_mirror(v, limit);
+        default:                  return v;
+    }
+}
+
+// A specialized fused image shader for bilinear, non-sRGB sampling of 8888 images, clamping to
+// the image's edges or tiling each sample point if tiling is non-null.
+SI void bilerp_8888(const SkRasterPipeline_GatherCtx* ctx,
+                    const SkRasterPipeline_TiledGatherCtx* tiling, F* r, F* g, F* b, F* a) {
     // (cx,cy) are the center of our sample.
-    F cx = r,
-      cy = g;
+    F cx = *r,
+      cy = *g;
 
     // All sample points are at the same fractional offset (fx,fy).
     // They're the 4 corners of a logical 1x1 pixel surrounding (x,y) at (0.5,0.5) offsets.
@@ -2226,7 +2326,7 @@ STAGE(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
       fy = fract(cy + 0.5f);
 
     // We'll accumulate the color of all four samples into {r,g,b,a} directly.
-    r = g = b = a = 0;
+    *r = *g = *b = *a = 0;
 
     for (float dy = -0.5f; dy <= +0.5f; dy += 1.0f)
     for (float dx = -0.5f; dx <= +0.5f; dx += 1.0f) {
@@ -2234,6 +2334,11 @@ STAGE(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
         F x = cx + dx,
           y = cy + dy;
 
+        if (tiling) {
+            x = tile(x, tiling->modeX, &tiling->limitX);
+            y = tile(y, tiling->modeY, &tiling->limitY);
+        }
+
         // ix_and_ptr() will clamp to the image's bounds for us.
         const uint32_t* ptr;
         U32 ix = ix_and_ptr(&ptr, ctx, x,y);
@@ -2249,10 +2354,54 @@ STAGE(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
           sy = (dy > 0) ? fy : 1.0f - fy,
           area = sx * sy;
 
-        r += sr * area;
-        g += sg * area;
-        b += sb * area;
-        a += sa * area;
+        *r += sr * area;
+        *g += sg * area;
+        *b += sb * area;
+        *a += sa * area;
+    }
+}
+
+STAGE(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
+    bilerp_8888(ctx, nullptr, &r,&g,&b,&a);
+}
+STAGE(bilerp_tiled_8888, const SkRasterPipeline_TiledGatherCtx* ctx) {
+    bilerp_8888(&ctx->gather, ctx, &r,&g,&b,&a);
+}
+
+// bicubic_clamp_8888 is the 16 bicubic_{n3,n1,p1,p3}{x,y} samples fused with clamped 8888 gathers,
+// computing each axis' four weights once rather than once per sample.
+STAGE(bicubic_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
+    // (cx,cy) are the center of our sample.
+    F cx = r,
+      cy = g;
+
+    // All sample points are at the same fractional offset (fx,fy).
+    // They're the 16 corners of a logical 3x3 grid surrounding (x,y) at (0.5,0.5) offsets.
+    F fx = fract(cx + 0.5f),
+      fy = fract(cy + 0.5f);
+    const F wx[] = { bicubic_far(1-fx), bicubic_near(1-fx), bicubic_near(fx), bicubic_far(fx) },
+            wy[] = { bicubic_far(1-fy), bicubic_near(1-fy), bicubic_near(fy), bicubic_far(fy) };
+
+    // We'll accumulate the color of all 16 samples into {r,g,b,a} directly.
+    r = g = b = a = 0;
+
+    F y = cy - 1.5f;
+    for (int j = 0; j < 4; j++, y += 1.0f) {
+        F x = cx - 1.5f;
+        for (int i = 0; i < 4; i++, x += 1.0f) {
+            // ix_and_ptr() will clamp to the image's bounds for us.
+            const uint32_t* ptr;
+            U32 ix = ix_and_ptr(&ptr, ctx, x,y);
+
+            F sr,sg,sb,sa;
+            from_8888(gather(ptr, ix), &sr,&sg,&sb,&sa);
+
+            F w = wx[i] * wy[j];
+            r = mad(sr, w, r);
+            g = mad(sg, w, g);
+            b = mad(sb, w, b);
+            a = mad(sa, w, a);
+        }
     }
 }
 
@@ -3155,6 +3304,21 @@ STAGE_PP(emboss, const SkRasterPipeline_EmbossCtx* ctx) {
 // Even repeat and mirror funnel through a clamp to handle bad inputs like +Inf, NaN.
 SI F clamp_01(F v) { return min(max(0, v), 1); }
 
+SI F exclusive_repeat(F v, const SkRasterPipeline_TileCtx* ctx) {
+    return v - floor_(v*ctx->invScale)*ctx->scale;
+}
+SI F exclusive_mirror(F v, const SkRasterPipeline_TileCtx* ctx) {
+    auto limit = ctx->scale;
+    auto invLimit = ctx->invScale;
+    return abs_( (v-limit) - (limit+limit)*floor_((v-limit)*(invLimit*0.5f)) - limit );
+}
+
+// As in highp, the gather stages clamp the output of these to [0,limit).
+STAGE_GG(repeat_x, const SkRasterPipeline_TileCtx* ctx) { x = exclusive_repeat(x, ctx); }
+STAGE_GG(repeat_y, const SkRasterPipeline_TileCtx* ctx) { y = exclusive_repeat(y, ctx); }
+STAGE_GG(mirror_x, const SkRasterPipeline_TileCtx* ctx) { x = exclusive_mirror(x, ctx); }
+STAGE_GG(mirror_y, const SkRasterPipeline_TileCtx* ctx) { y = exclusive_mirror(y, ctx); }
+
 STAGE_GG(clamp_x_1 , Ctx::None) { x = clamp_01(x); }
 STAGE_GG(repeat_x_1, Ctx::None) { x = clamp_01(x - floor_(x)); }
 STAGE_GG(mirror_x_1, Ctx::None) {
@@ -3242,13 +3406,27 @@ SI void gradient_lookup(const SkRasterPipeline_GradientCtx* c, U32 idx, F t,
                    r,g,b,a);
 }
 
+SI U32 bucketed_stop_index(const SkRasterPipeline_GradientCtx* c, F t) {
+    F clamped = if_then_else(t > 0, t, F(0));
+    clamped = if_then_else(clamped < 1, clamped, F(1));
+    U32 idx = gather<U32>(c->stopBuckets, trunc_(clamped * (float)c->bucketCount));
+    for (int i = 0; i < c->maxStopsPerBucket; i++) {
+        idx += if_then_else(t >= gather<F>(c->ts, idx + 1), U32(1), U32(0));
+    }
+    return idx;
+}
+
 STAGE_GP(gradient, const SkRasterPipeline_GradientCtx* c) {
     auto t = x;
     U32 idx = 0;
 
-    // N.B. The loop starts at 1 because idx 0 is the color to use before the first stop.
-    for (size_t i = 1; i < c->stopCount; i++) {
-        idx += if_then_else(t >= c->ts[i], U32(1), U32(0));
+    if (c->stopBuckets) {
+        idx = bucketed_stop_index(c, t);
+    } else {
+        // N.B. The loop starts at 1 because idx 0 is the color to use before the first stop.
+        for (size_t i = 1; i < c->stopCount; i++) {
+            idx += if_then_else(t >= c->ts[i], U32(1), U32(0));
+        }
     }
 
     gradient_lookup(c, idx, t, &r, &g, &b, &a);
@@ -3312,11 +3490,20 @@ STAGE_PP(srcover_rgba_8888, const SkRasterPipeline_MemoryCtx* ctx) {
 
 #if defined(SK_DISABLE_LOWP_BILERP_CLAMP_CLAMP_STAGE)
     static void(*bilerp_clamp_8888)(void) = nullptr;
+    static void(*bilerp_tiled_8888)(void) = nullptr;
 #else
-STAGE_GP(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
+SI F tile(F v, SkTileMode mode, const SkRasterPipeline_TileCtx* limit) {
+    switch (mode) {
+        case SkTileMode::kRepeat: return exclusive_repeat(v, limit);
+        case SkTileMode::kMirror: return exclusive_mirror(v, limit);
+        default:                  return v;
+    }
+}
+
+SI void bilerp_8888(const SkRasterPipeline_GatherCtx* ctx,
+                    const SkRasterPipeline_TiledGatherCtx* tiling, F cx, F cy,
+                    U16* r, U16* g, U16* b, U16* a) {
     // (cx,cy) are the center of our sample.
-    F cx = x,
-      cy = y;
 
     // All sample points are at the same fractional offset (fx,fy).
     // They're the 4 corners of a logical 1x1 pixel surrounding (x,y) at (0.5,0.5) offsets.
@@ -3324,7 +3511,7 @@ STAGE_GP(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
       fy = fract(cy + 0.5f);
 
     // We'll accumulate the color of all four samples into {r,g,b,a} directly.
-    r = g = b = a = 0;
+    *r = *g = *b = *a = 0;
 
     // The first three sample points will calculate their area using math
     // just like in the float code above, but the fourth will take up all the rest.
@@ -3343,6 +3530,11 @@ STAGE_GP(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
         F x = cx + dx,
           y = cy + dy;
 
+        if (tiling) {
+            x = tile(x, tiling->modeX, &tiling->limitX);
+            y = tile(y, tiling->modeY, &tiling->limitY);
+        }
+
         // ix_and_ptr() will clamp to the image's bounds for us.
         const uint32_t* ptr;
         U32 ix = ix_and_ptr(&ptr, ctx, x,y);
@@ -3364,16 +3556,23 @@ STAGE_GP(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
         }
         remaining -= area;
 
-        r += sr * area;
-        g += sg * area;
-        b += sb * area;
-        a += sa * area;
+        *r += sr * area;
+        *g += sg * area;
+        *b += sb * area;
+        *a += sa * area;
     }
 
-    r = (r + bias/2) / bias;
-    g = (g + bias/2) / bias;
-    b = (b + bias/2) / bias;
-    a = (a + bias/2) / bias;
+    *r = (*r + bias/2) / bias;
+    *g = (*g + bias/2) / bias;
+    *b = (*b + bias/2) / bias;
+    *a = (*a + bias/2) / bias;
+}
+
+STAGE_GP(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
+    bilerp_8888(ctx, nullptr, x,y, &r,&g,&b,&a);
+}
+STAGE_GP(bilerp_tiled_8888, const SkRasterPipeline_TiledGatherCtx* ctx) {
+    bilerp_8888(&ctx->gather, ctx, x,y, &r,&g,&b,&a);
 }
 #endif
 
@@ -3390,6 +3589,7 @@ STAGE_GP(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
     NOT_IMPLEMENTED(load_f16)
     NOT_IMPLEMENTED(load_f16_dst)
     NOT_IMPLEMENTED(store_f16)
+    NOT_IMPLEMENTED(srcover_rgba_f16)
     NOT_IMPLEMENTED(gather_f16)
     NOT_IMPLEMENTED(load_f32)
     NOT_IMPLEMENTED(load_f32_dst)
@@ -3399,8 +3599,10 @@ STAGE_GP(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
     NOT_IMPLEMENTED(load_1010102_dst)
     NOT_IMPLEMENTED(store_1010102)
     NOT_IMPLEMENTED(gather_1010102)
+    NOT_IMPLEMENTED(gather_yuva)
     NOT_IMPLEMENTED(store_u16_be)
     NOT_IMPLEMENTED(byte_tables)  // TODO
+    NOT_IMPLEMENTED(color_cube)
     NOT_IMPLEMENTED(colorburn)
     NOT_IMPLEMENTED(colordodge)
     NOT_IMPLEMENTED(softlight)
@@ -3417,10 +3619,6 @@ STAGE_GP(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
     NOT_IMPLEMENTED(rgb_to_hsl)
     NOT_IMPLEMENTED(hsl_to_rgb)
     NOT_IMPLEMENTED(gauss_a_to_rgba)  // TODO
-    NOT_IMPLEMENTED(mirror_x)         // TODO
-    NOT_IMPLEMENTED(repeat_x)         // TODO
-    NOT_IMPLEMENTED(mirror_y)         // TODO
-    NOT_IMPLEMENTED(repeat_y)         // TODO
     NOT_IMPLEMENTED(negate_x)
     NOT_IMPLEMENTED(bilinear_nx)      // TODO
     NOT_IMPLEMENTED(bilinear_ny)      // TODO
@@ -3434,6 +3632,7 @@ STAGE_GP(bilerp_clamp_8888, const SkRasterPipeline_GatherCtx* ctx) {
     NOT_IMPLEMENTED(bicubic_n1y)      // TODO
     NOT_IMPLEMENTED(bicubic_p1y)      // TODO
     NOT_IMPLEMENTED(bicubic_p3y)      // TODO
+    NOT_IMPLEMENTED(bicubic_clamp_8888)
     NOT_IMPLEMENTED(save_xy)          // TODO
     NOT_IMPLEMENTED(accumulate)       // TODO
     NOT_IMPLEMENTED(xy_to_2pt_conical_well_behaved)
@@ -11,8 +11,43 @@
 #include <stdint.h>
 #include "include/private/SkNx.h"
 
+#if defined(SK_CPU_SSE_LEVEL) && SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX512
+    #include <immintrin.h>
+#endif
+
 namespace SK_OPTS_NS {
 
+#if defined(SK_CPU_SSE_LEVEL) && SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX512
+    // With AVX-512 we write 64 bytes at a time, finishing with a single masked store.
+    // 16-bit lanes require AVX-512BW.
+    static void memsetT(uint16_t buffer[], uint16_t value, int count) {
+        const __m512i v = _mm512_set1_epi16(value);
+        for (; count >= 32; buffer += 32, count -= 32) {
+            _mm512_storeu_si512(buffer, v);
+        }
+        if (count > 0) {
+            _mm512_mask_storeu_epi16(buffer, (__mmask32)((1u << count) - 1), v);
+        }
+    }
+    static void memsetT(uint32_t buffer[], uint32_t value, int count) {
+        const __m512i v = _mm512_set1_epi32(value);
+        for (; count >= 16; buffer += 16, count -= 16) {
+            _mm512_storeu_si512(buffer, v);
+        }
+        if (count > 0) {
+            _mm512_mask_storeu_epi32(buffer, (__mmask16)((1u << count) - 1), v);
+        }
+    }
+    static void memsetT(uint64_t buffer[], uint64_t value, int count) {
+        const __m512i v = _mm512_set1_epi64(value);
+        for (; count >= 8; buffer += 8, count -= 8) {
+            _mm512_storeu_si512(buffer, v);
+        }
+        if (count > 0) {
+            _mm512_mask_storeu_epi64(buffer, (__mmask8)((1u << count) - 1), v);
+        }
+    }
+#else
     template <typename T>
     static void memsetT(T buffer[], T value, int count) {
     #if defined(SK_CPU_SSE_LEVEL) && SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_AVX
@@ -29,6 +64,7 @@ namespace SK_OPTS_NS {
             *buffer++ = value;
         }
     }
+#endif
 
     /*not static*/ inline void memset16(uint16_t buffer[], uint16_t value, int count) {
         memsetT(buffer, value, count);
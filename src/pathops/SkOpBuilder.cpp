@@ -120,25 +120,16 @@ void SkOpBuilder::reset() {
     fOps.reset();
 }
 
-/* OPTIMIZATION: Union doesn't need to be all-or-nothing. A run of three or more convex
-   paths with union ops could be locally resolved and still improve over doing the
-   ops one at a time. */
-bool SkOpBuilder::resolve(SkPath* result) {
-    SkPath original = *result;
-    int count = fOps.count();
-    bool allUnion = true;
+bool SkOpBuilder::ResolveUnion(SkPath* paths[], int count, SkPath* result) {
+    bool canSum = true;
     SkPathPriv::FirstDirection firstDir = SkPathPriv::kUnknown_FirstDirection;
     for (int index = 0; index < count; ++index) {
-        SkPath* test = &fPathRefs[index];
-        if (kUnion_SkPathOp != fOps[index] || test->isInverseFillType()) {
-            allUnion = false;
-            break;
-        }
+        SkPath* test = paths[index];
         // If all paths are convex, track direction, reversing as needed.
         if (test->isConvex()) {
             SkPathPriv::FirstDirection dir;
             if (!SkPathPriv::CheapComputeFirstDirection(*test, &dir)) {
-                allUnion = false;
+                canSum = false;
                 break;
             }
             if (firstDir == SkPathPriv::kUnknown_FirstDirection) {
@@ -152,11 +143,53 @@ bool SkOpBuilder::resolve(SkPath* result) {
         const SkRect& testBounds = test->getBounds();
         for (int inner = 0; inner < index; ++inner) {
             // OPTIMIZE: check to see if the contour bounds do not intersect other contour bounds?
-            if (SkRect::Intersects(fPathRefs[inner].getBounds(), testBounds)) {
-                allUnion = false;
+            if (SkRect::Intersects(paths[inner]->getBounds(), testBounds)) {
+                canSum = false;
                 break;
             }
         }
+        if (!canSum) {
+            break;
+        }
+    }
+    if (!canSum) {
+        // Union pairs of paths, then pairs of those results, and so on, so that no operand grows
+        // to hold most of the group while the rest are added to it one at a time.
+        for (int stride = 1; stride < count; stride *= 2) {
+            for (int index = 0; index + stride < count; index += 2 * stride) {
+                if (!Op(*paths[index], *paths[index + stride], kUnion_SkPathOp, paths[index])) {
+                    return false;
+                }
+            }
+        }
+        *result = *paths[0];
+        return true;
+    }
+    SkPath sum;
+    for (int index = 0; index < count; ++index) {
+        if (!Simplify(*paths[index], paths[index])) {
+            return false;
+        }
+        if (!paths[index]->isEmpty()) {
+            // convert the even odd result back to winding form before accumulating it
+            if (!FixWinding(paths[index])) {
+                return false;
+            }
+            sum.addPath(*paths[index]);
+        }
+    }
+    return Simplify(sum, result);
+}
+
+bool SkOpBuilder::resolve(SkPath* result) {
+    SkPath original = *result;
+    int count = fOps.count();
+    bool allUnion = true;
+    for (int index = 0; index < count; ++index) {
+        if (kUnion_SkPathOp != fOps[index] || fPathRefs[index].isInverseFillType()) {
+            allUnion = false;
+            break;
+        }
     }
     if (!allUnion) {
         *result = fPathRefs[0];
@@ -170,26 +203,41 @@ bool SkOpBuilder::resolve(SkPath* result) {
         reset();
         return true;
     }
-    SkPath sum;
+
+    // Paths whose bounds are apart can't change each other's part of the union, so each group of
+    // paths whose bounds intersect is resolved on its own, and the groups' results are appended.
+    SkTDArray<SkRect> bounds;
     for (int index = 0; index < count; ++index) {
-        if (!Simplify(fPathRefs[index], &fPathRefs[index])) {
+        *bounds.append() = fPathRefs[index].getBounds();
+    }
+    SkTDArray<int> groupOf;
+    int groupCount = GroupByBounds(bounds.begin(), count, &groupOf);
+    SkTDArray<SkPath*> group;
+    SkPath sum;
+    sum.setFillType(SkPath::kEvenOdd_FillType);
+    for (int groupIndex = 0; groupIndex < groupCount; ++groupIndex) {
+        group.rewind();
+        for (int index = 0; index < count; ++index) {
+            if (groupOf[index] == groupIndex) {
+                *group.append() = &fPathRefs[index];
+            }
+        }
+        SkPath groupResult;
+        if (!ResolveUnion(group.begin(), group.count(), &groupResult)) {
             reset();
             *result = original;
             return false;
         }
-        if (!fPathRefs[index].isEmpty()) {
-            // convert the even odd result back to winding form before accumulating it
-            if (!FixWinding(&fPathRefs[index])) {
-                *result = original;
-                return false;
-            }
-            sum.addPath(fPathRefs[index]);
+        if (groupCount == 1) {
+            sum = groupResult;
+        } else {
+            sum.addPath(groupResult);
         }
     }
     reset();
-    bool success = Simplify(sum, result);
-    if (!success) {
-        *result = original;
+    if (groupCount == 0) {
+        return Simplify(sum, result);
     }
-    return success;
+    *result = sum;
+    return true;
 }
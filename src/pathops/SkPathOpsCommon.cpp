@@ -6,7 +6,9 @@
  */
 
 #include "include/private/SkMacros.h"
+#include "include/private/SkTArray.h"
 #include "src/core/SkTSort.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/pathops/SkAddIntersections.h"
 #include "src/pathops/SkOpCoincidence.h"
 #include "src/pathops/SkOpEdgeBuilder.h"
@@ -331,3 +333,170 @@ bool HandleCoincidence(SkOpContourHead* contourList, SkOpCoincidence* coincidenc
     SkPathOpsDebug::ShowActiveSpans(contourList);
     return true;
 }
+
+// Puts each rect in a group such that no rect intersects or touches one in another group, by
+// sweeping across them from left to right. Returns the number of groups; groupOf[i] is the group
+// of bounds[i]. Groups are numbered in the order of their first rect.
+int GroupByBounds(const SkRect bounds[], int count, SkTDArray<int>* groupOf) {
+    SkTDArray<int> order;
+    SkTDArray<int> parent;
+    for (int index = 0; index < count; ++index) {
+        *order.append() = index;
+        *parent.append() = index;
+    }
+    auto find = [&parent](int index) {
+        while (parent[index] != index) {
+            parent[index] = parent[parent[index]];
+            index = parent[index];
+        }
+        return index;
+    };
+    if (count > 1) {
+        SkTQSort(order.begin(), order.end() - 1, [bounds](int a, int b) {
+            return bounds[a].fLeft < bounds[b].fLeft;
+        });
+    }
+
+    // The rects which may still intersect the ones to come.
+    SkTDArray<int> active;
+    for (int index : order) {
+        const SkRect& rect = bounds[index];
+        for (int a = 0; a < active.count();) {
+            const SkRect& activeRect = bounds[active[a]];
+            if (activeRect.fRight < rect.fLeft) {
+                active.removeShuffle(a);
+                continue;
+            }
+            // Touching rects are grouped too, so that edges they share are merged.
+            if (activeRect.fTop <= rect.fBottom && rect.fTop <= activeRect.fBottom) {
+                parent[find(index)] = find(active[a]);
+            }
+            ++a;
+        }
+        *active.append() = index;
+    }
+
+    SkTDArray<int> groupOfRoot;
+    groupOfRoot.setCount(count);
+    groupOf->setCount(count);
+    for (int index = 0; index < count; ++index) {
+        groupOfRoot[index] = -1;
+    }
+    int groupCount = 0;
+    for (int index = 0; index < count; ++index) {
+        int root = find(index);
+        if (groupOfRoot[root] < 0) {
+            groupOfRoot[root] = groupCount++;
+        }
+        (*groupOf)[index] = groupOfRoot[root];
+    }
+    return groupCount;
+}
+
+// Below this many verbs, splitting the paths costs more than the groups save.
+static constexpr int kMinVerbsToGroup = 256;
+
+static void add_contours(const SkPath& path, int operand, SkTArray<SkPath>* contours,
+                         SkTDArray<int>* operands) {
+    SkPath::RawIter iter(path);
+    SkPoint pts[4];
+    SkPath* contour = nullptr;
+    SkPath::Verb verb;
+    while ((verb = iter.next(pts)) != SkPath::kDone_Verb) {
+        if (SkPath::kMove_Verb == verb) {
+            contour = &contours->push_back();
+            contour->setFillType(path.getFillType());
+            contour->moveTo(pts[0]);
+            *operands->append() = operand;
+            continue;
+        }
+        switch (verb) {
+            case SkPath::kLine_Verb:
+                contour->lineTo(pts[1]);
+                break;
+            case SkPath::kQuad_Verb:
+                contour->quadTo(pts[1], pts[2]);
+                break;
+            case SkPath::kConic_Verb:
+                contour->conicTo(pts[1], pts[2], iter.conicWeight());
+                break;
+            case SkPath::kCubic_Verb:
+                contour->cubicTo(pts[1], pts[2], pts[3]);
+                break;
+            case SkPath::kClose_Verb:
+                contour->close();
+                break;
+            default:
+                SkASSERT(0);
+        }
+    }
+}
+
+// A point outside a contour's bounds has no winding from it, so contours whose bounds are apart
+// from every other group's can be resolved without them. Each group runs as a task on the default
+// SkExecutor, and the results are appended in group order, so the output doesn't depend on how the
+// tasks are scheduled. 'two' is null to simplify 'one'.
+//
+// Returns false, leaving 'result' alone, if the paths aren't split; otherwise sets 'success' to
+// whether every group succeeded.
+bool OpByGroups(const SkPath& one, const SkPath* two, SkPathOp op, SkPath* result, bool* success) {
+    // An inverse operand covers every group, except when simplifying, where the inverse is only
+    // applied to the result.
+    if (two && (one.isInverseFillType() || two->isInverseFillType())) {
+        return false;
+    }
+    if (one.countVerbs() + (two ? two->countVerbs() : 0) < kMinVerbsToGroup) {
+        return false;
+    }
+    SkTArray<SkPath> contours;
+    SkTDArray<int> operands;
+    add_contours(one, 0, &contours, &operands);
+    if (two) {
+        add_contours(*two, 1, &contours, &operands);
+    }
+    int count = contours.count();
+    SkTDArray<SkRect> bounds;
+    for (int index = 0; index < count; ++index) {
+        *bounds.append() = contours[index].getBounds();
+    }
+    SkTDArray<int> groupOf;
+    int groupCount = GroupByBounds(bounds.begin(), count, &groupOf);
+    if (groupCount < 2) {
+        return false;
+    }
+
+    SkTArray<SkPath> groupOne(groupCount), groupTwo(groupCount), groupResults(groupCount);
+    for (int groupIndex = 0; groupIndex < groupCount; ++groupIndex) {
+        groupOne.push_back().setFillType(one.getFillType());
+        groupTwo.push_back().setFillType(two ? two->getFillType() : one.getFillType());
+        groupResults.push_back();
+    }
+    for (int index = 0; index < count; ++index) {
+        SkTArray<SkPath>& group = operands[index] ? groupTwo : groupOne;
+        group[groupOf[index]].addPath(contours[index]);
+    }
+    std::unique_ptr<bool[]> succeeded(new bool[groupCount]);
+    SkTaskGroup().batch(groupCount, [&](int groupIndex) {
+        SkPath* groupResult = &groupResults[groupIndex];
+        succeeded[groupIndex] = two
+                ? OpDebug(groupOne[groupIndex], groupTwo[groupIndex], op, groupResult
+                          SkDEBUGPARAMS(true) SkDEBUGPARAMS(nullptr))
+                : SimplifyDebug(groupOne[groupIndex], groupResult
+                                SkDEBUGPARAMS(true) SkDEBUGPARAMS(nullptr));
+    });
+
+    *success = true;
+    for (int groupIndex = 0; groupIndex < groupCount; ++groupIndex) {
+        if (!succeeded[groupIndex]) {
+            *success = false;
+            return true;
+        }
+    }
+    result->reset();
+    result->setFillType(!two && one.isInverseFillType() ? SkPath::kInverseEvenOdd_FillType
+                                                        : SkPath::kEvenOdd_FillType);
+    for (const SkPath& groupResult : groupResults) {
+        result->addPath(groupResult);
+    }
+    return true;
+}
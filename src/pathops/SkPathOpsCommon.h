@@ -21,10 +21,15 @@ SkOpSegment* FindChase(SkTDArray<SkOpSpanBase*>* chase, SkOpSpanBase** startPtr,
 SkOpSpan* FindSortableTop(SkOpContourHead* );
 SkOpSpan* FindUndone(SkOpContourHead* );
 bool FixWinding(SkPath* path);
+int GroupByBounds(const SkRect bounds[], int count, SkTDArray<int>* groupOf);
 bool SortContourList(SkOpContourHead** , bool evenOdd, bool oppEvenOdd);
 bool HandleCoincidence(SkOpContourHead* , SkOpCoincidence* );
 bool OpDebug(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result
              SkDEBUGPARAMS(bool skipAssert)
              SkDEBUGPARAMS(const char* testName));
+bool OpByGroups(const SkPath& one, const SkPath* two, SkPathOp op, SkPath* result, bool* success);
+bool SimplifyDebug(const SkPath& path, SkPath* result
+                   SkDEBUGPARAMS(bool skipAssert)
+                   SkDEBUGPARAMS(const char* testName));
 
 #endif
@@ -4,6 +4,7 @@
  * Use of this source code is governed by a BSD-style license that can be
  * found in the LICENSE file.
  */
+#include "include/private/SkMalloc.h"
 #include "src/pathops/SkAddIntersections.h"
 #include "src/pathops/SkOpCoincidence.h"
 #include "src/pathops/SkOpEdgeBuilder.h"
@@ -212,6 +213,7 @@ bool SimplifyDebug(const SkPath& path, SkPath* result
 }
 
 bool Simplify(const SkPath& path, SkPath* result) {
+    SkAutoMemoryTag memoryTag(SkMemoryTag::kPathOps);
 #if DEBUG_DUMP_VERIFY
     if (SkPathOpsDebug::gVerifyOp) {
         if (!SimplifyDebug(path, result  SkDEBUGPARAMS(false) SkDEBUGPARAMS(nullptr))) {
@@ -222,5 +224,9 @@ bool Simplify(const SkPath& path, SkPath* result) {
         return true;
     }
 #endif
+    bool success;
+    if (OpByGroups(path, nullptr, kUnion_SkPathOp, result, &success)) {
+        return success;
+    }
     return SimplifyDebug(path, result  SkDEBUGPARAMS(true) SkDEBUGPARAMS(nullptr));
 }
@@ -13,3 +13,7 @@ sk_sp<SkDocument> SkPDF::MakeDocument(SkWStream*, const SkPDF::Metadata&) { retu
 void SkPDF::SetNodeId(SkCanvas* c, int n) {
     c->drawAnnotation({0, 0, 0, 0}, "PDF_Node_Key", SkData::MakeWithCopy(&n, sizeof(n)).get());
 }
+
+void SkPDF::AppendPages(SkDocument*, const sk_sp<SkPicture>[], int) {}
+
+std::unique_ptr<SkPDF::FontSubsetCache> SkPDF::FontSubsetCache::Make(size_t) { return nullptr; }
@@ -73,7 +73,8 @@ static void emit_image_stream(SkPDFDocument* doc,
                               const char* colorSpace,
                               SkPDFIndirectReference sMask,
                               int length,
-                              bool isJpeg) {
+                              bool isJpeg,
+                              int pngColors = 0) {
     SkPDFDict pdfDict("XObject");
     pdfDict.insertName("Subtype", "Image");
     pdfDict.insertInt("Width", size.width());
@@ -94,13 +95,29 @@ static void emit_image_stream(SkPDFDocument* doc,
     if (isJpeg) {
         pdfDict.insertInt("ColorTransform", 0);
     }
+    if (pngColors > 0) {
+        // The rows of PNG image data each start with the filter that PNG predictor 15 undoes.
+        auto decodeParms = SkPDFMakeDict();
+        decodeParms->insertInt("Predictor", 15);
+        decodeParms->insertInt("Colors", pngColors);
+        decodeParms->insertInt("BitsPerComponent", 8);
+        decodeParms->insertInt("Columns", size.width());
+        #ifdef SK_PDF_BASE85_BINARY
+        auto decodeParmsArray = SkPDFMakeArray();
+        decodeParmsArray->appendObject(SkPDFMakeDict());
+        decodeParmsArray->appendObject(std::move(decodeParms));
+        pdfDict.insertObject("DecodeParms", std::move(decodeParmsArray));
+        #else
+        pdfDict.insertObject("DecodeParms", std::move(decodeParms));
+        #endif
+    }
     pdfDict.insertInt("Length", length);
     doc->emitStream(pdfDict, std::move(writeStream), ref);
 }
 
 static void do_deflated_alpha(const SkPixmap& pm, SkPDFDocument* doc, SkPDFIndirectReference ref) {
     SkDynamicMemoryWStream buffer;
-    SkDeflateWStream deflateWStream(&buffer);
+    SkDeflateWStream deflateWStream(&buffer, doc->metadata().fCompressionLevel);
     if (kAlpha_8_SkColorType == pm.colorType()) {
         SkASSERT(pm.rowBytes() == (size_t)pm.width());
         buffer.write(pm.addr8(), pm.width() * pm.height());
@@ -143,7 +160,7 @@ static void do_deflated_image(const SkPixmap& pm,
         sMask = doc->reserveRef();
     }
     SkDynamicMemoryWStream buffer;
-    SkDeflateWStream deflateWStream(&buffer);
+    SkDeflateWStream deflateWStream(&buffer, doc->metadata().fCompressionLevel);
     const char* colorSpace = "DeviceGray";
     switch (pm.colorType()) {
         case kAlpha_8_SkColorType:
@@ -193,22 +210,86 @@ static void do_deflated_image(const SkPixmap& pm,
     }
 }
 
-static bool do_jpeg(sk_sp<SkData> data, SkPDFDocument* doc, SkISize size,
-                    SkPDFIndirectReference ref) {
+static bool is_embeddable_jpeg(const SkData& data, SkISize size, bool* yuv) {
     SkISize jpegSize;
     SkEncodedInfo::Color jpegColorType;
     SkEncodedOrigin exifOrientation;
-    if (!SkGetJpegInfo(data->data(), data->size(), &jpegSize,
+    if (!SkGetJpegInfo(data.data(), data.size(), &jpegSize,
                        &jpegColorType, &exifOrientation)) {
         return false;
     }
-    bool yuv = jpegColorType == SkEncodedInfo::kYUV_Color;
-    bool goodColorType = yuv || jpegColorType == SkEncodedInfo::kGray_Color;
-    if (jpegSize != size  // Sanity check.
-            || !goodColorType
-            || kTopLeft_SkEncodedOrigin != exifOrientation) {
+    *yuv = jpegColorType == SkEncodedInfo::kYUV_Color;
+    bool goodColorType = *yuv || jpegColorType == SkEncodedInfo::kGray_Color;
+    return jpegSize == size  // Sanity check.
+        && goodColorType
+        && kTopLeft_SkEncodedOrigin == exifOrientation;
+}
+
+static uint32_t png_uint32(const uint8_t* p) {
+    return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | (uint32_t)p[3];
+}
+
+// A PNG's image data is a zlib stream, split across its IDAT chunks, that a PDF FlateDecode filter
+// with the PNG predictors can read as is. This only accepts opaque, 8-bit, non-interlaced gray and
+// RGB PNGs that are (or are close enough to) sRGB, and appends their image data to idat if it's
+// not null.
+static bool is_embeddable_png(const SkData& data, SkISize size, int* colors,
+                              SkWStream* idat) {
+    static const uint8_t kSignature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    const uint8_t* ptr = data.bytes();
+    const uint8_t* end = ptr + data.size();
+    if (data.size() < sizeof(kSignature) || memcmp(ptr, kSignature, sizeof(kSignature))) {
         return false;
     }
+    ptr += sizeof(kSignature);
+    bool sawHeader = false, sawImageData = false;
+    while (end - ptr >= 12) {
+        uint32_t length = png_uint32(ptr);
+        const uint8_t* type = ptr + 4;
+        const uint8_t* chunk = ptr + 8;
+        if (length > (size_t)(end - chunk) - 4) {
+            return false;
+        }
+        ptr = chunk + length + 4;  // Skip the CRC.
+        if (!sawHeader) {
+            // IHDR: width, height, bit depth, color type, compression, filter, interlace.
+            if (memcmp(type, "IHDR", 4) || length != 13) {
+                return false;
+            }
+            int colorType = chunk[9];
+            if (SkISize::Make(png_uint32(chunk), png_uint32(chunk + 4)) != size ||
+                chunk[8] != 8 || (colorType != 0 && colorType != 2) ||
+                chunk[10] != 0 || chunk[11] != 0 || chunk[12] != 0) {
+                return false;
+            }
+            *colors = colorType == 2 ? 3 : 1;
+            sawHeader = true;
+        } else if (!memcmp(type, "IDAT", 4)) {
+            if (idat) {
+                idat->write(chunk, length);
+            }
+            sawImageData = true;
+        } else if (!memcmp(type, "IEND", 4)) {
+            break;
+        } else if (!memcmp(type, "tRNS", 4) || !memcmp(type, "iCCP", 4) ||
+                   !memcmp(type, "cHRM", 4) || !memcmp(type, "eXIf", 4)) {
+            // Transparency, color spaces other than sRGB, and orientations other than top-left
+            // need decoding.
+            return false;
+        } else if (!memcmp(type, "gAMA", 4)) {
+            // 1/2.2 and sRGB's curve look the same.
+            uint32_t gamma = length == 4 ? png_uint32(chunk) : 0;
+            if (gamma < 45000 || gamma > 46000) {
+                return false;
+            }
+        }
+    }
+    return sawImageData;
+}
+
+static void emit_encoded(sk_sp<SkData> data, SkPDFDocument* doc, SkISize size,
+                         const char* colorSpace, bool isJpeg, int pngColors,
+                         SkPDFIndirectReference ref) {
     #ifdef SK_PDF_BASE85_BINARY
     SkDynamicMemoryWStream buffer;
     SkPDFUtils::Base85Encode(SkMemoryStream::MakeDirect(data->data(), data->size()), &buffer);
@@ -217,11 +298,43 @@ static bool do_jpeg(sk_sp<SkData> data, SkPDFDocument* doc, SkISize size,
 
     emit_image_stream(doc, ref,
                       [&data](SkWStream* dst) { dst->write(data->data(), data->size()); },
-                      jpegSize, yuv ? "DeviceRGB" : "DeviceGray",
-                      SkPDFIndirectReference(), SkToInt(data->size()), true);
+                      size, colorSpace, SkPDFIndirectReference(), SkToInt(data->size()),
+                      isJpeg, pngColors);
+}
+
+static bool do_jpeg(sk_sp<SkData> data, SkPDFDocument* doc, SkISize size,
+                    SkPDFIndirectReference ref) {
+    bool yuv;
+    if (!is_embeddable_jpeg(*data, size, &yuv)) {
+        return false;
+    }
+    emit_encoded(std::move(data), doc, size, yuv ? "DeviceRGB" : "DeviceGray", true, 0, ref);
     return true;
 }
 
+static bool do_png(const SkData& data, SkPDFDocument* doc, SkISize size,
+                   SkPDFIndirectReference ref) {
+    int colors;
+    SkDynamicMemoryWStream idat;
+    if (!is_embeddable_png(data, size, &colors, &idat)) {
+        return false;
+    }
+    emit_encoded(idat.detachAsData(), doc, size, colors == 3 ? "DeviceRGB" : "DeviceGray",
+                 false, colors, ref);
+    return true;
+}
+
+sk_sp<SkData> SkPDFEmbeddableEncodedData(const SkImage* image) {
+    sk_sp<SkData> data = image->refEncodedData();
+    bool yuv;
+    int colors;
+    if (data && (is_embeddable_jpeg(*data, image->dimensions(), &yuv) ||
+                 is_embeddable_png(*data, image->dimensions(), &colors, nullptr))) {
+        return data;
+    }
+    return nullptr;
+}
+
 static SkBitmap to_pixels(const SkImage* image) {
     SkBitmap bm;
     int w = image->width(),
@@ -254,7 +367,8 @@ void serialize_image(const SkImage* img,
     SkASSERT(encodingQuality >= 0);
     SkISize dimensions = img->dimensions();
     sk_sp<SkData> data = img->refEncodedData();
-    if (data && do_jpeg(std::move(data), doc, dimensions, ref)) {
+    if (data && (do_png(*data, doc, dimensions, ref) ||
+                 do_jpeg(std::move(data), doc, dimensions, ref))) {
         return;
     }
     SkBitmap bm = to_pixels(img);
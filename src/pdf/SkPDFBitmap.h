@@ -7,6 +7,9 @@
 #ifndef SkPDFBitmap_DEFINED
 #define SkPDFBitmap_DEFINED
 
+#include "include/core/SkRefCnt.h"
+
+class SkData;
 class SkImage;
 class SkPDFDocument;
 struct SkPDFIndirectReference;
@@ -19,4 +22,10 @@ SkPDFIndirectReference SkPDFSerializeImage(const SkImage* img,
                                            SkPDFDocument* doc,
                                            int encodingQuality = 101);
 
+/**
+ * Returns the image's encoded data if SkPDFSerializeImage() embeds that data as is (an opaque
+ * JPEG or PNG), instead of the decoded pixels. Otherwise returns null.
+ */
+sk_sp<SkData> SkPDFEmbeddableEncodedData(const SkImage* img);
+
 #endif  // SkPDFBitmap_DEFINED
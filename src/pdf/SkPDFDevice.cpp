@@ -10,6 +10,7 @@
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkColorFilter.h"
+#include "include/core/SkData.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkPathEffect.h"
 #include "include/core/SkRRect.h"
@@ -30,6 +31,7 @@
 #include "src/core/SkImageFilterCache.h"
 #include "src/core/SkMakeUnique.h"
 #include "src/core/SkMaskFilterBase.h"
+#include "src/core/SkOpts.h"
 #include "src/core/SkRasterClip.h"
 #include "src/core/SkScopeExit.h"
 #include "src/core/SkStrike.h"
@@ -196,7 +198,7 @@ SkBaseDevice* SkPDFDevice::onCreateDevice(const CreateInfo& cinfo, const SkPaint
         // need to return a raster device, which we will detect in drawDevice()
         return SkBitmapDevice::Create(cinfo.fInfo, SkSurfaceProps(0, kUnknown_SkPixelGeometry));
     }
-    return new SkPDFDevice(cinfo.fInfo.dimensions(), fDocument);
+    return new SkPDFDevice(cinfo.fInfo.dimensions(), fDocument, SkMatrix::I(), fPage);
 }
 
 // A helper class to automatically finish a ContentEntry at the end of a
@@ -281,12 +283,14 @@ private:
 
 ////////////////////////////////////////////////////////////////////////////////
 
-SkPDFDevice::SkPDFDevice(SkISize pageSize, SkPDFDocument* doc, const SkMatrix& transform)
+SkPDFDevice::SkPDFDevice(SkISize pageSize, SkPDFDocument* doc, const SkMatrix& transform,
+                         SkPDFPageState* page)
     : INHERITED(SkImageInfo::MakeUnknown(pageSize.width(), pageSize.height()),
                 SkSurfaceProps(0, kUnknown_SkPixelGeometry))
     , fInitialTransform(transform)
     , fNodeId(0)
     , fDocument(doc)
+    , fPage(page)
 {
     SkASSERT(!pageSize.isEmpty());
 }
@@ -306,7 +310,10 @@ void SkPDFDevice::drawAnnotation(const SkRect& rect, const char key[], SkData* v
     if (!value) {
         return;
     }
-    const SkMatrix& pageXform = fDocument->currentPageTransform();
+    if (!fPage) {
+        return;
+    }
+    const SkMatrix& pageXform = fPage->fTransform;
     SkPoint deviceOffset = {(float)this->getOrigin().x(), (float)this->getOrigin().y()};
     if (rect.isEmpty()) {
         if (!strcmp(key, SkPDFGetNodeIdKey())) {
@@ -319,8 +326,8 @@ void SkPDFDevice::drawAnnotation(const SkRect& rect, const char key[], SkData* v
         if (!strcmp(SkAnnotationKeys::Define_Named_Dest_Key(), key)) {
             SkPoint p = deviceOffset + this->ctm().mapXY(rect.x(), rect.y());
             pageXform.mapPoints(&p, 1);
-            auto pg = fDocument->currentPage();
-            fDocument->fNamedDestinations.push_back(SkPDFNamedDestination{sk_ref_sp(value), p, pg});
+            fPage->fNamedDestinations.push_back(
+                    SkPDFNamedDestination{sk_ref_sp(value), p, fPage->fRef});
         }
         return;
     }
@@ -337,10 +344,10 @@ void SkPDFDevice::drawAnnotation(const SkRect& rect, const char key[], SkData* v
         return;
     }
     if (!strcmp(SkAnnotationKeys::URL_Key(), key)) {
-        fDocument->fCurrentPageLinkToURLs.push_back(
+        fPage->fLinkToURLs.push_back(
                 std::make_pair(sk_ref_sp(value), transformedRect));
     } else if (!strcmp(SkAnnotationKeys::Link_Named_Dest_Key(), key)) {
-        fDocument->fCurrentPageLinkToDestinations.emplace_back(
+        fPage->fLinkToDestinations.emplace_back(
                 std::make_pair(sk_ref_sp(value), transformedRect));
     }
 }
@@ -520,11 +527,15 @@ void SkPDFDevice::setGraphicState(SkPDFIndirectReference gs, SkDynamicMemoryWStr
 
 void SkPDFDevice::clearMaskOnGraphicState(SkDynamicMemoryWStream* contentStream) {
     // The no-softmask graphic state is used to "turn off" the mask for later draw calls.
-    SkPDFIndirectReference& noSMaskGS = fDocument->fNoSmaskGraphicState;
-    if (!noSMaskGS) {
-        SkPDFDict tmp("ExtGState");
-        tmp.insertName("SMask", "None");
-        noSMaskGS = fDocument->emit(tmp);
+    SkPDFIndirectReference noSMaskGS;
+    {
+        SkAutoMutexExclusive lock(fDocument->canonMutex());
+        if (!fDocument->fNoSmaskGraphicState) {
+            SkPDFDict tmp("ExtGState");
+            tmp.insertName("SMask", "None");
+            fDocument->fNoSmaskGraphicState = fDocument->emit(tmp);
+        }
+        noSMaskGS = fDocument->fNoSmaskGraphicState;
     }
     this->setGraphicState(noSMaskGS, contentStream);
 }
@@ -851,8 +862,8 @@ void SkPDFDevice::internalDrawGlyphRun(
     out->writeText("BT\n");
 
     int markId = -1;
-    if (fNodeId) {
-        markId = fDocument->getMarkIdForNodeId(fNodeId);
+    if (fNodeId && fPage) {
+        markId = fDocument->getMarkIdForNodeId(fNodeId, fPage->fIndex);
     }
 
     if (markId != -1) {
@@ -1388,7 +1399,7 @@ void SkPDFDevice::finishContentEntry(const SkClipStack* clipStack,
             filledPaint.setColor(SK_ColorBLACK);
             filledPaint.setStyle(SkPaint::kFill_Style);
             SkClipStack empty;
-            SkPDFDevice shapeDev(this->size(), fDocument, fInitialTransform);
+            SkPDFDevice shapeDev(this->size(), fDocument, fInitialTransform, fPage);
             shapeDev.internalDrawPath(clipStack ? *clipStack : empty,
                                       SkMatrix::I(), *shape, filledPaint, true);
             this->drawFormXObjectWithMask(dst, shapeDev.makeFormXObjectFromDevice(),
@@ -1490,15 +1501,23 @@ void SkPDFDevice::internalDrawImageRect(SkKeyedImage imageSubset,
     SkRect srcRect = src ? *src : SkRect::Make(bounds);
     SkMatrix transform;
     transform.setRectToRect(srcRect, dst, SkMatrix::kFill_ScaleToFit);
+    bool clipToSrc = false;
     if (src && *src != SkRect::Make(bounds)) {
         if (!srcRect.intersect(SkRect::Make(bounds))) {
             return;
         }
         srcRect.roundOut(&bounds);
-        transform.preTranslate(SkIntToScalar(bounds.x()),
-                               SkIntToScalar(bounds.y()));
         if (bounds != imageSubset.image()->bounds()) {
-            imageSubset = imageSubset.subset(bounds);
+            // Encoded data that's embedded as is gets clipped instead of decoded to a subset,
+            // so draws of any part of the image share one XObject.
+            if (!srcPaint.getColorFilter() && !ctm.hasPerspective() &&
+                SkPDFEmbeddableEncodedData(imageSubset.image().get())) {
+                clipToSrc = true;
+            } else {
+                transform.preTranslate(SkIntToScalar(bounds.x()),
+                                       SkIntToScalar(bounds.y()));
+                imageSubset = imageSubset.subset(bounds);
+            }
         }
         if (!imageSubset) {
             return;
@@ -1591,7 +1610,7 @@ void SkPDFDevice::internalDrawImageRect(SkKeyedImage imageSubset,
     transform.postConcat(ctm);
 
     bool needToRestore = false;
-    if (src && !is_integral(*src)) {
+    if ((src && !is_integral(*src)) || clipToSrc) {
         // Need sub-pixel clipping to fix https://bug.skia.org/4374
         this->cs().save();
         this->cs().clipRect(dst, ctm, SkClipOp::kIntersect, true);
@@ -1681,7 +1700,7 @@ void SkPDFDevice::internalDrawImageRect(SkKeyedImage imageSubset,
         return;
     }
     if (content.needShape()) {
-        SkPath shape = to_path(SkRect::Make(subset));
+        SkPath shape = to_path(clipToSrc ? srcRect : SkRect::Make(subset));
         shape.transform(matrix);
         content.setShape(shape);
     }
@@ -1700,14 +1719,37 @@ void SkPDFDevice::internalDrawImageRect(SkKeyedImage imageSubset,
     }
 
     SkBitmapKey key = imageSubset.key();
-    SkPDFIndirectReference* pdfimagePtr = fDocument->fPDFBitmapMap.find(key);
-    SkPDFIndirectReference pdfimage = pdfimagePtr ? *pdfimagePtr : SkPDFIndirectReference();
-    if (!pdfimagePtr) {
+    SkPDFIndirectReference pdfimage;
+    {
+        SkAutoMutexExclusive lock(fDocument->canonMutex());
+        if (SkPDFIndirectReference* pdfimagePtr = fDocument->fPDFBitmapMap.find(key)) {
+            pdfimage = *pdfimagePtr;
+        }
+    }
+    if (!pdfimage) {
         SkASSERT(imageSubset);
-        pdfimage = SkPDFSerializeImage(imageSubset.image().get(), fDocument,
-                                       fDocument->metadata().fEncodingQuality);
+        // Images of the same encoded data, like a photo decoded again for each page it's on,
+        // share the XObject that data is embedded in.
+        sk_sp<SkData> encoded = SkPDFEmbeddableEncodedData(imageSubset.image().get());
+        uint32_t encodedHash = encoded ? SkOpts::hash(encoded->data(), encoded->size()) : 0;
+        if (encoded) {
+            SkAutoMutexExclusive lock(fDocument->canonMutex());
+            const SkPDFDocument::EncodedImage* embedded =
+                    fDocument->fEncodedImageMap.find(encodedHash);
+            if (embedded && embedded->fData->equals(encoded.get())) {
+                pdfimage = embedded->fRef;
+            }
+        }
+        if (!pdfimage) {
+            pdfimage = SkPDFSerializeImage(imageSubset.image().get(), fDocument,
+                                           fDocument->metadata().fEncodingQuality);
+        }
         SkASSERT((key != SkBitmapKey{{0, 0, 0, 0}, 0}));
+        SkAutoMutexExclusive lock(fDocument->canonMutex());
         fDocument->fPDFBitmapMap.set(key, pdfimage);
+        if (encoded && !fDocument->fEncodedImageMap.find(encodedHash)) {
+            fDocument->fEncodedImageMap.set(encodedHash, {std::move(encoded), pdfimage});
+        }
     }
     SkASSERT(pdfimage != SkPDFIndirectReference());
     this->drawFormXObject(pdfimage, content.stream());
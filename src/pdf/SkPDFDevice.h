@@ -31,6 +31,7 @@ class SkPDFArray;
 class SkPDFDevice;
 class SkPDFDict;
 class SkPDFDocument;
+struct SkPDFPageState;
 class SkPDFFont;
 class SkPDFObject;
 class SkPath;
@@ -54,12 +55,15 @@ public:
      *         for early serializing of large immutable objects, such
      *         as images (via SkPDFDocument::serialize()).
      *  @param initialTransform Transform to be applied to the entire page.
+     *  @param page  The page this device draws part of, which receives its
+     *         links and other annotations. If nullptr, those are dropped.
      */
     SkPDFDevice(SkISize pageSize, SkPDFDocument* document,
-                const SkMatrix& initialTransform = SkMatrix::I());
+                const SkMatrix& initialTransform = SkMatrix::I(),
+                SkPDFPageState* page = nullptr);
 
     sk_sp<SkPDFDevice> makeCongruentDevice() {
-        return sk_make_sp<SkPDFDevice>(this->size(), fDocument);
+        return sk_make_sp<SkPDFDevice>(this->size(), fDocument, SkMatrix::I(), fPage);
     }
 
     ~SkPDFDevice() override;
@@ -139,6 +143,7 @@ private:
     bool fNeedsExtraSave = false;
     SkPDFGraphicStackState fActiveStackState;
     SkPDFDocument* fDocument;
+    SkPDFPageState* fPage;
 
     ////////////////////////////////////////////////////////////////////////////
 
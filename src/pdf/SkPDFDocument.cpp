@@ -8,10 +8,13 @@
 #include "include/docs/SkPDFDocument.h"
 #include "src/pdf/SkPDFDocumentPriv.h"
 
+#include "include/core/SkPicture.h"
 #include "include/core/SkStream.h"
 #include "include/docs/SkPDFDocument.h"
+#include "include/private/SkMalloc.h"
 #include "include/private/SkTo.h"
 #include "src/core/SkMakeUnique.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/pdf/SkPDFDevice.h"
 #include "src/pdf/SkPDFFont.h"
 #include "src/pdf/SkPDFGradientShader.h"
@@ -113,55 +116,69 @@ static void serialize_footer(const SkPDFOffsetMap& offsetMap,
     wStream->writeText("\n%%EOF");
 }
 
+// PDF wants a tree describing all the pages in the document.  We arbitrary
+// choose 8 (kMaxNodeSize) as the number of allowed children.  The internal
+// nodes have type "Pages" with an array of children, a parent pointer, and
+// the number of leaves below the node as "Count."  The leaves have type "Page"
+// and need a parent pointer.
+static constexpr size_t kMaxNodeSize = 8;
+
+namespace {
+struct PageTreeNode {
+    std::unique_ptr<SkPDFDict> fNode;
+    SkPDFIndirectReference fReservedRef;
+    int fPageObjectDescendantCount;
+
+    static std::vector<PageTreeNode> Layer(std::vector<PageTreeNode> vec, SkPDFDocument* doc) {
+        std::vector<PageTreeNode> result;
+        const size_t n = vec.size();
+        SkASSERT(n >= 1);
+        const size_t result_len = (n - 1) / kMaxNodeSize + 1;
+        SkASSERT(result_len >= 1);
+        SkASSERT(n == 1 || result_len < n);
+        result.reserve(result_len);
+        size_t index = 0;
+        for (size_t i = 0; i < result_len; ++i) {
+            if (n != 1 && index + 1 == n) {  // No need to create a new node.
+                result.push_back(std::move(vec[index++]));
+                continue;
+            }
+            SkPDFIndirectReference parent = doc->reserveRef();
+            auto kids_list = SkPDFMakeArray();
+            int descendantCount = 0;
+            for (size_t j = 0; j < kMaxNodeSize && index < n; ++j) {
+                PageTreeNode& node = vec[index++];
+                node.fNode->insertRef("Parent", parent);
+                kids_list->appendRef(doc->emit(*node.fNode, node.fReservedRef));
+                descendantCount += node.fPageObjectDescendantCount;
+            }
+            auto next = SkPDFMakeDict("Pages");
+            next->insertInt("Count", descendantCount);
+            next->insertObject("Kids", std::move(kids_list));
+            result.push_back(PageTreeNode{std::move(next), parent, descendantCount});
+        }
+        return result;
+    }
+
+    // Builds the tree above currentLayer, and emits its root.
+    static SkPDFIndirectReference EmitRoot(std::vector<PageTreeNode> currentLayer,
+                                           SkPDFDocument* doc) {
+        while (currentLayer.size() > 1) {
+            currentLayer = Layer(std::move(currentLayer), doc);
+        }
+        SkASSERT(currentLayer.size() == 1);
+        const PageTreeNode& root = currentLayer[0];
+        return doc->emit(*root.fNode, root.fReservedRef);
+    }
+};
+}  // namespace
+
+// Builds the tree bottom up, skipping internal nodes that would have only one child.
 static SkPDFIndirectReference generate_page_tree(
         SkPDFDocument* doc,
         std::vector<std::unique_ptr<SkPDFDict>> pages,
         const std::vector<SkPDFIndirectReference>& pageRefs) {
-    // PDF wants a tree describing all the pages in the document.  We arbitrary
-    // choose 8 (kNodeSize) as the number of allowed children.  The internal
-    // nodes have type "Pages" with an array of children, a parent pointer, and
-    // the number of leaves below the node as "Count."  The leaves are passed
-    // into the method, have type "Page" and need a parent pointer. This method
-    // builds the tree bottom up, skipping internal nodes that would have only
-    // one child.
     SkASSERT(pages.size() > 0);
-    struct PageTreeNode {
-        std::unique_ptr<SkPDFDict> fNode;
-        SkPDFIndirectReference fReservedRef;
-        int fPageObjectDescendantCount;
-
-        static std::vector<PageTreeNode> Layer(std::vector<PageTreeNode> vec, SkPDFDocument* doc) {
-            std::vector<PageTreeNode> result;
-            static constexpr size_t kMaxNodeSize = 8;
-            const size_t n = vec.size();
-            SkASSERT(n >= 1);
-            const size_t result_len = (n - 1) / kMaxNodeSize + 1;
-            SkASSERT(result_len >= 1);
-            SkASSERT(n == 1 || result_len < n);
-            result.reserve(result_len);
-            size_t index = 0;
-            for (size_t i = 0; i < result_len; ++i) {
-                if (n != 1 && index + 1 == n) {  // No need to create a new node.
-                    result.push_back(std::move(vec[index++]));
-                    continue;
-                }
-                SkPDFIndirectReference parent = doc->reserveRef();
-                auto kids_list = SkPDFMakeArray();
-                int descendantCount = 0;
-                for (size_t j = 0; j < kMaxNodeSize && index < n; ++j) {
-                    PageTreeNode& node = vec[index++];
-                    node.fNode->insertRef("Parent", parent);
-                    kids_list->appendRef(doc->emit(*node.fNode, node.fReservedRef));
-                    descendantCount += node.fPageObjectDescendantCount;
-                }
-                auto next = SkPDFMakeDict("Pages");
-                next->insertInt("Count", descendantCount);
-                next->insertObject("Kids", std::move(kids_list));
-                result.push_back(PageTreeNode{std::move(next), parent, descendantCount});
-            }
-            return result;
-        }
-    };
     std::vector<PageTreeNode> currentLayer;
     currentLayer.reserve(pages.size());
     SkASSERT(pages.size() == pageRefs.size());
@@ -169,12 +186,31 @@ static SkPDFIndirectReference generate_page_tree(
         currentLayer.push_back(PageTreeNode{std::move(pages[i]), pageRefs[i], 1});
     }
     currentLayer = PageTreeNode::Layer(std::move(currentLayer), doc);
-    while (currentLayer.size() > 1) {
-        currentLayer = PageTreeNode::Layer(std::move(currentLayer), doc);
+    return PageTreeNode::EmitRoot(std::move(currentLayer), doc);
+}
+
+// When streaming, the pages have already been written with the leaf nodes as their parents, so
+// only the nodes above them are left.
+static SkPDFIndirectReference generate_streamed_page_tree(
+        SkPDFDocument* doc,
+        const std::vector<SkPDFIndirectReference>& leafRefs,
+        const std::vector<SkPDFIndirectReference>& pageRefs) {
+    SkASSERT(leafRefs.size() > 0);
+    std::vector<PageTreeNode> currentLayer;
+    currentLayer.reserve(leafRefs.size());
+    for (size_t i = 0; i < leafRefs.size(); ++i) {
+        auto kids_list = SkPDFMakeArray();
+        size_t end = SkTMin(pageRefs.size(), (i + 1) * kMaxNodeSize);
+        for (size_t j = i * kMaxNodeSize; j < end; ++j) {
+            kids_list->appendRef(pageRefs[j]);
+        }
+        int descendantCount = SkToInt(end - i * kMaxNodeSize);
+        auto leaf = SkPDFMakeDict("Pages");
+        leaf->insertInt("Count", descendantCount);
+        leaf->insertObject("Kids", std::move(kids_list));
+        currentLayer.push_back(PageTreeNode{std::move(leaf), leafRefs[i], descendantCount});
     }
-    SkASSERT(currentLayer.size() == 1);
-    const PageTreeNode& root = currentLayer[0];
-    return doc->emit(*root.fNode, root.fReservedRef);
+    return PageTreeNode::EmitRoot(std::move(currentLayer), doc);
 }
 
 template<typename T, typename... Args>
@@ -221,44 +257,60 @@ void SkPDFDocument::endObject() SK_REQUIRES(fMutex) {
     end_indirect_object(this->getStream());
 };
 
+// How many executor jobs (mostly deflating streams) may still be running when a streamed page
+// ends. Each one holds its stream's data until it is written.
+static constexpr int kMaxPendingStreamingJobs = 16;
+
 static SkSize operator*(SkISize u, SkScalar s) { return SkSize{u.width() * s, u.height() * s}; }
 static SkSize operator*(SkSize u, SkScalar s) { return SkSize{u.width() * s, u.height() * s}; }
 
-SkCanvas* SkPDFDocument::onBeginPage(SkScalar width, SkScalar height) {
-    SkASSERT(fCanvas.imageInfo().dimensions().isZero());
-    if (fPages.empty()) {
-        // if this is the first page if the document.
-        {
-            SkAutoMutexExclusive autoMutexAcquire(fMutex);
-            serializeHeader(&fOffsetMap, this->getStream());
+void SkPDFDocument::beginDocument() {
+    {
+        SkAutoMutexExclusive autoMutexAcquire(fMutex);
+        serializeHeader(&fOffsetMap, this->getStream());
 
-        }
+    }
 
-        fInfoDict = this->emit(*SkPDFMetadata::MakeDocumentInformationDict(fMetadata));
-        if (fMetadata.fPDFA) {
-            fUUID = SkPDFMetadata::CreateUUID(fMetadata);
-            // We use the same UUID for Document ID and Instance ID since this
-            // is the first revision of this document (and Skia does not
-            // support revising existing PDF documents).
-            // If we are not in PDF/A mode, don't use a UUID since testing
-            // works best with reproducible outputs.
-            fXMP = SkPDFMetadata::MakeXMPObject(fMetadata, fUUID, fUUID, this);
-        }
+    fInfoDict = this->emit(*SkPDFMetadata::MakeDocumentInformationDict(fMetadata));
+    if (fMetadata.fPDFA) {
+        fUUID = SkPDFMetadata::CreateUUID(fMetadata);
+        // We use the same UUID for Document ID and Instance ID since this
+        // is the first revision of this document (and Skia does not
+        // support revising existing PDF documents).
+        // If we are not in PDF/A mode, don't use a UUID since testing
+        // works best with reproducible outputs.
+        fXMP = SkPDFMetadata::MakeXMPObject(fMetadata, fUUID, fUUID, this);
     }
+}
+
+sk_sp<SkPDFDevice> SkPDFDocument::makePageDevice(SkScalar width, SkScalar height,
+                                                 SkPDFPageState* page) {
     // By scaling the page at the device level, we will create bitmap layer
     // devices at the rasterized scale, not the 72dpi scale.  Bitmap layer
     // devices are created when saveLayer is called with an ImageFilter;  see
     // SkPDFDevice::onCreateDevice().
     SkISize pageSize = (SkSize{width, height} * fRasterScale).toRound();
-    SkMatrix initialTransform;
     // Skia uses the top left as the origin but PDF natively has the origin at the
     // bottom left. This matrix corrects for that, as well as the raster scale.
-    initialTransform.setScaleTranslate(fInverseRasterScale, -fInverseRasterScale,
+    page->fTransform.setScaleTranslate(fInverseRasterScale, -fInverseRasterScale,
                                        0, fInverseRasterScale * pageSize.height());
-    fPageDevice = sk_make_sp<SkPDFDevice>(pageSize, this, initialTransform);
+    page->fIndex = SkToUInt(fPageRefs.size());
+    page->fRef = this->reserveRef();
+    fPageRefs.push_back(page->fRef);
+    return sk_make_sp<SkPDFDevice>(pageSize, this, page->fTransform, page);
+}
+
+SkCanvas* SkPDFDocument::onBeginPage(SkScalar width, SkScalar height) {
+    SkAutoMemoryTag memoryTag(SkMemoryTag::kPDF);
+    SkASSERT(fCanvas.imageInfo().dimensions().isZero());
+    if (fPageRefs.empty()) {
+        // if this is the first page if the document.
+        this->beginDocument();
+    }
+    fCurrentPage = SkPDFPageState();
+    fPageDevice = this->makePageDevice(width, height, &fCurrentPage);
     reset_object(&fCanvas, fPageDevice);
     fCanvas.scale(fRasterScale, fRasterScale);
-    fPageRefs.push_back(this->reserveRef());
     return &fCanvas;
 }
 
@@ -324,34 +376,103 @@ static SkPDFIndirectReference append_destinations(
     return doc->emit(destinations);
 }
 
-void SkPDFDocument::onEndPage() {
-    SkASSERT(!fCanvas.imageInfo().dimensions().isZero());
-    reset_object(&fCanvas);
-    SkASSERT(fPageDevice);
-
+std::unique_ptr<SkPDFDict> SkPDFDocument::makePageDict(sk_sp<SkPDFDevice> device,
+                                                        SkPDFPageState* pageState) {
     auto page = SkPDFMakeDict("Page");
 
-    SkSize mediaSize = fPageDevice->imageInfo().dimensions() * fInverseRasterScale;
-    std::unique_ptr<SkStreamAsset> pageContent = fPageDevice->content();
-    auto resourceDict = fPageDevice->makeResourceDict();
-    SkASSERT(fPageRefs.size() > 0);
-    fPageDevice = nullptr;
+    SkSize mediaSize = device->imageInfo().dimensions() * fInverseRasterScale;
+    std::unique_ptr<SkStreamAsset> pageContent = device->content();
+    auto resourceDict = device->makeResourceDict();
+    device = nullptr;
 
     page->insertObject("Resources", std::move(resourceDict));
     page->insertObject("MediaBox", SkPDFUtils::RectToArray(SkRect::MakeSize(mediaSize)));
 
     if (std::unique_ptr<SkPDFArray> annotations =
-            get_annotations(this, fCurrentPageLinkToURLs, fCurrentPageLinkToDestinations)) {
+            get_annotations(this, pageState->fLinkToURLs, pageState->fLinkToDestinations)) {
         page->insertObject("Annots", std::move(annotations));
-        fCurrentPageLinkToURLs.clear();
-        fCurrentPageLinkToDestinations.clear();
+        pageState->fLinkToURLs.clear();
+        pageState->fLinkToDestinations.clear();
     }
 
     page->insertRef("Contents", SkPDFStreamOut(nullptr, std::move(pageContent), this));
     // The StructParents unique identifier for each page is just its
     // 0-based page index.
-    page->insertInt("StructParents", SkToInt(this->currentPageIndex()));
-    fPages.emplace_back(std::move(page));
+    page->insertInt("StructParents", SkToInt(pageState->fIndex));
+    return page;
+}
+
+void SkPDFDocument::addPage(std::unique_ptr<SkPDFDict> page, SkPDFPageState* pageState) {
+    SkASSERT(pageState->fIndex == fPageCount);
+    fNamedDestinations.insert(fNamedDestinations.end(),
+                              pageState->fNamedDestinations.begin(),
+                              pageState->fNamedDestinations.end());
+    pageState->fNamedDestinations.clear();
+
+    if (fMetadata.fStreamPages) {
+        // Write the page now, so nothing of it is kept until the document is closed.
+        if (fPageCount % kMaxNodeSize == 0) {
+            fPageTreeLeafRefs.push_back(this->reserveRef());
+        }
+        page->insertRef("Parent", fPageTreeLeafRefs.back());
+        this->emit(*page, pageState->fRef);
+        // Don't let the executor's queue hold on to many pages worth of content.
+        this->waitForJobs(kMaxPendingStreamingJobs);
+    } else {
+        fPages.emplace_back(std::move(page));
+    }
+    fPageCount++;
+}
+
+void SkPDFDocument::onEndPage() {
+    SkAutoMemoryTag memoryTag(SkMemoryTag::kPDF);
+    SkASSERT(!fCanvas.imageInfo().dimensions().isZero());
+    reset_object(&fCanvas);
+    SkASSERT(fPageDevice);
+    SkASSERT(fPageRefs.size() > 0);
+    this->addPage(this->makePageDict(std::move(fPageDevice), &fCurrentPage), &fCurrentPage);
+}
+
+void SkPDFDocument::appendPages(const sk_sp<SkPicture> pictures[], int count) {
+    if (this->getState() == kInPage_State) {
+        this->endPage();
+    }
+    if (this->getState() == kClosed_State || count <= 0) {
+        return;
+    }
+    if (fPageRefs.empty()) {
+        this->beginDocument();
+    }
+
+    // Pages are numbered, and their devices made, in order. Only the drawing and the conversion
+    // to content streams run in parallel.
+    std::vector<SkPDFPageState> pageStates(count);
+    std::vector<sk_sp<SkPDFDevice>> devices(count);
+    for (int i = 0; i < count; ++i) {
+        const SkRect& cull = pictures[i]->cullRect();
+        devices[i] = this->makePageDevice(cull.right(), cull.bottom(), &pageStates[i]);
+    }
+
+    std::vector<std::unique_ptr<SkPDFDict>> pages(count);
+    auto convert = [&](int i) {
+        {
+            SkCanvas canvas(devices[i]);
+            canvas.scale(fRasterScale, fRasterScale);
+            canvas.drawPicture(pictures[i]);
+        }
+        pages[i] = this->makePageDict(std::move(devices[i]), &pageStates[i]);
+    };
+    if (fExecutor) {
+        SkTaskGroup(*fExecutor).batch(count, convert);
+    } else {
+        for (int i = 0; i < count; ++i) {
+            convert(i);
+        }
+    }
+
+    for (int i = 0; i < count; ++i) {
+        this->addPage(std::move(pages[i]), &pageStates[i]);
+    }
 }
 
 void SkPDFDocument::onAbort() {
@@ -498,19 +619,18 @@ SkPDFIndirectReference SkPDFDocument::getPage(size_t pageIndex) const {
     return fPageRefs[pageIndex];
 }
 
-const SkMatrix& SkPDFDocument::currentPageTransform() const {
-    return fPageDevice->initialTransform();
-}
-
-int SkPDFDocument::getMarkIdForNodeId(int nodeId) {
-    return fTagTree.getMarkIdForNodeId(nodeId, SkToUInt(this->currentPageIndex()));
+int SkPDFDocument::getMarkIdForNodeId(int nodeId, unsigned pageIndex) {
+    SkAutoMutexExclusive lock(fCanonMutex);
+    return fTagTree.getMarkIdForNodeId(nodeId, pageIndex);
 }
 
 static std::vector<const SkPDFFont*> get_fonts(const SkPDFDocument& canon) {
     std::vector<const SkPDFFont*> fonts;
     fonts.reserve(canon.fFontMap.count());
     // Sort so the output PDF is reproducible.
-    canon.fFontMap.foreach([&fonts](uint64_t, const SkPDFFont& font) { fonts.push_back(&font); });
+    canon.fFontMap.foreach([&fonts](uint64_t, const std::unique_ptr<SkPDFFont>& font) {
+        fonts.push_back(font.get());
+    });
     std::sort(fonts.begin(), fonts.end(), [](const SkPDFFont* u, const SkPDFFont* v) {
         return u->indirectReference().fValue < v->indirectReference().fValue;
     });
@@ -518,8 +638,9 @@ static std::vector<const SkPDFFont*> get_fonts(const SkPDFDocument& canon) {
 }
 
 void SkPDFDocument::onClose(SkWStream* stream) {
+    SkAutoMemoryTag memoryTag(SkMemoryTag::kPDF);
     SkASSERT(fCanvas.imageInfo().dimensions().isZero());
-    if (fPages.empty()) {
+    if (fPageCount == 0) {
         this->waitForJobs();
         return;
     }
@@ -532,7 +653,12 @@ void SkPDFDocument::onClose(SkWStream* stream) {
         docCatalog->insertObject("OutputIntents", make_srgb_output_intents(this));
     }
 
-    docCatalog->insertRef("Pages", generate_page_tree(this, std::move(fPages), fPageRefs));
+    if (fMetadata.fStreamPages) {
+        docCatalog->insertRef("Pages",
+                              generate_streamed_page_tree(this, fPageTreeLeafRefs, fPageRefs));
+    } else {
+        docCatalog->insertRef("Pages", generate_page_tree(this, std::move(fPages), fPageRefs));
+    }
 
     if (!fNamedDestinations.empty()) {
         docCatalog->insertRef("Dests", append_destinations(this, fNamedDestinations));
@@ -565,9 +691,9 @@ void SkPDFDocument::incrementJobCount() { fJobCount++; }
 
 void SkPDFDocument::signalJobComplete() { fSemaphore.signal(); }
 
-void SkPDFDocument::waitForJobs() {
+void SkPDFDocument::waitForJobs(int maxPendingJobs) {
      // fJobCount can increase while we wait.
-     while (fJobCount > 0) {
+     while (fJobCount > maxPendingJobs) {
          fSemaphore.wait();
          --fJobCount;
      }
@@ -581,6 +707,12 @@ void SkPDF::SetNodeId(SkCanvas* canvas, int nodeID) {
     canvas->drawAnnotation({0, 0, 0, 0}, key, payload.get());
 }
 
+void SkPDF::AppendPages(SkDocument* document, const sk_sp<SkPicture> pages[], int count) {
+    if (document) {
+        static_cast<SkPDFDocument*>(document)->appendPages(pages, count);
+    }
+}
+
 sk_sp<SkDocument> SkPDF::MakeDocument(SkWStream* stream, const SkPDF::Metadata& metadata) {
     SkPDF::Metadata meta = metadata;
     if (meta.fRasterDPI <= 0) {
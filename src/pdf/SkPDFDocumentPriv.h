@@ -8,6 +8,7 @@
 #define SkPDFDocumentPriv_DEFINED
 
 #include "include/core/SkCanvas.h"
+#include "include/core/SkData.h"
 #include "include/core/SkStream.h"
 #include "include/docs/SkPDFDocument.h"
 #include "include/private/SkMutex.h"
@@ -22,6 +23,7 @@
 class SkExecutor;
 class SkPDFDevice;
 class SkPDFFont;
+class SkPicture;
 struct SkAdvancedTypefaceMetrics;
 struct SkBitmapKey;
 struct SkPDFFillGraphicState;
@@ -54,6 +56,18 @@ struct SkPDFNamedDestination {
     SkPDFIndirectReference fPage;
 };
 
+// A page being drawn, shared by its SkPDFDevice and any devices that one makes. Pages appended
+// with SkPDF::AppendPages() are drawn in parallel, so nothing about the page being drawn is kept
+// in the document itself.
+struct SkPDFPageState {
+    SkPDFIndirectReference fRef;
+    unsigned fIndex = 0;
+    SkMatrix fTransform;
+    std::vector<std::pair<sk_sp<SkData>, SkRect>> fLinkToURLs;
+    std::vector<std::pair<sk_sp<SkData>, SkRect>> fLinkToDestinations;
+    std::vector<SkPDFNamedDestination> fNamedDestinations;
+};
+
 /** Concrete implementation of SkDocument that creates PDF files. This
     class does not produced linearized or optimized PDFs; instead it
     it attempts to use a minimum amount of RAM. */
@@ -91,48 +105,58 @@ public:
 
     const SkPDF::Metadata& metadata() const { return fMetadata; }
 
+    // Draw each picture on a new page, converting the pages in parallel on the executor.
+    void appendPages(const sk_sp<SkPicture> pictures[], int count);
+
     SkPDFIndirectReference getPage(size_t pageIndex) const;
-    SkPDFIndirectReference currentPage() const {
-        return SkASSERT(!fPageRefs.empty()), fPageRefs.back();
-    }
     // Returns -1 if no mark ID.
-    int getMarkIdForNodeId(int nodeId);
+    int getMarkIdForNodeId(int nodeId, unsigned pageIndex);
 
     SkPDFIndirectReference reserveRef() { return SkPDFIndirectReference{fNextObjectNumber++}; }
 
     SkExecutor* executor() const { return fExecutor; }
     void incrementJobCount();
     void signalJobComplete();
-    size_t currentPageIndex() { return fPages.size(); }
     size_t pageCount() { return fPageRefs.size(); }
 
-    const SkMatrix& currentPageTransform() const;
+    // Pages may be drawn in parallel, so only use the canonicalized objects below, which all the
+    // pages share, while holding canonMutex(). Don't hold it while making an object that may need
+    // the canon itself.
+    SkMutex& canonMutex() { return fCanonMutex; }
 
     // Canonicalized objects
     SkTHashMap<SkPDFImageShaderKey, SkPDFIndirectReference> fImageShaderMap;
     SkTHashMap<SkPDFGradientShader::Key, SkPDFIndirectReference, SkPDFGradientShader::KeyHash>
         fGradientPatternMap;
     SkTHashMap<SkBitmapKey, SkPDFIndirectReference> fPDFBitmapMap;
+    // Images embedded from their encoded data (see SkPDFEmbeddableEncodedData()), by its hash.
+    struct EncodedImage {
+        sk_sp<SkData> fData;
+        SkPDFIndirectReference fRef;
+    };
+    SkTHashMap<uint32_t, EncodedImage> fEncodedImageMap;
     SkTHashMap<uint32_t, std::unique_ptr<SkAdvancedTypefaceMetrics>> fTypefaceMetrics;
     SkTHashMap<uint32_t, std::vector<SkString>> fType1GlyphNames;
-    SkTHashMap<uint32_t, std::vector<SkUnichar>> fToUnicodeMap;
+    SkTHashMap<uint32_t, std::unique_ptr<std::vector<SkUnichar>>> fToUnicodeMap;
     SkTHashMap<uint32_t, SkPDFIndirectReference> fFontDescriptors;
     SkTHashMap<uint32_t, SkPDFIndirectReference> fType3FontDescriptors;
-    SkTHashMap<uint64_t, SkPDFFont> fFontMap;
+    SkTHashMap<uint64_t, std::unique_ptr<SkPDFFont>> fFontMap;
     SkTHashMap<SkPDFStrokeGraphicState, SkPDFIndirectReference> fStrokeGSMap;
     SkTHashMap<SkPDFFillGraphicState, SkPDFIndirectReference> fFillGSMap;
     SkPDFIndirectReference fInvertFunction;
     SkPDFIndirectReference fNoSmaskGraphicState;
 
-    std::vector<std::pair<sk_sp<SkData>, SkRect>> fCurrentPageLinkToURLs;
-    std::vector<std::pair<sk_sp<SkData>, SkRect>> fCurrentPageLinkToDestinations;
-    std::vector<SkPDFNamedDestination> fNamedDestinations;
-
 private:
     SkPDFOffsetMap fOffsetMap;
     SkCanvas fCanvas;
+    SkPDFPageState fCurrentPage;
+    std::vector<SkPDFNamedDestination> fNamedDestinations;
     std::vector<std::unique_ptr<SkPDFDict>> fPages;
     std::vector<SkPDFIndirectReference> fPageRefs;
+    // When streaming pages, the reserved references of the page tree nodes that are the
+    // parents of the pages already written, one per kMaxNodeSize pages.
+    std::vector<SkPDFIndirectReference> fPageTreeLeafRefs;
+    size_t fPageCount = 0;
 
     sk_sp<SkPDFDevice> fPageDevice;
     std::atomic<int> fNextObjectNumber = {1};
@@ -149,9 +173,15 @@ private:
     SkPDFTagTree fTagTree;
 
     SkMutex fMutex;
+    SkMutex fCanonMutex;
     SkSemaphore fSemaphore;
 
-    void waitForJobs();
+    void beginDocument();
+    sk_sp<SkPDFDevice> makePageDevice(SkScalar width, SkScalar height, SkPDFPageState*);
+    std::unique_ptr<SkPDFDict> makePageDict(sk_sp<SkPDFDevice>, SkPDFPageState*);
+    void addPage(std::unique_ptr<SkPDFDict>, SkPDFPageState*);
+    // Wait until no more than maxPendingJobs jobs are still running.
+    void waitForJobs(int maxPendingJobs = 0);
     SkWStream* beginObject(SkPDFIndirectReference);
     void endObject();
 };
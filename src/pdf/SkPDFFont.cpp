@@ -37,6 +37,7 @@
 #include "src/pdf/SkPDFBitmap.h"
 #include "src/pdf/SkPDFDocumentPriv.h"
 #include "src/pdf/SkPDFFont.h"
+#include "src/pdf/SkPDFFontSubsetCache.h"
 #include "src/pdf/SkPDFMakeCIDGlyphWidthsArray.h"
 #include "src/pdf/SkPDFMakeToUnicodeCmap.h"
 #include "src/pdf/SkPDFSubsetFont.h"
@@ -96,10 +97,6 @@ void setGlyphWidthAndBoundingBox(SkScalar width, SkIRect box,
 
 SkPDFFont::~SkPDFFont() = default;
 
-SkPDFFont::SkPDFFont(SkPDFFont&&) = default;
-
-SkPDFFont& SkPDFFont::operator=(SkPDFFont&&) = default;
-
 static bool can_embed(const SkAdvancedTypefaceMetrics& metrics) {
     return !SkToBool(metrics.fFlags & SkAdvancedTypefaceMetrics::kNotEmbeddable_FontFlag);
 }
@@ -108,12 +105,16 @@ const SkAdvancedTypefaceMetrics* SkPDFFont::GetMetrics(const SkTypeface* typefac
                                                        SkPDFDocument* canon) {
     SkASSERT(typeface);
     SkFontID id = typeface->uniqueID();
-    if (std::unique_ptr<SkAdvancedTypefaceMetrics>* ptr = canon->fTypefaceMetrics.find(id)) {
-        return ptr->get();  // canon retains ownership.
+    {
+        SkAutoMutexExclusive lock(canon->canonMutex());
+        if (std::unique_ptr<SkAdvancedTypefaceMetrics>* ptr = canon->fTypefaceMetrics.find(id)) {
+            return ptr->get();  // canon retains ownership.
+        }
     }
     int count = typeface->countGlyphs();
     if (count <= 0 || count > 1 + SkTo<int>(UINT16_MAX)) {
         // Cache nullptr to skip this check.  Use SkSafeUnref().
+        SkAutoMutexExclusive lock(canon->canonMutex());
         canon->fTypefaceMetrics.set(id, nullptr);
         return nullptr;
     }
@@ -151,6 +152,12 @@ const SkAdvancedTypefaceMetrics* SkPDFFont::GetMetrics(const SkTypeface* typefac
             metrics->fCapHeight = SkToS16(SkScalarRoundToInt(capHeight / 2));
         }
     }
+    // Another page may have added these metrics while we were working; keep theirs, since they
+    // may already be in use.
+    SkAutoMutexExclusive lock(canon->canonMutex());
+    if (std::unique_ptr<SkAdvancedTypefaceMetrics>* ptr = canon->fTypefaceMetrics.find(id)) {
+        return ptr->get();
+    }
     return canon->fTypefaceMetrics.set(id, std::move(metrics))->get();
 }
 
@@ -159,12 +166,19 @@ const std::vector<SkUnichar>& SkPDFFont::GetUnicodeMap(const SkTypeface* typefac
     SkASSERT(typeface);
     SkASSERT(canon);
     SkFontID id = typeface->uniqueID();
-    if (std::vector<SkUnichar>* ptr = canon->fToUnicodeMap.find(id)) {
-        return *ptr;
+    {
+        SkAutoMutexExclusive lock(canon->canonMutex());
+        if (std::unique_ptr<std::vector<SkUnichar>>* ptr = canon->fToUnicodeMap.find(id)) {
+            return **ptr;
+        }
+    }
+    auto buffer = skstd::make_unique<std::vector<SkUnichar>>(typeface->countGlyphs());
+    typeface->getGlyphToUnicodeMap(buffer->data());
+    SkAutoMutexExclusive lock(canon->canonMutex());
+    if (std::unique_ptr<std::vector<SkUnichar>>* ptr = canon->fToUnicodeMap.find(id)) {
+        return **ptr;
     }
-    std::vector<SkUnichar> buffer(typeface->countGlyphs());
-    typeface->getGlyphToUnicodeMap(buffer.data());
-    return *canon->fToUnicodeMap.set(id, std::move(buffer));
+    return **canon->fToUnicodeMap.set(id, std::move(buffer));
 }
 
 SkAdvancedTypefaceMetrics::FontType SkPDFFont::FontType(const SkAdvancedTypefaceMetrics& metrics) {
@@ -203,9 +217,12 @@ SkPDFFont* SkPDFFont::GetFontResource(SkPDFDocument* doc,
     SkGlyphID subsetCode = multibyte ? 0 : first_nonzero_glyph_for_single_byte_encoding(glyphID);
     uint64_t fontID = (static_cast<uint64_t>(SkTypeface::UniqueID(face)) << 16) | subsetCode;
 
-    if (SkPDFFont* found = doc->fFontMap.find(fontID)) {
-        SkASSERT(multibyte == found->multiByteGlyphs());
-        return found;
+    {
+        SkAutoMutexExclusive lock(doc->canonMutex());
+        if (std::unique_ptr<SkPDFFont>* found = doc->fFontMap.find(fontID)) {
+            SkASSERT(multibyte == (*found)->multiByteGlyphs());
+            return found->get();
+        }
     }
 
     sk_sp<SkTypeface> typeface(sk_ref_sp(face));
@@ -223,9 +240,15 @@ SkPDFFont* SkPDFFont::GetFontResource(SkPDFDocument* doc,
         firstNonZeroGlyph = subsetCode;
         lastGlyph = SkToU16(SkTMin<int>((int)lastGlyph, 254 + (int)subsetCode));
     }
-    auto ref = doc->reserveRef();
-    return doc->fFontMap.set(
-            fontID, SkPDFFont(std::move(typeface), firstNonZeroGlyph, lastGlyph, type, ref));
+    // Only reserve the font's reference once we know no other page beat us to it, since every
+    // reserved reference must be written.
+    SkAutoMutexExclusive lock(doc->canonMutex());
+    if (std::unique_ptr<SkPDFFont>* found = doc->fFontMap.find(fontID)) {
+        return found->get();
+    }
+    std::unique_ptr<SkPDFFont> font(new SkPDFFont(std::move(typeface), firstNonZeroGlyph,
+                                                  lastGlyph, type, doc->reserveRef()));
+    return doc->fFontMap.set(fontID, std::move(font))->get();
 }
 
 SkPDFFont::SkPDFFont(sk_sp<SkTypeface> typeface,
@@ -282,6 +305,42 @@ static sk_sp<SkData> stream_to_data(std::unique_ptr<SkStreamAsset> stream) {
     return SkData::MakeFromStream(stream.get(), size);
 }
 
+// The parts of a Type0 font that only depend on its typeface and the glyphs it uses, which
+// documents can share through an SkPDFFontSubsetCache.
+static SkPDFFontSubsetCache::Subset make_type0_subset(const SkPDFFont& font,
+                                                      const SkAdvancedTypefaceMetrics& metrics,
+                                                      SkPDFDocument* doc) {
+    SkPDFFontSubsetCache::Subset subset;
+    SkTypeface* face = font.typeface();
+    if (SkAdvancedTypefaceMetrics::kTrueType_Font == font.getType() &&
+        !SkToBool(metrics.fFlags & SkAdvancedTypefaceMetrics::kNotSubsettable_FontFlag)) {
+        int ttcIndex;
+        std::unique_ptr<SkStreamAsset> fontAsset = face->openStream(&ttcIndex);
+        if (fontAsset && fontAsset->getLength() > 0) {
+            SkASSERT(font.firstGlyphID() == 1);
+            subset.fFontData = SkPDFSubsetFont(
+                    stream_to_data(std::move(fontAsset)), font.glyphUsage(),
+                    doc->metadata().fSubsetter,
+                    metrics.fFontName.c_str(), ttcIndex);
+        }
+    }
+
+    int emSize;
+    SkStrikeSpecStorage strikeSpec = SkStrikeSpecStorage::MakePDFVector(*face, &emSize);
+    auto glyphCache = strikeSpec.findOrCreateExclusiveStrike();
+    subset.fAdvances = SkPDFGetGlyphAdvances(glyphCache.get(), &font.glyphUsage());
+    subset.fEmSize = SkToU16(emSize);
+
+    const std::vector<SkUnichar>& glyphToUnicode = SkPDFFont::GetUnicodeMap(face, doc);
+    SkASSERT(SkToSizeT(face->countGlyphs()) == glyphToUnicode.size());
+    subset.fToUnicode = stream_to_data(SkPDFMakeToUnicodeCmap(glyphToUnicode.data(),
+                                                              &font.glyphUsage(),
+                                                              font.multiByteGlyphs(),
+                                                              font.firstGlyphID(),
+                                                              font.lastGlyphID()));
+    return subset;
+}
+
 static void emit_subset_type0(const SkPDFFont& font, SkPDFDocument* doc) {
     const SkAdvancedTypefaceMetrics* metricsPtr =
         SkPDFFont::GetMetrics(font.typeface(), doc);
@@ -293,6 +352,15 @@ static void emit_subset_type0(const SkPDFFont& font, SkPDFDocument* doc) {
     SkTypeface* face = font.typeface();
     SkASSERT(face);
 
+    SkPDFFontSubsetCache::Subset subset;
+    if (auto cache = static_cast<SkPDFFontSubsetCache*>(doc->metadata().fFontSubsetCache)) {
+        subset = cache->findOrMake(face->uniqueID(), doc->metadata().fSubsetter,
+                                   font.glyphUsage(),
+                                   [&]() { return make_type0_subset(font, metrics, doc); });
+    } else {
+        subset = make_type0_subset(font, metrics, doc);
+    }
+
     auto descriptor = SkPDFMakeDict("FontDescriptor");
     uint16_t emSize = SkToU16(font.typeface()->getUnitsPerEm());
     SkPDFFont::PopulateCommonFontDescriptor(descriptor.get(), metrics, emSize , 0);
@@ -307,29 +375,17 @@ static void emit_subset_type0(const SkPDFFont& font, SkPDFDocument* doc) {
     } else {
         switch (type) {
             case SkAdvancedTypefaceMetrics::kTrueType_Font: {
-                if (!SkToBool(metrics.fFlags &
-                              SkAdvancedTypefaceMetrics::kNotSubsettable_FontFlag)) {
-                    SkASSERT(font.firstGlyphID() == 1);
-                    sk_sp<SkData> subsetFontData = SkPDFSubsetFont(
-                            stream_to_data(std::move(fontAsset)), font.glyphUsage(),
-                            doc->metadata().fSubsetter,
-                            metrics.fFontName.c_str(), ttcIndex);
-                    if (subsetFontData) {
-                        std::unique_ptr<SkPDFDict> tmp = SkPDFMakeDict();
-                        tmp->insertInt("Length1", SkToInt(subsetFontData->size()));
-                        descriptor->insertRef(
-                                "FontFile2",
-                                SkPDFStreamOut(std::move(tmp),
-                                               SkMemoryStream::Make(std::move(subsetFontData)),
-                                               doc, true));
-                        break;
-                    }
-                    // If subsetting fails, fall back to original font data.
-                    fontAsset = face->openStream(&ttcIndex);
-                    SkASSERT(fontAsset);
-                    SkASSERT(fontAsset->getLength() == fontSize);
-                    if (!fontAsset || fontAsset->getLength() == 0) { break; }
+                if (sk_sp<SkData> subsetFontData = subset.fFontData) {
+                    std::unique_ptr<SkPDFDict> tmp = SkPDFMakeDict();
+                    tmp->insertInt("Length1", SkToInt(subsetFontData->size()));
+                    descriptor->insertRef(
+                            "FontFile2",
+                            SkPDFStreamOut(std::move(tmp),
+                                           SkMemoryStream::Make(std::move(subsetFontData)),
+                                           doc, true));
+                    break;
                 }
+                // If the font can't be subset, or subsetting fails, use the original font data.
                 std::unique_ptr<SkPDFDict> tmp = SkPDFMakeDict();
                 tmp->insertInt("Length1", fontSize);
                 descriptor->insertRef("FontFile2",
@@ -373,16 +429,13 @@ static void emit_subset_type0(const SkPDFFont& font, SkPDFDocument* doc) {
 
     int16_t defaultWidth = 0;
     {
-        int emSize;
-        SkStrikeSpecStorage strikeSpec = SkStrikeSpecStorage::MakePDFVector(*face, &emSize);
-        auto glyphCache = strikeSpec.findOrCreateExclusiveStrike();
         std::unique_ptr<SkPDFArray> widths = SkPDFMakeCIDGlyphWidthsArray(
-                glyphCache.get(), &font.glyphUsage(), SkToS16(emSize), &defaultWidth);
+                subset.fAdvances, &font.glyphUsage(), subset.fEmSize, &defaultWidth);
         if (widths && widths->size() > 0) {
             newCIDFont->insertObject("W", std::move(widths));
         }
         newCIDFont->insertScalar(
-                "DW", scaleFromFontUnits(defaultWidth, SkToS16(emSize)));
+                "DW", scaleFromFontUnits(defaultWidth, SkToS16(subset.fEmSize)));
     }
 
     ////////////////////////////////////////////////////////////////////////////
@@ -395,16 +448,8 @@ static void emit_subset_type0(const SkPDFFont& font, SkPDFDocument* doc) {
     descendantFonts->appendRef(doc->emit(*newCIDFont));
     fontDict.insertObject("DescendantFonts", std::move(descendantFonts));
 
-    const std::vector<SkUnichar>& glyphToUnicode =
-        SkPDFFont::GetUnicodeMap(font.typeface(), doc);
-    SkASSERT(SkToSizeT(font.typeface()->countGlyphs()) == glyphToUnicode.size());
-    std::unique_ptr<SkStreamAsset> toUnicode =
-            SkPDFMakeToUnicodeCmap(glyphToUnicode.data(),
-                                   &font.glyphUsage(),
-                                   font.multiByteGlyphs(),
-                                   font.firstGlyphID(),
-                                   font.lastGlyphID());
-    fontDict.insertRef("ToUnicode", SkPDFStreamOut(nullptr, std::move(toUnicode), doc));
+    fontDict.insertRef("ToUnicode",
+                       SkPDFStreamOut(nullptr, SkMemoryStream::Make(subset.fToUnicode), doc));
 
     doc->emit(fontDict, font.indirectReference());
 }
@@ -10,6 +10,7 @@
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkTypeface.h"
 #include "include/core/SkTypes.h"
+#include "include/private/SkSpinlock.h"
 #include "src/core/SkAdvancedTypefaceMetrics.h"
 #include "src/core/SkStrikeCache.h"
 #include "src/pdf/SkPDFGlyphUse.h"
@@ -32,8 +33,6 @@ class SkPDFFont {
 public:
     SkPDFFont() {}
     ~SkPDFFont();
-    SkPDFFont(SkPDFFont&&);
-    SkPDFFont& operator=(SkPDFFont&&);
 
     /** Returns the typeface represented by this class. Returns nullptr for the
      *  default typeface.
@@ -75,6 +74,7 @@ public:
 
     void noteGlyphUsage(SkGlyphID glyph) {
         SkASSERT(this->hasGlyph(glyph));
+        SkAutoSpinlock lock(fGlyphUsageLock);  // Fonts are shared by pages drawn in parallel.
         fGlyphUsage.set(glyph);
     }
 
@@ -124,6 +124,7 @@ public:
 private:
     sk_sp<SkTypeface> fTypeface;
     SkPDFGlyphUse fGlyphUsage;
+    SkSpinlock fGlyphUsageLock;
     SkPDFIndirectReference fIndirectReference;
     SkAdvancedTypefaceMetrics::FontType fFontType = (SkAdvancedTypefaceMetrics::FontType)(-1);
 
@@ -0,0 +1,84 @@
+// Copyright 2019 Google LLC.
+// Use of this source code is governed by a BSD-style license that can be found in the LICENSE file.
+
+#include "src/pdf/SkPDFFontSubsetCache.h"
+
+#include "include/private/SkTo.h"
+#include "src/core/SkOpts.h"
+#include "src/pdf/SkPDFGlyphUse.h"
+
+std::unique_ptr<SkPDF::FontSubsetCache> SkPDF::FontSubsetCache::Make(size_t byteLimit) {
+    return std::unique_ptr<SkPDF::FontSubsetCache>(new SkPDFFontSubsetCache(byteLimit));
+}
+
+SkPDFFontSubsetCache::Key::Key(uint32_t typefaceID,
+                               SkPDF::Metadata::Subsetter subsetter,
+                               const SkPDFGlyphUse& glyphUsage)
+        : fTypefaceID(typefaceID), fSubsetter(subsetter) {
+    glyphUsage.getSetValues([this](unsigned gid) { fGlyphs.push_back(SkToU16(gid)); });
+    fHash = SkOpts::hash(fGlyphs.data(), fGlyphs.size() * sizeof(SkGlyphID),
+                         fTypefaceID ^ (uint32_t)fSubsetter);
+}
+
+bool SkPDFFontSubsetCache::Key::operator==(const Key& that) const {
+    return fHash == that.fHash && fTypefaceID == that.fTypefaceID &&
+           fSubsetter == that.fSubsetter && fGlyphs == that.fGlyphs;
+}
+
+SkPDFFontSubsetCache::Entry::Entry(Key&& key, const Subset& subset)
+        : fKey(std::move(key)), fSubset(subset) {
+    fBytes = sizeof(Entry) + fKey.fGlyphs.size() * sizeof(SkGlyphID) +
+             fSubset.fAdvances.size() * sizeof(int16_t) +
+             (fSubset.fFontData ? fSubset.fFontData->size() : 0) +
+             (fSubset.fToUnicode ? fSubset.fToUnicode->size() : 0);
+}
+
+SkPDFFontSubsetCache::~SkPDFFontSubsetCache() {
+    SkAutoMutexExclusive lock(fMutex);
+    fMap.reset();
+    while (Entry* entry = fLRU.head()) {
+        fLRU.remove(entry);
+        delete entry;
+    }
+}
+
+size_t SkPDFFontSubsetCache::bytesUsed() const {
+    SkAutoMutexExclusive lock(fMutex);
+    return fBytesUsed;
+}
+
+bool SkPDFFontSubsetCache::find(const Key& key, Subset* subset) {
+    SkAutoMutexExclusive lock(fMutex);
+    Entry** found = fMap.find(key);
+    if (!found) {
+        return false;
+    }
+    Entry* entry = *found;
+    if (entry != fLRU.head()) {
+        fLRU.remove(entry);
+        fLRU.addToHead(entry);
+    }
+    *subset = entry->fSubset;
+    return true;
+}
+
+void SkPDFFontSubsetCache::add(Key&& key, const Subset& subset) {
+    std::unique_ptr<Entry> newEntry(new Entry(std::move(key), subset));
+    if (newEntry->fBytes > fByteLimit) {
+        return;
+    }
+    SkAutoMutexExclusive lock(fMutex);
+    if (fMap.find(newEntry->fKey)) {
+        return;  // Another thread made it first.
+    }
+    fBytesUsed += newEntry->fBytes;
+    fMap.set(newEntry.get());
+    fLRU.addToHead(newEntry.release());
+    while (fBytesUsed > fByteLimit) {
+        Entry* oldest = fLRU.tail();
+        fLRU.remove(oldest);
+        fMap.remove(oldest->fKey);
+        fBytesUsed -= oldest->fBytes;
+        delete oldest;
+    }
+}
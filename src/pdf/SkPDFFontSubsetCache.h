@@ -0,0 +1,84 @@
+// Copyright 2019 Google LLC.
+// Use of this source code is governed by a BSD-style license that can be found in the LICENSE file.
+#ifndef SkPDFFontSubsetCache_DEFINED
+#define SkPDFFontSubsetCache_DEFINED
+
+#include "include/core/SkData.h"
+#include "include/docs/SkPDFDocument.h"
+#include "include/private/SkMutex.h"
+#include "include/private/SkTHash.h"
+#include "src/core/SkTInternalLList.h"
+
+#include <vector>
+
+class SkPDFGlyphUse;
+
+// The SkPDF::FontSubsetCache that SkPDF::FontSubsetCache::Make() makes.
+class SkPDFFontSubsetCache final : public SkPDF::FontSubsetCache {
+public:
+    // The parts of a Type0 font that only depend on its typeface and the glyphs it uses.
+    struct Subset {
+        // The subset font program, or null to embed the whole font.
+        sk_sp<SkData>        fFontData;
+        // From SkPDFGetGlyphAdvances(), in fEmSize units.
+        std::vector<int16_t> fAdvances;
+        uint16_t             fEmSize = 0;
+        sk_sp<SkData>        fToUnicode;
+    };
+
+    explicit SkPDFFontSubsetCache(size_t byteLimit) : fByteLimit(byteLimit) {}
+    ~SkPDFFontSubsetCache() override;
+
+    size_t bytesUsed() const override;
+
+    // Returns the cached subset of the typeface for the glyphs, or the one make() returns if
+    // there isn't one. make() is called without holding the cache's lock, so threads that
+    // miss at the same time may each make the subset.
+    template <typename Fn>
+    Subset findOrMake(uint32_t typefaceID, SkPDF::Metadata::Subsetter subsetter,
+                      const SkPDFGlyphUse& glyphUsage, Fn&& make) {
+        Key key(typefaceID, subsetter, glyphUsage);
+        Subset subset;
+        if (!this->find(key, &subset)) {
+            subset = make();
+            this->add(std::move(key), subset);
+        }
+        return subset;
+    }
+
+private:
+    struct Key {
+        Key(uint32_t typefaceID, SkPDF::Metadata::Subsetter, const SkPDFGlyphUse&);
+        bool operator==(const Key&) const;
+
+        uint32_t               fTypefaceID;
+        int                    fSubsetter;
+        std::vector<SkGlyphID> fGlyphs;
+        uint32_t               fHash;
+    };
+    struct Entry {
+        Entry(Key&& key, const Subset& subset);
+
+        Key    fKey;
+        Subset fSubset;
+        size_t fBytes;
+
+        SK_DECLARE_INTERNAL_LLIST_INTERFACE(Entry);
+    };
+    struct Traits {
+        static const Key& GetKey(const Entry* entry) { return entry->fKey; }
+        static uint32_t Hash(const Key& key) { return key.fHash; }
+    };
+
+    bool find(const Key&, Subset*);
+    void add(Key&&, const Subset&);
+
+    const size_t                       fByteLimit;
+    mutable SkMutex                    fMutex;
+    SkTHashTable<Entry*, Key, Traits>  fMap SK_GUARDED_BY(fMutex);
+    // Most recently used first.
+    SkTInternalLList<Entry>            fLRU SK_GUARDED_BY(fMutex);
+    size_t                             fBytesUsed SK_GUARDED_BY(fMutex) = 0;
+};
+
+#endif  // SkPDFFontSubsetCache_DEFINED
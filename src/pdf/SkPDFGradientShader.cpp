@@ -896,8 +896,11 @@ static SkPDFIndirectReference find_pdf_shader(SkPDFDocument* doc,
                                               bool keyHasAlpha) {
     SkASSERT(gradient_has_alpha(key) == keyHasAlpha);
     auto& gradientPatternMap = doc->fGradientPatternMap;
-    if (SkPDFIndirectReference* ptr = gradientPatternMap.find(key)) {
-        return *ptr;
+    {
+        SkAutoMutexExclusive lock(doc->canonMutex());
+        if (SkPDFIndirectReference* ptr = gradientPatternMap.find(key)) {
+            return *ptr;
+        }
     }
     SkPDFIndirectReference pdfShader;
     if (keyHasAlpha) {
@@ -905,6 +908,7 @@ static SkPDFIndirectReference find_pdf_shader(SkPDFDocument* doc,
     } else {
         pdfShader = make_function_shader(doc, key);
     }
+    SkAutoMutexExclusive lock(doc->canonMutex());
     gradientPatternMap.set(std::move(key), pdfShader);
     return pdfShader;
 }
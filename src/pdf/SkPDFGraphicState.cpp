@@ -59,14 +59,18 @@ SkPDFIndirectReference SkPDFGraphicState::GetGraphicStateForPaint(SkPDFDocument*
     if (SkPaint::kFill_Style == p.getStyle()) {
         SkPDFFillGraphicState fillKey = {p.getColor4f().fA, pdf_blend_mode(p.getBlendMode())};
         auto& fillMap = doc->fFillGSMap;
-        if (SkPDFIndirectReference* statePtr = fillMap.find(fillKey)) {
-            return *statePtr;
+        {
+            SkAutoMutexExclusive lock(doc->canonMutex());
+            if (SkPDFIndirectReference* statePtr = fillMap.find(fillKey)) {
+                return *statePtr;
+            }
         }
         SkPDFDict state;
         state.reserve(2);
         state.insertColorComponentF("ca", fillKey.fAlpha);
         state.insertName("BM", as_pdf_blend_mode_name((SkBlendMode)fillKey.fBlendMode));
         SkPDFIndirectReference ref = doc->emit(state);
+        SkAutoMutexExclusive lock(doc->canonMutex());
         fillMap.set(fillKey, ref);
         return ref;
     } else {
@@ -79,8 +83,11 @@ SkPDFIndirectReference SkPDFGraphicState::GetGraphicStateForPaint(SkPDFDocument*
             pdf_blend_mode(p.getBlendMode())
         };
         auto& sMap = doc->fStrokeGSMap;
-        if (SkPDFIndirectReference* statePtr = sMap.find(strokeKey)) {
-            return *statePtr;
+        {
+            SkAutoMutexExclusive lock(doc->canonMutex());
+            if (SkPDFIndirectReference* statePtr = sMap.find(strokeKey)) {
+                return *statePtr;
+            }
         }
         SkPDFDict state;
         state.reserve(8);
@@ -93,6 +100,7 @@ SkPDFIndirectReference SkPDFGraphicState::GetGraphicStateForPaint(SkPDFDocument*
         state.insertBool("SA", true);  // SA = Auto stroke adjustment.
         state.insertName("BM", as_pdf_blend_mode_name((SkBlendMode)strokeKey.fBlendMode));
         SkPDFIndirectReference ref = doc->emit(state);
+        SkAutoMutexExclusive lock(doc->canonMutex());
         sMap.set(strokeKey, ref);
         return ref;
     }
@@ -129,6 +137,7 @@ SkPDFIndirectReference SkPDFGraphicState::GetSMaskGraphicState(SkPDFIndirectRefe
     sMaskDict->insertRef("G", sMask);
     if (invert) {
         // let the doc deduplicate this object.
+        SkAutoMutexExclusive lock(doc->canonMutex());
         if (doc->fInvertFunction == SkPDFIndirectReference()) {
             doc->fInvertFunction = make_invert_function(doc);
         }
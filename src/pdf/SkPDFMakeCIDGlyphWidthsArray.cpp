@@ -140,10 +140,35 @@ static void compose_advance_data(const AdvanceMetric& range,
     }
 }
 
+std::vector<int16_t> SkPDFGetGlyphAdvances(SkStrike* cache, const SkPDFGlyphUse* subset) {
+    // Limit the glyphs to the last one used.
+    int lastIndex = SkToInt(cache->getGlyphCount());
+    if (subset) {
+        while (lastIndex > 0 && !subset->has(lastIndex - 1)) {
+            --lastIndex;
+        }
+    }
+    SkAutoTArray<SkGlyphID> glyphIDs{lastIndex};
+    for (int gId = 0; gId < lastIndex; gId++) {
+        glyphIDs[gId] = gId;
+    }
+
+    SkAutoTArray<SkPoint> advances{lastIndex};
+
+    cache->getAdvances(
+            SkSpan<const SkGlyphID>{glyphIDs.get(), SkTo<size_t>(lastIndex)}, advances.get());
+
+    std::vector<int16_t> result(lastIndex);
+    for (int gId = 0; gId < lastIndex; gId++) {
+        result[gId] = (int16_t)advances[gId].x();
+    }
+    return result;
+}
+
 /** Retrieve advance data for glyphs. Used by the PDF backend. */
 // TODO(halcanary): this function is complex enough to need its logic
 // tested with unit tests.
-std::unique_ptr<SkPDFArray> SkPDFMakeCIDGlyphWidthsArray(SkStrike* cache,
+std::unique_ptr<SkPDFArray> SkPDFMakeCIDGlyphWidthsArray(const std::vector<int16_t>& advances,
                                                          const SkPDFGlyphUse* subset,
                                                          uint16_t emSize,
                                                          int16_t* defaultAdvance) {
@@ -163,7 +188,6 @@ std::unique_ptr<SkPDFArray> SkPDFMakeCIDGlyphWidthsArray(SkStrike* cache,
     //  e. Removing 2 repeating advances is a win
 
     auto result = SkPDFMakeArray();
-    int num_glyphs = SkToInt(cache->getGlyphCount());
 
     bool prevRange = false;
 
@@ -172,30 +196,14 @@ std::unique_ptr<SkPDFArray> SkPDFMakeCIDGlyphWidthsArray(SkStrike* cache,
     int wildCardsInRun = 0;
     int trailingWildCards = 0;
 
-    // Limit the loop count to glyph id ranges provided.
-    int lastIndex = num_glyphs;
-    if (subset) {
-        while (!subset->has(lastIndex - 1) && lastIndex > 0) {
-            --lastIndex;
-        }
-    }
+    int lastIndex = SkToInt(advances.size());
     AdvanceMetric curRange(0);
 
-    SkAutoTArray<SkGlyphID> glyphIDs{lastIndex + 1};
-    for (int gId = 0; gId <= lastIndex; gId++) {
-        glyphIDs[gId] = gId;
-    }
-
-    SkAutoTArray<SkPoint> advances{lastIndex + 1};
-
-    cache->getAdvances(
-            SkSpan<const SkGlyphID>{glyphIDs.get(), SkTo<size_t>(lastIndex + 1)}, advances.get());
-
     for (int gId = 0; gId <= lastIndex; gId++) {
         int16_t advance = kInvalidAdvance;
         if (gId < lastIndex) {
             if (!subset || 0 == gId || subset->has(gId)) {
-                advance = (int16_t)advances[gId].x();
+                advance = advances[gId];
             } else {
                 advance = kDontCareAdvance;
             }
@@ -9,13 +9,18 @@
 
 #include "src/pdf/SkPDFTypes.h"
 
+#include <vector>
+
 class SkStrike;
 class SkPDFGlyphUse;
 
+/* The advances of each glyph up to the last one used, in the units of the strike. */
+std::vector<int16_t> SkPDFGetGlyphAdvances(SkStrike* cache, const SkPDFGlyphUse* subset);
+
 /* PDF 32000-1:2008, page 270: "The array's elements have a variable
    format that can specify individual widths for consecutive CIDs or
    one width for a range of CIDs". */
-std::unique_ptr<SkPDFArray> SkPDFMakeCIDGlyphWidthsArray(SkStrike* cache,
+std::unique_ptr<SkPDFArray> SkPDFMakeCIDGlyphWidthsArray(const std::vector<int16_t>& advances,
                                                          const SkPDFGlyphUse* subset,
                                                          uint16_t emSize,
                                                          int16_t* defaultWidth);
@@ -356,11 +356,14 @@ SkPDFIndirectReference SkPDFMakeShader(SkPDFDocument* doc,
     SkASSERT(shader->asAGradient(nullptr) == SkShader::kNone_GradientType) ;
     if (SkImage* skimg = shader->isAImage(&key.fShaderTransform, key.fImageTileModes)) {
         key.fBitmapKey = SkBitmapKeyFromImage(skimg);
-        SkPDFIndirectReference* shaderPtr = doc->fImageShaderMap.find(key);
-        if (shaderPtr) {
-            return *shaderPtr;
+        {
+            SkAutoMutexExclusive lock(doc->canonMutex());
+            if (SkPDFIndirectReference* shaderPtr = doc->fImageShaderMap.find(key)) {
+                return *shaderPtr;
+            }
         }
         SkPDFIndirectReference pdfShader = make_image_shader(doc, key, skimg);
+        SkAutoMutexExclusive lock(doc->canonMutex());
         doc->fImageShaderMap.set(std::move(key), pdfShader);
         return pdfShader;
     }
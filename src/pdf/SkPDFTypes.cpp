@@ -430,9 +430,13 @@ static void serialize_stream(SkPDFDict* origDict,
     SkPDFDict tmpDict;
     SkPDFDict& dict = origDict ? *origDict : tmpDict;
     static const size_t kMinimumSavings = strlen("/Filter_/FlateDecode_");
+    SkPDF::Metadata::CompressionLevel level = doc->metadata().fCompressionLevel;
+    if (level == SkPDF::Metadata::kNone_CompressionLevel) {
+        deflate = false;
+    }
     if (deflate && stream->getLength() > kMinimumSavings) {
         SkDynamicMemoryWStream compressedData;
-        SkDeflateWStream deflateWStream(&compressedData);
+        SkDeflateWStream deflateWStream(&compressedData, level);
         SkStreamCopy(&deflateWStream, stream);
         deflateWStream.finalize();
         #ifdef SK_PDF_BASE85_BINARY
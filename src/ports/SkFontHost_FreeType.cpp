@@ -7,6 +7,7 @@
 
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkData.h"
 #include "include/core/SkFontMetrics.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkStream.h"
@@ -14,6 +15,7 @@
 #include "include/private/SkColorData.h"
 #include "include/private/SkMalloc.h"
 #include "include/private/SkMutex.h"
+#include "include/private/SkTArray.h"
 #include "include/private/SkTemplates.h"
 #include "include/private/SkTo.h"
 #include "src/core/SkAdvancedTypefaceMetrics.h"
@@ -21,6 +23,7 @@
 #include "src/core/SkFDot6.h"
 #include "src/core/SkFontDescriptor.h"
 #include "src/core/SkGlyph.h"
+#include "src/core/SkLRUCache.h"
 #include "src/core/SkMakeUnique.h"
 #include "src/core/SkMask.h"
 #include "src/core/SkMaskGamma.h"
@@ -258,6 +261,18 @@ SK_DECLARE_STATIC_MUTEX(gFTMutex);
 static FreeTypeLibrary* gFTLibrary;
 static SkFaceRec* gFaceRecHead;
 
+// Faces no longer used by any typeface. Another typeface made from the same font data, such as a
+// clone at a different variation position, takes one of these and sets its own design coordinates
+// rather than opening the font again. The pool lives only as long as the library, so purging the
+// font cache (which lets go of every scaler context) empties it.
+static constexpr int kMaxIdleFaceRecs = 8;
+static SkFaceRec* gIdleFaceRecHead;
+static int gIdleFaceRecCount;
+static int gFacePoolHits;
+static int gFacePoolMisses;
+
+static void purge_idle_ft_faces();
+
 // Private to ref_ft_library and unref_ft_library
 static int gFTCount;
 
@@ -281,6 +296,7 @@ static void unref_ft_library() {
 
     --gFTCount;
     if (0 == gFTCount) {
+        purge_idle_ft_faces();
         SkASSERT(nullptr == gFaceRecHead);
         SkASSERT(nullptr != gFTLibrary);
         delete gFTLibrary;
@@ -298,6 +314,12 @@ struct SkFaceRec {
     uint32_t fRefCnt;
     uint32_t fFontID;
 
+    // Identifies the font data the face was opened from, so that an idle face can be reused for
+    // another typeface with the same data. Only faces opened from memory can be reused.
+    const void* fMemoryBase;
+    size_t fMemorySize;
+    int fIndex;
+
     // FreeType prior to 2.7.1 does not implement retreiving variation design metrics.
     // Cache the variation design metrics used to create the font if the user specifies them.
     SkAutoSTMalloc<4, SkFixed> fAxes;
@@ -308,6 +330,17 @@ struct SkFaceRec {
     // Manually keep track of when a named variation is requested for 2.6.1 until 2.7.1.
     bool fNamedVariationSpecified;
 
+    // Color bitmap glyphs (CBDT, sbix) as FreeType decoded them at their strike's size, keyed by
+    // strike index and glyph ID. Every other size scales these instead of decoding the glyph
+    // again. Guarded by gFTMutex.
+    struct NativeBitmap {
+        SkBitmap fBitmap;
+        int fLeft;
+        int fTop;
+    };
+    static constexpr int kMaxNativeBitmaps = 64;
+    SkLRUCache<uint32_t, NativeBitmap> fNativeBitmaps;
+
     SkFaceRec(std::unique_ptr<SkStreamAsset> stream, uint32_t fontID);
 };
 
@@ -333,7 +366,8 @@ extern "C" {
 
 SkFaceRec::SkFaceRec(std::unique_ptr<SkStreamAsset> stream, uint32_t fontID)
         : fNext(nullptr), fSkStream(std::move(stream)), fRefCnt(1), fFontID(fontID)
-        , fAxesCount(0), fNamedVariationSpecified(false)
+        , fMemoryBase(fSkStream->getMemoryBase()), fMemorySize(fSkStream->getLength()), fIndex(0)
+        , fAxesCount(0), fNamedVariationSpecified(false), fNativeBitmaps(kMaxNativeBitmaps)
 {
     sk_bzero(&fFTStream, sizeof(fFTStream));
     fFTStream.size = fSkStream->getLength();
@@ -386,6 +420,66 @@ static void ft_face_setup_axes(SkFaceRec* rec, const SkFontData& data) {
     }
 }
 
+// Caller must lock gFTMutex before calling this function.
+static void purge_idle_ft_faces() {
+    gFTMutex.assertHeld();
+    while (gIdleFaceRecHead) {
+        SkFaceRec* next = gIdleFaceRecHead->fNext;
+        delete gIdleFaceRecHead;
+        gIdleFaceRecHead = next;
+    }
+    gIdleFaceRecCount = 0;
+}
+
+// Takes an idle face opened from the same font data and moves it to the variation position of
+// 'data'. Returns nullptr if there is no such face.
+// Caller must lock gFTMutex before calling this function.
+static SkFaceRec* reuse_idle_ft_face(SkFontData& data, uint32_t fontID) {
+    gFTMutex.assertHeld();
+
+    const void* memoryBase = data.getStream()->getMemoryBase();
+    if (!memoryBase) {
+        return nullptr;
+    }
+    size_t memorySize = data.getStream()->getLength();
+
+    SkFaceRec* prev = nullptr;
+    for (SkFaceRec* rec = gIdleFaceRecHead; rec; prev = rec, rec = rec->fNext) {
+        if (rec->fMemoryBase != memoryBase || rec->fMemorySize != memorySize ||
+            rec->fIndex != data.getIndex()) {
+            continue;
+        }
+        // Without axes to set the face would be left at the previous typeface's position.
+        if (data.getAxisCount() == 0 && rec->fAxesCount != 0) {
+            continue;
+        }
+
+        if (prev) {
+            prev->fNext = rec->fNext;
+        } else {
+            gIdleFaceRecHead = rec->fNext;
+        }
+        --gIdleFaceRecCount;
+
+        rec->fNext = nullptr;
+        rec->fRefCnt = 1;
+        rec->fFontID = fontID;
+        if (data.getAxisCount() > 0) {
+            rec->fAxesCount = 0;
+            rec->fAxes.reset(0);
+            ft_face_setup_axes(rec, data);
+            bool isMultipleMaster = rec->fFace->face_flags & FT_FACE_FLAG_MULTIPLE_MASTERS;
+            if (isMultipleMaster && !rec->fNamedVariationSpecified &&
+                rec->fAxesCount != data.getAxisCount()) {
+                delete rec;
+                return nullptr;
+            }
+        }
+        return rec;
+    }
+    return nullptr;
+}
+
 // Will return nullptr on failure
 // Caller must lock gFTMutex before calling this function.
 static SkFaceRec* ref_ft_face(const SkTypeface* typeface) {
@@ -407,7 +501,16 @@ static SkFaceRec* ref_ft_face(const SkTypeface* typeface) {
         return nullptr;
     }
 
+    if (SkFaceRec* reused = reuse_idle_ft_face(*data, fontID)) {
+        ++gFacePoolHits;
+        reused->fNext = gFaceRecHead;
+        gFaceRecHead = reused;
+        return reused;
+    }
+    ++gFacePoolMisses;
+
     std::unique_ptr<SkFaceRec> rec(new SkFaceRec(data->detachStream(), fontID));
+    rec->fIndex = data->getIndex();
 
     FT_Open_Args args;
     memset(&args, 0, sizeof(args));
@@ -465,7 +568,22 @@ extern /*static*/ void unref_ft_face(SkFaceRec* faceRec) {
                 } else {
                     gFaceRecHead = next;
                 }
-                delete rec;
+                if (!rec->fMemoryBase) {
+                    delete rec;
+                    return;
+                }
+                rec->fNext = gIdleFaceRecHead;
+                gIdleFaceRecHead = rec;
+                if (++gIdleFaceRecCount > kMaxIdleFaceRecs) {
+                    // Drop the face that has been idle the longest.
+                    SkFaceRec* oldest = gIdleFaceRecHead;
+                    while (oldest->fNext->fNext) {
+                        oldest = oldest->fNext;
+                    }
+                    delete oldest->fNext;
+                    oldest->fNext = nullptr;
+                    --gIdleFaceRecCount;
+                }
             }
             return;
         }
@@ -778,6 +896,42 @@ int SkTypeface_FreeType::GetUnitsPerEm(FT_Face face) {
     return upem;
 }
 
+SkTypeface_FreeType::FacePoolStats SkTypeface_FreeType::GetFacePoolStats() {
+    SkAutoMutexAcquire ac(gFTMutex);
+    return { gFacePoolHits, gFacePoolMisses, gIdleFaceRecCount };
+}
+
+SK_DECLARE_STATIC_MUTEX(gSharedFontFileMutex);
+
+std::unique_ptr<SkStreamAsset> SkTypeface_FreeType::MakeSharedFileStream(const char path[],
+                                                                          FILE* file) {
+    struct SharedFontFile {
+        SkString fPath;
+        sk_sp<SkData> fData;
+    };
+    static auto* gSharedFontFiles = new SkTArray<SharedFontFile>;
+
+    SkAutoMutexAcquire ac(gSharedFontFileMutex);
+    sk_sp<SkData> data;
+    for (int i = gSharedFontFiles->count(); i --> 0;) {
+        SharedFontFile& shared = (*gSharedFontFiles)[i];
+        if (shared.fPath.equals(path)) {
+            data = shared.fData;
+        } else if (shared.fData->unique()) {
+            // No stream uses this mapping any more, and new ones only come from here.
+            gSharedFontFiles->removeShuffle(i);
+        }
+    }
+    if (!data) {
+        data = file ? SkData::MakeFromFILE(file) : SkData::MakeFromFileName(path);
+        if (!data) {
+            return file ? nullptr : SkStream::MakeFromFile(path);
+        }
+        gSharedFontFiles->push_back({SkString(path), data});
+    }
+    return skstd::make_unique<SkMemoryStream>(std::move(data));
+}
+
 int SkTypeface_FreeType::onGetUPEM() const {
     AutoFTAccess fta(this);
     FT_Face face = fta.face();
@@ -1326,6 +1480,28 @@ void SkScalerContext_FreeType::generateImage(const SkGlyph& glyph) {
         return;
     }
 
+    SkMatrix* bitmapMatrix = &fMatrix22Scalar;
+    SkMatrix subpixelBitmapMatrix;
+    if (this->shouldSubpixelBitmap(glyph, *bitmapMatrix)) {
+        subpixelBitmapMatrix = fMatrix22Scalar;
+        subpixelBitmapMatrix.postTranslate(SkFixedToScalar(glyph.getSubXFixed()),
+                                           SkFixedToScalar(glyph.getSubYFixed()));
+        bitmapMatrix = &subpixelBitmapMatrix;
+    }
+
+    // Color glyphs from a bitmap strike that have to be scaled can use the strike's bitmap.
+    uint32_t nativeKey = (static_cast<uint32_t>(fStrikeIndex) << 16) | glyph.getGlyphID();
+    bool useNativeBitmaps = fStrikeIndex != -1 && !bitmapMatrix->isIdentity() &&
+                            SkMask::kARGB32_Format == glyph.fMaskFormat &&
+                            0 == (fRec.fFlags & SkScalerContext::kEmbolden_Flag);
+    if (useNativeBitmaps) {
+        if (const SkFaceRec::NativeBitmap* native = fFaceRec->fNativeBitmaps.find(nativeKey)) {
+            this->generateScaledBitmapImage(native->fBitmap, native->fLeft, native->fTop, glyph,
+                                            *bitmapMatrix);
+            return;
+        }
+    }
+
     FT_Error err = FT_Load_Glyph(fFace, glyph.getGlyphID(), fLoadGlyphFlags);
     if (err != 0) {
         SK_TRACEFTR(err, "SkScalerContext_FreeType::generateImage: FT_Load_Glyph(glyph:%d "
@@ -1337,13 +1513,19 @@ void SkScalerContext_FreeType::generateImage(const SkGlyph& glyph) {
     }
 
     emboldenIfNeeded(fFace, fFace->glyph, glyph.getGlyphID());
-    SkMatrix* bitmapMatrix = &fMatrix22Scalar;
-    SkMatrix subpixelBitmapMatrix;
-    if (this->shouldSubpixelBitmap(glyph, *bitmapMatrix)) {
-        subpixelBitmapMatrix = fMatrix22Scalar;
-        subpixelBitmapMatrix.postTranslate(SkFixedToScalar(glyph.getSubXFixed()),
-                                           SkFixedToScalar(glyph.getSubYFixed()));
-        bitmapMatrix = &subpixelBitmapMatrix;
+    if (useNativeBitmaps && FT_GLYPH_FORMAT_BITMAP == fFace->glyph->format &&
+        FT_PIXEL_MODE_BGRA == fFace->glyph->bitmap.pixel_mode)
+    {
+        SkFaceRec::NativeBitmap native;
+        CopyFTBitmap(fFace->glyph->bitmap, &native.fBitmap);
+        native.fBitmap.setImmutable();
+        native.fLeft = fFace->glyph->bitmap_left;
+        native.fTop = fFace->glyph->bitmap_top;
+        const SkFaceRec::NativeBitmap* cached =
+                fFaceRec->fNativeBitmaps.insert(nativeKey, std::move(native));
+        this->generateScaledBitmapImage(cached->fBitmap, cached->fLeft, cached->fTop, glyph,
+                                        *bitmapMatrix);
+        return;
     }
     generateGlyphImage(fFace, glyph, *bitmapMatrix);
 }
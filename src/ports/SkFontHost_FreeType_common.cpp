@@ -369,6 +369,89 @@ inline SkColorType SkColorType_for_SkMaskFormat(SkMask::Format format) {
 
 }  // namespace
 
+void SkScalerContext_FreeType_Base::CopyFTBitmap(const FT_Bitmap& ftBitmap, SkBitmap* dst) {
+    FT_Pixel_Mode pixel_mode = static_cast<FT_Pixel_Mode>(ftBitmap.pixel_mode);
+    // TODO: mark this as sRGB when the blits will be sRGB.
+    dst->allocPixels(SkImageInfo::Make(ftBitmap.width, ftBitmap.rows,
+                                       SkColorType_for_FTPixelMode(pixel_mode),
+                                       kPremul_SkAlphaType));
+
+    SkMask dstAlias;
+    dstAlias.fImage = reinterpret_cast<uint8_t*>(dst->getPixels());
+    dstAlias.fBounds.set(0, 0, dst->width(), dst->height());
+    dstAlias.fRowBytes = dst->rowBytes();
+    dstAlias.fFormat = SkMaskFormat_for_SkColorType(dst->colorType());
+    copyFTBitmap(ftBitmap, dstAlias);
+}
+
+void SkScalerContext_FreeType_Base::generateScaledBitmapImage(const SkBitmap& unscaledBitmap,
+                                                              int bitmapLeft, int bitmapTop,
+                                                              const SkGlyph& glyph,
+                                                              const SkMatrix& bitmapTransform) {
+    SkMask::Format maskFormat = static_cast<SkMask::Format>(glyph.fMaskFormat);
+
+    // Wrap the glyph's mask in a bitmap, unless the glyph's mask is BW or LCD.
+    // BW requires an A8 target for resizing, which can then be down sampled.
+    // LCD should use a 4x A8 target, which will then be down sampled.
+    // For simplicity, LCD uses A8 and is replicated.
+    int bitmapRowBytes = 0;
+    if (SkMask::kBW_Format != maskFormat && SkMask::kLCD16_Format != maskFormat) {
+        bitmapRowBytes = glyph.rowBytes();
+    }
+    SkBitmap dstBitmap;
+    // TODO: mark this as sRGB when the blits will be sRGB.
+    dstBitmap.setInfo(SkImageInfo::Make(glyph.fWidth, glyph.fHeight,
+                                        SkColorType_for_SkMaskFormat(maskFormat),
+                                        kPremul_SkAlphaType),
+                      bitmapRowBytes);
+    if (SkMask::kBW_Format == maskFormat || SkMask::kLCD16_Format == maskFormat) {
+        dstBitmap.allocPixels();
+    } else {
+        dstBitmap.setPixels(glyph.fImage);
+    }
+
+    // Scale unscaledBitmap into dstBitmap.
+    SkCanvas canvas(dstBitmap);
+#ifdef SK_SHOW_TEXT_BLIT_COVERAGE
+    canvas.clear(0x33FF0000);
+#else
+    canvas.clear(SK_ColorTRANSPARENT);
+#endif
+    canvas.translate(-glyph.fLeft, -glyph.fTop);
+    canvas.concat(bitmapTransform);
+    canvas.translate(bitmapLeft, -bitmapTop);
+
+    SkPaint paint;
+    // Using kMedium FilterQuality will cause mipmaps to be generated. Use
+    // kLow when the results will be roughly the same in order to avoid
+    // the mipmap generation cost.
+    // See skbug.com/6967
+    if (bitmapTransform.getMinScale() < 0.5) {
+        paint.setFilterQuality(kMedium_SkFilterQuality);
+    } else {
+        paint.setFilterQuality(kLow_SkFilterQuality);
+    }
+    canvas.drawBitmap(unscaledBitmap, 0, 0, &paint);
+
+    // If the destination is BW or LCD, convert from A8.
+    if (SkMask::kBW_Format == maskFormat) {
+        // Copy the A8 dstBitmap into the A1 glyph.fImage.
+        SkMask dstMask = glyph.mask();
+        packA8ToA1(dstMask, dstBitmap.getAddr8(0, 0), dstBitmap.rowBytes());
+    } else if (SkMask::kLCD16_Format == maskFormat) {
+        // Copy the A8 dstBitmap into the LCD16 glyph.fImage.
+        uint8_t* src = dstBitmap.getAddr8(0, 0);
+        uint16_t* dst = reinterpret_cast<uint16_t*>(glyph.fImage);
+        for (int y = dstBitmap.height(); y --> 0;) {
+            for (int x = 0; x < dstBitmap.width(); ++x) {
+                dst[x] = grayToRGB16(src[x]);
+            }
+            dst = (uint16_t*)((char*)dst + glyph.rowBytes());
+            src += dstBitmap.rowBytes();
+        }
+    }
+}
+
 void SkScalerContext_FreeType_Base::generateGlyphImage(
     FT_Face face,
     const SkGlyph& glyph,
@@ -562,8 +645,10 @@ void SkScalerContext_FreeType_Base::generateGlyphImage(
         } break;
 
         case FT_GLYPH_FORMAT_BITMAP: {
-            FT_Pixel_Mode pixel_mode = static_cast<FT_Pixel_Mode>(face->glyph->bitmap.pixel_mode);
-            SkMask::Format maskFormat = static_cast<SkMask::Format>(glyph.fMaskFormat);
+            SkDEBUGCODE(FT_Pixel_Mode pixel_mode =
+                                static_cast<FT_Pixel_Mode>(face->glyph->bitmap.pixel_mode));
+            SkDEBUGCODE(SkMask::Format maskFormat =
+                                static_cast<SkMask::Format>(glyph.fMaskFormat));
 
             // Assume that the other formats do not exist.
             SkASSERT(FT_PIXEL_MODE_MONO == pixel_mode ||
@@ -584,83 +669,10 @@ void SkScalerContext_FreeType_Base::generateGlyphImage(
             }
 
             // Otherwise, scale the bitmap.
-
-            // Copy the FT_Bitmap into an SkBitmap (either A8 or ARGB)
             SkBitmap unscaledBitmap;
-            // TODO: mark this as sRGB when the blits will be sRGB.
-            unscaledBitmap.allocPixels(SkImageInfo::Make(face->glyph->bitmap.width,
-                                                         face->glyph->bitmap.rows,
-                                                         SkColorType_for_FTPixelMode(pixel_mode),
-                                                         kPremul_SkAlphaType));
-
-            SkMask unscaledBitmapAlias;
-            unscaledBitmapAlias.fImage = reinterpret_cast<uint8_t*>(unscaledBitmap.getPixels());
-            unscaledBitmapAlias.fBounds.set(0, 0, unscaledBitmap.width(), unscaledBitmap.height());
-            unscaledBitmapAlias.fRowBytes = unscaledBitmap.rowBytes();
-            unscaledBitmapAlias.fFormat = SkMaskFormat_for_SkColorType(unscaledBitmap.colorType());
-            copyFTBitmap(face->glyph->bitmap, unscaledBitmapAlias);
-
-            // Wrap the glyph's mask in a bitmap, unless the glyph's mask is BW or LCD.
-            // BW requires an A8 target for resizing, which can then be down sampled.
-            // LCD should use a 4x A8 target, which will then be down sampled.
-            // For simplicity, LCD uses A8 and is replicated.
-            int bitmapRowBytes = 0;
-            if (SkMask::kBW_Format != maskFormat && SkMask::kLCD16_Format != maskFormat) {
-                bitmapRowBytes = glyph.rowBytes();
-            }
-            SkBitmap dstBitmap;
-            // TODO: mark this as sRGB when the blits will be sRGB.
-            dstBitmap.setInfo(SkImageInfo::Make(glyph.fWidth, glyph.fHeight,
-                                                SkColorType_for_SkMaskFormat(maskFormat),
-                                                kPremul_SkAlphaType),
-                              bitmapRowBytes);
-            if (SkMask::kBW_Format == maskFormat || SkMask::kLCD16_Format == maskFormat) {
-                dstBitmap.allocPixels();
-            } else {
-                dstBitmap.setPixels(glyph.fImage);
-            }
-
-            // Scale unscaledBitmap into dstBitmap.
-            SkCanvas canvas(dstBitmap);
-#ifdef SK_SHOW_TEXT_BLIT_COVERAGE
-            canvas.clear(0x33FF0000);
-#else
-            canvas.clear(SK_ColorTRANSPARENT);
-#endif
-            canvas.translate(-glyph.fLeft, -glyph.fTop);
-            canvas.concat(bitmapTransform);
-            canvas.translate(face->glyph->bitmap_left, -face->glyph->bitmap_top);
-
-            SkPaint paint;
-            // Using kMedium FilterQuality will cause mipmaps to be generated. Use
-            // kLow when the results will be roughly the same in order to avoid
-            // the mipmap generation cost.
-            // See skbug.com/6967
-            if (bitmapTransform.getMinScale() < 0.5) {
-                paint.setFilterQuality(kMedium_SkFilterQuality);
-            } else {
-                paint.setFilterQuality(kLow_SkFilterQuality);
-            }
-            canvas.drawBitmap(unscaledBitmap, 0, 0, &paint);
-
-            // If the destination is BW or LCD, convert from A8.
-            if (SkMask::kBW_Format == maskFormat) {
-                // Copy the A8 dstBitmap into the A1 glyph.fImage.
-                SkMask dstMask = glyph.mask();
-                packA8ToA1(dstMask, dstBitmap.getAddr8(0, 0), dstBitmap.rowBytes());
-            } else if (SkMask::kLCD16_Format == maskFormat) {
-                // Copy the A8 dstBitmap into the LCD16 glyph.fImage.
-                uint8_t* src = dstBitmap.getAddr8(0, 0);
-                uint16_t* dst = reinterpret_cast<uint16_t*>(glyph.fImage);
-                for (int y = dstBitmap.height(); y --> 0;) {
-                    for (int x = 0; x < dstBitmap.width(); ++x) {
-                        dst[x] = grayToRGB16(src[x]);
-                    }
-                    dst = (uint16_t*)((char*)dst + glyph.rowBytes());
-                    src += dstBitmap.rowBytes();
-                }
-            }
-
+            CopyFTBitmap(face->glyph->bitmap, &unscaledBitmap);
+            this->generateScaledBitmapImage(unscaledBitmap, face->glyph->bitmap_left,
+                                            face->glyph->bitmap_top, glyph, bitmapTransform);
         } break;
 
         default:
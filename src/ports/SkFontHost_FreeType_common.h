@@ -22,6 +22,7 @@
 typedef struct FT_LibraryRec_* FT_Library;
 typedef struct FT_FaceRec_* FT_Face;
 typedef struct FT_StreamRec_* FT_Stream;
+typedef struct FT_Bitmap_ FT_Bitmap;
 typedef signed long FT_Pos;
 
 
@@ -47,6 +48,13 @@ protected:
     {}
 
     void generateGlyphImage(FT_Face face, const SkGlyph& glyph, const SkMatrix& bitmapTransform);
+    /** Copies a glyph's FT_Bitmap, unscaled, into an A8 or N32 bitmap. */
+    static void CopyFTBitmap(const FT_Bitmap&, SkBitmap* dst);
+    /** Draws the unscaled bitmap of a glyph (from CopyFTBitmap, placed by the glyph slot's
+     *  bitmap_left and bitmap_top) into the glyph's image, transformed by bitmapTransform.
+     */
+    void generateScaledBitmapImage(const SkBitmap& unscaledBitmap, int bitmapLeft, int bitmapTop,
+                                   const SkGlyph& glyph, const SkMatrix& bitmapTransform);
     bool generateGlyphPath(FT_Face face, SkPath* path);
     bool generateFacePath(FT_Face face, SkGlyphID glyphID, SkPath* path);
 private:
@@ -88,6 +96,25 @@ public:
 
     /** Fetch units/EM from "head" table if needed (ie for bitmap fonts) */
     static int GetUnitsPerEm(FT_Face face);
+
+    /** How often opening a typeface's FreeType face found an idle face made from the same font
+     *  data (such as by another variation instance) to reuse, and how often it had to open one.
+     */
+    struct FacePoolStats {
+        int fHits;
+        int fMisses;
+        int fIdleFaces;
+    };
+    static FacePoolStats GetFacePoolStats();
+
+    /** Returns a stream of the font file at path (or of file, if it isn't null), mapped read-only.
+     *  While any stream from here is alive, every later one for the same path shares its
+     *  mapping, so the typefaces and collection indices of one file share its memory (and can
+     *  reuse each other's idle FreeType faces). If the file can't be mapped, this opens an
+     *  unshared stream of path instead, or fails if file was given.
+     */
+    static std::unique_ptr<SkStreamAsset> MakeSharedFileStream(const char path[],
+                                                               FILE* file = nullptr);
 protected:
     SkTypeface_FreeType(const SkFontStyle& style, bool isFixedPitch)
         : INHERITED(style, isFixedPitch)
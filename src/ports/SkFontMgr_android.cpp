@@ -76,11 +76,7 @@ public:
     }
 
     std::unique_ptr<SkStreamAsset> makeStream() const {
-        if (fFile) {
-            sk_sp<SkData> data(SkData::MakeFromFILE(fFile));
-            return data ? skstd::make_unique<SkMemoryStream>(std::move(data)) : nullptr;
-        }
-        return SkStream::MakeFromFile(fPathName.c_str());
+        return SkTypeface_FreeType::MakeSharedFileStream(fPathName.c_str(), fFile);
     }
 
     virtual void onGetFontDescriptor(SkFontDescriptor* desc, bool* serialize) const override {
@@ -451,7 +447,7 @@ protected:
     }
 
     sk_sp<SkTypeface> onMakeFromFile(const char path[], int ttcIndex) const override {
-        std::unique_ptr<SkStreamAsset> stream = SkStream::MakeFromFile(path);
+        std::unique_ptr<SkStreamAsset> stream = SkTypeface_FreeType::MakeSharedFileStream(path);
         return stream.get() ? this->makeFromStream(std::move(stream), ttcIndex) : nullptr;
     }
 
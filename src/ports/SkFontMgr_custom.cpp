@@ -94,7 +94,7 @@ SkTypeface_File::SkTypeface_File(const SkFontStyle& style, bool isFixedPitch, bo
 
 std::unique_ptr<SkStreamAsset> SkTypeface_File::onOpenStream(int* ttcIndex) const {
     *ttcIndex = this->getIndex();
-    return SkStream::MakeFromFile(fPath.c_str());
+    return SkTypeface_FreeType::MakeSharedFileStream(fPath.c_str());
 }
 
 sk_sp<SkTypeface> SkTypeface_File::onMakeClone(const SkFontArguments& args) const {
@@ -269,7 +269,7 @@ sk_sp<SkTypeface> SkFontMgr_Custom::onMakeFromFontData(std::unique_ptr<SkFontDat
 }
 
 sk_sp<SkTypeface> SkFontMgr_Custom::onMakeFromFile(const char path[], int ttcIndex) const {
-    std::unique_ptr<SkStreamAsset> stream = SkStream::MakeFromFile(path);
+    std::unique_ptr<SkStreamAsset> stream = SkTypeface_FreeType::MakeSharedFileStream(path);
     return stream ? this->makeFromStream(std::move(stream), ttcIndex) : nullptr;
 }
 
@@ -16,10 +16,12 @@
 #include "include/core/SkTypes.h"
 #include "include/private/SkFixed.h"
 #include "include/private/SkMutex.h"
+#include "include/private/SkOnce.h"
 #include "include/private/SkTDArray.h"
 #include "include/private/SkTemplates.h"
 #include "src/core/SkAdvancedTypefaceMetrics.h"
 #include "src/core/SkFontDescriptor.h"
+#include "src/core/SkLRUCache.h"
 #include "src/core/SkMakeUnique.h"
 #include "src/core/SkOSFile.h"
 #include "src/core/SkTypefaceCache.h"
@@ -575,7 +577,9 @@ private:
 class SkFontMgr_fontconfig : public SkFontMgr {
     mutable SkAutoFcConfig fFC;  // Only mutable to avoid const cast when passed to FontConfig API.
     const SkString fSysroot;
-    const sk_sp<SkDataTable> fFamilyNames;
+    // Listing the families walks every font, and is only needed to enumerate them.
+    mutable SkOnce fFamilyNamesOnce;
+    mutable sk_sp<SkDataTable> fFamilyNames;
     const SkTypeface_FreeType::Scanner fScanner;
 
     class StyleSet : public SkFontStyleSet {
@@ -713,12 +717,39 @@ class SkFontMgr_fontconfig : public SkFontMgr {
         return face;
     }
 
+    // Fallback runs FcFontMatch over every font, and text asks for the same characters (and
+    // misses the same ones) over and over. The config's fonts don't change, so the results
+    // (including no match) are kept by character, family, style and languages.
+    static constexpr int kFallbackCacheCount = 1024;
+    mutable SkMutex fFallbackCacheMutex;
+    mutable SkLRUCache<SkString, sk_sp<SkTypeface>> fFallbackCache;
+
+    static SkString FallbackKey(const char familyName[], const SkFontStyle& style,
+                                const char* bcp47[], int bcp47Count, SkUnichar character) {
+        SkString key;
+        key.printf("%d %d %d %d", character, style.weight(), style.width(), style.slant());
+        // Length prefixed, so the strings can't run into each other.
+        auto append = [&key](const char* str) {
+            key.appendf(" %zu:", strlen(str));
+            key.append(str);
+        };
+        if (familyName) {
+            append(familyName);
+        } else {
+            key.append(" -");
+        }
+        for (int i = 0; i < bcp47Count; ++i) {
+            append(bcp47[i]);
+        }
+        return key;
+    }
+
 public:
     /** Takes control of the reference to 'config'. */
     explicit SkFontMgr_fontconfig(FcConfig* config)
         : fFC(config ? config : FcInitLoadConfigAndFonts())
         , fSysroot(reinterpret_cast<const char*>(FcConfigGetSysRoot(fFC)))
-        , fFamilyNames(GetFamilyNames(fFC)) { }
+        , fFallbackCache(kFallbackCacheCount) { }
 
     ~SkFontMgr_fontconfig() override {
         // Hold the lock while unrefing the config.
@@ -727,16 +758,21 @@ public:
     }
 
 protected:
+    const SkDataTable& familyNames() const {
+        fFamilyNamesOnce([this] { fFamilyNames = GetFamilyNames(fFC); });
+        return *fFamilyNames;
+    }
+
     int onCountFamilies() const override {
-        return fFamilyNames->count();
+        return this->familyNames().count();
     }
 
     void onGetFamilyName(int index, SkString* familyName) const override {
-        familyName->set(fFamilyNames->atStr(index));
+        familyName->set(this->familyNames().atStr(index));
     }
 
     SkFontStyleSet* onCreateStyleSet(int index) const override {
-        return this->onMatchFamily(fFamilyNames->atStr(index));
+        return this->onMatchFamily(this->familyNames().atStr(index));
     }
 
     /** True if any string object value in the font is the same
@@ -910,6 +946,28 @@ protected:
                                             int bcp47Count,
                                             SkUnichar character) const override
     {
+        SkString key = FallbackKey(familyName, style, bcp47, bcp47Count, character);
+        {
+            SkAutoMutexExclusive ama(fFallbackCacheMutex);
+            if (sk_sp<SkTypeface>* cached = fFallbackCache.find(key)) {
+                return SkSafeRef(cached->get());
+            }
+        }
+
+        sk_sp<SkTypeface> typeface =
+                this->matchCharacter(familyName, style, bcp47, bcp47Count, character);
+
+        // Not under the FCLocker; an evicted typeface may need to lock.
+        SkAutoMutexExclusive ama(fFallbackCacheMutex);
+        if (!fFallbackCache.find(key)) {
+            fFallbackCache.insert(key, typeface);
+        }
+        return typeface.release();
+    }
+
+    sk_sp<SkTypeface> matchCharacter(const char familyName[], const SkFontStyle& style,
+                                     const char* bcp47[], int bcp47Count,
+                                     SkUnichar character) const {
         FCLocker lock;
 
         SkAutoFcPattern pattern;
@@ -943,7 +1001,7 @@ protected:
             return nullptr;
         }
 
-        return createTypefaceFromFcPattern(font).release();
+        return createTypefaceFromFcPattern(font);
     }
 
     SkTypeface* onMatchFaceStyle(const SkTypeface* typeface,
@@ -18,6 +18,7 @@
     #include "include/core/SkPathEffect.h"
     #include "include/effects/Sk1DPathEffect.h"
     #include "include/effects/Sk2DPathEffect.h"
+    #include "include/effects/SkColorCubeFilter.h"
     #include "include/effects/SkCornerPathEffect.h"
     #include "include/effects/SkDiscretePathEffect.h"
     #include "include/effects/SkGradientShader.h"
@@ -90,6 +91,7 @@
         SkShaderBase::RegisterFlattenables();
 
         // Color filters.
+        SkColorCubeFilter::RegisterFlattenables();
         SkColorFilter_Matrix::RegisterFlattenables();
         SK_REGISTER_FLATTENABLE(SkLumaColorFilter);
         SkColorFilter::RegisterFlattenables();
@@ -6,7 +6,9 @@
  */
 
 #include "include/private/SkMalloc.h"
+#include "src/core/SkMemoryTags.h"
 
+#include <cstdint>
 #include <cstdlib>
 
 #define SK_DEBUGFAILF(fmt, ...) \
@@ -30,6 +32,44 @@ static inline void* throw_on_failure(size_t size, void* p) {
     return p;
 }
 
+#if defined(SK_TRACK_MEMORY_TAGS)
+// Each block starts with a header recording the size and tag it was charged, so sk_free() can
+// credit them back. The header is padded to keep the rest of the block as aligned as malloc's.
+namespace {
+struct TagHeader {
+    size_t      fSize;
+    SkMemoryTag fTag;
+};
+}
+static constexpr size_t kTagHeaderSize = 16;
+static_assert(sizeof(TagHeader) <= kTagHeaderSize, "");
+
+static inline size_t tagged_size(size_t size) {
+    if (size > SIZE_MAX - kTagHeaderSize) {
+        sk_out_of_memory(size);
+    }
+    return size + kTagHeaderSize;
+}
+
+static inline void* tag_block(void* block, size_t size) {
+    if (block == nullptr) {
+        return nullptr;
+    }
+    TagHeader* header = static_cast<TagHeader*>(block);
+    header->fSize = size;
+    header->fTag = SkMemoryTags::CurrentTag();
+    SkMemoryTags::DidAllocate(header->fTag, size);
+    return static_cast<char*>(block) + kTagHeaderSize;
+}
+
+static inline void* untag_block(void* p) {
+    void* block = static_cast<char*>(p) - kTagHeaderSize;
+    const TagHeader* header = static_cast<const TagHeader*>(block);
+    SkMemoryTags::DidFree(header->fTag, header->fSize);
+    return block;
+}
+#endif
+
 void sk_abort_no_print() {
 #if defined(SK_BUILD_FOR_WIN) && defined(SK_IS_BOT)
     // do not display a system dialog before aborting the process
@@ -54,22 +94,39 @@ void sk_out_of_memory(void) {
 }
 
 void* sk_realloc_throw(void* addr, size_t size) {
+#if defined(SK_TRACK_MEMORY_TAGS)
+    // A reallocated block is charged to the tag current at the time.
+    void* block = addr ? untag_block(addr) : nullptr;
+    return throw_on_failure(size, tag_block(realloc(block, tagged_size(size)), size));
+#else
     return throw_on_failure(size, realloc(addr, size));
+#endif
 }
 
 void sk_free(void* p) {
     if (p) {
+#if defined(SK_TRACK_MEMORY_TAGS)
+        p = untag_block(p);
+#endif
         free(p);
     }
 }
 
 void* sk_malloc_flags(size_t size, unsigned flags) {
     void* p;
+#if defined(SK_TRACK_MEMORY_TAGS)
+    if (flags & SK_MALLOC_ZERO_INITIALIZE) {
+        p = tag_block(calloc(tagged_size(size), 1), size);
+    } else {
+        p = tag_block(malloc(tagged_size(size)), size);
+    }
+#else
     if (flags & SK_MALLOC_ZERO_INITIALIZE) {
         p = calloc(size, 1);
     } else {
         p = malloc(size);
     }
+#endif
     if (flags & SK_MALLOC_THROW) {
         return throw_on_failure(size, p);
     } else {
@@ -74,6 +74,20 @@ void sk_fmunmap(const void* addr, size_t length) {
     munmap(const_cast<void*>(addr), length);
 }
 
+void sk_madvise_sequential(const void* addr, size_t length) {
+    if (!addr || !length) {
+        return;
+    }
+    // madvise() wants a page aligned address.
+    static const uintptr_t kPageSize = sysconf(_SC_PAGESIZE);
+    const uintptr_t start = reinterpret_cast<uintptr_t>(addr) & ~(kPageSize - 1);
+    const size_t alignedLength = length + (reinterpret_cast<uintptr_t>(addr) - start);
+    void* alignedAddr = reinterpret_cast<void*>(start);
+    // These are only hints, so failure (e.g. for memory that isn't mapped from a file) is fine.
+    (void)madvise(alignedAddr, alignedLength, MADV_SEQUENTIAL);
+    (void)madvise(alignedAddr, alignedLength, MADV_WILLNEED);
+}
+
 void* sk_fdmmap(int fd, size_t* size) {
     struct stat status;
     if (0 != fstat(fd, &status)) {
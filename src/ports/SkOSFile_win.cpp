@@ -83,6 +83,10 @@ void sk_fmunmap(const void* addr, size_t) {
     UnmapViewOfFile(addr);
 }
 
+void sk_madvise_sequential(const void*, size_t) {
+    // PrefetchVirtualMemory() needs Windows 8, so leave read ahead to the OS.
+}
+
 void* sk_fdmmap(int fileno, size_t* length) {
     HANDLE file = (HANDLE)_get_osfhandle(fileno);
     if (INVALID_HANDLE_VALUE == file) {
@@ -441,14 +441,35 @@ bool SkImageShader::onAppendStages(const SkStageRec& rec) const {
         return true;
     };
 
-    // We've got a fast path for 8888 bilinear clamp/clamp sampling.
+    // We've got fast paths for 8888 bilinear and bicubic clamp/clamp sampling.
     auto ct = info.colorType();
     if (true
         && (ct == kRGBA_8888_SkColorType || ct == kBGRA_8888_SkColorType)
-        && quality == kLow_SkFilterQuality
+        && (quality == kLow_SkFilterQuality || quality == kHigh_SkFilterQuality)
         && fTileModeX == SkTileMode::kClamp && fTileModeY == SkTileMode::kClamp) {
 
-        p->append(SkRasterPipeline::bilerp_clamp_8888, gather);
+        p->append(quality == kLow_SkFilterQuality ? SkRasterPipeline::bilerp_clamp_8888
+                                                  : SkRasterPipeline::bicubic_clamp_8888,
+                  gather);
+        if (ct == kBGRA_8888_SkColorType) {
+            p->append(SkRasterPipeline::swap_rb);
+        }
+        return append_misc();
+    }
+
+    // ... and for 8888 bilinear sampling with any mix of clamp, repeat, and mirror tiling.
+    if (true
+        && (ct == kRGBA_8888_SkColorType || ct == kBGRA_8888_SkColorType)
+        && quality == kLow_SkFilterQuality
+        && fTileModeX != SkTileMode::kDecal && fTileModeY != SkTileMode::kDecal) {
+
+        auto tiled = alloc->make<SkRasterPipeline_TiledGatherCtx>();
+        tiled->gather = *gather;
+        tiled->limitX = *limit_x;
+        tiled->limitY = *limit_y;
+        tiled->modeX  = fTileModeX;
+        tiled->modeY  = fTileModeY;
+        p->append(SkRasterPipeline::bilerp_tiled_8888, tiled);
         if (ct == kBGRA_8888_SkColorType) {
             p->append(SkRasterPipeline::swap_rb);
         }
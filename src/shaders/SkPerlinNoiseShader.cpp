@@ -11,6 +11,7 @@
 #include "include/core/SkShader.h"
 #include "include/core/SkString.h"
 #include "include/core/SkUnPreMultiply.h"
+#include "include/private/SkVx.h"
 #include "src/core/SkArenaAlloc.h"
 #include "src/core/SkMakeUnique.h"
 #include "src/core/SkReadBuffer.h"
@@ -19,6 +20,7 @@
 #if SK_SUPPORT_GPU
 #include "include/private/GrRecordingContext.h"
 #include "src/gpu/GrCoordTransform.h"
+#include "src/gpu/GrProxyProvider.h"
 #include "src/gpu/GrRecordingContextPriv.h"
 #include "src/gpu/SkGr.h"
 #include "src/gpu/effects/generated/GrConstColorProcessor.h"
@@ -33,6 +35,9 @@ static const int kBlockMask = kBlockSize - 1;
 static const int kPerlinNoise = 4096;
 static const int kRandMaximum = SK_MaxS32; // 2**31 - 1
 
+using float8 = skvx::Vec<8, float>;
+using int8 = skvx::Vec<8, int32_t>;
+
 static uint8_t improved_noise_permutations[] = {
     151, 160, 137,  91,  90,  15, 131,  13, 201,  95,  96,  53, 194, 233,   7, 225, 140,  36, 103,
      30,  69, 142,   8,  99,  37, 240,  21,  10,  23, 190,   6, 148, 247, 120, 234,  75,   0,  26,
@@ -200,15 +205,7 @@ public:
         {
             static const SkScalar gInvBlockSizef = SkScalarInvert(SkIntToScalar(kBlockSize));
 
-            // According to the SVG spec, we must truncate (not round) the seed value.
-            fSeed = SkScalarTruncToInt(seed);
-            // The seed value clamp to the range [1, kRandMaximum - 1].
-            if (fSeed <= 0) {
-                fSeed = -(fSeed % (kRandMaximum - 1)) + 1;
-            }
-            if (fSeed > kRandMaximum - 1) {
-                fSeed = kRandMaximum - 1;
-            }
+            fSeed = TruncateSeed(seed);
             for (int channel = 0; channel < 4; ++channel) {
                 for (int i = 0; i < kBlockSize; ++i) {
                     fLatticeSelector[i] = i;
@@ -304,6 +301,20 @@ public:
 
     public:
 
+        // The noise only depends on this much of the seed.
+        static int TruncateSeed(SkScalar seed) {
+            // According to the SVG spec, we must truncate (not round) the seed value.
+            int truncated = SkScalarTruncToInt(seed);
+            // The seed value clamp to the range [1, kRandMaximum - 1].
+            if (truncated <= 0) {
+                truncated = -(truncated % (kRandMaximum - 1)) + 1;
+            }
+            if (truncated > kRandMaximum - 1) {
+                truncated = kRandMaximum - 1;
+            }
+            return truncated;
+        }
+
 #if SK_SUPPORT_GPU
         const sk_sp<SkImage> getPermutationsImage() const { return fPermutationsImage; }
 
@@ -358,6 +369,15 @@ public:
         SkScalar noise2D(int channel,
                          const StitchData& stitchData, const SkPoint& noiseVector) const;
 
+        // The same as shade(), calculateTurbulenceValueForPoint() and noise2D(), for the eight
+        // pixels in a row starting at point, and for all four channels at once since they share
+        // their lattice points. Only for fractal noise and turbulence.
+        void shade8(const SkPoint& point, SkPMColor result[8]) const;
+        void calculateTurbulenceValueForPoints(const float8& x, SkScalar y,
+                                               float8 turbulenceFunctionResult[4]) const;
+        void noise2D(const StitchData& stitchData, const float8& noiseX, SkScalar noiseY,
+                     float8 noise[4]) const;
+
         SkMatrix     fMatrix;
         PaintingData fPaintingData;
 
@@ -567,6 +587,140 @@ SkScalar SkPerlinNoiseShaderImpl::PerlinNoiseShaderContext::calculateTurbulenceV
     return SkScalarPin(turbulenceFunctionResult, 0, SK_Scalar1);
 }
 
+// Like SkScalarFloorToInt(), saturating the same way so that out of range lanes take the same
+// lattice points they do one at a time.
+static inline int8 floor_to_int(const float8& x) {
+    float8 floored = skvx::floor(x);
+    floored = skvx::if_then_else(floored < SK_MaxS32FitsInFloat, floored,
+                                 float8(SK_MaxS32FitsInFloat));
+    floored = skvx::if_then_else(SK_MinS32FitsInFloat < floored, floored,
+                                 float8(SK_MinS32FitsInFloat));
+    return skvx::cast<int32_t>(floored);
+}
+
+static inline float8 interp(const float8& a, const float8& b, const float8& t) {
+    return a + (b - a) * t;
+}
+
+void SkPerlinNoiseShaderImpl::PerlinNoiseShaderContext::noise2D(
+        const StitchData& stitchData, const float8& noiseX, SkScalar noiseY,
+        float8 noise[4]) const {
+    const auto& perlinNoiseShader = static_cast<const SkPerlinNoiseShaderImpl&>(fShader);
+    // All eight points are in the same row, so only x varies from lane to lane.
+    const float8 positionX = noiseX + kPerlinNoise;
+    int8 integerX = floor_to_int(positionX);
+    const float8 fractionX = positionX - skvx::cast<float>(integerX);
+    int8 nextIntegerX = integerX + 1;
+
+    const SkScalar positionY = noiseY + kPerlinNoise;
+    int integerY = SkScalarFloorToInt(positionY);
+    const SkScalar fractionY = positionY - SkIntToScalar(integerY);
+    int nextIntegerY = integerY + 1;
+
+    // If stitching, adjust lattice points accordingly.
+    if (perlinNoiseShader.fStitchTiles) {
+        integerX = skvx::if_then_else(integerX >= stitchData.fWrapX,
+                                      integerX - stitchData.fWidth, integerX);
+        nextIntegerX = skvx::if_then_else(nextIntegerX >= stitchData.fWrapX,
+                                          nextIntegerX - stitchData.fWidth, nextIntegerX);
+        integerY = checkNoise(integerY, stitchData.fWrapY, stitchData.fHeight);
+        nextIntegerY = checkNoise(nextIntegerY, stitchData.fWrapY, stitchData.fHeight);
+    }
+    integerX &= kBlockMask;
+    nextIntegerX &= kBlockMask;
+    integerY &= kBlockMask;
+    nextIntegerY &= kBlockMask;
+
+    const float8 sx = fractionX * fractionX * (3 - 2 * fractionX);
+    const SkScalar sy = smoothCurve(fractionY);
+    // Points with pathological inputs are zero.
+    if (sy < 0 || sy > 1) {
+        for (int channel = 0; channel < 4; ++channel) {
+            noise[channel] = 0;
+        }
+        return;
+    }
+    const auto pathological = (sx < 0) | (sx > 1);
+
+    // The lattice points are the same for every channel. The table lookups are done a lane at
+    // a time.
+    int b00[8], b10[8], b01[8], b11[8];
+    for (int k = 0; k < 8; ++k) {
+        int i = fPaintingData.fLatticeSelector[integerX[k]];
+        int j = fPaintingData.fLatticeSelector[nextIntegerX[k]];
+        b00[k] = (i + integerY) & kBlockMask;
+        b10[k] = (j + integerY) & kBlockMask;
+        b01[k] = (i + nextIntegerY) & kBlockMask;
+        b11[k] = (j + nextIntegerY) & kBlockMask;
+    }
+
+    for (int channel = 0; channel < 4; ++channel) {
+        // This is noise2D() above, from the SVG spec.
+        const SkPoint* gradient = fPaintingData.fGradient[channel];
+        auto dot = [gradient](const int b[8], const float8& x, SkScalar y) {
+            float gradientX[8], gradientY[8];
+            for (int k = 0; k < 8; ++k) {
+                gradientX[k] = gradient[b[k]].fX;
+                gradientY[k] = gradient[b[k]].fY;
+            }
+            return float8::Load(gradientX) * x + float8::Load(gradientY) * y;
+        };
+        const float8 a = interp(dot(b00, fractionX, fractionY),
+                                dot(b10, fractionX - 1, fractionY), sx);
+        const float8 b = interp(dot(b01, fractionX, fractionY - 1),
+                                dot(b11, fractionX - 1, fractionY - 1), sx);
+        noise[channel] = skvx::if_then_else(pathological, float8(0), interp(a, b, sy));
+    }
+}
+
+void SkPerlinNoiseShaderImpl::PerlinNoiseShaderContext::calculateTurbulenceValueForPoints(
+        const float8& x, SkScalar y, float8 turbulenceFunctionResult[4]) const {
+    const auto& perlinNoiseShader = static_cast<const SkPerlinNoiseShaderImpl&>(fShader);
+    StitchData stitchData;
+    if (perlinNoiseShader.fStitchTiles) {
+        // Set up TurbulenceInitial stitch values.
+        stitchData = fPaintingData.fStitchDataInit;
+    }
+    for (int channel = 0; channel < 4; ++channel) {
+        turbulenceFunctionResult[channel] = 0;
+    }
+    float8 noiseX = x * fPaintingData.fBaseFrequency.fX;
+    SkScalar noiseY = y * fPaintingData.fBaseFrequency.fY;
+    SkScalar ratio = SK_Scalar1;
+    for (int octave = 0; octave < perlinNoiseShader.fNumOctaves; ++octave) {
+        float8 noise[4];
+        this->noise2D(stitchData, noiseX, noiseY, noise);
+        for (int channel = 0; channel < 4; ++channel) {
+            float8 numer = (perlinNoiseShader.fType == kFractalNoise_Type)
+                                   ? noise[channel] : skvx::abs(noise[channel]);
+            turbulenceFunctionResult[channel] += numer / ratio;
+        }
+        noiseX *= 2;
+        noiseY *= 2;
+        ratio *= 2;
+        if (perlinNoiseShader.fStitchTiles) {
+            // Update stitch values
+            stitchData = StitchData(SkIntToScalar(stitchData.fWidth)  * 2,
+                                    SkIntToScalar(stitchData.fHeight) * 2);
+        }
+    }
+
+    for (int channel = 0; channel < 4; ++channel) {
+        float8& result = turbulenceFunctionResult[channel];
+        if (perlinNoiseShader.fType == kFractalNoise_Type) {
+            result = (result + 1) * SK_ScalarHalf;
+        }
+
+        if (channel == 3) { // Scale alpha by paint value
+            result *= SkIntToScalar(getPaintAlpha()) / 255;
+        }
+
+        // Clamp result, sending NaN to 1 as SkScalarPin() does.
+        result = skvx::if_then_else(result < SK_Scalar1, result, float8(SK_Scalar1));
+        result = skvx::if_then_else(0 < result, result, float8(0));
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // Improved Perlin Noise based on Java implementation found at http://mrl.nyu.edu/~perlin/noise/
 static SkScalar fade(SkScalar t) {
@@ -651,6 +805,24 @@ SkPMColor SkPerlinNoiseShaderImpl::PerlinNoiseShaderContext::shade(
     return SkPreMultiplyARGB(rgba[3], rgba[0], rgba[1], rgba[2]);
 }
 
+void SkPerlinNoiseShaderImpl::PerlinNoiseShaderContext::shade8(
+        const SkPoint& point, SkPMColor result[8]) const {
+    // fMatrix is only a translate.
+    const float8 x = skvx::floor(float8{ 0, 1, 2, 3, 4, 5, 6, 7 } + point.fX +
+                                 fMatrix.getTranslateX() + 0.5f);
+    const SkScalar y = SkScalarRoundToScalar(point.fY + fMatrix.getTranslateY());
+
+    float8 values[4];
+    this->calculateTurbulenceValueForPoints(x, y, values);
+    int8 rgba[4];
+    for (int channel = 0; channel < 4; ++channel) {
+        rgba[channel] = skvx::cast<int32_t>(skvx::floor(255 * values[channel]));
+    }
+    for (int k = 0; k < 8; ++k) {
+        result[k] = SkPreMultiplyARGB(rgba[3][k], rgba[0][k], rgba[1][k], rgba[2][k]);
+    }
+}
+
 #ifdef SK_ENABLE_LEGACY_SHADERCONTEXT
 SkShaderBase::Context* SkPerlinNoiseShaderImpl::onMakeContext(const ContextRec& rec,
                                                               SkArenaAlloc* alloc) const {
@@ -685,6 +857,24 @@ SkPerlinNoiseShaderImpl::PerlinNoiseShaderContext::PerlinNoiseShaderContext(
 void SkPerlinNoiseShaderImpl::PerlinNoiseShaderContext::shadeSpan(
         int x, int y, SkPMColor result[], int count) {
     SkPoint point = SkPoint::Make(SkIntToScalar(x), SkIntToScalar(y));
+    const auto& perlinNoiseShader = static_cast<const SkPerlinNoiseShaderImpl&>(fShader);
+    if (perlinNoiseShader.fType != kImprovedNoise_Type) {
+        // Eight at a time. A tail of four or more (e.g. a raster pipeline callback four pixels
+        // wide) is still quicker done eight wide, keeping only what we need.
+        while (count >= 4) {
+            if (count >= 8) {
+                this->shade8(point, result);
+            } else {
+                SkPMColor tmp[8];
+                this->shade8(point, tmp);
+                memcpy(result, tmp, count * sizeof(SkPMColor));
+            }
+            int n = SkTMin(count, 8);
+            result += n;
+            count -= n;
+            point.fX += n;
+        }
+    }
     StitchData stitchData;
     for (int i = 0; i < count; ++i) {
         result[i] = shade(point, stitchData);
@@ -1403,6 +1593,44 @@ void GrGLImprovedPerlinNoise::onSetData(const GrGLSLProgramDataManager& pdman,
 }
 
 /////////////////////////////////////////////////////////////////////
+
+namespace {
+
+enum class NoiseTexture : uint32_t {
+    kPermutations,
+    kNoise,
+    kImprovedPermutations,
+    kGradient,
+};
+
+}  // anonymous namespace
+
+// The permutations and noise textures only depend on the truncated seed, and the improved noise
+// textures are the same for every shader. Rather than upload each shader's images, share them
+// through the resource cache.
+static sk_sp<GrTextureProxy> find_or_create_noise_proxy(GrProxyProvider* proxyProvider,
+                                                        NoiseTexture texture, int seed,
+                                                        sk_sp<SkImage> image) {
+    static const GrUniqueKey::Domain kDomain = GrUniqueKey::GenerateDomain();
+    GrUniqueKey key;
+    {
+        GrUniqueKey::Builder builder(&key, kDomain, 2, "Perlin Noise");
+        builder[0] = static_cast<uint32_t>(texture);
+        builder[1] = seed;
+    }
+
+    sk_sp<GrTextureProxy> proxy =
+            proxyProvider->findOrCreateProxyByUniqueKey(key, kTopLeft_GrSurfaceOrigin);
+    if (!proxy) {
+        proxy = proxyProvider->createTextureProxy(std::move(image), kNone_GrSurfaceFlags, 1,
+                                                  SkBudgeted::kYes, SkBackingFit::kExact);
+        if (proxy) {
+            proxyProvider->assignUniqueKeyToProxy(key, proxy.get());
+        }
+    }
+    return proxy;
+}
+
 std::unique_ptr<GrFragmentProcessor> SkPerlinNoiseShaderImpl::asFragmentProcessor(
         const GrFPArgs& args) const {
     SkASSERT(args.fContext);
@@ -1431,13 +1659,13 @@ std::unique_ptr<GrFragmentProcessor> SkPerlinNoiseShaderImpl::asFragmentProcesso
         // go through GrBitmapTextureMaker to handle needed copies.
         const sk_sp<SkImage> permutationsImage = paintingData->getImprovedPermutationsImage();
         SkASSERT(SkIsPow2(permutationsImage->width()) && SkIsPow2(permutationsImage->height()));
-        sk_sp<GrTextureProxy> permutationsTexture(
-                GrMakeCachedImageProxy(proxyProvider, std::move(permutationsImage)));
+        sk_sp<GrTextureProxy> permutationsTexture = find_or_create_noise_proxy(
+                proxyProvider, NoiseTexture::kImprovedPermutations, 0, permutationsImage);
 
         const sk_sp<SkImage> gradientImage = paintingData->getGradientImage();
         SkASSERT(SkIsPow2(gradientImage->width()) && SkIsPow2(gradientImage->height()));
-        sk_sp<GrTextureProxy> gradientTexture(
-                GrMakeCachedImageProxy(proxyProvider, std::move(gradientImage)));
+        sk_sp<GrTextureProxy> gradientTexture = find_or_create_noise_proxy(
+                proxyProvider, NoiseTexture::kGradient, 0, gradientImage);
         return GrImprovedPerlinNoiseEffect::Make(fNumOctaves, fSeed, std::move(paintingData),
                                                  std::move(permutationsTexture),
                                                  std::move(gradientTexture), m);
@@ -1464,13 +1692,14 @@ std::unique_ptr<GrFragmentProcessor> SkPerlinNoiseShaderImpl::asFragmentProcesso
     // through GrBitmapTextureMaker to handle needed copies.
     const sk_sp<SkImage> permutationsImage = paintingData->getPermutationsImage();
     SkASSERT(SkIsPow2(permutationsImage->width()) && SkIsPow2(permutationsImage->height()));
-    sk_sp<GrTextureProxy> permutationsProxy = GrMakeCachedImageProxy(proxyProvider,
-                                                                     std::move(permutationsImage));
+    const int seed = PaintingData::TruncateSeed(fSeed);
+    sk_sp<GrTextureProxy> permutationsProxy = find_or_create_noise_proxy(
+            proxyProvider, NoiseTexture::kPermutations, seed, permutationsImage);
 
     const sk_sp<SkImage> noiseImage = paintingData->getNoiseImage();
     SkASSERT(SkIsPow2(noiseImage->width()) && SkIsPow2(noiseImage->height()));
-    sk_sp<GrTextureProxy> noiseProxy = GrMakeCachedImageProxy(proxyProvider,
-                                                              std::move(noiseImage));
+    sk_sp<GrTextureProxy> noiseProxy = find_or_create_noise_proxy(
+            proxyProvider, NoiseTexture::kNoise, seed, noiseImage);
 
     if (permutationsProxy && noiseProxy) {
         auto inner = GrPerlinNoise2Effect::Make(fType,
@@ -18,6 +18,7 @@
 #include "src/shaders/SkBitmapProcShader.h"
 #include "src/shaders/SkImageShader.h"
 #include <atomic>
+#include <cmath>
 
 #if SK_SUPPORT_GPU
 #include "include/private/GrRecordingContext.h"
@@ -171,10 +172,22 @@ void SkPictureShader::flatten(SkWriteBuffer& buffer) const {
 
 // Returns a cached image shader, which wraps a single picture tile at the given
 // CTM/local matrix.  Also adjusts the local matrix for tile scaling.
+// Rounds a tile scale up to a power of two, so that the scales a zoom animation steps through
+// share one cached tile instead of rasterizing the picture again at each of them. The tile is at
+// most twice as detailed as needed, which filtering hides.
+static SkScalar bucket_tile_scale(SkScalar scale) {
+    if (!(scale > 0) || !SkScalarIsFinite(scale)) {
+        return scale;
+    }
+    int exp;
+    return std::frexp(scale, &exp) == 0.5f ? scale : std::ldexp(1.0f, exp);
+}
+
 sk_sp<SkShader> SkPictureShader::refBitmapShader(const SkMatrix& viewMatrix,
                                                  SkTCopyOnFirstWrite<SkMatrix>* localMatrix,
                                                  SkColorType dstColorType,
                                                  SkColorSpace* dstColorSpace,
+                                                 SkFilterQuality filterQuality,
                                                  const int maxTextureSize) const {
     SkASSERT(fPicture && !fPicture->cullRect().isEmpty());
 
@@ -190,6 +203,11 @@ sk_sp<SkShader> SkPictureShader::refBitmapShader(const SkMatrix& viewMatrix,
         scale.set(SkScalarSqrt(m.getScaleX() * m.getScaleX() + m.getSkewX() * m.getSkewX()),
                   SkScalarSqrt(m.getScaleY() * m.getScaleY() + m.getSkewY() * m.getSkewY()));
     }
+    // Without filtering, a tile drawn at a larger scale than needed would alias.
+    if (filterQuality > kNone_SkFilterQuality) {
+        scale.set(bucket_tile_scale(SkScalarAbs(scale.x())),
+                  bucket_tile_scale(SkScalarAbs(scale.y())));
+    }
     SkSize scaledSize = SkSize::Make(SkScalarAbs(scale.x() * fTile.width()),
                                      SkScalarAbs(scale.y() * fTile.height()));
 
@@ -259,7 +277,8 @@ bool SkPictureShader::onAppendStages(const SkStageRec& rec) const {
 
     // Keep bitmapShader alive by using alloc instead of stack memory
     auto& bitmapShader = *rec.fAlloc->make<sk_sp<SkShader>>();
-    bitmapShader = this->refBitmapShader(rec.fCTM, &lm, rec.fDstColorType, rec.fDstCS);
+    bitmapShader = this->refBitmapShader(rec.fCTM, &lm, rec.fDstColorType, rec.fDstCS,
+                                          rec.fPaint.getFilterQuality());
 
     if (!bitmapShader) {
         return false;
@@ -278,7 +297,8 @@ SkShaderBase::Context* SkPictureShader::onMakeContext(const ContextRec& rec, SkA
 const {
     auto lm = this->totalLocalMatrix(rec.fLocalMatrix);
     sk_sp<SkShader> bitmapShader = this->refBitmapShader(*rec.fMatrix, &lm, rec.fDstColorType,
-                                                         rec.fDstColorSpace);
+                                                         rec.fDstColorSpace,
+                                                         rec.fPaint->getFilterQuality());
     if (!bitmapShader) {
         return nullptr;
     }
@@ -333,7 +353,7 @@ std::unique_ptr<GrFragmentProcessor> SkPictureShader::asFragmentProcessor(
     GrPixelConfigToColorType(args.fDstColorSpaceInfo->config(), &dstColorType);
     sk_sp<SkShader> bitmapShader(this->refBitmapShader(*args.fViewMatrix, &lm, dstColorType,
                                                        args.fDstColorSpaceInfo->colorSpace(),
-                                                       maxTextureSize));
+                                                       args.fFilterQuality, maxTextureSize));
     if (!bitmapShader) {
         return nullptr;
     }
@@ -48,7 +48,7 @@ private:
 
     sk_sp<SkShader> refBitmapShader(const SkMatrix&, SkTCopyOnFirstWrite<SkMatrix>* localMatrix,
                                     SkColorType dstColorType, SkColorSpace* dstColorSpace,
-                                    const int maxTextureSize = 0) const;
+                                    SkFilterQuality, const int maxTextureSize = 0) const;
 
     class PictureShaderContext : public Context {
     public:
@@ -270,6 +270,43 @@ static void init_stop_pos(
     add_stop_color(ctx, stop, Fs, Bs);
 }
 
+// Searching every stop gets expensive for gradients with many of them (e.g. heatmaps). Past this
+// many, the gradient stage starts its search from a table of where each 1/256th of t begins.
+static constexpr size_t kMinBucketedStopCount = 16;
+static constexpr int    kStopBucketCount      = 256;
+
+// Which bucket t falls in, computed exactly as bucketed_stop_index() in SkRasterPipeline_opts.h
+// does it, so that the table agrees with the pipeline about which stops are in each bucket.
+static int stop_bucket(float t) {
+    float clamped = t > 0 ? t : 0;
+    clamped = clamped < 1 ? clamped : 1;
+    return (int)(clamped * (float)kStopBucketCount);
+}
+
+static void init_stop_buckets(SkArenaAlloc* alloc, SkRasterPipeline_GradientCtx* ctx) {
+    // For each bucket, count the stops inside it, and the intervals that start before it.
+    int stopsInBucket[kStopBucketCount + 1] = {};
+    for (size_t i = 1; i < ctx->stopCount; i++) {
+        stopsInBucket[stop_bucket(ctx->ts[i])] += 1;
+    }
+    uint32_t* stopBuckets = alloc->makeArray<uint32_t>(kStopBucketCount + 1);
+    uint32_t intervalsBefore = 0;
+    int maxStopsPerBucket = 0;
+    for (int k = 0; k <= kStopBucketCount; k++) {
+        stopBuckets[k] = intervalsBefore;
+        intervalsBefore += stopsInBucket[k];
+        maxStopsPerBucket = SkTMax(maxStopsPerBucket, stopsInBucket[k]);
+    }
+
+    // If the stops are bunched up, the buckets don't save much over searching them all.
+    if (4 * (size_t)maxStopsPerBucket <= ctx->stopCount) {
+        ctx->ts[ctx->stopCount] = SK_FloatInfinity;
+        ctx->stopBuckets = stopBuckets;
+        ctx->bucketCount = kStopBucketCount;
+        ctx->maxStopsPerBucket = maxStopsPerBucket;
+    }
+}
+
 bool SkGradientShaderBase::onAppendStages(const SkStageRec& rec) const {
     SkRasterPipeline* p = rec.fPipeline;
     SkArenaAlloc* alloc = rec.fAlloc;
@@ -361,7 +398,8 @@ bool SkGradientShaderBase::onAppendStages(const SkStageRec& rec) const {
         } else {
             // Handle arbitrary stops.
 
-            ctx->ts = alloc->makeArray<float>(fColorCount+1);
+            // One more than the stops, for the end marker init_stop_buckets() may add.
+            ctx->ts = alloc->makeArray<float>(fColorCount+2);
 
             // Remove the dummy stops inserted by SkGradientShaderBase::SkGradientShaderBase
             // because they are naturally handled by the search method.
@@ -397,6 +435,9 @@ bool SkGradientShaderBase::onAppendStages(const SkStageRec& rec) const {
             add_const_color(ctx, stopCount++, c_l);
 
             ctx->stopCount = stopCount;
+            if (stopCount >= kMinBucketedStopCount) {
+                init_stop_buckets(alloc, ctx);
+            }
             p->append(SkRasterPipeline::gradient, ctx);
         }
     }
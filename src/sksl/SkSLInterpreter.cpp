@@ -32,11 +32,20 @@ namespace SkSL {
 
 static constexpr int UNINITIALIZED = 0xDEADBEEF;
 
+constexpr int Interpreter::kVecWidth;
+
 Interpreter::Interpreter(std::unique_ptr<Program> program,
                          std::unique_ptr<ByteCode> byteCode,
                          Interpreter::Value inputs[])
     : fProgram(std::move(program))
-    , fByteCode(std::move(byteCode))
+    , fOwnedByteCode(std::move(byteCode))
+    , fByteCode(fOwnedByteCode.get())
+    , fGlobals(fByteCode->fGlobalCount, UNINITIALIZED) {
+    this->setInputs(inputs);
+}
+
+Interpreter::Interpreter(const ByteCode* byteCode, Interpreter::Value inputs[])
+    : fByteCode(byteCode)
     , fGlobals(fByteCode->fGlobalCount, UNINITIALIZED) {
     this->setInputs(inputs);
 }
@@ -63,7 +72,9 @@ void Interpreter::run(const ByteCodeFunction& f, Interpreter::Value args[],
     if (f.fParameterCount) {
         memcpy(stack, args, f.fParameterCount * sizeof(Value));
     }
-    this->innerRun(f, stack, outReturn);
+    std::vector<StackFrame> frames;
+    this->innerRun(f.fCode.data(), f.fCode.data(), stack,
+                   stack + f.fParameterCount + f.fLocalCount - 1, &frames, outReturn);
 
     for (const Variable* p : f.fDeclaration.fParameters) {
         const int nvalues = ByteCodeGenerator::SlotCount(p->fType);
@@ -354,7 +365,7 @@ void Interpreter::disassemble(const ByteCodeFunction& f) {
     case ByteCodeInstruction::base:      sp[ 0] = fn(sp[ 0].field); \
                                          break;
 
-struct StackFrame {
+struct Interpreter::StackFrame {
     const uint8_t* fCode;
     const uint8_t* fIP;
     Interpreter::Value* fStack;
@@ -364,15 +375,12 @@ static float mix(float start, float end, float t) {
     return start * (1 - t) + end * t;
 }
 
-void Interpreter::innerRun(const ByteCodeFunction& f, Value* stack, Value* outReturn) {
-    Value* sp = stack + f.fParameterCount + f.fLocalCount - 1;
-
+void Interpreter::innerRun(const uint8_t* code, const uint8_t* ip, Value* stack, Value* sp,
+                           std::vector<StackFrame>* framesPtr, Value* outReturn) {
     auto POP =  [&]          { SkASSERT(sp     >= stack); return *(sp--); };
     auto PUSH = [&](Value v) { SkASSERT(sp + 1 >= stack); *(++sp) = v;    };
 
-    const uint8_t* code = f.fCode.data();
-    const uint8_t* ip = code;
-    std::vector<StackFrame> frames;
+    std::vector<StackFrame>& frames = *framesPtr;
 
     for (;;) {
 #ifdef TRACE
@@ -828,6 +836,577 @@ void Interpreter::innerRun(const ByteCodeFunction& f, Value* stack, Value* outRe
     }
 }
 
+struct Interpreter::StripedStackFrame {
+    const uint8_t* fCode;
+    const uint8_t* fIP;
+    Interpreter::VValue* fStack;
+};
+
+void Interpreter::runStriped(const ByteCodeFunction& f, int N, Value* args[],
+                             Value* outReturn[]) {
+#ifdef TRACE
+    this->disassemble(f);
+#endif
+    if ((int) fStripedStack.size() < f.fStackCount) {
+        fStripedStack.resize(f.fStackCount);
+    }
+    VValue* stack = fStripedStack.data();
+    SkAutoSTMalloc<4, VValue> returnValues(f.fReturnCount);
+
+    for (int base = 0; base < N; base += kVecWidth) {
+        const int lanes = SkTMin(kVecWidth, N - base);
+        // Unused lanes repeat the first one, so they can't branch differently or fault where it
+        // doesn't.
+        for (int slot = 0; slot < f.fParameterCount; ++slot) {
+            for (int l = 0; l < kVecWidth; ++l) {
+                stack[slot].fLanes[l] = args[slot][base + (l < lanes ? l : 0)];
+            }
+        }
+        this->innerRunStriped(f, stack, lanes, returnValues.get());
+
+        int slot = 0;
+        for (const Variable* p : f.fDeclaration.fParameters) {
+            const int nvalues = ByteCodeGenerator::SlotCount(p->fType);
+            if (p->fModifiers.fFlags & Modifiers::kOut_Flag) {
+                for (int i = slot; i < slot + nvalues; ++i) {
+                    memcpy(args[i] + base, stack[i].fLanes, lanes * sizeof(Value));
+                }
+            }
+            slot += nvalues;
+        }
+        if (outReturn) {
+            for (int i = 0; i < f.fReturnCount; ++i) {
+                memcpy(outReturn[i] + base, returnValues[i].fLanes, lanes * sizeof(Value));
+            }
+        }
+    }
+}
+
+void Interpreter::finishLanes(const ByteCodeFunction& f, const uint8_t* code, const uint8_t* ip,
+                              VValue* bottom, VValue* stack, VValue* sp,
+                              const std::vector<StripedStackFrame>& frames, int N,
+                              VValue* outReturn) {
+    Value smallStack[128];
+    std::unique_ptr<Value[]> largeStack;
+    Value* laneStack = smallStack;
+    if (SK_ARRAY_COUNT(smallStack) < fStripedStack.size()) {
+        largeStack.reset(new Value[fStripedStack.size()]);
+        laneStack = largeStack.get();
+    }
+    SkAutoSTMalloc<16, Value> returnValues(f.fReturnCount);
+
+    const int used = (int) (sp - bottom + 1);
+    std::vector<StackFrame> laneFrames;
+    for (int l = 0; l < N; ++l) {
+        for (int i = 0; i < used; ++i) {
+            laneStack[i] = bottom[i].fLanes[l];
+        }
+        laneFrames.clear();
+        for (const StripedStackFrame& frame : frames) {
+            laneFrames.push_back({ frame.fCode, frame.fIP, laneStack + (frame.fStack - bottom) });
+        }
+        this->innerRun(code, ip, laneStack + (stack - bottom), laneStack + (sp - bottom),
+                       &laneFrames, returnValues.get());
+
+        // runStriped() expects the parameters' final values at the bottom of the stack.
+        for (int i = 0; i < f.fParameterCount; ++i) {
+            bottom[i].fLanes[l] = laneStack[i];
+        }
+        for (int i = 0; i < f.fReturnCount; ++i) {
+            outReturn[i].fLanes[l] = returnValues[i];
+        }
+    }
+}
+
+#define LANES(stmt) for (int l = 0; l < kVecWidth; ++l) { stmt; }
+
+// Striped instructions operate on 'count' components at once, rather than falling through the
+// cases one component at a time.
+#define STRIPED_COUNT(base) ((int) inst - (int) ByteCodeInstruction::base + 1)
+
+#define STRIPED_BINARY(count, expr)                                   \
+    {                                                                 \
+        VValue* a = sp - 2 * (count) + 1;                             \
+        VValue* b = sp - (count) + 1;                                 \
+        for (int i = 0; i < (count); ++i) {                           \
+            LANES(Value& x = a[i].fLanes[l]; Value& y = b[i].fLanes[l]; x = expr) \
+        }                                                             \
+        sp -= (count);                                                \
+    }
+
+#define STRIPED_VECTOR_BINARY(base, expr)                             \
+    case ByteCodeInstruction::base ## 4:                              \
+    case ByteCodeInstruction::base ## 3:                              \
+    case ByteCodeInstruction::base ## 2:                              \
+    case ByteCodeInstruction::base:                                   \
+        STRIPED_BINARY(STRIPED_COUNT(base), expr)                     \
+        break;
+
+#define STRIPED_VECTOR_MATRIX_BINARY(base, expr)                      \
+    STRIPED_VECTOR_BINARY(base, expr)                                 \
+    case ByteCodeInstruction::base ## N: {                            \
+        int count = READ8();                                          \
+        STRIPED_BINARY(count, expr)                                   \
+        break;                                                        \
+    }
+
+#define STRIPED_VECTOR_BINARY_OP(base, field, op) \
+    STRIPED_VECTOR_BINARY(base, x.field op y.field)
+
+#define STRIPED_VECTOR_MATRIX_BINARY_OP(base, field, op) \
+    STRIPED_VECTOR_MATRIX_BINARY(base, x.field op y.field)
+
+#define STRIPED_VECTOR_UNARY(base, expr)                              \
+    case ByteCodeInstruction::base ## 4:                              \
+    case ByteCodeInstruction::base ## 3:                              \
+    case ByteCodeInstruction::base ## 2:                              \
+    case ByteCodeInstruction::base:                                   \
+        for (int i = 1 - STRIPED_COUNT(base); i <= 0; ++i) {          \
+            LANES(Value& x = sp[i].fLanes[l]; expr)                   \
+        }                                                             \
+        break;
+
+#define STRIPED_VECTOR_UNARY_FN(base, fn, field) \
+    STRIPED_VECTOR_UNARY(base, x = fn(x.field))
+
+void Interpreter::innerRunStriped(const ByteCodeFunction& f, VValue* stack, int N,
+                                  VValue* outReturn) {
+    VValue* const bottom = stack;
+    VValue* sp = stack + f.fParameterCount + f.fLocalCount - 1;
+
+    auto broadcast = [](Value v) {
+        VValue result;
+        LANES(result.fLanes[l] = v)
+        return result;
+    };
+    // Whether each of the N lanes in use holds the same bool or int.
+    auto uniformBool = [N](const VValue& v) {
+        for (int l = 1; l < N; ++l) {
+            if (v.fLanes[l].fBool != v.fLanes[0].fBool) {
+                return false;
+            }
+        }
+        return true;
+    };
+    auto uniformInt = [N](const VValue& v) {
+        for (int l = 1; l < N; ++l) {
+            if (v.fLanes[l].fSigned != v.fLanes[0].fSigned) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    const uint8_t* code = f.fCode.data();
+    const uint8_t* ip = code;
+    std::vector<StripedStackFrame> frames;
+
+    // Hands the instruction that is about to run, and everything after it, to the scalar
+    // interpreter.
+#define FINISH_LANES()                                                                   \
+    this->finishLanes(f, code, instIP, bottom, stack, sp, frames, N, outReturn);         \
+    return
+
+    for (;;) {
+        const uint8_t* instIP = ip;
+        ByteCodeInstruction inst = (ByteCodeInstruction) READ16();
+        switch (inst) {
+            STRIPED_VECTOR_BINARY_OP(kAddI, fSigned, +)
+            STRIPED_VECTOR_MATRIX_BINARY_OP(kAddF, fFloat, +)
+            STRIPED_VECTOR_BINARY_OP(kAndB, fBool, &&)
+
+            case ByteCodeInstruction::kBranch:
+                ip = code + READ16();
+                break;
+
+            case ByteCodeInstruction::kCall: {
+                int target = READ8();
+                const ByteCodeFunction* fun = fByteCode->fFunctions[target].get();
+                frames.push_back({ code, ip, stack });
+                ip = code = fun->fCode.data();
+                stack = sp - fun->fParameterCount + 1;
+                sp = stack + fun->fParameterCount + fun->fLocalCount - 1;
+                break;
+            }
+
+            case ByteCodeInstruction::kCallExternal:
+                FINISH_LANES();
+
+            STRIPED_VECTOR_BINARY_OP(kCompareIEQ, fSigned, ==)
+            STRIPED_VECTOR_MATRIX_BINARY_OP(kCompareFEQ, fFloat, ==)
+            STRIPED_VECTOR_BINARY_OP(kCompareINEQ, fSigned, !=)
+            STRIPED_VECTOR_MATRIX_BINARY_OP(kCompareFNEQ, fFloat, !=)
+            STRIPED_VECTOR_BINARY_OP(kCompareSGT, fSigned, >)
+            STRIPED_VECTOR_BINARY_OP(kCompareUGT, fUnsigned, >)
+            STRIPED_VECTOR_BINARY_OP(kCompareFGT, fFloat, >)
+            STRIPED_VECTOR_BINARY_OP(kCompareSGTEQ, fSigned, >=)
+            STRIPED_VECTOR_BINARY_OP(kCompareUGTEQ, fUnsigned, >=)
+            STRIPED_VECTOR_BINARY_OP(kCompareFGTEQ, fFloat, >=)
+            STRIPED_VECTOR_BINARY_OP(kCompareSLT, fSigned, <)
+            STRIPED_VECTOR_BINARY_OP(kCompareULT, fUnsigned, <)
+            STRIPED_VECTOR_BINARY_OP(kCompareFLT, fFloat, <)
+            STRIPED_VECTOR_BINARY_OP(kCompareSLTEQ, fSigned, <=)
+            STRIPED_VECTOR_BINARY_OP(kCompareULTEQ, fUnsigned, <=)
+            STRIPED_VECTOR_BINARY_OP(kCompareFLTEQ, fFloat, <=)
+
+            case ByteCodeInstruction::kConditionalBranch: {
+                int target = READ16();
+                if (!uniformBool(*sp)) {
+                    FINISH_LANES();
+                }
+                if ((sp--)->fLanes[0].fBool) {
+                    ip = code + target;
+                }
+                break;
+            }
+
+            STRIPED_VECTOR_UNARY(kConvertFtoI, x.fSigned = (int) x.fFloat)
+            STRIPED_VECTOR_UNARY(kConvertStoF, x.fFloat = x.fSigned)
+            STRIPED_VECTOR_UNARY(kConvertUtoF, x.fFloat = x.fUnsigned)
+
+            STRIPED_VECTOR_UNARY_FN(kCos, cosf, fFloat)
+
+            case ByteCodeInstruction::kCross:
+                LANES(SkPoint3 cross = SkPoint3::CrossProduct(
+                                               SkPoint3::Make(sp[-5].fLanes[l].fFloat,
+                                                              sp[-4].fLanes[l].fFloat,
+                                                              sp[-3].fLanes[l].fFloat),
+                                               SkPoint3::Make(sp[-2].fLanes[l].fFloat,
+                                                              sp[-1].fLanes[l].fFloat,
+                                                              sp[ 0].fLanes[l].fFloat));
+                      sp[-5].fLanes[l] = cross.fX;
+                      sp[-4].fLanes[l] = cross.fY;
+                      sp[-3].fLanes[l] = cross.fZ)
+                sp -= 3;
+                break;
+
+            case ByteCodeInstruction::kDebugPrint:
+                FINISH_LANES();
+
+            STRIPED_VECTOR_BINARY_OP(kDivideS, fSigned, /)
+            STRIPED_VECTOR_BINARY_OP(kDivideU, fUnsigned, /)
+            STRIPED_VECTOR_MATRIX_BINARY_OP(kDivideF, fFloat, /)
+
+            case ByteCodeInstruction::kDup4:
+            case ByteCodeInstruction::kDup3:
+            case ByteCodeInstruction::kDup2:
+            case ByteCodeInstruction::kDup: {
+                int count = STRIPED_COUNT(kDup);
+                memcpy(sp + 1, sp - count + 1, count * sizeof(VValue));
+                sp += count;
+                break;
+            }
+
+            case ByteCodeInstruction::kDupN: {
+                int count = READ8();
+                memcpy(sp + 1, sp - count + 1, count * sizeof(VValue));
+                sp += count;
+                break;
+            }
+
+            case ByteCodeInstruction::kLoad4:
+            case ByteCodeInstruction::kLoad3:
+            case ByteCodeInstruction::kLoad2:
+            case ByteCodeInstruction::kLoad: {
+                int count = STRIPED_COUNT(kLoad);
+                memcpy(sp + 1, &stack[READ8()], count * sizeof(VValue));
+                sp += count;
+                break;
+            }
+
+            case ByteCodeInstruction::kLoadGlobal4:
+            case ByteCodeInstruction::kLoadGlobal3:
+            case ByteCodeInstruction::kLoadGlobal2:
+            case ByteCodeInstruction::kLoadGlobal: {
+                int count = STRIPED_COUNT(kLoadGlobal);
+                int src = READ8();
+                for (int i = 0; i < count; ++i) {
+                    *(++sp) = broadcast(fGlobals[src + i]);
+                }
+                break;
+            }
+
+            case ByteCodeInstruction::kLoadExtended: {
+                int count = READ8();
+                if (!uniformInt(*sp)) {
+                    FINISH_LANES();
+                }
+                int src = (sp--)->fLanes[0].fSigned;
+                memcpy(sp + 1, &stack[src], count * sizeof(VValue));
+                sp += count;
+                break;
+            }
+
+            case ByteCodeInstruction::kLoadExtendedGlobal: {
+                int count = READ8();
+                if (!uniformInt(*sp)) {
+                    FINISH_LANES();
+                }
+                int src = (sp--)->fLanes[0].fSigned;
+                SkASSERT(src + count <= (int) fGlobals.size());
+                for (int i = 0; i < count; ++i) {
+                    *(++sp) = broadcast(fGlobals[src + i]);
+                }
+                break;
+            }
+
+            case ByteCodeInstruction::kLoadSwizzle: {
+                int src = READ8();
+                int count = READ8();
+                for (int i = 0; i < count; ++i) {
+                    *(++sp) = stack[src + *(ip + i)];
+                }
+                ip += count;
+                break;
+            }
+
+            case ByteCodeInstruction::kLoadSwizzleGlobal: {
+                int src = READ8();
+                SkASSERT(src < (int) fGlobals.size());
+                int count = READ8();
+                for (int i = 0; i < count; ++i) {
+                    *(++sp) = broadcast(fGlobals[src + *(ip + i)]);
+                }
+                ip += count;
+                break;
+            }
+
+            case ByteCodeInstruction::kMatrixToMatrix: {
+                int srcCols = READ8();
+                int srcRows = READ8();
+                int dstCols = READ8();
+                int dstRows = READ8();
+                SkASSERT(srcCols >= 2 && srcCols <= 4);
+                SkASSERT(srcRows >= 2 && srcRows <= 4);
+                SkASSERT(dstCols >= 2 && dstCols <= 4);
+                SkASSERT(dstRows >= 2 && dstRows <= 4);
+                VValue* src = sp - (srcCols * srcRows) + 1;
+                VValue tmp[16];
+                for (int l = 0; l < kVecWidth; ++l) {
+                    SkMatrix44 m;
+                    for (int c = 0; c < srcCols; ++c) {
+                        for (int r = 0; r < srcRows; ++r) {
+                            m.set(r, c, src[c*srcRows + r].fLanes[l].fFloat);
+                        }
+                    }
+                    for (int c = 0; c < dstCols; ++c) {
+                        for (int r = 0; r < dstRows; ++r) {
+                            tmp[c*dstRows + r].fLanes[l] = m.get(r, c);
+                        }
+                    }
+                }
+                sp -= srcCols * srcRows;
+                memcpy(sp + 1, tmp, dstCols * dstRows * sizeof(VValue));
+                sp += dstCols * dstRows;
+                break;
+            }
+
+            case ByteCodeInstruction::kMatrixMultiply: {
+                int lCols = READ8();
+                int lRows = READ8();
+                int rCols = READ8();
+                int rRows = lCols;
+                VValue tmp[16];
+                for (int i = 0; i < rCols * lRows; ++i) {
+                    tmp[i] = broadcast(0.0f);
+                }
+                VValue* B = sp - (rCols * rRows) + 1;
+                VValue* A = B - (lCols * lRows);
+                for (int c = 0; c < rCols; ++c) {
+                    for (int r = 0; r < lRows; ++r) {
+                        for (int j = 0; j < lCols; ++j) {
+                            LANES(tmp[c*lRows + r].fLanes[l].fFloat +=
+                                          A[j*lRows + r].fLanes[l].fFloat *
+                                          B[c*rRows + j].fLanes[l].fFloat)
+                        }
+                    }
+                }
+                sp -= (lCols * lRows) + (rCols * rRows);
+                memcpy(sp + 1, tmp, rCols * lRows * sizeof(VValue));
+                sp += (rCols * lRows);
+                break;
+            }
+
+            // stack looks like: X1 Y1 Z1 W1 X2 Y2 Z2 W2 T
+            case ByteCodeInstruction::kMix4:
+            case ByteCodeInstruction::kMix3:
+            case ByteCodeInstruction::kMix2:
+            case ByteCodeInstruction::kMix: {
+                int count = STRIPED_COUNT(kMix);
+                for (int i = 0; i < count; ++i) {
+                    LANES(Value& x = sp[i - 2 * count].fLanes[l];
+                          x = mix(x.fFloat, sp[i - count].fLanes[l].fFloat, sp[0].fLanes[l].fFloat))
+                }
+                sp -= 1 + count;
+                break;
+            }
+
+            STRIPED_VECTOR_BINARY_OP(kMultiplyI, fSigned, *)
+            STRIPED_VECTOR_MATRIX_BINARY_OP(kMultiplyF, fFloat, *)
+
+            STRIPED_VECTOR_UNARY(kNot, x.fBool = !x.fBool)
+
+            STRIPED_VECTOR_UNARY(kNegateF, x = -x.fFloat)
+
+            case ByteCodeInstruction::kNegateFN: {
+                int count = READ8();
+                for (int i = count - 1; i >= 0; --i) {
+                    LANES(sp[-i].fLanes[l] = -sp[-i].fLanes[l].fFloat)
+                }
+                break;
+            }
+
+            STRIPED_VECTOR_UNARY(kNegateI, x = -x.fSigned)
+
+            STRIPED_VECTOR_BINARY_OP(kOrB, fBool, ||)
+
+            case ByteCodeInstruction::kPop4:
+            case ByteCodeInstruction::kPop3:
+            case ByteCodeInstruction::kPop2:
+            case ByteCodeInstruction::kPop:
+                sp -= STRIPED_COUNT(kPop);
+                break;
+
+            case ByteCodeInstruction::kPopN:
+                sp -= READ8();
+                break;
+
+            case ByteCodeInstruction::kPushImmediate:
+                *(++sp) = broadcast(READ32());
+                break;
+
+            case ByteCodeInstruction::kReadExternal:
+            case ByteCodeInstruction::kReadExternal2:
+            case ByteCodeInstruction::kReadExternal3:
+            case ByteCodeInstruction::kReadExternal4:
+                FINISH_LANES();
+
+            STRIPED_VECTOR_BINARY(kRemainderF, fmodf(x.fFloat, y.fFloat))
+            STRIPED_VECTOR_BINARY_OP(kRemainderS, fSigned, %)
+            STRIPED_VECTOR_BINARY_OP(kRemainderU, fUnsigned, %)
+
+            case ByteCodeInstruction::kReturn: {
+                int count = READ8();
+                if (frames.empty()) {
+                    if (count) {
+                        memcpy(outReturn, sp - count + 1, count * sizeof(VValue));
+                    }
+                    return;
+                } else {
+                    memmove(stack, sp - count + 1, count * sizeof(VValue));
+                    const StripedStackFrame& frame(frames.back());
+                    sp = stack + count - 1;
+                    stack = frame.fStack;
+                    code = frame.fCode;
+                    ip = frame.fIP;
+                    frames.pop_back();
+                    break;
+                }
+            }
+
+            case ByteCodeInstruction::kScalarToMatrix: {
+                int cols = READ8();
+                int rows = READ8();
+                VValue v = *(sp--);
+                for (int c = 0; c < cols; ++c) {
+                    for (int r = 0; r < rows; ++r) {
+                        *(++sp) = c == r ? v : broadcast(0.0f);
+                    }
+                }
+                break;
+            }
+
+            STRIPED_VECTOR_UNARY_FN(kSin, sinf, fFloat)
+            STRIPED_VECTOR_UNARY_FN(kSqrt, sqrtf, fFloat)
+
+            case ByteCodeInstruction::kStore4:
+            case ByteCodeInstruction::kStore3:
+            case ByteCodeInstruction::kStore2:
+            case ByteCodeInstruction::kStore: {
+                int count = STRIPED_COUNT(kStore);
+                memcpy(&stack[READ8()], sp - count + 1, count * sizeof(VValue));
+                sp -= count;
+                break;
+            }
+
+            case ByteCodeInstruction::kStoreGlobal4:
+            case ByteCodeInstruction::kStoreGlobal3:
+            case ByteCodeInstruction::kStoreGlobal2:
+            case ByteCodeInstruction::kStoreGlobal:
+                FINISH_LANES();
+
+            case ByteCodeInstruction::kStoreExtended: {
+                int count = READ8();
+                if (!uniformInt(*sp)) {
+                    FINISH_LANES();
+                }
+                int target = (sp--)->fLanes[0].fSigned;
+                memcpy(&stack[target], sp - count + 1, count * sizeof(VValue));
+                sp -= count;
+                break;
+            }
+
+            case ByteCodeInstruction::kStoreExtendedGlobal:
+                FINISH_LANES();
+
+            case ByteCodeInstruction::kStoreSwizzle: {
+                int target = READ8();
+                int count = READ8();
+                for (int i = count - 1; i >= 0; --i) {
+                    stack[target + *(ip + i)] = *(sp--);
+                }
+                ip += count;
+                break;
+            }
+
+            case ByteCodeInstruction::kStoreSwizzleGlobal:
+                FINISH_LANES();
+
+            case ByteCodeInstruction::kStoreSwizzleIndirect: {
+                if (!uniformInt(*sp)) {
+                    FINISH_LANES();
+                }
+                int target = (sp--)->fLanes[0].fSigned;
+                int count = READ8();
+                for (int i = count - 1; i >= 0; --i) {
+                    stack[target + *(ip + i)] = *(sp--);
+                }
+                ip += count;
+                break;
+            }
+
+            case ByteCodeInstruction::kStoreSwizzleIndirectGlobal:
+                FINISH_LANES();
+
+            STRIPED_VECTOR_BINARY_OP(kSubtractI, fSigned, -)
+            STRIPED_VECTOR_MATRIX_BINARY_OP(kSubtractF, fFloat, -)
+
+            case ByteCodeInstruction::kSwizzle: {
+                VValue tmp[4];
+                for (int i = READ8() - 1; i >= 0; --i) {
+                    tmp[i] = *(sp--);
+                }
+                for (int i = READ8() - 1; i >= 0; --i) {
+                    *(++sp) = tmp[READ8()];
+                }
+                break;
+            }
+
+            STRIPED_VECTOR_UNARY_FN(kTan, tanf, fFloat)
+
+            case ByteCodeInstruction::kWriteExternal:
+            case ByteCodeInstruction::kWriteExternal2:
+            case ByteCodeInstruction::kWriteExternal3:
+            case ByteCodeInstruction::kWriteExternal4:
+                FINISH_LANES();
+
+            default:
+                SkDEBUGFAILF("unsupported instruction %d\n", (int) inst);
+        }
+    }
+#undef FINISH_LANES
+}
+
 } // namespace
 
 #endif
@@ -57,6 +57,13 @@ public:
     Interpreter(std::unique_ptr<Program> program, std::unique_ptr<ByteCode> byteCode,
                 Value inputs[] = nullptr);
 
+    /**
+     * As above, but the byte code (and the program it came from) belong to the caller, and must
+     * outlive the interpreter. Running never changes them, so any number of interpreters may share
+     * them.
+     */
+    Interpreter(const ByteCode* byteCode, Value inputs[] = nullptr);
+
     /**
      * Invokes the specified function with the given arguments. 'out' and 'inout' parameters will
      * result in the 'args' array being modified. The return value is stored in 'outReturn' (may be
@@ -64,6 +71,20 @@ public:
      */
     void run(const ByteCodeFunction& f, Value args[], Value* outReturn);
 
+    static constexpr int kVecWidth = 16;
+
+    /**
+     * Invokes the specified function N times, kVecWidth invocations at a time, so that the cost of
+     * decoding each instruction is shared. 'args' holds one array of N values per parameter slot,
+     * and 'outReturn' (may be null) one array of N values per return slot. As with run(), 'out'
+     * and 'inout' parameters are written back to 'args'.
+     *
+     * While every invocation takes the same branches, they execute together. Once they diverge, or
+     * reach an instruction with side effects (such as storing to a global or calling an external
+     * value), each invocation is finished on its own, in order.
+     */
+    void runStriped(const ByteCodeFunction& f, int N, Value* args[], Value* outReturn[]);
+
     /**
      * Updates the global inputs.
      */
@@ -74,12 +95,31 @@ public:
      */
     void disassemble(const ByteCodeFunction&);
 private:
-    void innerRun(const ByteCodeFunction& f, Value* stack, Value* outReturn);
+    struct StackFrame;
+    struct StripedStackFrame;
+
+    // One Value per lane of a striped invocation.
+    struct VValue {
+        Value fLanes[kVecWidth];
+    };
+
+    void innerRun(const uint8_t* code, const uint8_t* ip, Value* stack, Value* sp,
+                  std::vector<StackFrame>* frames, Value* outReturn);
+
+    void innerRunStriped(const ByteCodeFunction& f, VValue* stack, int N, VValue* outReturn);
+
+    // Finishes a striped invocation one lane at a time, starting with the instruction at 'ip'.
+    // 'bottom' is where the outermost function's parameters start.
+    void finishLanes(const ByteCodeFunction& f, const uint8_t* code, const uint8_t* ip,
+                     VValue* bottom, VValue* stack, VValue* sp,
+                     const std::vector<StripedStackFrame>& frames, int N, VValue* outReturn);
 
 
     std::unique_ptr<Program> fProgram;
-    std::unique_ptr<ByteCode> fByteCode;
+    std::unique_ptr<ByteCode> fOwnedByteCode;
+    const ByteCode* fByteCode;
     std::vector<Value> fGlobals;
+    std::vector<VValue> fStripedStack;
 };
 
 } // namespace
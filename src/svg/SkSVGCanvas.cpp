@@ -10,11 +10,18 @@
 #include "src/svg/SkSVGDevice.h"
 #include "src/xml/SkXMLWriter.h"
 
-std::unique_ptr<SkCanvas> SkSVGCanvas::Make(const SkRect& bounds, SkWStream* writer) {
+std::unique_ptr<SkCanvas> SkSVGCanvas::Make(const SkRect& bounds, SkWStream* writer,
+                                            uint32_t flags, int pathDecimalPlaces) {
     // TODO: pass full bounds to the device
     SkISize size = bounds.roundOut().size();
 
-    auto svgDevice = SkSVGDevice::Make(size, skstd::make_unique<SkXMLStreamWriter>(writer));
+    uint32_t xmlFlags = (flags & kNoPrettyXML_Flag) ? SkXMLStreamWriter::kNoPretty_Flag : 0;
+    auto pathEncoding = (flags & kRelativePathEncoding_Flag)
+            ? SkParsePath::PathEncoding::Relative
+            : SkParsePath::PathEncoding::Absolute;
+    auto svgDevice = SkSVGDevice::Make(size,
+                                       skstd::make_unique<SkXMLStreamWriter>(writer, xmlFlags),
+                                       pathEncoding, pathDecimalPlaces);
 
     return svgDevice ? skstd::make_unique<SkCanvas>(svgDevice)
                      : nullptr;
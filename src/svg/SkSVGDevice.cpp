@@ -18,6 +18,7 @@
 #include "include/core/SkStream.h"
 #include "include/core/SkTypeface.h"
 #include "include/private/SkChecksum.h"
+#include "include/private/SkFloatBits.h"
 #include "include/private/SkTHash.h"
 #include "include/private/SkTo.h"
 #include "include/utils/SkBase64.h"
@@ -133,17 +134,19 @@ bool RequiresViewportReset(const SkPaint& paint) {
 
 }  // namespace
 
-// For now all this does is serve unique serial IDs, but it will eventually evolve to track
-// and deduplicate resources.
+// Serves unique serial IDs, and remembers which resources have already been written so later
+// draws can refer to them instead of writing them again.
 class SkSVGDevice::ResourceBucket : ::SkNoncopyable {
 public:
-    ResourceBucket()
+    ResourceBucket(SkParsePath::PathEncoding pathEncoding, int pathDecimalPlaces)
             : fGradientCount(0)
             , fClipCount(0)
             , fPathCount(0)
             , fImageCount(0)
             , fPatternCount(0)
-            , fColorFilterCount(0) {}
+            , fColorFilterCount(0)
+            , fPathEncoding(pathEncoding)
+            , fPathDecimalPlaces(pathDecimalPlaces) {}
 
     SkString addLinearGradient() {
         return SkStringPrintf("gradient_%d", fGradientCount++);
@@ -167,6 +170,18 @@ public:
       return SkStringPrintf("pattern_%d", fPatternCount++);
     }
 
+    // Resources are written to a <defs> element the first time they're drawn. Returns the ID
+    // they were written with, or null if nothing has been written for 'key' yet.
+    const SkString* findResource(const SkString& key) const { return fResources.find(key); }
+
+    void addResource(const SkString& key, const SkString& id) {
+        SkASSERT(!key.isEmpty());
+        fResources.set(key, id);
+    }
+
+    SkParsePath::PathEncoding pathEncoding() const { return fPathEncoding; }
+    int pathDecimalPlaces() const { return fPathDecimalPlaces; }
+
 private:
     uint32_t fGradientCount;
     uint32_t fClipCount;
@@ -174,6 +189,11 @@ private:
     uint32_t fImageCount;
     uint32_t fPatternCount;
     uint32_t fColorFilterCount;
+
+    SkTHashMap<SkString, SkString> fResources;
+
+    const SkParsePath::PathEncoding fPathEncoding;
+    const int                       fPathDecimalPlaces;
 };
 
 struct SkSVGDevice::MxCp {
@@ -195,6 +215,12 @@ public:
     AutoElement(const char name[], const std::unique_ptr<SkXMLWriter>& writer)
         : AutoElement(name, writer.get()) {}
 
+    AutoElement(const char name[], SkXMLWriter* writer, ResourceBucket* bucket)
+        : fWriter(writer)
+        , fResourceBucket(bucket) {
+        fWriter->startElement(name);
+    }
+
     AutoElement(const char name[], const std::unique_ptr<SkXMLWriter>& writer,
                 ResourceBucket* bucket, const MxCp& mc, const SkPaint& paint)
         : fWriter(writer.get())
@@ -248,13 +274,13 @@ public:
 
 private:
     Resources addResources(const MxCp&, const SkPaint& paint);
-    void addClipResources(const MxCp&, Resources* resources);
-    void addShaderResources(const SkPaint& paint, Resources* resources);
+    void addClipResources(const MxCp&, const SkString& key, Resources* resources);
+    void addShaderResources(const SkPaint& paint, const SkString& key, Resources* resources);
     void addGradientShaderResources(const SkShader* shader, const SkPaint& paint,
-                                    Resources* resources);
+                                    const SkString& key, Resources* resources);
     void addColorFilterResources(const SkColorFilter& cf, Resources* resources);
     void addImageShaderResources(const SkShader* shader, const SkPaint& paint,
-                                 Resources* resources);
+                                 const SkString& key, Resources* resources);
 
     void addPatternDef(const SkBitmap& bm);
 
@@ -317,22 +343,74 @@ void SkSVGDevice::AutoElement::addPaint(const SkPaint& paint, const Resources& r
     }
 }
 
+// Returns the key the resources written for 'shader' are shared under, or an empty string if they
+// can't be shared.
+static SkString shader_resource_key(const SkShader* shader) {
+    SkString key;
+    SkShader::GradientInfo grInfo;
+    grInfo.fColorCount = 0;
+    if (SkShader::kLinear_GradientType == shader->asAGradient(&grInfo)) {
+        SkAutoSTArray<16, SkColor>  grColors(grInfo.fColorCount);
+        SkAutoSTArray<16, SkScalar> grOffsets(grInfo.fColorCount);
+        grInfo.fColors = grColors.get();
+        grInfo.fColorOffsets = grOffsets.get();
+        shader->asAGradient(&grInfo);
+
+        // Key on the exact bits of everything addLinearGradientDef() writes.
+        key.append("linear_gradient");
+        for (const SkPoint& pt : grInfo.fPoint) {
+            key.appendf(" %x,%x", SkFloat2Bits(pt.fX), SkFloat2Bits(pt.fY));
+        }
+        for (int i = 0; i < grInfo.fColorCount; ++i) {
+            key.appendf(" %x@%x", grInfo.fColors[i], SkFloat2Bits(grInfo.fColorOffsets[i]));
+        }
+        const SkMatrix& localMatrix = as_SB(shader)->getLocalMatrix();
+        for (int i = 0; i < 9; ++i) {
+            key.appendf(" %x", SkFloat2Bits(localMatrix[i]));
+        }
+    } else {
+        SkTileMode xy[2];
+        if (SkImage* image = shader->isAImage(nullptr, xy)) {
+            key.printf("image_pattern %u %d %d", image->uniqueID(), (int)xy[0], (int)xy[1]);
+        }
+    }
+    return key;
+}
+
 Resources SkSVGDevice::AutoElement::addResources(const MxCp& mc, const SkPaint& paint) {
     Resources resources(paint);
 
-    // FIXME: this is a weak heuristic and we end up with LOTS of redundant clips.
+    // Clips are in device space, so every draw under the same clip stack state shares one.
     bool hasClip   = !mc.fClipStack->isWideOpen();
     bool hasShader = SkToBool(paint.getShader());
 
+    SkString clipKey, shaderKey;
+    if (hasClip) {
+        clipKey.printf("clip %u", mc.fClipStack->getTopmostGenID());
+        if (const SkString* clipID = fResourceBucket->findResource(clipKey)) {
+            resources.fClip.printf("url(#%s)", clipID->c_str());
+            hasClip = false;
+        }
+    }
+    if (hasShader) {
+        shaderKey = shader_resource_key(paint.getShader());
+        const SkString* shaderID =
+                shaderKey.isEmpty() ? nullptr : fResourceBucket->findResource(shaderKey);
+        if (shaderID) {
+            resources.fPaintServer.printf("url(#%s)", shaderID->c_str());
+            hasShader = false;
+        }
+    }
+
     if (hasClip || hasShader) {
         AutoElement defs("defs", fWriter);
 
         if (hasClip) {
-            this->addClipResources(mc, &resources);
+            this->addClipResources(mc, clipKey, &resources);
         }
 
         if (hasShader) {
-            this->addShaderResources(paint, &resources);
+            this->addShaderResources(paint, shaderKey, &resources);
         }
     }
 
@@ -348,6 +426,7 @@ Resources SkSVGDevice::AutoElement::addResources(const MxCp& mc, const SkPaint&
 
 void SkSVGDevice::AutoElement::addGradientShaderResources(const SkShader* shader,
                                                           const SkPaint& paint,
+                                                          const SkString& key,
                                                           Resources* resources) {
     SkShader::GradientInfo grInfo;
     grInfo.fColorCount = 0;
@@ -366,7 +445,9 @@ void SkSVGDevice::AutoElement::addGradientShaderResources(const SkShader* shader
     SkASSERT(grInfo.fColorCount <= grColors.count());
     SkASSERT(grInfo.fColorCount <= grOffsets.count());
 
-    resources->fPaintServer.printf("url(#%s)", addLinearGradientDef(grInfo, shader).c_str());
+    SkString id = this->addLinearGradientDef(grInfo, shader);
+    fResourceBucket->addResource(key, id);
+    resources->fPaintServer.printf("url(#%s)", id.c_str());
 }
 
 void SkSVGDevice::AutoElement::addColorFilterResources(const SkColorFilter& cf,
@@ -441,6 +522,7 @@ sk_sp<SkData> AsDataUri(SkImage* image) {
 }
 
 void SkSVGDevice::AutoElement::addImageShaderResources(const SkShader* shader, const SkPaint& paint,
+                                                       const SkString& key,
                                                        Resources* resources) {
     SkMatrix outMatrix;
 
@@ -489,22 +571,25 @@ void SkSVGDevice::AutoElement::addImageShaderResources(const SkShader* shader, c
             imageTag.addAttribute("xlink:href", static_cast<const char*>(dataUri->data()));
         }
     }
+    fResourceBucket->addResource(key, patternID);
     resources->fPaintServer.printf("url(#%s)", patternID.c_str());
 }
 
-void SkSVGDevice::AutoElement::addShaderResources(const SkPaint& paint, Resources* resources) {
+void SkSVGDevice::AutoElement::addShaderResources(const SkPaint& paint, const SkString& key,
+                                                  Resources* resources) {
     const SkShader* shader = paint.getShader();
     SkASSERT(shader);
 
     if (shader->asAGradient(nullptr) != SkShader::kNone_GradientType) {
-        this->addGradientShaderResources(shader, paint, resources);
+        this->addGradientShaderResources(shader, paint, key, resources);
     } else if (shader->isAImage()) {
-        this->addImageShaderResources(shader, paint, resources);
+        this->addImageShaderResources(shader, paint, key, resources);
     }
     // TODO: other shader types?
 }
 
-void SkSVGDevice::AutoElement::addClipResources(const MxCp& mc, Resources* resources) {
+void SkSVGDevice::AutoElement::addClipResources(const MxCp& mc, const SkString& key,
+                                                Resources* resources) {
     SkASSERT(!mc.fClipStack->isWideOpen());
 
     SkPath clipPath;
@@ -525,12 +610,13 @@ void SkSVGDevice::AutoElement::addClipResources(const MxCp& mc, Resources* resou
             rectElement.addRectAttributes(clipRect);
             rectElement.addAttribute("clip-rule", clipRule);
         } else {
-            AutoElement pathElement("path", fWriter);
+            AutoElement pathElement("path", fWriter, fResourceBucket);
             pathElement.addPathAttributes(clipPath);
             pathElement.addAttribute("clip-rule", clipRule);
         }
     }
 
+    fResourceBucket->addResource(key, clipID);
     resources->fClip.printf("url(#%s)", clipID.c_str());
 }
 
@@ -587,8 +673,10 @@ void SkSVGDevice::AutoElement::addRectAttributes(const SkRect& rect) {
 }
 
 void SkSVGDevice::AutoElement::addPathAttributes(const SkPath& path) {
+    SkASSERT(fResourceBucket);
     SkString pathData;
-    SkParsePath::ToSVGString(path, &pathData);
+    SkParsePath::ToSVGString(path, &pathData, fResourceBucket->pathEncoding(),
+                             fResourceBucket->pathDecimalPlaces());
     this->addAttribute("d", pathData);
 }
 
@@ -639,16 +727,20 @@ void SkSVGDevice::AutoElement::addTextAttributes(const SkFont& font) {
     }
 }
 
-sk_sp<SkBaseDevice> SkSVGDevice::Make(const SkISize& size, std::unique_ptr<SkXMLWriter> writer) {
-    return writer ? sk_sp<SkBaseDevice>(new SkSVGDevice(size, std::move(writer)))
+sk_sp<SkBaseDevice> SkSVGDevice::Make(const SkISize& size, std::unique_ptr<SkXMLWriter> writer,
+                                      SkParsePath::PathEncoding pathEncoding,
+                                      int pathDecimalPlaces) {
+    return writer ? sk_sp<SkBaseDevice>(new SkSVGDevice(size, std::move(writer), pathEncoding,
+                                                        pathDecimalPlaces))
                   : nullptr;
 }
 
-SkSVGDevice::SkSVGDevice(const SkISize& size, std::unique_ptr<SkXMLWriter> writer)
+SkSVGDevice::SkSVGDevice(const SkISize& size, std::unique_ptr<SkXMLWriter> writer,
+                         SkParsePath::PathEncoding pathEncoding, int pathDecimalPlaces)
     : INHERITED(SkImageInfo::MakeUnknown(size.fWidth, size.fHeight),
                 SkSurfaceProps(0, kUnknown_SkPixelGeometry))
     , fWriter(std::move(writer))
-    , fResourceBucket(new ResourceBucket)
+    , fResourceBucket(new ResourceBucket(pathEncoding, pathDecimalPlaces))
 {
     SkASSERT(fWriter);
 
@@ -730,7 +822,11 @@ void SkSVGDevice::drawPoints(SkCanvas::PointMode mode, size_t count,
 void SkSVGDevice::drawRect(const SkRect& r, const SkPaint& paint) {
     std::unique_ptr<AutoElement> svg;
     if (RequiresViewportReset(paint)) {
-      svg.reset(new AutoElement("svg", fWriter, fResourceBucket.get(), MxCp(this), paint));
+      // Only the rect needs the shader. Leaving it off the viewport keeps the pattern in the
+      // viewport's own <defs> rather than writing it out a second time.
+      SkPaint viewportPaint(paint);
+      viewportPaint.setShader(nullptr);
+      svg.reset(new AutoElement("svg", fWriter, fResourceBucket.get(), MxCp(this), viewportPaint));
       svg->addRectAttributes(r);
     }
 
@@ -778,28 +874,37 @@ static sk_sp<SkData> encode(const SkBitmap& src) {
 }
 
 void SkSVGDevice::drawBitmapCommon(const MxCp& mc, const SkBitmap& bm, const SkPaint& paint) {
-    sk_sp<SkData> pngData = encode(bm);
-    if (!pngData) {
-        return;
-    }
+    SkIPoint origin = bm.pixelRefOrigin();
+    SkString imageKey = SkStringPrintf("bitmap %u %d %d %d %d", bm.getGenerationID(),
+                                       origin.x(), origin.y(), bm.width(), bm.height());
+    SkString imageID;
+    if (const SkString* id = fResourceBucket->findResource(imageKey)) {
+        imageID = *id;
+    } else {
+        sk_sp<SkData> pngData = encode(bm);
+        if (!pngData) {
+            return;
+        }
 
-    size_t b64Size = SkBase64::Encode(pngData->data(), pngData->size(), nullptr);
-    SkAutoTMalloc<char> b64Data(b64Size);
-    SkBase64::Encode(pngData->data(), pngData->size(), b64Data.get());
+        size_t b64Size = SkBase64::Encode(pngData->data(), pngData->size(), nullptr);
+        SkAutoTMalloc<char> b64Data(b64Size);
+        SkBase64::Encode(pngData->data(), pngData->size(), b64Data.get());
 
-    SkString svgImageData("data:image/png;base64,");
-    svgImageData.append(b64Data.get(), b64Size);
+        SkString svgImageData("data:image/png;base64,");
+        svgImageData.append(b64Data.get(), b64Size);
 
-    SkString imageID = fResourceBucket->addImage();
-    {
-        AutoElement defs("defs", fWriter);
+        imageID = fResourceBucket->addImage();
         {
-            AutoElement image("image", fWriter);
-            image.addAttribute("id", imageID);
-            image.addAttribute("width", bm.width());
-            image.addAttribute("height", bm.height());
-            image.addAttribute("xlink:href", svgImageData);
+            AutoElement defs("defs", fWriter);
+            {
+                AutoElement image("image", fWriter);
+                image.addAttribute("id", imageID);
+                image.addAttribute("width", bm.width());
+                image.addAttribute("height", bm.height());
+                image.addAttribute("xlink:href", svgImageData);
+            }
         }
+        fResourceBucket->addResource(imageKey, imageID);
     }
 
     {
@@ -9,13 +9,18 @@
 #define SkSVGDevice_DEFINED
 
 #include "include/private/SkTemplates.h"
+#include "include/utils/SkParsePath.h"
 #include "src/core/SkClipStackDevice.h"
 
 class SkXMLWriter;
 
 class SkSVGDevice : public SkClipStackDevice {
 public:
-    static sk_sp<SkBaseDevice> Make(const SkISize& size, std::unique_ptr<SkXMLWriter>);
+    // Paths are written with the given SkParsePath::ToSVGString() encoding and precision.
+    static sk_sp<SkBaseDevice> Make(
+            const SkISize& size, std::unique_ptr<SkXMLWriter>,
+            SkParsePath::PathEncoding = SkParsePath::PathEncoding::Absolute,
+            int pathDecimalPlaces = -1);
 
 protected:
     void drawPaint(const SkPaint& paint) override;
@@ -42,7 +47,8 @@ protected:
                     const SkPaint&) override;
 
 private:
-    SkSVGDevice(const SkISize& size, std::unique_ptr<SkXMLWriter>);
+    SkSVGDevice(const SkISize& size, std::unique_ptr<SkXMLWriter>, SkParsePath::PathEncoding,
+                int pathDecimalPlaces);
     ~SkSVGDevice() override;
 
     struct MxCp;
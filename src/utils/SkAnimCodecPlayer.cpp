@@ -7,15 +7,247 @@
 
 #include "include/codec/SkCodec.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
+#include "include/private/SkMutex.h"
+#include "include/private/SkTHash.h"
+#include "include/private/SkWeakRefCnt.h"
 #include "include/utils/SkAnimCodecPlayer.h"
 #include "src/codec/SkCodecImageGenerator.h"
+#include "src/core/SkNextID.h"
+#include "src/core/SkResourceCache.h"
 #include <algorithm>
+#include <atomic>
 
-SkAnimCodecPlayer::SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec) : fCodec(std::move(codec)) {
-    fImageInfo = fCodec->getInfo();
-    fFrameInfos = fCodec->getFrameInfo();
-    fImages.resize(fFrameInfos.size());
+namespace {
+static unsigned gAnimFrameKeyNamespaceLabel;
+
+static uint64_t shared_id(uint32_t decoderID) {
+    uint64_t sharedID = SkSetFourByteTag('a', 'n', 'i', 'm');
+    return (sharedID << 32) | decoderID;
+}
+
+struct AnimFrameKey : public SkResourceCache::Key {
+    AnimFrameKey(uint32_t decoderID, int frameIndex)
+        : fDecoderID(decoderID)
+        , fFrameIndex(frameIndex) {
+        this->init(&gAnimFrameKeyNamespaceLabel, shared_id(decoderID),
+                   sizeof(fDecoderID) + sizeof(fFrameIndex));
+    }
+
+    uint32_t fDecoderID;
+    int32_t  fFrameIndex;
+};
+
+struct AnimFrameRec : public SkResourceCache::Rec {
+    AnimFrameRec(const AnimFrameKey& key, sk_sp<SkImage> image, size_t bytes)
+        : fKey(key), fImage(std::move(image)), fBytes(bytes) {}
+
+    AnimFrameKey   fKey;
+    sk_sp<SkImage> fImage;
+    size_t         fBytes;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override { return sizeof(*this) + fBytes; }
+    const char* getCategory() const override { return "anim-frame"; }
+    SkDiscardableMemory* diagnostic_only_getDiscardable() const override { return nullptr; }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* context) {
+        const AnimFrameRec& rec = static_cast<const AnimFrameRec&>(baseRec);
+        *static_cast<sk_sp<SkImage>*>(context) = rec.fImage;
+        return true;
+    }
+};
+} // namespace
+
+/**
+ *  Decodes the frames of one animated image into the SkResourceCache, for any number of players
+ *  and threads. Decoders made from an SkData are registered by it, so that players of the same
+ *  SkData find and share them.
+ */
+class SkAnimCodecPlayer::Decoder : public SkWeakRefCnt {
+public:
+    // Returns the decoder registered for data, if there is one.
+    static sk_sp<Decoder> Find(const SkData* data) {
+        SkAutoMutexExclusive lock(RegistryMutex());
+        Decoder** decoder = Registry().find(data);
+        // A decoder that is going away can't be shared.
+        if (decoder && (*decoder)->try_ref()) {
+            return sk_sp<Decoder>(*decoder);
+        }
+        return nullptr;
+    }
+
+    // Makes a decoder for codec, registered by data if that isn't null. If another decoder was
+    // registered for data in the meantime, that one is returned instead.
+    static sk_sp<Decoder> Make(std::unique_ptr<SkCodec> codec, sk_sp<SkData> data) {
+        if (!data) {
+            return sk_sp<Decoder>(new Decoder(std::move(codec), nullptr));
+        }
+        SkAutoMutexExclusive lock(RegistryMutex());
+        Decoder** existing = Registry().find(data.get());
+        if (existing && (*existing)->try_ref()) {
+            return sk_sp<Decoder>(*existing);
+        }
+        if (existing) {
+            (*existing)->weak_unref();
+        }
+        sk_sp<Decoder> decoder(new Decoder(std::move(codec), data));
+        decoder->weak_ref();
+        Registry().set(data.get(), decoder.get());
+        return decoder;
+    }
+
+    const SkImageInfo& info() const { return fInfo; }
+    const std::vector<SkCodec::FrameInfo>& frameInfos() const { return fFrameInfos; }
+
+    // Returns the frame at index, decoding it (and the frames it depends on) if it isn't cached.
+    sk_sp<SkImage> frame(int index) {
+        SkASSERT((unsigned)index < fFrameInfos.size());
+        if (sk_sp<SkImage> image = this->findFrame(index)) {
+            return image;
+        }
+        SkAutoMutexExclusive lock(fCodecMutex);
+        // Another thread (e.g. a lookahead) may have decoded it while we waited.
+        if (sk_sp<SkImage> image = this->findFrame(index)) {
+            return image;
+        }
+
+        // Walk back to the newest frame this one depends on that is still cached, and decode
+        // forward from it, caching each frame on the way.
+        std::vector<int> chain;
+        sk_sp<SkImage> prior;
+        for (int i = index; i != SkCodec::kNoFrame; i = fFrameInfos[i].fRequiredFrame) {
+            if ((prior = this->findFrame(i))) {
+                break;
+            }
+            chain.push_back(i);
+        }
+        while (!chain.empty()) {
+            prior = this->decodeFrame(chain.back(), prior);
+            if (!prior) {
+                return nullptr;
+            }
+            chain.pop_back();
+        }
+        return prior;
+    }
+
+    // Decodes the frame at index on executor, unless it's cached or another is being decoded.
+    void decodeAhead(SkExecutor* executor, int index) {
+        int idle = -1;
+        if (this->findFrame(index) || !fDecodingAhead.compare_exchange_strong(idle, index)) {
+            return;
+        }
+        sk_sp<Decoder> self = sk_ref_sp(this);
+        executor->add([self, index] {
+            self->frame(index);
+            self->fDecodingAhead.store(-1);
+        });
+    }
+
+private:
+    Decoder(std::unique_ptr<SkCodec> codec, sk_sp<SkData> data)
+        : fCodec(std::move(codec))
+        , fData(std::move(data))
+        , fInfo(fCodec->getInfo())
+        , fFrameInfos(fCodec->getFrameInfo())
+        , fID(SkNextID::ImageID()) {}
+
+    static SkMutex& RegistryMutex() {
+        static SkMutex gMutex;
+        return gMutex;
+    }
+    static SkTHashMap<const SkData*, Decoder*>& Registry() {
+        static auto* gRegistry = new SkTHashMap<const SkData*, Decoder*>;
+        return *gRegistry;
+    }
+
+    void weak_dispose() const override {
+        SkResourceCache::PostPurgeSharedID(shared_id(fID));
+        if (fData) {
+            SkAutoMutexExclusive lock(RegistryMutex());
+            Decoder** registered = Registry().find(fData.get());
+            if (registered && *registered == this) {
+                Registry().remove(fData.get());
+                this->weak_unref();
+            }
+        }
+    }
+
+    sk_sp<SkImage> findFrame(int index) const {
+        sk_sp<SkImage> image;
+        SkResourceCache::Find(AnimFrameKey(fID, index), AnimFrameRec::Visitor, &image);
+        return image;
+    }
+
+    // Decodes the frame at index on top of prior, the frame it depends on (if any).
+    sk_sp<SkImage> decodeFrame(int index, const sk_sp<SkImage>& prior) {
+        size_t rb = fInfo.minRowBytes();
+        size_t size = fInfo.computeByteSize(rb);
+        auto data = SkData::MakeUninitialized(size);
+
+        SkCodec::Options opts;
+        opts.fFrameIndex = index;
+        SkPixmap priorPM;
+        if (prior && prior->peekPixels(&priorPM)) {
+            sk_careful_memcpy(data->writable_data(), priorPM.addr(), size);
+            opts.fPriorFrame = fFrameInfos[index].fRequiredFrame;
+        }
+        if (SkCodec::kSuccess != fCodec->getPixels(fInfo, data->writable_data(), rb, &opts)) {
+            return nullptr;
+        }
+        sk_sp<SkImage> image = SkImage::MakeRasterData(fInfo, std::move(data), rb);
+        SkResourceCache::Add(new AnimFrameRec(AnimFrameKey(fID, index), image, size));
+        return image;
+    }
+
+    SkMutex                               fCodecMutex;
+    const std::unique_ptr<SkCodec>        fCodec;
+    const sk_sp<SkData>                   fData;
+    const SkImageInfo                     fInfo;
+    const std::vector<SkCodec::FrameInfo> fFrameInfos;
+    const uint32_t                        fID;
+    // The frame being decoded on an executor, or -1.
+    std::atomic<int>                      fDecodingAhead{-1};
+
+    typedef SkWeakRefCnt INHERITED;
+};
+
+SkAnimCodecPlayer::SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec, SkExecutor* executor)
+        : fExecutor(executor) {
+    this->init(std::move(codec), nullptr);
+}
+
+SkAnimCodecPlayer::SkAnimCodecPlayer(sk_sp<SkData> data, SkExecutor* executor)
+        : fExecutor(executor) {
+    if ((fDecoder = Decoder::Find(data.get()))) {
+        this->initFrames();
+    } else if (std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(data)) {
+        this->init(std::move(codec), std::move(data));
+    }
+}
+
+void SkAnimCodecPlayer::init(std::unique_ptr<SkCodec> codec, sk_sp<SkData> data) {
+    fImageInfo = codec->getInfo();
+
+    uint32_t dur = 0;
+    for (const auto& f : codec->getFrameInfo()) {
+        dur += f.fDuration;
+    }
+    if (!dur) {
+        // Static image -- may or may not have returned a single frame info.
+        fImage = SkImage::MakeFromGenerator(
+                SkCodecImageGenerator::MakeFromCodec(std::move(codec)));
+        return;
+    }
+    fDecoder = Decoder::Make(std::move(codec), std::move(data));
+    this->initFrames();
+}
+
+void SkAnimCodecPlayer::initFrames() {
+    fImageInfo = fDecoder->info();
+    fFrameInfos = fDecoder->frameInfos();
 
     // change the interpretation of fDuration to a end-time for that frame
     size_t dur = 0;
@@ -24,14 +256,6 @@ SkAnimCodecPlayer::SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec) : fCodec(st
         f.fDuration = dur;
     }
     fTotalDuration = dur;
-
-    if (!fTotalDuration) {
-        // Static image -- may or may not have returned a single frame info.
-        fFrameInfos.clear();
-        fImages.clear();
-        fImages.push_back(SkImage::MakeFromGenerator(
-                              SkCodecImageGenerator::MakeFromCodec(std::move(fCodec))));
-    }
 }
 
 SkAnimCodecPlayer::~SkAnimCodecPlayer() {}
@@ -40,41 +264,18 @@ SkISize SkAnimCodecPlayer::dimensions() {
     return { fImageInfo.width(), fImageInfo.height() };
 }
 
-sk_sp<SkImage> SkAnimCodecPlayer::getFrameAt(int index) {
-    SkASSERT((unsigned)index < fFrameInfos.size());
-
-    if (fImages[index]) {
-        return fImages[index];
+sk_sp<SkImage> SkAnimCodecPlayer::getFrame() {
+    if (!fDecoder) {
+        return fImage;
     }
-
-    size_t rb = fImageInfo.minRowBytes();
-    size_t size = fImageInfo.computeByteSize(rb);
-    auto data = SkData::MakeUninitialized(size);
-
-    SkCodec::Options opts;
-    opts.fFrameIndex = index;
-
-    const int requiredFrame = fFrameInfos[index].fRequiredFrame;
-    if (requiredFrame != SkCodec::kNoFrame) {
-        auto requiredImage = fImages[requiredFrame];
-        SkPixmap requiredPM;
-        if (requiredImage && requiredImage->peekPixels(&requiredPM)) {
-            sk_careful_memcpy(data->writable_data(), requiredPM.addr(), size);
-            opts.fPriorFrame = requiredFrame;
+    if (fImageIndex != fCurrIndex) {
+        fImage = fDecoder->frame(fCurrIndex);
+        fImageIndex = fCurrIndex;
+        if (fExecutor) {
+            fDecoder->decodeAhead(fExecutor, (fCurrIndex + 1) % (int)fFrameInfos.size());
         }
     }
-    if (SkCodec::kSuccess == fCodec->getPixels(fImageInfo, data->writable_data(), rb, &opts)) {
-        return fImages[index] = SkImage::MakeRasterData(fImageInfo, std::move(data), rb);
-    }
-    return nullptr;
-}
-
-sk_sp<SkImage> SkAnimCodecPlayer::getFrame() {
-    SkASSERT(fTotalDuration > 0 || fImages.size() == 1);
-
-    return fTotalDuration > 0
-        ? this->getFrameAt(fCurrIndex)
-        : fImages.front();
+    return fImage;
 }
 
 bool SkAnimCodecPlayer::seek(uint32_t msec) {
@@ -92,5 +293,3 @@ bool SkAnimCodecPlayer::seek(uint32_t msec) {
     fCurrIndex = lower - fFrameInfos.begin();
     return fCurrIndex != prevIndex;
 }
-
-
@@ -0,0 +1,1052 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/utils/SkCanvasStream.h"
+
+#include "include/core/SkData.h"
+#include "include/core/SkDrawable.h"
+#include "include/core/SkImageFilter.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkRRect.h"
+#include "include/core/SkRSXform.h"
+#include "include/core/SkRegion.h"
+#include "include/core/SkStream.h"
+#include "include/core/SkTextBlob.h"
+#include "include/private/SkTemplates.h"
+#include "src/core/SkAutoMalloc.h"
+#include "src/core/SkCanvasPriv.h"
+#include "src/core/SkDrawShadowInfo.h"
+#include "src/core/SkReadBuffer.h"
+#include "src/core/SkRemoteGlyphCache.h"
+#include "src/core/SkSafeMath.h"
+#include "src/core/SkTextBlobPriv.h"
+#include "src/core/SkWriteBuffer.h"
+
+enum class SkCanvasStreamRecorder::Op : uint32_t {
+    kSave,
+    kSaveLayer,
+    kSaveBehind,
+    kRestore,
+    kConcat,
+    kSetMatrix,
+    kTranslate,
+    kClipRect,
+    kClipRRect,
+    kClipPath,
+    kClipRegion,
+    kDrawPaint,
+    kDrawBehind,
+    kDrawPoints,
+    kDrawRect,
+    kDrawRegion,
+    kDrawOval,
+    kDrawArc,
+    kDrawRRect,
+    kDrawDRRect,
+    kDrawPath,
+    kDrawTextBlob,
+    kDrawPatch,
+    kDrawVertices,
+    kDrawImage,
+    kDrawImageRect,
+    kDrawImageNine,
+    kDrawImageLattice,
+    kDrawAtlas,
+    kDrawEdgeAAQuad,
+    kDrawEdgeAAImageSet,
+    kDrawAnnotation,
+    kDrawShadowRec,
+    kFlush,
+
+    kLast = kFlush,
+};
+
+using Op = SkCanvasStreamRecorder::Op;
+
+namespace {
+// Which of the optional parts of a saveLayer follow.
+enum SaveLayerParts : uint32_t {
+    kBounds_SaveLayerPart     = 1 << 0,
+    kPaint_SaveLayerPart      = 1 << 1,
+    kBackdrop_SaveLayerPart   = 1 << 2,
+    kClipMask_SaveLayerPart   = 1 << 3,
+    kClipMatrix_SaveLayerPart = 1 << 4,
+};
+
+// Which of the optional arrays of a patch or atlas follow.
+enum ArrayParts : uint32_t {
+    kColors_ArrayPart    = 1 << 0,
+    kTexCoords_ArrayPart = 1 << 1,
+    kCull_ArrayPart      = 1 << 2,
+};
+}  // namespace
+
+static uint32_t pack_clip(SkClipOp op, bool doAA) {
+    return (static_cast<uint32_t>(op) << 1) | doAA;
+}
+
+static void write_rrect(SkWriteBuffer& buffer, const SkRRect& rrect) {
+    char storage[SkRRect::kSizeInMemory];
+    rrect.writeToMemory(storage);
+    buffer.writePad32(storage, sizeof(storage));
+}
+
+static void write_optional_paint(SkWriteBuffer& buffer, const SkPaint* paint) {
+    buffer.writeBool(paint != nullptr);
+    if (paint) {
+        buffer.writePaint(*paint);
+    }
+}
+
+static void write_optional_rect(SkWriteBuffer& buffer, const SkRect* rect) {
+    buffer.writeBool(rect != nullptr);
+    if (rect) {
+        buffer.writeRect(*rect);
+    }
+}
+
+SkCanvasStreamRecorder::SkCanvasStreamRecorder(int width, int height, SkWStream* stream)
+    : SkCanvasStreamRecorder(width, height, stream, Options()) {}
+
+SkCanvasStreamRecorder::SkCanvasStreamRecorder(int width, int height, SkWStream* stream,
+                                               const Options& options)
+    : INHERITED(width, height)
+    , fStream(stream)
+    , fOptions(options) {
+    this->resetBuffer();
+}
+
+SkCanvasStreamRecorder::~SkCanvasStreamRecorder() {
+    this->sendChunk();
+}
+
+void SkCanvasStreamRecorder::resetBuffer() {
+    fBuffer.reset(new SkBinaryWriteBuffer);
+    SkSerialProcs procs;
+    procs.fTypefaceProc = SerializeTypeface;
+    procs.fTypefaceCtx = this;
+    procs.fImageProc = SerializeImage;
+    procs.fImageCtx = this;
+    fBuffer->setSerialProcs(procs);
+}
+
+void SkCanvasStreamRecorder::sendChunk() {
+    if (size_t size = fBuffer->bytesWritten()) {
+        fStream->write32(SkToU32(size));
+        fBuffer->writeToStream(fStream);
+        fStream->flush();
+        this->resetBuffer();
+    }
+}
+
+// Typefaces and images are written as their unique ID, followed, the first time, by their data.
+sk_sp<SkData> SkCanvasStreamRecorder::SerializeTypeface(SkTypeface* typeface, void* ctx) {
+    auto recorder = static_cast<SkCanvasStreamRecorder*>(ctx);
+    SkDynamicMemoryWStream stream;
+    stream.write32(typeface->uniqueID());
+    if (!recorder->fSentTypefaces.contains(typeface->uniqueID())) {
+        sk_sp<SkData> data = recorder->fOptions.fStrikeServer
+                ? recorder->fOptions.fStrikeServer->serializeTypeface(typeface)
+                : typeface->serialize();
+        if (!data) {
+            return nullptr;
+        }
+        stream.write(data->data(), data->size());
+        recorder->fSentTypefaces.add(typeface->uniqueID());
+    }
+    return stream.detachAsData();
+}
+
+sk_sp<SkData> SkCanvasStreamRecorder::SerializeImage(SkImage* image, void* ctx) {
+    auto recorder = static_cast<SkCanvasStreamRecorder*>(ctx);
+    SkDynamicMemoryWStream stream;
+    stream.write32(image->uniqueID());
+    if (!recorder->fSentImages.contains(image->uniqueID())) {
+        sk_sp<SkData> data = image->encodeToData();
+        if (!data) {
+            return nullptr;
+        }
+        stream.write(data->data(), data->size());
+        recorder->fSentImages.add(image->uniqueID());
+    }
+    return stream.detachAsData();
+}
+
+SkBinaryWriteBuffer& SkCanvasStreamRecorder::beginOp(Op op) {
+    fBuffer->writeUInt(static_cast<uint32_t>(op));
+    return *fBuffer;
+}
+
+void SkCanvasStreamRecorder::endOp() {
+    if (fBuffer->bytesWritten() >= fOptions.fChunkSize) {
+        this->sendChunk();
+    }
+}
+
+void SkCanvasStreamRecorder::onFlush() {
+    this->beginOp(Op::kFlush);
+    this->sendChunk();
+}
+
+void SkCanvasStreamRecorder::willSave() {
+    this->beginOp(Op::kSave);
+    this->endOp();
+}
+
+SkCanvas::SaveLayerStrategy SkCanvasStreamRecorder::getSaveLayerStrategy(
+        const SaveLayerRec& rec) {
+    uint32_t parts = (rec.fBounds     ? kBounds_SaveLayerPart     : 0) |
+                     (rec.fPaint      ? kPaint_SaveLayerPart      : 0) |
+                     (rec.fBackdrop   ? kBackdrop_SaveLayerPart   : 0) |
+                     (rec.fClipMask   ? kClipMask_SaveLayerPart   : 0) |
+                     (rec.fClipMatrix ? kClipMatrix_SaveLayerPart : 0);
+    SkWriteBuffer& buffer = this->beginOp(Op::kSaveLayer);
+    buffer.writeUInt(parts);
+    buffer.writeUInt(rec.fSaveLayerFlags);
+    if (rec.fBounds) {
+        buffer.writeRect(*rec.fBounds);
+    }
+    if (rec.fPaint) {
+        buffer.writePaint(*rec.fPaint);
+    }
+    if (rec.fBackdrop) {
+        buffer.writeFlattenable(rec.fBackdrop);
+    }
+    if (rec.fClipMask) {
+        buffer.writeImage(rec.fClipMask);
+    }
+    if (rec.fClipMatrix) {
+        buffer.writeMatrix(*rec.fClipMatrix);
+    }
+    this->endOp();
+    return kNoLayer_SaveLayerStrategy;
+}
+
+bool SkCanvasStreamRecorder::onDoSaveBehind(const SkRect* subset) {
+    write_optional_rect(this->beginOp(Op::kSaveBehind), subset);
+    this->endOp();
+    return false;
+}
+
+void SkCanvasStreamRecorder::willRestore() {
+    this->beginOp(Op::kRestore);
+    this->endOp();
+}
+
+void SkCanvasStreamRecorder::didConcat(const SkMatrix& matrix) {
+    this->beginOp(Op::kConcat).writeMatrix(matrix);
+    this->endOp();
+}
+
+void SkCanvasStreamRecorder::didSetMatrix(const SkMatrix& matrix) {
+    this->beginOp(Op::kSetMatrix).writeMatrix(matrix);
+    this->endOp();
+}
+
+void SkCanvasStreamRecorder::didTranslate(SkScalar dx, SkScalar dy) {
+    this->beginOp(Op::kTranslate).writePoint({dx, dy});
+    this->endOp();
+}
+
+void SkCanvasStreamRecorder::onClipRect(const SkRect& rect, SkClipOp op, ClipEdgeStyle style) {
+    SkWriteBuffer& buffer = this->beginOp(Op::kClipRect);
+    buffer.writeRect(rect);
+    buffer.writeUInt(pack_clip(op, kSoft_ClipEdgeStyle == style));
+    this->endOp();
+    this->INHERITED::onClipRect(rect, op, style);
+}
+
+void SkCanvasStreamRecorder::onClipRRect(const SkRRect& rrect, SkClipOp op, ClipEdgeStyle style) {
+    SkWriteBuffer& buffer = this->beginOp(Op::kClipRRect);
+    write_rrect(buffer, rrect);
+    buffer.writeUInt(pack_clip(op, kSoft_ClipEdgeStyle == style));
+    this->endOp();
+    this->INHERITED::onClipRRect(rrect, op, style);
+}
+
+void SkCanvasStreamRecorder::onClipPath(const SkPath& path, SkClipOp op, ClipEdgeStyle style) {
+    SkWriteBuffer& buffer = this->beginOp(Op::kClipPath);
+    buffer.writePath(path);
+    buffer.writeUInt(pack_clip(op, kSoft_ClipEdgeStyle == style));
+    this->endOp();
+    this->INHERITED::onClipPath(path, op, style);
+}
+
+void SkCanvasStreamRecorder::onClipRegion(const SkRegion& deviceRgn, SkClipOp op) {
+    SkWriteBuffer& buffer = this->beginOp(Op::kClipRegion);
+    buffer.writeRegion(deviceRgn);
+    buffer.writeUInt(pack_clip(op, false));
+    this->endOp();
+    this->INHERITED::onClipRegion(deviceRgn, op);
+}
+
+void SkCanvasStreamRecorder::onDrawPaint(const SkPaint& paint) {
+    this->beginOp(Op::kDrawPaint).writePaint(paint);
+    this->endOp();
+}
+
+void SkCanvasStreamRecorder::onDrawBehind(const SkPaint& paint) {
+    this->beginOp(Op::kDrawBehind).writePaint(paint);
+    this->endOp();
+}
+
+void SkCanvasStreamRecorder::onDrawPoints(PointMode mode, size_t count, const SkPoint pts[],
+                                          const SkPaint& paint) {
+    SkWriteBuffer& buffer = this->beginOp(Op::kDrawPoints);
+    buffer.writeUInt(mode);
+    buffer.writePointArray(pts, SkToU32(count));
+    buffer.writePaint(paint);
+    this->endOp();
+}
+
+void SkCanvasStreamRecorder::onDrawRect(const SkRect& rect, const SkPaint& paint) {
+    SkWriteBuffer& buffer = this->beginOp(Op::kDrawRect);
+    buffer.writeRect(rect);
+    buffer.writePaint(paint);
+    this->endOp();
+}
+
+void SkCanvasStreamRecorder::onDrawRegion(const SkRegion& region, const SkPaint& paint) {
+    SkWriteBuffer& buffer = this->beginOp(Op::kDrawRegion);
+    buffer.writeRegion(region);
+    buffer.writePaint(paint);
+    this->endOp();
+}
+
+void SkCanvasStreamRecorder::onDrawOval(const SkRect& oval, const SkPaint& paint) {
+    SkWriteBuffer& buffer = this->beginOp(Op::kDrawOval);
+    buffer.writeRect(oval);
+    buffer.writePaint(paint);
+    this->endOp();
+}
+
+void SkCanvasStreamRecorder::onDrawArc(const SkRect& oval, SkScalar startAngle,
+                                       SkScalar sweepAngle, bool useCenter,
+                                       const SkPaint& paint) {
+    SkWriteBuffer& buffer = this->beginOp(Op::kDrawArc);
+    buffer.writeRect(oval);
+    buffer.writeScalar(startAngle);
+    buffer.writeScalar(sweepAngle);
+    buffer.writeBool(useCenter);
+    buffer.writePaint(paint);
+    this->endOp();
+}
+
+void SkCanvasStreamRecorder::onDrawRRect(const SkRRect& rrect, const SkPaint& paint) {
+    SkWriteBuffer& buffer = this->beginOp(Op::kDrawRRect);
+    write_rrect(buffer, rrect);
+    buffer.writePaint(paint);
+    this->endOp();
+}
+
+void SkCanvasStreamRecorder::onDrawDRRect(const SkRRect& outer, const SkRRect& inner,
+                                          const SkPaint& paint) {
+    SkWriteBuffer& buffer = this->beginOp(Op::kDrawDRRect);
+    write_rrect(buffer, outer);
+    write_rrect(buffer, inner);
+    buffer.writePaint(paint);
+    this->endOp();
+}
+
+void SkCanvasStreamRecorder::onDrawPath(const SkPath& path, const SkPaint& paint) {
+    SkWriteBuffer& buffer = this->beginOp(Op::kDrawPath);
+    buffer.writePath(path);
+    buffer.writePaint(paint);
+    this->endOp();
+}
+
+void SkCanvasStreamRecorder::onDrawTextBlob(const SkTextBlob* blob, SkScalar x, SkScalar y,
+                                            const SkPaint& paint) {
+    SkWriteBuffer& buffer = this->beginOp(Op::kDrawTextBlob);
+    SkTextBlobPriv::Flatten(*blob, buffer);
+    buffer.writePoint({x, y});
+    buffer.writePaint(paint);
+    this->endOp();
+}
+
+void SkCanvasStreamRecorder::onDrawPatch(const SkPoint cubics[12], const SkColor colors[4],
+                                         const SkPoint texCoords[4], SkBlendMode mode,
+                                         const SkPaint& paint) {
+    SkWriteBuffer& buffer = this->beginOp(Op::kDrawPatch);
+    buffer.writeUInt((colors ? kColors_ArrayPart : 0) | (texCoords ? kTexCoords_ArrayPart : 0));
+    buffer.writePointArray(cubics, 12);
+    if (colors) {
+        buffer.writeColorArray(colors, 4);
+    }
+    if (texCoords) {
+        buffer.writePointArray(texCoords, 4);
+    }
+    buffer.writeUInt(static_cast<uint32_t>(mode));
+    buffer.writePaint(paint);
+    this->endOp();
+}
+
+void SkCanvasStreamRecorder::onDrawVerticesObject(const SkVertices* vertices,
+                                                  const SkVertices::Bone bones[], int boneCount,
+                                                  SkBlendMode mode, const SkPaint& paint) {
+    SkWriteBuffer& buffer = this->beginOp(Op::kDrawVertices);
+    buffer.writeDataAsByteArray(vertices->encode().get());
+    buffer.writeByteArray(bones, boneCount * sizeof(SkVertices::Bone));
+    buffer.writeUInt(static_cast<uint32_t>(mode));
+    buffer.writePaint(paint);
+    this->endOp();
+}
+
+void SkCanvasStreamRecorder::onDrawImage(const SkImage* image, SkScalar left, SkScalar top,
+                                         const SkPaint* paint) {
+    SkWriteBuffer& buffer = this->beginOp(Op::kDrawImage);
+    buffer.writeImage(image);
+    buffer.writePoint({left, top});
+    write_optional_paint(buffer, paint);
+    this->endOp();
+}
+
+void SkCanvasStreamRecorder::onDrawImageRect(const SkImage* image, const SkRect* src,
+                                             const SkRect& dst, const SkPaint* paint,
+                                             SrcRectConstraint constraint) {
+    SkWriteBuffer& buffer = this->beginOp(Op::kDrawImageRect);
+    buffer.writeImage(image);
+    write_optional_rect(buffer, src);
+    buffer.writeRect(dst);
+    write_optional_paint(buffer, paint);
+    buffer.writeUInt(constraint);
+    this->endOp();
+}
+
+void SkCanvasStreamRecorder::onDrawImageNine(const SkImage* image, const SkIRect& center,
+                                             const SkRect& dst, const SkPaint* paint) {
+    SkWriteBuffer& buffer = this->beginOp(Op::kDrawImageNine);
+    buffer.writeImage(image);
+    buffer.writeIRect(center);
+    buffer.writeRect(dst);
+    write_optional_paint(buffer, paint);
+    this->endOp();
+}
+
+void SkCanvasStreamRecorder::onDrawImageLattice(const SkImage* image, const Lattice& lattice,
+                                                const SkRect& dst, const SkPaint* paint) {
+    SkWriteBuffer& buffer = this->beginOp(Op::kDrawImageLattice);
+    buffer.writeImage(image);
+    SkCanvasPriv::WriteLattice(buffer, lattice);
+    buffer.writeRect(dst);
+    write_optional_paint(buffer, paint);
+    this->endOp();
+}
+
+// Bitmaps are sent as images, which the player gets back as images.
+void SkCanvasStreamRecorder::onDrawBitmap(const SkBitmap& bitmap, SkScalar left, SkScalar top,
+                                          const SkPaint* paint) {
+    if (sk_sp<SkImage> image = SkImage::MakeFromBitmap(bitmap)) {
+        this->onDrawImage(image.get(), left, top, paint);
+    }
+}
+
+void SkCanvasStreamRecorder::onDrawBitmapRect(const SkBitmap& bitmap, const SkRect* src,
+                                              const SkRect& dst, const SkPaint* paint,
+                                              SrcRectConstraint constraint) {
+    if (sk_sp<SkImage> image = SkImage::MakeFromBitmap(bitmap)) {
+        this->onDrawImageRect(image.get(), src, dst, paint, constraint);
+    }
+}
+
+void SkCanvasStreamRecorder::onDrawBitmapNine(const SkBitmap& bitmap, const SkIRect& center,
+                                              const SkRect& dst, const SkPaint* paint) {
+    if (sk_sp<SkImage> image = SkImage::MakeFromBitmap(bitmap)) {
+        this->onDrawImageNine(image.get(), center, dst, paint);
+    }
+}
+
+void SkCanvasStreamRecorder::onDrawBitmapLattice(const SkBitmap& bitmap, const Lattice& lattice,
+                                                 const SkRect& dst, const SkPaint* paint) {
+    if (sk_sp<SkImage> image = SkImage::MakeFromBitmap(bitmap)) {
+        this->onDrawImageLattice(image.get(), lattice, dst, paint);
+    }
+}
+
+void SkCanvasStreamRecorder::onDrawAtlas(const SkImage* atlas, const SkRSXform xforms[],
+                                         const SkRect texs[], const SkColor colors[], int count,
+                                         SkBlendMode mode, const SkRect* cull,
+                                         const SkPaint* paint) {
+    SkWriteBuffer& buffer = this->beginOp(Op::kDrawAtlas);
+    buffer.writeImage(atlas);
+    buffer.writeUInt((colors ? kColors_ArrayPart : 0) | (cull ? kCull_ArrayPart : 0));
+    buffer.writeByteArray(xforms, count * sizeof(SkRSXform));
+    buffer.writeByteArray(texs, count * sizeof(SkRect));
+    if (colors) {
+        buffer.writeColorArray(colors, count);
+    }
+    buffer.writeUInt(static_cast<uint32_t>(mode));
+    if (cull) {
+        buffer.writeRect(*cull);
+    }
+    write_optional_paint(buffer, paint);
+    this->endOp();
+}
+
+void SkCanvasStreamRecorder::onDrawEdgeAAQuad(const SkRect& rect, const SkPoint clip[4],
+                                              QuadAAFlags aaFlags, SkColor color,
+                                              SkBlendMode mode) {
+    SkWriteBuffer& buffer = this->beginOp(Op::kDrawEdgeAAQuad);
+    buffer.writeRect(rect);
+    buffer.writePointArray(clip, clip ? 4 : 0);
+    buffer.writeUInt(aaFlags);
+    buffer.writeColor(color);
+    buffer.writeUInt(static_cast<uint32_t>(mode));
+    this->endOp();
+}
+
+void SkCanvasStreamRecorder::onDrawEdgeAAImageSet(const ImageSetEntry set[], int count,
+                                                  const SkPoint dstClips[],
+                                                  const SkMatrix preViewMatrices[],
+                                                  const SkPaint* paint,
+                                                  SrcRectConstraint constraint) {
+    int totalDstClipCount, totalMatrixCount;
+    SkCanvasPriv::GetDstClipAndMatrixCounts(set, count, &totalDstClipCount, &totalMatrixCount);
+
+    SkWriteBuffer& buffer = this->beginOp(Op::kDrawEdgeAAImageSet);
+    buffer.writeInt(count);
+    for (int i = 0; i < count; ++i) {
+        buffer.writeImage(set[i].fImage.get());
+        buffer.writeRect(set[i].fSrcRect);
+        buffer.writeRect(set[i].fDstRect);
+        buffer.writeInt(set[i].fMatrixIndex);
+        buffer.writeScalar(set[i].fAlpha);
+        buffer.writeUInt(set[i].fAAFlags);
+        buffer.writeBool(set[i].fHasClip);
+    }
+    buffer.writePointArray(dstClips, totalDstClipCount);
+    buffer.writeInt(totalMatrixCount);
+    for (int i = 0; i < totalMatrixCount; ++i) {
+        buffer.writeMatrix(preViewMatrices[i]);
+    }
+    write_optional_paint(buffer, paint);
+    buffer.writeUInt(constraint);
+    this->endOp();
+}
+
+void SkCanvasStreamRecorder::onDrawAnnotation(const SkRect& rect, const char key[],
+                                              SkData* value) {
+    SkWriteBuffer& buffer = this->beginOp(Op::kDrawAnnotation);
+    buffer.writeRect(rect);
+    buffer.writeString(key);
+    buffer.writeBool(value != nullptr);
+    if (value) {
+        buffer.writeDataAsByteArray(value);
+    }
+    this->endOp();
+}
+
+void SkCanvasStreamRecorder::onDrawShadowRec(const SkPath& path, const SkDrawShadowRec& rec) {
+    SkWriteBuffer& buffer = this->beginOp(Op::kDrawShadowRec);
+    buffer.writePath(path);
+    buffer.writePoint3(rec.fZPlaneParams);
+    buffer.writePoint3(rec.fLightPos);
+    buffer.writeScalar(rec.fLightRadius);
+    buffer.writeColor(rec.fAmbientColor);
+    buffer.writeColor(rec.fSpotColor);
+    buffer.writeUInt(rec.fFlags);
+    this->endOp();
+}
+
+// Drawables and pictures draw their commands through this canvas, and are sent as those.
+void SkCanvasStreamRecorder::onDrawDrawable(SkDrawable* drawable, const SkMatrix* matrix) {
+    this->INHERITED::onDrawDrawable(drawable, matrix);
+}
+
+void SkCanvasStreamRecorder::onDrawPicture(const SkPicture* picture, const SkMatrix* matrix,
+                                           const SkPaint* paint) {
+    this->INHERITED::onDrawPicture(picture, matrix, paint);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define BREAK_ON_READ_ERROR(r)  if (!r.isValid()) break
+
+static const SkPaint* read_optional_paint(SkReadBuffer& buffer, SkPaint* storage) {
+    if (!buffer.readBool()) {
+        return nullptr;
+    }
+    buffer.readPaint(storage, nullptr);
+    return storage;
+}
+
+static const SkRect* read_optional_rect(SkReadBuffer& buffer, SkRect* storage) {
+    if (!buffer.readBool()) {
+        return nullptr;
+    }
+    buffer.readRect(storage);
+    return storage;
+}
+
+static bool read_clip(SkReadBuffer& buffer, SkClipOp* op, bool* doAA) {
+    uint32_t packed = buffer.readUInt();
+    *op = static_cast<SkClipOp>(packed >> 1);
+    *doAA = SkToBool(packed & 1);
+    return buffer.validate(*op <= SkClipOp::kMax_EnumValue);
+}
+
+SkCanvasStreamPlayer::SkCanvasStreamPlayer(SkCanvas* canvas, SkStrikeClient* strikeClient)
+    : fCanvas(canvas)
+    , fStrikeClient(strikeClient) {}
+
+SkCanvasStreamPlayer::~SkCanvasStreamPlayer() {}
+
+sk_sp<SkTypeface> SkCanvasStreamPlayer::DeserializeTypeface(const void* data, size_t length,
+                                                            void* ctx) {
+    auto player = static_cast<SkCanvasStreamPlayer*>(ctx);
+    uint32_t id;
+    if (length < sizeof(id)) {
+        return nullptr;
+    }
+    memcpy(&id, data, sizeof(id));
+    if (length == sizeof(id)) {
+        sk_sp<SkTypeface>* typeface = player->fTypefaces.find(id);
+        return typeface ? *typeface : nullptr;
+    }
+    const void* typefaceData = SkTAddOffset<const void>(data, sizeof(id));
+    size_t typefaceLength = length - sizeof(id);
+    sk_sp<SkTypeface> typeface;
+    if (player->fStrikeClient) {
+        typeface = player->fStrikeClient->deserializeTypeface(typefaceData, typefaceLength);
+    } else {
+        SkMemoryStream stream(typefaceData, typefaceLength);
+        typeface = SkTypeface::MakeDeserialize(&stream);
+    }
+    player->fTypefaces.set(id, typeface);
+    return typeface;
+}
+
+sk_sp<SkImage> SkCanvasStreamPlayer::DeserializeImage(const void* data, size_t length,
+                                                      void* ctx) {
+    auto player = static_cast<SkCanvasStreamPlayer*>(ctx);
+    uint32_t id;
+    if (length < sizeof(id)) {
+        return nullptr;
+    }
+    memcpy(&id, data, sizeof(id));
+    if (length == sizeof(id)) {
+        sk_sp<SkImage>* image = player->fImages.find(id);
+        return image ? *image : nullptr;
+    }
+    sk_sp<SkImage> image = SkImage::MakeFromEncoded(
+            SkData::MakeWithCopy(SkTAddOffset<const void>(data, sizeof(id)), length - sizeof(id)));
+    if (image) {
+        player->fImages.set(id, image);
+    }
+    return image;
+}
+
+bool SkCanvasStreamPlayer::playChunk(const void* data, size_t size) {
+    SkReadBuffer buffer(data, size);
+    SkDeserialProcs procs;
+    procs.fTypefaceProc = DeserializeTypeface;
+    procs.fTypefaceCtx = this;
+    procs.fImageProc = DeserializeImage;
+    procs.fImageCtx = this;
+    buffer.setDeserialProcs(procs);
+
+    while (buffer.isValid() && !buffer.eof()) {
+        Op op = buffer.read32LE(Op::kLast);
+        if (buffer.isValid()) {
+            this->playOp(op, buffer);
+        }
+    }
+    return buffer.isValid();
+}
+
+bool SkCanvasStreamPlayer::play(SkStream* stream) {
+    uint32_t size;
+    while (stream->readU32(&size)) {
+        SkAutoMalloc chunk(size);
+        if (SkAlign4(size) != size || stream->read(chunk.get(), size) != size ||
+            !this->playChunk(chunk.get(), size)) {
+            return false;
+        }
+    }
+    return stream->isAtEnd();
+}
+
+void SkCanvasStreamPlayer::playOp(Op op, SkReadBuffer& buffer) {
+    SkCanvas* canvas = fCanvas;
+    SkPaint paint;
+    switch (op) {
+        case Op::kSave:
+            canvas->save();
+            break;
+        case Op::kSaveLayer: {
+            uint32_t parts = buffer.readUInt();
+            SkCanvas::SaveLayerFlags flags = buffer.readUInt();
+            SkRect bounds;
+            if (parts & kBounds_SaveLayerPart) {
+                buffer.readRect(&bounds);
+            }
+            if (parts & kPaint_SaveLayerPart) {
+                buffer.readPaint(&paint, nullptr);
+            }
+            sk_sp<SkImageFilter> backdrop;
+            if (parts & kBackdrop_SaveLayerPart) {
+                backdrop = buffer.readImageFilter();
+            }
+            sk_sp<SkImage> clipMask;
+            if (parts & kClipMask_SaveLayerPart) {
+                clipMask = buffer.readImage();
+            }
+            SkMatrix clipMatrix;
+            if (parts & kClipMatrix_SaveLayerPart) {
+                buffer.readMatrix(&clipMatrix);
+            }
+            BREAK_ON_READ_ERROR(buffer);
+
+            canvas->saveLayer(SkCanvas::SaveLayerRec(
+                    (parts & kBounds_SaveLayerPart) ? &bounds : nullptr,
+                    (parts & kPaint_SaveLayerPart) ? &paint : nullptr,
+                    backdrop.get(),
+                    clipMask.get(),
+                    (parts & kClipMatrix_SaveLayerPart) ? &clipMatrix : nullptr,
+                    flags));
+        } break;
+        case Op::kSaveBehind: {
+            SkRect storage;
+            const SkRect* subset = read_optional_rect(buffer, &storage);
+            BREAK_ON_READ_ERROR(buffer);
+            SkCanvasPriv::SaveBehind(canvas, subset);
+        } break;
+        case Op::kRestore:
+            canvas->restore();
+            break;
+        case Op::kConcat: {
+            SkMatrix matrix;
+            buffer.readMatrix(&matrix);
+            BREAK_ON_READ_ERROR(buffer);
+            canvas->concat(matrix);
+        } break;
+        case Op::kSetMatrix: {
+            SkMatrix matrix;
+            buffer.readMatrix(&matrix);
+            BREAK_ON_READ_ERROR(buffer);
+            canvas->setMatrix(matrix);
+        } break;
+        case Op::kTranslate: {
+            SkPoint delta;
+            buffer.readPoint(&delta);
+            BREAK_ON_READ_ERROR(buffer);
+            canvas->translate(delta.fX, delta.fY);
+        } break;
+        case Op::kClipRect: {
+            SkRect rect;
+            SkClipOp clipOp;
+            bool doAA;
+            buffer.readRect(&rect);
+            if (read_clip(buffer, &clipOp, &doAA)) {
+                canvas->clipRect(rect, clipOp, doAA);
+            }
+        } break;
+        case Op::kClipRRect: {
+            SkRRect rrect;
+            SkClipOp clipOp;
+            bool doAA;
+            buffer.readRRect(&rrect);
+            if (read_clip(buffer, &clipOp, &doAA)) {
+                canvas->clipRRect(rrect, clipOp, doAA);
+            }
+        } break;
+        case Op::kClipPath: {
+            SkPath path;
+            SkClipOp clipOp;
+            bool doAA;
+            buffer.readPath(&path);
+            if (read_clip(buffer, &clipOp, &doAA)) {
+                canvas->clipPath(path, clipOp, doAA);
+            }
+        } break;
+        case Op::kClipRegion: {
+            SkRegion region;
+            SkClipOp clipOp;
+            bool doAA;
+            buffer.readRegion(&region);
+            if (read_clip(buffer, &clipOp, &doAA)) {
+                canvas->clipRegion(region, clipOp);
+            }
+        } break;
+        case Op::kDrawPaint:
+            buffer.readPaint(&paint, nullptr);
+            BREAK_ON_READ_ERROR(buffer);
+            canvas->drawPaint(paint);
+            break;
+        case Op::kDrawBehind:
+            buffer.readPaint(&paint, nullptr);
+            BREAK_ON_READ_ERROR(buffer);
+            SkCanvasPriv::DrawBehind(canvas, paint);
+            break;
+        case Op::kDrawPoints: {
+            SkCanvas::PointMode mode = buffer.checkRange(SkCanvas::kPoints_PointMode,
+                                                         SkCanvas::kPolygon_PointMode);
+            uint32_t count = buffer.getArrayCount();
+            if (!buffer.validateCanReadN<SkPoint>(count)) {
+                break;
+            }
+            SkAutoTMalloc<SkPoint> pts(count);
+            buffer.readPointArray(pts.get(), count);
+            buffer.readPaint(&paint, nullptr);
+            BREAK_ON_READ_ERROR(buffer);
+            canvas->drawPoints(mode, count, pts.get(), paint);
+        } break;
+        case Op::kDrawRect: {
+            SkRect rect;
+            buffer.readRect(&rect);
+            buffer.readPaint(&paint, nullptr);
+            BREAK_ON_READ_ERROR(buffer);
+            canvas->drawRect(rect, paint);
+        } break;
+        case Op::kDrawRegion: {
+            SkRegion region;
+            buffer.readRegion(&region);
+            buffer.readPaint(&paint, nullptr);
+            BREAK_ON_READ_ERROR(buffer);
+            canvas->drawRegion(region, paint);
+        } break;
+        case Op::kDrawOval: {
+            SkRect oval;
+            buffer.readRect(&oval);
+            buffer.readPaint(&paint, nullptr);
+            BREAK_ON_READ_ERROR(buffer);
+            canvas->drawOval(oval, paint);
+        } break;
+        case Op::kDrawArc: {
+            SkRect oval;
+            buffer.readRect(&oval);
+            SkScalar startAngle = buffer.readScalar();
+            SkScalar sweepAngle = buffer.readScalar();
+            bool useCenter = buffer.readBool();
+            buffer.readPaint(&paint, nullptr);
+            BREAK_ON_READ_ERROR(buffer);
+            canvas->drawArc(oval, startAngle, sweepAngle, useCenter, paint);
+        } break;
+        case Op::kDrawRRect: {
+            SkRRect rrect;
+            buffer.readRRect(&rrect);
+            buffer.readPaint(&paint, nullptr);
+            BREAK_ON_READ_ERROR(buffer);
+            canvas->drawRRect(rrect, paint);
+        } break;
+        case Op::kDrawDRRect: {
+            SkRRect outer, inner;
+            buffer.readRRect(&outer);
+            buffer.readRRect(&inner);
+            buffer.readPaint(&paint, nullptr);
+            BREAK_ON_READ_ERROR(buffer);
+            canvas->drawDRRect(outer, inner, paint);
+        } break;
+        case Op::kDrawPath: {
+            SkPath path;
+            buffer.readPath(&path);
+            buffer.readPaint(&paint, nullptr);
+            BREAK_ON_READ_ERROR(buffer);
+            canvas->drawPath(path, paint);
+        } break;
+        case Op::kDrawTextBlob: {
+            sk_sp<SkTextBlob> blob = SkTextBlobPriv::MakeFromBuffer(buffer);
+            SkPoint origin;
+            buffer.readPoint(&origin);
+            buffer.readPaint(&paint, nullptr);
+            if (!buffer.validate(blob != nullptr)) {
+                break;
+            }
+            canvas->drawTextBlob(blob, origin.fX, origin.fY, paint);
+        } break;
+        case Op::kDrawPatch: {
+            uint32_t parts = buffer.readUInt();
+            SkPoint cubics[12];
+            SkColor colors[4];
+            SkPoint texCoords[4];
+            buffer.readPointArray(cubics, 12);
+            if (parts & kColors_ArrayPart) {
+                buffer.readColorArray(colors, 4);
+            }
+            if (parts & kTexCoords_ArrayPart) {
+                buffer.readPointArray(texCoords, 4);
+            }
+            SkBlendMode mode = buffer.read32LE(SkBlendMode::kLastMode);
+            buffer.readPaint(&paint, nullptr);
+            BREAK_ON_READ_ERROR(buffer);
+            canvas->drawPatch(cubics,
+                              (parts & kColors_ArrayPart) ? colors : nullptr,
+                              (parts & kTexCoords_ArrayPart) ? texCoords : nullptr,
+                              mode, paint);
+        } break;
+        case Op::kDrawVertices: {
+            size_t size;
+            const void* data = buffer.skipByteArray(&size);
+            sk_sp<SkVertices> vertices = data ? SkVertices::Decode(data, size) : nullptr;
+            size_t boneBytes;
+            const void* bones = buffer.skipByteArray(&boneBytes);
+            SkBlendMode mode = buffer.read32LE(SkBlendMode::kLastMode);
+            buffer.readPaint(&paint, nullptr);
+            if (!buffer.validate(vertices && boneBytes % sizeof(SkVertices::Bone) == 0)) {
+                break;
+            }
+            canvas->drawVertices(vertices.get(), static_cast<const SkVertices::Bone*>(bones),
+                                 SkToInt(boneBytes / sizeof(SkVertices::Bone)), mode, paint);
+        } break;
+        case Op::kDrawImage: {
+            sk_sp<SkImage> image = buffer.readImage();
+            SkPoint origin;
+            buffer.readPoint(&origin);
+            const SkPaint* p = read_optional_paint(buffer, &paint);
+            BREAK_ON_READ_ERROR(buffer);
+            canvas->drawImage(image, origin.fX, origin.fY, p);
+        } break;
+        case Op::kDrawImageRect: {
+            sk_sp<SkImage> image = buffer.readImage();
+            SkRect storage, dst;
+            const SkRect* src = read_optional_rect(buffer, &storage);
+            buffer.readRect(&dst);
+            const SkPaint* p = read_optional_paint(buffer, &paint);
+            auto constraint = buffer.checkRange(SkCanvas::kStrict_SrcRectConstraint,
+                                                SkCanvas::kFast_SrcRectConstraint);
+            BREAK_ON_READ_ERROR(buffer);
+            if (src) {
+                canvas->drawImageRect(image, *src, dst, p, constraint);
+            } else {
+                canvas->drawImageRect(image, dst, p);
+            }
+        } break;
+        case Op::kDrawImageNine: {
+            sk_sp<SkImage> image = buffer.readImage();
+            SkIRect center;
+            SkRect dst;
+            buffer.readIRect(&center);
+            buffer.readRect(&dst);
+            const SkPaint* p = read_optional_paint(buffer, &paint);
+            BREAK_ON_READ_ERROR(buffer);
+            canvas->drawImageNine(image, center, dst, p);
+        } break;
+        case Op::kDrawImageLattice: {
+            sk_sp<SkImage> image = buffer.readImage();
+            SkCanvas::Lattice lattice;
+            SkRect dst;
+            (void)SkCanvasPriv::ReadLattice(buffer, &lattice);
+            buffer.readRect(&dst);
+            const SkPaint* p = read_optional_paint(buffer, &paint);
+            BREAK_ON_READ_ERROR(buffer);
+            canvas->drawImageLattice(image.get(), lattice, dst, p);
+        } break;
+        case Op::kDrawAtlas: {
+            sk_sp<SkImage> atlas = buffer.readImage();
+            uint32_t parts = buffer.readUInt();
+            size_t xformBytes, texBytes;
+            auto xforms = static_cast<const SkRSXform*>(buffer.skipByteArray(&xformBytes));
+            auto texs = static_cast<const SkRect*>(buffer.skipByteArray(&texBytes));
+            const int count = SkToInt(xformBytes / sizeof(SkRSXform));
+            if (!buffer.validate(xformBytes == count * sizeof(SkRSXform) &&
+                                 texBytes == count * sizeof(SkRect))) {
+                break;
+            }
+            const SkColor* colors = nullptr;
+            if (parts & kColors_ArrayPart) {
+                // The count leads the colors.
+                if (!buffer.validate(buffer.readUInt() == SkToU32(count))) {
+                    break;
+                }
+                colors = buffer.skipT<SkColor>(count);
+            }
+            SkBlendMode mode = buffer.read32LE(SkBlendMode::kLastMode);
+            SkRect storage;
+            const SkRect* cull = nullptr;
+            if (parts & kCull_ArrayPart) {
+                buffer.readRect(&storage);
+                cull = &storage;
+            }
+            const SkPaint* p = read_optional_paint(buffer, &paint);
+            BREAK_ON_READ_ERROR(buffer);
+            canvas->drawAtlas(atlas.get(), xforms, texs, colors, count, mode, cull, p);
+        } break;
+        case Op::kDrawEdgeAAQuad: {
+            SkRect rect;
+            SkPoint clip[4];
+            buffer.readRect(&rect);
+            const bool hasClip = 4 == buffer.getArrayCount();
+            buffer.readPointArray(clip, hasClip ? 4 : 0);
+            auto aaFlags = static_cast<SkCanvas::QuadAAFlags>(
+                    buffer.checkRange<uint32_t>(0, SkCanvas::kAll_QuadAAFlags));
+            SkColor color = buffer.readColor();
+            SkBlendMode mode = buffer.read32LE(SkBlendMode::kLastMode);
+            BREAK_ON_READ_ERROR(buffer);
+            canvas->experimental_DrawEdgeAAQuad(rect, hasClip ? clip : nullptr, aaFlags, color,
+                                                mode);
+        } break;
+        case Op::kDrawEdgeAAImageSet: {
+            static const size_t kMinEntrySize = 6 * sizeof(uint32_t) + 2 * sizeof(SkRect);
+            int count = buffer.readInt();
+            if (!buffer.validate(count >= 0 &&
+                                 SkSafeMath::Mul(count, kMinEntrySize) <= buffer.available())) {
+                break;
+            }
+            SkAutoTArray<SkCanvas::ImageSetEntry> set(count);
+            int expectedClips = 0, expectedMatrices = 0;
+            for (int i = 0; i < count && buffer.isValid(); ++i) {
+                set[i].fImage = buffer.readImage();
+                buffer.readRect(&set[i].fSrcRect);
+                buffer.readRect(&set[i].fDstRect);
+                set[i].fMatrixIndex = buffer.readInt();
+                set[i].fAlpha = buffer.readScalar();
+                set[i].fAAFlags = buffer.readUInt();
+                set[i].fHasClip = buffer.readBool();
+                buffer.validate(set[i].fImage != nullptr);
+                expectedClips += set[i].fHasClip ? 4 : 0;
+                expectedMatrices = SkTMax(expectedMatrices, set[i].fMatrixIndex + 1);
+            }
+            uint32_t clipCount = buffer.getArrayCount();
+            if (!buffer.validate(SkToU32(expectedClips) <= clipCount) ||
+                !buffer.validateCanReadN<SkPoint>(clipCount)) {
+                break;
+            }
+            SkAutoTMalloc<SkPoint> dstClips(clipCount);
+            buffer.readPointArray(dstClips.get(), clipCount);
+            int matrixCount = buffer.readInt();
+            if (!buffer.validate(expectedMatrices <= matrixCount &&
+                                 buffer.validateCanReadN<SkScalar>(9 * (size_t)matrixCount))) {
+                break;
+            }
+            SkAutoTArray<SkMatrix> matrices(matrixCount);
+            for (int i = 0; i < matrixCount; ++i) {
+                buffer.readMatrix(&matrices[i]);
+            }
+            const SkPaint* p = read_optional_paint(buffer, &paint);
+            auto constraint = buffer.checkRange(SkCanvas::kStrict_SrcRectConstraint,
+                                                SkCanvas::kFast_SrcRectConstraint);
+            BREAK_ON_READ_ERROR(buffer);
+            canvas->experimental_DrawEdgeAAImageSet(set.get(), count, dstClips.get(),
+                                                    matrices.get(), p, constraint);
+        } break;
+        case Op::kDrawAnnotation: {
+            SkRect rect;
+            SkString key;
+            buffer.readRect(&rect);
+            buffer.readString(&key);
+            sk_sp<SkData> value = buffer.readBool() ? buffer.readByteArrayAsData() : nullptr;
+            BREAK_ON_READ_ERROR(buffer);
+            canvas->drawAnnotation(rect, key.c_str(), value.get());
+        } break;
+        case Op::kDrawShadowRec: {
+            SkPath path;
+            SkDrawShadowRec rec;
+            buffer.readPath(&path);
+            buffer.readPoint3(&rec.fZPlaneParams);
+            buffer.readPoint3(&rec.fLightPos);
+            rec.fLightRadius = buffer.readScalar();
+            rec.fAmbientColor = buffer.readColor();
+            rec.fSpotColor = buffer.readColor();
+            rec.fFlags = buffer.readUInt();
+            BREAK_ON_READ_ERROR(buffer);
+            canvas->private_draw_shadow_rec(path, rec);
+        } break;
+        case Op::kFlush:
+            canvas->flush();
+            break;
+    }
+}
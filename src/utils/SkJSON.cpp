@@ -11,12 +11,17 @@
 #include "include/core/SkString.h"
 #include "include/private/SkMalloc.h"
 #include "include/utils/SkParse.h"
+#include "src/core/SkMathPriv.h"
 #include "src/utils/SkUTF.h"
 
 #include <cmath>
 #include <tuple>
 #include <vector>
 
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+    #include <emmintrin.h>
+#endif
+
 namespace skjson {
 
 // #define SK_JSON_REPORT_ERRORS
@@ -261,6 +266,36 @@ static inline const char* skip_ws(const char* p) {
     return p;
 }
 
+// Skips 16-char blocks of string chars, up to the first string terminator (is_eostring()), or to
+// where fewer than 16 chars are left before |end|.  Callers finish the scan one char at a time.
+//
+// Long strings (e.g. base64 embedded images) dominate parsing for some inputs.
+static inline const char* skip_string_chars(const char* p, const char* end) {
+#if SK_CPU_SSE_LEVEL >= SK_CPU_SSE_LEVEL_SSE2
+    const auto quote   = _mm_set1_epi8('"'),
+               escape  = _mm_set1_epi8('\\'),
+               rbrace  = _mm_set1_epi8('}'),
+               rsquare = _mm_set1_epi8(']'),
+               control = _mm_set1_epi8(0x1f);
+
+    while (end - p >= 16) {
+        const auto c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        const auto terminators =
+            _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(c, quote), _mm_cmpeq_epi8(c, escape)),
+                         _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(c, rbrace),
+                                                   _mm_cmpeq_epi8(c, rsquare)),
+                                      // c <= 0x1f
+                                      _mm_cmpeq_epi8(_mm_max_epu8(c, control), control)));
+        const uint32_t mask = _mm_movemask_epi8(terminators);
+        if (mask) {
+            return p + (31 - SkCLZ(mask & (0 - mask)));
+        }
+        p += 16;
+    }
+#endif
+    return p;
+}
+
 static inline float pow10(int32_t exp) {
     static constexpr float g_pow10_table[63] =
     {
@@ -688,7 +723,7 @@ private:
         do {
             // Consume string chars.
             // This is the fast path, and hopefully we only hit it once then quick-exit below.
-            for (p = p + 1; !is_eostring(*p); ++p);
+            for (p = skip_string_chars(p + 1, p_stop + 1); !is_eostring(*p); ++p);
 
             if (*p == '"') {
                 // Valid string found.
@@ -901,10 +936,212 @@ SkString Value::toString() const {
     return SkString(static_cast<const char*>(data->data()), data->size());
 }
 
+namespace {
+
+// The binary DOM form is a header, the root value, and then the external storage ("slabs") of all
+// arrays, objects and long strings, in breadth-first order:
+//
+//   header: ["SkJB"] [uint32_t version] [uint64_t slab bytes]
+//   root:   [Value]
+//   slabs:  [uint64_t n] [n Values | n Members | n chars + \0, zero padded to 8 bytes] ...
+//
+// Values are stored as they are in memory, except that the pointers of arrays, objects and long
+// strings are zeroed: their slabs are implied by the order.  Loading copies each slab into the
+// arena and points its value at the copy.
+static constexpr char     kBinaryMagic[4]   = { 'S', 'k', 'J', 'B' };
+static constexpr uint32_t kBinaryVersion    = 1;
+static constexpr size_t   kBinaryHeaderSize = sizeof(kBinaryMagic) + sizeof(uint32_t)
+                                                                   + sizeof(uint64_t);
+
+class BinaryValue final : public Value {
+public:
+    static bool IsBinary(const char* data, size_t size) {
+        return size >= sizeof(kBinaryMagic) && !memcmp(data, kBinaryMagic, sizeof(kBinaryMagic));
+    }
+
+    static void Write(const Value& root, SkWStream* stream) {
+        SkDynamicMemoryWStream slabs;
+        std::vector<const BinaryValue*> pending;
+        const auto write_value = [&](const Value& v) {
+            const auto& bv = As(v);
+            if (bv.hasSlab()) {
+                BinaryValue record;
+                record.init_tagged(bv.getTag());
+                slabs.write(&record, sizeof(record));
+                pending.push_back(&bv);
+            } else {
+                slabs.write(&v, sizeof(Value));
+            }
+        };
+
+        write_value(root);
+        for (size_t i = 0; i < pending.size(); ++i) {
+            const auto& v = *pending[i];
+            switch (v.getTag()) {
+            case Tag::kString: {
+                const auto& str = v.as<StringValue>();
+                WriteCount(str.size(), &slabs);
+                slabs.write(str.begin(), str.size());
+                static constexpr char kZeros[8] = {};
+                slabs.write(kZeros, SkAlign8(str.size() + 1) - str.size());
+            } break;
+            case Tag::kArray: {
+                const auto& array = v.as<ArrayValue>();
+                WriteCount(array.size(), &slabs);
+                for (const auto& item : array) {
+                    write_value(item);
+                }
+            } break;
+            case Tag::kObject: {
+                const auto& object = v.as<ObjectValue>();
+                WriteCount(object.size(), &slabs);
+                for (const auto& member : object) {
+                    write_value(member.fKey);
+                    write_value(member.fValue);
+                }
+            } break;
+            default:
+                SkASSERT(false);
+                break;
+            }
+        }
+
+        // The root was written to the front of the slab stream.
+        const uint64_t slab_bytes = slabs.bytesWritten() - sizeof(Value);
+        stream->write(kBinaryMagic, sizeof(kBinaryMagic));
+        stream->write32(kBinaryVersion);
+        stream->write(&slab_bytes, sizeof(slab_bytes));
+        slabs.writeToAndReset(stream);
+    }
+
+    static bool Load(const char* data, size_t size, SkArenaAlloc& alloc, Value* root) {
+        SkASSERT(IsBinary(data, size));
+        if (size < kBinaryHeaderSize + sizeof(Value)) {
+            return false;
+        }
+        uint32_t version;
+        uint64_t slab_bytes;
+        memcpy(&version, data + sizeof(kBinaryMagic), sizeof(version));
+        memcpy(&slab_bytes, data + sizeof(kBinaryMagic) + sizeof(version), sizeof(slab_bytes));
+        if (version != kBinaryVersion ||
+            slab_bytes != size - kBinaryHeaderSize - sizeof(Value)) {
+            return false;
+        }
+
+        const char* p   = data + kBinaryHeaderSize;
+        const char* end = data + size;
+        memcpy(root, p, sizeof(Value));
+        p += sizeof(Value);
+
+        std::vector<BinaryValue*> pending;
+        pending.push_back(static_cast<BinaryValue*>(root));
+        for (size_t i = 0; i < pending.size(); ++i) {
+            auto& v = *pending[i];
+            if (!v.hasSlab()) {
+                if (!v.isValidInline()) {
+                    return false;
+                }
+                continue;
+            }
+            uint64_t n;
+            if (end - p < SkTo<ptrdiff_t>(sizeof(n))) {
+                return false;
+            }
+            memcpy(&n, p, sizeof(n));
+            p += sizeof(n);
+            const auto avail = SkTo<size_t>(end - p);
+
+            switch (v.getTag()) {
+            case Tag::kString: {
+                if (n >= avail || SkAlign8(n + 1) > avail) {
+                    return false;
+                }
+                auto* slab = MakeVector<char, 1>(p, SkTo<size_t>(n), alloc);
+                reinterpret_cast<char*>(static_cast<size_t*>(slab) + 1)[n] = '\0';
+                v.init_tagged_pointer(Tag::kString, slab);
+                p += SkAlign8(n + 1);
+            } break;
+            case Tag::kArray: {
+                if (n > avail / sizeof(Value)) {
+                    return false;
+                }
+                auto* slab = MakeVector<Value>(p, SkTo<size_t>(n), alloc);
+                v.init_tagged_pointer(Tag::kArray, slab);
+                p += n * sizeof(Value);
+
+                auto* items = reinterpret_cast<BinaryValue*>(static_cast<size_t*>(slab) + 1);
+                for (size_t j = 0; j < n; ++j) {
+                    pending.push_back(items + j);
+                }
+            } break;
+            case Tag::kObject: {
+                if (n > avail / sizeof(Member)) {
+                    return false;
+                }
+                auto* slab = MakeVector<Member>(p, SkTo<size_t>(n), alloc);
+                v.init_tagged_pointer(Tag::kObject, slab);
+                p += n * sizeof(Member);
+
+                auto* members = reinterpret_cast<Member*>(static_cast<size_t*>(slab) + 1);
+                for (size_t j = 0; j < n; ++j) {
+                    auto* key = static_cast<BinaryValue*>(static_cast<Value*>(&members[j].fKey));
+                    const auto key_tag = key->getTag();
+                    if (key_tag != Tag::kShortString && key_tag != Tag::kString) {
+                        return false;
+                    }
+                    pending.push_back(key);
+                    pending.push_back(static_cast<BinaryValue*>(&members[j].fValue));
+                }
+            } break;
+            default:
+                SkASSERT(false);
+                return false;
+            }
+        }
+
+        return p == end;
+    }
+
+private:
+    static const BinaryValue& As(const Value& v) { return static_cast<const BinaryValue&>(v); }
+
+    static void WriteCount(size_t n, SkWStream* stream) {
+        const uint64_t n64 = n;
+        stream->write(&n64, sizeof(n64));
+    }
+
+    // Inline payloads are used as is, so check the ones that could otherwise be misread.
+    bool isValidInline() const {
+        switch (this->getTag()) {
+        case Tag::kShortString:
+            // Must be \0 terminated within the record.
+            return this->cast<char>()[sizeof(Value) - 1] == '\0';
+        case Tag::kBool:
+            return *this->cast<uint8_t>() <= 1;
+        default:
+            return true;
+        }
+    }
+
+    bool hasSlab() const {
+        const auto tag = this->getTag();
+        return tag == Tag::kString || tag == Tag::kArray || tag == Tag::kObject;
+    }
+};
+
+} // namespace
+
 static constexpr size_t kMinChunkSize = 4096;
 
 DOM::DOM(const char* data, size_t size)
     : fAlloc(kMinChunkSize) {
+    if (BinaryValue::IsBinary(data, size)) {
+        if (!BinaryValue::Load(data, size, fAlloc, &fRoot)) {
+            fRoot = NullValue();
+        }
+        return;
+    }
+
     DOMParser parser(fAlloc);
 
     fRoot = parser.parse(data, size);
@@ -914,4 +1151,8 @@ void DOM::write(SkWStream* stream) const {
     Write(fRoot, stream);
 }
 
+void DOM::writeBinary(SkWStream* stream) const {
+    BinaryValue::Write(fRoot, stream);
+}
+
 } // namespace skjson
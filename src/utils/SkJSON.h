@@ -328,12 +328,21 @@ private:
 
 class DOM final : public SkNoncopyable {
 public:
+    // Parses JSON text, or loads the binary form written by writeBinary(). On failure the root
+    // is a NullValue.
     DOM(const char*, size_t);
 
     const Value& root() const { return fRoot; }
 
+    // Writes the DOM as JSON text.
     void write(SkWStream*) const;
 
+    // Writes the DOM in a binary form which loads without any tokenizing or number parsing:
+    // loading just copies the arrays, objects and strings into place.
+    //
+    // The form is versioned, and only readable by builds with the same binary version.
+    void writeBinary(SkWStream*) const;
+
 private:
     SkArenaAlloc fAlloc;
     Value        fRoot;
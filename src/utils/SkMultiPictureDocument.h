@@ -17,7 +17,8 @@ struct SkSerialProcs;
 class SkStreamSeekable;
 
 /**
- *  Writes into a file format that is similar to SkPicture::serialize()
+ *  Writes into a file format that is similar to SkPicture::serialize(). Sub-pictures and images
+ *  that appear on more than one page are written once, and are shared again when read.
  */
 SK_API sk_sp<SkDocument> SkMakeMultiPictureDocument(SkWStream* dst, const SkSerialProcs* = nullptr);
 
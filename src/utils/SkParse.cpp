@@ -199,10 +199,87 @@ const char* SkParse::FindMSec(const char str[], SkMSec* value)
     return str;
 }
 
+// Parses simple decimal numbers, like "-12.5e3", without calling strtod(). A number whose digits
+// fit in a double's mantissa, scaled by a power of ten a double holds exactly, converts to the
+// same correctly rounded double strtod() would give (Clinger's fast path). Returns null for
+// anything else, and leaves those to strtod().
+static const char* fast_find_scalar(const char str[], float* value) {
+    static constexpr double kPowersOfTen[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    static constexpr uint64_t kMaxExactMantissa = (uint64_t)1 << 53;
+
+    const char* p = str;
+    bool negative = false;
+    if (*p == '-' || *p == '+') {
+        negative = (*p == '-');
+        ++p;
+    }
+
+    uint64_t mantissa = 0;
+    int exponent = 0;
+    int numDigits = 0;
+    for (; is_digit(*p); ++p, ++numDigits) {
+        mantissa = mantissa * 10 + (*p - '0');
+        if (mantissa > kMaxExactMantissa) {
+            return nullptr;
+        }
+    }
+    if (*p == '.') {
+        ++p;
+        for (; is_digit(*p); ++p, ++numDigits) {
+            mantissa = mantissa * 10 + (*p - '0');
+            if (mantissa > kMaxExactMantissa) {
+                return nullptr;
+            }
+            --exponent;
+        }
+    }
+    if (0 == numDigits || *p == 'x' || *p == 'X') {
+        return nullptr;  // No number, or a hex number.
+    }
+    if (*p == 'e' || *p == 'E') {
+        const char* e = p + 1;
+        bool negativeExp = false;
+        if (*e == '-' || *e == '+') {
+            negativeExp = (*e == '-');
+            ++e;
+        }
+        // Like strtod(), leave an 'e' that isn't followed by digits for the caller.
+        if (is_digit(*e)) {
+            int explicitExp = 0;
+            for (; is_digit(*e); ++e) {
+                if (explicitExp < 1000) {
+                    explicitExp = explicitExp * 10 + (*e - '0');
+                }
+            }
+            exponent += negativeExp ? -explicitExp : explicitExp;
+            p = e;
+        }
+    }
+    if (exponent < -22 || exponent > 22) {
+        return nullptr;
+    }
+
+    double v = (double)mantissa;
+    v = (exponent < 0) ? v / kPowersOfTen[-exponent] : v * kPowersOfTen[exponent];
+    *value = (float)(negative ? -v : v);
+    return p;
+}
+
 const char* SkParse::FindScalar(const char str[], SkScalar* value) {
     SkASSERT(str);
     str = skip_ws(str);
 
+    float fast;
+    if (const char* stop = fast_find_scalar(str, &fast)) {
+        if (value) {
+            *value = fast;
+        }
+        return stop;
+    }
+
     char* stop;
     float v = (float)strtod(str, &stop);
     if (str == stop) {
@@ -72,8 +72,49 @@ static const char* find_scalar(const char str[], SkScalar* value,
     return str;
 }
 
+// Counts the points FromSVGString() will add for str, so the path can be sized once before it's
+// parsed instead of growing as it goes. Arcs are counted as the most conics they can turn into.
+static int count_points(const char str[]) {
+    int points = 0;
+    int numbers = 0;
+    char op = '\0';
+    auto endCommand = [&]() {
+        switch (op) {
+            case 'H': case 'V': case 'T': points += numbers;            break;
+            case 'S':                     points += numbers / 4 * 3;    break;
+            case 'A':                     points += numbers / 7 * 8;    break;
+            case 'Z':                     points += 1;                  break;  // A later moveTo.
+            default:                      points += numbers / 2;        break;
+        }
+        numbers = 0;
+    };
+    for (;;) {
+        str = skip_sep(str);
+        char ch = *str;
+        if (ch == '\0') {
+            break;
+        }
+        if (is_digit(ch) || ch == '-' || ch == '+' || ch == '.') {
+            str = SkParse::FindScalar(str, nullptr);
+            if (!str) {
+                break;
+            }
+            ++numbers;
+        } else {
+            endCommand();
+            op = is_lower(ch) ? (char)to_upper(ch) : ch;
+            ++str;
+        }
+    }
+    endCommand();
+    return points;
+}
+
 bool SkParsePath::FromSVGString(const char data[], SkPath* result) {
     SkPath path;
+    if (data) {
+        path.incReserve(count_points(data));
+    }
     SkPoint first = {0, 0};
     SkPoint c = {0, 0};
     SkPoint lastc = {0, 0};
@@ -208,29 +249,126 @@ bool SkParsePath::FromSVGString(const char data[], SkPath* result) {
 #include "include/core/SkString.h"
 #include "src/core/SkGeometry.h"
 
-static void write_scalar(SkWStream* stream, SkScalar value) {
-    char buffer[64];
-#ifdef SK_BUILD_FOR_WIN
-    int len = _snprintf(buffer, sizeof(buffer), "%g", value);
-#else
-    int len = snprintf(buffer, sizeof(buffer), "%g", value);
-#endif
-    char* stop = buffer + len;
-    stream->write(buffer, stop - buffer);
-}
+namespace {
+
+// Writes path data one command at a time, in the form ToSVGString() was asked for.
+class PathDataWriter {
+public:
+    PathDataWriter(SkWStream* stream, SkParsePath::PathEncoding encoding, int decimalPlaces)
+        : fStream(stream)
+        , fRelative(SkParsePath::PathEncoding::Relative == encoding)
+        , fCompact(fRelative || decimalPlaces >= 0)
+        , fDecimalPlaces(SkTMin(decimalPlaces, 9))
+        , fScale(fDecimalPlaces >= 0 ? pow(10.0, fDecimalPlaces) : 1) {}
+
+    void writeCommand(char verb, const SkPoint pts[], int count) {
+        SkPoint rounded[3];
+        SkASSERT(count <= (int)SK_ARRAY_COUNT(rounded));
+        for (int i = 0; i < count; ++i) {
+            rounded[i].set(this->round(pts[i].fX), this->round(pts[i].fY));
+        }
+
+        if (fRelative) {
+            verb += 'a' - 'A';
+        }
+        // A coordinate pair after a moveto is an implicit lineto, so moves are always written.
+        if (!fCompact || verb != fLastVerb || 'M' == verb || 'm' == verb) {
+            fStream->write(&verb, 1);
+            fNumberHasDot = false;
+            fNeedsSeparator = false;
+        }
+        fLastVerb = verb;
+
+        for (int i = 0; i < count; ++i) {
+            SkPoint pt = fRelative ? rounded[i] - fCurrent : rounded[i];
+            this->writeNumber(pt.fX);
+            this->writeNumber(pt.fY);
+        }
 
-static void append_scalars(SkWStream* stream, char verb, const SkScalar data[],
-                           int count) {
-    stream->write(&verb, 1);
-    write_scalar(stream, data[0]);
-    for (int i = 1; i < count; i++) {
-        stream->write(" ", 1);
-        write_scalar(stream, data[i]);
+        fCurrent = rounded[count - 1];
+        if ('M' == verb || 'm' == verb) {
+            fSubpathStart = fCurrent;
+        }
     }
-}
 
-void SkParsePath::ToSVGString(const SkPath& path, SkString* str) {
+    void writeClose() {
+        char verb = fRelative ? 'z' : 'Z';
+        fStream->write(&verb, 1);
+        fLastVerb = verb;
+        fNeedsSeparator = false;
+        fCurrent = fSubpathStart;
+    }
+
+private:
+    SkScalar round(SkScalar value) const {
+        return fDecimalPlaces >= 0 ? (SkScalar)(sk_double_round(value * fScale) / fScale) : value;
+    }
+
+    void writeNumber(SkScalar value) {
+        char buffer[64];
+        int len;
+        if (fDecimalPlaces >= 0) {
+            len = snprintf(buffer, sizeof(buffer), "%.*f", fDecimalPlaces, value);
+            if (memchr(buffer, '.', len)) {
+                while ('0' == buffer[len - 1]) {
+                    --len;
+                }
+                if ('.' == buffer[len - 1]) {
+                    --len;
+                }
+            }
+        } else {
+            len = snprintf(buffer, sizeof(buffer), "%g", value);
+        }
+        buffer[len] = 0;
+
+        const char* start = buffer;
+        if (fCompact) {
+            // Drop leading zeros and negative zeros: "0.5" -> ".5", "-0.5" -> "-.5", "-0" -> "0".
+            if (!strcmp(start, "-0")) {
+                start = "0";
+                len = 1;
+            } else if ('0' == start[0] && '.' == start[1]) {
+                start += 1;
+                len -= 1;
+            } else if ('-' == start[0] && '0' == start[1] && '.' == start[2]) {
+                buffer[1] = '-';
+                start += 1;
+                len -= 1;
+            }
+        }
+
+        bool hasDot = memchr(start, '.', len);
+        if (fNeedsSeparator) {
+            // A sign, or a second decimal point, already ends the previous number.
+            if (!fCompact || !('-' == start[0] || ('.' == start[0] && fNumberHasDot))) {
+                fStream->write(" ", 1);
+            }
+        }
+        fStream->write(start, len);
+        fNumberHasDot = hasDot;
+        fNeedsSeparator = true;
+    }
+
+    SkWStream*   fStream;
+    const bool   fRelative;
+    const bool   fCompact;
+    const int    fDecimalPlaces;
+    const double fScale;
+
+    SkPoint fCurrent = {0, 0};
+    SkPoint fSubpathStart = {0, 0};
+    char    fLastVerb = 0;
+    bool    fNeedsSeparator = false;
+    bool    fNumberHasDot = false;
+};
+
+}  // namespace
+
+void SkParsePath::ToSVGString(const SkPath& path, SkString* str, PathEncoding encoding,
+                              int decimalPlaces) {
     SkDynamicMemoryWStream  stream;
+    PathDataWriter          writer(&stream, encoding, decimalPlaces);
 
     SkPath::Iter    iter(path, false);
     SkPoint         pts[4];
@@ -242,23 +380,23 @@ void SkParsePath::ToSVGString(const SkPath& path, SkString* str) {
                 SkAutoConicToQuads quadder;
                 const SkPoint* quadPts = quadder.computeQuads(pts, iter.conicWeight(), tol);
                 for (int i = 0; i < quadder.countQuads(); ++i) {
-                    append_scalars(&stream, 'Q', &quadPts[i*2 + 1].fX, 4);
+                    writer.writeCommand('Q', &quadPts[i*2 + 1], 2);
                 }
             } break;
            case SkPath::kMove_Verb:
-                append_scalars(&stream, 'M', &pts[0].fX, 2);
+                writer.writeCommand('M', &pts[0], 1);
                 break;
             case SkPath::kLine_Verb:
-                append_scalars(&stream, 'L', &pts[1].fX, 2);
+                writer.writeCommand('L', &pts[1], 1);
                 break;
             case SkPath::kQuad_Verb:
-                append_scalars(&stream, 'Q', &pts[1].fX, 4);
+                writer.writeCommand('Q', &pts[1], 2);
                 break;
             case SkPath::kCubic_Verb:
-                append_scalars(&stream, 'C', &pts[1].fX, 6);
+                writer.writeCommand('C', &pts[1], 3);
                 break;
             case SkPath::kClose_Verb:
-                stream.write("Z", 1);
+                writer.writeClose();
                 break;
             case SkPath::kDone_Verb:
                 str->resize(stream.bytesWritten());
@@ -213,7 +213,7 @@ private:
 
         sk_sp<SkVertices> find(const FACTORY& factory, const SkMatrix& matrix,
                                SkVector* translate) const {
-            for (int i = 0; i < MAX_ENTRIES; ++i) {
+            for (int i = 0; i < fCount; ++i) {
                 if (fEntries[i].fFactory.isCompatible(factory, translate)) {
                     const SkMatrix& m = fEntries[i].fMatrix;
                     if (matrix.hasPerspective() || m.hasPerspective()) {
@@ -264,8 +264,10 @@ private:
         SkRandom fRandom;
     };
 
-    Set<AmbientVerticesFactory, 4> fAmbientSet;
-    Set<SpotVerticesFactory, 4> fSpotSet;
+    // Enough for a shape drawn at several elevations or scales, e.g. cards animating as they're
+    // picked up.
+    Set<AmbientVerticesFactory, 8> fAmbientSet;
+    Set<SpotVerticesFactory, 8> fSpotSet;
 };
 
 /**
@@ -285,7 +287,9 @@ public:
         return *reinterpret_cast<SkResourceCache::Key*>(fKey.get());
     }
 
-    size_t bytesUsed() const override { return fTessellations->size(); }
+    size_t bytesUsed() const override {
+        return sizeof(*this) + this->getKey().size() + fTessellations->size();
+    }
 
     const char* getCategory() const override { return "tessellated shadow masks"; }
 
@@ -447,7 +451,11 @@ bool draw_shadow(const FACTORY& factory,
                 return false;
             }
             auto rec = new CachedTessellationsRec(*key, std::move(tessellations));
-            SkPathPriv::AddGenIDChangeListener(path.path(), sk_make_sp<ShadowInvalidator>(*key));
+            // RRects are keyed on their geometry rather than their path's genID.
+            if (!path.isRRect(nullptr)) {
+                SkPathPriv::AddGenIDChangeListener(path.path(),
+                                                   sk_make_sp<ShadowInvalidator>(*key));
+            }
             SkResourceCache::Add(rec);
         } else {
             vertices = factory.makeVertices(path.path(), path.viewMatrix(),
@@ -565,7 +573,7 @@ static bool validate_rec(const SkDrawShadowRec& rec) {
            SkScalarIsFinite(rec.fLightRadius);
 }
 
-void SkBaseDevice::drawShadow(const SkPath& path, const SkDrawShadowRec& rec) {
+void SkBaseDevice::drawShadow(const SkPath& origPath, const SkDrawShadowRec& rec) {
     auto drawVertsProc = [this](const SkVertices* vertices, SkBlendMode mode, const SkPaint& paint,
                                 SkScalar tx, SkScalar ty, bool hasPerspective) {
         if (vertices->vertexCount()) {
@@ -587,14 +595,28 @@ void SkBaseDevice::drawShadow(const SkPath& path, const SkDrawShadowRec& rec) {
     SkMatrix viewMatrix = this->ctm();
     SkAutoDeviceCTMRestore adr(this, SkMatrix::I());
 
-    ShadowedPath shadowedPath(&path, &viewMatrix);
-
     bool tiltZPlane = tilted(rec.fZPlaneParams);
     bool transparent = SkToBool(rec.fFlags & SkShadowFlags::kTransparentOccluder_ShadowFlag);
-    bool uncached = tiltZPlane || path.isVolatile();
+    bool uncached = tiltZPlane || origPath.isVolatile();
 
     SkPoint3 zPlaneParams = rec.fZPlaneParams;
     SkPoint3 devLightPos = map(viewMatrix, rec.fLightPos);
+
+    // RRect tessellations are cached on the rrect's geometry, and are already reused across
+    // translations of the view matrix. Moving the rrect to the origin and its position into the
+    // view matrix lets identical rrects drawn in different places (a list of cards, say) share
+    // them too.
+    SkTLazy<SkPath> originPath;
+    SkRRect rrect;
+    const SkRect& origBounds = origPath.getBounds();
+    if (!uncached && !viewMatrix.hasPerspective() && origPath.isRRect(&rrect) &&
+        (origBounds.fLeft != 0 || origBounds.fTop != 0)) {
+        origPath.offset(-origBounds.fLeft, -origBounds.fTop, originPath.init());
+        viewMatrix.preTranslate(origBounds.fLeft, origBounds.fTop);
+    }
+    const SkPath& path = originPath.isValid() ? *originPath.get() : origPath;
+
+    ShadowedPath shadowedPath(&path, &viewMatrix);
     float lightRadius = rec.fLightRadius;
 
     if (SkColorGetA(rec.fAmbientColor) > 0) {
@@ -0,0 +1,223 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/utils/SkTiledDDLRecorder.h"
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkData.h"
+#include "include/core/SkDeferredDisplayListRecorder.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPromiseImageTexture.h"
+#include "include/core/SkSerialProcs.h"
+#include "include/core/SkSurface.h"
+#include "include/core/SkSurfaceCharacterization.h"
+#include "include/private/SkDeferredDisplayList.h"
+#include "include/private/SkTArray.h"
+#include "src/core/SkTaskGroup.h"
+
+#if SK_SUPPORT_GPU
+#include "include/gpu/GrBackendSurface.h"
+#include "include/gpu/GrContext.h"
+#endif
+
+struct SkTiledDDLRecorder::Tile {
+    SkIRect                                fClip;    // in the device space of fDst
+    sk_sp<SkSurface>                       fSurface;
+    SkSurfaceCharacterization              fCharacterization;
+    std::unique_ptr<SkDeferredDisplayList> fDisplayList;
+};
+
+SkTiledDDLRecorder::SkTiledDDLRecorder(SkSurface* dst, int numDivisions)
+        : fDst(dst)
+        , fNumDivisions(numDivisions) {
+    SkASSERT(fDst);
+    SkASSERT(fNumDivisions > 0);
+}
+
+SkTiledDDLRecorder::~SkTiledDDLRecorder() {}
+
+#if !SK_SUPPORT_GPU
+
+bool SkTiledDDLRecorder::record(const SkPicture*, SkExecutor*) { return false; }
+
+void SkTiledDDLRecorder::draw() {}
+
+#else
+
+// One image drawn by the picture, uploaded once and fulfilled for every tile that draws it. Each
+// promise image holds a ref, which its done proc drops, so the texture lives until it's safe to
+// delete it.
+class SkTiledDDLRecorder::PromiseImage : public SkRefCnt {
+public:
+    PromiseImage(sk_sp<SkImage> source, GrContext* context) : fSource(std::move(source)) {
+        fTextureImage = fSource->makeTextureImage(context, nullptr);
+        if (fTextureImage) {
+            GrBackendTexture backendTexture = fTextureImage->getBackendTexture(true, &fOrigin);
+            if (backendTexture.isValid()) {
+                fTexture = SkPromiseImageTexture::Make(backendTexture);
+            }
+        }
+    }
+
+    // Returns a promise image for this image made by 'recorder', or the original image if it
+    // couldn't be uploaded.
+    sk_sp<SkImage> makeImage(SkDeferredDisplayListRecorder* recorder) {
+        if (!fTexture) {
+            return fSource;
+        }
+        using Version = SkDeferredDisplayListRecorder::PromiseImageApiVersion;
+        this->ref();
+        return recorder->makePromiseTexture(fTexture->backendTexture().getBackendFormat(),
+                                            fTextureImage->width(),
+                                            fTextureImage->height(),
+                                            GrMipMapped::kNo,
+                                            fOrigin,
+                                            fTextureImage->colorType(),
+                                            fTextureImage->alphaType(),
+                                            fTextureImage->refColorSpace(),
+                                            Fulfill, Release, Done, this,
+                                            Version::kNew);
+    }
+
+    uint32_t sourceID() const { return fSource->uniqueID(); }
+
+private:
+    static sk_sp<SkPromiseImageTexture> Fulfill(void* ctx) {
+        return static_cast<PromiseImage*>(ctx)->fTexture;
+    }
+    static void Release(void*) {}
+    static void Done(void* ctx) { static_cast<PromiseImage*>(ctx)->unref(); }
+
+    sk_sp<SkImage>               fSource;
+    sk_sp<SkImage>               fTextureImage;
+    sk_sp<SkPromiseImageTexture> fTexture;
+    GrSurfaceOrigin              fOrigin = kTopLeft_GrSurfaceOrigin;
+};
+
+bool SkTiledDDLRecorder::record(const SkPicture* picture, SkExecutor* executor) {
+    fTiles.reset();
+    SkCanvas* dstCanvas = fDst->getCanvas();
+    GrContext* context = dstCanvas->getGrContext();
+    if (!context) {
+        return false;
+    }
+
+    std::unique_ptr<Tile[]> tiles(new Tile[fNumDivisions * fNumDivisions]);
+    const int width = fDst->width(), height = fDst->height();
+    const int xTileSize = width / fNumDivisions, yTileSize = height / fNumDivisions;
+    for (int y = 0, yOff = 0; y < fNumDivisions; ++y, yOff += yTileSize) {
+        int ySize = (y < fNumDivisions - 1) ? yTileSize : height - yOff;
+
+        for (int x = 0, xOff = 0; x < fNumDivisions; ++x, xOff += xTileSize) {
+            int xSize = (x < fNumDivisions - 1) ? xTileSize : width - xOff;
+
+            Tile& tile = tiles[y * fNumDivisions + x];
+            tile.fClip = SkIRect::MakeXYWH(xOff, yOff, xSize, ySize);
+            tile.fSurface = fDst->makeSurface(dstCanvas->imageInfo().makeWH(xSize, ySize));
+            if (!tile.fSurface || !tile.fSurface->characterize(&tile.fCharacterization)) {
+                return false;
+            }
+            // TODO: this is here to deal w/ a resource allocator bug (skbug.com/8007). If all
+            // the DDLs are flushed at the same time (w/o the composition draws) the allocator
+            // feels free to reuse the backing GrSurfaces!
+            tile.fSurface->flush();
+        }
+    }
+
+    // Upload each image once, and replace it in the serialized picture with its index.
+    SkTArray<sk_sp<PromiseImage>> images;
+    struct SerialContext {
+        GrContext*                     fContext;
+        SkTArray<sk_sp<PromiseImage>>* fImages;
+    } serialContext = { context, &images };
+    SkSerialProcs serialProcs;
+    serialProcs.fImageCtx = &serialContext;
+    serialProcs.fImageProc = [](SkImage* image, void* ctx) -> sk_sp<SkData> {
+        auto serialContext = static_cast<SerialContext*>(ctx);
+        auto& images = *serialContext->fImages;
+        int index = 0;
+        while (index < images.count() && images[index]->sourceID() != image->uniqueID()) {
+            ++index;
+        }
+        if (index == images.count()) {
+            images.push_back(sk_make_sp<PromiseImage>(sk_ref_sp(image), serialContext->fContext));
+        }
+        return SkData::MakeWithCopy(&index, sizeof(index));
+    };
+    sk_sp<SkData> data = picture->serialize(&serialProcs);
+
+    // Each tile reinflates its own copy of the picture, with promise images made by the same
+    // recorder that records the tile.
+    SkTaskGroup group(executor ? *executor : SkExecutor::GetDefault());
+    group.batch(fNumDivisions * fNumDivisions, [&](int i) {
+        Tile& tile = tiles[i];
+        SkDeferredDisplayListRecorder recorder(tile.fCharacterization);
+        // The recorder isn't ready to make promise images until it has made its canvas.
+        SkCanvas* canvas = recorder.getCanvas();
+
+        struct DeserialContext {
+            SkDeferredDisplayListRecorder*        fRecorder;
+            const SkTArray<sk_sp<PromiseImage>>*  fImages;
+        } deserialContext = { &recorder, &images };
+        SkDeserialProcs deserialProcs;
+        deserialProcs.fImageCtx = &deserialContext;
+        deserialProcs.fImageProc = [](const void* data, size_t length,
+                                      void* ctx) -> sk_sp<SkImage> {
+            auto deserialContext = static_cast<DeserialContext*>(ctx);
+            int index;
+            if (length != sizeof(index)) {
+                return nullptr;
+            }
+            memcpy(&index, data, sizeof(index));
+            if (index < 0 || index >= deserialContext->fImages->count()) {
+                return nullptr;
+            }
+            return (*deserialContext->fImages)[index]->makeImage(deserialContext->fRecorder);
+        };
+        sk_sp<SkPicture> tilePicture = SkPicture::MakeFromData(data.get(), &deserialProcs);
+
+        canvas->clipRect(SkRect::MakeWH(tile.fClip.width(), tile.fClip.height()));
+        canvas->translate(-tile.fClip.fLeft, -tile.fClip.fTop);
+        if (tilePicture) {
+            canvas->drawPicture(tilePicture);
+        }
+        tile.fDisplayList = recorder.detach();
+    });
+    group.wait();
+
+    fTiles = std::move(tiles);
+    return true;
+}
+
+void SkTiledDDLRecorder::draw() {
+    if (!fTiles) {
+        return;
+    }
+    const int count = fNumDivisions * fNumDivisions;
+    for (int i = 0; i < count; ++i) {
+        if (fTiles[i].fDisplayList) {
+            fTiles[i].fSurface->draw(fTiles[i].fDisplayList.get());
+        }
+    }
+
+    // The tiles are composed without flushing in between, so the whole frame goes to the GPU in
+    // one flush.
+    SkCanvas* canvas = fDst->getCanvas();
+    for (int i = 0; i < count; ++i) {
+        const Tile& tile = fTiles[i];
+        canvas->save();
+        canvas->clipRect(SkRect::Make(tile.fClip));
+        canvas->drawImage(tile.fSurface->makeImageSnapshot(), tile.fClip.fLeft, tile.fClip.fTop);
+        canvas->restore();
+    }
+    fDst->flush();
+
+    fTiles.reset();
+}
+
+#endif
@@ -190,14 +190,23 @@ void SkXMLWriter::writeHeader()
 
 // SkXMLStreamWriter
 
-static void tab(SkWStream& stream, int level) {
-    for (int i = 0; i < level; i++) {
-        stream.writeText("\t");
+SkXMLStreamWriter::SkXMLStreamWriter(SkWStream* stream, uint32_t flags)
+    : fStream(*stream)
+    , fFlags(flags) {}
+
+void SkXMLStreamWriter::newline() {
+    if (!(fFlags & kNoPretty_Flag)) {
+        fStream.newline();
     }
 }
 
-SkXMLStreamWriter::SkXMLStreamWriter(SkWStream* stream) : fStream(*stream)
-{}
+void SkXMLStreamWriter::tab(int level) {
+    if (!(fFlags & kNoPretty_Flag)) {
+        for (int i = 0; i < level; i++) {
+            fStream.writeText("\t");
+        }
+    }
+}
 
 SkXMLStreamWriter::~SkXMLStreamWriter() {
     this->flush();
@@ -217,25 +226,25 @@ void SkXMLStreamWriter::onAddText(const char text[], size_t length) {
 
     if (!elem->fHasChildren && !elem->fHasText) {
         fStream.writeText(">");
-        fStream.newline();
+        this->newline();
     }
 
-    tab(fStream, fElems.count() + 1);
+    this->tab(fElems.count() + 1);
     fStream.write(text, length);
-    fStream.newline();
+    this->newline();
 }
 
 void SkXMLStreamWriter::onEndElement() {
     Elem* elem = getEnd();
     if (elem->fHasChildren || elem->fHasText) {
-        tab(fStream, fElems.count());
+        this->tab(fElems.count());
         fStream.writeText("</");
         fStream.writeText(elem->fName.c_str());
         fStream.writeText(">");
     } else {
         fStream.writeText("/>");
     }
-    fStream.newline();
+    this->newline();
     doEnd(elem);
 }
 
@@ -244,10 +253,10 @@ void SkXMLStreamWriter::onStartElementLen(const char name[], size_t length) {
     if (this->doStart(name, length)) {
         // the first child, need to close with >
         fStream.writeText(">");
-        fStream.newline();
+        this->newline();
     }
 
-    tab(fStream, level);
+    this->tab(level);
     fStream.writeText("<");
     fStream.write(name, length);
 }
@@ -255,7 +264,7 @@ void SkXMLStreamWriter::onStartElementLen(const char name[], size_t length) {
 void SkXMLStreamWriter::writeHeader() {
     const char* header = getHeader();
     fStream.write(header, strlen(header));
-    fStream.newline();
+    this->newline();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////
@@ -63,7 +63,11 @@ private:
 
 class SkXMLStreamWriter : public SkXMLWriter {
 public:
-    SkXMLStreamWriter(SkWStream*);
+    enum : uint32_t {
+        kNoPretty_Flag = 0x01,  // Don't indent elements or put them on their own lines.
+    };
+
+    SkXMLStreamWriter(SkWStream*, uint32_t flags = 0);
     ~SkXMLStreamWriter() override;
     void writeHeader() override;
 
@@ -74,7 +78,11 @@ protected:
     void onAddText(const char text[], size_t length) override;
 
 private:
+    void newline();
+    void tab(int level);
+
     SkWStream&      fStream;
+    const uint32_t  fFlags;
 };
 
 class SkXMLParserWriter : public SkXMLWriter {
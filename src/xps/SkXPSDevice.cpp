@@ -40,6 +40,7 @@
 #include "src/core/SkEndian.h"
 #include "src/core/SkGeometry.h"
 #include "src/core/SkImagePriv.h"
+#include "src/core/SkMD5.h"
 #include "src/core/SkMaskFilterBase.h"
 #include "src/core/SkRasterClip.h"
 #include "src/core/SkStrikeCache.h"
@@ -115,7 +116,8 @@ HRESULT SkXPSDevice::createId(wchar_t* buffer, size_t bufferSize, wchar_t sep) {
 SkXPSDevice::SkXPSDevice(SkISize s)
     : INHERITED(SkImageInfo::MakeUnknown(s.width(), s.height()),
                 SkSurfaceProps(0, kUnknown_SkPixelGeometry))
-    , fCurrentPage(0) {}
+    , fCurrentPage(0)
+    , fImageResources(&fOwnedImageResources) {}
 
 SkXPSDevice::~SkXPSDevice() {}
 
@@ -627,12 +629,35 @@ static XPS_TILE_MODE SkToXpsTileMode(SkTileMode tmx, SkTileMode tmy) {
     return gSkToXpsTileMode[(unsigned)tmx][(unsigned)tmy];
 }
 
-HRESULT SkXPSDevice::createXpsImageBrush(
-        const SkBitmap& bitmap,
-        const SkMatrix& localMatrix,
-        const SkTileMode (&xy)[2],
-        const SkAlpha alpha,
-        IXpsOMTileBrush** xpsBrush) {
+static SkMD5::Digest digest_pixels(const SkBitmap& bitmap) {
+    SkMD5 md5;
+    const SkImageInfo& info = bitmap.info();
+    const int32_t header[] = {
+        info.width(), info.height(), info.colorType(), info.alphaType(),
+    };
+    md5.write(header, sizeof(header));
+    const uint64_t colorSpaceHash = info.colorSpace() ? info.colorSpace()->hash() : 0;
+    md5.write(&colorSpaceHash, sizeof(colorSpaceHash));
+    const size_t rowBytes = info.minRowBytes();
+    for (int y = 0; y < info.height(); ++y) {
+        md5.write(bitmap.getAddr(0, y), rowBytes);
+    }
+    return md5.finish();
+}
+
+HRESULT SkXPSDevice::findOrCreateXpsImageResource(const SkBitmap& bitmap,
+                                                  IXpsOMImageResource** imageResource) {
+    // Pixels that can't be read can't be matched, so they always get a resource of their own.
+    const bool canDigest = bitmap.getPixels() != nullptr;
+    SkMD5::Digest digest;
+    if (canDigest) {
+        digest = digest_pixels(bitmap);
+        if (SkTScopedComPtr<IXpsOMImageResource>* found = fImageResources->find(digest)) {
+            *imageResource = SkRefComPtr(found->get());
+            return S_OK;
+        }
+    }
+
     SkDynamicMemoryWStream write;
     if (!SkEncodeImage(&write, bitmap, SkEncodedImageFormat::kPNG, 100)) {
         HRM(E_FAIL, "Unable to encode bitmap as png.");
@@ -654,14 +679,30 @@ HRESULT SkXPSDevice::createXpsImageBrush(
     HRM(this->fXpsFactory->CreatePartUri(buffer, &imagePartUri),
         "Could not create image part uri.");
 
-    SkTScopedComPtr<IXpsOMImageResource> imageResource;
+    SkTScopedComPtr<IXpsOMImageResource> newResource;
     HRM(this->fXpsFactory->CreateImageResource(
             readWrapper.get(),
             XPS_IMAGE_TYPE_PNG,
             imagePartUri.get(),
-            &imageResource),
+            &newResource),
         "Could not create image resource.");
 
+    *imageResource = SkRefComPtr(newResource.get());
+    if (canDigest) {
+        fImageResources->set(digest, std::move(newResource));
+    }
+    return S_OK;
+}
+
+HRESULT SkXPSDevice::createXpsImageBrush(
+        const SkBitmap& bitmap,
+        const SkMatrix& localMatrix,
+        const SkTileMode (&xy)[2],
+        const SkAlpha alpha,
+        IXpsOMTileBrush** xpsBrush) {
+    SkTScopedComPtr<IXpsOMImageResource> imageResource;
+    HR(this->findOrCreateXpsImageResource(bitmap, &imageResource));
+
     XPS_RECT bitmapRect = {
         0.0, 0.0,
         static_cast<FLOAT>(bitmap.width()), static_cast<FLOAT>(bitmap.height())
@@ -2061,6 +2102,7 @@ SkBaseDevice* SkXPSDevice::onCreateDevice(const CreateInfo& info, const SkPaint*
     SkXPSDevice* dev = new SkXPSDevice(info.fInfo.dimensions());
     // TODO(halcanary) implement copy constructor on SkTScopedCOmPtr
     dev->fXpsFactory.reset(SkRefComPtr(fXpsFactory.get()));
+    dev->fImageResources = fImageResources;
     SkAssertResult(dev->createCanvasForLayer());
     return dev;
 }
@@ -24,8 +24,11 @@
 #include "include/core/SkSize.h"
 #include "include/core/SkTypeface.h"
 #include "include/private/SkTArray.h"
+#include "include/private/SkTHash.h"
 #include "src/core/SkBitmapDevice.h"
 #include "src/core/SkClipStackDevice.h"
+#include "src/core/SkMD5.h"
+#include "src/core/SkOpts.h"
 #include "src/utils/SkBitSet.h"
 #include "src/utils/win/SkAutoCoInitialize.h"
 #include "src/utils/win/SkTScopedComPtr.h"
@@ -130,6 +133,19 @@ private:
 
     SkTArray<TypefaceUse, true> fTypefaces;
 
+    struct DigestHash {
+        uint32_t operator()(const SkMD5::Digest& digest) const {
+            return SkOpts::hash(digest.data, sizeof(digest.data));
+        }
+    };
+    using ImageResourceMap =
+            SkTHashMap<SkMD5::Digest, SkTScopedComPtr<IXpsOMImageResource>, DigestHash>;
+    /** Image resources already made, by the MD5 of their pixels, so that an image drawn many
+        times (on any page, or in any layer) is encoded and written to the package once.
+        Layer devices share the map of the device that made them. */
+    ImageResourceMap fOwnedImageResources;
+    ImageResourceMap* fImageResources;
+
     /** Creates a GUID based id and places it into buffer.
         buffer should have space for at least GUID_ID_LEN wide characters.
         The string will always be wchar null terminated.
@@ -144,6 +160,10 @@ private:
 
     HRESULT initXpsDocumentWriter(IXpsOMImageResource* image);
 
+    HRESULT findOrCreateXpsImageResource(
+        const SkBitmap& bitmap,
+        IXpsOMImageResource** imageResource);
+
     HRESULT createXpsPage(
         const XPS_SIZE& pageSize,
         IXpsOMPage** page);
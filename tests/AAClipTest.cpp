@@ -429,6 +429,40 @@ static void test_huge(skiatest::Reporter* reporter) {
     clip.setRect(r);
 }
 
+// Big rrect and path clips are shared through SkResourceCache; reusing them must give the same
+// clip as scan converting them again, and changing the path must not pick up the old clip.
+static void test_cached_clips(skiatest::Reporter* reporter) {
+    const SkIRect bounds = SkIRect::MakeWH(300, 200);
+    const SkRRect rrect = SkRRect::MakeRectXY(SkRect::MakeLTRB(10.5f, 8, 280, 190.25f), 30, 20);
+    const SkMatrix matrix = SkMatrix::MakeTrans(3.25f, 1);
+
+    for (bool doAA : { false, true }) {
+        SkPath path;
+        path.addRRect(rrect);
+        path.setIsVolatile(true);   // never cached
+        SkRasterClip expected(bounds);
+        expected.op(path, matrix, bounds, SkRegion::kIntersect_Op, doAA);
+
+        for (int i = 0; i < 2; ++i) {
+            SkRasterClip rc(bounds);
+            rc.op(rrect, matrix, bounds, SkRegion::kIntersect_Op, doAA);
+            REPORTER_ASSERT(reporter, rc == expected);
+        }
+
+        path.setIsVolatile(false);
+        for (int i = 0; i < 2; ++i) {
+            SkRasterClip rc(bounds);
+            rc.op(path, matrix, bounds, SkRegion::kIntersect_Op, doAA);
+            REPORTER_ASSERT(reporter, rc == expected);
+        }
+
+        path.addCircle(150, 100, 40, SkPath::kCCW_Direction);
+        SkRasterClip rc(bounds);
+        rc.op(path, matrix, bounds, SkRegion::kIntersect_Op, doAA);
+        REPORTER_ASSERT(reporter, rc != expected);
+    }
+}
+
 DEF_TEST(AAClip, reporter) {
     test_empty(reporter);
     test_path_bounds(reporter);
@@ -440,4 +474,5 @@ DEF_TEST(AAClip, reporter) {
     test_really_a_rect(reporter);
     test_crbug_422693(reporter);
     test_huge(reporter);
+    test_cached_clips(reporter);
 }
@@ -299,3 +299,92 @@ DEF_TEST(AndroidCodec_sampledOrientation, r) {
         ERRORF(r, "got result \"%s\"\n", SkCodec::ResultToString(result));
     }
 }
+
+// Averages each sampleSize square of src's pixels, the way fBoxFilter should.
+static uint8_t box_filter_channel(const SkBitmap& src, int sampleSize, int x, int y, int c) {
+    uint32_t sum = 0;
+    for (int j = 0; j < sampleSize; j++) {
+        for (int i = 0; i < sampleSize; i++) {
+            sum += reinterpret_cast<const uint8_t*>(
+                    src.getAddr32(x * sampleSize + i, y * sampleSize + j))[c];
+        }
+    }
+    const uint32_t count = sampleSize * sampleSize;
+    return (sum + count / 2) / count;
+}
+
+DEF_TEST(AndroidCodec_boxFilter, r) {
+    if (GetResourcePath().isEmpty()) {
+        return;
+    }
+
+    constexpr int sampleSize = 4;
+    static const struct {
+        const char* fPath;
+        bool        fAveraged;
+    } kRecs[] = {
+        { "images/mandrill_256.png",     true  },
+        { "images/baby_tux.png",         true  },
+        // Interlaced PNGs are sampled as usual.
+        { "images/plane_interlaced.png", false },
+    };
+    for (const auto& rec : kRecs) {
+        auto data = GetResourceAsData(rec.fPath);
+        if (!data) {
+            ERRORF(r, "Failed to get resource %s", rec.fPath);
+            continue;
+        }
+        auto codec = SkAndroidCodec::MakeFromData(std::move(data));
+        if (!codec) {
+            ERRORF(r, "Failed to create codec for %s", rec.fPath);
+            continue;
+        }
+        SkImageInfo info = codec->getInfo().makeColorType(kN32_SkColorType);
+        if (kOpaque_SkAlphaType != info.alphaType()) {
+            info = info.makeAlphaType(kPremul_SkAlphaType);
+        }
+
+        SkBitmap full;
+        full.allocPixels(info);
+        auto result = codec->getAndroidPixels(info, full.getPixels(), full.rowBytes());
+        if (SkCodec::kSuccess != result) {
+            ERRORF(r, "%s: full decode failed with \"%s\"", rec.fPath,
+                   SkCodec::ResultToString(result));
+            continue;
+        }
+
+        SkAndroidCodec::AndroidOptions options;
+        options.fSampleSize = sampleSize;
+        const SkImageInfo sampledInfo = info.makeWH(info.width() / sampleSize,
+                                                    info.height() / sampleSize);
+        REPORTER_ASSERT(r, codec->getSampledDimensions(sampleSize) == sampledInfo.dimensions());
+        SkBitmap sampled, averaged;
+        sampled.allocPixels(sampledInfo);
+        averaged.allocPixels(sampledInfo);
+        result = codec->getAndroidPixels(sampledInfo, sampled.getPixels(), sampled.rowBytes(),
+                                         &options);
+        REPORTER_ASSERT(r, SkCodec::kSuccess == result);
+        options.fBoxFilter = true;
+        result = codec->getAndroidPixels(sampledInfo, averaged.getPixels(), averaged.rowBytes(),
+                                         &options);
+        REPORTER_ASSERT(r, SkCodec::kSuccess == result);
+
+        if (!rec.fAveraged) {
+            REPORTER_ASSERT(r, 0 == memcmp(sampled.getPixels(), averaged.getPixels(),
+                                           sampledInfo.computeByteSize(sampled.rowBytes())));
+            continue;
+        }
+        // The full decode may premultiply differently, so allow off-by-one.
+        int maxDiff = 0;
+        for (int y = 0; y < sampledInfo.height(); y++) {
+            for (int x = 0; x < sampledInfo.width(); x++) {
+                const uint8_t* pixel = reinterpret_cast<const uint8_t*>(averaged.getAddr32(x, y));
+                for (int c = 0; c < 4; c++) {
+                    int expected = box_filter_channel(full, sampleSize, x, y, c);
+                    maxDiff = SkTMax(maxDiff, SkTAbs(expected - pixel[c]));
+                }
+            }
+        }
+        REPORTER_ASSERT(r, maxDiff <= 1, "%s: averaged pixels off by %d", rec.fPath, maxDiff);
+    }
+}
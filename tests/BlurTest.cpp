@@ -12,6 +12,7 @@
 #include "include/core/SkColor.h"
 #include "include/core/SkColorPriv.h"
 #include "include/core/SkDrawLooper.h"
+#include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMaskFilter.h"
 #include "include/core/SkMath.h"
@@ -28,6 +29,7 @@
 #include "include/core/SkSurface.h"
 #include "include/core/SkTypes.h"
 #include "include/effects/SkBlurDrawLooper.h"
+#include "include/effects/SkBlurImageFilter.h"
 #include "include/effects/SkLayerDrawLooper.h"
 #include "include/effects/SkPerlinNoiseShader.h"
 #include "include/private/SkFloatBits.h"
@@ -37,6 +39,9 @@
 #include "src/core/SkMaskFilterBase.h"
 #include "src/core/SkMathPriv.h"
 #include "src/effects/SkEmbossMaskFilter.h"
+#include "src/gpu/GrBlurDownsampleCache.h"
+#include "src/gpu/GrContextPriv.h"
+#include "src/gpu/GrDrawingManager.h"
 #include "tests/Test.h"
 #include "tools/ToolUtils.h"
 #include "tools/gpu/GrContextFactory.h"
@@ -658,6 +663,41 @@ DEF_TEST(BlurredRRectNinePatchComputation, reporter) {
 }
 
 // https://crbugs.com/787712
+// Narrow or short rrects whose blur leaves nothing to stretch along one axis are still drawn as
+// a nine-patch stretched along the other. They should match their full blurred masks.
+DEF_TEST(BlurRRectNinePatchOneAxis, reporter) {
+    const SkImageInfo ii = SkImageInfo::MakeN32Premul(160, 160);
+    const SkRRect rrects[] = {
+        SkRRect::MakeRectXY(SkRect::MakeXYWH(60.5f, 10, 30, 140), 6, 6),
+        SkRRect::MakeRectXY(SkRect::MakeXYWH(10, 70.25f, 140, 24), 8, 8),
+    };
+
+    SkPaint paint;
+    paint.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, 6));
+    for (const SkRRect& rrect : rrects) {
+        SkBitmap ninePatch, fullMask;
+        ninePatch.allocPixels(ii);
+        ninePatch.eraseColor(SK_ColorTRANSPARENT);
+        fullMask.allocPixels(ii);
+        fullMask.eraseColor(SK_ColorTRANSPARENT);
+
+        SkCanvas(ninePatch).drawRRect(rrect, paint);
+        SkPath path;
+        path.addRRect(rrect);
+        SkCanvas(fullMask).drawPath(path, paint);
+
+        int maxDiff = 0;
+        for (int y = 0; y < ii.height(); ++y) {
+            for (int x = 0; x < ii.width(); ++x) {
+                int diff = SkGetPackedA32(*ninePatch.getAddr32(x, y)) -
+                           SkGetPackedA32(*fullMask.getAddr32(x, y));
+                maxDiff = SkTMax(maxDiff, SkTAbs(diff));
+            }
+        }
+        REPORTER_ASSERT(reporter, maxDiff <= 2, "max difference %d", maxDiff);
+    }
+}
+
 DEF_TEST(EmbossPerlinCrash, reporter) {
     SkPaint p;
 
@@ -735,6 +775,61 @@ DEF_GPUTEST_FOR_RENDERING_CONTEXTS(BlurMaskBiggerThanDest, reporter, ctxInfo) {
     REPORTER_ASSERT(reporter, readback.getColor(31, 31) == SK_ColorBLACK);
 }
 
+// Drop shadows of one image with different sigmas share the downsampled levels of the image
+// until the next flush. They should draw exactly what they draw when they don't.
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(BlurSharesDownsampledSource, reporter, ctxInfo) {
+    GrContext* context = ctxInfo.grContext();
+    GrBlurDownsampleCache* cache = context->priv().drawingManager()->blurDownsampleCache();
+
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(64, 64);
+    for (int y = 0; y < 64; ++y) {
+        for (int x = 0; x < 64; ++x) {
+            *bitmap.getAddr32(x, y) = ((x ^ y) & 8) ? SK_ColorBLUE : SK_ColorWHITE;
+        }
+    }
+    sk_sp<SkImage> image = SkImage::MakeFromBitmap(bitmap)->makeTextureImage(context, nullptr);
+    if (!image) {
+        ERRORF(reporter, "Could not create texture image for test.");
+        return;
+    }
+
+    // Both sigmas are downsampled by four before they are convolved.
+    const SkScalar kSigmas[] = { 10, 12 };
+    const SkImageInfo ii = SkImageInfo::MakeN32Premul(128, 128);
+
+    auto draw = [&](bool flushBetween, SkBitmap* result) {
+        sk_sp<SkSurface> surface(SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, ii));
+        if (!surface) {
+            return false;
+        }
+        SkCanvas* canvas = surface->getCanvas();
+        canvas->clear(SK_ColorTRANSPARENT);
+        for (SkScalar sigma : kSigmas) {
+            SkPaint paint;
+            paint.setImageFilter(SkBlurImageFilter::Make(sigma, sigma, nullptr));
+            paint.setBlendMode(SkBlendMode::kPlus);
+            canvas->drawImage(image, 32, 32, &paint);
+            if (flushBetween) {
+                surface->flush();
+                REPORTER_ASSERT(reporter, !cache->count());
+            } else {
+                REPORTER_ASSERT(reporter, cache->count() > 0);
+            }
+        }
+        result->allocPixels(ii);
+        return surface->readPixels(*result, 0, 0);
+    };
+
+    SkBitmap shared, separate;
+    if (!draw(false, &shared) || !draw(true, &separate)) {
+        ERRORF(reporter, "Could not draw blurs for test.");
+        return;
+    }
+    REPORTER_ASSERT(reporter, !cache->count());
+    REPORTER_ASSERT(reporter, ToolUtils::equal_pixels(shared, separate));
+}
+
 DEF_TEST(zero_blur, reporter) {
     SkBitmap alpha, bitmap;
 
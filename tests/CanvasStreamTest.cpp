@@ -0,0 +1,125 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkFont.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkRRect.h"
+#include "include/core/SkStream.h"
+#include "include/core/SkSurface.h"
+#include "include/core/SkTextBlob.h"
+#include "include/utils/SkCanvasStream.h"
+#include "tests/Test.h"
+#include "tools/ToolUtils.h"
+
+static sk_sp<SkImage> make_image() {
+    auto surface = SkSurface::MakeRasterN32Premul(16, 16);
+    surface->getCanvas()->clear(SK_ColorYELLOW);
+    SkPaint paint;
+    paint.setColor(SK_ColorBLUE);
+    surface->getCanvas()->drawRect({4, 4, 12, 12}, paint);
+    return surface->makeImageSnapshot();
+}
+
+static void draw_scene(SkCanvas* canvas, const sk_sp<SkImage>& image) {
+    SkPaint paint;
+    paint.setAntiAlias(true);
+
+    canvas->clear(SK_ColorWHITE);
+    canvas->save();
+    canvas->translate(10, 10);
+    canvas->clipRRect(SkRRect::MakeRectXY({0, 0, 100, 100}, 10, 10), true);
+    paint.setColor(SK_ColorRED);
+    canvas->drawRect({0, 0, 60, 60}, paint);
+    canvas->concat(SkMatrix::MakeScale(2));
+    canvas->drawImage(image, 0, 0);
+    canvas->restore();
+
+    SkPath path;
+    path.moveTo(120, 10);
+    path.lineTo(190, 40);
+    path.lineTo(130, 90);
+    path.close();
+    paint.setColor(SK_ColorGREEN);
+    canvas->drawPath(path, paint);
+
+    SkPaint layerPaint;
+    layerPaint.setAlphaf(0.5f);
+    canvas->saveLayer(nullptr, &layerPaint);
+    canvas->drawImageRect(image, SkRect::MakeXYWH(10, 120, 64, 64), nullptr);
+    paint.setColor(SK_ColorBLACK);
+    canvas->drawTextBlob(SkTextBlob::MakeFromString("Hello", SkFont(nullptr, 20)), 100, 150,
+                         paint);
+    canvas->restore();
+}
+
+DEF_TEST(CanvasStream_playback, reporter) {
+    sk_sp<SkImage> image = make_image();
+    auto info = SkImageInfo::MakeN32Premul(200, 200);
+
+    SkDynamicMemoryWStream stream;
+    {
+        // Small chunks, so that saves, layers and their restores end up in different chunks.
+        SkCanvasStreamRecorder::Options options;
+        options.fChunkSize = 64;
+        SkCanvasStreamRecorder recorder(info.width(), info.height(), &stream, options);
+        draw_scene(&recorder, image);
+    }
+
+    auto played = SkSurface::MakeRaster(info);
+    SkCanvasStreamPlayer player(played->getCanvas());
+    std::unique_ptr<SkStreamAsset> input = stream.detachAsStream();
+    REPORTER_ASSERT(reporter, player.play(input.get()));
+
+    auto expected = SkSurface::MakeRaster(info);
+    draw_scene(expected->getCanvas(), image);
+
+    REPORTER_ASSERT(reporter, ToolUtils::equal_pixels(played->makeImageSnapshot().get(),
+                                                      expected->makeImageSnapshot().get()));
+}
+
+DEF_TEST(CanvasStream_imagesSentOnce, reporter) {
+    sk_sp<SkImage> image = make_image();
+
+    auto record = [&](int draws) {
+        SkDynamicMemoryWStream stream;
+        SkCanvasStreamRecorder::Options options;
+        options.fChunkSize = 1;
+        SkCanvasStreamRecorder recorder(100, 100, &stream, options);
+        for (int i = 0; i < draws; ++i) {
+            recorder.drawImage(image, 0, 0);
+        }
+        recorder.sendChunk();
+        return stream.bytesWritten();
+    };
+
+    // Each draw goes in a chunk of its own, but only the first sends the image's data.
+    size_t once = record(1);
+    size_t twice = record(2);
+    REPORTER_ASSERT(reporter, twice - once < image->encodeToData()->size());
+}
+
+DEF_TEST(CanvasStream_malformed, reporter) {
+    SkDynamicMemoryWStream stream;
+    {
+        SkCanvasStreamRecorder recorder(100, 100, &stream);
+        recorder.drawPath(SkPath().addCircle(50, 50, 40), SkPaint());
+    }
+    sk_sp<SkData> data = stream.detachAsData();
+
+    auto surface = SkSurface::MakeRasterN32Premul(100, 100);
+    SkCanvasStreamPlayer player(surface->getCanvas());
+
+    // Cut the chunk short.
+    SkMemoryStream truncated(data->data(), data->size() - 8);
+    REPORTER_ASSERT(reporter, !player.play(&truncated));
+
+    // An op that doesn't exist.
+    uint32_t garbage[] = { 0xFFFF, 0 };
+    REPORTER_ASSERT(reporter, !player.playChunk(garbage, sizeof(garbage)));
+}
@@ -1524,7 +1524,8 @@ sk_sp<GrTextureProxy> GrClipStackClip::testingOnly_createClipMask(GrContext* con
     return this->createSoftwareClipMask(context, reducedClip, nullptr);
 }
 
-// Verify that clip masks are freed up when the clip state that generated them goes away.
+// Verify that clip masks are freed up when the clip state that generated them goes away. (Masks
+// of volatile paths are keyed by the clip's gen ID.)
 DEF_GPUTEST_FOR_ALL_CONTEXTS(ClipMaskCache, reporter, ctxInfo) {
     // This test uses resource key tags which only function in debug builds.
 #ifdef SK_DEBUG
@@ -1535,6 +1536,7 @@ DEF_GPUTEST_FOR_ALL_CONTEXTS(ClipMaskCache, reporter, ctxInfo) {
     path.addCircle(10, 10, 8);
     path.addCircle(15, 15, 8);
     path.setFillType(SkPath::kEvenOdd_FillType);
+    path.setIsVolatile(true);
 
     static const char* kTag = GrClipStackClip::kMaskTestTag;
     GrResourceCache* cache = context->priv().getResourceCache();
@@ -1564,6 +1566,56 @@ DEF_GPUTEST_FOR_ALL_CONTEXTS(ClipMaskCache, reporter, ctxInfo) {
 #endif
 }
 
+// Verify that a clip mask of the same elements is reused by later clip stacks, even when they're
+// translated by whole pixels, and that a change to the elements makes a new mask.
+DEF_GPUTEST_FOR_ALL_CONTEXTS(ClipMaskContentCache, reporter, ctxInfo) {
+    // This test uses resource key tags which only function in debug builds.
+#ifdef SK_DEBUG
+    GrContext* context = ctxInfo.grContext();
+    SkClipStack stack;
+
+    SkPath path;
+    path.addCircle(10, 10, 8);
+    path.addCircle(15, 15, 8);
+    path.setFillType(SkPath::kEvenOdd_FillType);
+    SkRRect rrect = SkRRect::MakeRectXY(SkRect::MakeLTRB(4, 4, 24, 24), 5, 5);
+
+    static const char* kTag = GrClipStackClip::kMaskTestTag;
+    GrResourceCache* cache = context->priv().getResourceCache();
+    cache->purgeAllUnlocked();
+    int startKeys = cache->countUniqueKeysWithTag(kTag);
+
+    auto make_mask = [&](const SkMatrix& m, float radius) {
+        stack.save();
+        stack.clipPath(path, m, SkClipOp::kIntersect, true);
+        SkRRect r = rrect;
+        r.setRectXY(rrect.rect(), radius, radius);
+        stack.clipRRect(r, m, SkClipOp::kDifference, true);
+        sk_sp<GrTextureProxy> mask = GrClipStackClip(&stack).testingOnly_createClipMask(context);
+        mask->instantiate(context->priv().resourceProvider());
+        uint32_t id = mask->peekTexture()->uniqueID().asUInt();
+        mask.reset(nullptr);
+        context->flush();
+        stack.restore();
+        cache->purgeAsNeeded();
+        return id;
+    };
+
+    uint32_t first = make_mask(SkMatrix::MakeTrans(0.5f, 0.5f), 5);
+    REPORTER_ASSERT(reporter, startKeys + 1 == cache->countUniqueKeysWithTag(kTag));
+    for (int i = 1; i < 4; ++i) {
+        uint32_t id = make_mask(SkMatrix::MakeTrans(0.5f + 30 * i, 0.5f + 20 * i), 5);
+        REPORTER_ASSERT(reporter, first == id);
+        REPORTER_ASSERT(reporter, startKeys + 1 == cache->countUniqueKeysWithTag(kTag));
+    }
+
+    // A subpixel translation or a different element changes the mask.
+    REPORTER_ASSERT(reporter, first != make_mask(SkMatrix::MakeTrans(0.75f, 0.5f), 5));
+    REPORTER_ASSERT(reporter, first != make_mask(SkMatrix::MakeTrans(0.5f, 0.5f), 4));
+    REPORTER_ASSERT(reporter, startKeys + 3 == cache->countUniqueKeysWithTag(kTag));
+#endif
+}
+
 DEF_GPUTEST_FOR_ALL_CONTEXTS(canvas_private_clipRgn, reporter, ctxInfo) {
     GrContext* context = ctxInfo.grContext();
 
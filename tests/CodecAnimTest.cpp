@@ -10,6 +10,7 @@
 #include "include/codec/SkCodecAnimation.h"
 #include "include/core/SkBitmap.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkRect.h"
@@ -488,3 +489,44 @@ DEF_TEST(AnimCodecPlayer, r) {
         REPORTER_ASSERT(r, f1->bounds().size() == test.fSize);
     }
 }
+
+DEF_TEST(AnimCodecPlayer_SharedData, r) {
+    sk_sp<SkData> data = GetResourceAsData("images/alphabetAnim.gif");
+    if (!data) {
+        return;
+    }
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(1);
+
+    // a and b share a decoder (b decodes ahead on the executor); c has a codec of its own.
+    SkAnimCodecPlayer a(data), b(data, executor.get());
+    SkAnimCodecPlayer c(SkCodec::MakeFromData(data));
+    REPORTER_ASSERT(r, a.duration() == c.duration() && b.duration() == c.duration());
+    REPORTER_ASSERT(r, a.dimensions() == c.dimensions());
+
+    // Play forwards twice (the second time around, frames may come from the cache), then seek
+    // backwards through the animation.
+    std::vector<uint32_t> times;
+    for (uint32_t msec = 0; msec < 2 * c.duration(); msec += 50) {
+        times.push_back(msec);
+    }
+    for (int msec = c.duration(); msec > 0; msec -= 100) {
+        times.push_back(msec);
+    }
+    for (uint32_t msec : times) {
+        a.seek(msec);
+        b.seek(msec);
+        c.seek(msec);
+        sk_sp<SkImage> frameA = a.getFrame(),
+                       frameB = b.getFrame(),
+                       frameC = c.getFrame();
+        REPORTER_ASSERT(r, frameA && frameB && frameC);
+        if (frameA && frameB && frameC) {
+            REPORTER_ASSERT(r, ToolUtils::equal_pixels(frameA.get(), frameC.get()));
+            REPORTER_ASSERT(r, ToolUtils::equal_pixels(frameB.get(), frameC.get()));
+        }
+    }
+
+    // Data that isn't an image makes a player with nothing to show.
+    SkAnimCodecPlayer empty(SkData::MakeWithCString("not an image"));
+    REPORTER_ASSERT(r, !empty.getFrame() && 0 == empty.duration());
+}
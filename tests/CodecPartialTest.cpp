@@ -171,6 +171,64 @@ DEF_TEST(Codec_partialWuffs, r) {
     }
 }
 
+// A progressive JPEG decodes a scan at a time, so each preview covers the whole image, and later
+// scans refine it.
+DEF_TEST(Codec_partialProgressiveJpeg, r) {
+    const char* name = "images/brickwork-texture.jpg";
+    sk_sp<SkData> file = GetResourceAsData(name);
+    if (!file) {
+        SkDebugf("missing resource %s\n", name);
+        return;
+    }
+
+    SkBitmap truth;
+    if (!create_truth(file, &truth)) {
+        ERRORF(r, "Failed to decode %s\n", name);
+        return;
+    }
+
+    HaltingStream* stream = new HaltingStream(file, file->size() / 8);
+    auto partialCodec = SkCodec::MakeFromStream(std::unique_ptr<SkStream>(stream));
+    if (!partialCodec) {
+        ERRORF(r, "Failed to create codec for %s", name);
+        return;
+    }
+
+    const SkImageInfo info = standardize_info(partialCodec.get());
+    SkBitmap incremental;
+    incremental.allocPixels(info);
+    if (SkCodec::kSuccess != partialCodec->startIncrementalDecode(info,
+            incremental.getPixels(), incremental.rowBytes())) {
+        ERRORF(r, "Failed to start incremental decode of %s", name);
+        return;
+    }
+
+    int previews = 0;
+    while (true) {
+        int rowsDecoded = 0;
+        const SkCodec::Result result = partialCodec->incrementalDecode(&rowsDecoded);
+        if (result == SkCodec::kSuccess) {
+            break;
+        }
+
+        REPORTER_ASSERT(r, result == SkCodec::kIncompleteInput);
+        REPORTER_ASSERT(r, rowsDecoded == 0 || rowsDecoded == info.height());
+        if (rowsDecoded == info.height()) {
+            previews++;
+        }
+
+        if (stream->isAllDataReceived()) {
+            ERRORF(r, "Failed to completely decode %s", name);
+            return;
+        }
+
+        stream->addNewData(1000);
+    }
+
+    REPORTER_ASSERT(r, previews > 1);
+    compare_bitmaps(r, truth, incremental);
+}
+
 // Verify that when decoding an animated gif byte by byte we report the correct
 // fRequiredFrame as soon as getFrameInfo reports the frame.
 DEF_TEST(Codec_requiredFrame, r) {
@@ -13,6 +13,7 @@
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkData.h"
 #include "include/core/SkEncodedImageFormat.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageEncoder.h"
 #include "include/core/SkImageGenerator.h"
@@ -1806,3 +1807,94 @@ DEF_TEST(Codec_crbug807324, r) {
         }
     }
 }
+
+// Decoding with an executor should give exactly the same pixels, whether the image is
+// complete or not.
+DEF_TEST(Codec_png_executor, r) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    auto adobeRGB = SkColorSpace::MakeRGB(SkNamedTransferFn::k2Dot2, SkNamedGamut::kAdobeRGB);
+    for (const char* path : { "images/mandrill_512.png",
+                              "images/plane_interlaced.png",
+                              "images/color_wheel_with_profile.png" }) {
+        sk_sp<SkData> data = GetResourceAsData(path);
+        if (!data) {
+            continue;
+        }
+        for (sk_sp<SkData> input : { data, SkData::MakeSubset(data.get(), 0, data->size() / 2) }) {
+            for (bool xform : { false, true }) {
+                SkMD5::Digest digests[2];
+                SkCodec::Result results[2];
+                for (int i = 0; i < 2; ++i) {
+                    std::unique_ptr<SkCodec> codec(SkCodec::MakeFromData(input));
+                    if (!codec) {
+                        ERRORF(r, "Unable to create codec for %s", path);
+                        return;
+                    }
+                    SkImageInfo info = codec->getInfo().makeColorType(kN32_SkColorType);
+                    if (xform) {
+                        info = info.makeColorType(kRGBA_F16_SkColorType)
+                                   .makeColorSpace(adobeRGB);
+                    }
+                    SkBitmap bm;
+                    bm.allocPixels(info);
+                    bm.eraseColor(SK_ColorTRANSPARENT);
+                    SkCodec::Options options;
+                    options.fExecutor = i ? executor.get() : nullptr;
+                    results[i] = codec->getPixels(info, bm.getPixels(), bm.rowBytes(), &options);
+                    digests[i] = md5(bm);
+                }
+                REPORTER_ASSERT(r, results[0] == results[1], "%s", path);
+                REPORTER_ASSERT(r, digests[0] == digests[1], "%s", path);
+            }
+        }
+    }
+}
+
+// JPEGs with restart markers are decoded in bands on the executor, which must give exactly
+// the same pixels and planes as a serial decode.
+DEF_TEST(Codec_jpeg_executor, r) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    for (const char* path : { "images/icc-v2-gbr.jpg",      // restart markers, 4:2:0
+                              "images/mandrill_cmyk.jpg",   // restart markers, CMYK
+                              "images/mandrill_512_q075.jpg" }) {
+        sk_sp<SkData> data = GetResourceAsData(path);
+        if (!data) {
+            continue;
+        }
+        SkMD5::Digest digests[2];
+        SkCodec::Result results[2];
+        for (int i = 0; i < 2; ++i) {
+            std::unique_ptr<SkCodec> codec(SkCodec::MakeFromData(data));
+            if (!codec) {
+                ERRORF(r, "Unable to create codec for %s", path);
+                return;
+            }
+            SkBitmap bm;
+            bm.allocPixels(codec->getInfo().makeColorType(kN32_SkColorType));
+            SkCodec::Options options;
+            options.fExecutor = i ? executor.get() : nullptr;
+            results[i] = codec->getPixels(bm.info(), bm.getPixels(), bm.rowBytes(), &options);
+            digests[i] = md5(bm);
+        }
+        REPORTER_ASSERT(r, results[0] == SkCodec::kSuccess, "%s", path);
+        REPORTER_ASSERT(r, results[0] == results[1], "%s", path);
+        REPORTER_ASSERT(r, digests[0] == digests[1], "%s", path);
+
+        std::unique_ptr<SkCodec> codec(SkCodec::MakeFromData(data));
+        SkYUVASizeInfo sizeInfo;
+        if (!codec || !codec->queryYUV8(&sizeInfo, nullptr)) {
+            continue;
+        }
+        std::vector<uint8_t> yuv[2];
+        for (int i = 0; i < 2; ++i) {
+            codec = SkCodec::MakeFromData(data);
+            yuv[i].resize(sizeInfo.computeTotalBytes());
+            void* planes[SkYUVASizeInfo::kMaxCount];
+            sizeInfo.computePlanes(yuv[i].data(), planes);
+            SkExecutor* yuvExecutor = i ? executor.get() : nullptr;
+            REPORTER_ASSERT(r, SkCodec::kSuccess ==
+                    codec->getYUV8Planes(sizeInfo, planes, yuvExecutor), "%s", path);
+        }
+        REPORTER_ASSERT(r, yuv[0] == yuv[1], "%s", path);
+    }
+}
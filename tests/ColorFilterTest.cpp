@@ -8,8 +8,12 @@
 #include "include/core/SkBlendMode.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkColorFilter.h"
+#include "include/core/SkData.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkTypes.h"
+#include "include/effects/SkColorCubeFilter.h"
+#include "include/effects/SkColorMatrix.h"
+#include "include/effects/SkTableColorFilter.h"
 #include "include/utils/SkRandom.h"
 #include "src/core/SkAutoMalloc.h"
 #include "src/core/SkReadBuffer.h"
@@ -112,3 +116,80 @@ DEF_TEST(ColorFilter, reporter) {
 
     test_composecolorfilter_limit(reporter);
 }
+
+DEF_TEST(ColorCubeFilter, reporter) {
+    // A cube that swaps the channels around, which trilinear interpolation reproduces exactly
+    // between the lattice points. A dimension of 6 puts them on multiples of 51.
+    const int dim = 6;
+    sk_sp<SkData> cube = SkData::MakeUninitialized(dim * dim * dim * sizeof(SkColor));
+    SkColor* colors = static_cast<SkColor*>(cube->writable_data());
+    for (int b = 0; b < dim; ++b) {
+        for (int g = 0; g < dim; ++g) {
+            for (int r = 0; r < dim; ++r) {
+                *colors++ = SkColorSetARGB(0x80, b * 51, r * 51, g * 51);
+            }
+        }
+    }
+
+    REPORTER_ASSERT(reporter, !SkColorCubeFilter::Make(cube, dim - 1));
+    REPORTER_ASSERT(reporter, !SkColorCubeFilter::Make(SkData::MakeEmpty(), 1));
+    sk_sp<SkColorFilter> filter = SkColorCubeFilter::Make(cube, dim);
+    REPORTER_ASSERT(reporter, filter);
+    if (!filter) {
+        return;
+    }
+    REPORTER_ASSERT(reporter, filter->getFlags() & SkColorFilter::kAlphaUnchanged_Flag);
+
+    auto check = [&](const sk_sp<SkColorFilter>& cf) {
+        SkRandom rand;
+        for (int i = 0; i < 100; ++i) {
+            SkColor4f in = {rand.nextF(), rand.nextF(), rand.nextF(), rand.nextRangeF(0.25f, 1)};
+            SkColor4f out = cf->filterColor4f(in, nullptr);
+            const float tol = 0.002f;
+            REPORTER_ASSERT(reporter, SkScalarNearlyEqual(out.fR, in.fB, tol));
+            REPORTER_ASSERT(reporter, SkScalarNearlyEqual(out.fG, in.fR, tol));
+            REPORTER_ASSERT(reporter, SkScalarNearlyEqual(out.fB, in.fG, tol));
+            REPORTER_ASSERT(reporter, SkScalarNearlyEqual(out.fA, in.fA, tol));
+        }
+    };
+    check(filter);
+    check(reincarnate_colorfilter(filter.get()));
+}
+
+DEF_TEST(ColorFilter_FoldComposed, reporter) {
+    // Two matrices fold into their product, if the inner one can't need clamping.
+    SkColorMatrix gray, darken, saturate;
+    gray.setSaturation(0);
+    darken.setScale(0.5f, 0.5f, 0.5f, 1);
+    saturate.setSaturation(2);
+    sk_sp<SkColorFilter> folded = SkColorFilters::Matrix(darken)->makeComposed(
+            SkColorFilters::Matrix(gray));
+    float matrix[20];
+    REPORTER_ASSERT(reporter, folded->asAColorMatrix(matrix));
+    SkColorMatrix product;
+    product.setConcat(darken, gray);
+    float expected[20];
+    product.getRowMajor(expected);
+    REPORTER_ASSERT(reporter, 0 == memcmp(matrix, expected, sizeof(matrix)));
+
+    sk_sp<SkColorFilter> unfolded = SkColorFilters::Matrix(darken)->makeComposed(
+            SkColorFilters::Matrix(saturate));
+    REPORTER_ASSERT(reporter, !unfolded->asAColorMatrix(nullptr));
+
+    // Nothing gets through a constant color.
+    sk_sp<SkColorFilter> constant = SkColorFilters::Blend(SK_ColorBLUE, SkBlendMode::kSrc);
+    REPORTER_ASSERT(reporter, constant->makeComposed(folded).get() == constant.get());
+
+    // Tables fold into one table.
+    uint8_t invert[256], halve[256];
+    for (int i = 0; i < 256; ++i) {
+        invert[i] = 255 - i;
+        halve[i] = i / 2;
+    }
+    sk_sp<SkColorFilter> outer = SkTableColorFilter::MakeARGB(nullptr, halve, halve, halve),
+                         inner = SkTableColorFilter::MakeARGB(nullptr, invert, nullptr, invert);
+    sk_sp<SkColorFilter> tables = outer->makeComposed(inner);
+    REPORTER_ASSERT(reporter, tables->getFactory() == outer->getFactory());
+    REPORTER_ASSERT(reporter, tables->filterColor(SkColorSetRGB(0x10, 0x20, 0x30)) ==
+                              SkColorSetRGB(0x77, 0x10, 0x67));
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkMaskFilter.h"
+#include "include/core/SkStream.h"
+#include "src/utils/SkJSONWriter.h"
+#include "tests/Test.h"
+#include "tools/debugger/CostHeatmapCanvas.h"
+
+using DrawType = CostHeatmapCanvas::DrawType;
+
+DEF_TEST(CostHeatmapCanvas_costs, reporter) {
+    SkPaint paint;
+    {
+        // A plain rect costs one unit for each of its pixels.
+        CostHeatmapCanvas canvas(64, 64);
+        canvas.drawRect(SkRect::MakeWH(32, 32), paint);
+        REPORTER_ASSERT(reporter, canvas.totalCost() == 32 * 32);
+        REPORTER_ASSERT(reporter, canvas.totalCost(DrawType::kRect) == 32 * 32);
+    }
+    {
+        // Only what's inside the clip and the canvas is counted.
+        CostHeatmapCanvas canvas(64, 64);
+        canvas.save();
+        canvas.clipRect(SkRect::MakeWH(16, 16));
+        canvas.drawRect(SkRect::MakeWH(32, 32), paint);
+        canvas.restore();
+        canvas.drawRect(SkRect::MakeXYWH(48, 48, 32, 32), paint);
+        REPORTER_ASSERT(reporter, canvas.totalCost() == 16 * 16 + 16 * 16);
+    }
+    {
+        // Blurring costs more, the more it blurs, and the layer costs for its bounds.
+        CostHeatmapCanvas small(64, 64), large(64, 64);
+        SkPaint blurred;
+        blurred.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, 1));
+        small.drawRect(SkRect::MakeXYWH(16, 16, 16, 16), blurred);
+        blurred.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, 4));
+        large.drawRect(SkRect::MakeXYWH(16, 16, 16, 16), blurred);
+        REPORTER_ASSERT(reporter, small.totalCost() > 16 * 16);
+        REPORTER_ASSERT(reporter, large.totalCost() > small.totalCost());
+
+        SkRect bounds = SkRect::MakeWH(8, 8);
+        large.saveLayer(&bounds, nullptr);
+        large.restore();
+        REPORTER_ASSERT(reporter, large.totalCost(DrawType::kLayer) > 0);
+    }
+}
+
+DEF_TEST(CostHeatmapCanvas_summary, reporter) {
+    CostHeatmapCanvas canvas(64, 64);
+    SkPaint paint;
+    canvas.drawRect(SkRect::MakeWH(64, 64), paint);
+    paint.setBlendMode(SkBlendMode::kMultiply);
+    canvas.drawRect(SkRect::MakeXYWH(16, 16, 16, 16), paint);
+
+    SkDynamicMemoryWStream stream;
+    SkJSONWriter writer(&stream, SkJSONWriter::Mode::kFast);
+    canvas.writeSummary(writer, 1);
+    writer.flush();
+    sk_sp<SkData> data = stream.detachAsData();
+    SkString summary(static_cast<const char*>(data->data()), data->size());
+
+    // The costliest cell is the one the second rect covers.
+    REPORTER_ASSERT(reporter, summary.contains("\"x\":16,\"y\":16,\"width\":16,\"height\":16"));
+    REPORTER_ASSERT(reporter, summary.contains("\"totalCost\":5120"));
+}
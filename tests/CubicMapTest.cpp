@@ -74,3 +74,30 @@ DEF_TEST(CubicMap, r) {
         }
     }
 }
+
+DEF_TEST(CubicMap_batch, r) {
+    const SkScalar values[] = {
+        0, 1, 0.5f, 0.0000001f, 0.999999f, 0.25f,
+    };
+
+    // Includes values outside [0..1], and a count that isn't a multiple of the batch width.
+    float x[259], y[259];
+    for (int i = 0; i < 259; ++i) {
+        x[i] = i * (1.0f / 256) - 0.005f;
+    }
+
+    for (SkScalar x0 : values) {
+        for (SkScalar y0 : values) {
+            for (SkScalar x1 : values) {
+                for (SkScalar y1 : values) {
+                    SkCubicMap cmap({ x0, y0 }, { x1, y1 });
+                    cmap.computeYFromX(x, y, SK_ARRAY_COUNT(x));
+                    for (int i = 0; i < 259; ++i) {
+                        REPORTER_ASSERT(r, SkScalarNearlyEqual(y[i], cmap.computeYFromX(x[i]),
+                                                               0.00001f));
+                    }
+                }
+            }
+        }
+    }
+}
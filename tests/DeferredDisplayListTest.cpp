@@ -10,9 +10,11 @@
 #include "include/core/SkColor.h"
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkDeferredDisplayListRecorder.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPaint.h"
+#include "include/core/SkPictureRecorder.h"
 #include "include/core/SkPromiseImageTexture.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
@@ -29,6 +31,7 @@
 #include "include/private/GrTextureProxy.h"
 #include "include/private/GrTypesPriv.h"
 #include "include/private/SkDeferredDisplayList.h"
+#include "include/utils/SkTiledDDLRecorder.h"
 #include "src/core/SkDeferredDisplayListPriv.h"
 #include "src/gpu/GrCaps.h"
 #include "src/gpu/GrContextPriv.h"
@@ -955,3 +958,56 @@ DEF_GPUTEST_FOR_GL_RENDERING_CONTEXTS(DDLCompatibilityTest, reporter, ctxInfo) {
     }
 
 }
+
+////////////////////////////////////////////////////////////////////////////////
+// Check that recording a picture as tiled DDLs on several threads, with its image shared as a
+// promise image, matches drawing the picture directly.
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(DDLTiledRecorder, reporter, ctxInfo) {
+    GrContext* context = ctxInfo.grContext();
+
+    SkImageInfo ii = SkImageInfo::MakeN32Premul(64, 64);
+    sk_sp<SkSurface> expected = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, ii);
+    sk_sp<SkSurface> actual = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, ii);
+    if (!expected || !actual) {
+        return;
+    }
+
+    SkBitmap imageBitmap;
+    imageBitmap.allocPixels(SkImageInfo::MakeN32Premul(40, 40));
+    imageBitmap.eraseColor(SK_ColorBLUE);
+    imageBitmap.erase(SK_ColorYELLOW, SkIRect::MakeXYWH(10, 10, 20, 20));
+    imageBitmap.setImmutable();
+    sk_sp<SkImage> image = SkImage::MakeFromBitmap(imageBitmap);
+
+    SkPictureRecorder pictureRecorder;
+    SkCanvas* canvas = pictureRecorder.beginRecording(64, 64);
+    canvas->clear(SK_ColorWHITE);
+    canvas->drawImage(image, 4, 4);
+    canvas->drawImage(image, 20, 22);
+    SkPaint paint;
+    paint.setColor(SK_ColorGREEN);
+    canvas->drawRect(SkRect::MakeXYWH(28, 12, 30, 40), paint);
+    sk_sp<SkPicture> picture = pictureRecorder.finishRecordingAsPicture();
+
+    expected->getCanvas()->drawPicture(picture);
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    SkTiledDDLRecorder tiles(actual.get(), 3);
+    REPORTER_ASSERT(reporter, tiles.record(picture.get(), executor.get()));
+    tiles.draw();
+
+    SkBitmap expectedBitmap, actualBitmap;
+    expectedBitmap.allocPixels(ii);
+    actualBitmap.allocPixels(ii);
+    REPORTER_ASSERT(reporter, expected->readPixels(expectedBitmap, 0, 0));
+    REPORTER_ASSERT(reporter, actual->readPixels(actualBitmap, 0, 0));
+    for (int y = 0; y < 64; ++y) {
+        for (int x = 0; x < 64; ++x) {
+            if (expectedBitmap.getColor(x, y) != actualBitmap.getColor(x, y)) {
+                ERRORF(reporter, "Mismatch at (%d, %d): expected 0x%08x, got 0x%08x", x, y,
+                       expectedBitmap.getColor(x, y), actualBitmap.getColor(x, y));
+                return; // we only really need to report the error once
+            }
+        }
+    }
+}
@@ -6,10 +6,14 @@
  */
 
 #include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColorFilter.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
+#include "include/core/SkRSXform.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkSurface.h"
 #include "include/core/SkTypes.h"
 #include "include/gpu/GrTypes.h"
 #include "src/core/SkDevice.h"
@@ -127,3 +131,103 @@ DEF_GPUTEST_FOR_RENDERING_CONTEXTS(SpecialImage_GPUDevice, reporter, ctxInfo) {
     SkASSERT(2*kHeight == special->height());
     SkASSERT(SkIRect::MakeWH(2*kWidth, 2*kHeight) == special->subset());
 }
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Whole-pixel sprites take SkBitmapDevice's direct blitting path for drawAtlas(). They should
+// match what drawVertices() draws for them, which an otherwise harmless color filter forces.
+DEF_TEST(BitmapDevice_drawAtlasSprites, reporter) {
+    SkBitmap atlasBitmap;
+    atlasBitmap.allocN32Pixels(32, 32);
+    for (int y = 0; y < 32; ++y) {
+        for (int x = 0; x < 32; ++x) {
+            *atlasBitmap.getAddr32(x, y) = SkPreMultiplyARGB(x * 8 + 7, y * 8, 255 - x * 8, 128);
+        }
+    }
+    sk_sp<SkImage> atlas = SkImage::MakeFromBitmap(atlasBitmap);
+
+    const SkRSXform xforms[] = {
+        SkRSXform::Make(1, 0,  0,  0),
+        SkRSXform::Make(1, 0, 10, 12),
+        SkRSXform::Make(1, 0, 40, 36),
+        SkRSXform::Make(1, 0, -6, 50),  // clipped
+    };
+    const SkRect tex[] = {
+        SkRect::MakeXYWH( 0,  0, 32, 32),
+        SkRect::MakeXYWH( 4,  8, 20, 16),
+        SkRect::MakeXYWH(16, 16, 16, 16),
+        SkRect::MakeXYWH( 8,  0, 24, 24),
+    };
+    const SkColor colors[] = { 0xFFFFFFFF, 0x80FF8040, 0xFF20C0E0, 0x40FFFFFF };
+    const float identity[20] = { 1, 0, 0, 0, 0,
+                                 0, 1, 0, 0, 0,
+                                 0, 0, 1, 0, 0,
+                                 0, 0, 0, 1, 0 };
+
+    for (bool useColors : { false, true }) {
+        for (U8CPU alpha : { 0xFF, 0xA0 }) {
+            auto draw = [&](sk_sp<SkColorFilter> filter) {
+                auto surface = SkSurface::MakeRasterN32Premul(64, 64);
+                SkCanvas* canvas = surface->getCanvas();
+                canvas->clear(0xFF808080);
+                canvas->clipRect(SkRect::MakeLTRB(2, 4, 62, 60));
+                canvas->translate(3, 1);
+                SkPaint paint;
+                paint.setAlpha(alpha);
+                paint.setColorFilter(std::move(filter));
+                canvas->drawAtlas(atlas.get(), xforms, tex, useColors ? colors : nullptr,
+                                  SK_ARRAY_COUNT(xforms), SkBlendMode::kModulate, nullptr,
+                                  &paint);
+                SkBitmap bm;
+                bm.allocN32Pixels(64, 64);
+                surface->readPixels(bm, 0, 0);
+                return bm;
+            };
+            SkBitmap fast = draw(nullptr),
+                     slow = draw(SkColorFilters::Matrix(identity));
+
+            int maxDiff = 0;
+            for (int y = 0; y < 64; ++y) {
+                for (int x = 0; x < 64; ++x) {
+                    SkPMColor a = *fast.getAddr32(x, y),
+                              b = *slow.getAddr32(x, y);
+                    for (int shift = 0; shift < 32; shift += 8) {
+                        maxDiff = SkTMax(maxDiff, SkTAbs((int)((a >> shift) & 0xFF) -
+                                                         (int)((b >> shift) & 0xFF)));
+                    }
+                }
+            }
+            REPORTER_ASSERT(reporter, maxDiff <= 2, "colors %d alpha %u: max diff %d",
+                            useColors, alpha, maxDiff);
+        }
+    }
+}
+
+// Consecutive draws with the same solid paint share a blitter on raster devices. Make sure it
+// follows the device's pixels when a snapshot forces the surface to copy them.
+DEF_TEST(BitmapDevice_reusedBlitter, reporter) {
+    auto surface = SkSurface::MakeRasterN32Premul(16, 16);
+    SkCanvas* canvas = surface->getCanvas();
+    canvas->clear(SK_ColorWHITE);
+
+    SkPaint paint;
+    paint.setColor(SK_ColorRED);
+    canvas->drawRect(SkRect::MakeXYWH(0, 0, 4, 4), paint);
+    sk_sp<SkImage> snapshot = surface->makeImageSnapshot();
+    canvas->drawRect(SkRect::MakeXYWH(8, 8, 4, 4), paint);
+    paint.setColor(SK_ColorBLUE);
+    canvas->drawRect(SkRect::MakeXYWH(0, 8, 4, 4), paint);
+
+    SkBitmap before, after;
+    before.allocN32Pixels(16, 16);
+    after.allocN32Pixels(16, 16);
+    REPORTER_ASSERT(reporter, snapshot->readPixels(before.pixmap(), 0, 0));
+    REPORTER_ASSERT(reporter, surface->readPixels(after, 0, 0));
+
+    REPORTER_ASSERT(reporter, before.getColor(1, 1) == SK_ColorRED);
+    REPORTER_ASSERT(reporter, before.getColor(9, 9) == SK_ColorWHITE);
+    REPORTER_ASSERT(reporter, after.getColor(1, 1) == SK_ColorRED);
+    REPORTER_ASSERT(reporter, after.getColor(9, 9) == SK_ColorRED);
+    REPORTER_ASSERT(reporter, after.getColor(1, 9) == SK_ColorBLUE);
+    REPORTER_ASSERT(reporter, after.getColor(9, 1) == SK_ColorWHITE);
+}
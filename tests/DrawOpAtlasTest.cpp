@@ -15,6 +15,7 @@
 #include "include/core/SkPoint.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkSize.h"
+#include "include/core/SkTraceMemoryDump.h"
 #include "include/core/SkTypes.h"
 #include "include/gpu/GrBackendSurface.h"
 #include "include/gpu/GrContext.h"
@@ -179,6 +180,102 @@ DEF_GPUTEST_FOR_RENDERING_CONTEXTS(BasicDrawOpAtlas, reporter, ctxInfo) {
     check(reporter, atlas.get(), 1, 4, 1);
 }
 
+static void CountingEvictionFunc(GrDrawOpAtlas::AtlasID, void* data) {
+    ++*static_cast<int*>(data);
+}
+
+class PageDump : public SkTraceMemoryDump {
+public:
+    void dumpNumericValue(const char* dumpName, const char* valueName, const char* units,
+                          uint64_t value) override {
+        fValues.push_back({SkStringPrintf("%s:%s", dumpName, valueName), value});
+    }
+    void setMemoryBacking(const char*, const char*, const char*) override {}
+    void setDiscardableMemoryBacking(const char*, const SkDiscardableMemory&) override {}
+    LevelOfDetail getRequestedDetails() const override {
+        return SkTraceMemoryDump::kObjectsBreakdowns_LevelOfDetail;
+    }
+
+    int count() const { return fValues.count(); }
+    bool find(const char* name, uint64_t* value) const {
+        for (const auto& entry : fValues) {
+            if (entry.first.equals(name)) {
+                *value = entry.second;
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    SkTArray<std::pair<SkString, uint64_t>> fValues;
+};
+
+// Verifies that an atlas which goes unused for long enough gives back all but its first page,
+// evicting whatever was still in the others, and that each page's occupancy can be dumped.
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(IdleDrawOpAtlas, reporter, ctxInfo) {
+    auto context = ctxInfo.grContext();
+    auto proxyProvider = context->priv().proxyProvider();
+    auto resourceProvider = context->priv().resourceProvider();
+    auto drawingManager = context->priv().drawingManager();
+
+    GrOnFlushResourceProvider onFlushResourceProvider(drawingManager);
+    TestingUploadTarget uploadTarget;
+
+    GrBackendFormat format =
+            context->priv().caps()->getBackendFormatFromColorType(kAlpha_8_SkColorType);
+
+    int evictions = 0;
+    std::unique_ptr<GrDrawOpAtlas> atlas = GrDrawOpAtlas::Make(
+                                                proxyProvider,
+                                                format,
+                                                GrColorType::kAlpha_8,
+                                                kAtlasSize, kAtlasSize,
+                                                kAtlasSize/kNumPlots, kAtlasSize/kNumPlots,
+                                                GrDrawOpAtlas::AllowMultitexturing::kYes,
+                                                CountingEvictionFunc, &evictions);
+
+    GrDrawOpAtlas::AtlasID atlasID;
+    for (int i = 0; i < kNumPlots * kNumPlots + 1; ++i) {
+        bool result = fill_plot(atlas.get(), resourceProvider, &uploadTarget, &atlasID, i*32);
+        REPORTER_ASSERT(reporter, result);
+    }
+    atlas->instantiate(&onFlushResourceProvider);
+    check(reporter, atlas.get(), 2, 4, 2);
+
+    PageDump dump;
+    atlas->dumpMemoryStatistics(&dump, "atlas");
+    REPORTER_ASSERT(reporter, 10 == dump.count());
+    uint64_t value = 0;
+    REPORTER_ASSERT(reporter, dump.find("atlas/page_0:page_size", &value) &&
+                              value == (uint64_t)kAtlasSize * kAtlasSize);
+    REPORTER_ASSERT(reporter, dump.find("atlas/page_1:occupied_size", &value) &&
+                              value == (uint64_t)kPlotSize * kPlotSize);
+    REPORTER_ASSERT(reporter, dump.find("atlas/page_1:plots", &value) &&
+                              value == kNumPlots * kNumPlots);
+    REPORTER_ASSERT(reporter, dump.find("atlas/page_1:plots_in_use", &value) && value == 1);
+
+    // Draw from the second page once, then stop using the atlas.
+    atlas->setLastUseToken(atlasID, uploadTarget.tokenTracker()->nextDrawToken());
+    uploadTarget.issueDrawToken();
+    uploadTarget.flushToken();
+    atlas->compact(uploadTarget.tokenTracker()->nextTokenToFlush());
+    check(reporter, atlas.get(), 2, 4, 2);
+
+    for (int i = 0; i < GrDrawOpAtlas::kIdleFlushCount; ++i) {
+        uploadTarget.flushToken();
+        atlas->compact(uploadTarget.tokenTracker()->nextTokenToFlush());
+    }
+    check(reporter, atlas.get(), 2, 4, 2);
+    REPORTER_ASSERT(reporter, 0 == evictions);
+
+    uploadTarget.flushToken();
+    atlas->compact(uploadTarget.tokenTracker()->nextTokenToFlush());
+    check(reporter, atlas.get(), 1, 4, 1);
+    REPORTER_ASSERT(reporter, 1 == evictions);
+    REPORTER_ASSERT(reporter, !atlas->hasID(atlasID));
+}
+
 // This test verifies that the GrAtlasTextOp::onPrepare method correctly handles a failure
 // when allocating an atlas page.
 DEF_GPUTEST_FOR_RENDERING_CONTEXTS(GrAtlasTextOpPreparation, reporter, ctxInfo) {
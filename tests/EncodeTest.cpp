@@ -8,9 +8,11 @@
 #include "tests/Test.h"
 #include "tools/Resources.h"
 
+#include "include/codec/SkCodec.h"
 #include "include/core/SkBitmap.h"
 #include "include/core/SkColorPriv.h"
 #include "include/core/SkEncodedImageFormat.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkStream.h"
 #include "include/encode/SkJpegEncoder.h"
@@ -391,3 +393,80 @@ DEF_TEST(Encode_WebpOptions, r) {
     REPORTER_ASSERT(r, almost_equals(bm0, bm2, 90));
     REPORTER_ASSERT(r, almost_equals(bm2, bm3, 50));
 }
+
+DEF_TEST(Encode_WebpMethod, r) {
+    SkBitmap bitmap;
+    if (!GetResourceAsBitmap("images/google_chrome.ico", &bitmap)) {
+        return;
+    }
+
+    SkDynamicMemoryWStream fastDst, slowDst;
+    SkWebpEncoder::Options options = SkWebpEncoder::FastLosslessOptions();
+    options.fMultithreaded = true;
+    REPORTER_ASSERT(r, SkWebpEncoder::Encode(&fastDst, bitmap.pixmap(), options));
+
+    options.fQuality = 100.0f;
+    options.fMethod = 6;
+    REPORTER_ASSERT(r, SkWebpEncoder::Encode(&slowDst, bitmap.pixmap(), options));
+
+    // Any effort is still lossless.
+    sk_sp<SkData> fastData = fastDst.detachAsData();
+    sk_sp<SkData> slowData = slowDst.detachAsData();
+    REPORTER_ASSERT(r, fastData->size() >= slowData->size());
+
+    SkBitmap fastBm, slowBm;
+    SkImage::MakeFromEncoded(fastData)->asLegacyBitmap(&fastBm);
+    SkImage::MakeFromEncoded(slowData)->asLegacyBitmap(&slowBm);
+    REPORTER_ASSERT(r, almost_equals(fastBm, slowBm, 0));
+}
+
+DEF_TEST(Encode_WebpAnimated, r) {
+    const SkColor colors[] = { SK_ColorRED, SK_ColorGREEN, SK_ColorBLUE, SK_ColorWHITE };
+    constexpr int kFrameCount = SK_ARRAY_COUNT(colors);
+    SkBitmap bitmaps[kFrameCount];
+    SkWebpEncoder::Frame frames[kFrameCount];
+    for (int i = 0; i < kFrameCount; ++i) {
+        bitmaps[i].allocN32Pixels(32, 24, true);
+        bitmaps[i].eraseColor(colors[i]);
+        frames[i] = { bitmaps[i].pixmap(), 100 * (i + 1) };
+    }
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+    SkWebpEncoder::Options options = SkWebpEncoder::FastLosslessOptions();
+    SkDynamicMemoryWStream dst;
+    if (!SkWebpEncoder::EncodeAnimated(&dst, frames, kFrameCount, options, executor.get())) {
+        ERRORF(r, "Failed to encode an animated webp");
+        return;
+    }
+
+    std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(dst.detachAsData());
+    if (!codec) {
+        ERRORF(r, "Failed to decode the animated webp");
+        return;
+    }
+    REPORTER_ASSERT(r, codec->getFrameCount() == kFrameCount);
+    REPORTER_ASSERT(r, codec->getRepetitionCount() == SkCodec::kRepetitionCountInfinite);
+
+    std::vector<SkCodec::FrameInfo> frameInfos = codec->getFrameInfo();
+    SkBitmap decoded;
+    decoded.allocPixels(codec->getInfo().makeColorType(kN32_SkColorType));
+    for (int i = 0; i < kFrameCount && i < (int)frameInfos.size(); ++i) {
+        REPORTER_ASSERT(r, frameInfos[i].fDuration == frames[i].fDuration);
+
+        SkCodec::Options codecOptions;
+        codecOptions.fFrameIndex = i;
+        REPORTER_ASSERT(r, SkCodec::kSuccess == codec->getPixels(decoded.pixmap(), &codecOptions));
+        bool matches = true;
+        for (int y = 0; y < decoded.height(); ++y) {
+            for (int x = 0; x < decoded.width(); ++x) {
+                matches &= decoded.getColor(x, y) == colors[i];
+            }
+        }
+        REPORTER_ASSERT(r, matches, "frame %d", i);
+    }
+
+    // Frames must all be the same size.
+    bitmaps[1].allocN32Pixels(16, 16, true);
+    frames[1].fPixmap = bitmaps[1].pixmap();
+    REPORTER_ASSERT(r, !SkWebpEncoder::EncodeAnimated(&dst, frames, kFrameCount, options));
+}
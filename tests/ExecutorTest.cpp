@@ -0,0 +1,142 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkExecutor.h"
+#include "include/core/SkString.h"
+#include "include/private/SkSemaphore.h"
+#include "include/private/SkTArray.h"
+#include "src/core/SkTaskGroup.h"
+#include "tests/Test.h"
+
+#include <atomic>
+#include <memory>
+
+DEF_TEST(SkTaskGroup_BatchRunsEachArgumentOnce, r) {
+    const int N = 1023;
+    std::unique_ptr<std::atomic<int>[]> runs(new std::atomic<int>[N]);
+    for (int i = 0; i < N; i++) {
+        runs[i] = 0;
+    }
+
+    std::unique_ptr<SkExecutor> executors[] = {
+        SkExecutor::MakeFIFOThreadPool(3),
+        SkExecutor::MakeLIFOThreadPool(3),
+        SkExecutor::MakeWorkStealingThreadPool(3),
+    };
+    for (auto& executor : executors) {
+        SkTaskGroup group(*executor);
+        group.batch(N, [&](int i) { runs[i]++; });
+        group.wait();
+    }
+    SkTaskGroup().batch(N, [&](int i) { runs[i]++; });
+
+    for (int i = 0; i < N; i++) {
+        REPORTER_ASSERT(r, runs[i] == 4);
+    }
+}
+
+DEF_TEST(SkExecutor_WorkStealingNested, r) {
+    // Tasks waiting on their own task groups run the work they add themselves.
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeWorkStealingThreadPool(2);
+    std::atomic<int> count{0};
+    SkTaskGroup group(*executor);
+    group.batch(64, [&](int) {
+        SkTaskGroup inner(*executor);
+        inner.batch(16, [&](int) { count++; });
+        inner.add([&] { count++; }, SkExecutor::Priority::kHigh);
+        inner.wait();
+    });
+    group.wait();
+    REPORTER_ASSERT(r, count == 64 * 17);
+}
+
+DEF_TEST(SkExecutor_WorkStealingPriority, r) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeWorkStealingThreadPool(1);
+
+    // Keep the only thread busy until all the work is added.
+    SkSemaphore added;
+    SkTArray<int> order;
+    executor->add([&] { added.wait(); });
+    executor->add([&] { order.push_back(0); });
+    executor->add([&] { order.push_back(1); });
+    executor->add([&] { order.push_back(2); }, SkExecutor::Priority::kHigh);
+
+    added.signal();
+    // The pool runs the remaining work before it shuts down.
+    executor.reset();
+
+    REPORTER_ASSERT(r, order.count() == 3);
+    REPORTER_ASSERT(r, order[0] == 2);
+}
+
+DEF_TEST(SkTaskGroup_ParallelFor, r) {
+    const int N = 1000;
+    std::unique_ptr<std::atomic<int>[]> runs(new std::atomic<int>[N]);
+    for (int i = 0; i < N; i++) {
+        runs[i] = 0;
+    }
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeWorkStealingThreadPool(3);
+    for (int grain : { 0, 1, 7, N, 2 * N }) {
+        std::atomic<bool> tooLong{false};
+        SkTaskGroup group(*executor);
+        group.parallelFor(N, [&](int start, int end) {
+            if (grain && end - start > grain) {
+                tooLong = true;
+            }
+            for (int i = start; i < end; i++) {
+                runs[i]++;
+            }
+        }, grain);
+        group.wait();
+        REPORTER_ASSERT(r, !tooLong);
+    }
+    for (int i = 0; i < N; i++) {
+        REPORTER_ASSERT(r, runs[i] == 5);
+    }
+}
+
+DEF_TEST(SkTaskGroup_ParallelReduce, r) {
+    auto sum = [](int64_t a, int64_t b) { return a + b; };
+    auto sumRange = [](int start, int end) {
+        int64_t s = 0;
+        for (int i = start; i < end; i++) {
+            s += i;
+        }
+        return s;
+    };
+    const int N = 100000;
+    const int64_t expected = (int64_t)N * (N - 1) / 2;
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeWorkStealingThreadPool(3);
+    SkTaskGroup group(*executor);
+    REPORTER_ASSERT(r, group.parallelReduce(N, int64_t(0), sumRange, sum) == expected);
+    REPORTER_ASSERT(r, group.parallelReduce(N, int64_t(0), sumRange, sum, 333) == expected);
+    REPORTER_ASSERT(r, group.parallelReduce(0, int64_t(42), sumRange, sum) == 42);
+
+    // The results are folded in range order.
+    auto concat = [](SkString a, SkString b) { a.append(b); return a; };
+    SkString digits = group.parallelReduce(10, SkString(), [](int start, int end) {
+        SkString s;
+        for (int i = start; i < end; i++) {
+            s.appendS32(i);
+        }
+        return s;
+    }, concat, 3);
+    REPORTER_ASSERT(r, digits.equals("0123456789"));
+
+    // Tasks that reduce in parallel themselves don't deadlock the pool.
+    std::atomic<int> nestedOK{0};
+    group.batch(8, [&](int) {
+        SkTaskGroup inner(*executor);
+        if (inner.parallelReduce(N, int64_t(0), sumRange, sum) == expected) {
+            nestedOK++;
+        }
+    });
+    group.wait();
+    REPORTER_ASSERT(r, nestedOK == 8);
+}
@@ -46,3 +46,51 @@ DEF_TEST(FillPathInverse, reporter) {
 
     REPORTER_ASSERT(reporter, blitter.m_blitCount == expected_lines);
 }
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+
+// Accumulation AA computes exact coverage, so it should agree closely with analytic AA on
+// paths whose edges don't cross each other.
+DEF_TEST(FillPath_AccumulationAA, reporter) {
+    SkPath paths[4];
+    paths[0].addRect(SkRect::MakeLTRB(3.25f, 4.5f, 40.75f, 21.125f));
+    paths[1].moveTo(32, -10).lineTo(75, 30).lineTo(40, 70).lineTo(-8, 40).close();
+    paths[2].moveTo(5.5f, 60).lineTo(30.3f, 12.1f).lineTo(58.7f, 50.9f).close();
+    paths[3].addRect(SkRect::MakeLTRB(8.5f, 8.5f, 56.5f, 56.5f));
+    paths[3].addRect(SkRect::MakeLTRB(20.25f, 20.25f, 44.75f, 44.75f));
+    paths[3].setFillType(SkPath::kEvenOdd_FillType);
+
+    SkPaint paint;
+    paint.setAntiAlias(true);
+
+    const bool useAnalytic     = gSkUseAnalyticAA,
+               forceAnalytic   = gSkForceAnalyticAA,
+               useAccumulation = gSkUseAccumulationAA;
+    for (const SkPath& path : paths) {
+        SkBitmap analytic, accumulated;
+        analytic.allocPixels(SkImageInfo::MakeA8(64, 64));
+        accumulated.allocPixels(SkImageInfo::MakeA8(64, 64));
+        analytic.eraseColor(SK_ColorTRANSPARENT);
+        accumulated.eraseColor(SK_ColorTRANSPARENT);
+
+        gSkUseAnalyticAA = gSkForceAnalyticAA = true;
+        gSkUseAccumulationAA = false;
+        SkCanvas(analytic).drawPath(path, paint);
+
+        gSkUseAccumulationAA = true;
+        SkCanvas(accumulated).drawPath(path, paint);
+
+        int maxDiff = 0;
+        for (int y = 0; y < 64; ++y) {
+            for (int x = 0; x < 64; ++x) {
+                maxDiff = SkTMax(maxDiff, SkTAbs(*analytic.getAddr8(x, y) -
+                                                 *accumulated.getAddr8(x, y)));
+            }
+        }
+        REPORTER_ASSERT(reporter, maxDiff <= 12, "max difference %d", maxDiff);
+    }
+    gSkUseAnalyticAA     = useAnalytic;
+    gSkForceAnalyticAA   = forceAnalytic;
+    gSkUseAccumulationAA = useAccumulation;
+}
@@ -7,6 +7,7 @@
 
 #include "include/core/SkFont.h"
 #include "include/core/SkPaint.h"
+#include "include/core/SkPath.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkTypeface.h"
 #include "src/core/SkAutoMalloc.h"
@@ -262,11 +263,38 @@ static void test_advances(skiatest::Reporter* reporter) {
     }
 }
 
+// getWidthsBoundsPaths() should agree with asking for each piece separately, whether or not the
+// font is measured with the same strike its paths come from.
+static void test_widths_bounds_paths(skiatest::Reporter* reporter) {
+    static const char kText[] = "Hamburgefons";
+    constexpr int kCount = SK_ARRAY_COUNT(kText) - 1;
+
+    for (SkScalar size : { 12.0f, 300.0f }) {
+        SkFont font(nullptr, size);
+        SkGlyphID glyphs[kCount];
+        font.textToGlyphs(kText, kCount, SkTextEncoding::kUTF8, glyphs, kCount);
+
+        SkScalar widths[kCount], expectedWidths[kCount];
+        SkRect bounds[kCount], expectedBounds[kCount];
+        SkPath paths[kCount];
+        font.getWidthsBoundsPaths(glyphs, kCount, widths, bounds, paths);
+        font.getWidthsBounds(glyphs, kCount, expectedWidths, expectedBounds, nullptr);
+        for (int i = 0; i < kCount; ++i) {
+            REPORTER_ASSERT(reporter, widths[i] == expectedWidths[i]);
+            REPORTER_ASSERT(reporter, bounds[i] == expectedBounds[i]);
+            SkPath expectedPath;
+            font.getPath(glyphs[i], &expectedPath);
+            REPORTER_ASSERT(reporter, paths[i] == expectedPath);
+        }
+    }
+}
+
 DEF_TEST(FontHost, reporter) {
     test_tables(reporter);
     test_fontstream(reporter);
     test_advances(reporter);
     test_symbolfont(reporter);
+    test_widths_bounds_paths(reporter);
 }
 
 // need tests for SkStrSearch
@@ -101,3 +101,32 @@ DEF_TEST(FontMgrFontConfig, reporter) {
         REPORTER_ASSERT(reporter, success);
     }
 }
+
+// Character fallback results (including misses) are cached; they must match the uncached ones.
+DEF_TEST(FontMgrFontConfig_fallback, reporter) {
+    FcConfig* config = FcConfigCreate();
+    FcConfigSetSysRoot(config, reinterpret_cast<const FcChar8*>(GetResourcePath("").c_str()));
+    SkString distortablePath(reinterpret_cast<const char*>(FcConfigGetSysRoot(config)));
+    distortablePath += "/fonts/Distortable.ttf";
+    FcConfigAppFontAddFile(config, reinterpret_cast<const FcChar8*>(distortablePath.c_str()));
+    FcConfigBuildFonts(config);
+    sk_sp<SkFontMgr> fontMgr(SkFontMgr_New_FontConfig(config));
+
+    const char* bcp47[] = { "en-US" };
+    for (int i = 0; i < 2; ++i) {
+        sk_sp<SkTypeface> a(fontMgr->matchFamilyStyleCharacter("Distortable", SkFontStyle(),
+                                                               bcp47, 1, 'a'));
+        if (!a) {
+            ERRORF(reporter, "Could not find typeface. FcVersion: %d", FcGetVersion());
+            return;
+        }
+        sk_sp<SkTypeface> b(fontMgr->matchFamilyStyleCharacter(nullptr, SkFontStyle::Bold(),
+                                                               nullptr, 0, 'b'));
+        REPORTER_ASSERT(reporter, SkTypeface::Equal(a.get(), b.get()));
+
+        // Distortable has no emoji, and nothing else is loaded.
+        sk_sp<SkTypeface> emoji(fontMgr->matchFamilyStyleCharacter("Distortable", SkFontStyle(),
+                                                                   bcp47, 1, 0x1F600));
+        REPORTER_ASSERT(reporter, !emoji);
+    }
+}
@@ -359,6 +359,34 @@ static void test_cubic_cusps(skiatest::Reporter* reporter) {
     }
 }
 
+// The batched evaluators should give exactly the points evaluating each t alone does, including
+// for counts that don't fill their last batch.
+static void test_eval_batch(skiatest::Reporter* reporter) {
+    SkRandom rand;
+    for (int count = 0; count <= 17; ++count) {
+        SkPoint pts[4];
+        for (SkPoint& pt : pts) {
+            pt.set(rand.nextRangeF(-100, 100), rand.nextRangeF(-100, 100));
+        }
+        SkConic conic(pts, rand.nextRangeF(0.25f, 4));
+        SkScalar t[17];
+        for (int i = 0; i < count; ++i) {
+            t[i] = rand.nextUScalar1();
+        }
+        SkPoint quadPts[17], conicPts[17], cubicPts[17];
+        SkEvalQuadAt(pts, t, count, quadPts);
+        conic.evalAt(t, count, conicPts);
+        SkEvalCubicAt(pts, t, count, cubicPts);
+        for (int i = 0; i < count; ++i) {
+            REPORTER_ASSERT(reporter, quadPts[i] == SkEvalQuadAt(pts, t[i]));
+            REPORTER_ASSERT(reporter, conicPts[i] == conic.evalAt(t[i]));
+            SkPoint cubicPt;
+            SkEvalCubicAt(pts, t[i], &cubicPt, nullptr, nullptr);
+            REPORTER_ASSERT(reporter, cubicPts[i] == cubicPt);
+        }
+    }
+}
+
 DEF_TEST(Geometry, reporter) {
     SkPoint pts[5];
 
@@ -389,4 +417,5 @@ DEF_TEST(Geometry, reporter) {
     test_conic_to_quads(reporter);
     test_classify_cubic(reporter);
     test_cubic_cusps(reporter);
+    test_eval_batch(reporter);
 }
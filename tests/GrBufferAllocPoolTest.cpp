@@ -0,0 +1,68 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkSurface.h"
+#include "include/gpu/GrContext.h"
+#include "src/gpu/GrCaps.h"
+#include "src/gpu/GrContextPriv.h"
+#include "tests/Test.h"
+#include "tools/gpu/GrContextFactory.h"
+
+using namespace sk_gpu_test;
+
+DEF_GPUTEST(GrBufferAllocPool_ringBuffer, reporter, options) {
+    for (auto type : {GrContextFactory::kGL_ContextType, GrContextFactory::kGLES_ContextType}) {
+        GrContextOptions ringOptions = options;
+        ringOptions.fUsePersistentlyMappedBuffers = GrContextOptions::Enable::kYes;
+        GrContextFactory factory(ringOptions);
+        GrContext* context = factory.get(type);
+        if (!context || !context->priv().caps()->persistentlyMappedBufferSupport()) {
+            continue;
+        }
+
+        static constexpr int kSize = 64;
+        SkImageInfo info = SkImageInfo::MakeN32Premul(kSize, kSize);
+        sk_sp<SkSurface> surface = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, info);
+        if (!surface) {
+            continue;
+        }
+        SkCanvas* canvas = surface->getCanvas();
+
+        // Enough flushes of enough rects for the vertex ring to wrap around. Each flush
+        // changes the color, so any draw that read vertices from the wrong flush would show.
+        const SkColor colors[] = {SK_ColorRED, SK_ColorGREEN, SK_ColorBLUE};
+        for (int flush = 0; flush < 200; ++flush) {
+            SkColor color = colors[flush % SK_ARRAY_COUNT(colors)];
+            SkPaint paint;
+            paint.setColor(color);
+            for (int y = 0; y < kSize; y += 2) {
+                for (int x = 0; x < kSize; x += 2) {
+                    canvas->drawRect(SkRect::MakeXYWH(x, y, 2, 2), paint);
+                }
+            }
+            surface->flush();
+
+            SkBitmap bitmap;
+            bitmap.allocPixels(info);
+            if (!surface->readPixels(bitmap, 0, 0)) {
+                ERRORF(reporter, "Could not read pixels");
+                return;
+            }
+            for (int y = 0; y < kSize; ++y) {
+                for (int x = 0; x < kSize; ++x) {
+                    if (bitmap.getColor(x, y) != color) {
+                        ERRORF(reporter, "Flush %d: expected 0x%08x at (%d, %d), got 0x%08x",
+                               flush, color, x, y, bitmap.getColor(x, y));
+                        return;
+                    }
+                }
+            }
+        }
+    }
+}
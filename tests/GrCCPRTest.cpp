@@ -130,6 +130,8 @@ public:
         fCtx->flush();
     }
 
+    bool doStroke() const { return fDoStroke; }
+
 private:
     sk_sp<GrContext> fCtx;
     GrCoverageCountingPathRenderer* fCCPR;
@@ -493,6 +495,63 @@ class CCPR_cache_recycleEntries : public CCPRCacheTest {
 };
 DEF_CCPR_TEST(CCPR_cache_recycleEntries)
 
+// Ensures cached masks get resampled, rather than re-rendered, when an animation only rotates or
+// shrinks the paths.
+class CCPR_cache_animationResample : public CCPRCacheTest {
+    void customizeOptions(GrMockOptions*, GrContextOptions* ctxOptions) override {
+        ctxOptions->fAllowPathMaskCaching = true;
+        ctxOptions->fAllowPathMaskResampling = true;
+    }
+
+    void onRun(skiatest::Reporter* reporter, CCPRPathDrawer& ccpr,
+               const RecordLastMockAtlasIDs& atlasIDRecorder) override {
+        SkMatrix m = SkMatrix::MakeTrans(kCanvasSize/2, kCanvasSize/2);
+        m.preScale(80, 80);
+        m.preTranslate(-.5,-.5);
+
+        // Go twice. Paths have to get drawn twice with the same matrix before we cache their mask.
+        for (int i = 0; i < 2; ++i) {
+            this->drawPathsAndFlush(ccpr, m);
+            REPORTER_ASSERT(reporter, 0 == atlasIDRecorder.lastCopyAtlasID());
+            REPORTER_ASSERT(reporter, 0 != atlasIDRecorder.lastRenderedAtlasID());
+        }
+
+        // The first rotated draw resamples the masks, and copies them to an 8-bit atlas.
+        m.preRotate(59, .5, .5);
+        this->drawPathsAndFlush(ccpr, m);
+        REPORTER_ASSERT(reporter, 0 != atlasIDRecorder.lastCopyAtlasID());
+        REPORTER_ASSERT(reporter, 0 == atlasIDRecorder.lastRenderedAtlasID());
+
+        // Further rotations resample the 8-bit copies.
+        for (int i = 0; i < 10; ++i) {
+            m.preRotate(59, .5, .5);
+            this->drawPathsAndFlush(ccpr, m);
+            REPORTER_ASSERT(reporter, 0 == atlasIDRecorder.lastCopyAtlasID());
+            REPORTER_ASSERT(reporter, 0 == atlasIDRecorder.lastRenderedAtlasID());
+        }
+
+        // Shrinking a fill resamples it too, but hairlines don't shrink with the matrix, so they
+        // have to be re-rendered.
+        m.preScale(.75f, .75f, .5, .5);
+        this->drawPathsAndFlush(ccpr, m);
+        REPORTER_ASSERT(reporter, 0 == atlasIDRecorder.lastCopyAtlasID());
+        REPORTER_ASSERT(reporter,
+                        ccpr.doStroke() == (0 != atlasIDRecorder.lastRenderedAtlasID()));
+
+        // Masks never get magnified.
+        m.preScale(2, 2, .5, .5);
+        this->drawPathsAndFlush(ccpr, m);
+        REPORTER_ASSERT(reporter, 0 != atlasIDRecorder.lastRenderedAtlasID());
+
+#if GR_CACHE_STATS
+        auto cache = ccpr.ccpr()->testingOnly_getPathCache();
+        REPORTER_ASSERT(reporter, cache);
+        REPORTER_ASSERT(reporter, cache->stats().fNumResampledHits > 0);
+#endif
+    }
+};
+DEF_CCPR_TEST(CCPR_cache_animationResample)
+
 // Ensures mostly-visible paths get their full mask cached.
 class CCPR_cache_mostlyVisible : public CCPRCacheTest {
     void onRun(skiatest::Reporter* reporter, CCPRPathDrawer& ccpr,
@@ -0,0 +1,105 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkData.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkSurface.h"
+#include "include/gpu/GrContext.h"
+#include "src/gpu/GrContextPriv.h"
+#include "src/gpu/GrGpu.h"
+#include "src/gpu/GrGpuCapture.h"
+#include "tests/Test.h"
+
+static int count_ops(const GrGpuCapture& capture, GrGpuCapture::Op op) {
+    int count = 0;
+    for (const GrGpuCapture::Command& command : capture.commands()) {
+        count += op == command.fOp;
+    }
+    return count;
+}
+
+DEF_GPUTEST(GrGpuCapture, reporter, /* options */) {
+    sk_sp<GrContext> context = GrContext::MakeMock(nullptr);
+    sk_sp<SkSurface> surface = SkSurface::MakeRenderTarget(context.get(), SkBudgeted::kNo,
+                                                           SkImageInfo::MakeN32Premul(64, 64));
+    if (!surface) {
+        return;
+    }
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(16, 16);
+    bitmap.eraseColor(SK_ColorBLUE);
+    sk_sp<SkImage> image = SkImage::MakeFromBitmap(bitmap);
+
+    GrGpuCapture capture;
+    GrGpu* gpu = context->priv().getGpu();
+    gpu->setCapture(&capture);
+    SkCanvas* canvas = surface->getCanvas();
+    canvas->drawRect(SkRect::MakeWH(32, 32), SkPaint());
+    canvas->drawImage(image, 8, 8);
+    surface->flush();
+    gpu->setCapture(nullptr);
+
+    // The image's pixels are uploaded, either as its texture is made or after, and both draws
+    // reach the GrGpu with their programs.
+    int uploads = 0;
+    for (const GrGpuCapture::Command& command : capture.commands()) {
+        if ((GrGpuCapture::Op::kCreateTexture == command.fOp && command.fCount) ||
+            GrGpuCapture::Op::kWritePixels == command.fOp) {
+            ++uploads;
+            REPORTER_ASSERT(reporter, SkIRect::MakeWH(16, 16) == command.fRect);
+        }
+    }
+    REPORTER_ASSERT(reporter, 1 == uploads);
+    int draws = count_ops(capture, GrGpuCapture::Op::kDraw);
+    REPORTER_ASSERT(reporter, draws >= 2);
+    int programDraws = 0;
+    for (const GrGpuCapture::Program& program : capture.programs()) {
+        REPORTER_ASSERT(reporter, program.fKeyLength > 0);
+        REPORTER_ASSERT(reporter, !program.fPrimitiveProcessor.isEmpty());
+        programDraws += program.fDrawCount;
+    }
+    REPORTER_ASSERT(reporter, capture.programs().count() >= 1);
+    REPORTER_ASSERT(reporter, programDraws == draws);
+
+    // The capture survives a round trip through JSON.
+    sk_sp<SkData> data = capture.serialize();
+    GrGpuCapture copy;
+    REPORTER_ASSERT(reporter, copy.deserialize(data->data(), data->size()));
+    REPORTER_ASSERT(reporter, copy.commands().count() == capture.commands().count());
+    for (int i = 0; i < copy.commands().count(); ++i) {
+        const GrGpuCapture::Command& a = capture.commands()[i];
+        const GrGpuCapture::Command& b = copy.commands()[i];
+        REPORTER_ASSERT(reporter, a.fOp == b.fOp && a.fDst.fID == b.fDst.fID &&
+                                  a.fDst.fConfig == b.fDst.fConfig && a.fRect == b.fRect &&
+                                  a.fCount == b.fCount && a.fProgram == b.fProgram);
+    }
+    REPORTER_ASSERT(reporter, copy.programs().count() == capture.programs().count());
+    for (int i = 0; i < copy.programs().count(); ++i) {
+        REPORTER_ASSERT(reporter, copy.programs()[i].fKeyHash == capture.programs()[i].fKeyHash);
+        REPORTER_ASSERT(reporter, copy.programs()[i].fPrimitiveProcessor.equals(
+                capture.programs()[i].fPrimitiveProcessor));
+    }
+
+    // Replaying against another context repeats the upload, and accounts for the draws.
+    sk_sp<GrContext> replayContext = GrContext::MakeMock(nullptr);
+    GrGpuCapture::ReplayResult result;
+    copy.replay(replayContext.get(), &result);
+    for (auto op : {GrGpuCapture::Op::kCreateTexture, GrGpuCapture::Op::kWritePixels}) {
+        int i = static_cast<int>(op);
+        REPORTER_ASSERT(reporter, result.fCount[i] == count_ops(capture, op));
+        REPORTER_ASSERT(reporter, result.fReplayed[i] == result.fCount[i]);
+    }
+    const int kDraw = static_cast<int>(GrGpuCapture::Op::kDraw);
+    REPORTER_ASSERT(reporter, result.fCount[kDraw] == draws);
+    REPORTER_ASSERT(reporter, 0 == result.fReplayed[kDraw]);
+
+    static const char kNotACapture[] = "{\"version\": 1, \"commands\": 7}";
+    REPORTER_ASSERT(reporter, !copy.deserialize(kNotACapture, sizeof(kNotACapture) - 1));
+    REPORTER_ASSERT(reporter, copy.commands().empty() && copy.programs().empty());
+}
@@ -10,6 +10,7 @@
 #include "include/private/SkTemplates.h"
 #include "include/utils/SkRandom.h"
 #include "src/gpu/GrMemoryPool.h"
+#include "src/gpu/ops/GrOp.h"
 #include "tests/Test.h"
 
 // A is the top of an inheritance tree of classes that overload op new and
@@ -318,3 +319,61 @@ DEF_TEST(GrMemoryPoolAPI, reporter) {
         REPORTER_ASSERT(reporter, pool.size() == hugeBlockSize + kMinAllocSize);
     }
 }
+
+namespace {
+
+class CountedOp : public GrOp {
+public:
+    DEFINE_OP_CLASS_ID
+
+    ~CountedOp() override { --*fLiveCount; }
+
+    const char* name() const override { return "CountedOp"; }
+
+private:
+    friend class ::GrOpMemoryPool;  // for ctor
+
+    CountedOp(int* liveCount) : INHERITED(ClassID()), fLiveCount(liveCount) { ++*fLiveCount; }
+
+    void onPrepare(GrOpFlushState*) override {}
+    void onExecute(GrOpFlushState*, const SkRect&) override {}
+
+    int* fLiveCount;
+
+    typedef GrOp INHERITED;
+};
+
+}  // namespace
+
+DEF_TEST(GrOpMemoryPoolFrameArena, reporter) {
+    GrOpMemoryPool pool(4096, 4096, true);
+    REPORTER_ASSERT(reporter, pool.usesFrameArena());
+    REPORTER_ASSERT(reporter, pool.isEmpty());
+
+    int liveCount = 0;
+    std::unique_ptr<GrOp> first = pool.allocate<CountedOp>(&liveCount);
+    std::unique_ptr<GrOp> second = pool.allocate<CountedOp>(&liveCount);
+    const void* firstAddr = first.get();
+    REPORTER_ASSERT(reporter, liveCount == 2);
+
+    pool.release(std::move(first));
+    REPORTER_ASSERT(reporter, liveCount == 1);
+    REPORTER_ASSERT(reporter, !pool.isEmpty());
+
+    // An op is still alive, so the reset must leave its memory alone.
+    pool.resetFrameArena();
+    std::unique_ptr<GrOp> third = pool.allocate<CountedOp>(&liveCount);
+    REPORTER_ASSERT(reporter, third.get() != firstAddr);
+
+    pool.release(std::move(second));
+    pool.release(std::move(third));
+    REPORTER_ASSERT(reporter, liveCount == 0);
+    REPORTER_ASSERT(reporter, pool.isEmpty());
+
+    // With every op released, the next frame starts over at the beginning of the arena.
+    pool.resetFrameArena();
+    std::unique_ptr<GrOp> next = pool.allocate<CountedOp>(&liveCount);
+    REPORTER_ASSERT(reporter, next.get() == firstAddr);
+    pool.release(std::move(next));
+    REPORTER_ASSERT(reporter, liveCount == 0);
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkFont.h"
+#include "include/core/SkSurface.h"
+#include "include/gpu/GrContext.h"
+#include "src/gpu/GrContextPriv.h"
+#include "src/gpu/GrGpu.h"
+#include "tests/Test.h"
+#include "tools/ToolUtils.h"
+#include "tools/gpu/GrContextFactory.h"
+#include "tools/gpu/MemoryCache.h"
+
+using namespace sk_gpu_test;
+
+static void draw_some_programs(GrContext* context) {
+    SkImageInfo info = SkImageInfo::MakeN32Premul(64, 64);
+    sk_sp<SkSurface> surface = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, info);
+    if (!surface) {
+        return;
+    }
+    SkCanvas* canvas = surface->getCanvas();
+    SkPaint paint;
+    canvas->drawRect(SkRect::MakeXYWH(4, 4, 20, 20), paint);
+    paint.setAntiAlias(true);
+    paint.setColor(SK_ColorBLUE);
+    canvas->drawCircle(40, 40, 12, paint);
+    surface->flush();
+}
+
+DEF_GPUTEST(GrContext_precompileShader, reporter, options) {
+    for (auto type : {GrContextFactory::kGL_ContextType, GrContextFactory::kGLES_ContextType}) {
+        MemoryCache cache;
+        GrContextOptions cacheOptions = options;
+        cacheOptions.fPersistentCache = &cache;
+
+        // Fill the cache the way a previous run of an app would.
+        {
+            GrContextFactory factory(cacheOptions);
+            GrContext* context = factory.get(type);
+            if (!context) {
+                continue;
+            }
+            draw_some_programs(context);
+        }
+        int numEntries = 0;
+        cache.foreach([&numEntries](sk_sp<const SkData>, sk_sp<SkData>, int) { ++numEntries; });
+        REPORTER_ASSERT(reporter, numEntries > 0);
+
+        // A new context should accept every entry, and then draw the same content without
+        // compiling anything.
+        GrContextFactory factory(cacheOptions);
+        GrContext* context = factory.get(type);
+        if (!context) {
+            continue;
+        }
+        cache.foreach([&](sk_sp<const SkData> key, sk_sp<SkData> data, int) {
+            REPORTER_ASSERT(reporter, context->precompileShader(*key, *data));
+        });
+#if GR_GPU_STATS
+        GrGpu::Stats* stats = context->priv().getGpu()->stats();
+        int compilationsBefore = stats->shaderCompilations();
+        draw_some_programs(context);
+        REPORTER_ASSERT(reporter, stats->shaderCompilations() == compilationsBefore);
+#endif
+
+        // Garbage never produces a program.
+        sk_sp<SkData> junk = SkData::MakeWithCString("not a program");
+        REPORTER_ASSERT(reporter, !context->precompileShader(*junk, *junk));
+    }
+}
+
+static bool draw_distance_field_text(GrContext* context, SkBitmap* result) {
+    SkImageInfo info = SkImageInfo::MakeN32Premul(256, 64);
+    SkSurfaceProps props(SkSurfaceProps::kUseDeviceIndependentFonts_Flag,
+                         SkSurfaceProps::kLegacyFontHost_InitType);
+    sk_sp<SkSurface> surface = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, info, 0,
+                                                           &props);
+    if (!surface) {
+        return false;
+    }
+    SkCanvas* canvas = surface->getCanvas();
+    canvas->clear(SK_ColorWHITE);
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    SkFont font(ToolUtils::create_portable_typeface("serif", SkFontStyle()), 40);
+    canvas->drawString("Glyphs", 8, 48, font, paint);
+    result->allocPixels(info);
+    return surface->readPixels(*result, 0, 0);
+}
+
+DEF_GPUTEST(GrContext_distanceFieldGlyphCache, reporter, options) {
+    for (auto type : {GrContextFactory::kGL_ContextType, GrContextFactory::kGLES_ContextType}) {
+        MemoryCache cache;
+        GrContextOptions cacheOptions = options;
+        cacheOptions.fDistanceFieldGlyphCache = &cache;
+
+        SkBitmap generated;
+        {
+            GrContextFactory factory(cacheOptions);
+            GrContext* context = factory.get(type);
+            if (!context || !draw_distance_field_text(context, &generated)) {
+                continue;
+            }
+        }
+        int numEntries = 0;
+        cache.foreach([&numEntries](sk_sp<const SkData>, sk_sp<SkData>, int) { ++numEntries; });
+        REPORTER_ASSERT(reporter, numEntries > 0);
+
+        // A new context should find every glyph in the cache, and draw the same pixels with them.
+        cache.resetNumCacheMisses();
+        GrContextFactory factory(cacheOptions);
+        GrContext* context = factory.get(type);
+        SkBitmap cached;
+        if (!context || !draw_distance_field_text(context, &cached)) {
+            continue;
+        }
+        REPORTER_ASSERT(reporter, cache.numCacheMisses() == 0);
+        for (int y = 0; y < generated.height(); ++y) {
+            REPORTER_ASSERT(reporter, !memcmp(generated.getAddr32(0, y), cached.getAddr32(0, y),
+                                              generated.width() * sizeof(uint32_t)));
+        }
+    }
+}
@@ -6,6 +6,8 @@
  */
 
 #include <set>
+#include "include/core/SkBitmap.h"
+#include "include/core/SkImage.h"
 #include "include/core/SkSurface.h"
 #include "include/gpu/GrContext.h"
 #include "include/gpu/GrRenderTarget.h"
@@ -18,6 +20,7 @@
 #include "src/gpu/GrProxyProvider.h"
 #include "src/gpu/GrResourceProvider.h"
 #include "src/gpu/GrTexturePriv.h"
+#include "src/image/SkImage_Base.h"
 #include "tests/Test.h"
 #include "tests/TestUtils.h"
 
@@ -743,3 +746,65 @@ DEF_GPUTEST_FOR_ALL_CONTEXTS(TextureIdleStateTest, reporter, contextInfo) {
         REPORTER_ASSERT(reporter, flags == (kFlushFlag | kFinishFlag));
     }
 }
+
+DEF_GPUTEST(CompressStaticImages, reporter, options) {
+    GrContextOptions compressOptions = options;
+    compressOptions.fCompressStaticImages = true;
+
+    // Four solid quadrants, which ETC1 should reproduce to within its color quantization.
+    static constexpr int kSize = 16;
+    const SkColor colors[] = {SK_ColorRED, SK_ColorGREEN, SK_ColorBLUE, 0xFF808040};
+    SkBitmap bitmap;
+    bitmap.allocPixels(SkImageInfo::Make(kSize, kSize, kRGBA_8888_SkColorType,
+                                         kOpaque_SkAlphaType));
+    for (int i = 0; i < 4; ++i) {
+        bitmap.erase(colors[i], SkIRect::MakeXYWH((i & 1) * kSize / 2, (i >> 1) * kSize / 2,
+                                                  kSize / 2, kSize / 2));
+    }
+    bitmap.setImmutable();
+    sk_sp<SkImage> image = SkImage::MakeFromBitmap(bitmap);
+
+    for (int type = 0; type < sk_gpu_test::GrContextFactory::kContextTypeCnt; ++type) {
+        sk_gpu_test::GrContextFactory factory(compressOptions);
+        auto contextType = static_cast<sk_gpu_test::GrContextFactory::ContextType>(type);
+        GrContext* context = factory.get(contextType);
+        if (!context) {
+            continue;
+        }
+
+        sk_sp<GrTextureProxy> proxy = as_IB(image)->asTextureProxyRef(
+                context, GrSamplerState::ClampNearest(), nullptr);
+        if (!proxy) {
+            ERRORF(reporter, "Could not upload image.");
+            continue;
+        }
+        bool compressed = context->priv().caps()->isConfigTexturable(kRGB_ETC1_GrPixelConfig);
+        REPORTER_ASSERT(reporter, compressed == (kRGB_ETC1_GrPixelConfig == proxy->config()));
+
+        auto surface = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo,
+                                                   SkImageInfo::MakeN32Premul(kSize, kSize));
+        if (!surface) {
+            continue;
+        }
+        surface->getCanvas()->drawImage(image, 0, 0);
+        SkBitmap result;
+        result.allocPixels(SkImageInfo::Make(kSize, kSize, kRGBA_8888_SkColorType,
+                                             kPremul_SkAlphaType));
+        if (!surface->readPixels(result, 0, 0)) {
+            continue;
+        }
+        for (int y = 0; y < kSize; ++y) {
+            for (int x = 0; x < kSize; ++x) {
+                SkColor expected = bitmap.getColor(x, y);
+                SkColor actual = result.getColor(x, y);
+                int diff = SkTMax(SkTMax(SkTAbs((int)SkColorGetR(expected) - SkColorGetR(actual)),
+                                         SkTAbs((int)SkColorGetG(expected) - SkColorGetG(actual))),
+                                  SkTAbs((int)SkColorGetB(expected) - SkColorGetB(actual)));
+                if (diff > 8 || SkColorGetA(actual) != 0xFF) {
+                    ERRORF(reporter, "Context %d: expected 0x%08x at %d, %d, got 0x%08x.", type,
+                           expected, x, y, actual);
+                }
+            }
+        }
+    }
+}
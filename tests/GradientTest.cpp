@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColorPriv.h"
 #include "include/core/SkShader.h"
@@ -15,6 +16,12 @@
 #include "src/shaders/SkColorShader.h"
 #include "tests/Test.h"
 
+#if SK_SUPPORT_GPU
+#include "include/gpu/GrContext.h"
+#include "include/gpu/GrContextOptions.h"
+#include "src/gpu/GrRecordingContextPriv.h"
+#endif
+
 // https://code.google.com/p/chromium/issues/detail?id=448299
 // Giant (inverse) matrix causes overflow when converting/computing using 32.32
 // Before the fix, we would assert (and then crash).
@@ -537,6 +544,42 @@ static void test_sweep_fuzzer(skiatest::Reporter*) {
     }
 }
 
+// Many stops are looked up through a table of buckets rather than by searching them all. Draw
+// solid bands separated by hard stops, so that every pixel shows which interval it landed in.
+static void test_many_hard_stops(skiatest::Reporter* reporter) {
+    constexpr int kBands = 20;
+    constexpr int kBandWidth = 10;
+    constexpr int kLeft = 20;
+    constexpr int kWidth = 2 * kLeft + kBands * kBandWidth;
+
+    SkColor colors[2 * kBands];
+    SkScalar pos[2 * kBands];
+    for (int i = 0; i < kBands; ++i) {
+        const SkColor color = SkColorSetRGB(12 * i, 255 - 12 * i, (37 * i) & 0xFF);
+        colors[2 * i] = colors[2 * i + 1] = color;
+        pos[2 * i]     = SkIntToScalar(i)     / kBands;
+        pos[2 * i + 1] = SkIntToScalar(i + 1) / kBands;
+    }
+    const SkPoint pts[] = { { kLeft, 0 }, { kLeft + kBands * kBandWidth, 0 } };
+
+    // F16, so that this is drawn by the raster pipeline rather than a legacy shader context.
+    sk_sp<SkSurface> surface = SkSurface::MakeRaster(
+            SkImageInfo::Make(kWidth, 1, kRGBA_F16_SkColorType, kPremul_SkAlphaType));
+    SkPaint paint;
+    paint.setShader(SkGradientShader::MakeLinear(pts, colors, pos, 2 * kBands,
+                                                 SkTileMode::kClamp));
+    surface->getCanvas()->drawPaint(paint);
+
+    SkBitmap pixels;
+    pixels.allocN32Pixels(kWidth, 1);
+    REPORTER_ASSERT(reporter, surface->readPixels(pixels, 0, 0));
+    for (int x = 0; x < kWidth; ++x) {
+        const int band = SkTPin((x - kLeft) / kBandWidth, 0, kBands - 1);
+        REPORTER_ASSERT(reporter, *pixels.getAddr32(x, 0) == SkPreMultiplyColor(colors[2 * band]),
+                        "x = %d", x);
+    }
+}
+
 DEF_TEST(Gradient, reporter) {
     TestGradientShaders(reporter);
     TestGradientOptimization(reporter);
@@ -550,4 +593,40 @@ DEF_TEST(Gradient, reporter) {
     test_degenerate_linear(reporter);
     test_linear_fuzzer(reporter);
     test_sweep_fuzzer(reporter);
+    test_many_hard_stops(reporter);
+}
+
+#if SK_SUPPORT_GPU
+// Gradients with more interval counts than GrContextOptions::fMaxGradientColorizerShapes allows
+// should still draw, with the ones past the limit sharing the textured colorizer.
+DEF_GPUTEST(GradientColorizerShapeLimit, reporter, /*ctxInfo*/) {
+    GrContextOptions options;
+    options.fMaxGradientColorizerShapes = 2;
+    sk_sp<GrContext> context = GrContext::MakeMock(nullptr, options);
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(16, 16);
+    sk_sp<SkSurface> surface = SkSurface::MakeRenderTarget(context.get(), SkBudgeted::kNo, info);
+    REPORTER_ASSERT(reporter, surface);
+    if (!surface) {
+        return;
+    }
+
+    const SkPoint pts[] = {{0, 0}, {16, 0}};
+    const SkColor colors[] = {SK_ColorRED, SK_ColorGREEN, SK_ColorBLUE, SK_ColorBLACK,
+                              SK_ColorWHITE, SK_ColorCYAN};
+    for (int count = 2; count <= (int)SK_ARRAY_COUNT(colors); ++count) {
+        SkPaint paint;
+        paint.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr, count,
+                                                     SkTileMode::kClamp));
+        surface->getCanvas()->drawPaint(paint);
+    }
+    surface->getCanvas()->flush();
+
+    uint32_t shapes =
+            *static_cast<GrRecordingContext*>(context.get())->priv().gradientColorizerShapes();
+    int shapeCount = 0;
+    for (; shapes; shapes &= shapes - 1) {
+        shapeCount++;
+    }
+    REPORTER_ASSERT(reporter, shapeCount == 2, "%d shapes", shapeCount);
 }
+#endif
@@ -9,6 +9,8 @@
 #include "include/core/SkString.h"
 #include "include/private/SkChecksum.h"
 #include "include/private/SkTHash.h"
+#include "include/utils/SkRandom.h"
+#include "src/core/SkTSwissTable.h"
 #include "tests/Test.h"
 
 // Tests use of const foreach().  map.count() is of course the better way to do this.
@@ -199,3 +201,83 @@ DEF_TEST(HashFindOrNull, r) {
 
     REPORTER_ASSERT(r, &seven == table.findOrNull(7));
 }
+
+DEF_TEST(SwissMap, r) {
+    // Check a random mix of sets, removes and finds against SkTHashMap, with enough removes to
+    // fill the table with deleted slots.
+    SkRandom rand;
+    SkTSwissMap<int, int> map;
+    SkTHashMap<int, int> expected;
+    const int kKeyRange = 300;
+    for (int i = 0; i < 20000; i++) {
+        int key = rand.nextULessThan(kKeyRange);
+        switch (rand.nextULessThan(3)) {
+            case 0:
+                map.set(key, i);
+                expected.set(key, i);
+                break;
+            case 1:
+                if (expected.find(key)) {
+                    map.remove(key);
+                    expected.remove(key);
+                }
+                break;
+            default: {
+                int* found = map.find(key);
+                int* expectedFound = expected.find(key);
+                REPORTER_ASSERT(r, SkToBool(found) == SkToBool(expectedFound));
+                REPORTER_ASSERT(r, !found || *found == *expectedFound);
+                break;
+            }
+        }
+        REPORTER_ASSERT(r, map.count() == expected.count());
+    }
+    int n = 0;
+    const SkTSwissMap<int, int>& constMap = map;
+    constMap.foreach([&](int key, int val) {
+        REPORTER_ASSERT(r, expected.find(key) && *expected.find(key) == val);
+        n++;
+    });
+    REPORTER_ASSERT(r, n == expected.count());
+    REPORTER_ASSERT(r, map.approxBytesUsed() > 0);
+
+    map.reset();
+    REPORTER_ASSERT(r, map.count() == 0);
+    REPORTER_ASSERT(r, !map.find(0));
+
+    {
+        // Test that we don't leave dangling values in deleted slots.
+        SkTSwissMap<int, sk_sp<SkRefCnt>> refMap;
+        auto ref = sk_make_sp<SkRefCnt>();
+        refMap.set(0, ref);
+        REPORTER_ASSERT(r, !ref->unique());
+        refMap.remove(0);
+        REPORTER_ASSERT(r, ref->unique());
+    }
+}
+
+DEF_TEST(SwissTableCollisions, r) {
+    // Every key has the same hash, so every probe walks all the groups it has filled.
+    struct HashTraits {
+        static int GetKey(int key) { return key; }
+        static uint32_t Hash(int) { return 42; }
+    };
+
+    SkTSwissTable<int, int, HashTraits> table;
+    const int N = 100;
+    for (int i = 0; i < N; i++) {
+        table.set(i);
+    }
+    REPORTER_ASSERT(r, table.count() == N);
+    for (int i = 0; i < N; i++) {
+        REPORTER_ASSERT(r, table.find(i));
+    }
+    REPORTER_ASSERT(r, !table.find(N));
+
+    for (int i = 0; i < N; i += 2) {
+        table.remove(i);
+    }
+    for (int i = 0; i < N; i++) {
+        REPORTER_ASSERT(r, SkToBool(table.find(i)) == SkToBool(i & 1));
+    }
+}
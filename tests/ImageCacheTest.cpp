@@ -150,3 +150,44 @@ DEF_TEST(ImageCache_doubleAdd, r) {
     REPORTER_ASSERT(r, cache.find(key, TestingRec::Visitor, &value));
     REPORTER_ASSERT(r, 2 == value || 3 == value);
 }
+
+DEF_TEST(ImageCache_discardableCountLimit, r) {
+    SkResourceCache cache(SkDiscardableMemory::Create);
+    cache.setDiscardableCountLimit(4);
+
+    // Purging keeps the cache under the limit.
+    for (int i = 0; i < COUNT; ++i) {
+        cache.add(new TestingRec(TestingKey(i), i));
+    }
+    for (int i = 0; i < COUNT; ++i) {
+        intptr_t value = -1;
+        const bool found = cache.find(TestingKey(i), TestingRec::Visitor, &value);
+        REPORTER_ASSERT(r, found == (i >= COUNT - 3));
+    }
+
+    // Lowering the limit purges right away.
+    cache.setDiscardableCountLimit(2);
+    intptr_t value = -1;
+    REPORTER_ASSERT(r, !cache.find(TestingKey(COUNT - 3), TestingRec::Visitor, &value));
+    REPORTER_ASSERT(r, cache.find(TestingKey(COUNT - 1), TestingRec::Visitor, &value));
+}
+
+DEF_TEST(ImageCache_purgeBytes, r) {
+    SkResourceCache cache(4096);
+    for (int i = 0; i < COUNT; ++i) {
+        cache.add(new TestingRec(TestingKey(i), i));
+    }
+    const size_t recBytes = cache.getTotalBytesUsed() / COUNT;
+
+    // Purges whole entries, least recently used first, until enough has been freed.
+    REPORTER_ASSERT(r, 3 * recBytes == cache.purgeBytes(3 * recBytes - 1));
+    REPORTER_ASSERT(r, (COUNT - 3) * recBytes == cache.getTotalBytesUsed());
+    for (int i = 0; i < COUNT; ++i) {
+        intptr_t value = -1;
+        const bool found = cache.find(TestingKey(i), TestingRec::Visitor, &value);
+        REPORTER_ASSERT(r, found == (i >= 3));
+    }
+
+    REPORTER_ASSERT(r, (COUNT - 3) * recBytes == cache.purgeBytes(SIZE_MAX));
+    REPORTER_ASSERT(r, 0 == cache.getTotalBytesUsed());
+}
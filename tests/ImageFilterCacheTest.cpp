@@ -195,6 +195,7 @@ DEF_TEST(ImageFilterCache_ImageBackedRaster, reporter) {
 #include "include/gpu/GrTexture.h"
 #include "include/private/GrTextureProxy.h"
 #include "src/gpu/GrContextPriv.h"
+#include "src/gpu/GrImageFilterCache.h"
 #include "src/gpu/GrProxyProvider.h"
 #include "src/gpu/GrResourceProvider.h"
 #include "src/gpu/GrSurfaceProxyPriv.h"
@@ -274,3 +275,40 @@ DEF_GPUTEST_FOR_RENDERING_CONTEXTS(ImageFilterCache_GPUBacked, reporter, ctxInfo
     test_internal_purge(reporter, fullImg);
     test_explicit_purging(reporter, fullImg, subsetImg);
 }
+
+// GrImageFilterCache holds no refs on its results: their textures stay in the resource cache under
+// unique keys, and the results are found until the resource cache purges them.
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(ImageFilterCache_ResourceCacheBacked, reporter, ctxInfo) {
+    GrContext* context = ctxInfo.grContext();
+
+    sk_sp<GrTextureProxy> srcProxy(create_proxy(context->priv().proxyProvider()));
+    if (!srcProxy || !srcProxy->instantiate(context->priv().resourceProvider())) {
+        return;
+    }
+
+    sk_sp<SkSpecialImage> image(SkSpecialImage::MakeDeferredFromGpu(
+                                                        context,
+                                                        SkIRect::MakeWH(kFullSize, kFullSize),
+                                                        kNeedNewImageUniqueID_SpecialImage,
+                                                        std::move(srcProxy), nullptr));
+    const uint32_t imageID = image->uniqueID();
+
+    sk_sp<GrImageFilterCache> cache(sk_make_sp<GrImageFilterCache>(context));
+    SkIRect clip = SkIRect::MakeWH(100, 100);
+    SkImageFilterCacheKey key(0, SkMatrix::I(), clip, 0, SkIRect::MakeWH(0, 0));
+
+    SkIPoint offset = SkIPoint::Make(3, 4);
+    auto filter = make_filter();
+    cache->set(key, image.get(), offset, filter.get());
+    image.reset();
+
+    SkIPoint foundOffset;
+    sk_sp<SkSpecialImage> foundImage = cache->get(key, &foundOffset);
+    REPORTER_ASSERT(reporter, foundImage && foundImage->uniqueID() == imageID);
+    REPORTER_ASSERT(reporter, offset == foundOffset);
+    foundImage.reset();
+
+    context->freeGpuResources();
+    REPORTER_ASSERT(reporter, !cache->get(key, &foundOffset));
+    SkDEBUGCODE(REPORTER_ASSERT(reporter, 0 == cache->count());)
+}
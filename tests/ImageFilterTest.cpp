@@ -7,12 +7,14 @@
 
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkGraphics.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkPicture.h"
 #include "include/core/SkPictureRecorder.h"
 #include "include/core/SkPoint3.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkSurface.h"
+#include "include/core/SkUnPreMultiply.h"
 #include "include/effects/SkArithmeticImageFilter.h"
 #include "include/effects/SkBlurImageFilter.h"
 #include "include/effects/SkColorFilterImageFilter.h"
@@ -33,6 +35,7 @@
 #include "include/effects/SkTableColorFilter.h"
 #include "include/effects/SkTileImageFilter.h"
 #include "include/effects/SkXfermodeImageFilter.h"
+#include "include/utils/SkRandom.h"
 #include "src/core/SkImageFilterPriv.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkSpecialImage.h"
@@ -851,6 +854,64 @@ DEF_TEST(ImageFilterDilateThenBlurBounds, reporter) {
     REPORTER_ASSERT(reporter, bounds == expectedBounds);
 }
 
+// Compares dilate and erode against taking the extreme of each pixel's whole window, for radii
+// on both sides of where the raster path switches to the van Herk/Gil-Werman algorithm.
+static void test_morphology(skiatest::Reporter* reporter, bool dilate, int radiusX, int radiusY) {
+    const int kSize = 20, kCanvasSize = 48, kOrigin = 14;
+    SkRandom rand;
+    SkBitmap src;
+    src.allocN32Pixels(kSize, kSize);
+    for (int y = 0; y < kSize; ++y) {
+        for (int x = 0; x < kSize; ++x) {
+            *src.getAddr32(x, y) = SkPreMultiplyARGB(rand.nextU() & 0xFF, rand.nextU() & 0xFF,
+                                                     rand.nextU() & 0xFF, rand.nextU() & 0xFF);
+        }
+    }
+
+    SkBitmap result;
+    result.allocN32Pixels(kCanvasSize, kCanvasSize);
+    result.eraseColor(SK_ColorTRANSPARENT);
+    SkCanvas canvas(result);
+    SkPaint paint;
+    paint.setImageFilter(dilate ? SkDilateImageFilter::Make(radiusX, radiusY, nullptr)
+                                : SkErodeImageFilter::Make(radiusX, radiusY, nullptr));
+    canvas.drawBitmap(src, kOrigin, kOrigin, &paint);
+
+    // Outside the source the layer is transparent, which also erodes the edges of the source.
+    int mismatches = 0;
+    for (int y = 0; y < kCanvasSize; ++y) {
+        for (int x = 0; x < kCanvasSize; ++x) {
+            SkPMColor expected = dilate ? 0 : 0xFFFFFFFF;
+            for (int sy = y - radiusY; sy <= y + radiusY; ++sy) {
+                for (int sx = x - radiusX; sx <= x + radiusX; ++sx) {
+                    SkPMColor p = 0;
+                    if (sx >= kOrigin && sx < kOrigin + kSize &&
+                        sy >= kOrigin && sy < kOrigin + kSize) {
+                        p = *src.getAddr32(sx - kOrigin, sy - kOrigin);
+                    }
+                    uint8_t* e = reinterpret_cast<uint8_t*>(&expected);
+                    const uint8_t* c = reinterpret_cast<const uint8_t*>(&p);
+                    for (int i = 0; i < 4; ++i) {
+                        e[i] = dilate ? SkTMax(e[i], c[i]) : SkTMin(e[i], c[i]);
+                    }
+                }
+            }
+            mismatches += *result.getAddr32(x, y) != expected;
+        }
+    }
+    REPORTER_ASSERT(reporter, 0 == mismatches, "%d mismatches at radius %d x %d",
+                    mismatches, radiusX, radiusY);
+}
+
+DEF_TEST(ImageFilterMorphology, reporter) {
+    for (bool dilate : { true, false }) {
+        test_morphology(reporter, dilate, 1, 1);
+        test_morphology(reporter, dilate, 1, 9);
+        test_morphology(reporter, dilate, 7, 5);
+        test_morphology(reporter, dilate, 30, 2);
+    }
+}
+
 DEF_TEST(ImageFilterScaledBlurRadius, reporter) {
     // Each blur should spread 3*sigma, so 3 for the blur and 30 for the shadow
     // (before the CTM). Bounds should be computed correctly in the presence of
@@ -1141,6 +1202,282 @@ DEF_GPUTEST_FOR_RENDERING_CONTEXTS(ImageFilterMatrixConvolutionBigKernel_Gpu,
     test_big_kernel(reporter, ctxInfo.grContext());
 }
 
+// Compares the raster matrix convolution against applying every tap directly, for kernels that
+// take the separable and FFT paths as well as the direct one.
+static void test_matrix_convolution(skiatest::Reporter* reporter, const SkISize& kernelSize,
+                                    const SkScalar* kernel,
+                                    SkMatrixConvolutionImageFilter::TileMode tileMode,
+                                    bool convolveAlpha) {
+    const int kSize = 40;
+    const SkScalar kGain = 0.75f, kBias = 16;
+    const SkIPoint kernelOffset = SkIPoint::Make(kernelSize.width() / 2, kernelSize.height() / 3);
+    SkRandom rand;
+    SkBitmap src;
+    src.allocN32Pixels(kSize, kSize);
+    for (int y = 0; y < kSize; ++y) {
+        for (int x = 0; x < kSize; ++x) {
+            *src.getAddr32(x, y) = SkPreMultiplyARGB(rand.nextU() & 0xFF, rand.nextU() & 0xFF,
+                                                     rand.nextU() & 0xFF, rand.nextU() & 0xFF);
+        }
+    }
+
+    sk_sp<SkImageFilter> filter(SkMatrixConvolutionImageFilter::Make(
+            kernelSize, kernel, kGain, kBias, kernelOffset, tileMode, convolveAlpha, nullptr));
+    sk_sp<SkSpecialImage> srcImg(SkSpecialImage::MakeFromRaster(SkIRect::MakeWH(kSize, kSize),
+                                                                src));
+    SkIPoint offset;
+    SkImageFilter::OutputProperties noColorSpace(kN32_SkColorType, nullptr);
+    SkImageFilter::Context ctx(SkMatrix::I(), SkIRect::MakeWH(kSize, kSize), nullptr,
+                               noColorSpace);
+    sk_sp<SkSpecialImage> resultImg(filter->filterImage(srcImg.get(), ctx, &offset));
+    SkBitmap result;
+    if (!resultImg || !resultImg->getROPixels(&result)) {
+        ERRORF(reporter, "matrix convolution failed");
+        return;
+    }
+    REPORTER_ASSERT(reporter, offset.fX == 0 && offset.fY == 0);
+    REPORTER_ASSERT(reporter, result.width() == kSize && result.height() == kSize);
+
+    auto fetch = [&](int x, int y) -> SkColor {
+        switch (tileMode) {
+            case SkMatrixConvolutionImageFilter::kClamp_TileMode:
+                x = SkTPin(x, 0, kSize - 1);
+                y = SkTPin(y, 0, kSize - 1);
+                break;
+            case SkMatrixConvolutionImageFilter::kRepeat_TileMode:
+                x = (x % kSize + kSize) % kSize;
+                y = (y % kSize + kSize) % kSize;
+                break;
+            case SkMatrixConvolutionImageFilter::kClampToBlack_TileMode:
+                if (x < 0 || x >= kSize || y < 0 || y >= kSize) {
+                    return 0;
+                }
+                break;
+        }
+        SkPMColor c = *src.getAddr32(x, y);
+        // Without convolveAlpha the color channels are convolved unpremultiplied.
+        return convolveAlpha ? c : SkUnPreMultiply::PMColorToColor(c);
+    };
+
+    // The faster paths sum in a different order, so allow floor() to land either side.
+    int mismatches = 0;
+    for (int y = 0; y < kSize; ++y) {
+        for (int x = 0; x < kSize; ++x) {
+            double sums[4] = { 0, 0, 0, 0 };
+            for (int cy = 0; cy < kernelSize.height(); ++cy) {
+                for (int cx = 0; cx < kernelSize.width(); ++cx) {
+                    SkColor c = fetch(x + cx - kernelOffset.fX, y + cy - kernelOffset.fY);
+                    double k = kernel[cy * kernelSize.width() + cx];
+                    for (int i = 0; i < 4; ++i) {
+                        sums[i] += ((c >> (8 * i)) & 0xFF) * k;
+                    }
+                }
+            }
+            int channels[4];
+            for (int i = 0; i < 4; ++i) {
+                channels[i] = (int)floor(sums[i] * kGain + kBias);
+            }
+            const SkPMColor actual = *result.getAddr32(x, y);
+            int expected[4];
+            if (convolveAlpha) {
+                // SkPMColor channels, with the color clamped to alpha.
+                const int a = SkTPin(channels[SK_A32_SHIFT / 8], 0, 255);
+                for (int i = 0; i < 4; ++i) {
+                    expected[i] = SkTPin(channels[i], 0, a);
+                }
+                expected[SK_A32_SHIFT / 8] = a;
+            } else {
+                const SkPMColor c = SkPreMultiplyARGB(SkGetPackedA32(*src.getAddr32(x, y)),
+                                                      SkTPin(channels[2], 0, 255),
+                                                      SkTPin(channels[1], 0, 255),
+                                                      SkTPin(channels[0], 0, 255));
+                for (int i = 0; i < 4; ++i) {
+                    expected[i] = (c >> (8 * i)) & 0xFF;
+                }
+            }
+            for (int i = 0; i < 4; ++i) {
+                if (SkTAbs(expected[i] - (int)((actual >> (8 * i)) & 0xFF)) > 1) {
+                    ++mismatches;
+                    break;
+                }
+            }
+        }
+    }
+    REPORTER_ASSERT(reporter, 0 == mismatches, "%d mismatches for a %d x %d kernel",
+                    mismatches, kernelSize.width(), kernelSize.height());
+}
+
+DEF_TEST(ImageFilterMatrixConvolutionLargeKernels, reporter) {
+    SkRandom rand;
+    // A separable kernel, the outer product of a column and a row.
+    const SkISize separableSize = SkISize::Make(7, 5);
+    SkScalar separable[35];
+    SkScalar row[7], column[5];
+    for (SkScalar& r : row) {
+        r = rand.nextRangeScalar(-0.1f, 0.4f);
+    }
+    for (SkScalar& c : column) {
+        c = rand.nextRangeScalar(-0.1f, 0.6f);
+    }
+    for (int y = 0; y < 5; ++y) {
+        for (int x = 0; x < 7; ++x) {
+            separable[y * 7 + x] = column[y] * row[x];
+        }
+    }
+    // Kernels on either side of where the filter switches to FFTs.
+    const SkISize directSize = SkISize::Make(9, 9), fftSize = SkISize::Make(13, 11);
+    SkScalar direct[81], fft[143];
+    for (SkScalar& k : direct) {
+        k = rand.nextRangeScalar(-0.01f, 0.03f);
+    }
+    for (SkScalar& k : fft) {
+        k = rand.nextRangeScalar(-0.005f, 0.015f);
+    }
+
+    for (auto tileMode : { SkMatrixConvolutionImageFilter::kClamp_TileMode,
+                           SkMatrixConvolutionImageFilter::kRepeat_TileMode,
+                           SkMatrixConvolutionImageFilter::kClampToBlack_TileMode }) {
+        for (bool convolveAlpha : { true, false }) {
+            test_matrix_convolution(reporter, separableSize, separable, tileMode, convolveAlpha);
+            test_matrix_convolution(reporter, directSize, direct, tileMode, convolveAlpha);
+            test_matrix_convolution(reporter, fftSize, fft, tileMode, convolveAlpha);
+        }
+    }
+}
+
+// Lighting a window too narrow for the raster path to batch pixels has to match the same pixels
+// lit as part of a wider image, away from the window's edges where the surface normals differ.
+DEF_TEST(ImageFilterLightingBatchedPixels, reporter) {
+    const int kWidth = 48, kHeight = 12, kWindowWidth = 9;
+    SkRandom rand;
+    SkBitmap src;
+    src.allocN32Pixels(kWidth, kHeight);
+    for (int y = 0; y < kHeight; ++y) {
+        for (int x = 0; x < kWidth; ++x) {
+            *src.getAddr32(x, y) = SkPreMultiplyARGB(rand.nextU() & 0xFF, 0xFF, 0xFF, 0xFF);
+        }
+    }
+    sk_sp<SkSpecialImage> srcImg(SkSpecialImage::MakeFromRaster(SkIRect::MakeWH(kWidth, kHeight),
+                                                                src));
+
+    const SkPoint3 direction = SkPoint3::Make(-0.6f, -0.5f, 0.6f);
+    const SkPoint3 location = SkPoint3::Make(20, 4, 30);
+    const SkPoint3 target = SkPoint3::Make(24, 8, 0);
+    const SkScalar surfaceScale = 2, kd = 1.5f, ks = 0.8f, shininess = 6.5f;
+    sk_sp<SkImageFilter> filters[] = {
+        SkLightingImageFilter::MakeDistantLitDiffuse(direction, SK_ColorWHITE, surfaceScale, kd,
+                                                     nullptr),
+        SkLightingImageFilter::MakePointLitDiffuse(location, SK_ColorCYAN, surfaceScale, kd,
+                                                   nullptr),
+        SkLightingImageFilter::MakeSpotLitDiffuse(location, target, 2, 40, SK_ColorWHITE,
+                                                  surfaceScale, kd, nullptr),
+        SkLightingImageFilter::MakeDistantLitSpecular(direction, SK_ColorWHITE, surfaceScale, ks,
+                                                      shininess, nullptr),
+        SkLightingImageFilter::MakePointLitSpecular(location, SK_ColorYELLOW, surfaceScale, ks,
+                                                    shininess, nullptr),
+        SkLightingImageFilter::MakeSpotLitSpecular(location, target, 1, 40, SK_ColorWHITE,
+                                                   surfaceScale, ks, shininess, nullptr),
+    };
+
+    SkImageFilter::OutputProperties noColorSpace(kN32_SkColorType, nullptr);
+    for (const auto& filter : filters) {
+        SkIPoint offset;
+        SkImageFilter::Context ctx(SkMatrix::I(), SkIRect::MakeWH(kWidth, kHeight), nullptr,
+                                   noColorSpace);
+        sk_sp<SkSpecialImage> wideImg(filter->filterImage(srcImg.get(), ctx, &offset));
+        SkBitmap wide;
+        REPORTER_ASSERT(reporter, wideImg && wideImg->getROPixels(&wide));
+        REPORTER_ASSERT(reporter, offset.fX == 0 && offset.fY == 0);
+
+        for (int left = 1; left + kWindowWidth < kWidth; left += 5) {
+            SkIRect window = SkIRect::MakeXYWH(left, 1, kWindowWidth, kHeight - 2);
+            SkImageFilter::Context windowCtx(SkMatrix::I(), window, nullptr, noColorSpace);
+            sk_sp<SkSpecialImage> narrowImg(filter->filterImage(srcImg.get(), windowCtx,
+                                                                &offset));
+            SkBitmap narrow;
+            REPORTER_ASSERT(reporter, narrowImg && narrowImg->getROPixels(&narrow));
+            REPORTER_ASSERT(reporter, offset.fX == window.fLeft && offset.fY == window.fTop);
+
+            int mismatches = 0;
+            for (int y = 1; y < window.height() - 1; ++y) {
+                for (int x = 1; x < window.width() - 1; ++x) {
+                    mismatches += *narrow.getAddr32(x, y) !=
+                                  *wide.getAddr32(window.fLeft + x, window.fTop + y);
+                }
+            }
+            REPORTER_ASSERT(reporter, 0 == mismatches, "%d mismatches at x = %d",
+                            mismatches, left);
+        }
+    }
+}
+
+DEF_TEST(ImageFilterDisplacementBatchedPixels, reporter) {
+    // An odd width, so that each row ends with pixels that aren't part of a batch of eight.
+    const int kWidth = 45, kHeight = 6;
+    SkRandom rand;
+    SkBitmap src;
+    src.allocN32Pixels(kWidth, kHeight);
+    for (int y = 0; y < kHeight; ++y) {
+        for (int x = 0; x < kWidth; ++x) {
+            *src.getAddr32(x, y) = SkPreMultiplyColor(rand.nextU());
+        }
+    }
+    sk_sp<SkSpecialImage> srcImg(SkSpecialImage::MakeFromRaster(SkIRect::MakeWH(kWidth, kHeight),
+                                                                src));
+
+    auto channel = [](SkDisplacementMapEffect::ChannelSelectorType type, SkColor c) {
+        switch (type) {
+            case SkDisplacementMapEffect::kR_ChannelSelectorType: return SkColorGetR(c);
+            case SkDisplacementMapEffect::kG_ChannelSelectorType: return SkColorGetG(c);
+            case SkDisplacementMapEffect::kA_ChannelSelectorType: return SkColorGetA(c);
+            default:                                              return SkColorGetB(c);
+        }
+    };
+    const struct {
+        SkDisplacementMapEffect::ChannelSelectorType fX, fY;
+        SkScalar fScale;
+    } kCases[] = {
+        { SkDisplacementMapEffect::kR_ChannelSelectorType,
+          SkDisplacementMapEffect::kG_ChannelSelectorType,  12 },
+        { SkDisplacementMapEffect::kB_ChannelSelectorType,
+          SkDisplacementMapEffect::kA_ChannelSelectorType,   6 },
+        { SkDisplacementMapEffect::kA_ChannelSelectorType,
+          SkDisplacementMapEffect::kUnknown_ChannelSelectorType, -30 },
+    };
+
+    SkImageFilter::OutputProperties noColorSpace(kN32_SkColorType, nullptr);
+    for (const auto& c : kCases) {
+        sk_sp<SkImageFilter> filter(SkDisplacementMapEffect::Make(c.fX, c.fY, c.fScale, nullptr,
+                                                                  nullptr));
+        SkIPoint offset;
+        SkImageFilter::Context ctx(SkMatrix::I(), SkIRect::MakeWH(kWidth, kHeight), nullptr,
+                                   noColorSpace);
+        sk_sp<SkSpecialImage> resultImg(filter->filterImage(srcImg.get(), ctx, &offset));
+        SkBitmap result;
+        REPORTER_ASSERT(reporter, resultImg && resultImg->getROPixels(&result));
+        REPORTER_ASSERT(reporter, offset.fX == 0 && offset.fY == 0);
+
+        // Every pixel should be the one a pixel at a time evaluation of the filter picks.
+        const SkScalar scale = c.fScale * SkScalarInvert(255);
+        const SkScalar adjust = SK_ScalarHalf - c.fScale * SK_ScalarHalf;
+        int mismatches = 0;
+        for (int y = 0; y < kHeight; ++y) {
+            for (int x = 0; x < kWidth; ++x) {
+                SkColor displ = SkUnPreMultiply::PMColorToColor(*src.getAddr32(x, y));
+                int srcX = x + SkScalarTruncToInt(scale * channel(c.fX, displ) + adjust);
+                int srcY = y + SkScalarTruncToInt(scale * channel(c.fY, displ) + adjust);
+                SkPMColor expected = 0;
+                if (srcX >= 0 && srcX < kWidth && srcY >= 0 && srcY < kHeight) {
+                    expected = *src.getAddr32(srcX, srcY);
+                }
+                mismatches += *result.getAddr32(x, y) != expected;
+            }
+        }
+        REPORTER_ASSERT(reporter, 0 == mismatches, "%d mismatches with scale %g",
+                        mismatches, c.fScale);
+    }
+}
+
 DEF_TEST(ImageFilterCropRect, reporter) {
     test_crop_rects(reporter, nullptr);
 }
@@ -1437,6 +1774,94 @@ DEF_TEST(XfermodeImageFilterCroppedInput, reporter) {
     test_xfermode_cropped_input(SkSurface::MakeRasterN32Premul(100, 100).get(), reporter);
 }
 
+// Color filter and offset nodes are applied in the same pass as the filter consuming them. That
+// must draw the same as running each node on its own, which a crop rect forces.
+static sk_sp<SkImageFilter> make_pointwise_dag(const SkImageFilter::CropRect* cropRect) {
+    auto colorize = [cropRect](SkColor color, sk_sp<SkImageFilter> input) {
+        return SkColorFilterImageFilter::Make(SkColorFilters::Blend(color, SkBlendMode::kSrcIn),
+                                              std::move(input), cropRect);
+    };
+    sk_sp<SkImageFilter> background =
+            colorize(SK_ColorBLUE, SkOffsetImageFilter::Make(3, 2, colorize(SK_ColorGREEN, nullptr),
+                                                             cropRect));
+    sk_sp<SkImageFilter> foreground =
+            SkOffsetImageFilter::Make(-2, 4, colorize(SK_ColorRED, nullptr), cropRect);
+    return SkXfermodeImageFilter::Make(SkBlendMode::kSrcOver, std::move(background),
+                                       std::move(foreground), cropRect);
+}
+
+static void test_fused_pointwise_inputs(skiatest::Reporter* reporter, SkSurface* fusedSurface,
+                                        SkSurface* unfusedSurface) {
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(20, 20);
+    bitmap.eraseColor(SK_ColorWHITE);
+    bitmap.erase(0x80FFFFFF, SkIRect::MakeLTRB(10, 0, 20, 20));
+
+    SkImageFilter::CropRect cropRect(SkRect::MakeWH(100, 100));
+    SkSurface* surfaces[] = { fusedSurface, unfusedSurface };
+    for (int i = 0; i < 2; ++i) {
+        SkPaint paint;
+        paint.setImageFilter(make_pointwise_dag(i == 0 ? nullptr : &cropRect));
+        surfaces[i]->getCanvas()->clear(0x0);
+        surfaces[i]->getCanvas()->drawBitmap(bitmap, 10, 10, &paint);
+    }
+
+    SkBitmap fused, unfused;
+    SkImageInfo info = SkImageInfo::MakeN32Premul(40, 40);
+    fused.allocPixels(info);
+    unfused.allocPixels(info);
+    REPORTER_ASSERT(reporter, fusedSurface->readPixels(fused, 0, 0));
+    REPORTER_ASSERT(reporter, unfusedSurface->readPixels(unfused, 0, 0));
+    REPORTER_ASSERT(reporter, 0 == memcmp(fused.getPixels(), unfused.getPixels(),
+                                          fused.computeByteSize()));
+}
+
+DEF_TEST(ImageFilterFusedPointwiseInputs, reporter) {
+    SkImageInfo info = SkImageInfo::MakeN32Premul(40, 40);
+    test_fused_pointwise_inputs(reporter, SkSurface::MakeRaster(info).get(),
+                                SkSurface::MakeRaster(info).get());
+}
+
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(ImageFilterFusedPointwiseInputs_Gpu, reporter, ctxInfo) {
+    SkImageInfo info = SkImageInfo::MakeN32Premul(40, 40);
+    GrContext* context = ctxInfo.grContext();
+    test_fused_pointwise_inputs(reporter,
+                                SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, info).get(),
+                                SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, info).get());
+}
+
+// Drawing a layer through a filter DAG tile by tile must match drawing it in one go, including
+// next to the tile edges, where the blur reads pixels of the neighbouring tiles.
+DEF_TEST(ImageFilterTiledEvaluation, reporter) {
+    sk_sp<SkColorFilter> red(SkColorFilters::Blend(SK_ColorRED, SkBlendMode::kSrcIn));
+    sk_sp<SkImageFilter> blur(SkBlurImageFilter::Make(4, 4, nullptr));
+    sk_sp<SkImageFilter> filter(SkXfermodeImageFilter::Make(
+            SkBlendMode::kSrcOver, SkColorFilterImageFilter::Make(red, blur),
+            SkOffsetImageFilter::Make(7, -5, nullptr), nullptr));
+
+    auto draw = [&](int tileSize, SkBitmap* bitmap) {
+        const int prevTileSize = SkGraphics::SetImageFilterTileSize(tileSize);
+        bitmap->allocN32Pixels(200, 150);
+        bitmap->eraseColor(SK_ColorTRANSPARENT);
+        SkCanvas canvas(*bitmap);
+        SkPaint layerPaint;
+        layerPaint.setImageFilter(filter);
+        canvas.saveLayer(nullptr, &layerPaint);
+        SkPaint paint;
+        paint.setColor(SK_ColorBLUE);
+        canvas.drawCircle(100, 75, 50, paint);
+        canvas.restore();
+        SkGraphics::SetImageFilterTileSize(prevTileSize);
+    };
+
+    SkBitmap whole, tiled;
+    draw(0, &whole);
+    // 35 tiles, more than are filtered in one batch.
+    draw(32, &tiled);
+    REPORTER_ASSERT(reporter, 0 == memcmp(whole.getPixels(), tiled.getPixels(),
+                                          whole.computeByteSize()));
+}
+
 static void test_composed_imagefilter_offset(skiatest::Reporter* reporter, GrContext* context) {
     sk_sp<SkSpecialImage> srcImg(create_empty_special_image(context, 100));
 
@@ -1672,6 +2097,39 @@ DEF_TEST(ImageFilterBlurLargeImage, reporter) {
     test_large_blur_input(reporter, surface->getCanvas());
 }
 
+// Wide raster blurs are done at a reduced resolution, which should still spread the source
+// evenly and keep all of its coverage.
+DEF_TEST(ImageFilterBlurLargeSigma, reporter) {
+    auto surface(SkSurface::MakeRaster(SkImageInfo::MakeN32Premul(320, 320)));
+    SkCanvas* canvas = surface->getCanvas();
+    canvas->clear(SK_ColorTRANSPARENT);
+
+    SkPaint paint;
+    paint.setImageFilter(SkBlurImageFilter::Make(40, 40, nullptr));
+    canvas->saveLayer(nullptr, &paint);
+    canvas->drawRect(SkRect::MakeXYWH(144, 144, 32, 32), SkPaint());
+    canvas->restore();
+
+    SkBitmap bitmap;
+    bitmap.allocPixels(SkImageInfo::MakeN32Premul(320, 320));
+    surface->readPixels(bitmap, 0, 0);
+
+    double total = 0;
+    for (int y = 0; y < 320; ++y) {
+        for (int x = 0; x < 320; ++x) {
+            total += SkColorGetA(bitmap.getColor(x, y));
+        }
+    }
+    REPORTER_ASSERT(reporter, SkTAbs(total / (32 * 32 * 255) - 1) < 0.03, "%g", total);
+
+    // The blur is centered on the rect.
+    for (int d = 0; d < 150; d += 10) {
+        int center = SkColorGetA(bitmap.getColor(160, 160 + d));
+        REPORTER_ASSERT(reporter, SkTAbs(SkColorGetA(bitmap.getColor(160 + d, 160)) - center) <= 3);
+        REPORTER_ASSERT(reporter, SkTAbs(SkColorGetA(bitmap.getColor(160 - d, 160)) - center) <= 3);
+    }
+}
+
 static void test_make_with_filter(skiatest::Reporter* reporter, GrContext* context) {
     sk_sp<SkSurface> surface(create_surface(context, 192, 128));
     surface->getCanvas()->clear(SK_ColorRED);
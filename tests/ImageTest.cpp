@@ -29,6 +29,7 @@
 #include "src/core/SkUtils.h"
 #include "src/gpu/GrContextPriv.h"
 #include "src/gpu/GrGpu.h"
+#include "src/gpu/GrImageTextureMaker.h"
 #include "src/gpu/GrResourceCache.h"
 #include "src/gpu/SkGr.h"
 #include "src/image/SkImage_Base.h"
@@ -368,6 +369,63 @@ DEF_GPUTEST_FOR_RENDERING_CONTEXTS(SkImage_Gpu2Cpu, reporter, ctxInfo) {
     }
 }
 
+/*
+ *  Lazy images drawn well below their size should decode, and cache, at a reduced size rather
+ *  than the full one, and share that decode with draws at smaller scales.
+ */
+DEF_TEST(SkImage_Lazy_scaledDecode, reporter) {
+    sk_sp<SkImage> image = SkImage::MakeFromEncoded(
+            GetResourceAsData("images/mandrill_512_q075.jpg"));
+    if (!image) {
+        ERRORF(reporter, "Error creating image.");
+        return;
+    }
+    const SkIRect bounds = image->bounds();
+    auto surface(SkSurface::MakeRaster(SkImageInfo::MakeN32Premul(64, 64)));
+
+    auto draw = [&](float scale) {
+        SkPaint paint;
+        paint.setFilterQuality(kMedium_SkFilterQuality);
+        surface->getCanvas()->save();
+        surface->getCanvas()->scale(scale, scale);
+        surface->getCanvas()->drawImage(image, 0, 0, &paint);
+        surface->getCanvas()->restore();
+    };
+    auto isCached = [&](const SkBitmapCacheDesc& desc) {
+        SkBitmap cachedBitmap;
+        return SkBitmapCache::Find(desc, &cachedBitmap);
+    };
+
+    draw(1 / 8.f);
+    if (!isCached(SkBitmapCacheDesc::MakeScaled(image->uniqueID(), bounds, {64, 64}))) {
+        // unexpected, but not really a bug, since the cache is global and this test may be
+        // run w/ other threads competing for its budget.
+        SkDebugf("SkImage_Lazy_scaledDecode : scaled bitmap was already purged\n");
+        return;
+    }
+    REPORTER_ASSERT(reporter, !isCached(SkBitmapCacheDesc::Make(image.get())));
+
+    draw(1 / 16.f);
+    REPORTER_ASSERT(reporter,
+                    !isCached(SkBitmapCacheDesc::MakeScaled(image->uniqueID(), bounds, {32, 32})));
+
+    // The reduced decode should look like the full one, filtered down.
+    SkBitmap scaled;
+    REPORTER_ASSERT(reporter, as_IB(image)->getROPixelsForScale({0.125f, 0.125f}, &scaled));
+    REPORTER_ASSERT(reporter, scaled.width() == 64 && scaled.height() == 64);
+    SkBitmap full;
+    REPORTER_ASSERT(reporter, full.tryAllocPixels(SkImageInfo::MakeN32Premul(64, 64)));
+    REPORTER_ASSERT(reporter, image->scalePixels(full.pixmap(), kMedium_SkFilterQuality,
+                                                 SkImage::kDisallow_CachingHint));
+    int maxDiff = 0;
+    for (int y = 0; y < 64; ++y) {
+        for (int x = 0; x < 64; ++x) {
+            SkColor a = scaled.getColor(x, y), b = full.getColor(x, y);
+            maxDiff = SkTMax(maxDiff, SkTAbs((int)SkColorGetG(a) - (int)SkColorGetG(b)));
+        }
+    }
+    REPORTER_ASSERT(reporter, maxDiff < 64);
+}
 DEF_GPUTEST_FOR_RENDERING_CONTEXTS(SkImage_makeTextureImage, reporter, contextInfo) {
     GrContext* context = contextInfo.grContext();
     sk_gpu_test::TestContext* testContext = contextInfo.testContext();
@@ -453,6 +511,35 @@ DEF_GPUTEST_FOR_RENDERING_CONTEXTS(SkImage_makeTextureImage, reporter, contextIn
     }
 }
 
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(SkImage_makeTextureImageFromTransferBuffer, reporter,
+                                   contextInfo) {
+    GrContext* context = contextInfo.grContext();
+    sk_sp<SkImage> image = SkImage::MakeFromEncoded(GetResourceAsData("images/mandrill_128.png"));
+    if (!image) {
+        ERRORF(reporter, "Error creating image.");
+        return;
+    }
+
+    // Whether or not the lazy image can decode straight into a transfer buffer, the texture
+    // must hold the same pixels as a raster decode.
+#if GR_GPU_STATS
+    GrGpu::Stats* stats = context->priv().getGpu()->stats();
+    int transfersBefore = stats->transfersToTexture();
+#endif
+    sk_sp<SkImage> texImage = image->makeTextureImage(context, nullptr);
+    if (!texImage || !texImage->isTextureBacked()) {
+        ERRORF(reporter, "makeTextureImage failed.");
+        return;
+    }
+    REPORTER_ASSERT(reporter, ToolUtils::equal_pixels(image.get(), texImage.get()));
+#if GR_GPU_STATS
+    const GrCaps* caps = context->priv().caps();
+    if (caps->transferBufferSupport() && GrCaps::kNone_MapFlags != caps->mapBufferFlags()) {
+        REPORTER_ASSERT(reporter, stats->transfersToTexture() > transfersBefore);
+    }
+#endif
+}
+
 DEF_GPUTEST_FOR_RENDERING_CONTEXTS(SkImage_makeNonTextureImage, reporter, contextInfo) {
     GrContext* context = contextInfo.grContext();
 
@@ -1495,3 +1582,34 @@ DEF_GPUTEST_FOR_ALL_CONTEXTS(ImageFlush, reporter, ctxInfo) {
     i2->flush(c);
     REPORTER_ASSERT(reporter, numFlushes() == 1);
 }
+
+DEF_GPUTEST(ImageTextureDownscaledOverBudget, reporter, options) {
+    GrContextOptions downscaleOptions = options;
+    downscaleOptions.fDownscaleImageTexturesOverBudget = true;
+    sk_sp<GrContext> context = GrContext::MakeMock(nullptr, downscaleOptions);
+    sk_sp<SkImage> image = create_codec_image();
+    GrImageTextureMaker maker(context.get(), image.get(), SkImage::kAllow_CachingHint);
+
+    // The full resolution texture doesn't fit the budget, so a half resolution one is made.
+    context->setResourceCacheLimits(100, 1000);
+    SkScalar scaleAdjust[2] = { 1, 1 };
+    sk_sp<GrTextureProxy> proxy =
+            maker.refTextureProxyForParams(GrSamplerState::ClampBilerp(), scaleAdjust);
+    REPORTER_ASSERT(reporter, proxy && proxy->width() == image->width() / 2 &&
+                              proxy->height() == image->height() / 2);
+    REPORTER_ASSERT(reporter, 0.5f == scaleAdjust[0] && 0.5f == scaleAdjust[1]);
+
+    // Callers that can't account for a scale always get the full resolution.
+    proxy = maker.refTextureProxyForParams(GrSamplerState::ClampBilerp(), nullptr);
+    REPORTER_ASSERT(reporter, proxy && proxy->width() == image->width());
+    proxy.reset();
+    context->priv().getResourceCache()->purgeAllUnlocked();
+
+    // Once the budget allows, the full resolution is back.
+    context->setResourceCacheLimits(100, 1 << 20);
+    scaleAdjust[0] = scaleAdjust[1] = 1;
+    proxy = maker.refTextureProxyForParams(GrSamplerState::ClampBilerp(), scaleAdjust);
+    REPORTER_ASSERT(reporter, proxy && proxy->width() == image->width() &&
+                              proxy->height() == image->height());
+    REPORTER_ASSERT(reporter, 1 == scaleAdjust[0] && 1 == scaleAdjust[1]);
+}
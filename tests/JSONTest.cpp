@@ -454,3 +454,81 @@ DEF_TEST(JSON_ParseNumber, reporter) {
         REPORTER_ASSERT(reporter, SkScalarNearlyEqual(**jnumber, test.value, test.tolerance));
     }
 }
+
+DEF_TEST(JSON_DOM_binary, reporter) {
+    static constexpr char json[] =
+        "{ \"k1\": [ 1, 2.5, -3, true, false, null, \"short\", \"a string too long to inline\" ],"
+        "  \"a key too long to inline\": { \"k2\": {}, \"k3\": [ [], [ {} ] ] } }";
+    const DOM dom(json, strlen(json));
+
+    SkDynamicMemoryWStream stream;
+    dom.writeBinary(&stream);
+    const auto binary = stream.detachAsData();
+    const auto* data = static_cast<const char*>(binary->data());
+
+    const DOM loaded(data, binary->size());
+    REPORTER_ASSERT(reporter, loaded.root().is<ObjectValue>());
+    REPORTER_ASSERT(reporter, loaded.root().toString().equals(dom.root().toString()));
+
+    // Malformed blobs load as null.
+    for (size_t size = 4; size < binary->size(); ++size) {
+        REPORTER_ASSERT(reporter, DOM(data, size).root().is<NullValue>());
+    }
+
+    SkString padded(data, binary->size());
+    padded.append("\0\0\0\0\0\0\0\0", 8);
+    REPORTER_ASSERT(reporter, DOM(padded.c_str(), padded.size()).root().is<NullValue>());
+
+    SkString bad_version(data, binary->size());
+    bad_version.writable_str()[4] ^= 0xff;
+    REPORTER_ASSERT(reporter, DOM(bad_version.c_str(), bad_version.size()).root().is<NullValue>());
+}
+
+DEF_TEST(JSON_Parse_long_strings, reporter) {
+    // Strings are scanned in blocks: exercise escapes and scope chars at every block offset.
+    static constexpr struct {
+        const char* escaped;
+        const char* unescaped;
+    } gTerminators[] = {
+        { "\\\"", "\"" },
+        { "\\\\", "\\" },
+        { "\\n" , "\n" },
+        { "}"   , "}"  },
+        { "]"   , "]"  },
+    };
+
+    for (const auto& term : gTerminators) {
+        for (size_t len = 0; len < 40; ++len) {
+            for (size_t pos = 0; pos <= len; ++pos) {
+                SkString expected, json("[ \"");
+                for (size_t i = 0; i <= len; ++i) {
+                    if (i == pos) {
+                        expected.append(term.unescaped);
+                        json.append(term.escaped);
+                    }
+                    if (i < len) {
+                        expected.append("a");
+                        json.append("a");
+                    }
+                }
+                json.append("\" ]");
+
+                const DOM dom(json.c_str(), json.size());
+                const ArrayValue* jarray = dom.root();
+                REPORTER_ASSERT(reporter, jarray && jarray->size() == 1);
+                if (!jarray || jarray->size() != 1) {
+                    continue;
+                }
+
+                const StringValue* jstr = (*jarray)[0];
+                REPORTER_ASSERT(reporter, jstr);
+                REPORTER_ASSERT(reporter,
+                                jstr && SkString(jstr->begin(), jstr->size()).equals(expected));
+            }
+        }
+    }
+
+    // Unterminated.
+    static constexpr char json[] = "[ \"aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa ]";
+    REPORTER_ASSERT(reporter, DOM(json, strlen(json)).root().is<NullValue>());
+}
@@ -1070,3 +1070,56 @@ DEF_TEST(Matrix_maprects, r) {
 DEF_TEST(Matrix_Ctor, r) {
     REPORTER_ASSERT(r, SkMatrix{} == SkMatrix::I());
 }
+
+// mapPoints() and mapHomogeneousPoints() map several points at a time; each should come out just
+// as it would alone, wherever it falls in the batch, and in place or not.
+DEF_TEST(Matrix_mapPointsBatch, r) {
+    SkMatrix affine = SkMatrix::MakeTrans(2, 3);
+    affine.postRotate(15);
+    SkMatrix persp = affine;
+    persp.setPerspX(0.001f);
+    persp.setPerspY(-0.002f);
+    const SkMatrix mats[] = {
+        SkMatrix::MakeTrans(2, 3),
+        SkMatrix::MakeAll(1.5f, 0, 2, 0, 0.5f, 3, 0, 0, 1),
+        affine,
+        persp,
+    };
+
+    constexpr int kCount = 19;
+    SkRandom rand;
+    SkPoint src[kCount];
+    SkPoint3 src3[kCount];
+    for (int i = 0; i < kCount; ++i) {
+        src[i].set(rand.nextRangeF(-100, 100), rand.nextRangeF(-100, 100));
+        src3[i].set(rand.nextRangeF(-100, 100), rand.nextRangeF(-100, 100),
+                    rand.nextRangeF(-2, 2));
+    }
+
+    for (const SkMatrix& m : mats) {
+        for (int count = 0; count <= kCount; ++count) {
+            SkPoint dst[kCount], inPlace[kCount];
+            m.mapPoints(dst, src, count);
+            memcpy(inPlace, src, sizeof(src));
+            m.mapPoints(inPlace, count);
+
+            SkPoint3 dst3[kCount];
+            m.mapHomogeneousPoints(dst3, src3, count);
+
+            for (int i = 0; i < count; ++i) {
+                SkPoint one;
+                m.mapPoints(&one, &src[i], 1);
+                REPORTER_ASSERT(r, dst[i] == one);
+                REPORTER_ASSERT(r, inPlace[i] == one);
+                SkPoint xy = m.mapXY(src[i].fX, src[i].fY);
+                REPORTER_ASSERT(r, scalar_nearly_equal_relative(one.fX, xy.fX));
+                REPORTER_ASSERT(r, scalar_nearly_equal_relative(one.fY, xy.fY));
+
+                SkPoint3 one3;
+                m.mapHomogeneousPoints(&one3, &src3[i], 1);
+                REPORTER_ASSERT(r, dst3[i] == one3);
+                REPORTER_ASSERT(r, naive_homogeneous_mapping(m, src3[i], one3));
+            }
+        }
+    }
+}
@@ -1,3 +1,4 @@
+#include "include/private/SkMalloc.h"
 #include "tests/Test.h"
 
 DEF_TEST(memory_calloc, reporter) {
@@ -9,3 +10,32 @@ DEF_TEST(memory_calloc, reporter) {
     }
     sk_free(zeros);
 }
+
+DEF_TEST(memory_tags, reporter) {
+    SkMemoryTagStats before;
+    if (!sk_get_memory_tag_stats(SkMemoryTag::kPDF, &before)) {
+        return;  // Not built with SK_TRACK_MEMORY_TAGS.
+    }
+
+    void* block;
+    {
+        SkAutoMemoryTag tag(SkMemoryTag::kPDF);
+        block = sk_malloc_throw(100);
+        block = sk_realloc_throw(block, 300);
+        {
+            // The innermost tag wins.
+            SkAutoMemoryTag inner(SkMemoryTag::kCodec);
+            sk_free(sk_malloc_throw(10));
+        }
+    }
+    SkMemoryTagStats stats;
+    sk_get_memory_tag_stats(SkMemoryTag::kPDF, &stats);
+    REPORTER_ASSERT(reporter, stats.fLiveBytes == before.fLiveBytes + 300);
+    REPORTER_ASSERT(reporter, stats.fAllocationCount == before.fAllocationCount + 2);
+    REPORTER_ASSERT(reporter, stats.fAllocatedBytes == before.fAllocatedBytes + 400);
+
+    // Freeing credits the tag the block was charged to, whatever the current tag is.
+    sk_free(block);
+    sk_get_memory_tag_stats(SkMemoryTag::kPDF, &stats);
+    REPORTER_ASSERT(reporter, stats.fLiveBytes == before.fLiveBytes);
+}
@@ -6,6 +6,7 @@
  */
 
 #include "include/core/SkBitmap.h"
+#include "include/core/SkExecutor.h"
 #include "include/utils/SkRandom.h"
 #include "src/core/SkMipMap.h"
 #include "tests/Test.h"
@@ -209,3 +210,63 @@ DEF_TEST(MipMap_F16, reporter) {
     bmp.eraseColor(0);
     sk_sp<SkMipMap> mipmap(SkMipMap::Build(bmp, nullptr));
 }
+
+// The first level of an even-sized 8888 or A8 base is a plain 2x2 box filter, whichever
+// downsampler SkOpts picked, and building in parallel bands doesn't change any level.
+DEF_TEST(MipMap_boxFilter, reporter) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    SkRandom rand;
+
+    for (SkColorType ct : {kRGBA_8888_SkColorType, kAlpha_8_SkColorType, kRGBA_F16_SkColorType}) {
+        SkBitmap bm;
+        bm.allocPixels(SkImageInfo::Make(2048, 1030, ct, kPremul_SkAlphaType));
+        for (int y = 0; y < bm.height(); ++y) {
+            auto row = (uint8_t*)bm.getAddr(0, y);
+            for (size_t i = 0; i < bm.info().minRowBytes(); ++i) {
+                row[i] = rand.nextU();
+                if (ct == kRGBA_F16_SkColorType && (i & 1)) {
+                    row[i] &= 0x3F;  // Keep the halfs finite.
+                }
+            }
+        }
+
+        sk_sp<SkMipMap> serial(SkMipMap::Build(bm, nullptr));
+        SkExecutor::SetDefault(executor.get());
+        sk_sp<SkMipMap> banded(SkMipMap::Build(bm, nullptr));
+        SkExecutor::SetDefault(nullptr);
+        if (!serial || !banded) {
+            ERRORF(reporter, "Build failed.");
+            continue;
+        }
+
+        REPORTER_ASSERT(reporter, serial->countLevels() == banded->countLevels());
+        for (int i = 0; i < serial->countLevels(); ++i) {
+            SkMipMap::Level a, b;
+            REPORTER_ASSERT(reporter, serial->getLevel(i, &a) && banded->getLevel(i, &b));
+            for (int y = 0; y < a.fPixmap.height(); ++y) {
+                REPORTER_ASSERT(reporter, !memcmp(a.fPixmap.addr(0, y), b.fPixmap.addr(0, y),
+                                                  a.fPixmap.info().minRowBytes()));
+            }
+        }
+
+        if (ct == kRGBA_F16_SkColorType) {
+            continue;
+        }
+        SkMipMap::Level level;
+        REPORTER_ASSERT(reporter, serial->getLevel(0, &level));
+        const int bpp = bm.bytesPerPixel();
+        for (int y = 0; y < level.fPixmap.height(); ++y) {
+            auto p0 = (const uint8_t*)bm.getAddr(0, 2*y),
+                 p1 = (const uint8_t*)bm.getAddr(0, 2*y + 1),
+                 d  = (const uint8_t*)level.fPixmap.addr(0, y);
+            for (int i = 0; i < level.fPixmap.width() * bpp; ++i) {
+                int c = (i / bpp) * 2 * bpp + i % bpp;
+                int expected = (p0[c] + p0[c + bpp] + p1[c] + p1[c + bpp]) >> 2;
+                if (d[i] != expected) {
+                    ERRORF(reporter, "Mismatch at byte %d of row %d of level 0.", i, y);
+                    return;
+                }
+            }
+        }
+    }
+}
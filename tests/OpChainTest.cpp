@@ -159,8 +159,8 @@ private:
  * adding the ops in all possible orders and verifies that the chained executions don't violate
  * painter's order.
  */
-DEF_GPUTEST(OpChainTest, reporter, /*ctxInfo*/) {
-    auto context = GrContext::MakeMock(nullptr);
+static void test_op_chains(skiatest::Reporter* reporter, sk_sp<GrContext> context,
+                           int numPermutations) {
     SkASSERT(context);
     GrSurfaceDesc desc;
     desc.fConfig = kRGBA_8888_GrPixelConfig;
@@ -183,15 +183,13 @@ DEF_GPUTEST(OpChainTest, reporter, /*ctxInfo*/) {
     for (int i = 0; i < kNumOps; ++i) {
         permutation[i] = i;
     }
-    // Op order permutations.
-    static constexpr int kNumPermutations = 100;
     // For a given number of chainability groups, this is the number of random combinability reuslts
     // we will test.
     static constexpr int kNumCombinabilitiesPerGrouping = 20;
     SkRandom random;
     bool repeat = false;
     Combinable combinable;
-    for (int p = 0; p < kNumPermutations; ++p) {
+    for (int p = 0; p < numPermutations; ++p) {
         for (int i = 0; i < kNumOps - 2 && !repeat; ++i) {
             // The current implementation of nextULessThan() is biased. :(
             unsigned j = i + random.nextULessThan(kNumOps - i);
@@ -239,3 +237,15 @@ DEF_GPUTEST(OpChainTest, reporter, /*ctxInfo*/) {
         }
     }
 }
+
+DEF_GPUTEST(OpChainTest, reporter, /*ctxInfo*/) {
+    test_op_chains(reporter, GrContext::MakeMock(nullptr), 100);
+
+    // The shortest search, and one that can reach across the whole op list.
+    for (int distance : {1, kNumOps}) {
+        GrContextOptions options;
+        options.fMaxOpChainDistance = distance;
+        options.fMaxOpMergeDistance = distance;
+        test_op_chains(reporter, GrContext::MakeMock(nullptr, options), 20);
+    }
+}
@@ -8,6 +8,8 @@
 
 #include "include/core/SkCanvas.h"
 #include "include/core/SkExecutor.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkPictureRecorder.h"
 #include "include/core/SkStream.h"
 #include "include/docs/SkPDFDocument.h"
 #include "src/core/SkOSFile.h"
@@ -256,3 +258,141 @@ DEF_TEST(SkPDF_abort_jobs, rep) {
     doc->abort();
 }
 
+// Streamed pages, with and without an executor, still end up in a complete page tree.
+DEF_TEST(SkPDF_stream_pages, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_stream_pages, r);
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool();
+    for (SkExecutor* pageExecutor : {(SkExecutor*)nullptr, executor.get()}) {
+        SkPDF::Metadata metadata;
+        metadata.fStreamPages = true;
+        metadata.fExecutor = pageExecutor;
+        SkDynamicMemoryWStream stream;
+        auto doc = SkPDF::MakeDocument(&stream, metadata);
+        SkFont font(ToolUtils::create_portable_typeface(), 12);
+        const int n = 75;
+        for (int i = 0; i < n; ++i) {
+            SkCanvas* canvas = doc->beginPage(612, 792);
+            canvas->drawColor(SkColorSetARGB(0xFF, 0x00, (uint8_t)(255.0f * i / (n - 1)), 0x00));
+            canvas->drawString("Page", 72, 72, font, SkPaint());
+        }
+        doc->close();
+
+        sk_sp<SkData> data = stream.detachAsData();
+        const uint8_t* bytes = data->bytes();
+        REPORTER_ASSERT(r, contains(bytes, data->size(), "/Count 75"));
+        REPORTER_ASSERT(r, contains(bytes, data->size(), "%%EOF"));
+    }
+}
+
+// Pages appended as pictures, with and without an executor, after pages drawn the usual way.
+DEF_TEST(SkPDF_append_pages, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_append_pages, r);
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(64, 64);
+    bitmap.eraseColor(0xFF4F9643);
+    sk_sp<SkImage> image = SkImage::MakeFromBitmap(bitmap);
+    SkFont font(ToolUtils::create_portable_typeface(), 12);
+    const int n = 20;
+    std::vector<sk_sp<SkPicture>> pictures;
+    for (int i = 0; i < n; ++i) {
+        SkPictureRecorder recorder;
+        SkCanvas* canvas = recorder.beginRecording(SkRect::MakeWH(612, 792));
+        canvas->drawColor(SkColorSetARGB(0xFF, 0x00, (uint8_t)(255.0f * i / (n - 1)), 0x00));
+        canvas->drawImage(image, 72, 144);
+        canvas->drawString("Page", 72, 72, font, SkPaint());
+        pictures.push_back(recorder.finishRecordingAsPicture());
+    }
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool();
+    for (SkExecutor* pageExecutor : {(SkExecutor*)nullptr, executor.get()}) {
+        SkPDF::Metadata metadata;
+        metadata.fExecutor = pageExecutor;
+        SkDynamicMemoryWStream stream;
+        auto doc = SkPDF::MakeDocument(&stream, metadata);
+        doc->beginPage(612, 792)->drawString("First", 72, 72, font, SkPaint());
+        SkPDF::AppendPages(doc.get(), pictures.data(), (int)pictures.size());
+        doc->close();
+
+        sk_sp<SkData> data = stream.detachAsData();
+        const uint8_t* bytes = data->bytes();
+        REPORTER_ASSERT(r, contains(bytes, data->size(), "/Count 21"));
+        REPORTER_ASSERT(r, contains(bytes, data->size(), "%%EOF"));
+    }
+}
+
+// Each compression level makes the same document every time, and the lower levels make larger
+// ones. An executor may write the objects in another order, but compresses them the same way.
+DEF_TEST(SkPDF_compression_levels, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_compression_levels, r);
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(64, 64);
+    bitmap.eraseColor(0x804F9643);
+    sk_sp<SkImage> image = SkImage::MakeFromBitmap(bitmap);
+    SkFont font(ToolUtils::create_portable_typeface(), 12);
+    auto make_pdf = [&](SkPDF::Metadata::CompressionLevel level, SkExecutor* executor) {
+        SkPDF::Metadata metadata;
+        metadata.fCompressionLevel = level;
+        metadata.fExecutor = executor;
+        SkDynamicMemoryWStream stream;
+        auto doc = SkPDF::MakeDocument(&stream, metadata);
+        for (int i = 0; i < 10; ++i) {
+            SkCanvas* canvas = doc->beginPage(612, 792);
+            canvas->drawImage(image, 72, 144);
+            for (int y = 72; y < 720; y += 14) {
+                canvas->drawString("The quick brown fox jumps over the lazy dog", 72, y, font,
+                                   SkPaint());
+            }
+        }
+        doc->close();
+        return stream.detachAsData();
+    };
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool();
+    size_t previousSize = 0;
+    for (auto level : {SkPDF::Metadata::kHighButSlow_CompressionLevel,
+                       SkPDF::Metadata::kLowButFast_CompressionLevel,
+                       SkPDF::Metadata::kNone_CompressionLevel}) {
+        sk_sp<SkData> serial = make_pdf(level, nullptr);
+        REPORTER_ASSERT(r, serial->equals(make_pdf(level, nullptr).get()));
+        REPORTER_ASSERT(r, serial->size() == make_pdf(level, executor.get())->size());
+        REPORTER_ASSERT(r, contains(serial->bytes(), serial->size(), "%%EOF"));
+        REPORTER_ASSERT(r, serial->size() > previousSize);
+        previousSize = serial->size();
+    }
+}
+
+// Documents that share a font subset cache make the same fonts as ones that don't, and only the
+// first one adds the subset.
+DEF_TEST(SkPDF_font_subset_cache, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_font_subset_cache, r);
+    sk_sp<SkTypeface> typeface = MakeResourceAsTypeface("fonts/Roboto-Regular.ttf");
+    if (!typeface) {
+        INFOF(r, "Could not run test because Roboto-Regular.ttf is missing.");
+        return;
+    }
+    SkFont font(typeface, 12);
+    auto make_pdf = [&](SkPDF::FontSubsetCache* cache, SkExecutor* executor) {
+        SkPDF::Metadata metadata;
+        metadata.fFontSubsetCache = cache;
+        metadata.fExecutor = executor;
+        SkDynamicMemoryWStream stream;
+        auto doc = SkPDF::MakeDocument(&stream, metadata);
+        doc->beginPage(612, 792)->drawString("Invoice #12345", 72, 72, font, SkPaint());
+        doc->close();
+        return stream.detachAsData();
+    };
+
+    std::unique_ptr<SkPDF::FontSubsetCache> cache = SkPDF::FontSubsetCache::Make(1 << 20);
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool();
+    size_t uncachedSize = make_pdf(nullptr, nullptr)->size();
+    REPORTER_ASSERT(r, make_pdf(cache.get(), nullptr)->size() == uncachedSize);
+    size_t bytesUsed = cache->bytesUsed();
+    REPORTER_ASSERT(r, bytesUsed > 0);
+    REPORTER_ASSERT(r, make_pdf(cache.get(), executor.get())->size() == uncachedSize);
+    REPORTER_ASSERT(r, cache->bytesUsed() == bytesUsed);
+
+    // Subsets bigger than the cache aren't kept.
+    std::unique_ptr<SkPDF::FontSubsetCache> tinyCache = SkPDF::FontSubsetCache::Make(16);
+    REPORTER_ASSERT(r, make_pdf(tinyCache.get(), nullptr)->size() == uncachedSize);
+    REPORTER_ASSERT(r, tinyCache->bytesUsed() == 0);
+}
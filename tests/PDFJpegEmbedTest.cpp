@@ -5,8 +5,10 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkData.h"
+#include "include/core/SkImageEncoder.h"
 #include "include/core/SkImageGenerator.h"
 #include "include/core/SkStream.h"
 #include "include/docs/SkPDFDocument.h"
@@ -79,6 +81,76 @@ DEF_TEST(SkPDF_JpegEmbedTest, r) {
     REPORTER_ASSERT(r, !is_subset_of(cmykData.get(), pdfData.get()));
 }
 
+static int count_images(const SkData* pdf) {
+    static const char kImage[] = "/Subtype /Image";
+    const size_t length = strlen(kImage);
+    int count = 0;
+    for (size_t i = 0; i + length <= pdf->size(); ++i) {
+        count += 0 == memcmp(pdf->bytes() + i, kImage, length);
+    }
+    return count;
+}
+
+/**
+ *  Test that images decoded from the same JPEG share one embedded copy of it, whether they're
+ *  drawn whole or in part.
+ */
+DEF_TEST(SkPDF_JpegEmbedDedupTest, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_JpegEmbedDedupTest, r);
+    sk_sp<SkData> mandrillData(load_resource(r, "SkPDF_JpegEmbedDedupTest",
+                                             "images/mandrill_512_q075.jpg"));
+    if (!mandrillData) {
+        return;
+    }
+    SkDynamicMemoryWStream pdf;
+    auto document = SkPDF::MakeDocument(&pdf);
+    for (int i = 0; i < 3; ++i) {
+        SkCanvas* canvas = document->beginPage(612, 792);
+        // Each page decodes its own copy, as if it came from a separate file.
+        sk_sp<SkImage> image = SkImage::MakeFromEncoded(SkData::MakeWithCopy(
+                mandrillData->data(), mandrillData->size()));
+        canvas->rotate(10.0f * i);
+        canvas->drawImage(image, 50, 50);
+        canvas->drawImageRect(image, SkRect::MakeXYWH(100, 100, 64.5f, 64),
+                              SkRect::MakeXYWH(50, 600, 128, 128), nullptr);
+    }
+    document->close();
+    sk_sp<SkData> pdfData = pdf.detachAsData();
+
+    REPORTER_ASSERT(r, 1 == count_images(pdfData.get()));
+    #ifndef SK_PDF_BASE85_BINARY
+    REPORTER_ASSERT(r, is_subset_of(mandrillData.get(), pdfData.get()));
+    #endif
+}
+
+/**
+ *  Test that an opaque PNG's compressed image data is embedded as is.
+ */
+DEF_TEST(SkPDF_PngEmbedTest, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_PngEmbedTest, r);
+    SkBitmap bitmap;
+    bitmap.allocPixels(SkImageInfo::MakeN32(64, 48, kOpaque_SkAlphaType));
+    for (int y = 0; y < bitmap.height(); ++y) {
+        for (int x = 0; x < bitmap.width(); ++x) {
+            *bitmap.getAddr32(x, y) = SkPreMultiplyColor(SkColorSetRGB(4 * x, 5 * y, x ^ y));
+        }
+    }
+    sk_sp<SkData> pngData = SkEncodeBitmap(bitmap, SkEncodedImageFormat::kPNG, 100);
+    if (!pngData) {
+        return;
+    }
+    SkDynamicMemoryWStream pdf;
+    auto document = SkPDF::MakeDocument(&pdf);
+    document->beginPage(612, 792)->drawImage(SkImage::MakeFromEncoded(pngData), 72, 72);
+    document->close();
+    sk_sp<SkData> pdfData = pdf.detachAsData();
+
+    REPORTER_ASSERT(r, 1 == count_images(pdfData.get()));
+    static const char kPredictor[] = "/Predictor 15";
+    sk_sp<SkData> predictor = SkData::MakeWithoutCopy(kPredictor, strlen(kPredictor));
+    REPORTER_ASSERT(r, is_subset_of(predictor.get(), pdfData.get()));
+}
+
 #ifdef SK_SUPPORT_PDF
 
 #include "src/pdf/SkJpegInfo.h"
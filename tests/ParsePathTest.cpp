@@ -5,9 +5,12 @@
  * found in the LICENSE file.
  */
 
+#include "include/utils/SkParse.h"
 #include "include/utils/SkParsePath.h"
 #include "tests/Test.h"
 
+#include <stdlib.h>
+
 static void test_to_from(skiatest::Reporter* reporter, const SkPath& path) {
     SkString str, str2;
     SkParsePath::ToSVGString(path, &str);
@@ -64,6 +67,43 @@ DEF_TEST(ParsePath, reporter) {
     test_to_from(reporter, p);
 }
 
+DEF_TEST(ParsePath_encoding, r) {
+    using PathEncoding = SkParsePath::PathEncoding;
+
+    SkPath path;
+    path.moveTo(10.5f, 10);
+    path.lineTo(20, 10);
+    path.lineTo(20, 20.25f);
+    path.close();
+    path.moveTo(0.5f, -0.5f);
+    path.cubicTo(1, -1, 2, 0, 3, 1);
+
+    SkString absolute, relative;
+    SkParsePath::ToSVGString(path, &absolute);
+    SkParsePath::ToSVGString(path, &relative, PathEncoding::Relative);
+    REPORTER_ASSERT(r, relative.equals(
+            "m10.5 10l9.5 0 0 10.25-9.5-10.25zm-10-10.5c.5-.5 1.5.5 2.5 1.5"));
+    REPORTER_ASSERT(r, relative.size() < absolute.size());
+
+    // Relative data parses back to the same path.
+    SkPath path2;
+    SkString absolute2;
+    REPORTER_ASSERT(r, SkParsePath::FromSVGString(relative.c_str(), &path2));
+    SkParsePath::ToSVGString(path2, &absolute2);
+    REPORTER_ASSERT(r, absolute == absolute2);
+
+    // Rounded coordinates are measured from the rounded end of the previous command.
+    path.reset();
+    path.moveTo(0.123456f, 1.98765f);
+    path.lineTo(3.14159f, 2.71828f);
+    path.lineTo(3.14159f, 2.71828f);
+    SkString rounded;
+    SkParsePath::ToSVGString(path, &rounded, PathEncoding::Relative, 2);
+    REPORTER_ASSERT(r, rounded.equals("m.12 1.99l3.02.73 0 0"));
+    SkParsePath::ToSVGString(path, &rounded, PathEncoding::Absolute, 2);
+    REPORTER_ASSERT(r, rounded.equals("M.12 1.99L3.14 2.72 3.14 2.72"));
+}
+
 DEF_TEST(ParsePath_invalid, r) {
     SkPath path;
     // This is an invalid SVG string, but the test verifies that we do not
@@ -128,3 +168,25 @@ DEF_TEST(ParsePathOptionalCommand, r) {
         REPORTER_ASSERT(r, path.countPoints() == gTests[i].fPoints);
     }
 }
+
+DEF_TEST(ParseScalar_matchesStrtod, r) {
+    static const char* gNumbers[] = {
+        "0", "-0", "+1", "12", "-12.5", ".5", "-.5", "1.", "1.e5", "1e", "1e+", "2E-3", "6.5e+2x",
+        "0.1", "3.14159", "1.5.5", "9007199254740992", "9007199254740993", "1e22", "1e23", "1e-40",
+        "123456789012345678901234", "0x10", "inf", "nan", "-", ".", "e5",
+    };
+    for (const char* str : gNumbers) {
+        SkScalar value = 0;
+        const char* stop = SkParse::FindScalar(str, &value);
+
+        char* expectedStop;
+        float expected = (float)strtod(str, &expectedStop);
+        if (expectedStop == str) {
+            REPORTER_ASSERT(r, !stop, "%s", str);
+            continue;
+        }
+        REPORTER_ASSERT(r, stop == expectedStop, "%s", str);
+        REPORTER_ASSERT(r, SkScalarIsNaN(expected) ? SkScalarIsNaN(value) : value == expected,
+                        "%s", str);
+    }
+}
@@ -306,3 +306,68 @@ DEF_TEST(contour_measure, reporter) {
     test_empty_contours(reporter);
     test_MLM_contours(reporter);
 }
+
+#include "src/core/SkContourMeasureCache.h"
+#include "src/core/SkResourceCache.h"
+
+static int count_recs(SkResourceCache* cache) {
+    int count = 0;
+    cache->visitAll([](const SkResourceCache::Rec&, void* ctx) { ++*static_cast<int*>(ctx); },
+                    &count);
+    return count;
+}
+
+DEF_TEST(contour_measure_cache, reporter) {
+    SkResourceCache cache(1024 * 1024);
+
+    SkPath path;
+    path.addCircle(0, 0, 100);
+    path.moveTo(5, 5).lineTo(5, 5);                 // zero-length
+    path.moveTo(0, 0).cubicTo(10, 20, 30, -20, 40, 0);
+
+    SkTArray<sk_sp<SkContourMeasure>> first, second;
+    SkScalar length = SkContourMeasureCache::Find(path, false, 1, &first, &cache);
+    {
+        // Matches what the iterator measures, skipping the zero-length contour.
+        SkContourMeasureIter iter(path, false);
+        SkScalar iterLength = 0;
+        int index = 0;
+        while (auto contour = iter.next()) {
+            REPORTER_ASSERT(reporter, index < first.count());
+            if (index < first.count()) {
+                REPORTER_ASSERT(reporter, contour->length() == first[index]->length());
+                REPORTER_ASSERT(reporter, contour->isClosed() == first[index]->isClosed());
+            }
+            iterLength += contour->length();
+            ++index;
+        }
+        REPORTER_ASSERT(reporter, index == first.count());
+        REPORTER_ASSERT(reporter, iterLength == length);
+    }
+    REPORTER_ASSERT(reporter, 2 == first.count());
+
+    // The second lookup shares the first one's contours.
+    REPORTER_ASSERT(reporter, length == SkContourMeasureCache::Find(path, false, 1, &second,
+                                                                    &cache));
+    REPORTER_ASSERT(reporter, 2 == second.count());
+    REPORTER_ASSERT(reporter, first[0] == second[0] && first[1] == second[1]);
+
+    // Different options are measured separately.
+    SkContourMeasureCache::Find(path, true, 1, &second, &cache);
+    REPORTER_ASSERT(reporter, first[1] != second[1]);
+    REPORTER_ASSERT(reporter, second[1]->isClosed());
+    REPORTER_ASSERT(reporter, 2 == count_recs(&cache));
+
+    // Editing the path purges what was measured for it.
+    path.lineTo(100, 100);
+    SkScalar newLength = SkContourMeasureCache::Find(path, false, 1, &second, &cache);
+    REPORTER_ASSERT(reporter, newLength > length);
+    REPORTER_ASSERT(reporter, first[1] != second[1]);
+    REPORTER_ASSERT(reporter, 1 == count_recs(&cache));
+
+    // Volatile paths aren't cached.
+    path.setIsVolatile(true);
+    path.lineTo(200, 100);
+    SkContourMeasureCache::Find(path, false, 1, &second, &cache);
+    REPORTER_ASSERT(reporter, 1 == count_recs(&cache));
+}
@@ -361,3 +361,35 @@ SkOpBuilder builder;
     builder.add(path1, SkPathOp::kUnion_SkPathOp);
     builder.resolve(&path);
 }
+
+// Clusters of overlapping non-convex paths, far enough apart that each cluster can be resolved
+// on its own, must give the same union as adding the paths one at a time.
+DEF_TEST(SkOpBuilderDisjointGroups, reporter) {
+    SkOpBuilder builder;
+    SkPath expected;
+    for (int y = 0; y < 4; ++y) {
+        for (int x = 0; x < 4; ++x) {
+            SkScalar left = x * 60.f, top = y * 60.f;
+            SkPath ell;
+            ell.moveTo(left, top);
+            ell.lineTo(left + 30, top);
+            ell.lineTo(left + 30, top + 10);
+            ell.lineTo(left + 10, top + 10);
+            ell.lineTo(left + 10, top + 40);
+            ell.lineTo(left, top + 40);
+            ell.close();
+            SkPath other = ell;
+            other.offset(15, 15);
+            SkPath circle;
+            circle.addCircle(left + 35, top + 30, 8);
+            for (const SkPath* path : {&ell, &other, &circle}) {
+                builder.add(*path, kUnion_SkPathOp);
+                REPORTER_ASSERT(reporter, Op(expected, *path, kUnion_SkPathOp, &expected));
+            }
+        }
+    }
+    SkPath result;
+    REPORTER_ASSERT(reporter, builder.resolve(&result));
+    int pixelDiff = comparePaths(reporter, __FUNCTION__, expected, result);
+    REPORTER_ASSERT(reporter, pixelDiff == 0);
+}
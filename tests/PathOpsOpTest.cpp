@@ -4,6 +4,7 @@
  * Use of this source code is governed by a BSD-style license that can be
  * found in the LICENSE file.
  */
+#include "src/pathops/SkPathOpsCommon.h"
 #include "tests/PathOpsDebug.h"
 #include "tests/PathOpsExtendedTest.h"
 #include "tests/PathOpsTestCommon.h"
@@ -12548,3 +12549,43 @@ DEF_TEST(PathOpsRepOp, reporter) {
   for (int index = 0; index < 1; ++index)
     RunTestSet(reporter, repTests, SK_ARRAY_COUNT(repTests), nullptr, nullptr, nullptr, false);
 }
+
+// Op and Simplify split paths like these, whose clusters of contours are apart, into a group per
+// cluster. The groups' results should match resolving the paths whole.
+DEF_TEST(PathOpsGroups, reporter) {
+    SkPath one, two;
+    for (int y = 0; y < 6; ++y) {
+        for (int x = 0; x < 6; ++x) {
+            SkScalar left = x * 60.f, top = y * 60.f;
+            SkPath ell;
+            ell.moveTo(left, top);
+            ell.lineTo(left + 30, top);
+            ell.lineTo(left + 30, top + 10);
+            ell.lineTo(left + 10, top + 10);
+            ell.lineTo(left + 10, top + 40);
+            ell.lineTo(left, top + 40);
+            ell.close();
+            one.addPath(ell);
+            ell.offset(15, 15);
+            two.addPath(ell);
+            two.addCircle(left + 35, top + 30, 8);
+        }
+    }
+    for (int op = kDifference_SkPathOp; op <= kReverseDifference_SkPathOp; ++op) {
+        SkPath grouped, whole;
+        REPORTER_ASSERT(reporter, Op(one, two, (SkPathOp) op, &grouped));
+        REPORTER_ASSERT(reporter, OpDebug(one, two, (SkPathOp) op, &whole
+                                          SkDEBUGPARAMS(true) SkDEBUGPARAMS(__FUNCTION__)));
+        REPORTER_ASSERT(reporter, !comparePaths(reporter, __FUNCTION__, whole, grouped));
+    }
+    SkPath both = one;
+    both.addPath(two);
+    for (SkPath::FillType fillType : {SkPath::kWinding_FillType, SkPath::kEvenOdd_FillType}) {
+        both.setFillType(fillType);
+        SkPath grouped, whole;
+        REPORTER_ASSERT(reporter, Simplify(both, &grouped));
+        REPORTER_ASSERT(reporter, SimplifyDebug(both, &whole
+                                                SkDEBUGPARAMS(true) SkDEBUGPARAMS(__FUNCTION__)));
+        REPORTER_ASSERT(reporter, !comparePaths(reporter, __FUNCTION__, whole, grouped));
+    }
+}
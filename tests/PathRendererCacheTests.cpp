@@ -8,15 +8,19 @@
 #include "tests/Test.h"
 
 #include "include/core/SkPath.h"
+#include "include/core/SkStream.h"
 #include "include/gpu/GrContext.h"
+#include "include/private/GrAuditTrail.h"
 #include "src/gpu/GrClip.h"
 #include "src/gpu/GrContextPriv.h"
+#include "src/gpu/GrDrawingManager.h"
 #include "src/gpu/GrResourceCache.h"
 #include "src/gpu/GrShape.h"
 #include "src/gpu/GrSoftwarePathRenderer.h"
 #include "src/gpu/GrStyle.h"
 #include "src/gpu/effects/GrPorterDuffXferProcessor.h"
 #include "src/gpu/ops/GrTessellatingPathRenderer.h"
+#include "src/utils/SkJSONWriter.h"
 
 static SkPath create_concave_path() {
     SkPath path;
@@ -156,3 +160,57 @@ DEF_GPUTEST(SoftwarePathRendererCacheTest, reporter, /* options */) {
     test_path(reporter, create_concave_path, createPR, kExpectedResources, AATypeFlags::kCoverage,
               style);
 }
+
+// Test that path renderers count their draws, name themselves in the audit trail, and explain why
+// they pass on paths.
+DEF_GPUTEST(PathRendererStatsTest, reporter, /* options */) {
+    sk_sp<GrContext> ctx = GrContext::MakeMock(nullptr);
+    const GrBackendFormat format =
+            ctx->priv().caps()->getBackendFormatFromColorType(kRGBA_8888_SkColorType);
+    sk_sp<GrRenderTargetContext> rtc(ctx->priv().makeDeferredRenderTargetContext(
+            format, SkBackingFit::kApprox, 800, 800, kRGBA_8888_GrPixelConfig, nullptr, 1,
+            GrMipMapped::kNo, kTopLeft_GrSurfaceOrigin));
+    if (!rtc) {
+        return;
+    }
+
+    sk_sp<GrTessellatingPathRenderer> pr(new GrTessellatingPathRenderer());
+    SkDynamicMemoryWStream json;
+    {
+        GrAuditTrail* auditTrail = ctx->priv().auditTrail();
+        GrAuditTrail::AutoManageOpList autoManage(auditTrail);
+        draw_path(ctx.get(), rtc.get(), create_concave_path(), pr.get(), AATypeFlags::kNone,
+                  GrStyle::SimpleFill());
+        SkJSONWriter writer(&json);
+        auditTrail->toJson(writer);
+        writer.flush();
+    }
+    sk_sp<SkData> data = json.detachAsData();
+    SkString jsonString(static_cast<const char*>(data->data()), data->size());
+    REPORTER_ASSERT(reporter, jsonString.contains("Path renderer tess"));
+
+#if GR_GPU_STATS
+    const GrPathRendererChain::Stats* stats = ctx->priv().drawingManager()->pathRendererStats();
+    REPORTER_ASSERT(reporter, 1 == stats->numUses("tess"));
+    REPORTER_ASSERT(reporter, 0 == stats->numUses("sw"));
+    // The path has a move, three lines and a close.
+    REPORTER_ASSERT(reporter, 1 == stats->numPathsInVerbCountBucket(1));
+#endif
+
+    pr->setMaxVerbCount(2);
+    SkPath path = create_concave_path();
+    GrShape shape(path, GrStyle::SimpleFill());
+    SkIRect clipConservativeBounds = SkIRect::MakeWH(800, 800);
+    GrPathRenderer::CanDrawPathArgs args;
+    args.fCaps = ctx->priv().caps();
+    args.fClipConservativeBounds = &clipConservativeBounds;
+    args.fViewMatrix = &SkMatrix::I();
+    args.fShape = &shape;
+    args.fAATypeFlags = AATypeFlags::kCoverage;
+    args.fTargetIsWrappedVkSecondaryCB = false;
+    args.fHasUserStencilSettings = false;
+    args.fRejectReason = nullptr;
+    REPORTER_ASSERT(reporter, GrPathRenderer::CanDrawPath::kNo == pr->canDrawPath(args));
+    REPORTER_ASSERT(reporter, args.fRejectReason &&
+                              !strcmp(args.fRejectReason, "too many verbs"));
+}
@@ -5443,3 +5443,58 @@ DEF_TEST(path_last_move_to_index, r) {
 
     copyPath.rConicTo(1, 1, 3, 3, 0.707107f);
 }
+
+DEF_TEST(Path_Make, r) {
+    const SkPoint pts[] = {
+        {0, 0}, {10, 0}, {20, 10}, {20, 20}, {15, 30}, {10, 20},
+        {0, 30}, {10, 40}, {0, 50}, {40, 40},
+    };
+    const uint8_t verbs[] = {
+        SkPath::kMove_Verb, SkPath::kLine_Verb, SkPath::kQuad_Verb, SkPath::kConic_Verb,
+        SkPath::kClose_Verb, SkPath::kMove_Verb, SkPath::kCubic_Verb,
+    };
+    const SkScalar weights[] = { 0.5f };
+
+    SkPath expected;
+    expected.moveTo(pts[0]);
+    expected.lineTo(pts[1]);
+    expected.quadTo(pts[2], pts[3]);
+    expected.conicTo(pts[4], pts[5], weights[0]);
+    expected.close();
+    expected.moveTo(pts[6]);
+    expected.cubicTo(pts[7], pts[8], pts[9]);
+    expected.setFillType(SkPath::kEvenOdd_FillType);
+
+    SkPath path = SkPath::Make(pts, SK_ARRAY_COUNT(pts), verbs, SK_ARRAY_COUNT(verbs),
+                               weights, SK_ARRAY_COUNT(weights), SkPath::kEvenOdd_FillType, true);
+    REPORTER_ASSERT(r, path == expected);
+    REPORTER_ASSERT(r, path.isVolatile());
+    REPORTER_ASSERT(r, path.getSegmentMasks() == expected.getSegmentMasks());
+    REPORTER_ASSERT(r, path.getBounds() == expected.getBounds());
+
+    // Building on top of the made path behaves as if it had been built a verb at a time.
+    path.lineTo(1, 2);
+    expected.lineTo(1, 2);
+    REPORTER_ASSERT(r, path == expected);
+
+    // After a close, the next lineTo starts a contour at the last moveTo.
+    path = SkPath::Make(pts, 4, verbs, 3, nullptr, 0);
+    path.close();
+    path.lineTo(5, 5);
+    expected.reset();
+    expected.moveTo(pts[0]);
+    expected.lineTo(pts[1]);
+    expected.quadTo(pts[2], pts[3]);
+    expected.close();
+    expected.lineTo(5, 5);
+    REPORTER_ASSERT(r, path == expected);
+
+    // Anything that isn't a valid path makes an empty one.
+    REPORTER_ASSERT(r, SkPath::Make(pts, 0, verbs, 0, nullptr, 0).isEmpty());
+    REPORTER_ASSERT(r, SkPath::Make(pts, 1, verbs + 1, 1, nullptr, 0).isEmpty());
+    REPORTER_ASSERT(r, SkPath::Make(pts, 3, verbs, 2, nullptr, 0).isEmpty());
+    REPORTER_ASSERT(r, SkPath::Make(pts, 6, verbs, 4, nullptr, 0).isEmpty());
+    const SkScalar badWeight = -1;
+    REPORTER_ASSERT(r, SkPath::Make(pts, 6, verbs, 4, &badWeight, 1).isEmpty());
+    REPORTER_ASSERT(r, !SkPath::Make(pts, 6, verbs, 4, weights, 1).isEmpty());
+}
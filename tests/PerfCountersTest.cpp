@@ -0,0 +1,107 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkFont.h"
+#include "include/core/SkFontMgr.h"
+#include "include/core/SkGraphics.h"
+#include "include/core/SkString.h"
+#include "include/core/SkSurface.h"
+#include "include/core/SkTraceMemoryDump.h"
+#include "src/core/SkRasterPipeline.h"
+#include "tests/Test.h"
+
+#include <vector>
+
+using PerfCounter = SkGraphics::PerfCounter;
+
+// The counters are shared with every other test running at the same time, so these only check
+// that they went up by at least what we did.
+
+DEF_TEST(PerfCounters_RasterPipeline, r) {
+    uint64_t builds = SkGraphics::GetPerfCounter(PerfCounter::kRasterPipelineBuilds);
+    uint32_t src = 0xff0000ff, dst = 0;
+    SkRasterPipeline_MemoryCtx srcCtx = { &src, 0 },
+                               dstCtx = { &dst, 0 };
+    SkRasterPipeline_<256> p;
+    p.append(SkRasterPipeline::load_8888, &srcCtx);
+    p.append(SkRasterPipeline::store_8888, &dstCtx);
+    p.run(0,0,1,1);
+    p.compile()(0,0,1,1);
+    REPORTER_ASSERT(r, SkGraphics::GetPerfCounter(PerfCounter::kRasterPipelineBuilds) >=
+                       builds + 2);
+
+    // Whether a simple draw gets a legacy blitter depends on the build, but it gets one or the
+    // other.
+    uint64_t blitters = SkGraphics::GetPerfCounter(PerfCounter::kRasterPipelineBlitters) +
+                        SkGraphics::GetPerfCounter(PerfCounter::kLegacyBlitters);
+    auto surface = SkSurface::MakeRasterN32Premul(16, 16);
+    SkPaint paint;
+    paint.setColor(SK_ColorBLUE);
+    surface->getCanvas()->drawRect(SkRect::MakeWH(8, 8), paint);
+    REPORTER_ASSERT(r, SkGraphics::GetPerfCounter(PerfCounter::kRasterPipelineBlitters) +
+                       SkGraphics::GetPerfCounter(PerfCounter::kLegacyBlitters) >= blitters + 1);
+}
+
+DEF_TEST(PerfCounters_StrikeCache, r) {
+    auto surface = SkSurface::MakeRasterN32Premul(64, 64);
+    SkFont font;
+    font.setSize(13.5f);
+    surface->getCanvas()->drawString("a", 8, 32, font, SkPaint());
+
+    // The strike made by the first draw is found by the second.
+    uint64_t hits = SkGraphics::GetPerfCounter(PerfCounter::kStrikeCacheHits);
+    surface->getCanvas()->drawString("a", 8, 32, font, SkPaint());
+    REPORTER_ASSERT(r, SkGraphics::GetPerfCounter(PerfCounter::kStrikeCacheHits) >= hits + 1);
+}
+
+DEF_TEST(PerfCounters_InitPhases, r) {
+    using InitPhase = SkGraphics::InitPhase;
+    SkGraphics::Init();
+    SkFontMgr::RefDefault();
+
+    // Only the first call does (and is charged for) the work.
+    uint64_t opts = SkGraphics::GetInitPhaseNanos(InitPhase::kOpts);
+    uint64_t fontMgr = SkGraphics::GetInitPhaseNanos(InitPhase::kDefaultFontMgr);
+    SkGraphics::Init();
+    SkFontMgr::RefDefault();
+    REPORTER_ASSERT(r, SkGraphics::GetInitPhaseNanos(InitPhase::kOpts) == opts);
+    REPORTER_ASSERT(r, SkGraphics::GetInitPhaseNanos(InitPhase::kDefaultFontMgr) == fontMgr);
+
+    for (int i = 0; i < SkGraphics::kInitPhaseCount; ++i) {
+        REPORTER_ASSERT(r, strlen(SkGraphics::InitPhaseName(static_cast<InitPhase>(i))) > 0);
+    }
+}
+
+namespace {
+
+class CounterDump : public SkTraceMemoryDump {
+public:
+    void dumpNumericValue(const char* dumpName, const char* valueName, const char* units,
+                          uint64_t) override {
+        fDumps.push_back(SkStringPrintf("%s %s %s", dumpName, valueName, units));
+    }
+    void setMemoryBacking(const char*, const char*, const char*) override {}
+    void setDiscardableMemoryBacking(const char*, const SkDiscardableMemory&) override {}
+    LevelOfDetail getRequestedDetails() const override { return kLight_LevelOfDetail; }
+
+    std::vector<SkString> fDumps;
+};
+
+}  // namespace
+
+DEF_TEST(PerfCounters_Dump, r) {
+    CounterDump dump;
+    SkGraphics::DumpPerfCounters(&dump);
+    REPORTER_ASSERT(r, (int)dump.fDumps.size() == SkGraphics::kPerfCounterCount);
+    for (int i = 0; i < SkGraphics::kPerfCounterCount && i < (int)dump.fDumps.size(); ++i) {
+        SkString expected = SkStringPrintf(
+                "skia/perf_counters/%s count events",
+                SkGraphics::PerfCounterName(static_cast<PerfCounter>(i)));
+        REPORTER_ASSERT(r, dump.fDumps[i] == expected, "%s", dump.fDumps[i].c_str());
+    }
+}
@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkPicture.h"
 #include "include/core/SkPictureRecorder.h"
@@ -46,3 +47,38 @@ DEF_TEST(PictureShader_caching, reporter) {
     // All but the local ref should be gone now.
     REPORTER_ASSERT(reporter, picture->unique());
 }
+
+// Filtered picture shaders rasterize their tile at a power-of-two scale, and should still map
+// that tile back onto the picture's own coordinates.
+DEF_TEST(PictureShader_bucketedScale, reporter) {
+    SkPictureRecorder recorder;
+    SkCanvas* pictureCanvas = recorder.beginRecording(20, 20);
+    SkPaint red;
+    red.setColor(SK_ColorRED);
+    pictureCanvas->drawRect(SkRect::MakeWH(10, 20), red);
+    SkPaint green;
+    green.setColor(SK_ColorGREEN);
+    pictureCanvas->drawRect(SkRect::MakeXYWH(10, 0, 10, 20), green);
+    sk_sp<SkPicture> picture = recorder.finishRecordingAsPicture();
+
+    sk_sp<SkSurface> surface = SkSurface::MakeRasterN32Premul(100, 10);
+    for (SkScalar scale : {1.25f, 1.75f, 3.0f}) {
+        SkPaint paint;
+        paint.setShader(picture->makeShader(SkTileMode::kRepeat, SkTileMode::kRepeat));
+        paint.setFilterQuality(kLow_SkFilterQuality);
+        SkCanvas* canvas = surface->getCanvas();
+        canvas->save();
+        canvas->scale(scale, scale);
+        canvas->drawPaint(paint);
+        canvas->restore();
+
+        // Sample the middle of the first red and green halves, away from the filtered edges.
+        SkBitmap bitmap;
+        bitmap.allocN32Pixels(100, 10);
+        REPORTER_ASSERT(reporter, surface->readPixels(bitmap, 0, 0));
+        REPORTER_ASSERT(reporter, bitmap.getColor(SkScalarFloorToInt(5 * scale), 5) ==
+                                  SK_ColorRED, "scale %g", scale);
+        REPORTER_ASSERT(reporter, bitmap.getColor(SkScalarFloorToInt(15 * scale), 5) ==
+                                  SK_ColorGREEN, "scale %g", scale);
+    }
+}
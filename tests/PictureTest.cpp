@@ -12,6 +12,7 @@
 #include "include/core/SkColor.h"
 #include "include/core/SkData.h"
 #include "include/core/SkFontStyle.h"
+#include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPaint.h"
@@ -25,16 +26,21 @@
 #include "include/core/SkStream.h"
 #include "include/core/SkTypeface.h"
 #include "include/core/SkTypes.h"
+#include "include/utils/SkNoDrawCanvas.h"
 #include "include/utils/SkRandom.h"
 #include "src/core/SkBBoxHierarchy.h"
 #include "src/core/SkBigPicture.h"
 #include "src/core/SkClipOpPriv.h"
+#include "src/core/SkMakeUnique.h"
 #include "src/core/SkMiniRecorder.h"
 #include "src/core/SkPicturePriv.h"
 #include "src/core/SkRectPriv.h"
+#include "src/core/SkTaskGroup.h"
 #include "tests/Test.h"
 
+#include <functional>
 #include <memory>
+#include <vector>
 
 class SkRRect;
 class SkRegion;
@@ -713,6 +719,53 @@ DEF_TEST(Picture_SkipBBH, r) {
     REPORTER_ASSERT(r, bbh.searchCalls == 1);
 }
 
+DEF_TEST(Picture_playbackParallel, r) {
+    SkTaskGroup::Enabler enabled(4);
+    const int kSize = 128, kTile = 32, kTilesPerRow = kSize / kTile;
+
+    SkRTreeFactory factory;
+    SkPictureRecorder recorder;
+    SkCanvas* c = recorder.beginRecording(SkRect::MakeIWH(kSize, kSize), &factory);
+    SkRandom rand;
+    for (int i = 0; i < 50; i++) {
+        SkPaint paint;
+        paint.setColor(rand.nextU() | 0xff000000);
+        SkScalar x = rand.nextRangeScalar(0, kSize),
+                 y = rand.nextRangeScalar(0, kSize);
+        c->save();
+            c->clipRect(SkRect::MakeXYWH(x - 20, y - 20, 40, 40));
+            c->drawCircle(x, y, rand.nextRangeScalar(5, 30), paint);
+        c->restore();
+    }
+    sk_sp<SkPicture> picture = recorder.finishRecordingAsPicture();
+
+    SkBitmap expected, actual;
+    expected.allocN32Pixels(kSize, kSize);
+    actual.allocN32Pixels(kSize, kSize);
+    expected.eraseColor(SK_ColorWHITE);
+    actual.eraseColor(SK_ColorWHITE);
+    {
+        SkCanvas canvas(expected);
+        picture->playback(&canvas);
+    }
+
+    std::vector<std::unique_ptr<SkCanvas>> tiles;
+    picture->playbackParallel(kTilesPerRow * kTilesPerRow, [&](int tile) {
+        SkIRect bounds = SkIRect::MakeXYWH((tile % kTilesPerRow) * kTile,
+                                           (tile / kTilesPerRow) * kTile, kTile, kTile);
+        SkBitmap subset;
+        SkAssertResult(actual.extractSubset(&subset, bounds));
+        tiles.push_back(skstd::make_unique<SkCanvas>(subset));
+        tiles.back()->translate(-SkIntToScalar(bounds.fLeft), -SkIntToScalar(bounds.fTop));
+        return tiles.back().get();
+    });
+
+    for (int y = 0; y < kSize; y++) {
+        REPORTER_ASSERT(r, 0 == memcmp(expected.getAddr32(0, y), actual.getAddr32(0, y),
+                                       kSize * sizeof(uint32_t)));
+    }
+}
+
 DEF_TEST(Picture_BitmapLeak, r) {
     SkBitmap mut, immut;
     mut.allocN32Pixels(300, 200);
@@ -879,3 +932,201 @@ DEF_TEST(Picture_empty_serial, reporter) {
     REPORTER_ASSERT(reporter, pic2);
 }
 
+
+DEF_TEST(Picture_MakeFromDataForPlayback, reporter) {
+    SkPictureRecorder rec;
+    SkCanvas* canvas = rec.beginRecording(64, 64);
+    SkPaint paint;
+    paint.setColor(SK_ColorBLUE);
+    canvas->drawRect(SkRect::MakeWH(64, 64), paint);
+    canvas->save();
+        canvas->clipRect(SkRect::MakeXYWH(8, 8, 40, 40));
+        canvas->translate(4, 4);
+        paint.setColor(SK_ColorRED);
+        paint.setAntiAlias(true);
+        canvas->drawCircle(24, 24, 20, paint);
+    canvas->restore();
+    paint.setColor(SK_ColorGREEN);
+    canvas->drawPath(SkPath().moveTo(0, 64).lineTo(32, 40).lineTo(64, 64), paint);
+    sk_sp<SkData> data = rec.finishRecordingAsPicture()->serialize();
+
+    sk_sp<SkPicture> expected = SkPicture::MakeFromData(data.get()),
+                     actual = SkPicture::MakeFromDataForPlayback(data);
+    REPORTER_ASSERT(reporter, expected && actual);
+    REPORTER_ASSERT(reporter, actual->cullRect() == expected->cullRect());
+    REPORTER_ASSERT(reporter, actual->approximateOpCount() > 0);
+
+    SkBitmap expectedBitmap, actualBitmap;
+    expectedBitmap.allocN32Pixels(64, 64);
+    actualBitmap.allocN32Pixels(64, 64);
+    expectedBitmap.eraseColor(SK_ColorTRANSPARENT);
+    actualBitmap.eraseColor(SK_ColorTRANSPARENT);
+    SkCanvas(expectedBitmap).drawPicture(expected);
+    SkCanvas(actualBitmap).drawPicture(actual);
+    REPORTER_ASSERT(reporter, 0 == memcmp(expectedBitmap.getPixels(), actualBitmap.getPixels(),
+                                          expectedBitmap.computeByteSize()));
+
+    // The picture plays back from the data it was made from, which it keeps alive.
+    REPORTER_ASSERT(reporter, !data->unique());
+    actual = nullptr;
+    REPORTER_ASSERT(reporter, data->unique());
+
+    // Garbage doesn't make a picture.
+    sk_sp<SkData> garbage = SkData::MakeWithCopy("skiapict", 8);
+    REPORTER_ASSERT(reporter, !SkPicture::MakeFromDataForPlayback(garbage));
+    REPORTER_ASSERT(reporter, !SkPicture::MakeFromDataForPlayback(nullptr));
+}
+
+namespace {
+class RectCountingCanvas : public SkCanvas {
+public:
+    RectCountingCanvas(int width, int height) : INHERITED(width, height) {}
+
+    void onDrawRect(const SkRect& rect, const SkPaint& paint) override {
+        fRectCount += 1;
+        this->INHERITED::onDrawRect(rect, paint);
+    }
+
+    int fRectCount = 0;
+
+private:
+    typedef SkCanvas INHERITED;
+};
+}  // namespace
+
+DEF_TEST(Picture_MakeFromDataForPlayback_BBH, reporter) {
+    // An 8x8 grid of rects, with a clipped and translated group in the top left cell.
+    SkRTreeFactory factory;
+    SkPictureRecorder rec;
+    SkCanvas* canvas = rec.beginRecording(64, 64, &factory);
+    SkPaint paint;
+    for (int y = 0; y < 8; y++) {
+        for (int x = 0; x < 8; x++) {
+            paint.setColor(SkColorSetARGB(0xFF, x * 32, y * 32, 0x80));
+            canvas->drawRect(SkRect::MakeXYWH(x * 8 + 1, y * 8 + 1, 6, 6), paint);
+        }
+    }
+    canvas->save();
+        canvas->clipRect(SkRect::MakeXYWH(0, 0, 8, 8));
+        canvas->translate(2, 2);
+        paint.setColor(SK_ColorWHITE);
+        canvas->drawRect(SkRect::MakeWH(8, 8), paint);
+    canvas->restore();
+    sk_sp<SkData> data = rec.finishRecordingAsPicture()->serialize();
+
+    sk_sp<SkPicture> expected = SkPicture::MakeFromData(data.get()),
+                     actual = SkPicture::MakeFromDataForPlayback(data);
+    REPORTER_ASSERT(reporter, expected && actual);
+
+    // Only the ops that touch the clip are played back.
+    const SkRect tiles[] = {
+        SkRect::MakeXYWH(16, 16, 16, 16),
+        SkRect::MakeXYWH( 0,  0,  8,  8),
+        SkRect::MakeXYWH(40,  0, 24, 64),
+    };
+    const int rectCounts[] = { 4, 2, 24 };
+    for (size_t i = 0; i < SK_ARRAY_COUNT(tiles); i++) {
+        RectCountingCanvas counter(64, 64);
+        counter.clipRect(tiles[i]);
+        actual->playback(&counter);
+        REPORTER_ASSERT(reporter, counter.fRectCount == rectCounts[i],
+                        "%d != %d", counter.fRectCount, rectCounts[i]);
+
+        SkBitmap expectedBitmap, actualBitmap;
+        expectedBitmap.allocN32Pixels(64, 64);
+        actualBitmap.allocN32Pixels(64, 64);
+        expectedBitmap.eraseColor(SK_ColorTRANSPARENT);
+        actualBitmap.eraseColor(SK_ColorTRANSPARENT);
+        SkCanvas expectedCanvas(expectedBitmap), actualCanvas(actualBitmap);
+        expectedCanvas.clipRect(tiles[i]);
+        actualCanvas.clipRect(tiles[i]);
+        expectedCanvas.drawPicture(expected);
+        actualCanvas.drawPicture(actual);
+        REPORTER_ASSERT(reporter, 0 == memcmp(expectedBitmap.getPixels(),
+                                              actualBitmap.getPixels(),
+                                              expectedBitmap.computeByteSize()));
+    }
+
+    // Without a clip, everything is played back.
+    RectCountingCanvas counter(64, 64);
+    actual->playback(&counter);
+    REPORTER_ASSERT(reporter, counter.fRectCount == 65);
+}
+
+DEF_TEST(Picture_SharedObjectsSerializedOnce, reporter) {
+    // Two copies of the same (hard to compress) pixels, which should be written once.
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(32, 32, true);
+    SkRandom random;
+    for (int y = 0; y < 32; y++) {
+        for (int x = 0; x < 32; x++) {
+            *bitmap.getAddr32(x, y) = random.nextU() | 0xFF000000;
+        }
+    }
+    sk_sp<SkImage> image0 = SkImage::MakeRasterCopy(bitmap.pixmap()),
+                   image1 = SkImage::MakeRasterCopy(bitmap.pixmap());
+    REPORTER_ASSERT(reporter, image0->uniqueID() != image1->uniqueID());
+
+    auto make_picture = [](const std::function<void(SkCanvas*)>& draw) {
+        SkPictureRecorder rec;
+        draw(rec.beginRecording(64, 64));
+        return rec.finishRecordingAsPicture();
+    };
+    // Enough ops that drawPicture() won't unroll them.
+    sk_sp<SkPicture> shared = make_picture([](SkCanvas* canvas) {
+        canvas->drawRect(SkRect::MakeWH(8, 8), SkPaint());
+        canvas->drawRect(SkRect::MakeXYWH(8, 8, 8, 8), SkPaint());
+    });
+    auto make_page = [&](const sk_sp<SkImage>& image) {
+        return make_picture([&](SkCanvas* canvas) {
+            canvas->drawImage(image, 0, 0);
+            canvas->drawPicture(shared);
+        });
+    };
+    sk_sp<SkPicture> page0 = make_page(image0),
+                     page1 = make_page(image1);
+    sk_sp<SkPicture> oneImage = make_picture([&](SkCanvas* canvas) {
+        canvas->drawPicture(page0);
+        canvas->drawPicture(page1);
+    });
+    sk_sp<SkPicture> twoImages = make_picture([&](SkCanvas* canvas) {
+        canvas->drawPicture(page0);
+        canvas->drawPicture(page1);
+        canvas->drawImage(image0, 0, 0);
+        canvas->drawImage(image1, 0, 0);
+    });
+
+    sk_sp<SkData> data = oneImage->serialize();
+    sk_sp<SkPicture> copy = SkPicture::MakeFromData(data.get());
+    REPORTER_ASSERT(reporter, copy);
+
+    // The shared picture and image are read back as one object each.
+    struct ObjectCollector : public SkNoDrawCanvas {
+        ObjectCollector() : SkNoDrawCanvas(64, 64) {}
+
+        void onDrawPicture(const SkPicture* picture, const SkMatrix* matrix,
+                           const SkPaint* paint) override {
+            fPictures.push_back(picture);
+            this->SkNoDrawCanvas::onDrawPicture(picture, matrix, paint);
+        }
+        void onDrawImage(const SkImage* image, SkScalar, SkScalar, const SkPaint*) override {
+            fImages.push_back(image);
+        }
+
+        std::vector<const SkPicture*> fPictures;
+        std::vector<const SkImage*>   fImages;
+    } collector;
+    copy->playback(&collector);
+    REPORTER_ASSERT(reporter, collector.fPictures.size() == 4);
+    REPORTER_ASSERT(reporter, collector.fImages.size() == 2);
+    if (collector.fPictures.size() == 4 && collector.fImages.size() == 2) {
+        // page0, shared, page1, shared
+        REPORTER_ASSERT(reporter, collector.fPictures[0] != collector.fPictures[2]);
+        REPORTER_ASSERT(reporter, collector.fPictures[1] == collector.fPictures[3]);
+        REPORTER_ASSERT(reporter, collector.fImages[0] == collector.fImages[1]);
+    }
+
+    // Drawing the images again at the top level doesn't write them again, either.
+    REPORTER_ASSERT(reporter, data->size() < bitmap.computeByteSize() * 2);
+    REPORTER_ASSERT(reporter, twoImages->serialize()->size() < data->size() + 256);
+}
@@ -11,7 +11,9 @@
 #include "include/core/SkPoint3.h"
 #include "include/core/SkTypes.h"
 #include "include/effects/SkLightingImageFilter.h"
+#include "include/utils/SkRandom.h"
 #include "src/core/SkArenaAlloc.h"
+#include "src/core/SkCanvasPriv.h"
 #include "tests/Test.h"
 
 /*
@@ -166,6 +168,44 @@ DEF_TEST(QuickReject_MatrixState, reporter) {
     canvas.quickReject(SkRect::MakeWH(100.0f, 100.0f));
 }
 
+// SkCanvasPriv::QuickReject() must agree with quickReject() for every rect, including flipped,
+// empty and NaN ones, whatever the matrix.
+DEF_TEST(QuickReject_Batch, reporter) {
+    SkCanvas canvas(100, 100);
+    canvas.clipRect(SkRect::MakeLTRB(10, 20, 90, 70));
+
+    static constexpr int kCount = 103;
+    SkRect rects[kCount];
+    SkRandom rand;
+    for (SkRect& r : rects) {
+        r = SkRect::MakeLTRB(rand.nextRangeF(-50, 150), rand.nextRangeF(-50, 150),
+                             rand.nextRangeF(-50, 150), rand.nextRangeF(-50, 150));
+    }
+    rects[1] = SkRect::MakeEmpty();
+    rects[2] = SkRect::MakeXYWH(40, 40, 10, 0);
+    rects[3].fLeft = SK_ScalarNaN;
+    rects[6].fRight = SK_ScalarNaN;
+    rects[kCount - 1].fBottom = SK_ScalarNaN;
+
+    SkMatrix rotate;
+    rotate.setRotate(30, 50, 50);
+    for (const SkMatrix& matrix : {SkMatrix::I(), SkMatrix::MakeTrans(-15.5f, 7),
+                                   SkMatrix::MakeScale(-2, 0.5f), rotate}) {
+        canvas.setMatrix(matrix);
+        bool rejected[kCount];
+        int count = SkCanvasPriv::QuickReject(canvas, rects, kCount, rejected);
+        int expected = 0;
+        for (int i = 0; i < kCount; ++i) {
+            REPORTER_ASSERT(reporter, rejected[i] == canvas.quickReject(rects[i]), "%d", i);
+            expected += rejected[i];
+        }
+        REPORTER_ASSERT(reporter, count == expected);
+        REPORTER_ASSERT(reporter, rejected[1] && rejected[3] && rejected[6]);
+        REPORTER_ASSERT(reporter, rejected[kCount - 1]);
+        REPORTER_ASSERT(reporter, count > 0 && count < kCount);
+    }
+}
+
 #include "include/core/SkSurface.h"
 #include "include/effects/SkLayerDrawLooper.h"
 DEF_TEST(looper_nothingtodraw, reporter) {
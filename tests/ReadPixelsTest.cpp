@@ -853,3 +853,82 @@ DEF_GPUTEST_FOR_RENDERING_CONTEXTS(AsyncReadPixels, reporter, ctxInfo) {
         }
     }
 }
+
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(AsyncReadPixelsYUV420, reporter, ctxInfo) {
+    static constexpr int kW = 16;
+    static constexpr int kH = 16;
+    struct Context {
+        SkAutoPixmapStorage fPlanes[3];
+        bool fSuceeded = false;
+        bool fCalled = false;
+    };
+    auto callback = [](SkSurface::ReadPixelsContext c, const void* data[3],
+                       const size_t rowBytes[3]) {
+        auto* context = static_cast<Context*>(c);
+        context->fCalled = true;
+        if (!(context->fSuceeded = SkToBool(data))) {
+            return;
+        }
+        for (int i = 0; i < 3; ++i) {
+            SkPixmap& plane = context->fPlanes[i];
+            SkPixmap(plane.info(), data[i], rowBytes[i]).readPixels(plane);
+        }
+    };
+    auto info = SkImageInfo::Make(kW, kH, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+    // The raster surface takes the CPU conversion in SkSurface_Base, which the GPU one must match.
+    sk_sp<SkSurface> surfs[] = {
+            SkSurface::MakeRaster(info),
+            SkSurface::MakeRenderTarget(ctxInfo.grContext(), SkBudgeted::kNo, info)};
+    if (!surfs[1]) {
+        return;
+    }
+    for (const auto& surf : surfs) {
+        for (int j = 0; j < kH; ++j) {
+            for (int i = 0; i < kW; ++i) {
+                SkPaint paint;
+                paint.setColor4f(SkColor4f{i / (float)kW, 1.f - j / (float)kH, (i ^ j) / 16.f, 1.f},
+                                 nullptr);
+                surf->getCanvas()->drawRect(SkRect::MakeXYWH(i, j, 1, 1), paint);
+            }
+        }
+    }
+    for (const auto& rect : {SkIRect::MakeWH(kW, kH), SkIRect::MakeLTRB(2, 2, kW - 4, kH - 6)}) {
+        for (bool odd : {false, true}) {
+            const int dstW = rect.width() + odd;
+            const int dstH = rect.height();
+            Context contexts[2];
+            for (int s = 0; s < 2; ++s) {
+                for (int i = 0; i < 3; ++i) {
+                    contexts[s].fPlanes[i].alloc(
+                            SkImageInfo::MakeA8(i ? dstW / 2 : dstW, i ? dstH / 2 : dstH));
+                }
+                surfs[s]->asyncRescaleAndReadPixelsYUV420(
+                        kRec709_SkYUVColorSpace, nullptr, rect, dstW, dstH,
+                        SkSurface::RescaleGamma::kSrc, kNone_SkFilterQuality, callback,
+                        &contexts[s]);
+                while (!contexts[s].fCalled) {
+                    ctxInfo.grContext()->checkAsyncWorkCompletion();
+                }
+                // Odd dimensions have no 4:2:0 subsampling.
+                REPORTER_ASSERT(reporter, contexts[s].fSuceeded == !odd);
+            }
+            if (odd || !contexts[0].fSuceeded || !contexts[1].fSuceeded) {
+                continue;
+            }
+            for (int i = 0; i < 3; ++i) {
+                const SkPixmap& cpu = contexts[0].fPlanes[i];
+                const SkPixmap& gpu = contexts[1].fPlanes[i];
+                for (int y = 0; y < cpu.height(); ++y) {
+                    for (int x = 0; x < cpu.width(); ++x) {
+                        int diff = *cpu.addr8(x, y) - *gpu.addr8(x, y);
+                        if (diff < -2 || diff > 2) {
+                            ERRORF(reporter, "Plane %d, rect [%d, %d, %d, %d], error at %d, %d: "
+                                   "%d vs %d", i, rect.fLeft, rect.fTop, rect.fRight, rect.fBottom,
+                                   x, y, *cpu.addr8(x, y), *gpu.addr8(x, y));
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
@@ -427,3 +427,131 @@ DEF_TEST(savelayer_srcmode_alpha, r) {
     do_savelayer_srcmode(r, 0x80FF0000);
 }
 
+
+DEF_TEST(RecordOpts_CullOccludedDraws, r) {
+    SkRecord record;
+    SkRecorder recorder(&record, W, H);
+
+    SkPaint opaque;
+    SkPaint translucent;
+    translucent.setAlpha(0x80);
+    SkPaint aa;
+    aa.setAntiAlias(true);
+
+    recorder.drawRect(SkRect::MakeWH(100, 100), SkPaint());          // 0: covered by 4
+    recorder.drawRect(SkRect::MakeXYWH(150, 0, 100, 100), aa);       // 1: anti-aliased
+    recorder.drawRect(SkRect::MakeXYWH(0, 150, 100, 100), SkPaint()); // 2: not covered
+    recorder.drawRect(SkRect::MakeWH(300, 300), translucent);        // 3: covers nothing
+    recorder.drawRect(SkRect::MakeWH(300, 100), opaque);             // 4
+    recorder.drawRect(SkRect::MakeWH(300, 300), aa);                 // 5: anti-aliased cover
+
+    SkRecordCullOccludedDraws(&record);
+    assert_type<SkRecords::NoOp>(r, record, 0);
+    assert_type<SkRecords::DrawRect>(r, record, 1);
+    assert_type<SkRecords::DrawRect>(r, record, 2);
+    assert_type<SkRecords::DrawRect>(r, record, 3);
+    assert_type<SkRecords::DrawRect>(r, record, 4);
+    assert_type<SkRecords::DrawRect>(r, record, 5);
+}
+
+DEF_TEST(RecordOpts_CullOccludedDrawsClipsAndLayers, r) {
+    SkRecord record;
+    SkRecorder recorder(&record, W, H);
+
+    SkPaint aa;
+    aa.setAntiAlias(true);
+
+    // A draw under a clip can be covered by a later draw outside the clip...
+    recorder.save();                                                 // 0
+        recorder.clipRect(SkRect::MakeWH(50, 50));                   // 1
+        recorder.translate(10, 10);                                  // 2
+        recorder.drawOval(SkRect::MakeWH(20, 20), SkPaint());        // 3: covered by 11
+        recorder.drawOval(SkRect::MakeWH(20, 20), aa);               // 4: anti-aliased
+    recorder.restore();                                              // 5
+    // ... but not the other way around.
+    recorder.drawRect(SkRect::MakeXYWH(100, 0, 50, 50), SkPaint());  // 6
+    recorder.save();                                                 // 7
+        recorder.clipRect(SkRect::MakeXYWH(100, 0, 10, 10));         // 8
+        recorder.drawPaint(SkPaint());                               // 9
+    recorder.restore();                                              // 10
+    recorder.drawRect(SkRect::MakeWH(60, 60), SkPaint());            // 11
+    // Nothing under an anti-aliased clip is covered.
+    recorder.save();                                                 // 12
+        recorder.clipRect(SkRect::MakeWH(50, 50), true);             // 13
+        recorder.drawRect(SkRect::MakeWH(10, 10), SkPaint());        // 14
+    recorder.restore();                                              // 15
+    recorder.drawRect(SkRect::MakeWH(60, 60), SkPaint());            // 16: covers 11, not 14
+    // Nothing that draws into a layer is covered by something drawn after it.
+    recorder.saveLayer(nullptr, nullptr);                            // 17
+        recorder.drawRect(SkRect::MakeWH(10, 10), SkPaint());        // 18
+    recorder.restore();                                              // 19
+    recorder.drawRect(SkRect::MakeWH(60, 60), SkPaint());            // 20
+
+    SkRecordCullOccludedDraws(&record);
+    assert_type<SkRecords::NoOp>(r, record, 3);
+    assert_type<SkRecords::DrawOval>(r, record, 4);
+    assert_type<SkRecords::DrawRect>(r, record, 6);
+    assert_type<SkRecords::DrawPaint>(r, record, 9);
+    assert_type<SkRecords::NoOp>(r, record, 11);
+    assert_type<SkRecords::DrawRect>(r, record, 14);
+    assert_type<SkRecords::DrawRect>(r, record, 16);
+    assert_type<SkRecords::DrawRect>(r, record, 18);
+    assert_type<SkRecords::DrawRect>(r, record, 20);
+}
+
+DEF_TEST(RecordOpts_CullOccludedDrawsPaint, r) {
+    SkRecord record;
+    SkRecorder recorder(&record, W, H);
+
+    SkPaint aa;
+    aa.setAntiAlias(true);
+    SkPaint translucent;
+    translucent.setAlpha(0x80);
+
+    // A paint that covers the whole clip covers anti-aliased draws too.
+    recorder.drawOval(SkRect::MakeWH(20, 20), aa);                   // 0
+    recorder.drawPaint(translucent);                                 // 1
+    recorder.drawPaint(SkPaint());                                   // 2
+
+    SkRecordCullOccludedDraws(&record);
+    assert_type<SkRecords::NoOp>(r, record, 0);
+    assert_type<SkRecords::NoOp>(r, record, 1);
+    assert_type<SkRecords::DrawPaint>(r, record, 2);
+}
+
+DEF_TEST(RecordOpts_CullOccludedDrawsPicture, r) {
+    auto draw = [](SkCanvas* canvas) {
+        SkPaint paint;
+        paint.setColor(SK_ColorRED);
+        canvas->drawRect(SkRect::MakeWH(10, 10), paint);
+        paint.setAntiAlias(true);
+        canvas->drawCircle(30, 30, 10, paint);
+        paint.setColor(SK_ColorBLUE);
+        paint.setAntiAlias(false);
+        canvas->drawRect(SkRect::MakeWH(20, 20), paint);
+    };
+
+    SkPictureRecorder recorder;
+    draw(recorder.beginRecording(50, 50));
+    sk_sp<SkPicture> picture = recorder.finishRecordingAsPicture();
+    draw(recorder.beginRecording(50, 50, nullptr,
+                                 SkPictureRecorder::kCullOccludedDraws_RecordFlag));
+    sk_sp<SkPicture> culled = recorder.finishRecordingAsPicture();
+    REPORTER_ASSERT(r, picture->approximateOpCount() == 3);
+    REPORTER_ASSERT(r, culled->approximateOpCount() == 2);
+
+    sk_sp<SkSurface> expected = SkSurface::MakeRasterN32Premul(50, 50);
+    sk_sp<SkSurface> actual = SkSurface::MakeRasterN32Premul(50, 50);
+    expected->getCanvas()->scale(0.7f, 1.3f);
+    actual->getCanvas()->scale(0.7f, 1.3f);
+    expected->getCanvas()->drawPicture(picture);
+    actual->getCanvas()->drawPicture(culled);
+
+    SkBitmap expectedBitmap, actualBitmap;
+    expectedBitmap.allocN32Pixels(50, 50);
+    actualBitmap.allocN32Pixels(50, 50);
+    expected->readPixels(expectedBitmap, 0, 0);
+    actual->readPixels(actualBitmap, 0, 0);
+    REPORTER_ASSERT(r, 0 == memcmp(expectedBitmap.getPixels(), actualBitmap.getPixels(),
+                                   expectedBitmap.computeByteSize()));
+}
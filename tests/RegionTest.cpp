@@ -258,6 +258,19 @@ DEF_TEST(Region, reporter) {
         REPORTER_ASSERT(reporter, test_rects(rect, N));
     }
 
+    // Many rects, including empty and abutting ones, as in a frame's worth of damage.
+    for (int i = 0; i < 20; i++) {
+        const int N = 200;
+        SkIRect rect[N];
+        for (int j = 0; j < N; j++) {
+            rand_rect(&rect[j], rand);
+            if (j & 1) {
+                rect[j].offsetTo(rect[j - 1].fRight, rect[j - 1].fTop);
+            }
+        }
+        REPORTER_ASSERT(reporter, test_rects(rect, N));
+    }
+
     test_proc(reporter, contains_proc);
     test_proc(reporter, intersects_proc);
     test_empties(reporter);
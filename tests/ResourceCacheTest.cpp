@@ -1185,6 +1185,88 @@ static void test_timestamp_wrap(skiatest::Reporter* reporter) {
     }
 }
 
+static void test_purge_policies(skiatest::Reporter* reporter) {
+    using PurgePolicy = GrResourceCache::PurgePolicy;
+
+    // Each policy is given a budget of four resources. One resource is expensive to rebuild and
+    // has been reused, the others are neither. Adding more one-off resources purges the least
+    // recently used ones, unless the policy favors the expensive one.
+    for (PurgePolicy policy :
+         {PurgePolicy::kLRU, PurgePolicy::kCostAware, PurgePolicy::kScanResistant}) {
+        Mock mock(4, 30000);
+        GrContext* context = mock.context();
+        GrResourceCache* cache = mock.cache();
+        GrGpu* gpu = context->priv().getGpu();
+        cache->setPurgePolicy(policy);
+        REPORTER_ASSERT(reporter, policy == cache->purgePolicy());
+
+        GrUniqueKey keys[7];
+        for (int i = 0; i < 7; ++i) {
+            make_unique_key<0>(&keys[i], i);
+        }
+        auto addOneOff = [&](int i) {
+            TestResource* r = new TestResource(gpu);
+            r->resourcePriv().setUniqueKey(keys[i]);
+            r->unref();
+        };
+
+        addOneOff(1);
+        TestResource* expensive = new TestResource(gpu);
+        expensive->resourcePriv().setUniqueKey(keys[0]);
+        expensive->resourcePriv().setRebuildCostHint(1000);
+        expensive->unref();
+        addOneOff(2);
+        SkSafeUnref(cache->findAndRefUniqueResource(keys[0]));
+        for (int i = 3; i < 7; ++i) {
+            addOneOff(i);
+        }
+
+        bool keepsExpensive = PurgePolicy::kLRU != policy;
+        REPORTER_ASSERT(reporter, 4 == cache->getResourceCount());
+        REPORTER_ASSERT(reporter, keepsExpensive == cache->hasUniqueKey(keys[0]));
+        REPORTER_ASSERT(reporter, !cache->hasUniqueKey(keys[1]));
+        REPORTER_ASSERT(reporter, !cache->hasUniqueKey(keys[2]));
+        REPORTER_ASSERT(reporter, keepsExpensive != cache->hasUniqueKey(keys[3]));
+        for (int i = 4; i < 7; ++i) {
+            REPORTER_ASSERT(reporter, cache->hasUniqueKey(keys[i]));
+        }
+
+        // Switching to LRU reorders the remaining resources by their last use.
+        cache->setPurgePolicy(PurgePolicy::kLRU);
+        context->setResourceCacheLimits(1, 30000);
+        REPORTER_ASSERT(reporter, 1 == cache->getResourceCount());
+        REPORTER_ASSERT(reporter, cache->hasUniqueKey(keys[6]));
+    }
+}
+
+static void test_memory_pressure(skiatest::Reporter* reporter) {
+    Mock mock(10, 30000);
+    GrContext* context = mock.context();
+    GrResourceCache* cache = mock.cache();
+    GrGpu* gpu = context->priv().getGpu();
+
+    for (int i = 0; i < 4; ++i) {
+        GrUniqueKey key;
+        make_unique_key<0>(&key, i);
+        TestResource* r = new TestResource(gpu);
+        r->resourcePriv().setUniqueKey(key);
+        r->unref();
+    }
+    TestResource* locked = new TestResource(gpu);
+
+    SkGraphics::MemoryPressureResult result;
+    context->onMemoryPressure(SkGraphics::MemoryPressure::kModerate, &result);
+    REPORTER_ASSERT(reporter, 2 * TestResource::kDefaultSize == result.fGpuResourceBytes);
+    REPORTER_ASSERT(reporter, 3 == cache->getResourceCount());
+
+    // Adds to the previous result, and only frees what isn't in use.
+    context->onMemoryPressure(SkGraphics::MemoryPressure::kCritical, &result);
+    REPORTER_ASSERT(reporter, 4 * TestResource::kDefaultSize == result.fGpuResourceBytes);
+    REPORTER_ASSERT(reporter, 1 == cache->getResourceCount());
+
+    locked->unref();
+}
+
 static void test_time_purge(skiatest::Reporter* reporter) {
     Mock mock(1000000, 1000000);
     GrContext* context = mock.context();
@@ -1602,6 +1684,8 @@ DEF_GPUTEST(ResourceCacheMisc, reporter, /* options */) {
     test_purge_invalidated(reporter);
     test_cache_chained_purge(reporter);
     test_timestamp_wrap(reporter);
+    test_purge_policies(reporter);
+    test_memory_pressure(reporter);
     test_time_purge(reporter);
     test_partial_purge(reporter);
     test_large_resource_count(reporter);
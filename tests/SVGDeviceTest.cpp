@@ -20,6 +20,7 @@
 #include "include/core/SkImage.h"
 #include "include/core/SkShader.h"
 #include "include/core/SkStream.h"
+#include "include/effects/SkGradientShader.h"
 #include "include/private/SkTo.h"
 #include "include/utils/SkParse.h"
 #include "src/core/SkMakeUnique.h"
@@ -356,6 +357,41 @@ DEF_TEST(SVGDevice_image_shader_tileboth, reporter) {
     REPORTER_ASSERT(reporter, atoi(dom.findAttr(patternNode, "height")) == imageHeight);
 }
 
+DEF_TEST(SVGDevice_shared_resources, reporter) {
+    SkDOM dom;
+    {
+        auto svgCanvas = MakeDOMCanvas(&dom);
+        const SkPoint pts[] = {{0, 0}, {10, 10}};
+        const SkColor colors[] = {SK_ColorRED, SK_ColorBLUE};
+        SkPaint paint;
+        paint.setShader(SkGradientShader::MakeLinear(pts, colors, nullptr, 2, SkTileMode::kClamp));
+        svgCanvas->clipRect(SkRect::MakeWH(50, 50));
+        svgCanvas->drawRect({0, 0, 10, 10}, paint);
+        svgCanvas->drawRect({20, 20, 30, 30}, paint);
+    }
+    const SkDOM::Node* root = dom.finishParsing();
+    ABORT_TEST(reporter, !root, "root element not found");
+
+    // The clip and the gradient are only written for the first rect.
+    const SkDOM::Node* defs = dom.getFirstChild(root, "defs");
+    ABORT_TEST(reporter, !defs, "defs not found");
+    REPORTER_ASSERT(reporter, !dom.getNextSibling(defs, "defs"));
+    REPORTER_ASSERT(reporter, dom.getFirstChild(defs, "clipPath"));
+    REPORTER_ASSERT(reporter, dom.getFirstChild(defs, "linearGradient"));
+
+    const SkDOM::Node* group0 = dom.getFirstChild(root, "g");
+    ABORT_TEST(reporter, !group0, "first clip group not found");
+    const SkDOM::Node* group1 = dom.getNextSibling(group0, "g");
+    ABORT_TEST(reporter, !group1, "second clip group not found");
+    REPORTER_ASSERT(reporter, !strcmp(dom.findAttr(group0, "clip-path"),
+                                      dom.findAttr(group1, "clip-path")));
+
+    const SkDOM::Node* rect0 = dom.getFirstChild(group0, "rect");
+    const SkDOM::Node* rect1 = dom.getFirstChild(group1, "rect");
+    ABORT_TEST(reporter, !rect0 || !rect1, "rects not found");
+    REPORTER_ASSERT(reporter, !strcmp(dom.findAttr(rect0, "fill"), dom.findAttr(rect1, "fill")));
+}
+
 DEF_TEST(SVGDevice_ColorFilters, reporter) {
     SkDOM dom;
     SkPaint paint;
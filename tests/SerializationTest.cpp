@@ -501,6 +501,28 @@ DEF_TEST(Serialization, reporter) {
         TestArraySerialization(data, reporter);
     }
 
+    // Test skipByteArray, which reads a padded byte array in place
+    {
+        const unsigned char data[5] = { 1, 2, 3, 4, 5 };
+        SkBinaryWriteBuffer writer;
+        writer.writeByteArray(data, sizeof(data));
+        REPORTER_ASSERT(reporter, 12 == writer.bytesWritten());
+        alignas(4) unsigned char dataWritten[12];
+        writer.writeToMemory(dataWritten);
+
+        size_t size;
+        SkReadBuffer buffer(dataWritten, sizeof(dataWritten));
+        const void* bytes = buffer.skipByteArray(&size);
+        REPORTER_ASSERT(reporter, bytes && sizeof(data) == size &&
+                                  0 == memcmp(bytes, data, sizeof(data)));
+        REPORTER_ASSERT(reporter, buffer.isValid() && buffer.eof());
+
+        // Truncated, it fails.
+        SkReadBuffer truncated(dataWritten, 8);
+        REPORTER_ASSERT(reporter, !truncated.skipByteArray(&size) && 0 == size);
+        REPORTER_ASSERT(reporter, !truncated.isValid());
+    }
+
     // Test readColorArray
     {
         SkColor data[kArraySize] = { SK_ColorBLACK, SK_ColorWHITE, SK_ColorRED };
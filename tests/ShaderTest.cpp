@@ -13,6 +13,8 @@
 #include "include/core/SkShader.h"
 #include "include/core/SkSurface.h"
 #include "include/effects/SkPerlinNoiseShader.h"
+#include "src/core/SkArenaAlloc.h"
+#include "src/shaders/SkShaderBase.h"
 #include "tests/Test.h"
 
 static void check_isaimage(skiatest::Reporter* reporter, SkShader* shader,
@@ -68,3 +70,99 @@ DEF_TEST(ComposeShaderSingle, reporter) {
     rr.setRectRadii({0, 0, 0, 0}, rd);
     canvas.drawRRect(rr, p);
 }
+
+// Clamped 8888 bilerp and bicubic sampling have their own fused stages. Away from the image's
+// edges they should sample just like the general stages used for other tile modes.
+DEF_TEST(ImageShader_clampedSamplingInterior, reporter) {
+    SkBitmap bm;
+    bm.allocN32Pixels(16, 16);
+    for (int y = 0; y < 16; ++y) {
+        for (int x = 0; x < 16; ++x) {
+            *bm.getAddr32(x, y) = SkPreMultiplyARGB(0x80 + x * 8, x * 16, y * 16, (x ^ y) * 16);
+        }
+    }
+    sk_sp<SkImage> image = SkImage::MakeFromBitmap(bm);
+
+    SkMatrix rotate = SkMatrix::MakeScale(2.5f);
+    rotate.postRotate(20, 20, 20);
+    SkMatrix persp = SkMatrix::MakeScale(2.5f);
+    persp.setPerspX(0.002f);
+
+    // Only the middle of the image is drawn, so no sample comes within a pixel of its edges.
+    const SkRect interior = SkRect::MakeLTRB(4, 4, 12, 12);
+    for (const SkMatrix& matrix : { rotate, persp }) {
+        for (SkFilterQuality quality : { kLow_SkFilterQuality, kHigh_SkFilterQuality }) {
+            auto draw = [&](SkTileMode tileMode) {
+                SkBitmap dst;
+                dst.allocN32Pixels(64, 64);
+                dst.eraseColor(SK_ColorTRANSPARENT);
+                SkCanvas canvas(dst);
+                canvas.concat(matrix);
+                SkPaint paint;
+                paint.setFilterQuality(quality);
+                paint.setShader(image->makeShader(tileMode, tileMode));
+                canvas.drawRect(interior, paint);
+                return dst;
+            };
+            SkBitmap clamped  = draw(SkTileMode::kClamp),
+                     repeated = draw(SkTileMode::kRepeat);
+
+            int maxDiff = 0;
+            for (int y = 0; y < 64; ++y) {
+                for (int x = 0; x < 64; ++x) {
+                    SkPMColor a = *clamped.getAddr32(x, y),
+                              b = *repeated.getAddr32(x, y);
+                    for (int shift = 0; shift < 32; shift += 8) {
+                        maxDiff = SkTMax(maxDiff, SkTAbs((int)((a >> shift) & 0xFF) -
+                                                         (int)((b >> shift) & 0xFF)));
+                    }
+                }
+            }
+            REPORTER_ASSERT(reporter, maxDiff <= 1, "quality %d: max diff %d", quality, maxDiff);
+        }
+    }
+}
+
+#ifdef SK_ENABLE_LEGACY_SHADERCONTEXT
+// Perlin noise spans are shaded eight pixels at a time, with the rest done one at a time. Both
+// ways should give the same colors.
+DEF_TEST(PerlinNoiseShader_spans, reporter) {
+    const SkISize tileSize = SkISize::Make(50, 40);
+    const sk_sp<SkShader> shaders[] = {
+        SkPerlinNoiseShader::MakeFractalNoise(0.1f, 0.1f, 3, 0),
+        SkPerlinNoiseShader::MakeTurbulence(0.05f, 0.2f, 4, 7.5f),
+        SkPerlinNoiseShader::MakeFractalNoise(0.3f, 0.3f, 2, 2, &tileSize),
+        SkPerlinNoiseShader::MakeTurbulence(0.02f, 0.02f, 3, 3, &tileSize),
+    };
+
+    SkPaint paint;
+    paint.setAlpha(200);
+    SkMatrix matrix;
+    matrix.setScaleTranslate(2.5f, 2.5f, 3.5f, -2);
+    for (const sk_sp<SkShader>& shader : shaders) {
+        SkArenaAlloc alloc(1024);
+        SkShaderBase::ContextRec rec(paint, matrix, nullptr, kN32_SkColorType, nullptr);
+        SkShaderBase::Context* context = as_SB(shader)->makeContext(rec, &alloc);
+        if (!context) {
+            ERRORF(reporter, "Could not make a shader context.");
+            continue;
+        }
+
+        for (int y = -5; y < 40; y += 3) {
+            SkPMColor span[77], pixel;
+            context->shadeSpan(-13, y, span, SK_ARRAY_COUNT(span));
+            for (int x = 0; x < (int)SK_ARRAY_COUNT(span); ++x) {
+                context->shadeSpan(-13 + x, y, &pixel, 1);
+                // Compilers may fuse multiplies and adds differently, which can round a
+                // channel off by one.
+                int maxDiff = 0;
+                for (int shift = 0; shift < 32; shift += 8) {
+                    int diff = (int)((span[x] >> shift) & 0xFF) - (int)((pixel >> shift) & 0xFF);
+                    maxDiff = SkTMax(maxDiff, SkTAbs(diff));
+                }
+                REPORTER_ASSERT(reporter, maxDiff <= 1, "(%d, %d)", x, y);
+            }
+        }
+    }
+}
+#endif
@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkVertices.h"
@@ -175,3 +176,35 @@ DEF_TEST(ShadowBounds, reporter) {
     path.cubicTo(100, 50, 20, 100, 0, 0);
     check_bounds(reporter, path);
 }
+
+// Identical rrects share cached tessellations wherever they're drawn, so an ambient shadow (which
+// doesn't depend on the light) must come out the same, just moved, at any position.
+DEF_TEST(ShadowUtils_TranslatedRRects, reporter) {
+    const SkRect rect = SkRect::MakeWH(40, 30);
+    const SkPoint offsets[] = { { 20, 20 }, { 120, 20 }, { 20, 95 } };
+
+    SkBitmap bm;
+    bm.allocN32Pixels(200, 160);
+    bm.eraseColor(SK_ColorWHITE);
+    SkCanvas canvas(bm);
+    for (SkPoint offset : offsets) {
+        SkPath path;
+        path.addRRect(SkRRect::MakeRectXY(rect.makeOffset(offset.fX, offset.fY), 6, 6));
+        SkShadowUtils::DrawShadow(&canvas, path, SkPoint3::Make(0, 0, 8),
+                                  SkPoint3::Make(100, 0, 400), 200, 0xFF000000, 0,
+                                  SkShadowFlags::kGeometricOnly_ShadowFlag);
+    }
+
+    // Each shadow fits in its rrect outset by 20 pixels.
+    for (int i = 1; i < (int)SK_ARRAY_COUNT(offsets); ++i) {
+        int dx = (int)(offsets[i].fX - offsets[0].fX),
+            dy = (int)(offsets[i].fY - offsets[0].fY);
+        bool same = true;
+        for (int y = 0; y < 70 && same; ++y) {
+            for (int x = 0; x < 80 && same; ++x) {
+                same = *bm.getAddr32(x, y) == *bm.getAddr32(x + dx, y + dy);
+            }
+        }
+        REPORTER_ASSERT(reporter, same, "shadow %d differs", i);
+    }
+}
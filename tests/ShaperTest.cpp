@@ -5,6 +5,8 @@
 
 #if !defined(SK_BUILD_FOR_ANDROID_FRAMEWORK) && !defined(SK_BUILD_FOR_GOOGLE3)
 
+#include "include/core/SkExecutor.h"
+#include "include/private/SkTArray.h"
 #include "modules/skshaper/include/SkShaper.h"
 #include "tools/Resources.h"
 
@@ -101,4 +103,67 @@ SHAPER_TEST(vai)
 //SHAPER_TEST(tamil)
 #undef SHAPER_TEST
 
+namespace {
+// Collects every glyph of every line, with its position relative to its run.
+struct CollectingRunHandler final : public SkShaper::RunHandler {
+    SkTArray<SkGlyphID> fGlyphs;
+    SkTArray<SkPoint> fPositions;
+    SkTArray<uint32_t> fClusters;
+    int fLines = 0;
+
+    void beginLine() override {}
+    void runInfo(const RunInfo&) override {}
+    void commitRunInfo() override {}
+    Buffer runBuffer(const RunInfo& info) override {
+        int count = SkToInt(info.glyphCount);
+        return { fGlyphs.push_back_n(count), fPositions.push_back_n(count), nullptr,
+                 fClusters.push_back_n(count), {0, 0} };
+    }
+    void commitRunBuffer(const RunInfo&) override {}
+    void commitLine() override { fLines++; }
+};
+}  // namespace
+
+DEF_TEST(Shaper_ShapeParagraphs, reporter) {
+    const char* resources[] = {
+        "text/english.txt", "text/arabic.txt", "text/thai.txt", "text/hebrew.txt",
+    };
+    constexpr int kCount = SK_ARRAY_COUNT(resources);
+    constexpr float kWidth = 400;
+
+    sk_sp<SkData> data[kCount];
+    CollectingRunHandler serial[kCount], parallel[kCount];
+    SkShaper::Paragraph paragraphs[kCount];
+    std::unique_ptr<SkShaper> shaper = SkShaper::Make();
+    for (int i = 0; i < kCount; ++i) {
+        data[i] = GetResourceAsData(resources[i]);
+        if (!data[i]) {
+            return;
+        }
+        SkFont font;
+        paragraphs[i] = { (const char*)data[i]->data(), data[i]->size(), font, i % 2 == 0,
+                          kWidth, &parallel[i] };
+        shaper->shape(paragraphs[i].utf8, paragraphs[i].utf8Bytes, font,
+                      paragraphs[i].leftToRight, kWidth, &serial[i]);
+    }
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(3);
+    SkShaper::ShapeParagraphs(paragraphs, kCount, executor.get());
+
+    for (int i = 0; i < kCount; ++i) {
+        const CollectingRunHandler& a = serial[i];
+        const CollectingRunHandler& b = parallel[i];
+        REPORTER_ASSERT(reporter, a.fLines == b.fLines, "%s", resources[i]);
+        REPORTER_ASSERT(reporter, a.fGlyphs.count() == b.fGlyphs.count(), "%s", resources[i]);
+        if (a.fGlyphs.count() != b.fGlyphs.count()) {
+            continue;
+        }
+        for (int j = 0; j < a.fGlyphs.count(); ++j) {
+            REPORTER_ASSERT(reporter, a.fGlyphs[j] == b.fGlyphs[j] &&
+                                      a.fPositions[j] == b.fPositions[j] &&
+                                      a.fClusters[j] == b.fClusters[j], "%s %d", resources[i], j);
+        }
+    }
+}
+
 #endif  // !defined(SK_BUILD_FOR_ANDROID_FRAMEWORK) && !defined(SK_BUILD_FOR_GOOGLE3)
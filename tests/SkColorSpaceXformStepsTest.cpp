@@ -7,6 +7,7 @@
 
 #include "src/core/SkColorSpacePriv.h"
 #include "src/core/SkColorSpaceXformSteps.h"
+#include "src/core/SkConvertPixels.h"
 #include "tests/Test.h"
 
 DEF_TEST(SkColorSpaceXformSteps, r) {
@@ -169,3 +170,50 @@ DEF_TEST(SkColorSpaceXformSteps, r) {
                 (t&16) ? " true" : "false");
     }
 }
+
+// Large enough 8888 conversions that don't premul or unpremul are done with tables rather than
+// the pipeline. They should agree with the steps' own float math.
+DEF_TEST(SkColorSpaceXformSteps_8888Tables, r) {
+    const int W = 64, H = 64;
+    uint32_t src[W*H], dst[W*H];
+    for (int i = 0; i < W*H; i++) {
+        // Visit every value in each channel, in different combinations.
+        src[i] = 0xff000000 | (((i * 7) & 0xff) << 16) | (((i * 3) & 0xff) << 8) | (i & 0xff);
+    }
+
+    auto srgb = SkColorSpace::MakeSRGB();
+    sk_sp<SkColorSpace> dstSpaces[] = {
+        srgb->makeLinearGamma(),
+        SkColorSpace::MakeRGB(SkNamedTransferFn::kSRGB,    SkNamedGamut::kDCIP3),
+        SkColorSpace::MakeRGB(SkNamedTransferFn::kRec2020, SkNamedGamut::kRec2020),
+        SkColorSpace::MakeRGB(SkNamedTransferFn::k2Dot2,   SkNamedGamut::kSRGB),
+    };
+    for (const auto& dstCS : dstSpaces) {
+        for (SkColorType dstCT : {kRGBA_8888_SkColorType, kBGRA_8888_SkColorType}) {
+            auto srcInfo = SkImageInfo::Make(W, H, kRGBA_8888_SkColorType, kOpaque_SkAlphaType,
+                                             srgb);
+            auto dstInfo = srcInfo.makeColorType(dstCT).makeColorSpace(dstCS);
+            SkConvertPixels(dstInfo, dst, 4*W, srcInfo, src, 4*W);
+
+            SkColorSpaceXformSteps steps(srgb.get(),  kOpaque_SkAlphaType,
+                                         dstCS.get(), kOpaque_SkAlphaType);
+            for (int i = 0; i < W*H; i++) {
+                float rgba[4] = {
+                    ((src[i] >>  0) & 0xff) * (1/255.0f),
+                    ((src[i] >>  8) & 0xff) * (1/255.0f),
+                    ((src[i] >> 16) & 0xff) * (1/255.0f),
+                    1,
+                };
+                steps.apply(rgba);
+
+                const int shift[] = {dstCT == kRGBA_8888_SkColorType ? 0 : 16, 8,
+                                     dstCT == kRGBA_8888_SkColorType ? 16 : 0, 24};
+                for (int c = 0; c < 4; c++) {
+                    int want = (int)(SkTPin(rgba[c], 0.0f, 1.0f) * 255 + 0.5f),
+                        got  = (dst[i] >> shift[c]) & 0xff;
+                    REPORTER_ASSERT(r, SkTAbs(want - got) <= 1, "%d: %d vs %d", i, want, got);
+                }
+            }
+        }
+    }
+}
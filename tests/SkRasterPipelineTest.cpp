@@ -35,6 +35,151 @@ DEF_TEST(SkRasterPipeline, r) {
     REPORTER_ASSERT(r, ((result >> 48) & 0xffff) == 0x3c00);
 }
 
+DEF_TEST(SkRasterPipeline_srcover_rgba_f16, r) {
+    // The fused stage should match load_f16_dst, srcover, store_f16, including out of [0,1].
+    uint64_t src[5] = {
+        0x3800380000000000ull,  // 50% blue
+        0x3c00000000003c00ull,  // opaque red
+        0x0000000000000000ull,  // transparent
+        0x3c004000bc003e00ull,  // opaque wide-gamut color
+        0x3400340034003400ull,  // 25% gray
+    };
+    uint64_t fused[5] = {
+        0x3c00000000003c00ull, 0x3c003c003c003c00ull,
+        0x3c00000000003c00ull, 0x3c003800b8004400ull, 0x0000000000000000ull,
+    };
+    uint64_t reference[5];
+    memcpy(reference, fused, sizeof(fused));
+
+    // SkRasterPipeline fuses load_dst, srcover and store itself when they share a context.
+    SkRasterPipeline_MemoryCtx src_ctx           = { src, 0 },
+                               fused_ctx         = { fused, 0 },
+                               reference_ctx     = { reference, 0 },
+                               reference_dst_ctx = { reference, 0 };
+
+    SkRasterPipeline_<256> p;
+    p.append(SkRasterPipeline::load_f16, &src_ctx);
+    p.append(SkRasterPipeline::srcover_rgba_f16, &fused_ctx);
+    p.run(0,0,5,1);
+
+    SkRasterPipeline_<256> q;
+    q.append(SkRasterPipeline::load_f16, &src_ctx);
+    q.append(SkRasterPipeline::load_f16_dst, &reference_dst_ctx);
+    q.append(SkRasterPipeline::srcover);
+    q.append(SkRasterPipeline::store_f16, &reference_ctx);
+    q.run(0,0,5,1);
+
+    for (int i = 0; i < 5; i++) {
+        REPORTER_ASSERT(r, fused[i] == reference[i]);
+    }
+    // Half-intensity magenta, as in the SkRasterPipeline test.
+    REPORTER_ASSERT(r, fused[0] == 0x3c00380000003800ull);
+}
+
+DEF_TEST(SkRasterPipeline_fused_srcover, r) {
+    // A coverage blit's load_8888_dst, srcover, store_8888 runs as srcover_rgba_8888, and
+    // should draw just what the separate stages do.
+    uint32_t src[4] = { 0x80000080, 0xff00ff00, 0x00000000, 0x40404040 },
+             dst[4] = { 0xff0000ff, 0x80808080, 0xffffffff, 0x00000000 },
+             fused[4],
+             reference[4];
+    memcpy(fused, dst, sizeof(dst));
+    memcpy(reference, dst, sizeof(dst));
+    float coverage = 0.75f;
+
+    SkRasterPipeline_MemoryCtx src_ctx           = { src, 0 },
+                               fused_ctx         = { fused, 0 },
+                               reference_ctx     = { reference, 0 },
+                               reference_dst_ctx = { reference, 0 };
+
+    // Only the last three stages of p share a context, so only they fuse.
+    SkRasterPipeline_<256> p;
+    p.append(SkRasterPipeline::load_8888, &src_ctx);
+    p.append(SkRasterPipeline::scale_1_float, &coverage);
+    p.append(SkRasterPipeline::load_8888_dst, &fused_ctx);
+    p.append(SkRasterPipeline::srcover);
+    p.append(SkRasterPipeline::store_8888, &fused_ctx);
+    p.run(0,0,4,1);
+
+    SkRasterPipeline_<256> q;
+    q.append(SkRasterPipeline::load_8888, &src_ctx);
+    q.append(SkRasterPipeline::scale_1_float, &coverage);
+    q.append(SkRasterPipeline::load_8888_dst, &reference_dst_ctx);
+    q.append(SkRasterPipeline::srcover);
+    q.append(SkRasterPipeline::store_8888, &reference_ctx);
+    q.run(0,0,4,1);
+
+    for (int i = 0; i < 4; i++) {
+        REPORTER_ASSERT(r, fused[i] == reference[i]);
+    }
+}
+
+DEF_TEST(SkRasterPipeline_bilerp_tiled_8888, r) {
+    uint32_t img[16];
+    for (int i = 0; i < 16; i++) {
+        img[i] = 0xff000000 | (i * 0x10) | (0xf0 - i * 0x10) << 8;
+    }
+
+    auto sample = [&](SkTileMode mode, float shift, uint32_t dst[16]) {
+        SkRasterPipeline_TiledGatherCtx tiled = {
+            { img, 4, 4.0f, 4.0f }, { 4.0f, 0.25f }, { 4.0f, 0.25f }, mode, mode,
+        };
+        SkRasterPipeline_MemoryCtx dst_ctx = { dst, 4 };
+        float translate[2] = { shift, shift };
+
+        SkRasterPipeline_<256> p;
+        p.append(SkRasterPipeline::seed_shader);
+        p.append(SkRasterPipeline::matrix_translate, translate);
+        p.append(SkRasterPipeline::bilerp_tiled_8888, &tiled);
+        p.append(SkRasterPipeline::store_8888, &dst_ctx);
+        p.run(0,0,4,4);
+    };
+
+    // Sampling a whole period away should give the same colors, edges blending with the
+    // other side of the image for repeat and with themselves for mirror.
+    uint32_t near[16], far[16], clamped[16];
+    sample(SkTileMode::kRepeat, 0.25f, near);
+    sample(SkTileMode::kRepeat, 4.25f, far);
+    REPORTER_ASSERT(r, 0 == memcmp(near, far, sizeof(near)));
+    sample(SkTileMode::kClamp, 0.25f, clamped);
+    REPORTER_ASSERT(r, near[15] != clamped[15]);
+
+    sample(SkTileMode::kMirror, 0.25f, near);
+    sample(SkTileMode::kMirror, 8.25f, far);
+    REPORTER_ASSERT(r, 0 == memcmp(near, far, sizeof(near)));
+    REPORTER_ASSERT(r, near[15] == clamped[15]);
+}
+
+DEF_TEST(SkRasterPipeline_extend_shared, r) {
+    // Two pipelines sharing the same prefix of stages can each append their own.
+    uint64_t blue = 0x3800380000000000ull,
+             red  = 0x3c00000000003c00ull,
+             over, src;
+
+    SkRasterPipeline_MemoryCtx load_s_ctx = { &blue, 0 },
+                               load_d_ctx = { &red, 0 },
+                               over_ctx   = { &over, 0 },
+                               src_ctx    = { &src, 0 };
+
+    SkRasterPipeline_<256> prefix;
+    prefix.append(SkRasterPipeline::load_f16, &load_s_ctx);
+
+    SkRasterPipeline_<256> srcover;
+    srcover.extend_shared(prefix);
+    srcover.append(SkRasterPipeline::load_f16_dst, &load_d_ctx);
+    srcover.append(SkRasterPipeline::srcover);
+    srcover.append(SkRasterPipeline::store_f16, &over_ctx);
+
+    SkRasterPipeline_<256> copy;
+    copy.extend_shared(prefix);
+    copy.append(SkRasterPipeline::store_f16, &src_ctx);
+
+    srcover.run(0,0,1,1);
+    copy.run(0,0,1,1);
+    REPORTER_ASSERT(r, over == 0x3c00380000003800ull);
+    REPORTER_ASSERT(r, src  == blue);
+}
+
 DEF_TEST(SkRasterPipeline_empty, r) {
     // No asserts... just a test that this is safe to run.
     SkRasterPipeline_<256> p;
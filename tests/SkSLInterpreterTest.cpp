@@ -88,6 +88,24 @@ void test(skiatest::Reporter* r, const char* src, float inR, float inG, float in
         REPORTER_ASSERT(r, inoutColor[1] == expectedG);
         REPORTER_ASSERT(r, inoutColor[2] == expectedB);
         REPORTER_ASSERT(r, inoutColor[3] == expectedA);
+
+        // Running several copies at once should give the same answer for each of them.
+        constexpr int kCopies = 5;
+        const float in[4] = { inR, inG, inB, inA };
+        const float expected[4] = { expectedR, expectedG, expectedB, expectedA };
+        SkSL::Interpreter::Value striped[4][kCopies];
+        for (int c = 0; c < 4; ++c) {
+            for (int i = 0; i < kCopies; ++i) {
+                striped[c][i] = in[c];
+            }
+        }
+        SkSL::Interpreter::Value* args[] = { striped[0], striped[1], striped[2], striped[3] };
+        interpreter.runStriped(*main, kCopies, args, nullptr);
+        for (int c = 0; c < 4; ++c) {
+            for (int i = 0; i < kCopies; ++i) {
+                REPORTER_ASSERT(r, striped[c][i].fFloat == expected[c]);
+            }
+        }
     } else {
         printf("%s\n%s", src, compiler.errorText().c_str());
     }
@@ -416,6 +434,63 @@ DEF_TEST(SkSLInterpreterGeneric, r) {
          (SkSL::Interpreter::Value*) expected2);
 }
 
+DEF_TEST(SkSLInterpreterStriped, r) {
+    // Every invocation takes the same path through 'square' and the first loop, but not through
+    // the 'if' or the second loop, so this tests both striped and per-invocation execution.
+    const char* src = R"(
+        float square(float x) { return x * x; }
+        float2 main(float x, int n) {
+            float y = square(x) + 1;
+            for (int i = 0; i < 3; ++i) {
+                y += x;
+            }
+            if (x > 10) {
+                y = -y;
+            }
+            for (int i = 0; i < n; ++i) {
+                y *= 2;
+            }
+            return float2(y, x);
+        }
+    )";
+
+    SkSL::Compiler compiler;
+    SkSL::Program::Settings settings;
+    std::unique_ptr<SkSL::Program> program = compiler.convertProgram(
+                                                             SkSL::Program::kGeneric_Kind,
+                                                             SkSL::String(src), settings);
+    REPORTER_ASSERT(r, program);
+    std::unique_ptr<SkSL::ByteCode> byteCode = compiler.toByteCode(*program);
+    REPORTER_ASSERT(r, !compiler.errorCount());
+    if (compiler.errorCount() > 0) {
+        printf("%s\n%s", src, compiler.errorText().c_str());
+        return;
+    }
+    const SkSL::ByteCodeFunction* main = byteCode->getFunction("main");
+    SkSL::Interpreter interpreter(std::move(program), std::move(byteCode));
+
+    // More than one batch, with a partial batch at the end.
+    constexpr int N = SkSL::Interpreter::kVecWidth * 2 + 3;
+    for (bool diverge : { false, true }) {
+        SkSL::Interpreter::Value xs[N], ns[N], outY[N], outX[N];
+        for (int i = 0; i < N; ++i) {
+            xs[i] = diverge ? (float) i : 2.0f;
+            ns[i] = diverge ? i % 4 : 1;
+        }
+        SkSL::Interpreter::Value* args[] = { xs, ns };
+        SkSL::Interpreter::Value* outReturn[] = { outY, outX };
+        interpreter.runStriped(*main, N, args, outReturn);
+
+        for (int i = 0; i < N; ++i) {
+            SkSL::Interpreter::Value in[2] = { xs[i], ns[i] };
+            SkSL::Interpreter::Value expected[2];
+            interpreter.run(*main, in, expected);
+            REPORTER_ASSERT(r, outY[i].fFloat == expected[0].fFloat);
+            REPORTER_ASSERT(r, outX[i].fFloat == expected[1].fFloat);
+        }
+    }
+}
+
 DEF_TEST(SkSLInterpreterSetInputs, r) {
     const char* src = R"(
         layout(ctype=float) in uniform float x;
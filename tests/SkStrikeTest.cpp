@@ -0,0 +1,223 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkExecutor.h"
+#include "include/core/SkFont.h"
+#include "include/core/SkPath.h"
+#include "src/core/SkArenaAlloc.h"
+#include "src/core/SkStrike.h"
+#include "src/core/SkStrikeCache.h"
+#include "src/core/SkTaskGroup.h"
+#include "src/lazy/SkDiscardableMemoryPool.h"
+#include "tests/Test.h"
+#include "tools/ToolUtils.h"
+
+#include <atomic>
+#include <vector>
+
+DEF_TEST(SkStrike_prepareImages, reporter) {
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+
+    SkFont font(ToolUtils::create_portable_typeface("serif", SkFontStyle()), 23);
+    font.setEdging(SkFont::Edging::kAntiAlias);
+    font.setSubpixel(true);
+    auto strike = SkStrikeCache::FindOrCreateStrikeWithNoDeviceExclusive(font);
+
+    // Enough glyphs, at a few subpixel positions, to be split across several tasks.
+    std::vector<SkPackedGlyphID> glyphIDs;
+    int glyphCount = SkTMin(128, (int)strike->getGlyphCount());
+    for (SkFixed x = 0; x < SK_Fixed1; x += SK_FixedQuarter) {
+        for (int glyph = 0; glyph < glyphCount; ++glyph) {
+            glyphIDs.push_back(SkPackedGlyphID((SkGlyphID)glyph, x, 0));
+        }
+    }
+    strike->prepareImages(SkSpan<const SkPackedGlyphID>(glyphIDs.data(), glyphIDs.size()),
+                          executor.get());
+
+    // Every image must match what a single scaler context produces for the same glyph.
+    auto reference = strike->getScalerContext()->makeSibling(strike->getDescriptor());
+    REPORTER_ASSERT(reporter, reference);
+    if (!reference) {
+        return;
+    }
+    SkArenaAlloc alloc(4096);
+    for (SkPackedGlyphID glyphID : glyphIDs) {
+        const SkGlyph& glyph = strike->getGlyphIDMetrics(glyphID);
+        if (glyph.isEmpty() || glyph.fWidth >= kMaxGlyphWidth) {
+            continue;
+        }
+        REPORTER_ASSERT(reporter, glyph.fImage);
+
+        SkGlyph expected(glyphID);
+        reference->getMetrics(&expected);
+        size_t size = expected.allocImage(&alloc);
+        reference->getImage(expected);
+        REPORTER_ASSERT(reporter, size == glyph.computeImageSize());
+        if (glyph.fImage && size == glyph.computeImageSize()) {
+            REPORTER_ASSERT(reporter, 0 == memcmp(glyph.fImage, expected.fImage, size));
+        }
+    }
+}
+
+DEF_TEST(SkStrikeCache_sharedStrikes, reporter) {
+    SkStrikeCache strikeCache;
+    strikeCache.setSharedStrikes(true);
+
+    SkFont font(ToolUtils::create_portable_typeface("serif", SkFontStyle()), 18);
+    font.setEdging(SkFont::Edging::kAntiAlias);
+    font.setSubpixel(true);
+    SkAutoDescriptor ad;
+    SkScalerContextEffects effects;
+    const SkDescriptor* desc = SkScalerContext::CreateDescriptorAndEffectsUsingPaint(
+            font, SkPaint(), SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+            SkScalerContextFlags::kNone, SkMatrix::I(), &ad, &effects);
+    SkTypeface* typeface = font.getTypefaceOrDefault();
+
+    constexpr int kGlyphCount = 64;
+    SkGlyphID glyphIDs[kGlyphCount];
+    SkPoint positions[kGlyphCount];
+    for (int i = 0; i < kGlyphCount; ++i) {
+        glyphIDs[i] = (SkGlyphID)i;
+        positions[i] = {i * 10.25f, 20};
+    }
+
+    // Every thread should draw from the same strike, and always see finished glyphs, whether
+    // it prepared them itself or found them already prepared by another thread.
+    std::atomic<SkStrikeInterface*> firstStrike{nullptr};
+    std::atomic<int> failures{0};
+    auto drawFromThreads = [&]() {
+        SkTaskGroup().batch(8, [&](int) {
+            for (int pass = 0; pass < 4; ++pass) {
+                SkScopedStrike strike =
+                        strikeCache.findOrCreateScopedStrike(*desc, effects, *typeface);
+                SkStrikeInterface* expected = nullptr;
+                if (!firstStrike.compare_exchange_strong(expected, strike.get())
+                        && expected != strike.get()) {
+                    failures++;
+                }
+
+                SkGlyphPos results[kGlyphCount];
+                auto drawables = strike->prepareForDrawing(
+                        glyphIDs, positions, kGlyphCount, 256,
+                        SkStrikeInterface::kImageIfNeeded, results);
+                for (const SkGlyphPos& glyphPos : drawables) {
+                    const SkGlyph* glyph = glyphPos.glyph;
+                    if (glyph->isEmpty()
+                            || (glyph->fWidth < kMaxGlyphWidth && glyph->fImage == nullptr)) {
+                        failures++;
+                    }
+                }
+            }
+        });
+    };
+
+    drawFromThreads();
+    REPORTER_ASSERT(reporter, failures == 0);
+    REPORTER_ASSERT(reporter, strikeCache.getCacheCountUsed() == 1);
+
+    // Purging while threads still hold the strike must not break them, and must lead to a new
+    // strike being made.
+    strikeCache.purgeAll();
+    REPORTER_ASSERT(reporter, strikeCache.getCacheCountUsed() == 0);
+    firstStrike = nullptr;
+    drawFromThreads();
+    REPORTER_ASSERT(reporter, failures == 0);
+    REPORTER_ASSERT(reporter, strikeCache.getCacheCountUsed() == 1);
+}
+
+DEF_TEST(SkStrike_compactPaths, reporter) {
+    SkFont font(ToolUtils::create_portable_typeface("serif", SkFontStyle()), 64);
+    auto strike = SkStrikeCache::FindOrCreateStrikeWithNoDeviceExclusive(font);
+    auto reference = strike->getScalerContext()->makeSibling(strike->getDescriptor());
+    REPORTER_ASSERT(reporter, reference);
+    if (!reference) {
+        return;
+    }
+
+    constexpr int kGlyphCount = 32;
+    std::vector<SkPath> paths(kGlyphCount);
+    for (int i = 0; i < kGlyphCount; ++i) {
+        const SkGlyph& glyph = strike->getGlyphIDMetrics((SkGlyphID)i);
+        if (const SkPath* path = strike->findPath(glyph)) {
+            paths[i] = *path;
+
+            // The stored outline is quantized, but only by a fraction of a pixel.
+            SkPath original;
+            reference->getPath(SkPackedGlyphID((SkGlyphID)i), &original);
+            const SkRect& a = original.getBounds();
+            const SkRect& b = path->getBounds();
+            REPORTER_ASSERT(reporter, path->countPoints() == original.countPoints());
+            REPORTER_ASSERT(reporter, SkScalarNearlyEqual(a.fLeft,   b.fLeft,   0.01f) &&
+                                      SkScalarNearlyEqual(a.fTop,    b.fTop,    0.01f) &&
+                                      SkScalarNearlyEqual(a.fRight,  b.fRight,  0.01f) &&
+                                      SkScalarNearlyEqual(a.fBottom, b.fBottom, 0.01f));
+        }
+    }
+
+    // Releasing the paths must be reflected in the strike's size, and they must come back the
+    // same as before.
+    size_t memoryUsed = strike->getMemoryUsed();
+    size_t freed = strike->releasePaths();
+    REPORTER_ASSERT(reporter, freed > 0);
+    REPORTER_ASSERT(reporter, strike->getMemoryUsed() == memoryUsed - freed);
+    for (int i = 0; i < kGlyphCount; ++i) {
+        const SkGlyph& glyph = strike->getGlyphIDMetrics((SkGlyphID)i);
+        const SkPath* path = strike->findPath(glyph);
+        REPORTER_ASSERT(reporter, path ? *path == paths[i] : paths[i].isEmpty());
+    }
+    REPORTER_ASSERT(reporter, strike->getMemoryUsed() == memoryUsed);
+}
+
+DEF_TEST(SkStrike_discardableImages, reporter) {
+    sk_sp<SkDiscardableMemoryPool> pool = SkDiscardableMemoryPool::Make(1024 * 1024);
+    SkStrikeCache strikeCache;
+
+    SkFont font(ToolUtils::create_portable_typeface("serif", SkFontStyle()), 24);
+    font.setEdging(SkFont::Edging::kAntiAlias);
+    SkAutoDescriptor ad;
+    SkScalerContextEffects effects;
+    const SkDescriptor* desc = SkScalerContext::CreateDescriptorAndEffectsUsingPaint(
+            font, SkPaint(), SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+            SkScalerContextFlags::kNone, SkMatrix::I(), &ad, &effects);
+    auto strike = strikeCache.findOrCreateStrikeExclusive(*desc, effects,
+                                                          *font.getTypefaceOrDefault());
+    strike->useDiscardableImages(pool);
+
+    constexpr int kGlyphCount = 32;
+    std::vector<std::vector<uint8_t>> images(kGlyphCount);
+    for (int i = 0; i < kGlyphCount; ++i) {
+        const SkGlyph& glyph = strike->getGlyphIDMetrics((SkGlyphID)i);
+        if (const void* image = strike->findImage(glyph)) {
+            const uint8_t* bytes = static_cast<const uint8_t*>(image);
+            images[i].assign(bytes, bytes + glyph.computeImageSize());
+        }
+    }
+    size_t memoryUsed = strike->getMemoryUsed();
+    REPORTER_ASSERT(reporter, pool->getRAMUsed() > 0);
+
+    // Unlocked images are kept until the system needs the memory...
+    strike->unlockImages();
+    strike->lockImages();
+    REPORTER_ASSERT(reporter, strike->getMemoryUsed() == memoryUsed);
+
+    // ... and then come back the same as before.
+    strike->unlockImages();
+    pool->dumpPool();
+    strike->lockImages();
+    REPORTER_ASSERT(reporter, strike->getMemoryUsed() < memoryUsed);
+    for (int i = 0; i < kGlyphCount; ++i) {
+        const SkGlyph& glyph = strike->getGlyphIDMetrics((SkGlyphID)i);
+        REPORTER_ASSERT(reporter, glyph.fImage == nullptr);
+        const uint8_t* image = static_cast<const uint8_t*>(strike->findImage(glyph));
+        REPORTER_ASSERT(reporter, (image != nullptr) == !images[i].empty());
+        if (image) {
+            REPORTER_ASSERT(reporter,
+                            0 == memcmp(image, images[i].data(), glyph.computeImageSize()));
+        }
+    }
+    REPORTER_ASSERT(reporter, strike->getMemoryUsed() == memoryUsed);
+}
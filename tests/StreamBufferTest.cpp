@@ -148,3 +148,23 @@ DEF_TEST(StreamBuffer, r) {
     // Now go back to the data we skipped.
     test_get_data_at_position(r, &buffer, 14, 13);
 }
+
+DEF_TEST(StreamBuffer_memoryBacked, r) {
+    const size_t size = strlen(gText);
+    sk_sp<SkData> data(SkData::MakeWithoutCopy(gText, size));
+    SkStreamBuffer buffer(skstd::make_unique<SkMemoryStream>(data));
+
+    // Nothing should be copied out of the stream's memory.
+    REPORTER_ASSERT(r, buffer.buffer(5));
+    REPORTER_ASSERT(r, buffer.get() == gText);
+    const size_t position = buffer.markPosition();
+    buffer.flush();
+
+    REPORTER_ASSERT(r, buffer.buffer(7));
+    REPORTER_ASSERT(r, buffer.get() == gText + 5);
+    buffer.flush();
+
+    sk_sp<SkData> marked = buffer.getDataAtPosition(position, 5);
+    REPORTER_ASSERT(r, marked && marked->data() == gText);
+    test_get_data_at_position(r, &buffer, 12, size - 12);
+}
@@ -16,6 +16,7 @@
 #include "include/gpu/GrContext.h"
 #include "src/core/SkAutoPixmapStorage.h"
 #include "src/core/SkDevice.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkUtils.h"
 #include "src/gpu/GrContextPriv.h"
 #include "src/gpu/GrGpu.h"
@@ -1145,3 +1146,58 @@ DEF_TEST(surface_image_unity, reporter) {
         }
     }
 }
+
+static void draw_threaded_test_content(SkCanvas* canvas, int step) {
+    SkPaint paint;
+    switch (step) {
+        case 0:
+            canvas->clear(SK_ColorWHITE);
+            canvas->translate(3, 5);
+            canvas->save();
+            canvas->clipRect(SkRect::MakeLTRB(10, 10, 90, 90));
+            paint.setColor(SK_ColorRED);
+            canvas->drawCircle(50, 50, 45, paint);
+            break;
+        case 1:
+            paint.setColor(SK_ColorBLUE);
+            canvas->drawRect(SkRect::MakeLTRB(20, 60, 70, 95), paint);
+            canvas->restore();
+            paint.setAlpha(0x80);
+            canvas->saveLayer(nullptr, &paint);
+            break;
+        case 2:
+            paint.setColor(SK_ColorGREEN);
+            canvas->drawOval(SkRect::MakeLTRB(5, 30, 95, 70), paint);
+            canvas->restore();
+            canvas->drawLine(0, 0, 100, 100, paint);
+            break;
+    }
+}
+
+DEF_TEST(Surface_RasterThreaded, reporter) {
+    SkTaskGroup::Enabler enabled(4);
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(100, 100);
+    REPORTER_ASSERT(reporter, !SkSurface::MakeRasterThreaded(info, nullptr, 0));
+
+    auto expected = SkSurface::MakeRaster(info);
+    auto threaded = SkSurface::MakeRasterThreaded(info, nullptr, 16);
+    REPORTER_ASSERT(reporter, threaded);
+
+    for (int step = 0; step < 3; ++step) {
+        draw_threaded_test_content(expected->getCanvas(), step);
+        draw_threaded_test_content(threaded->getCanvas(), step);
+
+        // Snapshots must see the draws made so far, and not change with later draws.
+        sk_sp<SkImage> expectedImage = expected->makeImageSnapshot(),
+                       threadedImage = threaded->makeImageSnapshot();
+        REPORTER_ASSERT(reporter, ToolUtils::equal_pixels(expectedImage.get(),
+                                                          threadedImage.get()));
+
+        SkBitmap expectedBitmap, threadedBitmap;
+        expectedBitmap.allocPixels(info);
+        threadedBitmap.allocPixels(info);
+        REPORTER_ASSERT(reporter, expected->readPixels(expectedBitmap, 0, 0));
+        REPORTER_ASSERT(reporter, threaded->readPixels(threadedBitmap, 0, 0));
+        REPORTER_ASSERT(reporter, ToolUtils::equal_pixels(expectedBitmap, threadedBitmap));
+    }
+}
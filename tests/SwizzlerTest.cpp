@@ -7,6 +7,7 @@
 
 #include "include/core/SkSwizzle.h"
 #include "include/private/SkImageInfoPriv.h"
+#include "include/utils/SkRandom.h"
 #include "src/codec/SkSwizzler.h"
 #include "src/core/SkOpts.h"
 #include "tests/Test.h"
@@ -144,6 +145,25 @@ DEF_TEST(SwizzleOpts, r) {
     REPORTER_ASSERT(r, dst == 0xFA04ADCA);
 }
 
+DEF_TEST(SwizzleOpts_Spans, r) {
+    // Longer spans go through the SIMD loops. Each pixel should come out as it does alone.
+    uint32_t src[67], dst[67];
+    SkRandom random;
+    for (uint32_t& px : src) {
+        px = random.nextU();
+    }
+    for (auto proc : { SkOpts::RGBA_to_rgbA, SkOpts::RGBA_to_bgrA, SkOpts::RGBA_to_BGRA }) {
+        for (int count : { 4, 8, 15, 16, 17, 32, 67 }) {
+            proc(dst, src, count);
+            for (int i = 0; i < count; i++) {
+                uint32_t expected;
+                proc(&expected, src + i, 1);
+                REPORTER_ASSERT(r, dst[i] == expected);
+            }
+        }
+    }
+}
+
 DEF_TEST(PublicSwizzleOpts, r) {
     uint32_t dst, src;
 
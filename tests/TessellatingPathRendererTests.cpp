@@ -7,16 +7,19 @@
 
 #include "tests/Test.h"
 
+#include "include/core/SkExecutor.h"
 #include "include/core/SkPath.h"
 #include "include/effects/SkGradientShader.h"
 #include "include/gpu/GrContext.h"
 #include "src/gpu/GrClip.h"
 #include "src/gpu/GrContextPriv.h"
+#include "src/gpu/GrGpu.h"
 #include "src/gpu/GrShape.h"
 #include "src/gpu/GrStyle.h"
 #include "src/gpu/effects/GrPorterDuffXferProcessor.h"
 #include "src/gpu/ops/GrTessellatingPathRenderer.h"
 #include "src/shaders/SkShaderBase.h"
+#include "tools/gpu/GrContextFactory.h"
 
 /*
  * These tests pass by not crashing, hanging or asserting in Debug.
@@ -748,3 +751,96 @@ DEF_GPUTEST_FOR_ALL_CONTEXTS(TessellatingPathRendererTests, reporter, ctxInfo) {
     test_path(ctx, rtc.get(), create_path_43(), SkMatrix(), AATypeFlags::kCoverage);
     test_path(ctx, rtc.get(), create_path_44(), SkMatrix(), AATypeFlags::kCoverage);
 }
+
+#if GR_GPU_STATS
+// A cached tessellation should be reused as a path rotates and translates, and only redone when
+// the scale changes enough to need a different tolerance.
+DEF_GPUTEST_FOR_ALL_CONTEXTS(TessellatingPathRendererCache, reporter, ctxInfo) {
+    GrContext* ctx = ctxInfo.grContext();
+    const GrBackendFormat format =
+            ctx->priv().caps()->getBackendFormatFromColorType(kRGBA_8888_SkColorType);
+    sk_sp<GrRenderTargetContext> rtc(ctx->priv().makeDeferredRenderTargetContext(
+            format, SkBackingFit::kApprox, 400, 400, kRGBA_8888_GrPixelConfig, nullptr, 1,
+            GrMipMapped::kNo, kTopLeft_GrSurfaceOrigin));
+    if (!rtc) {
+        return;
+    }
+    rtc->discard();
+
+    SkPath path;
+    path.moveTo(0, 0);
+    path.quadTo(50, 100, 100, 0);
+    path.lineTo(50, 30);
+    path.close();
+
+    GrGpu::Stats* stats = ctx->priv().getGpu()->stats();
+    auto drawAndCount = [&](const SkMatrix& matrix, int* hits, int* misses) {
+        int hitsBefore = stats->numTessellationCacheHits();
+        int missesBefore = stats->numTessellationCacheMisses();
+        test_path(ctx, rtc.get(), path, matrix);
+        ctx->flush();
+        *hits = stats->numTessellationCacheHits() - hitsBefore;
+        *misses = stats->numTessellationCacheMisses() - missesBefore;
+    };
+
+    int hits, misses;
+    drawAndCount(SkMatrix::MakeTrans(100, 100), &hits, &misses);
+    REPORTER_ASSERT(reporter, hits == 0 && misses == 1);
+    for (int degrees = 10; degrees < 90; degrees += 10) {
+        SkMatrix matrix = SkMatrix::MakeTrans(100 + degrees, 100);
+        matrix.preRotate(degrees);
+        drawAndCount(matrix, &hits, &misses);
+        REPORTER_ASSERT(reporter, hits == 1 && misses == 0);
+    }
+    drawAndCount(SkMatrix::MakeScale(4), &hits, &misses);
+    REPORTER_ASSERT(reporter, hits == 0 && misses == 1);
+}
+#endif
+
+// Big paths are tessellated on the context's executor, which must give the same triangles as
+// tessellating them at flush.
+DEF_GPUTEST(TessellatingPathRendererThreaded, reporter, options) {
+    // A star with enough points to be tessellated on another thread.
+    SkPath path;
+    for (int i = 0; i < 2000; ++i) {
+        SkScalar angle = i * SK_ScalarPI * 2 / 2000;
+        SkScalar radius = (i & 1) ? 60 : 190;
+        SkPoint pt = {200 + radius * SkScalarCos(angle), 200 + radius * SkScalarSin(angle)};
+        if (i == 0) {
+            path.moveTo(pt);
+        } else {
+            path.lineTo(pt);
+        }
+    }
+    path.close();
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+    SkImageInfo info = SkImageInfo::Make(400, 400, kRGBA_8888_SkColorType, kPremul_SkAlphaType);
+    SkAutoTMalloc<uint32_t> pixels[2];
+    for (int threaded = 0; threaded < 2; ++threaded) {
+        GrContextOptions contextOptions = options;
+        contextOptions.fExecutor = threaded ? executor.get() : nullptr;
+        sk_gpu_test::GrContextFactory factory(contextOptions);
+        GrContext* ctx = factory.get(sk_gpu_test::GrContextFactory::kGL_ContextType);
+        if (!ctx) {
+            return;
+        }
+        const GrBackendFormat format =
+                ctx->priv().caps()->getBackendFormatFromColorType(kRGBA_8888_SkColorType);
+        sk_sp<GrRenderTargetContext> rtc(ctx->priv().makeDeferredRenderTargetContext(
+                format, SkBackingFit::kExact, 400, 400, kRGBA_8888_GrPixelConfig, nullptr, 1,
+                GrMipMapped::kNo, kTopLeft_GrSurfaceOrigin));
+        if (!rtc) {
+            return;
+        }
+        rtc->clear(nullptr, SK_PMColor4fTRANSPARENT,
+                   GrRenderTargetContext::CanClearFullscreen::kYes);
+        test_path(ctx, rtc.get(), path, SkMatrix::I(), AATypeFlags::kCoverage);
+        test_path(ctx, rtc.get(), path, SkMatrix::MakeTrans(10, 10));
+        pixels[threaded].reset(400 * 400);
+        REPORTER_ASSERT(reporter, rtc->readPixels(info, pixels[threaded].get(),
+                                                   info.minRowBytes(), 0, 0));
+    }
+    REPORTER_ASSERT(reporter, 0 == memcmp(pixels[0].get(), pixels[1].get(),
+                                          400 * 400 * sizeof(uint32_t)));
+}
@@ -171,3 +171,42 @@ DEF_GPUTEST_FOR_MOCK_CONTEXT(TextBlobAbnormal, reporter, ctxInfo) {
 DEF_GPUTEST_FOR_MOCK_CONTEXT(TextBlobStressAbnormal, reporter, ctxInfo) {
     text_blob_cache_inner(reporter, ctxInfo.grContext(), 256, 256, 10, false, true);
 }
+
+// Scrolling a cached blob offsets its vertices on the GPU instead of moving them, which must look
+// the same as drawing a new blob in the new place.
+DEF_GPUTEST_FOR_RENDERING_CONTEXTS(TextBlobCache_translate, reporter, ctxInfo) {
+    GrContext* context = ctxInfo.grContext();
+    SkImageInfo info = SkImageInfo::MakeN32Premul(256, 128);
+    auto cachedSurface = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, info);
+    auto freshSurface = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, info);
+    if (!cachedSurface || !freshSurface) {
+        return;
+    }
+
+    SkFont font(ToolUtils::create_portable_typeface(), 24);
+    const char* text = "Scrolling text";
+    sk_sp<SkTextBlob> cachedBlob = SkTextBlob::MakeFromString(text, font);
+
+    SkBitmap cachedBitmap, freshBitmap;
+    cachedBitmap.allocPixels(info);
+    freshBitmap.allocPixels(info);
+    for (int step = 0; step < 8; ++step) {
+        SkScalar x = 10 + 3 * step, y = 100 - 7 * step;
+
+        SkCanvas* canvas = cachedSurface->getCanvas();
+        canvas->clear(SK_ColorWHITE);
+        canvas->save();
+        canvas->translate(0, -2.0f * step);
+        canvas->drawTextBlob(cachedBlob, x, y + 2.0f * step, SkPaint());
+        canvas->restore();
+        cachedSurface->readPixels(cachedBitmap, 0, 0);
+
+        canvas = freshSurface->getCanvas();
+        canvas->clear(SK_ColorWHITE);
+        canvas->drawTextBlob(SkTextBlob::MakeFromString(text, font), x, y, SkPaint());
+        freshSurface->readPixels(freshBitmap, 0, 0);
+
+        REPORTER_ASSERT(reporter, 0 == memcmp(cachedBitmap.getPixels(), freshBitmap.getPixels(),
+                                              cachedBitmap.computeByteSize()));
+    }
+}
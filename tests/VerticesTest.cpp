@@ -8,9 +8,14 @@
 #include "include/core/SkCanvas.h"
 #include "include/core/SkSurface.h"
 #include "include/core/SkVertices.h"
+#include "include/utils/SkRandom.h"
 #include "tests/Test.h"
 #include "tools/ToolUtils.h"
 
+#include <algorithm>
+#include <array>
+#include <vector>
+
 static bool equal(const SkVertices* v0, const SkVertices* v1) {
     if (v0->mode() != v1->mode()) {
         return false;
@@ -121,6 +126,102 @@ DEF_TEST(Vertices, reporter) {
     }
 }
 
+// Average number of vertices a FIFO post-transform cache of 'cacheSize' misses per triangle.
+static float average_cache_miss_ratio(const SkVertices* vertices, int cacheSize) {
+    std::vector<uint16_t> cache;
+    int misses = 0;
+    for (int i = 0; i < vertices->indexCount(); ++i) {
+        uint16_t index = vertices->indices()[i];
+        if (std::find(cache.begin(), cache.end(), index) == cache.end()) {
+            ++misses;
+            cache.push_back(index);
+            if ((int)cache.size() > cacheSize) {
+                cache.erase(cache.begin());
+            }
+        }
+    }
+    return misses / (vertices->indexCount() / 3.0f);
+}
+
+DEF_TEST(Vertices_optimizeForVertexCache, reporter) {
+    // A grid of quads whose triangles are listed in a random order.
+    const int kSize = 32;
+    const int kVertexCount = (kSize + 1) * (kSize + 1);
+    std::vector<std::array<uint16_t, 3>> triangles;
+    for (int y = 0; y < kSize; ++y) {
+        for (int x = 0; x < kSize; ++x) {
+            uint16_t i = SkToU16(y * (kSize + 1) + x);
+            triangles.push_back({{ i, SkToU16(i + 1), SkToU16(i + kSize + 1) }});
+            triangles.push_back({{ SkToU16(i + 1), SkToU16(i + kSize + 2),
+                                   SkToU16(i + kSize + 1) }});
+        }
+    }
+    SkRandom random;
+    for (int i = triangles.size() - 1; i > 0; --i) {
+        std::swap(triangles[i], triangles[random.nextULessThan(i + 1)]);
+    }
+
+    sk_sp<SkVertices> vertices[2];
+    for (int optimize = 0; optimize < 2; ++optimize) {
+        uint32_t flags = SkVertices::kHasColors_BuilderFlag;
+        if (optimize) {
+            flags |= SkVertices::kOptimizeForVertexCache_BuilderFlag;
+        }
+        SkVertices::Builder builder(SkVertices::kTriangles_VertexMode, kVertexCount,
+                                    3 * triangles.size(), flags);
+        for (int v = 0; v < kVertexCount; ++v) {
+            builder.positions()[v].set(v % (kSize + 1), v / (kSize + 1));
+            builder.colors()[v] = SkColorSetARGB(0xFF, v % (kSize + 1), v / (kSize + 1), 0);
+        }
+        memcpy(builder.indices(), triangles.data(), 3 * triangles.size() * sizeof(uint16_t));
+        vertices[optimize] = builder.detach();
+    }
+    const SkVertices* original = vertices[0].get();
+    const SkVertices* optimized = vertices[1].get();
+    REPORTER_ASSERT(reporter, optimized->vertexCount() == original->vertexCount());
+    REPORTER_ASSERT(reporter, optimized->indexCount() == original->indexCount());
+    REPORTER_ASSERT(reporter, optimized->bounds() == original->bounds());
+
+    // The same triangles are drawn, with their winding and per-vertex attributes intact.
+    using Triangle = std::array<std::pair<SkScalar, SkScalar>, 3>;
+    auto collect_triangles = [](const SkVertices* vertices) {
+        std::vector<Triangle> result;
+        for (int i = 0; i < vertices->indexCount(); i += 3) {
+            Triangle triangle;
+            for (int j = 0; j < 3; ++j) {
+                const SkPoint& p = vertices->positions()[vertices->indices()[i + j]];
+                triangle[j] = { p.fX, p.fY };
+            }
+            std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()),
+                        triangle.end());
+            result.push_back(triangle);
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    };
+    REPORTER_ASSERT(reporter, collect_triangles(original) == collect_triangles(optimized));
+    for (int v = 0; v < kVertexCount; ++v) {
+        SkPoint p = optimized->positions()[v];
+        REPORTER_ASSERT(reporter,
+                        optimized->colors()[v] == SkColorSetARGB(0xFF, p.fX, p.fY, 0));
+    }
+
+    // The vertices are numbered in the order the triangles first use them.
+    int maxIndex = -1;
+    for (int i = 0; i < optimized->indexCount(); ++i) {
+        int index = optimized->indices()[i];
+        REPORTER_ASSERT(reporter, index <= maxIndex + 1);
+        maxIndex = SkTMax(maxIndex, index);
+    }
+
+    // A random order fetches nearly every vertex of every triangle. A good order for a grid
+    // fetches well under one new vertex per triangle.
+    float originalRatio = average_cache_miss_ratio(original, 16);
+    float optimizedRatio = average_cache_miss_ratio(optimized, 16);
+    REPORTER_ASSERT(reporter, originalRatio > 2.5f, "%g", originalRatio);
+    REPORTER_ASSERT(reporter, optimizedRatio < 1.0f, "%g", optimizedRatio);
+}
+
 static void fill_triangle(SkCanvas* canvas, const SkPoint pts[], SkColor c) {
     SkColor colors[] = { c, c, c };
     auto verts = SkVertices::MakeCopy(SkVertices::kTriangles_VertexMode, 3, pts, nullptr, colors);
@@ -163,3 +163,70 @@ DEF_TEST(YUVMath, reporter) {
         }
     }
 }
+
+#include "include/core/SkImage.h"
+#include "include/core/SkYUVAIndex.h"
+
+// Without a context the planes become a raster image. Here the chroma is subsampled 2x2 and
+// interleaved in one plane, as in NV12.
+DEF_TEST(YUVAPixmaps_Raster, reporter) {
+    const SkColor colors[4] = { SK_ColorRED, SK_ColorGREEN, SK_ColorBLUE, 0xFF808040 };
+    float rgbToYUV[20];
+    SkColorMatrix_RGB2YUV(kRec601_SkYUVColorSpace, rgbToYUV);
+
+    uint8_t yPlane[4 * 4];
+    uint32_t uvPlane[2 * 2];
+    for (int i = 0; i < 4; ++i) {
+        float rgb[3] = { SkColorGetR(colors[i]) / 255.0f,
+                         SkColorGetG(colors[i]) / 255.0f,
+                         SkColorGetB(colors[i]) / 255.0f };
+        uint8_t yuv[3];
+        for (int j = 0; j < 3; ++j) {
+            const float* row = rgbToYUV + 5 * j;
+            float v = row[0] * rgb[0] + row[1] * rgb[1] + row[2] * rgb[2] + row[4];
+            yuv[j] = (uint8_t)SkTPin(sk_float_round2int(v * 255), 0, 255);
+        }
+        int x = i % 2, y = i / 2;
+        for (int dy = 0; dy < 2; ++dy) {
+            for (int dx = 0; dx < 2; ++dx) {
+                yPlane[(2 * y + dy) * 4 + 2 * x + dx] = yuv[0];
+            }
+        }
+        uvPlane[y * 2 + x] = 0xFF000000 | yuv[2] << 8 | yuv[1];
+    }
+
+    const SkPixmap planes[2] = {
+        { SkImageInfo::Make(4, 4, kGray_8_SkColorType, kOpaque_SkAlphaType), yPlane, 4 },
+        { SkImageInfo::Make(2, 2, kRGBA_8888_SkColorType, kOpaque_SkAlphaType), uvPlane, 8 },
+    };
+    const SkYUVAIndex indices[4] = {
+        { 0, SkColorChannel::kR }, { 1, SkColorChannel::kR }, { 1, SkColorChannel::kG },
+        { -1, SkColorChannel::kA },
+    };
+
+    for (GrSurfaceOrigin origin : { kTopLeft_GrSurfaceOrigin, kBottomLeft_GrSurfaceOrigin }) {
+        sk_sp<SkImage> image = SkImage::MakeFromYUVAPixmaps(nullptr, kRec601_SkYUVColorSpace,
+                                                            planes, indices, {4, 4}, origin,
+                                                            false);
+        REPORTER_ASSERT(reporter, image && !image->isTextureBacked() && image->isOpaque());
+        if (!image) {
+            continue;
+        }
+
+        SkColor pixels[4 * 4];
+        SkImageInfo info = SkImageInfo::Make(4, 4, kBGRA_8888_SkColorType, kUnpremul_SkAlphaType);
+        REPORTER_ASSERT(reporter, image->readPixels(info, pixels, 16, 0, 0));
+        for (int y = 0; y < 4; ++y) {
+            for (int x = 0; x < 4; ++x) {
+                int planeY = origin == kTopLeft_GrSurfaceOrigin ? y : 3 - y;
+                SkColor expected = colors[(planeY / 2) * 2 + x / 2],
+                        actual   = pixels[y * 4 + x];
+                REPORTER_ASSERT(reporter,
+                                SkTAbs((int)SkColorGetR(expected) - (int)SkColorGetR(actual)) <= 2
+                             && SkTAbs((int)SkColorGetG(expected) - (int)SkColorGetG(actual)) <= 2
+                             && SkTAbs((int)SkColorGetB(expected) - (int)SkColorGetB(actual)) <= 2
+                             && SkColorGetA(actual) == 0xFF);
+            }
+        }
+    }
+}
@@ -0,0 +1,512 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "tools/debugger/CostHeatmapCanvas.h"
+
+#include "include/core/SkColorFilter.h"
+#include "include/core/SkDrawable.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkImageFilter.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkRRect.h"
+#include "include/core/SkRSXform.h"
+#include "include/core/SkRegion.h"
+#include "include/core/SkShader.h"
+#include "include/core/SkTextBlob.h"
+#include "include/core/SkVertices.h"
+#include "src/core/SkDrawShadowInfo.h"
+#include "src/core/SkMaskFilterBase.h"
+#include "src/utils/SkJSONWriter.h"
+
+#include <algorithm>
+
+// Costs are in rough units of one raster pipeline stage run for one pixel.
+
+// Anti-aliased edges need coverage computed and applied.
+static constexpr float kAACoverageCost = 1;
+// Arbitrary paths are rasterized edge by edge, on top of their coverage.
+static constexpr float kPathRasterCost = 1;
+// Glyph masks are looked up and applied as coverage.
+static constexpr float kGlyphMaskCost = 1;
+// Shadows draw blurred ambient and spot shapes.
+static constexpr float kShadowCost = 6;
+// A layer is cleared, then composited back through its paint.
+static constexpr float kLayerClearCost = 1;
+// A backdrop filter reads the layer below back, then filters it.
+static constexpr float kBackdropCost = 4;
+
+static SkRect point_bounds(size_t count, const SkPoint pts[], const SkPaint& paint) {
+    SkRect bounds;
+    bounds.setBounds(pts, SkToInt(count));
+    SkScalar outset = SkTMax(paint.getStrokeWidth() * 0.5f, 0.5f);
+    return bounds.makeOutset(outset, outset);
+}
+
+static float aa_cost(const SkPaint& paint) { return paint.isAntiAlias() ? kAACoverageCost : 0; }
+
+CostHeatmapCanvas::CostHeatmapCanvas(int width, int height)
+        : INHERITED(width, height)
+        , fCellsX((width + kCellSize - 1) / kCellSize)
+        , fCellsY((height + kCellSize - 1) / kCellSize) {
+    fCells.push_back_n(SkTMax(fCellsX * fCellsY * kDrawTypeCount, 0), 0.f);
+    std::fill_n(fTotals, kDrawTypeCount, 0.f);
+    fSaves.push_back({SkIRect::MakeWH(width, height), false, 0, SkIRect::MakeEmpty()});
+}
+
+const char* CostHeatmapCanvas::DrawTypeName(DrawType type) {
+    switch (type) {
+        case DrawType::kPaint:    return "paint";
+        case DrawType::kRect:     return "rect";
+        case DrawType::kRRect:    return "rrect";
+        case DrawType::kPath:     return "path";
+        case DrawType::kText:     return "text";
+        case DrawType::kImage:    return "image";
+        case DrawType::kVertices: return "vertices";
+        case DrawType::kAtlas:    return "atlas";
+        case DrawType::kShadow:   return "shadow";
+        case DrawType::kLayer:    return "layer";
+    }
+    SK_ABORT("Unknown DrawType");
+    return nullptr;
+}
+
+float CostHeatmapCanvas::totalCost() const {
+    float total = 0;
+    for (float cost : fTotals) {
+        total += cost;
+    }
+    return total;
+}
+
+float CostHeatmapCanvas::totalCost(DrawType type) const {
+    return fTotals[static_cast<int>(type)];
+}
+
+float CostHeatmapCanvas::cellCost(int x, int y) const {
+    const float* costs = this->cell(x, y);
+    float total = 0;
+    for (int i = 0; i < kDrawTypeCount; ++i) {
+        total += costs[i];
+    }
+    return total;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+float CostHeatmapCanvas::PaintCost(const SkPaint* paint, SkRect* bounds, bool* boundsAreKnown) {
+    *boundsAreKnown = true;
+    // Loading the destination, blending and storing.
+    float cost = 1;
+    if (!paint) {
+        return cost;
+    }
+    if (const SkShader* shader = paint->getShader()) {
+        cost += shader->isAImage() ? 3 : 2;
+    }
+    if (paint->getColorFilter()) {
+        cost += 1;
+    }
+    SkBlendMode mode = paint->getBlendMode();
+    if (mode != SkBlendMode::kSrcOver && mode != SkBlendMode::kSrc) {
+        cost += mode > SkBlendMode::kLastCoeffMode ? 3 : 1;
+    }
+    if (const SkMaskFilterBase* maskFilter = as_MFB(paint->getMaskFilter())) {
+        // Blurs make a mask, then blur it in passes whose work grows with sigma.
+        SkMaskFilterBase::BlurRec rec;
+        cost += maskFilter->asABlur(&rec) ? 2 + 2 * rec.fSigma : 2;
+    }
+    if (paint->getImageFilter()) {
+        // The filter runs in its own pass, drawn into a layer that's then composited.
+        cost += 4 + kLayerClearCost;
+    }
+    if (paint->canComputeFastBounds()) {
+        SkRect storage;
+        *bounds = paint->computeFastBounds(*bounds, &storage);
+    } else {
+        *boundsAreKnown = false;
+    }
+    return cost;
+}
+
+float CostHeatmapCanvas::ImageCost(const SkPaint* paint) {
+    switch (paint ? paint->getFilterQuality() : kNone_SkFilterQuality) {
+        case kNone_SkFilterQuality:   return 1;
+        case kLow_SkFilterQuality:    return 2;
+        case kMedium_SkFilterQuality: return 3;  // bilerp, and choosing and building mipmaps
+        case kHigh_SkFilterQuality:   return 6;  // bicubic
+    }
+    SK_ABORT("Unknown SkFilterQuality");
+    return 1;
+}
+
+void CostHeatmapCanvas::addCost(DrawType type, const SkRect& localBounds, const SkPaint* paint,
+                                float geometryCost) {
+    SkRect bounds = localBounds;
+    bool boundsAreKnown;
+    float cost = geometryCost + PaintCost(paint, &bounds, &boundsAreKnown);
+
+    SkIRect deviceBounds = fSaves.back().fClipBounds;
+    if (boundsAreKnown && !deviceBounds.intersect(this->getTotalMatrix().mapRect(bounds)
+                                                          .roundOut())) {
+        return;
+    }
+    this->addDeviceCost(type, deviceBounds, cost);
+}
+
+void CostHeatmapCanvas::addDeviceCost(DrawType type, const SkIRect& deviceBounds,
+                                      float costPerPixel) {
+    SkIRect bounds = deviceBounds;
+    if (!bounds.intersect(SkIRect::MakeSize(this->getBaseLayerSize()))) {
+        return;
+    }
+    for (int y = bounds.fTop / kCellSize; y * kCellSize < bounds.fBottom; ++y) {
+        for (int x = bounds.fLeft / kCellSize; x * kCellSize < bounds.fRight; ++x) {
+            SkIRect covered = SkIRect::MakeXYWH(x * kCellSize, y * kCellSize,
+                                                kCellSize, kCellSize);
+            SkAssertResult(covered.intersect(bounds));
+            float cost = costPerPixel * covered.width() * covered.height();
+            this->cell(x, y)[static_cast<int>(type)] += cost;
+            fTotals[static_cast<int>(type)] += cost;
+        }
+    }
+}
+
+void CostHeatmapCanvas::clipDeviceBounds(const SkRect& localBounds, SkClipOp op) {
+    // Only intersections shrink the clip's bounds.
+    if (op == SkClipOp::kIntersect) {
+        SkIRect& clipBounds = fSaves.back().fClipBounds;
+        if (!clipBounds.intersect(this->getTotalMatrix().mapRect(localBounds).roundOut())) {
+            clipBounds.setEmpty();
+        }
+    }
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void CostHeatmapCanvas::willSave() {
+    fSaves.push_back({fSaves.back().fClipBounds, false, 0, SkIRect::MakeEmpty()});
+    this->INHERITED::willSave();
+}
+
+SkCanvas::SaveLayerStrategy CostHeatmapCanvas::getSaveLayerStrategy(const SaveLayerRec& rec) {
+    SkIRect layerBounds = fSaves.back().fClipBounds;
+    if (rec.fBounds &&
+        !layerBounds.intersect(this->getTotalMatrix().mapRect(*rec.fBounds).roundOut())) {
+        layerBounds.setEmpty();
+    }
+    SkRect unused = SkRect::Make(layerBounds);
+    bool boundsAreKnown;
+    float cost = kLayerClearCost + PaintCost(rec.fPaint, &unused, &boundsAreKnown);
+    if (rec.fBackdrop) {
+        cost += kBackdropCost;
+    }
+    fSaves.push_back({layerBounds, true, cost, layerBounds});
+    return this->INHERITED::getSaveLayerStrategy(rec);
+}
+
+void CostHeatmapCanvas::willRestore() {
+    if (fSaves.count() > 1) {
+        const SaveRec& save = fSaves.back();
+        if (save.fIsLayer) {
+            this->addDeviceCost(DrawType::kLayer, save.fLayerBounds, save.fLayerCost);
+        }
+        fSaves.pop_back();
+    }
+    this->INHERITED::willRestore();
+}
+
+void CostHeatmapCanvas::onClipRect(const SkRect& rect, SkClipOp op, ClipEdgeStyle style) {
+    this->clipDeviceBounds(rect, op);
+    this->INHERITED::onClipRect(rect, op, style);
+}
+
+void CostHeatmapCanvas::onClipRRect(const SkRRect& rrect, SkClipOp op, ClipEdgeStyle style) {
+    this->clipDeviceBounds(rrect.getBounds(), op);
+    this->INHERITED::onClipRRect(rrect, op, style);
+}
+
+void CostHeatmapCanvas::onClipPath(const SkPath& path, SkClipOp op, ClipEdgeStyle style) {
+    if (!path.isInverseFillType()) {
+        this->clipDeviceBounds(path.getBounds(), op);
+    }
+    this->INHERITED::onClipPath(path, op, style);
+}
+
+void CostHeatmapCanvas::onClipRegion(const SkRegion& deviceRegion, SkClipOp op) {
+    // Regions are already in device space.
+    if (op == SkClipOp::kIntersect) {
+        SkIRect& clipBounds = fSaves.back().fClipBounds;
+        if (!clipBounds.intersect(deviceRegion.getBounds())) {
+            clipBounds.setEmpty();
+        }
+    }
+    this->INHERITED::onClipRegion(deviceRegion, op);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void CostHeatmapCanvas::onDrawPaint(const SkPaint& paint) {
+    SkRect unused = SkRect::MakeEmpty();
+    bool boundsAreKnown;
+    this->addDeviceCost(DrawType::kPaint, fSaves.back().fClipBounds,
+                        PaintCost(&paint, &unused, &boundsAreKnown));
+}
+
+void CostHeatmapCanvas::onDrawBehind(const SkPaint& paint) { this->onDrawPaint(paint); }
+
+void CostHeatmapCanvas::onDrawPoints(PointMode, size_t count, const SkPoint pts[],
+                                     const SkPaint& paint) {
+    if (count > 0) {
+        this->addCost(DrawType::kPath, point_bounds(count, pts, paint), &paint, aa_cost(paint));
+    }
+}
+
+void CostHeatmapCanvas::onDrawRect(const SkRect& rect, const SkPaint& paint) {
+    this->addCost(DrawType::kRect, rect, &paint, 0);
+}
+
+void CostHeatmapCanvas::onDrawRegion(const SkRegion& region, const SkPaint& paint) {
+    this->addCost(DrawType::kRect, SkRect::Make(region.getBounds()), &paint, 0);
+}
+
+void CostHeatmapCanvas::onDrawOval(const SkRect& oval, const SkPaint& paint) {
+    this->addCost(DrawType::kRRect, oval, &paint, aa_cost(paint));
+}
+
+void CostHeatmapCanvas::onDrawArc(const SkRect& oval, SkScalar, SkScalar, bool,
+                                  const SkPaint& paint) {
+    this->addCost(DrawType::kPath, oval, &paint, aa_cost(paint) + kPathRasterCost);
+}
+
+void CostHeatmapCanvas::onDrawRRect(const SkRRect& rrect, const SkPaint& paint) {
+    this->addCost(DrawType::kRRect, rrect.getBounds(), &paint, aa_cost(paint));
+}
+
+void CostHeatmapCanvas::onDrawDRRect(const SkRRect& outer, const SkRRect&,
+                                     const SkPaint& paint) {
+    this->addCost(DrawType::kRRect, outer.getBounds(), &paint, aa_cost(paint));
+}
+
+void CostHeatmapCanvas::onDrawPath(const SkPath& path, const SkPaint& paint) {
+    if (path.isInverseFillType()) {
+        SkRect unused = SkRect::MakeEmpty();
+        bool boundsAreKnown;
+        this->addDeviceCost(DrawType::kPath, fSaves.back().fClipBounds,
+                            kPathRasterCost + PaintCost(&paint, &unused, &boundsAreKnown));
+        return;
+    }
+    this->addCost(DrawType::kPath, path.getBounds(), &paint, aa_cost(paint) + kPathRasterCost);
+}
+
+void CostHeatmapCanvas::onDrawTextBlob(const SkTextBlob* blob, SkScalar x, SkScalar y,
+                                       const SkPaint& paint) {
+    this->addCost(DrawType::kText, blob->bounds().makeOffset(x, y), &paint, kGlyphMaskCost);
+}
+
+void CostHeatmapCanvas::onDrawPatch(const SkPoint cubics[12], const SkColor colors[4],
+                                    const SkPoint texCoords[4], SkBlendMode,
+                                    const SkPaint& paint) {
+    SkRect bounds;
+    bounds.setBounds(cubics, 12);
+    this->addCost(DrawType::kVertices, bounds, &paint, colors ? 1 : 0);
+}
+
+void CostHeatmapCanvas::onDrawVerticesObject(const SkVertices* vertices, const SkVertices::Bone[],
+                                             int boneCount, SkBlendMode, const SkPaint& paint) {
+    this->addCost(DrawType::kVertices, vertices->bounds(), &paint,
+                  (vertices->hasColors() ? 1 : 0) + (boneCount > 0 ? 1 : 0));
+}
+
+void CostHeatmapCanvas::onDrawImage(const SkImage* image, SkScalar left, SkScalar top,
+                                    const SkPaint* paint) {
+    this->addCost(DrawType::kImage,
+                  SkRect::MakeXYWH(left, top, image->width(), image->height()), paint,
+                  ImageCost(paint));
+}
+
+void CostHeatmapCanvas::onDrawImageRect(const SkImage*, const SkRect*, const SkRect& dst,
+                                        const SkPaint* paint, SrcRectConstraint) {
+    this->addCost(DrawType::kImage, dst, paint, ImageCost(paint));
+}
+
+void CostHeatmapCanvas::onDrawImageNine(const SkImage*, const SkIRect&, const SkRect& dst,
+                                        const SkPaint* paint) {
+    this->addCost(DrawType::kImage, dst, paint, ImageCost(paint));
+}
+
+void CostHeatmapCanvas::onDrawImageLattice(const SkImage*, const Lattice&, const SkRect& dst,
+                                           const SkPaint* paint) {
+    this->addCost(DrawType::kImage, dst, paint, ImageCost(paint));
+}
+
+void CostHeatmapCanvas::onDrawBitmap(const SkBitmap& bitmap, SkScalar left, SkScalar top,
+                                     const SkPaint* paint) {
+    this->addCost(DrawType::kImage,
+                  SkRect::MakeXYWH(left, top, bitmap.width(), bitmap.height()), paint,
+                  ImageCost(paint));
+}
+
+void CostHeatmapCanvas::onDrawBitmapRect(const SkBitmap&, const SkRect*, const SkRect& dst,
+                                         const SkPaint* paint, SrcRectConstraint) {
+    this->addCost(DrawType::kImage, dst, paint, ImageCost(paint));
+}
+
+void CostHeatmapCanvas::onDrawBitmapNine(const SkBitmap&, const SkIRect&, const SkRect& dst,
+                                         const SkPaint* paint) {
+    this->addCost(DrawType::kImage, dst, paint, ImageCost(paint));
+}
+
+void CostHeatmapCanvas::onDrawBitmapLattice(const SkBitmap&, const Lattice&, const SkRect& dst,
+                                            const SkPaint* paint) {
+    this->addCost(DrawType::kImage, dst, paint, ImageCost(paint));
+}
+
+void CostHeatmapCanvas::onDrawAtlas(const SkImage*, const SkRSXform xforms[],
+                                    const SkRect texs[], const SkColor colors[], int count,
+                                    SkBlendMode, const SkRect* cull, const SkPaint* paint) {
+    // Sprites may overlap, so each is costed on its own.
+    float geometryCost = ImageCost(paint) + (colors ? 1 : 0);
+    for (int i = 0; i < count; ++i) {
+        SkPoint quad[4];
+        xforms[i].toQuad(texs[i].width(), texs[i].height(), quad);
+        SkRect bounds;
+        bounds.setBounds(quad, 4);
+        if (cull && !bounds.intersect(*cull)) {
+            continue;
+        }
+        this->addCost(DrawType::kAtlas, bounds, paint, geometryCost);
+    }
+}
+
+void CostHeatmapCanvas::onDrawEdgeAAQuad(const SkRect& rect, const SkPoint clip[4],
+                                         QuadAAFlags aaFlags, SkColor, SkBlendMode mode) {
+    SkPaint paint;
+    paint.setBlendMode(mode);
+    SkRect bounds = rect;
+    if (clip) {
+        bounds.setBounds(clip, 4);
+    }
+    this->addCost(DrawType::kRect, bounds, &paint, aaFlags ? kAACoverageCost : 0);
+}
+
+void CostHeatmapCanvas::onDrawEdgeAAImageSet(const ImageSetEntry set[], int count,
+                                             const SkPoint dstClips[],
+                                             const SkMatrix preViewMatrices[],
+                                             const SkPaint* paint, SrcRectConstraint) {
+    int clipIndex = 0;
+    for (int i = 0; i < count; ++i) {
+        SkRect bounds = set[i].fDstRect;
+        if (set[i].fHasClip) {
+            bounds.setBounds(dstClips + clipIndex, 4);
+            clipIndex += 4;
+        }
+        if (set[i].fMatrixIndex >= 0) {
+            bounds = preViewMatrices[set[i].fMatrixIndex].mapRect(bounds);
+        }
+        this->addCost(DrawType::kImage, bounds, paint,
+                      ImageCost(paint) + (set[i].fAAFlags ? kAACoverageCost : 0));
+    }
+}
+
+void CostHeatmapCanvas::onDrawShadowRec(const SkPath& path, const SkDrawShadowRec& rec) {
+    SkRect bounds;
+    SkDrawShadowMetrics::GetLocalBounds(path, rec, this->getTotalMatrix(), &bounds);
+    this->addCost(DrawType::kShadow, bounds, nullptr, kShadowCost);
+}
+
+void CostHeatmapCanvas::onDrawDrawable(SkDrawable* drawable, const SkMatrix* matrix) {
+    // Costs what it draws.
+    drawable->draw(this, matrix);
+}
+
+void CostHeatmapCanvas::onDrawPicture(const SkPicture* picture, const SkMatrix* matrix,
+                                      const SkPaint* paint) {
+    // Costs what it draws, in a layer if there's a paint.
+    this->SkCanvas::onDrawPicture(picture, matrix, paint);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+void CostHeatmapCanvas::drawHeatmap(SkCanvas* canvas) const {
+    float maxCost = 0;
+    for (int y = 0; y < fCellsY; ++y) {
+        for (int x = 0; x < fCellsX; ++x) {
+            maxCost = SkTMax(maxCost, this->cellCost(x, y));
+        }
+    }
+    if (maxCost <= 0) {
+        return;
+    }
+
+    SkPaint paint;
+    for (int y = 0; y < fCellsY; ++y) {
+        for (int x = 0; x < fCellsX; ++x) {
+            float cost = this->cellCost(x, y);
+            if (cost <= 0) {
+                continue;
+            }
+            // The square root spreads out the cheaper cells, which would otherwise all look cold
+            // next to a few very costly ones.
+            float t = sqrtf(cost / maxCost);
+            paint.setColor4f({t, 0, 1 - t, 0.25f + 0.5f * t}, nullptr);
+            canvas->drawRect(SkRect::MakeXYWH(x * kCellSize, y * kCellSize, kCellSize, kCellSize),
+                             paint);
+        }
+    }
+}
+
+void CostHeatmapCanvas::writeSummary(SkJSONWriter& writer, int maxRegions) const {
+    writer.beginObject();
+    writer.appendS32("cellSize", kCellSize);
+    writer.appendFloat("totalCost", this->totalCost());
+    writer.beginObject("costByType");
+    for (int i = 0; i < kDrawTypeCount; ++i) {
+        writer.appendFloat(DrawTypeName(static_cast<DrawType>(i)), fTotals[i]);
+    }
+    writer.endObject();
+
+    SkTArray<int> cells;
+    for (int i = 0; i < fCellsX * fCellsY; ++i) {
+        if (this->cellCost(i % fCellsX, i / fCellsX) > 0) {
+            cells.push_back(i);
+        }
+    }
+    int regionCount = SkTMin(SkTMax(maxRegions, 0), cells.count());
+    std::partial_sort(cells.begin(), cells.begin() + regionCount, cells.end(),
+                      [this](int a, int b) {
+        return this->cellCost(a % fCellsX, a / fCellsX) > this->cellCost(b % fCellsX,
+                                                                          b / fCellsX);
+    });
+
+    const SkIRect canvasBounds = SkIRect::MakeSize(this->getBaseLayerSize());
+    writer.beginArray("regions");
+    for (int i = 0; i < regionCount; ++i) {
+        int x = cells[i] % fCellsX,
+            y = cells[i] / fCellsX;
+        SkIRect region = SkIRect::MakeXYWH(x * kCellSize, y * kCellSize, kCellSize, kCellSize);
+        SkAssertResult(region.intersect(canvasBounds));
+
+        writer.beginObject(nullptr, false);
+        writer.appendS32("x", region.x());
+        writer.appendS32("y", region.y());
+        writer.appendS32("width", region.width());
+        writer.appendS32("height", region.height());
+        writer.appendFloat("cost", this->cellCost(x, y));
+        writer.beginObject("costByType", false);
+        const float* costs = this->cell(x, y);
+        for (int type = 0; type < kDrawTypeCount; ++type) {
+            if (costs[type] > 0) {
+                writer.appendFloat(DrawTypeName(static_cast<DrawType>(type)), costs[type]);
+            }
+        }
+        writer.endObject();
+        writer.endObject();
+    }
+    writer.endArray();
+    writer.endObject();
+}
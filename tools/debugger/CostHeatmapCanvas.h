@@ -0,0 +1,154 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef CostHeatmapCanvas_DEFINED
+#define CostHeatmapCanvas_DEFINED
+
+#include "include/core/SkCanvasVirtualEnforcer.h"
+#include "include/private/SkTArray.h"
+#include "include/utils/SkNoDrawCanvas.h"
+
+class SkJSONWriter;
+
+/**
+ * Captures drawing commands and, rather than drawing them, estimates what each pixel would cost
+ * to draw. Each draw adds a cost per pixel over its bounds in device space (clipped by the clip's
+ * bounds), weighted by the work its paint asks for. That is roughly one unit for each stage the
+ * raster pipeline would run (shader, color filter, blend, coverage, image filtering), plus blur
+ * work that grows with sigma. Each layer adds the cost of clearing it and compositing it back.
+ *
+ * Costs are kept for cells of kCellSize x kCellSize pixels, and by the kind of draw that made
+ * them, so the heatmap and the summary show both where and on what the cost was spent.
+ */
+class CostHeatmapCanvas : public SkCanvasVirtualEnforcer<SkNoDrawCanvas> {
+public:
+    enum class DrawType {
+        kPaint,
+        kRect,
+        kRRect,
+        kPath,
+        kText,
+        kImage,
+        kVertices,
+        kAtlas,
+        kShadow,
+        kLayer,
+
+        kLast = kLayer,
+    };
+    static constexpr int kDrawTypeCount = static_cast<int>(DrawType::kLast) + 1;
+    static constexpr int kCellSize = 16;
+
+    CostHeatmapCanvas(int width, int height);
+
+    static const char* DrawTypeName(DrawType);
+
+    float totalCost() const;
+    float totalCost(DrawType) const;
+
+    /**
+     * Draws the heatmap over canvas, from transparent blue for cheap cells to opaque red for the
+     * costliest one.
+     */
+    void drawHeatmap(SkCanvas*) const;
+
+    /**
+     * Writes the total cost, the cost of each kind of draw, and the 'maxRegions' costliest cells
+     * with their costs by kind of draw.
+     */
+    void writeSummary(SkJSONWriter&, int maxRegions = 16) const;
+
+protected:
+    void willSave() override;
+    SaveLayerStrategy getSaveLayerStrategy(const SaveLayerRec&) override;
+    void willRestore() override;
+
+    void onClipRect(const SkRect&, SkClipOp, ClipEdgeStyle) override;
+    void onClipRRect(const SkRRect&, SkClipOp, ClipEdgeStyle) override;
+    void onClipPath(const SkPath&, SkClipOp, ClipEdgeStyle) override;
+    void onClipRegion(const SkRegion&, SkClipOp) override;
+
+    void onDrawPaint(const SkPaint&) override;
+    void onDrawBehind(const SkPaint&) override;
+    void onDrawPoints(PointMode, size_t count, const SkPoint pts[], const SkPaint&) override;
+    void onDrawRect(const SkRect&, const SkPaint&) override;
+    void onDrawRegion(const SkRegion&, const SkPaint&) override;
+    void onDrawOval(const SkRect&, const SkPaint&) override;
+    void onDrawArc(const SkRect&, SkScalar, SkScalar, bool, const SkPaint&) override;
+    void onDrawRRect(const SkRRect&, const SkPaint&) override;
+    void onDrawDRRect(const SkRRect&, const SkRRect&, const SkPaint&) override;
+    void onDrawPath(const SkPath&, const SkPaint&) override;
+    void onDrawTextBlob(const SkTextBlob*, SkScalar x, SkScalar y, const SkPaint&) override;
+    void onDrawPatch(const SkPoint cubics[12], const SkColor colors[4],
+                     const SkPoint texCoords[4], SkBlendMode, const SkPaint&) override;
+    void onDrawVerticesObject(const SkVertices*, const SkVertices::Bone bones[], int boneCount,
+                              SkBlendMode, const SkPaint&) override;
+
+    void onDrawImage(const SkImage*, SkScalar left, SkScalar top, const SkPaint*) override;
+    void onDrawImageRect(const SkImage*, const SkRect* src, const SkRect& dst,
+                         const SkPaint*, SrcRectConstraint) override;
+    void onDrawImageNine(const SkImage*, const SkIRect& center, const SkRect& dst,
+                         const SkPaint*) override;
+    void onDrawImageLattice(const SkImage*, const Lattice&, const SkRect& dst,
+                            const SkPaint*) override;
+    void onDrawBitmap(const SkBitmap&, SkScalar left, SkScalar top, const SkPaint*) override;
+    void onDrawBitmapRect(const SkBitmap&, const SkRect* src, const SkRect& dst, const SkPaint*,
+                          SrcRectConstraint) override;
+    void onDrawBitmapNine(const SkBitmap&, const SkIRect& center, const SkRect& dst,
+                          const SkPaint*) override;
+    void onDrawBitmapLattice(const SkBitmap&, const Lattice&, const SkRect& dst,
+                             const SkPaint*) override;
+    void onDrawAtlas(const SkImage*, const SkRSXform[], const SkRect[], const SkColor[],
+                     int count, SkBlendMode, const SkRect* cull, const SkPaint*) override;
+    void onDrawEdgeAAQuad(const SkRect&, const SkPoint clip[4], QuadAAFlags, SkColor,
+                          SkBlendMode) override;
+    void onDrawEdgeAAImageSet(const ImageSetEntry[], int count, const SkPoint dstClips[],
+                              const SkMatrix preViewMatrices[], const SkPaint*,
+                              SrcRectConstraint) override;
+
+    void onDrawAnnotation(const SkRect&, const char key[], SkData* value) override {}
+    void onDrawShadowRec(const SkPath&, const SkDrawShadowRec&) override;
+
+    void onDrawDrawable(SkDrawable*, const SkMatrix*) override;
+    void onDrawPicture(const SkPicture*, const SkMatrix*, const SkPaint*) override;
+
+private:
+    struct SaveRec {
+        SkIRect fClipBounds;
+        // If this save is a layer, the cost of each of its pixels, and their device bounds.
+        bool    fIsLayer;
+        float   fLayerCost;
+        SkIRect fLayerBounds;
+    };
+
+    // The cost of each pixel drawn with paint, beyond the draw's own geometry. Outsets bounds
+    // (in local space) by how far blurs and image filters reach, when they can be computed.
+    static float PaintCost(const SkPaint*, SkRect* bounds, bool* boundsAreKnown);
+    static float ImageCost(const SkPaint*);
+
+    // Adds cost per pixel over the device bounds of localBounds, or of the whole clip if they
+    // can't be known.
+    void addCost(DrawType, const SkRect& localBounds, const SkPaint*, float geometryCost);
+    void addDeviceCost(DrawType, const SkIRect& deviceBounds, float costPerPixel);
+
+    void clipDeviceBounds(const SkRect& localBounds, SkClipOp);
+
+    float* cell(int x, int y) { return &fCells[(y * fCellsX + x) * kDrawTypeCount]; }
+    const float* cell(int x, int y) const { return &fCells[(y * fCellsX + x) * kDrawTypeCount]; }
+    float cellCost(int x, int y) const;
+
+    const int         fCellsX;
+    const int         fCellsY;
+    // kDrawTypeCount costs for each cell, in rows of fCellsX cells.
+    SkTArray<float>   fCells;
+    float             fTotals[kDrawTypeCount];
+    SkTArray<SaveRec> fSaves;
+
+    typedef SkCanvasVirtualEnforcer<SkNoDrawCanvas> INHERITED;
+};
+
+#endif
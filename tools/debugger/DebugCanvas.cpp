@@ -7,13 +7,20 @@
 
 #include "include/core/SkPicture.h"
 #include "include/core/SkTextBlob.h"
+#include "include/core/SkTime.h"
+#include "include/private/SkTHash.h"
 #include "include/utils/SkPaintFilterCanvas.h"
 #include "src/core/SkCanvasPriv.h"
 #include "src/core/SkClipOpPriv.h"
 #include "src/core/SkRectPriv.h"
 #include "src/utils/SkJSONWriter.h"
+#include "tools/debugger/CostHeatmapCanvas.h"
 #include "tools/debugger/DebugCanvas.h"
 #include "tools/debugger/DrawCommand.h"
+#include "tools/gpu/GpuTimer.h"
+
+#include <algorithm>
+#include <vector>
 
 #include "include/gpu/GrContext.h"
 #include "include/private/GrAuditTrail.h"
@@ -53,9 +60,94 @@ private:
     typedef SkPaintFilterCanvas INHERITED;
 };
 
+namespace {
+
+// The features of a paint that usually decide what drawing with it costs.
+enum PaintFeature : uint32_t {
+    kAntiAlias_PaintFeature   = 1 << 0,
+    kStroke_PaintFeature      = 1 << 1,
+    kAlpha_PaintFeature       = 1 << 2,
+    kBlendMode_PaintFeature   = 1 << 3,
+    kShader_PaintFeature      = 1 << 4,
+    kColorFilter_PaintFeature = 1 << 5,
+    kMaskFilter_PaintFeature  = 1 << 6,
+    kPathEffect_PaintFeature  = 1 << 7,
+    kImageFilter_PaintFeature = 1 << 8,
+};
+static constexpr const char* kPaintFeatureNames[] = {
+    "aa", "stroke", "alpha", "blendMode", "shader", "colorFilter", "maskFilter", "pathEffect",
+    "imageFilter",
+};
+
+static SkString paint_features_string(uint32_t features) {
+    SkString str;
+    for (size_t i = 0; i < SK_ARRAY_COUNT(kPaintFeatureNames); ++i) {
+        if (features & (1 << i)) {
+            if (!str.isEmpty()) {
+                str.append(" ");
+            }
+            str.append(kPaintFeatureNames[i]);
+        }
+    }
+    return str;
+}
+
+// Collects the features of the paints drawn with, so command timings can be grouped by them.
+class PaintFeatureCanvas : public SkPaintFilterCanvas {
+public:
+    PaintFeatureCanvas(SkCanvas* canvas) : INHERITED(canvas) {}
+
+    // Returns the features of every paint filtered since the last call.
+    uint32_t takeFeatures() { return skstd::exchange(fFeatures, 0); }
+
+protected:
+    bool onFilter(SkPaint& paint) const override {
+        fFeatures |= (paint.isAntiAlias()                       ? kAntiAlias_PaintFeature   : 0) |
+                     (SkPaint::kFill_Style != paint.getStyle()  ? kStroke_PaintFeature      : 0) |
+                     (0xFF != paint.getAlpha()                  ? kAlpha_PaintFeature       : 0) |
+                     (!paint.isSrcOver()                        ? kBlendMode_PaintFeature   : 0) |
+                     (paint.getShader()                         ? kShader_PaintFeature      : 0) |
+                     (paint.getColorFilter()                    ? kColorFilter_PaintFeature : 0) |
+                     (paint.getMaskFilter()                     ? kMaskFilter_PaintFeature  : 0) |
+                     (paint.getPathEffect()                     ? kPathEffect_PaintFeature  : 0) |
+                     (paint.getImageFilter()                    ? kImageFilter_PaintFeature : 0);
+        return true;
+    }
+
+    void onDrawPicture(const SkPicture* picture,
+                       const SkMatrix*  matrix,
+                       const SkPaint*   paint) override {
+        // Replay the picture onto this canvas, so its commands are seen separately.
+        this->SkCanvas::onDrawPicture(picture, matrix, paint);
+    }
+
+private:
+    mutable uint32_t fFeatures = 0;
+
+    typedef SkPaintFilterCanvas INHERITED;
+};
+
+struct CommandTiming {
+    uint32_t fFeatures = 0;
+    int      fDepth = 0;
+    double   fCpuMs = 0;
+    double   fGpuMs = 0;
+};
+
+struct TimingGroup {
+    DrawCommand::OpType fType;
+    uint32_t            fFeatures;
+    int                 fCount;
+    double              fCpuMs;
+    double              fGpuMs;
+};
+
+}  // namespace
+
 DebugCanvas::DebugCanvas(int width, int height)
         : INHERITED(width, height)
         , fOverdrawViz(false)
+        , fCostHeatmap(false)
         , fClipVizColor(SK_ColorTRANSPARENT)
         , fDrawGpuOpBounds(false) {
     // SkPicturePlayback uses the base-class' quickReject calls to cull clipped
@@ -148,6 +240,15 @@ void DebugCanvas::drawTo(SkCanvas* originalCanvas, int index, int m) {
     fClip   = filterCanvas.getDeviceClipBounds();
     filterCanvas.restoreToCount(saveCount);
 
+    if (fCostHeatmap) {
+        CostHeatmapCanvas heatmap(originalCanvas->getBaseLayerSize().width(),
+                                  originalCanvas->getBaseLayerSize().height());
+        this->drawCostHeatmap(&heatmap, index);
+        SkAutoCanvasRestore acr(originalCanvas, true);
+        originalCanvas->resetMatrix();
+        heatmap.drawHeatmap(originalCanvas);
+    }
+
     // draw any ops if required and issue a full reset onto GrAuditTrail
     if (at) {
         // just in case there is global reordering, we flush the canvas before querying
@@ -198,6 +299,24 @@ void DebugCanvas::drawTo(SkCanvas* originalCanvas, int index, int m) {
     this->cleanupAuditTrail(originalCanvas);
 }
 
+void DebugCanvas::drawCostHeatmap(CostHeatmapCanvas* heatmap, int n) {
+    SkASSERT(n < fCommandVector.count());
+    for (int i = 0; i <= n; i++) {
+        if (fCommandVector[i]->isVisible()) {
+            fCommandVector[i]->execute(heatmap);
+        }
+    }
+}
+
+void DebugCanvas::toJSONCostSummary(SkJSONWriter& writer, int n) {
+    SkISize size = this->getBaseLayerSize();
+    CostHeatmapCanvas heatmap(size.width(), size.height());
+    if (!fCommandVector.isEmpty()) {
+        this->drawCostHeatmap(&heatmap, SkTMin(n, fCommandVector.count() - 1));
+    }
+    heatmap.writeSummary(writer);
+}
+
 void DebugCanvas::deleteDrawCommandAt(int index) {
     SkASSERT(index < fCommandVector.count());
     delete fCommandVector[index];
@@ -284,6 +403,153 @@ void DebugCanvas::toJSONOpList(SkJSONWriter& writer, int n, SkCanvas* canvas) {
     this->cleanupAuditTrail(canvas);
 }
 
+void DebugCanvas::toJSONTimings(SkJSONWriter&          writer,
+                                int                    n,
+                                SkCanvas*              canvas,
+                                int                    repeat,
+                                sk_gpu_test::GpuTimer* gpuTimer) {
+    using sk_gpu_test::GpuTimer;
+    using sk_gpu_test::PlatformTimerQuery;
+
+    n = SkTPin(n, -1, this->getSize() - 1);
+    repeat = SkTMax(repeat, 1);
+    std::vector<CommandTiming> timings(n + 1);
+    std::vector<PlatformTimerQuery> queries(n + 1, sk_gpu_test::kInvalidTimerQuery);
+    int inaccurateGpuTimes = 0;
+
+    for (int r = 0; r < repeat; ++r) {
+        int saveCount = canvas->save();
+        canvas->clear(SK_ColorTRANSPARENT);
+        canvas->resetMatrix();
+        canvas->flush();
+
+        PaintFeatureCanvas featureCanvas(canvas);
+        int depth = 0;
+        for (int i = 0; i <= n; ++i) {
+            const DrawCommand* command = fCommandVector[i];
+            DrawCommand::OpType type = command->getOpType();
+            if (DrawCommand::kRestore_OpType == type ||
+                DrawCommand::kEndDrawPicture_OpType == type) {
+                depth = SkTMax(depth - 1, 0);
+            }
+            timings[i].fDepth = depth;
+            if (DrawCommand::kSave_OpType == type || DrawCommand::kSaveLayer_OpType == type ||
+                DrawCommand::kBeginDrawPicture_OpType == type) {
+                ++depth;
+            }
+            if (!command->isVisible()) {
+                continue;
+            }
+
+            if (gpuTimer) {
+                gpuTimer->queueStart();
+            }
+            double start = SkTime::GetNSecs();
+            command->execute(&featureCanvas);
+            featureCanvas.flush();
+            timings[i].fCpuMs += (SkTime::GetNSecs() - start) * 1e-6;
+            if (gpuTimer) {
+                queries[i] = gpuTimer->queueStop();
+            }
+            timings[i].fFeatures = featureCanvas.takeFeatures();
+        }
+        canvas->restoreToCount(saveCount);
+
+        if (gpuTimer) {
+            // Wait for the GPU, so the queries are done (or lost) rather than pending.
+            if (GrContext* context = canvas->getGrContext()) {
+                GrFlushInfo info;
+                info.fFlags = kSyncCpu_GrFlushFlag;
+                context->flush(info);
+            }
+            for (int i = 0; i <= n; ++i) {
+                if (sk_gpu_test::kInvalidTimerQuery == queries[i]) {
+                    continue;
+                }
+                GpuTimer::QueryStatus status;
+                while (GpuTimer::QueryStatus::kPending ==
+                       (status = gpuTimer->checkQueryStatus(queries[i]))) {
+                }
+                if (GpuTimer::QueryStatus::kAccurate == status) {
+                    std::chrono::nanoseconds ns = gpuTimer->getTimeElapsed(queries[i]);
+                    timings[i].fGpuMs += ns.count() * 1e-6;
+                } else {
+                    ++inaccurateGpuTimes;
+                }
+                gpuTimer->deleteQuery(queries[i]);
+                queries[i] = sk_gpu_test::kInvalidTimerQuery;
+            }
+        }
+    }
+
+    // Sum the commands by type and paint features, most expensive first.
+    SkTHashMap<uint32_t, TimingGroup> groupsByKey;
+    double totalCpuMs = 0,
+           totalGpuMs = 0;
+    for (int i = 0; i <= n; ++i) {
+        CommandTiming& timing = timings[i];
+        timing.fCpuMs /= repeat;
+        timing.fGpuMs /= repeat;
+        totalCpuMs += timing.fCpuMs;
+        totalGpuMs += timing.fGpuMs;
+
+        DrawCommand::OpType type = fCommandVector[i]->getOpType();
+        uint32_t key = timing.fFeatures * DrawCommand::kOpTypeCount + type;
+        TimingGroup* group = groupsByKey.find(key);
+        if (!group) {
+            group = groupsByKey.set(key, {type, timing.fFeatures, 0, 0, 0});
+        }
+        group->fCount++;
+        group->fCpuMs += timing.fCpuMs;
+        group->fGpuMs += timing.fGpuMs;
+    }
+    std::vector<TimingGroup> groups;
+    groupsByKey.foreach([&groups](uint32_t, TimingGroup* group) { groups.push_back(*group); });
+    auto slower = [gpuTimer](const TimingGroup& a, const TimingGroup& b) {
+        return gpuTimer ? a.fGpuMs > b.fGpuMs : a.fCpuMs > b.fCpuMs;
+    };
+    std::sort(groups.begin(), groups.end(), slower);
+
+    writer.beginObject();
+    writer.appendS32("repeat", repeat);
+    writer.appendBool("gpuTimes", gpuTimer != nullptr);
+    writer.appendDouble("totalCpuMs", totalCpuMs);
+    if (gpuTimer) {
+        writer.appendDouble("totalGpuMs", totalGpuMs);
+        writer.appendS32("inaccurateGpuTimes", inaccurateGpuTimes);
+    }
+    writer.beginArray("commands");
+    for (int i = 0; i <= n; ++i) {
+        const CommandTiming& timing = timings[i];
+        writer.beginObject();
+        writer.appendS32("index", i);
+        writer.appendString("command",
+                            DrawCommand::GetCommandString(fCommandVector[i]->getOpType()));
+        writer.appendString("features", paint_features_string(timing.fFeatures).c_str());
+        writer.appendS32("depth", timing.fDepth);
+        writer.appendDouble("cpuMs", timing.fCpuMs);
+        if (gpuTimer) {
+            writer.appendDouble("gpuMs", timing.fGpuMs);
+        }
+        writer.endObject();
+    }
+    writer.endArray();  // commands
+    writer.beginArray("groups");
+    for (const TimingGroup& group : groups) {
+        writer.beginObject();
+        writer.appendString("command", DrawCommand::GetCommandString(group.fType));
+        writer.appendString("features", paint_features_string(group.fFeatures).c_str());
+        writer.appendS32("count", group.fCount);
+        writer.appendDouble("cpuMs", group.fCpuMs);
+        if (gpuTimer) {
+            writer.appendDouble("gpuMs", group.fGpuMs);
+        }
+        writer.endObject();
+    }
+    writer.endArray();  // groups
+    writer.endObject();
+}
+
 void DebugCanvas::setOverdrawViz(bool overdrawViz) { fOverdrawViz = overdrawViz; }
 
 void DebugCanvas::onClipPath(const SkPath& path, SkClipOp op, ClipEdgeStyle edgeStyle) {
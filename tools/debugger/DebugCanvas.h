@@ -18,10 +18,15 @@
 #include "tools/UrlDataManager.h"
 #include "tools/debugger/DrawCommand.h"
 
+class CostHeatmapCanvas;
 class GrAuditTrail;
 class SkNWayCanvas;
 class SkPicture;
 
+namespace sk_gpu_test {
+class GpuTimer;
+}
+
 class DebugCanvas : public SkCanvasVirtualEnforcer<SkCanvas> {
 public:
     DebugCanvas(int width, int height);
@@ -37,6 +42,13 @@ public:
 
     bool getOverdrawViz() const { return fOverdrawViz; }
 
+    /**
+     * Enable or disable drawing a heatmap of each pixel's estimated cost over the commands.
+     */
+    void setCostHeatmap(bool costHeatmap) { fCostHeatmap = costHeatmap; }
+
+    bool getCostHeatmap() const { return fCostHeatmap; }
+
     /**
      * Set the color of the clip visualization. An alpha of zero renders the clip invisible.
      */
@@ -102,6 +114,21 @@ public:
 
     void toJSONOpList(SkJSONWriter& writer, int n, SkCanvas*);
 
+    /**
+        Writes a summary of the estimated cost of the commands up to n, in total, by kind of draw,
+        and for the costliest regions of the canvas.
+     */
+    void toJSONCostSummary(SkJSONWriter& writer, int n);
+
+    /**
+        Draws the commands up to the Nth to the canvas repeat times, flushing after each one, and
+        writes a JSON object with the average time each took: per command (with its save depth,
+        for a flame-style view), and summed by command type and paint features. If gpuTimer is
+        given, it must time the canvas' context, and the GPU time of each command is also written.
+     */
+    void toJSONTimings(SkJSONWriter& writer, int n, SkCanvas*, int repeat,
+                       sk_gpu_test::GpuTimer* gpuTimer);
+
     void detachCommands(SkTDArray<DrawCommand*>* dst) { fCommandVector.swap(*dst); }
 
 protected:
@@ -204,6 +231,7 @@ private:
     SkIRect                 fClip;
 
     bool    fOverdrawViz;
+    bool    fCostHeatmap;
     SkColor fClipVizColor;
     bool    fDrawGpuOpBounds;
 
@@ -216,6 +244,9 @@ private:
     GrAuditTrail* getAuditTrail(SkCanvas*);
 
     void drawAndCollectOps(int n, SkCanvas*);
+
+    // Plays the commands up to n into heatmap.
+    void drawCostHeatmap(CostHeatmapCanvas* heatmap, int n);
     void cleanupAuditTrail(SkCanvas*);
 
     typedef SkCanvasVirtualEnforcer<SkCanvas> INHERITED;
@@ -80,6 +80,8 @@ public:
 
     void setVisible(bool toggle) { fVisible = toggle; }
 
+    OpType getOpType() const { return fOpType; }
+
     virtual void execute(SkCanvas*) const = 0;
 
     virtual bool render(SkCanvas* canvas) const { return false; }
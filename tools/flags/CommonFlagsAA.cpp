@@ -9,8 +9,12 @@ static DEFINE_bool(forceAnalyticAA, false,
             "Force analytic anti-aliasing even if the path is complicated: "
             "whether it's concave or convex, we consider a path complicated"
             "if its number of points is comparable to its resolution.");
+static DEFINE_bool(accumulationAA, false,
+            "Fill anti-aliased paths by accumulating exact pixel coverage instead of "
+            "choosing between analytic and supersampled anti-aliasing.");
 
 void SetAnalyticAAFromCommonFlags() {
     gSkUseAnalyticAA   = FLAGS_analyticAA;
     gSkForceAnalyticAA = FLAGS_forceAnalyticAA;
+    gSkUseAccumulationAA = FLAGS_accumulationAA;
 }
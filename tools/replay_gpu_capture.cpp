@@ -0,0 +1,80 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkData.h"
+#include "include/core/SkString.h"
+#include "src/gpu/GrContextPriv.h"
+#include "src/gpu/GrGpuCapture.h"
+#include "tools/flags/CommandLineFlags.h"
+#include "tools/flags/CommonFlags.h"
+#include "tools/flags/CommonFlagsConfig.h"
+#include "tools/gpu/GrContextFactory.h"
+
+/**
+ * Replays a GrGpuCapture (e.g. one written by skpbench --gpuCapture) against a single GPU config,
+ * and prints what each kind of command cost live and on replay. Draws are listed with the live
+ * cost only, along with the programs they used.
+ */
+
+static DEFINE_string2(input, i, "", "GrGpuCapture JSON file to replay");
+static DEFINE_int(loops, 1, "number of times to replay the capture");
+static DEFINE_bool(programs, false, "also list the programs the captured draws used");
+
+int main(int argc, char** argv) {
+    CommandLineFlags::SetUsage("Replays a GrGpuCapture against a GPU config");
+    CommandLineFlags::Parse(argc, argv);
+
+    if (FLAGS_input.count() != 1) {
+        SkDebugf("Missing input file\n");
+        return 1;
+    }
+    sk_sp<SkData> data = SkData::MakeFromFileName(FLAGS_input[0]);
+    if (!data) {
+        SkDebugf("Couldn't read %s\n", FLAGS_input[0]);
+        return 1;
+    }
+    GrGpuCapture capture;
+    if (!capture.deserialize(data->data(), data->size())) {
+        SkDebugf("%s isn't a GrGpuCapture\n", FLAGS_input[0]);
+        return 1;
+    }
+
+    const SkCommandLineConfigGpu* config = nullptr;
+    SkCommandLineConfigArray configs;
+    ParseConfigs(FLAGS_config, &configs);
+    if (configs.count() != 1 || !(config = configs[0]->asConfigGpu())) {
+        SkDebugf("Must specify one (and only one) GPU config\n");
+        return 1;
+    }
+    GrContextOptions ctxOptions;
+    SetCtxOptionsFromCommonFlags(&ctxOptions);
+    sk_gpu_test::GrContextFactory factory(ctxOptions);
+    GrContext* context =
+            factory.getContextInfo(config->getContextType(), config->getContextOverrides())
+                    .grContext();
+    if (!context) {
+        SkDebugf("Couldn't create a context for %s\n", config->getTag().c_str());
+        return 1;
+    }
+
+    GrGpuCapture::ReplayResult result;
+    for (int i = 0; i < FLAGS_loops; ++i) {
+        capture.replay(context, &result);
+    }
+
+    SkString out;
+    result.dump(&out);
+    if (FLAGS_programs) {
+        out.appendf("\n%-10s %10s %8s %s\n", "key_hash", "key_bytes", "draws", "primproc");
+        for (const GrGpuCapture::Program& program : capture.programs()) {
+            out.appendf("0x%08x %10d %8d %s\n", program.fKeyHash, program.fKeyLength,
+                        program.fDrawCount, program.fPrimitiveProcessor.c_str());
+        }
+    }
+    printf("%s", out.c_str());
+    return 0;
+}
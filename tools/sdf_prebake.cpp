@@ -0,0 +1,138 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+// Precomputes the distance field glyph images GrContext would generate for a font and a set of
+// characters, and writes them to a directory as the entries of a
+// GrContextOptions::fDistanceFieldGlyphCache.
+//
+// Each entry is written to <out>/<md5 of key>.sdfg as the key's size (a uint32_t), the key, and
+// then the image. An app can ship the directory and serve load() by reading the file named after
+// the key, checking that the key stored in it matches.
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkData.h"
+#include "include/core/SkFont.h"
+#include "include/core/SkStream.h"
+#include "include/core/SkSurface.h"
+#include "include/core/SkTypeface.h"
+#include "include/gpu/GrContext.h"
+#include "include/gpu/GrContextOptions.h"
+#include "src/core/SkMD5.h"
+#include "src/core/SkOSFile.h"
+#include "src/utils/SkOSPath.h"
+#include "src/utils/SkUTF.h"
+#include "tools/flags/CommandLineFlags.h"
+#include "tools/gpu/GrContextFactory.h"
+
+static DEFINE_string2(font, f, "", "Font file to prebake glyphs for.");
+static DEFINE_string2(chars, c,
+                      " !\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_`"
+                      "abcdefghijklmnopqrstuvwxyz{|}~",
+                      "UTF-8 characters to prebake.");
+static DEFINE_string2(out, o, "sdf-cache", "Directory to write the cache entries to.");
+
+namespace {
+
+class DirectoryCache : public GrContextOptions::PersistentCache {
+public:
+    explicit DirectoryCache(const char* dir) : fDir(dir) {}
+
+    sk_sp<SkData> load(const SkData&) override { return nullptr; }
+
+    void store(const SkData& key, const SkData& data) override {
+        SkMD5 md5;
+        md5.write(key.data(), key.size());
+        SkMD5::Digest digest = md5.finish();
+        SkString name;
+        for (uint8_t byte : digest.data) {
+            name.appendf("%02x", byte);
+        }
+        name.append(".sdfg");
+
+        SkFILEWStream file(SkOSPath::Join(fDir.c_str(), name.c_str()).c_str());
+        if (!file.isValid()) {
+            SkDebugf("Could not write %s\n", name.c_str());
+            return;
+        }
+        file.write32(SkToU32(key.size()));
+        file.write(key.data(), key.size());
+        file.write(data.data(), data.size());
+        ++fCount;
+    }
+
+    int count() const { return fCount; }
+
+private:
+    SkString fDir;
+    int      fCount = 0;
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    CommandLineFlags::SetUsage("Prebakes distance field glyphs: sdf_prebake -f font.ttf -o dir");
+    CommandLineFlags::Parse(argc, argv);
+
+    sk_sp<SkTypeface> typeface = SkTypeface::MakeFromFile(FLAGS_font[0]);
+    if (!typeface) {
+        SkDebugf("Could not load font '%s'.\n", FLAGS_font[0]);
+        return 1;
+    }
+    if (!sk_mkdir(FLAGS_out[0])) {
+        SkDebugf("Could not make directory '%s'.\n", FLAGS_out[0]);
+        return 1;
+    }
+
+    DirectoryCache cache(FLAGS_out[0]);
+    GrContextOptions options;
+    options.fDistanceFieldGlyphCache = &cache;
+    sk_gpu_test::GrContextFactory factory(options);
+    GrContext* context = factory.get(sk_gpu_test::GrContextFactory::kGL_ContextType);
+    if (!context) {
+        context = factory.get(sk_gpu_test::GrContextFactory::kGLES_ContextType);
+    }
+    if (!context) {
+        SkDebugf("Could not make a GL context.\n");
+        return 1;
+    }
+
+    // Every distance field is generated at one of three sizes, so drawing the characters once at a
+    // size in each range makes all of them.
+    const SkScalar kSizes[] = { 24, 60, 120 };
+    SkImageInfo info = SkImageInfo::MakeN32Premul(256, 256);
+    SkSurfaceProps props(SkSurfaceProps::kUseDeviceIndependentFonts_Flag,
+                         SkSurfaceProps::kLegacyFontHost_InitType);
+    sk_sp<SkSurface> surface = SkSurface::MakeRenderTarget(context, SkBudgeted::kNo, info, 0,
+                                                           &props);
+    if (!surface) {
+        SkDebugf("Could not make a surface.\n");
+        return 1;
+    }
+    SkCanvas* canvas = surface->getCanvas();
+    SkPaint paint;
+    paint.setAntiAlias(true);
+
+    const char* chars = FLAGS_chars[0];
+    const char* end = chars + strlen(chars);
+    for (SkScalar size : kSizes) {
+        SkFont font(typeface, size);
+        for (const char* ptr = chars; ptr < end;) {
+            const char* start = ptr;
+            if (SkUTF::NextUTF8(&ptr, end) < 0) {
+                SkDebugf("Invalid UTF-8 in --chars.\n");
+                return 1;
+            }
+            // Glyphs are only rasterized when their draw is flushed, so flush each one before it
+            // can be overdrawn.
+            canvas->drawSimpleText(start, ptr - start, SkTextEncoding::kUTF8, 0, size, font, paint);
+            surface->flush();
+        }
+    }
+
+    SkDebugf("Wrote %d glyphs to %s.\n", cache.count(), FLAGS_out[0]);
+    return 0;
+}
@@ -10,6 +10,7 @@
 #include "include/core/SkPictureRecorder.h"
 #include "src/utils/SkJSONWriter.h"
 #include "tools/ToolUtils.h"
+#include "tools/gpu/TestContext.h"
 
 using namespace sk_gpu_test;
 
@@ -17,6 +18,8 @@ static int kDefaultWidth = 1920;
 static int kDefaultHeight = 1080;
 static int kMaxWidth = 8192;
 static int kMaxHeight = 8192;
+// Each op is drawn this many times when timing them.
+static int kTimingRepeat = 10;
 
 
 Request::Request(SkString rootUrl)
@@ -98,6 +101,20 @@ GrContext* Request::getContext() {
     return result;
 }
 
+GpuTimer* Request::getGpuTimer() {
+    if (!fGPUEnabled) {
+        return nullptr;
+    }
+    ContextInfo info = fContextFactory->getContextInfo(GrContextFactory::kGL_ContextType,
+                                                       GrContextFactory::ContextOverrides::kNone);
+    if (!info.grContext()) {
+        info = fContextFactory->getContextInfo(GrContextFactory::kGLES_ContextType,
+                                               GrContextFactory::ContextOverrides::kNone);
+    }
+    TestContext* testContext = info.testContext();
+    return testContext && testContext->gpuTimingSupport() ? testContext->gpuTimer() : nullptr;
+}
+
 SkIRect Request::getBounds() {
     SkIRect bounds;
     if (fPicture) {
@@ -268,6 +285,27 @@ sk_sp<SkData> Request::getJsonInfo(int n) {
     return stream.detachAsData();
 }
 
+sk_sp<SkData> Request::getJsonTimings(int n) {
+    SkCanvas* canvas = this->getCanvas();
+    SkDynamicMemoryWStream stream;
+    SkJSONWriter writer(&stream, SkJSONWriter::Mode::kFast);
+
+    fDebugCanvas->toJSONTimings(writer, n, canvas, kTimingRepeat, this->getGpuTimer());
+
+    writer.flush();
+    return stream.detachAsData();
+}
+
+sk_sp<SkData> Request::getJsonCost(int n) {
+    SkDynamicMemoryWStream stream;
+    SkJSONWriter writer(&stream, SkJSONWriter::Mode::kFast);
+
+    fDebugCanvas->toJSONCostSummary(writer, n);
+
+    writer.flush();
+    return stream.detachAsData();
+}
+
 SkColor Request::getPixel(int x, int y) {
     SkBitmap bmp;
     bmp.allocPixels(this->getCanvas()->imageInfo().makeWH(1, 1));
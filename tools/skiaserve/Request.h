@@ -56,6 +56,12 @@ struct Request {
     // Returns json with the viewMatrix and clipRect
     sk_sp<SkData> getJsonInfo(int n);
 
+    // Returns json with the time each op up to N takes to draw, on the GPU too if it is enabled
+    sk_sp<SkData> getJsonTimings(int n);
+
+    // Returns json with the estimated cost of the ops up to N, in total and by region
+    sk_sp<SkData> getJsonCost(int n);
+
     // returns the color of the pixel at (x,y) in the canvas
     SkColor getPixel(int x, int y);
 
@@ -69,6 +75,7 @@ private:
     SkSurface* createGPUSurface();
     SkIRect getBounds();
     GrContext* getContext();
+    sk_gpu_test::GpuTimer* getGpuTimer();
 
     sk_sp<SkPicture> fPicture;
     sk_gpu_test::GrContextFactory* fContextFactory;
@@ -44,6 +44,8 @@ public:
         fHandlers.push_back(new BreakHandler);
         fHandlers.push_back(new OpsHandler);
         fHandlers.push_back(new OpBoundsHandler);
+        fHandlers.push_back(new TimingsHandler);
+        fHandlers.push_back(new CostHandler);
         fHandlers.push_back(new ColorModeHandler);
         fHandlers.push_back(new QuitHandler);
     }
@@ -0,0 +1,45 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "tools/skiaserve/urlhandlers/UrlHandler.h"
+
+#include "tools/skiaserve/Request.h"
+#include "tools/skiaserve/Response.h"
+#include "microhttpd.h"
+
+using namespace Response;
+
+bool TimingsHandler::canHandle(const char* method, const char* url) {
+    const char* kBasePath = "/timings";
+    return 0 == strncmp(url, kBasePath, strlen(kBasePath));
+}
+
+int TimingsHandler::handle(Request* request, MHD_Connection* connection,
+                           const char* url, const char* method,
+                           const char* upload_data, size_t* upload_data_size) {
+    SkTArray<SkString> commands;
+    SkStrSplit(url, "/", &commands);
+
+    if (!request->hasPicture() || commands.count() > 2) {
+        return MHD_NO;
+    }
+
+    // /timings or /timings/N
+    if (0 == strcmp(method, MHD_HTTP_METHOD_GET)) {
+        int n;
+        if (commands.count() == 1) {
+            n = request->getLastOp();
+        } else {
+            sscanf(commands[1].c_str(), "%d", &n);
+        }
+
+        sk_sp<SkData> data(request->getJsonTimings(n));
+        return SendData(connection, data.get(), "application/json");
+    }
+
+    return MHD_NO;
+}
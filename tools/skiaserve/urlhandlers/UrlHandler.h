@@ -135,6 +135,31 @@ public:
                const char* upload_data, size_t* upload_data_size) override;
 };
 
+/*
+ * Returns a json description of how long each op takes to draw, alone and grouped by type and
+ * paint features. /timings/N times the ops up to N.
+ */
+class TimingsHandler : public UrlHandler {
+public:
+    bool canHandle(const char* method, const char* url) override;
+    int handle(Request* request, MHD_Connection* connection,
+               const char* url, const char* method,
+               const char* upload_data, size_t* upload_data_size) override;
+};
+
+/*
+ * Returns a json summary of the estimated cost of the ops up to N, in total, by type of draw and
+ * for the costliest regions of the canvas, with GET /cost/N. Posting to /cost/1 draws a heatmap
+ * of that cost over the ops, /cost/0 stops drawing it.
+ */
+class CostHandler : public UrlHandler {
+public:
+    bool canHandle(const char* method, const char* url) override;
+    int handle(Request* request, MHD_Connection* connection,
+               const char* url, const char* method,
+               const char* upload_data, size_t* upload_data_size) override;
+};
+
 class RootHandler : public UrlHandler {
 public:
     bool canHandle(const char* method, const char* url) override;
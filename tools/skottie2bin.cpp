@@ -0,0 +1,51 @@
+/*
+ * Copyright 2019 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+// Converts a Lottie JSON file to the binary skjson DOM form, which skottie loads without parsing.
+// The output is tied to the skjson binary version (and host endianness), so it should be
+// regenerated with the runtime it ships with.
+
+#include "include/core/SkData.h"
+#include "include/core/SkStream.h"
+#include "modules/skottie/include/Skottie.h"
+#include "src/utils/SkJSON.h"
+#include "tools/flags/CommandLineFlags.h"
+
+static DEFINE_string2(input, i, "", "skottie animation to convert");
+static DEFINE_string2(output, o, "", "binary file to create");
+
+int main(int argc, char** argv) {
+    CommandLineFlags::SetUsage("Converts skottie JSON to binary: skottie2bin -i in.json -o out");
+    CommandLineFlags::Parse(argc, argv);
+
+    if (FLAGS_input.isEmpty() || FLAGS_output.isEmpty()) {
+        SkDebugf("Need -i input_file.json -o output_file\n");
+        return 1;
+    }
+
+    auto data = SkData::MakeFromFileName(FLAGS_input[0]);
+    if (!data) {
+        SkDebugf("Couldn't read %s\n", FLAGS_input[0]);
+        return 1;
+    }
+
+    const auto* json = static_cast<const char*>(data->data());
+    if (!skottie::Animation::Make(json, data->size())) {
+        SkDebugf("%s is not a valid skottie animation\n", FLAGS_input[0]);
+        return 1;
+    }
+
+    SkFILEWStream ostream(FLAGS_output[0]);
+    if (!ostream.isValid()) {
+        SkDebugf("Can't create output file %s\n", FLAGS_output[0]);
+        return 1;
+    }
+    skjson::DOM(json, data->size()).writeBinary(&ostream);
+
+    SkDebugf("Wrote %zu bytes to %s\n", ostream.bytesWritten(), FLAGS_output[0]);
+    return 0;
+}
@@ -6,16 +6,91 @@
  */
 
 #include "modules/skottie/include/Skottie.h"
+#include "modules/skottie/utils/SkottieUtils.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkTime.h"
+#include "src/core/SkTaskGroup.h"
+#include "src/utils/SkOSPath.h"
 #include "experimental/ffmpeg/SkVideoEncoder.h"
 #include "tools/flags/CommandLineFlags.h"
 
+#include <algorithm>
+#include <vector>
+
 static DEFINE_string2(input, i, "", "skottie animation to render");
 static DEFINE_string2(output, o, "", "mp4 file to create");
 static DEFINE_int_2(fps, f, 25, "fps");
 static DEFINE_bool2(verbose, v, false, "verbose mode");
 static DEFINE_bool2(forever, f, false, "forever mode for profiling");
+static DEFINE_int_2(threads, t, 1, "number of threads rendering frames");
+
+namespace {
+
+// Renders frames on |animations.size()| threads, one animation clone per thread, while the
+// calling thread encodes the previous batch.
+class FrameRenderer {
+public:
+    FrameRenderer(std::vector<sk_sp<skottie::Animation>> animations, const SkImageInfo& info)
+        : fAnimations(std::move(animations))
+        , fExecutor(SkExecutor::MakeFIFOThreadPool(SkToInt(fAnimations.size()))) {
+        for (auto& batch : fBatches) {
+            batch.resize(fAnimations.size());
+            for (auto& bm : batch) {
+                bm.allocPixels(info);
+            }
+        }
+    }
+
+    // Renders frames [0...frames] to |encoder|.
+    bool render(SkVideoEncoder* encoder, int frames) {
+        const int batch_size = SkToInt(fAnimations.size());
+        SkTaskGroup group(*fExecutor);
+
+        this->renderBatch(&group, 0, 0, frames);
+        group.wait();
+        for (int start = 0, b = 0; start <= frames; start += batch_size, b ^= 1) {
+            // Render the next batch while this one is encoded.
+            this->renderBatch(&group, b ^ 1, start + batch_size, frames);
+
+            const int count = std::min(batch_size, frames + 1 - start);
+            for (int i = 0; i < count; ++i) {
+                if (FLAGS_verbose) {
+                    SkDebugf("encoding frame %d ts %g\n", start + i, (start + i) * 1.0 / FLAGS_fps);
+                }
+                if (!encoder->addFrame(fBatches[b][i].pixmap())) {
+                    group.wait();
+                    return false;
+                }
+            }
+            group.wait();
+        }
+        return true;
+    }
+
+private:
+    void renderBatch(SkTaskGroup* group, int b, int start, int frames) {
+        const int count = std::min(SkToInt(fAnimations.size()), frames + 1 - start);
+        if (count <= 0) {
+            return;
+        }
+        group->batch(count, [this, b, start, frames](int i) {
+            SkCanvas canvas(fBatches[b][i]);
+            canvas.clear(0);
+            fAnimations[i]->seek((start + i) * 1.0 / frames);  // normalized time
+            fAnimations[i]->render(&canvas);
+        });
+    }
+
+    const std::vector<sk_sp<skottie::Animation>> fAnimations;
+    std::unique_ptr<SkExecutor>                  fExecutor;
+    std::vector<SkBitmap>                        fBatches[2];
+};
+
+} // namespace
 
 int main(int argc, char** argv) {
     CommandLineFlags::SetUsage("Converts skottie to a mp4");
@@ -25,15 +100,30 @@ int main(int argc, char** argv) {
         SkDebugf("Need -i input_file.json\n");
         return -1;
     }
-    SkFILEStream stream(FLAGS_input[0]);
-    if (!stream.isValid()) {
+    auto data = SkData::MakeFromFileName(FLAGS_input[0]);
+    if (!data) {
         SkDebugf("Couldn't open skottie %s\n", FLAGS_input[0]);
         return -1;
     }
 
-    auto animation = skottie::Animation::Builder().make(&stream);
-    SkISize dim = animation->size().toRound();
-    double duration = animation->duration();
+    // The clones share the input and the resources loaded for it (images, fonts).
+    auto rp = skottie_utils::SharedResourceProvider::Make(
+            skottie_utils::FileResourceProvider::Make(SkOSPath::Dirname(FLAGS_input[0])));
+    const int threads = std::max(1, FLAGS_threads);
+    std::vector<sk_sp<skottie::Animation>> animations;
+    for (int i = 0; i < threads; ++i) {
+        auto animation = skottie::Animation::Builder()
+                .setResourceProvider(rp)
+                .make(static_cast<const char*>(data->data()), data->size());
+        if (!animation) {
+            SkDebugf("Couldn't load skottie %s\n", FLAGS_input[0]);
+            return -1;
+        }
+        animations.push_back(std::move(animation));
+    }
+
+    SkISize dim = animations[0]->size().toRound();
+    double duration = animations[0]->duration();
     int fps = FLAGS_fps;
     if (fps < 1) {
         fps = 1;
@@ -42,41 +132,36 @@ int main(int argc, char** argv) {
     }
 
     if (FLAGS_verbose) {
-        SkDebugf("size %dx%d duration %g\n", dim.width(), dim.height(), duration, fps);
+        SkDebugf("size %dx%d duration %g fps %d threads %d\n",
+                 dim.width(), dim.height(), duration, fps, threads);
     }
 
     SkVideoEncoder encoder;
+    if (!encoder.beginRecording(dim, fps)) {
+        SkDebugf("Couldn't start recording %dx%d\n", dim.width(), dim.height());
+        return -1;
+    }
+    FrameRenderer renderer(std::move(animations), encoder.frameInfo());
     const int frames = SkScalarRoundToInt(duration * fps);
 
     while (FLAGS_forever) {
         double now = SkTime::GetSecs();
-        encoder.beginRecording(dim, fps);
-        for (int i = 0; i <= frames; ++i) {
-            animation->seek(i * 1.0 / frames);  // normalized time
-            animation->render(encoder.beginFrame());
-            encoder.endFrame();
-        }
+        (void)renderer.render(&encoder, frames);
         (void)encoder.endRecording();
         SkDebugf("time in ms: %d\n", (int)((SkTime::GetSecs() - now) * 1000));
+        encoder.beginRecording(dim, fps);
     }
 
-    encoder.beginRecording(dim, fps);
-
-    for (int i = 0; i <= frames; ++i) {
-        double ts = i * 1.0 / fps;
-        if (FLAGS_verbose) {
-            SkDebugf("rendering frame %d ts %g\n", i, ts);
-        }
-        animation->seek(i * 1.0 / frames);  // normalized time
-        animation->render(encoder.beginFrame());
-        encoder.endFrame();
+    if (!renderer.render(&encoder, frames)) {
+        SkDebugf("Encoding failed\n");
+        return -1;
     }
 
-    auto data = encoder.endRecording();
+    auto movie = encoder.endRecording();
     SkFILEWStream ostream(FLAGS_output[0]);
     if (!ostream.isValid()) {
         SkDebugf("Can't create output file %s\n", FLAGS_output[0]);
         return -1;
     }
-    ostream.write(data->data(), data->size());
+    ostream.write(movie->data(), movie->size());
 }
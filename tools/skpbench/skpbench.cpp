@@ -14,10 +14,13 @@
 #include "include/core/SkSurfaceProps.h"
 #include "include/effects/SkPerlinNoiseShader.h"
 #include "include/private/SkDeferredDisplayList.h"
+#include "src/core/SkMD5.h"
 #include "src/core/SkOSFile.h"
 #include "src/core/SkTaskGroup.h"
 #include "src/gpu/GrCaps.h"
 #include "src/gpu/GrContextPriv.h"
+#include "src/gpu/GrGpu.h"
+#include "src/gpu/GrGpuCapture.h"
 #include "src/gpu/SkGr.h"
 #include "src/utils/SkOSPath.h"
 #include "tools/DDLPromiseImageHelper.h"
@@ -28,6 +31,7 @@
 #include "tools/flags/CommonFlagsConfig.h"
 #include "tools/gpu/GpuTimer.h"
 #include "tools/gpu/GrContextFactory.h"
+#include "tools/gpu/MemoryCache.h"
 
 #ifdef SK_XML
 #include "experimental/svg/model/SkSVGDOM.h"
@@ -66,8 +70,17 @@ static DEFINE_bool(fps, false, "use fps instead of ms");
 static DEFINE_string(src, "",
                      "path to a single .skp or .svg file, or 'warmup' for a builtin warmup run");
 static DEFINE_string(png, "", "if set, save a .png proof to disk at this file location");
+static DEFINE_string(writeShaderCache, "",
+                     "if set, save every program key/data pair the skp stores in the context's "
+                     "PersistentCache to this directory, for use with GrContext::precompileShader");
 static DEFINE_int(verbosity, 4, "level of verbosity (0=none to 5=debug)");
 static DEFINE_bool(suppressHeader, false, "don't print a header row before the results");
+static DEFINE_string(gpuCapture, "",
+                     "if set, save the GrGpu commands of the first frame to this file, for use "
+                     "with replay_gpu_capture. The frame is drawn before the benchmark starts.");
+static DEFINE_bool(frameStats, false,
+                   "after the results, also print per-frame percentiles, the first frame's time, "
+                   "and how many frames compiled programs");
 
 static const char* header =
 "   accum    median       max       min   stddev  samples  sample_ms  clock  metric  config    bench";
@@ -90,6 +103,22 @@ struct Sample {
     duration   fDuration;
 };
 
+// Per-frame timings, gathered alongside the samples when --frameStats is set. The samples average
+// away the occasional slow frame, and skip the first frames entirely; these keep both.
+struct FrameStats {
+    using duration = std::chrono::nanoseconds;
+
+    // The first frame's time: record and flush on the cpu clock, or its gpu work on the gpu clock.
+    duration               fFirstFrame = duration(0);
+    // Every timed frame after the cache was primed, in the order they were drawn.
+    std::vector<duration>  fFrames;
+    // Frames, including the first and priming ones, whose flush built programs. Negative if the
+    // build doesn't keep GPU stats.
+    int                    fCompiledFrames = 0;
+    int                    fSteadyCompiledFrames = 0;
+    int                    fTotalFrames = 0;
+};
+
 class GpuSync {
 public:
     GpuSync(const sk_gpu_test::FenceSync* fenceSync);
@@ -114,9 +143,12 @@ enum class ExitErr {
 };
 
 static void draw_skp_and_flush(SkSurface*, const SkPicture*);
+static void draw_frame(SkSurface*, const SkPicture*, FrameStats*, bool steady);
 static sk_sp<SkPicture> create_warmup_skp();
 static sk_sp<SkPicture> create_skp_from_svg(SkStream*, const char* filename);
 static bool mkdir_p(const SkString& name);
+static void write_shader_cache(const char* dir, sk_gpu_test::MemoryCache*);
+static void write_gpu_capture(const char* path, SkSurface*, const SkPicture*);
 static SkString         join(const CommandLineFlags::StringArray&);
 static void exitf(ExitErr, const char* format, ...);
 
@@ -195,16 +227,21 @@ static void run_ddl_benchmark(const sk_gpu_test::FenceSync* fenceSync,
 }
 
 static void run_benchmark(const sk_gpu_test::FenceSync* fenceSync, SkSurface* surface,
-                          const SkPicture* skp, std::vector<Sample>* samples) {
+                          const SkPicture* skp, std::vector<Sample>* samples,
+                          FrameStats* frameStats) {
     using clock = std::chrono::high_resolution_clock;
     const Sample::duration sampleDuration = std::chrono::milliseconds(FLAGS_sampleMs);
     const clock::duration benchDuration = std::chrono::milliseconds(FLAGS_duration);
 
-    draw_skp_and_flush(surface, skp); // draw 1
+    clock::time_point firstStart = clock::now();
+    draw_frame(surface, skp, frameStats, false); // draw 1
+    if (frameStats) {
+        frameStats->fFirstFrame = clock::now() - firstStart;
+    }
     GpuSync gpuSync(fenceSync);
 
     for (int i = 1; i < kNumFlushesToPrimeCache; ++i) {
-        draw_skp_and_flush(surface, skp); // draw N
+        draw_frame(surface, skp, frameStats, false); // draw N
         // Waits for draw N-1 to finish (after draw N's cpu work is done).
         gpuSync.syncToPreviousFrame();
     }
@@ -218,19 +255,24 @@ static void run_benchmark(const sk_gpu_test::FenceSync* fenceSync, SkSurface* su
         Sample& sample = samples->back();
 
         do {
-            draw_skp_and_flush(surface, skp);
+            clock::time_point frameStart = now;
+            draw_frame(surface, skp, frameStats, true);
             gpuSync.syncToPreviousFrame();
 
             now = clock::now();
             sample.fDuration = now - sampleStart;
             ++sample.fFrames;
+            if (frameStats) {
+                frameStats->fFrames.push_back(now - frameStart);
+            }
         } while (sample.fDuration < sampleDuration);
     } while (now < endTime || 0 == samples->size() % 2);
 }
 
 static void run_gpu_time_benchmark(sk_gpu_test::GpuTimer* gpuTimer,
                                    const sk_gpu_test::FenceSync* fenceSync, SkSurface* surface,
-                                   const SkPicture* skp, std::vector<Sample>* samples) {
+                                   const SkPicture* skp, std::vector<Sample>* samples,
+                                   FrameStats* frameStats) {
     using sk_gpu_test::PlatformTimerQuery;
     using clock = std::chrono::steady_clock;
     const clock::duration sampleDuration = std::chrono::milliseconds(FLAGS_sampleMs);
@@ -241,17 +283,26 @@ static void run_gpu_time_benchmark(sk_gpu_test::GpuTimer* gpuTimer,
                         "results may be unreliable\n");
     }
 
-    draw_skp_and_flush(surface, skp);
+    gpuTimer->queueStart();
+    draw_frame(surface, skp, frameStats, false);
+    PlatformTimerQuery firstTime = gpuTimer->queueStop();
     GpuSync gpuSync(fenceSync);
 
     PlatformTimerQuery previousTime = 0;
     for (int i = 1; i < kNumFlushesToPrimeCache; ++i) {
         gpuTimer->queueStart();
-        draw_skp_and_flush(surface, skp);
+        draw_frame(surface, skp, frameStats, false);
         previousTime = gpuTimer->queueStop();
         gpuSync.syncToPreviousFrame();
     }
 
+    // The priming syncs have waited for the first frame, so its query is ready (or lost).
+    if (frameStats &&
+        sk_gpu_test::GpuTimer::QueryStatus::kAccurate == gpuTimer->checkQueryStatus(firstTime)) {
+        frameStats->fFirstFrame = gpuTimer->getTimeElapsed(firstTime);
+    }
+    gpuTimer->deleteQuery(firstTime);
+
     clock::time_point now = clock::now();
     const clock::time_point endTime = now + benchDuration;
 
@@ -262,7 +313,7 @@ static void run_gpu_time_benchmark(sk_gpu_test::GpuTimer* gpuTimer,
 
         do {
             gpuTimer->queueStart();
-            draw_skp_and_flush(surface, skp);
+            draw_frame(surface, skp, frameStats, true);
             PlatformTimerQuery time = gpuTimer->queueStop();
             gpuSync.syncToPreviousFrame();
 
@@ -277,10 +328,15 @@ static void run_gpu_time_benchmark(sk_gpu_test::GpuTimer* gpuTimer,
                         fprintf(stderr, "discarding timer query due to disjoint operations.\n");
                     }
                     break;
-                case QueryStatus::kAccurate:
-                    sample.fDuration += gpuTimer->getTimeElapsed(previousTime);
+                case QueryStatus::kAccurate: {
+                    Sample::duration elapsed = gpuTimer->getTimeElapsed(previousTime);
+                    sample.fDuration += elapsed;
                     ++sample.fFrames;
+                    if (frameStats) {
+                        frameStats->fFrames.push_back(elapsed);
+                    }
                     break;
+                }
             }
             gpuTimer->deleteQuery(previousTime);
             previousTime = time;
@@ -323,6 +379,42 @@ void print_result(const std::vector<Sample>& samples, const char* config, const
     fflush(stdout);
 }
 
+// Prints one line of frame stats after the result. It doesn't match the result format, so
+// skpbench.py passes it through rather than parsing it.
+void print_frame_stats(const FrameStats& stats, const char* config, const char* bench) {
+    if (stats.fFrames.empty()) {
+        exitf(ExitErr::kSoftware, "attempted to gather frame stats without any frames");
+    }
+
+    std::vector<double> ms;
+    ms.reserve(stats.fFrames.size());
+    for (FrameStats::duration frame : stats.fFrames) {
+        ms.push_back(std::chrono::duration<double, std::milli>(frame).count());
+    }
+    std::sort(ms.begin(), ms.end());
+    // Nearest rank, so each percentile is the time of an actual frame.
+    auto percentile = [&ms](int p) {
+        size_t rank = (p * ms.size() + 99) / 100;
+        return ms[SkTMax<size_t>(rank, 1) - 1];
+    };
+    const double median = percentile(50);
+    auto framesOver = [&ms](double limit) {
+        return ms.end() - std::upper_bound(ms.begin(), ms.end(), limit);
+    };
+
+    printf("frames %zu  first %.4gms  p50 %.4gms  p90 %.4gms  p95 %.4gms  p99 %.4gms  max %.4gms  "
+           ">2x_p50 %li  >4x_p50 %li",
+           ms.size(), std::chrono::duration<double, std::milli>(stats.fFirstFrame).count(),
+           median, percentile(90), percentile(95), percentile(99), ms.back(),
+           (long)framesOver(2 * median), (long)framesOver(4 * median));
+    if (stats.fCompiledFrames >= 0) {
+        printf("  compiled %i/%i (steady %i)", stats.fCompiledFrames, stats.fTotalFrames,
+               stats.fSteadyCompiledFrames);
+    }
+    printf("  %s  %-9s %s\n", FLAGS_gpuClock ? "gpu" : "cpu", config, bench);
+    fflush(stdout);
+}
+
 int main(int argc, char** argv) {
     CommandLineFlags::SetUsage(
             "Use skpbench.py instead. "
@@ -392,6 +484,10 @@ int main(int argc, char** argv) {
     // Create a context.
     GrContextOptions ctxOptions;
     SetCtxOptionsFromCommonFlags(&ctxOptions);
+    sk_gpu_test::MemoryCache memoryCache;
+    if (!FLAGS_writeShaderCache.isEmpty()) {
+        ctxOptions.fPersistentCache = &memoryCache;
+    }
     sk_gpu_test::GrContextFactory factory(ctxOptions);
     sk_gpu_test::ContextInfo ctxInfo =
         factory.getContextInfo(config->getContextType(), config->getContextOverrides());
@@ -444,13 +540,25 @@ int main(int argc, char** argv) {
     } else {
         samples.reserve(2 * FLAGS_duration);
     }
+    FrameStats frameStats;
+    FrameStats* frameStatsPtr = FLAGS_frameStats ? &frameStats : nullptr;
+    if (FLAGS_frameStats && FLAGS_ddl) {
+        exitf(ExitErr::kUnavailable, "DDL: frame stats not supported");
+    }
     SkCanvas* canvas = surface->getCanvas();
     canvas->translate(-skp->cullRect().x(), -skp->cullRect().y());
+    if (!FLAGS_gpuCapture.isEmpty()) {
+        if (FLAGS_ddl) {
+            exitf(ExitErr::kUnavailable, "DDL: GPU capture not supported");
+        }
+        write_gpu_capture(FLAGS_gpuCapture[0], surface.get(), skp.get());
+    }
     if (!FLAGS_gpuClock) {
         if (FLAGS_ddl) {
             run_ddl_benchmark(testCtx->fenceSync(), ctx, canvas, skp.get(), &samples);
         } else {
-            run_benchmark(testCtx->fenceSync(), surface.get(), skp.get(), &samples);
+            run_benchmark(testCtx->fenceSync(), surface.get(), skp.get(), &samples,
+                          frameStatsPtr);
         }
     } else {
         if (FLAGS_ddl) {
@@ -460,9 +568,12 @@ int main(int argc, char** argv) {
             exitf(ExitErr::kUnavailable, "GPU does not support timing");
         }
         run_gpu_time_benchmark(testCtx->gpuTimer(), testCtx->fenceSync(), surface.get(), skp.get(),
-                               &samples);
+                               &samples, frameStatsPtr);
     }
     print_result(samples, config->getTag().c_str(), srcname.c_str());
+    if (frameStatsPtr) {
+        print_frame_stats(frameStats, config->getTag().c_str(), srcname.c_str());
+    }
 
     // Save a proof (if one was requested).
     if (!FLAGS_png.isEmpty()) {
@@ -479,6 +590,11 @@ int main(int argc, char** argv) {
         }
     }
 
+    // Save the shader cache (if requested).
+    if (!FLAGS_writeShaderCache.isEmpty()) {
+        write_shader_cache(FLAGS_writeShaderCache[0], &memoryCache);
+    }
+
     exit(0);
 }
 
@@ -488,6 +604,35 @@ static void draw_skp_and_flush(SkSurface* surface, const SkPicture* skp) {
     surface->flush();
 }
 
+// Programs built so far. On GL these are shader compiles; on Vulkan, pipeline creations.
+static int program_builds(GrContext* context) {
+#if GR_GPU_STATS
+    GrGpu::Stats* stats = context->priv().getGpu()->stats();
+    return stats->shaderCompilations() + stats->numWarmPipelineCreates() +
+           stats->numColdPipelineCreates();
+#else
+    return -1;
+#endif
+}
+
+static void draw_frame(SkSurface* surface, const SkPicture* skp, FrameStats* frameStats,
+                       bool steady) {
+    if (!frameStats) {
+        draw_skp_and_flush(surface, skp);
+        return;
+    }
+    GrContext* context = surface->getCanvas()->getGrContext();
+    const int buildsBefore = program_builds(context);
+    draw_skp_and_flush(surface, skp);
+    ++frameStats->fTotalFrames;
+    if (buildsBefore < 0) {
+        frameStats->fCompiledFrames = -1;
+    } else if (program_builds(context) > buildsBefore) {
+        ++frameStats->fCompiledFrames;
+        frameStats->fSteadyCompiledFrames += steady;
+    }
+}
+
 static sk_sp<SkPicture> create_warmup_skp() {
     static constexpr SkRect bounds{0, 0, 500, 500};
     SkPictureRecorder recorder;
@@ -543,6 +688,45 @@ bool mkdir_p(const SkString& dirname) {
     return mkdir_p(SkOSPath::Dirname(dirname.c_str())) && sk_mkdir(dirname.c_str());
 }
 
+// Writes each entry as <md5 of key>.key and <md5 of key>.data. Naming the files after the key lets
+// runs over a whole corpus share one directory without duplicating programs.
+void write_shader_cache(const char* dir, sk_gpu_test::MemoryCache* cache) {
+    if (!mkdir_p(SkString(dir))) {
+        exitf(ExitErr::kIO, "failed to create directory for shader cache \"%s\"", dir);
+    }
+    cache->foreach([dir](sk_sp<const SkData> key, sk_sp<SkData> data, int /*hitCount*/) {
+        SkMD5 hash;
+        hash.write(key->data(), key->size());
+        SkMD5::Digest digest = hash.finish();
+        SkString name;
+        for (int i = 0; i < 16; ++i) {
+            name.appendf("%02x", digest.data[i]);
+        }
+        SkString path = SkOSPath::Join(dir, name.c_str());
+        SkFILEWStream keyFile(SkStringPrintf("%s.key", path.c_str()).c_str());
+        SkFILEWStream dataFile(SkStringPrintf("%s.data", path.c_str()).c_str());
+        if (!keyFile.isValid() || !dataFile.isValid() ||
+            !keyFile.write(key->data(), key->size()) ||
+            !dataFile.write(data->data(), data->size())) {
+            exitf(ExitErr::kIO, "failed to write shader cache entry \"%s\"", path.c_str());
+        }
+    });
+}
+
+void write_gpu_capture(const char* path, SkSurface* surface, const SkPicture* skp) {
+    GrGpu* gpu = surface->getCanvas()->getGrContext()->priv().getGpu();
+    GrGpuCapture capture;
+    gpu->setCapture(&capture);
+    draw_skp_and_flush(surface, skp);
+    gpu->setCapture(nullptr);
+
+    sk_sp<SkData> data = capture.serialize();
+    SkFILEWStream file(path);
+    if (!file.isValid() || !file.write(data->data(), data->size())) {
+        exitf(ExitErr::kIO, "failed to write GPU capture \"%s\"", path);
+    }
+}
+
 static SkString join(const CommandLineFlags::StringArray& stringArray) {
     SkString joined;
     for (int i = 0; i < stringArray.count(); ++i) {
@@ -45,6 +45,9 @@ __argparse.add_argument('-x', '--suffix',
   help="suffix to append on config (e.g. '_before', '_after')")
 __argparse.add_argument('-w','--write-path',
   help="directory to save .png proofs to disk.")
+__argparse.add_argument('--write-shader-cache',
+  help="directory to save every program key/data pair the skps use, for "
+       "GrContext::precompileShader.")
 __argparse.add_argument('-v','--verbosity',
   type=int, default=1, help="level of verbosity (0=none to 5=debug)")
 __argparse.add_argument('-d', '--duration',
@@ -56,6 +59,10 @@ __argparse.add_argument('--gpu',
   help="perform timing on the gpu clock instead of cpu (gpu work only)")
 __argparse.add_argument('--fps',
   action='store_true', help="use fps instead of ms")
+__argparse.add_argument('--frame-stats',
+  action='store_true',
+  help="also print per-frame percentiles, the first frame's time, and how many "
+       "frames compiled programs")
 __argparse.add_argument('--pr',
   help="comma- or space-separated list of GPU path renderers, including: "
        "[[~]all [~]default [~]dashline [~]nvpr [~]msaa [~]aaconvex "
@@ -131,6 +138,8 @@ class SKPBench:
     ARGV.extend(['--gpuClock', 'true'])
   if FLAGS.fps:
     ARGV.extend(['--fps', 'true'])
+  if FLAGS.frame_stats:
+    ARGV.extend(['--frameStats', 'true'])
   if FLAGS.pr:
     ARGV.extend(['--pr'] + re.split(r'[ ,]', FLAGS.pr))
   if FLAGS.cc:
@@ -139,6 +148,8 @@ class SKPBench:
     ARGV.extend(['--cachePathMasks', 'false'])
   if FLAGS.gpuThreads != -1:
     ARGV.extend(['--gpuThreads', str(FLAGS.gpuThreads)])
+  if FLAGS.write_shader_cache:
+    ARGV.extend(['--writeShaderCache', FLAGS.write_shader_cache])
 
   # DDL parameters
   if FLAGS.ddl:
@@ -29,6 +29,7 @@
 #include "src/utils/SkOSPath.h"
 #include "tools/Resources.h"
 #include "tools/ToolUtils.h"
+#include "tools/debugger/CostHeatmapCanvas.h"
 #include "tools/flags/CommandLineFlags.h"
 #include "tools/flags/CommonFlags.h"
 #include "tools/trace/EventTracingPriv.h"
@@ -238,6 +239,8 @@ Viewer::Viewer(int argc, char** argv, void* platformData)
     , fRefresh(false)
     , fSaveToSKP(false)
     , fShowSlideDimensions(false)
+    , fShowCostHeatmap(false)
+    , fPrintCostSummary(false)
     , fShowImGuiDebugWindow(false)
     , fShowSlidePicker(false)
     , fShowImGuiTestWindow(false)
@@ -403,6 +406,11 @@ Viewer::Viewer(int argc, char** argv, void* platformData)
         fShowSlideDimensions = !fShowSlideDimensions;
         fWindow->inval();
     });
+    fCommands.addCommand('C', "Overlays", "Toggle cost heatmap", [this]() {
+        fShowCostHeatmap = !fShowCostHeatmap;
+        fPrintCostSummary = fShowCostHeatmap;
+        fWindow->inval();
+    });
     fCommands.addCommand('G', "Modes", "Geometry", [this]() {
         DisplayParams params = fWindow->getRequestedDisplayParams();
         uint32_t flags = params.fSurfaceProps.flags();
@@ -1330,6 +1338,24 @@ void Viewer::drawSlide(SkSurface* surface) {
         paint.setColor(0x40FFFF00);
         surface->getCanvas()->drawRect(r, paint);
     }
+
+    if (fShowCostHeatmap) {
+        CostHeatmapCanvas heatmap(fWindow->width(), fWindow->height());
+        heatmap.concat(this->computeMatrix());
+        fSlides[fCurrentSlide]->draw(&heatmap);
+        heatmap.drawHeatmap(surface->getCanvas());
+
+        // The summary is printed once each time the heatmap is turned on.
+        if (fPrintCostSummary) {
+            SkDynamicMemoryWStream stream;
+            SkJSONWriter writer(&stream, SkJSONWriter::Mode::kPretty);
+            heatmap.writeSummary(writer);
+            writer.flush();
+            sk_sp<SkData> summary = stream.detachAsData();
+            SkDebugf("%.*s\n", SkToInt(summary->size()), summary->data());
+            fPrintCostSummary = false;
+        }
+    }
 }
 
 void Viewer::onBackendCreated() {
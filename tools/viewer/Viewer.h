@@ -129,6 +129,8 @@ private:
 
     bool                   fSaveToSKP;
     bool                   fShowSlideDimensions;
+    bool                   fShowCostHeatmap;
+    bool                   fPrintCostSummary;
 
     ImGuiLayer             fImGuiLayer;
     SkPaint                fImGuiGamutPaint;